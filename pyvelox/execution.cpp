@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "execution.h"
+#include <pybind11/stl.h>
+#include <velox/core/Expressions.h>
+#include <velox/core/PlanFragment.h>
+#include <velox/core/PlanNode.h>
+#include <velox/exec/PartitionFunction.h>
+#include <velox/exec/Task.h>
+#include <velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h>
+#include <velox/parse/Expressions.h>
+#include <velox/parse/ExpressionsParser.h>
+#include <velox/vector/arrow/Abi.h>
+#include <velox/vector/arrow/Bridge.h>
+#include "context.h"
+
+namespace facebook::velox::py {
+
+namespace py = pybind11;
+
+namespace {
+
+// A plan fragment built from Python. Plan nodes are immutable, so each
+// builder call returns a new PyPlan that shares the nodes below it.
+struct PyPlan {
+  core::PlanNodePtr node;
+};
+
+std::string nextPlanNodeId() {
+  static std::atomic<int64_t> nextId{0};
+  return fmt::format("py{}", nextId++);
+}
+
+core::TypedExprPtr parseTypedExpr(
+    const std::string& sql,
+    const RowTypePtr& inputType) {
+  auto* pool = PyVeloxContext::getSingletonInstance().pool();
+  return core::Expressions::inferTypes(
+      parse::parseExpr(sql, parse::ParseOptions{}), inputType, pool);
+}
+
+RowVectorPtr importRecordBatch(const py::handle& recordBatch) {
+  ArrowArray arrowArray;
+  ArrowSchema arrowSchema;
+  recordBatch.attr("_export_to_c")(
+      reinterpret_cast<uintptr_t>(&arrowArray),
+      reinterpret_cast<uintptr_t>(&arrowSchema));
+  auto* pool = PyVeloxContext::getSingletonInstance().pool();
+  auto vector = importFromArrowAsOwner(arrowSchema, arrowArray, pool);
+  auto rowVector = std::dynamic_pointer_cast<RowVector>(vector);
+  if (!rowVector) {
+    throw py::type_error("Expected a pyarrow RecordBatch");
+  }
+  return rowVector;
+}
+
+// Makes 'arrowArray' also hold a reference to 'task' until the consumer
+// releases it. The exported buffers of fixed-width columns are the buffers
+// of the result vectors, which are allocated from the memory pools of the
+// task.
+void holdTask(ArrowArray& arrowArray, std::shared_ptr<exec::Task> task) {
+  struct Holder {
+    ArrowArray exported;
+    std::shared_ptr<exec::Task> task;
+  };
+  arrowArray.private_data = new Holder{arrowArray, std::move(task)};
+  arrowArray.release = [](ArrowArray* array) {
+    auto* holder = static_cast<Holder*>(array->private_data);
+    holder->exported.release(&holder->exported);
+    delete holder;
+    array->release = nullptr;
+  };
+}
+
+// Runs a plan fragment single-threaded on the calling thread and returns the
+// results one batch at a time.
+class PyTaskCursor {
+ public:
+  PyTaskCursor(
+      const core::PlanNodePtr& plan,
+      std::unordered_map<std::string, std::string> config) {
+    static std::atomic<int64_t> nextTaskId{0};
+    task_ = exec::Task::create(
+        fmt::format("pyvelox.{}", nextTaskId++),
+        core::PlanFragment{plan},
+        0,
+        std::make_shared<core::QueryCtx>(nullptr, std::move(config)));
+  }
+
+  py::object next() {
+    RowVectorPtr result;
+    {
+      // Velox does not call into Python, so other Python threads can run
+      // while the task produces the batch.
+      py::gil_scoped_release release;
+      result = nextBatch();
+    }
+    if (!result) {
+      throw py::stop_iteration();
+    }
+    return toRecordBatch(result);
+  }
+
+ private:
+  RowVectorPtr nextBatch() {
+    for (;;) {
+      auto future = ContinueFuture::makeEmpty();
+      auto result = task_->next(&future);
+      if (result || !future.valid()) {
+        return result;
+      }
+      std::move(future).wait();
+    }
+  }
+
+  py::object toRecordBatch(const RowVectorPtr& result) {
+    // Lazy columns are not exported. Loading them keeps flat columns flat.
+    std::vector<VectorPtr> children;
+    children.reserve(result->childrenSize());
+    for (const auto& child : result->children()) {
+      children.push_back(BaseVector::loadedVectorShared(child));
+    }
+    auto* pool = PyVeloxContext::getSingletonInstance().pool();
+    VectorPtr loaded = std::make_shared<RowVector>(
+        result->pool(),
+        result->type(),
+        result->nulls(),
+        result->size(),
+        std::move(children));
+
+    ArrowArray arrowArray;
+    ArrowSchema arrowSchema;
+    exportToArrow(loaded, arrowArray, pool);
+    exportToArrow(loaded, arrowSchema);
+    holdTask(arrowArray, task_);
+    return py::module::import("pyarrow")
+        .attr("RecordBatch")
+        .attr("_import_from_c")(
+            reinterpret_cast<uintptr_t>(&arrowArray),
+            reinterpret_cast<uintptr_t>(&arrowSchema));
+  }
+
+  std::shared_ptr<exec::Task> task_;
+};
+
+} // namespace
+
+void addExecutionBindings(py::module& m, bool asModuleLocalDefinitions) {
+  using namespace facebook::velox;
+  Type::registerSerDe();
+  core::PlanNode::registerSerDe();
+  core::ITypedExpr::registerSerDe();
+  exec::registerPartitionFunctionSerDe();
+  aggregate::prestosql::registerAllAggregateFunctions();
+
+  py::class_<PyTaskCursor>(
+      m, "TaskCursor", py::module_local(asModuleLocalDefinitions))
+      .def("__iter__", [](PyTaskCursor& cursor) -> PyTaskCursor& {
+        return cursor;
+      })
+      .def("__next__", &PyTaskCursor::next);
+
+  py::class_<PyPlan>(m, "Plan", py::module_local(asModuleLocalDefinitions))
+      .def_static(
+          "from_record_batches",
+          [](const py::list& recordBatches) {
+            std::vector<RowVectorPtr> values;
+            values.reserve(recordBatches.size());
+            for (const auto& recordBatch : recordBatches) {
+              values.push_back(importRecordBatch(recordBatch));
+            }
+            if (values.empty()) {
+              throw py::value_error("Expected at least one RecordBatch");
+            }
+            return PyPlan{std::make_shared<core::ValuesNode>(
+                nextPlanNodeId(), std::move(values))};
+          },
+          "Returns a plan that produces the given pyarrow RecordBatches. Fixed-width columns are not copied.",
+          py::arg("record_batches"))
+      .def_static(
+          "from_json",
+          [](const std::string& json) {
+            auto* pool = PyVeloxContext::getSingletonInstance().pool();
+            return PyPlan{ISerializable::deserialize<core::PlanNode>(
+                folly::parseJson(json), pool)};
+          },
+          "Returns the plan fragment serialized by to_json or by Velox.",
+          py::arg("json"))
+      .def(
+          "to_json",
+          [](const PyPlan& plan) {
+            return folly::toJson(plan.node->serialize());
+          },
+          "Serializes the plan fragment as JSON.")
+      .def(
+          "filter",
+          [](const PyPlan& plan, const std::string& filter) {
+            return PyPlan{std::make_shared<core::FilterNode>(
+                nextPlanNodeId(),
+                parseTypedExpr(filter, plan.node->outputType()),
+                plan.node)};
+          },
+          "Returns a plan that keeps the rows for which the SQL expression is true.",
+          py::arg("filter"))
+      .def(
+          "project",
+          [](const PyPlan& plan, const std::vector<std::string>& projections) {
+            std::vector<std::string> names;
+            std::vector<core::TypedExprPtr> exprs;
+            for (auto i = 0; i < projections.size(); ++i) {
+              auto untyped =
+                  parse::parseExpr(projections[i], parse::ParseOptions{});
+              names.push_back(untyped->alias().value_or(fmt::format("p{}", i)));
+              exprs.push_back(core::Expressions::inferTypes(
+                  untyped,
+                  plan.node->outputType(),
+                  PyVeloxContext::getSingletonInstance().pool()));
+            }
+            return PyPlan{std::make_shared<core::ProjectNode>(
+                nextPlanNodeId(),
+                std::move(names),
+                std::move(exprs),
+                plan.node)};
+          },
+          "Returns a plan that computes the SQL expressions, named by their aliases or p0, p1... otherwise.",
+          py::arg("projections"))
+      .def(
+          "execute",
+          [](const PyPlan& plan,
+             std::unordered_map<std::string, std::string> config) {
+            return std::make_unique<PyTaskCursor>(plan.node, std::move(config));
+          },
+          R"delimiter(
+        Runs the plan fragment on the calling thread and returns an iterator
+        over the results as pyarrow RecordBatches. Flat fixed-width columns
+        are passed through the Arrow C data interface without copies; strings
+        are copied. The GIL is released while each batch is produced.
+
+        Parameters
+        ----------
+        config : Dict[str, str]
+              Query config, e.g. {'preferred_output_batch_rows': '4096'}.
+
+        Examples
+        --------
+
+        >>> import pyarrow as pa
+        >>> import pyvelox.pyvelox as pv
+        >>> batch = pa.record_batch([pa.array([1, 2, 3])], names=['a'])
+        >>> plan = pv.Plan.from_record_batches([batch]).filter('a > 1')
+        >>> for result in plan.execute():
+        ...     print(result.column(0).to_numpy())
+        [2 3]
+      )delimiter",
+          py::arg("config") = std::unordered_map<std::string, std::string>{});
+}
+
+} // namespace facebook::velox::py
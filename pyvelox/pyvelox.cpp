@@ -16,6 +16,7 @@
 
 #include "pyvelox.h"
 #include "conversion.h"
+#include "execution.h"
 #include "serde.h"
 #include "signatures.h"
 
@@ -310,6 +311,7 @@ PYBIND11_MODULE(pyvelox, m) {
   addSignatureBindings(m);
   addSerdeBindings(m);
   addConversionBindings(m);
+  addExecutionBindings(m);
   m.attr("__version__") = "dev";
 }
 #endif
@@ -0,0 +1,102 @@
+# Copyright (c) Facebook, Inc. and its affiliates.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import threading
+import unittest
+
+import pyarrow as pa
+
+import pyvelox.pyvelox as pv
+
+
+class TestVeloxExecution(unittest.TestCase):
+    def make_batches(self):
+        return [
+            pa.record_batch(
+                [
+                    pa.array(range(i * 100, (i + 1) * 100), type=pa.int64()),
+                    pa.array([str(x) for x in range(100)]),
+                ],
+                names=["a", "b"],
+            )
+            for i in range(3)
+        ]
+
+    def collect(self, plan, **kwargs):
+        return pa.Table.from_batches(list(plan.execute(**kwargs)))
+
+    def test_values(self):
+        batches = self.make_batches()
+        result = self.collect(pv.Plan.from_record_batches(batches))
+        self.assertTrue(result.equals(pa.Table.from_batches(batches)))
+
+    def test_filter_project(self):
+        plan = (
+            pv.Plan.from_record_batches(self.make_batches())
+            .filter("a % 2 = 0")
+            .project(["a * 10 as x", "b", "a + 1"])
+        )
+        result = self.collect(plan)
+        self.assertEqual(result.column_names, ["x", "b", "p2"])
+        self.assertEqual(result.num_rows, 150)
+        self.assertEqual(
+            result.column("x").to_pylist(), [x * 10 for x in range(0, 300, 2)]
+        )
+        self.assertEqual(
+            result.column("b").to_pylist(), [str(x) for x in range(0, 100, 2)] * 3
+        )
+
+    def test_zero_copy(self):
+        plan = pv.Plan.from_record_batches(self.make_batches()).project(["a + 1"])
+        for batch in plan.execute():
+            self.assertEqual(batch.num_columns, 1)
+            # Flat columns without nulls convert to NumPy without copies.
+            column = batch.column(0).to_numpy(zero_copy_only=True)
+            self.assertEqual(column.dtype.name, "int64")
+        # The batches outlive the cursor that produced them.
+        batches = list(plan.execute())
+        self.assertEqual(sum(b.num_rows for b in batches), 300)
+
+    def test_json(self):
+        plan = pv.Plan.from_record_batches(self.make_batches()).filter("a < 10")
+        copy = pv.Plan.from_json(plan.to_json())
+        self.assertEqual(self.collect(copy).num_rows, 10)
+
+    def test_config(self):
+        plan = pv.Plan.from_record_batches(self.make_batches()).filter("a >= 0")
+        result = self.collect(plan, config={"preferred_output_batch_rows": "10"})
+        self.assertEqual(result.num_rows, 300)
+
+    def test_threads(self):
+        # The GIL is released during execution, so tasks can run concurrently.
+        plan = pv.Plan.from_record_batches(self.make_batches()).project(["a * 2"])
+        counts = []
+
+        def run():
+            counts.append(self.collect(plan).num_rows)
+
+        threads = [threading.Thread(target=run) for _ in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        self.assertEqual(counts, [300] * 4)
+
+    def test_errors(self):
+        with self.assertRaises(ValueError):
+            pv.Plan.from_record_batches([])
+        plan = pv.Plan.from_record_batches(self.make_batches())
+        with self.assertRaises(RuntimeError):
+            plan.filter("no_such_column > 1")
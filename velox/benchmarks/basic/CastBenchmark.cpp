@@ -16,6 +16,7 @@
 
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
+#include <fmt/format.h>
 
 #include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
 
@@ -51,6 +52,30 @@ int main(int argc, char** argv) {
         return Timestamp(1695859694 + j / 1000, j % 1000 * 1'000'000);
       });
 
+  // Strings as read from CSV or JSON, in the formats that are parsed in a
+  // batch.
+  std::vector<std::string> bigintStrings;
+  std::vector<std::string> doubleStrings;
+  std::vector<std::string> dateStrings;
+  std::vector<std::string> timestampStrings;
+  for (int i = 0; i < vectorSize; i++) {
+    bigintStrings.push_back(std::to_string(1'234'567'890'123LL * i));
+    doubleStrings.push_back(fmt::format("{}.{:02}", i * 37, i % 100));
+    dateStrings.push_back(
+        fmt::format("20{:02}-{:02}-{:02}", i % 100, i % 12 + 1, i % 28 + 1));
+    timestampStrings.push_back(fmt::format(
+        "{} {:02}:{:02}:{:02}.{:03}",
+        dateStrings.back(),
+        i % 24,
+        i % 60,
+        (i * 7) % 60,
+        i));
+  }
+  auto bigintStringInput = vectorMaker.flatVector(bigintStrings);
+  auto doubleStringInput = vectorMaker.flatVector(doubleStrings);
+  auto dateStringInput = vectorMaker.flatVector(dateStrings);
+  auto timestampStringInput = vectorMaker.flatVector(timestampStrings);
+
   invalidInput->resize(vectorSize);
   validInput->resize(vectorSize);
   nanInput->resize(vectorSize);
@@ -71,14 +96,22 @@ int main(int argc, char** argv) {
                "decimal",
                "short_decimal",
                "long_decimal",
-               "timestamp"},
+               "timestamp",
+               "bigint_string",
+               "double_string",
+               "date_string",
+               "timestamp_string"},
               {validInput,
                invalidInput,
                nanInput,
                decimalInput,
                shortDecimalInput,
                longDecimalInput,
-               timestampInput}))
+               timestampInput,
+               bigintStringInput,
+               doubleStringInput,
+               dateStringInput,
+               timestampStringInput}))
       .addExpression("try_cast_invalid_empty_input", "try_cast (empty as int) ")
       .addExpression(
           "tryexpr_cast_invalid_empty_input", "try (cast (empty as int))")
@@ -92,6 +125,13 @@ int main(int argc, char** argv) {
       .addExpression("cast_short_decimal", "cast (short_decimal as varchar)")
       .addExpression("cast_long_decimal", "cast (long_decimal as varchar)")
       .addExpression("cast_timestamp", "cast (timestamp as varchar)")
+      .addExpression("cast_varchar_to_bigint", "cast (bigint_string as bigint)")
+      .addExpression("cast_varchar_to_double", "cast (double_string as double)")
+      .addExpression("cast_varchar_to_date", "cast (date_string as date)")
+      .addExpression(
+          "cast_varchar_to_timestamp", "cast (timestamp_string as timestamp)")
+      .addExpression(
+          "try_cast_varchar_to_bigint", "try_cast (bigint_string as bigint)")
       .withIterations(100)
       .disableTesting();
 
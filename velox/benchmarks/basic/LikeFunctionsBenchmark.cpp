@@ -91,6 +91,13 @@ class LikeFunctionsBenchmark : public FunctionBaseTest,
         auto fixedPatternString = inputString.substr(fixedPatternStartIdx, 10);
         return generateRandomString(kAnyWildcardCharacter) + fixedPatternString;
       }
+      case PatternKind::kSubstring: {
+        auto fixedPatternStartIdx =
+            std::max(vector_size_t(inputString.size() / 2 - 5), 0);
+        auto fixedPatternString = inputString.substr(fixedPatternStartIdx, 10);
+        return generateRandomString(kAnyWildcardCharacter) +
+            fixedPatternString + generateRandomString(kAnyWildcardCharacter);
+      }
       default:
         return inputString;
     }
@@ -199,6 +206,10 @@ BENCHMARK(suffixPattern) {
   benchmark->run(PatternKind::kSuffix);
 }
 
+BENCHMARK(substringPattern) {
+  benchmark->run(PatternKind::kSubstring);
+}
+
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK(tpchQuery2) {
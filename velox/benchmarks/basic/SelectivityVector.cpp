@@ -38,6 +38,7 @@ class SelectivityVectorBenchmark
       : FunctionBenchmarkBase(),
         vectorSize_(vectorSize),
         rowsAll_(vectorSize),
+        rowsRange_(vectorSize, false),
         rows99PerCent_(vectorSize),
         rows50PerCent_(vectorSize),
         rows10PerCent_(vectorSize),
@@ -70,7 +71,11 @@ class SelectivityVectorBenchmark
       }
     }
 
+    // A contiguous range of rows, as selected by a filter on a sorted column.
+    rowsRange_.setValidRange(vectorSize_ / 4, vectorSize_ * 3 / 4, true);
+
     rowsAll_.updateBounds();
+    rowsRange_.updateBounds();
     rows99PerCent_.updateBounds();
     rows50PerCent_.updateBounds();
     rows10PerCent_.updateBounds();
@@ -92,6 +97,10 @@ class SelectivityVectorBenchmark
     return run(rowsAll_);
   }
 
+  size_t runSelectivityRange() {
+    return run(rowsRange_);
+  }
+
   size_t runSelectivity50PerCent() {
     return run(rows50PerCent_);
   }
@@ -122,6 +131,7 @@ class SelectivityVectorBenchmark
   VectorPtr flatVector_;
 
   SelectivityVector rowsAll_;
+  SelectivityVector rowsRange_;
   SelectivityVector rows99PerCent_;
   SelectivityVector rows50PerCent_;
   SelectivityVector rows10PerCent_;
@@ -149,6 +159,10 @@ BENCHMARK(sumSelectivity99PerCent) {
   run([] { benchmark->runSelectivity99PerCent(); });
 }
 
+BENCHMARK(sumSelectivityRange) {
+  run([] { benchmark->runSelectivityRange(); });
+}
+
 BENCHMARK(sumSelectivity50PerCent) {
   run([] { benchmark->runSelectivity50PerCent(); });
 }
@@ -62,6 +62,38 @@ struct MultiplyNullOutputFunction {
   }
 };
 
+// Vectorized vs. per-row iteration.
+template <typename T>
+struct MultiplyVectorizedFunction {
+  static constexpr bool is_vectorizable = true;
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void
+  call(TInput& result, const TInput& a, const TInput& b) {
+    result = functions::multiply(a, b);
+  }
+};
+
+template <typename T>
+struct LessThanFunction {
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void
+  call(bool& result, const TInput& a, const TInput& b) {
+    result = a < b;
+  }
+};
+
+template <typename T>
+struct LessThanVectorizedFunction {
+  static constexpr bool is_vectorizable = true;
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void
+  call(bool& result, const TInput& a, const TInput& b) {
+    result = a < b;
+  }
+};
+
 // Checked vs. Unchecked Arithmetic.
 template <typename T>
 struct PlusFunction {
@@ -92,6 +124,12 @@ class SimpleArithmeticBenchmark
     registerFunction<MultiplyNullOutputFunction, double, double, double>(
         {"multiply_null_output"});
 
+    registerFunction<MultiplyVectorizedFunction, double, double, double>(
+        {"multiply_vectorized"});
+    registerFunction<LessThanFunction, bool, double, double>({"lt"});
+    registerFunction<LessThanVectorizedFunction, bool, double, double>(
+        {"lt_vectorized"});
+
     registerFunction<PlusFunction, int64_t, int64_t, int64_t>({"plus"});
     registerFunction<CheckedPlusFunction, int64_t, int64_t, int64_t>(
         {"checked_plus"});
@@ -226,6 +264,24 @@ BENCHMARK(plusCheckedSmall) {
   benchmark->runSmall("checked_plus(c, d)");
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(multiplyVectorizedSmall) {
+  benchmark->runSmall("multiply_vectorized(a, b)");
+}
+
+BENCHMARK(multiplyVectorizedConstantSmall) {
+  benchmark->runSmall("multiply_vectorized(a, constant)");
+}
+
+BENCHMARK(lessThanSmall) {
+  benchmark->runSmall("lt(a, b)");
+}
+
+BENCHMARK(lessThanVectorizedSmall) {
+  benchmark->runSmall("lt_vectorized(a, b)");
+}
+
 BENCHMARK_DRAW_LINE();
 BENCHMARK_DRAW_LINE();
 
@@ -283,6 +339,24 @@ BENCHMARK(plusCheckedMedium) {
   benchmark->runMedium("checked_plus(c, d)");
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(multiplyVectorizedMedium) {
+  benchmark->runMedium("multiply_vectorized(a, b)");
+}
+
+BENCHMARK(multiplyVectorizedConstantMedium) {
+  benchmark->runMedium("multiply_vectorized(a, constant)");
+}
+
+BENCHMARK(lessThanMedium) {
+  benchmark->runMedium("lt(a, b)");
+}
+
+BENCHMARK(lessThanVectorizedMedium) {
+  benchmark->runMedium("lt_vectorized(a, b)");
+}
+
 BENCHMARK_DRAW_LINE();
 BENCHMARK_DRAW_LINE();
 
@@ -340,6 +414,24 @@ BENCHMARK(plusCheckedLarge) {
   benchmark->runLarge("checked_plus(c, d)");
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(multiplyVectorizedLarge) {
+  benchmark->runLarge("multiply_vectorized(a, b)");
+}
+
+BENCHMARK(multiplyVectorizedConstantLarge) {
+  benchmark->runLarge("multiply_vectorized(a, constant)");
+}
+
+BENCHMARK(lessThanLarge) {
+  benchmark->runLarge("lt(a, b)");
+}
+
+BENCHMARK(lessThanVectorizedLarge) {
+  benchmark->runLarge("lt_vectorized(a, b)");
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
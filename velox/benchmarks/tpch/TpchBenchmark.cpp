@@ -19,11 +19,14 @@
 #include <sys/time.h>
 
 #include <folly/Benchmark.h>
+#include <folly/String.h>
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include <gflags/gflags.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <fstream>
+#include <numeric>
 
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/file/FileSystems.h"
@@ -162,6 +165,37 @@ DEFINE_bool(
     "Runs one warmup of the query before "
     "measured run. Use to run warm after clearing caches.");
 
+DEFINE_string(
+    json_output,
+    "",
+    "If set, runs the queries in --queries for each value of "
+    "--suite_num_drivers and writes the timings and the per plan node stats of "
+    "each run as JSON to this file, so that runs can be diffed across "
+    "releases");
+DEFINE_string(
+    queries,
+    "",
+    "Comma separated TPC-H query numbers for --json_output. All 22 queries if "
+    "empty. Queries that the query builder does not support are listed as "
+    "skipped in the output");
+DEFINE_string(
+    suite_num_drivers,
+    "",
+    "Comma separated numbers of drivers for --json_output. Uses "
+    "--num_drivers if empty");
+DEFINE_string(
+    cache_state,
+    "memory_warm",
+    "Cache state for the runs of --json_output. 'cold' clears the RAM, OS and "
+    "SSD caches before each run, 'memory_warm' runs each query once before "
+    "measuring and 'ssd_warm' also runs once before measuring but then clears "
+    "the RAM and OS caches, so that data comes from the SSD cache");
+DEFINE_double(
+    scale_factor,
+    0,
+    "Scale factor of the data in --data_path. Only recorded in the output of "
+    "--json_output");
+
 DEFINE_validator(data_path, &notEmpty);
 DEFINE_validator(data_format, &validateDataFormat);
 
@@ -278,30 +312,7 @@ class TpchBenchmark {
     int32_t repeat = 0;
     try {
       for (;;) {
-        CursorParameters params;
-        params.maxDrivers = FLAGS_num_drivers;
-        params.planNode = tpchPlan.plan;
-        const int numSplitsPerFile = FLAGS_num_splits_per_file;
-
-        bool noMoreSplits = false;
-        auto addSplits = [&](exec::Task* task) {
-          if (!noMoreSplits) {
-            for (const auto& entry : tpchPlan.dataFiles) {
-              for (const auto& path : entry.second) {
-                auto const splits =
-                    HiveConnectorTestBase::makeHiveConnectorSplits(
-                        path, numSplitsPerFile, tpchPlan.dataFileFormat);
-                for (const auto& split : splits) {
-                  task->addSplit(entry.first, exec::Split(split));
-                }
-              }
-              task->noMoreSplits(entry.first);
-            }
-          }
-          noMoreSplits = true;
-        };
-        auto result = readCursor(params, addSplits);
-        ensureTaskCompletion(result.first->task().get());
+        auto result = runOnce(tpchPlan);
         if (++repeat >= FLAGS_num_repeats) {
           return result;
         }
@@ -312,6 +323,34 @@ class TpchBenchmark {
     }
   }
 
+  std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>> runOnce(
+      const TpchPlan& tpchPlan) {
+    CursorParameters params;
+    params.maxDrivers = FLAGS_num_drivers;
+    params.planNode = tpchPlan.plan;
+    const int numSplitsPerFile = FLAGS_num_splits_per_file;
+
+    bool noMoreSplits = false;
+    auto addSplits = [&](exec::Task* task) {
+      if (!noMoreSplits) {
+        for (const auto& entry : tpchPlan.dataFiles) {
+          for (const auto& path : entry.second) {
+            auto const splits = HiveConnectorTestBase::makeHiveConnectorSplits(
+                path, numSplitsPerFile, tpchPlan.dataFileFormat);
+            for (const auto& split : splits) {
+              task->addSplit(entry.first, exec::Split(split));
+            }
+          }
+          task->noMoreSplits(entry.first);
+        }
+      }
+      noMoreSplits = true;
+    };
+    auto result = readCursor(params, addSplits);
+    ensureTaskCompletion(result.first->task().get());
+    return result;
+  }
+
   void runMain(std::ostream& out, RunStats& runStats) {
     if (FLAGS_run_query_verbose == -1 && FLAGS_io_meter_column_pct == 0) {
       folly::runBenchmarks();
@@ -378,34 +417,40 @@ class TpchBenchmark {
     }
   }
 
-  void runCombinations(int32_t level) {
-    if (level == parameters_.size()) {
-      if (FLAGS_clear_ram_cache) {
+  // Flushes the in-process and OS file system caches if 'ram' is true and the
+  // SSD cache if 'ssd' is true.
+  void clearCaches(bool ram, bool ssd) {
+    if (ram) {
 #ifdef linux
-        // system("echo 3 >/proc/sys/vm/drop_caches");
-        bool success = false;
-        auto fd = open("/proc//sys/vm/drop_caches", O_WRONLY);
-        if (fd > 0) {
-          success = write(fd, "3", 1) == 1;
-          close(fd);
-        }
-        if (!success) {
-          LOG(ERROR) << "Failed to clear OS disk cache: errno=" << errno;
-        }
+      // system("echo 3 >/proc/sys/vm/drop_caches");
+      bool success = false;
+      auto fd = open("/proc//sys/vm/drop_caches", O_WRONLY);
+      if (fd > 0) {
+        success = write(fd, "3", 1) == 1;
+        close(fd);
+      }
+      if (!success) {
+        LOG(ERROR) << "Failed to clear OS disk cache: errno=" << errno;
+      }
 #endif
 
-        if (cache_) {
-          cache_->clear();
-        }
+      if (cache_) {
+        cache_->clear();
       }
-      if (FLAGS_clear_ssd_cache) {
-        if (cache_) {
-          auto ssdCache = cache_->ssdCache();
-          if (ssdCache) {
-            ssdCache->clear();
-          }
+    }
+    if (ssd) {
+      if (cache_) {
+        auto ssdCache = cache_->ssdCache();
+        if (ssdCache) {
+          ssdCache->clear();
         }
       }
+    }
+  }
+
+  void runCombinations(int32_t level) {
+    if (level == parameters_.size()) {
+      clearCaches(FLAGS_clear_ram_cache, FLAGS_clear_ssd_cache);
       if (FLAGS_warmup_after_clear) {
         std::stringstream result;
         RunStats ignore;
@@ -469,6 +514,120 @@ class TpchBenchmark {
     }
   }
 
+  // Runs each query of --queries --num_repeats times with each number of
+  // drivers in --suite_num_drivers in --cache_state and writes a JSON report
+  // to --json_output.
+  void runSuite() {
+    const auto queryIds = parseInts(FLAGS_queries);
+    auto numDriversList = parseInts(FLAGS_suite_num_drivers);
+    if (numDriversList.empty()) {
+      numDriversList.push_back(FLAGS_num_drivers);
+    }
+    const auto& cacheState = FLAGS_cache_state;
+    VELOX_USER_CHECK(
+        cacheState == "cold" || cacheState == "memory_warm" ||
+            cacheState == "ssd_warm",
+        "Invalid value for --cache_state: {}",
+        cacheState);
+    VELOX_USER_CHECK(
+        cacheState != "ssd_warm" ||
+            (cache_ != nullptr && cache_->ssdCache() != nullptr),
+        "--cache_state=ssd_warm requires --cache_gb and --ssd_cache_gb");
+
+    folly::dynamic runs = folly::dynamic::array;
+    folly::dynamic skipped = folly::dynamic::array;
+    const auto savedNumDrivers = FLAGS_num_drivers;
+    for (auto queryId : queryIds.empty() ? allQueryIds() : queryIds) {
+      std::optional<TpchPlan> plan;
+      try {
+        plan = queryBuilder->getQueryPlan(queryId);
+      } catch (const VeloxException& e) {
+        LOG(WARNING) << "Skipping TPC-H query " << queryId << ": "
+                     << e.message();
+        skipped.push_back(queryId);
+        continue;
+      }
+      for (auto numDrivers : numDriversList) {
+        FLAGS_num_drivers = numDrivers;
+        if (cacheState != "cold") {
+          clearCaches(true, true);
+          runAndReport(*plan);
+        }
+        for (auto repeat = 0; repeat < FLAGS_num_repeats; ++repeat) {
+          if (cacheState == "cold") {
+            clearCaches(true, true);
+          } else if (cacheState == "ssd_warm") {
+            clearCaches(true, false);
+          }
+          auto run = runAndReport(*plan);
+          run["query"] = queryId;
+          run["numDrivers"] = numDrivers;
+          run["repeat"] = repeat;
+          runs.push_back(std::move(run));
+        }
+      }
+    }
+    FLAGS_num_drivers = savedNumDrivers;
+
+    folly::dynamic report = folly::dynamic::object;
+    report["dataPath"] = FLAGS_data_path;
+    report["dataFormat"] = FLAGS_data_format;
+    report["scaleFactor"] = FLAGS_scale_factor;
+    report["cacheState"] = cacheState;
+    report["numSplitsPerFile"] = FLAGS_num_splits_per_file;
+    report["skippedQueries"] = std::move(skipped);
+    report["runs"] = std::move(runs);
+    std::ofstream file(FLAGS_json_output);
+    VELOX_USER_CHECK(
+        file.good(), "Cannot open --json_output: {}", FLAGS_json_output);
+    file << folly::toPrettyJson(report) << std::endl;
+  }
+
+  // Runs 'plan' once and returns the timings and the stats of each plan node
+  // and operator. A failed run has an 'error' and no stats.
+  folly::dynamic runAndReport(const TpchPlan& plan) {
+    folly::dynamic run = folly::dynamic::object;
+    uint64_t micros = 0;
+    struct rusage start;
+    getrusage(RUSAGE_SELF, &start);
+    try {
+      MicrosecondTimer timer(&micros);
+      auto result = runOnce(plan);
+      const auto stats = result.first->task()->taskStats();
+      run["executionMs"] =
+          stats.executionEndTimeMs - stats.executionStartTimeMs;
+      run["planNodeStats"] = toPlanStatsJson(stats);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Query terminated with: " << e.what();
+      run["error"] = e.what();
+    }
+    struct rusage final;
+    getrusage(RUSAGE_SELF, &final);
+    auto tvNanos = [](struct timeval tv) {
+      return tv.tv_sec * 1000000000 + tv.tv_usec * 1000;
+    };
+    run["wallMicros"] = micros;
+    run["userNanos"] = tvNanos(final.ru_utime) - tvNanos(start.ru_utime);
+    run["systemNanos"] = tvNanos(final.ru_stime) - tvNanos(start.ru_stime);
+    return run;
+  }
+
+  static std::vector<int32_t> allQueryIds() {
+    std::vector<int32_t> ids(22);
+    std::iota(ids.begin(), ids.end(), 1);
+    return ids;
+  }
+
+  static std::vector<int32_t> parseInts(const std::string& list) {
+    std::vector<int32_t> values;
+    std::vector<folly::StringPiece> parts;
+    folly::split(',', list, parts, true);
+    for (auto part : parts) {
+      values.push_back(folly::to<int32_t>(folly::trimWhitespace(part)));
+    }
+    return values;
+  }
+
   std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
   std::unique_ptr<folly::IOThreadPoolExecutor> cacheExecutor_;
   std::shared_ptr<memory::MemoryAllocator> allocator_;
@@ -582,7 +741,9 @@ int tpchBenchmarkMain() {
   queryBuilder =
       std::make_shared<TpchQueryBuilder>(toFileFormat(FLAGS_data_format));
   queryBuilder->initialize(FLAGS_data_path);
-  if (FLAGS_test_flags_file.empty()) {
+  if (!FLAGS_json_output.empty()) {
+    benchmark.runSuite();
+  } else if (FLAGS_test_flags_file.empty()) {
     RunStats ignore;
     benchmark.runMain(std::cout, ignore);
   } else {
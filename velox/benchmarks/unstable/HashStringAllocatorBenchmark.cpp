@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/memory/HashStringAllocator.h"
+#include "velox/common/memory/Memory.h"
+
+DEFINE_int32(
+    hash_string_allocator_blocks,
+    100'000,
+    "The number of live blocks, e.g. accumulators, in the allocator");
+DEFINE_int32(
+    hash_string_allocator_rounds,
+    10,
+    "The number of times each live block is freed and reallocated");
+
+using namespace facebook::velox;
+
+namespace {
+
+// Simulates array_agg style accumulators: many live small blocks that are
+// repeatedly freed and reallocated with a different size as they grow.
+size_t runSmallAllocations(bool cacheSmallBlocks, int32_t maxSize) {
+  auto pool = memory::addDefaultLeafMemoryPool();
+  HashStringAllocator allocator(pool.get(), cacheSmallBlocks);
+  folly::Random::DefaultGenerator rng(1);
+  std::vector<HashStringAllocator::Header*> blocks(
+      FLAGS_hash_string_allocator_blocks);
+  for (auto& block : blocks) {
+    block = allocator.allocate(1 + folly::Random::rand32(rng) % maxSize);
+  }
+  for (auto round = 0; round < FLAGS_hash_string_allocator_rounds; ++round) {
+    for (auto& block : blocks) {
+      allocator.free(block);
+      block = allocator.allocate(1 + folly::Random::rand32(rng) % maxSize);
+    }
+  }
+  for (auto block : blocks) {
+    allocator.free(block);
+  }
+  return static_cast<size_t>(FLAGS_hash_string_allocator_blocks) *
+      FLAGS_hash_string_allocator_rounds;
+}
+
+BENCHMARK_MULTI(freeListsSmall) {
+  return runSmallAllocations(false, 64);
+}
+
+BENCHMARK_RELATIVE_MULTI(cachedSmall) {
+  return runSmallAllocations(true, 64);
+}
+
+BENCHMARK_MULTI(freeListsMaxCached) {
+  return runSmallAllocations(false, HashStringAllocator::kMaxCachedSize);
+}
+
+BENCHMARK_RELATIVE_MULTI(cachedMaxCached) {
+  return runSmallAllocations(true, HashStringAllocator::kMaxCachedSize);
+}
+
+BENCHMARK_MULTI(freeListsMixed) {
+  return runSmallAllocations(false, 1'000);
+}
+
+BENCHMARK_RELATIVE_MULTI(cachedMixed) {
+  return runSmallAllocations(true, 1'000);
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -21,6 +21,7 @@
 #include <folly/futures/Future.h>
 #include <functional>
 #include <memory>
+#include <vector>
 #include "velox/common/time/CpuWallTimer.h"
 
 #include "velox/common/base/Exceptions.h"
@@ -65,6 +66,7 @@ class AsyncSource {
       exception_ = std::current_exception();
     }
     std::unique_ptr<ContinuePromise> promise;
+    std::vector<ContinuePromise> readyPromises;
     {
       std::lock_guard<std::mutex> l(mutex_);
       VELOX_CHECK_NULL(item_);
@@ -73,10 +75,29 @@ class AsyncSource {
       }
       making_ = false;
       promise.swap(promise_);
+      readyPromises.swap(readyPromises_);
     }
     if (promise != nullptr) {
       promise->setValue();
     }
+    for (auto& readyPromise : readyPromises) {
+      readyPromise.setValue();
+    }
+  }
+
+  // Returns true if move() will not wait for prepare() on the executor.
+  // Otherwise returns false and sets 'future' to be realized when the item is
+  // made, so that the caller can wait for it without blocking its thread. An
+  // item that the executor has not started to make is made by move() on the
+  // caller thread.
+  bool readyOrWait(ContinueFuture& future) {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!making_) {
+      return true;
+    }
+    readyPromises_.emplace_back("AsyncSource::readyOrWait");
+    future = readyPromises_.back().getSemiFuture();
+    return false;
   }
 
   // Returns the item to the first caller and nullptr to subsequent callers. If
@@ -130,6 +151,27 @@ class AsyncSource {
     return std::move(item_);
   }
 
+  // Drops the item if it has not been made and waits for it if it is being
+  // made on the executor. move() returns nullptr after this.
+  void close() {
+    ContinueFuture wait;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      make_ = nullptr;
+      if (making_ && !promise_) {
+        promise_ = std::make_unique<ContinuePromise>();
+        wait = promise_->getSemiFuture();
+      }
+    }
+    if (wait.valid()) {
+      auto& exec = folly::QueuedImmediateExecutor::instance();
+      std::move(wait).via(&exec).wait();
+    }
+    std::lock_guard<std::mutex> l(mutex_);
+    item_ = nullptr;
+    exception_ = nullptr;
+  }
+
   // If true, move() will not block. But there is no guarantee that somebody
   // else will not get the item first.
   bool hasValue() const {
@@ -149,6 +191,8 @@ class AsyncSource {
   // True if 'prepare() is making the item.
   bool making_{false};
   std::unique_ptr<ContinuePromise> promise_;
+  // Realized when prepare() is done, for callers of readyOrWait().
+  std::vector<ContinuePromise> readyPromises_;
   std::unique_ptr<Item> item_;
   std::function<std::unique_ptr<Item>()> make_;
   std::exception_ptr exception_;
@@ -22,6 +22,7 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/IOUtils.h"
+#include "velox/common/base/SimdUtil.h"
 
 namespace facebook::velox {
 // BloomFilter filter with groups of 64 bits, of which 4 are set. The hash
@@ -61,6 +62,25 @@ class BloomFilter {
     return test(bits_.data(), bits_.size(), value);
   }
 
+  // Same as mayContain() for a batch of hashed values. The words of all lanes
+  // are gathered at once and tested against the masks computed in parallel.
+  xsimd::batch_bool<int64_t> mayContain(xsimd::batch<int64_t> values) const {
+    using Batch = xsimd::batch<int64_t>;
+    const Batch kLowBits(63);
+    const Batch kOne(1);
+    // The shifts are arithmetic but only bits below the sign extension are
+    // used.
+    const auto mask = (kOne << (values & kLowBits)) |
+        (kOne << ((values >> 6) & kLowBits)) |
+        (kOne << ((values >> 12) & kLowBits)) |
+        (kOne << ((values >> 18) & kLowBits));
+    const auto index =
+        (values >> 24) & Batch(static_cast<int64_t>(bits_.size()) - 1);
+    const auto words =
+        simd::gather(reinterpret_cast<const int64_t*>(bits_.data()), index);
+    return (words & mask) == mask;
+  }
+
   void merge(const char* serialized) {
     common::InputByteStream stream(serialized);
     auto version = stream.read<int8_t>();
@@ -24,6 +24,32 @@ void registerVeloxCounters() {
   // P50, P90, P99, and P100.
   REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
       kCounterHiveFileHandleGenerateLatencyMs, 10, 0, 100000, 50, 90, 99, 100);
+
+  // Track arbitration queue time in range of [0, 600s] and reports P50, P90,
+  // P99, and P100.
+  REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
+      kCounterArbitratorQueueTimeMs, 1000, 0, 600000, 50, 90, 99, 100);
+
+  REPORT_ADD_STAT_EXPORT_TYPE(kCounterSpillWriteBytes, StatType::RATE);
+
+  // Track spill write time in range of [0, 10s] and reports P50, P90, P99,
+  // and P100.
+  REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
+      kCounterSpillWriteTimeMs, 10, 0, 10000, 50, 90, 99, 100);
+
+  REPORT_ADD_STAT_EXPORT_TYPE(kCounterCacheMemoryHitBytes, StatType::RATE);
+  REPORT_ADD_STAT_EXPORT_TYPE(kCounterCacheSsdHitBytes, StatType::RATE);
+  REPORT_ADD_STAT_EXPORT_TYPE(kCounterCacheStorageReadBytes, StatType::RATE);
+
+  REPORT_ADD_STAT_EXPORT_TYPE(kCounterExchangeQueueBytes, StatType::AVG);
+
+  // Track driver queue time in range of [0, 60s] and reports P50, P90, P99,
+  // and P100.
+  REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
+      kCounterDriverQueueTimeMs, 10, 0, 60000, 50, 90, 99, 100);
+
+  // The blocked time histograms per BlockingReason are registered by the
+  // Driver on first use since the reasons are defined in velox/exec.
 }
 
 } // namespace facebook::velox
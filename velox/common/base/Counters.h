@@ -25,4 +25,41 @@ void registerVeloxCounters();
 
 constexpr folly::StringPiece kCounterHiveFileHandleGenerateLatencyMs{
     "velox.hive_file_handle_generate_latency_ms"};
+
+/// Time a memory arbitration request waits for the running arbitration of
+/// another request.
+constexpr folly::StringPiece kCounterArbitratorQueueTimeMs{
+    "velox.arbitrator_queue_time_ms"};
+
+/// Bytes written to spill files. Exported as a rate.
+constexpr folly::StringPiece kCounterSpillWriteBytes{
+    "velox.spill_write_bytes"};
+
+/// Time to write one serialized buffer to a spill file.
+constexpr folly::StringPiece kCounterSpillWriteTimeMs{
+    "velox.spill_write_time_ms"};
+
+/// Bytes of file reads served by each tier of the cache. The hit ratio of a
+/// tier is its share of the total of the three.
+constexpr folly::StringPiece kCounterCacheMemoryHitBytes{
+    "velox.cache_memory_hit_bytes"};
+
+constexpr folly::StringPiece kCounterCacheSsdHitBytes{
+    "velox.cache_ssd_hit_bytes"};
+
+constexpr folly::StringPiece kCounterCacheStorageReadBytes{
+    "velox.cache_storage_read_bytes"};
+
+/// Bytes queued in an exchange queue after a page is added.
+constexpr folly::StringPiece kCounterExchangeQueueBytes{
+    "velox.exchange_queue_bytes"};
+
+/// Time a driver waits in the executor queue before it runs.
+constexpr folly::StringPiece kCounterDriverQueueTimeMs{
+    "velox.driver_queue_time_ms"};
+
+/// Time a driver is blocked. Reported under this key followed by '.' and the
+/// BlockingReason, e.g. velox.driver_blocked_time_ms.kWaitForProducer.
+constexpr folly::StringPiece kCounterDriverBlockedTimeMs{
+    "velox.driver_blocked_time_ms"};
 } // namespace facebook::velox
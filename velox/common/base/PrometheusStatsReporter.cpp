@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/PrometheusStatsReporter.h"
+
+#include <fmt/format.h>
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+#include <shared_mutex>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox {
+namespace {
+
+std::string_view toView(folly::StringPiece key) {
+  return std::string_view(key.data(), key.size());
+}
+
+// Returns 'key' with the characters that are not allowed in Prometheus metric
+// names replaced by '_'.
+std::string prometheusName(const std::string& key) {
+  std::string name = key;
+  for (auto i = 0; i < name.size(); ++i) {
+    const char c = name[i];
+    if (!(std::isalnum(c) || c == '_' || c == ':') ||
+        (i == 0 && std::isdigit(c))) {
+      name[i] = '_';
+    }
+  }
+  return name;
+}
+
+template <typename Map>
+std::vector<typename Map::const_iterator> sortedByKey(const Map& map) {
+  std::vector<typename Map::const_iterator> entries;
+  entries.reserve(map.size());
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    entries.push_back(it);
+  }
+  std::sort(entries.begin(), entries.end(), [](auto left, auto right) {
+    return left->first < right->first;
+  });
+  return entries;
+}
+
+} // namespace
+
+PrometheusStatsReporter::Histogram::Histogram(
+    int64_t _bucketWidth,
+    int64_t _min,
+    int64_t _max,
+    std::vector<int32_t> _pcts)
+    : bucketWidth(_bucketWidth),
+      min(_min),
+      max(_max),
+      pcts(std::move(_pcts)),
+      buckets((_max - _min + _bucketWidth - 1) / _bucketWidth + 2) {}
+
+void PrometheusStatsReporter::Histogram::add(int64_t value) {
+  size_t index;
+  if (value < min) {
+    index = 0;
+  } else if (value >= max) {
+    index = buckets.size() - 1;
+  } else {
+    index = (value - min) / bucketWidth + 1;
+  }
+  buckets[index].fetch_add(1, std::memory_order_relaxed);
+  sum.fetch_add(value, std::memory_order_relaxed);
+  count.fetch_add(1, std::memory_order_relaxed);
+}
+
+int64_t PrometheusStatsReporter::Histogram::percentile(int32_t pct) const {
+  const auto total = count.load(std::memory_order_relaxed);
+  if (total == 0) {
+    return 0;
+  }
+  // The rank of the value at 'pct', at least 1.
+  const auto rank = std::max<int64_t>(1, (total * pct + 99) / 100);
+  int64_t cumulative = 0;
+  for (auto i = 0; i < buckets.size(); ++i) {
+    cumulative += buckets[i].load(std::memory_order_relaxed);
+    if (cumulative >= rank) {
+      return std::min(max, min + static_cast<int64_t>(i) * bucketWidth);
+    }
+  }
+  return max;
+}
+
+void PrometheusStatsReporter::addStatExportType(
+    folly::StringPiece key,
+    StatType statType) const {
+  std::unique_lock<folly::SharedMutex> l(mutex_);
+  stats_.try_emplace(key.str(), std::make_unique<Stat>(statType));
+}
+
+void PrometheusStatsReporter::addHistogramExportPercentiles(
+    folly::StringPiece key,
+    int64_t bucketWidth,
+    int64_t min,
+    int64_t max,
+    const std::vector<int32_t>& pcts) const {
+  VELOX_CHECK_GT(bucketWidth, 0);
+  VELOX_CHECK_LT(min, max);
+  for (auto pct : pcts) {
+    VELOX_CHECK(pct >= 0 && pct <= 100, "Bad percentile: {}", pct);
+  }
+  std::unique_lock<folly::SharedMutex> l(mutex_);
+  histograms_.try_emplace(
+      key.str(), std::make_unique<Histogram>(bucketWidth, min, max, pcts));
+}
+
+void PrometheusStatsReporter::addStatValue(folly::StringPiece key, size_t value)
+    const {
+  std::shared_lock<folly::SharedMutex> l(mutex_);
+  auto it = stats_.find(toView(key));
+  if (it == stats_.end()) {
+    return;
+  }
+  it->second->sum.fetch_add(value, std::memory_order_relaxed);
+  it->second->count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PrometheusStatsReporter::addHistogramValue(
+    folly::StringPiece key,
+    size_t value) const {
+  std::shared_lock<folly::SharedMutex> l(mutex_);
+  auto it = histograms_.find(toView(key));
+  if (it == histograms_.end()) {
+    return;
+  }
+  it->second->add(value);
+}
+
+int64_t PrometheusStatsReporter::histogramPercentile(
+    folly::StringPiece key,
+    int32_t pct) const {
+  std::shared_lock<folly::SharedMutex> l(mutex_);
+  auto it = histograms_.find(toView(key));
+  VELOX_CHECK(it != histograms_.end(), "Histogram not registered: {}", key);
+  return it->second->percentile(pct);
+}
+
+std::string PrometheusStatsReporter::toPrometheusText() const {
+  std::string out;
+  std::shared_lock<folly::SharedMutex> l(mutex_);
+  for (const auto& it : sortedByKey(stats_)) {
+    const auto name = prometheusName(it->first);
+    const auto& stat = *it->second;
+    const auto sum = stat.sum.load(std::memory_order_relaxed);
+    if (stat.type == StatType::AVG) {
+      const auto count = stat.count.load(std::memory_order_relaxed);
+      out += fmt::format(
+          "# TYPE {} gauge\n{} {}\n",
+          name,
+          name,
+          count == 0 ? 0.0 : static_cast<double>(sum) / count);
+    } else {
+      out += fmt::format("# TYPE {} counter\n{} {}\n", name, name, sum);
+    }
+  }
+  for (const auto& it : sortedByKey(histograms_)) {
+    const auto name = prometheusName(it->first);
+    const auto& histogram = *it->second;
+    out += fmt::format("# TYPE {} summary\n", name);
+    for (auto pct : histogram.pcts) {
+      out += fmt::format(
+          "{}{{quantile=\"{}\"}} {}\n",
+          name,
+          pct / 100.0,
+          histogram.percentile(pct));
+    }
+    out += fmt::format(
+        "{}_sum {}\n{}_count {}\n",
+        name,
+        histogram.sum.load(std::memory_order_relaxed),
+        name,
+        histogram.count.load(std::memory_order_relaxed));
+  }
+  return out;
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/SharedMutex.h>
+#include <folly/container/F14Map.h>
+#include <atomic>
+#include <string_view>
+
+#include "velox/common/base/StatsReporter.h"
+
+namespace facebook::velox {
+
+/// A BaseStatsReporter that aggregates the stats in memory and renders them in
+/// the Prometheus text exposition format, e.g. for the metrics endpoint of a
+/// worker. Adding a value to a registered stat takes a shared lock and a few
+/// relaxed atomic increments, so that the stats can stay on in production.
+/// Values of stats that are not registered are ignored.
+///
+///   folly::Singleton<facebook::velox::BaseStatsReporter> reporter([]() {
+///     return new facebook::velox::PrometheusStatsReporter();
+///   });
+class PrometheusStatsReporter : public BaseStatsReporter {
+ public:
+  void addStatExportType(const char* key, StatType statType) const override {
+    addStatExportType(folly::StringPiece(key), statType);
+  }
+
+  void addStatExportType(folly::StringPiece key, StatType statType)
+      const override;
+
+  void addHistogramExportPercentiles(
+      const char* key,
+      int64_t bucketWidth,
+      int64_t min,
+      int64_t max,
+      const std::vector<int32_t>& pcts) const override {
+    addHistogramExportPercentiles(
+        folly::StringPiece(key), bucketWidth, min, max, pcts);
+  }
+
+  void addHistogramExportPercentiles(
+      folly::StringPiece key,
+      int64_t bucketWidth,
+      int64_t min,
+      int64_t max,
+      const std::vector<int32_t>& pcts) const override;
+
+  void addStatValue(const std::string& key, size_t value = 1) const override {
+    addStatValue(folly::StringPiece(key), value);
+  }
+
+  void addStatValue(const char* key, size_t value = 1) const override {
+    addStatValue(folly::StringPiece(key), value);
+  }
+
+  void addStatValue(folly::StringPiece key, size_t value = 1) const override;
+
+  void addHistogramValue(const std::string& key, size_t value) const override {
+    addHistogramValue(folly::StringPiece(key), value);
+  }
+
+  void addHistogramValue(const char* key, size_t value) const override {
+    addHistogramValue(folly::StringPiece(key), value);
+  }
+
+  void addHistogramValue(folly::StringPiece key, size_t value) const override;
+
+  /// Returns the registered stats in the Prometheus text format, sorted by
+  /// name. SUM, COUNT and RATE stats are counters of the total value, AVG
+  /// stats are gauges of the average value and histograms are summaries
+  /// with the registered percentiles as quantiles. Characters that
+  /// Prometheus does not allow in names, e.g. '.', are replaced by '_'.
+  std::string toPrometheusText() const;
+
+  /// Returns the estimated value at percentile 'pct' of histogram 'key', i.e.
+  /// the upper bound of the bucket the percentile falls in. Returns 0 if
+  /// there is no value.
+  int64_t histogramPercentile(folly::StringPiece key, int32_t pct) const;
+
+ private:
+  struct Stat {
+    explicit Stat(StatType _type) : type(_type) {}
+
+    const StatType type;
+    std::atomic<int64_t> sum{0};
+    std::atomic<int64_t> count{0};
+  };
+
+  struct Histogram {
+    Histogram(
+        int64_t _bucketWidth,
+        int64_t _min,
+        int64_t _max,
+        std::vector<int32_t> _pcts);
+
+    void add(int64_t value);
+
+    int64_t percentile(int32_t pct) const;
+
+    const int64_t bucketWidth;
+    const int64_t min;
+    const int64_t max;
+    const std::vector<int32_t> pcts;
+    // Bucket 0 counts the values below 'min' and the last bucket the values
+    // at or above 'max'.
+    std::vector<std::atomic<int64_t>> buckets;
+    std::atomic<int64_t> sum{0};
+    std::atomic<int64_t> count{0};
+  };
+
+  mutable folly::SharedMutex mutex_;
+  mutable folly::F14FastMap<std::string, std::unique_ptr<Stat>> stats_;
+  mutable folly::F14FastMap<std::string, std::unique_ptr<Histogram>>
+      histograms_;
+};
+
+} // namespace facebook::velox
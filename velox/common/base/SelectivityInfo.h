@@ -47,6 +47,23 @@ class SelectivityInfo {
     return numOut_;
   }
 
+  /// Adds the rows and time of 'other'. Used for starting from the history of
+  /// earlier scans.
+  void add(const SelectivityInfo& other) {
+    numIn_ += other.numIn_;
+    numOut_ += other.numOut_;
+    timeClocks_ += other.timeClocks_;
+  }
+
+  /// Returns the rows and time added to 'this' since it was equal to 'base'.
+  SelectivityInfo since(const SelectivityInfo& base) const {
+    SelectivityInfo result;
+    result.numIn_ = numIn_ - base.numIn_;
+    result.numOut_ = numOut_ - base.numOut_;
+    result.timeClocks_ = timeClocks_ - base.timeClocks_;
+    return result;
+  }
+
  private:
   uint64_t numIn_ = 0;
   uint64_t numOut_ = 0;
@@ -1374,4 +1374,52 @@ inline bool memEqualUnsafe(const void* x, const void* y, int32_t size) {
   return true;
 }
 
+template <typename A>
+size_t simdStrstr(
+    const char* s,
+    size_t n,
+    const char* needle,
+    size_t k,
+    const A&) {
+  if (k == 0) {
+    return 0;
+  }
+  if (n < k) {
+    return std::string::npos;
+  }
+  if (k == 1) {
+    auto* found = static_cast<const char*>(::memchr(s, needle[0], n));
+    return found ? found - s : std::string::npos;
+  }
+  using Batch = xsimd::batch<uint8_t, A>;
+  constexpr size_t kBatch = Batch::size;
+  const auto first = xsimd::broadcast<uint8_t, A>(needle[0]);
+  const auto last = xsimd::broadcast<uint8_t, A>(needle[k - 1]);
+  size_t i = 0;
+  // The batch of last bytes for the positions from 'i' ends at
+  // i + k - 1 + kBatch.
+  for (; i + k - 1 + kBatch <= n; i += kBatch) {
+    auto firstBytes =
+        Batch::load_unaligned(reinterpret_cast<const uint8_t*>(s + i));
+    auto lastBytes =
+        Batch::load_unaligned(reinterpret_cast<const uint8_t*>(s + i + k - 1));
+    auto mask = toBitMask((firstBytes == first) & (lastBytes == last));
+    auto bits = static_cast<uint64_t>(
+        static_cast<std::make_unsigned_t<decltype(mask)>>(mask));
+    while (bits) {
+      auto offset = __builtin_ctzll(bits);
+      if (std::memcmp(s + i + offset + 1, needle + 1, k - 2) == 0) {
+        return i + offset;
+      }
+      bits &= bits - 1;
+    }
+  }
+  for (; i + k <= n; ++i) {
+    if (s[i] == needle[0] && std::memcmp(s + i + 1, needle + 1, k - 1) == 0) {
+      return i;
+    }
+  }
+  return std::string::npos;
+}
+
 } // namespace facebook::velox::simd
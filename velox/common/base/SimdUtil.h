@@ -17,6 +17,8 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <string>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 
@@ -355,6 +357,21 @@ uint32_t crc32U64(uint32_t checksum, uint64_t value, const A& arch = {}) {
   return detail::Crc32<uint64_t, A>::apply(checksum, value, arch);
 }
 
+// Lane-wise version of bits::hashMix(). Returns the same hashes as applying
+// bits::hashMix() to each pair of lanes.
+template <typename A = xsimd::default_arch>
+xsimd::batch<uint64_t, A> hashMix(
+    xsimd::batch<uint64_t, A> upper,
+    xsimd::batch<uint64_t, A> lower,
+    const A& = {}) {
+  const auto kMul = xsimd::broadcast<uint64_t, A>(0x9ddfea08eb382d69ULL);
+  auto a = (lower ^ upper) * kMul;
+  a ^= (a >> 47);
+  auto b = (upper ^ a) * kMul;
+  b ^= (b >> 47);
+  return b * kMul;
+}
+
 // Return a vector consisting {0, 1, ..., n} where 'n' is the number
 // of lanes.
 template <typename T, typename A = xsimd::default_arch>
@@ -430,6 +447,18 @@ xsimd::batch<T, A> reinterpretBatch(xsimd::batch<U, A>, const A& = {});
 template <typename A = xsimd::default_arch>
 inline bool memEqualUnsafe(const void* x, const void* y, int32_t size);
 
+// Returns the position of the first occurrence of 'needle' of 'k' bytes in
+// 's' of 'n' bytes or std::string::npos if there is none. Compares the first
+// and the last byte of 'needle' with a batch of positions at a time and
+// verifies the candidates with memcmp. Does not read past the end of 's'.
+template <typename A = xsimd::default_arch>
+size_t simdStrstr(
+    const char* s,
+    size_t n,
+    const char* needle,
+    size_t k,
+    const A& = {});
+
 } // namespace facebook::velox::simd
 
 #include "velox/common/base/SimdUtil-inl.h"
@@ -18,6 +18,7 @@
 #include <fmt/format.h>
 #include <folly/Random.h>
 #include <folly/Synchronized.h>
+#include <folly/synchronization/Baton.h>
 #include <gtest/gtest.h>
 #include <thread>
 #include "velox/common/base/Exceptions.h"
@@ -47,6 +48,36 @@ TEST(AsyncSourceTest, basic) {
   EXPECT_TRUE(error.hasValue());
 }
 
+TEST(AsyncSourceTest, readyOrWait) {
+  auto future = ContinueFuture::makeEmpty();
+  AsyncSource<Gizmo> notStarted([]() { return std::make_unique<Gizmo>(1); });
+  // Not being made on an executor, so move() makes it on the caller thread.
+  EXPECT_TRUE(notStarted.readyOrWait(future));
+  EXPECT_FALSE(future.valid());
+  EXPECT_EQ(1, notStarted.move()->id);
+
+  folly::Baton<> making;
+  folly::Baton<> release;
+  AsyncSource<Gizmo> gizmo([&]() {
+    making.post();
+    release.wait();
+    return std::make_unique<Gizmo>(2);
+  });
+  std::thread thread([&]() { gizmo.prepare(); });
+  making.wait();
+  EXPECT_FALSE(gizmo.readyOrWait(future));
+  ASSERT_TRUE(future.valid());
+  EXPECT_FALSE(future.isReady());
+  release.post();
+  std::move(future).via(&folly::QueuedImmediateExecutor::instance()).wait();
+  thread.join();
+  EXPECT_TRUE(gizmo.hasValue());
+  future = ContinueFuture::makeEmpty();
+  EXPECT_TRUE(gizmo.readyOrWait(future));
+  EXPECT_FALSE(future.valid());
+  EXPECT_EQ(2, gizmo.move()->id);
+}
+
 TEST(AsyncSourceTest, threads) {
   constexpr int32_t kNumThreads = 10;
   constexpr int32_t kNumGizmos = 2000;
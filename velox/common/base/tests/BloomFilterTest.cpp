@@ -42,6 +42,28 @@ TEST_F(BloomFilterTest, basic) {
   EXPECT_GT(2, 100 * numFalsePositives / kSize);
 }
 
+TEST_F(BloomFilterTest, batch) {
+  constexpr int32_t kSize = 1024;
+  constexpr auto kBatchSize = xsimd::batch<int64_t>::size;
+  BloomFilter bloom;
+  bloom.reset(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    bloom.insert(folly::hasher<int64_t>()(i));
+  }
+  // Values that are in the filter and values that mostly are not.
+  for (auto i = 0; i + kBatchSize <= 2 * kSize; i += kBatchSize) {
+    int64_t hashes[kBatchSize];
+    for (auto j = 0; j < kBatchSize; ++j) {
+      hashes[j] = folly::hasher<int64_t>()((i + j) * 7);
+    }
+    auto mask = simd::toBitMask(
+        bloom.mayContain(xsimd::batch<int64_t>::load_unaligned(hashes)));
+    for (auto j = 0; j < kBatchSize; ++j) {
+      EXPECT_EQ(bloom.mayContain(hashes[j]), ((mask >> j) & 1) != 0);
+    }
+  }
+}
+
 TEST_F(BloomFilterTest, serialize) {
   constexpr int32_t kSize = 1024;
   BloomFilter bloom;
@@ -320,6 +320,24 @@ TEST_F(SimdUtilTest, crc32) {
   EXPECT_EQ(checksum, 121285919);
 }
 
+TEST_F(SimdUtilTest, hashMix) {
+  constexpr auto kSize = xsimd::batch<uint64_t>::size;
+  uint64_t upper[kSize];
+  uint64_t lower[kSize];
+  for (auto i = 0; i < kSize; ++i) {
+    upper[i] = folly::Random::rand64();
+    lower[i] = folly::Random::rand64();
+  }
+  uint64_t mixed[kSize];
+  simd::hashMix(
+      xsimd::batch<uint64_t>::load_unaligned(upper),
+      xsimd::batch<uint64_t>::load_unaligned(lower))
+      .store_unaligned(mixed);
+  for (auto i = 0; i < kSize; ++i) {
+    EXPECT_EQ(bits::hashMix(upper[i], lower[i]), mixed[i]) << i;
+  }
+}
+
 TEST_F(SimdUtilTest, Batch64_assign) {
   auto b = simd::Batch64<int32_t>::from({0, 1});
   EXPECT_EQ(b.data[0], 0);
@@ -399,4 +417,24 @@ TEST_F(SimdUtilTest, memEqual) {
   EXPECT_FALSE(simd::memEqualUnsafe(&data.x[1], &data.y[1], 67));
 }
 
+TEST_F(SimdUtilTest, simdStrstr) {
+  // A small alphabet gives many partial matches.
+  auto randomString = [&](size_t size) {
+    std::string result;
+    for (auto i = 0; i < size; ++i) {
+      result.push_back('a' + folly::Random::rand32(rng_) % 3);
+    }
+    return result;
+  };
+  for (auto i = 0; i < 10'000; ++i) {
+    auto haystack = randomString(folly::Random::rand32(rng_) % 130);
+    auto needle = randomString(folly::Random::rand32(rng_) % 7);
+    ASSERT_EQ(
+        haystack.find(needle),
+        simd::simdStrstr(
+            haystack.data(), haystack.size(), needle.data(), needle.size()))
+        << haystack << " " << needle;
+  }
+}
+
 } // namespace
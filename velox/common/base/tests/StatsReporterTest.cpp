@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/base/StatsReporter.h"
+#include "velox/common/base/PrometheusStatsReporter.h"
 #include <folly/Singleton.h>
 #include <folly/init/Init.h>
 #include <gtest/gtest.h>
@@ -121,6 +122,42 @@ TEST_F(StatsReporterTest, trivialReporter) {
   EXPECT_EQ(100, reporter->counterMap["key4"]);
 };
 
+TEST_F(StatsReporterTest, prometheusReporter) {
+  PrometheusStatsReporter reporter;
+  reporter.addStatExportType("velox.sum", StatType::SUM);
+  reporter.addStatExportType("velox.avg", StatType::AVG);
+  reporter.addHistogramExportPercentiles(
+      "velox.latency_ms", 10, 0, 100, {50, 90, 100});
+
+  reporter.addStatValue("velox.sum", 10);
+  reporter.addStatValue("velox.sum");
+  reporter.addStatValue("velox.avg", 10);
+  reporter.addStatValue("velox.avg", 20);
+  reporter.addStatValue("velox.unregistered", 5);
+  for (auto i = 0; i < 100; ++i) {
+    reporter.addHistogramValue("velox.latency_ms", i);
+  }
+  // Values out of range go to the first and last buckets.
+  reporter.addHistogramValue("velox.latency_ms", 1'000);
+
+  // Percentiles are the upper bounds of their buckets.
+  EXPECT_EQ(60, reporter.histogramPercentile("velox.latency_ms", 50));
+  EXPECT_EQ(100, reporter.histogramPercentile("velox.latency_ms", 90));
+  EXPECT_EQ(100, reporter.histogramPercentile("velox.latency_ms", 100));
+  EXPECT_EQ(
+      "# TYPE velox_avg gauge\n"
+      "velox_avg 15\n"
+      "# TYPE velox_sum counter\n"
+      "velox_sum 11\n"
+      "# TYPE velox_latency_ms summary\n"
+      "velox_latency_ms{quantile=\"0.5\"} 60\n"
+      "velox_latency_ms{quantile=\"0.9\"} 100\n"
+      "velox_latency_ms{quantile=\"1\"} 100\n"
+      "velox_latency_ms_sum 5950\n"
+      "velox_latency_ms_count 101\n",
+      reporter.toPrometheusText());
+}
+
 // Registering to folly Singleton with intended reporter type
 folly::Singleton<BaseStatsReporter> reporter([]() {
   return new TestReporter();
@@ -18,7 +18,10 @@
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 
+#include <folly/container/F14Set.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
+#include <folly/io/IOBuf.h>
+#include <thread>
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
 
@@ -27,6 +30,51 @@ namespace facebook::velox::cache {
 using memory::MachinePageCount;
 using memory::MemoryAllocator;
 
+namespace {
+// Returns the first 'size' bytes of 'data' as a chain of IOBufs that do not
+// own their memory.
+std::unique_ptr<folly::IOBuf> wrapRuns(
+    const memory::Allocation& data,
+    uint64_t size) {
+  std::unique_ptr<folly::IOBuf> result;
+  uint64_t offset = 0;
+  for (auto i = 0; i < data.numRuns() && offset < size; ++i) {
+    const auto run = data.runAt(i);
+    const auto bytes = std::min<uint64_t>(run.numBytes(), size - offset);
+    auto buffer = folly::IOBuf::wrapBuffer(run.data(), bytes);
+    if (result == nullptr) {
+      result = std::move(buffer);
+    } else {
+      result->prependChain(std::move(buffer));
+    }
+    offset += bytes;
+  }
+  VELOX_CHECK_EQ(offset, size);
+  return result;
+}
+
+// Copies the bytes of 'data' to the start of the runs of 'allocation'.
+void copyToRuns(const folly::IOBuf& data, memory::Allocation& allocation) {
+  int32_t runIndex = 0;
+  uint64_t offsetInRun = 0;
+  for (auto range : data) {
+    while (!range.empty()) {
+      VELOX_CHECK_LT(runIndex, allocation.numRuns());
+      const auto run = allocation.runAt(runIndex);
+      const auto bytes =
+          std::min<uint64_t>(range.size(), run.numBytes() - offsetInRun);
+      memcpy(run.data<char>() + offsetInRun, range.data(), bytes);
+      range.advance(bytes);
+      offsetInRun += bytes;
+      if (offsetInRun == run.numBytes()) {
+        ++runIndex;
+        offsetInRun = 0;
+      }
+    }
+  }
+}
+} // namespace
+
 AsyncDataCacheEntry::AsyncDataCacheEntry(CacheShard* shard) : shard_(shard) {
   accessStats_.reset();
 }
@@ -40,7 +88,7 @@ void AsyncDataCacheEntry::setExclusiveToShared() {
   numPins_ = 1;
   std::unique_ptr<folly::SharedPromise<bool>> promise;
   {
-    std::lock_guard<std::mutex> l(shard_->mutex());
+    std::lock_guard<folly::SharedMutex> l(shard_->mutex());
     // Enter the shard's mutex to make sure a promise is not being added during
     // the move.
     promise = std::move(promise_);
@@ -152,10 +200,18 @@ CachePin CacheShard::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
+  if (auto pin = findShared(key, size); !pin.empty()) {
+    return pin;
+  }
   AsyncDataCacheEntry* entryToInit = nullptr;
+  // Set if the new entry is filled from the compressed tier.
+  std::optional<CompressedEntry> compressed;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    auto l = lockAndMeasureWait();
     ++eventCounter_;
+    if (admissionPolicy_ != nullptr) {
+      admissionPolicy_->recordAccess(std::hash<RawFileCacheKey>()(key));
+    }
     auto it = entryMap_.find(key);
     if (it != entryMap_.end()) {
       auto* found = it->second;
@@ -177,6 +233,10 @@ CachePin CacheShard::findOrCreate(
           ++numHit_;
           hitBytes_ += found->size();
         }
+        if (found->retainedByPolicy_) {
+          found->retainedByPolicy_ = false;
+          ++numPolicyRetainHits_;
+        }
         ++found->numPins_;
         CachePin pin;
         pin.setEntry(found);
@@ -195,6 +255,9 @@ CachePin CacheShard::findOrCreate(
       found->key_.fileNum.clear();
     }
 
+    if (!compressed_.empty()) {
+      compressed = takeCompressedLocked(key, size);
+    }
     auto newEntry = getFreeEntry();
     // Initialize the members that must be set inside 'mutex_'.
     newEntry->numPins_ = AsyncDataCacheEntry::kExclusive;
@@ -208,28 +271,70 @@ CachePin CacheShard::findOrCreate(
       emptySlots_.pop_back();
       entries_[index] = std::move(newEntry);
     }
-    ++numNew_;
+    if (compressed.has_value()) {
+      ++numCompressedHit_;
+    } else {
+      ++numNew_;
+    }
     // Inside the shard mutex.
     VELOX_CHECK_EQ(entryToInit->size_, 0);
-    entryToInit->size_ = size;
+    entryToInit->size_ = compressed.has_value() ? compressed->size : size;
     entryToInit->isFirstUse_ = true;
+    entryToInit->scanHint_ = false;
+    entryToInit->retainedByPolicy_ = false;
   }
-  return initEntry(key, entryToInit);
+  return initEntry(
+      key, entryToInit, compressed.has_value() ? &compressed.value() : nullptr);
+}
+
+CachePin CacheShard::findShared(RawFileCacheKey key, uint64_t size) {
+  std::shared_lock<folly::SharedMutex> l(mutex_);
+  if (admissionPolicy_ != nullptr) {
+    // The policy records each access and is not thread safe.
+    return CachePin();
+  }
+  auto it = entryMap_.find(key);
+  if (it == entryMap_.end()) {
+    return CachePin();
+  }
+  auto* found = it->second;
+  // The first use of a prefetched entry changes its state. An exclusive entry
+  // needs a promise to wait for. Both go through the exclusive path.
+  if (found->size() < size || found->isPrefetch() ||
+      found->retainedByPolicy_) {
+    return CachePin();
+  }
+  // The entry can go from exclusive to shared, but not back, while 'mutex_'
+  // is held.
+  auto numPins = found->numPins_.load();
+  do {
+    if (numPins == AsyncDataCacheEntry::kExclusive) {
+      return CachePin();
+    }
+  } while (!found->numPins_.compare_exchange_weak(numPins, numPins + 1));
+  ++eventCounter_;
+  found->touch();
+  numHit_.fetch_add(1, std::memory_order_relaxed);
+  hitBytes_.fetch_add(found->size(), std::memory_order_relaxed);
+  CachePin pin;
+  pin.setEntry(found);
+  return pin;
 }
 
 bool CacheShard::exists(RawFileCacheKey key) const {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::shared_lock<folly::SharedMutex> l(mutex_);
   auto it = entryMap_.find(key);
   if (it != entryMap_.end()) {
     it->second->touch();
     return true;
   }
-  return false;
+  return compressed_.contains(key);
 }
 
 CachePin CacheShard::initEntry(
     RawFileCacheKey key,
-    AsyncDataCacheEntry* entry) {
+    AsyncDataCacheEntry* entry,
+    const CompressedEntry* compressed) {
   // The new entry is in the map and is in exclusive mode and is otherwise
   // uninitialized. Other threads may find it and may add a promise or wait for
   // a promise that another one has added. The new entry is otherwise volatile
@@ -237,9 +342,24 @@ CachePin CacheShard::initEntry(
   // can be set outside of 'mutex_'.
   entry->initialize(
       FileCacheKey{StringIdLease(fileIds(), key.fileNum), key.offset});
-  cache_->incrementNew(entry->size());
   CachePin pin;
   pin.setEntry(entry);
+  if (compressed == nullptr) {
+    cache_->incrementNew(entry->size());
+    return pin;
+  }
+  auto codec = common::compressionKindToCodec(compressed->compressionKind);
+  auto input = folly::IOBuf::wrapBufferAsValue(
+      compressed->data.data(), compressed->data.size());
+  const auto uncompressed = codec->uncompress(&input, entry->size());
+  VELOX_CHECK_EQ(uncompressed->computeChainDataLength(), entry->size());
+  copyToRuns(*uncompressed, entry->data());
+  entry->setGroupId(compressed->groupId);
+  entry->setTrackingId(compressed->trackingId);
+  if (compressed->ssdFile != nullptr) {
+    entry->setSsdFile(compressed->ssdFile, compressed->ssdOffset);
+  }
+  entry->setExclusiveToShared();
   return pin;
 }
 
@@ -300,7 +420,7 @@ void CoalescedLoad::setEndState(State endState) {
 
 std::unique_ptr<folly::SharedPromise<bool>> CacheShard::removeEntry(
     AsyncDataCacheEntry* entry) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   removeEntryLocked(entry);
   // After the entry is removed from the hash table, a promise can no longer
   // be made. It is safe to move the promise and realize it.
@@ -331,6 +451,15 @@ void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
   }
 }
 
+std::unique_lock<folly::SharedMutex> CacheShard::lockAndMeasureWait() {
+  std::unique_lock<folly::SharedMutex> l(mutex_, std::try_to_lock);
+  if (!l.owns_lock()) {
+    ClockTimer t(lockWaitClocks_);
+    l.lock();
+  }
+  return l;
+}
+
 void CacheShard::evict(
     uint64_t bytesToFree,
     bool evictAllUnpinned,
@@ -343,8 +472,14 @@ void CacheShard::evict(
   bool skipSsdSaveable = ssdCache && ssdCache->writeInProgress();
   auto now = accessTime();
   std::vector<memory::Allocation> toFree;
+  std::vector<ToCompress> toCompress;
+  common::CompressionKind compressionKind;
+  double maxCompressedRatio;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    auto l = lockAndMeasureWait();
+    ClockTimer evictTimer(evictClocks_);
+    compressionKind = compressedTier_.compressionKind;
+    maxCompressedRatio = compressedTier_.maxCompressedRatio;
     int size = entries_.size();
     if (!size) {
       return;
@@ -378,13 +513,26 @@ void CacheShard::evict(
       int32_t score = 0;
       if (candidate->numPins_ == 0 &&
           (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
-           (score = candidate->score(now)) >= evictionThreshold_)) {
+           shouldEvictLocked(candidate, score = candidate->score(now)))) {
         if (skipSsdSaveable && candidate->ssdSaveable_ && !evictAllUnpinned) {
           ++evictSaveableSkipped;
           continue;
         }
         largeFreed += candidate->data_.byteSize();
-        if (pagesToAcquire > 0) {
+        if (!evictAllUnpinned && shouldCompressLocked(*candidate)) {
+          toCompress.push_back(ToCompress{
+              CompressedEntry{
+                  candidate->key_,
+                  candidate->size_,
+                  compressionKind,
+                  {},
+                  candidate->groupId_,
+                  candidate->trackingId_,
+                  candidate->ssdFile_,
+                  candidate->ssdOffset_,
+                  0},
+              std::move(candidate->data())});
+        } else if (pagesToAcquire > 0) {
           auto candidatePages = candidate->data().numPages();
           pagesToAcquire = candidatePages > pagesToAcquire
               ? 0
@@ -411,10 +559,26 @@ void CacheShard::evict(
       }
     }
   }
-  ClockTimer t(allocClocks_);
-  freeAllocations(toFree);
+  std::vector<CompressedEntry> compressed;
+  double compressionRatio = 0;
+  if (!toCompress.empty()) {
+    compressed = compress(
+        toCompress,
+        compressionKind,
+        maxCompressedRatio,
+        toFree,
+        compressionRatio);
+  }
+  {
+    ClockTimer t(allocClocks_);
+    freeAllocations(toFree);
+  }
   cache_->incrementCachedPages(
       -largeFreed / static_cast<int32_t>(memory::AllocationTraits::kPageSize));
+  if (!toCompress.empty()) {
+    addCompressed(
+        std::move(compressed), toCompress.size(), compressionRatio);
+  }
   if (evictSaveableSkipped && ssdCache && ssdCache->startWrite()) {
     // Rare. May occur if SSD is unusually slow. Useful for  diagnostics.
     VELOX_SSD_CACHE_LOG(INFO)
@@ -426,6 +590,179 @@ void CacheShard::evict(
   }
 }
 
+bool CacheShard::shouldCompressLocked(const AsyncDataCacheEntry& entry) {
+  if (compressedTier_.capacity == 0 || !entry.key_.fileNum.hasValue() ||
+      entry.data_.numPages() == 0 ||
+      entry.size_ * compressedTier_.maxCompressedRatio >
+          compressedTier_.capacity) {
+    return false;
+  }
+  if (compressionRatio_ > compressedTier_.maxCompressedRatio) {
+    // The recent entries did not compress well. Compress a sample to notice
+    // when they do.
+    return ++numCompressSkips_ % kCompressSampleInterval == 0;
+  }
+  return true;
+}
+
+std::vector<CacheShard::CompressedEntry> CacheShard::compress(
+    std::vector<ToCompress>& toCompress,
+    common::CompressionKind compressionKind,
+    double maxCompressedRatio,
+    std::vector<memory::Allocation>& toFree,
+    double& compressionRatio) {
+  auto codec = common::compressionKindToCodec(compressionKind);
+  std::vector<CompressedEntry> compressed;
+  uint64_t rawBytes = 0;
+  uint64_t compressedBytes = 0;
+  for (auto& [entry, data] : toCompress) {
+    auto output = codec->compress(wrapRuns(data, entry.size).get());
+    toFree.push_back(std::move(data));
+    const auto size = output->computeChainDataLength();
+    rawBytes += entry.size;
+    compressedBytes += size;
+    if (size > entry.size * maxCompressedRatio) {
+      continue;
+    }
+    // Copy to a string of the compressed size. The codec's output buffer has
+    // space for the worst case.
+    entry.data.reserve(size);
+    for (const auto range : *output) {
+      entry.data.append(
+          reinterpret_cast<const char*>(range.data()), range.size());
+    }
+    compressed.push_back(std::move(entry));
+  }
+  compressionRatio = static_cast<double>(compressedBytes) / rawBytes;
+  return compressed;
+}
+
+void CacheShard::addCompressed(
+    std::vector<CompressedEntry> entries,
+    int32_t numAttempts,
+    double compressionRatio) {
+  std::lock_guard<folly::SharedMutex> l(mutex_);
+  numCompressRejects_ += numAttempts - entries.size();
+  compressionRatio_ = compressionRatio_ == 0
+      ? compressionRatio
+      : 0.75 * compressionRatio_ + 0.25 * compressionRatio;
+  if (compressedTier_.capacity == 0) {
+    return;
+  }
+  for (auto& entry : entries) {
+    const RawFileCacheKey key{entry.key.fileNum.id(), entry.key.offset};
+    // The entry may have been loaded again or superseded while compressing.
+    if (entryMap_.contains(key) || compressed_.contains(key)) {
+      continue;
+    }
+    entry.sequence = ++compressedSequence_;
+    compressedOrder_.emplace_back(key, entry.sequence);
+    compressedBytes_ += entry.data.size();
+    compressedRawBytes_ += entry.size;
+    compressed_.emplace(key, std::move(entry));
+  }
+  trimCompressedLocked();
+}
+
+std::optional<CacheShard::CompressedEntry> CacheShard::takeCompressedLocked(
+    RawFileCacheKey key,
+    uint64_t size) {
+  auto it = compressed_.find(key);
+  if (it == compressed_.end()) {
+    return std::nullopt;
+  }
+  auto entry = std::move(it->second);
+  compressed_.erase(it);
+  compressedBytes_ -= entry.data.size();
+  compressedRawBytes_ -= entry.size;
+  if (entry.size < size) {
+    return std::nullopt;
+  }
+  return entry;
+}
+
+void CacheShard::trimCompressedLocked() {
+  const auto isStale = [&](const auto& element) {
+    auto it = compressed_.find(element.first);
+    return it == compressed_.end() || it->second.sequence != element.second;
+  };
+  if (compressedOrder_.size() > 2 * compressed_.size() + 1'000) {
+    std::erase_if(compressedOrder_, isStale);
+  }
+  while (!compressedOrder_.empty() &&
+         compressedBytes_ > compressedTier_.capacity) {
+    const auto element = compressedOrder_.front();
+    compressedOrder_.pop_front();
+    if (isStale(element)) {
+      // The entry has been hit or dropped.
+      continue;
+    }
+    auto it = compressed_.find(element.first);
+    compressedBytes_ -= it->second.data.size();
+    compressedRawBytes_ -= it->second.size;
+    compressed_.erase(it);
+  }
+}
+
+void CacheShard::setCompressedTier(const CompressedTierOptions& options) {
+  // Throws if there is no codec for the compression kind.
+  common::compressionKindToCodec(options.compressionKind);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
+  compressedTier_ = options;
+  compressionRatio_ = 0;
+  trimCompressedLocked();
+}
+
+void CacheShard::clearCompressed() {
+  std::lock_guard<folly::SharedMutex> l(mutex_);
+  compressed_.clear();
+  compressedOrder_.clear();
+  compressedBytes_ = 0;
+  compressedRawBytes_ = 0;
+}
+
+bool CacheShard::shouldEvictLocked(AsyncDataCacheEntry* entry, int32_t score) {
+  const bool evictByScore = score >= evictionThreshold_;
+  if (admissionPolicy_ == nullptr) {
+    return evictByScore;
+  }
+  const bool evict = admissionPolicy_->shouldEvict(
+      std::hash<RawFileCacheKey>()(
+          RawFileCacheKey{entry->key_.fileNum.id(), entry->key_.offset}),
+      entry->scanHint_,
+      evictByScore);
+  if (evict && !evictByScore) {
+    ++numPolicyRejects_;
+  } else if (!evict && evictByScore) {
+    ++numPolicyRetains_;
+    entry->retainedByPolicy_ = true;
+  }
+  return evict;
+}
+
+void CacheShard::forEachLoadedEntry(
+    const std::function<void(RawFileCacheKey key, uint64_t size)>& func)
+    const {
+  std::shared_lock<folly::SharedMutex> l(mutex_);
+  for (const auto& entry : entries_) {
+    if (entry != nullptr && entry->key_.fileNum.hasValue() &&
+        !entry->isExclusive()) {
+      func(
+          RawFileCacheKey{entry->key_.fileNum.id(), entry->key_.offset},
+          entry->size_);
+    }
+  }
+  for (const auto& [key, entry] : compressed_) {
+    func(key, entry.size);
+  }
+}
+
+void CacheShard::setAdmissionPolicy(
+    std::unique_ptr<CacheAdmissionPolicy> policy) {
+  std::lock_guard<folly::SharedMutex> l(mutex_);
+  admissionPolicy_ = std::move(policy);
+}
+
 void CacheShard::tryAddFreeEntry(std::unique_ptr<AsyncDataCacheEntry>&& entry) {
   freeEntries_.push_back(std::move(entry));
   // If we have too many free entries, we free up half of them to save space.
@@ -465,7 +802,7 @@ void CacheShard::calibrateThreshold() {
 }
 
 void CacheShard::updateStats(CacheStats& stats) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   for (auto& entry : entries_) {
     if (!entry || !entry->key_.fileNum.hasValue()) {
       ++stats.numEmptyEntries;
@@ -493,10 +830,24 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numWaitExclusive += numWaitExclusive_;
   stats.sumEvictScore += sumEvictScore_;
   stats.allocClocks += allocClocks_;
+  stats.lockWaitClocks += lockWaitClocks_;
+  stats.evictClocks += evictClocks_;
+  if (admissionPolicy_ != nullptr) {
+    stats.admissionPolicy = admissionPolicy_->name();
+  }
+  stats.numPolicyRejects += numPolicyRejects_;
+  stats.numPolicyRetains += numPolicyRetains_;
+  stats.numPolicyRetainHits += numPolicyRetainHits_;
+  stats.compressedCapacity += compressedTier_.capacity;
+  stats.numCompressed += compressed_.size();
+  stats.compressedBytes += compressedBytes_;
+  stats.compressedRawBytes += compressedRawBytes_;
+  stats.numCompressedHit += numCompressedHit_;
+  stats.numCompressRejects += numCompressRejects_;
 }
 
 void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   // Do not add more than 70% of entries to a write batch.If SSD save
   // is slower than storage read, we must not have a situation where
   // SSD save pins everything and stops reading.
@@ -521,14 +872,26 @@ void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
 AsyncDataCache::AsyncDataCache(
     memory::MemoryAllocator* allocator,
     std::unique_ptr<SsdCache> ssdCache)
-    : allocator_(allocator), ssdCache_(std::move(ssdCache)), cachedPages_(0) {
-  for (auto i = 0; i < kNumShards; ++i) {
+    : allocator_(allocator),
+      ssdCache_(std::move(ssdCache)),
+      numShards_(numShardsForCores(std::thread::hardware_concurrency())),
+      shardMask_(numShards_ - 1),
+      cachedPages_(0) {
+  for (auto i = 0; i < numShards_; ++i) {
     shards_.push_back(std::make_unique<CacheShard>(this));
   }
 }
 
 AsyncDataCache::~AsyncDataCache() {}
 
+// static
+int32_t AsyncDataCache::numShardsForCores(int32_t numCores) {
+  return std::clamp<int32_t>(
+      bits::nextPowerOfTwo(std::max(numCores, 1) / 2),
+      kMinNumShards,
+      kMaxNumShards);
+}
+
 // static
 std::shared_ptr<AsyncDataCache> AsyncDataCache::create(
     memory::MemoryAllocator* allocator,
@@ -563,18 +926,19 @@ void AsyncDataCache::shutdown() {
 void CacheShard::shutdown() {
   entries_.clear();
   freeEntries_.clear();
+  clearCompressed();
 }
 
 CachePin AsyncDataCache::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
-  const int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
+  const int shard = std::hash<RawFileCacheKey>()(key) & shardMask_;
   return shards_[shard]->findOrCreate(key, size, wait);
 }
 
 bool AsyncDataCache::exists(RawFileCacheKey key) const {
-  int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
+  int shard = std::hash<RawFileCacheKey>()(key) & shardMask_;
   return shards_[shard]->exists(key);
 }
 
@@ -593,7 +957,7 @@ bool AsyncDataCache::makeSpace(
   // serialize with a mutex because memory arbitration must not be
   // called from inside a global mutex.
 
-  constexpr int32_t kMaxAttempts = kNumShards * 4;
+  const int32_t maxAttempts = numShards_ * 4;
   // Evict at least 1MB even for small allocations to avoid constantly hitting
   // the mutex protected evict loop.
   constexpr int32_t kMinEvictPages = 256;
@@ -624,7 +988,7 @@ bool AsyncDataCache::makeSpace(
     rank = ++numThreadsInAllocate_;
     isCounted = true;
   }
-  for (auto nthAttempt = 0; nthAttempt < kMaxAttempts; ++nthAttempt) {
+  for (auto nthAttempt = 0; nthAttempt < maxAttempts; ++nthAttempt) {
     if (canTryAllocate(numPages, acquired)) {
       if (allocate(acquired)) {
         return true;
@@ -636,7 +1000,7 @@ bool AsyncDataCache::makeSpace(
           << "Pause 0.5s after failed eviction waiting for SSD cache write to unpin memory";
       std::this_thread::sleep_for(std::chrono::milliseconds(500)); // NOLINT
     }
-    if (nthAttempt > kMaxAttempts / 2) {
+    if (nthAttempt > maxAttempts / 2) {
       if (!isCounted) {
         rank = ++numThreadsInAllocate_;
         isCounted = true;
@@ -657,10 +1021,10 @@ bool AsyncDataCache::makeSpace(
     // Evict from next shard. If we have gone through all shards once
     // and still have not made the allocation, we go to desperate mode
     // with 'evictAllUnpinned' set to true.
-    shards_[shardCounter_ & (kShardMask)]->evict(
+    shards_[shardCounter_ & shardMask_]->evict(
         memory::AllocationTraits::pageBytes(
             std::max<int32_t>(kMinEvictPages, numPages) * sizeMultiplier),
-        nthAttempt >= kNumShards,
+        nthAttempt >= numShards_,
         numPagesToAcquire,
         acquired);
     if (numPages < kSmallSizePages && sizeMultiplier < 4) {
@@ -742,11 +1106,162 @@ CacheStats AsyncDataCache::refreshStats() const {
   return stats;
 }
 
+namespace {
+// Returns 'regions' sorted by offset with the overlapping regions merged.
+std::vector<common::Region> mergeRegions(
+    std::vector<common::Region> regions) {
+  std::sort(regions.begin(), regions.end());
+  std::vector<common::Region> merged;
+  for (const auto& region : regions) {
+    if (!merged.empty() &&
+        region.offset <= merged.back().offset + merged.back().length) {
+      auto& last = merged.back();
+      last.length =
+          std::max(last.offset + last.length, region.offset + region.length) -
+          last.offset;
+    } else {
+      merged.emplace_back(region.offset, region.length);
+    }
+  }
+  return merged;
+}
+
+// Returns the number of bytes of [offset, offset + size) that are inside
+// 'regions'. 'regions' must be sorted and must not overlap.
+uint64_t overlapBytes(
+    const std::vector<common::Region>& regions,
+    uint64_t offset,
+    uint64_t size) {
+  const auto end = offset + size;
+  // The first region that ends after 'offset'.
+  auto it = std::upper_bound(
+      regions.begin(),
+      regions.end(),
+      offset,
+      [](uint64_t offset, const common::Region& region) {
+        return offset < region.offset + region.length;
+      });
+  uint64_t bytes = 0;
+  for (; it != regions.end() && it->offset < end; ++it) {
+    bytes += std::min(end, it->offset + it->length) -
+        std::max(offset, it->offset);
+  }
+  return bytes;
+}
+} // namespace
+
+double AsyncDataCache::residentFraction(
+    uint64_t fileNum,
+    const std::vector<common::Region>& regions,
+    bool includeSsd) const {
+  const auto merged = mergeRegions(regions);
+  uint64_t totalBytes = 0;
+  for (const auto& region : merged) {
+    totalBytes += region.length;
+  }
+  if (totalBytes == 0) {
+    return 0;
+  }
+  uint64_t residentBytes = 0;
+  // Offsets of the entries in memory. These are not counted again if also on
+  // SSD.
+  folly::F14FastSet<uint64_t> memoryOffsets;
+  for (auto& shard : shards_) {
+    shard->forEachLoadedEntry([&](RawFileCacheKey key, uint64_t size) {
+      if (key.fileNum == fileNum) {
+        residentBytes += overlapBytes(merged, key.offset, size);
+        memoryOffsets.insert(key.offset);
+      }
+    });
+  }
+  if (includeSsd && ssdCache_ != nullptr) {
+    ssdCache_->file(fileNum).forEachEntry(
+        [&](RawFileCacheKey key, uint64_t size) {
+          if (key.fileNum == fileNum && !memoryOffsets.contains(key.offset)) {
+            residentBytes += overlapBytes(merged, key.offset, size);
+          }
+        });
+  }
+  return std::min(1.0, static_cast<double>(residentBytes) / totalBytes);
+}
+
+BloomFilter<> AsyncDataCache::residencyDigest() const {
+  // Pairs of file number and range number.
+  folly::F14FastSet<std::pair<uint64_t, uint64_t>> ranges;
+  const auto addEntry = [&](RawFileCacheKey key, uint64_t size) {
+    const auto last =
+        (key.offset + std::max<uint64_t>(size, 1) - 1) / kResidencyGranularity;
+    for (auto range = key.offset / kResidencyGranularity; range <= last;
+         ++range) {
+      ranges.insert({key.fileNum, range});
+    }
+  };
+  for (auto& shard : shards_) {
+    shard->forEachLoadedEntry(addEntry);
+  }
+  if (ssdCache_ != nullptr) {
+    ssdCache_->forEachEntry(addEntry);
+  }
+
+  BloomFilter<> digest;
+  digest.reset(std::max<int32_t>(1, ranges.size()));
+  folly::F14FastMap<uint64_t, std::string> fileNames;
+  for (const auto& [fileNum, range] : ranges) {
+    auto it = fileNames.find(fileNum);
+    if (it == fileNames.end()) {
+      it = fileNames.emplace(fileNum, fileIds().string(fileNum)).first;
+    }
+    // The file may have been evicted after the scan of the entries.
+    if (!it->second.empty()) {
+      digest.insert(residencyHash(it->second, range * kResidencyGranularity));
+    }
+  }
+  return digest;
+}
+
+// static
+double AsyncDataCache::residentFraction(
+    const BloomFilter<>& digest,
+    std::string_view fileName,
+    const common::Region& region) {
+  if (region.length == 0) {
+    return 0;
+  }
+  const auto first = region.offset / kResidencyGranularity;
+  const auto last = (region.offset + region.length - 1) / kResidencyGranularity;
+  int32_t numResident = 0;
+  for (auto range = first; range <= last; ++range) {
+    const auto hash = residencyHash(fileName, range * kResidencyGranularity);
+    numResident += digest.mayContain(hash);
+  }
+  return static_cast<double>(numResident) / (last - first + 1);
+}
+
+void AsyncDataCache::setAdmissionPolicy(
+    const CacheAdmissionPolicyFactory& factory) {
+  for (auto& shard : shards_) {
+    shard->setAdmissionPolicy(factory ? factory() : nullptr);
+  }
+}
+
+void AsyncDataCache::setCompressedTier(const CompressedTierOptions& options) {
+  VELOX_CHECK(
+      options.maxCompressedRatio > 0 && options.maxCompressedRatio <= 1,
+      "maxCompressedRatio must be in (0, 1]: {}",
+      options.maxCompressedRatio);
+  auto shardOptions = options;
+  shardOptions.capacity = options.capacity / numShards_;
+  for (auto& shard : shards_) {
+    shard->setCompressedTier(shardOptions);
+  }
+}
+
 void AsyncDataCache::clear() {
   for (auto& shard : shards_) {
     memory::Allocation acquired;
     shard->evict(std::numeric_limits<int32_t>::max(), true, 0, acquired);
     VELOX_CHECK(acquired.empty());
+    shard->clearCompressed();
   }
 }
 
@@ -782,13 +1297,32 @@ std::string CacheStats::toString() const {
       << "Cache access miss: " << numNew << " hit: " << numHit
       << " hit bytes: " << succinctBytes(hitBytes) << " eviction: " << numEvict
       << " eviction checks: " << numEvictChecks
-      << "\n"
+      << "\n";
+  if (!admissionPolicy.empty()) {
+    // Admission policy stats.
+    out << "Admission policy " << admissionPolicy
+        << " rejects: " << numPolicyRejects
+        << " retains: " << numPolicyRetains
+        << " retain hits: " << numPolicyRetainHits << "\n";
+  }
+  if (compressedCapacity > 0) {
+    // Compressed tier stats.
+    out << "Compressed tier capacity: " << succinctBytes(compressedCapacity)
+        << " entries: " << numCompressed
+        << " size: " << succinctBytes(compressedBytes)
+        << " raw size: " << succinctBytes(compressedRawBytes)
+        << " hit: " << numCompressedHit
+        << " rejects: " << numCompressRejects << "\n";
+  }
+  out
       // Cache prefetch stats.
       << "Prefetch entries: " << numPrefetch
       << " bytes: " << succinctBytes(prefetchBytes)
       << "\n"
       // Cache timing stats.
-      << "Alloc Megaclocks " << (allocClocks >> 20);
+      << "Alloc Megaclocks " << (allocClocks >> 20)
+      << " lock wait Megaclocks " << (lockWaitClocks >> 20)
+      << " evict Megaclocks " << (evictClocks >> 20);
   return out.str();
 }
 
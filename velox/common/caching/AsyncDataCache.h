@@ -17,19 +17,25 @@
 #pragma once
 
 #include <deque>
+#include <optional>
 
 #include <fmt/format.h>
+#include <folly/SharedMutex.h>
 #include <folly/chrono/Hardware.h>
 #include <folly/futures/SharedPromise.h>
 #include "folly/GLog.h"
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/CoalesceIo.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
+#include "velox/common/caching/CacheAdmissionPolicy.h"
 #include "velox/common/caching/FileGroupStats.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/Region.h"
 #include "velox/common/memory/MemoryAllocator.h"
 
 namespace facebook::velox::cache {
@@ -59,9 +65,10 @@ inline AccessTime accessTime() {
   return folly::hardware_timestamp() >> 21;
 }
 
+// The fields are updated without synchronization on cache hits.
 struct AccessStats {
-  AccessTime lastUse{0};
-  int32_t numUses{0};
+  tsan_atomic<AccessTime> lastUse{0};
+  tsan_atomic<int32_t> numUses{0};
 
   // Retention score. A higher number means less worth retaining. This
   // works well with a typical formula of time over use count going to
@@ -248,6 +255,16 @@ class AsyncDataCacheEntry {
   /// Sets access stats so that this is immediately evictable.
   void makeEvictable();
 
+  /// Marks that 'this' is loaded by a large scan and is likely to be read only
+  /// once. See CacheAdmissionPolicy.
+  void setScanHint(bool flag = true) {
+    scanHint_ = flag;
+  }
+
+  bool scanHint() const {
+    return scanHint_;
+  }
+
   // Moves the promise out of 'this'. Used in order to handle the
   // promise within the lock of the cache shard, so not within private
   // methods of 'this'.
@@ -319,6 +336,14 @@ class AsyncDataCacheEntry {
   // True if this should be saved to SSD.
   std::atomic<bool> ssdSaveable_{false};
 
+  // True if loaded by a large scan. Set outside of the shard mutex for a new
+  // entry that is held exclusively.
+  bool scanHint_{false};
+
+  // True if the admission policy of 'shard_' has kept this from being evicted
+  // and this has not been hit since. Accessed under the shard mutex.
+  bool retainedByPolicy_{false};
+
   friend class CacheShard;
   friend class CachePin;
 };
@@ -465,6 +490,25 @@ class CoalescedLoad {
   std::vector<int32_t> sizes_;
 };
 
+/// Options for the tier of AsyncDataCache that keeps evicted entries
+/// compressed in memory. An entry that is evicted by access score is
+/// compressed and dropped from the tier in eviction order when the tier is
+/// full. A miss on an entry in the tier is served by decompressing the entry
+/// into a new cache entry.
+struct CompressedTierOptions {
+  /// Maximum total size of the compressed entries. 0 disables the tier. The
+  /// compressed entries are on the heap, in addition to the capacity of the
+  /// cache's allocator.
+  uint64_t capacity{0};
+
+  common::CompressionKind compressionKind{common::CompressionKind_LZ4};
+
+  /// An entry is kept only if its compressed size is at most this fraction of
+  /// its size. While the recently compressed entries do not meet this on
+  /// average, only a sample of the evicted entries are compressed.
+  double maxCompressedRatio{0.6};
+};
+
 // Struct for CacheShard stats. Stats from all shards are added into
 // this struct to provide a snapshot of state.
 struct CacheStats {
@@ -506,9 +550,38 @@ struct CacheStats {
   // Cumulative clocks spent in allocating or freeing memory for backing cache
   // entries.
   uint64_t allocClocks{0};
+  // Cumulative clocks spent waiting for the mutex of a shard in findOrCreate
+  // and eviction.
+  uint64_t lockWaitClocks{0};
+  // Cumulative clocks spent in selecting and removing entries for eviction,
+  // not counting the freeing of memory.
+  uint64_t evictClocks{0};
   // Sum of scores of evicted entries. This serves to infer an average
   // lifetime for entries in cache.
   int64_t sumEvictScore{0};
+  // Name of the admission policy or empty if none.
+  std::string admissionPolicy;
+  // Number of entries evicted by the admission policy that the access score
+  // would have retained.
+  int64_t numPolicyRejects{0};
+  // Number of times the admission policy retained an entry that the access
+  // score would have evicted.
+  int64_t numPolicyRetains{0};
+  // Number of hits on entries retained by the admission policy.
+  int64_t numPolicyRetainHits{0};
+  // Capacity of the compressed tier. 0 if there is no compressed tier.
+  uint64_t compressedCapacity{0};
+  // Number of evicted entries kept compressed.
+  int32_t numCompressed{0};
+  // Compressed size of the entries in 'numCompressed'.
+  int64_t compressedBytes{0};
+  // Uncompressed size of the entries in 'numCompressed'.
+  int64_t compressedRawBytes{0};
+  // Number of misses served from the compressed tier.
+  int64_t numCompressedHit{0};
+  // Number of evicted entries that were compressed but did not compress
+  // enough to be kept.
+  int64_t numCompressRejects{0};
 
   std::shared_ptr<SsdCacheStats> ssdStats = nullptr;
 
@@ -536,7 +609,7 @@ class CacheShard {
     return cache_;
   }
 
-  std::mutex& mutex() {
+  folly::SharedMutex& mutex() {
     return mutex_;
   }
 
@@ -577,12 +650,69 @@ class CacheShard {
     return allocClocks_;
   }
 
+  /// Calls 'func' with the key and size of each entry that has its data
+  /// loaded. 'func' is called under the shard mutex and must not call back
+  /// into the cache.
+  void forEachLoadedEntry(
+      const std::function<void(RawFileCacheKey key, uint64_t size)>& func)
+      const;
+
+  /// Sets the policy that decides eviction together with the access score of
+  /// the entries. nullptr means evicting by access score only.
+  void setAdmissionPolicy(std::unique_ptr<CacheAdmissionPolicy> policy);
+
+  /// Sets the compressed tier of 'this'. 'options.capacity' is the capacity
+  /// of 'this', not of the cache. Drops compressed entries that do not fit.
+  void setCompressedTier(const CompressedTierOptions& options);
+
+  /// Drops all compressed entries.
+  void clearCompressed();
+
  private:
   static constexpr uint32_t kMaxFreeEntries = 1 << 10;
   static constexpr int32_t kNoThreshold = std::numeric_limits<int32_t>::max();
+  // While the compression ratio of recent entries is above the maximum, one
+  // in this many evicted entries is compressed.
+  static constexpr uint32_t kCompressSampleInterval = 16;
+
+  // An evicted entry in the compressed tier. Holds a reference to the file
+  // name like a cache entry.
+  struct CompressedEntry {
+    FileCacheKey key;
+    int32_t size;
+    common::CompressionKind compressionKind;
+    std::string data;
+    uint64_t groupId;
+    TrackingId trackingId;
+    SsdFile* ssdFile;
+    uint64_t ssdOffset;
+    // Identifies the position in 'compressedOrder_'.
+    uint64_t sequence;
+  };
+
+  // An evicted entry to compress outside of 'mutex_' and its data.
+  struct ToCompress {
+    CompressedEntry entry;
+    memory::Allocation data;
+  };
 
   void calibrateThreshold();
 
+  // Returns a pin on the entry for 'key' if it is in a readable state and
+  // needs no bookkeeping beyond the pin and the hit stats, otherwise an empty
+  // pin. Takes 'mutex_' in shared mode, so that concurrent hits do not
+  // serialize. Entries are only made exclusive or removed with 'mutex_' held
+  // exclusively, so an entry found here stays valid while it is pinned.
+  CachePin findShared(RawFileCacheKey key, uint64_t size);
+
+  // Locks 'mutex_' exclusively. Adds the time spent waiting for it, if any,
+  // to 'lockWaitClocks_'.
+  std::unique_lock<folly::SharedMutex> lockAndMeasureWait();
+
+  // Returns true if the unpinned 'entry' with access score 'score' is evicted.
+  // Consults 'admissionPolicy_' if set.
+  bool shouldEvictLocked(AsyncDataCacheEntry* entry, int32_t score);
+
   void removeEntryLocked(AsyncDataCacheEntry* entry);
 
   // Returns an unused entry if found.
@@ -591,7 +721,45 @@ class CacheShard {
   // already has the right amount of memory associated with it.
   std::unique_ptr<AsyncDataCacheEntry> getFreeEntry();
 
-  CachePin initEntry(RawFileCacheKey key, AsyncDataCacheEntry* entry);
+  // Allocates the memory of the new exclusive 'entry'. If 'compressed' is
+  // set, fills 'entry' from it and returns the pin in shared mode.
+  CachePin initEntry(
+      RawFileCacheKey key,
+      AsyncDataCacheEntry* entry,
+      const CompressedEntry* compressed = nullptr);
+
+  // Returns true if the data of the evicted 'entry' is to be compressed.
+  bool shouldCompressLocked(const AsyncDataCacheEntry& entry);
+
+  // Compresses the entries of 'toCompress' and moves their data to 'toFree'.
+  // Returns the entries that compress well enough to keep and sets
+  // 'compressionRatio' to the compressed over raw size of all. Called outside
+  // of 'mutex_'.
+  std::vector<CompressedEntry> compress(
+      std::vector<ToCompress>& toCompress,
+      common::CompressionKind compressionKind,
+      double maxCompressedRatio,
+      std::vector<memory::Allocation>& toFree,
+      double& compressionRatio);
+
+  // Adds 'entries' to the compressed tier and drops the oldest compressed
+  // entries that do not fit. 'numAttempts' is the number of entries that
+  // were compressed to get 'entries' and 'compressionRatio' is their
+  // compression ratio.
+  void addCompressed(
+      std::vector<CompressedEntry> entries,
+      int32_t numAttempts,
+      double compressionRatio);
+
+  // Removes the compressed entry for 'key' and returns it if it has at least
+  // 'size' bytes.
+  std::optional<CompressedEntry> takeCompressedLocked(
+      RawFileCacheKey key,
+      uint64_t size);
+
+  // Drops compressed entries in insertion order until they fit in the
+  // capacity.
+  void trimCompressedLocked();
 
   void freeAllocations(std::vector<memory::Allocation>& allocations);
 
@@ -599,7 +767,9 @@ class CacheShard {
 
   AsyncDataCache* const cache_;
 
-  mutable std::mutex mutex_;
+  // Held in shared mode for cache hits and exclusively for anything that
+  // changes the set of entries or their state.
+  mutable folly::SharedMutex mutex_;
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
   // Entries associated to a key.
   std::deque<std::unique_ptr<AsyncDataCacheEntry>> entries_;
@@ -612,13 +782,13 @@ class CacheShard {
   // Index in 'entries_' for the next eviction candidate.
   uint32_t clockHand_{0};
   // Number of gets since last stats sampling.
-  uint32_t eventCounter_{0};
+  std::atomic<uint32_t> eventCounter_{0};
   // Maximum retainable entry score(). Anything above this is evictable.
   int32_t evictionThreshold_{kNoThreshold};
   // Cumulative count of cache hits.
-  uint64_t numHit_{0};
+  std::atomic<uint64_t> numHit_{0};
   // Sum of bytes in cache hits.
-  uint64_t hitBytes_{0};
+  std::atomic<uint64_t> hitBytes_{0};
   // Cumulative count of hits on entries held in exclusive mode.
   uint64_t numWaitExclusive_{0};
   // Cumulative count of new entry creation.
@@ -634,6 +804,37 @@ class CacheShard {
   // Tracker of time spent in allocating/freeing MemoryAllocator space
   // for backing cached data.
   std::atomic<uint64_t> allocClocks_{0};
+  // Tracker of time spent waiting for 'mutex_'.
+  std::atomic<uint64_t> lockWaitClocks_{0};
+  // Tracker of time spent in the eviction loop under 'mutex_'.
+  uint64_t evictClocks_{0};
+  std::unique_ptr<CacheAdmissionPolicy> admissionPolicy_;
+  // Count of entries evicted by 'admissionPolicy_' against the access score.
+  uint64_t numPolicyRejects_{0};
+  // Count of entries retained by 'admissionPolicy_' against the access score.
+  uint64_t numPolicyRetains_{0};
+  // Count of hits on entries retained by 'admissionPolicy_'.
+  uint64_t numPolicyRetainHits_{0};
+
+  CompressedTierOptions compressedTier_;
+  folly::F14FastMap<RawFileCacheKey, CompressedEntry> compressed_;
+  // Keys and sequence numbers of 'compressed_' in insertion order. Contains
+  // stale elements for the entries that have been hit or dropped.
+  std::deque<std::pair<RawFileCacheKey, uint64_t>> compressedOrder_;
+  uint64_t compressedSequence_{0};
+  // Sum of the compressed sizes in 'compressed_'.
+  uint64_t compressedBytes_{0};
+  // Sum of the uncompressed sizes in 'compressed_'.
+  uint64_t compressedRawBytes_{0};
+  // Exponential average of compressed over raw size of the recently
+  // compressed entries.
+  double compressionRatio_{0};
+  // Count of evicted entries not compressed because of 'compressionRatio_'.
+  uint32_t numCompressSkips_{0};
+  // Count of misses served from 'compressed_'.
+  uint64_t numCompressedHit_{0};
+  // Count of compressed entries not kept because of their compression ratio.
+  uint64_t numCompressRejects_{0};
 };
 
 class AsyncDataCache : public memory::Cache {
@@ -650,6 +851,12 @@ class AsyncDataCache : public memory::Cache {
 
   static AsyncDataCache* getInstance();
 
+  /// Returns the number of shards for a machine with 'numCores' hardware
+  /// threads. This is a power of 2 with one shard per 2 threads, at least 4
+  /// and at most 64, so that scans on many cores do not contend on few shard
+  /// mutexes.
+  static int32_t numShardsForCores(int32_t numCores);
+
   static void setInstance(AsyncDataCache* asyncDataCache);
 
   /// Release any resources that consume memory from 'allocator_' for a graceful
@@ -692,6 +899,48 @@ class AsyncDataCache : public memory::Cache {
 
   CacheStats refreshStats() const;
 
+  /// Returns the fraction of the bytes of 'regions' of 'fileNum' that are
+  /// cached in memory or, if 'includeSsd' is true, on SSD. Scans all the
+  /// entries of the cache and is meant for split scheduling decisions, not
+  /// for the read path.
+  double residentFraction(
+      uint64_t fileNum,
+      const std::vector<common::Region>& regions,
+      bool includeSsd = true) const;
+
+  /// Returns a bloom filter of the kResidencyGranularity sized ranges of files
+  /// that have data in memory or on SSD. A scheduler polls this to route
+  /// splits to workers that have their data cached. The elements are computed
+  /// with residencyHash() from the file path and are comparable across
+  /// workers. Scans all the entries of the cache.
+  BloomFilter<> residencyDigest() const;
+
+  /// Returns the element of residencyDigest() for the range of 'fileName'
+  /// that contains 'offset'.
+  static uint64_t residencyHash(std::string_view fileName, uint64_t offset) {
+    return bits::hashMix(
+        std::hash<std::string_view>()(fileName),
+        offset / kResidencyGranularity);
+  }
+
+  /// Returns the fraction of the kResidencyGranularity sized ranges of
+  /// 'region' of 'fileName' that 'digest' may contain.
+  static double residentFraction(
+      const BloomFilter<>& digest,
+      std::string_view fileName,
+      const common::Region& region);
+
+  static constexpr uint64_t kResidencyGranularity = 8 << 20;
+
+  /// Sets an admission policy made by 'factory' for each shard. A nullptr
+  /// factory removes the policies. See CacheAdmissionPolicy.
+  void setAdmissionPolicy(const CacheAdmissionPolicyFactory& factory);
+
+  /// Keeps evicted entries compressed in memory as set by 'options'. Each
+  /// shard gets an equal part of 'options.capacity'. A zero capacity drops
+  /// the compressed entries and disables the tier. See CompressedTierOptions.
+  void setCompressedTier(const CompressedTierOptions& options);
+
   std::string toString() const;
 
   memory::MachinePageCount incrementCachedPages(int64_t pages) {
@@ -748,7 +997,7 @@ class AsyncDataCache : public memory::Cache {
     }
   }
 
-  // Drops all unpinned entries. Pins stay valid.
+  // Drops all unpinned entries and the compressed entries. Pins stay valid.
   void clear();
 
   // Saves all entries with 'ssdSaveable_' to 'ssdCache_'.
@@ -759,8 +1008,8 @@ class AsyncDataCache : public memory::Cache {
   }
 
  private:
-  static constexpr int32_t kNumShards = 4; // Must be power of 2.
-  static constexpr int32_t kShardMask = kNumShards - 1;
+  static constexpr int32_t kMinNumShards = 4;
+  static constexpr int32_t kMaxNumShards = 64;
 
   // True if 'acquired' has more pages than 'numPages' or allocator has space
   // for numPages - acquired pages of more allocation.
@@ -774,6 +1023,9 @@ class AsyncDataCache : public memory::Cache {
 
   memory::MemoryAllocator* const allocator_;
   std::unique_ptr<SsdCache> ssdCache_;
+  // Power of 2.
+  const int32_t numShards_;
+  const int32_t shardMask_;
   std::vector<std::unique_ptr<CacheShard>> shards_;
   std::atomic<int32_t> shardCounter_{0};
   std::atomic<memory::MachinePageCount> cachedPages_{0};
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheAdmissionPolicy.h"
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+#include <algorithm>
+
+namespace facebook::velox::cache {
+
+FrequencySketch::FrequencySketch(int32_t numCounters)
+    : mask_(bits::nextPowerOfTwo(std::max(numCounters, kCountersPerWord)) - 1),
+      sampleSize_(10 * (mask_ + 1)),
+      table_(kNumRows * (mask_ + 1) / kCountersPerWord) {
+  VELOX_CHECK_GT(numCounters, 0);
+}
+
+uint64_t FrequencySketch::counterIndex(uint64_t hash, int32_t row) const {
+  return row * (mask_ + 1) + (bits::hashMix(hash, row) & mask_);
+}
+
+void FrequencySketch::increment(uint64_t hash) {
+  // Conservative update: only the smallest counters are incremented. This
+  // keeps the estimates of the items that collide with frequent items lower.
+  uint64_t indices[kNumRows];
+  auto minCount = kMaxCount;
+  for (auto row = 0; row < kNumRows; ++row) {
+    indices[row] = counterIndex(hash, row);
+    minCount = std::min(minCount, count(indices[row]));
+  }
+  if (minCount < kMaxCount) {
+    for (auto row = 0; row < kNumRows; ++row) {
+      if (count(indices[row]) == minCount) {
+        table_[indices[row] / kCountersPerWord] += 1UL
+            << (4 * (indices[row] % kCountersPerWord));
+      }
+    }
+  }
+  if (++numIncrements_ >= sampleSize_) {
+    age();
+  }
+}
+
+int32_t FrequencySketch::estimate(uint64_t hash) const {
+  auto minCount = kMaxCount;
+  for (auto row = 0; row < kNumRows; ++row) {
+    minCount = std::min(minCount, count(counterIndex(hash, row)));
+  }
+  return minCount;
+}
+
+void FrequencySketch::age() {
+  // Shifts each word right by one and clears the bit that moved into the high
+  // bit of each counter from the next one.
+  for (auto& word : table_) {
+    word = (word >> 1) & 0x7777777777777777UL;
+  }
+  numIncrements_ /= 2;
+}
+
+bool TinyLfuAdmissionPolicy::shouldEvict(
+    uint64_t hash,
+    bool scanHint,
+    bool evictByScore) const {
+  const auto frequency = sketch_.estimate(hash);
+  if (evictByScore) {
+    return frequency < retainFrequency_;
+  }
+  return scanHint && frequency < admitFrequency_;
+}
+
+} // namespace facebook::velox::cache
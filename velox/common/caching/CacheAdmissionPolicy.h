@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace facebook::velox::cache {
+
+/// Count-min sketch of access frequencies with 4 bit counters. The counts are
+/// halved after a sample of 10 accesses per counter so that the estimates
+/// favor recent accesses. An estimate can be too high because of hash
+/// collisions but is never too low, except for the halving. Not thread safe.
+class FrequencySketch {
+ public:
+  /// Makes a sketch with 'numCounters' counters per hash function, rounded up
+  /// to a power of 2.
+  explicit FrequencySketch(int32_t numCounters);
+
+  /// Records an access to the item with 'hash'.
+  void increment(uint64_t hash);
+
+  /// Returns the estimated number of accesses to the item with 'hash', at most
+  /// kMaxCount.
+  int32_t estimate(uint64_t hash) const;
+
+  static constexpr int32_t kMaxCount = 15;
+
+ private:
+  static constexpr int32_t kNumRows = 4;
+  static constexpr int32_t kCountersPerWord = 16;
+
+  // Returns the index of the counter of 'hash' in 'row'.
+  uint64_t counterIndex(uint64_t hash, int32_t row) const;
+
+  int32_t count(uint64_t index) const {
+    return (table_[index / kCountersPerWord] >>
+            (4 * (index % kCountersPerWord))) &
+        kMaxCount;
+  }
+
+  // Halves all counters.
+  void age();
+
+  // Number of counters per row minus 1.
+  const uint64_t mask_;
+
+  // Number of increments after which the counters are halved.
+  const uint64_t sampleSize_;
+
+  uint64_t numIncrements_{0};
+
+  // 'kNumRows' rows of 'mask_' + 1 counters.
+  std::vector<uint64_t> table_;
+};
+
+/// Decides which entries a CacheShard retains in addition to or instead of
+/// the access score of the entries. A policy instance belongs to one shard and
+/// is called under the shard mutex.
+class CacheAdmissionPolicy {
+ public:
+  virtual ~CacheAdmissionPolicy() = default;
+
+  virtual std::string name() const = 0;
+
+  /// Records a lookup of the key with 'hash', whether it hits or misses.
+  virtual void recordAccess(uint64_t hash) = 0;
+
+  /// Returns true if the unpinned entry for the key with 'hash' is evicted.
+  /// 'evictByScore' is true if the access score of the entry makes it
+  /// evictable. 'scanHint' is true if the entry was loaded by a large scan and
+  /// is likely to be read only once.
+  virtual bool
+  shouldEvict(uint64_t hash, bool scanHint, bool evictByScore) const = 0;
+};
+
+using CacheAdmissionPolicyFactory =
+    std::function<std::unique_ptr<CacheAdmissionPolicy>()>;
+
+/// TinyLFU admission for the cache entries. Keeps a FrequencySketch of the
+/// cache lookups. Entries of large scans are admitted only if their key has
+/// been looked up at least 'admitFrequency' times recently, so that a one-shot
+/// scan does not flush data that is used repeatedly. Entries with at least
+/// 'retainFrequency' recent lookups are retained even if their access score
+/// makes them evictable.
+class TinyLfuAdmissionPolicy : public CacheAdmissionPolicy {
+ public:
+  static constexpr int32_t kDefaultNumCounters = 1 << 16;
+
+  explicit TinyLfuAdmissionPolicy(
+      int32_t numCounters = kDefaultNumCounters,
+      int32_t admitFrequency = 2,
+      int32_t retainFrequency = 8)
+      : sketch_(numCounters),
+        admitFrequency_(admitFrequency),
+        retainFrequency_(retainFrequency) {}
+
+  std::string name() const override {
+    return "TinyLFU";
+  }
+
+  void recordAccess(uint64_t hash) override {
+    sketch_.increment(hash);
+  }
+
+  bool shouldEvict(uint64_t hash, bool scanHint, bool evictByScore)
+      const override;
+
+ private:
+  FrequencySketch sketch_;
+  const int32_t admitFrequency_;
+  const int32_t retainFrequency_;
+};
+
+} // namespace facebook::velox::cache
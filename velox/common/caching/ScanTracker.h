@@ -168,6 +168,19 @@ class ScanTracker {
     return data_[id];
   }
 
+  // Returns true if the scan has referenced the stream 'id' at least
+  // kLargeScanReferences times. The data of such a stream, e.g. a column of a
+  // large fact table, is typically read once per scan. This is a hint for
+  // cache admission, see CacheAdmissionPolicy.
+  bool isLargeScan(TrackingId id) {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = data_.find(id);
+    return it != data_.end() &&
+        it->second.numReferences >= kLargeScanReferences;
+  }
+
+  static constexpr int32_t kLargeScanReferences = 32;
+
   std::string_view id() const {
     return id_;
   }
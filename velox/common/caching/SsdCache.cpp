@@ -15,11 +15,14 @@
  */
 #include "velox/common/caching/SsdCache.h"
 #include <folly/Executor.h>
+#include <folly/hash/Hash.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/time/Timer.h"
 
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
 #include <numeric>
 
@@ -58,11 +61,85 @@ SsdCache::SsdCache(
         checkpointIntervalBytes / numShards,
         disableFileCow));
   }
+  devices_.resize(numShards_);
+  // The files keep their shards from before a restart.
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  rebuildPlacementsLocked();
 }
 
 SsdFile& SsdCache::file(uint64_t fileId) {
-  const auto index = fileId % numShards_;
-  return *files_[index];
+  if (numShards_ == 1) {
+    return *files_[0];
+  }
+  {
+    std::shared_lock<std::shared_mutex> l(mutex_);
+    auto it = filePlacements_.find(fileId);
+    if (it != filePlacements_.end()) {
+      return *files_[it->second];
+    }
+  }
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  if (filePlacements_.size() >= maxFilePlacements_) {
+    rebuildPlacementsLocked();
+  }
+  const auto [it, inserted] =
+      filePlacements_.emplace(fileId, placeLocked(fileId));
+  return *files_[it->second];
+}
+
+int32_t SsdCache::placeLocked(uint64_t fileId) const {
+  double totalWeight = 0;
+  for (const auto& device : devices_) {
+    totalWeight += device.weight;
+  }
+  if (totalWeight == numShards_) {
+    return fileId % numShards_;
+  }
+  // A point in [0, 'totalWeight') from the hash of 'fileId'.
+  double point =
+      (folly::hash::twang_mix64(fileId) >> 11) * 0x1.0p-53 * totalWeight;
+  for (auto i = 0; i < numShards_; ++i) {
+    if (point < devices_[i].weight) {
+      return i;
+    }
+    point -= devices_[i].weight;
+  }
+  return numShards_ - 1;
+}
+
+void SsdCache::recordWrite(int32_t shard, uint64_t bytes, uint64_t micros) {
+  if (bytes < kMinMeasuredWriteBytes || micros == 0) {
+    return;
+  }
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  const auto throughput = static_cast<double>(bytes) / micros;
+  auto& state = devices_[shard];
+  state.writeBytesPerMicro = state.writeBytesPerMicro == 0
+      ? throughput
+      : 0.7 * state.writeBytesPerMicro + 0.3 * throughput;
+  double maxThroughput = 0;
+  for (const auto& device : devices_) {
+    maxThroughput = std::max(maxThroughput, device.writeBytesPerMicro);
+  }
+  for (auto& device : devices_) {
+    const auto ratio = device.writeBytesPerMicro == 0
+        ? 1
+        : device.writeBytesPerMicro / maxThroughput;
+    device.weight = ratio >= kMinRelativeThroughput
+        ? 1
+        : std::max(kMinWeight, std::floor(ratio / kMinWeight) * kMinWeight);
+  }
+}
+
+void SsdCache::rebuildPlacementsLocked() {
+  filePlacements_.clear();
+  for (auto i = 0; i < numShards_; ++i) {
+    files_[i]->forEachEntry([&](RawFileCacheKey key, uint64_t /*size*/) {
+      filePlacements_.emplace(key.fileNum, i);
+    });
+  }
+  maxFilePlacements_ =
+      std::max(kMaxFilePlacements, 2 * filePlacements_.size());
 }
 
 bool SsdCache::startWrite() {
@@ -85,11 +162,37 @@ void SsdCache::write(std::vector<CachePin> pins) {
 
   uint64_t bytes = 0;
   std::vector<std::vector<CachePin>> shards(numShards_);
+  std::vector<uint64_t> shardBytes(numShards_);
   for (auto& pin : pins) {
-    bytes += pin.checkedEntry()->size();
+    const auto size = pin.checkedEntry()->size();
+    bytes += size;
     const auto& target = file(pin.checkedEntry()->key().fileNum.id());
+    shardBytes[target.shardId()] += size;
     shards[target.shardId()].push_back(std::move(pin));
   }
+  {
+    // Writes to a slow device are cut to its weight so that it does not hold
+    // up the writes to the others.
+    std::lock_guard<std::shared_mutex> l(mutex_);
+    for (auto i = 0; i < numShards_; ++i) {
+      if (devices_[i].weight == 1) {
+        continue;
+      }
+      const uint64_t maxBytes = shardBytes[i] * devices_[i].weight;
+      uint64_t keptBytes = 0;
+      int32_t numKept = 0;
+      for (; numKept < shards[i].size(); ++numKept) {
+        const auto size = shards[i][numKept].checkedEntry()->size();
+        if (keptBytes + size > maxBytes) {
+          break;
+        }
+        keptBytes += size;
+      }
+      devices_[i].bytesThrottled += shardBytes[i] - keptBytes;
+      shards[i].resize(numKept);
+      shardBytes[i] = keptBytes;
+    }
+  }
 
   int32_t numNoStore = 0;
   for (auto i = 0; i < numShards_; ++i) {
@@ -107,9 +210,14 @@ void SsdCache::write(std::vector<CachePin> pins) {
     // We move the mutable vector of pins to the executor. These must
     // be wrapped in a shared struct to be passed via lambda capture.
     auto pinHolder = std::make_shared<PinHolder>(std::move(shards[i]));
-    executor_->add([this, i, pinHolder, bytes, startTimeUs]() {
+    executor_->add([this, i, pinHolder, bytes, startTimeUs, shardBytes]() {
       try {
-        files_[i]->write(pinHolder->pins);
+        uint64_t writeMicros = 0;
+        {
+          MicrosecondTimer timer(&writeMicros);
+          files_[i]->write(pinHolder->pins);
+        }
+        recordWrite(i, shardBytes[i], writeMicros);
       } catch (const std::exception& e) {
         // Catch so as not to miss updating 'writesInProgress_'. Could
         // theoretically happen for std::bad_alloc or such.
@@ -134,9 +242,24 @@ SsdCacheStats SsdCache::stats() const {
   for (auto& file : files_) {
     file->updateStats(stats);
   }
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  for (auto i = 0; i < numShards_; ++i) {
+    auto& device = stats.devices[i];
+    device.writeBytesPerMicro = devices_[i].writeBytesPerMicro;
+    device.weight = devices_[i].weight;
+    device.bytesThrottled = devices_[i].bytesThrottled;
+  }
   return stats;
 }
 
+void SsdCache::forEachEntry(
+    const std::function<void(RawFileCacheKey key, uint64_t size)>& func)
+    const {
+  for (auto& file : files_) {
+    file->forEachEntry(func);
+  }
+}
+
 void SsdCache::clear() {
   for (auto& file : files_) {
     file->clear();
@@ -151,6 +274,18 @@ std::string SsdCache::toString() const {
       << (data.bytesRead >> 20) << "MB Size " << (capacity >> 30)
       << "GB Occupied " << (data.bytesCached >> 30) << "GB";
   out << (data.entriesCached >> 10) << "K entries.";
+  const bool balanced = std::all_of(
+      data.devices.begin(), data.devices.end(), [](const auto& device) {
+        return device.weight == 1;
+      });
+  if (!balanced) {
+    out << "\nDevices:";
+    for (const auto& device : data.devices) {
+      out << " [" << device.shardId << ": " << device.writeBytesPerMicro
+          << " MB/s weight " << device.weight << " throttled "
+          << (device.bytesThrottled >> 20) << "MB]";
+    }
+  }
   out << "\nGroupStats: " << groupStats_->toString(capacity);
   return out.str();
 }
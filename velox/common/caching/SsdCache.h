@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <shared_mutex>
+
 #include "velox/common/caching/SsdFile.h"
 
 namespace facebook::velox::cache {
@@ -52,7 +54,11 @@ class SsdCache {
       bool disableFileCow = false);
 
   /// Returns the shard corresponding to 'fileId'. 'fileId' is a file id from
-  /// e.g. FileCacheKey.
+  /// e.g. FileCacheKey. A file is placed on a shard on first use and stays
+  /// there. While the devices of the shards have about the same write
+  /// throughput, the shard is 'fileId' modulo the number of shards. Otherwise
+  /// new files are placed in proportion to the weight of each device, so that
+  /// a slow or degraded device gets less data.
   SsdFile& file(uint64_t fileId);
 
   /// Returns the maximum capacity, rounded up from the capacity passed to the
@@ -73,12 +79,21 @@ class SsdCache {
   /// Stores the entries of 'pins' into the corresponding files. Sets the file
   /// for the successfully stored entries. May evict existing entries from
   /// unpinned regions. startWrite() must have been called first and it must
-  /// have returned true.
+  /// have returned true. A device with a weight under 1 gets only that
+  /// fraction of its entries, so that the write finishes at about the same
+  /// time on all devices. The other entries stay in memory and may be saved
+  /// by a later write.
   void write(std::vector<CachePin> pins);
 
-  /// Returns stats aggregated from all shards.
+  /// Returns stats aggregated from all shards with the stats of each shard in
+  /// 'devices'.
   SsdCacheStats stats() const;
 
+  /// Calls 'func' with the key and size of each entry of all shards.
+  void forEachEntry(
+      const std::function<void(RawFileCacheKey key, uint64_t size)>& func)
+      const;
+
   FileGroupStats& groupStats() const {
     return *groupStats_;
   }
@@ -91,6 +106,12 @@ class SsdCache {
   /// Deletes backing files. Used in testing.
   void testingDeleteFiles();
 
+  /// Records a write of 'bytes' to 'shard' that took 'micros', as if done by
+  /// write(). Used in testing.
+  void testingRecordWrite(int32_t shard, uint64_t bytes, uint64_t micros) {
+    recordWrite(shard, bytes, micros);
+  }
+
   /// Stops writing to the cache files and waits for pending writes to finish.
   /// If checkpointing is on, makes a checkpoint.
   void shutdown();
@@ -98,10 +119,48 @@ class SsdCache {
   std::string toString() const;
 
  private:
+  // A device with at least this fraction of the throughput of the fastest
+  // device has a weight of 1.
+  static constexpr double kMinRelativeThroughput = 0.8;
+  // Weights are multiples of kMinWeight, so that small changes in throughput
+  // do not change placement.
+  static constexpr double kMinWeight = 1.0 / 8;
+  // Writes of fewer bytes are too short to measure throughput.
+  static constexpr uint64_t kMinMeasuredWriteBytes = 1 << 20;
+  // Number of placements in 'filePlacements_' after which the placements of
+  // files with no entries are dropped.
+  static constexpr size_t kMaxFilePlacements = 1 << 20;
+
+  // Throughput and weight of the device of a shard.
+  struct DeviceState {
+    // Exponential average of the write throughput. 0 if not measured.
+    double writeBytesPerMicro{0};
+    double weight{1};
+    uint64_t bytesThrottled{0};
+  };
+
+  // Returns the shard for a file that does not have one.
+  int32_t placeLocked(uint64_t fileId) const;
+
+  // Updates the throughput of 'shard' and the weights of all shards after a
+  // write of 'bytes' that took 'micros'.
+  void recordWrite(int32_t shard, uint64_t bytes, uint64_t micros);
+
+  // Sets 'filePlacements_' to the shards of the files that have entries.
+  void rebuildPlacementsLocked();
+
   const std::string filePrefix_;
   const int32_t numShards_;
   std::vector<std::unique_ptr<SsdFile>> files_;
 
+  // Serializes 'devices_' and 'filePlacements_'.
+  mutable std::shared_mutex mutex_;
+  std::vector<DeviceState> devices_;
+  // Map from file id to shard.
+  folly::F14FastMap<uint64_t, int32_t> filePlacements_;
+  // Size of 'filePlacements_' at which to drop the unused placements.
+  size_t maxFilePlacements_{kMaxFilePlacements};
+
   // Count of shards with unfinished writes.
   std::atomic<int32_t> writesInProgress_{0};
 
@@ -16,11 +16,15 @@
 
 #include "velox/common/caching/SsdFile.h"
 #include <folly/Executor.h>
+#include <folly/ScopeGuard.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/Crc.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
+#include "velox/common/file/IoUring.h"
+#include "velox/common/time/Timer.h"
 
 #include <fcntl.h>
 #ifdef linux
@@ -34,6 +38,10 @@
 
 DEFINE_bool(ssd_odirect, true, "Use O_DIRECT for SSD cache IO");
 DEFINE_bool(ssd_verify_write, false, "Read back data after writing to SSD");
+DEFINE_bool(
+    ssd_checksum,
+    false,
+    "Checksum SSD cache entries on write and verify the checksum on read");
 
 namespace facebook::velox::cache {
 
@@ -79,6 +87,23 @@ void addEntryToIovecs(AsyncDataCacheEntry& entry, std::vector<iovec>& iovecs) {
     };
   }
 }
+
+uint32_t checksumEntry(const AsyncDataCacheEntry& entry) {
+  bits::Crc32 crc;
+  if (entry.tinyData() != nullptr) {
+    crc.process_bytes(entry.tinyData(), entry.size());
+    return crc.checksum();
+  }
+  const auto& data = entry.data();
+  int64_t bytesLeft = entry.size();
+  for (auto i = 0; i < data.numRuns() && bytesLeft > 0; ++i) {
+    const auto run = data.runAt(i);
+    const auto size = std::min<int64_t>(bytesLeft, run.numBytes());
+    crc.process_bytes(run.data<char>(), size);
+    bytesLeft -= size;
+  }
+  return crc.checksum();
+}
 } // namespace
 
 SsdPin::SsdPin(SsdFile& file, SsdRun run) : file_(&file), run_(run) {
@@ -213,6 +238,15 @@ bool SsdFile::erase(RawFileCacheKey key) {
   return true;
 }
 
+void SsdFile::forEachEntry(
+    const std::function<void(RawFileCacheKey key, uint64_t size)>& func)
+    const {
+  tsan_lock_guard<std::shared_mutex> l(mutex_);
+  for (const auto& [key, run] : entries_) {
+    func(RawFileCacheKey{key.fileNum.id(), key.offset}, run.size());
+  }
+}
+
 CoalesceIoStats SsdFile::load(
     const std::vector<SsdPin>& ssdPins,
     const std::vector<CachePin>& pins) {
@@ -240,6 +274,12 @@ CoalesceIoStats SsdFile::load(
   // Do coalesced IO for the pins. For short payloads, the break-even between
   // discrete pread calls and a single preadv that discards gaps is ~25K per
   // gap. For longer payloads this is ~50-100K.
+  // With io_uring, the coalesced reads are submitted together after
+  // coalescing all the pins.
+  const bool useIoUring = IoUring::enabled();
+  std::vector<IoUring::Request> requests;
+  uint64_t readMicros = 0;
+  auto guard = folly::makeGuard([&]() { stats_.readMicros += readMicros; });
   auto stats = readPins(
       pins,
       payloadTotal / pins.size() < 10000 ? 25000 : 50000,
@@ -253,8 +293,44 @@ CoalesceIoStats SsdFile::load(
           int32_t /*end*/,
           uint64_t offset,
           const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
+        if (useIoUring) {
+          requests.push_back({fd_, offset, buffers});
+        } else {
+          MicrosecondTimer timer(&readMicros);
+          read(offset, buffers);
+        }
       });
+  if (!requests.empty()) {
+    std::vector<uint64_t> bytesRead;
+    {
+      MicrosecondTimer timer(&readMicros);
+      bytesRead = IoUring::forThread().run(requests);
+    }
+    for (auto i = 0; i < requests.size(); ++i) {
+      uint64_t bytes = 0;
+      for (const auto& buffer : requests[i].buffers) {
+        bytes += buffer.size();
+      }
+      if (FOLLY_UNLIKELY(bytesRead[i] != bytes)) {
+        ++stats_.readSsdErrors;
+        VELOX_FAIL(
+            "IOERR: Short read from SSD cache: {} of {} bytes at {}",
+            bytesRead[i],
+            bytes,
+            requests[i].offset);
+      }
+    }
+  }
+
+  for (auto i = 0; i < ssdPins.size(); ++i) {
+    const auto run = ssdPins[i].run();
+    auto* entry = pins[i].checkedEntry();
+    // A checksum covers the whole run, so a shorter entry can not be verified.
+    if (FLAGS_ssd_checksum && run.checksum() != 0 &&
+        run.size() == entry->size()) {
+      verifyChecksum(*entry, run);
+    }
+  }
 
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
@@ -367,12 +443,41 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     total += entry->size();
   }
 
+  std::vector<uint32_t> checksums(pins.size(), 0);
+  // Adds the 'numWritten' pins from 'begin' written at 'offset' to 'entries_'.
+  const auto addEntries =
+      [&](int32_t begin, int32_t numWritten, uint64_t offset) {
+        std::lock_guard<std::shared_mutex> l(mutex_);
+        for (auto i = begin; i < begin + numWritten; ++i) {
+          auto* entry = pins[i].checkedEntry();
+          entry->setSsdFile(this, offset);
+          const auto size = entry->size();
+          FileCacheKey key = {
+              entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
+          entries_[std::move(key)] = SsdRun(offset, size, checksums[i]);
+          if (FLAGS_ssd_verify_write) {
+            verifyWrite(*entry, SsdRun(offset, size));
+          }
+          offset += size;
+          ++stats_.entriesWritten;
+          stats_.bytesWritten += size;
+          bytesAfterCheckpoint_ += size;
+        }
+      };
+
+  // With io_uring, the writes to all the regions are submitted together after
+  // getting the space for all the pins.
+  const bool useIoUring = IoUring::enabled();
+  std::vector<IoUring::Request> requests;
+  // {begin, numWritten, offset} for each of 'requests'.
+  std::vector<std::tuple<int32_t, int32_t, uint64_t>> requestPins;
+
   int32_t storeIndex = 0;
   while (storeIndex < pins.size()) {
     auto space = getSpace(pins, storeIndex);
     if (!space.has_value()) {
       // No space can be reclaimed. The pins are freed when the caller is freed.
-      return;
+      break;
     }
 
     auto [offset, available] = space.value();
@@ -386,12 +491,33 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         break;
       }
       addEntryToIovecs(*entry, iovecs);
+      if (FLAGS_ssd_checksum) {
+        checksums[i] = checksumEntry(*entry);
+      }
       bytes += entrySize;
       ++numWritten;
     }
     VELOX_CHECK_GE(fileSize_, offset + bytes);
 
-    const auto rc = folly::pwritev(fd_, iovecs.data(), iovecs.size(), offset);
+    if (useIoUring) {
+      std::vector<folly::Range<char*>> buffers;
+      buffers.reserve(iovecs.size());
+      for (const auto& iov : iovecs) {
+        buffers.emplace_back(static_cast<char*>(iov.iov_base), iov.iov_len);
+      }
+      requests.push_back({fd_, offset, std::move(buffers), true});
+      requestPins.emplace_back(storeIndex, numWritten, offset);
+      storeIndex += numWritten;
+      continue;
+    }
+
+    ssize_t rc;
+    uint64_t writeMicros = 0;
+    {
+      MicrosecondTimer timer(&writeMicros);
+      rc = folly::pwritev(fd_, iovecs.data(), iovecs.size(), offset);
+    }
+    stats_.writeMicros += writeMicros;
     if (rc != bytes) {
       VELOX_SSD_CACHE_LOG(ERROR)
           << "Failed to write to SSD, file name: " << fileName_
@@ -403,26 +529,33 @@ void SsdFile::write(std::vector<CachePin>& pins) {
       // entries are unchanged.
       return;
     }
+    addEntries(storeIndex, numWritten, offset);
+    storeIndex += numWritten;
+  }
 
-    {
-      std::lock_guard<std::shared_mutex> l(mutex_);
-      for (auto i = storeIndex; i < storeIndex + numWritten; ++i) {
-        auto* entry = pins[i].checkedEntry();
-        entry->setSsdFile(this, offset);
-        const auto size = entry->size();
-        FileCacheKey key = {
-            entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
-        entries_[std::move(key)] = SsdRun(offset, size);
-        if (FLAGS_ssd_verify_write) {
-          verifyWrite(*entry, SsdRun(offset, size));
+  if (!requests.empty()) {
+    try {
+      uint64_t writeMicros = 0;
+      auto guard =
+          folly::makeGuard([&]() { stats_.writeMicros += writeMicros; });
+      MicrosecondTimer timer(&writeMicros);
+      const auto written = IoUring::forThread().run(requests);
+      for (auto i = 0; i < requests.size(); ++i) {
+        uint64_t bytes = 0;
+        for (const auto& buffer : requests[i].buffers) {
+          bytes += buffer.size();
         }
-        offset += size;
-        ++stats_.entriesWritten;
-        stats_.bytesWritten += size;
-        bytesAfterCheckpoint_ += size;
+        VELOX_CHECK_EQ(written[i], bytes, "Short write to SSD");
       }
+    } catch (const std::exception& e) {
+      VELOX_SSD_CACHE_LOG(ERROR) << "Failed to write to SSD, file name: "
+                                 << fileName_ << ", error: " << e.what();
+      ++stats_.writeSsdErrors;
+      return;
+    }
+    for (const auto& [begin, numWritten, offset] : requestPins) {
+      addEntries(begin, numWritten, offset);
     }
-    storeIndex += numWritten;
   }
 
   if ((checkpointIntervalBytes_ > 0) &&
@@ -471,6 +604,27 @@ void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   }
 }
 
+void SsdFile::verifyChecksum(AsyncDataCacheEntry& entry, SsdRun run) {
+  const auto checksum = checksumEntry(entry);
+  if (checksum == run.checksum()) {
+    return;
+  }
+  ++stats_.readSsdCorruptions;
+  {
+    std::lock_guard<std::shared_mutex> l(mutex_);
+    entries_.erase(FileCacheKey{
+        entry.key().fileNum, static_cast<uint64_t>(entry.offset())});
+  }
+  VELOX_FAIL(
+      "IOERR: Corrupt SSD cache entry at offset {} size {} in {}: checksum {} "
+      "expected {}",
+      run.offset(),
+      run.size(),
+      fileName_,
+      checksum,
+      run.checksum());
+}
+
 void SsdFile::updateStats(SsdCacheStats& stats) const {
   // Lock only in tsan build. Incrementing the counters has no synchronized
   // emantics.
@@ -496,6 +650,20 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.writeCheckpointErrors += stats_.writeCheckpointErrors;
   stats.readSsdErrors += stats_.readSsdErrors;
   stats.readCheckpointErrors += stats_.readCheckpointErrors;
+  stats.readSsdCorruptions += stats_.readSsdCorruptions;
+  stats.writeMicros += stats_.writeMicros;
+  stats.readMicros += stats_.readMicros;
+
+  SsdDeviceStats device;
+  device.shardId = shardId_;
+  device.bytesWritten = stats_.bytesWritten;
+  device.writeMicros = stats_.writeMicros;
+  device.bytesRead = stats_.bytesRead;
+  device.readMicros = stats_.readMicros;
+  for (auto& regionSize : regionSizes_) {
+    device.bytesCached += regionSize;
+  }
+  stats.devices.push_back(device);
 }
 
 void SsdFile::clear() {
@@ -608,6 +776,11 @@ void SsdFile::checkpoint(bool force) {
     auto checkpointPath = fileName_ + kCheckpointExtension;
     state.exceptions(std::ofstream::failbit);
     state.open(checkpointPath, std::ios_base::out | std::ios_base::trunc);
+    bits::Crc32 crc;
+    const auto write = [&](const char* data, int32_t size) {
+      state.write(data, size);
+      crc.process_bytes(data, size);
+    };
     // The checkpoint state file contains:
     // int32_t The 4 bytes of kCheckpointMagic,
     // int32_t maxRegions,
@@ -615,35 +788,38 @@ void SsdFile::checkpoint(bool force) {
     // regionScores from the 'tracker_',
     // {fileId, fileName} pairs,
     // kMapMarker,
-    // {fileId, offset, SSdRun} triples,
-    // kEndMarker.
-    state.write(kCheckpointMagic, sizeof(int32_t));
-    state.write(asChar(&maxRegions_), sizeof(maxRegions_));
-    state.write(asChar(&numRegions_), sizeof(numRegions_));
+    // {fileId, offset, SSdRun, checksum} tuples,
+    // kEndMarker,
+    // uint32_t crc32 of the above.
+    write(kCheckpointMagic, sizeof(int32_t));
+    write(asChar(&maxRegions_), sizeof(maxRegions_));
+    write(asChar(&numRegions_), sizeof(numRegions_));
 
     // Copy the region scores before writing out for tsan.
     const auto scoresCopy = tracker_.copyScores();
-    state.write(asChar(scoresCopy.data()), maxRegions_ * sizeof(uint64_t));
+    write(asChar(scoresCopy.data()), maxRegions_ * sizeof(uint64_t));
     std::unordered_set<uint64_t> fileNums;
     for (const auto& entry : entries_) {
       const auto fileNum = entry.first.fileNum.id();
       if (fileNums.insert(fileNum).second) {
-        state.write(asChar(&fileNum), sizeof(fileNum));
+        write(asChar(&fileNum), sizeof(fileNum));
         const auto name = fileIds().string(fileNum);
         const int32_t length = name.size();
-        state.write(asChar(&length), sizeof(length));
-        state.write(name.data(), length);
+        write(asChar(&length), sizeof(length));
+        write(name.data(), length);
       }
     }
 
     const auto mapMarker = kCheckpointMapMarker;
-    state.write(asChar(&mapMarker), sizeof(mapMarker));
+    write(asChar(&mapMarker), sizeof(mapMarker));
     for (auto& pair : entries_) {
       auto id = pair.first.fileNum.id();
-      state.write(asChar(&id), sizeof(id));
-      state.write(asChar(&pair.first.offset), sizeof(pair.first.offset));
+      write(asChar(&id), sizeof(id));
+      write(asChar(&pair.first.offset), sizeof(pair.first.offset));
       auto offsetAndSize = pair.second.bits();
-      state.write(asChar(&offsetAndSize), sizeof(offsetAndSize));
+      write(asChar(&offsetAndSize), sizeof(offsetAndSize));
+      auto checksum = pair.second.checksum();
+      write(asChar(&checksum), sizeof(checksum));
     }
 
     // NOTE: we need to ensure cache file data sync update completes before
@@ -652,7 +828,9 @@ void SsdFile::checkpoint(bool force) {
     checkRc(*fileSyncRc, "Sync of cache data file");
 
     const auto endMarker = kCheckpointEndMarker;
-    state.write(asChar(&endMarker), sizeof(endMarker));
+    write(asChar(&endMarker), sizeof(endMarker));
+    const auto checkpointChecksum = crc.checksum();
+    state.write(asChar(&checkpointChecksum), sizeof(checkpointChecksum));
 
     if (state.bad()) {
       ++stats_.writeCheckpointErrors;
@@ -718,6 +896,7 @@ void SsdFile::initializeCheckpoint() {
       VELOX_SSD_CACHE_LOG(ERROR) << "Error recovering from checkpoint "
                                  << e.what() << ": Starting without checkpoint";
       entries_.clear();
+      std::fill(regionSizes_.begin(), regionSizes_.end(), 0);
       deleteCheckpoint(true);
     } catch (const std::exception& e) {
     }
@@ -742,35 +921,51 @@ bool SsdFile::testingIsCowDisabled() const {
 }
 
 namespace {
+// Reads 'size' bytes from 'stream' into 'data' and adds them to 'crc'.
+void readBytes(
+    std::ifstream& stream,
+    char* data,
+    int64_t size,
+    bits::Crc32& crc) {
+  stream.read(data, size);
+  crc.process_bytes(data, size);
+}
+
 template <typename T>
-T readNumber(std::ifstream& stream) {
+T readNumber(std::ifstream& stream, bits::Crc32& crc) {
   T data;
-  stream.read(asChar(&data), sizeof(T));
+  readBytes(stream, asChar(&data), sizeof(T), crc);
   return data;
 }
 } // namespace
 
 void SsdFile::readCheckpoint(std::ifstream& state) {
+  bits::Crc32 crc;
   char magic[4];
-  state.read(magic, sizeof(magic));
-  VELOX_CHECK_EQ(strncmp(magic, kCheckpointMagic, 4), 0);
-  const auto maxRegions = readNumber<int32_t>(state);
+  readBytes(state, magic, sizeof(magic), crc);
+  // Version 1 checkpoints have no checksums and are still accepted so that an
+  // upgrade does not start with a cold cache.
+  const bool hasChecksums = strncmp(magic, kCheckpointMagic, 4) == 0;
+  if (!hasChecksums) {
+    VELOX_CHECK_EQ(strncmp(magic, kCheckpointMagicV1, 4), 0);
+  }
+  const auto maxRegions = readNumber<int32_t>(state, crc);
   VELOX_CHECK_EQ(
       maxRegions,
       maxRegions_,
       "Trying to start from checkpoint with a different capacity");
-  numRegions_ = readNumber<int32_t>(state);
+  numRegions_ = readNumber<int32_t>(state, crc);
   std::vector<int64_t> scores(maxRegions);
-  state.read(asChar(scores.data()), maxRegions_ * sizeof(uint64_t));
+  readBytes(state, asChar(scores.data()), maxRegions_ * sizeof(uint64_t), crc);
   std::unordered_map<uint64_t, StringIdLease> idMap;
   for (;;) {
-    auto id = readNumber<uint64_t>(state);
+    auto id = readNumber<uint64_t>(state, crc);
     if (id == kCheckpointMapMarker) {
       break;
     }
     std::string name;
-    name.resize(readNumber<int32_t>(state));
-    state.read(name.data(), name.size());
+    name.resize(readNumber<int32_t>(state, crc));
+    readBytes(state, name.data(), name.size(), crc);
     auto lease = StringIdLease(fileIds(), name);
     idMap[id] = std::move(lease);
   }
@@ -784,21 +979,33 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
     evictedMap.insert(region);
   }
   for (;;) {
-    const uint64_t fileNum = readNumber<uint64_t>(state);
+    const uint64_t fileNum = readNumber<uint64_t>(state, crc);
     if (fileNum == kCheckpointEndMarker) {
       break;
     }
-    const uint64_t offset = readNumber<uint64_t>(state);
-    const auto run = SsdRun(readNumber<uint64_t>(state));
+    const uint64_t offset = readNumber<uint64_t>(state, crc);
+    const auto bits = readNumber<uint64_t>(state, crc);
+    const auto run =
+        SsdRun(bits, hasChecksums ? readNumber<uint32_t>(state, crc) : 0);
     // Check that the recovered entry does not fall in an evicted region.
-    if (evictedMap.find(regionIndex(run.offset())) == evictedMap.end()) {
+    const auto region = regionIndex(run.offset());
+    if (evictedMap.find(region) == evictedMap.end()) {
       // The file may have a different id on restore.
       auto it = idMap.find(fileNum);
       VELOX_CHECK(it != idMap.end());
       FileCacheKey key{it->second, offset};
       entries_[std::move(key)] = run;
+      regionSizes_[region] = std::max<uint64_t>(
+          regionSizes_[region],
+          run.offset() - region * kRegionSize + run.size());
     }
   }
+  if (hasChecksums) {
+    const auto expectedChecksum = crc.checksum();
+    const auto checksum = readNumber<uint32_t>(state, crc);
+    VELOX_CHECK_EQ(
+        checksum, expectedChecksum, "Checksum mismatch in checkpoint");
+  }
   // The state is successfully read. Install the access frequency scores and
   // evicted regions.
   VELOX_CHECK_EQ(scores.size(), tracker_.regionScores().size());
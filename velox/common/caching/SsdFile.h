@@ -24,34 +24,39 @@
 
 DECLARE_bool(ssd_odirect);
 DECLARE_bool(ssd_verify_write);
+DECLARE_bool(ssd_checksum);
 
 namespace facebook::velox::cache {
 
 // A 64 bit word describing a SSD cache entry in an SsdFile. The low
 // 23 bits are the size, for a maximum entry size of 8MB. The high
-// bits are the offset.
+// bits are the offset. The run also has the crc32 of the entry data if the
+// entry was written with FLAGS_ssd_checksum.
 class SsdRun {
  public:
   static constexpr int32_t kSizeBits = 23;
 
-  SsdRun() : bits_(0) {}
+  SsdRun() : bits_(0), checksum_(0) {}
 
-  SsdRun(uint64_t offset, uint32_t size)
-      : bits_((offset << kSizeBits) | ((size - 1))) {
+  SsdRun(uint64_t offset, uint32_t size, uint32_t checksum = 0)
+      : bits_((offset << kSizeBits) | ((size - 1))), checksum_(checksum) {
     VELOX_CHECK_LT(offset, 1L << (64 - kSizeBits));
     VELOX_CHECK_LT(size - 1, 1 << kSizeBits);
   }
 
-  SsdRun(uint64_t bits) : bits_(bits) {}
+  SsdRun(uint64_t bits, uint32_t checksum = 0)
+      : bits_(bits), checksum_(checksum) {}
 
   SsdRun(const SsdRun& other) = default;
   SsdRun(SsdRun&& other) = default;
 
   void operator=(const SsdRun& other) {
     bits_ = other.bits_;
+    checksum_ = other.checksum_;
   }
   void operator=(SsdRun&& other) {
     bits_ = other.bits_;
+    checksum_ = other.checksum_;
   }
 
   uint64_t offset() const {
@@ -67,8 +72,14 @@ class SsdRun {
     return bits_;
   }
 
+  // Returns the crc32 of the entry data or 0 if the entry has no checksum.
+  uint32_t checksum() const {
+    return checksum_;
+  }
+
  private:
   uint64_t bits_;
+  uint32_t checksum_;
 };
 
 // Represents an SsdFile entry that is planned for load or being
@@ -118,6 +129,25 @@ class SsdPin {
   SsdRun run_;
 };
 
+// Metrics for one SsdFile, i.e. for the device the file is on.
+struct SsdDeviceStats {
+  int32_t shardId{0};
+  uint64_t bytesWritten{0};
+  // Time spent in writing 'bytesWritten'.
+  uint64_t writeMicros{0};
+  uint64_t bytesRead{0};
+  // Time spent in reads. Concurrent reads are counted in full.
+  uint64_t readMicros{0};
+  uint64_t bytesCached{0};
+  // Recent write throughput as measured by SsdCache. 0 if not measured.
+  double writeBytesPerMicro{0};
+  // Share of new files placed on the device relative to the fastest device.
+  // See SsdCache.
+  double weight{1};
+  // Bytes not written because the device was slower than the others.
+  uint64_t bytesThrottled{0};
+};
+
 // Metrics for SSD cache. Maintained by SsdFile and aggregated by SsdCache.
 struct SsdCacheStats {
   SsdCacheStats() {}
@@ -144,6 +174,10 @@ struct SsdCacheStats {
     writeCheckpointErrors = tsanAtomicValue(other.writeCheckpointErrors);
     readSsdErrors = tsanAtomicValue(other.readSsdErrors);
     readCheckpointErrors = tsanAtomicValue(other.readCheckpointErrors);
+    readSsdCorruptions = tsanAtomicValue(other.readSsdCorruptions);
+    writeMicros = tsanAtomicValue(other.writeMicros);
+    readMicros = tsanAtomicValue(other.readMicros);
+    devices = other.devices;
   }
 
   tsan_atomic<uint64_t> entriesWritten{0};
@@ -163,6 +197,13 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> writeCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdErrors{0};
   tsan_atomic<uint32_t> readCheckpointErrors{0};
+  tsan_atomic<uint32_t> readSsdCorruptions{0};
+
+  tsan_atomic<uint64_t> writeMicros{0};
+  tsan_atomic<uint64_t> readMicros{0};
+
+  // Stats of each device, in the order of the shards.
+  std::vector<SsdDeviceStats> devices;
 };
 
 // A shard of SsdCache. Corresponds to one file on SSD.  The data
@@ -198,6 +239,12 @@ class SsdFile {
   // Erases 'key'
   bool erase(RawFileCacheKey key);
 
+  // Calls 'func' with the key and size of each entry. 'func' must not call
+  // back into 'this'.
+  void forEachEntry(
+      const std::function<void(RawFileCacheKey key, uint64_t size)>& func)
+      const;
+
   // Copies the data in 'ssdPins' into 'pins'. Coalesces IO for nearby
   // entries if they are in ascending order and near enough.
   CoalesceIoStats load(
@@ -236,7 +283,8 @@ class SsdFile {
     return shardId_;
   }
 
-  // Adds 'stats_' to 'stats'.
+  // Adds 'stats_' to 'stats' and appends the stats of 'this' to
+  // 'stats.devices'.
   void updateStats(SsdCacheStats& stats) const;
 
   // Resets this' to a post-construction empty state. See SsdCache::clear().
@@ -256,8 +304,10 @@ class SsdFile {
 
  private:
   // 4 first bytes of a checkpoint file. Allows distinguishing between format
-  // versions.
-  static constexpr const char* kCheckpointMagic = "CPT1";
+  // versions. Version 2 adds the checksum of each entry and the checksum of
+  // the checkpoint file after kCheckpointEndMarker.
+  static constexpr const char* kCheckpointMagic = "CPT2";
+  static constexpr const char* kCheckpointMagicV1 = "CPT1";
   // Magic number separating file names from cache entry data in checkpoint
   // file.
   static constexpr int64_t kCheckpointMapMarker = 0xfffffffffffffffe;
@@ -292,6 +342,10 @@ class SsdFile {
   // Verifies that 'entry' has the data at 'run'.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
 
+  // Checks that the data read into 'entry' matches the checksum of 'run'.
+  // Erases the entry and throws if not.
+  void verifyChecksum(AsyncDataCacheEntry& entry, SsdRun run);
+
   // Deletes checkpoint files. If 'keepLog' is true, truncates and syncs the
   // eviction log and leaves this open.
   void deleteCheckpoint(bool keepLog = false);
@@ -22,6 +22,7 @@
 #include "velox/common/memory/MmapAllocator.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
+#include <folly/Random.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
@@ -780,6 +781,47 @@ TEST_F(AsyncDataCacheTest, invalidSsdPath) {
           testPath));
 }
 
+TEST_F(AsyncDataCacheTest, ssdDeviceWeights) {
+  constexpr uint64_t kRamBytes = 32 << 20;
+  constexpr uint64_t kSsdBytes = 512UL << 20;
+  constexpr int32_t kNumShards = 4;
+  initializeCache(kRamBytes, kSsdBytes);
+  auto* ssdCache = cache_->ssdCache();
+  // Equally fast devices get the files by file id.
+  for (auto fileId = 0; fileId < 100; ++fileId) {
+    ASSERT_EQ(fileId % kNumShards, ssdCache->file(fileId).shardId());
+  }
+  for (auto shard = 0; shard < kNumShards; ++shard) {
+    ssdCache->testingRecordWrite(shard, 64 << 20, shard == 0 ? 4'000 : 1'100);
+  }
+  auto stats = ssdCache->stats();
+  ASSERT_EQ(kNumShards, stats.devices.size());
+  ASSERT_EQ(0.25, stats.devices[0].weight);
+  for (auto shard = 1; shard < kNumShards; ++shard) {
+    ASSERT_EQ(shard, stats.devices[shard].shardId);
+    ASSERT_EQ(1, stats.devices[shard].weight);
+  }
+  ASSERT_NE(std::string::npos, ssdCache->toString().find("weight 0.25"));
+
+  // Placed files keep their shard. New files go less to the slow device, 0.25
+  // / 3.25 of them on average.
+  for (auto fileId = 0; fileId < 100; ++fileId) {
+    ASSERT_EQ(fileId % kNumShards, ssdCache->file(fileId).shardId());
+  }
+  int32_t numOnSlow = 0;
+  for (auto fileId = 1'000; fileId < 11'000; ++fileId) {
+    numOnSlow += ssdCache->file(fileId).shardId() == 0;
+  }
+  ASSERT_LT(400, numOnSlow);
+  ASSERT_GT(1'200, numOnSlow);
+
+  // The device recovers.
+  for (auto i = 0; i < 10; ++i) {
+    ssdCache->testingRecordWrite(0, 64 << 20, 1'000);
+  }
+  ASSERT_EQ(1, ssdCache->stats().devices[0].weight);
+}
+
 TEST_F(AsyncDataCacheTest, cacheStats) {
   CacheStats stats;
   stats.tinySize = 234;
@@ -799,6 +841,8 @@ TEST_F(AsyncDataCacheTest, cacheStats) {
   stats.numEvictChecks = 348;
   stats.numWaitExclusive = 244;
   stats.allocClocks = 1320;
+  stats.lockWaitClocks = 3 << 20;
+  stats.evictClocks = 5 << 20;
   stats.sumEvictScore = 123;
   ASSERT_EQ(
       stats.toString(),
@@ -806,7 +850,7 @@ TEST_F(AsyncDataCacheTest, cacheStats) {
       "Cache entries: 100 read pins: 30 write pins: 20 num write wait: 244 empty entries: 20\n"
       "Cache access miss: 2041 hit: 46 hit bytes: 1.34KB eviction: 463 eviction checks: 348\n"
       "Prefetch entries: 30 bytes: 100B\n"
-      "Alloc Megaclocks 0");
+      "Alloc Megaclocks 0 lock wait Megaclocks 3 evict Megaclocks 5");
 
   constexpr uint64_t kRamBytes = 32 << 20;
   constexpr uint64_t kSsdBytes = 512UL << 20;
@@ -818,7 +862,7 @@ TEST_F(AsyncDataCacheTest, cacheStats) {
       "Cache entries: 0 read pins: 0 write pins: 0 num write wait: 0 empty entries: 0\n"
       "Cache access miss: 0 hit: 0 hit bytes: 0B eviction: 0 eviction checks: 0\n"
       "Prefetch entries: 0 bytes: 0B\n"
-      "Alloc Megaclocks 0\n"
+      "Alloc Megaclocks 0 lock wait Megaclocks 0 evict Megaclocks 0\n"
       "Allocated pages: 0 cached pages: 0\n"
       "Backing: Memory Allocator[MMAP capacity 16.00KB allocated pages 0 mapped pages 0 external mapped pages 0\n"
       "[size 1: 0(0MB) allocated 0 mapped]\n"
@@ -834,3 +878,235 @@ TEST_F(AsyncDataCacheTest, cacheStats) {
       "SSD: Ssd cache IO: Write 0MB read 0MB Size 0GB Occupied 0GB0K entries.\n"
       "GroupStats: <dummy FileGroupStats>");
 }
+
+TEST(FrequencySketchTest, estimate) {
+  FrequencySketch sketch(1024);
+  for (auto i = 0; i < 100; ++i) {
+    for (auto j = 0; j <= i % 10; ++j) {
+      sketch.increment(i);
+    }
+  }
+  for (auto i = 0; i < 100; ++i) {
+    ASSERT_GE(sketch.estimate(i), i % 10 + 1);
+  }
+  for (auto i = 0; i < 100; ++i) {
+    sketch.increment(1'000);
+  }
+  ASSERT_EQ(FrequencySketch::kMaxCount, sketch.estimate(1'000));
+
+  // The counts are halved after 10 increments per counter.
+  for (auto i = 0; i < 10 * 1024; ++i) {
+    sketch.increment(2'000 + i);
+  }
+  ASSERT_GE(FrequencySketch::kMaxCount / 2, sketch.estimate(1'000));
+  ASSERT_LT(0, sketch.estimate(1'000));
+}
+
+TEST_F(AsyncDataCacheTest, tinyLfuAdmission) {
+  constexpr int64_t kMaxBytes = 64 << 20;
+  constexpr int32_t kSize = 64 << 10;
+  constexpr int32_t kNumHot = 50;
+  initializeCache(kMaxBytes);
+  cache_->setAdmissionPolicy(
+      []() { return std::make_unique<TinyLfuAdmissionPolicy>(); });
+
+  const auto load = [&](uint64_t offset, bool scanHint) {
+    folly::SemiFuture<bool> wait(false);
+    RawFileCacheKey key{filenames_[0].id(), offset};
+    auto pin = cache_->findOrCreate(key, kSize, &wait);
+    ASSERT_FALSE(pin.empty());
+    if (pin.entry()->isExclusive()) {
+      pin.entry()->setScanHint(scanHint);
+      pin.entry()->setExclusiveToShared();
+    }
+  };
+
+  // Frequently used data, e.g. of a dimension table.
+  for (auto i = 0; i < 10; ++i) {
+    for (auto offset = 0; offset < kNumHot * kSize; offset += kSize) {
+      load(offset, false);
+    }
+  }
+  // A one-shot scan of twice the cache capacity.
+  for (auto offset = kNumHot * kSize; offset < kNumHot * kSize + 2 * kMaxBytes;
+       offset += kSize) {
+    load(offset, true);
+  }
+  for (auto offset = 0; offset < kNumHot * kSize; offset += kSize) {
+    ASSERT_TRUE(cache_->exists(RawFileCacheKey{filenames_[0].id(), offset}));
+  }
+  const auto stats = cache_->refreshStats();
+  ASSERT_EQ("TinyLFU", stats.admissionPolicy);
+  ASSERT_LT(0, stats.numEvict);
+  ASSERT_LT(0, stats.numPolicyRejects + stats.numPolicyRetains);
+  ASSERT_NE(
+      std::string::npos, stats.toString().find("Admission policy TinyLFU"));
+
+  cache_->setAdmissionPolicy(nullptr);
+  ASSERT_TRUE(cache_->refreshStats().admissionPolicy.empty());
+}
+
+TEST_F(AsyncDataCacheTest, compressedTier) {
+  constexpr int32_t kSize = 256 << 10;
+  // 4x the capacity of the cache.
+  constexpr int32_t kNumEntries = 1'000;
+  initializeCache(64 << 20);
+  cache_->setCompressedTier({.capacity = 64 << 20});
+
+  // Text-like contents that compress well if 'compressible'.
+  const auto contents = [](uint64_t offset, bool compressible) {
+    std::string data;
+    folly::Random::DefaultGenerator rng(offset);
+    while (data.size() < kSize) {
+      data += compressible
+          ? fmt::format("{},row {},some text,", offset, data.size() % 97)
+          : fmt::format("{}", folly::Random::rand64(rng));
+    }
+    data.resize(kSize);
+    return data;
+  };
+  const auto load = [&](bool compressible) {
+    for (auto i = 0; i < kNumEntries; ++i) {
+      const uint64_t offset = i * kSize;
+      auto pin =
+          cache_->findOrCreate({filenames_[0].id(), offset}, kSize, nullptr);
+      ASSERT_TRUE(pin.checkedEntry()->isExclusive());
+      const auto data = contents(offset, compressible);
+      uint64_t copied = 0;
+      auto& allocation = pin.entry()->data();
+      for (auto j = 0; j < allocation.numRuns() && copied < kSize; ++j) {
+        const auto run = allocation.runAt(j);
+        const auto bytes = std::min<uint64_t>(run.numBytes(), kSize - copied);
+        memcpy(run.data(), data.data() + copied, bytes);
+        copied += bytes;
+      }
+      pin.entry()->setExclusiveToShared();
+    }
+  };
+
+  load(true);
+  auto stats = cache_->refreshStats();
+  ASSERT_LT(0, stats.numEvict);
+  ASSERT_LT(0, stats.numCompressed);
+  ASSERT_GE(64 << 20, stats.compressedBytes);
+  ASSERT_LT(stats.compressedBytes * 2, stats.compressedRawBytes);
+  ASSERT_NE(std::string::npos, stats.toString().find("Compressed tier"));
+
+  // The first entries are evicted from memory. Misses on the ones in the
+  // compressed tier return a filled entry.
+  for (auto i = 0; i < kNumEntries / 4; ++i) {
+    const uint64_t offset = i * kSize;
+    auto pin =
+        cache_->findOrCreate({filenames_[0].id(), offset}, kSize, nullptr);
+    if (pin.checkedEntry()->isExclusive()) {
+      continue;
+    }
+    std::string data;
+    auto& allocation = pin.entry()->data();
+    for (auto j = 0; j < allocation.numRuns(); ++j) {
+      const auto run = allocation.runAt(j);
+      data.append(run.data<char>(), run.numBytes());
+    }
+    data.resize(kSize);
+    ASSERT_EQ(contents(offset, true), data);
+  }
+  ASSERT_LT(stats.numCompressedHit, cache_->refreshStats().numCompressedHit);
+
+  // Incompressible entries are not kept.
+  cache_->clear();
+  ASSERT_EQ(0, cache_->refreshStats().numCompressed);
+  load(false);
+  stats = cache_->refreshStats();
+  ASSERT_LT(0, stats.numCompressRejects);
+  ASSERT_EQ(0, stats.numCompressed);
+
+  cache_->setCompressedTier({});
+  ASSERT_EQ(0, cache_->refreshStats().compressedCapacity);
+}
+
+TEST_F(AsyncDataCacheTest, concurrentHits) {
+  constexpr int32_t kSize = 16 << 10;
+  constexpr int32_t kNumEntries = 100;
+  constexpr int32_t kNumThreads = 16;
+  constexpr int32_t kNumLookups = 2'000;
+  initializeCache(64 << 20);
+  for (auto i = 0; i < kNumEntries; ++i) {
+    auto pin = newEntry(i * kSize, kSize);
+    initializeContents(
+        filenames_[0].id() + i * kSize, pin.checkedEntry()->data());
+    pin.entry()->setExclusiveToShared();
+    // The first use of a prefetched entry is not a hit.
+    pin = cache_->findOrCreate({filenames_[0].id(), i * kSize}, kSize, nullptr);
+    ASSERT_FALSE(pin.checkedEntry()->isPrefetch());
+  }
+  const auto numHitsBefore = cache_->refreshStats().numHit;
+
+  // Half of the threads only hit. The others also add entries, which takes
+  // the shard mutexes exclusively.
+  runThreads(kNumThreads, [&](int32_t threadIndex) {
+    folly::Random::DefaultGenerator rng(threadIndex);
+    for (auto i = 0; i < kNumLookups; ++i) {
+      const uint64_t offset = folly::Random::rand32(kNumEntries, rng) * kSize;
+      auto pin =
+          cache_->findOrCreate({filenames_[0].id(), offset}, kSize, nullptr);
+      ASSERT_FALSE(pin.empty());
+      ASSERT_TRUE(pin.checkedEntry()->isShared());
+      if (i % 100 == 0) {
+        checkContents(*pin.entry());
+      }
+      if (threadIndex % 2 == 1 && i % 10 == 0) {
+        const uint64_t newOffset =
+            (kNumEntries + threadIndex * kNumLookups + i) * kSize;
+        auto newPin = cache_->findOrCreate(
+            {filenames_[0].id(), newOffset}, kSize, nullptr);
+        ASSERT_TRUE(newPin.checkedEntry()->isExclusive());
+        newPin.entry()->setExclusiveToShared();
+      }
+    }
+  });
+
+  const auto stats = cache_->refreshStats();
+  ASSERT_EQ(numHitsBefore + kNumThreads * kNumLookups, stats.numHit);
+  ASSERT_EQ(0, stats.numShared);
+  ASSERT_EQ(0, stats.numExclusive);
+}
+
+TEST_F(AsyncDataCacheTest, numShards) {
+  ASSERT_EQ(4, AsyncDataCache::numShardsForCores(0));
+  ASSERT_EQ(4, AsyncDataCache::numShardsForCores(8));
+  ASSERT_EQ(8, AsyncDataCache::numShardsForCores(12));
+  ASSERT_EQ(32, AsyncDataCache::numShardsForCores(64));
+  ASSERT_EQ(64, AsyncDataCache::numShardsForCores(96));
+  ASSERT_EQ(64, AsyncDataCache::numShardsForCores(512));
+}
+
+TEST_F(AsyncDataCacheTest, residency) {
+  constexpr int32_t kSize = 1 << 20;
+  initializeCache(64 << 20);
+  for (auto i = 0; i < 4; ++i) {
+    auto pin = newEntry(i * kSize, kSize);
+    pin.entry()->setExclusiveToShared();
+  }
+  // An entry that is being loaded does not count.
+  auto loadingPin = newEntry(10 * kSize, kSize);
+
+  const auto fileNum = filenames_[0].id();
+  ASSERT_EQ(1.0, cache_->residentFraction(fileNum, {{0, 4 * kSize}}));
+  ASSERT_EQ(0.5, cache_->residentFraction(fileNum, {{2 * kSize, 4 * kSize}}));
+  // Overlapping regions count once.
+  ASSERT_EQ(
+      1.0, cache_->residentFraction(fileNum, {{0, kSize}, {kSize / 2, kSize}}));
+  ASSERT_EQ(0, cache_->residentFraction(fileNum, {{10 * kSize, kSize}}));
+  ASSERT_EQ(0, cache_->residentFraction(filenames_[1].id(), {{0, kSize}}));
+
+  const auto digest = cache_->residencyDigest();
+  const auto fileName = fileIds().string(fileNum);
+  ASSERT_EQ(
+      1.0, AsyncDataCache::residentFraction(digest, fileName, {0, 4 * kSize}));
+  ASSERT_EQ(
+      0.5,
+      AsyncDataCache::residentFraction(
+          digest, fileName, {0, 2 * AsyncDataCache::kResidencyGranularity}));
+  ASSERT_EQ(
+      0, AsyncDataCache::residentFraction(digest, "otherFile", {0, kSize}));
+}
@@ -14,10 +14,12 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
+#include <fcntl.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -53,7 +55,8 @@ class SsdFileTest : public testing::Test {
   void initializeCache(
       int64_t maxBytes,
       int64_t ssdBytes = 0,
-      bool setNoCowFlag = false) {
+      bool setNoCowFlag = false,
+      int64_t checkpointIntervalBytes = 0) {
     // tmpfs does not support O_DIRECT, so turn this off for testing.
     FLAGS_ssd_odirect = false;
     cache_ = AsyncDataCache::create(MemoryAllocator::getInstance());
@@ -61,14 +64,29 @@ class SsdFileTest : public testing::Test {
     fileName_ = StringIdLease(fileIds(), "fileInStorage");
 
     tempDirectory_ = exec::test::TempDirectoryPath::create();
+    openSsdFile(ssdBytes, setNoCowFlag, checkpointIntervalBytes);
+  }
+
+  void openSsdFile(
+      int64_t ssdBytes,
+      bool setNoCowFlag = false,
+      int64_t checkpointIntervalBytes = 0) {
     ssdFile_ = std::make_unique<SsdFile>(
         fmt::format("{}/ssdtest", tempDirectory_->path),
         0, // shardId
         bits::roundUp(ssdBytes, SsdFile::kRegionSize) / SsdFile::kRegionSize,
-        0, // checkpointInternalBytes
+        checkpointIntervalBytes,
         setNoCowFlag);
   }
 
+  // Simulates a restart: drops the memory cache and opens the SSD file again,
+  // recovering from its checkpoint.
+  void restart(int64_t ssdBytes, int64_t checkpointIntervalBytes) {
+    cache_->clear();
+    ssdFile_.reset();
+    openSsdFile(ssdBytes, false, checkpointIntervalBytes);
+  }
+
   static void initializeContents(int64_t sequence, memory::Allocation& alloc) {
     bool first = true;
     for (int32_t i = 0; i < alloc.numRuns(); ++i) {
@@ -312,3 +330,77 @@ TEST_F(SsdFileTest, notDisabledCow) {
   EXPECT_FALSE(ssdFile_->testingIsCowDisabled());
 }
 #endif // VELOX_SSD_FILE_TEST_SET_NO_COW_FLAG
+
+TEST_F(SsdFileTest, checkpointWithChecksums) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  FLAGS_ssd_checksum = true;
+  initializeCache(128 * kMB, kSsdSize, false, kSsdSize);
+  auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 32 * kMB);
+  ssdFile_->write(pins);
+  const auto firstOffset = pins[0].entry()->ssdOffset();
+  pins.clear();
+  ssdFile_->checkpoint(true);
+
+  // The entries are found and read after restarting from the checkpoint.
+  restart(kSsdSize, kSsdSize);
+  pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 32 * kMB);
+  readAndCheckPins(pins);
+  pins.clear();
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  ASSERT_GE(stats.bytesCached, 32 * kMB);
+  ASSERT_EQ(stats.readSsdCorruptions, 0);
+
+  // Overwrites the data of the first entry behind the back of the cache. The
+  // corrupt entry is detected on read and dropped.
+  {
+    const auto path = fmt::format("{}/ssdtest", tempDirectory_->path);
+    auto fd = ::open(path.c_str(), O_WRONLY);
+    ASSERT_GE(fd, 0);
+    const int64_t garbage = -1;
+    ASSERT_EQ(
+        ::pwrite(fd, &garbage, sizeof(garbage), firstOffset), sizeof(garbage));
+    ::close(fd);
+  }
+  restart(kSsdSize, kSsdSize);
+  pins.push_back(
+      cache_->findOrCreate(RawFileCacheKey{fileName_.id(), 0}, 4096, nullptr));
+  std::vector<SsdPin> ssdPins;
+  ssdPins.push_back(ssdFile_->find(RawFileCacheKey{fileName_.id(), 0}));
+  ASSERT_FALSE(ssdPins.back().empty());
+  VELOX_ASSERT_THROW(ssdFile_->load(ssdPins, pins), "Corrupt SSD cache entry");
+  ASSERT_TRUE(ssdFile_->find(RawFileCacheKey{fileName_.id(), 0}).empty());
+  stats = SsdCacheStats();
+  ssdFile_->updateStats(stats);
+  ASSERT_EQ(stats.readSsdCorruptions, 1);
+  FLAGS_ssd_checksum = false;
+}
+
+TEST_F(SsdFileTest, corruptCheckpoint) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  initializeCache(128 * kMB, kSsdSize, false, kSsdSize);
+  auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 32 * kMB);
+  ssdFile_->write(pins);
+  pins.clear();
+  ssdFile_->checkpoint(true);
+
+  // Flips a byte in the middle of the checkpoint. The checksum of the
+  // checkpoint does not match and the file starts empty.
+  {
+    const auto path = fmt::format("{}/ssdtest.cpt", tempDirectory_->path);
+    auto fd = ::open(path.c_str(), O_RDWR);
+    ASSERT_GE(fd, 0);
+    const auto size = ::lseek(fd, 0, SEEK_END);
+    char byte;
+    ASSERT_EQ(::pread(fd, &byte, 1, size / 2), 1);
+    byte = ~byte;
+    ASSERT_EQ(::pwrite(fd, &byte, 1, size / 2), 1);
+    ::close(fd);
+  }
+  restart(kSsdSize, kSsdSize);
+  ASSERT_TRUE(ssdFile_->find(RawFileCacheKey{fileName_.id(), 0}).empty());
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  ASSERT_EQ(stats.readCheckpointErrors, 1);
+  ASSERT_EQ(stats.entriesCached, 0);
+}
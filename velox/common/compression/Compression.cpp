@@ -18,10 +18,47 @@
 #include "velox/common/base/Exceptions.h"
 
 #include <folly/Conv.h>
+#include <folly/Synchronized.h>
 
 namespace facebook::velox::common {
 
+namespace {
+
+folly::Synchronized<std::unordered_map<int32_t, CodecFactory>>&
+codecFactories() {
+  static folly::Synchronized<std::unordered_map<int32_t, CodecFactory>>
+      factories;
+  return factories;
+}
+
+} // namespace
+
+void registerCodecFactory(CompressionKind kind, CodecFactory factory) {
+  auto factories = codecFactories().wlock();
+  if (factory) {
+    (*factories)[kind] = std::move(factory);
+  } else {
+    factories->erase(kind);
+  }
+}
+
+std::unique_ptr<folly::io::Codec> createRegisteredCodec(CompressionKind kind) {
+  CodecFactory factory;
+  {
+    auto factories = codecFactories().rlock();
+    auto it = factories->find(kind);
+    if (it == factories->end()) {
+      return nullptr;
+    }
+    factory = it->second;
+  }
+  return factory(kind);
+}
+
 std::unique_ptr<folly::io::Codec> compressionKindToCodec(CompressionKind kind) {
+  if (auto codec = createRegisteredCodec(kind)) {
+    return codec;
+  }
   switch (static_cast<int32_t>(kind)) {
     case CompressionKind_NONE:
       return getCodec(folly::io::CodecType::NO_COMPRESSION);
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <folly/compression/Compression.h>
+#include <functional>
 #include <string>
 
 namespace facebook::velox::common {
@@ -32,8 +33,27 @@ enum CompressionKind {
   CompressionKind_MAX = INT64_MAX
 };
 
+/// Returns the codec registered for 'kind' by registerCodecFactory() or the
+/// folly software codec for 'kind' if there is none.
 std::unique_ptr<folly::io::Codec> compressionKindToCodec(CompressionKind kind);
 
+/// Creates a codec for a compression kind, e.g. one that offloads to a
+/// hardware accelerator. Returns nullptr if the codec is not available on
+/// this host, in which case the software codec is used.
+using CodecFactory =
+    std::function<std::unique_ptr<folly::io::Codec>(CompressionKind kind)>;
+
+/// Registers 'factory' to create the codecs for 'kind'. Replaces a previously
+/// registered factory. A null 'factory' removes the registration. The codecs
+/// are used by compressionKindToCodec(), i.e. for spilling, exchange and
+/// Parquet, and by the DWRF/ORC readers for the compression kinds whose block
+/// format matches the folly codec.
+void registerCodecFactory(CompressionKind kind, CodecFactory factory);
+
+/// Returns a codec from the factory registered for 'kind'. Returns nullptr if
+/// there is no factory or the factory returns nullptr.
+std::unique_ptr<folly::io::Codec> createRegisteredCodec(CompressionKind kind);
+
 CompressionKind codecTypeToCompressionKind(folly::io::CodecType type);
 
 /**
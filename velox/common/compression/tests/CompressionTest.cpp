@@ -48,6 +48,36 @@ TEST_F(CompressionTest, compressionKindToCodec) {
       facebook::velox::VeloxException);
 }
 
+TEST_F(CompressionTest, registerCodecFactory) {
+  int32_t numCalls = 0;
+  registerCodecFactory(CompressionKind_LZO, [&](CompressionKind kind) {
+    EXPECT_EQ(kind, CompressionKind_LZO);
+    ++numCalls;
+    return folly::io::getCodec(folly::io::CodecType::LZ4);
+  });
+  // A factory that returns nullptr falls back to the software codec.
+  registerCodecFactory(CompressionKind_ZSTD, [&](CompressionKind /*kind*/) {
+    ++numCalls;
+    return nullptr;
+  });
+  ASSERT_EQ(
+      folly::io::CodecType::LZ4,
+      compressionKindToCodec(CompressionKind_LZO)->type());
+  ASSERT_EQ(
+      folly::io::CodecType::ZSTD,
+      compressionKindToCodec(CompressionKind_ZSTD)->type());
+  ASSERT_EQ(numCalls, 2);
+  ASSERT_EQ(createRegisteredCodec(CompressionKind_SNAPPY), nullptr);
+
+  registerCodecFactory(CompressionKind_LZO, nullptr);
+  registerCodecFactory(CompressionKind_ZSTD, nullptr);
+  ASSERT_EQ(createRegisteredCodec(CompressionKind_LZO), nullptr);
+  EXPECT_THROW(
+      compressionKindToCodec(CompressionKind_LZO),
+      facebook::velox::VeloxException);
+  ASSERT_EQ(numCalls, 2);
+}
+
 TEST_F(CompressionTest, stringToCompressionKind) {
   EXPECT_EQ(stringToCompressionKind("none"), CompressionKind_NONE);
   EXPECT_EQ(stringToCompressionKind("zlib"), CompressionKind_ZLIB);
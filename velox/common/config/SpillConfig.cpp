@@ -17,6 +17,26 @@
 #include "velox/common/base/Exceptions.h"
 
 namespace facebook::velox::common {
+SpillFileFormat stringToSpillFileFormat(const std::string& format) {
+  if (format == "presto") {
+    return SpillFileFormat::kPresto;
+  }
+  if (format == "columnar") {
+    return SpillFileFormat::kColumnar;
+  }
+  VELOX_USER_FAIL("Unsupported spill file format: {}", format);
+}
+
+std::string spillFileFormatToString(SpillFileFormat format) {
+  switch (format) {
+    case SpillFileFormat::kPresto:
+      return "presto";
+    case SpillFileFormat::kColumnar:
+      return "columnar";
+  }
+  VELOX_UNREACHABLE();
+}
+
 SpillConfig::SpillConfig(
     const std::string& _filePath,
     uint64_t _maxFileSize,
@@ -31,7 +51,9 @@ SpillConfig::SpillConfig(
     bool _aggregationSpillAll,
     int32_t _maxSpillLevel,
     int32_t _testSpillPct,
-    const std::string& _compressionKind)
+    const std::string& _compressionKind,
+    SpillOverflowTier _overflowTier,
+    SpillFileFormat _fileFormat)
     : filePath(_filePath),
       maxFileSize(
           _maxFileSize == 0 ? std::numeric_limits<int64_t>::max()
@@ -47,7 +69,9 @@ SpillConfig::SpillConfig(
       aggregationSpillAll(_aggregationSpillAll),
       maxSpillLevel(_maxSpillLevel),
       testSpillPct(_testSpillPct),
-      compressionKind(common::stringToCompressionKind(_compressionKind)) {
+      compressionKind(common::stringToCompressionKind(_compressionKind)),
+      overflowTier(std::move(_overflowTier)),
+      fileFormat(_fileFormat) {
   VELOX_USER_CHECK_GE(
       spillableReservationGrowthPct,
       minSpillableReservationPct,
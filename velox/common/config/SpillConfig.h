@@ -16,11 +16,47 @@
 #pragma once
 #include <stdint.h>
 #include <string.h>
+#include <atomic>
 
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include "velox/common/compression/Compression.h"
 
 namespace facebook::velox::common {
+/// Specifies a second tier of spill storage, e.g. on a remote file system, that
+/// takes new spill files once the first tier at 'SpillConfig::filePath' holds
+/// 'maxLocalBytes'.
+struct SpillOverflowTier {
+  /// File path prefix on the overflow tier. Empty if there is no overflow tier.
+  std::string filePath;
+
+  /// The bytes of spill files the first tier may hold. The limit is checked
+  /// when a new spill file is opened.
+  uint64_t maxLocalBytes{0};
+
+  /// Counts the bytes written to the first tier by all spillers that share
+  /// it. Not owned.
+  std::atomic<uint64_t>* localBytes{nullptr};
+
+  bool enabled() const {
+    return !filePath.empty() && maxLocalBytes > 0 && localBytes != nullptr;
+  }
+};
+
+/// Serialization format of spill files.
+enum class SpillFileFormat {
+  /// Presto wire format with lossless timestamps.
+  kPresto,
+  /// Columnar format with lightweight encodings per column. See
+  /// serializer::SpillVectorSerde.
+  kColumnar,
+};
+
+/// Returns the SpillFileFormat named 'format', i.e. "presto" or "columnar".
+/// Throws a user error for other names.
+SpillFileFormat stringToSpillFileFormat(const std::string& format);
+
+std::string spillFileFormatToString(SpillFileFormat format);
+
 /// Specifies the config for spilling.
 struct SpillConfig {
   SpillConfig(
@@ -37,7 +73,9 @@ struct SpillConfig {
       bool _aggregationSpillAll,
       int32_t _maxSpillLevel,
       int32_t _testSpillPct,
-      const std::string& _compressionKind);
+      const std::string& _compressionKind,
+      SpillOverflowTier _overflowTier = {},
+      SpillFileFormat _fileFormat = SpillFileFormat::kPresto);
 
   /// Returns the hash join spilling level with given 'startBitOffset'.
   ///
@@ -110,5 +148,11 @@ struct SpillConfig {
 
   /// CompressionKind when spilling, CompressionKind_NONE means no compression.
   common::CompressionKind compressionKind;
+
+  /// Where spill files go once the storage at 'filePath' is full.
+  SpillOverflowTier overflowTier;
+
+  /// Serialization format of the spill files.
+  SpillFileFormat fileFormat;
 };
 } // namespace facebook::velox::common
@@ -16,6 +16,7 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/base/Fs.h"
+#include "velox/common/file/IoUring.h"
 
 #include <fmt/format.h>
 #include <glog/logging.h>
@@ -24,6 +25,7 @@
 
 #include <fcntl.h>
 #include <folly/portability/SysUio.h>
+#include <sys/mman.h>
 
 namespace facebook::velox {
 
@@ -94,7 +96,8 @@ uint64_t InMemoryWriteFile::size() const {
   return file_->size();
 }
 
-LocalReadFile::LocalReadFile(std::string_view path) : path_(path) {
+LocalReadFile::LocalReadFile(std::string_view path, Mmap mmap)
+    : path_(path) {
   fd_ = open(path_.c_str(), O_RDONLY);
   VELOX_CHECK_GE(
       fd_,
@@ -112,11 +115,30 @@ LocalReadFile::LocalReadFile(std::string_view path) : path_(path) {
       path,
       folly::errnoStr(errno));
   size_ = rc;
+  if (mmap == Mmap::kNone || size_ == 0) {
+    return;
+  }
+  void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+  if (mapped == MAP_FAILED) {
+    // Reads go through pread().
+    LOG(WARNING) << "mmap failure in LocalReadFile constructor, " << path
+                 << " " << folly::errnoStr(errno);
+    return;
+  }
+  mapped_ = static_cast<char*>(mapped);
+  ::madvise(
+      mapped_,
+      size_,
+      mmap == Mmap::kSequential ? MADV_SEQUENTIAL : MADV_NORMAL);
 }
 
 LocalReadFile::LocalReadFile(int32_t fd) : fd_(fd) {}
 
 LocalReadFile::~LocalReadFile() {
+  if (mapped_ != nullptr && ::munmap(mapped_, size_) < 0) {
+    LOG(WARNING) << "munmap failure in LocalReadFile destructor: "
+                 << folly::errnoStr(errno);
+  }
   const int ret = close(fd_);
   if (ret < 0) {
     LOG(WARNING) << "close failure in LocalReadFile destructor: " << ret << ", "
@@ -145,6 +167,11 @@ LocalReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
 uint64_t LocalReadFile::preadv(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) const {
+  if (IoUring::enabled()) {
+    // Submits all the ranges at once instead of one preadv per IOV_MAX ranges.
+    return IoUring::forThread().run({{fd_, offset, buffers}})[0];
+  }
+
   // Dropped bytes sized so that a typical dropped range of 50K is not
   // too many iovecs.
   static thread_local std::vector<char> droppedBytes(16 * 1024);
@@ -202,6 +229,16 @@ uint64_t LocalReadFile::size() const {
   return size_;
 }
 
+std::string_view LocalReadFile::mappedRegion(
+    const common::Region& region) const {
+  if (mapped_ == nullptr || region.length < kMinMappedRegionBytes ||
+      region.offset + region.length > size_) {
+    return {};
+  }
+  bytesRead_ += region.length;
+  return {mapped_ + region.offset, region.length};
+}
+
 uint64_t LocalReadFile::memoryUsage() const {
   // TODO: does FILE really not use any more memory? From the stdio.h
   // source code it looks like it has only a single integer? Probably
@@ -130,6 +130,14 @@ class ReadFile {
   //
   virtual uint64_t getNaturalReadSize() const = 0;
 
+  // Returns a view of the bytes of 'region' that stays valid for the lifetime
+  // of *this, or an empty view if the file cannot hand out the region without
+  // copying it. Callers fall back to pread() in that case.
+  virtual std::string_view mappedRegion(
+      const common::Region& /*region*/) const {
+    return {};
+  }
+
  protected:
   mutable std::atomic<uint64_t> bytesRead_ = 0;
 };
@@ -225,7 +233,23 @@ class InMemoryWriteFile final : public WriteFile {
 
 class LocalReadFile final : public ReadFile {
  public:
-  explicit LocalReadFile(std::string_view path);
+  // Whether to memory map the file and the access pattern to advise the
+  // kernel of.
+  enum class Mmap {
+    // Reads with pread() only.
+    kNone,
+    // Maps the file with the default readahead of the kernel.
+    kNormal,
+    // Maps the file for reading front to back, e.g. a spill file. The kernel
+    // reads further ahead and can drop the pages behind the reads sooner.
+    kSequential,
+  };
+
+  // Regions smaller than this are not handed out from the mapping. Copying
+  // them with pread() is cheaper than faulting them in page by page.
+  static constexpr uint64_t kMinMappedRegionBytes = 64 << 10;
+
+  explicit LocalReadFile(std::string_view path, Mmap mmap = Mmap::kNone);
 
   explicit LocalReadFile(int32_t fd);
 
@@ -257,6 +281,10 @@ class LocalReadFile final : public ReadFile {
     return 10 << 20;
   }
 
+  // Returns a view into the mapping if the file is mapped and 'region' is at
+  // least kMinMappedRegionBytes.
+  std::string_view mappedRegion(const common::Region& region) const final;
+
  private:
   void preadInternal(uint64_t offset, uint64_t length, char* FOLLY_NONNULL pos)
       const;
@@ -264,6 +292,8 @@ class LocalReadFile final : public ReadFile {
   std::string path_;
   int32_t fd_;
   long size_;
+  // The mapping of the whole file, nullptr if not mapped.
+  char* mapped_{nullptr};
 };
 
 class LocalWriteFile final : public WriteFile {
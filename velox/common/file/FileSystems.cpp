@@ -19,9 +19,16 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/file/File.h"
 
+#include <gflags/gflags.h>
 #include <cstdio>
 #include <filesystem>
 
+DEFINE_bool(
+    velox_local_file_mmap,
+    false,
+    "Memory map local files opened for read, including spill files, unless "
+    "FileOptions::kLocalMmap says otherwise");
+
 namespace facebook::velox::filesystems {
 
 namespace {
@@ -77,6 +84,23 @@ class LocalFileSystem : public FileSystem {
     return "Local FS";
   }
 
+  static LocalReadFile::Mmap mmap(const FileOptions& options) {
+    auto it = options.values.find(FileOptions::kLocalMmap);
+    if (it == options.values.end()) {
+      return FLAGS_velox_local_file_mmap ? LocalReadFile::Mmap::kNormal
+                                         : LocalReadFile::Mmap::kNone;
+    }
+    if (it->second == "normal") {
+      return LocalReadFile::Mmap::kNormal;
+    }
+    if (it->second == "sequential") {
+      return LocalReadFile::Mmap::kSequential;
+    }
+    VELOX_CHECK_EQ(
+        it->second, "none", "Unknown value of {}", FileOptions::kLocalMmap);
+    return LocalReadFile::Mmap::kNone;
+  }
+
   inline std::string_view extractPath(std::string_view path) {
     if (path.find(kFileScheme) == 0) {
       return path.substr(kFileScheme.length());
@@ -86,8 +110,8 @@ class LocalFileSystem : public FileSystem {
 
   std::unique_ptr<ReadFile> openFileForRead(
       std::string_view path,
-      const FileOptions& /*unused*/) override {
-    return std::make_unique<LocalReadFile>(extractPath(path));
+      const FileOptions& options) override {
+    return std::make_unique<LocalReadFile>(extractPath(path), mmap(options));
   }
 
   std::unique_ptr<WriteFile> openFileForWrite(
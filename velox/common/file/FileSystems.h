@@ -35,6 +35,13 @@ namespace facebook::velox::filesystems {
 /// MemoryPool to allocate buffers needed to read/write files on FileSystems
 /// such as S3.
 struct FileOptions {
+  /// Key of 'values' that asks the local file system to memory map a file
+  /// opened for read. The value is "normal" or "sequential" for the access
+  /// pattern to advise the kernel of, or "none". Other file systems ignore
+  /// it. If not set, local files are mapped with "normal" advice if the
+  /// velox_local_file_mmap gflag is true.
+  static constexpr const char* kLocalMmap = "local.mmap";
+
   std::unordered_map<std::string, std::string> values;
   memory::MemoryPool* pool{nullptr};
 };
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUring.h"
+#include "velox/common/base/Exceptions.h"
+
+#include <folly/String.h>
+#include <folly/portability/SysUio.h>
+
+#ifdef VELOX_ENABLE_IO_URING
+#include <liburing.h>
+#endif
+
+DEFINE_bool(
+    velox_io_uring,
+    false,
+    "Use io_uring for batched local file IO if available");
+
+namespace facebook::velox {
+
+#ifdef VELOX_ENABLE_IO_URING
+namespace {
+io_uring* asRing(void* ring) {
+  return reinterpret_cast<io_uring*>(ring);
+}
+
+// One readv or writev of up to IOV_MAX ranges.
+struct Io {
+  int32_t fd;
+  uint64_t offset;
+  std::vector<iovec> iovecs;
+  bool isWrite;
+  // Index of the request in the argument of run().
+  int32_t request;
+};
+
+void addIo(
+    const IoUring::Request& request,
+    int32_t index,
+    std::vector<char>& droppedBytes,
+    std::vector<Io>& ios) {
+  uint64_t offset = request.offset;
+  ios.push_back({request.fd, offset, {}, request.isWrite, index});
+  const auto add = [&](char* data, size_t size) {
+    if (ios.back().iovecs.size() >= IOV_MAX) {
+      ios.push_back({request.fd, offset, {}, request.isWrite, index});
+    }
+    ios.back().iovecs.push_back({data, size});
+    offset += size;
+  };
+  for (const auto& range : request.buffers) {
+    if (range.data() != nullptr) {
+      add(range.data(), range.size());
+      continue;
+    }
+    VELOX_CHECK(!request.isWrite, "Writes can not skip ranges");
+    auto skipSize = range.size();
+    while (skipSize > 0) {
+      const auto bytes = std::min<size_t>(droppedBytes.size(), skipSize);
+      add(droppedBytes.data(), bytes);
+      skipSize -= bytes;
+    }
+  }
+}
+} // namespace
+#endif
+
+IoUring::IoUring(int32_t queueDepth)
+    : queueDepth_(queueDepth), droppedBytes_(16 * 1024) {
+#ifdef VELOX_ENABLE_IO_URING
+  auto ring = std::make_unique<io_uring>();
+  const auto rc = io_uring_queue_init(queueDepth_, ring.get(), 0);
+  VELOX_CHECK_EQ(rc, 0, "io_uring_queue_init failed: {}", folly::errnoStr(-rc));
+  ring_ = ring.release();
+#else
+  VELOX_UNSUPPORTED("Velox is built without io_uring");
+#endif
+}
+
+IoUring::~IoUring() {
+#ifdef VELOX_ENABLE_IO_URING
+  if (ring_ != nullptr) {
+    io_uring_queue_exit(asRing(ring_));
+    delete asRing(ring_);
+  }
+#endif
+}
+
+// static
+bool IoUring::isAvailable() {
+#ifdef VELOX_ENABLE_IO_URING
+  static const bool kAvailable = []() {
+    io_uring ring;
+    if (io_uring_queue_init(1, &ring, 0) != 0) {
+      return false;
+    }
+    io_uring_queue_exit(&ring);
+    return true;
+  }();
+  return kAvailable;
+#else
+  return false;
+#endif
+}
+
+// static
+IoUring& IoUring::forThread() {
+  static thread_local IoUring ioUring;
+  return ioUring;
+}
+
+std::vector<uint64_t> IoUring::run(const std::vector<Request>& requests) {
+  std::vector<uint64_t> results(requests.size(), 0);
+#ifdef VELOX_ENABLE_IO_URING
+  std::vector<Io> ios;
+  for (auto i = 0; i < requests.size(); ++i) {
+    addIo(requests[i], i, droppedBytes_, ios);
+  }
+
+  auto* ring = asRing(ring_);
+  std::optional<std::string> error;
+  for (auto begin = 0; begin < ios.size(); begin += queueDepth_) {
+    const auto end = std::min<int32_t>(begin + queueDepth_, ios.size());
+    for (auto i = begin; i < end; ++i) {
+      auto& io = ios[i];
+      auto* sqe = io_uring_get_sqe(ring);
+      VELOX_CHECK_NOT_NULL(sqe);
+      if (io.isWrite) {
+        io_uring_prep_writev(
+            sqe, io.fd, io.iovecs.data(), io.iovecs.size(), io.offset);
+      } else {
+        io_uring_prep_readv(
+            sqe, io.fd, io.iovecs.data(), io.iovecs.size(), io.offset);
+      }
+      io_uring_sqe_set_data(sqe, &io);
+    }
+    const auto rc = io_uring_submit_and_wait(ring, end - begin);
+    VELOX_CHECK_EQ(
+        rc, end - begin, "io_uring_submit failed: {}", folly::errnoStr(-rc));
+
+    // All the completions are reaped before reporting an error so that the
+    // ring can be reused.
+    for (auto i = begin; i < end; ++i) {
+      io_uring_cqe* cqe;
+      const auto waitRc = io_uring_wait_cqe(ring, &cqe);
+      VELOX_CHECK_EQ(
+          waitRc, 0, "io_uring_wait_cqe failed: {}", folly::errnoStr(-waitRc));
+      const auto* io = reinterpret_cast<const Io*>(io_uring_cqe_get_data(cqe));
+      if (cqe->res < 0) {
+        if (!error.has_value()) {
+          error = fmt::format(
+              "io_uring {} of fd {} at {} failed: {}",
+              io->isWrite ? "write" : "read",
+              io->fd,
+              io->offset,
+              folly::errnoStr(-cqe->res));
+        }
+      } else {
+        results[io->request] += cqe->res;
+      }
+      io_uring_cqe_seen(ring, cqe);
+    }
+  }
+  if (error.has_value()) {
+    VELOX_FAIL("{}", error.value());
+  }
+#else
+  VELOX_UNSUPPORTED("Velox is built without io_uring");
+#endif
+  return results;
+}
+
+} // namespace facebook::velox
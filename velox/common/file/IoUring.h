@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Range.h>
+#include <gflags/gflags.h>
+
+#include <vector>
+
+DECLARE_bool(velox_io_uring);
+
+namespace facebook::velox {
+
+/// Positional reads and writes of local files through io_uring. All the
+/// requests passed to run() are submitted with one system call per queue depth
+/// worth of requests instead of one pread or pwrite system call per request.
+///
+/// Available only if Velox is built with VELOX_ENABLE_IO_URING and the kernel
+/// supports io_uring. An instance is not thread safe, use forThread() to get
+/// the instance of the calling thread.
+class IoUring {
+ public:
+  struct Request {
+    int32_t fd;
+    uint64_t offset;
+    /// The ranges to read into or write from, consecutive in the file. For
+    /// reads, a range with nullptr data skips its size worth of bytes.
+    std::vector<folly::Range<char*>> buffers;
+    bool isWrite{false};
+  };
+
+  explicit IoUring(int32_t queueDepth = kDefaultQueueDepth);
+
+  ~IoUring();
+
+  /// Returns true if io_uring is compiled in and supported by the kernel.
+  static bool isAvailable();
+
+  /// Returns true if FLAGS_velox_io_uring is set and io_uring is available.
+  static bool enabled() {
+    return FLAGS_velox_io_uring && isAvailable();
+  }
+
+  /// Returns the instance of the calling thread.
+  static IoUring& forThread();
+
+  /// Performs 'requests' and returns once all of them are complete. Returns
+  /// the number of bytes transferred for each request. Throws if a request
+  /// fails.
+  std::vector<uint64_t> run(const std::vector<Request>& requests);
+
+ private:
+  static constexpr int32_t kDefaultQueueDepth = 64;
+
+  const int32_t queueDepth_;
+
+  // The io_uring of liburing. nullptr if built without io_uring.
+  void* ring_{nullptr};
+
+  // Destination of the skipped ranges of reads.
+  std::vector<char> droppedBytes_;
+};
+
+} // namespace facebook::velox
@@ -18,6 +18,7 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUring.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
 
@@ -126,6 +127,40 @@ TEST(LocalFile, writeAndRead) {
   readData(&readFile);
 }
 
+TEST(LocalFile, mmap) {
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path.c_str();
+  remove(filename);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  {
+    LocalReadFile readFile(filename);
+    ASSERT_TRUE(readFile.mappedRegion({0, kOneMB}).empty());
+  }
+  for (auto mmap :
+       {LocalReadFile::Mmap::kNormal, LocalReadFile::Mmap::kSequential}) {
+    LocalReadFile readFile(filename, mmap);
+    readData(&readFile);
+    ASSERT_EQ(
+        readFile.mappedRegion({5, kOneMB}),
+        "bbbbb" + std::string(kOneMB - 5, 'c'));
+    // Small regions and regions past the end are not handed out.
+    ASSERT_TRUE(readFile.mappedRegion({0, 10}).empty());
+    ASSERT_TRUE(readFile.mappedRegion({kOneMB, kOneMB}).empty());
+  }
+
+  filesystems::registerLocalFileSystem();
+  auto lfs = filesystems::getFileSystem(filename, nullptr);
+  filesystems::FileOptions options;
+  options.values[filesystems::FileOptions::kLocalMmap] = "sequential";
+  auto readFile = lfs->openFileForRead(filename, options);
+  ASSERT_EQ(readFile->mappedRegion({10, kOneMB}), std::string(kOneMB, 'c'));
+  options.values[filesystems::FileOptions::kLocalMmap] = "bad";
+  ASSERT_ANY_THROW(lfs->openFileForRead(filename, options));
+}
+
 TEST(LocalFile, viaRegistry) {
   filesystems::registerLocalFileSystem();
   auto tempFile = ::exec::test::TempFilePath::create();
@@ -244,6 +279,51 @@ TEST(LocalFile, readFileDestructor) {
   }
 }
 
+TEST(LocalFile, ioUring) {
+  if (!IoUring::isAvailable()) {
+    GTEST_SKIP() << "io_uring is not available";
+  }
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path.c_str();
+  remove(filename);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  FLAGS_velox_io_uring = true;
+  {
+    LocalReadFile readFile(filename);
+    readData(&readFile);
+  }
+
+  // Writes and reads back several ranges in one submission.
+  auto fd = open(filename, O_RDWR);
+  ASSERT_GE(fd, 0);
+  std::string first(100, 'x');
+  std::string second(1'000, 'y');
+  IoUring ioUring(2);
+  auto written = ioUring.run({
+      {fd, 0, {folly::Range<char*>(first.data(), first.size())}, true},
+      {fd, 200, {folly::Range<char*>(second.data(), second.size())}, true},
+      {fd, 1'200, {folly::Range<char*>(first.data(), first.size())}, true},
+  });
+  ASSERT_EQ(written, std::vector<uint64_t>({100, 1'000, 100}));
+  std::string head(10, 0);
+  std::string tail(first.size(), 0);
+  auto read = ioUring.run({
+      {fd,
+       95,
+       {folly::Range<char*>(head.data(), head.size()),
+        folly::Range<char*>(nullptr, (char*)(uint64_t)1'000)}},
+      {fd, 1'200, {folly::Range<char*>(tail.data(), tail.size())}},
+  });
+  ASSERT_EQ(read, std::vector<uint64_t>({1'010, 100}));
+  ASSERT_EQ(head, "xxxxxccccc");
+  ASSERT_EQ(tail, first);
+  close(fd);
+  FLAGS_velox_io_uring = false;
+}
+
 TEST(LocalFile, mkdir) {
   filesystems::registerLocalFileSystem();
   auto tempFolder = ::exec::test::TempDirectoryPath::create();
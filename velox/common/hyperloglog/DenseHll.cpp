@@ -18,6 +18,7 @@
 #include <exception>
 #include <sstream>
 #include "velox/common/base/IOUtils.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/common/hyperloglog/BiasCorrection.h"
 #include "velox/common/hyperloglog/HllUtils.h"
 
@@ -567,11 +568,94 @@ void DenseHll::mergeWith(
     int16_t otherOverflows,
     const uint16_t* otherOverflowBuckets,
     const int8_t* otherOverflowValues) {
+  using Batch = xsimd::batch<uint8_t>;
   int8_t newBaseline = std::max(baseline_, otherBaseline);
   int32_t baselineCount = 0;
 
-  int bucket = 0;
-  for (int i = 0; i < deltas_.size(); i++) {
+  // Merges Batch::size slots, i.e. 2 * Batch::size buckets, at a time. If no
+  // bucket in the batch is kMaxDelta in either HLL, there are no overflows
+  // and the new delta of each bucket is the larger of the deltas rebased to
+  // 'newBaseline'. Rebasing subtracts the difference of the baselines, which
+  // is zero for one of the HLLs. The subtraction saturates at 0 since the
+  // other HLL then has the larger value. The high and low buckets of a slot
+  // are processed separately, the high bucket in place in the high 4 bits.
+  const auto lowMask = Batch::broadcast(kBucketMask);
+  const auto highMask = Batch::broadcast(kBucketMask << kBitsPerBucket);
+  // Deltas in a batch are less than kMaxDelta, so rebasing by more than
+  // kMaxDelta gives 0 as well.
+  const uint8_t shift1 = std::min<int>(newBaseline - baseline_, kMaxDelta);
+  const uint8_t shift2 = std::min<int>(newBaseline - otherBaseline, kMaxDelta);
+  const auto lowShift1 = Batch::broadcast(shift1);
+  const auto lowShift2 = Batch::broadcast(shift2);
+  const auto highShift1 = Batch::broadcast(shift1 << kBitsPerBucket);
+  const auto highShift2 = Batch::broadcast(shift2 << kBitsPerBucket);
+  auto* deltas = reinterpret_cast<uint8_t*>(deltas_.data());
+  auto* otherSlots = reinterpret_cast<const uint8_t*>(otherDeltas);
+  const int32_t numSlots = deltas_.size();
+  int32_t i = 0;
+  for (; i + Batch::size <= numSlots; i += Batch::size) {
+    auto slots1 = Batch::load_unaligned(deltas + i);
+    auto slots2 = Batch::load_unaligned(otherSlots + i);
+    auto high1 = slots1 & highMask;
+    auto low1 = slots1 & lowMask;
+    auto high2 = slots2 & highMask;
+    auto low2 = slots2 & lowMask;
+    if (xsimd::any(
+            (high1 == highMask) | (low1 == lowMask) | (high2 == highMask) |
+            (low2 == lowMask))) {
+      baselineCount += mergeSlots(
+          i,
+          i + Batch::size,
+          newBaseline,
+          otherBaseline,
+          otherDeltas,
+          otherOverflows,
+          otherOverflowBuckets,
+          otherOverflowValues);
+      continue;
+    }
+    auto high = xsimd::max(
+        xsimd::max(high1, highShift1) - highShift1,
+        xsimd::max(high2, highShift2) - highShift2);
+    auto low = xsimd::max(
+        xsimd::max(low1, lowShift1) - lowShift1,
+        xsimd::max(low2, lowShift2) - lowShift2);
+    const auto zero = Batch::broadcast(0);
+    baselineCount += __builtin_popcountll(simd::toBitMask(high == zero)) +
+        __builtin_popcountll(simd::toBitMask(low == zero));
+    (high | low).store_unaligned(deltas + i);
+  }
+  baselineCount += mergeSlots(
+      i,
+      numSlots,
+      newBaseline,
+      otherBaseline,
+      otherDeltas,
+      otherOverflows,
+      otherOverflowBuckets,
+      otherOverflowValues);
+
+  baseline_ = newBaseline;
+  baselineCount_ = baselineCount;
+
+  // All baseline values in one of the HLLs lost to the values
+  // in the other HLL, so we need to adjust the final baseline.
+  adjustBaselineIfNeeded();
+}
+
+int32_t DenseHll::mergeSlots(
+    int32_t begin,
+    int32_t end,
+    int8_t newBaseline,
+    int8_t otherBaseline,
+    const int8_t* otherDeltas,
+    int16_t otherOverflows,
+    const uint16_t* otherOverflowBuckets,
+    const int8_t* otherOverflowValues) {
+  int32_t baselineCount = 0;
+
+  int bucket = begin * 2;
+  for (int i = begin; i < end; i++) {
     int newSlot = 0;
 
     int8_t slot1 = deltas_[i];
@@ -613,13 +697,7 @@ void DenseHll::mergeWith(
 
     deltas_[i] = newSlot;
   }
-
-  baseline_ = newBaseline;
-  baselineCount_ = baselineCount;
-
-  // All baseline values in one of the HLLs lost to the values
-  // in the other HLL, so we need to adjust the final baseline.
-  adjustBaselineIfNeeded();
+  return baselineCount;
 }
 
 int8_t
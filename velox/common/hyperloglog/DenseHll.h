@@ -116,6 +116,19 @@ class DenseHll {
       const uint16_t* otherOverflowBuckets,
       const int8_t* otherOverflowValues);
 
+  /// Merges slots [begin, end) of 'deltas_' with the same slots of the other
+  /// HLL, one bucket at a time, including the overflows. Returns the number
+  /// of merged buckets equal to 'newBaseline'.
+  int32_t mergeSlots(
+      int32_t begin,
+      int32_t end,
+      int8_t newBaseline,
+      int8_t otherBaseline,
+      const int8_t* otherDeltas,
+      int16_t otherOverflows,
+      const uint16_t* otherOverflowBuckets,
+      const int8_t* otherOverflowValues);
+
   /// Number of first bits of the hash to calculate buckets from.
   int8_t indexBitLength_;
 
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/IoLatencyModel.h"
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
+namespace facebook::velox::io {
+
+// static
+IoLatencyModel& IoLatencyModel::forPath(std::string_view path) {
+  static std::mutex mutex;
+  // Never destroyed since reads may be recorded during static destruction.
+  static auto* models =
+      new std::unordered_map<std::string, std::unique_ptr<IoLatencyModel>>();
+  const auto pos = path.find("://");
+  const std::string scheme(
+      pos == std::string_view::npos ? "file" : path.substr(0, pos));
+  std::lock_guard<std::mutex> l(mutex);
+  auto& model = (*models)[scheme];
+  if (model == nullptr) {
+    model = std::make_unique<IoLatencyModel>();
+  }
+  return *model;
+}
+
+void IoLatencyModel::record(uint64_t bytes, uint64_t micros) {
+  if (bytes == 0) {
+    return;
+  }
+  const double x = bytes;
+  const double y = micros;
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numSamples_;
+  sumWeight_ = sumWeight_ * kDecay + 1;
+  sumBytes_ = sumBytes_ * kDecay + x;
+  sumMicros_ = sumMicros_ * kDecay + y;
+  sumBytesSquared_ = sumBytesSquared_ * kDecay + x * x;
+  sumBytesMicros_ = sumBytesMicros_ * kDecay + x * y;
+}
+
+IoLatencyModel::Estimate IoLatencyModel::estimate() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (numSamples_ < 2) {
+    return {};
+  }
+  const double meanBytes = sumBytes_ / sumWeight_;
+  const double meanMicros = sumMicros_ / sumWeight_;
+  const double bytesVariance =
+      sumBytesSquared_ / sumWeight_ - meanBytes * meanBytes;
+  // Reads of about the same size do not separate the latency from the
+  // transfer time.
+  if (bytesVariance <= 0.01 * meanBytes * meanBytes) {
+    return {};
+  }
+  const double covariance =
+      sumBytesMicros_ / sumWeight_ - meanBytes * meanMicros;
+  const double microsPerByte = covariance / bytesVariance;
+  if (microsPerByte <= 0) {
+    return {};
+  }
+  // A negative intercept is noise around a negligible latency.
+  const double latency =
+      std::max<double>(0, meanMicros - microsPerByte * meanBytes);
+  return {numSamples_, latency, 1 / microsPerByte};
+}
+
+double IoLatencyModel::bandwidthDelayProduct() const {
+  const auto fit = estimate();
+  if (fit.numSamples < kMinSamples) {
+    return 0;
+  }
+  return fit.latencyUs * fit.bytesPerUs;
+}
+
+int32_t IoLatencyModel::coalesceDistance(int32_t defaultDistance) const {
+  const auto bytes = bandwidthDelayProduct();
+  if (bytes == 0) {
+    return defaultDistance;
+  }
+  return std::clamp<double>(bytes, kMinCoalesceDistance, kMaxCoalesceDistance);
+}
+
+int64_t IoLatencyModel::maxCoalesceBytes(int64_t maxBytes, bool parallel)
+    const {
+  const auto bytes = bandwidthDelayProduct();
+  if (bytes == 0) {
+    return maxBytes;
+  }
+  const auto factor =
+      parallel ? kParallelCoalesceBytesFactor : kCoalesceBytesFactor;
+  return std::clamp<double>(
+      bytes * factor, std::min(kMinCoalesceBytes, maxBytes), maxBytes);
+}
+
+void IoLatencyModel::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  numSamples_ = 0;
+  sumWeight_ = 0;
+  sumBytes_ = 0;
+  sumMicros_ = 0;
+  sumBytesSquared_ = 0;
+  sumBytesMicros_ = 0;
+}
+
+} // namespace facebook::velox::io
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace facebook::velox::io {
+
+/// Model of the time of a read from a storage system as a fixed per request
+/// latency plus the size of the read divided by the throughput. The model is
+/// fitted with exponentially decayed least squares over the observed reads so
+/// that it follows changes in the load of the storage.
+///
+/// The model gives the coalescing parameters that balance the cost of reading
+/// unneeded bytes against the cost of issuing more requests: a gap between two
+/// ranges is worth reading if transferring it takes less time than the latency
+/// of a separate request, i.e. if it is shorter than latency * throughput.
+class IoLatencyModel {
+ public:
+  /// Number of reads after which the model replaces the static options.
+  static constexpr int32_t kMinSamples = 10;
+
+  /// Weight of the past samples after each new sample.
+  static constexpr double kDecay = 0.98;
+
+  /// A coalesced read is this many times the bytes that can be transferred in
+  /// the time of the latency, so that the latency is amortized to a few
+  /// percent of the transfer time.
+  static constexpr int32_t kCoalesceBytesFactor = 16;
+
+  /// Same as kCoalesceBytesFactor when the coalesced reads are issued in
+  /// parallel. The reads are smaller so that more of them are in flight.
+  static constexpr int32_t kParallelCoalesceBytesFactor = 4;
+
+  static constexpr int32_t kMinCoalesceDistance = 4 << 10; // 4K
+  static constexpr int32_t kMaxCoalesceDistance = 16 << 20; // 16MB
+  static constexpr int64_t kMinCoalesceBytes = 1 << 20; // 1MB
+
+  struct Estimate {
+    int64_t numSamples{0};
+    /// Fixed cost of a request.
+    double latencyUs{0};
+    /// Transfer rate after the first byte.
+    double bytesPerUs{0};
+  };
+
+  /// Returns the model of the storage system of 'path', identified by the
+  /// scheme of 'path', e.g. 's3' for 's3://bucket/key'. Paths without a scheme
+  /// are local files.
+  static IoLatencyModel& forPath(std::string_view path);
+
+  /// Records a read of 'bytes' that took 'micros'.
+  void record(uint64_t bytes, uint64_t micros);
+
+  /// Returns the current fit. 'numSamples' is 0 if there are not enough
+  /// samples of sufficiently different sizes for a fit.
+  Estimate estimate() const;
+
+  /// Returns the largest gap to read through when coalescing reads, or
+  /// 'defaultDistance' if the model has fewer than kMinSamples samples.
+  int32_t coalesceDistance(int32_t defaultDistance) const;
+
+  /// Returns the maximum size of a coalesced read, at most 'maxBytes'. If
+  /// 'parallel' is true, the coalesced reads are issued concurrently and are
+  /// made smaller. Returns 'maxBytes' if the model has fewer than kMinSamples
+  /// samples.
+  int64_t maxCoalesceBytes(int64_t maxBytes, bool parallel) const;
+
+  void clear();
+
+ private:
+  // The number of bytes the storage transfers during the latency of one
+  // request or 0 if there is no usable fit.
+  double bandwidthDelayProduct() const;
+
+  mutable std::mutex mutex_;
+  int64_t numSamples_{0};
+  // Decayed sums for the least squares fit of time over bytes.
+  double sumWeight_{0};
+  double sumBytes_{0};
+  double sumMicros_{0};
+  double sumBytesSquared_{0};
+  double sumBytesMicros_{0};
+};
+
+} // namespace facebook::velox::io
@@ -65,6 +65,7 @@ class ReaderOptions {
   int32_t maxCoalesceDistance_{kDefaultCoalesceDistance};
   int64_t maxCoalesceBytes_{kDefaultCoalesceBytes};
   int32_t prefetchRowGroups_{kDefaultPrefetchRowGroups};
+  bool adaptiveCoalesce_{false};
 
  public:
   static constexpr int32_t kDefaultLoadQuantum = 8 << 20; // 8MB
@@ -84,6 +85,7 @@ class ReaderOptions {
     maxCoalesceDistance_ = other.maxCoalesceDistance_;
     maxCoalesceBytes_ = other.maxCoalesceBytes_;
     prefetchRowGroups_ = other.prefetchRowGroups_;
+    adaptiveCoalesce_ = other.adaptiveCoalesce_;
     return *this;
   }
 
@@ -137,6 +139,16 @@ class ReaderOptions {
     return *this;
   }
 
+  /**
+   * Derive the coalesce distance and bytes from the measured latency and
+   * throughput of the storage instead of using the configured maximums. See
+   * IoLatencyModel.
+   */
+  ReaderOptions& setAdaptiveCoalesce(bool adaptive) {
+    adaptiveCoalesce_ = adaptive;
+    return *this;
+  }
+
   /**
    * Modify the number of row groups to prefetch.
    */
@@ -175,5 +187,9 @@ class ReaderOptions {
   int64_t prefetchRowGroups() const {
     return prefetchRowGroups_;
   }
+
+  bool adaptiveCoalesce() const {
+    return adaptiveCoalesce_;
+  }
 };
 } // namespace facebook::velox::io
@@ -115,6 +115,7 @@ class ByteStream {
     ranges_ = std::move(ranges);
     current_ = &ranges_[0];
     lastRangeEnd_ = ranges_.back().size;
+    inputOwner_.reset();
   }
 
   void setRange(ByteRange range) {
@@ -128,6 +129,20 @@ class ByteStream {
     return ranges_;
   }
 
+  /// Sets an object that keeps the memory of the input ranges alive. Must be
+  /// called after resetInput(), which clears the owner. If set,
+  /// readers may make vectors that reference the input bytes directly instead
+  /// of copying them, as long as they hold on to 'owner'.
+  void setInputOwner(std::shared_ptr<void> owner) {
+    inputOwner_ = std::move(owner);
+  }
+
+  /// Returns the owner of the input ranges or nullptr if the input memory may
+  /// go away after reading.
+  const std::shared_ptr<void>& inputOwner() const {
+    return inputOwner_;
+  }
+
   void startWrite(int32_t initialSize) {
     extend(initialSize);
   }
@@ -268,6 +283,10 @@ class ByteStream {
   // Pointer to the current element of 'ranges_'.
   ByteRange* current_{nullptr};
 
+  // Keeps the memory of input 'ranges_' alive for readers that reference it
+  // without copying. See setInputOwner().
+  std::shared_ptr<void> inputOwner_;
+
   // Number of bits/bytes that have been written in the last element
   // of 'ranges_'. In a write situation, all non-last ranges are full
   // and the last may be partly full. The position in the last range
@@ -91,6 +91,8 @@ void HashStringAllocator::clear() {
   numFree_ = 0;
   freeBytes_ = 0;
   freeNonEmpty_ = 0;
+  std::fill(std::begin(cached_), std::end(cached_), nullptr);
+  cachedBytes_ = 0;
   for (auto& pair : allocationsFromPool_) {
     pool()->free(pair.first, pair.second);
   }
@@ -167,7 +169,7 @@ void HashStringAllocator::extendWrite(Position position, ByteStream& stream) {
       "Starting extendWrite outside of the current range");
 
   if (header->isContinued()) {
-    free(header->nextContinued());
+    freeToFreeLists(header->nextContinued());
     header->clearContinued();
   }
 
@@ -195,7 +197,7 @@ HashStringAllocator::finishWrite(ByteStream& stream, int32_t numReserveBytes) {
 
   Position currentPosition = Position::atOffset(currentHeader_, offset);
   if (currentHeader_->isContinued()) {
-    free(currentHeader_->nextContinued());
+    freeToFreeLists(currentHeader_->nextContinued());
     currentHeader_->clearContinued();
   }
   // Free remainder of block if there is a lot left over.
@@ -242,7 +244,7 @@ void HashStringAllocator::newSlab() {
   // Add the new memory to the free list: Placement construct a header
   // that covers the space from start to the end marker and add this
   // to free list.
-  free(new (run) Header(available - sizeof(Header)));
+  freeToFreeLists(new (run) Header(available - sizeof(Header)));
 }
 
 void HashStringAllocator::newRange(
@@ -305,7 +307,7 @@ void HashStringAllocator::freeRestOfBlock(Header* header, int32_t keepBytes) {
 
   header->setSize(keepBytes);
   auto newHeader = new (header->end()) Header(freeSize);
-  free(newHeader);
+  freeToFreeLists(newHeader);
 }
 
 // Free list sizes align with size of containers. + 20 allows for padding for an
@@ -374,6 +376,18 @@ HashStringAllocator::allocate(int32_t size, bool exactSize) {
   return header;
 }
 
+HashStringAllocator::Header* HashStringAllocator::allocateCached(int32_t size) {
+  const auto index =
+      bits::roundUp(size, kCacheGranularity) / kCacheGranularity;
+  if (auto header = cached_[index]) {
+    cached_[index] = *reinterpret_cast<Header**>(header->begin());
+    cachedBytes_ -= header->size() + sizeof(Header);
+    cumulativeBytes_ += header->size();
+    return header;
+  }
+  return allocate(index * kCacheGranularity, true);
+}
+
 HashStringAllocator::Header* FOLLY_NULLABLE
 HashStringAllocator::allocateFromFreeLists(
     int32_t preferredSize,
@@ -462,7 +476,22 @@ HashStringAllocator::allocateFromFreeList(
   return found;
 }
 
-void HashStringAllocator::free(Header* _header) {
+void HashStringAllocator::free(Header* header) {
+  if (cacheSmallBlocks_ && header->size() <= kMaxCachedBlockSize &&
+      !header->isContinued() && cachedBytes_ < kMaxCachedBytes) {
+    VELOX_CHECK(!header->isFree());
+    const auto index =
+        std::min(header->size(), kMaxCachedSize) / kCacheGranularity;
+    *reinterpret_cast<Header**>(header->begin()) = cached_[index];
+    cached_[index] = header;
+    cachedBytes_ += header->size() + sizeof(Header);
+    cumulativeBytes_ -= header->size();
+    return;
+  }
+  freeToFreeLists(header);
+}
+
+void HashStringAllocator::freeToFreeLists(Header* _header) {
   Header* header = _header;
   if (header->size() > kMaxAlloc && !pool_.isInCurrentRange(header) &&
       allocationsFromPool_.find(header) != allocationsFromPool_.end()) {
@@ -597,6 +626,9 @@ std::string HashStringAllocator::toString() const {
   out << "allocated: " << cumulativeBytes_ << " bytes" << std::endl;
   out << "free: " << freeBytes_ << " bytes in " << numFree_ << " blocks"
       << std::endl;
+  if (cachedBytes_ > 0) {
+    out << "cached: " << cachedBytes_ << " bytes" << std::endl;
+  }
   out << "standalone allocations: " << sizeFromPool_ << " bytes in "
       << allocationsFromPool_.size() << " allocations" << std::endl;
   out << "ranges: " << pool_.numRanges() << std::endl;
@@ -708,6 +740,21 @@ int64_t HashStringAllocator::checkConsistency() const {
 
   VELOX_CHECK_EQ(numInFreeList, numFree_);
   VELOX_CHECK_EQ(bytesInFreeList, freeBytes_);
+
+  // Blocks in the caches are not marked free and were counted as allocated
+  // above.
+  int64_t cachedBytes = 0;
+  for (auto i = 0; i < kNumCaches; ++i) {
+    for (auto header = cached_[i]; header != nullptr;
+         header = *reinterpret_cast<Header**>(header->begin())) {
+      VELOX_CHECK(!header->isFree());
+      VELOX_CHECK(!header->isContinued());
+      VELOX_CHECK_GE(header->size(), i * kCacheGranularity);
+      cachedBytes += header->size() + sizeof(Header);
+      allocatedBytes -= header->size();
+    }
+  }
+  VELOX_CHECK_EQ(cachedBytes, cachedBytes_);
   return allocatedBytes;
 }
 
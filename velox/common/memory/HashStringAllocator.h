@@ -38,7 +38,10 @@ namespace facebook::velox {
 // free block contain its length. kPreviousFree means that the block immediately
 // below is free. In this case the uint32_t below the header has the size of the
 // previous free block. The last word of a Allocation::PageRun backing a
-// HashStringAllocator is set to kArenaEnd.
+// HashStringAllocator is set to kArenaEnd. If 'cacheSmallBlocks' is set at
+// construction, freed blocks of up to kMaxCachedSize bytes are kept in
+// segregated per size free lists and reused in O(1) by allocate() without
+// coalescing or splitting.
 class HashStringAllocator : public StreamArena {
  public:
   // The minimum allocation must have space after the header for the
@@ -174,8 +177,14 @@ class HashStringAllocator : public StreamArena {
     }
   };
 
-  explicit HashStringAllocator(memory::MemoryPool* FOLLY_NONNULL pool)
-      : StreamArena(pool), pool_(pool) {}
+  // Largest size of a block kept in the per size caches if
+  // 'cacheSmallBlocks' is set.
+  static constexpr int32_t kMaxCachedSize = 128;
+
+  explicit HashStringAllocator(
+      memory::MemoryPool* FOLLY_NONNULL pool,
+      bool cacheSmallBlocks = false)
+      : StreamArena(pool), cacheSmallBlocks_(cacheSmallBlocks), pool_(pool) {}
 
   ~HashStringAllocator();
 
@@ -228,7 +237,11 @@ class HashStringAllocator : public StreamArena {
   Header* FOLLY_NONNULL allocate(int32_t size) {
     VELOX_CHECK(
         !currentHeader_, "Do not call allocate() when a write is in progress");
-    return allocate(std::max(size, kMinAlloc), true);
+    size = std::max(size, kMinAlloc);
+    if (cacheSmallBlocks_ && size <= kMaxCachedSize) {
+      return allocateCached(size);
+    }
+    return allocate(size, true);
   }
 
   /// Allocates a block that is independently freeable but is freed on
@@ -361,6 +374,12 @@ class HashStringAllocator : public StreamArena {
     return numFreeListNoFit_;
   }
 
+  // Returns the number of bytes, including headers, in freed blocks kept in
+  // the per size caches.
+  int64_t cachedBytes() const {
+    return cachedBytes_;
+  }
+
   std::string toString() const;
 
  private:
@@ -368,6 +387,18 @@ class HashStringAllocator : public StreamArena {
   static constexpr int32_t kMinContiguous = 48;
   static constexpr int32_t kNumFreeLists = 10;
 
+  // Block sizes in the caches are grouped in steps of kCacheGranularity.
+  static constexpr int32_t kCacheGranularity = 8;
+  static constexpr int32_t kNumCaches = kMaxCachedSize / kCacheGranularity + 1;
+
+  // A block allocated for kMaxCachedSize can be this large if the rest of the
+  // free block it came from was too small to split off.
+  static constexpr int32_t kMaxCachedBlockSize =
+      kMaxCachedSize + kMinAlloc + sizeof(uint32_t);
+
+  // Cap on 'cachedBytes_'. Frees beyond this go to the free lists.
+  static constexpr int64_t kMaxCachedBytes = 1 << 20;
+
   // different sizes have different free lists. Sizes below first size
   // go to freeLists_[0]. Sizes >= freeListSize_[i] go to freeLists_[i
   // + 1]. The sizes match the size progression for growing F14
@@ -385,6 +416,14 @@ class HashStringAllocator : public StreamArena {
   // anything yet. Throws if fails to grow.
   void newSlab();
 
+  // Returns a block of at least 'size' bytes from the caches or allocates a
+  // block of the cache's size.
+  Header* FOLLY_NONNULL allocateCached(int32_t size);
+
+  // Adds the allocation of 'header' and any extensions to the free lists,
+  // coalescing with adjacent free blocks.
+  void freeToFreeLists(Header* FOLLY_NONNULL header);
+
   void removeFromFreeList(Header* FOLLY_NONNULL header) {
     VELOX_CHECK(header->isFree());
     header->clearFree();
@@ -427,6 +466,16 @@ class HashStringAllocator : public StreamArena {
   // kNumFreeLists.
   int32_t freeListIndex(int32_t size, uint32_t mask = ~0);
 
+  const bool cacheSmallBlocks_;
+
+  // Singly linked lists of freed blocks kept for reuse by allocateCached().
+  // cached_[i] has blocks of kCacheGranularity * i bytes or more. The blocks
+  // are not marked free and the link is in their first word.
+  Header* FOLLY_NULLABLE cached_[kNumCaches] = {};
+
+  // Sum of the size of blocks in 'cached_', including headers.
+  int64_t cachedBytes_{0};
+
   // Circular list of free blocks.
   CompactDoubleList free_[kNumFreeLists];
 
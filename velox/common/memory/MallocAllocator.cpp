@@ -196,14 +196,8 @@ bool MallocAllocator::allocateContiguousImpl(
   }
   numAllocated_.fetch_add(numPages);
   numMapped_.fetch_add(numPages);
-  void* data = ::mmap(
-      nullptr,
-      AllocationTraits::pageBytes(maxPages),
-      PROT_READ | PROT_WRITE,
-      MAP_PRIVATE | MAP_ANONYMOUS,
-      -1,
-      0);
-  // TODO: add handling of MAP_FAILED.
+  void* data = mapContiguous(AllocationTraits::pageBytes(maxPages));
+  // TODO: add handling of mmap failure.
   allocation.set(
       data,
       AllocationTraits::pageBytes(numPages),
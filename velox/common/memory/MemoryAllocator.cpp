@@ -17,6 +17,7 @@
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/common/memory/MallocAllocator.h"
 
+#include <folly/FileUtil.h>
 #include <sys/mman.h>
 #include <iostream>
 #include <numeric>
@@ -25,6 +26,7 @@
 #include "velox/common/memory/Memory.h"
 
 DECLARE_bool(velox_memory_use_hugepages);
+DECLARE_int64(velox_memory_huge_page_threshold_bytes);
 
 namespace facebook::velox::memory {
 
@@ -290,6 +292,9 @@ Stats Stats::operator-(const Stats& other) const {
     result.sizes[i] = sizes[i] - other.sizes[i];
   }
   result.numAdvise = numAdvise - other.numAdvise;
+  result.numHugePageBytes = numHugePageBytes;
+  result.numHugePageFallbacks =
+      numHugePageFallbacks - other.numHugePageFallbacks;
   return result;
 }
 
@@ -327,17 +332,48 @@ std::string Stats::toString() const {
   return out.str();
 }
 
+namespace {
+bool useHugePagesForSize(uint64_t bytes) {
+  return FLAGS_velox_memory_use_hugepages &&
+      bytes >= FLAGS_velox_memory_huge_page_threshold_bytes;
+}
+
+// Returns false if transparent huge pages are disabled or not supported by
+// the kernel. madvise() with MADV_HUGEPAGE is then a no-op or fails.
+bool transparentHugePagesAvailable() {
+#ifdef linux
+  static const bool available = []() {
+    std::string mode;
+    if (!folly::readFile(
+            "/sys/kernel/mm/transparent_hugepage/enabled", mode)) {
+      return false;
+    }
+    return mode.find("[never]") == std::string::npos;
+  }();
+  return available;
+#else
+  return false;
+#endif
+}
+} // namespace
+
 void MemoryAllocator::useHugePages(
     const ContiguousAllocation& data,
     bool enable) {
 #ifdef linux
-  if (!FLAGS_velox_memory_use_hugepages) {
+  if (!useHugePagesForSize(data.maxSize())) {
     return;
   }
   auto maybeRange = data.hugePageRange();
   if (!maybeRange.has_value()) {
     return;
   }
+  if (!transparentHugePagesAvailable()) {
+    if (enable) {
+      ++numHugePageFallbacks_;
+    }
+    return;
+  }
   auto rc = ::madvise(
       maybeRange.value().data(),
       maybeRange.value().size(),
@@ -345,8 +381,52 @@ void MemoryAllocator::useHugePages(
   if (rc != 0) {
     VELOX_MEM_LOG(WARNING) << "madvise hugepage errno="
                            << folly ::errnoStr(errno);
+    if (enable) {
+      ++numHugePageFallbacks_;
+    }
+    return;
+  }
+  if (enable) {
+    numHugePageBytes_ += maybeRange.value().size();
+  } else {
+    numHugePageBytes_ -= maybeRange.value().size();
   }
 #endif
 }
 
+// static
+void* MemoryAllocator::mapContiguous(uint64_t bytes) {
+  // Over-map by a huge page so that the aligned range can be cut out of it.
+  const bool alignToHugePage = useHugePagesForSize(bytes);
+  const uint64_t mapBytes =
+      alignToHugePage ? bytes + AllocationTraits::kHugePageSize : bytes;
+  void* data = ::mmap(
+      nullptr,
+      mapBytes,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0);
+  if (data == MAP_FAILED) {
+    VELOX_MEM_LOG(ERROR) << "mmap of " << mapBytes
+                         << " bytes failed: " << folly::errnoStr(errno);
+    return nullptr;
+  }
+  if (!alignToHugePage) {
+    return data;
+  }
+  const auto begin = reinterpret_cast<uintptr_t>(data);
+  const auto alignedBegin =
+      bits::roundUp(begin, AllocationTraits::kHugePageSize);
+  const auto alignedEnd = alignedBegin + bytes;
+  if (alignedBegin > begin) {
+    ::munmap(data, alignedBegin - begin);
+  }
+  if (begin + mapBytes > alignedEnd) {
+    ::munmap(
+        reinterpret_cast<void*>(alignedEnd), begin + mapBytes - alignedEnd);
+  }
+  return reinterpret_cast<void*>(alignedBegin);
+}
+
 } // namespace facebook::velox::memory
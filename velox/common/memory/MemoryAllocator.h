@@ -137,6 +137,14 @@ struct Stats {
 
   /// Cumulative count of pages advised away, if the allocator exposes this.
   int64_t numAdvise{0};
+
+  /// Bytes of contiguous allocations currently advised to be backed by
+  /// transparent huge pages.
+  int64_t numHugePageBytes{0};
+
+  /// Cumulative count of contiguous allocations above the huge page threshold
+  /// that fell back to regular pages because huge pages are not available.
+  int64_t numHugePageFallbacks{0};
 };
 
 class MemoryAllocator;
@@ -338,7 +346,10 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   virtual MachinePageCount numMapped() const = 0;
 
   virtual Stats stats() const {
-    return stats_;
+    auto stats = stats_;
+    stats.numHugePageBytes = numHugePageBytes_;
+    stats.numHugePageFallbacks = numHugePageFallbacks_;
+    return stats;
   }
 
   virtual std::string toString() const = 0;
@@ -461,6 +472,11 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   // the address raneg.
   void useHugePages(const ContiguousAllocation& data, bool enable);
 
+  // Maps 'bytes' of anonymous memory for a contiguous allocation. If 'bytes'
+  // is above the huge page threshold, the mapping is aligned to a huge page so
+  // that all of it can be backed by huge pages. Returns nullptr on failure.
+  static void* mapContiguous(uint64_t bytes);
+
   // The machine page counts corresponding to different sizes in order
   // of increasing size.
   const std::vector<MachinePageCount>
@@ -487,6 +503,12 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
 
   Stats stats_;
 
+  // Bytes advised to be backed by huge pages in useHugePages().
+  std::atomic<int64_t> numHugePageBytes_{0};
+
+  // Number of useHugePages() calls that could not enable huge pages.
+  std::atomic<int64_t> numHugePageFallbacks_{0};
+
  private:
   static std::mutex initMutex_;
   // Singleton instance.
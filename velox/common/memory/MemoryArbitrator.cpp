@@ -184,6 +184,32 @@ bool MemoryReclaimer::reclaimableBytes(
   return reclaimable;
 }
 
+void MemoryReclaimer::reclaimCost(const MemoryPool& pool, ReclaimCost& cost)
+    const {
+  if (pool.kind() == MemoryPool::Kind::kLeaf) {
+    return;
+  }
+  pool.visitChildren([&](MemoryPool* child) {
+    if (child->reclaimer() == nullptr) {
+      return true;
+    }
+    ReclaimCost childCost;
+    child->reclaimer()->reclaimCost(*child, childCost);
+    cost.spillBytes += childCost.spillBytes;
+    cost.noSpillBytes += childCost.noSpillBytes;
+    return true;
+  });
+}
+
+std::string MemoryReclaimer::ReclaimCost::toString() const {
+  return fmt::format(
+      "PRIORITY[{}] ELAPSED[{}ms] SPILL_BYTES[{}] NO_SPILL_BYTES[{}]",
+      priority,
+      elapsedTimeMs,
+      succinctBytes(spillBytes),
+      succinctBytes(noSpillBytes));
+}
+
 uint64_t
 MemoryReclaimer::reclaim(MemoryPool* pool, uint64_t targetBytes, Stats& stats) {
   if (pool->kind() == MemoryPool::Kind::kLeaf) {
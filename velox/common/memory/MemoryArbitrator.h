@@ -297,6 +297,34 @@ class MemoryReclaimer {
       const MemoryPool& pool,
       uint64_t& reclaimableBytes) const;
 
+  /// Describes the cost of reclaiming memory from a memory pool. Used by the
+  /// memory arbitrator to choose the pools to reclaim from.
+  struct ReclaimCost {
+    /// The priority of the query of the memory pool. Pools with lower
+    /// priority are reclaimed from first.
+    int32_t priority{0};
+
+    /// The time the query of the memory pool has been running, in
+    /// milliseconds. 0 if not known.
+    uint64_t elapsedTimeMs{0};
+
+    /// The estimated number of bytes to write to spill storage for reclaiming
+    /// all the reclaimable memory.
+    uint64_t spillBytes{0};
+
+    /// The number of reclaimable bytes that can be freed without spilling,
+    /// e.g. by flushing a partial aggregation.
+    uint64_t noSpillBytes{0};
+
+    std::string toString() const;
+  };
+
+  /// Invoked by the memory arbitrator to get the cost of reclaiming memory
+  /// from 'pool'. The default implementation sums up the spill costs of the
+  /// child pools. A query system can override this for a root pool to set
+  /// 'priority' and 'elapsedTimeMs'.
+  virtual void reclaimCost(const MemoryPool& pool, ReclaimCost& cost) const;
+
   /// Invoked by the memory arbitrator to reclaim from memory 'pool' with
   /// specified 'targetBytes'. It is expected to reclaim at least that amount of
   /// memory bytes but there is no guarantees. If 'targetBytes' is zero, then it
@@ -16,10 +16,12 @@
 
 #include "velox/common/memory/MemoryPool.h"
 
+#include <fstream>
 #include <set>
 
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/process/StackTrace.h"
 #include "velox/common/testutil/TestValue.h"
 
 #include <re2/re2.h>
@@ -135,6 +137,10 @@ std::string capacityToString(int64_t capacity) {
   return capacity == kMaxMemory ? "UNLIMITED" : succinctBytes(capacity);
 }
 
+// The number of bytes left to reserve by this thread before the next profile
+// sample. Shared by all the memory pools like the sampling state of jemalloc.
+thread_local int64_t profileBytesUntilSample{0};
+
 #define DEBUG_RECORD_ALLOC(...)        \
   if (FOLLY_UNLIKELY(debugEnabled_)) { \
     recordAllocDbg(__VA_ARGS__);       \
@@ -202,7 +208,8 @@ MemoryPool::MemoryPool(
       trackUsage_(options.trackUsage),
       threadSafe_(options.threadSafe),
       checkUsageLeak_(options.checkUsageLeak),
-      debugEnabled_(options.debugEnabled) {
+      debugEnabled_(options.debugEnabled),
+      profileSampleBytes_(options.profileSampleBytes) {
   VELOX_CHECK(!isRoot() || !isLeaf());
   VELOX_CHECK_GT(
       maxCapacity_, 0, "Memory pool {} max capacity can't be zero", name_);
@@ -228,6 +235,41 @@ std::ostream& operator<<(std::ostream& out, MemoryPool::Kind kind) {
   return out << MemoryPool::kindString(kind);
 }
 
+std::string MemoryPool::dumpProfile() const {
+  Profile profile;
+  collectProfile(profile);
+  ProfileSample total;
+  for (const auto& [stack, sample] : profile) {
+    total.count += sample.count;
+    total.bytes += sample.bytes;
+  }
+  // The samples are already extrapolated, hence 'heapprofile' without a
+  // sampling rate for pprof to adjust to.
+  std::stringstream out;
+  out << fmt::format(
+      "heap profile: {}: {} [{}: {}] @ heapprofile\n",
+      total.count,
+      total.bytes,
+      total.count,
+      total.bytes);
+  for (const auto& [stack, sample] : profile) {
+    out << fmt::format(
+        "{}: {} [{}: {}] @",
+        sample.count,
+        sample.bytes,
+        sample.count,
+        sample.bytes);
+    for (const auto* frame : stack) {
+      out << fmt::format(" {}", fmt::ptr(frame));
+    }
+    out << "\n";
+  }
+  out << "\nMAPPED_LIBRARIES:\n";
+  std::ifstream maps("/proc/self/maps");
+  out << maps.rdbuf();
+  return out.str();
+}
+
 const std::string& MemoryPool::name() const {
   return name_;
 }
@@ -628,7 +670,8 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .checkUsageLeak = checkUsageLeak_,
-          .debugEnabled = debugEnabled_});
+          .debugEnabled = debugEnabled_,
+          .profileSampleBytes = profileSampleBytes_});
 }
 
 bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
@@ -654,6 +697,9 @@ bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
 }
 
 void MemoryPoolImpl::reserve(uint64_t size, bool reserveOnly) {
+  if (FOLLY_UNLIKELY(profileSampleBytes_ != 0)) {
+    maybeRecordProfileSample(size);
+  }
   if (FOLLY_LIKELY(trackUsage_)) {
     if (FOLLY_LIKELY(threadSafe_)) {
       reserveThreadSafe(size, reserveOnly);
@@ -1096,6 +1142,38 @@ void MemoryPoolImpl::recordGrowDbg(const void* addr, uint64_t newSize) {
   allocResult->second.size = newSize;
 }
 
+void MemoryPoolImpl::maybeRecordProfileSample(uint64_t size) {
+  profileBytesUntilSample -= size;
+  if (FOLLY_LIKELY(profileBytesUntilSample > 0)) {
+    return;
+  }
+  // Each sample stands for 'profileSampleBytes_' reserved bytes, and a large
+  // reservation crosses as many sampling points as it covers.
+  const uint64_t numSamples =
+      1 + static_cast<uint64_t>(-profileBytesUntilSample) / profileSampleBytes_;
+  profileBytesUntilSample += numSamples * profileSampleBytes_;
+  const process::StackTrace stackTrace;
+  std::lock_guard<std::mutex> l(profileMutex_);
+  auto& sample = profile_[stackTrace.getStack()];
+  sample.count += numSamples;
+  sample.bytes += numSamples * profileSampleBytes_;
+}
+
+void MemoryPoolImpl::collectProfile(Profile& profile) const {
+  {
+    std::lock_guard<std::mutex> l(profileMutex_);
+    for (const auto& [stack, sample] : profile_) {
+      auto& aggregated = profile[stack];
+      aggregated.count += sample.count;
+      aggregated.bytes += sample.bytes;
+    }
+  }
+  visitChildren([&](MemoryPool* child) {
+    child->collectProfile(profile);
+    return true;
+  });
+}
+
 void MemoryPoolImpl::leakCheckDbg() {
   VELOX_CHECK(debugEnabled_);
   if (debugAllocRecords_.empty()) {
@@ -18,6 +18,7 @@
 
 #include <array>
 #include <atomic>
+#include <map>
 #include <memory>
 #include <optional>
 #include <queue>
@@ -32,6 +33,7 @@
 
 DECLARE_bool(velox_memory_leak_check_enabled);
 DECLARE_bool(velox_memory_pool_debug_enabled);
+DECLARE_uint64(velox_memory_pool_profile_sample_bytes);
 
 namespace facebook::velox::memory {
 #define VELOX_MEM_POOL_CAP_EXCEEDED(errorMessage)                   \
@@ -160,6 +162,12 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// If true, tracks the allocation and free call stacks to detect the source
     /// of memory leak for testing purpose.
     bool debugEnabled{FLAGS_velox_memory_pool_debug_enabled};
+
+    /// If not zero, samples the call stack of a memory reservation from a leaf
+    /// memory pool every this number of bytes reserved by a thread on average,
+    /// in the style of jemalloc heap profiling. The samples are aggregated per
+    /// memory pool and can be dumped with dumpProfile().
+    uint64_t profileSampleBytes{FLAGS_velox_memory_pool_profile_sample_bytes};
   };
 
   /// Constructs a named memory pool with specified 'name', 'parent' and 'kind'.
@@ -476,6 +484,32 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// MemoryPoolImpl::treeMemoryUsage()
   virtual std::string treeMemoryUsage() const = 0;
 
+  /// The estimated number and bytes of the memory reservations made from one
+  /// call stack, extrapolated from the sampled reservations.
+  struct ProfileSample {
+    uint64_t count{0};
+    uint64_t bytes{0};
+  };
+
+  /// Maps from the raw frame pointers of a call stack to its samples.
+  using Profile = std::map<std::vector<void*>, ProfileSample>;
+
+  /// Adds the allocation-site profile samples of this memory pool and all its
+  /// descendants to 'profile'. The samples are only collected if
+  /// Options::profileSampleBytes is set.
+  virtual void collectProfile(Profile& profile) const = 0;
+
+  /// Returns the allocation-site profile of this memory pool and all its
+  /// descendants in the legacy pprof heap profile text format, which can be
+  /// symbolized by 'pprof --text <binary> <file>'. The profile is cumulative
+  /// and doesn't account for the memory freed since.
+  std::string dumpProfile() const;
+
+  /// Returns the profile sampling interval in bytes, or zero if disabled.
+  uint64_t profileSampleBytes() const {
+    return profileSampleBytes_;
+  }
+
   /// Indicates if this is a leaf memory pool or not.
   FOLLY_ALWAYS_INLINE bool isLeaf() const {
     return kind_ == Kind::kLeaf;
@@ -524,6 +558,7 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool threadSafe_;
   const bool checkUsageLeak_;
   const bool debugEnabled_;
+  const uint64_t profileSampleBytes_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
   /// not.
@@ -670,6 +705,8 @@ class MemoryPoolImpl : public MemoryPool {
   //     op.0.0.0.Values usage 0B peak 0B
   std::string treeMemoryUsage() const override;
 
+  void collectProfile(Profile& profile) const override;
+
   Stats stats() const override;
 
   void testingSetCapacity(int64_t bytes);
@@ -945,6 +982,10 @@ class MemoryPoolImpl : public MemoryPool {
   // Accounts for ContiguousAllocation size change in growContiguous().
   void recordGrowDbg(const void* addr, uint64_t newSize);
 
+  // Invoked on a memory reservation of 'size' bytes if profiling is enabled to
+  // sample the call stack of the reservation.
+  void maybeRecordProfileSample(uint64_t size);
+
   // Invoked by memory pool destructor to detect the sources of leaked memory
   // allocations from the call sites which are still recorded in
   // 'debugAllocRecords_'. If there is no memory leaks, 'debugAllocRecords_'
@@ -1015,6 +1056,12 @@ class MemoryPoolImpl : public MemoryPool {
 
   // Map from address to 'AllocationRecord'.
   std::unordered_map<uint64_t, AllocationRecord> debugAllocRecords_;
+
+  // Mutex for 'profile_'.
+  mutable std::mutex profileMutex_;
+
+  // The sampled call stacks of the memory reservations from this pool.
+  Profile profile_;
 };
 
 /// An Allocator backed by a memory pool for STL containers.
@@ -1050,4 +1097,55 @@ class StlAllocator {
     return !(*this == rhs);
   }
 };
+
+/// Like StlAllocator but allocates from the global heap if there is no pool.
+/// Used by containers in classes that are used both inside operators, where
+/// the memory must be accounted to the operator's pool, and by utilities that
+/// have no pool.
+template <typename T>
+class OptionalStlAllocator {
+ public:
+  typedef T value_type;
+  MemoryPool* pool;
+
+  /* implicit */ OptionalStlAllocator(MemoryPool* pool = nullptr)
+      : pool{pool} {}
+
+  template <typename U>
+  /* implicit */ OptionalStlAllocator(const OptionalStlAllocator<U>& a)
+      : pool{a.pool} {}
+
+  T* allocate(size_t n) {
+    const auto bytes = checkedMultiply(n, sizeof(T));
+    if (pool != nullptr) {
+      return static_cast<T*>(pool->allocate(bytes));
+    }
+    auto* result = std::malloc(bytes);
+    if (result == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(result);
+  }
+
+  void deallocate(T* p, size_t n) {
+    if (pool != nullptr) {
+      pool->free(p, checkedMultiply(n, sizeof(T)));
+    } else {
+      std::free(p);
+    }
+  }
+
+  template <typename T1>
+  bool operator==(const OptionalStlAllocator<T1>& rhs) const {
+    if constexpr (std::is_same_v<T, T1>) {
+      return this->pool == rhs.pool;
+    }
+    return false;
+  }
+
+  template <typename T1>
+  bool operator!=(const OptionalStlAllocator<T1>& rhs) const {
+    return !(*this == rhs);
+  }
+};
 } // namespace facebook::velox::memory
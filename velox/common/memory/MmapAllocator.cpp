@@ -20,6 +20,7 @@
 
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/process/Numa.h"
 
 namespace facebook::velox::memory {
 MmapAllocator::MmapAllocator(const Options& options)
@@ -32,9 +33,14 @@ MmapAllocator::MmapAllocator(const Options& options)
               : options.capacity * options.smallAllocationReservePct / 100),
       capacity_(bits::roundUp(
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
-          64 * sizeClassSizes_.back())) {
-  for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+          64 * sizeClassSizes_.back())),
+      numNumaNodes_(std::max<int32_t>(1, options.numNumaNodes)),
+      numAllocatedOnNode_(numNumaNodes_) {
+  for (int32_t node = 0; node < numNumaNodes_; ++node) {
+    for (const auto& size : sizeClassSizes_) {
+      sizeClasses_.push_back(std::make_unique<SizeClass>(
+          capacity_ / size, size, numNumaNodes_ > 1 ? node : -1));
+    }
   }
 
   if (useMmapArena_) {
@@ -110,16 +116,21 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
       std::rethrow_exception(std::current_exception());
     }
   }
+  const int32_t node =
+      numNumaNodes_ > 1 ? process::currentNumaNode() % numNumaNodes_ : 0;
+  const auto firstClass = node * sizeClassSizes_.size();
   MachinePageCount newMapsNeeded = 0;
   for (int i = 0; i < mix.numSizes; ++i) {
     bool success;
+    const auto unitSize = sizeClassSizes_[mix.sizeIndices[i]];
     stats_.recordAllocate(
-        AllocationTraits::pageBytes(sizeClassSizes_[mix.sizeIndices[i]]),
-        mix.sizeCounts[i],
-        [&]() {
-          success = sizeClasses_[mix.sizeIndices[i]]->allocate(
+        AllocationTraits::pageBytes(unitSize), mix.sizeCounts[i], [&]() {
+          success = sizeClasses_[firstClass + mix.sizeIndices[i]]->allocate(
               mix.sizeCounts[i], newMapsNeeded, out);
         });
+    if (success) {
+      numAllocatedOnNode_[node] += mix.sizeCounts[i] * unitSize;
+    }
     if (success && ((i > 0) || (mix.numSizes == 1)) &&
         testingHasInjectedFailure(InjectedFailure::kAllocate)) {
       // Trigger memory allocation failure in the middle of the size class
@@ -205,10 +216,13 @@ MachinePageCount MmapAllocator::freeInternal(Allocation& allocation) {
       // Increment the free time only if the allocation contained
       // pages in the class. Note that size class indices in the
       // allocator are not necessarily the same as in the stats.
-      const auto sizeIndex =
-          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClassSizes_[i]));
+      const auto sizeIndex = Stats::sizeIndex(AllocationTraits::pageBytes(
+          sizeClassSizes_[i % sizeClassSizes_.size()]));
       stats_.sizes[sizeIndex].freeClocks += clocks;
     }
+    if (pages > 0) {
+      numAllocatedOnNode_[i / sizeClassSizes_.size()] -= pages;
+    }
     numFreed += pages;
   }
   allocation.clear();
@@ -361,16 +375,9 @@ bool MmapAllocator::allocateContiguousImpl(
       std::lock_guard<std::mutex> l(arenaMutex_);
       data = managedArenas_->allocate(AllocationTraits::pageBytes(maxPages));
     } else {
-      data = ::mmap(
-          nullptr,
-          AllocationTraits::pageBytes(maxPages),
-          PROT_READ | PROT_WRITE,
-          MAP_PRIVATE | MAP_ANONYMOUS,
-          -1,
-          0);
+      data = mapContiguous(AllocationTraits::pageBytes(maxPages));
     }
   }
-  // TODO: add handling of MAP_FAILED.
   if (data == nullptr) {
     VELOX_MEM_LOG(ERROR) << "Mmap failed with " << numPages
                          << " pages, use MmapArena "
@@ -532,16 +539,24 @@ void MmapAllocator::markAllMapped(const Allocation& allocation) {
 
 MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   MachinePageCount numAway = 0;
-  for (int32_t i = sizeClasses_.size() - 1; i >= 0; --i) {
-    numAway += sizeClasses_[i]->adviseAway(target - numAway);
-    if (numAway >= target) {
-      break;
+  // Advise away from the largest size class of every node first.
+  const int32_t numSizes = sizeClassSizes_.size();
+  for (int32_t i = numSizes - 1; i >= 0; --i) {
+    for (int32_t node = 0; node < numNumaNodes_; ++node) {
+      numAway +=
+          sizeClasses_[node * numSizes + i]->adviseAway(target - numAway);
+      if (numAway >= target) {
+        return numAway;
+      }
     }
   }
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    int32_t numaNode)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
@@ -570,6 +585,10 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         unitSize_);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  if (numaNode >= 0 && !process::preferNumaNode(ptr, byteSize_, numaNode)) {
+    VELOX_MEM_LOG(WARNING) << "Could not bind sizeClass " << unitSize_
+                           << " to NUMA node " << numaNode;
+  }
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
@@ -990,6 +1009,12 @@ std::string MmapAllocator::toString() const {
       << ((capacity_ == kMaxMemory) ? "UNLIMITED" : succinctBytes(capacity_))
       << " allocated pages " << numAllocated_ << " mapped pages " << numMapped_
       << " external mapped pages " << numExternalMapped_ << std::endl;
+  if (numNumaNodes_ > 1) {
+    for (int32_t node = 0; node < numNumaNodes_; ++node) {
+      out << "NUMA node " << node << " allocated pages "
+          << numAllocatedOnNode_[node] << std::endl;
+    }
+  }
   for (auto& sizeClass : sizeClasses_) {
     out << sizeClass->toString() << std::endl;
   }
@@ -75,6 +75,12 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// Number of NUMA nodes to partition the size classes into. If greater
+    /// than 1, each node gets its own set of size classes whose pages are
+    /// preferentially backed by the node's memory, and non-contiguous
+    /// allocations are served from the calling thread's node.
+    int32_t numNumaNodes = 1;
   };
 
   explicit MmapAllocator(const Options& options);
@@ -148,13 +154,25 @@ class MmapAllocator : public MemoryAllocator {
   }
 
   Stats stats() const override {
-    auto stats = stats_;
+    auto stats = MemoryAllocator::stats();
     stats.numAdvise = numAdvisedPages_;
     return stats;
   }
 
   std::string toString() const override;
 
+  /// Returns the number of NUMA partitions of the size classes.
+  int32_t numNumaNodes() const {
+    return numNumaNodes_;
+  }
+
+  /// Returns the number of pages allocated from the size classes of NUMA
+  /// partition 'node'.
+  MachinePageCount numAllocatedOnNode(int32_t node) const {
+    VELOX_CHECK_LT(node, numNumaNodes_);
+    return numAllocatedOnNode_[node];
+  }
+
  private:
   static constexpr uint64_t kAllSet = 0xffffffffffffffff;
 
@@ -162,7 +180,9 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    // If 'numaNode' is not negative, the address range is bound to prefer
+    // the memory of 'numaNode'.
+    SizeClass(size_t capacity, MachinePageCount unitSize, int32_t numaNode);
 
     ~SizeClass();
 
@@ -406,8 +426,15 @@ class MmapAllocator : public MemoryAllocator {
   // to std::malloc().
   const MachinePageCount capacity_ = 0;
 
+  const int32_t numNumaNodes_;
+
+  // Size classes for each NUMA node. The size class 'sizeIndex' of 'node' is
+  // at 'node * sizeClassSizes_.size() + sizeIndex'.
   std::vector<std::unique_ptr<SizeClass>> sizeClasses_;
 
+  // Number of pages allocated from the size classes of each NUMA node.
+  std::vector<std::atomic<MachinePageCount>> numAllocatedOnNode_;
+
   // Statistics.
   std::atomic<uint64_t> numAllocations_ = 0;
   std::atomic<uint64_t> numAllocatedPages_ = 0;
@@ -16,7 +16,11 @@
 
 #include "velox/common/memory/SharedArbitrator.h"
 
+#include <numeric>
+
+#include "velox/common/base/Counters.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
 
@@ -67,11 +71,80 @@ SharedArbitrator::SharedArbitrator(const MemoryArbitrator::Config& config)
 
 std::string SharedArbitrator::Candidate::toString() const {
   return fmt::format(
-      "CANDIDATE[{} RECLAIMABLE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}]]",
+      "CANDIDATE[{} RECLAIMABLE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}] {}]",
       pool->root()->name(),
       reclaimable,
       succinctBytes(reclaimableBytes),
-      succinctBytes(freeBytes));
+      succinctBytes(freeBytes),
+      reclaimCost.toString());
+}
+
+void SharedArbitrator::ReclaimableBytesVictimPolicy::sort(
+    std::vector<Candidate>& candidates) const {
+  std::sort(
+      candidates.begin(),
+      candidates.end(),
+      [](const Candidate& lhs, const Candidate& rhs) {
+        if (!lhs.reclaimable) {
+          return false;
+        }
+        if (!rhs.reclaimable) {
+          return true;
+        }
+        return lhs.reclaimableBytes > rhs.reclaimableBytes;
+      });
+}
+
+double SharedArbitrator::CostBasedVictimPolicy::score(
+    const Candidate& candidate) const {
+  if (!candidate.reclaimable || candidate.reclaimableBytes == 0) {
+    return 0;
+  }
+  const auto& cost = candidate.reclaimCost;
+  const double bytes = candidate.reclaimableBytes;
+  const double noSpillFraction =
+      std::min<double>(cost.noSpillBytes, bytes) / bytes;
+  const double spillCost = options_.spillCostWeight * cost.spillBytes / bytes *
+      (1 - noSpillFraction);
+  const double ageFactor = 1 +
+      static_cast<double>(cost.elapsedTimeMs) /
+          std::max<uint64_t>(1, options_.halfScoreElapsedTimeMs);
+  return bytes / ((1 + spillCost) * ageFactor);
+}
+
+void SharedArbitrator::CostBasedVictimPolicy::sort(
+    std::vector<Candidate>& candidates) const {
+  std::vector<double> scores;
+  scores.reserve(candidates.size());
+  for (const auto& candidate : candidates) {
+    scores.push_back(score(candidate));
+  }
+  std::vector<int32_t> order(candidates.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](int32_t lhs, int32_t rhs) {
+    const auto& left = candidates[lhs];
+    const auto& right = candidates[rhs];
+    if (left.reclaimable != right.reclaimable) {
+      return left.reclaimable;
+    }
+    if (left.reclaimCost.priority != right.reclaimCost.priority) {
+      return left.reclaimCost.priority < right.reclaimCost.priority;
+    }
+    return scores[lhs] > scores[rhs];
+  });
+  std::vector<Candidate> sorted;
+  sorted.reserve(candidates.size());
+  for (auto i : order) {
+    sorted.push_back(candidates[i]);
+  }
+  candidates = std::move(sorted);
+}
+
+void SharedArbitrator::setVictimPolicy(
+    std::shared_ptr<const VictimPolicy> policy) {
+  VELOX_CHECK_NOT_NULL(policy);
+  std::lock_guard<std::mutex> l(mutex_);
+  victimPolicy_ = std::move(policy);
 }
 
 void SharedArbitrator::sortCandidatesByFreeCapacity(
@@ -90,18 +163,18 @@ void SharedArbitrator::sortCandidatesByFreeCapacity(
 
 void SharedArbitrator::sortCandidatesByReclaimableMemory(
     std::vector<Candidate>& candidates) const {
-  std::sort(
-      candidates.begin(),
-      candidates.end(),
-      [](const Candidate& lhs, const Candidate& rhs) {
-        if (!lhs.reclaimable) {
-          return false;
-        }
-        if (!rhs.reclaimable) {
-          return true;
-        }
-        return lhs.reclaimableBytes > rhs.reclaimableBytes;
-      });
+  std::shared_ptr<const VictimPolicy> policy;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    policy = victimPolicy_;
+  }
+  policy->sort(candidates);
+  std::stringstream out;
+  for (const auto& candidate : candidates) {
+    out << "\n" << candidate.toString();
+  }
+  VELOX_MEM_LOG(INFO) << "Reclaim victims ordered by " << policy->name() << ":"
+                      << out.str();
 
   TestValue::adjust(
       "facebook::velox::memory::SharedArbitrator::sortCandidatesByReclaimableMemory",
@@ -178,6 +251,9 @@ std::vector<SharedArbitrator::Candidate> SharedArbitrator::getCandidateStats(
     const bool reclaimable = pool->reclaimableBytes(reclaimableBytes);
     candidates.push_back(
         {reclaimable, reclaimableBytes, pool->freeBytes(), pool.get()});
+    if (reclaimable && pool->reclaimer() != nullptr) {
+      pool->reclaimer()->reclaimCost(*pool, candidates.back().reclaimCost);
+    }
   }
   return candidates;
 }
@@ -562,6 +638,8 @@ void SharedArbitrator::startArbitration(MemoryPool* requestor) {
       waitPromise.wait();
     }
     queueTimeUs_ += waitTimeUs;
+    REPORT_ADD_HISTOGRAM_VALUE(
+        kCounterArbitratorQueueTimeMs, waitTimeUs / 1'000);
   }
 }
 
@@ -68,10 +68,75 @@ class SharedArbitrator : public MemoryArbitrator {
     uint64_t reclaimableBytes{0};
     uint64_t freeBytes{0};
     MemoryPool* pool;
+    /// The cost of reclaiming used memory from 'pool'. Only set if
+    /// 'reclaimable' is true.
+    MemoryReclaimer::ReclaimCost reclaimCost{};
 
     std::string toString() const;
   };
 
+  /// Chooses the order in which to reclaim used memory from the candidates.
+  class VictimPolicy {
+   public:
+    virtual ~VictimPolicy() = default;
+
+    virtual std::string name() const = 0;
+
+    /// Sorts 'candidates' so that the ones to reclaim from first are at the
+    /// front. Candidates that are not reclaimable must be at the end.
+    virtual void sort(std::vector<Candidate>& candidates) const = 0;
+  };
+
+  /// Reclaims from the candidates with the most reclaimable bytes first. This
+  /// is the default policy.
+  class ReclaimableBytesVictimPolicy : public VictimPolicy {
+   public:
+    std::string name() const override {
+      return "RECLAIMABLE_BYTES";
+    }
+
+    void sort(std::vector<Candidate>& candidates) const override;
+  };
+
+  /// Reclaims from the candidates of the lowest priority first. Within a
+  /// priority, reclaims from the candidates with the highest score() first.
+  /// The score is the reclaimable bytes discounted by the spill I/O needed to
+  /// reclaim them and by the time the query has been running, so that nearly
+  /// finished queries and pools that are expensive to spill are reclaimed
+  /// from last.
+  class CostBasedVictimPolicy : public VictimPolicy {
+   public:
+    struct Options {
+      /// Weight of a spilled byte relative to a reclaimed byte. With 1, a
+      /// pool that must spill all its reclaimable bytes scores half of a pool
+      /// that frees the same bytes without spilling.
+      double spillCostWeight{1.0};
+
+      /// A query that has been running for this long scores half of a query
+      /// that has just started.
+      uint64_t halfScoreElapsedTimeMs{60'000};
+    };
+
+    CostBasedVictimPolicy() = default;
+
+    explicit CostBasedVictimPolicy(const Options& options)
+        : options_(options) {}
+
+    std::string name() const override {
+      return "COST_BASED";
+    }
+
+    void sort(std::vector<Candidate>& candidates) const override;
+
+    double score(const Candidate& candidate) const;
+
+   private:
+    const Options options_;
+  };
+
+  /// Sets the policy to choose the candidates to reclaim used memory from.
+  void setVictimPolicy(std::shared_ptr<const VictimPolicy> policy);
+
  private:
   // The kind string of shared arbitrator.
   inline static const std::string kind_{"SHARED"};
@@ -106,6 +171,7 @@ class SharedArbitrator : public MemoryArbitrator {
   static std::vector<Candidate> getCandidateStats(
       const std::vector<std::shared_ptr<MemoryPool>>& pools);
 
+  // Sorts 'candidates' with the victim policy and logs the order.
   void sortCandidatesByReclaimableMemory(
       std::vector<Candidate>& candidates) const;
 
@@ -191,6 +257,9 @@ class SharedArbitrator : public MemoryArbitrator {
   // execution.
   std::vector<ContinuePromise> waitPromises_;
 
+  std::shared_ptr<const VictimPolicy> victimPolicy_{
+      std::make_shared<ReclaimableBytesVictimPolicy>()};
+
   tsan_atomic<uint64_t> numRequests_{0};
   std::atomic<uint64_t> numSucceeded_{0};
   tsan_atomic<uint64_t> numAborted_{0};
@@ -506,5 +506,45 @@ TEST_F(HashStringAllocatorTest, freeLists) {
   EXPECT_EQ(2 * 98, allocator_->numFreeListNoFit());
 }
 
+TEST_F(HashStringAllocatorTest, smallBlockCache) {
+  allocator_ = std::make_unique<HashStringAllocator>(pool_.get(), true);
+  std::vector<HSA::Header*> headers;
+  for (auto i = 0; i < 10'000; ++i) {
+    headers.push_back(allocate(1 + i % HSA::kMaxCachedSize));
+  }
+  allocator_->checkConsistency();
+  const auto retained = allocator_->retainedSize();
+  const auto cumulative = allocator_->cumulativeBytes();
+  std::vector<HSA::Header*> freed;
+  for (auto i = 0; i < headers.size(); i += 2) {
+    freed.push_back(headers[i]);
+    allocator_->free(headers[i]);
+  }
+  // Freed blocks are cached, not coalesced.
+  EXPECT_LT(allocator_->cumulativeBytes(), cumulative);
+  EXPECT_GT(allocator_->cachedBytes(), 0);
+  for (auto* header : freed) {
+    EXPECT_FALSE(header->isFree());
+  }
+  allocator_->checkConsistency();
+
+  // Allocating the same sizes again reuses the cached blocks. A few blocks
+  // at the end of a slab are larger than their size and stay cached.
+  for (auto i = 0; i < headers.size(); i += 2) {
+    headers[i] = allocate(1 + i % HSA::kMaxCachedSize);
+  }
+  EXPECT_LT(allocator_->cachedBytes(), 1'000);
+  EXPECT_EQ(allocator_->retainedSize(), retained);
+  allocator_->checkConsistency();
+
+  for (auto* header : headers) {
+    allocator_->free(header);
+  }
+  EXPECT_TRUE(allocator_->isEmpty());
+  allocator_->clear();
+  EXPECT_EQ(allocator_->cachedBytes(), 0);
+  EXPECT_TRUE(allocator_->isEmpty());
+}
+
 } // namespace
 } // namespace facebook::velox
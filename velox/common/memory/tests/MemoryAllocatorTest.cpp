@@ -19,18 +19,22 @@
 #include "velox/common/memory/MallocAllocator.h"
 #include "velox/common/memory/MmapAllocator.h"
 #include "velox/common/memory/MmapArena.h"
+#include "velox/common/process/Numa.h"
 #include "velox/common/testutil/TestValue.h"
 
 #include <fstream>
 #include <thread>
 
 #include <folly/Random.h>
+#include <folly/ScopeGuard.h>
 #include <folly/Range.h>
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
 DECLARE_int32(velox_memory_pool_mb);
+DECLARE_bool(velox_memory_use_hugepages);
+DECLARE_int64(velox_memory_huge_page_threshold_bytes);
 
 using namespace facebook::velox::common::testutil;
 
@@ -464,6 +468,37 @@ TEST_P(MemoryAllocatorTest, mmapAllocatorInit) {
   }
 }
 
+TEST_P(MemoryAllocatorTest, numaPartitionedSizeClasses) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.numNumaNodes = 2;
+  auto mmapAllocator = std::make_shared<MmapAllocator>(options);
+  ASSERT_EQ(mmapAllocator->numNumaNodes(), 2);
+  const int32_t node = process::currentNumaNode() % 2;
+  const int32_t otherNode = 1 - node;
+  {
+    Allocation allocation;
+    const MachinePageCount numPages = 1000;
+    ASSERT_TRUE(mmapAllocator->allocateNonContiguous(numPages, allocation));
+    // The calling thread may migrate between nodes in the middle of the test.
+    const auto allocatedNode =
+        mmapAllocator->numAllocatedOnNode(node) > 0 ? node : otherNode;
+    ASSERT_GE(mmapAllocator->numAllocatedOnNode(allocatedNode), numPages);
+    ASSERT_EQ(
+        mmapAllocator->numAllocatedOnNode(allocatedNode),
+        allocation.numPages());
+    ASSERT_EQ(mmapAllocator->numAllocatedOnNode(1 - allocatedNode), 0);
+    ASSERT_TRUE(mmapAllocator->checkConsistency());
+    mmapAllocator->freeNonContiguous(allocation);
+  }
+  ASSERT_EQ(mmapAllocator->numAllocatedOnNode(0), 0);
+  ASSERT_EQ(mmapAllocator->numAllocatedOnNode(1), 0);
+  ASSERT_TRUE(mmapAllocator->checkConsistency());
+}
+
 TEST_P(MemoryAllocatorTest, allocationPool) {
   const size_t kNumLargeAllocPages = instance_->largestSizeClass() * 2;
   const size_t kLarge = kNumLargeAllocPages * AllocationTraits::kPageSize;
@@ -940,6 +975,49 @@ TEST_P(MemoryAllocatorTest, allocContiguous) {
   }
 }
 
+TEST_P(MemoryAllocatorTest, allocContiguousHugePages) {
+  const bool useHugePages = FLAGS_velox_memory_use_hugepages;
+  const auto threshold = FLAGS_velox_memory_huge_page_threshold_bytes;
+  SCOPE_EXIT {
+    FLAGS_velox_memory_use_hugepages = useHugePages;
+    FLAGS_velox_memory_huge_page_threshold_bytes = threshold;
+  };
+  FLAGS_velox_memory_use_hugepages = true;
+  FLAGS_velox_memory_huge_page_threshold_bytes =
+      AllocationTraits::kHugePageSize;
+  const auto kHugePageSize = AllocationTraits::kHugePageSize;
+  const MachinePageCount numPages = 2 * AllocationTraits::numPagesInHugePage();
+  {
+    ContiguousAllocation allocation;
+    instance_->allocateContiguous(numPages, nullptr, allocation);
+    // The whole allocation is aligned to huge pages and is either advised to
+    // use them or counted as a fallback if they are not available.
+    ASSERT_EQ(
+        reinterpret_cast<uintptr_t>(allocation.data()) % kHugePageSize, 0);
+    const auto stats = instance_->stats();
+    if (stats.numHugePageFallbacks == 0) {
+      ASSERT_EQ(stats.numHugePageBytes, 2 * kHugePageSize);
+    } else {
+      ASSERT_EQ(stats.numHugePageBytes, 0);
+    }
+    instance_->freeContiguous(allocation);
+    ASSERT_EQ(instance_->stats().numHugePageBytes, 0);
+  }
+  {
+    // Allocations below the threshold are not aligned or advised.
+    FLAGS_velox_memory_huge_page_threshold_bytes = 4 * kHugePageSize;
+    const auto before = instance_->stats();
+    ContiguousAllocation allocation;
+    instance_->allocateContiguous(numPages, nullptr, allocation);
+    const auto delta = instance_->stats() - before;
+    ASSERT_EQ(delta.numHugePageBytes, 0);
+    ASSERT_EQ(delta.numHugePageFallbacks, 0);
+    instance_->freeContiguous(allocation);
+  }
+  ASSERT_EQ(instance_->numAllocated(), 0);
+  ASSERT_TRUE(instance_->checkConsistency());
+}
+
 TEST_P(MemoryAllocatorTest, allocContiguousFail) {
   struct {
     MachinePageCount nonContiguousPages;
@@ -27,6 +27,7 @@
 
 DECLARE_bool(velox_memory_leak_check_enabled);
 DECLARE_bool(velox_memory_pool_debug_enabled);
+DECLARE_uint64(velox_memory_pool_profile_sample_bytes);
 DECLARE_int32(velox_memory_num_shared_leaf_pools);
 
 using namespace ::testing;
@@ -3147,6 +3148,58 @@ TEST_P(MemoryPoolTest, maybeReserve) {
   ASSERT_EQ(child->stats().numShrinks, 0);
 }
 
+TEST_P(MemoryPoolTest, allocationProfile) {
+  constexpr uint64_t kSampleBytes = 1024;
+  constexpr int64_t kAllocSize = 64 * KB;
+  constexpr int32_t kNumAllocs = 4;
+  auto manager = getMemoryManager();
+  auto unprofiledRoot = manager->addRootPool("unprofiled");
+  std::shared_ptr<MemoryPool> root;
+  {
+    gflags::FlagSaver flagSaver;
+    FLAGS_velox_memory_pool_profile_sample_bytes = kSampleBytes;
+    root = manager->addRootPool("profiled");
+  }
+  ASSERT_EQ(root->profileSampleBytes(), kSampleBytes);
+  ASSERT_EQ(unprofiledRoot->profileSampleBytes(), 0);
+  auto child = root->addLeafChild("profiled", isLeafThreadSafe_);
+  ASSERT_EQ(child->profileSampleBytes(), kSampleBytes);
+  auto unprofiledChild =
+      unprofiledRoot->addLeafChild("unprofiled", isLeafThreadSafe_);
+
+  std::vector<void*> buffers;
+  for (int32_t i = 0; i < kNumAllocs; ++i) {
+    buffers.push_back(child->allocate(kAllocSize));
+    buffers.push_back(unprofiledChild->allocate(kAllocSize));
+  }
+  for (int32_t i = 0; i < kNumAllocs; ++i) {
+    child->free(buffers[2 * i], kAllocSize);
+    unprofiledChild->free(buffers[2 * i + 1], kAllocSize);
+  }
+
+  MemoryPool::Profile profile;
+  root->collectProfile(profile);
+  ASSERT_FALSE(profile.empty());
+  uint64_t sampledBytes{0};
+  for (const auto& [stack, sample] : profile) {
+    ASSERT_FALSE(stack.empty());
+    ASSERT_EQ(sample.bytes, sample.count * kSampleBytes);
+    sampledBytes += sample.bytes;
+  }
+  // The sampling points of the thread may be carried over from earlier
+  // reservations.
+  ASSERT_GE(sampledBytes, kNumAllocs * kAllocSize - kSampleBytes);
+  ASSERT_LE(sampledBytes, kNumAllocs * kAllocSize + kSampleBytes);
+
+  const auto dump = root->dumpProfile();
+  ASSERT_EQ(dump.rfind("heap profile: ", 0), 0) << dump;
+  ASSERT_NE(dump.find("MAPPED_LIBRARIES:"), std::string::npos);
+
+  MemoryPool::Profile unprofiled;
+  unprofiledRoot->collectProfile(unprofiled);
+  ASSERT_TRUE(unprofiled.empty());
+}
+
 TEST_P(MemoryPoolTest, maybeReserveFailWithAbort) {
   constexpr int64_t kMaxSize = 1 * GB; // 1GB
   setupMemory({.capacity = kMaxSize, .arbitratorKind = "SHARED"});
@@ -519,6 +519,64 @@ TEST_F(MockSharedArbitrationTest, constructor) {
   verifyArbitratorStats(stats, kMemoryCapacity, kMemoryCapacity);
 }
 
+TEST_F(MockSharedArbitrationTest, costBasedVictimPolicy) {
+  auto makeCandidate = [](bool reclaimable,
+                          uint64_t reclaimableBytes,
+                          int32_t priority,
+                          uint64_t elapsedTimeMs,
+                          uint64_t spillBytes,
+                          uint64_t noSpillBytes) {
+    SharedArbitrator::Candidate candidate;
+    candidate.reclaimable = reclaimable;
+    candidate.reclaimableBytes = reclaimableBytes;
+    candidate.pool = nullptr;
+    candidate.reclaimCost.priority = priority;
+    candidate.reclaimCost.elapsedTimeMs = elapsedTimeMs;
+    candidate.reclaimCost.spillBytes = spillBytes;
+    candidate.reclaimCost.noSpillBytes = noSpillBytes;
+    return candidate;
+  };
+  SharedArbitrator::CostBasedVictimPolicy policy;
+  ASSERT_EQ(policy.name(), "COST_BASED");
+  // Reclaimable without spilling scores the full bytes.
+  ASSERT_DOUBLE_EQ(
+      policy.score(makeCandidate(true, 100 * MB, 0, 0, 0, 100 * MB)),
+      100 * MB);
+  // Spilling all of it halves the score, as does running for a minute.
+  ASSERT_DOUBLE_EQ(
+      policy.score(makeCandidate(true, 100 * MB, 0, 0, 100 * MB, 0)), 50 * MB);
+  ASSERT_DOUBLE_EQ(
+      policy.score(makeCandidate(true, 100 * MB, 0, 60'000, 0, 0)), 50 * MB);
+  ASSERT_EQ(policy.score(makeCandidate(false, 100 * MB, 0, 0, 0, 0)), 0);
+
+  std::vector<SharedArbitrator::Candidate> candidates{
+      makeCandidate(false, 0, 0, 0, 0, 0),
+      // Nearly finished query.
+      makeCandidate(true, 100 * MB, 0, 600'000, 100 * MB, 0),
+      // High priority query.
+      makeCandidate(true, 200 * MB, 1, 0, 0, 200 * MB),
+      // Cheap to reclaim.
+      makeCandidate(true, 60 * MB, 0, 0, 0, 60 * MB),
+      // Expensive to spill.
+      makeCandidate(true, 80 * MB, 0, 0, 160 * MB, 0)};
+  policy.sort(candidates);
+  std::vector<uint64_t> order;
+  for (const auto& candidate : candidates) {
+    order.push_back(candidate.reclaimableBytes);
+  }
+  ASSERT_EQ(
+      order,
+      std::vector<uint64_t>({60 * MB, 80 * MB, 100 * MB, 200 * MB, 0}));
+
+  // The default policy orders by reclaimable bytes.
+  SharedArbitrator::ReclaimableBytesVictimPolicy().sort(candidates);
+  ASSERT_EQ(candidates[0].reclaimableBytes, 200 * MB);
+  ASSERT_FALSE(candidates.back().reclaimable);
+
+  arbitrator_->setVictimPolicy(
+      std::make_shared<SharedArbitrator::CostBasedVictimPolicy>());
+}
+
 TEST_F(MockSharedArbitrationTest, arbitrationStateCheck) {
   const int memCapacity = 256 * MB;
   const int minPoolCapacity = 32 * MB;
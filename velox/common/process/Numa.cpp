@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/Numa.h"
+
+#include <fmt/format.h>
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/InitThreadFactory.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace facebook::velox::process {
+
+namespace {
+constexpr const char* kNodeDirectory = "/sys/devices/system/node";
+
+#ifdef __linux__
+// Memory policy of mbind(2) from <numaif.h>. Defined here to not depend on
+// libnuma.
+constexpr int kMpolPreferred = 1;
+#endif
+} // namespace
+
+std::vector<int32_t> parseCpuList(std::string_view list) {
+  std::vector<int32_t> result;
+  std::vector<folly::StringPiece> ranges;
+  folly::split(',', folly::trimWhitespace(list), ranges, true);
+  for (auto range : ranges) {
+    auto dash = range.find('-');
+    auto first = folly::tryTo<int32_t>(range.subpiece(0, dash));
+    auto last = dash == folly::StringPiece::npos
+        ? first
+        : folly::tryTo<int32_t>(range.subpiece(dash + 1));
+    if (!first.hasValue() || !last.hasValue() || first.value() < 0 ||
+        last.value() < first.value()) {
+      return {};
+    }
+    for (auto cpu = first.value(); cpu <= last.value(); ++cpu) {
+      result.push_back(cpu);
+    }
+  }
+  return result;
+}
+
+int32_t numaNodeCount() {
+  static const int32_t count = []() {
+    std::string online;
+    if (!folly::readFile(
+            fmt::format("{}/online", kNodeDirectory).c_str(), online)) {
+      return 1;
+    }
+    auto nodes = parseCpuList(online);
+    return nodes.empty() ? 1 : nodes.back() + 1;
+  }();
+  return count;
+}
+
+int32_t currentNumaNode() {
+#if defined(__linux__) && defined(SYS_getcpu)
+  unsigned cpu;
+  unsigned node;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return node;
+  }
+#endif
+  return 0;
+}
+
+std::vector<int32_t> numaNodeCpus(int32_t node) {
+  std::string cpus;
+  if (!folly::readFile(
+          fmt::format("{}/node{}/cpulist", kNodeDirectory, node).c_str(),
+          cpus)) {
+    return {};
+  }
+  return parseCpuList(cpus);
+}
+
+bool bindThreadToNumaNode(int32_t node) {
+#ifdef __linux__
+  const auto cpus = numaNodeCpus(node);
+  if (cpus.empty()) {
+    return false;
+  }
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (auto cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpuSet);
+    }
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+  return false;
+#endif
+}
+
+bool preferNumaNode(void* address, size_t size, int32_t node) {
+#if defined(__linux__) && defined(SYS_mbind)
+  constexpr int32_t kBitsPerWord = 8 * sizeof(unsigned long);
+  std::vector<unsigned long> nodeMask(node / kBitsPerWord + 1);
+  nodeMask[node / kBitsPerWord] = 1UL << (node % kBitsPerWord);
+  return syscall(
+             SYS_mbind,
+             address,
+             size,
+             kMpolPreferred,
+             nodeMask.data(),
+             nodeMask.size() * kBitsPerWord,
+             0) == 0;
+#else
+  return false;
+#endif
+}
+
+std::shared_ptr<folly::CPUThreadPoolExecutor> makeNumaNodeExecutor(
+    int32_t node,
+    size_t numThreads,
+    const std::string& threadNamePrefix) {
+  return std::make_shared<folly::CPUThreadPoolExecutor>(
+      numThreads,
+      std::make_shared<folly::InitThreadFactory>(
+          std::make_shared<folly::NamedThreadFactory>(threadNamePrefix),
+          [node]() { bindThreadToNumaNode(node); }));
+}
+
+} // namespace facebook::velox::process
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace folly {
+class CPUThreadPoolExecutor;
+}
+
+namespace facebook::velox::process {
+
+// Returns the number of NUMA nodes of the machine. Returns 1 if this is not
+// known, e.g. on non-Linux systems.
+int32_t numaNodeCount();
+
+// Returns the NUMA node of the CPU the calling thread runs on. Returns 0 if
+// this is not known.
+int32_t currentNumaNode();
+
+// Returns the CPUs of NUMA node 'node'. Returns an empty vector if this is not
+// known.
+std::vector<int32_t> numaNodeCpus(int32_t node);
+
+// Parses a CPU or node list in the format of /sys/devices/system, e.g.
+// "0-3,8-11". Returns an empty vector if 'list' is malformed.
+std::vector<int32_t> parseCpuList(std::string_view list);
+
+// Restricts the calling thread to the CPUs of NUMA node 'node'. Returns false
+// if this is not supported.
+bool bindThreadToNumaNode(int32_t node);
+
+// Makes NUMA node 'node' the preferred node for the memory that later faults
+// in the 'size' bytes starting at 'address'. Returns false if this is not
+// supported.
+bool preferNumaNode(void* address, size_t size, int32_t node);
+
+// Returns an executor with 'numThreads' threads that run on the CPUs of NUMA
+// node 'node'. Used as the executor of a QueryCtx, this keeps the Drivers of
+// its Tasks and the memory they allocate from a NUMA aware MmapAllocator on
+// one node.
+std::shared_ptr<folly::CPUThreadPoolExecutor> makeNumaNodeExecutor(
+    int32_t node,
+    size_t numThreads,
+    const std::string& threadNamePrefix);
+
+} // namespace facebook::velox::process
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#include <fmt/format.h>
+#include <array>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace facebook::velox::process {
+
+std::string PerfCounters::toString() const {
+  return fmt::format(
+      "cycles: {}, instructions: {}, IPC: {:.2f}, LLC misses: {}, "
+      "dTLB misses: {}",
+      cycles,
+      instructions,
+      ipc(),
+      llcMisses,
+      dtlbMisses);
+}
+
+#ifdef __linux__
+namespace {
+
+constexpr int32_t kNumCounters = 4;
+
+// The counting group of one thread. The first event that opens is the group
+// leader, so that all counters are read with one read(2).
+class ThreadCounterGroup {
+ public:
+  ThreadCounterGroup() {
+    const std::array<std::pair<uint32_t, uint64_t>, kNumCounters> events = {{
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HW_CACHE,
+         PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    }};
+    for (auto i = 0; i < kNumCounters; ++i) {
+      perf_event_attr attr{};
+      attr.size = sizeof(attr);
+      attr.type = events[i].first;
+      attr.config = events[i].second;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP;
+      const auto fd = syscall(
+          SYS_perf_event_open, &attr, 0, -1, leaderFd_ < 0 ? -1 : leaderFd_, 0);
+      if (fd < 0) {
+        continue;
+      }
+      if (leaderFd_ < 0) {
+        leaderFd_ = fd;
+      }
+      fds_[numOpen_] = fd;
+      counterIndex_[numOpen_++] = i;
+    }
+  }
+
+  ~ThreadCounterGroup() {
+    for (auto i = 0; i < numOpen_; ++i) {
+      close(fds_[i]);
+    }
+  }
+
+  bool read(PerfCounters& counters) {
+    if (leaderFd_ < 0) {
+      return false;
+    }
+    // 'nr' followed by one value for each counter in the group.
+    std::array<uint64_t, kNumCounters + 1> data;
+    const auto size = (numOpen_ + 1) * sizeof(uint64_t);
+    if (::read(leaderFd_, data.data(), size) != static_cast<ssize_t>(size)) {
+      return false;
+    }
+    std::array<uint64_t, kNumCounters> values{};
+    for (auto i = 0; i < numOpen_; ++i) {
+      values[counterIndex_[i]] = data[i + 1];
+    }
+    counters = {values[0], values[1], values[2], values[3]};
+    return true;
+  }
+
+ private:
+  int leaderFd_{-1};
+  int32_t numOpen_{0};
+  std::array<int, kNumCounters> fds_;
+  // Index in PerfCounters of each open counter.
+  std::array<int32_t, kNumCounters> counterIndex_;
+};
+
+} // namespace
+
+bool readThreadPerfCounters(PerfCounters& counters) {
+  thread_local ThreadCounterGroup group;
+  return group.read(counters);
+}
+#else
+bool readThreadPerfCounters(PerfCounters& /*counters*/) {
+  return false;
+}
+#endif
+
+} // namespace facebook::velox::process
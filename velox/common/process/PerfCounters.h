@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace facebook::velox::process {
+
+/// Hardware performance counters of the calling thread, as counted by
+/// perf_event_open(2) in user mode. Counters that the CPU or the kernel do not
+/// support stay 0.
+struct PerfCounters {
+  uint64_t cycles{0};
+  uint64_t instructions{0};
+  uint64_t llcMisses{0};
+  uint64_t dtlbMisses{0};
+
+  void add(const PerfCounters& other) {
+    cycles += other.cycles;
+    instructions += other.instructions;
+    llcMisses += other.llcMisses;
+    dtlbMisses += other.dtlbMisses;
+  }
+
+  /// Returns the counts since 'start', which was read earlier on the same
+  /// thread.
+  PerfCounters since(const PerfCounters& start) const {
+    return {
+        cycles - start.cycles,
+        instructions - start.instructions,
+        llcMisses - start.llcMisses,
+        dtlbMisses - start.dtlbMisses};
+  }
+
+  void clear() {
+    *this = PerfCounters();
+  }
+
+  /// Instructions per cycle or 0 if no cycles are counted.
+  double ipc() const {
+    return cycles == 0 ? 0 : static_cast<double>(instructions) / cycles;
+  }
+
+  std::string toString() const;
+};
+
+/// Reads the counters of the calling thread into 'counters'. The counters are
+/// opened on the first call on each thread. Returns false if hardware
+/// counters are not available, e.g. outside of Linux, in a container without
+/// perf_event access or if perf_event_paranoid forbids user mode counting.
+bool readThreadPerfCounters(PerfCounters& counters);
+
+} // namespace facebook::velox::process
@@ -26,12 +26,28 @@ folly::Synchronized<std::unordered_map<std::string, TraceData>>& traceMap() {
       staticTraceMap;
   return staticTraceMap;
 }
+
+thread_local TraceListener* traceListener{nullptr};
 } // namespace
 
+TraceListener* threadTraceListener() {
+  return traceListener;
+}
+
+ScopedTraceListener::ScopedTraceListener(TraceListener* listener)
+    : savedListener_(traceListener) {
+  traceListener = listener;
+}
+
+ScopedTraceListener::~ScopedTraceListener() {
+  traceListener = savedListener_;
+}
+
 TraceContext::TraceContext(std::string label, bool isTemporary)
     : label_(std::move(label)),
       enterTime_(std::chrono::steady_clock::now()),
-      isTemporary_(isTemporary) {
+      isTemporary_(isTemporary),
+      listener_(traceListener) {
   traceMap().withWLock([&](auto& counts) {
     auto& data = counts[label_];
     ++data.numThreads;
@@ -43,11 +59,15 @@ TraceContext::TraceContext(std::string label, bool isTemporary)
 }
 
 TraceContext::~TraceContext() {
+  const auto now = std::chrono::steady_clock::now();
+  if (listener_ != nullptr) {
+    listener_->onTrace(label_, enterTime_, now);
+  }
   traceMap().withWLock([&](auto& counts) {
     auto& data = counts[label_];
     --data.numThreads;
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                  std::chrono::steady_clock::now() - enterTime_)
+                  now - enterTime_)
                   .count();
     data.totalMs += ms;
     data.maxMs = std::max<uint64_t>(data.maxMs, ms);
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -41,6 +42,35 @@ struct TraceData {
   std::chrono::steady_clock::time_point startTime;
 };
 
+// Receives the sections traced on the threads it is installed on, e.g. to
+// build a timeline of a query.
+class TraceListener {
+ public:
+  virtual ~TraceListener() = default;
+
+  // Called when a thread leaves the section 'label' that it entered at
+  // 'start'.
+  virtual void onTrace(
+      const std::string& label,
+      std::chrono::steady_clock::time_point start,
+      std::chrono::steady_clock::time_point end) = 0;
+};
+
+// Returns the listener of the calling thread or nullptr if none is set.
+TraceListener* threadTraceListener();
+
+// Sets the listener of the calling thread for the lifetime of 'this' and then
+// restores the previous one.
+class ScopedTraceListener {
+ public:
+  explicit ScopedTraceListener(TraceListener* listener);
+
+  ~ScopedTraceListener();
+
+ private:
+  TraceListener* const savedListener_;
+};
+
 // Records that a thread has entered a section described by a
 // label. Possible labels are operations like 'opening a file'
 // waiting for read from file, processing file xx and so on. This
@@ -69,6 +99,8 @@ class TraceContext {
   const std::string label_;
   const std::chrono::steady_clock::time_point enterTime_;
   const bool isTemporary_;
+  // The listener of the thread at construction.
+  TraceListener* const listener_;
 };
 
 } // namespace facebook::velox::process
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/Numa.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::process;
+
+TEST(NumaTest, parseCpuList) {
+  EXPECT_EQ(parseCpuList("0"), std::vector<int32_t>({0}));
+  EXPECT_EQ(
+      parseCpuList("0-3,8-9\n"), std::vector<int32_t>({0, 1, 2, 3, 8, 9}));
+  EXPECT_EQ(parseCpuList("2,4-5"), std::vector<int32_t>({2, 4, 5}));
+  EXPECT_TRUE(parseCpuList("").empty());
+  EXPECT_TRUE(parseCpuList("3-1").empty());
+  EXPECT_TRUE(parseCpuList("a-b").empty());
+}
+
+TEST(NumaTest, currentNode) {
+  ASSERT_GE(numaNodeCount(), 1);
+  ASSERT_GE(currentNumaNode(), 0);
+}
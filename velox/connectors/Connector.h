@@ -59,6 +59,11 @@ class ColumnHandle : public ISerializable {
  public:
   virtual ~ColumnHandle() = default;
 
+  /// Returns the name of the column in the table.
+  virtual const std::string& name() const {
+    VELOX_NYI();
+  }
+
   folly::dynamic serialize() const override;
 
  protected:
@@ -82,6 +87,16 @@ class ConnectorTableHandle : public ISerializable {
     return connectorId_;
   }
 
+  /// Returns the table columns the output of a table scan driver is clustered
+  /// on, e.g. the bucketing and sorting columns of a bucketed table with sorted
+  /// buckets when each driver reads whole buckets. Rows with equal values in
+  /// any prefix of these columns are adjacent in the output. Empty if the
+  /// output has no known clustering.
+  virtual const std::vector<std::string>& clusteringKeys() const {
+    static const std::vector<std::string> kEmpty;
+    return kEmpty;
+  }
+
   virtual folly::dynamic serialize() const override;
 
  protected:
@@ -106,6 +121,14 @@ class ConnectorInsertTableHandle : public ISerializable {
     return false;
   }
 
+  // Whether multi-threaded write requires the input to be partitioned among
+  // the writers, e.g. each bucket of a bucketed table must be written by a
+  // single writer. Planner runs one writer if the plan has no partitioning
+  // scheme.
+  virtual bool requiresPartitioningScheme() const {
+    return false;
+  }
+
   folly::dynamic serialize() const override {
     VELOX_NYI();
   }
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/connectors/hive/FilterOrderCache.h"
+
+namespace facebook::velox::connector::hive {
+
+std::shared_ptr<const FilterOrderCache::Entry> FilterOrderCache::find(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entryMap_.find(key);
+  if (it == entryMap_.end()) {
+    ++numMisses_;
+    return nullptr;
+  }
+  ++numHits_;
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->second;
+}
+
+void FilterOrderCache::add(const std::string& key, const Entry& delta) {
+  if (delta.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  // Entries are immutable since readers may hold them. Replace the entry with
+  // a copy that has 'delta' added.
+  auto entry = std::make_shared<Entry>();
+  auto it = entryMap_.find(key);
+  if (it != entryMap_.end()) {
+    *entry = *it->second->second;
+    entries_.erase(it->second);
+  }
+  for (const auto& [name, selectivity] : delta) {
+    (*entry)[name].add(selectivity);
+  }
+  entries_.emplace_front(key, std::move(entry));
+  entryMap_[key] = entries_.begin();
+  while (entries_.size() > maxEntries_) {
+    entryMap_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+}
+
+FilterOrderCache::Stats FilterOrderCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  Stats stats;
+  stats.numHits = numHits_;
+  stats.numMisses = numMisses_;
+  stats.numEntries = entries_.size();
+  return stats;
+}
+
+void FilterOrderCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entryMap_.clear();
+  entries_.clear();
+}
+
+} // namespace facebook::velox::connector::hive
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include <list>
+#include <mutex>
+
+#include "velox/common/base/SelectivityInfo.h"
+
+namespace facebook::velox::connector::hive {
+
+/// Worker level history of the cost and selectivity of the pushed down filters
+/// of table scans. The ScanSpec of a scan orders its filters by the time they
+/// take to drop a row. Without history, each data source measures this again
+/// from scratch. With the cache, a data source starts from the measurements of
+/// the earlier scans of the same table with the same filters and adds its own
+/// measurements at the end of each split.
+///
+/// The key identifies the table and the filtered columns with their filters,
+/// see HiveDataSource. The least recently used keys are dropped so that the
+/// cache stays within 'maxEntries'.
+class FilterOrderCache {
+ public:
+  /// The accumulated selectivity of each filtered top level column, keyed on
+  /// the column name.
+  using Entry = folly::F14FastMap<std::string, SelectivityInfo>;
+
+  struct Stats {
+    uint64_t numHits{0};
+    uint64_t numMisses{0};
+    uint64_t numEntries{0};
+  };
+
+  explicit FilterOrderCache(uint32_t maxEntries) : maxEntries_(maxEntries) {}
+
+  /// Returns the history for 'key' or nullptr if there is none.
+  std::shared_ptr<const Entry> find(const std::string& key);
+
+  /// Adds the rows and time in 'delta' to the history for 'key'.
+  void add(const std::string& key, const Entry& delta);
+
+  Stats stats() const;
+
+  /// Drops all entries.
+  void clear();
+
+ private:
+  using EntryList =
+      std::list<std::pair<std::string, std::shared_ptr<const Entry>>>;
+
+  const uint32_t maxEntries_;
+
+  mutable std::mutex mutex_;
+  // Entries in order of last use, the most recently used first.
+  EntryList entries_;
+  folly::F14FastMap<std::string, EntryList::iterator> entryMap_;
+  uint64_t numHits_{0};
+  uint64_t numMisses_{0};
+};
+
+} // namespace facebook::velox::connector::hive
@@ -67,6 +67,11 @@ uint32_t HiveConfig::maxPartitionsPerWriters(const Config* config) {
   return config->get<uint32_t>(kMaxPartitionsPerWriters, 100);
 }
 
+// static
+uint32_t HiveConfig::maxOpenFileWriters(const Config* config) {
+  return config->get<uint32_t>(kMaxOpenFileWriters, 0);
+}
+
 // static
 bool HiveConfig::immutablePartitions(const Config* config) {
   return config->get<bool>(kImmutablePartitions, false);
@@ -126,6 +131,51 @@ std::string HiveConfig::s3IAMRoleSessionName(const Config* config) {
   return config->get(kS3IamRoleSessionName, std::string("velox-session"));
 }
 
+// static
+int32_t HiveConfig::s3MaxConnections(const Config* config) {
+  return config->get<int32_t>(kS3MaxConnections, 25);
+}
+
+// static
+int32_t HiveConfig::s3ReadThreads(const Config* config) {
+  return config->get<int32_t>(kS3ReadThreads, 0);
+}
+
+// static
+uint64_t HiveConfig::s3ReadChunkSize(const Config* config) {
+  return config->get<uint64_t>(kS3ReadChunkSize, 8 << 20);
+}
+
+// static
+int32_t HiveConfig::s3UploadThreads(const Config* config) {
+  return config->get<int32_t>(kS3UploadThreads, 0);
+}
+
+// static
+int32_t HiveConfig::s3MaxUploadsInFlight(const Config* config) {
+  return config->get<int32_t>(kS3MaxUploadsInFlight, 4);
+}
+
+// static
+bool HiveConfig::isHdfsShortCircuitRead(const Config* config) {
+  return config->get<bool>(kHdfsShortCircuitRead, false);
+}
+
+// static
+std::string HiveConfig::hdfsDomainSocketPath(const Config* config) {
+  return config->get<std::string>(kHdfsDomainSocketPath, std::string(""));
+}
+
+// static
+int32_t HiveConfig::hdfsHedgedReadThreads(const Config* config) {
+  return config->get<int32_t>(kHdfsHedgedReadThreads, 0);
+}
+
+// static
+int32_t HiveConfig::hdfsHedgedReadThresholdMs(const Config* config) {
+  return config->get<int32_t>(kHdfsHedgedReadThresholdMs, 500);
+}
+
 // static
 std::string HiveConfig::gcsEndpoint(const Config* config) {
   return config->get<std::string>(kGCSEndpoint, std::string(""));
@@ -141,6 +191,31 @@ std::string HiveConfig::gcsCredentials(const Config* config) {
   return config->get<std::string>(kGCSCredentials, std::string(""));
 }
 
+// static
+int32_t HiveConfig::gcsMaxConnections(const Config* config) {
+  return config->get<int32_t>(kGCSMaxConnections, 25);
+}
+
+// static
+int32_t HiveConfig::gcsReadThreads(const Config* config) {
+  return config->get<int32_t>(kGCSReadThreads, 0);
+}
+
+// static
+uint64_t HiveConfig::gcsReadChunkSize(const Config* config) {
+  return config->get<uint64_t>(kGCSReadChunkSize, 8 << 20);
+}
+
+// static
+int32_t HiveConfig::gcsUploadThreads(const Config* config) {
+  return config->get<int32_t>(kGCSUploadThreads, 0);
+}
+
+// static
+int32_t HiveConfig::gcsMaxUploadsInFlight(const Config* config) {
+  return config->get<int32_t>(kGCSMaxUploadsInFlight, 4);
+}
+
 // static.
 bool HiveConfig::isOrcUseColumnNames(const Config* config) {
   return config->get<bool>(kOrcUseColumnNames, false);
@@ -161,11 +236,31 @@ int32_t HiveConfig::maxCoalescedDistanceBytes(const Config* config) {
   return config->get<int32_t>(kMaxCoalescedDistanceBytes, 512 << 10);
 }
 
+// static.
+bool HiveConfig::isAdaptiveCoalescingEnabled(const Config* config) {
+  return config->get<bool>(kAdaptiveCoalescingEnabled, false);
+}
+
 // static.
 int32_t HiveConfig::numCacheFileHandles(const Config* config) {
   return config->get<int32_t>(kNumCacheFileHandles, 20'000);
 }
 
+// static.
+uint64_t HiveConfig::scanResultCacheBytes(const Config* config) {
+  return config->get<uint64_t>(kScanResultCacheBytes, 0);
+}
+
+// static.
+bool HiveConfig::isScanResultCacheEnabled(const Config* config) {
+  return config->get<bool>(kScanResultCacheEnabled, false);
+}
+
+// static.
+uint32_t HiveConfig::filterOrderCacheEntries(const Config* config) {
+  return config->get<uint32_t>(kFilterOrderCacheEntries, 0);
+}
+
 uint64_t HiveConfig::fileWriterFlushThresholdBytes(const Config* config) {
   return config->get<int32_t>(kFileWriterFlushThresholdBytes, 96L << 20);
 }
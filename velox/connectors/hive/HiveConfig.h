@@ -44,6 +44,11 @@ class HiveConfig {
   static constexpr const char* kMaxPartitionsPerWriters =
       "max_partitions_per_writers";
 
+  /// Maximum number of open file writers of a non-bucketed partitioned table
+  /// writer. Once reached, the least recently used writer is closed and its
+  /// partition continues in a new file. 0 keeps all the writers open.
+  static constexpr const char* kMaxOpenFileWriters = "max_open_file_writers";
+
   /// Whether new data can be inserted into an unpartition table.
   /// Velox currently does not support appending data to existing partitions.
   static constexpr const char* kImmutablePartitions =
@@ -81,6 +86,46 @@ class HiveConfig {
   static constexpr const char* kS3IamRoleSessionName =
       "hive.s3.iam-role-session-name";
 
+  /// Maximum number of concurrent HTTP connections of the S3 client.
+  static constexpr const char* kS3MaxConnections = "hive.s3.max-connections";
+
+  /// Number of threads that issue ranged GETs of large S3 reads in parallel.
+  /// 0 reads each range with a single GET on the calling thread.
+  static constexpr const char* kS3ReadThreads = "hive.s3.read-threads";
+
+  /// Size of the ranged GETs that a large S3 read is split into if
+  /// kS3ReadThreads is set.
+  static constexpr const char* kS3ReadChunkSize = "hive.s3.read-chunk-size";
+
+  /// Number of threads that upload the parts of S3 files in the background.
+  /// 0 uploads the parts on the writing thread.
+  static constexpr const char* kS3UploadThreads = "hive.s3.upload-threads";
+
+  /// Maximum number of parts of an S3 file that are uploaded in the background
+  /// at a time if kS3UploadThreads is set.
+  static constexpr const char* kS3MaxUploadsInFlight =
+      "hive.s3.max-uploads-in-flight";
+
+  /// Reads blocks on the local datanode directly from the local file system
+  /// through the domain socket in kHdfsDomainSocketPath.
+  static constexpr const char* kHdfsShortCircuitRead =
+      "hive.hdfs.short-circuit-read";
+
+  /// Path of the domain socket that the local datanode shares the file
+  /// descriptors of short-circuit reads on.
+  static constexpr const char* kHdfsDomainSocketPath =
+      "hive.hdfs.domain-socket-path";
+
+  /// Number of threads that make the hedged HDFS reads. 0 disables hedged
+  /// reads.
+  static constexpr const char* kHdfsHedgedReadThreads =
+      "hive.hdfs.hedged-read-threads";
+
+  /// Time after which a HDFS read that is not done is issued a second time if
+  /// kHdfsHedgedReadThreads is set.
+  static constexpr const char* kHdfsHedgedReadThresholdMs =
+      "hive.hdfs.hedged-read-threshold-ms";
+
   /// The GCS storage endpoint server.
   static constexpr const char* kGCSEndpoint = "hive.gcs.endpoint";
 
@@ -90,6 +135,26 @@ class HiveConfig {
   /// The GCS service account configuration as json string
   static constexpr const char* kGCSCredentials = "hive.gcs.credentials";
 
+  /// Maximum number of connections that the GCS client keeps open.
+  static constexpr const char* kGCSMaxConnections = "hive.gcs.max-connections";
+
+  /// Number of threads that issue range requests of large GCS reads in
+  /// parallel. 0 reads each range with one request on the calling thread.
+  static constexpr const char* kGCSReadThreads = "hive.gcs.read-threads";
+
+  /// Size of the range requests that a large GCS read is split into if
+  /// kGCSReadThreads is set.
+  static constexpr const char* kGCSReadChunkSize = "hive.gcs.read-chunk-size";
+
+  /// Number of threads that upload the parts of GCS files in the background.
+  /// 0 streams the file from the writing thread.
+  static constexpr const char* kGCSUploadThreads = "hive.gcs.upload-threads";
+
+  /// Maximum number of parts of a GCS file that are uploaded in the
+  /// background at a time if kGCSUploadThreads is set.
+  static constexpr const char* kGCSMaxUploadsInFlight =
+      "hive.gcs.max-uploads-in-flight";
+
   /// Maps table field names to file field names using names, not indices.
   static constexpr const char* kOrcUseColumnNames = "hive.orc.use-column-names";
 
@@ -104,9 +169,31 @@ class HiveConfig {
   static constexpr const char* kMaxCoalescedDistanceBytes =
       "max-coalesced-distance-bytes";
 
+  /// Derive the coalesce distance and bytes from the measured latency and
+  /// throughput of the storage. The two settings above are then upper bounds
+  /// that apply until enough reads have been measured.
+  static constexpr const char* kAdaptiveCoalescingEnabled =
+      "adaptive-coalescing-enabled";
+
   /// Maximum number of entries in the file handle cache.
   static constexpr const char* kNumCacheFileHandles = "num_cached_file_handles";
 
+  /// Capacity of the worker level cache of decoded and filtered scan results.
+  /// 0 disables the cache. See ScanResultCache.
+  static constexpr const char* kScanResultCacheBytes =
+      "scan-result-cache-bytes";
+
+  /// Whether a query reads and fills the scan result cache. The files the
+  /// query scans must not change while cached.
+  static constexpr const char* kScanResultCacheEnabled =
+      "scan-result-cache-enabled";
+
+  /// Maximum number of scans, keyed on the table and the pushed down filters,
+  /// whose filter cost and selectivity the worker remembers for ordering the
+  /// filters of later scans. 0 disables the history. See FilterOrderCache.
+  static constexpr const char* kFilterOrderCacheEntries =
+      "filter-order-cache-entries";
+
   /// The memory arbitrator might flush a file write to reclaim used memory if
   /// its buffered data size is no less than this minimum threshold. The
   /// buffered data size is measured by a file writer's memory footprint.
@@ -129,6 +216,8 @@ class HiveConfig {
 
   static uint32_t maxPartitionsPerWriters(const Config* config);
 
+  static uint32_t maxOpenFileWriters(const Config* config);
+
   static bool immutablePartitions(const Config* config);
 
   static bool s3UseVirtualAddressing(const Config* config);
@@ -149,12 +238,40 @@ class HiveConfig {
 
   static std::string s3IAMRoleSessionName(const Config* config);
 
+  static int32_t s3MaxConnections(const Config* config);
+
+  static int32_t s3ReadThreads(const Config* config);
+
+  static uint64_t s3ReadChunkSize(const Config* config);
+
+  static int32_t s3UploadThreads(const Config* config);
+
+  static int32_t s3MaxUploadsInFlight(const Config* config);
+
+  static bool isHdfsShortCircuitRead(const Config* config);
+
+  static std::string hdfsDomainSocketPath(const Config* config);
+
+  static int32_t hdfsHedgedReadThreads(const Config* config);
+
+  static int32_t hdfsHedgedReadThresholdMs(const Config* config);
+
   static std::string gcsEndpoint(const Config* config);
 
   static std::string gcsScheme(const Config* config);
 
   static std::string gcsCredentials(const Config* config);
 
+  static int32_t gcsMaxConnections(const Config* config);
+
+  static int32_t gcsReadThreads(const Config* config);
+
+  static uint64_t gcsReadChunkSize(const Config* config);
+
+  static int32_t gcsUploadThreads(const Config* config);
+
+  static int32_t gcsMaxUploadsInFlight(const Config* config);
+
   static bool isOrcUseColumnNames(const Config* config);
 
   static bool isFileColumnNamesReadAsLowerCase(const Config* config);
@@ -163,8 +280,16 @@ class HiveConfig {
 
   static int32_t maxCoalescedDistanceBytes(const Config* config);
 
+  static bool isAdaptiveCoalescingEnabled(const Config* config);
+
   static int32_t numCacheFileHandles(const Config* config);
 
+  static uint64_t scanResultCacheBytes(const Config* config);
+
+  static bool isScanResultCacheEnabled(const Config* config);
+
+  static uint32_t filterOrderCacheEntries(const Config* config);
+
   static uint64_t fileWriterFlushThresholdBytes(const Config* config);
 
   static uint64_t getOrcWriterMaxStripeSize(
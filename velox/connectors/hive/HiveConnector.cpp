@@ -63,6 +63,16 @@ HiveConnector::HiveConnector(
               numCachedFileHandles(properties.get())),
           std::make_unique<FileHandleGenerator>(properties)),
       executor_(executor) {
+  if (properties != nullptr &&
+      HiveConfig::scanResultCacheBytes(properties.get()) > 0) {
+    scanResultCache_ = std::make_unique<ScanResultCache>(
+        HiveConfig::scanResultCacheBytes(properties.get()));
+  }
+  if (properties != nullptr &&
+      HiveConfig::filterOrderCacheEntries(properties.get()) > 0) {
+    filterOrderCache_ = std::make_unique<FilterOrderCache>(
+        HiveConfig::filterOrderCacheEntries(properties.get()));
+  }
   LOG(INFO) << "Hive connector " << connectorId() << " created with maximum of "
             << numCachedFileHandles(properties.get())
             << " cached file handles.";
@@ -80,6 +90,8 @@ std::unique_ptr<DataSource> HiveConnector::createDataSource(
       HiveConfig::maxCoalescedBytes(connectorQueryCtx->config()));
   options.setMaxCoalesceDistance(
       HiveConfig::maxCoalescedDistanceBytes(connectorQueryCtx->config()));
+  options.setAdaptiveCoalesce(
+      HiveConfig::isAdaptiveCoalescingEnabled(connectorQueryCtx->config()));
   options.setFileColumnNamesReadAsLowerCase(
       HiveConfig::isFileColumnNamesReadAsLowerCase(
           connectorQueryCtx->config()));
@@ -95,7 +107,11 @@ std::unique_ptr<DataSource> HiveConnector::createDataSource(
       connectorQueryCtx->cache(),
       connectorQueryCtx->scanId(),
       executor_,
-      options);
+      options,
+      HiveConfig::isScanResultCacheEnabled(connectorQueryCtx->config())
+          ? scanResultCache_.get()
+          : nullptr,
+      filterOrderCache_.get());
 }
 
 std::unique_ptr<DataSink> HiveConnector::createDataSink(
@@ -132,7 +148,8 @@ std::unique_ptr<core::PartitionFunction> HivePartitionFunctionSpec::create(
       bucketToPartition_.empty() ? std::move(bucketToPartitions)
                                  : bucketToPartition_,
       channels_,
-      constValues_);
+      constValues_,
+      hashKind_);
 }
 
 void HiveConnectorFactory::initialize() {
@@ -174,7 +191,12 @@ std::string HivePartitionFunctionSpec::toString() const {
     }
   }
 
-  return fmt::format("HIVE(({}) buckets: {})", keys.str(), numBuckets_);
+  return fmt::format(
+      "{}(({}) buckets: {})",
+      hashKind_ == HivePartitionFunction::HashKind::kSparkMurmur3 ? "SPARK"
+                                                                    : "HIVE",
+      keys.str(),
+      numBuckets_);
 }
 
 folly::dynamic HivePartitionFunctionSpec::serialize() const {
@@ -189,6 +211,8 @@ folly::dynamic HivePartitionFunctionSpec::serialize() const {
     constValueExprs.emplace_back(value);
   }
   obj["constants"] = ISerializable::serialize(constValueExprs);
+  obj["sparkMurmur3"] =
+      hashKind_ == HivePartitionFunction::HashKind::kSparkMurmur3;
   return obj;
 }
 
@@ -213,7 +237,10 @@ core::PartitionFunctionSpecPtr HivePartitionFunctionSpec::deserialize(
       ISerializable::deserialize<std::vector<int>>(
           obj["bucketToPartition"], context),
       std::move(channels),
-      std::move(constValues));
+      std::move(constValues),
+      obj.getDefault("sparkMurmur3", false).asBool()
+          ? HivePartitionFunction::HashKind::kSparkMurmur3
+          : HivePartitionFunction::HashKind::kHive);
 }
 
 void registerHivePartitionFunctionSerDe() {
@@ -17,6 +17,9 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/FilterOrderCache.h"
+#include "velox/connectors/hive/HivePartitionFunction.h"
+#include "velox/connectors/hive/ScanResultCache.h"
 #include "velox/core/PlanNode.h"
 
 namespace facebook::velox::dwio::common {
@@ -69,8 +72,22 @@ class HiveConnector : public Connector {
     return fileHandleFactory_.clearCache();
   }
 
+  /// Returns the cache of scan results or nullptr if
+  /// HiveConfig::kScanResultCacheBytes is not set.
+  ScanResultCache* scanResultCache() const {
+    return scanResultCache_.get();
+  }
+
+  /// Returns the history of filter selectivity or nullptr if
+  /// HiveConfig::kFilterOrderCacheEntries is not set.
+  FilterOrderCache* filterOrderCache() const {
+    return filterOrderCache_.get();
+  }
+
  protected:
   FileHandleFactory fileHandleFactory_;
+  std::unique_ptr<ScanResultCache> scanResultCache_;
+  std::unique_ptr<FilterOrderCache> filterOrderCache_;
   folly::Executor* FOLLY_NULLABLE executor_;
 };
 
@@ -109,11 +126,14 @@ class HivePartitionFunctionSpec : public core::PartitionFunctionSpec {
       int numBuckets,
       std::vector<int> bucketToPartition,
       std::vector<column_index_t> channels,
-      std::vector<VectorPtr> constValues)
+      std::vector<VectorPtr> constValues,
+      HivePartitionFunction::HashKind hashKind =
+          HivePartitionFunction::HashKind::kHive)
       : numBuckets_(numBuckets),
         bucketToPartition_(std::move(bucketToPartition)),
         channels_(std::move(channels)),
-        constValues_(std::move(constValues)) {}
+        constValues_(std::move(constValues)),
+        hashKind_(hashKind) {}
 
   /// The constructor without 'bucketToPartition' input is used in case that
   /// we don't know the actual number of partitions until we create the
@@ -126,12 +146,15 @@ class HivePartitionFunctionSpec : public core::PartitionFunctionSpec {
   HivePartitionFunctionSpec(
       int numBuckets,
       std::vector<column_index_t> channels,
-      std::vector<VectorPtr> constValues)
+      std::vector<VectorPtr> constValues,
+      HivePartitionFunction::HashKind hashKind =
+          HivePartitionFunction::HashKind::kHive)
       : HivePartitionFunctionSpec(
             numBuckets,
             {},
             std::move(channels),
-            std::move(constValues)) {}
+            std::move(constValues),
+            hashKind) {}
 
   std::unique_ptr<core::PartitionFunction> create(
       int numPartitions) const override;
@@ -149,6 +172,7 @@ class HivePartitionFunctionSpec : public core::PartitionFunctionSpec {
   const std::vector<int> bucketToPartition_;
   const std::vector<column_index_t> channels_;
   const std::vector<VectorPtr> constValues_;
+  const HivePartitionFunction::HashKind hashKind_;
 };
 
 void registerHivePartitionFunctionSerDe();
@@ -23,6 +23,11 @@
 namespace facebook::velox::connector::hive {
 
 struct HiveConnectorSplit : public connector::ConnectorSplit {
+  /// Key of 'customSplitInfo' for the modification time or etag of the file.
+  /// Together with the path and the size, identifies the version of the file
+  /// in dwio::common::FileMetadataCache.
+  static constexpr const char* kFileVersion = "$file_version";
+
   const std::string filePath;
   dwio::common::FileFormat fileFormat;
   const uint64_t start;
@@ -75,4 +80,25 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
   }
 };
 
+/// Bundles the splits of many small files into one split. HiveDataSource
+/// reads the files one after the other with one reader, and reads the footers
+/// of the next files in the background while scanning the current one. This
+/// avoids the per split overhead of the TableScan for tables of many small
+/// files. The splits must have the same file format.
+struct HiveMultiFileSplit : public connector::ConnectorSplit {
+  const std::vector<std::shared_ptr<HiveConnectorSplit>> splits;
+
+  HiveMultiFileSplit(
+      const std::string& connectorId,
+      std::vector<std::shared_ptr<HiveConnectorSplit>> _splits)
+      : ConnectorSplit(connectorId), splits(std::move(_splits)) {}
+
+  std::string toString() const override {
+    return fmt::format(
+        "Hive: {} files, first {}",
+        splits.size(),
+        splits.empty() ? "none" : splits.front()->toString());
+  }
+};
+
 } // namespace facebook::velox::connector::hive
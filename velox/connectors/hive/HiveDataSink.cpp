@@ -302,6 +302,8 @@ HiveDataSink::HiveDataSink(
       connectorProperties_(connectorProperties),
       maxOpenWriters_(
           HiveConfig::maxPartitionsPerWriters(connectorQueryCtx_->config())),
+      maxOpenFileWriters_(
+          HiveConfig::maxOpenFileWriters(connectorQueryCtx_->config())),
       partitionChannels_(getPartitionChannels(insertTableHandle_)),
       partitionIdGenerator_(
           !partitionChannels_.empty() ? std::make_unique<PartitionIdGenerator>(
@@ -398,6 +400,7 @@ void HiveDataSink::appendData(RowVectorPtr input) {
 void HiveDataSink::write(size_t index, const VectorPtr& input) {
   writers_[index]->write(input);
   writerInfo_[index]->numWrittenRows += input->size();
+  writerLastWrites_[index] = ++numWrites_;
 }
 
 void HiveDataSink::computePartitionAndBucketIds(const RowVectorPtr& input) {
@@ -423,10 +426,16 @@ int32_t HiveDataSink::numWrittenFiles() const {
 }
 
 std::shared_ptr<memory::MemoryPool> HiveDataSink::createWriterPool(
-    const HiveWriterId& writerId) {
+    const HiveWriterId& writerId,
+    bool reopen) {
   auto* connectorPool = connectorQueryCtx_->connectorMemoryPool();
-  auto writerPool = connectorPool->addAggregateChild(
-      fmt::format("{}.{}", connectorPool->name(), writerId.toString()));
+  auto poolName =
+      fmt::format("{}.{}", connectorPool->name(), writerId.toString());
+  if (reopen) {
+    // The pool of the closed writer of 'writerId' still exists.
+    poolName = fmt::format("{}.{}", poolName, writers_.size());
+  }
+  auto writerPool = connectorPool->addAggregateChild(poolName);
   if (connectorPool->reclaimer() != nullptr) {
     writerPool->setReclaimer(WriterReclaimer::create(
         canReclaim(),
@@ -491,30 +500,61 @@ void HiveDataSink::closeInternal(bool abort) {
   if (!abort) {
     closed_ = true;
     for (const auto& writer : writers_) {
-      writer->close();
+      if (writer != nullptr) {
+        writer->close();
+      }
     }
   } else {
     aborted_ = true;
     for (const auto& writer : writers_) {
-      writer->abort();
+      if (writer != nullptr) {
+        writer->abort();
+      }
     }
   }
 }
 
 uint32_t HiveDataSink::ensureWriter(const HiveWriterId& id) {
   auto it = writerIndexMap_.find(id);
-  if (it != writerIndexMap_.end()) {
+  if (it != writerIndexMap_.end() && writers_[it->second] != nullptr) {
     return it->second;
   }
   return appendWriter(id);
 }
 
+void HiveDataSink::maybeCloseIdleWriter() {
+  if (!closeIdleWriters() || numOpenWriters_ < maxOpenFileWriters_) {
+    return;
+  }
+  std::optional<uint32_t> idleIndex;
+  for (uint32_t i = 0; i < writers_.size(); ++i) {
+    if (writers_[i] == nullptr || partitionSizes_[i] != 0) {
+      continue;
+    }
+    if (!idleIndex.has_value() ||
+        writerLastWrites_[i] < writerLastWrites_[idleIndex.value()]) {
+      idleIndex = i;
+    }
+  }
+  // All the open writers have rows of the current input.
+  if (!idleIndex.has_value()) {
+    return;
+  }
+  writers_[idleIndex.value()]->close();
+  writers_[idleIndex.value()].reset();
+  --numOpenWriters_;
+}
+
 uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
+  const bool reopen = writerIndexMap_.count(id) != 0;
   // Check max open writers.
-  VELOX_USER_CHECK_LE(
-      writers_.size(), maxOpenWriters_, "Exceeded open writer limit");
+  if (!reopen) {
+    VELOX_USER_CHECK_LE(
+        writerIndexMap_.size(), maxOpenWriters_, "Exceeded open writer limit");
+  }
   VELOX_CHECK_EQ(writers_.size(), writerInfo_.size());
-  VELOX_CHECK_EQ(writerIndexMap_.size(), writerInfo_.size());
+  VELOX_CHECK_LE(writerIndexMap_.size(), writerInfo_.size());
+  maybeCloseIdleWriter();
 
   std::optional<std::string> partitionName;
   if (isPartitioned()) {
@@ -527,7 +567,7 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   auto writerParameters = getWriterParameters(partitionName, id.bucketId);
   const auto writePath = fs::path(writerParameters.writeDirectory()) /
       writerParameters.writeFileName();
-  auto writerPool = createWriterPool(id);
+  auto writerPool = createWriterPool(id, reopen);
   auto sinkPool = createSinkPool(writerPool);
   std::shared_ptr<memory::MemoryPool> sortPool{nullptr};
   if (sortWrite()) {
@@ -565,12 +605,14 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
       options);
   writer = maybeCreateBucketSortWriter(std::move(writer));
   writers_.emplace_back(std::move(writer));
+  ++numOpenWriters_;
+  writerLastWrites_.emplace_back(0);
   // Extends the buffer used for partition rows calculations.
   partitionSizes_.emplace_back(0);
   partitionRows_.emplace_back(nullptr);
   rawPartitionRows_.emplace_back(nullptr);
 
-  writerIndexMap_.emplace(id, writers_.size() - 1);
+  writerIndexMap_[id] = writers_.size() - 1;
   return writerIndexMap_[id];
 }
 
@@ -591,8 +633,12 @@ HiveDataSink::maybeCreateBucketSortWriter(
       &nonReclaimableSection_,
       &numSpillRuns_,
       spillConfig_);
+  // Merges the sorted output on the spill executor while the file writer
+  // encodes the previous batch.
   return std::make_unique<dwio::common::SortingWriter>(
-      std::move(writer), std::move(sortBuffer));
+      std::move(writer),
+      std::move(sortBuffer),
+      spillConfig_ != nullptr ? spillConfig_->executor : nullptr);
 }
 
 void HiveDataSink::splitInputRowsAndEnsureWriters() {
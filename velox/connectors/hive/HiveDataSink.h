@@ -232,6 +232,12 @@ class HiveInsertTableHandle : public ConnectorInsertTableHandle {
     return true;
   }
 
+  /// The file names of a bucket are the same for all writers, so the buckets
+  /// must be spread over the writers by a local partition on the bucket.
+  bool requiresPartitioningScheme() const override {
+    return isBucketed();
+  }
+
   bool isPartitioned() const;
 
   bool isBucketed() const;
@@ -464,12 +470,22 @@ class HiveDataSink : public DataSink {
     return bucketCount_ != 0;
   }
 
+  // Returns true if idle writers are closed to bound the number of open
+  // writers. A bucket must be written to a single file, so this only applies
+  // to non-bucketed partitioned tables.
+  FOLLY_ALWAYS_INLINE bool closeIdleWriters() const {
+    return maxOpenFileWriters_ != 0 && isPartitioned() && !isBucketed();
+  }
+
   FOLLY_ALWAYS_INLINE bool isCommitRequired() const {
     return commitStrategy_ != CommitStrategy::kNoCommit;
   }
 
+  // Creates the memory pool of a writer. 'reopen' is true if 'writerId' had
+  // a writer before that was closed as idle.
   std::shared_ptr<memory::MemoryPool> createWriterPool(
-      const HiveWriterId& writerId);
+      const HiveWriterId& writerId,
+      bool reopen);
 
   // Compute the partition id and bucket id for each row in 'input'.
   void computePartitionAndBucketIds(const RowVectorPtr& input);
@@ -488,6 +504,11 @@ class HiveDataSink : public DataSink {
   // the newly created writer in 'writers_'.
   uint32_t appendWriter(const HiveWriterId& id);
 
+  // Closes the least recently written writer if 'maxOpenFileWriters_' writers
+  // are open. Writers with rows of the current input are not closed. The rows
+  // of the closed writer's partition go to a new file later.
+  void maybeCloseIdleWriter();
+
   std::unique_ptr<facebook::velox::dwio::common::Writer>
   maybeCreateBucketSortWriter(
       std::unique_ptr<facebook::velox::dwio::common::Writer> writer);
@@ -532,6 +553,7 @@ class HiveDataSink : public DataSink {
   const CommitStrategy commitStrategy_;
   const std::shared_ptr<const Config> connectorProperties_;
   const uint32_t maxOpenWriters_;
+  const uint32_t maxOpenFileWriters_;
   const std::vector<column_index_t> partitionChannels_;
   const std::unique_ptr<PartitionIdGenerator> partitionIdGenerator_;
   const int32_t bucketCount_{0};
@@ -555,7 +577,13 @@ class HiveDataSink : public DataSink {
   // Below are structures for partitions from all inputs. writerInfo_ and
   // writers_ are both indexed by partitionId.
   std::vector<std::shared_ptr<HiveWriterInfo>> writerInfo_;
+  // A writer closed as idle is nullptr.
   std::vector<std::unique_ptr<dwio::common::Writer>> writers_;
+  uint32_t numOpenWriters_{0};
+  // The sequence number of the last write per writer for closing the least
+  // recently written writer.
+  std::vector<uint64_t> writerLastWrites_;
+  uint64_t numWrites_{0};
   // IO statistics collected for each writer.
   std::vector<std::shared_ptr<io::IoStatistics>> ioStats_;
 
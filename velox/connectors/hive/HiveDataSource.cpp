@@ -16,10 +16,13 @@
 
 #include "velox/connectors/hive/HiveDataSource.h"
 
+#include <map>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 
 #include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/expression/FieldReference.h"
@@ -31,6 +34,51 @@ class HiveColumnHandle;
 
 namespace {
 
+// Evaluates the remaining filter in the file reader, right after reading the
+// columns it uses. Columns read after these are then only decoded for the
+// passing rows.
+class RemainingFilter : public common::MultiColumnFilter {
+ public:
+  RemainingFilter(
+      std::unique_ptr<exec::ExprSet> exprSet,
+      core::ExpressionEvaluator* evaluator,
+      memory::MemoryPool* pool)
+      : exprSet_(std::move(exprSet)), evaluator_(evaluator), pool_(pool) {
+    for (const auto& field : exprSet_->expr(0)->distinctFields()) {
+      inputs_.push_back(field->field());
+    }
+  }
+
+  const std::vector<std::string>& inputs() const override {
+    return inputs_;
+  }
+
+  void filter(const RowVectorPtr& input, std::vector<vector_size_t>& passed)
+      override {
+    rows_.resize(input->size());
+    evaluator_->evaluate(exprSet_.get(), rows_, *input, result_);
+    const auto numPassed =
+        exec::processFilterResults(result_, rows_, filterEvalCtx_, pool_);
+    if (numPassed == input->size()) {
+      passed.resize(numPassed);
+      std::iota(passed.begin(), passed.end(), 0);
+      return;
+    }
+    const auto* indices =
+        filterEvalCtx_.selectedIndices->as<vector_size_t>();
+    passed.assign(indices, indices + numPassed);
+  }
+
+ private:
+  const std::unique_ptr<exec::ExprSet> exprSet_;
+  core::ExpressionEvaluator* const evaluator_;
+  memory::MemoryPool* const pool_;
+  std::vector<std::string> inputs_;
+  VectorPtr result_;
+  SelectivityVector rows_;
+  exec::FilterEvalCtx filterEvalCtx_;
+};
+
 struct SubfieldSpec {
   const common::Subfield* subfield;
   bool filterOnly;
@@ -357,7 +405,9 @@ HiveDataSource::HiveDataSource(
     cache::AsyncDataCache* cache,
     const std::string& scanId,
     folly::Executor* executor,
-    const dwio::common::ReaderOptions& options)
+    const dwio::common::ReaderOptions& options,
+    ScanResultCache* resultCache,
+    FilterOrderCache* filterOrderCache)
     : fileHandleFactory_(fileHandleFactory),
       readerOpts_(options),
       pool_(&options.getMemoryPool()),
@@ -365,7 +415,9 @@ HiveDataSource::HiveDataSource(
       expressionEvaluator_(expressionEvaluator),
       cache_(cache),
       scanId_(scanId),
-      executor_(executor) {
+      executor_(executor),
+      resultCache_(resultCache),
+      filterOrderCache_(filterOrderCache) {
   // Column handled keyed on the column alias, the name used in the query.
   for (const auto& [canonicalizedName, columnHandle] : columnHandles) {
     auto handle = std::dynamic_pointer_cast<HiveColumnHandle>(columnHandle);
@@ -379,32 +431,38 @@ HiveDataSource::HiveDataSource(
     }
   }
 
+  hiveTableHandle_ = std::dynamic_pointer_cast<HiveTableHandle>(tableHandle);
+  VELOX_CHECK(
+      hiveTableHandle_ != nullptr,
+      "TableHandle must be an instance of HiveTableHandle");
+
   std::vector<std::string> readerRowNames;
-  auto readerRowTypes = outputType_->children();
+  std::vector<TypePtr> readerRowTypes;
   folly::F14FastMap<std::string, std::vector<const common::Subfield*>>
       subfields;
-  for (auto& outputName : outputType_->names()) {
-    auto it = columnHandles.find(outputName);
-    VELOX_CHECK(
-        it != columnHandles.end(),
-        "ColumnHandle is missing for output column: {}",
-        outputName);
-
-    auto* handle = static_cast<const HiveColumnHandle*>(it->second.get());
-    readerRowNames.push_back(handle->name());
-    for (auto& subfield : handle->requiredSubfields()) {
-      VELOX_USER_CHECK_EQ(
-          getColumnName(subfield),
-          handle->name(),
-          "Required subfield does not match column name");
-      subfields[handle->name()].push_back(&subfield);
+  if (!hiveTableHandle_->statsAggregates().empty()) {
+    // The output columns are aggregates, which read the aggregated columns.
+    addStatsAggregateColumns(readerRowNames, readerRowTypes);
+  } else {
+    readerRowTypes = outputType_->children();
+    for (auto& outputName : outputType_->names()) {
+      auto it = columnHandles.find(outputName);
+      VELOX_CHECK(
+          it != columnHandles.end(),
+          "ColumnHandle is missing for output column: {}",
+          outputName);
+
+      auto* handle = static_cast<const HiveColumnHandle*>(it->second.get());
+      readerRowNames.push_back(handle->name());
+      for (auto& subfield : handle->requiredSubfields()) {
+        VELOX_USER_CHECK_EQ(
+            getColumnName(subfield),
+            handle->name(),
+            "Required subfield does not match column name");
+        subfields[handle->name()].push_back(&subfield);
+      }
     }
   }
-
-  hiveTableHandle_ = std::dynamic_pointer_cast<HiveTableHandle>(tableHandle);
-  VELOX_CHECK(
-      hiveTableHandle_ != nullptr,
-      "TableHandle must be an instance of HiveTableHandle");
   if (readerOpts_.isFileColumnNamesReadAsLowerCase()) {
     checkColumnNameLowerCase(outputType_);
     checkColumnNameLowerCase(hiveTableHandle_->subfieldFilters());
@@ -422,9 +480,10 @@ HiveDataSource::HiveDataSource(
       filters);
 
   std::vector<common::Subfield> remainingFilterSubfields;
+  std::unique_ptr<exec::ExprSet> remainingFilterExprSet;
   if (remainingFilter) {
-    remainingFilterExprSet_ = expressionEvaluator_->compile(remainingFilter);
-    auto& remainingFilterExpr = remainingFilterExprSet_->expr(0);
+    remainingFilterExprSet = expressionEvaluator_->compile(remainingFilter);
+    auto& remainingFilterExpr = remainingFilterExprSet->expr(0);
     folly::F14FastSet<std::string> columnNames(
         readerRowNames.begin(), readerRowNames.end());
     for (auto& input : remainingFilterExpr->distinctFields()) {
@@ -467,10 +526,24 @@ HiveDataSource::HiveDataSource(
   if (remainingFilter) {
     metadataFilter_ = std::make_shared<common::MetadataFilter>(
         *scanSpec_, *remainingFilter, expressionEvaluator_);
+    scanSpec_->setMultiColumnFilter(std::make_shared<RemainingFilter>(
+        std::move(remainingFilterExprSet), expressionEvaluator_, pool_));
   }
 
   readerOpts_.setFileSchema(hiveTableHandle_->dataColumns());
   ioStats_ = std::make_shared<io::IoStatistics>();
+
+  if (resultCache_ != nullptr) {
+    std::stringstream out;
+    out << hiveTableHandle_->toString() << "\n" << outputType_->toString();
+    for (const auto& name : outputType_->names()) {
+      // The outputs of stats aggregates have no column handles.
+      if (auto it = columnHandles.find(name); it != columnHandles.end()) {
+        out << "\n" << it->second->toString();
+      }
+    }
+    scanFingerprint_ = out.str();
+  }
 }
 
 inline uint8_t parseDelimiter(const std::string& delim) {
@@ -527,12 +600,39 @@ std::unique_ptr<SplitReader> HiveDataSource::createSplitReader() {
       split_, readerOutputType_, partitionKeys_, scanSpec_, pool_);
 }
 
+HiveDataSource::~HiveDataSource() {
+  // The files being prepared in the background use 'this'.
+  for (auto& file : preparedFiles_) {
+    file->close();
+  }
+}
+
 void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   VELOX_CHECK(
       split_ == nullptr,
       "Previous split has not been processed yet. Call next to process the split.");
-  split_ = std::dynamic_pointer_cast<HiveConnectorSplit>(split);
-  VELOX_CHECK(split_, "Wrong type of split");
+  if (auto multiFileSplit =
+          std::dynamic_pointer_cast<HiveMultiFileSplit>(split)) {
+    VELOX_CHECK(
+        !multiFileSplit->splits.empty(), "Multi-file split has no files");
+    VELOX_CHECK(pendingFileSplits_.empty());
+    pendingFileSplits_.insert(
+        pendingFileSplits_.end(),
+        multiFileSplit->splits.begin() + 1,
+        multiFileSplit->splits.end());
+    addFileSplit(multiFileSplit->splits.front());
+    return;
+  }
+  auto hiveSplit = std::dynamic_pointer_cast<HiveConnectorSplit>(split);
+  VELOX_CHECK(hiveSplit, "Wrong type of split");
+  addFileSplit(std::move(hiveSplit));
+}
+
+void HiveDataSource::addFileSplit(
+    std::shared_ptr<HiveConnectorSplit> split,
+    std::shared_ptr<AsyncSource<PreparedFile>> preparedFile) {
+  split_ = std::move(split);
+  VELOX_CHECK_NOT_NULL(split_);
 
   VLOG(1) << "Adding split " << split_->toString();
 
@@ -546,27 +646,128 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
     parseSerdeParameters(split_->serdeParameters);
     readerOpts_.setFileFormat(split_->fileFormat);
   }
+  prepareFiles();
+
+  splitStartRows_ = completedRows_;
+  if (resultCache_ != nullptr) {
+    auto key = makeResultCacheKey();
+    cachedResult_ = resultCache_->find(key);
+    if (cachedResult_ != nullptr) {
+      ++numResultCacheHits_;
+      nextCachedBatch_ = 0;
+      if (preparedFile != nullptr) {
+        preparedFile->close();
+      }
+      return;
+    }
+    ++numResultCacheMisses_;
+    pendingResultKey_ = std::move(key);
+    pendingResult_.clear();
+    pendingResultBytes_ = 0;
+  }
 
-  auto fileHandle = fileHandleFactory_->generate(split_->filePath).second;
-  auto input = createBufferedInput(*fileHandle, readerOpts_);
-
-  if (splitReader_) {
-    splitReader_.reset();
+  auto file = preparedFile != nullptr ? preparedFile->move()
+                                      : prepareFile(*split_, readerOpts_);
+  VELOX_CHECK_NOT_NULL(file);
+  splitCoversFile_ =
+      split_->start == 0 && split_->length >= file->fileHandle->file->size();
+  statsAggregatesTried_ = false;
+  statsAggregatesDone_ = false;
+  readerOpts_.setFileMetadataCacheKey(
+      makeFileMetadataCacheKey(*split_, *file->fileHandle));
+
+  seedFilterOrder();
+  if (splitReader_ == nullptr) {
+    splitReader_ = createSplitReader();
+  } else {
+    splitReader_->setSplit(split_);
   }
-  splitReader_ = createSplitReader();
   splitReader_->prepareSplit(
       hiveTableHandle_,
       readerOpts_,
-      std::move(input),
+      nullptr,
       metadataFilter_,
-      runtimeStats_);
+      runtimeStats_,
+      std::move(file->reader));
+}
+
+std::unique_ptr<HiveDataSource::PreparedFile> HiveDataSource::prepareFile(
+    const HiveConnectorSplit& split,
+    dwio::common::ReaderOptions readerOpts) {
+  auto file = std::make_unique<PreparedFile>();
+  file->fileHandle = fileHandleFactory_->generate(split.filePath).second;
+  readerOpts.setFileMetadataCacheKey(
+      makeFileMetadataCacheKey(split, *file->fileHandle));
+  file->reader = dwio::common::getReaderFactory(readerOpts.getFileFormat())
+                     ->createReader(
+                         createBufferedInput(*file->fileHandle, readerOpts),
+                         readerOpts);
+  return file;
+}
+
+void HiveDataSource::prepareFiles() {
+  if (executor_ == nullptr) {
+    return;
+  }
+  const auto numFiles =
+      std::min(pendingFileSplits_.size(), kNumPreparedFiles);
+  while (preparedFiles_.size() < numFiles) {
+    auto split = pendingFileSplits_[preparedFiles_.size()];
+    auto file = std::make_shared<AsyncSource<PreparedFile>>(
+        [this, split, readerOpts = readerOpts_]() {
+          return prepareFile(*split, readerOpts);
+        });
+    executor_->add([file]() { file->prepare(); });
+    preparedFiles_.push_back(std::move(file));
+  }
 }
 
 std::optional<RowVectorPtr> HiveDataSource::next(
     uint64_t size,
-    velox::ContinueFuture& /*future*/) {
-  VELOX_CHECK(split_ != nullptr, "No split to process. Call addSplit first.");
+    velox::ContinueFuture& future) {
+  VELOX_CHECK(
+      split_ != nullptr || !pendingFileSplits_.empty(),
+      "No split to process. Call addSplit first.");
+  for (;;) {
+    if (split_ == nullptr) {
+      // Continues with the next file of a HiveMultiFileSplit. If its footer
+      // is being read on 'executor_', waits for it without blocking the
+      // Driver thread.
+      if (!preparedFiles_.empty() &&
+          !preparedFiles_.front()->readyOrWait(future)) {
+        ++numPreparedFileWaits_;
+        return std::nullopt;
+      }
+      auto split = std::move(pendingFileSplits_.front());
+      pendingFileSplits_.pop_front();
+      std::shared_ptr<AsyncSource<PreparedFile>> preparedFile;
+      if (!preparedFiles_.empty()) {
+        preparedFile = std::move(preparedFiles_.front());
+        preparedFiles_.pop_front();
+      }
+      addFileSplit(std::move(split), std::move(preparedFile));
+    }
+    auto result = nextFromSplit(size);
+    if (result.value() != nullptr || pendingFileSplits_.empty()) {
+      return result;
+    }
+  }
+}
 
+std::optional<RowVectorPtr> HiveDataSource::nextFromSplit(uint64_t size) {
+  if (cachedResult_ != nullptr) {
+    return nextCachedBatch();
+  }
+  auto result = hiveTableHandle_->statsAggregates().empty()
+      ? readNext(size)
+      : nextStatsAggregates(size);
+  if (!pendingResultKey_.empty()) {
+    recordResult(result.value());
+  }
+  return result;
+}
+
+std::optional<RowVectorPtr> HiveDataSource::readNext(uint64_t size) {
   if (splitReader_ && splitReader_->emptySplit()) {
     resetSplit();
     return nullptr;
@@ -576,10 +777,6 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     output_ = BaseVector::create(readerOutputType_, 0, pool_);
   }
 
-  // TODO Check if remaining filter has a conjunct that doesn't depend on
-  // any column, e.g. rand() < 0.1. Evaluate that conjunct first, then scan
-  // only rows that passed.
-
   auto rowsScanned = splitReader_->next(size, output_);
   completedRows_ += rowsScanned;
 
@@ -592,56 +789,410 @@ std::optional<RowVectorPtr> HiveDataSource::next(
       return getEmptyOutput();
     }
 
+    // The reader has applied the remaining filter. See RemainingFilter.
     auto rowVector = std::dynamic_pointer_cast<RowVector>(output_);
+    if (outputType_->size() == 0 ||
+        !hiveTableHandle_->statsAggregates().empty()) {
+      return rowVector;
+    }
 
-    // In case there is a remaining filter that excludes some but not all
-    // rows, collect the indices of the passing rows. If there is no filter,
-    // or it passes on all rows, leave this as null and let exec::wrap skip
-    // wrapping the results.
-    BufferPtr remainingIndices;
-    if (remainingFilterExprSet_) {
-      rowsRemaining = evaluateRemainingFilter(rowVector);
-      VELOX_CHECK_LE(rowsRemaining, rowsScanned);
-      if (rowsRemaining == 0) {
-        // No rows passed the remaining filter.
-        return getEmptyOutput();
-      }
+    std::vector<VectorPtr> outputColumns(
+        rowVector->children().begin(),
+        rowVector->children().begin() + outputType_->size());
+
+    return std::make_shared<RowVector>(
+        pool_, outputType_, BufferPtr(nullptr), rowsRemaining, outputColumns);
+  }
+
+  splitReader_->updateRuntimeStats(runtimeStats_);
+  resetSplit();
+  return nullptr;
+}
+
+void HiveDataSource::addStatsAggregateColumns(
+    std::vector<std::string>& names,
+    std::vector<TypePtr>& types) const {
+  const auto& aggregates = hiveTableHandle_->statsAggregates();
+  VELOX_USER_CHECK_EQ(
+      aggregates.size(),
+      outputType_->size(),
+      "Stats aggregates must match the output columns");
+  VELOX_USER_CHECK_NULL(
+      hiveTableHandle_->remainingFilter(),
+      "Stats aggregates do not support a remaining filter");
+  for (const auto& [subfield, _] : hiveTableHandle_->subfieldFilters()) {
+    VELOX_USER_CHECK_GT(
+        partitionKeys_.count(getColumnName(subfield)),
+        0,
+        "Stats aggregates only support filters on partition keys: {}",
+        subfield.toString());
+  }
+  for (auto i = 0; i < aggregates.size(); ++i) {
+    const auto& aggregate = aggregates[i];
+    const auto& outputType = outputType_->childAt(i);
+    if (aggregate.column.empty()) {
+      VELOX_USER_CHECK(
+          aggregate.kind == HiveStatsAggregate::Kind::kCount,
+          "Only count has no column: {}",
+          aggregate.toString());
+      VELOX_USER_CHECK(outputType->isBigint());
+      continue;
+    }
+    VELOX_USER_CHECK_NOT_NULL(
+        hiveTableHandle_->dataColumns(),
+        "Stats aggregates need the data columns");
+    VELOX_USER_CHECK_EQ(
+        partitionKeys_.count(aggregate.column),
+        0,
+        "Stats aggregates do not support partition keys: {}",
+        aggregate.toString());
+    const auto& type =
+        hiveTableHandle_->dataColumns()->findChild(aggregate.column);
+    VELOX_USER_CHECK(
+        outputType->equivalent(
+            aggregate.kind == HiveStatsAggregate::Kind::kCount ? *BIGINT()
+                                                               : *type),
+        "Wrong output type {} for {}",
+        outputType->toString(),
+        aggregate.toString());
+    if (std::find(names.begin(), names.end(), aggregate.column) ==
+        names.end()) {
+      names.push_back(aggregate.column);
+      types.push_back(type);
+    }
+  }
+}
+
+namespace {
+
+// Sets 'result' at 0 to the minimum or maximum in 'stats' if 'stats' is of
+// type TStats and has the value.
+template <typename T, typename TStats>
+bool setStatsValue(
+    const dwio::common::ColumnStatistics& stats,
+    bool isMin,
+    BaseVector& result) {
+  auto* typedStats = dynamic_cast<const TStats*>(&stats);
+  if (typedStats == nullptr) {
+    return false;
+  }
+  const auto value =
+      isMin ? typedStats->getMinimum() : typedStats->getMaximum();
+  if (!value.has_value()) {
+    return false;
+  }
+  result.asFlatVector<T>()->set(0, static_cast<T>(value.value()));
+  return true;
+}
+
+bool setMinMaxFromStats(
+    const dwio::common::ColumnStatistics& stats,
+    bool isMin,
+    BaseVector& result) {
+  using dwio::common::DoubleColumnStatistics;
+  using dwio::common::IntegerColumnStatistics;
+  if (result.type()->isDecimal()) {
+    return false;
+  }
+  switch (result.typeKind()) {
+    case TypeKind::TINYINT:
+      return setStatsValue<int8_t, IntegerColumnStatistics>(
+          stats, isMin, result);
+    case TypeKind::SMALLINT:
+      return setStatsValue<int16_t, IntegerColumnStatistics>(
+          stats, isMin, result);
+    case TypeKind::INTEGER:
+      return setStatsValue<int32_t, IntegerColumnStatistics>(
+          stats, isMin, result);
+    case TypeKind::BIGINT:
+      return setStatsValue<int64_t, IntegerColumnStatistics>(
+          stats, isMin, result);
+    case TypeKind::REAL:
+      return setStatsValue<float, DoubleColumnStatistics>(stats, isMin, result);
+    case TypeKind::DOUBLE:
+      return setStatsValue<double, DoubleColumnStatistics>(
+          stats, isMin, result);
+    default:
+      return false;
+  }
+}
 
-      if (rowsRemaining < rowVector->size()) {
-        // Some, but not all rows passed the remaining filter.
-        remainingIndices = filterEvalCtx_.selectedIndices;
+} // namespace
+
+std::optional<RowVectorPtr> HiveDataSource::nextStatsAggregates(
+    uint64_t size) {
+  if (statsAggregatesDone_) {
+    resetSplit();
+    return nullptr;
+  }
+  if (!statsAggregatesTried_) {
+    statsAggregatesTried_ = true;
+    if (!splitReader_->emptySplit()) {
+      if (auto result = aggregatesFromStats()) {
+        statsAggregatesDone_ = true;
+        ++numStatsAggregatedSplits_;
+        return result;
       }
     }
+  }
+  auto batch = readNext(size);
+  if (batch.value() == nullptr) {
+    return batch;
+  }
+  if (batch.value()->size() == 0) {
+    return getEmptyOutput();
+  }
+  return aggregateBatch(batch.value());
+}
 
-    if (outputType_->size() == 0) {
-      return exec::wrap(rowsRemaining, remainingIndices, rowVector);
+RowVectorPtr HiveDataSource::aggregatesFromStats() {
+  const auto format = readerOpts_.getFileFormat();
+  if (!splitCoversFile_ ||
+      (format != dwio::common::FileFormat::DWRF &&
+       format != dwio::common::FileFormat::ORC &&
+       format != dwio::common::FileFormat::PARQUET)) {
+    return nullptr;
+  }
+  const auto* reader = splitReader_->baseReader();
+  const auto numRows = reader->numberOfRows();
+  if (!numRows.has_value()) {
+    return nullptr;
+  }
+  auto result = BaseVector::create<RowVector>(outputType_, 1, pool_);
+  const auto& aggregates = hiveTableHandle_->statsAggregates();
+  for (auto i = 0; i < aggregates.size(); ++i) {
+    const auto& aggregate = aggregates[i];
+    auto& child = result->childAt(i);
+    if (aggregate.column.empty()) {
+      child->asFlatVector<int64_t>()->set(0, numRows.value());
+      continue;
+    }
+    // A column that is missing in the file is read as nulls.
+    if (!reader->rowType()->containsChild(aggregate.column)) {
+      return nullptr;
+    }
+    const auto stats = reader->columnStatistics(
+        reader->typeWithId()->childByName(aggregate.column)->id());
+    if (stats == nullptr || !stats->getNumberOfValues().has_value()) {
+      return nullptr;
     }
+    const auto numValues = stats->getNumberOfValues().value();
+    if (aggregate.kind == HiveStatsAggregate::Kind::kCount) {
+      child->asFlatVector<int64_t>()->set(0, numValues);
+    } else if (numValues == 0) {
+      child->setNull(0, true);
+    } else if (!setMinMaxFromStats(
+                   *stats,
+                   aggregate.kind == HiveStatsAggregate::Kind::kMin,
+                   *child)) {
+      return nullptr;
+    }
+  }
+  completedRows_ += numRows.value();
+  return result;
+}
 
-    std::vector<VectorPtr> outputColumns;
-    outputColumns.reserve(outputType_->size());
-    for (int i = 0; i < outputType_->size(); i++) {
-      auto& child = rowVector->childAt(i);
-      if (remainingIndices) {
-        // Disable dictionary values caching in expression eval so that we
-        // don't need to reallocate the result for every batch.
-        child->disableMemo();
+RowVectorPtr HiveDataSource::aggregateBatch(const RowVectorPtr& batch) {
+  auto result = BaseVector::create<RowVector>(outputType_, 1, pool_);
+  const auto& aggregates = hiveTableHandle_->statsAggregates();
+  const SelectivityVector rows(batch->size());
+  DecodedVector decoded;
+  for (auto i = 0; i < aggregates.size(); ++i) {
+    const auto& aggregate = aggregates[i];
+    auto& child = result->childAt(i);
+    if (aggregate.column.empty()) {
+      child->asFlatVector<int64_t>()->set(0, batch->size());
+      continue;
+    }
+    const auto& column =
+        batch->childAt(readerOutputType_->getChildIdx(aggregate.column));
+    decoded.decode(*column, rows);
+    if (aggregate.kind == HiveStatsAggregate::Kind::kCount) {
+      int64_t count = 0;
+      for (auto row = 0; row < batch->size(); ++row) {
+        count += !decoded.isNullAt(row);
       }
-      outputColumns.emplace_back(
-          exec::wrapChild(rowsRemaining, remainingIndices, child));
+      child->asFlatVector<int64_t>()->set(0, count);
+      continue;
+    }
+    const bool isMin = aggregate.kind == HiveStatsAggregate::Kind::kMin;
+    const auto* base = decoded.base();
+    vector_size_t best = -1;
+    for (auto row = 0; row < batch->size(); ++row) {
+      if (decoded.isNullAt(row)) {
+        continue;
+      }
+      if (best == -1) {
+        best = row;
+        continue;
+      }
+      const auto comparison =
+          base->compare(base, decoded.index(row), decoded.index(best));
+      if (isMin ? comparison < 0 : comparison > 0) {
+        best = row;
+      }
+    }
+    if (best == -1) {
+      child->setNull(0, true);
+    } else {
+      child->copy(base, 0, decoded.index(best), 1);
     }
+  }
+  return result;
+}
 
-    return std::make_shared<RowVector>(
-        pool_, outputType_, BufferPtr(nullptr), rowsRemaining, outputColumns);
+std::string HiveDataSource::makeResultCacheKey() const {
+  // Sort partition keys for deterministic output.
+  std::map<std::string, std::optional<std::string>> partitionKeys(
+      split_->partitionKeys.begin(), split_->partitionKeys.end());
+  std::stringstream out;
+  out << split_->filePath << " " << split_->start << " " << split_->length;
+  for (const auto& [name, value] : partitionKeys) {
+    out << " " << name << "=" << value.value_or("<null>");
   }
+  // The scan spec has the dynamic filters added after creating 'this'.
+  out << "\n" << scanSpec_->toString() << "\n" << scanFingerprint_;
+  return out.str();
+}
 
-  splitReader_->updateRuntimeStats(runtimeStats_);
+// static
+std::string HiveDataSource::makeFileMetadataCacheKey(
+    const HiveConnectorSplit& split,
+    const FileHandle& fileHandle) {
+  if (dwio::common::FileMetadataCache::instance() == nullptr) {
+    return "";
+  }
+  // The size tells apart most rewrites of a file even if the split has no
+  // version.
+  auto key = fmt::format("{} {}", split.filePath, fileHandle.file->size());
+  auto it = split.customSplitInfo.find(HiveConnectorSplit::kFileVersion);
+  if (it != split.customSplitInfo.end()) {
+    key += " " + it->second;
+  }
+  return key;
+}
+
+RowVectorPtr HiveDataSource::nextCachedBatch() {
+  const auto& batches = cachedResult_->batches;
+  if (nextCachedBatch_ < batches.size()) {
+    return batches[nextCachedBatch_++];
+  }
+  completedRows_ += cachedResult_->numScannedRows;
+  cachedResult_.reset();
   resetSplit();
   return nullptr;
 }
 
+void HiveDataSource::recordResult(const RowVectorPtr& batch) {
+  if (batch == nullptr) {
+    resultCache_->put(
+        pendingResultKey_,
+        std::move(pendingResult_),
+        completedRows_ - splitStartRows_);
+    pendingResultKey_.clear();
+    pendingResult_.clear();
+    return;
+  }
+  if (batch->size() == 0) {
+    return;
+  }
+  auto copy = resultCache_->copy(batch);
+  pendingResultBytes_ += copy->retainedSize();
+  if (pendingResultBytes_ > resultCache_->maxEntryBytes()) {
+    // Too large to cache.
+    pendingResultKey_.clear();
+    pendingResult_.clear();
+    return;
+  }
+  pendingResult_.push_back(std::move(copy));
+}
+
+std::string HiveDataSource::makeFilterOrderKey() const {
+  // Sort the filtered columns for a key independent of the current order.
+  std::map<std::string, std::string> filters;
+  for (const auto& child : scanSpec_->children()) {
+    if (!child->hasFilter()) {
+      continue;
+    }
+    // Filters on members of complex types are part of the child's spec.
+    filters[child->fieldName()] =
+        child->filter() ? child->filter()->toString() : child->toString();
+  }
+  if (filters.size() < 2) {
+    return "";
+  }
+  std::stringstream out;
+  out << hiveTableHandle_->tableName();
+  for (const auto& [name, filter] : filters) {
+    out << "\n" << name << " " << filter;
+  }
+  return out.str();
+}
+
+void HiveDataSource::seedFilterOrder() {
+  if (filterOrderCache_ == nullptr) {
+    return;
+  }
+  auto key = makeFilterOrderKey();
+  if (key == filterOrderKey_) {
+    return;
+  }
+  publishFilterOrder();
+  filterOrderKey_ = std::move(key);
+  publishedSelectivity_.clear();
+  if (filterOrderKey_.empty()) {
+    return;
+  }
+  auto history = filterOrderCache_->find(filterOrderKey_);
+  if (history != nullptr) {
+    ++numFilterOrderCacheHits_;
+  } else {
+    ++numFilterOrderCacheMisses_;
+  }
+  for (const auto& child : scanSpec_->children()) {
+    if (!child->hasFilter()) {
+      continue;
+    }
+    auto& selectivity = child->selectivity();
+    if (history != nullptr && selectivity.numIn() == 0) {
+      auto it = history->find(child->fieldName());
+      if (it != history->end()) {
+        // The next read orders the filters by these.
+        selectivity = it->second;
+      }
+    }
+    // The history is not measured by 'this' and is not added back.
+    publishedSelectivity_[child->fieldName()] = selectivity;
+  }
+}
+
+void HiveDataSource::publishFilterOrder() {
+  if (filterOrderCache_ == nullptr || filterOrderKey_.empty()) {
+    return;
+  }
+  FilterOrderCache::Entry delta;
+  for (const auto& child : scanSpec_->children()) {
+    auto it = publishedSelectivity_.find(child->fieldName());
+    if (it == publishedSelectivity_.end()) {
+      continue;
+    }
+    const auto& selectivity = child->selectivity();
+    auto added = selectivity.since(it->second);
+    if (added.numIn() > 0) {
+      delta[child->fieldName()] = added;
+    }
+    it->second = selectivity;
+  }
+  filterOrderCache_->add(filterOrderKey_, delta);
+}
+
 void HiveDataSource::addDynamicFilter(
     column_index_t outputChannel,
     const std::shared_ptr<common::Filter>& filter) {
+  // The result of the current split is not the result of the key made before
+  // the filter.
+  pendingResultKey_.clear();
+  pendingResult_.clear();
   auto& fieldSpec = scanSpec_->getChildByChannel(outputChannel);
   fieldSpec.addFilter(*filter);
   scanSpec_->resetCachedValues(true);
@@ -679,6 +1230,26 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
             ioStats_->rawOverreadBytes(), RuntimeCounter::Unit::kBytes)},
        {"queryThreadIoLatency",
         RuntimeCounter(ioStats_->queryThreadIoLatency().count())}});
+  if (resultCache_ != nullptr) {
+    res.insert(
+        {{"numResultCacheHits", RuntimeCounter(numResultCacheHits_)},
+         {"numResultCacheMisses", RuntimeCounter(numResultCacheMisses_)}});
+  }
+  if (!hiveTableHandle_->statsAggregates().empty()) {
+    res.insert(
+        {"numStatsAggregatedSplits",
+         RuntimeCounter(numStatsAggregatedSplits_)});
+  }
+  if (numPreparedFileWaits_ > 0) {
+    res.insert(
+        {"numPreparedFileWaits", RuntimeCounter(numPreparedFileWaits_)});
+  }
+  if (filterOrderCache_ != nullptr) {
+    res.insert(
+        {{"numFilterOrderCacheHits", RuntimeCounter(numFilterOrderCacheHits_)},
+         {"numFilterOrderCacheMisses",
+          RuntimeCounter(numFilterOrderCacheMisses_)}});
+  }
   return res;
 }
 
@@ -688,6 +1259,31 @@ void HiveDataSource::setFromDataSource(
   VELOX_CHECK(source, "Bad DataSource type");
 
   split_ = std::move(source->split_);
+  // The files of 'source' that are being prepared use 'source'. This
+  // prepares them again when it moves to the next file.
+  for (auto& file : source->preparedFiles_) {
+    file->close();
+  }
+  source->preparedFiles_.clear();
+  pendingFileSplits_ = std::move(source->pendingFileSplits_);
+  numResultCacheHits_ += source->numResultCacheHits_;
+  numResultCacheMisses_ += source->numResultCacheMisses_;
+  numFilterOrderCacheHits_ += source->numFilterOrderCacheHits_;
+  numFilterOrderCacheMisses_ += source->numFilterOrderCacheMisses_;
+  numStatsAggregatedSplits_ += source->numStatsAggregatedSplits_;
+  numPreparedFileWaits_ += source->numPreparedFileWaits_;
+  splitCoversFile_ = source->splitCoversFile_;
+  statsAggregatesTried_ = false;
+  statsAggregatesDone_ = false;
+  splitStartRows_ = completedRows_;
+  pendingResultKey_ = std::move(source->pendingResultKey_);
+  pendingResult_ = std::move(source->pendingResult_);
+  pendingResultBytes_ = source->pendingResultBytes_;
+  if (source->cachedResult_ != nullptr) {
+    cachedResult_ = std::move(source->cachedResult_);
+    nextCachedBatch_ = 0;
+    return;
+  }
   if (source->splitReader_ && source->splitReader_->emptySplit()) {
     return;
   }
@@ -806,17 +1402,12 @@ HiveDataSource::createBufferedInput(
       ioStats_.get());
 }
 
-vector_size_t HiveDataSource::evaluateRemainingFilter(RowVectorPtr& rowVector) {
-  filterRows_.resize(output_->size());
-
-  expressionEvaluator_->evaluate(
-      remainingFilterExprSet_.get(), filterRows_, *rowVector, filterResult_);
-  return exec::processFilterResults(
-      filterResult_, filterRows_, filterEvalCtx_, pool_);
-}
-
 void HiveDataSource::resetSplit() {
   split_.reset();
+  publishFilterOrder();
+  if (splitReader_ == nullptr) {
+    return;
+  }
   splitReader_->resetSplit();
   // Keep readers around to hold adaptation.
 }
@@ -15,10 +15,15 @@
  */
 #pragma once
 
+#include <deque>
+
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/FilterOrderCache.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/ScanResultCache.h"
 #include "velox/connectors/hive/SplitReader.h"
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/dwio/common/BufferedInput.h"
@@ -42,8 +47,15 @@ class HiveDataSource : public DataSource {
       cache::AsyncDataCache* cache,
       const std::string& scanId,
       folly::Executor* executor,
-      const dwio::common::ReaderOptions& options);
+      const dwio::common::ReaderOptions& options,
+      ScanResultCache* resultCache = nullptr,
+      FilterOrderCache* filterOrderCache = nullptr);
+
+  ~HiveDataSource() override;
 
+  /// Takes a HiveConnectorSplit or a HiveMultiFileSplit. next() reads the
+  /// files of a HiveMultiFileSplit in order and returns nullptr after the last
+  /// one.
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
   std::optional<RowVectorPtr> next(uint64_t size, velox::ContinueFuture& future)
@@ -64,7 +76,8 @@ class HiveDataSource : public DataSource {
   std::unordered_map<std::string, RuntimeCounter> runtimeStats() override;
 
   bool allPrefetchIssued() const override {
-    return splitReader_ && splitReader_->allPrefetchIssued();
+    return pendingFileSplits_.empty() && splitReader_ &&
+        splitReader_->allPrefetchIssued();
   }
 
   void setFromDataSource(std::unique_ptr<DataSource> sourceUnique) override;
@@ -118,16 +131,89 @@ class HiveDataSource : public DataSource {
       partitionKeys_;
 
  private:
-  // Evaluates remainingFilter_ on the specified vector. Returns number of rows
-  // passed. Populates filterEvalCtx_.selectedIndices and selectedBits if only
-  // some rows passed the filter. If none or all rows passed
-  // filterEvalCtx_.selectedIndices and selectedBits are not updated.
-  vector_size_t evaluateRemainingFilter(RowVectorPtr& rowVector);
+  // Number of files after the current one of a HiveMultiFileSplit whose
+  // readers are made in the background.
+  static constexpr size_t kNumPreparedFiles = 4;
+
+  // A file of a split with its reader, i.e. with the footer read.
+  struct PreparedFile {
+    std::shared_ptr<FileHandle> fileHandle;
+    std::unique_ptr<dwio::common::Reader> reader;
+  };
+
+  // Makes the split of one file the current split. 'preparedFile' is the
+  // file made in the background or nullptr.
+  void addFileSplit(
+      std::shared_ptr<HiveConnectorSplit> split,
+      std::shared_ptr<AsyncSource<PreparedFile>> preparedFile = nullptr);
+
+  // Returns the next batch of 'split_' or nullptr at its end.
+  std::optional<RowVectorPtr> nextFromSplit(uint64_t size);
+
+  // Opens the file of 'split' and reads its footer.
+  std::unique_ptr<PreparedFile> prepareFile(
+      const HiveConnectorSplit& split,
+      dwio::common::ReaderOptions readerOpts);
+
+  // Starts preparing the first kNumPreparedFiles files of
+  // 'pendingFileSplits_' on 'executor_'.
+  void prepareFiles();
 
   // Clear split_ after split has been fully processed.  Keep readers around to
   // hold adaptation.
   void resetSplit();
 
+  // Reads the next batch of 'split_' from the file.
+  std::optional<RowVectorPtr> readNext(uint64_t size);
+
+  // Adds the columns read for the stats aggregates of 'hiveTableHandle_' to
+  // 'names' and 'types'. Checks that the output type matches the aggregates.
+  void addStatsAggregateColumns(
+      std::vector<std::string>& names,
+      std::vector<TypePtr>& types) const;
+
+  // Returns the next batch of the stats aggregates over the rows of 'split_'.
+  // This is a single row from the file statistics if these answer all the
+  // aggregates and otherwise a row for each batch read from the file.
+  std::optional<RowVectorPtr> nextStatsAggregates(uint64_t size);
+
+  // Returns the stats aggregates over all rows of 'split_' from the file
+  // statistics or nullptr if the statistics do not answer all of them.
+  RowVectorPtr aggregatesFromStats();
+
+  // Returns the stats aggregates over the rows of 'batch' read from 'split_'.
+  RowVectorPtr aggregateBatch(const RowVectorPtr& batch);
+
+  // Returns the key of 'split_' in 'resultCache_'.
+  std::string makeResultCacheKey() const;
+
+  // Returns the key of the file of 'split' in FileMetadataCache or an empty
+  // string if the cache is disabled.
+  static std::string makeFileMetadataCacheKey(
+      const HiveConnectorSplit& split,
+      const FileHandle& fileHandle);
+
+  // Returns the next batch of 'cachedResult_' or nullptr at the end.
+  RowVectorPtr nextCachedBatch();
+
+  // Adds 'batch' read from 'split_' to 'pendingResult_'. Adds
+  // 'pendingResult_' to 'resultCache_' if 'batch' is nullptr, i.e. at the end
+  // of the split.
+  void recordResult(const RowVectorPtr& batch);
+
+  // Returns the key of the filters of 'scanSpec_' in 'filterOrderCache_' or
+  // an empty string if there are less than two filters to order.
+  std::string makeFilterOrderKey() const;
+
+  // Starts the filters of 'scanSpec_' that have no measurements yet from
+  // the history in 'filterOrderCache_' if the filters changed since the last
+  // call, e.g. on the first split or after a dynamic filter.
+  void seedFilterOrder();
+
+  // Adds the measurements of the filters of 'scanSpec_' since the last call
+  // or seedFilterOrder() to 'filterOrderCache_'.
+  void publishFilterOrder();
+
   void parseSerdeParameters(
       const std::unordered_map<std::string, std::string>& serdeParameters);
 
@@ -144,20 +230,63 @@ class HiveDataSource : public DataSource {
   const RowTypePtr outputType_;
   std::shared_ptr<io::IoStatistics> ioStats_;
   std::shared_ptr<common::MetadataFilter> metadataFilter_;
-  std::unique_ptr<exec::ExprSet> remainingFilterExprSet_;
   RowVectorPtr emptyOutput_;
   dwio::common::RuntimeStatistics runtimeStats_;
   core::ExpressionEvaluator* expressionEvaluator_;
   uint64_t completedRows_ = 0;
 
-  // Reusable memory for remaining filter evaluation.
-  VectorPtr filterResult_;
-  SelectivityVector filterRows_;
-  exec::FilterEvalCtx filterEvalCtx_;
-
   cache::AsyncDataCache* const cache_{nullptr};
   const std::string& scanId_;
   folly::Executor* executor_;
+
+  // Cache of the output of splits. nullptr if not enabled for the query.
+  ScanResultCache* const resultCache_;
+  // Describes the table handle, the column handles and the output type. Part
+  // of the result cache keys.
+  std::string scanFingerprint_;
+  // The result of 'split_' from 'resultCache_' and the next batch to return.
+  std::shared_ptr<const ScanResultCache::Entry> cachedResult_;
+  size_t nextCachedBatch_{0};
+  // Key in 'resultCache_' for the result of 'split_' being read from the file.
+  // Empty if the result is not recorded, e.g. because it grew too large.
+  std::string pendingResultKey_;
+  std::vector<RowVectorPtr> pendingResult_;
+  uint64_t pendingResultBytes_{0};
+  // Value of 'completedRows_' when 'split_' was added.
+  uint64_t splitStartRows_{0};
+  uint64_t numResultCacheHits_{0};
+  uint64_t numResultCacheMisses_{0};
+
+  // History of the filter order of earlier scans. nullptr if not enabled.
+  FilterOrderCache* const filterOrderCache_;
+  // Key in 'filterOrderCache_' of the filters of 'scanSpec_' at the last
+  // seedFilterOrder().
+  std::string filterOrderKey_;
+  // The selectivity of each filtered column at the last seedFilterOrder() or
+  // publishFilterOrder().
+  FilterOrderCache::Entry publishedSelectivity_;
+  uint64_t numFilterOrderCacheHits_{0};
+  uint64_t numFilterOrderCacheMisses_{0};
+
+  // True if 'split_' starts at the beginning of its file and extends past the
+  // end.
+  bool splitCoversFile_{false};
+  // True if the file statistics have been tried for the stats aggregates of
+  // 'split_'.
+  bool statsAggregatesTried_{false};
+  // True if the stats aggregates of 'split_' were returned from the file
+  // statistics.
+  bool statsAggregatesDone_{false};
+  // Number of splits whose stats aggregates came from the file statistics.
+  uint64_t numStatsAggregatedSplits_{0};
+
+  // The files of a HiveMultiFileSplit after 'split_' in read order.
+  std::deque<std::shared_ptr<HiveConnectorSplit>> pendingFileSplits_;
+  // The files being prepared for the first splits of 'pendingFileSplits_'.
+  std::deque<std::shared_ptr<AsyncSource<PreparedFile>>> preparedFiles_;
+  // Number of times next() returned a future to wait for the next file of a
+  // HiveMultiFileSplit instead of waiting on the Driver thread.
+  uint64_t numPreparedFileWaits_{0};
 };
 
 } // namespace facebook::velox::connector::hive
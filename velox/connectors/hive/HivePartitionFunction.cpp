@@ -15,6 +15,8 @@
  */
 #include "velox/connectors/hive/HivePartitionFunction.h"
 
+#include "velox/functions/lib/SparkHash.h"
+
 namespace facebook::velox::connector::hive {
 
 namespace {
@@ -434,15 +436,22 @@ HivePartitionFunction::HivePartitionFunction(
     int numBuckets,
     std::vector<int> bucketToPartition,
     std::vector<column_index_t> keyChannels,
-    const std::vector<VectorPtr>& constValues)
+    const std::vector<VectorPtr>& constValues,
+    HashKind hashKind)
     : numBuckets_{numBuckets},
       bucketToPartition_{bucketToPartition},
-      keyChannels_{std::move(keyChannels)} {
+      keyChannels_{std::move(keyChannels)},
+      hashKind_{hashKind} {
   precomputedHashes_.resize(keyChannels_.size());
+  constKeyValues_.resize(keyChannels_.size());
   size_t constChannel{0};
   for (auto i = 0; i < keyChannels_.size(); ++i) {
     if (keyChannels_[i] == kConstantChannel) {
-      precompute(*(constValues[constChannel++]), i);
+      if (hashKind_ == HashKind::kSparkMurmur3) {
+        constKeyValues_[i] = constValues[constChannel++];
+      } else {
+        precompute(*(constValues[constChannel++]), i);
+      }
     }
   }
 }
@@ -460,34 +469,61 @@ std::optional<uint32_t> HivePartitionFunction::partition(
     hashes.resize(numRows);
   }
   partitions.resize(numRows);
-  for (auto i = 0; i < keyChannels_.size(); ++i) {
-    if (keyChannels_[i] != kConstantChannel) {
-      const auto& keyVector = input.childAt(keyChannels_[i]);
-      decodedVector.decode(*keyVector, rows);
-      hash(decodedVector, keyVector->typeKind(), rows, i > 0, hashes, 1);
-    } else {
-      hashPrecomputed(precomputedHashes_[i], numRows, i > 0, hashes);
+  if (hashKind_ == HashKind::kSparkMurmur3) {
+    sparkHash(input, rows, hashes);
+    // Spark's pmod(hash, numBuckets) of the signed hash.
+    for (auto i = 0; i < numRows; ++i) {
+      const int32_t remainder = static_cast<int32_t>(hashes[i]) % numBuckets_;
+      hashes[i] = remainder < 0 ? remainder + numBuckets_ : remainder;
+    }
+  } else {
+    for (auto i = 0; i < keyChannels_.size(); ++i) {
+      if (keyChannels_[i] != kConstantChannel) {
+        const auto& keyVector = input.childAt(keyChannels_[i]);
+        decodedVector.decode(*keyVector, rows);
+        hash(decodedVector, keyVector->typeKind(), rows, i > 0, hashes, 1);
+      } else {
+        hashPrecomputed(precomputedHashes_[i], numRows, i > 0, hashes);
+      }
     }
-  }
 
-  static const int32_t kInt32Max = std::numeric_limits<int32_t>::max();
+    static const int32_t kInt32Max = std::numeric_limits<int32_t>::max();
+    for (auto i = 0; i < numRows; ++i) {
+      hashes[i] = (hashes[i] & kInt32Max) % numBuckets_;
+    }
+  }
 
   if (bucketToPartition_.empty()) {
     // NOTE: if bucket to partition mapping is empty, then we do
     // identical mapping.
-    for (auto i = 0; i < numRows; ++i) {
-      partitions[i] = (hashes[i] & kInt32Max) % numBuckets_;
-    }
+    std::copy(hashes.begin(), hashes.begin() + numRows, partitions.begin());
   } else {
     for (auto i = 0; i < numRows; ++i) {
-      partitions[i] =
-          bucketToPartition_[((hashes[i] & kInt32Max) % numBuckets_)];
+      partitions[i] = bucketToPartition_[hashes[i]];
     }
   }
 
   return std::nullopt;
 }
 
+void HivePartitionFunction::sparkHash(
+    const RowVector& input,
+    const SelectivityVector& rows,
+    std::vector<uint32_t>& hashes) {
+  static constexpr uint32_t kSeed = 42;
+  const auto numRows = rows.size();
+  std::fill(hashes.begin(), hashes.begin() + numRows, kSeed);
+  auto& decodedVector = getDecodedVector();
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    const VectorPtr keyVector = keyChannels_[i] == kConstantChannel
+        ? BaseVector::wrapInConstant(numRows, 0, constKeyValues_[i])
+        : input.childAt(keyChannels_[i]);
+    decodedVector.decode(*keyVector, rows);
+    functions::sparkMurmur3Hash(
+        decodedVector, keyVector->typeKind(), rows, hashes.data());
+  }
+}
+
 void HivePartitionFunction::precompute(
     const BaseVector& value,
     size_t channelIndex) {
@@ -22,21 +22,34 @@ namespace facebook::velox::connector::hive {
 
 class HivePartitionFunction : public core::PartitionFunction {
  public:
+  /// The hash function that maps the keys of a row to a bucket.
+  enum class HashKind {
+    /// Hive's ObjectInspectorUtils.hashCode.
+    kHive,
+    /// Spark's murmur3 'hash' function with seed 42, as used by Spark for
+    /// bucketed tables and hash partitioning. Supports the types of
+    /// functions::sparkMurmur3Hash().
+    kSparkMurmur3,
+  };
+
   HivePartitionFunction(
       int numBuckets,
       std::vector<int> bucketToPartition,
       std::vector<column_index_t> keyChannels,
-      const std::vector<VectorPtr>& constValues = {});
+      const std::vector<VectorPtr>& constValues = {},
+      HashKind hashKind = HashKind::kHive);
 
   HivePartitionFunction(
       int numBuckets,
       std::vector<column_index_t> keyChannels,
-      const std::vector<VectorPtr>& constValues = {})
+      const std::vector<VectorPtr>& constValues = {},
+      HashKind hashKind = HashKind::kHive)
       : HivePartitionFunction(
             numBuckets,
             {},
             std::move(keyChannels),
-            constValues) {}
+            constValues,
+            hashKind) {}
 
   ~HivePartitionFunction() override = default;
 
@@ -48,6 +61,13 @@ class HivePartitionFunction : public core::PartitionFunction {
   // Precompute single value hive hash for a constant partition key.
   void precompute(const BaseVector& value, size_t column_index_t);
 
+  // Sets the first 'rows.size()' of 'hashes' to the Spark murmur3 hashes of
+  // the keys of 'input'.
+  void sparkHash(
+      const RowVector& input,
+      const SelectivityVector& rows,
+      std::vector<uint32_t>& hashes);
+
   void hash(
       const DecodedVector& values,
       TypeKind typeKind,
@@ -76,6 +96,7 @@ class HivePartitionFunction : public core::PartitionFunction {
   const int numBuckets_;
   const std::vector<int> bucketToPartition_;
   const std::vector<column_index_t> keyChannels_;
+  const HashKind hashKind_;
 
   // Pools of reusable memory.
   std::vector<std::unique_ptr<std::vector<uint32_t>>> hashesPool_;
@@ -83,5 +104,8 @@ class HivePartitionFunction : public core::PartitionFunction {
   std::vector<std::unique_ptr<DecodedVector>> decodedVectorsPool_;
   // Precomputed hashes for constant partition keys (one per key).
   std::vector<uint32_t> precomputedHashes_;
+  // Values of constant partition keys (one per key) for kSparkMurmur3, whose
+  // hash of a key depends on the hash of the previous keys.
+  std::vector<VectorPtr> constKeyValues_;
 };
 } // namespace facebook::velox::connector::hive
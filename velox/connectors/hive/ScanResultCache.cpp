@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/connectors/hive/ScanResultCache.h"
+
+namespace facebook::velox::connector::hive {
+
+ScanResultCache::ScanResultCache(uint64_t maxBytes)
+    : maxBytes_(maxBytes),
+      pool_(memory::addDefaultLeafMemoryPool("_sys.scanResultCache")) {}
+
+std::shared_ptr<const ScanResultCache::Entry> ScanResultCache::find(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entryMap_.find(key);
+  if (it == entryMap_.end()) {
+    ++numMisses_;
+    return nullptr;
+  }
+  ++numHits_;
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->second;
+}
+
+RowVectorPtr ScanResultCache::copy(const RowVectorPtr& batch) {
+  auto copy = std::dynamic_pointer_cast<RowVector>(
+      BaseVector::create(batch->type(), batch->size(), pool_.get()));
+  copy->copy(batch.get(), 0, 0, batch->size());
+  return copy;
+}
+
+void ScanResultCache::put(
+    const std::string& key,
+    std::vector<RowVectorPtr> batches,
+    uint64_t numScannedRows) {
+  auto entry = std::make_shared<Entry>();
+  for (const auto& batch : batches) {
+    entry->bytes += batch->retainedSize();
+  }
+  if (entry->bytes > maxEntryBytes()) {
+    return;
+  }
+  entry->batches = std::move(batches);
+  entry->numScannedRows = numScannedRows;
+
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entryMap_.find(key);
+  if (it != entryMap_.end()) {
+    // Another driver scanned the same split concurrently.
+    return;
+  }
+  bytes_ += entry->bytes;
+  entries_.emplace_front(key, std::move(entry));
+  entryMap_[key] = entries_.begin();
+  evictLocked();
+}
+
+void ScanResultCache::evictLocked() {
+  while (bytes_ > maxBytes_ && !entries_.empty()) {
+    auto& [key, entry] = entries_.back();
+    bytes_ -= entry->bytes;
+    entryMap_.erase(key);
+    entries_.pop_back();
+    ++numEvicts_;
+  }
+}
+
+ScanResultCache::Stats ScanResultCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  Stats stats;
+  stats.numHits = numHits_;
+  stats.numMisses = numMisses_;
+  stats.numEvicts = numEvicts_;
+  stats.numEntries = entries_.size();
+  stats.bytes = bytes_;
+  return stats;
+}
+
+void ScanResultCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entryMap_.clear();
+  entries_.clear();
+  bytes_ = 0;
+}
+
+} // namespace facebook::velox::connector::hive
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include <list>
+#include <mutex>
+
+#include "velox/common/memory/Memory.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::connector::hive {
+
+/// Worker level cache of the decoded and filtered output of splits. Repeated
+/// scans of the same split with the same columns and filters, e.g. dashboard
+/// queries over immutable partitions, return the cached batches instead of
+/// reading and decoding the file again. The key identifies the split and the
+/// scan, see HiveDataSource. The cache assumes that the files do not change.
+///
+/// The batches are copied into a leaf pool owned by the cache and the least
+/// recently used entries are dropped so that the cache stays within
+/// 'maxBytes'.
+class ScanResultCache {
+ public:
+  struct Entry {
+    std::vector<RowVectorPtr> batches;
+    /// The number of rows read from the file to produce 'batches'.
+    uint64_t numScannedRows{0};
+    uint64_t bytes{0};
+  };
+
+  struct Stats {
+    uint64_t numHits{0};
+    uint64_t numMisses{0};
+    uint64_t numEvicts{0};
+    uint64_t numEntries{0};
+    uint64_t bytes{0};
+  };
+
+  explicit ScanResultCache(uint64_t maxBytes);
+
+  /// Returns the entry for 'key' or nullptr if not found.
+  std::shared_ptr<const Entry> find(const std::string& key);
+
+  /// Returns a copy of 'batch' allocated from the pool of 'this' to be passed
+  /// to put().
+  RowVectorPtr copy(const RowVectorPtr& batch);
+
+  /// Adds the 'batches' of copy() for 'key'. Drops 'batches' if their size
+  /// is over 1/4 of 'maxBytes'.
+  void put(
+      const std::string& key,
+      std::vector<RowVectorPtr> batches,
+      uint64_t numScannedRows);
+
+  /// Returns the largest size of the batches of one entry.
+  uint64_t maxEntryBytes() const {
+    return maxBytes_ / 4;
+  }
+
+  Stats stats() const;
+
+  /// Drops all entries.
+  void clear();
+
+ private:
+  using EntryList =
+      std::list<std::pair<std::string, std::shared_ptr<const Entry>>>;
+
+  // Drops least recently used entries until 'bytes_' is within 'maxBytes_'.
+  void evictLocked();
+
+  const uint64_t maxBytes_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  // Entries in order of last use, the most recently used first.
+  EntryList entries_;
+  folly::F14FastMap<std::string, EntryList::iterator> entryMap_;
+  uint64_t bytes_{0};
+  uint64_t numHits_{0};
+  uint64_t numMisses_{0};
+  uint64_t numEvicts_{0};
+};
+
+} // namespace facebook::velox::connector::hive
@@ -148,9 +148,15 @@ void SplitReader::prepareSplit(
     const dwio::common::ReaderOptions& readerOptions,
     std::unique_ptr<dwio::common::BufferedInput> baseFileInput,
     std::shared_ptr<common::MetadataFilter> metadataFilter,
-    dwio::common::RuntimeStatistics& runtimeStats) {
-  baseReader_ = dwio::common::getReaderFactory(readerOptions.getFileFormat())
-                    ->createReader(std::move(baseFileInput), readerOptions);
+    dwio::common::RuntimeStatistics& runtimeStats,
+    std::unique_ptr<dwio::common::Reader> baseReader) {
+  if (baseReader != nullptr) {
+    baseReader_ = std::move(baseReader);
+  } else {
+    baseReader_ =
+        dwio::common::getReaderFactory(readerOptions.getFileFormat())
+            ->createReader(std::move(baseFileInput), readerOptions);
+  }
 
   // Note that this doesn't apply to Hudi tables.
   emptySplit_ = false;
@@ -260,6 +266,13 @@ void SplitReader::resetSplit() {
   hiveSplit_.reset();
 }
 
+void SplitReader::setSplit(std::shared_ptr<HiveConnectorSplit> hiveSplit) {
+  hiveSplit_ = std::move(hiveSplit);
+  baseRowReader_.reset();
+  baseReader_.reset();
+  rowReaderOpts_ = dwio::common::RowReaderOptions();
+}
+
 int64_t SplitReader::estimatedRowSize() const {
   if (!baseRowReader_) {
     return DataSource::kUnknownRowSize;
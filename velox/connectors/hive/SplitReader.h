@@ -54,13 +54,20 @@ class SplitReader {
 
   /// This function is used by different table formats like Iceberg and Hudi to
   /// do additional preparations before reading the split, e.g. Open delete
-  /// files or log files, and add column adapatations for metadata columns
+  /// files or log files, and add column adapatations for metadata columns.
+  /// If 'baseReader' is set, it is the reader of the file of the split, e.g.
+  /// made ahead of time with the footer read, and 'baseFileInput' is not used.
   virtual void prepareSplit(
       const std::shared_ptr<HiveTableHandle>& hiveTableHandle,
       const dwio::common::ReaderOptions& readerOptions,
       std::unique_ptr<dwio::common::BufferedInput> baseFileInput,
       std::shared_ptr<common::MetadataFilter> metadataFilter,
-      dwio::common::RuntimeStatistics& runtimeStats);
+      dwio::common::RuntimeStatistics& runtimeStats,
+      std::unique_ptr<dwio::common::Reader> baseReader = nullptr);
+
+  /// Reuses the reader for 'hiveSplit', which is read after the next
+  /// prepareSplit(). Frees the readers of the previous split.
+  void setSplit(std::shared_ptr<HiveConnectorSplit> hiveSplit);
 
   virtual uint64_t next(int64_t size, VectorPtr& output);
 
@@ -76,6 +83,14 @@ class SplitReader {
 
   bool allPrefetchIssued() const;
 
+  /// Returns the reader of the file of the split or nullptr before
+  /// prepareSplit(). The statistics of the file describe the rows of the
+  /// split only if the split covers the whole file and the table format adds
+  /// no rows or deletes, e.g. from delete or log files.
+  const dwio::common::Reader* baseReader() const {
+    return baseReader_.get();
+  }
+
   std::string toString() const;
 
  protected:
@@ -102,6 +102,33 @@ void HiveColumnHandle::registerSerDe() {
   registry.Register("HiveColumnHandle", HiveColumnHandle::create);
 }
 
+std::string HiveStatsAggregate::toString() const {
+  return fmt::format(
+      "{}({})", kindName(kind), column.empty() ? "*" : column);
+}
+
+std::string HiveStatsAggregate::kindName(Kind kind) {
+  switch (kind) {
+    case Kind::kCount:
+      return "count";
+    case Kind::kMin:
+      return "min";
+    case Kind::kMax:
+      return "max";
+  }
+  VELOX_UNREACHABLE();
+}
+
+HiveStatsAggregate::Kind HiveStatsAggregate::kindFromName(
+    const std::string& name) {
+  static const std::unordered_map<std::string, Kind> kNameToKind = {
+      {"count", Kind::kCount}, {"min", Kind::kMin}, {"max", Kind::kMax}};
+  auto it = kNameToKind.find(name);
+  VELOX_USER_CHECK(
+      it != kNameToKind.end(), "Unknown stats aggregate: {}", name);
+  return it->second;
+}
+
 HiveTableHandle::HiveTableHandle(
     std::string connectorId,
     const std::string& tableName,
@@ -109,14 +136,18 @@ HiveTableHandle::HiveTableHandle(
     SubfieldFilters subfieldFilters,
     const core::TypedExprPtr& remainingFilter,
     const RowTypePtr& dataColumns,
-    const std::unordered_map<std::string, std::string>& tableParameters)
+    const std::unordered_map<std::string, std::string>& tableParameters,
+    const std::vector<std::string>& clusteringKeys,
+    const std::vector<HiveStatsAggregate>& statsAggregates)
     : ConnectorTableHandle(std::move(connectorId)),
       tableName_(tableName),
       filterPushdownEnabled_(filterPushdownEnabled),
       subfieldFilters_(std::move(subfieldFilters)),
       remainingFilter_(remainingFilter),
       dataColumns_(dataColumns),
-      tableParameters_(tableParameters) {}
+      tableParameters_(tableParameters),
+      clusteringKeys_(clusteringKeys),
+      statsAggregates_(statsAggregates) {}
 
 std::string HiveTableHandle::toString() const {
   std::stringstream out;
@@ -144,6 +175,20 @@ std::string HiveTableHandle::toString() const {
   if (dataColumns_) {
     out << ", data columns: " << dataColumns_->toString();
   }
+  if (!clusteringKeys_.empty()) {
+    out << ", clustered by: [";
+    for (auto i = 0; i < clusteringKeys_.size(); ++i) {
+      out << (i > 0 ? ", " : "") << clusteringKeys_[i];
+    }
+    out << "]";
+  }
+  if (!statsAggregates_.empty()) {
+    out << ", stats aggregates: [";
+    for (auto i = 0; i < statsAggregates_.size(); ++i) {
+      out << (i > 0 ? ", " : "") << statsAggregates_[i].toString();
+    }
+    out << "]";
+  }
   return out.str();
 }
 
@@ -167,6 +212,19 @@ folly::dynamic HiveTableHandle::serialize() const {
   if (dataColumns_) {
     obj["dataColumns"] = dataColumns_->serialize();
   }
+  if (!clusteringKeys_.empty()) {
+    obj["clusteringKeys"] = ISerializable::serialize(clusteringKeys_);
+  }
+  if (!statsAggregates_.empty()) {
+    folly::dynamic statsAggregates = folly::dynamic::array;
+    for (const auto& aggregate : statsAggregates_) {
+      folly::dynamic aggregateObj = folly::dynamic::object;
+      aggregateObj["kind"] = HiveStatsAggregate::kindName(aggregate.kind);
+      aggregateObj["column"] = aggregate.column;
+      statsAggregates.push_back(aggregateObj);
+    }
+    obj["statsAggregates"] = statsAggregates;
+  }
 
   return obj;
 }
@@ -199,13 +257,31 @@ ConnectorTableHandlePtr HiveTableHandle::create(
     dataColumns = ISerializable::deserialize<RowType>(it->second, context);
   }
 
+  std::vector<std::string> clusteringKeys;
+  if (auto it = obj.find("clusteringKeys"); it != obj.items().end()) {
+    clusteringKeys =
+        ISerializable::deserialize<std::vector<std::string>>(it->second);
+  }
+
+  std::vector<HiveStatsAggregate> statsAggregates;
+  if (auto it = obj.find("statsAggregates"); it != obj.items().end()) {
+    for (const auto& aggregateObj : it->second) {
+      statsAggregates.push_back(
+          {HiveStatsAggregate::kindFromName(aggregateObj["kind"].asString()),
+           aggregateObj["column"].asString()});
+    }
+  }
+
   return std::make_shared<const HiveTableHandle>(
       connectorId,
       tableName,
       filterPushdownEnabled,
       std::move(subfieldFilters),
       remainingFilter,
-      dataColumns);
+      dataColumns,
+      std::unordered_map<std::string, std::string>{},
+      clusteringKeys,
+      statsAggregates);
 }
 
 void HiveTableHandle::registerSerDe() {
@@ -53,7 +53,7 @@ class HiveColumnHandle : public ColumnHandle {
         hiveType_->toString());
   }
 
-  const std::string& name() const {
+  const std::string& name() const override {
     return name_;
   }
 
@@ -112,8 +112,30 @@ class HiveColumnHandle : public ColumnHandle {
   const std::vector<common::Subfield> requiredSubfields_;
 };
 
+/// An aggregate over all rows of a split that the scan may answer from the
+/// file statistics instead of reading the rows.
+struct HiveStatsAggregate {
+  enum class Kind { kCount, kMin, kMax };
+
+  Kind kind;
+  /// Name of the aggregated column in the file. Empty for count(*).
+  std::string column;
+
+  std::string toString() const;
+
+  static std::string kindName(Kind kind);
+
+  static Kind kindFromName(const std::string& name);
+};
+
 class HiveTableHandle : public ConnectorTableHandle {
  public:
+  /// If 'statsAggregates' is not empty, the scan produces one row per split or
+  /// batch of a split where column i is the value of 'statsAggregates[i]' over
+  /// the rows of the split or batch. The types of the output are BIGINT for
+  /// count and the column type in 'dataColumns' for min and max. The rows are
+  /// to be combined by a final aggregation with sum, min and max. There must be
+  /// no filters on columns other than partition keys.
   HiveTableHandle(
       std::string connectorId,
       const std::string& tableName,
@@ -121,7 +143,9 @@ class HiveTableHandle : public ConnectorTableHandle {
       SubfieldFilters subfieldFilters,
       const core::TypedExprPtr& remainingFilter,
       const RowTypePtr& dataColumns = nullptr,
-      const std::unordered_map<std::string, std::string>& tableParameters = {});
+      const std::unordered_map<std::string, std::string>& tableParameters = {},
+      const std::vector<std::string>& clusteringKeys = {},
+      const std::vector<HiveStatsAggregate>& statsAggregates = {});
 
   const std::string& tableName() const {
     return tableName_;
@@ -148,6 +172,17 @@ class HiveTableHandle : public ConnectorTableHandle {
     return tableParameters_;
   }
 
+  /// Bucketing and sorting columns of a bucketed table with sorted buckets.
+  /// Set only if each split has all the rows of a bucket and the splits of a
+  /// bucket are read by the same driver in order.
+  const std::vector<std::string>& clusteringKeys() const override {
+    return clusteringKeys_;
+  }
+
+  const std::vector<HiveStatsAggregate>& statsAggregates() const {
+    return statsAggregates_;
+  }
+
   std::string toString() const override;
 
   folly::dynamic serialize() const override;
@@ -165,6 +200,8 @@ class HiveTableHandle : public ConnectorTableHandle {
   const core::TypedExprPtr remainingFilter_;
   const RowTypePtr dataColumns_;
   const std::unordered_map<std::string, std::string> tableParameters_;
+  const std::vector<std::string> clusteringKeys_;
+  const std::vector<HiveStatsAggregate> statsAggregates_;
 };
 
 } // namespace facebook::velox::connector::hive
@@ -21,7 +21,11 @@
 #include "velox/core/Config.h"
 
 #include <fmt/format.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
+#include <deque>
 #include <memory>
 #include <stdexcept>
 
@@ -58,10 +62,33 @@ inline void checkGCSStatus(
   }
 }
 
+// Copies consecutive bytes of 'data' to the non-gap ranges of 'buffers'.
+void copyToBuffers(
+    const std::string& data,
+    const std::vector<folly::Range<char*>>& buffers) {
+  size_t dataOffset = 0;
+  for (auto range : buffers) {
+    if (range.data()) {
+      memcpy(range.data(), data.data() + dataOffset, range.size());
+    }
+    dataOffset += range.size();
+  }
+}
+
 class GCSReadFile final : public ReadFile {
  public:
-  GCSReadFile(const std::string& path, std::shared_ptr<gcs::Client> client)
-      : client_(std::move(client)) {
+  // If 'ioExecutor' is not nullptr, reads larger than 'readChunkSize' are
+  // split into range requests of 'readChunkSize' bytes that run in parallel
+  // on 'ioExecutor'. The tasks on 'ioExecutor' must not wait for other tasks.
+  GCSReadFile(
+      const std::string& path,
+      std::shared_ptr<gcs::Client> client,
+      folly::Executor* ioExecutor = nullptr,
+      uint64_t readChunkSize = 0)
+      : client_(std::move(client)),
+        ioExecutor_(ioExecutor),
+        readChunkSize_(readChunkSize) {
+    VELOX_CHECK(ioExecutor_ == nullptr || readChunkSize_ > 0);
     // assumption it's a proper path
     setBucketAndKeyFromGCSPath(path, bucket_, key_);
   }
@@ -88,14 +115,14 @@ class GCSReadFile final : public ReadFile {
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buffer)
       const override {
-    preadInternal(offset, length, static_cast<char*>(buffer));
+    preadChunks(offset, length, static_cast<char*>(buffer));
     return {static_cast<char*>(buffer), length};
   }
 
   std::string pread(uint64_t offset, uint64_t length) const override {
     std::string result(length, 0);
     char* position = result.data();
-    preadInternal(offset, length, position);
+    preadChunks(offset, length, position);
     return result;
   }
 
@@ -111,17 +138,33 @@ class GCSReadFile final : public ReadFile {
       length += range.size();
     }
     std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
-      }
-      resultOffset += range.size();
-    }
+    preadChunks(offset, length, static_cast<char*>(result.data()));
+    copyToBuffers(result, buffers);
     return length;
   }
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    if (ioExecutor_ == nullptr) {
+      return ReadFile::preadvAsync(offset, buffers);
+    }
+    size_t length = 0;
+    for (const auto range : buffers) {
+      length += range.size();
+    }
+    auto result = std::make_shared<std::string>(length, 0);
+    return preadChunksAsync(offset, length, result->data())
+        .deferValue([result, buffers, length](auto&& /*unused*/) {
+          copyToBuffers(*result, buffers);
+          return static_cast<uint64_t>(length);
+        });
+  }
+
+  bool hasPreadvAsync() const override {
+    return ioExecutor_ != nullptr;
+  }
+
   uint64_t size() const override {
     return length_;
   }
@@ -145,6 +188,39 @@ class GCSReadFile final : public ReadFile {
   }
 
  private:
+  // Reads 'length' bytes at 'offset' with one request or with parallel range
+  // requests if the read is large.
+  void preadChunks(uint64_t offset, uint64_t length, char* position) const {
+    if (ioExecutor_ == nullptr || length <= readChunkSize_) {
+      preadInternal(offset, length, position);
+      return;
+    }
+    preadChunksAsync(offset, length, position).get();
+  }
+
+  // Reads 'length' bytes at 'offset' with range requests of at most
+  // 'readChunkSize_' bytes on 'ioExecutor_'. The future is fulfilled after all
+  // the requests are complete, so that 'position' is not written to after a
+  // failure is reported.
+  folly::SemiFuture<folly::Unit>
+  preadChunksAsync(uint64_t offset, uint64_t length, char* position) const {
+    std::vector<folly::SemiFuture<folly::Unit>> chunks;
+    chunks.reserve((length + readChunkSize_ - 1) / readChunkSize_);
+    for (uint64_t begin = 0; begin < length; begin += readChunkSize_) {
+      const auto size = std::min<uint64_t>(readChunkSize_, length - begin);
+      chunks.push_back(
+          folly::via(ioExecutor_, [this, offset, begin, size, position]() {
+            preadInternal(offset + begin, size, position + begin);
+          }).semi());
+    }
+    return folly::collectAll(std::move(chunks))
+        .deferValue([](std::vector<folly::Try<folly::Unit>>&& results) {
+          for (auto& result : results) {
+            result.throwUnlessValue();
+          }
+        });
+  }
+
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
@@ -164,6 +240,8 @@ class GCSReadFile final : public ReadFile {
   }
 
   std::shared_ptr<gcs::Client> client_;
+  folly::Executor* const ioExecutor_;
+  const uint64_t readChunkSize_;
   std::string bucket_;
   std::string key_;
   std::atomic<int64_t> length_ = -1;
@@ -171,10 +249,20 @@ class GCSReadFile final : public ReadFile {
 
 class GCSWriteFile final : public WriteFile {
  public:
+  // If 'uploadExecutor' is not nullptr, the file is uploaded in parts of
+  // kUploadPartSize bytes. The parts are written as temporary objects in
+  // parallel on 'uploadExecutor' while the writer fills the next part and are
+  // composed into the file by close(). At most 'maxUploadsInFlight' parts are
+  // uploaded at a time.
   explicit GCSWriteFile(
       const std::string& path,
-      std::shared_ptr<gcs::Client> client)
-      : client_(client) {
+      std::shared_ptr<gcs::Client> client,
+      folly::Executor* uploadExecutor = nullptr,
+      int32_t maxUploadsInFlight = 0)
+      : client_(client),
+        uploadExecutor_(uploadExecutor),
+        maxUploadsInFlight_(maxUploadsInFlight) {
+    VELOX_CHECK(uploadExecutor_ == nullptr || maxUploadsInFlight_ > 0);
     setBucketAndKeyFromGCSPath(path, bucket_, key_);
   }
 
@@ -192,6 +280,11 @@ class GCSWriteFile final : public WriteFile {
     auto object_metadata = client_->GetObjectMetadata(bucket_, key_);
     VELOX_CHECK(!object_metadata.ok(), "File already exists");
 
+    if (uploadExecutor_ != nullptr) {
+      currentPart_.reserve(kUploadPartSize);
+      size_ = 0;
+      return;
+    }
     auto stream = client_->WriteObject(bucket_, key_);
     checkGCSStatus(
         stream.last_status(),
@@ -204,22 +297,31 @@ class GCSWriteFile final : public WriteFile {
 
   void append(const std::string_view data) override {
     VELOX_CHECK(isFileOpen(), "File is not open");
-    stream_ << data;
+    if (uploadExecutor_ != nullptr) {
+      abortOnFailure([&]() { appendParts(data); });
+    } else {
+      stream_ << data;
+    }
     size_ += data.size();
   }
 
   void flush() override {
-    if (isFileOpen()) {
+    if (isFileOpen() && uploadExecutor_ == nullptr) {
       stream_.flush();
     }
   }
 
   void close() override {
-    if (isFileOpen()) {
+    if (!isFileOpen()) {
+      return;
+    }
+    closed_ = true;
+    if (uploadExecutor_ == nullptr) {
       stream_.flush();
       stream_.Close();
-      closed_ = true;
+      return;
     }
+    abortOnFailure([&]() { composeParts(); });
   }
 
   uint64_t size() const override {
@@ -227,12 +329,125 @@ class GCSWriteFile final : public WriteFile {
   }
 
  private:
+  static constexpr uint64_t kUploadPartSize = 16 << 20;
+  // Maximum number of source objects of a GCS compose request.
+  static constexpr size_t kMaxComposeSources = 32;
+
   inline bool isFileOpen() {
-    return (!closed_ && stream_.IsOpen());
+    return !closed_ && (uploadExecutor_ != nullptr || stream_.IsOpen());
+  }
+
+  // Runs 'func' and closes the file without composing it if 'func' throws.
+  template <typename Func>
+  void abortOnFailure(Func func) {
+    try {
+      func();
+    } catch (const std::exception&) {
+      closed_ = true;
+      // The failures of the other uploads do not matter after a failure.
+      while (!uploadsInFlight_.empty()) {
+        std::move(uploadsInFlight_.front()).getTry();
+        uploadsInFlight_.pop_front();
+      }
+      deleteParts();
+      throw;
+    }
+  }
+
+  // Copies 'data' to 'currentPart_' and uploads each full part in the
+  // background.
+  void appendParts(std::string_view data) {
+    while (!data.empty()) {
+      const auto size = std::min<uint64_t>(
+          data.size(), kUploadPartSize - currentPart_.size());
+      currentPart_.append(data.data(), size);
+      data.remove_prefix(size);
+      if (currentPart_.size() == kUploadPartSize) {
+        uploadCurrentPart();
+      }
+    }
+  }
+
+  // Uploads 'currentPart_' as the next temporary object on
+  // 'uploadExecutor_'. Waits for the oldest upload if 'maxUploadsInFlight_'
+  // parts are being uploaded.
+  void uploadCurrentPart() {
+    if (uploadsInFlight_.size() >= maxUploadsInFlight_) {
+      std::move(uploadsInFlight_.front()).get();
+      uploadsInFlight_.pop_front();
+    }
+    auto part = std::make_shared<std::string>(std::move(currentPart_));
+    currentPart_ = std::string();
+    currentPart_.reserve(kUploadPartSize);
+    auto name = fmt::format("{}.velox-part-{}", key_, partNames_.size());
+    partNames_.push_back(name);
+    uploadsInFlight_.push_back(
+        folly::via(
+            uploadExecutor_,
+            [client = client_, bucket = bucket_, name, part]() {
+              auto metadata =
+                  client->InsertObject(bucket, name, std::move(*part));
+              checkGCSStatus(
+                  metadata.status(),
+                  "Failed to upload part of GCS object",
+                  bucket,
+                  name);
+            })
+            .semi());
+  }
+
+  // Uploads the last part, waits for all the parts and composes them into
+  // the file. A compose request takes at most kMaxComposeSources objects, so
+  // the parts after the first kMaxComposeSources are appended to the file in
+  // groups.
+  void composeParts() {
+    if (!currentPart_.empty() || partNames_.empty()) {
+      uploadCurrentPart();
+    }
+    while (!uploadsInFlight_.empty()) {
+      std::move(uploadsInFlight_.front()).get();
+      uploadsInFlight_.pop_front();
+    }
+    std::vector<gcs::ComposeSourceObject> sources;
+    for (const auto& name : partNames_) {
+      if (sources.size() == kMaxComposeSources) {
+        compose(sources);
+        sources = {gcs::ComposeSourceObject{key_, {}, {}}};
+      }
+      sources.push_back(gcs::ComposeSourceObject{name, {}, {}});
+    }
+    compose(sources);
+    deleteParts();
+  }
+
+  void compose(const std::vector<gcs::ComposeSourceObject>& sources) {
+    auto metadata = client_->ComposeObject(bucket_, sources, key_);
+    checkGCSStatus(
+        metadata.status(), "Failed to compose GCS object", bucket_, key_);
+  }
+
+  // Deletes the temporary objects of the parts.
+  void deleteParts() {
+    for (const auto& name : partNames_) {
+      auto status = client_->DeleteObject(bucket_, name);
+      if (!status.ok()) {
+        LOG(WARNING) << "Failed to delete part " << gcsURI(bucket_, name)
+                     << ": " << status.message();
+      }
+    }
+    partNames_.clear();
   }
 
   gcs::ObjectWriteStream stream_;
   std::shared_ptr<gcs::Client> client_;
+  // Runs the part uploads in the background. nullptr if the file is written
+  // with 'stream_'.
+  folly::Executor* const uploadExecutor_;
+  const size_t maxUploadsInFlight_;
+  std::string currentPart_;
+  // Names of the temporary objects of the parts in upload order.
+  std::vector<std::string> partNames_;
+  std::deque<folly::SemiFuture<folly::Unit>> uploadsInFlight_;
   std::string bucket_;
   std::string key_;
   std::atomic<int64_t> size_{-1};
@@ -249,7 +464,11 @@ class GCSFileSystem::Impl {
  public:
   Impl(const Config* config) : config_(config) {}
 
-  ~Impl() = default;
+  ~Impl() {
+    // The reads and uploads in progress use 'client_'.
+    ioExecutor_.reset();
+    uploadExecutor_.reset();
+  }
 
   // Use the input Config parameters and initialize the GCSClient.
   void initializeClient() {
@@ -262,6 +481,9 @@ class GCSFileSystem::Impl {
       options.set<gc::UnifiedCredentialsOption>(gc::MakeInsecureCredentials());
     }
     options.set<gcs::UploadBufferSizeOption>(kUploadBufferSize);
+    // Keeps a connection for each of the parallel requests.
+    options.set<gcs::ConnectionPoolSizeOption>(
+        HiveConfig::gcsMaxConnections(config_));
 
     auto endpointOverride = HiveConfig::gcsEndpoint(config_);
     if (!endpointOverride.empty()) {
@@ -277,15 +499,45 @@ class GCSFileSystem::Impl {
     }
 
     client_ = std::make_shared<gcs::Client>(options);
+    if (const auto numThreads = HiveConfig::gcsReadThreads(config_);
+        numThreads > 0) {
+      ioExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(
+          numThreads,
+          std::make_shared<folly::NamedThreadFactory>("GCSReadThread"));
+    }
+    if (const auto numThreads = HiveConfig::gcsUploadThreads(config_);
+        numThreads > 0) {
+      uploadExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(
+          numThreads,
+          std::make_shared<folly::NamedThreadFactory>("GCSUploadThread"));
+    }
   }
 
   std::shared_ptr<gcs::Client> getClient() const {
     return client_;
   }
 
+  folly::Executor* ioExecutor() const {
+    return ioExecutor_.get();
+  }
+
+  uint64_t readChunkSize() const {
+    return HiveConfig::gcsReadChunkSize(config_);
+  }
+
+  folly::Executor* uploadExecutor() const {
+    return uploadExecutor_.get();
+  }
+
+  int32_t maxUploadsInFlight() const {
+    return HiveConfig::gcsMaxUploadsInFlight(config_);
+  }
+
  private:
   const Config* FOLLY_NONNULL config_;
   std::shared_ptr<gcs::Client> client_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> uploadExecutor_;
 };
 
 GCSFileSystem::GCSFileSystem(std::shared_ptr<const Config> config)
@@ -301,7 +553,11 @@ std::unique_ptr<ReadFile> GCSFileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& /*unused*/) {
   const auto gcspath = gcsPath(path);
-  auto gcsfile = std::make_unique<GCSReadFile>(gcspath, impl_->getClient());
+  auto gcsfile = std::make_unique<GCSReadFile>(
+      gcspath,
+      impl_->getClient(),
+      impl_->ioExecutor(),
+      impl_->readChunkSize());
   gcsfile->initialize();
   return gcsfile;
 }
@@ -310,7 +566,11 @@ std::unique_ptr<WriteFile> GCSFileSystem::openFileForWrite(
     std::string_view path,
     const FileOptions& /*unused*/) {
   const auto gcspath = gcsPath(path);
-  auto gcsfile = std::make_unique<GCSWriteFile>(gcspath, impl_->getClient());
+  auto gcsfile = std::make_unique<GCSWriteFile>(
+      gcspath,
+      impl_->getClient(),
+      impl_->uploadExecutor(),
+      impl_->maxUploadsInFlight());
   gcsfile->initialize();
   return gcsfile;
 }
@@ -139,8 +139,8 @@ class GCSFileSystemTest : public testing::Test {
                              << ">, status=" << object.status();
   }
 
-  std::shared_ptr<const Config> testGcsOptions() const {
-    std::unordered_map<std::string, std::string> configOverride = {};
+  std::shared_ptr<const Config> testGcsOptions(
+      std::unordered_map<std::string, std::string> configOverride = {}) const {
 
     configOverride["hive.gcs.scheme"] = "http";
     configOverride["hive.gcs.endpoint"] = "localhost:" + testbench_->port();
@@ -211,6 +211,58 @@ TEST_F(GCSFileSystemTest, readFile) {
   ASSERT_EQ(std::string_view(buff3, sizeof(buff3)), kLoremIpsum.substr(80, 30));
 }
 
+TEST_F(GCSFileSystemTest, parallelRead) {
+  const std::string gcsFile =
+      gcsURI(preexistingBucketName(), preexistingObjectName());
+
+  // Splits the reads into range requests of 16 bytes.
+  filesystems::GCSFileSystem gcfs(testGcsOptions(
+      {{"hive.gcs.read-threads", "4"}, {"hive.gcs.read-chunk-size", "16"}}));
+  gcfs.initializeClient();
+  auto readFile = gcfs.openFileForRead(gcsFile);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  EXPECT_EQ(readFile->pread(0, readFile->size()), kLoremIpsum);
+  EXPECT_EQ(readFile->pread(10, 50), kLoremIpsum.substr(10, 50));
+
+  char buff1[10];
+  char buff2[50];
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(buff1, 10),
+      folly::Range<char*>(nullptr, 20),
+      folly::Range<char*>(buff2, 50)};
+  ASSERT_EQ(readFile->preadvAsync(5, buffers).get(), 10 + 20 + 50);
+  ASSERT_EQ(std::string_view(buff1, sizeof(buff1)), kLoremIpsum.substr(5, 10));
+  ASSERT_EQ(std::string_view(buff2, sizeof(buff2)), kLoremIpsum.substr(35, 50));
+}
+
+TEST_F(GCSFileSystemTest, parallelUpload) {
+  const std::string gcsFile =
+      gcsURI(preexistingBucketName(), "parallelUploadFile.txt");
+
+  filesystems::GCSFileSystem gcfs(testGcsOptions(
+      {{"hive.gcs.upload-threads", "2"},
+       {"hive.gcs.max-uploads-in-flight", "1"}}));
+  gcfs.initializeClient();
+  auto writeFile = gcfs.openFileForWrite(gcsFile);
+  // Two full parts and a partial one.
+  std::string dataContent;
+  for (auto i = 0; dataContent.size() < (33 << 20); ++i) {
+    dataContent += fmt::format("{} ", i);
+  }
+  writeFile->append(dataContent.substr(0, 10));
+  writeFile->append(dataContent.substr(10));
+  EXPECT_EQ(writeFile->size(), dataContent.size());
+  writeFile->close();
+
+  auto readFile = gcfs.openFileForRead(gcsFile);
+  EXPECT_EQ(readFile->size(), dataContent.size());
+  EXPECT_EQ(readFile->pread(0, dataContent.size()), dataContent);
+  // The temporary objects of the parts are deleted.
+  for (const auto& name : gcfs.list(gcsFile)) {
+    EXPECT_THAT(name, ::testing::Not(::testing::HasSubstr(".velox-part-")));
+  }
+}
+
 TEST_F(GCSFileSystemTest, writeAndReadFile) {
   const std::string newFile = "readWriteFile.txt";
   const std::string gcsFile = gcsURI(preexistingBucketName(), newFile);
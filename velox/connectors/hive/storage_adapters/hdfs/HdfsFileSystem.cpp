@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsFileSystem.h"
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <hdfs/hdfs.h>
 #include <mutex>
+#include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsReadFile.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsWriteFile.h"
 #include "velox/core/Config.h"
@@ -23,22 +26,43 @@
 namespace facebook::velox::filesystems {
 std::string_view HdfsFileSystem::kScheme("hdfs://");
 
+using namespace connector::hive;
+
 class HdfsFileSystem::Impl {
  public:
-  // Keep config here for possible use in the future.
   explicit Impl(const Config* config, const HdfsServiceEndpoint& endpoint) {
     auto builder = hdfsNewBuilder();
     hdfsBuilderSetNameNode(builder, endpoint.host.c_str());
     hdfsBuilderSetNameNodePort(builder, atoi(endpoint.port.data()));
+    const auto domainSocketPath = HiveConfig::hdfsDomainSocketPath(config);
+    if (HiveConfig::isHdfsShortCircuitRead(config)) {
+      VELOX_USER_CHECK(
+          !domainSocketPath.empty(),
+          "{} must be set for short-circuit reads",
+          HiveConfig::kHdfsDomainSocketPath);
+      hdfsBuilderConfSetStr(builder, "dfs.client.read.shortcircuit", "true");
+      hdfsBuilderConfSetStr(
+          builder, "dfs.domain.socket.path", domainSocketPath.c_str());
+    }
     hdfsClient_ = hdfsBuilderConnect(builder);
     VELOX_CHECK_NOT_NULL(
         hdfsClient_,
         "Unable to connect to HDFS: {}, got error: {}.",
         endpoint.identity(),
         hdfsGetLastError())
+    if (const auto numThreads = HiveConfig::hdfsHedgedReadThreads(config);
+        numThreads > 0) {
+      hedgedReadExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(
+          numThreads,
+          std::make_shared<folly::NamedThreadFactory>("HdfsHedgedRead"));
+      hedgedReadThreshold_ = std::chrono::milliseconds(
+          HiveConfig::hdfsHedgedReadThresholdMs(config));
+    }
   }
 
   ~Impl() {
+    // The hedged reads in progress use 'hdfsClient_'.
+    hedgedReadExecutor_.reset();
     LOG(INFO) << "Disconnecting HDFS file system";
     int disconnectResult = hdfsDisconnect(hdfsClient_);
     if (disconnectResult != 0) {
@@ -51,8 +75,18 @@ class HdfsFileSystem::Impl {
     return hdfsClient_;
   }
 
+  folly::Executor* hedgedReadExecutor() const {
+    return hedgedReadExecutor_.get();
+  }
+
+  std::chrono::milliseconds hedgedReadThreshold() const {
+    return hedgedReadThreshold_;
+  }
+
  private:
   hdfsFS hdfsClient_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> hedgedReadExecutor_;
+  std::chrono::milliseconds hedgedReadThreshold_{0};
 };
 
 HdfsFileSystem::HdfsFileSystem(
@@ -76,7 +110,11 @@ std::unique_ptr<ReadFile> HdfsFileSystem::openFileForRead(
     path.remove_prefix(index);
   }
 
-  return std::make_unique<HdfsReadFile>(impl_->hdfsClient(), path);
+  return std::make_unique<HdfsReadFile>(
+      impl_->hdfsClient(),
+      path,
+      impl_->hedgedReadExecutor(),
+      impl_->hedgedReadThreshold());
 }
 
 std::unique_ptr<WriteFile> HdfsFileSystem::openFileForWrite(
@@ -15,19 +15,80 @@
  */
 
 #include "HdfsReadFile.h"
+#include <folly/futures/Future.h>
 #include <folly/synchronization/CallOnce.h>
 #include <hdfs/hdfs.h>
+#include <mutex>
 
 namespace facebook::velox {
+namespace {
+// Reads 'length' bytes at the position of 'file' into 'pos'.
+void readFully(const HdfsFile& file, uint64_t length, char* pos) {
+  uint64_t totalBytesRead = 0;
+  while (totalBytesRead < length) {
+    auto bytesRead = file.read(pos, length - totalBytesRead);
+    totalBytesRead += bytesRead;
+    pos += bytesRead;
+  }
+}
+} // namespace
+
+class HdfsReadFile::StreamPool {
+ public:
+  StreamPool(hdfsFS client, const std::string& path)
+      : client_(client), path_(path) {}
 
-HdfsReadFile::HdfsReadFile(hdfsFS hdfs, const std::string_view path)
-    : hdfsClient_(hdfs), filePath_(path) {
+  // Reads 'length' bytes at 'offset' on a stream that no other read is using.
+  std::unique_ptr<std::string> read(uint64_t offset, uint64_t length) {
+    auto file = acquire();
+    auto data = std::make_unique<std::string>(length, 0);
+    file->seek(offset);
+    readFully(*file, length, data->data());
+    std::lock_guard<std::mutex> l(mutex_);
+    streams_.push_back(std::move(file));
+    return data;
+  }
+
+ private:
+  std::unique_ptr<HdfsFile> acquire() {
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (!streams_.empty()) {
+        auto file = std::move(streams_.back());
+        streams_.pop_back();
+        return file;
+      }
+    }
+    auto file = std::make_unique<HdfsFile>();
+    file->open(client_, path_);
+    return file;
+  }
+
+  const hdfsFS client_;
+  const std::string path_;
+  std::mutex mutex_;
+  // Streams not used by a read.
+  std::vector<std::unique_ptr<HdfsFile>> streams_;
+};
+
+HdfsReadFile::HdfsReadFile(
+    hdfsFS hdfs,
+    const std::string_view path,
+    folly::Executor* hedgedReadExecutor,
+    std::chrono::milliseconds hedgedReadThreshold)
+    : hdfsClient_(hdfs),
+      filePath_(path),
+      hedgedReadExecutor_(hedgedReadExecutor),
+      hedgedReadThreshold_(hedgedReadThreshold) {
   fileInfo_ = hdfsGetPathInfo(hdfsClient_, filePath_.data());
   VELOX_CHECK_NOT_NULL(
       fileInfo_,
       "Unable to get file path info for file: {}. got error: {}",
       filePath_,
       hdfsGetLastError());
+  if (hedgedReadExecutor_ != nullptr) {
+    streams_ = std::make_shared<StreamPool>(hdfsClient_, filePath_);
+  }
 }
 
 HdfsReadFile::~HdfsReadFile() {
@@ -38,16 +99,75 @@ HdfsReadFile::~HdfsReadFile() {
 void HdfsReadFile::preadInternal(uint64_t offset, uint64_t length, char* pos)
     const {
   checkFileReadParameters(offset, length);
+  if (hedgedReadExecutor_ != nullptr) {
+    auto data = hedgedRead(offset, length);
+    memcpy(pos, data->data(), length);
+    return;
+  }
+  file().seek(offset);
+  readFully(file(), length, pos);
+}
+
+const HdfsFile& HdfsReadFile::file() const {
   if (!file_->handle_) {
     file_->open(hdfsClient_, filePath_);
   }
-  file_->seek(offset);
-  uint64_t totalBytesRead = 0;
-  while (totalBytesRead < length) {
-    auto bytesRead = file_->read(pos, length - totalBytesRead);
-    totalBytesRead += bytesRead;
-    pos += bytesRead;
+  return *file_;
+}
+
+std::unique_ptr<std::string> HdfsReadFile::hedgedRead(
+    uint64_t offset,
+    uint64_t length) const {
+  auto read = [streams = streams_, offset, length]() {
+    return streams->read(offset, length);
+  };
+  auto primary = folly::via(hedgedReadExecutor_, read);
+  if (primary.wait(hedgedReadThreshold_).isReady()) {
+    return std::move(primary).get();
+  }
+  std::vector<folly::Future<std::unique_ptr<std::string>>> reads;
+  reads.push_back(std::move(primary));
+  reads.push_back(folly::via(hedgedReadExecutor_, read));
+  // The first read that succeeds. Throws if both fail. The other read
+  // completes in the background.
+  return folly::collectAnyWithoutException(std::move(reads)).get().second;
+}
+
+uint64_t HdfsReadFile::preadv(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  const auto fileSize = size();
+  if (offset >= fileSize) {
+    return 0;
+  }
+  uint64_t length = 0;
+  for (const auto& range : buffers) {
+    length += range.size();
+  }
+  length = std::min<uint64_t>(length, fileSize - offset);
+  // A hedged read covers the whole range, including the gaps.
+  std::unique_ptr<std::string> data;
+  if (hedgedReadExecutor_ != nullptr) {
+    data = hedgedRead(offset, length);
+  } else {
+    file().seek(offset);
+  }
+  uint64_t numRead = 0;
+  for (const auto& range : buffers) {
+    const auto copySize = std::min<uint64_t>(range.size(), length - numRead);
+    if (data != nullptr) {
+      if (range.data() != nullptr) {
+        memcpy(range.data(), data->data() + numRead, copySize);
+      }
+    } else if (range.data() != nullptr) {
+      readFully(file(), copySize, range.data());
+    } else if (numRead + copySize < length) {
+      // Skips the gap between coalesced ranges.
+      file().seek(offset + numRead + copySize);
+    }
+    numRead += copySize;
   }
+  return numRead;
 }
 
 std::string_view
@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 
+#include <folly/Executor.h>
 #include <hdfs/hdfs.h>
+#include <chrono>
 #include "velox/common/file/File.h"
 
 namespace facebook::velox {
@@ -57,10 +59,21 @@ struct HdfsFile {
 
 /**
  * Implementation of hdfs read file.
+ *
+ * If 'hedgedReadExecutor' is set, reads are made on 'hedgedReadExecutor' and a
+ * read that is not done after 'hedgedReadThreshold' is issued again on another
+ * stream. The first of the two to complete is returned, which cuts the tail
+ * latency of reads from a slow datanode. The tasks on 'hedgedReadExecutor'
+ * must not wait for other tasks.
  */
 class HdfsReadFile final : public ReadFile {
  public:
-  explicit HdfsReadFile(hdfsFS hdfs, std::string_view path);
+  explicit HdfsReadFile(
+      hdfsFS hdfs,
+      std::string_view path,
+      folly::Executor* hedgedReadExecutor = nullptr,
+      std::chrono::milliseconds hedgedReadThreshold =
+          std::chrono::milliseconds(0));
   ~HdfsReadFile() override;
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buf)
@@ -68,6 +81,12 @@ class HdfsReadFile final : public ReadFile {
 
   std::string pread(uint64_t offset, uint64_t length) const final;
 
+  /// Reads the coalesced ranges of 'buffers' with one seek and skips the gaps
+  /// without reading them.
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
   uint64_t size() const final;
 
   uint64_t memoryUsage() const final;
@@ -83,13 +102,28 @@ class HdfsReadFile final : public ReadFile {
   }
 
  private:
+  // Open streams of the file for reads on 'hedgedReadExecutor_'. Shared with
+  // the reads in progress, which may outlive the file.
+  class StreamPool;
+
   void preadInternal(uint64_t offset, uint64_t length, char* pos) const;
   void checkFileReadParameters(uint64_t offset, uint64_t length) const;
 
+  // Returns the thread local stream, opening it if needed.
+  const HdfsFile& file() const;
+
+  // Reads 'length' bytes at 'offset' on 'hedgedReadExecutor_', hedging the
+  // read if it takes longer than 'hedgedReadThreshold_'.
+  std::unique_ptr<std::string> hedgedRead(uint64_t offset, uint64_t length)
+      const;
+
   hdfsFS hdfsClient_;
   hdfsFileInfo* fileInfo_;
   std::string filePath_;
   folly::ThreadLocal<HdfsFile> file_;
+  folly::Executor* const hedgedReadExecutor_;
+  const std::chrono::milliseconds hedgedReadThreshold_;
+  std::shared_ptr<StreamPool> streams_;
 };
 
 } // namespace facebook::velox
@@ -15,6 +15,7 @@
  */
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsFileSystem.h"
 #include <boost/format.hpp>
+#include <folly/executors/IOThreadPoolExecutor.h>
 #include <gmock/gmock-matchers.h>
 #include <hdfs/hdfs.h>
 #include <atomic>
@@ -177,6 +178,41 @@ TEST_F(HdfsFileSystemTest, read) {
   readData(&readFile);
 }
 
+TEST_F(HdfsFileSystemTest, hedgedRead) {
+  struct hdfsBuilder* builder = hdfsNewBuilder();
+  hdfsBuilderSetNameNode(builder, localhost.c_str());
+  hdfsBuilderSetNameNodePort(builder, 7878);
+  auto hdfs = hdfsBuilderConnect(builder);
+  folly::IOThreadPoolExecutor executor(2);
+  // A threshold of 0 hedges all reads.
+  HdfsReadFile readFile(
+      hdfs, destinationPath, &executor, std::chrono::milliseconds(0));
+  readData(&readFile);
+}
+
+TEST_F(HdfsFileSystemTest, preadv) {
+  struct hdfsBuilder* builder = hdfsNewBuilder();
+  hdfsBuilderSetNameNode(builder, localhost.c_str());
+  hdfsBuilderSetNameNodePort(builder, 7878);
+  auto hdfs = hdfsBuilderConnect(builder);
+  folly::IOThreadPoolExecutor executor(2);
+  HdfsReadFile readFile(hdfs, destinationPath);
+  HdfsReadFile hedgedReadFile(
+      hdfs, destinationPath, &executor, std::chrono::milliseconds(0));
+  for (auto* file : {&readFile, &hedgedReadFile}) {
+    char head[3];
+    char tail[7];
+    // Skips 'cccc...' between the ranges.
+    std::vector<folly::Range<char*>> buffers = {
+        {head, sizeof(head)},
+        {nullptr, 2 + kOneMB},
+        {tail, sizeof(tail)}};
+    ASSERT_EQ(file->preadv(3, buffers), 12 + kOneMB);
+    ASSERT_EQ(std::string_view(head, sizeof(head)), "aab");
+    ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+  }
+}
+
 TEST_F(HdfsFileSystemTest, viaFileSystem) {
   auto memConfig = std::make_shared<const core::MemConfig>(configurationValues);
   auto hdfsFileSystem =
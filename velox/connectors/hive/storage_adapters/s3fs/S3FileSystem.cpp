@@ -23,7 +23,11 @@
 #include "velox/dwio/common/DataBuffer.h"
 
 #include <fmt/format.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
+#include <deque>
 #include <memory>
 #include <stdexcept>
 
@@ -34,6 +38,7 @@
 #include <aws/core/utils/stream/PreallocatedStreamBuf.h>
 #include <aws/identity-management/auth/STSAssumeRoleCredentialsProvider.h>
 #include <aws/s3/S3Client.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
 #include <aws/s3/model/CompleteMultipartUploadRequest.h>
 #include <aws/s3/model/CompletedMultipartUpload.h>
 #include <aws/s3/model/CompletedPart.h>
@@ -72,8 +77,18 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
 // TODO: Implement retry on failure.
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(const std::string& path, Aws::S3::S3Client* client)
-      : client_(client) {
+  // If 'ioExecutor' is not nullptr, reads larger than 'readChunkSize' are
+  // split into ranged GETs of 'readChunkSize' bytes that run in parallel on
+  // 'ioExecutor'. The tasks on 'ioExecutor' must not wait for other tasks.
+  S3ReadFile(
+      const std::string& path,
+      Aws::S3::S3Client* client,
+      folly::Executor* ioExecutor = nullptr,
+      uint64_t readChunkSize = 0)
+      : client_(client),
+        ioExecutor_(ioExecutor),
+        readChunkSize_(readChunkSize) {
+    VELOX_CHECK(ioExecutor_ == nullptr || readChunkSize_ > 0);
     getBucketAndKeyFromS3Path(path, bucket_, key_);
   }
 
@@ -98,14 +113,14 @@ class S3ReadFile final : public ReadFile {
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buffer)
       const override {
-    preadInternal(offset, length, static_cast<char*>(buffer));
+    preadChunks(offset, length, static_cast<char*>(buffer));
     return {static_cast<char*>(buffer), length};
   }
 
   std::string pread(uint64_t offset, uint64_t length) const override {
     std::string result(length, 0);
     char* position = result.data();
-    preadInternal(offset, length, position);
+    preadChunks(offset, length, position);
     return result;
   }
 
@@ -124,17 +139,33 @@ class S3ReadFile final : public ReadFile {
     }
     // TODO: allocate from a memory pool
     std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
-      }
-      resultOffset += range.size();
-    }
+    preadChunks(offset, length, static_cast<char*>(result.data()));
+    copyToBuffers(result, buffers);
     return length;
   }
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    if (ioExecutor_ == nullptr) {
+      return ReadFile::preadvAsync(offset, buffers);
+    }
+    size_t length = 0;
+    for (const auto range : buffers) {
+      length += range.size();
+    }
+    auto result = std::make_shared<std::string>(length, 0);
+    return preadChunksAsync(offset, length, result->data())
+        .deferValue([result, buffers, length](auto&& /*unused*/) {
+          copyToBuffers(*result, buffers);
+          return static_cast<uint64_t>(length);
+        });
+  }
+
+  bool hasPreadvAsync() const override {
+    return ioExecutor_ != nullptr;
+  }
+
   uint64_t size() const override {
     return length_;
   }
@@ -158,6 +189,52 @@ class S3ReadFile final : public ReadFile {
   }
 
  private:
+  // Copies consecutive bytes of 'data' to the non-gap ranges of 'buffers'.
+  static void copyToBuffers(
+      const std::string& data,
+      const std::vector<folly::Range<char*>>& buffers) {
+    size_t dataOffset = 0;
+    for (auto range : buffers) {
+      if (range.data()) {
+        memcpy(range.data(), data.data() + dataOffset, range.size());
+      }
+      dataOffset += range.size();
+    }
+  }
+
+  // Reads 'length' bytes at 'offset' with one GET or with parallel ranged
+  // GETs if the read is large.
+  void preadChunks(uint64_t offset, uint64_t length, char* position) const {
+    if (ioExecutor_ == nullptr || length <= readChunkSize_) {
+      preadInternal(offset, length, position);
+      return;
+    }
+    preadChunksAsync(offset, length, position).get();
+  }
+
+  // Reads 'length' bytes at 'offset' with ranged GETs of at most
+  // 'readChunkSize_' bytes on 'ioExecutor_'. The future is fulfilled after all
+  // the GETs are complete, so that 'position' is not written to after a
+  // failure is reported.
+  folly::SemiFuture<folly::Unit>
+  preadChunksAsync(uint64_t offset, uint64_t length, char* position) const {
+    std::vector<folly::SemiFuture<folly::Unit>> chunks;
+    chunks.reserve((length + readChunkSize_ - 1) / readChunkSize_);
+    for (uint64_t begin = 0; begin < length; begin += readChunkSize_) {
+      const auto size = std::min<uint64_t>(readChunkSize_, length - begin);
+      chunks.push_back(
+          folly::via(ioExecutor_, [this, offset, begin, size, position]() {
+            preadInternal(offset + begin, size, position + begin);
+          }).semi());
+    }
+    return folly::collectAll(std::move(chunks))
+        .deferValue([](std::vector<folly::Try<folly::Unit>>&& results) {
+          for (auto& result : results) {
+            result.throwUnlessValue();
+          }
+        });
+  }
+
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
@@ -177,6 +254,8 @@ class S3ReadFile final : public ReadFile {
   }
 
   Aws::S3::S3Client* client_;
+  folly::Executor* const ioExecutor_;
+  const uint64_t readChunkSize_;
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
@@ -214,13 +293,18 @@ class S3WriteFile::Impl {
   explicit Impl(
       const std::string& path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool)
-      : client_(client), pool_(pool) {
+      memory::MemoryPool* pool,
+      folly::Executor* uploadExecutor,
+      int32_t maxUploadsInFlight)
+      : client_(client),
+        pool_(pool),
+        uploadExecutor_(uploadExecutor),
+        maxUploadsInFlight_(maxUploadsInFlight) {
     VELOX_CHECK_NOT_NULL(client);
     VELOX_CHECK_NOT_NULL(pool);
+    VELOX_CHECK(uploadExecutor_ == nullptr || maxUploadsInFlight_ > 0);
     getBucketAndKeyFromS3Path(path, bucket_, key_);
-    currentPart_ = std::make_unique<dwio::common::DataBuffer<char>>(*pool_);
-    currentPart_->reserve(kPartUploadSize);
+    currentPart_ = makePartBuffer();
     // Check that the object doesn't exist, if it does throw an error.
     {
       Aws::S3::Model::HeadObjectRequest request;
@@ -265,15 +349,32 @@ class S3WriteFile::Impl {
     fileSize_ = 0;
   }
 
+  ~Impl() {
+    // A file that is not closed, e.g. because its writer failed, does not
+    // leave an incomplete upload behind.
+    if (!closed()) {
+      try {
+        abort();
+      } catch (const std::exception& e) {
+        LOG(WARNING) << "Failed to abort S3 upload of " << bucket_ << "/"
+                     << key_ << ": " << e.what();
+      }
+    }
+  }
+
   // Appends data to the end of the file.
   void append(std::string_view data) {
     VELOX_CHECK(!closed(), "File is closed");
-    if (data.size() + currentPart_->size() >= kPartUploadSize) {
-      upload(data);
-    } else {
-      // Append to current part.
-      currentPart_->unsafeAppend(data.data(), data.size());
-    }
+    abortOnFailure([&]() {
+      if (uploadExecutor_ != nullptr) {
+        appendAsync(data);
+      } else if (data.size() + currentPart_->size() >= kPartUploadSize) {
+        upload(data);
+      } else {
+        // Append to current part.
+        currentPart_->unsafeAppend(data.data(), data.size());
+      }
+    });
     fileSize_ += data.size();
   }
 
@@ -290,10 +391,14 @@ class S3WriteFile::Impl {
     if (closed()) {
       return;
     }
-    uploadPart({currentPart_->data(), currentPart_->size()}, true);
-    VELOX_CHECK_EQ(uploadState_.partNumber, uploadState_.completedParts.size());
-    // Complete the multipart upload.
-    {
+    abortOnFailure([&]() {
+      while (!uploadsInFlight_.empty()) {
+        waitForOldestUpload();
+      }
+      uploadPart({currentPart_->data(), currentPart_->size()}, true);
+      VELOX_CHECK_EQ(
+          uploadState_.partNumber, uploadState_.completedParts.size());
+      // Complete the multipart upload.
       Aws::S3::Model::CompletedMultipartUpload completedUpload;
       completedUpload.SetParts(uploadState_.completedParts);
       Aws::S3::Model::CompleteMultipartUploadRequest request;
@@ -305,7 +410,7 @@ class S3WriteFile::Impl {
       auto outcome = client_->CompleteMultipartUpload(request);
       VELOX_CHECK_AWS_OUTCOME(
           outcome, "Failed to complete multiple part upload", bucket_, key_);
-    }
+    });
     currentPart_->clear();
   }
 
@@ -335,6 +440,92 @@ class S3WriteFile::Impl {
   };
   UploadState uploadState_;
 
+  // A part being uploaded on 'uploadExecutor_'.
+  struct UploadInFlight {
+    folly::SemiFuture<Aws::S3::Model::CompletedPart> completedPart;
+    // The data of the part. Allocated from 'pool_' so that the memory of the
+    // uploads in flight is accounted to the writer.
+    std::unique_ptr<dwio::common::DataBuffer<char>> part;
+  };
+
+  std::unique_ptr<dwio::common::DataBuffer<char>> makePartBuffer() const {
+    auto buffer = std::make_unique<dwio::common::DataBuffer<char>>(*pool_);
+    buffer->reserve(kPartUploadSize);
+    return buffer;
+  }
+
+  // Runs 'func' and aborts the upload if it throws.
+  template <typename Func>
+  void abortOnFailure(Func func) {
+    try {
+      func();
+    } catch (const std::exception&) {
+      try {
+        abort();
+      } catch (const std::exception& abortError) {
+        LOG(WARNING) << "Failed to abort S3 upload of " << bucket_ << "/"
+                     << key_ << ": " << abortError.what();
+      }
+      throw;
+    }
+  }
+
+  // Waits for the uploads in flight, aborts the multipart upload and closes
+  // the file. S3 frees the uploaded parts.
+  void abort() {
+    while (!uploadsInFlight_.empty()) {
+      // The failures of the other uploads do not matter after a failure.
+      std::move(uploadsInFlight_.front().completedPart).getTry();
+      uploadsInFlight_.pop_front();
+    }
+    currentPart_->clear();
+    Aws::S3::Model::AbortMultipartUploadRequest request;
+    request.SetBucket(awsString(bucket_));
+    request.SetKey(awsString(key_));
+    request.SetUploadId(uploadState_.id);
+    auto outcome = client_->AbortMultipartUpload(request);
+    VELOX_CHECK_AWS_OUTCOME(
+        outcome, "Failed to abort multiple part upload", bucket_, key_);
+  }
+
+  // Copies 'data' to 'currentPart_' and uploads each full part in the
+  // background. Waits for the oldest upload if 'maxUploadsInFlight_' parts
+  // are being uploaded.
+  void appendAsync(std::string_view data) {
+    while (!data.empty()) {
+      const auto size = std::min<uint64_t>(
+          data.size(), kPartUploadSize - currentPart_->size());
+      currentPart_->unsafeAppend(data.data(), size);
+      data.remove_prefix(size);
+      if (currentPart_->size() < kPartUploadSize) {
+        continue;
+      }
+      if (uploadsInFlight_.size() >= maxUploadsInFlight_) {
+        waitForOldestUpload();
+      }
+      // Allocated first so that 'currentPart_' is set if this throws.
+      auto nextPart = makePartBuffer();
+      const auto partNumber = ++uploadState_.partNumber;
+      const std::string_view part(currentPart_->data(), currentPart_->size());
+      auto completedPart =
+          folly::via(uploadExecutor_, [this, partNumber, part]() {
+            return uploadPartRequest(partNumber, part);
+          }).semi();
+      uploadsInFlight_.push_back(
+          {std::move(completedPart), std::move(currentPart_)});
+      currentPart_ = std::move(nextPart);
+    }
+  }
+
+  // Waits for the oldest upload in flight and throws if it failed. The uploads
+  // finish in part number order for 'completedParts'.
+  void waitForOldestUpload() {
+    auto upload = std::move(uploadsInFlight_.front());
+    uploadsInFlight_.pop_front();
+    uploadState_.completedParts.push_back(
+        std::move(upload.completedPart).get());
+  }
+
   // Data can be smaller or larger than the kPartUploadSize.
   // Complete the currentPart_ and upload kPartUploadSize chunks of data.
   // Save the remaining into currentPart_.
@@ -359,31 +550,40 @@ class S3WriteFile::Impl {
   void uploadPart(const std::string_view part, bool isLast = false) {
     // Only the last part can be less than kPartUploadSize.
     VELOX_CHECK(isLast || (!isLast && (part.size() == kPartUploadSize)));
-    // Upload the part.
-    {
-      Aws::S3::Model::UploadPartRequest request;
-      request.SetBucket(bucket_);
-      request.SetKey(key_);
-      request.SetUploadId(uploadState_.id);
-      request.SetPartNumber(++uploadState_.partNumber);
-      request.SetContentLength(part.size());
-      request.SetBody(
-          std::make_shared<StringViewStream>(part.data(), part.size()));
-      auto outcome = client_->UploadPart(request);
-      VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to upload", bucket_, key_);
-      // Append ETag and part number for this uploaded part.
-      // This will be needed for upload completion in Close().
-      auto result = outcome.GetResult();
-      Aws::S3::Model::CompletedPart part;
-
-      part.SetPartNumber(uploadState_.partNumber);
-      part.SetETag(result.GetETag());
-      uploadState_.completedParts.push_back(std::move(part));
-    }
+    // Append ETag and part number for this uploaded part.
+    // This will be needed for upload completion in Close().
+    uploadState_.completedParts.push_back(
+        uploadPartRequest(++uploadState_.partNumber, part));
+  }
+
+  // Uploads 'part' as part 'partNumber'. Only reads the members that do not
+  // change during the upload, so that this can run on 'uploadExecutor_'.
+  Aws::S3::Model::CompletedPart uploadPartRequest(
+      int64_t partNumber,
+      const std::string_view part) const {
+    Aws::S3::Model::UploadPartRequest request;
+    request.SetBucket(bucket_);
+    request.SetKey(key_);
+    request.SetUploadId(uploadState_.id);
+    request.SetPartNumber(partNumber);
+    request.SetContentLength(part.size());
+    request.SetBody(
+        std::make_shared<StringViewStream>(part.data(), part.size()));
+    auto outcome = client_->UploadPart(request);
+    VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to upload", bucket_, key_);
+    Aws::S3::Model::CompletedPart completedPart;
+    completedPart.SetPartNumber(partNumber);
+    completedPart.SetETag(outcome.GetResult().GetETag());
+    return completedPart;
   }
 
   Aws::S3::S3Client* client_;
   memory::MemoryPool* pool_;
+  // Runs the part uploads in the background. nullptr if parts are uploaded
+  // by append().
+  folly::Executor* const uploadExecutor_;
+  const size_t maxUploadsInFlight_;
+  std::deque<UploadInFlight> uploadsInFlight_;
   std::unique_ptr<dwio::common::DataBuffer<char>> currentPart_;
   std::string bucket_;
   std::string key_;
@@ -393,8 +593,11 @@ class S3WriteFile::Impl {
 S3WriteFile::S3WriteFile(
     const std::string& path,
     Aws::S3::S3Client* client,
-    memory::MemoryPool* pool) {
-  impl_ = std::make_shared<Impl>(path, client, pool);
+    memory::MemoryPool* pool,
+    folly::Executor* uploadExecutor,
+    int32_t maxUploadsInFlight) {
+  impl_ = std::make_shared<Impl>(
+      path, client, pool, uploadExecutor, maxUploadsInFlight);
 }
 
 void S3WriteFile::append(std::string_view data) {
@@ -516,6 +719,7 @@ class S3FileSystem::Impl {
     } else {
       clientConfig.scheme = Aws::Http::Scheme::HTTP;
     }
+    clientConfig.maxConnections = HiveConfig::s3MaxConnections(config_);
 
     auto credentialsProvider = getCredentialsProvider();
 
@@ -524,10 +728,25 @@ class S3FileSystem::Impl {
         clientConfig,
         Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy::Never,
         HiveConfig::s3UseVirtualAddressing(config_));
+    if (const auto numThreads = HiveConfig::s3ReadThreads(config_);
+        numThreads > 0) {
+      ioExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(
+          numThreads,
+          std::make_shared<folly::NamedThreadFactory>("S3ReadThread"));
+    }
+    if (const auto numThreads = HiveConfig::s3UploadThreads(config_);
+        numThreads > 0) {
+      uploadExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(
+          numThreads,
+          std::make_shared<folly::NamedThreadFactory>("S3UploadThread"));
+    }
     ++fileSystemCount;
   }
 
   ~Impl() {
+    // The reads and uploads in progress use 'client_'.
+    ioExecutor_.reset();
+    uploadExecutor_.reset();
     client_.reset();
     --fileSystemCount;
   }
@@ -606,9 +825,31 @@ class S3FileSystem::Impl {
     return getAwsInstance()->getLogLevelName();
   }
 
+  // Returns the executor for parallel ranged GETs or nullptr if reads are not
+  // split.
+  folly::Executor* ioExecutor() const {
+    return ioExecutor_.get();
+  }
+
+  uint64_t readChunkSize() const {
+    return HiveConfig::s3ReadChunkSize(config_);
+  }
+
+  // Returns the executor for background part uploads or nullptr if parts are
+  // uploaded by the writing thread.
+  folly::Executor* uploadExecutor() const {
+    return uploadExecutor_.get();
+  }
+
+  int32_t maxUploadsInFlight() const {
+    return HiveConfig::s3MaxUploadsInFlight(config_);
+  }
+
  private:
   const Config* config_;
   std::shared_ptr<Aws::S3::S3Client> client_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> uploadExecutor_;
 };
 
 S3FileSystem::S3FileSystem(std::shared_ptr<const Config> config)
@@ -624,7 +865,8 @@ std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& /*unused*/) {
   const auto file = s3Path(path);
-  auto s3file = std::make_unique<S3ReadFile>(file, impl_->s3Client());
+  auto s3file = std::make_unique<S3ReadFile>(
+      file, impl_->s3Client(), impl_->ioExecutor(), impl_->readChunkSize());
   s3file->initialize();
   return s3file;
 }
@@ -633,8 +875,12 @@ std::unique_ptr<WriteFile> S3FileSystem::openFileForWrite(
     std::string_view path,
     const FileOptions& options) {
   const auto file = s3Path(path);
-  auto s3file =
-      std::make_unique<S3WriteFile>(file, impl_->s3Client(), options.pool);
+  auto s3file = std::make_unique<S3WriteFile>(
+      file,
+      impl_->s3Client(),
+      options.pool,
+      impl_->uploadExecutor(),
+      impl_->maxUploadsInFlight());
   return s3file;
 }
 
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/common/file/File.h"
 #include "velox/common/memory/MemoryPool.h"
 
@@ -42,24 +44,33 @@ namespace facebook::velox::filesystems {
 /// https://docs.aws.amazon.com/AmazonS3/latest/userguide/mpuoverview.html
 /// https://github.com/apache/arrow/blob/main/cpp/src/arrow/filesystem/s3fs.cc
 /// S3WriteFile is not thread-safe.
-/// UploadPart is currently synchronous during append and flush.
-/// TODO: Evaluate and add option for asynchronous part uploads.
+/// If an upload executor is given, the full parts are uploaded in the
+/// background on it while append() fills the next part, with at most
+/// 'maxUploadsInFlight' parts being uploaded at a time. The parts in flight
+/// are allocated from 'pool'. Otherwise, UploadPart is synchronous during
+/// append.
+/// A failed upload aborts the multipart upload and so does destroying the file
+/// without closing it.
 /// TODO: Implement retry on failure.
 class S3WriteFile : public WriteFile {
  public:
   S3WriteFile(
       const std::string& path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      folly::Executor* uploadExecutor = nullptr,
+      int32_t maxUploadsInFlight = 0);
 
   /// Appends data to the end of the file.
-  /// Uploads a part on reaching part size limit.
+  /// Uploads a part on reaching part size limit. Waits for the oldest part
+  /// upload in the background if the maximum number of parts are in flight.
   void append(std::string_view data) override;
 
   /// No-op. Append handles the flush.
   void flush() override;
 
-  /// Close the file. Any cleanup (disk flush, etc.) will be done here.
+  /// Close the file. Any cleanup (disk flush, etc.) will be done here. Waits
+  /// for the part uploads in the background.
   void close() override;
 
   /// Current file size, i.e. the sum of all previous Appends.
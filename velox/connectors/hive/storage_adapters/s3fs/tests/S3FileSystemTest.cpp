@@ -60,6 +60,38 @@ TEST_F(S3FileSystemTest, writeAndRead) {
   readData(readFile.get());
 }
 
+TEST_F(S3FileSystemTest, parallelRead) {
+  const char* bucketName = "paralleldata";
+  const char* file = "test.txt";
+  const std::string filename = localPath(bucketName) + "/" + file;
+  const std::string s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  // Reads of more than 100K are split into parallel GETs.
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.read-threads", "4"}, {"hive.s3.read-chunk-size", "100000"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  readData(readFile.get());
+
+  char head[10];
+  std::string middle(kOneMB, 0);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head, sizeof(head)),
+      folly::Range<char*>(middle.data(), middle.size())};
+  ASSERT_EQ(kOneMB + 10, readFile->preadvAsync(0, buffers).get());
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbb");
+  ASSERT_EQ(middle, std::string(kOneMB, 'c'));
+
+  // A failed GET fails the read.
+  VELOX_ASSERT_THROW(
+      readFile->pread(kOneMB, 2 * kOneMB), "Failed to get S3 object");
+}
+
 TEST_F(S3FileSystemTest, invalidCredentialsConfig) {
   {
     const std::unordered_map<std::string, std::string> config(
@@ -250,3 +282,44 @@ TEST_F(S3FileSystemTest, writeFileAndRead) {
   // Verify the last chunk.
   ASSERT_EQ(readFile->pread(contentSize * 250'000, contentSize), dataContent);
 }
+
+TEST_F(S3FileSystemTest, writeFileInBackground) {
+  const auto bucketName = "writedatainbackground";
+  const auto s3File = s3URI(bucketName, "test.txt");
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.upload-threads", "2"},
+       {"hive.s3.max-uploads-in-flight", "2"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  auto pool = memory::defaultMemoryManager().addLeafPool("S3FileSystemTest");
+  auto writeFile = s3fs.openFileForWrite(s3File, {{}, pool.get()});
+  auto s3WriteFile = dynamic_cast<filesystems::S3WriteFile*>(writeFile.get());
+
+  // 25MiB make 2 full parts that are held in 'pool' while in flight.
+  constexpr int64_t kPartSize = 10 << 20;
+  std::string data(25 << 20, 'a');
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = 'a' + i % 26;
+  }
+  writeFile->append({data.data(), 1 << 20});
+  writeFile->append({data.data() + (1 << 20), data.size() - (1 << 20)});
+  EXPECT_EQ(s3WriteFile->numPartsUploaded(), 2);
+  EXPECT_GE(pool->currentBytes(), 3 * kPartSize);
+  writeFile->close();
+  EXPECT_EQ(s3WriteFile->numPartsUploaded(), 3);
+  EXPECT_EQ(pool->currentBytes(), 0);
+
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_EQ(readFile->size(), data.size());
+  for (int64_t offset = 0; offset < data.size(); offset += 1 << 20) {
+    ASSERT_EQ(readFile->pread(offset, 100), data.substr(offset, 100));
+  }
+
+  // A file that is not closed is aborted and not created.
+  const auto abortedFile = s3URI(bucketName, "aborted.txt");
+  writeFile = s3fs.openFileForWrite(abortedFile, {{}, pool.get()});
+  writeFile->append({data.data(), data.size()});
+  writeFile.reset();
+  EXPECT_EQ(pool->currentBytes(), 0);
+  VELOX_ASSERT_THROW(
+      s3fs.openFileForRead(abortedFile), "Failed to get metadata");
+}
@@ -663,6 +663,63 @@ TEST_F(HiveDataSinkTest, memoryReclaim) {
     ASSERT_GE(results.size(), 1);
   }
 }
+
+TEST_F(HiveDataSinkTest, closeIdleWriters) {
+  const int numPartitions = 5;
+  const int numBatches = 10;
+  const int batchSize = 100;
+  auto rowType = ROW({"c0", "p0"}, {BIGINT(), INTEGER()});
+  // Each batch is a single partition.
+  std::vector<RowVectorPtr> vectors;
+  for (int i = 0; i < numBatches; ++i) {
+    vectors.push_back(makeRowVector(
+        rowType->names(),
+        {makeFlatVector<int64_t>(batchSize, [](auto row) { return row; }),
+         makeFlatVector<int32_t>(
+             batchSize, [&](auto /*row*/) { return i % numPartitions; })}));
+  }
+
+  for (uint32_t maxOpenFileWriters : {0, 2}) {
+    SCOPED_TRACE(fmt::format("maxOpenFileWriters: {}", maxOpenFileWriters));
+    setConnectorConfig(
+        {{HiveConfig::kMaxOpenFileWriters,
+          folly::to<std::string>(maxOpenFileWriters)}});
+    setConnectorQueryContext(std::make_unique<connector::ConnectorQueryCtx>(
+        opPool_.get(),
+        connectorPool_.get(),
+        connectorConfig_.get(),
+        nullptr,
+        nullptr,
+        nullptr,
+        "query.HiveDataSinkTest",
+        "task.HiveDataSinkTest",
+        "planNodeId.HiveDataSinkTest",
+        0));
+
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto dataSink = createDataSink(
+        rowType,
+        outputDirectory->path,
+        dwio::common::FileFormat::DWRF,
+        {"p0"});
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    // With 2 open writers, every batch after a partition change closes the
+    // least recently written writer and writes to a new file.
+    const int expectedFiles =
+        maxOpenFileWriters == 0 ? numPartitions : numBatches;
+    ASSERT_EQ(dataSink->numWrittenFiles(), expectedFiles);
+    const auto results = dataSink->close(true);
+    ASSERT_EQ(results.size(), expectedFiles);
+    ASSERT_EQ(listFiles(outputDirectory->path).size(), expectedFiles);
+    int64_t numRows = 0;
+    for (const auto& result : results) {
+      numRows += folly::parseJson(result)["rowCount"].asInt();
+    }
+    ASSERT_EQ(numRows, numBatches * batchSize);
+  }
+}
 } // namespace
 } // namespace facebook::velox::connector::hive
 
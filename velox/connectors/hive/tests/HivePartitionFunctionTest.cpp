@@ -584,6 +584,52 @@ TEST_F(HivePartitionFunctionTest, nestedRows) {
   assertPartitionsWithConstChannel(values, 997);
 }
 
+TEST_F(HivePartitionFunctionTest, sparkMurmur3) {
+  using HashKind = connector::hive::HivePartitionFunction::HashKind;
+  // The buckets are Spark's pmod(hash(c0, c1), 10). hash("", 0) is
+  // 1143746540, hash(null, 0) 933211791, hash("", null) 142593372 and
+  // hash(null, null) the seed 42.
+  auto rowVector = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {"", std::nullopt, "", std::nullopt}),
+      makeNullableFlatVector<int32_t>({0, 0, std::nullopt, std::nullopt}),
+  });
+  connector::hive::HivePartitionFunction function(
+      10, std::vector<column_index_t>{0, 1}, {}, HashKind::kSparkMurmur3);
+  std::vector<uint32_t> partitions;
+  function.partition(*rowVector, partitions);
+  EXPECT_EQ(partitions, (std::vector<uint32_t>{0, 1, 2, 2}));
+
+  // Negative hashes are mapped to non-negative buckets. hash(1) is
+  // -559580957 and hash(-1) -1604776387.
+  connector::hive::HivePartitionFunction singleKeyFunction(
+      10, std::vector<column_index_t>{0}, {}, HashKind::kSparkMurmur3);
+  singleKeyFunction.partition(
+      *makeRowVector({makeFlatVector<int32_t>({1, 0, -1})}), partitions);
+  EXPECT_EQ(partitions, (std::vector<uint32_t>{3, 1, 3}));
+
+  // A constant key is hashed with the hash of the previous keys as seed.
+  connector::hive::HivePartitionFunction constFunction(
+      10,
+      std::vector<column_index_t>{0, kConstantChannel},
+      {makeFlatVector<int32_t>(std::vector<int32_t>{0})},
+      HashKind::kSparkMurmur3);
+  constFunction.partition(*rowVector, partitions);
+  EXPECT_EQ(partitions, (std::vector<uint32_t>{0, 1, 0, 1}));
+
+  auto spec = std::make_unique<connector::hive::HivePartitionFunctionSpec>(
+      10,
+      std::vector<column_index_t>{0, 1},
+      std::vector<VectorPtr>{},
+      HashKind::kSparkMurmur3);
+  ASSERT_EQ(spec->toString(), "SPARK((0, 1) buckets: 10)");
+  auto copy = connector::hive::HivePartitionFunctionSpec::deserialize(
+      spec->serialize(), pool());
+  ASSERT_EQ(copy->toString(), spec->toString());
+  copy->create(10)->partition(*rowVector, partitions);
+  EXPECT_EQ(partitions, (std::vector<uint32_t>{0, 1, 2, 2}));
+}
+
 TEST_F(HivePartitionFunctionTest, spec) {
   Type::registerSerDe();
   core::ITypedExpr::registerSerDe();
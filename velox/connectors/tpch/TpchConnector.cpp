@@ -63,8 +63,12 @@ TpchDataSource::TpchDataSource(
     const std::unordered_map<
         std::string,
         std::shared_ptr<connector::ColumnHandle>>& columnHandles,
-    velox::memory::MemoryPool* FOLLY_NONNULL pool)
-    : pool_(pool) {
+    velox::memory::MemoryPool* FOLLY_NONNULL pool,
+    folly::Executor* FOLLY_NULLABLE executor,
+    int32_t numPrefetchBatches)
+    : pool_(pool),
+      executor_(executor),
+      numPrefetchBatches_(executor ? numPrefetchBatches : 0) {
   auto tpchTableHandle =
       std::dynamic_pointer_cast<TpchTableHandle>(tableHandle);
   VELOX_CHECK_NOT_NULL(
@@ -105,6 +109,10 @@ TpchDataSource::TpchDataSource(
   outputType_ = outputType;
 }
 
+TpchDataSource::~TpchDataSource() {
+  clearPrefetched();
+}
+
 RowVectorPtr TpchDataSource::projectOutputColumns(RowVectorPtr inputVector) {
   std::vector<VectorPtr> children;
   children.reserve(outputColumnMappings_.size());
@@ -142,26 +150,69 @@ std::optional<RowVectorPtr> TpchDataSource::next(
   VELOX_CHECK_NOT_NULL(
       currentSplit_, "No split to process. Call addSplit() first.");
 
-  size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
-  auto outputVector =
-      getTpchData(tpchTable_, maxRows, splitOffset_, scaleFactor_, pool_);
+  auto outputVector = nextBatch(size);
 
   // If the split is exhausted.
   if (!outputVector || outputVector->size() == 0) {
+    clearPrefetched();
     currentSplit_ = nullptr;
     return nullptr;
   }
 
-  // splitOffset needs to advance based on maxRows passed to getTpchData(), and
-  // not the actual number of returned rows in the output vector, as they are
-  // not the same for lineitem.
-  splitOffset_ += maxRows;
   completedRows_ += outputVector->size();
   completedBytes_ += outputVector->retainedSize();
 
   return projectOutputColumns(outputVector);
 }
 
+RowVectorPtr TpchDataSource::nextBatch(uint64_t size) {
+  if (numPrefetchBatches_ == 0) {
+    size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
+    auto batch =
+        getTpchData(tpchTable_, maxRows, splitOffset_, scaleFactor_, pool_);
+    // splitOffset needs to advance based on maxRows passed to getTpchData(),
+    // and not the actual number of returned rows in the output vector, as they
+    // are not the same for lineitem.
+    splitOffset_ += maxRows;
+    return batch;
+  }
+  prefetch(size);
+  if (prefetched_.empty()) {
+    return nullptr;
+  }
+  auto source = std::move(prefetched_.front());
+  prefetched_.pop_front();
+  prefetch(size);
+  auto batch = source->move();
+  return batch ? *batch : nullptr;
+}
+
+void TpchDataSource::prefetch(uint64_t size) {
+  while (prefetched_.size() < numPrefetchBatches_ &&
+         splitOffset_ < splitEnd_) {
+    const size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
+    auto source = std::make_shared<AsyncSource<RowVectorPtr>>(
+        [table = tpchTable_,
+         maxRows,
+         offset = splitOffset_,
+         scaleFactor = scaleFactor_,
+         pool = pool_]() {
+          return std::make_unique<RowVectorPtr>(
+              getTpchData(table, maxRows, offset, scaleFactor, pool));
+        });
+    splitOffset_ += maxRows;
+    prefetched_.push_back(source);
+    executor_->add([source]() { source->prepare(); });
+  }
+}
+
+void TpchDataSource::clearPrefetched() {
+  for (auto& source : prefetched_) {
+    source->close();
+  }
+  prefetched_.clear();
+}
+
 VELOX_REGISTER_CONNECTOR_FACTORY(std::make_shared<TpchConnectorFactory>())
 
 } // namespace facebook::velox::connector::tpch
@@ -15,6 +15,9 @@
  */
 #pragma once
 
+#include <deque>
+
+#include "velox/common/base/AsyncSource.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/tpch/TpchConnectorSplit.h"
 #include "velox/tpch/gen/TpchGen.h"
@@ -29,7 +32,7 @@ class TpchColumnHandle : public ColumnHandle {
  public:
   explicit TpchColumnHandle(const std::string& name) : name_(name) {}
 
-  const std::string& name() const {
+  const std::string& name() const override {
     return name_;
   }
 
@@ -75,7 +78,11 @@ class TpchDataSource : public DataSource {
       const std::unordered_map<
           std::string,
           std::shared_ptr<connector::ColumnHandle>>& columnHandles,
-      velox::memory::MemoryPool* FOLLY_NONNULL pool);
+      velox::memory::MemoryPool* FOLLY_NONNULL pool,
+      folly::Executor* FOLLY_NULLABLE executor = nullptr,
+      int32_t numPrefetchBatches = 0);
+
+  ~TpchDataSource() override;
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
@@ -104,6 +111,18 @@ class TpchDataSource : public DataSource {
  private:
   RowVectorPtr projectOutputColumns(RowVectorPtr vector);
 
+  // Returns the next batch of at most 'size' rows of the current split, or
+  // nullptr if the split is at end.
+  RowVectorPtr nextBatch(uint64_t size);
+
+  // Schedules the generation of the batches after the ones in 'prefetched_'
+  // on 'executor_', up to 'numPrefetchBatches_' batches.
+  void prefetch(uint64_t size);
+
+  // Drops the batches that are not yet returned and waits for the ones that
+  // are being generated.
+  void clearPrefetched();
+
   velox::tpch::Table tpchTable_;
   double scaleFactor_{1.0};
   size_t tpchTableRowCount_{0};
@@ -124,6 +143,16 @@ class TpchDataSource : public DataSource {
   size_t completedBytes_{0};
 
   memory::MemoryPool* FOLLY_NONNULL pool_;
+
+  // Executor for generating batches ahead of next(). Each batch is seeded by
+  // its offset, so that the batches can be generated in parallel and the
+  // result does not depend on the number of batches in flight.
+  folly::Executor* FOLLY_NULLABLE const executor_;
+  const int32_t numPrefetchBatches_;
+
+  // Batches of the current split in generation order. 'splitOffset_' is the
+  // offset of the first batch that is not in 'prefetched_'.
+  std::deque<std::shared_ptr<AsyncSource<RowVectorPtr>>> prefetched_;
 };
 
 class TpchConnector final : public Connector {
@@ -131,8 +160,21 @@ class TpchConnector final : public Connector {
   TpchConnector(
       const std::string& id,
       std::shared_ptr<const Config> properties,
-      folly::Executor* FOLLY_NULLABLE /*executor*/)
-      : Connector(id, properties) {}
+      folly::Executor* FOLLY_NULLABLE executor)
+      : Connector(id, properties),
+        executor_(executor),
+        numPrefetchBatches_(
+            properties ? properties->get<int32_t>(kNumPrefetchBatches, 0)
+                       : 0) {}
+
+  /// Number of batches of a split that each data source generates ahead on
+  /// the connector's executor. 0 generates the batches in next().
+  static constexpr const char* kNumPrefetchBatches =
+      "tpch.num-prefetch-batches";
+
+  folly::Executor* FOLLY_NULLABLE executor() const override {
+    return executor_;
+  }
 
   std::unique_ptr<DataSource> createDataSource(
       const std::shared_ptr<const RowType>& outputType,
@@ -145,7 +187,9 @@ class TpchConnector final : public Connector {
         outputType,
         tableHandle,
         columnHandles,
-        connectorQueryCtx->memoryPool());
+        connectorQueryCtx->memoryPool(),
+        executor_,
+        numPrefetchBatches_);
   }
 
   std::unique_ptr<DataSink> createDataSink(
@@ -156,6 +200,10 @@ class TpchConnector final : public Connector {
       CommitStrategy /*commitStrategy*/) override final {
     VELOX_NYI("TpchConnector does not support data sink.");
   }
+
+ private:
+  folly::Executor* FOLLY_NULLABLE const executor_;
+  const int32_t numPrefetchBatches_;
 };
 
 class TpchConnectorFactory : public ConnectorFactory {
@@ -15,6 +15,7 @@
  */
 
 #include "velox/connectors/tpch/TpchConnector.h"
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 #include "gtest/gtest.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -230,6 +231,53 @@ TEST_F(TpchConnectorTest, multipleSplits) {
   }
 }
 
+// Generating batches ahead of next() on an executor returns the same data in
+// the same order.
+TEST_F(TpchConnectorTest, prefetchBatches) {
+  const std::string kPrefetchConnectorId = "test-tpch-prefetch";
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  auto properties = std::make_shared<const core::MemConfig>(
+      std::unordered_map<std::string, std::string>{
+          {connector::tpch::TpchConnector::kNumPrefetchBatches, "3"}});
+  connector::registerConnector(
+      connector::getConnectorFactory(
+          connector::tpch::TpchConnectorFactory::kTpchConnectorName)
+          ->newConnector(kPrefetchConnectorId, properties, executor.get()));
+
+  auto scan = [&](const std::string& connectorId) {
+    auto outputType = ROW(
+        {"l_orderkey", "l_linenumber", "l_shipdate", "l_comment"},
+        {BIGINT(), INTEGER(), DATE(), VARCHAR()});
+    std::unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
+        assignments;
+    for (const auto& name : outputType->names()) {
+      assignments[name] = std::make_shared<TpchColumnHandle>(name);
+    }
+    auto plan = PlanBuilder()
+                    .tableScan(
+                        outputType,
+                        std::make_shared<TpchTableHandle>(
+                            connectorId, Table::TBL_LINEITEM, 0.01),
+                        assignments)
+                    .planNode();
+    std::vector<exec::Split> splits;
+    for (auto i = 0; i < 3; ++i) {
+      splits.emplace_back(
+          std::make_shared<TpchConnectorSplit>(connectorId, 3, i));
+    }
+    return exec::test::AssertQueryBuilder(plan)
+        .config(core::QueryConfig::kPreferredOutputBatchRows, "1000")
+        .splits(std::move(splits))
+        .copyResults(pool());
+  };
+  auto expected = scan(kTpchConnectorId);
+  auto output = scan(kPrefetchConnectorId);
+  EXPECT_EQ(
+      tpch::getRowCount(tpch::Table::TBL_LINEITEM, 0.01), output->size());
+  test::assertEqualVectors(expected, output);
+  connector::unregisterConnector(kPrefetchConnectorId);
+}
+
 // Join nation and region.
 TEST_F(TpchConnectorTest, join) {
   auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
@@ -565,8 +565,29 @@ const std::vector<PlanNodePtr>& TableScanNode::sources() const {
   return kEmptySources;
 }
 
+std::vector<std::string> TableScanNode::clusteringKeys() const {
+  std::vector<std::string> keys;
+  for (const auto& key : tableHandle_->clusteringKeys()) {
+    std::optional<std::string> output;
+    for (const auto& [name, columnHandle] : assignments_) {
+      if (columnHandle->name() == key && outputType_->containsChild(name)) {
+        output = name;
+        break;
+      }
+    }
+    if (!output.has_value()) {
+      break;
+    }
+    keys.push_back(std::move(output.value()));
+  }
+  return keys;
+}
+
 void TableScanNode::addDetails(std::stringstream& stream) const {
   stream << tableHandle_->toString();
+  if (limit_.has_value()) {
+    stream << ", limit: " << limit_.value();
+  }
 }
 
 folly::dynamic TableScanNode::serialize() const {
@@ -581,6 +602,9 @@ folly::dynamic TableScanNode::serialize() const {
     assignments.push_back(std::move(pair));
   }
   obj["assignments"] = std::move(assignments);
+  if (limit_.has_value()) {
+    obj["limit"] = limit_.value();
+  }
   return obj;
 }
 
@@ -602,8 +626,13 @@ PlanNodePtr TableScanNode::create(const folly::dynamic& obj, void* context) {
         std::const_pointer_cast<connector::ColumnHandle>(columnHandle);
   }
 
+  std::optional<int64_t> limit;
+  if (obj.count("limit")) {
+    limit = obj["limit"].asInt();
+  }
+
   return std::make_shared<const TableScanNode>(
-      planNodeId, outputType, tableHandle, assignments);
+      planNodeId, outputType, tableHandle, assignments, limit);
 }
 
 const std::vector<PlanNodePtr>& ArrowStreamNode::sources() const {
@@ -276,16 +276,32 @@ class ValuesNode : public PlanNode {
   const size_t repeatTimes_;
 };
 
+/// Reads batches from one or more Arrow C streams. With several streams, up
+/// to one driver per stream reads them in parallel, each driver reading every
+/// n-th stream.
 class ArrowStreamNode : public PlanNode {
  public:
   ArrowStreamNode(
       const PlanNodeId& id,
       RowTypePtr outputType,
       std::shared_ptr<ArrowArrayStream> arrowStream)
+      : ArrowStreamNode(
+            id,
+            std::move(outputType),
+            std::vector<std::shared_ptr<ArrowArrayStream>>{
+                std::move(arrowStream)}) {}
+
+  ArrowStreamNode(
+      const PlanNodeId& id,
+      RowTypePtr outputType,
+      std::vector<std::shared_ptr<ArrowArrayStream>> arrowStreams)
       : PlanNode(id),
         outputType_(std::move(outputType)),
-        arrowStream_(std::move(arrowStream)) {
-    VELOX_USER_CHECK_NOT_NULL(arrowStream_);
+        arrowStreams_(std::move(arrowStreams)) {
+    VELOX_USER_CHECK(!arrowStreams_.empty());
+    for (const auto& stream : arrowStreams_) {
+      VELOX_USER_CHECK_NOT_NULL(stream);
+    }
   }
 
   const RowTypePtr& outputType() const override {
@@ -295,7 +311,11 @@ class ArrowStreamNode : public PlanNode {
   const std::vector<PlanNodePtr>& sources() const override;
 
   const std::shared_ptr<ArrowArrayStream>& arrowStream() const {
-    return arrowStream_;
+    return arrowStreams_[0];
+  }
+
+  const std::vector<std::shared_ptr<ArrowArrayStream>>& arrowStreams() const {
+    return arrowStreams_;
   }
 
   std::string_view name() const override {
@@ -310,7 +330,7 @@ class ArrowStreamNode : public PlanNode {
   void addDetails(std::stringstream& stream) const override;
 
   const RowTypePtr outputType_;
-  std::shared_ptr<ArrowArrayStream> arrowStream_;
+  const std::vector<std::shared_ptr<ArrowArrayStream>> arrowStreams_;
 };
 
 class FilterNode : public PlanNode {
@@ -425,17 +445,26 @@ class ProjectNode : public PlanNode {
 
 class TableScanNode : public PlanNode {
  public:
+  /// @param limit Optional hint that each consumer of the scan, e.g. a Limit,
+  /// needs at most this many rows. The scan then reads no larger batches than
+  /// needed to produce the remaining rows.
   TableScanNode(
       const PlanNodeId& id,
       RowTypePtr outputType,
       const std::shared_ptr<connector::ConnectorTableHandle>& tableHandle,
       const std::unordered_map<
           std::string,
-          std::shared_ptr<connector::ColumnHandle>>& assignments)
+          std::shared_ptr<connector::ColumnHandle>>& assignments,
+      std::optional<int64_t> limit = std::nullopt)
       : PlanNode(id),
         outputType_(std::move(outputType)),
         tableHandle_(tableHandle),
-        assignments_(assignments) {}
+        assignments_(assignments),
+        limit_(limit) {
+    if (limit_.has_value()) {
+      VELOX_USER_CHECK_GT(limit_.value(), 0);
+    }
+  }
 
   const std::vector<PlanNodePtr>& sources() const override;
 
@@ -457,6 +486,14 @@ class TableScanNode : public PlanNode {
     return assignments_;
   }
 
+  const std::optional<int64_t>& limit() const {
+    return limit_;
+  }
+
+  /// Returns the names of the output columns for the longest prefix of the
+  /// clustering keys of 'tableHandle' that are projected out.
+  std::vector<std::string> clusteringKeys() const;
+
   std::string_view name() const override {
     return "TableScan";
   }
@@ -473,6 +510,7 @@ class TableScanNode : public PlanNode {
   const std::
       unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
           assignments_;
+  const std::optional<int64_t> limit_;
 };
 
 class AggregationNode : public PlanNode {
@@ -2218,6 +2256,10 @@ class MarkDistinctNode : public PlanNode {
     return distinctKeys_;
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.markDistinctSpillEnabled();
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -81,6 +81,18 @@ class QueryConfig {
   static constexpr const char* kExprEvalSimplified =
       "expression.eval_simplified";
 
+  /// Whether FilterProject evaluates filters and projections over flat
+  /// numeric columns with a fused kernel instead of the expression
+  /// interpreter. False by default.
+  static constexpr const char* kExprFusedKernelEnabled =
+      "expression.fused_kernel_enabled";
+
+  /// The maximum number of bytes an expression retains for results memoized
+  /// for dictionary base vectors. The results are kept across batches so that
+  /// a dictionary that repeats over many batches is evaluated once. The least
+  /// recently used results are dropped when over the limit.
+  static constexpr const char* kExprMaxMemoBytes = "expression.max_memo_bytes";
+
   /// Whether to track CPU usage for individual expressions (supported by call
   /// and cast expressions). False by default. Can be expensive when processing
   /// small batches, e.g. < 10K rows.
@@ -92,6 +104,39 @@ class QueryConfig {
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  /// Whether to count cycles, instructions, LLC misses and dTLB misses of each
+  /// operator call with perf_event hardware counters. False by default. Has no
+  /// effect where the counters are not available.
+  static constexpr const char* kOperatorTrackHardwareCounters =
+      "track_operator_hardware_counters";
+
+  /// The number of most recent timeline events, e.g. driver runs and blocked
+  /// intervals, that each task keeps for export as a Chrome trace. 0, the
+  /// default, disables the timeline.
+  static constexpr const char* kTaskTimelineMaxEvents =
+      "task_timeline_max_events";
+
+  /// The CPU time in milliseconds a driver may run on a thread before it
+  /// yields and goes to the back of the executor queue. Drivers of tasks that
+  /// have used less CPU are then queued ahead of the others if the executor
+  /// supports priorities. 0 means no limit.
+  static constexpr const char* kDriverCpuTimeSliceLimitMs =
+      "driver_cpu_time_slice_limit_ms";
+
+  /// Memory in bytes that the split groups of a task running in grouped
+  /// execution may use at the same time. The usage of a split group is
+  /// estimated from the largest completed split group, and the task only runs
+  /// as many split groups concurrently as fit in the budget. 0 means no limit.
+  static constexpr const char* kGroupedExecutionMemoryBudget =
+      "grouped_execution_memory_budget";
+
+  /// Directory in which a task in grouped execution checkpoints the
+  /// PartitionedOutput pages of its completed split groups. A task started
+  /// with the same directory does not read the splits of the checkpointed
+  /// split groups and sends the checkpointed pages instead. Empty disables
+  /// checkpointing.
+  static constexpr const char* kTaskCheckpointPath = "task_checkpoint_path";
+
   /// Flags used to configure the CAST operator:
 
   /// This flag makes the Row conversion to by applied in a way that the casting
@@ -123,11 +168,36 @@ class QueryConfig {
   static constexpr const char* kMaxLocalExchangeBufferSize =
       "max_local_exchange_buffer_size";
 
+  /// If true, LocalPartition reorders each input batch that goes to more
+  /// than one partition so that the rows of each partition are contiguous and
+  /// hands out zero-copy slices of the reordered batch instead of dictionary
+  /// wraps of the input.
+  static constexpr const char* kLocalPartitionSortByPartition =
+      "local_partition_sort_by_partition";
+
   /// Maximum size in bytes to accumulate in ExchangeQueue. Enforced
   /// approximately, not strictly.
   static constexpr const char* kMaxExchangeBufferSize =
       "exchange.max_buffer_size";
 
+  /// If true, Exchange deserializes fixed width columns without nulls into
+  /// vectors that reference the received pages instead of copying the values.
+  /// The pages then stay in memory for as long as any such vector is alive.
+  static constexpr const char* kExchangeZeroCopyDeserialization =
+      "exchange.zero_copy_deserialization";
+
+  /// If true, PartitionedOutput sends dictionary and constant encoded columns
+  /// as DICTIONARY or RLE instead of flattening them when that takes fewer
+  /// bytes. The receiving Exchange then produces dictionary and constant
+  /// vectors.
+  static constexpr const char* kExchangePreserveEncodings =
+      "exchange.preserve_encodings";
+
+  /// Codec for the pages sent between tasks. Must be the same for producers
+  /// and consumers. Pages that do not compress well are sent uncompressed.
+  static constexpr const char* kExchangeCompressionKind =
+      "exchange.compression_codec";
+
   static constexpr const char* kMaxPartialAggregationMemory =
       "max_partial_aggregation_memory";
 
@@ -140,9 +210,41 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// If true, partial aggregation samples the cardinality of the grouping keys
+  /// with a HyperLogLog sketch and uses the estimate to choose between
+  /// extending memory, flushing a fixed-size cache of hot keys or switching to
+  /// pass-through when the partial aggregation gets full.
+  static constexpr const char* kPartialAggregationKeySamplingEnabled =
+      "partial_aggregation_key_sampling_enabled";
+
+  /// The max range of values of a single integer grouping key for which hash
+  /// aggregation keeps the accumulators in arrays indexed by key value instead
+  /// of in a hash table. Applies if all aggregates support dense accumulators,
+  /// e.g. sum, count, min and max, and spilling is disabled. 0 disables.
+  static constexpr const char* kAggregationDenseKeyRange =
+      "aggregation_dense_key_range";
+
   static constexpr const char* kMaxPartitionedOutputBufferSize =
       "max_page_partitioning_buffer_size";
 
+  /// If true and the task has a spill directory, a partitioned output buffer
+  /// writes the pages that do not fit in max_page_partitioning_buffer_size to
+  /// a file in the spill directory instead of blocking the producers. The
+  /// pages are read back when their destination fetches them.
+  static constexpr const char* kPartitionedOutputSpillEnabled =
+      "partitioned_output_spill_enabled";
+
+  /// If true, PartitionedOutput reorders each hash partitioned input batch so
+  /// that the rows of each destination are contiguous, then serializes each
+  /// destination's rows with one append instead of one append per row.
+  static constexpr const char* kPartitionedOutputSortByPartition =
+      "partitioned_output_sort_by_partition";
+
+  /// If true, OrderBy and Window sort rows by binary comparable prefixes made
+  /// from the leading fixed-width integer and boolean sort keys, and only
+  /// compare the remaining keys when two prefixes are equal.
+  static constexpr const char* kPrefixSortEnabled = "prefix_sort_enabled";
+
   /// Preferred size of batches in bytes to be returned by operators from
   /// Operator::getOutput. It is used when an estimate of average row size is
   /// known. Otherwise kPreferredOutputBatchRows is used.
@@ -162,12 +264,52 @@ class QueryConfig {
   /// output rows.
   static constexpr const char* kMaxOutputBatchRows = "max_output_batch_rows";
 
+  /// If true, operators that otherwise return kPreferredOutputBatchRows rows
+  /// per batch, e.g. HashProbe and Unnest, estimate the size of their output
+  /// rows from their input and size their batches to
+  /// kPreferredOutputBatchBytes. FilterProject also coalesces the small
+  /// batches left by selective filters into batches of about that size.
+  static constexpr const char* kOutputBatchSizeByBytes =
+      "output_batch_size_by_bytes";
+
+  /// Max time in milliseconds that FilterProject holds small output batches
+  /// for coalescing before it returns them. Zero means no limit. Applies if
+  /// kOutputBatchSizeByBytes is set.
+  static constexpr const char* kOutputBatchCoalesceMaxDelayMs =
+      "output_batch_coalesce_max_delay_ms";
+
+  /// If true, the Unnest operator splits the elements of an input row across
+  /// output batches so that no batch has more than the preferred number of
+  /// output rows. Otherwise each input row is unnested into a single batch.
+  static constexpr const char* kUnnestSplitOutput = "unnest_split_output";
+
+  /// Max bytes of batches that the ArrowStream operator reads ahead of its
+  /// consumer on the query executor. Zero reads batches synchronously in
+  /// getOutput().
+  static constexpr const char* kArrowStreamMaxPrefetchBytes =
+      "arrow_stream_max_prefetch_bytes";
+
   /// TableScan operator will exit getOutput() method after this many
   /// milliseconds even if it has no data to return yet. Zero means 'no time
   /// limit'.
   static constexpr const char* kTableScanGetOutputTimeLimitMs =
       "table_scan_getoutput_time_limit_ms";
 
+  /// TableScan operator yields its thread after this many milliseconds of
+  /// thread CPU time in getOutput() even in the middle of a split, e.g. while
+  /// reading batches that filters drop entirely. The reader keeps its
+  /// position and the scan continues there when the Driver runs again. Zero
+  /// means 'no limit'.
+  static constexpr const char* kTableScanGetOutputCpuTimeLimitMs =
+      "table_scan_getoutput_cpu_time_limit_ms";
+
+  /// TableScan operator stops preloading splits in the background while the
+  /// memory of its connector pool is at least this many bytes. The pool holds
+  /// the readers of the current split and of the preloaded splits. Zero means
+  /// 'no limit'.
+  static constexpr const char* kMaxSplitPreloadMemoryBytes =
+      "max_split_preload_memory_bytes";
+
   /// If false, the 'group by' code is forced to use generic hash mode
   /// hashtable.
   static constexpr const char* kHashAdaptivityEnabled =
@@ -199,6 +341,10 @@ class QueryConfig {
   static constexpr const char* kRowNumberSpillEnabled =
       "row_number_spill_enabled";
 
+  /// MarkDistinct spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kMarkDistinctSpillEnabled =
+      "mark_distinct_spill_enabled";
+
   /// TopNRowNumber spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kTopNRowNumberSpillEnabled =
       "topn_row_number_spill_enabled";
@@ -232,6 +378,15 @@ class QueryConfig {
   /// The max allowed spill file size. If it is zero, then there is no limit.
   static constexpr const char* kMaxSpillFileSize = "max_spill_file_size";
 
+  /// Base path on any registered file system, e.g. S3 or HDFS, for the spill
+  /// files that do not fit in the task spill directory. Each task spills
+  /// under its own subdirectory. Empty means no overflow tier.
+  static constexpr const char* kSpillOverflowPath = "spill_overflow_path";
+
+  /// The max bytes a task spills to its spill directory before new spill
+  /// files go to 'spill_overflow_path'. Zero means no overflow tier.
+  static constexpr const char* kMaxLocalSpillBytes = "max_local_spill_bytes";
+
   /// The min spill run size limit used to select partitions for spilling. The
   /// spiller tries to spill a previously spilled partitions if its data size
   /// exceeds this limit, otherwise it spills the partition with most data.
@@ -244,6 +399,9 @@ class QueryConfig {
   static constexpr const char* kSpillCompressionKind =
       "spill_compression_codec";
 
+  /// Serialization format of spill files, "presto" or "columnar".
+  static constexpr const char* kSpillFileFormat = "spill_file_format";
+
   /// Specifies spill write buffer size in bytes. The spiller tries to buffer
   /// serialized spill data up to the specified size before write to storage
   /// underneath for io efficiency. If it is set to zero, then spill write
@@ -266,6 +424,13 @@ class QueryConfig {
   /// output processing stage.
   static constexpr const char* kAggregationSpillAll = "aggregation_spill_all";
 
+  /// If true, the drivers of a spilled aggregation restore the spilled
+  /// partitions in parallel after all of them have finished input. Each driver
+  /// restores its own partitions first and then takes over the remaining
+  /// partitions of the other drivers.
+  static constexpr const char* kAggregationSpillParallelRestoreEnabled =
+      "aggregation_spill_parallel_restore_enabled";
+
   static constexpr const char* kMinSpillableReservationPct =
       "min_spillable_reservation_pct";
 
@@ -305,11 +470,46 @@ class QueryConfig {
   static constexpr const char* kHashProbeFinishEarlyOnEmptyBuild =
       "hash_probe_finish_early_on_empty_build";
 
+  /// If true, the build side columns of hash join probe output are LazyVectors
+  /// that copy the values from the hash table when loaded, so that rows
+  /// dropped by a downstream filter or limit are never copied. Does not apply
+  /// when spilling is enabled.
+  static constexpr const char* kHashProbeLazyBuildColumns =
+      "hash_probe_lazy_build_columns";
+
+  /// If true, a hash join filter that is a conjunction of comparisons between
+  /// BIGINT or INTEGER probe side columns, build side columns and constants
+  /// is evaluated directly on the probe input and the hash table rows instead
+  /// of copying the build side values into vectors for the expression
+  /// evaluator. Does not apply to null-aware joins.
+  static constexpr const char* kHashProbeSimpleFilterEnabled =
+      "hash_probe_simple_filter_enabled";
+
+  /// If true, an inner hash join whose probe input is later probed into a
+  /// more selective inner hash join of the same pipeline filters its input by
+  /// the hash table of that join first. The selectivities are observed at
+  /// runtime, so the order in which the joins drop rows adapts to the data.
+  static constexpr const char* kHashProbeEarlyJoinFilterEnabled =
+      "hash_probe_early_join_filter_enabled";
+
   /// The minimum number of table rows that can trigger the parallel hash join
   /// table build.
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// The max size in bytes of a Bloom filter made by hash join build on a join
+  /// key with too many distinct values for an IN-list dynamic filter. The Bloom
+  /// filter is pushed down by hash probe into the probe side table scan. 0
+  /// disables Bloom filter dynamic filters.
+  static constexpr const char* kHashBuildBloomFilterMaxSize =
+      "hash_build_bloom_filter_max_size";
+
+  /// Identifies the build side input of hash joins, e.g. the table snapshot
+  /// and splits read by a broadcast join build. Tasks on the same worker share
+  /// one read-only hash table for joins that have this key and the same build
+  /// side plan. Empty disables sharing.
+  static constexpr const char* kHashTableCacheKey = "hash_table_cache_key";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -326,6 +526,13 @@ class QueryConfig {
   static constexpr const char* kEnableExpressionEvaluationCache =
       "enable_expression_evaluation_cache";
 
+  /// If true and the expression evaluation caches are enabled, the operators
+  /// of a driver share one vector pool so that the vectors and buffers
+  /// released by one operator can be reused by the others. Otherwise, each
+  /// operator has its own vector pool.
+  static constexpr const char* kDriverVectorPoolEnabled =
+      "driver_vector_pool_enabled";
+
   uint64_t queryMaxMemoryPerNode() const {
     return toCapacity(
         get<std::string>(kQueryMaxMemoryPerNode, "0B"), CapacityUnit::BYTE);
@@ -349,6 +556,14 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  bool partialAggregationKeySamplingEnabled() const {
+    return get<bool>(kPartialAggregationKeySamplingEnabled, false);
+  }
+
+  uint64_t aggregationDenseKeyRange() const {
+    return get<uint64_t>(kAggregationDenseKeyRange, 0);
+  }
+
   uint64_t aggregationSpillMemoryThreshold() const {
     static constexpr uint64_t kDefault = 0;
     return get<uint64_t>(kAggregationSpillMemoryThreshold, kDefault);
@@ -373,16 +588,44 @@ class QueryConfig {
     return get<uint64_t>(kMaxPartitionedOutputBufferSize, kDefault);
   }
 
+  bool partitionedOutputSpillEnabled() const {
+    return get<bool>(kPartitionedOutputSpillEnabled, false);
+  }
+
+  bool partitionedOutputSortByPartition() const {
+    return get<bool>(kPartitionedOutputSortByPartition, false);
+  }
+
+  bool prefixSortEnabled() const {
+    return get<bool>(kPrefixSortEnabled, false);
+  }
+
   uint64_t maxLocalExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
   }
 
+  bool localPartitionSortByPartition() const {
+    return get<bool>(kLocalPartitionSortByPartition, false);
+  }
+
   uint64_t maxExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxExchangeBufferSize, kDefault);
   }
 
+  bool exchangeZeroCopyDeserialization() const {
+    return get<bool>(kExchangeZeroCopyDeserialization, false);
+  }
+
+  bool exchangePreserveEncodings() const {
+    return get<bool>(kExchangePreserveEncodings, false);
+  }
+
+  std::string exchangeCompressionKind() const {
+    return get<std::string>(kExchangeCompressionKind, "none");
+  }
+
   uint64_t preferredOutputBatchBytes() const {
     static constexpr uint64_t kDefault = 10UL << 20;
     return get<uint64_t>(kPreferredOutputBatchBytes, kDefault);
@@ -396,10 +639,35 @@ class QueryConfig {
     return get<uint32_t>(kMaxOutputBatchRows, 10'000);
   }
 
+  bool outputBatchSizeByBytes() const {
+    return get<bool>(kOutputBatchSizeByBytes, false);
+  }
+
+  uint64_t outputBatchCoalesceMaxDelayMs() const {
+    return get<uint64_t>(kOutputBatchCoalesceMaxDelayMs, 100);
+  }
+
+  bool unnestSplitOutput() const {
+    return get<bool>(kUnnestSplitOutput, true);
+  }
+
+  uint64_t arrowStreamMaxPrefetchBytes() const {
+    static constexpr uint64_t kDefault = 64UL << 20;
+    return get<uint64_t>(kArrowStreamMaxPrefetchBytes, kDefault);
+  }
+
   uint32_t tableScanGetOutputTimeLimitMs() const {
     return get<uint64_t>(kTableScanGetOutputTimeLimitMs, 5'000);
   }
 
+  uint64_t tableScanGetOutputCpuTimeLimitMs() const {
+    return get<uint64_t>(kTableScanGetOutputCpuTimeLimitMs, 0);
+  }
+
+  uint64_t maxSplitPreloadMemoryBytes() const {
+    return get<uint64_t>(kMaxSplitPreloadMemoryBytes, 0);
+  }
+
   bool hashAdaptivityEnabled() const {
     return get<bool>(kHashAdaptivityEnabled, true);
   }
@@ -454,6 +722,15 @@ class QueryConfig {
     return get<bool>(kExprEvalSimplified, false);
   }
 
+  bool exprFusedKernelEnabled() const {
+    return get<bool>(kExprFusedKernelEnabled, false);
+  }
+
+  uint64_t exprMaxMemoBytes() const {
+    static constexpr uint64_t kDefault = 8UL << 20;
+    return get<uint64_t>(kExprMaxMemoBytes, kDefault);
+  }
+
   /// Returns true if spilling is enabled.
   bool spillEnabled() const {
     return get<bool>(kSpillEnabled, false);
@@ -489,6 +766,12 @@ class QueryConfig {
     return get<bool>(kRowNumberSpillEnabled, true);
   }
 
+  /// Returns true if spilling is enabled for MarkDistinct operator. Must also
+  /// check the spillEnabled()!
+  bool markDistinctSpillEnabled() const {
+    return get<bool>(kMarkDistinctSpillEnabled, true);
+  }
+
   /// Returns true if spilling is enabled for TopNRowNumber operator. Must also
   /// check the spillEnabled()!
   bool topNRowNumberSpillEnabled() const {
@@ -542,11 +825,23 @@ class QueryConfig {
     return get<bool>(kAggregationSpillAll, true);
   }
 
+  bool aggregationSpillParallelRestoreEnabled() const {
+    return get<bool>(kAggregationSpillParallelRestoreEnabled, false);
+  }
+
   uint64_t maxSpillFileSize() const {
     constexpr uint64_t kDefaultMaxFileSize = 0;
     return get<uint64_t>(kMaxSpillFileSize, kDefaultMaxFileSize);
   }
 
+  std::string spillOverflowPath() const {
+    return get<std::string>(kSpillOverflowPath, "");
+  }
+
+  uint64_t maxLocalSpillBytes() const {
+    return get<uint64_t>(kMaxLocalSpillBytes, 0);
+  }
+
   uint64_t minSpillRunSize() const {
     constexpr uint64_t kDefaultMinSpillRunSize = 256 << 20; // 256MB.
     return get<uint64_t>(kMinSpillRunSize, kDefaultMinSpillRunSize);
@@ -556,6 +851,10 @@ class QueryConfig {
     return get<std::string>(kSpillCompressionKind, "none");
   }
 
+  std::string spillFileFormat() const {
+    return get<std::string>(kSpillFileFormat, "presto");
+  }
+
   uint64_t spillWriteBufferSize() const {
     // The default write buffer size set to 1MB.
     return get<uint64_t>(kSpillWriteBufferSize, 1L << 20);
@@ -622,6 +921,26 @@ class QueryConfig {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  bool operatorTrackHardwareCounters() const {
+    return get<bool>(kOperatorTrackHardwareCounters, false);
+  }
+
+  uint32_t taskTimelineMaxEvents() const {
+    return get<uint32_t>(kTaskTimelineMaxEvents, 0);
+  }
+
+  uint32_t driverCpuTimeSliceLimitMs() const {
+    return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
+  }
+
+  uint64_t groupedExecutionMemoryBudget() const {
+    return get<uint64_t>(kGroupedExecutionMemoryBudget, 0);
+  }
+
+  std::string taskCheckpointPath() const {
+    return get<std::string>(kTaskCheckpointPath, "");
+  }
+
   uint32_t taskWriterCount() const {
     return get<uint32_t>(kTaskWriterCount, 4);
   }
@@ -635,10 +954,30 @@ class QueryConfig {
     return get<bool>(kHashProbeFinishEarlyOnEmptyBuild, true);
   }
 
+  bool hashProbeLazyBuildColumns() const {
+    return get<bool>(kHashProbeLazyBuildColumns, false);
+  }
+
+  bool hashProbeSimpleFilterEnabled() const {
+    return get<bool>(kHashProbeSimpleFilterEnabled, false);
+  }
+
+  bool hashProbeEarlyJoinFilterEnabled() const {
+    return get<bool>(kHashProbeEarlyJoinFilterEnabled, false);
+  }
+
   uint32_t minTableRowsForParallelJoinBuild() const {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  uint64_t hashBuildBloomFilterMaxSize() const {
+    return get<uint64_t>(kHashBuildBloomFilterMaxSize, 0);
+  }
+
+  std::string hashTableCacheKey() const {
+    return get<std::string>(kHashTableCacheKey, "");
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
@@ -647,6 +986,10 @@ class QueryConfig {
     return get<bool>(kEnableExpressionEvaluationCache, true);
   }
 
+  bool driverVectorPoolEnabled() const {
+    return get<bool>(kDriverVectorPoolEnabled, false);
+  }
+
   template <typename T>
   T get(const std::string& key, const T& defaultValue) const {
     return config_->get<T>(key, defaultValue);
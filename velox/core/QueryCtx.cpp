@@ -76,4 +76,28 @@ QueryCtx::QueryCtx(
   return fmt::format("query.{}.{}", queryId.c_str(), seqNum++);
 }
 
+std::vector<SelectivityInfo> QueryCtx::conjunctHistory(
+    const std::string& key) const {
+  std::lock_guard<std::mutex> l(conjunctHistoryMutex_);
+  auto it = conjunctHistory_.find(key);
+  if (it == conjunctHistory_.end()) {
+    return {};
+  }
+  return it->second;
+}
+
+void QueryCtx::addConjunctHistory(
+    const std::string& key,
+    const std::vector<SelectivityInfo>& delta) {
+  std::lock_guard<std::mutex> l(conjunctHistoryMutex_);
+  auto& history = conjunctHistory_[key];
+  if (history.empty()) {
+    history.resize(delta.size());
+  }
+  VELOX_CHECK_EQ(history.size(), delta.size());
+  for (auto i = 0; i < delta.size(); ++i) {
+    history[i].add(delta[i]);
+  }
+}
+
 } // namespace facebook::velox::core
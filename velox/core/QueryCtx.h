@@ -16,8 +16,11 @@
 #pragma once
 
 #include <folly/Executor.h>
+#include <folly/container/F14Map.h>
 #include <folly/executors/CPUThreadPoolExecutor.h>
+#include "velox/common/base/SelectivityInfo.h"
 #include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/memory/AllocationPool.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/vector/DecodedVector.h"
@@ -128,6 +131,17 @@ class QueryCtx {
     pool_ = std::move(pool);
   }
 
+  /// Returns the rows in, rows out and time of each input of the AND or OR
+  /// expression 'key' accumulated by all drivers and splits of the query so
+  /// far. Returns an empty vector if there is no history for 'key'.
+  std::vector<SelectivityInfo> conjunctHistory(const std::string& key) const;
+
+  /// Adds 'delta' to the history of 'key'. 'delta' must have one element per
+  /// input of the expression.
+  void addConjunctHistory(
+      const std::string& key,
+      const std::vector<SelectivityInfo>& delta);
+
  private:
   static Config* getEmptyConfig() {
     static const std::unique_ptr<Config> kEmptyConfig =
@@ -151,20 +165,39 @@ class QueryCtx {
   folly::Executor::KeepAlive<> executorKeepalive_;
   QueryConfig queryConfig_;
   std::shared_ptr<folly::Executor> spillExecutor_;
+
+  // Selectivity and cost of the inputs of AND and OR expressions, keyed on
+  // the expression text. Lets drivers start with the input order learned by
+  // the others.
+  mutable std::mutex conjunctHistoryMutex_;
+  folly::F14FastMap<std::string, std::vector<SelectivityInfo>>
+      conjunctHistory_;
 };
 
 // Represents the state of one thread of query execution.
 class ExecCtx {
  public:
-  ExecCtx(memory::MemoryPool* pool, QueryCtx* queryCtx)
+  /// If 'sharedVectorPool' is set, uses it instead of a vector pool of its
+  /// own. The recycled vectors and buffers might then come from the memory
+  /// pools of the other users of 'sharedVectorPool', while the new ones are
+  /// allocated from 'pool'.
+  ExecCtx(
+      memory::MemoryPool* pool,
+      QueryCtx* queryCtx,
+      VectorPool* sharedVectorPool = nullptr)
       : pool_(pool),
         queryCtx_(queryCtx),
         exprEvalCacheEnabled_(
             !queryCtx ||
             queryCtx->queryConfig().isExpressionEvaluationCacheEnabled()),
+        ownedVectorPool_(
+            exprEvalCacheEnabled_ && sharedVectorPool == nullptr
+                ? std::make_unique<VectorPool>(pool)
+                : nullptr),
         vectorPool_(
-            exprEvalCacheEnabled_ ? std::make_unique<VectorPool>(pool)
-                                  : nullptr) {}
+            ownedVectorPool_ != nullptr
+                ? ownedVectorPool_.get()
+                : (exprEvalCacheEnabled_ ? sharedVectorPool : nullptr)) {}
 
   velox::memory::MemoryPool* pool() const {
     return pool_;
@@ -233,14 +266,14 @@ class ExecCtx {
   }
 
   VectorPool* vectorPool() {
-    return vectorPool_.get();
+    return vectorPool_;
   }
 
   /// Gets a possibly recycled vector of 'type and 'size'. Allocates from
   /// 'pool_' if no pre-allocated vector.
   VectorPtr getVector(const TypePtr& type, vector_size_t size) {
     if (vectorPool_) {
-      return vectorPool_->get(type, size);
+      return vectorPool_->get(type, size, pool_);
     } else {
       return BaseVector::create(type, size, pool_);
     }
@@ -268,7 +301,71 @@ class ExecCtx {
     return exprEvalCacheEnabled_;
   }
 
+  /// Returns 'bytes' of uninitialized memory from a bump arena owned by
+  /// 'this'. The memory stays valid until the outermost ScratchScope on
+  /// 'this' ends, after which the arena is rewound for the next batch. Must
+  /// not be used for anything that outlives the evaluation of the current
+  /// batch, e.g. vector buffers. Memory allocated outside of any scope is kept
+  /// until the next outermost scope ends.
+  char* allocateScratch(uint64_t bytes, int32_t alignment = 1) {
+    if (scratchArena_ == nullptr) {
+      scratchArena_ = std::make_unique<memory::AllocationPool>(pool_);
+    }
+    return scratchArena_->allocateFixed(bytes, alignment);
+  }
+
+  /// Returns uninitialized scratch space for 'count' values of type T. See
+  /// allocateScratch().
+  template <typename T>
+  T* allocateScratch(uint64_t count) {
+    static_assert(std::is_trivially_destructible_v<T>);
+    return reinterpret_cast<T*>(
+        allocateScratch(count * sizeof(T), alignof(T)));
+  }
+
+  /// Bytes currently held by the scratch arena, including space retained
+  /// between batches.
+  int64_t scratchBytes() const {
+    return scratchArena_ == nullptr ? 0 : scratchArena_->allocatedBytes();
+  }
+
+  /// Delimits the lifetime of scratch allocations. Scopes nest, e.g. for an
+  /// ExprSet evaluated from inside a function, and the arena is rewound when
+  /// the outermost one ends.
+  class ScratchScope {
+   public:
+    explicit ScratchScope(ExecCtx* execCtx) : execCtx_(execCtx) {
+      ++execCtx_->scratchDepth_;
+    }
+
+    ~ScratchScope() {
+      if (--execCtx_->scratchDepth_ == 0) {
+        execCtx_->resetScratch();
+      }
+    }
+
+   private:
+    ExecCtx* const execCtx_;
+  };
+
  private:
+  // Makes the scratch arena ready for the next batch. If the last batch fit in
+  // a single run, the run is kept and rewound. Otherwise the runs are freed
+  // and replaced by a single one big enough for the last batch so that steady
+  // state batches do not allocate at all.
+  void resetScratch() {
+    if (scratchArena_ == nullptr || scratchArena_->numRanges() == 0) {
+      return;
+    }
+    if (scratchArena_->numRanges() == 1) {
+      scratchArena_->setFirstFreeInRun(scratchArena_->rangeAt(0).data());
+      return;
+    }
+    const auto highWaterBytes = scratchArena_->allocatedBytes();
+    scratchArena_->clear();
+    scratchArena_->newRun(highWaterBytes);
+  }
+
   // Pool for all Buffers for this thread.
   memory::MemoryPool* const pool_;
   QueryCtx* const queryCtx_;
@@ -279,7 +376,14 @@ class ExecCtx {
   // A pool of preallocated SelectivityVectors for use by expressions
   // and operators.
   std::vector<std::unique_ptr<SelectivityVector>> selectivityVectorPool_;
-  std::unique_ptr<VectorPool> vectorPool_;
+  std::unique_ptr<VectorPool> ownedVectorPool_;
+  // Either 'ownedVectorPool_' or the vector pool shared with other ExecCtxs.
+  VectorPool* const vectorPool_;
+  // Bump arena for scratch memory of expression evaluation. Created on first
+  // use.
+  std::unique_ptr<memory::AllocationPool> scratchArena_;
+  // Number of active ScratchScopes.
+  int32_t scratchDepth_{0};
 };
 
 } // namespace facebook::velox::core
@@ -50,6 +50,18 @@ struct udf_is_default_ascii_behavior<
     util::detail::void_t<decltype(T::is_default_ascii_behavior)>>
     : std::integral_constant<bool, T::is_default_ascii_behavior> {};
 
+// Functions are not vectorizable unless specified explicitly. A vectorizable
+// function has a branch free call() that has no side effects and does not
+// throw, e.g. comparisons and wrap-around arithmetic.
+template <class T, class = void>
+struct udf_is_vectorizable : std::false_type {};
+
+template <class T>
+struct udf_is_vectorizable<
+    T,
+    util::detail::void_t<decltype(T::is_vectorizable)>>
+    : std::integral_constant<bool, T::is_vectorizable> {};
+
 // If a UDF doesn't declare a default help(),
 template <class T, class = void>
 struct udf_help {
@@ -632,6 +644,12 @@ class UDFHolder final
   static constexpr bool is_default_ascii_behavior =
       udf_is_default_ascii_behavior<Fun>();
 
+  // True if call() can be invoked on all rows of flat and constant inputs
+  // without nulls in a dense loop that the compiler vectorizes.
+  static constexpr bool is_vectorizable = udf_is_vectorizable<Fun>() &&
+      udf_has_call && !udf_has_callNullable && !udf_has_callAscii &&
+      !can_produce_null_output;
+
   template <typename T>
   struct ptrfy {
     using type = const T*;
@@ -21,6 +21,7 @@
 #include "velox/vector/TypeAliases.h"
 
 #include <folly/Range.h>
+#include <folly/lang/Bits.h>
 #include <xsimd/config/xsimd_config.hpp> // @manual
 
 namespace facebook::velox::dwio::common {
@@ -111,6 +112,18 @@ static inline uint32_t unpackNaive(
     uint8_t bitWidth,
     T* FOLLY_NONNULL& result);
 
+/// Same as unpackNaive but reads each value with one unaligned 8 byte load,
+/// plus one byte for values of more than 56 bits that straddle 8 bytes. Covers
+/// all widths up to 64 bits. Used on targets without the AVX2 kernels below
+/// and for 64 bit results.
+template <typename T>
+static inline void unpackWords(
+    const uint8_t* FOLLY_NONNULL& inputBits,
+    uint64_t inputBufferLen,
+    uint64_t numValues,
+    uint8_t bitWidth,
+    T* FOLLY_NONNULL& result);
+
 /// Unpack numValues number of input values from inputBuffer. The results
 /// will be written to result. numValues must be a multiple of 8. The
 /// caller needs to make sure the inputBufferLen contains at least numValues
@@ -123,7 +136,7 @@ inline void unpack(
     uint64_t numValues,
     uint8_t bitWidth,
     T* FOLLY_NONNULL& result) {
-  unpackNaive<T>(inputBits, inputBufferLen, numValues, bitWidth, result);
+  unpackWords<T>(inputBits, inputBufferLen, numValues, bitWidth, result);
 }
 
 template <>
@@ -179,6 +192,42 @@ static inline uint32_t unpackNaive(
   return numValues;
 }
 
+template <typename T>
+static inline void unpackWords(
+    const uint8_t* FOLLY_NONNULL& inputBits,
+    uint64_t inputBufferLen,
+    uint64_t numValues,
+    uint8_t bitWidth,
+    T* FOLLY_NONNULL& result) {
+  VELOX_CHECK(bitWidth >= 1 && bitWidth <= sizeof(T) * 8);
+  VELOX_CHECK(inputBufferLen * 8 >= bitWidth * numValues);
+
+  const uint64_t mask =
+      bitWidth == 64 ? ~0ULL : facebook::velox::bits::lowMask(bitWidth);
+  const uint8_t* end = inputBits + inputBufferLen;
+  // Values before 'numFullLoads' can be loaded with 8 bytes that are all
+  // within the buffer. The rest are loaded partially.
+  const uint64_t numFullLoads = inputBufferLen < sizeof(uint64_t)
+      ? 0
+      : std::min<uint64_t>(
+            numValues, (inputBufferLen - sizeof(uint64_t)) * 8 / bitWidth + 1);
+  for (uint64_t i = 0; i < numValues; ++i) {
+    const uint64_t bit = i * bitWidth;
+    const uint8_t* word = inputBits + bit / 8;
+    const auto shift = bit & 7;
+    uint64_t value = i < numFullLoads
+        ? folly::loadUnaligned<uint64_t>(word)
+        : facebook::velox::bits::loadPartialWord(word, end - word);
+    value >>= shift;
+    if (shift + bitWidth > 64) {
+      value |= static_cast<uint64_t>(word[8]) << (64 - shift);
+    }
+    result[i] = static_cast<T>(value & mask);
+  }
+  inputBits += (numValues * bitWidth + 7) / 8;
+  result += numValues;
+}
+
 #if XSIMD_WITH_AVX2
 
 // numValues number of uint16_t values with bitWidth in
@@ -665,7 +714,7 @@ inline void unpack<uint8_t>(
 
 #else
 
-  unpackNaive<uint8_t>(inputBits, inputBufferLen, numValues, bitWidth, result);
+  unpackWords<uint8_t>(inputBits, inputBufferLen, numValues, bitWidth, result);
 
 #endif
 }
@@ -714,7 +763,7 @@ inline void unpack<uint16_t>(
   }
 #else
 
-  unpackNaive<uint16_t>(inputBits, inputBufferLen, numValues, bitWidth, result);
+  unpackWords<uint16_t>(inputBits, inputBufferLen, numValues, bitWidth, result);
 
 #endif
 }
@@ -784,7 +833,7 @@ inline void unpack<uint32_t>(
 
 #else
 
-  unpackNaive<uint32_t>(inputBits, inputBufferLen, numValues, bitWidth, result);
+  unpackWords<uint32_t>(inputBits, inputBufferLen, numValues, bitWidth, result);
 
 #endif
 }
@@ -59,6 +59,16 @@ void BufferedInput::load(const LogType logType) {
 
   } else {
     for (const auto& region : regions_) {
+      // A memory mapped file hands out the region in place.
+      const auto mapped = input_->getReadFile()->mappedRegion(region);
+      if (!mapped.empty()) {
+        offsets_.push_back(region.offset);
+        buffers_.emplace_back(const_cast<char*>(mapped.data()), mapped.size());
+        if (auto* stats = input_->getStats()) {
+          stats->read().increment(region.length);
+        }
+        continue;
+      }
       auto allocated = allocate(region);
       uint64_t usec = 0;
       {
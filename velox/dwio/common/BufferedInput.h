@@ -88,6 +88,11 @@ class BufferedInput {
   read(uint64_t offset, uint64_t length, LogType logType) const {
     std::unique_ptr<SeekableInputStream> ret = readBuffer(offset, length);
     if (!ret) {
+      const auto mapped = input_->getReadFile()->mappedRegion({offset, length});
+      if (!mapped.empty()) {
+        return std::make_unique<SeekableArrayInputStream>(
+            mapped.data(), mapped.size());
+      }
       VLOG(1) << "Unplanned read. Offset: " << offset << ", Length: " << length;
       // We cannot do enqueue/load here because load() clears previously
       // loaded data. TODO: figure out how we can use the data cache for
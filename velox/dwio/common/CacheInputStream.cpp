@@ -16,6 +16,8 @@
 
 #include <folly/executors/QueuedImmediateExecutor.h>
 
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
@@ -206,6 +208,9 @@ void CacheInputStream::loadSync(Region region) {
       // missed, fall back to remote fetching.
       entry->setGroupId(groupId_);
       entry->setTrackingId(trackingId_);
+      if (tracker_ && tracker_->isLargeScan(trackingId_)) {
+        entry->setScanHint();
+      }
       if (loadFromSsd(region, *entry)) {
         return;
       }
@@ -215,13 +220,16 @@ void CacheInputStream::loadSync(Region region) {
         MicrosecondTimer timer(&usec);
         input_->read(ranges, region.offset, LogType::FILE);
       }
+      bufferedInput_->latencyModel().record(region.length, usec);
       ioStats_->read().increment(region.length);
       ioStats_->queryThreadIoLatency().increment(usec);
+      REPORT_ADD_STAT_VALUE(kCounterCacheStorageReadBytes, region.length);
       entry->setExclusiveToShared();
     } else {
       // Hit memory cache.
       if (!entry->getAndClearFirstUseFlag()) {
         ioStats_->ramHit().increment(hitSize);
+        REPORT_ADD_STAT_VALUE(kCounterCacheMemoryHitBytes, hitSize);
       }
       return;
     }
@@ -280,6 +288,7 @@ bool CacheInputStream::loadFromSsd(
   pin_ = std::move(pins[0]);
   ioStats_->ssdRead().increment(region.length);
   ioStats_->queryThreadIoLatency().increment(usec);
+  REPORT_ADD_STAT_VALUE(kCounterCacheSsdHitBytes, region.length);
   entry.setExclusiveToShared();
   return true;
 }
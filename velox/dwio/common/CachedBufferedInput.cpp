@@ -15,8 +15,11 @@
  */
 
 #include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
 
 DEFINE_int32(
@@ -189,6 +192,8 @@ void CachedBufferedInput::load(const LogType) {
           if (cache_->exists(part->key)) {
             continue;
           }
+          part->scanHint = trackingData.numReferences >=
+              cache::ScanTracker::kLargeScanReferences;
           if (ssdFile) {
             part->ssdPin = ssdFile->find(part->key);
             if (!part->ssdPin.empty() &&
@@ -219,6 +224,14 @@ void CachedBufferedInput::makeLoads(
   }
   bool isSsd = !requests[0]->ssdPin.empty();
   int32_t maxDistance = isSsd ? 20000 : options_.maxCoalesceDistance();
+  int64_t maxCoalesceBytes = options_.maxCoalesceBytes();
+  if (!isSsd && options_.adaptiveCoalesce()) {
+    // Prefetched loads are issued in parallel on 'executor_', so these are
+    // split into smaller loads that are in flight at the same time.
+    maxDistance = latencyModel_->coalesceDistance(maxDistance);
+    maxCoalesceBytes = latencyModel_->maxCoalesceBytes(
+        maxCoalesceBytes, prefetch && executor_ != nullptr);
+  }
   std::sort(
       requests.begin(),
       requests.end(),
@@ -248,7 +261,7 @@ void CachedBufferedInput::makeLoads(
         return size;
       },
       [&](int32_t index) {
-        if (coalescedBytes > options_.maxCoalesceBytes()) {
+        if (coalescedBytes > maxCoalesceBytes) {
           coalescedBytes = 0;
           return kNoCoalesce;
         }
@@ -264,7 +277,7 @@ void CachedBufferedInput::makeLoads(
           uint64_t /*offset*/,
           const std::vector<CacheRequest*>& ranges) {
         ++numNewLoads;
-        readRegion(ranges, prefetch);
+        readRegion(ranges, prefetch, maxDistance);
       });
   if (prefetch && executor_) {
     std::vector<int32_t> doneIndices;
@@ -337,8 +350,11 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
       ioStats_->incRawOverreadBytes(stats.extraBytes);
       if (isSsd) {
         ioStats_->ssdRead().increment(stats.payloadBytes);
+        REPORT_ADD_STAT_VALUE(kCounterCacheSsdHitBytes, stats.payloadBytes);
       } else {
         ioStats_->read().increment(stats.payloadBytes);
+        REPORT_ADD_STAT_VALUE(
+            kCounterCacheStorageReadBytes, stats.payloadBytes);
       }
       if (isPrefetch) {
         ioStats_->prefetch().increment(stats.payloadBytes);
@@ -381,10 +397,12 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
       std::shared_ptr<IoStatistics> ioStats,
       uint64_t groupId,
       std::vector<CacheRequest*> requests,
-      int32_t maxCoalesceDistance)
+      int32_t maxCoalesceDistance,
+      io::IoLatencyModel& latencyModel)
       : DwioCoalescedLoadBase(cache, ioStats, groupId, std::move(requests)),
         input_(std::move(input)),
-        maxCoalesceDistance_(maxCoalesceDistance) {}
+        maxCoalesceDistance_(maxCoalesceDistance),
+        latencyModel_(latencyModel) {}
 
   std::vector<CachePin> loadData(bool isPrefetch) override {
     std::vector<CachePin> pins;
@@ -392,10 +410,11 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
     cache_.makePins(
         keys_,
         [&](int32_t index) { return sizes_[index]; },
-        [&](int32_t /*index*/, CachePin pin) {
+        [&](int32_t index, CachePin pin) {
           if (isPrefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
+          pin.checkedEntry()->setScanHint(requests_[index].scanHint);
           pins.push_back(std::move(pin));
         });
     if (pins.empty()) {
@@ -411,7 +430,16 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
             int32_t /*end*/,
             uint64_t offset,
             const std::vector<folly::Range<char*>>& buffers) {
-          input_->read(buffers, offset, LogType::FILE);
+          uint64_t usec = 0;
+          {
+            MicrosecondTimer timer(&usec);
+            input_->read(buffers, offset, LogType::FILE);
+          }
+          uint64_t bytes = 0;
+          for (const auto& buffer : buffers) {
+            bytes += buffer.size();
+          }
+          latencyModel_.record(bytes, usec);
         });
     updateStats(stats, isPrefetch, false);
     return pins;
@@ -419,6 +447,7 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
 
   std::shared_ptr<ReadFileInputStream> input_;
   const int32_t maxCoalesceDistance_;
+  io::IoLatencyModel& latencyModel_;
 };
 
 // Represents a CoalescedLoad from local SSD cache.
@@ -441,6 +470,7 @@ class SsdLoad : public DwioCoalescedLoadBase {
           if (isPrefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
+          pin.checkedEntry()->setScanHint(requests_[index].scanHint);
           pins.push_back(std::move(pin));
           ssdPins.push_back(std::move(requests_[index].ssdPin));
         });
@@ -458,7 +488,8 @@ class SsdLoad : public DwioCoalescedLoadBase {
 
 void CachedBufferedInput::readRegion(
     std::vector<CacheRequest*> requests,
-    bool prefetch) {
+    bool prefetch,
+    int32_t maxCoalesceDistance) {
   if (requests.empty() || (requests.size() == 1 && !prefetch)) {
     return;
   }
@@ -472,7 +503,8 @@ void CachedBufferedInput::readRegion(
         ioStats_,
         groupId_,
         requests,
-        options_.maxCoalesceDistance());
+        maxCoalesceDistance,
+        *latencyModel_);
   }
   allCoalescedLoads_.push_back(load);
   coalescedLoads_.withWLock([&](auto& loads) {
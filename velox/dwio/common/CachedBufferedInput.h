@@ -21,6 +21,7 @@
 #include "velox/common/caching/FileGroupStats.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/SsdCache.h"
+#include "velox/common/io/IoLatencyModel.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/common/io/Options.h"
 #include "velox/dwio/common/BufferedInput.h"
@@ -51,6 +52,10 @@ struct CacheRequest {
   // for sparsely accessed large columns where hitting one piece
   // should not load the adjacent pieces.
   bool coalesces{true};
+
+  // True if this is part of a stream that the scan references often enough
+  // for its data to be read only once. See ScanTracker::isLargeScan().
+  bool scanHint{false};
   const SeekableInputStream* FOLLY_NONNULL stream;
 };
 
@@ -77,7 +82,8 @@ class CachedBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(readerOptions),
+        latencyModel_(&io::IoLatencyModel::forPath(input_->getName())) {}
 
   CachedBufferedInput(
       std::shared_ptr<ReadFileInputStream> input,
@@ -96,7 +102,8 @@ class CachedBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(readerOptions),
+        latencyModel_(&io::IoLatencyModel::forPath(input_->getName())) {}
 
   ~CachedBufferedInput() override {
     for (auto& load : allCoalescedLoads_) {
@@ -163,6 +170,12 @@ class CachedBufferedInput : public BufferedInput {
     return prefetchSize_;
   }
 
+  /// Returns the model of the storage of the file. All reads from storage are
+  /// recorded in the model.
+  io::IoLatencyModel& latencyModel() const {
+    return *latencyModel_;
+  }
+
  private:
   // Sorts requests and makes CoalescedLoads for nearby requests. If 'prefetch'
   // is true, starts background loading.
@@ -171,9 +184,12 @@ class CachedBufferedInput : public BufferedInput {
   // Makes a CoalescedLoad for 'requests' to be read together, coalescing
   // IO is appropriate. If 'prefetch' is set, schedules the CoalescedLoad
   // on 'executor_'. Links the CoalescedLoad  to all CacheInputStreams that it
-  // concerns.
-
-  void readRegion(std::vector<CacheRequest*> requests, bool prefetch);
+  // concerns. 'maxCoalesceDistance' is the largest gap to read through
+  // between the requests.
+  void readRegion(
+      std::vector<CacheRequest*> requests,
+      bool prefetch,
+      int32_t maxCoalesceDistance);
 
   cache::AsyncDataCache* FOLLY_NONNULL cache_;
   const uint64_t fileNum_;
@@ -197,6 +213,7 @@ class CachedBufferedInput : public BufferedInput {
   const uint64_t fileSize_;
   int64_t prefetchSize_{0};
   io::ReaderOptions options_;
+  io::IoLatencyModel* const latencyModel_;
 };
 
 } // namespace facebook::velox::dwio::common
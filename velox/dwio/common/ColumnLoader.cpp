@@ -75,17 +75,39 @@ void ColumnLoader::loadInternal(
     effectiveRows = RowSet(selectedRows);
   }
 
-  structReader_->advanceFieldReader(fieldReader_, offset);
+  // The filters may have left only a few rows far from 'offset'. If the first
+  // of them is in a later row group than 'offset', seek 'fieldReader_' to that
+  // row group with the row group index instead of decompressing and decoding
+  // all the rows in between, and read the rows relative to the start of the
+  // row group. Value hooks and parent nulls are addressed by the row numbers
+  // relative to 'offset', so these are read from 'offset'.
+  auto readOffset = offset;
+  RowSet readRows = effectiveRows;
+  raw_vector<vector_size_t> shiftedRows;
+  if (!hook && !incomingNulls) {
+    structReader_->advanceFieldReader(fieldReader_, offset + effectiveRows[0]);
+    if (fieldReader_->readOffset() > offset) {
+      readOffset = fieldReader_->readOffset();
+      const auto bias = readOffset - offset;
+      shiftedRows.resize(effectiveRows.size());
+      for (auto i = 0; i < effectiveRows.size(); ++i) {
+        shiftedRows[i] = effectiveRows[i] - bias;
+      }
+      readRows = RowSet(shiftedRows);
+    }
+  } else {
+    structReader_->advanceFieldReader(fieldReader_, offset);
+  }
   fieldReader_->scanSpec()->setValueHook(hook);
-  fieldReader_->read(offset, effectiveRows, incomingNulls);
+  fieldReader_->read(readOffset, readRows, incomingNulls);
   if (fieldReader_->fileType().type()->kind() == TypeKind::ROW) {
     // 'fieldReader_' may itself produce LazyVectors. For this it must have its
     // result row numbers set.
     static_cast<SelectiveStructColumnReaderBase*>(fieldReader_)
-        ->setLoadableRows(effectiveRows);
+        ->setLoadableRows(readRows);
   }
   if (!hook) {
-    fieldReader_->getValues(effectiveRows, result);
+    fieldReader_->getValues(readRows, result);
     if (((rows.back() + 1) < resultSize) || rows.size() != outputRows.size()) {
       // We read sparsely. The values that were read should appear
       // at the indices in the result vector that were given by
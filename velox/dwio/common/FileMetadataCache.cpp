@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+DEFINE_int64(
+    velox_file_metadata_cache_bytes,
+    0,
+    "Size of the worker wide cache of parsed file footers. 0 disables it");
+
+namespace facebook::velox::dwio::common {
+
+// static
+FileMetadataCache* FileMetadataCache::instance() {
+  if (FLAGS_velox_file_metadata_cache_bytes <= 0) {
+    return nullptr;
+  }
+  // Never destroyed since readers may outlive static destruction.
+  static auto* cache =
+      new FileMetadataCache(FLAGS_velox_file_metadata_cache_bytes);
+  return cache;
+}
+
+std::shared_ptr<const void> FileMetadataCache::getInternal(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numLookups_;
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  ++numHits_;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->metadata;
+}
+
+void FileMetadataCache::put(
+    const std::string& key,
+    std::shared_ptr<const void> metadata,
+    int64_t bytes) {
+  if (bytes > maxBytes_) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    removeLocked(it->second);
+  }
+  while (!lru_.empty() && curBytes_ + bytes > maxBytes_) {
+    removeLocked(std::prev(lru_.end()));
+    ++numEvictions_;
+  }
+  lru_.push_front({key, std::move(metadata), bytes});
+  entries_[key] = lru_.begin();
+  curBytes_ += bytes;
+}
+
+void FileMetadataCache::removeLocked(std::list<Entry>::iterator it) {
+  curBytes_ -= it->bytes;
+  entries_.erase(it->key);
+  lru_.erase(it);
+}
+
+void FileMetadataCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  lru_.clear();
+  entries_.clear();
+  curBytes_ = 0;
+}
+
+FileMetadataCache::Stats FileMetadataCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return {
+      static_cast<int64_t>(entries_.size()),
+      curBytes_,
+      maxBytes_,
+      numHits_,
+      numLookups_,
+      numEvictions_};
+}
+
+} // namespace facebook::velox::dwio::common
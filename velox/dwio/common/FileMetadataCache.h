@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <gflags/gflags.h>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+DECLARE_int64(velox_file_metadata_cache_bytes);
+
+namespace facebook::velox::dwio::common {
+
+/// Worker wide LRU cache of the parsed footers of files, e.g. the DWRF
+/// PostScript and Footer or the Parquet FileMetaData. Readers of a file that
+/// find its footer in the cache skip reading and decoding the tail of the
+/// file. The entries are immutable and shared by all readers of the file.
+///
+/// The key identifies a version of a file, e.g. the path plus the
+/// modification time or etag, so that a rewritten file does not hit the
+/// footer of its previous version. The cache is bounded by the total size of
+/// the entries as reported by the reader that adds them.
+///
+/// Thread safe.
+class FileMetadataCache {
+ public:
+  struct Stats {
+    int64_t numEntries{0};
+    int64_t curBytes{0};
+    int64_t maxBytes{0};
+    int64_t numHits{0};
+    int64_t numLookups{0};
+    int64_t numEvictions{0};
+  };
+
+  explicit FileMetadataCache(int64_t maxBytes) : maxBytes_(maxBytes) {}
+
+  /// Returns the process wide cache sized by
+  /// FLAGS_velox_file_metadata_cache_bytes or nullptr if the flag is 0.
+  static FileMetadataCache* instance();
+
+  /// Returns the entry for 'key' or nullptr if there is none. The caller must
+  /// know the type the entry was added with.
+  template <typename T>
+  std::shared_ptr<const T> get(const std::string& key) {
+    return std::static_pointer_cast<const T>(getInternal(key));
+  }
+
+  /// Adds 'metadata' of 'bytes' for 'key', replacing an existing entry, and
+  /// evicts least recently used entries until the cache fits in its maximum
+  /// size. An entry larger than the cache is not added.
+  void put(
+      const std::string& key,
+      std::shared_ptr<const void> metadata,
+      int64_t bytes);
+
+  void clear();
+
+  Stats stats() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<const void> metadata;
+    int64_t bytes;
+  };
+
+  std::shared_ptr<const void> getInternal(const std::string& key);
+
+  // Removes the entry at 'it'.
+  void removeLocked(std::list<Entry>::iterator it);
+
+  const int64_t maxBytes_;
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> lru_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> entries_;
+  int64_t curBytes_{0};
+  int64_t numHits_{0};
+  int64_t numLookups_{0};
+  int64_t numEvictions_{0};
+};
+
+} // namespace facebook::velox::dwio::common
@@ -116,6 +116,12 @@ class RowReaderOptions {
   // 'ioExecutor' enables parallelism when performing file system read
   // operations.
   std::shared_ptr<folly::Executor> decodingExecutor_;
+  // Number of stripes after the current one that are fetched in parallel on
+  // 'decodingExecutor_'.
+  uint32_t parallelStripeFetches_ = 0;
+  // Number of compression blocks after the current one that are decompressed
+  // ahead on 'decodingExecutor_'.
+  uint32_t decompressionReadAheadBlocks_ = 0;
   bool appendRowNumberColumn_ = false;
   // Function to populate metrics related to feature projection stats
   // in Koski. This gets fired in FlatMapColumnReader.
@@ -306,6 +312,34 @@ class RowReaderOptions {
     decodingExecutor_ = executor;
   }
 
+  /// Sets the number of stripes after the current one to fetch on the decoding
+  /// executor while the current stripe is read. A fetch reads the stripe,
+  /// decompresses its footer and builds its column readers, so that a split
+  /// over a few large files uses more than one core. The rows are still
+  /// returned in file order. Fetches are not started when the stripe does not
+  /// fit in the free capacity of the memory pool of the reader. 0 disables
+  /// parallel fetches. Seeking is not supported after a parallel fetch.
+  void setParallelStripeFetches(uint32_t numStripes) {
+    parallelStripeFetches_ = numStripes;
+  }
+
+  uint32_t getParallelStripeFetches() const {
+    return parallelStripeFetches_;
+  }
+
+  /// Sets the number of compression blocks after the current one that each
+  /// stream decompresses ahead on the decoding executor, so that
+  /// decompression overlaps with decoding and filtering. Memory use grows by
+  /// up to this many decompressed blocks per stream being read. 0 disables
+  /// the read ahead.
+  void setDecompressionReadAheadBlocks(uint32_t numBlocks) {
+    decompressionReadAheadBlocks_ = numBlocks;
+  }
+
+  uint32_t getDecompressionReadAheadBlocks() const {
+    return decompressionReadAheadBlocks_;
+  }
+
   /*
    * Set to true, if you want to add a new column to the results containing the
    * row numbers.  These row numbers are relative to the beginning of file (0 as
@@ -370,6 +404,7 @@ class ReaderOptions : public io::ReaderOptions {
   bool fileColumnNamesReadAsLowerCase{false};
   bool useColumnNamesForColumnMapping_{false};
   std::shared_ptr<folly::Executor> ioExecutor_;
+  std::string fileMetadataCacheKey_;
 
  public:
   static constexpr uint64_t kDefaultDirectorySizeGuess = 1024 * 1024; // 1MB
@@ -397,6 +432,7 @@ class ReaderOptions : public io::ReaderOptions {
     filePreloadThreshold = other.filePreloadThreshold;
     fileColumnNamesReadAsLowerCase = other.fileColumnNamesReadAsLowerCase;
     useColumnNamesForColumnMapping_ = other.useColumnNamesForColumnMapping_;
+    fileMetadataCacheKey_ = other.fileMetadataCacheKey_;
     return *this;
   }
 
@@ -410,8 +446,8 @@ class ReaderOptions : public io::ReaderOptions {
         directorySizeGuess(other.directorySizeGuess),
         filePreloadThreshold(other.filePreloadThreshold),
         fileColumnNamesReadAsLowerCase(other.fileColumnNamesReadAsLowerCase),
-        useColumnNamesForColumnMapping_(other.useColumnNamesForColumnMapping_) {
-  }
+        useColumnNamesForColumnMapping_(other.useColumnNamesForColumnMapping_),
+        fileMetadataCacheKey_(other.fileMetadataCacheKey_) {}
 
   /**
    * Set the format of the file, such as "rc" or "dwrf".  The
@@ -480,6 +516,14 @@ class ReaderOptions : public io::ReaderOptions {
     return *this;
   }
 
+  /// Sets the key of the file in FileMetadataCache. The key must change when
+  /// the file is rewritten. The parsed footer of the file is cached only if
+  /// the key is set and the cache is enabled.
+  ReaderOptions& setFileMetadataCacheKey(std::string key) {
+    fileMetadataCacheKey_ = std::move(key);
+    return *this;
+  }
+
   /**
    * Get the desired tail location.
    * @return if not set, return the maximum long.
@@ -534,6 +578,10 @@ class ReaderOptions : public io::ReaderOptions {
   bool isUseColumnNamesForColumnMapping() const {
     return useColumnNamesForColumnMapping_;
   }
+
+  const std::string& fileMetadataCacheKey() const {
+    return fileMetadataCacheKey_;
+  }
 };
 
 struct WriterMemoryReclaimConfig {
@@ -30,6 +30,8 @@ ScanSpec& ScanSpec::operator=(const ScanSpec& other) {
     extractValues_ = other.extractValues_;
     makeFlat_ = other.makeFlat_;
     filter_ = other.filter_;
+    lengthFilter_ = other.lengthFilter_;
+    multiColumnFilter_ = other.multiColumnFilter_;
     metadataFilters_ = other.metadataFilters_;
     selectivity_ = other.selectivity_;
     enableFilterReorder_ = other.enableFilterReorder_;
@@ -139,7 +141,7 @@ bool ScanSpec::hasFilter() const {
   if (hasFilter_.has_value()) {
     return hasFilter_.value();
   }
-  if (!isConstant() && filter_) {
+  if (!isConstant() && (filter_ || lengthFilter_ || multiColumnFilter_)) {
     hasFilter_ = true;
     return true;
   }
@@ -167,6 +169,7 @@ void ScanSpec::moveAdaptationFrom(ScanSpec& other) {
           // 'child' is constant there is no adaptation that can be
           // received.
           child->filter_ = std::move(otherChild->filter_);
+          child->lengthFilter_ = std::move(otherChild->lengthFilter_);
           child->selectivity_ = otherChild->selectivity_;
         }
         childByFieldName_[child->fieldName_] = child.get();
@@ -385,6 +388,9 @@ std::string ScanSpec::toString() const {
     if (filter_) {
       out << " filter " << filter_->toString();
     }
+    if (lengthFilter_) {
+      out << " length filter " << lengthFilter_->toString();
+    }
     if (isConstant()) {
       out << " constant";
     }
@@ -33,6 +33,25 @@ class ColumnStatistics;
 }
 namespace common {
 
+// A filter on several children of a struct, e.g. 'a > b', that no single
+// column Filter can express. The struct reader evaluates it right after
+// reading its inputs, so that the children read after them, including the
+// ones loaded lazily, are only decoded for the rows that pass.
+class MultiColumnFilter {
+ public:
+  virtual ~MultiColumnFilter() = default;
+
+  // Names of the children of the struct that the filter reads.
+  virtual const std::vector<std::string>& inputs() const = 0;
+
+  // Evaluates the filter on the rows of 'input', which has one child for
+  // each of 'inputs()' in the same order. Sets 'passed' to the positions in
+  // 'input' of the rows that pass, in ascending order.
+  virtual void filter(
+      const RowVectorPtr& input,
+      std::vector<vector_size_t>& passed) = 0;
+};
+
 // Describes the filtering and value extraction for a
 // SelectiveColumnReader. This is owned by the TableScan Operator and
 // is passed to SelectiveColumnReaders at construction.  This is
@@ -77,6 +96,30 @@ class ScanSpec {
 
   void addFilter(const Filter&);
 
+  // Filter on several children of this struct. Only supported on the top
+  // level ScanSpec. See MultiColumnFilter.
+  MultiColumnFilter* multiColumnFilter() const {
+    return multiColumnFilter_.get();
+  }
+
+  void setMultiColumnFilter(std::shared_ptr<MultiColumnFilter> filter) {
+    multiColumnFilter_ = std::move(filter);
+    hasFilter_.reset();
+  }
+
+  // Filter on the number of elements of a list or map, e.g. from
+  // 'cardinality(c) > 0'. Repeated readers apply this to the lengths
+  // before reading any nested data, so that the elements of rows that
+  // do not pass are skipped. A null list or map passes if the filter
+  // passes nulls.
+  common::Filter* lengthFilter() const {
+    return lengthFilter_.get();
+  }
+
+  void setLengthFilter(std::unique_ptr<Filter> filter) {
+    lengthFilter_ = std::move(filter);
+  }
+
   void setMaxArrayElementsCount(vector_size_t count) {
     maxArrayElementsCount_ = count;
   }
@@ -236,6 +279,9 @@ class ScanSpec {
   // the nulls stream. True if filter is is-null with or without value
   // extraction or if filter is is-not-null and no value is extracted.
   bool readsNullsOnly() const {
+    if (lengthFilter_) {
+      return false;
+    }
     if (filter_) {
       if (filter_->kind() == FilterKind::kIsNull) {
         return true;
@@ -355,6 +401,8 @@ class ScanSpec {
   // returned as flat.
   bool makeFlat_ = false;
   std::shared_ptr<common::Filter> filter_;
+  std::shared_ptr<common::Filter> lengthFilter_;
+  std::shared_ptr<MultiColumnFilter> multiColumnFilter_;
 
   // Filters that will be only used for row group filtering based on metadata.
   // The conjunctions among these filters are tracked in MetadataFilter, with
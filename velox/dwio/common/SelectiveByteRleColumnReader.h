@@ -140,6 +140,30 @@ void SelectiveByteRleColumnReader::processValueHook(
           rows,
           dwio::common::ExtractToHook<SumHook<int64_t, int64_t>>(hook));
       break;
+    case aggregate::AggregationHook::kSumTinyintToBigint:
+      readHelper<Reader, velox::common::AlwaysTrue, isDense>(
+          &dwio::common::alwaysTrue(),
+          rows,
+          dwio::common::ExtractToHook<SumHook<int8_t, int64_t>>(hook));
+      break;
+    case aggregate::AggregationHook::kTinyintMax:
+      readHelper<Reader, velox::common::AlwaysTrue, isDense>(
+          &dwio::common::alwaysTrue(),
+          rows,
+          dwio::common::ExtractToHook<MinMaxHook<int8_t, false>>(hook));
+      break;
+    case aggregate::AggregationHook::kTinyintMin:
+      readHelper<Reader, velox::common::AlwaysTrue, isDense>(
+          &dwio::common::alwaysTrue(),
+          rows,
+          dwio::common::ExtractToHook<MinMaxHook<int8_t, true>>(hook));
+      break;
+    case aggregate::AggregationHook::kCount:
+      readHelper<Reader, velox::common::AlwaysTrue, isDense>(
+          &dwio::common::alwaysTrue(),
+          rows,
+          dwio::common::ExtractToHook<CountHook>(hook));
+      break;
     default:
       readHelper<Reader, velox::common::AlwaysTrue, isDense>(
           &dwio::common::alwaysTrue(),
@@ -323,6 +323,9 @@ void SelectiveColumnReader::addStringValue(folly::StringPiece value) {
 }
 
 bool SelectiveColumnReader::readsNullsOnly() const {
+  if (scanSpec_->lengthFilter()) {
+    return false;
+  }
   auto filter = scanSpec_->filter();
   if (filter) {
     auto kind = filter->kind();
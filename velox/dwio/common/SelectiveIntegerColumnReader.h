@@ -151,6 +151,10 @@ void SelectiveIntegerColumnReader::processFilter(
       readHelper<Reader, velox::common::BigintValuesUsingBitmask, isDense>(
           filter, rows, extractValues);
       break;
+    case velox::common::FilterKind::kBigintValuesUsingBloomFilter:
+      readHelper<Reader, velox::common::BigintValuesUsingBloomFilter, isDense>(
+          filter, rows, extractValues);
+      break;
     case velox::common::FilterKind::kNegatedBigintValuesUsingHashTable:
       readHelper<
           Reader,
@@ -163,6 +167,10 @@ void SelectiveIntegerColumnReader::processFilter(
           velox::common::NegatedBigintValuesUsingBitmask,
           isDense>(filter, rows, extractValues);
       break;
+    case velox::common::FilterKind::kHugeintRange:
+      readHelper<Reader, velox::common::HugeintRange, isDense>(
+          filter, rows, extractValues);
+      break;
     default:
       readHelper<Reader, velox::common::Filter, isDense>(
           filter, rows, extractValues);
@@ -193,6 +201,48 @@ void SelectiveIntegerColumnReader::processValueHook(
           rows,
           ExtractToHook<aggregate::MinMaxHook<int64_t, true>>(hook));
       break;
+    // The decoders may produce the values of narrower columns as int64_t. The
+    // hooks read the low bytes, which hold the value on little endian.
+    case aggregate::AggregationHook::kSumIntegerToBigint:
+      readHelper<Reader, velox::common::AlwaysTrue, isDense>(
+          &alwaysTrue(),
+          rows,
+          ExtractToHook<aggregate::SumHook<int32_t, int64_t>>(hook));
+      break;
+    case aggregate::AggregationHook::kSumSmallintToBigint:
+      readHelper<Reader, velox::common::AlwaysTrue, isDense>(
+          &alwaysTrue(),
+          rows,
+          ExtractToHook<aggregate::SumHook<int16_t, int64_t>>(hook));
+      break;
+    case aggregate::AggregationHook::kIntegerMax:
+      readHelper<Reader, velox::common::AlwaysTrue, isDense>(
+          &alwaysTrue(),
+          rows,
+          ExtractToHook<aggregate::MinMaxHook<int32_t, false>>(hook));
+      break;
+    case aggregate::AggregationHook::kIntegerMin:
+      readHelper<Reader, velox::common::AlwaysTrue, isDense>(
+          &alwaysTrue(),
+          rows,
+          ExtractToHook<aggregate::MinMaxHook<int32_t, true>>(hook));
+      break;
+    case aggregate::AggregationHook::kSmallintMax:
+      readHelper<Reader, velox::common::AlwaysTrue, isDense>(
+          &alwaysTrue(),
+          rows,
+          ExtractToHook<aggregate::MinMaxHook<int16_t, false>>(hook));
+      break;
+    case aggregate::AggregationHook::kSmallintMin:
+      readHelper<Reader, velox::common::AlwaysTrue, isDense>(
+          &alwaysTrue(),
+          rows,
+          ExtractToHook<aggregate::MinMaxHook<int16_t, true>>(hook));
+      break;
+    case aggregate::AggregationHook::kCount:
+      readHelper<Reader, velox::common::AlwaysTrue, isDense>(
+          &alwaysTrue(), rows, ExtractToHook<aggregate::CountHook>(hook));
+      break;
     default:
       readHelper<Reader, velox::common::AlwaysTrue, isDense>(
           &alwaysTrue(), rows, ExtractToGenericHook(hook));
@@ -88,9 +88,7 @@ advanceNestedRows(const RowSet& rows, vector_size_t i, vector_size_t last) {
 
 } // namespace
 
-void SelectiveRepeatedColumnReader::makeNestedRowSet(
-    RowSet rows,
-    int32_t maxRow) {
+void SelectiveRepeatedColumnReader::readAllLengths(int32_t maxRow) {
   if (!allLengthsHolder_ ||
       allLengthsHolder_->capacity() < (maxRow + 1) * sizeof(vector_size_t)) {
     allLengthsHolder_ = allocateIndices(maxRow + 1, &memoryPool_);
@@ -100,6 +98,12 @@ void SelectiveRepeatedColumnReader::makeNestedRowSet(
   // Reads the lengths, leaves an uninitialized gap for a null
   // map/list. Reading these checks the null mask.
   readLengths(allLengths_, maxRow + 1, nulls);
+}
+
+void SelectiveRepeatedColumnReader::makeNestedRowSet(
+    RowSet rows,
+    int32_t maxRow) {
+  auto nulls = nullsInReadRange_ ? nullsInReadRange_->as<uint64_t>() : nullptr;
   vector_size_t nestedLength = 0;
   for (auto row : rows) {
     if (!nulls || !bits::isBitNull(nulls, row)) {
@@ -167,8 +171,16 @@ void SelectiveRepeatedColumnReader::makeOffsetsAndSizes(
 }
 
 RowSet SelectiveRepeatedColumnReader::applyFilter(RowSet rows) {
+  auto* lengthFilter = scanSpec_->lengthFilter();
   if (!scanSpec_->filter()) {
-    return rows;
+    if (!lengthFilter) {
+      return rows;
+    }
+    for (auto row : rows) {
+      addOutputRow(row);
+    }
+    applyLengthFilter(*lengthFilter);
+    return outputRows_;
   }
   switch (scanSpec_->filter()->kind()) {
     case velox::common::FilterKind::kIsNull:
@@ -183,9 +195,30 @@ RowSet SelectiveRepeatedColumnReader::applyFilter(RowSet rows) {
           scanSpec_->fieldName(),
           scanSpec_->filter()->toString());
   }
+  if (lengthFilter) {
+    applyLengthFilter(*lengthFilter);
+  }
   return outputRows_;
 }
 
+void SelectiveRepeatedColumnReader::applyLengthFilter(
+    const velox::common::Filter& filter) {
+  auto* nulls = nullsInReadRange_ ? nullsInReadRange_->as<uint64_t>() : nullptr;
+  // Lengths of null rows are not initialized, so these are tested with
+  // testNull().
+  vector_size_t numPassed = 0;
+  for (auto i = 0; i < outputRows_.size(); ++i) {
+    auto row = outputRows_[i];
+    bool passed = nulls && bits::isBitNull(nulls, row)
+        ? filter.testNull()
+        : filter.testInt64(allLengths_[row]);
+    if (passed) {
+      outputRows_[numPassed++] = row;
+    }
+  }
+  outputRows_.resize(numPassed);
+}
+
 void SelectiveRepeatedColumnReader::setResultNulls(BaseVector& result) {
   if (anyNulls_) {
     resultNulls_->setSize(bits::nbytes(result.size()));
@@ -237,6 +270,7 @@ void SelectiveListColumnReader::read(
   // Catch up if the child is behind the length stream.
   child_->seekTo(childTargetReadOffset_, false);
   prepareRead<char>(offset, rows, incomingNulls);
+  readAllLengths(rows.back());
   auto activeRows = applyFilter(rows);
   makeNestedRowSet(activeRows, rows.back());
   if (child_ && !nestedRows_.empty()) {
@@ -314,6 +348,7 @@ void SelectiveMapColumnReader::read(
   }
 
   prepareRead<char>(offset, rows, incomingNulls);
+  readAllLengths(rows.back());
   auto activeRows = applyFilter(rows);
   makeNestedRowSet(activeRows, rows.back());
   if (keyReader_ && elementReader_ && !nestedRows_.empty()) {
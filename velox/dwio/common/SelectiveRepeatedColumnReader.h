@@ -57,7 +57,12 @@ class SelectiveRepeatedColumnReader : public SelectiveColumnReader {
       int32_t numLengths,
       const uint64_t* FOLLY_NULLABLE nulls) = 0;
 
-  // Create row set for child columns based on the row set of parent column.
+  // Reads the lengths of all rows up to and including 'maxRow' into
+  // 'allLengths_'.
+  void readAllLengths(int32_t maxRow);
+
+  // Create row set for child columns based on the row set of parent
+  // column. 'allLengths_' must have been filled by readAllLengths().
   void makeNestedRowSet(RowSet rows, int32_t maxRow);
 
   // Compute the offsets and lengths based on the current filtered rows passed
@@ -74,9 +79,13 @@ class SelectiveRepeatedColumnReader : public SelectiveColumnReader {
   }
 
   // Apply filter on parent level.  Child filtering should be handled separately
-  // in subclasses.
+  // in subclasses. The null filter is applied first, followed by the length
+  // filter of 'scanSpec_', if any. Expects the lengths to have been read.
   RowSet applyFilter(RowSet rows);
 
+  // Removes the rows in 'outputRows_' whose length does not pass 'filter'.
+  void applyLengthFilter(const velox::common::Filter& filter);
+
   void setResultNulls(BaseVector& result);
 
   BufferPtr allLengthsHolder_;
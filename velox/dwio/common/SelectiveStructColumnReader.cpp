@@ -60,6 +60,13 @@ void SelectiveStructColumnReaderBase::next(
     if (mutation && mutation->deletedRows) {
       numValues -= bits::countBits(mutation->deletedRows, 0, numValues);
     }
+    if (scanSpec_->multiColumnFilter()) {
+      // The filter reads only constants. The rows that pass are
+      // interchangeable.
+      rows_.resize(numValues);
+      std::iota(rows_.begin(), rows_.end(), 0);
+      numValues = applyMultiColumnFilter(rows_).size();
+    }
 
     // no readers
     // This can be either count(*) query or a query that select only
@@ -134,15 +141,39 @@ void SelectiveStructColumnReaderBase::read(
 
   auto& childSpecs = scanSpec_->children();
   VELOX_CHECK(!childSpecs.empty());
-  for (size_t i = 0; i < childSpecs.size(); ++i) {
+  auto* multiColumnFilter = scanSpec_->multiColumnFilter();
+  multiColumnFilterInputRows_.clear();
+  multiColumnFilterValues_.clear();
+  // Number of inputs of 'multiColumnFilter' that are still to be read.
+  int32_t numPendingFilterInputs = 0;
+  if (multiColumnFilter) {
+    for (const auto& name : multiColumnFilter->inputs()) {
+      auto* childSpec = scanSpec_->childByName(name);
+      VELOX_CHECK_NOT_NULL(childSpec, "Input of multi column filter not found");
+      if (!isChildConstant(*childSpec)) {
+        ++numPendingFilterInputs;
+      }
+    }
+    if (numPendingFilterInputs == 0) {
+      activeRows = applyMultiColumnFilter(activeRows);
+      multiColumnFilter = nullptr;
+    }
+  }
+  for (size_t i = 0; i < childSpecs.size() && !activeRows.empty(); ++i) {
     auto& childSpec = childSpecs[i];
     if (isChildConstant(*childSpec)) {
       continue;
     }
     auto fieldIndex = childSpec->subscript();
     auto reader = children_.at(fieldIndex);
+    const bool isFilterInput = multiColumnFilter != nullptr &&
+        std::find(
+            multiColumnFilter->inputs().begin(),
+            multiColumnFilter->inputs().end(),
+            childSpec->fieldName()) != multiColumnFilter->inputs().end();
     if (reader->isTopLevel() && childSpec->projectOut() &&
-        !childSpec->hasFilter() && !childSpec->extractValues()) {
+        !childSpec->hasFilter() && !childSpec->extractValues() &&
+        !isFilterInput) {
       // Will make a LazyVector.
       continue;
     }
@@ -160,12 +191,13 @@ void SelectiveStructColumnReaderBase::read(
         activeRows = reader->outputRows();
         childSpec->selectivity().addOutput(activeRows.size());
       }
-      if (activeRows.empty()) {
-        break;
-      }
     } else {
       reader->read(offset, activeRows, structNulls);
     }
+    if (isFilterInput && --numPendingFilterInputs == 0 && !activeRows.empty()) {
+      activeRows = applyMultiColumnFilter(activeRows);
+      multiColumnFilter = nullptr;
+    }
   }
 
   // If this adds nulls, the field readers will miss a value for each null added
@@ -179,6 +211,68 @@ void SelectiveStructColumnReaderBase::read(
   readOffset_ = offset + rows.back() + 1;
 }
 
+RowSet SelectiveStructColumnReaderBase::applyMultiColumnFilter(RowSet rows) {
+  auto* filter = scanSpec_->multiColumnFilter();
+  multiColumnFilterInputRows_.assign(rows.begin(), rows.end());
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  std::vector<VectorPtr> inputs;
+  for (const auto& name : filter->inputs()) {
+    auto* childSpec = scanSpec_->childByName(name);
+    VELOX_CHECK_NOT_NULL(childSpec, "Input of multi column filter not found");
+    VectorPtr values;
+    if (childSpec->isConstant()) {
+      values = BaseVector::wrapInConstant(
+          rows.size(), 0, childSpec->constantValue());
+    } else if (isChildConstant(*childSpec)) {
+      // Missing in the file.
+      values = BaseVector::createNullConstant(
+          requestedType_->type()->asRow().findChild(name),
+          rows.size(),
+          &memoryPool_);
+    } else {
+      values = BaseVector::create(
+          requestedType_->type()->asRow().findChild(name), 0, &memoryPool_);
+      children_.at(childSpec->subscript())->getValues(rows, &values);
+      multiColumnFilterValues_[childSpec->subscript()] = values;
+    }
+    names.push_back(name);
+    types.push_back(values->type());
+    inputs.push_back(std::move(values));
+  }
+  auto input = std::make_shared<RowVector>(
+      &memoryPool_,
+      ROW(std::move(names), std::move(types)),
+      nullptr,
+      rows.size(),
+      std::move(inputs));
+  filter->filter(input, multiColumnFilterPassed_);
+  multiColumnFilterOutputRows_.resize(multiColumnFilterPassed_.size());
+  for (auto i = 0; i < multiColumnFilterPassed_.size(); ++i) {
+    multiColumnFilterOutputRows_[i] = rows[multiColumnFilterPassed_[i]];
+  }
+  return multiColumnFilterOutputRows_;
+}
+
+VectorPtr SelectiveStructColumnReaderBase::multiColumnFilterValues(
+    int64_t subscript,
+    RowSet rows) const {
+  const auto& values = multiColumnFilterValues_.at(subscript);
+  if (rows.size() == multiColumnFilterInputRows_.size()) {
+    return values;
+  }
+  auto indices = allocateIndices(rows.size(), &memoryPool_);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t position = 0;
+  for (auto i = 0; i < rows.size(); ++i) {
+    while (multiColumnFilterInputRows_[position] < rows[i]) {
+      ++position;
+    }
+    rawIndices[i] = position;
+  }
+  return BaseVector::wrapInDictionary(nullptr, indices, rows.size(), values);
+}
+
 void SelectiveStructColumnReaderBase::recordParentNullsInChildren(
     vector_size_t offset,
     RowSet rows) {
@@ -205,6 +299,7 @@ bool SelectiveStructColumnReaderBase::isChildConstant(
   // Returns true if the child has a constant set in the ScanSpec, or if the
   // file doesn't have this child (in which case it will be treated as null).
   return childSpec.isConstant() ||
+      childSpec.subscript() == kConstantChildSpecSubscript ||
       // The below check is trying to determine if this is a missing field in a
       // struct that should be constant null.
       (!isRoot_ && // If we're in the root struct channel is meaningless in this
@@ -357,6 +452,11 @@ void SelectiveStructColumnReaderBase::getValues(
       setNullField(rows.size(), childResult, childType, resultRow->pool());
       continue;
     }
+    if (!multiColumnFilterInputRows_.empty() &&
+        multiColumnFilterValues_.count(index)) {
+      childResult = multiColumnFilterValues(index, rows);
+      continue;
+    }
     if (childSpec->extractValues() || childSpec->hasFilter() ||
         !children_[index]->isTopLevel()) {
       children_[index]->getValues(rows, &childResult);
@@ -126,6 +126,15 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
   // need to read it).
   bool isChildConstant(const velox::common::ScanSpec& childSpec) const;
 
+  // Evaluates the MultiColumnFilter of 'scanSpec_' on 'rows' after its inputs
+  // have been read. Keeps the values of the inputs for getValues() and
+  // returns the rows that pass.
+  RowSet applyMultiColumnFilter(RowSet rows);
+
+  // Returns the values of the input of the MultiColumnFilter with child
+  // 'subscript' for 'rows', a subset of the rows the filter was applied to.
+  VectorPtr multiColumnFilterValues(int64_t subscript, RowSet rows) const;
+
   const std::shared_ptr<const dwio::common::TypeWithId> requestedType_;
 
   std::vector<SelectiveColumnReader*> children_;
@@ -155,6 +164,18 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
   // Whether or not this is the root Struct that represents entire rows of the
   // table.
   const bool isRoot_;
+
+  // Rows that the MultiColumnFilter was applied to in the last read() and the
+  // values of its inputs for these rows by child subscript. Empty if the
+  // filter was not applied.
+  std::vector<vector_size_t> multiColumnFilterInputRows_;
+  folly::F14FastMap<int64_t, VectorPtr> multiColumnFilterValues_;
+
+  // Positions in 'multiColumnFilterInputRows_' of the rows that passed.
+  std::vector<vector_size_t> multiColumnFilterPassed_;
+
+  // Rows that passed the MultiColumnFilter.
+  std::vector<vector_size_t> multiColumnFilterOutputRows_;
 };
 
 struct SelectiveStructColumnReader : SelectiveStructColumnReaderBase {
@@ -16,12 +16,17 @@
 
 #include "velox/dwio/common/SortingWriter.h"
 
+#include "velox/common/base/AsyncSource.h"
+
 namespace facebook::velox::dwio::common {
 
 SortingWriter::SortingWriter(
     std::unique_ptr<Writer> writer,
-    std::unique_ptr<exec::SortBuffer> sortBuffer)
-    : outputWriter_(std::move(writer)), sortBuffer_(std::move(sortBuffer)) {}
+    std::unique_ptr<exec::SortBuffer> sortBuffer,
+    folly::Executor* executor)
+    : outputWriter_(std::move(writer)),
+      sortBuffer_(std::move(sortBuffer)),
+      executor_(executor) {}
 
 void SortingWriter::write(const VectorPtr& data) {
   sortBuffer_->addInput(data);
@@ -33,12 +38,44 @@ void SortingWriter::flush() {
 
 void SortingWriter::close() {
   sortBuffer_->noMoreInput();
+  if (executor_ != nullptr) {
+    writeOutputAsync();
+  } else {
+    RowVectorPtr output = sortBuffer_->getOutput();
+    while (output != nullptr) {
+      outputWriter_->write(output);
+      output = sortBuffer_->getOutput();
+    }
+  }
+  outputWriter_->close();
+}
+
+void SortingWriter::writeOutputAsync() {
+  auto getOutputAsync = [&]() {
+    auto source = std::make_shared<AsyncSource<RowVectorPtr>>([this]() {
+      return std::make_unique<RowVectorPtr>(sortBuffer_->getOutput());
+    });
+    executor_->add([source]() { source->prepare(); });
+    return source;
+  };
+
   RowVectorPtr output = sortBuffer_->getOutput();
   while (output != nullptr) {
-    outputWriter_->write(output);
-    output = sortBuffer_->getOutput();
+    // 'sortBuffer_' does not reuse 'output' for the next batch while it is
+    // referenced here.
+    auto next = getOutputAsync();
+    try {
+      outputWriter_->write(output);
+    } catch (const std::exception&) {
+      // Waits for the background merge before 'sortBuffer_' can go away.
+      try {
+        next->move();
+      } catch (const std::exception&) {
+      }
+      throw;
+    }
+    output = *next->move();
   }
-  outputWriter_->close();
 }
 
 void SortingWriter::abort() {
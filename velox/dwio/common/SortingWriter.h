@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/dwio/common/Writer.h"
 #include "velox/exec/SortBuffer.h"
 
@@ -24,9 +26,13 @@ namespace facebook::velox::dwio::common {
 /// Sorting Writer object is used to write sorted data into a single file.
 class SortingWriter : public Writer {
  public:
+  /// If 'executor' is set, the next sorted output batch is merged from the
+  /// sorted runs on 'executor' while the current batch is encoded by
+  /// 'writer'.
   SortingWriter(
       std::unique_ptr<Writer> writer,
-      std::unique_ptr<exec::SortBuffer> sortBuffer);
+      std::unique_ptr<exec::SortBuffer> sortBuffer,
+      folly::Executor* executor = nullptr);
 
   void write(const VectorPtr& data) override;
 
@@ -40,6 +46,13 @@ class SortingWriter : public Writer {
 
   const std::unique_ptr<Writer> outputWriter_;
   std::unique_ptr<exec::SortBuffer> sortBuffer_;
+
+ private:
+  // Writes the sorted output while the next output batch is made on
+  // 'executor_'.
+  void writeOutputAsync();
+
+  folly::Executor* const executor_;
 };
 
 } // namespace facebook::velox::dwio::common
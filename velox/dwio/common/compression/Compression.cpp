@@ -20,6 +20,7 @@
 #include "velox/dwio/common/compression/PagedInputStream.h"
 #include "velox/dwio/common/compression/PagedOutputStream.h"
 
+#include <folly/io/Cursor.h>
 #include <folly/logging/xlog.h>
 #include <lz4.h>
 #include <snappy.h>
@@ -209,6 +210,10 @@ class LzoDecompressor : public Decompressor {
     return ::facebook::velox::common::compression::lzoDecompress(
         src, src + srcLength, dest, dest + destLength);
   }
+
+  bool isThreadSafe() const override {
+    return true;
+  }
 };
 
 class Lz4Decompressor : public Decompressor {
@@ -223,6 +228,10 @@ class Lz4Decompressor : public Decompressor {
       uint64_t srcLength,
       char* dest,
       uint64_t destLength) override;
+
+  bool isThreadSafe() const override {
+    return true;
+  }
 };
 
 uint64_t Lz4Decompressor::decompress(
@@ -257,6 +266,10 @@ class ZstdDecompressor : public Decompressor {
       char* dest,
       uint64_t destLength) override;
 
+  bool isThreadSafe() const override {
+    return true;
+  }
+
   std::pair<int64_t, bool> getDecompressedLength(
       const char* src,
       uint64_t srcLength) const override;
@@ -308,6 +321,10 @@ class SnappyDecompressor : public Decompressor {
       char* dest,
       uint64_t destLength) override;
 
+  bool isThreadSafe() const override {
+    return true;
+  }
+
   std::pair<int64_t, bool> getDecompressedLength(
       const char* src,
       uint64_t srcLength) const override;
@@ -459,6 +476,58 @@ bool ZlibDecompressionStream::readOrSkip(const void** data, int32_t* size) {
   return true;
 }
 
+// Decompresses with a codec from a factory registered with
+// velox::common::registerCodecFactory(), e.g. one that offloads to a
+// hardware accelerator. Falls back to the software decompressor if the codec
+// fails.
+class CodecDecompressor : public Decompressor {
+ public:
+  CodecDecompressor(
+      std::unique_ptr<folly::io::Codec> codec,
+      std::unique_ptr<Decompressor> fallback,
+      uint64_t blockSize,
+      const std::string& streamDebugInfo)
+      : Decompressor{blockSize, streamDebugInfo},
+        codec_{std::move(codec)},
+        fallback_{std::move(fallback)} {}
+
+  uint64_t decompress(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override;
+
+  std::pair<int64_t, bool> getDecompressedLength(
+      const char* src,
+      uint64_t srcLength) const override {
+    return fallback_->getDecompressedLength(src, srcLength);
+  }
+
+ private:
+  const std::unique_ptr<folly::io::Codec> codec_;
+  const std::unique_ptr<Decompressor> fallback_;
+};
+
+uint64_t CodecDecompressor::decompress(
+    const char* src,
+    uint64_t srcLength,
+    char* dest,
+    uint64_t destLength) {
+  try {
+    auto input = folly::IOBuf::wrapBufferAsValue(src, srcLength);
+    auto output = codec_->uncompress(&input);
+    auto length = output->computeChainDataLength();
+    if (length <= destLength) {
+      folly::io::Cursor(output.get()).pull(dest, length);
+      return length;
+    }
+  } catch (const std::exception& e) {
+    VLOG(1) << "Falling back to software decompression: " << e.what()
+            << " Info: " << streamDebugInfo_;
+  }
+  return fallback_->decompress(src, srcLength, dest, destLength);
+}
+
 } // namespace
 
 std::unique_ptr<BufferedOutputStream> createCompressor(
@@ -579,6 +648,17 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     default:
       DWIO_RAISE("Unknown compression codec ", kind);
   }
+  // The blocks of these kinds are in the format of the folly codecs.
+  if (kind == CompressionKind::CompressionKind_ZSTD ||
+      kind == CompressionKind::CompressionKind_SNAPPY) {
+    if (auto codec = velox::common::createRegisteredCodec(kind)) {
+      decompressor = std::make_unique<CodecDecompressor>(
+          std::move(codec),
+          std::move(decompressor),
+          blockSize,
+          streamDebugInfo);
+    }
+  }
   return std::make_unique<PagedInputStream>(
       std::move(input),
       pool,
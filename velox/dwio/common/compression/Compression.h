@@ -62,6 +62,12 @@ class Decompressor {
       char* dest,
       uint64_t destLength) = 0;
 
+  /// True if decompress() keeps no state between calls, so that different
+  /// blocks may be decompressed concurrently.
+  virtual bool isThreadSafe() const {
+    return false;
+  }
+
  protected:
   int64_t blockSize_;
   const std::string streamDebugInfo_;
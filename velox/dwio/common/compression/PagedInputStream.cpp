@@ -26,6 +26,9 @@ void PagedInputStream::prepareOutputBuffer(uint64_t uncompressedLength) {
 }
 
 void PagedInputStream::readBuffer(bool failOnEof) {
+  // The read ahead refers to the range that the next call to 'input_'
+  // releases.
+  clearReadAhead();
   int32_t length;
   if (!input_->Next(
           reinterpret_cast<const void**>(&inputBufferPtr_), &length)) {
@@ -181,9 +184,21 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
     DWIO_ENSURE_NOT_NULL(input);
     auto [decompressedLength, exact] =
         decompressor_->getDecompressedLength(input, remainingLength_);
+    auto readAhead = popReadAhead(input, remainingLength_);
     if (!data && exact && decompressedLength <= pendingSkip_) {
+      if (readAhead) {
+        readAhead->close();
+      }
       *size = decompressedLength;
       outputBufferPtr_ = nullptr;
+    } else if (auto block = readAhead ? readAhead->move() : nullptr) {
+      outputBuffer_ = std::move(block->buffer);
+      outputBufferLength_ = block->length;
+      if (data) {
+        *data = outputBuffer_->data();
+      }
+      *size = static_cast<int32_t>(outputBufferLength_);
+      outputBufferPtr_ = outputBuffer_->data() + outputBufferLength_;
     } else {
       prepareOutputBuffer(decompressedLength);
       outputBufferLength_ = decompressor_->decompress(
@@ -199,6 +214,9 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
     }
     // release decryption buffer
     decryptionBuffer_ = nullptr;
+    if (maxReadAheadBlocks_ > 0) {
+      scheduleReadAhead();
+    }
   }
 
   if (!original) {
@@ -212,6 +230,61 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
   return true;
 }
 
+void PagedInputStream::scheduleReadAhead() {
+  // Each block starts with a 3 byte header: the length shifted left by one
+  // and the lowest bit set if the block is not compressed.
+  constexpr int32_t kHeaderSize = 3;
+  const char* next = readAhead_.empty() ? inputBufferPtr_ : readAheadEnd_;
+  while (readAhead_.size() < static_cast<size_t>(maxReadAheadBlocks_) &&
+         inputBufferPtrEnd_ - next >= kHeaderSize) {
+    auto* header = reinterpret_cast<const unsigned char*>(next);
+    const uint32_t value = header[0] | (header[1] << 8) | (header[2] << 16);
+    if (value & 1) {
+      break;
+    }
+    const size_t length = value >> 1;
+    const char* input = next + kHeaderSize;
+    if (length > static_cast<size_t>(inputBufferPtrEnd_ - input)) {
+      break;
+    }
+    auto source = std::make_shared<AsyncSource<DecompressedBlock>>(
+        [this, input, length]() {
+          auto block = std::make_unique<DecompressedBlock>();
+          block->buffer = std::make_unique<dwio::common::DataBuffer<char>>(
+              pool_, decompressor_->getDecompressedLength(input, length).first);
+          block->length = decompressor_->decompress(
+              input, length, block->buffer->data(), block->buffer->capacity());
+          return block;
+        });
+    readAhead_.push_back({input, length, source});
+    readAheadExecutor_->add([source]() { source->prepare(); });
+    next = input + length;
+  }
+  readAheadEnd_ = next;
+}
+
+std::shared_ptr<AsyncSource<PagedInputStream::DecompressedBlock>>
+PagedInputStream::popReadAhead(const char* input, size_t length) {
+  if (readAhead_.empty()) {
+    return nullptr;
+  }
+  auto& block = readAhead_.front();
+  if (block.input != input || block.length != length) {
+    clearReadAhead();
+    return nullptr;
+  }
+  auto source = std::move(block.source);
+  readAhead_.pop_front();
+  return source;
+}
+
+void PagedInputStream::clearReadAhead() {
+  for (auto& block : readAhead_) {
+    block.source->close();
+  }
+  readAhead_.clear();
+}
+
 void PagedInputStream::BackUp(int32_t count) {
   VELOX_CHECK_GE(count, 0);
   if (pendingSkip_ > 0) {
@@ -266,6 +339,7 @@ bool PagedInputStream::Skip(int32_t count) {
 }
 
 void PagedInputStream::clearDecompressionState() {
+  clearReadAhead();
   state_ = State::HEADER;
   outputBufferLength_ = 0;
   remainingLength_ = 0;
@@ -298,6 +372,7 @@ void PagedInputStream::seekToPosition(
   if (compressedOffset != lastHeaderOffset_ || outsideOriginalWindow()) {
     std::vector<uint64_t> positions = {compressedOffset};
     auto provider = dwio::common::PositionProvider(positions);
+    clearReadAhead();
     input_->seekToPosition(provider);
     clearDecompressionState();
     pendingSkip_ = uncompressedOffset;
@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+#include <deque>
+
+#include "velox/common/base/AsyncSource.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/compression/Compression.h"
 
@@ -50,6 +54,23 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
     }
   }
 
+  ~PagedInputStream() override {
+    clearReadAhead();
+  }
+
+  /// Decompresses up to 'numBlocks' compression blocks after the current one
+  /// on 'executor', so that decompression overlaps with decoding the current
+  /// block. Only blocks that are contiguous in the range last returned by the
+  /// input stream are decompressed ahead, which bounds the extra memory to
+  /// 'numBlocks' decompressed blocks. Has no effect for encrypted streams or
+  /// for decompressors that are not thread safe. Not for raw decompression.
+  void setReadAhead(folly::Executor* executor, int32_t numBlocks) {
+    if (decompressor_ && decompressor_->isThreadSafe() && !decrypter_) {
+      readAheadExecutor_ = executor;
+      maxReadAheadBlocks_ = executor ? numBlocks : 0;
+    }
+  }
+
   bool Next(const void** data, int32_t* size) override;
   void BackUp(int32_t count) override;
 
@@ -121,6 +142,33 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
 
   virtual bool readOrSkip(const void** data, int32_t* size);
 
+  struct DecompressedBlock {
+    std::unique_ptr<dwio::common::DataBuffer<char>> buffer;
+    size_t length;
+  };
+
+  struct ReadAheadBlock {
+    // Compressed input of the block in the range returned by 'input_'.
+    const char* input;
+    size_t length;
+    std::shared_ptr<AsyncSource<DecompressedBlock>> source;
+  };
+
+  // Starts decompressing the blocks that follow the current one on
+  // 'readAheadExecutor_' until there are 'maxReadAheadBlocks_' blocks in
+  // 'readAhead_' or the next block is not complete in the current input range.
+  void scheduleReadAhead();
+
+  // Returns the read ahead of the block at 'input' of 'length' bytes. Returns
+  // nullptr and discards all read ahead if the block is not the next one.
+  std::shared_ptr<AsyncSource<DecompressedBlock>> popReadAhead(
+      const char* input,
+      size_t length);
+
+  // Waits for and discards all read ahead. Must be called before the input
+  // range the read ahead refers to is released.
+  void clearReadAhead();
+
   // input stream where to read compressed/encrypted data
   std::unique_ptr<SeekableInputStream> input_;
   memory::MemoryPool& pool_;
@@ -177,6 +225,16 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
 
   int64_t pendingSkip_{0};
 
+  folly::Executor* readAheadExecutor_{nullptr};
+  int32_t maxReadAheadBlocks_{0};
+
+  // Blocks after the current one being decompressed on 'readAheadExecutor_',
+  // in stream order.
+  std::deque<ReadAheadBlock> readAhead_;
+
+  // The first byte after the last block in 'readAhead_'.
+  const char* readAheadEnd_{nullptr};
+
  private:
   bool skipAllPending();
 
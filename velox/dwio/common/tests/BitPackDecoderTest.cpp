@@ -43,8 +43,8 @@ class BitPackDecoderTest : public testing::Test {
   }
 
   void populateBitPackedData() {
-    bitPackedData_.resize(33);
-    for (auto bitWidth = 1; bitWidth <= 32; ++bitWidth) {
+    bitPackedData_.resize(65);
+    for (auto bitWidth = 1; bitWidth <= 64; ++bitWidth) {
       auto numWords = bits::roundUp(randomInts_.size() * bitWidth, 64) / 64;
       bitPackedData_[bitWidth].resize(numWords);
       auto source = randomInts_.data();
@@ -67,7 +67,7 @@ class BitPackDecoderTest : public testing::Test {
       RowSet rows,
       int8_t bitWidth,
       const U* result) {
-    uint64_t mask = bits::lowMask(bitWidth);
+    uint64_t mask = bitWidth == 64 ? ~0ULL : bits::lowMask(bitWidth);
     for (auto i = 0; i < rows.size(); ++i) {
       uint64_t original = reference[rows[i]] & mask;
       ASSERT_EQ(original, result[i])
@@ -147,7 +147,7 @@ class BitPackDecoderTest : public testing::Test {
 };
 
 TEST_F(BitPackDecoderTest, allWidths) {
-  for (auto width = 0; width < bitPackedData_.size() - 1; ++width) {
+  for (auto width = 0; width < 32; ++width) {
     testUnpack<int32_t>(width, allRows_);
     testUnpack<int64_t>(width, allRows_);
     testUnpack<int32_t>(width, oddRows_);
@@ -172,3 +172,32 @@ TEST_F(BitPackDecoderTest, uint32AllRows) {
     testUnpack<uint32_t>(width);
   }
 }
+
+TEST_F(BitPackDecoderTest, uint64AllRows) {
+  for (auto width = 1; width <= 64; ++width) {
+    testUnpack<uint64_t>(width);
+  }
+}
+
+TEST_F(BitPackDecoderTest, unpackWords) {
+  // The portable path used without AVX2. Checks that both pointers advance.
+  constexpr uint64_t kNumValues = 1'000;
+  for (auto width = 1; width <= 32; ++width) {
+    std::vector<uint32_t> result(kNumValues);
+    const auto* input =
+        reinterpret_cast<const uint8_t*>(bitPackedData_[width].data());
+    auto* output = result.data();
+    unpackWords<uint32_t>(
+        input, bytes(kNumValues, width), kNumValues, width, output);
+    ASSERT_EQ(
+        reinterpret_cast<const uint8_t*>(bitPackedData_[width].data()) +
+            bytes(kNumValues, width),
+        input);
+    ASSERT_EQ(result.data() + kNumValues, output);
+    checkDecodeResult(
+        randomInts_.data(),
+        RowSet(allRowNumbers_.data(), kNumValues),
+        width,
+        result.data());
+  }
+}
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Random.h>
+#include <folly/String.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+#include <iostream>
+#include <thread>
+
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/caching/SsdCache.h"
+#include "velox/common/file/File.h"
+#include "velox/common/io/Options.h"
+#include "velox/common/memory/MmapAllocator.h"
+#include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/functions/lib/ZetaDistribution.h"
+
+/// Measures AsyncDataCache and SsdCache under concurrent scans. Each thread
+/// reads stripes of a synthetic file set through CachedBufferedInput, picking
+/// the file from a Zipf distribution so that a few files are hot. Each run
+/// starts with an empty cache and prints one line with the hit rate, the
+/// clocks spent waiting for CacheShard mutexes, evicting and allocating, and
+/// the SSD write throughput, e.g.
+///
+///  $ velox_dwio_cache_benchmark --threads 1,8,32 --ssd_mb 2048 \
+///        --ssd_odirect=false
+
+DEFINE_string(
+    threads,
+    "1,4,16",
+    "Comma separated numbers of reader threads, one run per number.");
+DEFINE_int32(num_files, 500, "Number of files in the synthetic file set.");
+DEFINE_int32(num_stripes, 10, "Number of stripes per file.");
+DEFINE_int32(num_columns, 20, "Number of column streams per stripe.");
+DEFINE_int32(column_bytes, 200 << 10, "Size of each column stream.");
+DEFINE_int32(
+    read_pct,
+    50,
+    "Percentage of the columns of a stripe a reader reads.");
+DEFINE_double(
+    zipf_exponent,
+    1.1,
+    "Exponent of the Zipf distribution of accesses over files. Values close "
+    "to 1 spread the accesses more evenly.");
+DEFINE_int32(stripes_per_thread, 400, "Number of stripes each thread reads.");
+DEFINE_int32(
+    read_latency_us,
+    0,
+    "Time each read of the synthetic files takes, modeling storage.");
+DEFINE_int64(memory_mb, 1024, "Capacity of the memory cache.");
+DEFINE_int64(ssd_mb, 0, "Capacity of the SSD cache. 0 means no SSD cache.");
+DEFINE_int32(ssd_shards, 4, "Number of files of the SSD cache.");
+DEFINE_int32(io_threads, 16, "Threads for prefetch and SSD writes.");
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+
+namespace {
+
+// File with no storage. Reads fill the buffer with a pattern and optionally
+// take --read_latency_us.
+class SyntheticReadFile : public ReadFile {
+ public:
+  explicit SyntheticReadFile(uint64_t size) : size_(size) {}
+
+  std::string_view pread(uint64_t offset, uint64_t length, void* buffer)
+      const override {
+    const auto available = std::min(size_ - offset, length);
+    if (FLAGS_read_latency_us > 0) {
+      std::this_thread::sleep_for(
+          std::chrono::microseconds(FLAGS_read_latency_us)); // NOLINT
+    }
+    memset(buffer, offset & 0xff, available);
+    return std::string_view(static_cast<const char*>(buffer), available);
+  }
+
+  uint64_t size() const override {
+    return size_;
+  }
+
+  uint64_t memoryUsage() const override {
+    return 0;
+  }
+
+  bool shouldCoalesce() const override {
+    return true;
+  }
+
+  std::string getName() const override {
+    return "<SyntheticReadFile>";
+  }
+
+  uint64_t getNaturalReadSize() const override {
+    return 1 << 20;
+  }
+
+ private:
+  const uint64_t size_;
+};
+
+struct SyntheticFile {
+  std::shared_ptr<ReadFile> readFile;
+  cache::StringIdLease fileId;
+  cache::StringIdLease groupId;
+};
+
+class CacheBenchmark {
+ public:
+  CacheBenchmark() {
+    const uint64_t stripeBytes =
+        static_cast<uint64_t>(FLAGS_num_columns) * FLAGS_column_bytes;
+    for (auto i = 0; i < FLAGS_num_files; ++i) {
+      // Files are in groups of 8, e.g. the files of a partition.
+      files_.push_back(SyntheticFile{
+          std::make_shared<SyntheticReadFile>(stripeBytes * FLAGS_num_stripes),
+          cache::StringIdLease(cache::fileIds(), fmt::format("file{}", i)),
+          cache::StringIdLease(
+              cache::fileIds(), fmt::format("group{}", i / 8))});
+    }
+    for (auto i = 0; i < FLAGS_num_columns; ++i) {
+      streamIds_.emplace_back(i);
+    }
+  }
+
+  void run(int32_t numThreads) {
+    makeCache();
+    std::atomic<uint64_t> bytesRead{0};
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < numThreads; ++i) {
+      threads.emplace_back([&, i]() { bytesRead += readStripes(i); });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    const auto readSeconds = secondsSince(start);
+    auto* ssd = cache_->ssdCache();
+    while (ssd && ssd->writeInProgress()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10)); // NOLINT
+    }
+    const auto totalSeconds = secondsSince(start);
+
+    const auto stats = cache_->refreshStats();
+    const auto numAccesses = stats.numHit + stats.numNew;
+    const double ssdWriteMB =
+        stats.ssdStats ? stats.ssdStats->bytesWritten / double(1 << 20) : 0;
+    std::cout << fmt::format(
+                     "{:>7} {:>9.2f} {:>9.1f} {:>8.1f}% {:>9.1f} {:>11} "
+                     "{:>11} {:>11} {:>12.1f}",
+                     numThreads,
+                     readSeconds,
+                     bytesRead / double(1 << 20) / readSeconds,
+                     numAccesses ? 100.0 * stats.numHit / numAccesses : 0,
+                     ioStats_->ssdRead().sum() / double(1 << 20),
+                     stats.lockWaitClocks >> 20,
+                     stats.evictClocks >> 20,
+                     stats.allocClocks >> 20,
+                     ssdWriteMB / totalSeconds)
+              << std::endl;
+    VLOG(1) << cache_->toString();
+    shutdownCache();
+  }
+
+  static void printHeader() {
+    std::cout << fmt::format(
+                     "{:>7} {:>9} {:>9} {:>9} {:>9} {:>11} {:>11} {:>11} "
+                     "{:>12}",
+                     "threads",
+                     "seconds",
+                     "MB/s",
+                     "hit rate",
+                     "SSD MB",
+                     "lock Mclk",
+                     "evict Mclk",
+                     "alloc Mclk",
+                     "SSD write/s")
+              << std::endl;
+  }
+
+ private:
+  static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+  }
+
+  void makeCache() {
+    executor_ = std::make_unique<folly::IOThreadPoolExecutor>(
+        FLAGS_io_threads, FLAGS_io_threads);
+    std::unique_ptr<cache::SsdCache> ssd;
+    if (FLAGS_ssd_mb > 0) {
+      tempDirectory_ = exec::test::TempDirectoryPath::create();
+      ssd = std::make_unique<cache::SsdCache>(
+          fmt::format("{}/cache", tempDirectory_->path),
+          FLAGS_ssd_mb << 20,
+          FLAGS_ssd_shards,
+          executor_.get());
+    }
+    memory::MmapAllocator::Options options;
+    options.capacity = FLAGS_memory_mb << 20;
+    allocator_ = std::make_shared<memory::MmapAllocator>(options);
+    cache_ = cache::AsyncDataCache::create(allocator_.get(), std::move(ssd));
+    tracker_ = std::make_shared<cache::ScanTracker>(
+        "benchmark", nullptr, io::ReaderOptions::kDefaultLoadQuantum);
+    ioStats_ = std::make_shared<IoStatistics>();
+  }
+
+  void shutdownCache() {
+    executor_->join();
+    if (auto* ssd = cache_->ssdCache()) {
+      ssd->testingDeleteFiles();
+    }
+    cache_->shutdown();
+    cache_.reset();
+    allocator_.reset();
+    tempDirectory_.reset();
+  }
+
+  // Reads --stripes_per_thread stripes and returns the number of bytes read.
+  uint64_t readStripes(int32_t threadIndex) {
+    std::mt19937 rng(threadIndex);
+    functions::ZetaDistribution fileDistribution(
+        FLAGS_zipf_exponent, FLAGS_num_files);
+    const uint64_t stripeBytes =
+        static_cast<uint64_t>(FLAGS_num_columns) * FLAGS_column_bytes;
+    uint64_t bytesRead = 0;
+    for (auto i = 0; i < FLAGS_stripes_per_thread; ++i) {
+      const auto& file = files_[fileDistribution(rng) - 1];
+      const auto stripe = folly::Random::rand32(FLAGS_num_stripes, rng);
+      CachedBufferedInput input(
+          file.readFile,
+          MetricsLog::voidLog(),
+          file.fileId.id(),
+          cache_.get(),
+          tracker_,
+          file.groupId.id(),
+          ioStats_,
+          executor_.get(),
+          io::ReaderOptions(pool_.get()));
+      std::vector<std::unique_ptr<SeekableInputStream>> streams;
+      for (auto column = 0; column < FLAGS_num_columns; ++column) {
+        if (folly::Random::rand32(100, rng) >= FLAGS_read_pct) {
+          continue;
+        }
+        streams.push_back(input.enqueue(
+            {stripe * stripeBytes +
+                 static_cast<uint64_t>(column) * FLAGS_column_bytes,
+             static_cast<uint64_t>(FLAGS_column_bytes)},
+            &streamIds_[column]));
+      }
+      input.load(LogType::TEST);
+      for (auto& stream : streams) {
+        const void* data;
+        int32_t size;
+        while (stream->Next(&data, &size) && size > 0) {
+          bytesRead += size;
+        }
+      }
+    }
+    return bytesRead;
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::addDefaultLeafMemoryPool()};
+  std::vector<SyntheticFile> files_;
+  std::vector<StreamIdentifier> streamIds_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> executor_;
+  std::shared_ptr<exec::test::TempDirectoryPath> tempDirectory_;
+  std::shared_ptr<memory::MemoryAllocator> allocator_;
+  std::shared_ptr<cache::AsyncDataCache> cache_;
+  std::shared_ptr<cache::ScanTracker> tracker_;
+  std::shared_ptr<IoStatistics> ioStats_;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  std::vector<std::string> threadCounts;
+  folly::split(',', FLAGS_threads, threadCounts, true);
+  CacheBenchmark benchmark;
+  CacheBenchmark::printHeader();
+  for (const auto& numThreads : threadCounts) {
+    benchmark.run(folly::to<int32_t>(numThreads));
+  }
+  return 0;
+}
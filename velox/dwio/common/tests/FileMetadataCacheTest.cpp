@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::dwio::common;
+
+TEST(FileMetadataCacheTest, getAndPut) {
+  FileMetadataCache cache(100);
+  ASSERT_EQ(cache.get<std::string>("a"), nullptr);
+  cache.put("a", std::make_shared<const std::string>("footer a"), 40);
+  auto a = cache.get<std::string>("a");
+  ASSERT_NE(a, nullptr);
+  ASSERT_EQ(*a, "footer a");
+
+  // Replacing an entry does not count its old size.
+  cache.put("a", std::make_shared<const std::string>("footer a2"), 50);
+  ASSERT_EQ(*cache.get<std::string>("a"), "footer a2");
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.numEntries, 1);
+  ASSERT_EQ(stats.curBytes, 50);
+  ASSERT_EQ(stats.numLookups, 3);
+  ASSERT_EQ(stats.numHits, 2);
+
+  // Entries larger than the cache are not added.
+  cache.put("big", std::make_shared<const std::string>("big"), 101);
+  ASSERT_EQ(cache.get<std::string>("big"), nullptr);
+  ASSERT_EQ(cache.stats().numEntries, 1);
+
+  // The entry stays valid for its users after it is dropped from the cache.
+  cache.clear();
+  ASSERT_EQ(cache.get<std::string>("a"), nullptr);
+  ASSERT_EQ(*a, "footer a");
+  ASSERT_EQ(cache.stats().curBytes, 0);
+}
+
+TEST(FileMetadataCacheTest, evictLeastRecentlyUsed) {
+  FileMetadataCache cache(100);
+  cache.put("a", std::make_shared<const std::string>("a"), 40);
+  cache.put("b", std::make_shared<const std::string>("b"), 40);
+  // Makes 'b' the least recently used.
+  ASSERT_NE(cache.get<std::string>("a"), nullptr);
+  cache.put("c", std::make_shared<const std::string>("c"), 40);
+  ASSERT_EQ(cache.get<std::string>("b"), nullptr);
+  ASSERT_NE(cache.get<std::string>("a"), nullptr);
+  ASSERT_NE(cache.get<std::string>("c"), nullptr);
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.numEntries, 2);
+  ASSERT_EQ(stats.curBytes, 80);
+  ASSERT_EQ(stats.maxBytes, 100);
+  ASSERT_EQ(stats.numEvictions, 1);
+}
@@ -105,6 +105,10 @@ Config::Entry<uint32_t> Config::ENTROPY_STRING_THRESHOLD{
     "hive.exec.orc.entropy.string.threshold",
     20};
 
+Config::Entry<uint32_t> Config::DICTIONARY_STRING_EVALUATION_ROWS{
+    "orc.dictionary.string.evaluation.rows",
+    0};
+
 Config::Entry<uint32_t> Config::STRING_STATS_LIMIT(
     "hive.orc.string.stats.limit",
     64);
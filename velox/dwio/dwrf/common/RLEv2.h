@@ -20,9 +20,12 @@
 #include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/Adaptor.h"
 #include "velox/dwio/common/DataBuffer.h"
+#include "velox/dwio/common/DecoderUtil.h"
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/exception/Exception.h"
 
+#include <folly/lang/Bits.h>
+
 #include <vector>
 
 namespace facebook::velox::dwrf {
@@ -72,6 +75,10 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
 
   template <bool hasNulls, typename Visitor>
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    if (dwio::common::useFastPath<Visitor, hasNulls>(visitor)) {
+      fastPath<hasNulls>(nulls, visitor);
+      return;
+    }
     int32_t current = visitor.start();
     skip<hasNulls>(current, 0, nulls);
 
@@ -110,6 +117,104 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   }
 
  private:
+  // Rows decoded at a time by bulkScan().
+  static constexpr int32_t kBulkBatchRows = 1024;
+
+  template <bool hasNulls, typename Visitor>
+  void fastPath(const uint64_t* nulls, Visitor& visitor) {
+    constexpr bool hasFilter =
+        !std::is_same_v<typename Visitor::FilterType, common::AlwaysTrue>;
+    constexpr bool hasHook =
+        !std::is_same_v<typename Visitor::HookType, dwio::common::NoHook>;
+    auto rows = visitor.rows();
+    auto numRows = visitor.numRows();
+    auto rowsAsRange = folly::Range<const int32_t*>(rows, numRows);
+    if (hasNulls) {
+      raw_vector<int32_t>* innerVector = nullptr;
+      auto outerVector = &visitor.outerNonNullRows();
+      if (Visitor::dense) {
+        dwio::common::nonNullRowsFromDense(nulls, numRows, *outerVector);
+        if (outerVector->empty()) {
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkScan<hasFilter, hasHook, true>(
+            folly::Range<const int32_t*>(rows, outerVector->size()),
+            outerVector->data(),
+            visitor);
+      } else {
+        innerVector = &visitor.innerNonNullRows();
+        int32_t tailSkip = -1;
+        auto anyNulls = dwio::common::nonNullRowsFromSparse < hasFilter,
+             !hasFilter &&
+            !hasHook >
+                (nulls,
+                 rowsAsRange,
+                 *innerVector,
+                 *outerVector,
+                 (hasFilter || hasHook) ? nullptr : visitor.rawNulls(numRows),
+                 tailSkip);
+        if (anyNulls) {
+          visitor.setHasNulls();
+        }
+        if (innerVector->empty()) {
+          skip<false>(tailSkip, 0, nullptr);
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkScan<hasFilter, hasHook, true>(
+            *innerVector, outerVector->data(), visitor);
+        skip<false>(tailSkip, 0, nullptr);
+      }
+    } else {
+      bulkScan<hasFilter, hasHook, false>(rowsAsRange, nullptr, visitor);
+    }
+  }
+
+  // Decodes the values from the current position to the last of 'nonNullRows'
+  // in batches of up to kBulkBatchRows rows and hands the values of the rows in
+  // 'nonNullRows' to the visitor a batch at a time. This lets the visitor
+  // filter a batch with SIMD, e.g. by gathering the cached filter results of
+  // dictionary entries, instead of testing the values one at a time.
+  template <bool hasFilter, bool hasHook, bool scatter, typename Visitor>
+  void bulkScan(
+      folly::Range<const int32_t*> nonNullRows,
+      const int32_t* scatterRows,
+      Visitor& visitor) {
+    using T = typename Visitor::DataType;
+    auto numAllRows = visitor.numRows();
+    visitor.setRows(nonNullRows);
+    auto rows = visitor.rows();
+    auto numRows = visitor.numRows();
+    int32_t rowIndex = 0;
+    int32_t currentRow = 0;
+    auto values = visitor.rawValues(numRows);
+    auto filterHits = hasFilter ? visitor.outputRows(numRows) : nullptr;
+    int32_t numValues = 0;
+    while (rowIndex < numRows) {
+      if (rows[rowIndex] > currentRow) {
+        skip(rows[rowIndex] - currentRow);
+        currentRow = rows[rowIndex];
+      }
+      auto end = std::lower_bound(
+          rows + rowIndex, rows + numRows, currentRow + kBulkBatchRows);
+      int32_t numInBatch = end - (rows + rowIndex);
+      int32_t numDecoded = end[-1] + 1 - currentRow;
+      bulkValues.resize(numDecoded);
+      auto decoded = bulkValues.data();
+      next(decoded, numDecoded, nullptr);
+      auto batch = values + numValues;
+      for (auto i = 0; i < numInBatch; ++i) {
+        batch[i] = static_cast<T>(decoded[rows[rowIndex + i] - currentRow]);
+      }
+      visitor.template processRun<hasFilter, hasHook, scatter>(
+          batch, numInBatch, scatterRows, filterHits, values, numValues);
+      currentRow += numDecoded;
+      rowIndex += numInBatch;
+    }
+    visitor.setNumValues(hasFilter ? numValues : numAllRows);
+  }
+
   // Used by PATCHED_BASE
   void adjustGapAndPatch() {
     curGap = static_cast<uint64_t>(unpackedPatch[patchIdx]) >> patchBitSize;
@@ -169,9 +274,13 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
       uint64_t fb,
       const uint64_t* nulls = nullptr) {
     uint64_t ret = 0;
+    uint64_t i = offset;
+    if (!nulls && bitsLeft == 0) {
+      ret = unpackBigEndian(data + offset, len, fb);
+      i += ret;
+    }
 
-    // TODO: unroll to improve performance
-    for (uint64_t i = offset; i < (offset + len); i++) {
+    for (; i < (offset + len); i++) {
       // skip null positions
       if (nulls && bits::isBitNull(nulls, i)) {
         continue;
@@ -199,6 +308,44 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
     return ret;
   }
 
+  // Decodes up to 'numValues' values of 'bitWidth' bits into 'data' from the
+  // current buffer with one unaligned 8 byte load per value when the bits
+  // start at a byte boundary, i.e. 'bitsLeft' is 0. Stops before the first
+  // value whose load would go past the buffer. Leaves 'curByte' and
+  // 'bitsLeft' as readLongs() would. Returns the number of values decoded.
+  uint64_t
+  unpackBigEndian(int64_t* data, uint64_t numValues, uint64_t bitWidth) {
+    auto& bufferStart = dwio::common::IntDecoder<isSigned>::bufferStart;
+    const auto available =
+        dwio::common::IntDecoder<isSigned>::bufferEnd - bufferStart;
+    // A value of more than 56 bits may need one byte after its 8 byte load.
+    if (available < sizeof(uint64_t) + 1) {
+      return 0;
+    }
+    const auto* start = reinterpret_cast<const uint8_t*>(bufferStart);
+    const auto numLoads = std::min<uint64_t>(
+        numValues, (available - sizeof(uint64_t) - 1) * 8 / bitWidth + 1);
+    for (uint64_t i = 0; i < numLoads; ++i) {
+      const uint64_t bit = i * bitWidth;
+      const auto* word = start + bit / 8;
+      const auto shift = bit & 7;
+      uint64_t value =
+          (folly::Endian::big(folly::loadUnaligned<uint64_t>(word)) << shift) >>
+          (64 - bitWidth);
+      if (shift + bitWidth > 64) {
+        value |= word[8] >> (72 - shift - bitWidth);
+      }
+      data[i] = static_cast<int64_t>(value);
+    }
+    const uint64_t numBits = numLoads * bitWidth;
+    bufferStart += numBits / 8;
+    if (numBits % 8 != 0) {
+      curByte = static_cast<unsigned char>(*bufferStart++);
+      bitsLeft = 8 - numBits % 8;
+    }
+    return numLoads;
+  }
+
   uint64_t nextShortRepeats(
       int64_t* data,
       uint64_t offset,
@@ -243,6 +390,7 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   EncodingType type;
   dwio::common::DataBuffer<int64_t> unpacked; // Used by PATCHED_BASE
   dwio::common::DataBuffer<int64_t> unpackedPatch; // Used by PATCHED_BASE
+  dwio::common::DataBuffer<int64_t> bulkValues; // Used by bulkScan
 };
 
 } // namespace facebook::velox::dwrf
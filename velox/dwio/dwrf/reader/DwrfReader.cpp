@@ -94,6 +94,12 @@ DwrfRowReader::DwrfRowReader(
       std::vector<FetchStatus>(numberOfStripes, FetchStatus::NOT_STARTED));
 }
 
+DwrfRowReader::~DwrfRowReader() {
+  for (auto& fetch : parallelFetches_) {
+    fetch->wait();
+  }
+}
+
 uint64_t DwrfRowReader::seekToRow(uint64_t rowNumber) {
   // Empty file
   if (isEmptyFile()) {
@@ -548,6 +554,50 @@ DwrfRowReader::FetchResult DwrfRowReader::prefetch(uint32_t stripeToFetch) {
   return fetch(stripeToFetch);
 }
 
+void DwrfRowReader::fetchNextStripesInParallel() {
+  const auto& executor = options_.getDecodingExecutor();
+  const auto numStripes = options_.getParallelStripeFetches();
+  if (!executor || numStripes == 0) {
+    return;
+  }
+  // The fetched stripes stay in memory until they are read. Do not start a
+  // fetch that would not fit in the free capacity of the pool.
+  auto* root = getReader().getMemoryPool().root();
+  int64_t freeBytes = root->capacity() - root->currentBytes();
+  const auto& footer = getReader().getFooter();
+  const auto endStripe =
+      std::min<uint64_t>(lastStripe, currentStripe + 1 + numStripes);
+  for (auto stripeIndex = currentStripe + 1; stripeIndex < endStripe;
+       ++stripeIndex) {
+    if (stripeLoadStatuses_.rlock()->at(stripeIndex) !=
+        FetchStatus::NOT_STARTED) {
+      continue;
+    }
+    auto stripe = footer.stripes(stripeIndex);
+    const int64_t stripeBytes =
+        stripe.indexLength() + stripe.dataLength() + stripe.footerLength();
+    if (stripeBytes > freeBytes) {
+      break;
+    }
+    freeBytes -= stripeBytes;
+    prefetchHasOccurred_ = true;
+    auto done = std::make_shared<folly::Baton<>>();
+    parallelFetches_.push_back(done);
+    executor->add([this, stripeIndex, done]() {
+      try {
+        fetch(stripeIndex);
+      } catch (const std::exception&) {
+        // The stripe stays in progress. The reader of the stripe finds the
+        // error after waiting for the stripe.
+        parallelFetchErrors_.wlock()->emplace(
+            stripeIndex, std::current_exception());
+        stripeLoadBatons_[stripeIndex]->post();
+      }
+      done->post();
+    });
+  }
+}
+
 // Guarantee stripe we are currently on is available and loaded
 void DwrfRowReader::safeFetchNextStripe() {
   auto startTime = std::chrono::high_resolution_clock::now();
@@ -564,6 +614,12 @@ void DwrfRowReader::safeFetchNextStripe() {
     VLOG(1) << "Waiting on baton for stripe: " << currentStripe;
     stripeLoadBatons_[currentStripe]->wait();
     VLOG(1) << "Acquired baton for stripe " << currentStripe;
+    parallelFetchErrors_.withRLock([&](const auto& errors) {
+      auto it = errors.find(currentStripe);
+      if (it != errors.end()) {
+        std::rethrow_exception(it->second);
+      }
+    });
   }
   auto reportBlockedOnIoMetric = options_.getBlockedOnIoCallback();
   if (reportBlockedOnIoMetric) {
@@ -612,6 +668,7 @@ void DwrfRowReader::startNextStripe() {
   DWIO_ENSURE(freeStripeAt(currentStripe));
 
   newStripeReadyForRead = true;
+  fetchNextStripesInParallel();
   auto endTime = std::chrono::high_resolution_clock::now();
   VLOG(1) << " time to complete startNextStripe: "
           << std::chrono::duration_cast<std::chrono::microseconds>(
@@ -748,7 +805,8 @@ DwrfReader::DwrfReader(
           options.getFilePreloadThreshold(),
           options.getFileFormat() == FileFormat::ORC ? FileFormat::ORC
                                                      : FileFormat::DWRF,
-          options.isFileColumnNamesReadAsLowerCase())),
+          options.isFileColumnNamesReadAsLowerCase(),
+          options.fileMetadataCacheKey())),
       options_(options) {
   // If we are not using column names to map table columns to file columns, then
   // we use indices. In that case we need to ensure the names completely match,
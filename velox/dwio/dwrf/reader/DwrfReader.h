@@ -37,7 +37,7 @@ class DwrfRowReader : public StrideIndexProvider,
       const std::shared_ptr<ReaderBase>& reader,
       const dwio::common::RowReaderOptions& options);
 
-  ~DwrfRowReader() override = default;
+  ~DwrfRowReader() override;
 
   // Select the columns from the options object
   const dwio::common::ColumnSelector& getColumnSelector() const {
@@ -130,6 +130,10 @@ class DwrfRowReader : public StrideIndexProvider,
   FetchResult fetch(uint32_t stripeIndex);
   FetchResult prefetch(uint32_t stripeToFetch);
 
+  // Starts fetches of the stripes after 'currentStripe' on the decoding
+  // executor if RowReaderOptions::getParallelStripeFetches() is set.
+  void fetchNextStripesInParallel();
+
   // footer
   std::vector<uint64_t> firstRowOfStripe;
   mutable std::shared_ptr<const dwio::common::TypeWithId> selectedSchema;
@@ -173,6 +177,15 @@ class DwrfRowReader : public StrideIndexProvider,
   // is posted, it means the ith stripe has finished loading
   std::vector<std::unique_ptr<folly::Baton<>>> stripeLoadBatons_;
 
+  // Errors of the fetches started by fetchNextStripesInParallel(). Key is
+  // stripe index. The error is rethrown when the stripe is read.
+  folly::Synchronized<folly::F14FastMap<uint32_t, std::exception_ptr>>
+      parallelFetchErrors_;
+
+  // Posted when the fetch started by fetchNextStripesInParallel() returns. The
+  // destructor waits for these since the fetches reference 'this'.
+  std::vector<std::shared_ptr<folly::Baton<>>> parallelFetches_;
+
   // column selector
   std::shared_ptr<dwio::common::ColumnSelector> columnSelector_;
 
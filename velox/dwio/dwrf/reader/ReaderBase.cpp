@@ -18,6 +18,7 @@
 
 #include <fmt/format.h>
 
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/exception/Exception.h"
 
 namespace facebook::velox::dwrf {
@@ -93,7 +94,8 @@ ReaderBase::ReaderBase(
     uint64_t directorySizeGuess,
     uint64_t filePreloadThreshold,
     FileFormat fileFormat,
-    bool fileColumnNamesReadAsLowerCase)
+    bool fileColumnNamesReadAsLowerCase,
+    const std::string& fileMetadataCacheKey)
     : pool_{pool},
       arena_(std::make_unique<google::protobuf::Arena>()),
       decryptorFactory_(decryptorFactory),
@@ -111,9 +113,84 @@ ReaderBase::ReaderBase(
       preloadFile ? fileLength_ : std::min(fileLength_, directorySizeGuess_);
   DWIO_ENSURE_GE(readSize, 4, "File size too small");
 
-  input_->enqueue({fileLength_ - readSize, readSize, "footer"});
-  input_->load(preloadFile ? LogType::FILE : LogType::FOOTER);
+  auto* metadataCache = fileMetadataCacheKey.empty()
+      ? nullptr
+      : dwio::common::FileMetadataCache::instance();
+  // DWRF and ORC footers of the same file are different protos.
+  const auto cacheKey = fmt::format(
+      "{}:{}", fileMetadataCacheKey, dwio::common::toString(fileFormat));
+  std::shared_ptr<const FileTail> tail;
+  if (metadataCache != nullptr) {
+    tail = metadataCache->get<FileTail>(cacheKey);
+  }
+  if (tail != nullptr) {
+    // A small file is still loaded as a whole since its data is read next.
+    if (preloadFile) {
+      input_->enqueue({0, fileLength_, "footer"});
+      input_->load(LogType::FILE);
+    }
+  } else {
+    input_->enqueue({fileLength_ - readSize, readSize, "footer"});
+    input_->load(preloadFile ? LogType::FILE : LogType::FOOTER);
+    tail = readTail(readSize, fileFormat);
+    if (metadataCache != nullptr) {
+      metadataCache->put(
+          cacheKey, tail, sizeof(FileTail) + tail->arena.SpaceUsed());
+    }
+  }
+  psLength_ = tail->psLength;
+  postScript_ =
+      std::shared_ptr<const PostScript>(tail, tail->postScript.get());
+  footer_ = std::shared_ptr<const FooterWrapper>(tail, tail->footer.get());
+
+  schema_ = std::dynamic_pointer_cast<const RowType>(
+      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
+  DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
+
+  const uint64_t cacheSize =
+      postScript_->hasCacheSize() ? postScript_->cacheSize() : 0;
+  const uint64_t tailSize =
+      1 + psLength_ + postScript_->footerLength() + cacheSize;
+
+  // load stripe index/footer cache
+  if (cacheSize > 0) {
+    DWIO_ENSURE_EQ(format(), DwrfFormat::kDwrf);
+    if (input_->shouldPrefetchStripes()) {
+      cache_ = std::make_unique<StripeMetadataCache>(
+          postScript_->cacheMode(),
+          *footer_,
+          input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER));
+      input_->load(LogType::FOOTER);
+    } else {
+      auto cacheBuffer =
+          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
+      input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER)
+          ->readFully(cacheBuffer->data(), cacheSize);
+      cache_ = std::make_unique<StripeMetadataCache>(
+          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
+    }
+  }
+  if (!cache_ && input_->shouldPrefetchStripes()) {
+    auto numStripes = getFooter().stripesSize();
+    for (auto i = 0; i < numStripes; i++) {
+      const auto stripe = getFooter().stripes(i);
+      input_->enqueue(
+          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
+           stripe.footerLength(),
+           "stripe_footer"});
+    }
+    if (numStripes) {
+      input_->load(LogType::FOOTER);
+    }
+  }
+  // initialize file decrypter
+  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+}
 
+std::shared_ptr<const ReaderBase::FileTail> ReaderBase::readTail(
+    uint64_t readSize,
+    FileFormat fileFormat) {
+  auto tail = std::make_shared<FileTail>();
   // TODO: read footer from spectrum
   {
     const void* buf;
@@ -121,27 +198,31 @@ ReaderBase::ReaderBase(
     auto lastByteStream = input_->read(fileLength_ - 1, 1, LogType::FOOTER);
     DWIO_ENSURE(lastByteStream->Next(&buf, &ignored), "failed to read");
     // Make sure 'lastByteStream' is live while dereferencing 'buf'.
-    psLength_ = *static_cast<const char*>(buf) & 0xff;
+    tail->psLength = *static_cast<const char*>(buf) & 0xff;
   }
+  const auto psLength = tail->psLength;
   DWIO_ENSURE_LE(
-      psLength_ + 4, // 1 byte for post script len, 3 byte "ORC" header.
+      psLength + 4, // 1 byte for post script len, 3 byte "ORC" header.
       fileLength_,
       "Corrupted file, Post script size is invalid");
 
   if (fileFormat == FileFormat::DWRF) {
     auto postScript = ProtoUtils::readProto<proto::PostScript>(
-        input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+        input_->read(fileLength_ - psLength - 1, psLength, LogType::FOOTER));
+    tail->postScript = std::make_unique<PostScript>(std::move(postScript));
   } else {
     auto postScript = ProtoUtils::readProto<proto::orc::PostScript>(
-        input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+        input_->read(fileLength_ - psLength - 1, psLength, LogType::FOOTER));
+    tail->postScript = std::make_unique<PostScript>(std::move(postScript));
   }
+  // createDecompressedStream() reads the compression from 'postScript_'.
+  postScript_ =
+      std::shared_ptr<const PostScript>(tail, tail->postScript.get());
 
   uint64_t footerSize = postScript_->footerLength();
   uint64_t cacheSize =
       postScript_->hasCacheSize() ? postScript_->cacheSize() : 0;
-  uint64_t tailSize = 1 + psLength_ + footerSize + cacheSize;
+  uint64_t tailSize = 1 + psLength + footerSize + cacheSize;
 
   // There are cases in warehouse, where RC/text files are stored
   // in ORC partition. This causes the Reader to SIGSEGV. The following
@@ -165,60 +246,23 @@ ReaderBase::ReaderBase(
   }
 
   auto footerStream = input_->read(
-      fileLength_ - psLength_ - footerSize - 1, footerSize, LogType::FOOTER);
+      fileLength_ - psLength - footerSize - 1, footerSize, LogType::FOOTER);
   if (fileFormat == FileFormat::DWRF) {
     auto footer =
-        google::protobuf::Arena::CreateMessage<proto::Footer>(arena_.get());
+        google::protobuf::Arena::CreateMessage<proto::Footer>(&tail->arena);
     ProtoUtils::readProtoInto<proto::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
+    tail->footer = std::make_unique<FooterWrapper>(footer);
   } else {
     auto footer = google::protobuf::Arena::CreateMessage<proto::orc::Footer>(
-        arena_.get());
+        &tail->arena);
     ProtoUtils::readProtoInto<proto::orc::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
-  }
-
-  schema_ = std::dynamic_pointer_cast<const RowType>(
-      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
-  DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
-
-  // load stripe index/footer cache
-  if (cacheSize > 0) {
-    DWIO_ENSURE_EQ(format(), DwrfFormat::kDwrf);
-    if (input_->shouldPrefetchStripes()) {
-      cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(),
-          *footer_,
-          input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER));
-      input_->load(LogType::FOOTER);
-    } else {
-      auto cacheBuffer =
-          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
-      input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER)
-          ->readFully(cacheBuffer->data(), cacheSize);
-      cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
-    }
+    tail->footer = std::make_unique<FooterWrapper>(footer);
   }
-  if (!cache_ && input_->shouldPrefetchStripes()) {
-    auto numStripes = getFooter().stripesSize();
-    for (auto i = 0; i < numStripes; i++) {
-      const auto stripe = getFooter().stripes(i);
-      input_->enqueue(
-          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
-           stripe.footerLength(),
-           "stripe_footer"});
-    }
-    if (numStripes) {
-      input_->load(LogType::FOOTER);
-    }
-  }
-  // initialize file decrypter
-  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+  return tail;
 }
 
 std::vector<uint64_t> ReaderBase::getRowsPerStripe() const {
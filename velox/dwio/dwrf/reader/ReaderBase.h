@@ -70,7 +70,8 @@ class ReaderBase {
       uint64_t filePreloadThreshold =
           dwio::common::ReaderOptions::kDefaultFilePreloadThreshold,
       dwio::common::FileFormat fileFormat = dwio::common::FileFormat::DWRF,
-      bool fileColumnNamesReadAsLowerCase = false);
+      bool fileColumnNamesReadAsLowerCase = false,
+      const std::string& fileMetadataCacheKey = "");
 
   ReaderBase(
       memory::MemoryPool& pool,
@@ -232,15 +233,33 @@ class ReaderBase {
   }
 
  private:
+  // The parsed PostScript and Footer of a file. Shared by the readers of the
+  // file through dwio::common::FileMetadataCache.
+  struct FileTail {
+    // Owns the Footer.
+    google::protobuf::Arena arena;
+    std::unique_ptr<PostScript> postScript;
+    std::unique_ptr<FooterWrapper> footer;
+    uint64_t psLength;
+  };
+
+  // Reads and parses the PostScript and Footer of the file. 'readSize' bytes
+  // from the end of the file are loaded in 'input_'.
+  std::shared_ptr<const FileTail> readTail(
+      uint64_t readSize,
+      dwio::common::FileFormat fileFormat);
+
   static std::shared_ptr<const Type> convertType(
       const FooterWrapper& footer,
       uint32_t index = 0,
       bool fileColumnNamesReadAsLowerCase = false);
 
   memory::MemoryPool& pool_;
+  // Arena for the stripe footers. The file footer is in the arena of the
+  // FileTail.
   std::unique_ptr<google::protobuf::Arena> arena_;
-  std::unique_ptr<PostScript> postScript_;
-  std::unique_ptr<FooterWrapper> footer_ = nullptr;
+  std::shared_ptr<const PostScript> postScript_;
+  std::shared_ptr<const FooterWrapper> footer_;
   std::unique_ptr<StripeMetadataCache> cache_;
   // Keeps factory alive for possibly async prefetch.
   std::shared_ptr<dwio::common::encryption::DecrypterFactory> decryptorFactory_;
@@ -109,12 +109,10 @@ std::vector<KeyNode<T>> getKeyNodes(
   std::unordered_map<KeyValue<T>, common::ScanSpec*, KeyValueHash<T>>
       childSpecs;
   if (asStruct) {
+    // The fields of the struct are named by the keys. The subscripts are
+    // reassigned for each stripe.
     for (auto& c : scanSpec.children()) {
-      if constexpr (std::is_same_v<T, StringView>) {
-        childSpecs[KeyValue<T>(StringView(c->fieldName()))] = c.get();
-      } else {
-        childSpecs[KeyValue<T>(c->subscript())] = c.get();
-      }
+      childSpecs[parseKeyValue<T>(c->fieldName())] = c.get();
     }
   }
 
@@ -201,15 +199,44 @@ class SelectiveFlatMapAsStructReader : public SelectiveStructColumnReaderBase {
     VELOX_CHECK(
         !keyNodes_.empty(),
         "For struct encoding, keys to project must be configured");
+    // Keys that are not in this stripe are read as null.
+    for (auto& childSpec : scanSpec.children()) {
+      if (!childSpec->isConstant()) {
+        childSpec->setSubscript(kConstantChildSpecSubscript);
+      }
+    }
     children_.resize(keyNodes_.size());
     for (int i = 0; i < keyNodes_.size(); ++i) {
       keyNodes_[i].reader->scanSpec()->setSubscript(i);
       children_[i] = keyNodes_[i].reader.get();
     }
+    for (auto& childSpec : scanSpec.children()) {
+      if (childSpec->subscript() == kConstantChildSpecSubscript &&
+          childSpec->filter() && !childSpec->filter()->testNull()) {
+        missingKeyFilteredOut_ = true;
+      }
+    }
+  }
+
+  void read(vector_size_t offset, RowSet rows, const uint64_t* incomingNulls)
+      override {
+    if (!missingKeyFilteredOut_) {
+      SelectiveStructColumnReaderBase::read(offset, rows, incomingNulls);
+      return;
+    }
+    // A key missing in this stripe is null and no row passes the filter on
+    // it.
+    numReads_ = scanSpec_->newRead();
+    prepareRead<char>(offset, rows, incomingNulls);
+    recordParentNullsInChildren(offset, rows);
+    lazyVectorReadOffset_ = offset;
+    readOffset_ = offset + rows.back() + 1;
   }
 
  private:
   std::vector<KeyNode<T>> keyNodes_;
+  // True if a key with a filter that fails on null is not in this stripe.
+  bool missingKeyFilteredOut_{false};
 };
 
 template <typename T>
@@ -18,6 +18,7 @@
 #include <folly/container/F14Set.h>
 
 #include "velox/common/base/BitSet.h"
+#include "velox/dwio/common/compression/PagedInputStream.h"
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/common/DecoderUtil.h"
 #include "velox/dwio/dwrf/common/wrap/coded-stream-wrapper.h"
@@ -303,10 +304,21 @@ std::unique_ptr<dwio::common::SeekableInputStream> StripeStreamsImpl::getStream(
 
   auto streamDebugInfo =
       fmt::format("Stripe {} Stream {}", stripeIndex_, si.toString());
-  return readState_->readerBase->createDecompressedStream(
+  auto stream = readState_->readerBase->createDecompressedStream(
       std::move(streamRead),
       streamDebugInfo,
       getDecrypter(si.encodingKey().node()));
+  if (opts_.getDecompressionReadAheadBlocks() > 0 &&
+      opts_.getDecodingExecutor()) {
+    if (auto* paged =
+            dynamic_cast<dwio::common::compression::PagedInputStream*>(
+                stream.get())) {
+      paged->setReadAhead(
+          opts_.getDecodingExecutor().get(),
+          opts_.getDecompressionReadAheadBlocks());
+    }
+  }
+  return stream;
 }
 
 uint32_t StripeStreamsImpl::visitStreamsOfNode(
@@ -19,6 +19,7 @@
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/io/IoLatencyModel.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/common/io/Options.h"
 #include "velox/common/memory/MmapAllocator.h"
@@ -761,3 +762,54 @@ TEST_F(CacheTest, readAhead) {
 
   LOG(INFO) << count << " prefetches with total " << bytes << " bytes";
 }
+
+TEST_F(CacheTest, latencyModel) {
+  constexpr int32_t kDistance = 512 << 10;
+  constexpr int64_t kMaxBytes = 128 << 20;
+  io::IoLatencyModel model;
+  // 1ms latency and 100 bytes per microsecond.
+  const auto read = [&](uint64_t bytes) {
+    model.record(bytes, 1000 + bytes / 100);
+  };
+
+  // Reads of one size do not separate the latency from the transfer time.
+  for (auto i = 0; i < 20; ++i) {
+    read(1 << 20);
+  }
+  EXPECT_EQ(0, model.estimate().numSamples);
+  EXPECT_EQ(kDistance, model.coalesceDistance(kDistance));
+  EXPECT_EQ(kMaxBytes, model.maxCoalesceBytes(kMaxBytes, false));
+
+  model.clear();
+  for (auto i = 1; i < io::IoLatencyModel::kMinSamples; ++i) {
+    read(i * 100'000);
+  }
+  EXPECT_EQ(kDistance, model.coalesceDistance(kDistance));
+  read(2'000'000);
+  const auto fit = model.estimate();
+  EXPECT_EQ(io::IoLatencyModel::kMinSamples, fit.numSamples);
+  EXPECT_NEAR(1000, fit.latencyUs, 10);
+  EXPECT_NEAR(100, fit.bytesPerUs, 1);
+  EXPECT_NEAR(100'000, model.coalesceDistance(kDistance), 2'000);
+  EXPECT_NEAR(1'600'000, model.maxCoalesceBytes(kMaxBytes, false), 30'000);
+  // Parallel loads are smaller but not below the minimum.
+  EXPECT_EQ(
+      io::IoLatencyModel::kMinCoalesceBytes,
+      model.maxCoalesceBytes(kMaxBytes, true));
+  EXPECT_EQ(1'000'000, model.maxCoalesceBytes(1'000'000, false));
+
+  // The model follows a slower storage.
+  for (auto i = 0; i < 200; ++i) {
+    const uint64_t bytes = (1 + i % 10) * 100'000;
+    model.record(bytes, 10'000 + bytes / 100);
+  }
+  EXPECT_NEAR(1'000'000, model.coalesceDistance(kDistance), 20'000);
+
+  // Files of a file system share a model.
+  EXPECT_EQ(
+      &io::IoLatencyModel::forPath("s3://bucket/file1"),
+      &io::IoLatencyModel::forPath("s3://other/file2"));
+  EXPECT_NE(
+      &io::IoLatencyModel::forPath("s3://bucket/file1"),
+      &io::IoLatencyModel::forPath("/tmp/file1"));
+}
@@ -104,12 +104,17 @@ class E2EFilterTest : public E2EFilterTestBase {
   }
 
   std::unordered_set<std::string> flatMapColumns_;
+  // Rows per row group. 0 means the default of the writer.
+  uint32_t rowIndexStride_{0};
 
  private:
   dwrf::WriterOptions createWriterOptions(const TypePtr& type) {
     auto config = std::make_shared<dwrf::Config>();
     config->set(dwrf::Config::COMPRESSION, CompressionKind_NONE);
     config->set(dwrf::Config::USE_VINTS, useVInts_);
+    if (rowIndexStride_) {
+      config->set(dwrf::Config::ROW_INDEX_STRIDE, rowIndexStride_);
+    }
     auto writerSchema = type;
     if (!flatMapColumns_.empty()) {
       auto& rowType = type->asRow();
@@ -354,6 +359,25 @@ TEST_F(E2EFilterTest, lazyStruct) {
       false);
 }
 
+TEST_F(E2EFilterTest, lazyVectorRowGroupSeek) {
+  // Row groups much smaller than the read batches, so that the rows left by
+  // selective filters start several row groups after the start of the batch
+  // and the LazyVectors seek to them with the row group index.
+  rowIndexStride_ = 100;
+  testWithTypes(
+      "long_val:bigint,"
+      "short_val:smallint,"
+      "string_val:string,"
+      "double_val:double,"
+      "struct_val:struct<a:bigint, b:string>",
+      [&]() {},
+      true,
+      {"long_val", "short_val"},
+      20,
+      true,
+      false);
+}
+
 TEST_F(E2EFilterTest, filterStruct) {
 #ifdef TSAN_BUILD
   // The test is running slow under TSAN; reduce the number of combinations to
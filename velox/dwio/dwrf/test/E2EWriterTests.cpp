@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/testutil/TestValue.h"
@@ -29,6 +30,7 @@
 #include "velox/dwio/dwrf/test/utils/E2EWriterTestUtil.h"
 #include "velox/dwio/dwrf/writer/Writer.h"
 #include "velox/type/fbhive/HiveTypeParser.h"
+#include "velox/vector/DecodedVector.h"
 #include "velox/vector/FlatVector.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
@@ -388,6 +390,143 @@ TEST_F(E2EWriterTests, FlatMapDictionaryEncoding) {
   E2EWriterTestUtil::testWriter(*pool, type, batches, 1, 1, config);
 }
 
+TEST_F(E2EWriterTests, parallelColumnEncoding) {
+  HiveTypeParser parser;
+  auto type = parser.parse(
+      "struct<"
+      "int_val:int,"
+      "long_val:bigint,"
+      "string_val:string,"
+      "array_val:array<float>,"
+      "map_val:map<bigint,double>,"
+      "flat_map_val:map<int,string>,"
+      "struct_val:struct<a:float,b:double>"
+      ">");
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::ROW_INDEX_STRIDE, static_cast<uint32_t>(1000));
+  config->set(dwrf::Config::FLATTEN_MAP, true);
+  config->set(dwrf::Config::MAP_FLAT_COLS, {5});
+
+  std::vector<VectorPtr> batches;
+  for (size_t i = 0; i < 10; ++i) {
+    batches.push_back(
+        BatchMaker::createBatch(type, 1'500, *leafPool_, nullptr, i));
+  }
+
+  auto write = [&](std::shared_ptr<folly::Executor> executor) {
+    auto sink = std::make_unique<MemorySink>(
+        64 * kSizeMB, dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    options.flushPolicyFactory = []() {
+      return std::make_unique<RowsPerStripeFlushPolicy>(
+          std::vector<uint64_t>{6'000, 9'000});
+    };
+    options.encodingExecutor = std::move(executor);
+    dwrf::Writer writer{std::move(sink), options};
+    for (auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  // The streams are laid out in the same order whichever column finishes
+  // first, so the files are identical.
+  auto serial = write(nullptr);
+  auto parallel = write(std::make_shared<folly::CPUThreadPoolExecutor>(4));
+  ASSERT_EQ(serial, parallel);
+
+  auto input = std::make_unique<BufferedInput>(
+      std::make_shared<InMemoryReadFile>(std::string_view(parallel)),
+      *leafPool_);
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  auto reader = DwrfReader::create(std::move(input), readerOpts);
+  ASSERT_EQ(reader->numberOfRows(), 15'000);
+  ASSERT_EQ(reader->getNumberOfStripes(), 2);
+}
+
+TEST_F(E2EWriterTests, perStripeDictionaryEvaluation) {
+  const size_t kRowsPerStripe = 2'000;
+  const size_t kStripes = 4;
+  // Even stripes repeat a few values and odd stripes have unique values.
+  std::vector<std::string> values;
+  for (size_t stripe = 0; stripe < kStripes; ++stripe) {
+    for (size_t i = 0; i < kRowsPerStripe; ++i) {
+      values.push_back(
+          stripe % 2 == 0 ? fmt::format("value_{}", i % 10)
+                          : fmt::format("unique_value_{}_{}", stripe, i));
+    }
+  }
+
+  VectorMaker maker{leafPool_.get()};
+  std::vector<VectorPtr> batches;
+  for (size_t stripe = 0; stripe < kStripes; ++stripe) {
+    batches.push_back(maker.rowVector({maker.flatVector<StringView>(
+        kRowsPerStripe, [&](auto row) {
+          return StringView(values[stripe * kRowsPerStripe + row]);
+        })}));
+  }
+  auto type = asRowType(batches[0]->type());
+
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(
+      dwrf::Config::DICTIONARY_STRING_EVALUATION_ROWS,
+      static_cast<uint32_t>(500));
+  auto sink = std::make_unique<MemorySink>(
+      64 * kSizeMB, dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto* sinkPtr = sink.get();
+  dwrf::WriterOptions options;
+  options.config = config;
+  options.schema = type;
+  options.memoryPool = rootPool_.get();
+  options.flushPolicyFactory = [&]() {
+    return std::make_unique<RowsPerStripeFlushPolicy>(
+        std::vector<uint64_t>(kStripes, kRowsPerStripe));
+  };
+  dwrf::Writer writer{std::move(sink), options};
+  for (auto& batch : batches) {
+    writer.write(batch);
+  }
+  writer.close();
+
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  auto reader = createReader(*sinkPtr, readerOpts);
+  ASSERT_EQ(reader->getNumberOfStripes(), kStripes);
+  auto rowReader = reader->createRowReader(RowReaderOptions{});
+  auto dwrfRowReader = dynamic_cast<DwrfRowReader*>(rowReader.get());
+  for (uint32_t i = 0; i < kStripes; ++i) {
+    bool preload = true;
+    dwrfRowReader->loadStripe(i, preload);
+    auto& footer = dwrfRowReader->getStripeFooter();
+    for (int32_t j = 0; j < footer.encoding_size(); ++j) {
+      auto& encoding = footer.encoding(j);
+      if (encoding.node() == 1) {
+        EXPECT_EQ(
+            encoding.kind(),
+            i % 2 == 0 ? proto::ColumnEncoding_Kind_DICTIONARY
+                       : proto::ColumnEncoding_Kind_DIRECT);
+      }
+    }
+  }
+
+  rowReader = reader->createRowReader(RowReaderOptions{});
+  VectorPtr result;
+  size_t numRows = 0;
+  while (rowReader->next(1'000, result)) {
+    auto strings = result->as<RowVector>()->childAt(0);
+    DecodedVector decoded(*strings);
+    for (vector_size_t i = 0; i < strings->size(); ++i) {
+      ASSERT_EQ(decoded.valueAt<StringView>(i).str(), values[numRows + i]);
+    }
+    numRows += strings->size();
+  }
+  ASSERT_EQ(numRows, values.size());
+}
+
 TEST_F(E2EWriterTests, MaxFlatMapKeys) {
   using keyType = int32_t;
   using valueType = int32_t;
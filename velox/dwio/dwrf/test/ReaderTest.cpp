@@ -17,9 +17,11 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <velox/buffer/Buffer.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include "folly/Random.h"
 #include "folly/lang/Assume.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/FileSink.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -494,6 +496,46 @@ VELOX_INSTANTIATE_TEST_SUITE_P(
     TestFlatMapReader,
     Values(true, false));
 
+TEST(TestReader, fileMetadataCache) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_file_metadata_cache_bytes = 64 << 20;
+  auto* cache = FileMetadataCache::instance();
+  ASSERT_NE(cache, nullptr);
+  cache->clear();
+
+  ReaderOptions readerOpts{getDefaultPool().get()};
+  readerOpts.setFileMetadataCacheKey(getStructFile());
+  auto createReader = [&]() {
+    return DwrfReader::create(
+        createFileBufferedInput(getStructFile(), readerOpts.getMemoryPool()),
+        readerOpts);
+  };
+  const auto numHits = cache->stats().numHits;
+  auto first = createReader();
+  auto stats = cache->stats();
+  ASSERT_EQ(stats.numEntries, 1);
+  ASSERT_GT(stats.curBytes, 0);
+  ASSERT_EQ(stats.numHits, numHits);
+
+  auto second = createReader();
+  ASSERT_EQ(cache->stats().numHits, numHits + 1);
+  ASSERT_EQ(second->rowType()->toString(), first->rowType()->toString());
+  ASSERT_EQ(second->numberOfRows(), first->numberOfRows());
+  // The footer is shared by the readers.
+  ASSERT_EQ(&second->getFooter(), &first->getFooter());
+
+  // The footer outlives its cache entry.
+  const auto numStripes = first->getFooter().stripesSize();
+  cache->clear();
+  first.reset();
+  ASSERT_EQ(second->getFooter().stripesSize(), numStripes);
+
+  // Readers without a key do not use the cache.
+  readerOpts.setFileMetadataCacheKey("");
+  createReader();
+  ASSERT_EQ(cache->stats().numEntries, 0);
+}
+
 TEST(TestRowReaderPrefetch, testPartialPrefetch) {
   // batch size is set as 1000 in reading
   std::array<int32_t, 5> seeks;
@@ -604,6 +646,37 @@ TEST(TestRowReaderPrefetch, testPrefetchAndStartNextStripeInterleaved) {
       expectedBatchSize.size());
 }
 
+TEST(TestRowReaderPrefetch, parallelStripeFetches) {
+  std::array<int32_t, 5> seeks;
+  seeks.fill(0);
+  const std::array<int32_t, 4> expectedBatchSize{300, 300, 300, 100};
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(2);
+  dwio::common::ReaderOptions readerOpts{getDefaultPool().get()};
+  readerOpts.setFilePreloadThreshold(0);
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.select(std::make_shared<ColumnSelector>(getFlatmapSchema()));
+  rowReaderOpts.setDecodingExecutor(executor);
+  rowReaderOpts.setParallelStripeFetches(2);
+  auto reader = DwrfReader::create(
+      createFileBufferedInput(getFMSmallFile(), readerOpts.getMemoryPool()),
+      readerOpts);
+  auto rowReaderOwner = reader->createRowReader(rowReaderOpts);
+  auto rowReader = dynamic_cast<DwrfRowReader*>(rowReaderOwner.get());
+
+  // Starting the first stripe starts the fetches of the next two.
+  rowReader->startNextStripe();
+  auto units = rowReader->prefetchUnits().value();
+  ASSERT_EQ(units.size(), 4);
+  EXPECT_NE(units[1].prefetch(), DwrfRowReader::FetchResult::kFetched);
+  EXPECT_NE(units[2].prefetch(), DwrfRowReader::FetchResult::kFetched);
+
+  verifyFlatMapReading(
+      rowReader,
+      seeks.data(),
+      expectedBatchSize.data(),
+      expectedBatchSize.size());
+}
+
 TEST(TestRowReaderPrefetch, testReadLargePrefetch) {
   // batch size is set as 1000 in reading
   // 3000 per stripe
@@ -1376,6 +1449,63 @@ TEST(TestReader, testFlatmapAsStructRequiringKeyList) {
       rowReaderOpts.setFlatmapNodeIdsAsStruct(emptyKeys), VeloxException);
 }
 
+TEST(TestReader, testSelectiveFlatmapAsStruct) {
+  auto* pool = getDefaultPool().get();
+  dwio::common::ReaderOptions readerOpts{pool};
+  auto reader = DwrfReader::create(
+      createFileBufferedInput(getFMSmallFile(), readerOpts.getMemoryPool()),
+      readerOpts);
+  auto schema = reader->rowType();
+  const auto mapIndex = schema->getChildIdx("map1");
+  const std::vector<int32_t> keys{1, 2, 3, 4, 5, -99999999 /* missing */};
+
+  // Reads 'map1' as a map and as a struct of 'keys'.
+  auto structType = schema;
+  {
+    auto names = schema->names();
+    auto types = schema->children();
+    types[mapIndex] = ROW(
+        stringify(keys),
+        std::vector<TypePtr>(keys.size(), types[mapIndex]->childAt(1)));
+    structType = ROW(std::move(names), std::move(types));
+  }
+  auto makeRowReader = [&](const RowTypePtr& type, bool asStruct) {
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addAllChildFields(*type);
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(spec);
+    if (asStruct) {
+      rowReaderOpts.setFlatmapNodeIdsAsStruct(
+          {{reader->typeWithId()->childAt(mapIndex)->id(), stringify(keys)}});
+    }
+    return std::make_pair(reader->createRowReader(rowReaderOpts), spec);
+  };
+  auto [mapReader, mapSpec] = makeRowReader(schema, false);
+  auto [structReader, structSpec] = makeRowReader(structType, true);
+
+  auto mapBatch = BaseVector::create(schema, 0, pool);
+  auto structBatch = BaseVector::create(structType, 0, pool);
+  vector_size_t numRows = 0;
+  while (mapReader->next(300, mapBatch)) {
+    ASSERT_TRUE(structReader->next(300, structBatch));
+    ASSERT_EQ(mapBatch->size(), structBatch->size());
+    auto* map = mapBatch->as<RowVector>()
+                    ->childAt(mapIndex)
+                    ->loadedVector()
+                    ->as<MapVector>();
+    auto* row = structBatch->as<RowVector>()
+                    ->childAt(mapIndex)
+                    ->loadedVector()
+                    ->as<RowVector>();
+    for (auto i = 0; i < keys.size(); ++i) {
+      verifyMapColumnEqual(map, row, keys[i], i);
+    }
+    numRows += mapBatch->size();
+  }
+  ASSERT_FALSE(structReader->next(300, structBatch));
+  ASSERT_GT(numRows, 0);
+}
+
 // TODO: replace with mock
 TEST(TestReader, testMismatchSchemaMoreFields) {
   // file has schema: a int, b struct<a:int, b:float, c:string>, c float
@@ -2361,6 +2491,71 @@ TEST(TestReader, testOrcReaderVarchar) {
   EXPECT_EQ(counter, 6000);
 }
 
+TEST(TestReader, testOrcReaderRleV2Filters) {
+  // The columns of the file are RLEv2 encoded. The filters go through the bulk
+  // path of RleDecoderV2.
+  const std::string varcharOrc(getExampleFilePath("orc_index_int_string.orc"));
+  auto* pool = getDefaultPool().get();
+  dwio::common::ReaderOptions readerOpts{pool};
+  readerOpts.setFileFormat(dwio::common::FileFormat::ORC);
+  auto reader = DwrfReader::create(
+      createFileBufferedInput(varcharOrc, readerOpts.getMemoryPool()),
+      readerOpts);
+  auto schema = reader->rowType();
+
+  auto readFiltered = [&](std::unique_ptr<common::Filter> intFilter,
+                          std::unique_ptr<common::Filter> stringFilter) {
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addAllChildFields(*schema);
+    if (intFilter) {
+      spec->childByName(schema->nameOf(0))->setFilter(std::move(intFilter));
+    }
+    if (stringFilter) {
+      spec->childByName(schema->nameOf(1))->setFilter(std::move(stringFilter));
+    }
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto batch = BaseVector::create(schema, 0, pool);
+    std::vector<int32_t> ints;
+    while (rowReader->next(1000, batch)) {
+      auto rowVector = batch->as<RowVector>();
+      // A column without a filter is returned as a LazyVector.
+      auto intValues =
+          rowVector->childAt(0)->loadedVector()->as<SimpleVector<int32_t>>();
+      auto strings =
+          rowVector->childAt(1)->loadedVector()->as<SimpleVector<StringView>>();
+      for (auto i = 0; i < rowVector->size(); ++i) {
+        auto value = intValues->valueAt(i);
+        auto expected = std::to_string(value) + (value < 1000 ? "a" : "");
+        EXPECT_EQ(expected, strings->valueAt(i).str());
+        ints.push_back(value);
+      }
+    }
+    return ints;
+  };
+
+  auto ints = readFiltered(
+      std::make_unique<common::BigintRange>(990, 2500, false), nullptr);
+  ASSERT_EQ(ints.size(), 1511);
+  for (auto i = 0; i < ints.size(); ++i) {
+    EXPECT_EQ(ints[i], 990 + i);
+  }
+
+  ints = readFiltered(
+      nullptr,
+      std::make_unique<common::BytesValues>(
+          std::vector<std::string>{"1a", "999a", "1000", "4321", "6000"},
+          false));
+  EXPECT_EQ(ints, (std::vector<int32_t>{1, 999, 1000, 4321, 6000}));
+
+  ints = readFiltered(
+      std::make_unique<common::BigintRange>(1, 4000, false),
+      std::make_unique<common::BytesValues>(
+          std::vector<std::string>{"1a", "4321", "3999"}, false));
+  EXPECT_EQ(ints, (std::vector<int32_t>{1, 3999}));
+}
+
 TEST(TestReader, testOrcReaderDate) {
   const std::string dateOrc(getExampleFilePath("TestOrcFile.testDate1900.orc"));
   dwio::common::ReaderOptions readerOpts{getDefaultPool().get()};
@@ -2880,3 +3075,64 @@ TEST(TestReader, missingSubfieldsNoResultReusing) {
   });
   assertEqualVectors(expected, actual);
 }
+
+TEST(TestReader, repeatedColumnLengthFilter) {
+  auto* pool = getDefaultPool().get();
+  VectorMaker maker(pool);
+  using Maps =
+      std::vector<std::vector<std::pair<int64_t, std::optional<int64_t>>>>;
+  auto batch = maker.rowVector({
+      maker.flatVector<int64_t>(6, folly::identity),
+      maker.arrayVectorFromJson<int64_t>(
+          {"[1, 2]", "[]", "null", "[3]", "[4, 5, 6]", "[]"}),
+      maker.mapVector<int64_t, int64_t>(
+          Maps{{{1, 10}}, {}, {{2, 20}, {3, 30}}, {{4, 40}}, {}, {}}),
+  });
+  auto [writer, reader] = createWriterReader({batch}, *pool);
+  auto schema = asRowType(batch->type());
+
+  auto readWithLengthFilter = [&](const std::string& column,
+                                  std::unique_ptr<common::Filter> filter) {
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addAllChildFields(*schema);
+    spec->childByName(column)->setLengthFilter(std::move(filter));
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    VectorPtr actual = BaseVector::create(schema, 0, pool);
+    EXPECT_EQ(rowReader->next(1024, actual), 6);
+    return actual;
+  };
+
+  // cardinality(c1) > 0.
+  auto actual = readWithLengthFilter(
+      "c1",
+      std::make_unique<common::BigintRange>(
+          1, std::numeric_limits<int64_t>::max(), false));
+  auto expected = maker.rowVector({
+      maker.flatVector<int64_t>({0, 3, 4}),
+      maker.arrayVectorFromJson<int64_t>({"[1, 2]", "[3]", "[4, 5, 6]"}),
+      maker.mapVector<int64_t, int64_t>(Maps{{{1, 10}}, {{4, 40}}, {}}),
+  });
+  assertEqualVectors(expected, actual);
+
+  // cardinality(c2) = 2.
+  actual = readWithLengthFilter(
+      "c2", std::make_unique<common::BigintRange>(2, 2, false));
+  expected = maker.rowVector({
+      maker.flatVector<int64_t>({2}),
+      maker.arrayVectorFromJson<int64_t>({"null"}),
+      maker.mapVector<int64_t, int64_t>(Maps{{{2, 20}, {3, 30}}}),
+  });
+  assertEqualVectors(expected, actual);
+
+  // cardinality(c1) = 0 or c1 is null.
+  actual = readWithLengthFilter(
+      "c1", std::make_unique<common::BigintRange>(0, 0, true));
+  expected = maker.rowVector({
+      maker.flatVector<int64_t>({1, 2, 5}),
+      maker.arrayVectorFromJson<int64_t>({"[]", "null", "[]"}),
+      maker.mapVector<int64_t, int64_t>(Maps{{}, {{2, 20}, {3, 30}}, {}}),
+  });
+  assertEqualVectors(expected, actual);
+}
@@ -18,10 +18,12 @@
 #include <folly/String.h>
 #include <folly/compression/Compression.h>
 #include <folly/compression/Zlib.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include "velox/common/base/BitUtil.h"
 #include "velox/dwio/common/InputStream.h"
 #include "velox/dwio/common/compression/Compression.h"
+#include "velox/dwio/common/compression/PagedInputStream.h"
 #include "velox/dwio/dwrf/test/OrcTest.h"
 
 #include <cstdio>
@@ -925,6 +927,87 @@ TEST_F(TestSeek, Snappy) {
   runTest(*codec, CompressionKind_SNAPPY);
 }
 
+TEST(TestDecompression, readAhead) {
+  constexpr int32_t kNumBlocks = 8;
+  constexpr int32_t kBlockSize = 1024;
+  auto codec = getCodec(CodecType::ZSTD);
+  std::vector<std::vector<char>> blocks(
+      kNumBlocks, std::vector<char>(kBlockSize));
+  std::vector<char> compressed(kNumBlocks * kBlockSize * 2);
+  std::vector<uint64_t> offsets;
+  size_t offset = 0;
+  for (auto& block : blocks) {
+    fillInput(block.data(), block.size());
+    offsets.push_back(offset);
+    offset = compress(
+        block.data(), block.size(), compressed.data(), offset, *codec);
+  }
+
+  folly::CPUThreadPoolExecutor executor(2);
+  auto stream = createDecompressor(
+      CompressionKind_ZSTD,
+      std::make_unique<SeekableArrayInputStream>(compressed.data(), offset),
+      kBlockSize,
+      *pool,
+      "Test Decompression",
+      nullptr);
+  auto* paged = dynamic_cast<dwio::common::compression::PagedInputStream*>(
+      stream.get());
+  ASSERT_NE(paged, nullptr);
+  paged->setReadAhead(&executor, 3);
+
+  const void* data;
+  int32_t size;
+  for (auto& block : blocks) {
+    ASSERT_TRUE(stream->Next(&data, &size));
+    ASSERT_EQ(size, kBlockSize);
+    EXPECT_EQ(0, memcmp(data, block.data(), kBlockSize));
+  }
+  EXPECT_FALSE(stream->Next(&data, &size));
+
+  // Seeks back, then skips a block that is being read ahead.
+  std::vector<uint64_t> positions{offsets[2], 10};
+  PositionProvider provider(positions);
+  stream->seekToPosition(provider);
+  ASSERT_TRUE(stream->Next(&data, &size));
+  ASSERT_EQ(size, kBlockSize - 10);
+  EXPECT_EQ(0, memcmp(data, blocks[2].data() + 10, size));
+  ASSERT_TRUE(stream->Skip(kBlockSize));
+  ASSERT_TRUE(stream->Next(&data, &size));
+  ASSERT_EQ(size, kBlockSize);
+  EXPECT_EQ(0, memcmp(data, blocks[4].data(), kBlockSize));
+}
+
+TEST(TestDecompression, registeredCodec) {
+  constexpr int32_t kSize = 1024;
+  std::vector<char> input(kSize);
+  fillInput(input.data(), kSize);
+  std::vector<char> compressed(2 * kSize);
+  auto codec = getCodec(CodecType::ZSTD);
+  auto compressedSize =
+      compress(input.data(), kSize, compressed.data(), 0, *codec);
+
+  int32_t numCodecs = 0;
+  registerCodecFactory(CompressionKind_ZSTD, [&](CompressionKind /*kind*/) {
+    ++numCodecs;
+    return getCodec(CodecType::ZSTD);
+  });
+  auto stream = createTestDecompressor(
+      CompressionKind_ZSTD,
+      std::make_unique<SeekableArrayInputStream>(
+          compressed.data(), compressedSize),
+      kSize);
+  registerCodecFactory(CompressionKind_ZSTD, nullptr);
+  ASSERT_EQ(numCodecs, 1);
+
+  const void* data;
+  int32_t size;
+  ASSERT_TRUE(stream->Next(&data, &size));
+  ASSERT_EQ(size, kSize);
+  EXPECT_EQ(0, memcmp(data, input.data(), kSize));
+  EXPECT_FALSE(stream->Next(&data, &size));
+}
+
 TEST_F(TestSeek, uncompressed) {
   constexpr int32_t kSize = 1000;
   constexpr int32_t kHeaderSize = 3;
@@ -666,6 +666,61 @@ TEST(RLEv2, bitsLeftByPreviousStream) {
   }
 };
 
+TEST(RLEv2, directAllWidths) {
+  auto pool = memory::addDefaultLeafMemoryPool();
+  // The bit widths of DIRECT runs and their 5 bit codes.
+  const std::vector<std::pair<int32_t, int32_t>> widths = {
+      {1, 0},   {2, 1},   {3, 2},   {4, 3},   {5, 4},   {7, 6},
+      {8, 7},   {11, 10}, {13, 12}, {16, 15}, {17, 16}, {24, 23},
+      {26, 24}, {28, 25}, {30, 26}, {32, 27}, {40, 28}, {48, 29},
+      {56, 30}, {64, 31}};
+  constexpr int32_t kRunLength = 500;
+  for (const auto& [width, code] : widths) {
+    SCOPED_TRACE(fmt::format("width {}", width));
+    // One DIRECT run of zigzag encoded values, packed most significant bit
+    // first.
+    std::vector<unsigned char> bytes = {
+        static_cast<unsigned char>(
+            0x40 | (code << 1) | ((kRunLength - 1) >> 8)),
+        static_cast<unsigned char>((kRunLength - 1) & 0xff)};
+    std::vector<int64_t> expected;
+    uint64_t bitsInByte = 0;
+    for (auto i = 0; i < kRunLength; ++i) {
+      const uint64_t encoded = (width == 64 ? ~0ULL : bits::lowMask(width)) &
+          (i * 0x9e3779b97f4a7c15ULL);
+      expected.push_back(
+          static_cast<int64_t>(encoded >> 1) ^
+          -static_cast<int64_t>(encoded & 1));
+      for (auto bit = width - 1; bit >= 0; --bit) {
+        if (bitsInByte % 8 == 0) {
+          bytes.push_back(0);
+        }
+        bytes.back() |= ((encoded >> bit) & 1) << (7 - bitsInByte % 8);
+        ++bitsInByte;
+      }
+    }
+    // Read with small stream buffers and batches to cover values that
+    // straddle buffers and batches that end inside a byte.
+    for (auto blockSize : {0, 13}) {
+      for (auto batchSize : {1, 7, kRunLength}) {
+        auto rle = createRleDecoder<true>(
+            std::make_unique<dwio::common::SeekableArrayInputStream>(
+                bytes.data(), bytes.size(), blockSize),
+            RleVersion_2,
+            *pool,
+            true /* doesn't matter */,
+            dwio::common::INT_BYTE_SIZE /* doesn't matter */);
+        std::vector<int64_t> data(kRunLength);
+        for (auto i = 0; i < kRunLength; i += batchSize) {
+          rle->next(
+              data.data() + i, std::min(batchSize, kRunLength - i), nullptr);
+        }
+        checkResults(expected, data, batchSize);
+      }
+    }
+  }
+}
+
 TEST(RLEv1, simpleTest) {
   auto pool = memory::addDefaultLeafMemoryPool();
   const unsigned char buffer[] = {
@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
+#include <folly/futures/Future.h>
 #include <velox/dwio/common/exception/Exception.h>
 #include "velox/dwio/common/ChainedBuffer.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
@@ -35,7 +36,8 @@ namespace facebook::velox::dwrf {
 WriterContext::LocalDecodedVector BaseColumnWriter::decode(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
-  auto& selected = context_.getSharedSelectivityVector(slice->size());
+  auto localSelected = context_.getLocalSelectivityVector(slice->size());
+  auto& selected = localSelected.get();
   // initialize
   selected.clearAll();
   for (auto& range : ranges.getRanges()) {
@@ -804,6 +806,8 @@ class StringColumnWriter : public BaseColumnWriter {
             getConfig(Config::ENTROPY_STRING_DICT_SAMPLE_FRACTION),
             getConfig(Config::ENTROPY_STRING_THRESHOLD)},
         sort_{getConfig(Config::DICTIONARY_SORT_KEYS)},
+        dictionaryEvaluationRows_{
+            getConfig(Config::DICTIONARY_STRING_EVALUATION_ROWS)},
         useDictionaryEncoding_{useDictionaryEncoding()},
         strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)} {
     DWIO_ENSURE(firstStripe_);
@@ -816,6 +820,16 @@ class StringColumnWriter : public BaseColumnWriter {
   uint64_t write(const VectorPtr& slice, const common::Ranges& ranges) override;
 
   void reset() override {
+    // With per stripe evaluation, every stripe starts with dictionary encoding
+    // and falls back to direct encoding once the first rows of the stripe
+    // show that the dictionary does not pay off.
+    if (!firstStripe_ && !useDictionaryEncoding_ &&
+        dictionaryEvaluationRows_ > 0 && useDictionaryEncoding()) {
+      dataDirect_.reset();
+      dataDirectLength_.reset();
+      useDictionaryEncoding_ = true;
+    }
+    dictionaryEvaluated_ = false;
     // Lots of decisions regarding the presence of streams are made at flush
     // time. We would defer recording all stream positions till then, and
     // only record position for PRESENT stream upon construction.
@@ -869,6 +883,17 @@ class StringColumnWriter : public BaseColumnWriter {
       dictionaryDataLength_->flush();
       data_->flush();
     } else {
+      // Dictionary only streams are left over from an earlier stripe that
+      // used dictionary encoding.
+      for (auto kind :
+           {StreamKind::StreamKind_DICTIONARY_DATA,
+            StreamKind::StreamKind_IN_DICTIONARY,
+            StreamKind::StreamKind_STRIDE_DICTIONARY,
+            StreamKind::StreamKind_STRIDE_DICTIONARY_LENGTH}) {
+        if (hasStream(kind)) {
+          suppressStream(kind);
+        }
+      }
       dataDirect_->flush();
       dataDirectLength_->flush();
     }
@@ -895,11 +920,9 @@ class StringColumnWriter : public BaseColumnWriter {
     indexBuilder_->addEntry(*indexStatsBuilder_);
     indexStatsBuilder_->reset();
     BaseColumnWriter::recordPosition();
-    // TODO: the only way useDictionaryEncoding_ right now is
-    // through abandonDictionary, so we already have the stream initialization
-    // handled. Might want to rethink stream initialization in the future when
-    // we support starting with low memory mode and switching encoding after
-    // first stripe.
+    // The encoding only changes through tryAbandonDictionaries() within a
+    // stripe, which handles the stream initialization, or at stripe
+    // boundaries in reset().
     if (useDictionaryEncoding_) {
       // Record the stride boundaries so that we can backfill the stream
       // positions when actually writing the streams.
@@ -930,9 +953,10 @@ class StringColumnWriter : public BaseColumnWriter {
   }
 
   bool tryAbandonDictionaries(bool force) override {
-    // TODO: hopefully not required in the future, but need to solve the problem
-    // of replacing/deleting streams.
-    if (!useDictionaryEncoding_ || !firstStripe_) {
+    // Without per stripe evaluation, the encoding is decided in the first
+    // stripe and kept for the rest of the file.
+    if (!useDictionaryEncoding_ ||
+        (!firstStripe_ && dictionaryEvaluationRows_ == 0)) {
       return false;
     }
 
@@ -941,6 +965,14 @@ class StringColumnWriter : public BaseColumnWriter {
       return false;
     }
 
+    // Dictionary stream writers of an earlier stripe have nothing written in
+    // this stripe yet. DATA and LENGTH are reused by direct encoding.
+    data_.reset();
+    dictionaryData_.reset();
+    dictionaryDataLength_.reset();
+    inDictionary_.reset();
+    strideDictionaryData_.reset();
+    strideDictionaryDataLength_.reset();
     initStreamWriters(useDictionaryEncoding_);
     // Record direct encoding stream starting position.
     recordDirectEncodingStreamPositions(0);
@@ -985,31 +1017,31 @@ class StringColumnWriter : public BaseColumnWriter {
       if (dictEncoding) {
         data_ = createRleEncoder</* isSigned = */ false>(
             RleVersion_1,
-            newStream(StreamKind::StreamKind_DATA),
+            newOrReusedStream(StreamKind::StreamKind_DATA),
             getConfig(Config::USE_VINTS),
             sizeof(uint32_t));
         dictionaryData_ = std::make_unique<AppendOnlyBufferedStream>(
-            newStream(StreamKind::StreamKind_DICTIONARY_DATA));
+            newOrReusedStream(StreamKind::StreamKind_DICTIONARY_DATA));
         dictionaryDataLength_ = createRleEncoder</* isSigned = */ false>(
             RleVersion_1,
-            newStream(StreamKind::StreamKind_LENGTH),
+            newOrReusedStream(StreamKind::StreamKind_LENGTH),
             getConfig(Config::USE_VINTS),
             sizeof(uint32_t));
         inDictionary_ = createBooleanRleEncoder(
-            newStream(StreamKind::StreamKind_IN_DICTIONARY));
+            newOrReusedStream(StreamKind::StreamKind_IN_DICTIONARY));
         strideDictionaryData_ = std::make_unique<AppendOnlyBufferedStream>(
-            newStream(StreamKind::StreamKind_STRIDE_DICTIONARY));
+            newOrReusedStream(StreamKind::StreamKind_STRIDE_DICTIONARY));
         strideDictionaryDataLength_ = createRleEncoder</* isSigned = */ false>(
             RleVersion_1,
-            newStream(StreamKind::StreamKind_STRIDE_DICTIONARY_LENGTH),
+            newOrReusedStream(StreamKind::StreamKind_STRIDE_DICTIONARY_LENGTH),
             getConfig(Config::USE_VINTS),
             sizeof(uint32_t));
       } else {
         dataDirect_ = std::make_unique<AppendOnlyBufferedStream>(
-            newStream(StreamKind::StreamKind_DATA));
+            newOrReusedStream(StreamKind::StreamKind_DATA));
         dataDirectLength_ = createRleEncoder</* isSigned = */ false>(
             RleVersion_1,
-            newStream(StreamKind::StreamKind_LENGTH),
+            newOrReusedStream(StreamKind::StreamKind_LENGTH),
             getConfig(Config::USE_VINTS),
             sizeof(uint32_t));
       }
@@ -1078,11 +1110,16 @@ class StringColumnWriter : public BaseColumnWriter {
   size_t finalDictionarySize_;
   EntropyEncodingSelector encodingSelector_;
   const bool sort_;
+  // Number of rows after which each stripe re-evaluates dictionary encoding.
+  // 0 decides the encoding once in the first stripe.
+  const uint32_t dictionaryEvaluationRows_;
   // This value could change if we are writing with low memory mode or if we
   // determine with the first stripe that the data is not fit for dictionary
   // encoding.
   bool useDictionaryEncoding_;
   bool firstStripe_{true};
+  // Whether the encoding of the current stripe has been evaluated.
+  bool dictionaryEvaluated_{false};
   DataBuffer<size_t> strideOffsets_;
 };
 
@@ -1093,7 +1130,13 @@ uint64_t StringColumnWriter::write(
   auto& decodedVector = localDecoded.get();
 
   if (useDictionaryEncoding_) {
-    return writeDict(decodedVector, ranges);
+    const auto rawSize = writeDict(decodedVector, ranges);
+    if (dictionaryEvaluationRows_ > 0 && !dictionaryEvaluated_ &&
+        rows_.size() >= dictionaryEvaluationRows_) {
+      dictionaryEvaluated_ = true;
+      tryAbandonDictionaries(false);
+    }
+    return rawSize;
   } else {
     return writeDirect(decodedVector, ranges);
   }
@@ -1611,7 +1654,23 @@ uint64_t StructColumnWriter::writeChildrenAndStats(
     const common::Ranges& ranges,
     uint64_t nullCount) {
   uint64_t rawSize = 0;
-  if (ranges.size() > 0) {
+  auto* executor = context_.encodingExecutor();
+  if (ranges.size() > 0 && isRoot() && executor && children_.size() > 1) {
+    // The columns have their own streams and encoders, so the top level
+    // columns are encoded and compressed in parallel. The streams are laid out
+    // at flush in an order that does not depend on the order of the writes.
+    std::vector<folly::SemiFuture<uint64_t>> writes;
+    writes.reserve(children_.size());
+    for (size_t i = 0; i < children_.size(); ++i) {
+      writes.push_back(
+          folly::via(executor, [&, i]() {
+            return children_[i]->write(rowSlice->childAt(i), ranges);
+          }).semi());
+    }
+    for (auto& result : folly::collectAll(std::move(writes)).get()) {
+      rawSize += result.value();
+    }
+  } else if (ranges.size() > 0) {
     for (size_t i = 0; i < children_.size(); ++i) {
       rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
     }
@@ -225,6 +225,16 @@ class BaseColumnWriter : public ColumnWriter {
         DwrfStreamIdentifier{id_, sequence_, type_.column(), kind});
   }
 
+  std::unique_ptr<BufferedOutputStream> newOrReusedStream(StreamKind kind) {
+    return context_.newOrReusedStream(
+        DwrfStreamIdentifier{id_, sequence_, type_.column(), kind});
+  }
+
+  bool hasStream(StreamKind kind) const {
+    return context_.hasStream(
+        DwrfStreamIdentifier{id_, sequence_, type_.column(), kind});
+  }
+
   void suppressStream(StreamKind kind, uint32_t sequence) {
     context_.suppressStream(
         DwrfStreamIdentifier{id_, sequence, type_.column(), kind});
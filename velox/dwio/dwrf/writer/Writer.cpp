@@ -66,6 +66,7 @@ Writer::Writer(
   writerBase_->initContext(options.config, pool, std::move(handler));
   auto& context = writerBase_->getContext();
   context.buildPhysicalSizeAggregators(*schema_);
+  context.setEncodingExecutor(options.encodingExecutor);
   if (options.flushPolicyFactory == nullptr) {
     flushPolicy_ = std::make_unique<DefaultFlushPolicy>(
         context.stripeSizeFlushThreshold(),
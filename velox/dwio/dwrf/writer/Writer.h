@@ -48,6 +48,9 @@ struct WriterOptions {
       WriterContext& context,
       const velox::dwio::common::TypeWithId& type)>
       columnWriterFactory;
+  /// If set, the top level columns of each write are encoded in parallel on
+  /// this executor.
+  std::shared_ptr<folly::Executor> encodingExecutor;
 };
 
 class Writer : public dwio::common::Writer {
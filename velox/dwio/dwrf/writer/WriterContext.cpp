@@ -153,7 +153,8 @@ void WriterContext::abort() {
   dictEncoders_.clear();
   decodedVectorPool_.clear();
   decodedVectorPool_.shrink_to_fit();
-  selectivityVector_.reset();
+  selectivityVectorPool_.clear();
+  spareCompressionBuffers_.clear();
   releaseMemoryReservation();
 }
 } // namespace facebook::velox::dwrf
@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include <limits>
+#include <mutex>
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -71,6 +74,7 @@ class WriterContext : public CompressionBufferPool {
   // flush policy evaluation and would be more accurate after flush.
   std::unique_ptr<BufferedOutputStream> newStream(
       const DwrfStreamIdentifier& stream) {
+    std::lock_guard<std::mutex> l(streamsMutex_);
     VELOX_CHECK(
         !hasStream(stream), "Stream already exists: {}", stream.toString());
 
@@ -83,11 +87,32 @@ class WriterContext : public CompressionBufferPool {
             getConfig(Config::COMPRESSION_BLOCK_SIZE_MIN),
             getConfig(Config::COMPRESSION_BLOCK_SIZE_EXTEND_RATIO)));
     auto& holder = streams_.at(stream);
-    auto encrypter = handler_->isEncrypted(stream.encodingKey().node())
-        ? std::addressof(
-              handler_->getEncryptionProvider(stream.encodingKey().node()))
-        : nullptr;
-    return newStream(compression_, holder, encrypter);
+    return newStream(compression_, holder, getEncrypter(stream));
+  }
+
+  // Like newStream() but returns a new output stream on the buffers of
+  // 'stream' if it exists. Nothing must have been written to 'stream' in the
+  // current stripe. Used by columns that change their encoding at stripe
+  // boundaries and use a stream of an earlier stripe again.
+  std::unique_ptr<BufferedOutputStream> newOrReusedStream(
+      const DwrfStreamIdentifier& stream) {
+    DataBufferHolder* holder = nullptr;
+    {
+      std::lock_guard<std::mutex> l(streamsMutex_);
+      auto it = streams_.find(stream);
+      if (it != streams_.end()) {
+        VELOX_CHECK_EQ(
+            it->second.size(),
+            0,
+            "Stream is not empty: {}",
+            stream.toString());
+        holder = &it->second;
+      }
+    }
+    if (holder == nullptr) {
+      return newStream(stream);
+    }
+    return newStream(compression_, *holder, getEncrypter(stream));
   }
 
   std::unique_ptr<DataBufferHolder> newDataBufferHolder(
@@ -112,6 +137,7 @@ class WriterContext : public CompressionBufferPool {
       const EncodingKey& encodingKey,
       velox::memory::MemoryPool& dictionaryPool,
       velox::memory::MemoryPool& generalPool) {
+    std::lock_guard<std::mutex> l(dictEncodersMutex_);
     auto result = dictEncoders_.find(encodingKey);
     if (result == dictEncoders_.end()) {
       auto emplaceResult = dictEncoders_.emplace(
@@ -143,6 +169,7 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void suppressStream(const DwrfStreamIdentifier& stream) {
+    std::lock_guard<std::mutex> l(streamsMutex_);
     VELOX_CHECK(hasStream(stream));
     auto& collector = streams_.at(stream);
     collector.suppress();
@@ -245,18 +272,46 @@ class WriterContext : public CompressionBufferPool {
     }
   }
 
+  // Returns the compression buffer. Columns that are written in parallel get
+  // a spare buffer if another column is compressing.
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
       uint64_t size) override {
-    VELOX_CHECK_NOT_NULL(compressionBuffer_);
-    VELOX_CHECK_GE(compressionBuffer_->size(), size);
-    return std::move(compressionBuffer_);
+    std::lock_guard<std::mutex> l(scratchMutex_);
+    std::unique_ptr<dwio::common::DataBuffer<char>> buffer;
+    if (compressionBuffer_ != nullptr) {
+      buffer = std::move(compressionBuffer_);
+    } else if (!spareCompressionBuffers_.empty()) {
+      buffer = std::move(spareCompressionBuffers_.back());
+      spareCompressionBuffers_.pop_back();
+    } else {
+      VELOX_CHECK_NOT_NULL(
+          encodingExecutor_, "Compression buffer is already in use");
+      buffer = std::make_unique<dwio::common::DataBuffer<char>>(
+          *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
+    }
+    VELOX_CHECK_GE(buffer->size(), size);
+    return buffer;
   }
 
   void returnBuffer(
       std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
     VELOX_CHECK_NOT_NULL(buffer);
-    VELOX_CHECK_NULL(compressionBuffer_);
-    compressionBuffer_ = std::move(buffer);
+    std::lock_guard<std::mutex> l(scratchMutex_);
+    if (compressionBuffer_ == nullptr) {
+      compressionBuffer_ = std::move(buffer);
+    } else {
+      spareCompressionBuffers_.push_back(std::move(buffer));
+    }
+  }
+
+  /// Sets the executor on which the children of the root column are written
+  /// in parallel. nullptr writes them on the calling thread.
+  void setEncodingExecutor(std::shared_ptr<folly::Executor> executor) {
+    encodingExecutor_ = std::move(executor);
+  }
+
+  folly::Executor* encodingExecutor() const {
+    return encodingExecutor_.get();
   }
 
   void incrementNodeSize(uint32_t node, uint64_t size) {
@@ -557,13 +612,33 @@ class WriterContext : public CompressionBufferPool {
     return LocalDecodedVector{*this};
   }
 
-  SelectivityVector& getSharedSelectivityVector(velox::vector_size_t size) {
-    if (FOLLY_UNLIKELY(selectivityVector_ == nullptr)) {
-      selectivityVector_ = std::make_unique<velox::SelectivityVector>(size);
-    } else {
-      selectivityVector_->resize(size);
+  class LocalSelectivityVector {
+   public:
+    LocalSelectivityVector(WriterContext& context, velox::vector_size_t size)
+        : context_(context), vector_(context_.getSelectivityVector(size)) {}
+
+    LocalSelectivityVector(LocalSelectivityVector&& other) noexcept
+        : context_{other.context_}, vector_{std::move(other.vector_)} {}
+
+    LocalSelectivityVector& operator=(LocalSelectivityVector&& other) = delete;
+
+    ~LocalSelectivityVector() {
+      if (vector_) {
+        context_.releaseSelectivityVector(std::move(vector_));
+      }
+    }
+
+    SelectivityVector& get() {
+      return *vector_;
     }
-    return *selectivityVector_;
+
+   private:
+    WriterContext& context_;
+    std::unique_ptr<velox::SelectivityVector> vector_;
+  };
+
+  LocalSelectivityVector getLocalSelectivityVector(velox::vector_size_t size) {
+    return LocalSelectivityVector{*this, size};
   }
 
   void abort();
@@ -575,9 +650,18 @@ class WriterContext : public CompressionBufferPool {
  private:
   void validateConfigs() const;
 
+  const dwio::common::encryption::Encrypter* getEncrypter(
+      const DwrfStreamIdentifier& stream) const {
+    const auto node = stream.encodingKey().node();
+    return handler_->isEncrypted(node)
+        ? std::addressof(handler_->getEncryptionProvider(node))
+        : nullptr;
+  }
+
   void setMemoryReclaimers();
 
   std::unique_ptr<velox::DecodedVector> getDecodedVector() {
+    std::lock_guard<std::mutex> l(scratchMutex_);
     if (decodedVectorPool_.empty()) {
       return std::make_unique<velox::DecodedVector>();
     }
@@ -587,9 +671,33 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void releaseDecodedVector(std::unique_ptr<velox::DecodedVector>&& vector) {
+    std::lock_guard<std::mutex> l(scratchMutex_);
     decodedVectorPool_.push_back(std::move(vector));
   }
 
+  std::unique_ptr<velox::SelectivityVector> getSelectivityVector(
+      velox::vector_size_t size) {
+    std::unique_ptr<velox::SelectivityVector> vector;
+    {
+      std::lock_guard<std::mutex> l(scratchMutex_);
+      if (!selectivityVectorPool_.empty()) {
+        vector = std::move(selectivityVectorPool_.back());
+        selectivityVectorPool_.pop_back();
+      }
+    }
+    if (vector == nullptr) {
+      return std::make_unique<velox::SelectivityVector>(size);
+    }
+    vector->resize(size);
+    return vector;
+  }
+
+  void releaseSelectivityVector(
+      std::unique_ptr<velox::SelectivityVector>&& vector) {
+    std::lock_guard<std::mutex> l(scratchMutex_);
+    selectivityVectorPool_.push_back(std::move(vector));
+  }
+
   const std::shared_ptr<const Config> config_;
   const std::shared_ptr<memory::MemoryPool> pool_;
   const std::shared_ptr<memory::MemoryPool> dictionaryPool_;
@@ -625,10 +733,20 @@ class WriterContext : public CompressionBufferPool {
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
   std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  // Compression buffers of columns compressing in parallel.
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>>
+      spareCompressionBuffers_;
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
-  // Reusable SelectivityVector
-  std::unique_ptr<velox::SelectivityVector> selectivityVector_;
+  // A pool of reusable SelectivityVectors.
+  std::vector<std::unique_ptr<velox::SelectivityVector>>
+      selectivityVectorPool_;
+  std::shared_ptr<folly::Executor> encodingExecutor_;
+  // Serializes the creation of streams and dictionary encoders and the use of
+  // the scratch pools by columns written in parallel.
+  std::mutex streamsMutex_;
+  std::mutex dictEncodersMutex_;
+  std::mutex scratchMutex_;
 
   std::unique_ptr<encryption::EncryptionHandler> handler_;
   folly::F14FastMap<uint32_t, uint64_t> nodeSize_;
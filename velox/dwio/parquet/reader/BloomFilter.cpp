@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+#include "velox/common/base/Exceptions.h"
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+namespace facebook::velox::parquet {
+
+namespace {
+// The multipliers that select the bit in each word of a block.
+constexpr uint32_t kSalt[8] = {
+    0x47b6137bU,
+    0x44974d91U,
+    0x8824ad5bU,
+    0xa2b7289dU,
+    0x705495c7U,
+    0x2df1424bU,
+    0x9efc4947U,
+    0x5c6bfb31U};
+} // namespace
+
+SplitBlockBloomFilter::SplitBlockBloomFilter(const char* data, int32_t size) {
+  VELOX_CHECK(
+      size > 0 && size % kBytesPerBlock == 0,
+      "Invalid Bloom filter size: {}",
+      size);
+  words_.resize(size / sizeof(uint32_t));
+  memcpy(words_.data(), data, size);
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hash(const void* data, int32_t size) {
+  return XXH64(data, size, 0);
+}
+
+// static
+bool SplitBlockBloomFilter::canTest(const common::Filter& filter) {
+  if (filter.testNull()) {
+    return false;
+  }
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return static_cast<const common::BigintRange&>(filter).isSingleValue();
+    case common::FilterKind::kBytesRange:
+      return static_cast<const common::BytesRange&>(filter).isSingleValue();
+    case common::FilterKind::kBigintValuesUsingHashTable:
+    case common::FilterKind::kBytesValues:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void SplitBlockBloomFilter::insert(uint64_t hash) {
+  const uint64_t numBlocks = words_.size() / kWordsPerBlock;
+  auto* block = &words_[((hash >> 32) * numBlocks >> 32) * kWordsPerBlock];
+  const auto key = static_cast<uint32_t>(hash);
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    block[i] |= 1U << ((key * kSalt[i]) >> 27);
+  }
+}
+
+bool SplitBlockBloomFilter::mayContain(uint64_t hash) const {
+  const uint64_t numBlocks = words_.size() / kWordsPerBlock;
+  const auto* block =
+      &words_[((hash >> 32) * numBlocks >> 32) * kWordsPerBlock];
+  const auto key = static_cast<uint32_t>(hash);
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    if ((block[i] & (1U << ((key * kSalt[i]) >> 27))) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SplitBlockBloomFilter::mayContainInteger(
+    int64_t value,
+    thrift::Type::type parquetType) const {
+  switch (parquetType) {
+    case thrift::Type::INT32: {
+      // A value out of range may be an unsigned 32 bit value, which is not
+      // hashed as its 64 bit value.
+      if (value < std::numeric_limits<int32_t>::min() ||
+          value > std::numeric_limits<int32_t>::max()) {
+        return true;
+      }
+      const int32_t narrow = value;
+      return mayContain(hash(&narrow, sizeof(narrow)));
+    }
+    case thrift::Type::INT64:
+      return mayContain(hash(&value, sizeof(value)));
+    default:
+      return true;
+  }
+}
+
+bool SplitBlockBloomFilter::mayMatch(
+    const common::Filter& filter,
+    thrift::Type::type parquetType) const {
+  if (!canTest(filter)) {
+    return true;
+  }
+  const bool isBinary = parquetType == thrift::Type::BYTE_ARRAY ||
+      parquetType == thrift::Type::FIXED_LEN_BYTE_ARRAY;
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return mayContainInteger(
+          static_cast<const common::BigintRange&>(filter).lower(),
+          parquetType);
+    case common::FilterKind::kBigintValuesUsingHashTable: {
+      auto& values =
+          static_cast<const common::BigintValuesUsingHashTable&>(filter)
+              .values();
+      return std::any_of(values.begin(), values.end(), [&](int64_t value) {
+        return mayContainInteger(value, parquetType);
+      });
+    }
+    case common::FilterKind::kBytesRange: {
+      auto& value = static_cast<const common::BytesRange&>(filter).lower();
+      return !isBinary || mayContain(hash(value.data(), value.size()));
+    }
+    case common::FilterKind::kBytesValues: {
+      if (!isBinary) {
+        return true;
+      }
+      auto& values = static_cast<const common::BytesValues&>(filter).values();
+      return std::any_of(
+          values.begin(), values.end(), [&](const std::string& value) {
+            return mayContain(hash(value.data(), value.size()));
+          });
+    }
+    default:
+      return true;
+  }
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Filter.h"
+
+#include <vector>
+
+namespace facebook::velox::parquet {
+
+/// The split block Bloom filter of a Parquet column chunk. The bitset is a
+/// sequence of 32 byte blocks of 8 words. A value sets one bit in each word of
+/// the block selected by the upper half of the xxHash64 of its PLAIN encoding.
+class SplitBlockBloomFilter {
+ public:
+  static constexpr int32_t kBytesPerBlock = 32;
+
+  /// Largest bitset accepted from a file.
+  static constexpr int32_t kMaxBytes = 128 << 20;
+
+  /// Makes a filter with the bitset of 'size' bytes at 'data'. 'size' is a
+  /// multiple of kBytesPerBlock.
+  SplitBlockBloomFilter(const char* FOLLY_NONNULL data, int32_t size);
+
+  /// Returns the hash of the 'size' bytes of the PLAIN encoding of a value at
+  /// 'data'. For a BYTE_ARRAY this is the bytes without the length.
+  static uint64_t hash(const void* FOLLY_NONNULL data, int32_t size);
+
+  /// True if 'filter' can be tested against a Bloom filter, i.e. it accepts a
+  /// few values and no nulls.
+  static bool canTest(const common::Filter& filter);
+
+  void insert(uint64_t hash);
+
+  /// Returns false if no value with 'hash' was inserted.
+  bool mayContain(uint64_t hash) const;
+
+  /// Returns false if no value that passes 'filter' was inserted into the
+  /// filter of a column of 'parquetType'. Returns true if canTest() is false.
+  bool mayMatch(const common::Filter& filter, thrift::Type::type parquetType)
+      const;
+
+  /// Size of the bitset in bytes.
+  int64_t size() const {
+    return words_.size() * sizeof(uint32_t);
+  }
+
+ private:
+  static constexpr int32_t kWordsPerBlock = 8;
+
+  bool mayContainInteger(int64_t value, thrift::Type::type parquetType) const;
+
+  // Bitset as 32 bit words in the byte order of the file.
+  std::vector<uint32_t> words_;
+};
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/BitPackDecoder.h"
+
+#include <type_traits>
+#include <vector>
+
+namespace facebook::velox::parquet {
+
+/// Decoder for the DELTA_BINARY_PACKED encoding of INT32 and INT64 values. The
+/// stream is a header with the block size, the number of miniblocks per block,
+/// the number of values and the first value, followed by blocks of a minimum
+/// delta and bit packed miniblocks of the deltas minus the minimum delta.
+class DeltaBpDecoder {
+ public:
+  DeltaBpDecoder(const char* FOLLY_NONNULL start, const char* FOLLY_NONNULL end)
+      : bufferStart_(start), bufferEnd_(end) {
+    const auto blockSize = readVarint();
+    const auto numMiniblocks = readVarint();
+    numValues_ = readVarint();
+    firstValue_ = readZigZag();
+    VELOX_CHECK(
+        blockSize > 0 && blockSize % 128 == 0 && blockSize <= kMaxBlockSize,
+        "Invalid DELTA_BINARY_PACKED block size: {}",
+        blockSize);
+    VELOX_CHECK(
+        numMiniblocks > 0 && blockSize % numMiniblocks == 0,
+        "Invalid DELTA_BINARY_PACKED miniblock count: {}",
+        numMiniblocks);
+    blockSize_ = blockSize;
+    numMiniblocks_ = numMiniblocks;
+    valuesPerMiniblock_ = blockSize_ / numMiniblocks_;
+    VELOX_CHECK_EQ(
+        valuesPerMiniblock_ % 32,
+        0,
+        "Invalid DELTA_BINARY_PACKED miniblock size");
+    deltas_.resize(valuesPerMiniblock_);
+  }
+
+  /// Number of values in the stream.
+  int64_t numValues() const {
+    return numValues_;
+  }
+
+  /// Decodes all the values of the stream into 'values', which must have space
+  /// for numValues() elements. T is int32_t or int64_t.
+  template <typename T>
+  void readAll(T* FOLLY_NONNULL values) {
+    static_assert(std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>);
+    if (numValues_ == 0) {
+      return;
+    }
+    // The writer computes the deltas with wrap around.
+    using U = std::make_unsigned_t<T>;
+    U last = static_cast<U>(firstValue_);
+    values[0] = last;
+    int64_t numRead = 1;
+    while (numRead < numValues_) {
+      const U minDelta = static_cast<U>(readZigZag());
+      VELOX_CHECK_LE(
+          numMiniblocks_,
+          bufferEnd_ - bufferStart_,
+          "DELTA_BINARY_PACKED block is truncated");
+      const auto* bitWidths = reinterpret_cast<const uint8_t*>(bufferStart_);
+      bufferStart_ += numMiniblocks_;
+      // The bit widths of the miniblocks after the last value are present but
+      // their miniblocks are not.
+      for (auto i = 0; i < numMiniblocks_ && numRead < numValues_; ++i) {
+        const int32_t numDeltas =
+            std::min<int64_t>(valuesPerMiniblock_, numValues_ - numRead);
+        unpackMiniblock(bitWidths[i], numDeltas);
+        auto* output = values + numRead;
+        for (auto j = 0; j < numDeltas; ++j) {
+          last += minDelta + static_cast<U>(deltas_[j]);
+          output[j] = last;
+        }
+        numRead += numDeltas;
+      }
+    }
+  }
+
+  /// Returns the first byte after the stream. Valid after readAll().
+  const char* FOLLY_NONNULL end() const {
+    return bufferStart_;
+  }
+
+ private:
+  uint64_t readVarint() {
+    uint64_t value = 0;
+    for (auto shift = 0; shift < 64; shift += 7) {
+      VELOX_CHECK_LT(
+          bufferStart_, bufferEnd_, "DELTA_BINARY_PACKED data is truncated");
+      const uint8_t byte = *bufferStart_++;
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    VELOX_FAIL("Invalid varint in DELTA_BINARY_PACKED data");
+  }
+
+  int64_t readZigZag() {
+    const auto value = readVarint();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  }
+
+  // Unpacks the first 'numDeltas' deltas of the next miniblock into 'deltas_'
+  // and moves past the miniblock.
+  void unpackMiniblock(uint8_t bitWidth, int32_t numDeltas) {
+    VELOX_CHECK_LE(bitWidth, 64, "Invalid DELTA_BINARY_PACKED bit width");
+    // Writers may leave out the padding of the last miniblock.
+    const auto numBytes = std::min<int64_t>(
+        valuesPerMiniblock_ * bitWidth / 8, bufferEnd_ - bufferStart_);
+    if (bitWidth == 0) {
+      std::fill(deltas_.begin(), deltas_.begin() + numDeltas, 0);
+      return;
+    }
+    const auto numUnpacked = bits::roundUp(numDeltas, 8);
+    VELOX_CHECK_LE(
+        numUnpacked * bitWidth / 8,
+        numBytes,
+        "DELTA_BINARY_PACKED miniblock is truncated");
+    const auto* input = reinterpret_cast<const uint8_t*>(bufferStart_);
+    bufferStart_ += numBytes;
+    if (bitWidth <= 32) {
+      narrowDeltas_.resize(valuesPerMiniblock_);
+      auto* output = narrowDeltas_.data();
+      dwio::common::unpack<uint32_t>(
+          input, numBytes, numUnpacked, bitWidth, output);
+      std::copy(
+          narrowDeltas_.begin(),
+          narrowDeltas_.begin() + numDeltas,
+          deltas_.begin());
+      return;
+    }
+    auto* output = deltas_.data();
+    dwio::common::unpack<uint64_t>(
+        input, numBytes, numUnpacked, bitWidth, output);
+  }
+
+  static constexpr uint64_t kMaxBlockSize = 1 << 20;
+
+  const char* FOLLY_NONNULL bufferStart_;
+  const char* FOLLY_NONNULL const bufferEnd_;
+  int32_t blockSize_;
+  int32_t numMiniblocks_;
+  int32_t valuesPerMiniblock_;
+  int64_t numValues_;
+  int64_t firstValue_;
+  // Deltas minus the minimum delta for the current miniblock.
+  std::vector<uint64_t> deltas_;
+  // Output of unpacking miniblocks of up to 32 bit deltas.
+  std::vector<uint32_t> narrowDeltas_;
+};
+
+} // namespace facebook::velox::parquet
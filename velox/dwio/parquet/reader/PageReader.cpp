@@ -15,9 +15,11 @@
  */
 
 #include "velox/dwio/parquet/reader/PageReader.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/common/compression/LzoDecompressor.h"
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/ColumnVisitors.h"
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
 #include "velox/dwio/parquet/reader/NestedStructureDecoder.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 #include "velox/vector/FlatVector.h"
@@ -603,6 +605,30 @@ int32_t parquetTypeBytes(thrift::Type::type type) {
 }
 } // namespace
 
+namespace {
+// Returns true if all of the 'numLevels' levels at 'levels' are at least
+// 'minLevel'.
+bool allLevelsAtLeast(
+    const int16_t* levels,
+    int32_t numLevels,
+    int16_t minLevel) {
+  using Batch = xsimd::batch<int16_t>;
+  const auto threshold = Batch::broadcast(minLevel);
+  int32_t i = 0;
+  for (; i + Batch::size <= numLevels; i += Batch::size) {
+    if (simd::toBitMask(Batch::load_unaligned(levels + i) < threshold)) {
+      return false;
+    }
+  }
+  for (; i < numLevels; ++i) {
+    if (levels[i] < minLevel) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 void PageReader::preloadRepDefs() {
   hasChunkRepDefs_ = true;
   while (pageStart_ < chunkSize_) {
@@ -682,12 +708,41 @@ int32_t PageReader::getLengthsAndNulls(
   bits.valid_bits = reinterpret_cast<uint8_t*>(nulls);
   bits.valid_bits_offset = nullsStartIndex;
 
+  // When every level is defined down to the level of 'info' there are no
+  // nulls, no empty collections and no levels under null or empty ancestors.
+  // The lengths then only depend on the repetition levels.
+  const bool allDefined = mode != LevelMode::kStructOverLists &&
+      allLevelsAtLeast(
+          definitionLevels_.data() + begin, end - begin, info.def_level);
   switch (mode) {
     case LevelMode::kNulls:
+      if (allDefined) {
+        bits::fillBits(
+            nulls, nullsStartIndex, nullsStartIndex + end - begin, true);
+        return end - begin;
+      }
       DefLevelsToBitmap(
           definitionLevels_.data() + begin, end - begin, info, &bits);
       break;
     case LevelMode::kList: {
+      if (allDefined &&
+          (begin == end || repetitionLevels_[begin] < info.rep_level)) {
+        // A level below the repetition level of 'info' starts a collection.
+        // A level at most the repetition level of 'info' starts an element
+        // of the current collection.
+        int32_t numLists = 0;
+        for (auto i = begin; i < end; ++i) {
+          const auto repetitionLevel = repetitionLevels_[i];
+          if (repetitionLevel < info.rep_level) {
+            lengths[numLists++] = 0;
+          }
+          lengths[numLists - 1] += repetitionLevel <= info.rep_level;
+        }
+        VELOX_CHECK_LE(numLists, maxItems);
+        bits::fillBits(
+            nulls, nullsStartIndex, nullsStartIndex + numLists, true);
+        return numLists;
+      }
       ::parquet::internal::DefRepLevelsToList(
           definitionLevels_.data() + begin,
           repetitionLevels_.data() + begin,
@@ -723,38 +778,191 @@ void PageReader::makeDecoder() {
           pageData_ + 1, pageData_ + encodedDataSize_, pageData_[0]);
       break;
     case Encoding::PLAIN:
-      switch (parquetType) {
-        case thrift::Type::BOOLEAN:
-          booleanDecoder_ = std::make_unique<BooleanDecoder>(
-              pageData_, pageData_ + encodedDataSize_);
-          break;
-        case thrift::Type::BYTE_ARRAY:
-          stringDecoder_ = std::make_unique<StringDecoder>(
-              pageData_, pageData_ + encodedDataSize_);
-          break;
-        case thrift::Type::FIXED_LEN_BYTE_ARRAY:
-          directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
-              std::make_unique<dwio::common::SeekableArrayInputStream>(
-                  pageData_, encodedDataSize_),
-              false,
-              type_->typeLength_,
-              true);
-          break;
-        default: {
-          directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
-              std::make_unique<dwio::common::SeekableArrayInputStream>(
-                  pageData_, encodedDataSize_),
-              false,
-              parquetTypeBytes(type_->parquetType_.value()));
-        }
-      }
+      makePlainDecoder(pageData_, encodedDataSize_);
       break;
     case Encoding::DELTA_BINARY_PACKED:
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+    case Encoding::DELTA_BYTE_ARRAY:
+    case Encoding::BYTE_STREAM_SPLIT: {
+      // The page is converted to PLAIN so that the filters and fast paths of
+      // the PLAIN decoders apply.
+      const auto size = decodeToPlain(parquetType);
+      makePlainDecoder(decodedValues_->as<char>(), size);
+      break;
+    }
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
 }
 
+void PageReader::makePlainDecoder(const char* data, int32_t size) {
+  switch (type_->parquetType_.value()) {
+    case thrift::Type::BOOLEAN:
+      booleanDecoder_ = std::make_unique<BooleanDecoder>(data, data + size);
+      break;
+    case thrift::Type::BYTE_ARRAY:
+      stringDecoder_ = std::make_unique<StringDecoder>(data, data + size);
+      break;
+    case thrift::Type::FIXED_LEN_BYTE_ARRAY:
+      directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+          std::make_unique<dwio::common::SeekableArrayInputStream>(data, size),
+          false,
+          type_->typeLength_,
+          true);
+      break;
+    default: {
+      directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+          std::make_unique<dwio::common::SeekableArrayInputStream>(data, size),
+          false,
+          parquetTypeBytes(type_->parquetType_.value()));
+    }
+  }
+}
+
+namespace {
+// Interleaves 'numStreams' streams of 'numValues' bytes each into values of
+// 'numStreams' bytes.
+template <int32_t numStreams>
+void mergeByteStreams(const char* input, int32_t numValues, char* output) {
+  for (auto i = 0; i < numValues; ++i) {
+    for (auto stream = 0; stream < numStreams; ++stream) {
+      output[i * numStreams + stream] = input[stream * numValues + i];
+    }
+  }
+}
+
+void mergeByteStreams(
+    const char* input,
+    int32_t numValues,
+    int32_t numStreams,
+    char* output) {
+  switch (numStreams) {
+    case 4:
+      mergeByteStreams<4>(input, numValues, output);
+      break;
+    case 8:
+      mergeByteStreams<8>(input, numValues, output);
+      break;
+    default:
+      for (auto stream = 0; stream < numStreams; ++stream) {
+        for (auto i = 0; i < numValues; ++i) {
+          output[i * numStreams + stream] = input[stream * numValues + i];
+        }
+      }
+  }
+}
+
+// Returns the lengths in the DELTA_BINARY_PACKED stream at 'data' and sets
+// 'data' to the first byte after the stream.
+std::vector<int32_t> readLengths(const char*& data, const char* end) {
+  DeltaBpDecoder decoder(data, end);
+  std::vector<int32_t> lengths(decoder.numValues());
+  decoder.readAll(lengths.data());
+  data = decoder.end();
+  return lengths;
+}
+} // namespace
+
+int32_t PageReader::decodeToPlain(thrift::Type::type parquetType) {
+  const char* end = pageData_ + encodedDataSize_;
+  switch (encoding_) {
+    case Encoding::DELTA_BINARY_PACKED: {
+      DeltaBpDecoder decoder(pageData_, end);
+      const auto numValues = decoder.numValues();
+      if (parquetType == thrift::Type::INT32) {
+        dwio::common::ensureCapacity<int32_t>(
+            decodedValues_, numValues, &pool_);
+        decoder.readAll(decodedValues_->asMutable<int32_t>());
+        return numValues * sizeof(int32_t);
+      }
+      VELOX_CHECK(
+          parquetType == thrift::Type::INT64,
+          "DELTA_BINARY_PACKED is only for INT32 and INT64");
+      dwio::common::ensureCapacity<int64_t>(decodedValues_, numValues, &pool_);
+      decoder.readAll(decodedValues_->asMutable<int64_t>());
+      return numValues * sizeof(int64_t);
+    }
+    case Encoding::BYTE_STREAM_SPLIT: {
+      VELOX_CHECK(
+          parquetType != thrift::Type::BOOLEAN &&
+              parquetType != thrift::Type::BYTE_ARRAY,
+          "BYTE_STREAM_SPLIT is only for fixed width types");
+      const int32_t width = parquetType == thrift::Type::FIXED_LEN_BYTE_ARRAY
+          ? type_->typeLength_
+          : parquetTypeBytes(parquetType);
+      VELOX_CHECK_EQ(
+          encodedDataSize_ % width, 0, "Invalid BYTE_STREAM_SPLIT page size");
+      dwio::common::ensureCapacity<char>(
+          decodedValues_, encodedDataSize_, &pool_);
+      mergeByteStreams(
+          pageData_,
+          encodedDataSize_ / width,
+          width,
+          decodedValues_->asMutable<char>());
+      return encodedDataSize_;
+    }
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+    case Encoding::DELTA_BYTE_ARRAY: {
+      const bool isDelta = encoding_ == Encoding::DELTA_BYTE_ARRAY;
+      // FIXED_LEN_BYTE_ARRAY values in PLAIN have no lengths.
+      const bool hasLengths = parquetType == thrift::Type::BYTE_ARRAY;
+      VELOX_CHECK(
+          hasLengths || (isDelta && type_->typeLength_ > 0),
+          "{} is not supported for Parquet type {}",
+          encoding_,
+          parquetType);
+      const char* data = pageData_;
+      std::vector<int32_t> prefixLengths;
+      if (isDelta) {
+        prefixLengths = readLengths(data, end);
+      }
+      const auto suffixLengths = readLengths(data, end);
+      const int32_t numValues = suffixLengths.size();
+      VELOX_CHECK(
+          !isDelta || prefixLengths.size() == numValues,
+          "Mismatched prefix and suffix counts in DELTA_BYTE_ARRAY");
+      int64_t size = hasLengths ? numValues * sizeof(int32_t) : 0;
+      int64_t suffixSize = 0;
+      for (auto i = 0; i < numValues; ++i) {
+        VELOX_CHECK_GE(suffixLengths[i], 0);
+        suffixSize += suffixLengths[i];
+        size += suffixLengths[i] + (isDelta ? prefixLengths[i] : 0);
+      }
+      VELOX_CHECK_LE(suffixSize, end - data, "{} page is truncated", encoding_);
+      VELOX_CHECK_LE(size, std::numeric_limits<int32_t>::max());
+      dwio::common::ensureCapacity<char>(
+          decodedValues_, size + simd::kPadding, &pool_);
+      auto* output = decodedValues_->asMutable<char>();
+      const char* previous = nullptr;
+      int32_t previousLength = 0;
+      for (auto i = 0; i < numValues; ++i) {
+        const int32_t prefixLength = isDelta ? prefixLengths[i] : 0;
+        VELOX_CHECK(
+            prefixLength >= 0 && prefixLength <= previousLength,
+            "Invalid DELTA_BYTE_ARRAY prefix length");
+        const int32_t length = prefixLength + suffixLengths[i];
+        if (hasLengths) {
+          memcpy(output, &length, sizeof(int32_t));
+          output += sizeof(int32_t);
+        } else {
+          VELOX_CHECK_EQ(length, type_->typeLength_);
+        }
+        if (prefixLength > 0) {
+          memcpy(output, previous, prefixLength);
+        }
+        memcpy(output + prefixLength, data, suffixLengths[i]);
+        data += suffixLengths[i];
+        previous = output;
+        previousLength = length;
+        output += length;
+      }
+      return size;
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
 void PageReader::skip(int64_t numRows) {
   if (!numRows && firstUnvisited_ != rowOfPage_ + numRowsInPage_) {
     // Return if no skip and position not at end of page or before first page.
@@ -227,6 +227,14 @@ class PageReader {
   void prepareDictionary(const thrift::PageHeader& pageHeader);
   void makeDecoder();
 
+  // Makes the decoder of PLAIN values for the 'size' bytes at 'data'.
+  void makePlainDecoder(const char* FOLLY_NONNULL data, int32_t size);
+
+  // Converts the values of the current page from a DELTA_BINARY_PACKED,
+  // DELTA_LENGTH_BYTE_ARRAY, DELTA_BYTE_ARRAY or BYTE_STREAM_SPLIT encoding to
+  // PLAIN in 'decodedValues_'. Returns the size of the PLAIN values.
+  int32_t decodeToPlain(thrift::Type::type parquetType);
+
   // For a non-top level leaf, reads the defs and sets 'leafNulls_' and
   // 'numRowsInPage_' accordingly. This is used for non-top level leaves when
   // 'hasChunkRepDefs_' is false.
@@ -449,6 +457,10 @@ class PageReader {
   // decompressed data for the page. Rep-def-data in V1, data alone in V2.
   BufferPtr decompressedData_;
 
+  // Values of the page in PLAIN encoding if the page has an encoding without
+  // its own decoder. See decodeToPlain().
+  BufferPtr decodedValues_;
+
   // First byte of decompressed encoded data. Contains the encoded data as a
   // contiguous run of bytes.
   const char* FOLLY_NULLABLE pageData_{nullptr};
@@ -16,11 +16,58 @@
 
 #include "velox/dwio/parquet/reader/ParquetData.h"
 #include "velox/dwio/parquet/reader/Statistics.h"
+#include "velox/dwio/parquet/reader/TimestampColumnReader.h"
 
 namespace facebook::velox::parquet {
 
 using thrift::RowGroup;
 
+namespace {
+// Returns the file offset of the first page of the column chunk of 'metaData'.
+uint64_t chunkReadOffset(const thrift::ColumnMetaData& metaData) {
+  uint64_t chunkReadOffset = metaData.data_page_offset;
+  if (metaData.__isset.dictionary_page_offset &&
+      metaData.dictionary_page_offset >= 4) {
+    // this assumes the data pages follow the dict pages directly.
+    chunkReadOffset = metaData.dictionary_page_offset;
+  }
+  VELOX_CHECK_GE(chunkReadOffset, 0);
+  return chunkReadOffset;
+}
+
+template <typename T>
+T readThrift(const char* data, int32_t size) {
+  std::shared_ptr<thrift::ThriftTransport> transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(data, size);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  T result;
+  result.read(&protocol);
+  return result;
+}
+} // namespace
+
+std::vector<RowRange> intersectRowRanges(
+    const std::vector<RowRange>& left,
+    const std::vector<RowRange>& right) {
+  std::vector<RowRange> result;
+  auto i = 0;
+  auto j = 0;
+  while (i < left.size() && j < right.size()) {
+    const auto begin = std::max(left[i].begin, right[j].begin);
+    const auto end = std::min(left[i].end, right[j].end);
+    if (begin < end) {
+      result.push_back({begin, end});
+    }
+    if (left[i].end < right[j].end) {
+      ++i;
+    } else {
+      ++j;
+    }
+  }
+  return result;
+}
+
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
     const common::ScanSpec& /*scanSpec*/) {
@@ -30,7 +77,7 @@ std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
 void ParquetData::filterRowGroups(
     const common::ScanSpec& scanSpec,
     uint64_t /*rowsPerRowGroup*/,
-    const dwio::common::StatsContext& /*writerContext*/,
+    const dwio::common::StatsContext& writerContext,
     FilterRowGroupsResult& result) {
   result.totalCount = std::max<int>(result.totalCount, rowGroups_.size());
   auto nwords = bits::nwords(result.totalCount);
@@ -43,7 +90,9 @@ void ParquetData::filterRowGroups(
         scanSpec.metadataFilterNodeAt(i), std::vector<uint64_t>(nwords));
   }
   for (auto i = 0; i < rowGroups_.size(); ++i) {
-    if (scanSpec.filter() && !rowGroupMatches(i, scanSpec.filter())) {
+    if (scanSpec.filter() &&
+        (!rowGroupMatches(i, scanSpec.filter()) ||
+         !bloomFilterMatches(i, *scanSpec.filter(), writerContext))) {
       bits::setBit(result.filterResult.data(), i);
       continue;
     }
@@ -73,15 +122,57 @@ bool ParquetData::rowGroupMatches(
 
   if (rowGroup.columns[column].__isset.meta_data &&
       rowGroup.columns[column].meta_data.__isset.statistics) {
-    auto columnStats = buildColumnStatisticsFromThrift(
-        rowGroup.columns[column].meta_data.statistics,
-        *type,
-        rowGroup.num_rows);
+    const auto& statistics = rowGroup.columns[column].meta_data.statistics;
+    std::unique_ptr<common::Filter> unitFilter;
+    if (type->kind() == TypeKind::TIMESTAMP) {
+      // The statistics are the INT64 values in the file unit. Translate the
+      // filter to that unit.
+      unitFilter =
+          toTimestampUnitFilter(*filter, type_->timestampNanosPerUnit());
+      if (!unitFilter) {
+        return true;
+      }
+      filter = unitFilter.get();
+      type = BIGINT();
+    } else if (type->isShortDecimal()) {
+      // Short decimal filters are on the unscaled values, which is what the
+      // statistics of INT32 and INT64 decimals hold.
+      if (type_->parquetType_ == thrift::Type::INT32) {
+        type = INTEGER();
+      } else if (type_->parquetType_ == thrift::Type::INT64) {
+        type = BIGINT();
+      } else {
+        return true;
+      }
+    }
+    auto columnStats =
+        buildColumnStatisticsFromThrift(statistics, *type, rowGroup.num_rows);
     return testFilter(filter, columnStats.get(), rowGroup.num_rows, type);
   }
   return true;
 }
 
+bool ParquetData::bloomFilterMatches(
+    uint32_t rowGroupId,
+    const common::Filter& filter,
+    const dwio::common::StatsContext& context) {
+  auto* parquetContext = dynamic_cast<const ParquetStatsContext*>(&context);
+  if (!parquetContext || !parquetContext->bloomFilterReader ||
+      !type_->parquetType_.has_value() ||
+      !SplitBlockBloomFilter::canTest(filter)) {
+    return true;
+  }
+  auto& chunk = rowGroups_[rowGroupId].columns[type_->column()];
+  if (!chunk.__isset.meta_data ||
+      !chunk.meta_data.__isset.bloom_filter_offset) {
+    return true;
+  }
+  auto bloomFilter =
+      parquetContext->bloomFilterReader(rowGroupId, type_->column());
+  return !bloomFilter ||
+      bloomFilter->mayMatch(filter, type_->parquetType_.value());
+}
+
 void ParquetData::enqueueRowGroup(
     uint32_t index,
     dwio::common::BufferedInput& input) {
@@ -93,20 +184,16 @@ void ParquetData::enqueueRowGroup(
       type_->column());
   auto& metaData = chunk.meta_data;
 
-  uint64_t chunkReadOffset = metaData.data_page_offset;
-  if (metaData.__isset.dictionary_page_offset &&
-      metaData.dictionary_page_offset >= 4) {
-    // this assumes the data pages follow the dict pages directly.
-    chunkReadOffset = metaData.dictionary_page_offset;
-  }
-  VELOX_CHECK_GE(chunkReadOffset, 0);
-
   uint64_t readSize = (metaData.codec == thrift::CompressionCodec::UNCOMPRESSED)
       ? metaData.total_uncompressed_size
       : metaData.total_compressed_size;
+  auto it = chunkReadSizes_.find(index);
+  if (it != chunkReadSizes_.end()) {
+    readSize = std::min<uint64_t>(readSize, it->second);
+  }
 
   auto id = dwio::common::StreamIdentifier(type_->column());
-  streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
+  streams_[index] = input.enqueue({chunkReadOffset(metaData), readSize}, &id);
 }
 
 dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
@@ -114,12 +201,15 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
   VELOX_CHECK_LT(index, streams_.size());
   VELOX_CHECK(streams_[index], "Stream not enqueued for column");
   auto& metadata = rowGroups_[index].columns[type_->column()].meta_data;
+  int64_t chunkSize = metadata.total_compressed_size;
+  auto it = chunkReadSizes_.find(index);
+  if (it != chunkReadSizes_.end()) {
+    // The page reader sees the end of the chunk after the last fetched page.
+    chunkSize = std::min(chunkSize, it->second);
+    chunkReadSizes_.erase(it);
+  }
   reader_ = std::make_unique<PageReader>(
-      std::move(streams_[index]),
-      pool_,
-      type_,
-      metadata.codec,
-      metadata.total_compressed_size);
+      std::move(streams_[index]), pool_, type_, metadata.codec, chunkSize);
   return dwio::common::PositionProvider(empty);
 }
 
@@ -141,4 +231,108 @@ std::pair<int64_t, int64_t> ParquetData::getRowGroupRegion(
   return {fileOffset, length};
 }
 
+std::pair<int64_t, int64_t> ParquetData::getPageIndexRegion(
+    uint32_t index,
+    bool withColumnIndex) const {
+  auto& chunk = rowGroups_[index].columns[type_->column()];
+  if (!chunk.__isset.offset_index_offset || chunk.offset_index_length <= 0) {
+    return {0, 0};
+  }
+  auto begin = chunk.offset_index_offset;
+  auto end = begin + chunk.offset_index_length;
+  if (withColumnIndex && chunk.__isset.column_index_offset &&
+      chunk.column_index_length > 0) {
+    begin = std::min(begin, chunk.column_index_offset);
+    end = std::max(end, chunk.column_index_offset + chunk.column_index_length);
+  }
+  return {begin, end - begin};
+}
+
+PageIndex ParquetData::readPageIndex(
+    uint32_t index,
+    bool withColumnIndex,
+    const char* region,
+    int64_t regionOffset) const {
+  auto& chunk = rowGroups_[index].columns[type_->column()];
+  PageIndex pageIndex;
+  pageIndex.offsetIndex = readThrift<thrift::OffsetIndex>(
+      region + chunk.offset_index_offset - regionOffset,
+      chunk.offset_index_length);
+  if (withColumnIndex && chunk.__isset.column_index_offset &&
+      chunk.column_index_length > 0) {
+    pageIndex.columnIndex = readThrift<thrift::ColumnIndex>(
+        region + chunk.column_index_offset - regionOffset,
+        chunk.column_index_length);
+  }
+  return pageIndex;
+}
+
+std::vector<RowRange> ParquetData::filterPages(
+    uint32_t index,
+    const PageIndex& pageIndex,
+    common::Filter* filter) const {
+  const int64_t numRows = rowGroups_[index].num_rows;
+  if (!pageIndex.columnIndex.has_value()) {
+    return {{0, numRows}};
+  }
+  auto& pages = pageIndex.offsetIndex.page_locations;
+  auto& columnIndex = pageIndex.columnIndex.value();
+  VELOX_CHECK_EQ(
+      columnIndex.null_pages.size(),
+      pages.size(),
+      "ColumnIndex and OffsetIndex have different numbers of pages");
+  std::vector<RowRange> ranges;
+  for (auto i = 0; i < pages.size(); ++i) {
+    const auto begin = pages[i].first_row_index;
+    const auto end =
+        i + 1 < pages.size() ? pages[i + 1].first_row_index : numRows;
+    // The page statistics are tested the same way as the row group ones.
+    thrift::Statistics stats;
+    if (columnIndex.null_pages[i]) {
+      stats.__set_null_count(end - begin);
+    } else {
+      if (columnIndex.__isset.null_counts) {
+        stats.__set_null_count(columnIndex.null_counts[i]);
+      }
+      stats.__set_min_value(columnIndex.min_values[i]);
+      stats.__set_max_value(columnIndex.max_values[i]);
+    }
+    auto columnStats =
+        buildColumnStatisticsFromThrift(stats, *type_->type(), end - begin);
+    if (!testFilter(filter, columnStats.get(), end - begin, type_->type())) {
+      continue;
+    }
+    if (!ranges.empty() && ranges.back().end == begin) {
+      ranges.back().end = end;
+    } else {
+      ranges.push_back({begin, end});
+    }
+  }
+  return ranges;
+}
+
+void ParquetData::setLastRowToRead(
+    uint32_t index,
+    const PageIndex& pageIndex,
+    int64_t lastRow) {
+  auto& pages = pageIndex.offsetIndex.page_locations;
+  if (pages.empty()) {
+    return;
+  }
+  // The last page whose first row is at or before 'lastRow'.
+  auto it = std::upper_bound(
+      pages.begin(),
+      pages.end(),
+      lastRow,
+      [](int64_t row, const thrift::PageLocation& page) {
+        return row < page.first_row_index;
+      });
+  if (it != pages.begin()) {
+    --it;
+  }
+  auto& metaData = rowGroups_[index].columns[type_->column()].meta_data;
+  chunkReadSizes_[index] =
+      it->offset + it->compressed_page_size - chunkReadOffset(metaData);
+}
+
 } // namespace facebook::velox::parquet
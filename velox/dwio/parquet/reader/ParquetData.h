@@ -21,6 +21,7 @@
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/parquet/reader/BloomFilter.h"
 #include "velox/dwio/parquet/reader/PageReader.h"
 #include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
@@ -41,6 +42,43 @@ class ParquetParams : public dwio::common::FormatParams {
   const thrift::FileMetaData& metaData_;
 };
 
+/// Context of ParquetData::filterRowGroups(). 'bloomFilterReader' returns the
+/// Bloom filter of a column chunk given the row group and the column, or
+/// nullptr if it is not available.
+struct ParquetStatsContext : dwio::common::StatsContext {
+  using BloomFilterReader =
+      std::function<std::shared_ptr<const SplitBlockBloomFilter>(
+          uint32_t rowGroup,
+          uint32_t column)>;
+
+  ParquetStatsContext() = default;
+
+  explicit ParquetStatsContext(BloomFilterReader reader)
+      : bloomFilterReader(std::move(reader)) {}
+
+  BloomFilterReader bloomFilterReader;
+};
+
+/// The page index of a column chunk. 'offsetIndex' has the location and first
+/// row of each page. 'columnIndex' has the min and max of each page and is
+/// read only for filtered columns.
+struct PageIndex {
+  thrift::OffsetIndex offsetIndex;
+  std::optional<thrift::ColumnIndex> columnIndex;
+};
+
+/// A range of rows of a row group, from 'begin' to 'end' exclusive.
+struct RowRange {
+  int64_t begin;
+  int64_t end;
+};
+
+/// Returns the rows that are in both 'left' and 'right'. The ranges are
+/// ascending and disjoint.
+std::vector<RowRange> intersectRowRanges(
+    const std::vector<RowRange>& left,
+    const std::vector<RowRange>& right);
+
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
 class ParquetData : public dwio::common::FormatData {
  public:
@@ -178,11 +216,49 @@ class ParquetData : public dwio::common::FormatData {
   // Returns the <offset, length> of the row group.
   std::pair<int64_t, int64_t> getRowGroupRegion(uint32_t index) const;
 
+  /// Returns the <offset, length> of the page index of the column chunk in
+  /// row group 'index' or <0, 0> if the chunk has no OffsetIndex. The region
+  /// covers the ColumnIndex if 'withColumnIndex' is true and the chunk has one.
+  std::pair<int64_t, int64_t> getPageIndexRegion(
+      uint32_t index,
+      bool withColumnIndex) const;
+
+  /// Decodes the page index of the column chunk in row group 'index' from
+  /// 'region', which holds the bytes of the file from 'regionOffset' on and
+  /// covers getPageIndexRegion(index, withColumnIndex).
+  PageIndex readPageIndex(
+      uint32_t index,
+      bool withColumnIndex,
+      const char* FOLLY_NONNULL region,
+      int64_t regionOffset) const;
+
+  /// Returns the ranges of rows of row group 'index' that are on pages whose
+  /// min and max in 'pageIndex' may pass 'filter'. Returns all rows if
+  /// 'pageIndex' has no ColumnIndex.
+  std::vector<RowRange> filterPages(
+      uint32_t index,
+      const PageIndex& pageIndex,
+      common::Filter* FOLLY_NONNULL filter) const;
+
+  /// Limits the read of the column chunk in row group 'index' to the pages up
+  /// to the one containing 'lastRow'. Must be called before enqueueRowGroup().
+  void setLastRowToRead(
+      uint32_t index,
+      const PageIndex& pageIndex,
+      int64_t lastRow);
+
  private:
   /// True if 'filter' may have hits for the column of 'this' according to the
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
 
+  /// False if 'filter' has no hits in row group 'rowGroupId' according to the
+  /// Bloom filter of the column chunk from 'context'.
+  bool bloomFilterMatches(
+      uint32_t rowGroupId,
+      const common::Filter& filter,
+      const dwio::common::StatsContext& context);
+
  protected:
   memory::MemoryPool& pool_;
   std::shared_ptr<const ParquetTypeWithId> type_;
@@ -191,6 +267,10 @@ class ParquetData : public dwio::common::FormatData {
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
 
+  // Bytes to read of the column chunk for the row groups where the pages after
+  // the last row to read are not fetched. Set by setLastRowToRead().
+  std::unordered_map<uint32_t, int64_t> chunkReadSizes_;
+
   const uint32_t maxDefine_;
   const uint32_t maxRepeat_;
   int64_t rowsInRowGroup_;
@@ -16,8 +16,11 @@
 
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 #include <thrift/protocol/TCompactProtocol.h> //@manual
+#include "velox/common/base/AsyncSource.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/MetricsLog.h"
 #include "velox/dwio/common/TypeUtils.h"
+#include "velox/dwio/parquet/reader/Statistics.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 
@@ -32,7 +35,7 @@ class ReaderBase {
       std::unique_ptr<dwio::common::BufferedInput>,
       const dwio::common::ReaderOptions& options);
 
-  virtual ~ReaderBase() = default;
+  virtual ~ReaderBase();
 
   memory::MemoryPool& getMemoryPool() const {
     return pool_;
@@ -67,7 +70,8 @@ class ReaderBase {
   }
 
   /// Ensures that streams are enqueued and loading for the row group at
-  /// 'currentGroup'. May start loading one or more subsequent groups.
+  /// 'currentGroup'. May start loading one or more subsequent groups. These
+  /// are loaded on the IO executor of the reader options if there is one.
   void scheduleRowGroups(
       const std::vector<uint32_t>& groups,
       int32_t currentGroup,
@@ -83,12 +87,34 @@ class ReaderBase {
   /// the data still exists in the buffered inputs.
   bool isRowGroupBuffered(int32_t rowGroupIndex) const;
 
+  /// Returns the Bloom filter of 'column' in row group 'rowGroup' or nullptr if
+  /// the column chunk has no Bloom filter that the reader supports. The filters
+  /// are cached in 'this' and in the FileMetadataCache if the file has a cache
+  /// key.
+  std::shared_ptr<const SplitBlockBloomFilter> bloomFilter(
+      uint32_t rowGroup,
+      uint32_t column);
+
  private:
   // Reads and parses file footer.
   void loadFileMetaData();
 
+  // Reads the Bloom filter header and bitset at 'offset'. Returns nullptr if
+  // the filter is not a split block filter with xxHash and no compression.
+  std::shared_ptr<const SplitBlockBloomFilter> readBloomFilter(int64_t offset);
+
   void initializeSchema();
 
+  // Enqueues the streams of row group 'index' and starts loading them in the
+  // background if there is an IO executor. Returns the input of the group.
+  std::shared_ptr<dwio::common::BufferedInput> prefetchRowGroup(
+      uint32_t index,
+      StructColumnReader& reader);
+
+  // Waits for the background load of row group 'index' if there is one, or
+  // loads it on the calling thread if the load has not started.
+  void waitForRowGroupLoad(uint32_t index);
+
   std::shared_ptr<const ParquetTypeWithId> getParquetColumnInfo(
       uint32_t maxSchemaElementIdx,
       uint32_t maxRepeat,
@@ -110,15 +136,33 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  std::shared_ptr<const thrift::FileMetaData> fileMetaData_;
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
   const bool binaryAsString = false;
 
+  // Estimated ratio of the memory of a decoded footer to its serialized size,
+  // used for sizing the entries of FileMetadataCache.
+  static constexpr int32_t kDecodedFooterSizeRatio = 4;
+
+  // Bytes read at the start of a Bloom filter. The header is a few bytes and
+  // the bitset is usually read with it.
+  static constexpr int64_t kBloomFilterReadSizeGuess = 64 << 10;
+
   // Map from row group index to pre-created loading BufferedInput.
   std::unordered_map<uint32_t, std::shared_ptr<dwio::common::BufferedInput>>
       inputs_;
+
+  // Background loads of the prefetched inputs in 'inputs_'.
+  std::unordered_map<uint32_t, std::shared_ptr<AsyncSource<bool>>>
+      pendingLoads_;
+
+  std::mutex bloomFiltersMutex_;
+  // Bloom filters by row group in the high and column in the low 32 bits.
+  // nullptr for the column chunks without a usable filter.
+  std::unordered_map<uint64_t, std::shared_ptr<const SplitBlockBloomFilter>>
+      bloomFilters_;
 };
 
 ReaderBase::ReaderBase(
@@ -137,11 +181,34 @@ ReaderBase::ReaderBase(
   initializeSchema();
 }
 
+ReaderBase::~ReaderBase() {
+  // The loads reference the inputs and the memory pool of 'this'.
+  for (auto& [index, load] : pendingLoads_) {
+    load->close();
+  }
+}
+
 void ReaderBase::loadFileMetaData() {
   bool preloadFile =
       fileLength_ <= std::max(filePreloadThreshold_, directorySizeGuess_);
   uint64_t readSize = preloadFile ? fileLength_ : directorySizeGuess_;
 
+  auto* metadataCache = options_.fileMetadataCacheKey().empty()
+      ? nullptr
+      : dwio::common::FileMetadataCache::instance();
+  const auto cacheKey =
+      fmt::format("{}:parquet", options_.fileMetadataCacheKey());
+  if (metadataCache != nullptr) {
+    fileMetaData_ = metadataCache->get<thrift::FileMetaData>(cacheKey);
+    if (fileMetaData_ != nullptr) {
+      // A small file is still loaded as a whole since its data is read next.
+      if (preloadFile) {
+        input_->loadCompleteFile();
+      }
+      return;
+    }
+  }
+
   std::unique_ptr<dwio::common::SeekableInputStream> stream;
   if (preloadFile) {
     stream = input_->loadCompleteFile();
@@ -184,8 +251,107 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto fileMetaData = std::make_shared<thrift::FileMetaData>();
+  fileMetaData->read(thriftProtocol.get());
+  fileMetaData_ = fileMetaData;
+  if (metadataCache != nullptr) {
+    // The decoded footer is a few times the size of its compact encoding.
+    metadataCache->put(
+        cacheKey,
+        fileMetaData_,
+        sizeof(thrift::FileMetaData) + kDecodedFooterSizeRatio * footerLength);
+  }
+}
+
+std::shared_ptr<const SplitBlockBloomFilter> ReaderBase::bloomFilter(
+    uint32_t rowGroup,
+    uint32_t column) {
+  const uint64_t key = (static_cast<uint64_t>(rowGroup) << 32) | column;
+  {
+    std::lock_guard<std::mutex> l(bloomFiltersMutex_);
+    auto it = bloomFilters_.find(key);
+    if (it != bloomFilters_.end()) {
+      return it->second;
+    }
+  }
+  auto& metaData =
+      fileMetaData_->row_groups[rowGroup].columns[column].meta_data;
+  if (!metaData.__isset.bloom_filter_offset) {
+    return nullptr;
+  }
+  auto* metadataCache = options_.fileMetadataCacheKey().empty()
+      ? nullptr
+      : dwio::common::FileMetadataCache::instance();
+  const auto cacheKey = fmt::format(
+      "{}:parquet:bloom:{}:{}",
+      options_.fileMetadataCacheKey(),
+      rowGroup,
+      column);
+  std::shared_ptr<const SplitBlockBloomFilter> bloomFilter;
+  if (metadataCache != nullptr) {
+    bloomFilter = metadataCache->get<SplitBlockBloomFilter>(cacheKey);
+  }
+  if (bloomFilter == nullptr) {
+    bloomFilter = readBloomFilter(metaData.bloom_filter_offset);
+    if (bloomFilter != nullptr && metadataCache != nullptr) {
+      metadataCache->put(
+          cacheKey,
+          bloomFilter,
+          sizeof(SplitBlockBloomFilter) + bloomFilter->size());
+    }
+  }
+  std::lock_guard<std::mutex> l(bloomFiltersMutex_);
+  bloomFilters_[key] = bloomFilter;
+  return bloomFilter;
+}
+
+std::shared_ptr<const SplitBlockBloomFilter> ReaderBase::readBloomFilter(
+    int64_t offset) {
+  const int64_t bytesLeft = fileLength_ - offset;
+  if (offset <= 0 || bytesLeft <= 0) {
+    return nullptr;
+  }
+  const auto readSize = std::min(kBloomFilterReadSizeGuess, bytesLeft);
+  std::vector<char> buffer(readSize);
+  auto stream =
+      input_->read(offset, readSize, dwio::common::LogType::STRIPE_INDEX);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      readSize, stream.get(), buffer.data(), bufferStart, bufferEnd);
+
+  std::shared_ptr<thrift::ThriftTransport> thriftTransport =
+      std::make_shared<thrift::ThriftBufferedTransport>(
+          buffer.data(), readSize);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>
+      protocol(thriftTransport);
+  thrift::BloomFilterHeader header;
+  const int64_t headerSize = header.read(&protocol);
+  const int64_t numBytes = header.numBytes;
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED || numBytes <= 0 ||
+      numBytes % SplitBlockBloomFilter::kBytesPerBlock != 0 ||
+      numBytes > SplitBlockBloomFilter::kMaxBytes ||
+      headerSize + numBytes > bytesLeft) {
+    return nullptr;
+  }
+  if (headerSize + numBytes > readSize) {
+    buffer.resize(headerSize + numBytes);
+    stream = input_->read(
+        offset + readSize,
+        headerSize + numBytes - readSize,
+        dwio::common::LogType::STRIPE_INDEX);
+    bufferStart = nullptr;
+    bufferEnd = nullptr;
+    dwio::common::readBytes(
+        headerSize + numBytes - readSize,
+        stream.get(),
+        buffer.data() + readSize,
+        bufferStart,
+        bufferEnd);
+  }
+  return std::make_shared<const SplitBlockBloomFilter>(
+      buffer.data() + headerSize, numBytes);
 }
 
 void ReaderBase::initializeSchema() {
@@ -361,10 +527,29 @@ std::shared_ptr<const ParquetTypeWithId> ReaderBase::getParquetColumnInfo(
     int32_t type_length =
         schemaElement.__isset.type_length ? schemaElement.type_length : 0;
     std::vector<std::shared_ptr<const dwio::common::TypeWithId>> children;
-    const std::optional<thrift::LogicalType> logicalType_ =
+    std::optional<thrift::LogicalType> logicalType_ =
         schemaElement.__isset.logicalType
         ? std::optional<thrift::LogicalType>(schemaElement.logicalType)
         : std::nullopt;
+    if (!logicalType_.has_value() && schemaElement.__isset.converted_type) {
+      // Older writers only set the converted type. Express the timestamp unit
+      // as a logical type so that readers have one place to look it up.
+      thrift::TimeUnit unit;
+      if (schemaElement.converted_type ==
+          thrift::ConvertedType::TIMESTAMP_MILLIS) {
+        unit.__set_MILLIS(thrift::MilliSeconds());
+      } else if (
+          schemaElement.converted_type ==
+          thrift::ConvertedType::TIMESTAMP_MICROS) {
+        unit.__set_MICROS(thrift::MicroSeconds());
+      }
+      if (unit.__isset.MILLIS || unit.__isset.MICROS) {
+        thrift::TimestampType timestamp;
+        timestamp.__set_unit(unit);
+        logicalType_.emplace();
+        logicalType_->__set_TIMESTAMP(timestamp);
+      }
+    }
     std::shared_ptr<const ParquetTypeWithId> leafTypePtr =
         std::make_shared<const ParquetTypeWithId>(
             veloxType,
@@ -414,6 +599,15 @@ TypePtr ReaderBase::convertType(
           schemaElement.__isset.type_length,
       "FIXED_LEN_BYTE_ARRAY requires length to be set");
 
+  if (schemaElement.__isset.logicalType &&
+      schemaElement.logicalType.__isset.TIMESTAMP) {
+    VELOX_CHECK_EQ(
+        schemaElement.type,
+        thrift::Type::INT64,
+        "TIMESTAMP logical type can only be set for value of thrift::Type::INT64");
+    return TIMESTAMP();
+  }
+
   if (schemaElement.__isset.converted_type) {
     switch (schemaElement.converted_type) {
       case thrift::ConvertedType::INT_8:
@@ -577,7 +771,7 @@ void ReaderBase::scheduleRowGroups(
   for (auto counter = 0; counter < options_.prefetchRowGroups(); ++counter) {
     if (nextGroup) {
       if (inputs_.count(nextGroup) == 0) {
-        inputs_[nextGroup] = reader.loadRowGroup(nextGroup, input_);
+        inputs_[nextGroup] = prefetchRowGroup(nextGroup, reader);
       }
     } else {
       break;
@@ -585,11 +779,41 @@ void ReaderBase::scheduleRowGroups(
     nextGroup =
         nextGroup + 1 < rowGroupIds.size() ? rowGroupIds[nextGroup + 1] : 0;
   }
+  waitForRowGroupLoad(thisGroup);
   if (currentGroup >= 1) {
     inputs_.erase(rowGroupIds[currentGroup - 1]);
   }
 }
 
+std::shared_ptr<dwio::common::BufferedInput> ReaderBase::prefetchRowGroup(
+    uint32_t index,
+    StructColumnReader& reader) {
+  const auto& executor = options_.getIOExecutor();
+  if (!executor) {
+    return reader.loadRowGroup(index, input_);
+  }
+  auto [input, needsLoad] = reader.enqueueRowGroupInput(index, input_);
+  if (needsLoad) {
+    auto load = std::make_shared<AsyncSource<bool>>([input = input]() {
+      input->load(dwio::common::LogType::STRIPE);
+      return std::make_unique<bool>(true);
+    });
+    pendingLoads_[index] = load;
+    executor->add([load]() { load->prepare(); });
+  }
+  return input;
+}
+
+void ReaderBase::waitForRowGroupLoad(uint32_t index) {
+  auto it = pendingLoads_.find(index);
+  if (it == pendingLoads_.end()) {
+    return;
+  }
+  auto load = std::move(it->second);
+  pendingLoads_.erase(it);
+  load->move();
+}
+
 int64_t ReaderBase::rowGroupUncompressedSize(
     int32_t rowGroupIndex,
     const dwio::common::TypeWithId& type) const {
@@ -654,34 +878,37 @@ ParquetRowReader::ParquetRowReader(
   }
 }
 
-namespace {
-struct ParquetStatsContext : dwio::common::StatsContext {};
-} // namespace
+bool ParquetRowReader::isRowGroupInRange(uint32_t index) const {
+  VELOX_CHECK_GT(rowGroups_[index].columns.size(), 0);
+  auto fileOffset = rowGroups_[index].__isset.file_offset
+      ? rowGroups_[index].file_offset
+      : rowGroups_[index].columns[0].meta_data.__isset.dictionary_page_offset
+      ? rowGroups_[index].columns[0].meta_data.dictionary_page_offset
+      : rowGroups_[index].columns[0].meta_data.data_page_offset;
+  VELOX_CHECK_GT(fileOffset, 0);
+  return fileOffset >= options_.getOffset() && fileOffset < options_.getLimit();
+}
 
 void ParquetRowReader::filterRowGroups() {
   rowGroupIds_.reserve(rowGroups_.size());
   firstRowOfRowGroup_.reserve(rowGroups_.size());
 
+  // The Bloom filters are read only for the row groups of the split.
+  ParquetStatsContext context([&](uint32_t rowGroup, uint32_t column) {
+    return isRowGroupInRange(rowGroup)
+        ? readerBase_->bloomFilter(rowGroup, column)
+        : nullptr;
+  });
   ParquetData::FilterRowGroupsResult res;
-  columnReader_->filterRowGroups(0, ParquetStatsContext(), res);
+  columnReader_->filterRowGroups(0, context, res);
   if (auto& metadataFilter = options_.getMetadataFilter()) {
     metadataFilter->eval(res.metadataFilterResults, res.filterResult);
   }
 
   uint64_t rowNumber = 0;
   for (auto i = 0; i < rowGroups_.size(); i++) {
-    VELOX_CHECK_GT(rowGroups_[i].columns.size(), 0);
-    auto fileOffset = rowGroups_[i].__isset.file_offset
-        ? rowGroups_[i].file_offset
-        : rowGroups_[i].columns[0].meta_data.__isset.dictionary_page_offset
-        ? rowGroups_[i].columns[0].meta_data.dictionary_page_offset
-        : rowGroups_[i].columns[0].meta_data.data_page_offset;
-    VELOX_CHECK_GT(fileOffset, 0);
-    auto rowGroupInRange =
-        (fileOffset >= options_.getOffset() &&
-         fileOffset < options_.getLimit());
     // A skipped row group is one that is in range and is in the excluded list.
-    if (rowGroupInRange) {
+    if (isRowGroupInRange(i)) {
       if (i < res.totalCount && bits::isBitSet(res.filterResult.data(), i)) {
         ++skippedRowGroups_;
       } else {
@@ -694,19 +921,45 @@ void ParquetRowReader::filterRowGroups() {
 }
 
 int64_t ParquetRowReader::nextRowNumber() {
-  if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
-      !advanceToNextRowGroup()) {
-    return kAtEnd;
+  while (currentRowInGroup_ >= rowsInCurrentRowGroup_ ||
+         !skipToNextRowRange()) {
+    if (!advanceToNextRowGroup()) {
+      return kAtEnd;
+    }
   }
   return firstRowOfRowGroup_[nextRowGroupIdsIdx_ - 1] + currentRowInGroup_;
 }
 
+bool ParquetRowReader::skipToNextRowRange() {
+  const int64_t row = currentRowInGroup_;
+  while (nextRowRange_ < rowRanges_.size() &&
+         rowRanges_[nextRowRange_].end <= row) {
+    ++nextRowRange_;
+  }
+  if (nextRowRange_ == rowRanges_.size()) {
+    skippedPageRows_ += rowsInCurrentRowGroup_ - currentRowInGroup_;
+    currentRowInGroup_ = rowsInCurrentRowGroup_;
+    return false;
+  }
+  const auto begin = rowRanges_[nextRowRange_].begin;
+  if (begin > row) {
+    // The column readers are positioned at the top level read offset on their
+    // next read.
+    const auto numSkipped = begin - row;
+    columnReader_->setReadOffset(columnReader_->readOffset() + numSkipped);
+    skippedPageRows_ += numSkipped;
+    currentRowInGroup_ = begin;
+  }
+  return true;
+}
+
 int64_t ParquetRowReader::nextReadSize(uint64_t size) {
   VELOX_CHECK_GT(size, 0);
   if (nextRowNumber() == kAtEnd) {
     return kAtEnd;
   }
-  return std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+  return std::min<uint64_t>(
+      size, rowRanges_[nextRowRange_].end - currentRowInGroup_);
 }
 
 uint64_t ParquetRowReader::next(
@@ -739,12 +992,21 @@ bool ParquetRowReader::advanceToNextRowGroup() {
   currentRowInGroup_ = 0;
   nextRowGroupIdsIdx_++;
   columnReader_->seekToRowGroup(nextRowGroupIndex);
+  auto ranges = static_cast<StructColumnReader&>(*columnReader_)
+                    .takeRowRanges(nextRowGroupIndex);
+  if (ranges.has_value()) {
+    rowRanges_ = std::move(ranges.value());
+  } else {
+    rowRanges_ = {{0, static_cast<int64_t>(rowsInCurrentRowGroup_)}};
+  }
+  nextRowRange_ = 0;
   return true;
 }
 
 void ParquetRowReader::updateRuntimeStats(
     dwio::common::RuntimeStatistics& stats) const {
   stats.skippedStrides += skippedRowGroups_;
+  stats.skippedPageRows += skippedPageRows_;
 }
 
 void ParquetRowReader::resetFilterCaches() {
@@ -755,11 +1017,31 @@ bool ParquetRowReader::isRowGroupBuffered(int32_t rowGroupIndex) const {
   return readerBase_->isRowGroupBuffered(rowGroupIndex);
 }
 
+namespace {
+// Returns the uncompressed size of the column chunks in row group
+// 'rowGroupIndex' that are read by 'reader'. Pruned subfields have no reader
+// and are not counted.
+int64_t readColumnsUncompressedSize(
+    const ReaderBase& readerBase,
+    int32_t rowGroupIndex,
+    const dwio::common::SelectiveColumnReader& reader) {
+  const auto& fileType =
+      static_cast<const ParquetTypeWithId&>(reader.fileType());
+  if (fileType.isLeaf()) {
+    return readerBase.rowGroupUncompressedSize(rowGroupIndex, fileType);
+  }
+  int64_t sum = 0;
+  for (auto* child : reader.children()) {
+    sum += readColumnsUncompressedSize(readerBase, rowGroupIndex, *child);
+  }
+  return sum;
+}
+} // namespace
+
 std::optional<size_t> ParquetRowReader::estimatedRowSize() const {
   auto index =
       nextRowGroupIdsIdx_ < 1 ? 0 : rowGroupIds_[nextRowGroupIdsIdx_ - 1];
-  return readerBase_->rowGroupUncompressedSize(
-             index, *readerBase_->schemaWithId()) /
+  return readColumnsUncompressedSize(*readerBase_, index, *columnReader_) /
       rowGroups_[index].num_rows;
 }
 
@@ -772,6 +1054,24 @@ std::optional<uint64_t> ParquetReader::numberOfRows() const {
   return readerBase_->fileNumRows();
 }
 
+std::unique_ptr<dwio::common::ColumnStatistics>
+ParquetReader::columnStatistics(uint32_t nodeId) const {
+  const auto& schema = readerBase_->schemaWithId();
+  for (auto i = 0; i < schema->size(); ++i) {
+    const auto& child =
+        static_cast<const ParquetTypeWithId&>(*schema->childAt(i));
+    if (child.id() != nodeId) {
+      continue;
+    }
+    if (!child.isLeaf()) {
+      return nullptr;
+    }
+    return buildFileColumnStatistics(
+        readerBase_->fileMetaData(), child.column(), *child.type());
+  }
+  return nullptr;
+}
+
 const velox::RowTypePtr& ParquetReader::rowType() const {
   return readerBase_->schema();
 }
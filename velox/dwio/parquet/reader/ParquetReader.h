@@ -20,6 +20,7 @@
 #include "velox/dwio/common/Reader.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/dwio/common/SelectiveColumnReader.h"
+#include "velox/dwio/parquet/reader/ParquetData.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
 
@@ -74,10 +75,17 @@ class ParquetRowReader : public dwio::common::RowReader {
   // ReaderBase and determines the set of row groups to scan.
   void filterRowGroups();
 
+  // True if the row group at 'index' starts in the range of the split.
+  bool isRowGroupInRange(uint32_t index) const;
+
   // Positions the reader tre at the start of the next row group, as determined
   // by filterRowGroups().
   bool advanceToNextRowGroup();
 
+  // Skips the rows of the current row group before the next range in
+  // 'rowRanges_'. Returns false if there are no more ranges.
+  bool skipToNextRowRange();
+
   memory::MemoryPool& pool_;
   const std::shared_ptr<ReaderBase> readerBase_;
   const dwio::common::RowReaderOptions options_;
@@ -93,9 +101,18 @@ class ParquetRowReader : public dwio::common::RowReader {
   uint64_t rowsInCurrentRowGroup_;
   uint64_t currentRowInGroup_;
 
+  // Ranges of rows of the current row group that are on pages which may pass
+  // the filters according to the page index. 'nextRowRange_' is the first
+  // range that does not end before 'currentRowInGroup_'.
+  std::vector<RowRange> rowRanges_;
+  size_t nextRowRange_{0};
+
   // Number of row groups skipped based on stats.
   int32_t skippedRowGroups_{0};
 
+  // Number of rows skipped based on page stats.
+  int64_t skippedPageRows_{0};
+
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
 
   RowTypePtr requestedType_;
@@ -114,10 +131,11 @@ class ParquetReader : public dwio::common::Reader {
 
   std::optional<uint64_t> numberOfRows() const override;
 
+  /// Returns the statistics of top level primitive column 'nodeId' merged
+  /// over all row groups, or nullptr for nested columns and columns without
+  /// statistics.
   std::unique_ptr<dwio::common::ColumnStatistics> columnStatistics(
-      uint32_t index) const override {
-    return nullptr;
-  }
+      uint32_t nodeId) const override;
 
   const velox::RowTypePtr& rowType() const override;
 
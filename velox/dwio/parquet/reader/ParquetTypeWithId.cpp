@@ -34,6 +34,22 @@ bool containsList(const ParquetTypeWithId& type) {
 } // namespace
 using ::parquet::internal::LevelInfo;
 
+int64_t ParquetTypeWithId::timestampNanosPerUnit() const {
+  VELOX_CHECK(
+      logicalType_.has_value() && logicalType_->__isset.TIMESTAMP,
+      "Not a Parquet timestamp column: {}",
+      name_);
+  const auto& unit = logicalType_->TIMESTAMP.unit;
+  if (unit.__isset.MILLIS) {
+    return 1'000'000;
+  }
+  if (unit.__isset.MICROS) {
+    return 1'000;
+  }
+  VELOX_CHECK(unit.__isset.NANOS, "Unknown timestamp unit: {}", name_);
+  return 1;
+}
+
 bool ParquetTypeWithId::hasNonRepeatedLeaf() const {
   if (type()->kind() == TypeKind::ARRAY) {
     return false;
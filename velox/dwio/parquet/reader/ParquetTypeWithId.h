@@ -74,6 +74,10 @@ class ParquetTypeWithId : public dwio::common::TypeWithId {
   /// Fills 'info' and returns the mode for interpreting levels.
   LevelMode makeLevelInfo(::parquet::internal::LevelInfo& info) const;
 
+  /// Returns the number of nanoseconds in one unit of a timestamp leaf stored
+  /// as INT64, e.g. 1'000 for microseconds.
+  int64_t timestampNanosPerUnit() const;
+
   const std::string name_;
   const std::optional<thrift::Type::type> parquetType_;
   const std::optional<thrift::LogicalType> logicalType_;
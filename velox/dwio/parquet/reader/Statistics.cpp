@@ -108,4 +108,102 @@ std::unique_ptr<dwio::common::ColumnStatistics> buildColumnStatisticsFromThrift(
   }
 }
 
+namespace {
+
+template <typename T>
+void mergeMinMax(
+    const std::optional<T>& min,
+    const std::optional<T>& max,
+    std::optional<T>& mergedMin,
+    std::optional<T>& mergedMax,
+    bool& valid) {
+  if (!min.has_value() || !max.has_value()) {
+    valid = false;
+    return;
+  }
+  mergedMin = mergedMin.has_value() ? std::min(*mergedMin, *min) : *min;
+  mergedMax = mergedMax.has_value() ? std::max(*mergedMax, *max) : *max;
+}
+
+} // namespace
+
+std::unique_ptr<dwio::common::ColumnStatistics> buildFileColumnStatistics(
+    const thrift::FileMetaData& fileMetaData,
+    uint32_t column,
+    const velox::Type& type) {
+  const bool isInteger = type.isTinyint() || type.isSmallint() ||
+      type.isInteger() || type.isBigint();
+  const bool isFloatingPoint = type.isReal() || type.isDouble();
+  const bool hasMinMax = (isInteger || isFloatingPoint) && !type.isDecimal();
+
+  uint64_t numValues = 0;
+  bool hasNull = false;
+  // False if some row group with values has no minimum or maximum.
+  bool minMaxValid = hasMinMax;
+  std::optional<int64_t> integerMin;
+  std::optional<int64_t> integerMax;
+  std::optional<double> doubleMin;
+  std::optional<double> doubleMax;
+  for (const auto& rowGroup : fileMetaData.row_groups) {
+    VELOX_CHECK_LT(column, rowGroup.columns.size());
+    const auto& metaData = rowGroup.columns[column].meta_data;
+    if (!metaData.__isset.statistics ||
+        !metaData.statistics.__isset.null_count) {
+      return nullptr;
+    }
+    auto stats = buildColumnStatisticsFromThrift(
+        metaData.statistics, type, rowGroup.num_rows);
+    const auto groupValues = stats->getNumberOfValues().value();
+    numValues += groupValues;
+    hasNull |= stats->hasNull().value();
+    if (!minMaxValid || groupValues == 0) {
+      continue;
+    }
+    if (isInteger) {
+      auto* integerStats =
+          dynamic_cast<const dwio::common::IntegerColumnStatistics*>(
+              stats.get());
+      mergeMinMax(
+          integerStats->getMinimum(),
+          integerStats->getMaximum(),
+          integerMin,
+          integerMax,
+          minMaxValid);
+    } else {
+      auto* doubleStats =
+          dynamic_cast<const dwio::common::DoubleColumnStatistics*>(
+              stats.get());
+      mergeMinMax(
+          doubleStats->getMinimum(),
+          doubleStats->getMaximum(),
+          doubleMin,
+          doubleMax,
+          minMaxValid);
+    }
+  }
+
+  if (minMaxValid && isInteger) {
+    return std::make_unique<dwio::common::IntegerColumnStatistics>(
+        numValues,
+        hasNull,
+        std::nullopt,
+        std::nullopt,
+        integerMin,
+        integerMax,
+        std::nullopt);
+  }
+  if (minMaxValid && isFloatingPoint) {
+    return std::make_unique<dwio::common::DoubleColumnStatistics>(
+        numValues,
+        hasNull,
+        std::nullopt,
+        std::nullopt,
+        doubleMin,
+        doubleMax,
+        std::nullopt);
+  }
+  return std::make_unique<dwio::common::ColumnStatistics>(
+      numValues, hasNull, std::nullopt, std::nullopt);
+}
+
 } // namespace facebook::velox::parquet
@@ -22,8 +22,6 @@
 
 namespace facebook::velox::parquet {
 
-// TODO: provide function to merge multiple Statistics into one
-
 template <typename T>
 inline const T load(const char* ptr) {
   T ret;
@@ -72,4 +70,13 @@ std::unique_ptr<dwio::common::ColumnStatistics> buildColumnStatisticsFromThrift(
     const velox::Type& type,
     uint64_t numRowsInRowGroup);
 
+/// Returns the statistics of leaf column 'column' of 'type' over all row
+/// groups of 'fileMetaData', or nullptr if a column chunk has no statistics.
+/// The minimum and maximum are kept only for integer and floating point
+/// columns that are not decimals.
+std::unique_ptr<dwio::common::ColumnStatistics> buildFileColumnStatistics(
+    const thrift::FileMetaData& fileMetaData,
+    uint32_t column,
+    const velox::Type& type);
+
 } // namespace facebook::velox::parquet
@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
+#include "velox/dwio/common/StreamUtil.h"
 #include "velox/dwio/parquet/reader/RepeatedColumnReader.h"
 
 namespace facebook::velox::parquet {
@@ -28,7 +29,12 @@ StructColumnReader::StructColumnReader(
   auto& childSpecs = scanSpec_->stableChildren();
   for (auto i = 0; i < childSpecs.size(); ++i) {
     auto childSpec = childSpecs[i];
-    if (childSpecs[i]->isConstant()) {
+    // Pruned subfields and nested fields that are not in the file are
+    // constant. No reader is made for them, so that their column chunks are
+    // neither fetched nor decoded.
+    if (isChildConstant(*childSpec) ||
+        !fileType_->type()->asRow().containsChild(childSpec->fieldName())) {
+      childSpec->setSubscript(kConstantChildSpecSubscript);
       continue;
     }
     auto childDataType = fileType_->childByName(childSpec->fieldName());
@@ -99,14 +105,27 @@ void StructColumnReader::read(
 std::shared_ptr<dwio::common::BufferedInput> StructColumnReader::loadRowGroup(
     uint32_t index,
     const std::shared_ptr<dwio::common::BufferedInput>& input) {
+  auto [rowGroupInput, needsLoad] = enqueueRowGroupInput(index, input);
+  if (needsLoad) {
+    rowGroupInput->load(dwio::common::LogType::STRIPE);
+  }
+  return rowGroupInput;
+}
+
+std::pair<std::shared_ptr<dwio::common::BufferedInput>, bool>
+StructColumnReader::enqueueRowGroupInput(
+    uint32_t index,
+    const std::shared_ptr<dwio::common::BufferedInput>& input) {
+  if (!fileType().parent()) {
+    filterPages(index, *input);
+  }
   if (isRowGroupBuffered(index, *input)) {
     enqueueRowGroup(index, *input);
-    return input;
+    return {input, false};
   }
-  auto newInput = input->clone();
+  std::shared_ptr<dwio::common::BufferedInput> newInput = input->clone();
   enqueueRowGroup(index, *newInput);
-  newInput->load(dwio::common::LogType::STRIPE);
-  return newInput;
+  return {std::move(newInput), true};
 }
 
 bool StructColumnReader::isRowGroupBuffered(
@@ -117,6 +136,81 @@ bool StructColumnReader::isRowGroupBuffered(
   return input.isBuffered(offset, length);
 }
 
+void StructColumnReader::filterPages(
+    uint32_t index,
+    dwio::common::BufferedInput& input) {
+  // The rows of the leaves directly under the root are top level rows. Other
+  // columns read their whole chunk.
+  std::vector<ParquetData*> leaves;
+  std::vector<common::Filter*> filters;
+  bool hasFilter = false;
+  int64_t regionBegin = std::numeric_limits<int64_t>::max();
+  int64_t regionEnd = 0;
+  for (auto* child : children_) {
+    auto& type = static_cast<const ParquetTypeWithId&>(child->fileType());
+    if (type.column() == ParquetTypeWithId::kNonLeaf || type.maxRepeat_ > 0) {
+      continue;
+    }
+    auto& data = child->formatData().as<ParquetData>();
+    auto* filter = child->scanSpec()->filter();
+    auto [offset, length] = data.getPageIndexRegion(index, filter != nullptr);
+    if (length == 0) {
+      continue;
+    }
+    leaves.push_back(&data);
+    filters.push_back(filter);
+    hasFilter |= filter != nullptr;
+    regionBegin = std::min(regionBegin, offset);
+    regionEnd = std::max(regionEnd, offset + length);
+  }
+  if (!hasFilter) {
+    return;
+  }
+
+  // The page indices of the columns of a row group are usually next to each
+  // other, so they are read with one request.
+  auto stream = input.read(
+      regionBegin,
+      regionEnd - regionBegin,
+      dwio::common::LogType::STRIPE_INDEX);
+  std::vector<char> region(regionEnd - regionBegin);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      region.size(), stream.get(), region.data(), bufferStart, bufferEnd);
+
+  std::vector<PageIndex> pageIndices;
+  std::optional<std::vector<RowRange>> ranges;
+  for (auto i = 0; i < leaves.size(); ++i) {
+    pageIndices.push_back(leaves[i]->readPageIndex(
+        index, filters[i] != nullptr, region.data(), regionBegin));
+    if (!filters[i]) {
+      continue;
+    }
+    auto columnRanges =
+        leaves[i]->filterPages(index, pageIndices.back(), filters[i]);
+    ranges = ranges.has_value()
+        ? intersectRowRanges(ranges.value(), columnRanges)
+        : std::move(columnRanges);
+  }
+  const auto lastRow = ranges->empty() ? 0 : ranges->back().end - 1;
+  for (auto i = 0; i < leaves.size(); ++i) {
+    leaves[i]->setLastRowToRead(index, pageIndices[i], lastRow);
+  }
+  rowRanges_[index] = std::move(ranges.value());
+}
+
+std::optional<std::vector<RowRange>> StructColumnReader::takeRowRanges(
+    uint32_t index) {
+  auto it = rowRanges_.find(index);
+  if (it == rowRanges_.end()) {
+    return std::nullopt;
+  }
+  auto ranges = std::move(it->second);
+  rowRanges_.erase(it);
+  return ranges;
+}
+
 void StructColumnReader::enqueueRowGroup(
     uint32_t index,
     dwio::common::BufferedInput& input) {
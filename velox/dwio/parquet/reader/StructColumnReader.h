@@ -36,11 +36,27 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
 
   /// Creates the streams for 'rowGroup'. Checks whether row 'rowGroup'
   /// has been buffered in 'input'. If true, return the input. Or else creates
-  /// the streams in a new input and loads.
+  /// the streams in a new input and loads. For the root of a table, first
+  /// evaluates the filters of the top level columns on the page index of the
+  /// row group, see takeRowRanges().
   std::shared_ptr<dwio::common::BufferedInput> loadRowGroup(
       uint32_t index,
       const std::shared_ptr<dwio::common::BufferedInput>& input);
 
+  /// Like loadRowGroup() but leaves loading a new input to the caller. Returns
+  /// the input and true if it is a new input that must be loaded before the
+  /// row group is read.
+  std::pair<std::shared_ptr<dwio::common::BufferedInput>, bool>
+  enqueueRowGroupInput(
+      uint32_t index,
+      const std::shared_ptr<dwio::common::BufferedInput>& input);
+
+  /// Returns the ranges of rows of row group 'index' that may pass the
+  /// filters according to the page index and forgets them. Returns
+  /// std::nullopt if the row group has no page index for the filtered columns.
+  /// loadRowGroup() must be called first.
+  std::optional<std::vector<RowRange>> takeRowRanges(uint32_t index);
+
   // No-op in Parquet. All readers switch row groups at the same time, there is
   // no on-demand skipping to a new row group.
   void advanceFieldReader(
@@ -74,6 +90,12 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
 
   bool isRowGroupBuffered(uint32_t index, dwio::common::BufferedInput& input);
 
+  // Reads the page index of the top level columns of row group 'index' from
+  // 'input' and sets 'rowRanges_' to the rows on the pages that may pass the
+  // filters of all the columns. Limits the reads of the column chunks to the
+  // pages up to the last range.
+  void filterPages(uint32_t index, dwio::common::BufferedInput& input);
+
   // Leaf column reader used for getting nullability information for
   // 'this'. This is nullptr for the root of a table.
   dwio::common::SelectiveColumnReader* FOLLY_NULLABLE childForRepDefs_{nullptr};
@@ -85,6 +107,9 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
   // The level information for extracting nulls for 'this' from the
   // repdefs in a leaf PageReader.
   ::parquet::internal::LevelInfo levelInfo_;
+
+  // Row ranges from filterPages() for the loaded row groups that have them.
+  std::unordered_map<uint32_t, std::vector<RowRange>> rowRanges_;
 };
 
 } // namespace facebook::velox::parquet
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/TimestampColumnReader.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+constexpr int64_t kNanosPerSecond = 1'000'000'000;
+
+// Returns 'timestamp' in units of 'nanosPerUnit' since the epoch, rounded
+// towards positive infinity if 'roundUp' and towards negative infinity
+// otherwise.
+int128_t
+toUnits(const Timestamp& timestamp, int64_t nanosPerUnit, bool roundUp) {
+  const int64_t unitsPerSecond = kNanosPerSecond / nanosPerUnit;
+  int128_t units =
+      static_cast<int128_t>(timestamp.getSeconds()) * unitsPerSecond +
+      timestamp.getNanos() / nanosPerUnit;
+  if (roundUp && timestamp.getNanos() % nanosPerUnit != 0) {
+    ++units;
+  }
+  return units;
+}
+
+Timestamp fromUnits(int64_t units, int64_t nanosPerUnit) {
+  const int64_t unitsPerSecond = kNanosPerSecond / nanosPerUnit;
+  int64_t seconds = units / unitsPerSecond;
+  int64_t remainder = units % unitsPerSecond;
+  if (remainder < 0) {
+    --seconds;
+    remainder += unitsPerSecond;
+  }
+  return Timestamp(seconds, remainder * nanosPerUnit);
+}
+} // namespace
+
+std::unique_ptr<common::Filter> toTimestampUnitFilter(
+    const common::Filter& filter,
+    int64_t nanosPerUnit) {
+  switch (filter.kind()) {
+    case common::FilterKind::kAlwaysTrue:
+    case common::FilterKind::kAlwaysFalse:
+    case common::FilterKind::kIsNull:
+    case common::FilterKind::kIsNotNull:
+      return filter.clone();
+    case common::FilterKind::kTimestampRange: {
+      const auto& range = static_cast<const common::TimestampRange&>(filter);
+      const auto lower = std::max<int128_t>(
+          toUnits(range.lower(), nanosPerUnit, true),
+          std::numeric_limits<int64_t>::min());
+      const auto upper = std::min<int128_t>(
+          toUnits(range.upper(), nanosPerUnit, false),
+          std::numeric_limits<int64_t>::max());
+      if (lower > upper) {
+        // No value in the file unit is inside the range.
+        if (range.testNull()) {
+          return std::make_unique<common::IsNull>();
+        }
+        return std::make_unique<common::AlwaysFalse>();
+      }
+      return std::make_unique<common::BigintRange>(
+          static_cast<int64_t>(lower),
+          static_cast<int64_t>(upper),
+          range.testNull());
+    }
+    default:
+      return nullptr;
+  }
+}
+
+TimestampColumnReader::TimestampColumnReader(
+    const std::shared_ptr<const dwio::common::TypeWithId>& requestedType,
+    std::shared_ptr<const dwio::common::TypeWithId> dataType,
+    ParquetParams& params,
+    common::ScanSpec& scanSpec)
+    : SelectiveIntegerColumnReader(
+          requestedType->type(),
+          params,
+          scanSpec,
+          dataType),
+      nanosPerUnit_(
+          std::static_pointer_cast<const ParquetTypeWithId>(dataType)
+              ->timestampNanosPerUnit()) {}
+
+common::Filter* TimestampColumnReader::unitFilter() {
+  auto* filter = scanSpec_->filter();
+  if (filter != scanSpecFilter_) {
+    // The filter may be replaced between reads, e.g. by dynamic filters.
+    scanSpecFilter_ = filter;
+    unitFilter_ =
+        filter ? toTimestampUnitFilter(*filter, nanosPerUnit_) : nullptr;
+  }
+  return unitFilter_.get();
+}
+
+void TimestampColumnReader::read(
+    vector_size_t offset,
+    RowSet rows,
+    const uint64_t* /*incomingNulls*/) {
+  VELOX_CHECK(
+      !scanSpec_->valueHook(),
+      "Selective reader for TIMESTAMP doesn't support aggregation pushdown yet");
+  prepareRead<int64_t>(offset, rows, nullptr);
+  bool isDense = rows.back() == rows.size() - 1;
+  if (isDense) {
+    readWithFilter<true>(rows);
+  } else {
+    readWithFilter<false>(rows);
+  }
+  readOffset_ += rows.back() + 1;
+}
+
+template <bool isDense>
+void TimestampColumnReader::readWithFilter(RowSet rows) {
+  auto* filter = unitFilter();
+  if (filter || !scanSpec_->filter()) {
+    if (!filter) {
+      filter = &dwio::common::alwaysTrue();
+    }
+    if (scanSpec_->keepValues()) {
+      processFilter<TimestampColumnReader, isDense>(
+          filter, dwio::common::ExtractToReader(this), rows);
+      convertValues();
+    } else {
+      processFilter<TimestampColumnReader, isDense>(
+          filter, dwio::common::DropValues(), rows);
+    }
+    return;
+  }
+
+  // The filter has no equivalent on the integers in the file, e.g. a
+  // MultiRange. Decode all values and test the filter on Timestamps.
+  if (!scanSpec_->keepValues()) {
+    prepareNulls(rows, nullsInReadRange_ != nullptr);
+  }
+  processFilter<TimestampColumnReader, isDense>(
+      &dwio::common::alwaysTrue(), dwio::common::ExtractToReader(this), rows);
+  convertValues();
+  const auto rawNulls = nullsInReadRange_
+      ? (isDense ? nullsInReadRange_->as<uint64_t>() : rawResultNulls_)
+      : nullptr;
+  filterTimestamps(*scanSpec_->filter(), rows, rawNulls);
+}
+
+void TimestampColumnReader::convertValues() {
+  auto units = reinterpret_cast<const int64_t*>(rawValues_);
+  auto timestamps =
+      AlignedBuffer::allocate<Timestamp>(numValues_, &memoryPool_);
+  auto rawTimestamps = timestamps->asMutable<Timestamp>();
+  // Values under nulls are converted too. The conversion does not overflow
+  // and the results are masked by the nulls.
+  for (vector_size_t i = 0; i < numValues_; ++i) {
+    rawTimestamps[i] = fromUnits(units[i], nanosPerUnit_);
+  }
+  values_ = timestamps;
+  rawValues_ = values_->asMutable<char>();
+}
+
+void TimestampColumnReader::filterTimestamps(
+    const common::Filter& filter,
+    RowSet rows,
+    const uint64_t* rawNulls) {
+  auto rawTimestamps = values_->asMutable<Timestamp>();
+
+  returnReaderNulls_ = false;
+  anyNulls_ = false;
+  allNull_ = true;
+  vector_size_t idx = 0;
+  for (vector_size_t i = 0; i < numValues_; i++) {
+    if (rawNulls && bits::isBitNull(rawNulls, i)) {
+      if (filter.testNull()) {
+        bits::setNull(rawResultNulls_, idx);
+        addOutputRow(rows[i]);
+        anyNulls_ = true;
+        idx++;
+      }
+    } else if (filter.testTimestamp(rawTimestamps[i])) {
+      if (rawNulls) {
+        bits::setNull(rawResultNulls_, idx, false);
+      }
+      rawTimestamps[idx] = rawTimestamps[i];
+      addOutputRow(rows[i]);
+      allNull_ = false;
+      idx++;
+    }
+  }
+  numValues_ = idx;
+}
+
+void TimestampColumnReader::getValues(RowSet rows, VectorPtr* result) {
+  getFlatValues<Timestamp, Timestamp>(rows, result, requestedType_, true);
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/SelectiveIntegerColumnReader.h"
+#include "velox/dwio/parquet/reader/ParquetData.h"
+
+namespace facebook::velox::parquet {
+
+/// Returns a filter over the INT64 values of a Parquet timestamp column in
+/// units of 'nanosPerUnit' that accepts exactly the values for which
+/// 'filter' accepts the corresponding Timestamp. Returns nullptr if 'filter'
+/// has no such equivalent and must be evaluated on Timestamps.
+std::unique_ptr<common::Filter> toTimestampUnitFilter(
+    const common::Filter& filter,
+    int64_t nanosPerUnit);
+
+/// Reads a TIMESTAMP column stored as INT64 in milli-, micro- or nanoseconds
+/// since the epoch. Timestamp range filters are translated to integer ranges
+/// in the file unit so that they run in the decoding loop like for BIGINT.
+class TimestampColumnReader
+    : public dwio::common::SelectiveIntegerColumnReader {
+ public:
+  TimestampColumnReader(
+      const std::shared_ptr<const dwio::common::TypeWithId>& requestedType,
+      std::shared_ptr<const dwio::common::TypeWithId> dataType,
+      ParquetParams& params,
+      common::ScanSpec& scanSpec);
+
+  bool hasBulkPath() const override {
+    return true;
+  }
+
+  void seekToRowGroup(uint32_t index) override {
+    SelectiveIntegerColumnReader::seekToRowGroup(index);
+    scanState().clear();
+    readOffset_ = 0;
+    formatData_->as<ParquetData>().seekToRowGroup(index);
+  }
+
+  uint64_t skip(uint64_t numValues) override {
+    formatData_->as<ParquetData>().skip(numValues);
+    return numValues;
+  }
+
+  void read(vector_size_t offset, RowSet rows, const uint64_t* incomingNulls)
+      override;
+
+  void getValues(RowSet rows, VectorPtr* result) override;
+
+  template <typename ColumnVisitor>
+  void readWithVisitor(RowSet rows, ColumnVisitor visitor) {
+    formatData_->as<ParquetData>().readWithVisitor(visitor);
+  }
+
+ private:
+  // Returns the filter to apply to the INT64 values or nullptr if the
+  // filter of 'scanSpec_' must be applied to the converted Timestamps.
+  common::Filter* unitFilter();
+
+  template <bool isDense>
+  void readWithFilter(RowSet rows);
+
+  // Converts the INT64 values in 'values_' into Timestamps.
+  void convertValues();
+
+  // Applies 'filter' to the converted values of 'rows' and compacts the
+  // values and nulls of the passing rows.
+  void filterTimestamps(
+      const common::Filter& filter,
+      RowSet rows,
+      const uint64_t* rawNulls);
+
+  const int64_t nanosPerUnit_;
+
+  // The filter of 'scanSpec_' that 'unitFilter_' was made from.
+  const common::Filter* scanSpecFilter_{nullptr};
+  std::unique_ptr<common::Filter> unitFilter_;
+};
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::common;
+using namespace facebook::velox::parquet;
+
+class BloomFilterTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    std::vector<char> bitset(1024);
+    bloomFilter_ =
+        std::make_unique<SplitBlockBloomFilter>(bitset.data(), bitset.size());
+  }
+
+  template <typename T>
+  void insert(T value) {
+    bloomFilter_->insert(SplitBlockBloomFilter::hash(&value, sizeof(T)));
+  }
+
+  void insert(const std::string& value) {
+    bloomFilter_->insert(
+        SplitBlockBloomFilter::hash(value.data(), value.size()));
+  }
+
+  std::unique_ptr<SplitBlockBloomFilter> bloomFilter_;
+};
+
+TEST_F(BloomFilterTest, bigint) {
+  for (int64_t i = 0; i < 10; ++i) {
+    insert<int64_t>(i * 1'000'000'007);
+  }
+  const auto type = thrift::Type::INT64;
+  EXPECT_TRUE(bloomFilter_->mayMatch(
+      BigintRange(7'000'000'049, 7'000'000'049, false), type));
+  EXPECT_FALSE(bloomFilter_->mayMatch(BigintRange(5, 5, false), type));
+  // Only single values and lists are tested.
+  EXPECT_TRUE(bloomFilter_->mayMatch(BigintRange(5, 6, false), type));
+  EXPECT_TRUE(bloomFilter_->mayMatch(BigintRange(5, 5, true), type));
+
+  EXPECT_TRUE(bloomFilter_->mayMatch(
+      *createBigintValues({1, 2, 3, 4, 5, 2'000'000'014}, false), type));
+  EXPECT_FALSE(bloomFilter_->mayMatch(
+      *createBigintValues({1, 2, 3, 4, 5, 2'000'000'015}, false), type));
+}
+
+TEST_F(BloomFilterTest, integer) {
+  for (int32_t i = 0; i < 10; ++i) {
+    insert<int32_t>(i * 1'001);
+  }
+  const auto type = thrift::Type::INT32;
+  EXPECT_TRUE(bloomFilter_->mayMatch(BigintRange(3'003, 3'003, false), type));
+  EXPECT_FALSE(bloomFilter_->mayMatch(BigintRange(3'004, 3'004, false), type));
+  // A value that does not fit in 32 bits is not tested.
+  EXPECT_TRUE(bloomFilter_->mayMatch(
+      BigintRange(1LL << 40, 1LL << 40, false), type));
+}
+
+TEST_F(BloomFilterTest, bytes) {
+  for (auto i = 0; i < 10; ++i) {
+    insert(fmt::format("user-{}", i));
+  }
+  const auto type = thrift::Type::BYTE_ARRAY;
+  EXPECT_TRUE(bloomFilter_->mayMatch(
+      BytesRange("user-3", false, false, "user-3", false, false, false),
+      type));
+  EXPECT_FALSE(bloomFilter_->mayMatch(
+      BytesRange("user-31", false, false, "user-31", false, false, false),
+      type));
+  EXPECT_TRUE(
+      bloomFilter_->mayMatch(BytesValues({"user-11", "user-7"}, false), type));
+  EXPECT_FALSE(
+      bloomFilter_->mayMatch(BytesValues({"user-11", "user-12"}, false), type));
+  EXPECT_TRUE(
+      bloomFilter_->mayMatch(BytesValues({"user-11", "user-12"}, true), type));
+}
@@ -16,6 +16,7 @@
 
 #include "velox/dwio/common/tests/E2EFilterTestBase.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
+#include "velox/dwio/parquet/writer/NativeWriter.h"
 #include "velox/dwio/parquet/writer/Writer.h"
 
 #include <folly/init/Init.h>
@@ -70,8 +71,12 @@ class E2EFilterTest : public E2EFilterTestBase {
           });
     };
 
-    writer_ = std::make_unique<facebook::velox::parquet::Writer>(
-        std::move(sink), options_);
+    if (useNativeWriter_) {
+      writer_ = std::make_unique<NativeWriter>(std::move(sink), options_);
+    } else {
+      writer_ = std::make_unique<facebook::velox::parquet::Writer>(
+          std::move(sink), options_);
+    }
     for (auto& batch : batches) {
       writer_->write(batch);
     }
@@ -85,8 +90,9 @@ class E2EFilterTest : public E2EFilterTestBase {
     return std::make_unique<ParquetReader>(std::move(input), opts);
   }
 
-  std::unique_ptr<facebook::velox::parquet::Writer> writer_;
+  std::unique_ptr<dwio::common::Writer> writer_;
   facebook::velox::parquet::WriterOptions options_;
+  bool useNativeWriter_ = false;
   uint64_t rowsInRowGroup_ = 10'000;
   int64_t bytesInRowGroup_ = 128 * 1'024 * 1'024;
 };
@@ -128,6 +134,23 @@ TEST_F(E2EFilterTest, integerDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, integerDeltaBinaryPacked) {
+  options_.enableDictionary = false;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::DELTA_BINARY_PACKED;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "long_null:bigint",
+      [&]() { makeAllNulls("long_null"); },
+      true,
+      {"short_val", "int_val", "long_val"},
+      20);
+}
+
 TEST_F(E2EFilterTest, compression) {
   for (const auto compression :
        {common::CompressionKind_SNAPPY,
@@ -258,6 +281,22 @@ TEST_F(E2EFilterTest, floatAndDoubleDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, floatAndDoubleByteStreamSplit) {
+  options_.enableDictionary = false;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::BYTE_STREAM_SPLIT;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "float_val:float,"
+      "double_val:double,"
+      "float_null:float",
+      [&]() { makeAllNulls("float_null"); },
+      true,
+      {"float_val", "double_val", "float_null"},
+      20);
+}
+
 TEST_F(E2EFilterTest, floatAndDouble) {
   // float_val and double_val may be direct since the
   // values are random.float_val2 and double_val2 are expected to be
@@ -430,6 +469,28 @@ TEST_F(E2EFilterTest, stringDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, stringDeltaEncodings) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 4 * 1024;
+
+  for (const auto encoding :
+       {facebook::velox::parquet::arrow::Encoding::DELTA_LENGTH_BYTE_ARRAY,
+        facebook::velox::parquet::arrow::Encoding::DELTA_BYTE_ARRAY}) {
+    SCOPED_TRACE(encoding);
+    options_.encoding = encoding;
+    testWithTypes(
+        "string_val:string,"
+        "string_val_2:string",
+        [&]() {
+          makeStringUnique("string_val");
+          makeStringUnique("string_val_2");
+        },
+        true,
+        {"string_val", "string_val_2"},
+        10);
+  }
+}
+
 TEST_F(E2EFilterTest, stringDictionary) {
   testWithTypes(
       "string_val:string,"
@@ -615,6 +676,155 @@ TEST_F(E2EFilterTest, combineRowGroup) {
   EXPECT_EQ(parquetReader.numberOfRows(), 5);
 }
 
+TEST_F(E2EFilterTest, pageIndex) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 1024;
+  options_.writePageIndex = true;
+
+  testWithTypes(
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "string_val:string",
+      [&]() {
+        makeIntDistribution<int64_t>(
+            "long_val",
+            10, // min
+            100, // max
+            22, // repeats
+            19, // rareFrequency
+            -9999, // rareMin
+            10000000000, // rareMax
+            true); // keepNulls
+      },
+      false,
+      {"short_val", "int_val", "long_val", "string_val"},
+      20);
+
+  // With sorted values a range filter matches a few pages of one row group.
+  rowType_ = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 5; ++i) {
+    batches.push_back(
+        std::static_pointer_cast<RowVector>(test::BatchMaker::createBatch(
+            rowType_, 10'000, *leafPool_, nullptr, i)));
+    auto* sorted = batches.back()->childAt(0)->asFlatVector<int64_t>();
+    for (auto j = 0; j < sorted->size(); ++j) {
+      sorted->set(j, i * 10'000 + j);
+    }
+  }
+  writeToMemory(rowType_, batches, false);
+
+  auto spec = std::make_shared<ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType_);
+  spec->childByName("c0")->setFilter(
+      std::make_unique<BigintRange>(21'000, 21'499, false));
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  std::string_view data(sinkPtr_->data(), sinkPtr_->size());
+  auto input = std::make_unique<BufferedInput>(
+      std::make_shared<InMemoryReadFile>(data), readerOpts.getMemoryPool());
+  auto reader = makeReader(readerOpts, std::move(input));
+  dwio::common::RowReaderOptions rowReaderOpts;
+  setUpRowReaderOptions(rowReaderOpts, spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto result = BaseVector::create(rowType_, 1, leafPool_.get());
+  int64_t numHits = 0;
+  while (rowReader->next(1'000, result) > 0) {
+    auto* c0 = result->as<RowVector>()
+                   ->childAt(0)
+                   ->loadedVector()
+                   ->as<SimpleVector<int64_t>>();
+    for (auto i = 0; i < c0->size(); ++i) {
+      EXPECT_EQ(21'000 + numHits, c0->valueAt(i));
+      ++numHits;
+    }
+  }
+  EXPECT_EQ(500, numHits);
+  dwio::common::RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  EXPECT_LT(8'000, stats.skippedPageRows);
+}
+
+TEST_F(E2EFilterTest, nativeWriter) {
+  useNativeWriter_ = true;
+  options_.dataPageSize = 4 * 1024;
+  for (const auto compression :
+       {common::CompressionKind_NONE,
+        common::CompressionKind_SNAPPY,
+        common::CompressionKind_ZSTD}) {
+    for (const auto enableDictionary : {true, false}) {
+      options_.compression = compression;
+      options_.enableDictionary = enableDictionary;
+      testWithTypes(
+          "boolean_val:boolean,"
+          "tinyint_val:tinyint,"
+          "short_val:smallint,"
+          "int_val:int,"
+          "long_val:bigint,"
+          "float_val:float,"
+          "double_val:double,"
+          "string_val:string,"
+          "long_null:bigint",
+          [&]() {
+            makeAllNulls("long_null");
+            makeIntDistribution<int64_t>(
+                "long_val",
+                10, // min
+                100, // max
+                22, // repeats
+                19, // rareFrequency
+                -9999, // rareMin
+                10000000000, // rareMax
+                true); // keepNulls
+            makeStringDistribution("string_val", 100, true, false);
+          },
+          true,
+          {"tinyint_val", "int_val", "long_val", "double_val", "string_val"},
+          10);
+    }
+  }
+}
+
+TEST_F(E2EFilterTest, nativeWriterDictionaryFallback) {
+  useNativeWriter_ = true;
+  options_.dictionaryPageSizeLimit = 1024;
+  testWithTypes(
+      "long_val:bigint,"
+      "string_val:string",
+      [&]() { makeStringUnique("string_val"); },
+      false,
+      {"long_val", "string_val"},
+      10);
+}
+
+TEST_F(E2EFilterTest, nativeWriterDictionaryVector) {
+  useNativeWriter_ = true;
+  rowType_ = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 3; ++i) {
+    auto base = std::static_pointer_cast<RowVector>(
+        test::BatchMaker::createBatch(rowType_, 100, *leafPool_, nullptr, i));
+    auto indices = allocateIndices(5'000, leafPool_.get());
+    auto* rawIndices = indices->asMutable<vector_size_t>();
+    for (auto j = 0; j < 5'000; ++j) {
+      rawIndices[j] = (j * 7 + i) % 100;
+    }
+    std::vector<VectorPtr> children;
+    for (const auto& child : base->children()) {
+      children.push_back(
+          BaseVector::wrapInDictionary(nullptr, indices, 5'000, child));
+    }
+    batches.push_back(std::make_shared<RowVector>(
+        leafPool_.get(), rowType_, nullptr, 5'000, std::move(children)));
+  }
+  writeToMemory(rowType_, batches, false);
+
+  auto spec = std::make_shared<ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType_);
+  uint64_t time = 0;
+  readWithoutFilter(spec, batches, time);
+}
+
 // Define main so that gflags get processed.
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
@@ -15,9 +15,13 @@
  */
 
 #include "velox/dwio/parquet/reader/ParquetReader.h"
+#include "velox/dwio/parquet/reader/TimestampColumnReader.h"
 #include "velox/dwio/parquet/tests/ParquetReaderTestBase.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <filesystem>
+
 using namespace facebook::velox;
 using namespace facebook::velox::common;
 using namespace facebook::velox::dwio::common;
@@ -86,6 +90,36 @@ TEST_F(ParquetReaderTest, parseSample) {
   assertReadExpected(sampleSchema(), *rowReader, expected, *pool_);
 }
 
+TEST_F(ParquetReaderTest, columnStatistics) {
+  // sample.parquet has two row groups of 10 rows with a: [1..20] and
+  // b: [1.0..20.0]. The statistics of the column chunks are merged.
+  const std::string sample(getExampleFilePath("sample.parquet"));
+  facebook::velox::dwio::common::ReaderOptions readerOptions{defaultPool.get()};
+  ParquetReader reader = createReader(sample, readerOptions);
+  const auto& type = reader.typeWithId();
+
+  auto stats = reader.columnStatistics(type->childByName("a")->id());
+  ASSERT_NE(stats, nullptr);
+  EXPECT_EQ(stats->getNumberOfValues(), 20);
+  EXPECT_EQ(stats->hasNull(), false);
+  auto* integerStats =
+      dynamic_cast<const dwio::common::IntegerColumnStatistics*>(stats.get());
+  ASSERT_NE(integerStats, nullptr);
+  EXPECT_EQ(integerStats->getMinimum(), 1);
+  EXPECT_EQ(integerStats->getMaximum(), 20);
+
+  stats = reader.columnStatistics(type->childByName("b")->id());
+  ASSERT_NE(stats, nullptr);
+  auto* doubleStats =
+      dynamic_cast<const dwio::common::DoubleColumnStatistics*>(stats.get());
+  ASSERT_NE(doubleStats, nullptr);
+  EXPECT_EQ(doubleStats->getMinimum(), 1.0);
+  EXPECT_EQ(doubleStats->getMaximum(), 20.0);
+
+  // The root is not a leaf column.
+  EXPECT_EQ(reader.columnStatistics(type->id()), nullptr);
+}
+
 TEST_F(ParquetReaderTest, parseSampleRange1) {
   const std::string sample(getExampleFilePath("sample.parquet"));
 
@@ -580,6 +614,53 @@ TEST_F(ParquetReaderTest, filterRowGroups) {
   EXPECT_EQ(reader.numberOfRows(), 10ULL);
 }
 
+TEST_F(ParquetReaderTest, timestampUnitFilter) {
+  constexpr int64_t kMicros = 1'000;
+  // [1.0000015s, 2.5s] covers the microseconds [1'000'002, 2'500'000].
+  auto filter = toTimestampUnitFilter(
+      TimestampRange(Timestamp(1, 1'500), Timestamp(2, 500'000'000), false),
+      kMicros);
+  ASSERT_EQ(filter->kind(), FilterKind::kBigintRange);
+  auto range = static_cast<const BigintRange*>(filter.get());
+  EXPECT_EQ(range->lower(), 1'000'002);
+  EXPECT_EQ(range->upper(), 2'500'000);
+  EXPECT_FALSE(range->testNull());
+
+  // Before the epoch the rounding is still towards the inside of the range.
+  filter = toTimestampUnitFilter(
+      TimestampRange(Timestamp(-2, 999'999'999), Timestamp(-1, 1), true),
+      kMicros);
+  ASSERT_EQ(filter->kind(), FilterKind::kBigintRange);
+  range = static_cast<const BigintRange*>(filter.get());
+  EXPECT_EQ(range->lower(), -1'000'000);
+  EXPECT_EQ(range->upper(), -1'000'000);
+  EXPECT_TRUE(range->testNull());
+
+  // No millisecond falls inside the range.
+  filter = toTimestampUnitFilter(
+      TimestampRange(Timestamp(1, 1'000), Timestamp(1, 2'000), true),
+      1'000'000);
+  EXPECT_EQ(filter->kind(), FilterKind::kIsNull);
+
+  filter = toTimestampUnitFilter(
+      TimestampRange(Timestamp::min(), Timestamp::max(), false), 1);
+  ASSERT_EQ(filter->kind(), FilterKind::kBigintRange);
+  range = static_cast<const BigintRange*>(filter.get());
+  EXPECT_EQ(range->lower(), std::numeric_limits<int64_t>::min());
+  EXPECT_EQ(range->upper(), std::numeric_limits<int64_t>::max());
+
+  EXPECT_EQ(
+      toTimestampUnitFilter(IsNotNull(), kMicros)->kind(),
+      FilterKind::kIsNotNull);
+  std::vector<std::unique_ptr<Filter>> ranges;
+  ranges.push_back(std::make_unique<TimestampRange>(
+      Timestamp(1, 0), Timestamp(2, 0), false));
+  ranges.push_back(std::make_unique<TimestampRange>(
+      Timestamp(5, 0), Timestamp(6, 0), false));
+  MultiRange multiRange(std::move(ranges), false, false);
+  EXPECT_EQ(toTimestampUnitFilter(multiRange, kMicros), nullptr);
+}
+
 TEST_F(ParquetReaderTest, parseLongTagged) {
   // This is a case for long with annonation read
   const std::string sample(getExampleFilePath("tagged_long.parquet"));
@@ -689,3 +770,49 @@ TEST_F(ParquetReaderTest, prefetchRowGroups) {
     }
   }
 }
+
+TEST_F(ParquetReaderTest, prefetchRowGroupsOnExecutor) {
+  auto rowType = ROW({"id"}, {BIGINT()});
+  const std::string sample(getExampleFilePath("multiple_row_groups.parquet"));
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(2);
+
+  facebook::velox::dwio::common::ReaderOptions readerOptions{defaultPool.get()};
+  readerOptions.setFilePreloadThreshold(0);
+  readerOptions.setPrefetchRowGroups(2);
+  readerOptions.setIOExecutor(executor);
+
+  // Reads the rows of the row groups that start in [offset, offset + length)
+  // and returns the number of rows and the sum of 'id'.
+  auto readRange = [&](uint64_t offset, uint64_t length) {
+    ParquetReader reader = createReader(sample, readerOptions);
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(makeScanSpec(rowType));
+    rowReaderOpts.range(offset, length);
+    auto rowReader = reader.createRowReader(rowReaderOpts);
+    VectorPtr result = BaseVector::create(rowType, 0, pool_.get());
+    int64_t numRows = 0;
+    int64_t sum = 0;
+    while (rowReader->next(1'000, result) > 0) {
+      auto ids = result->as<RowVector>()->childAt(0)->asFlatVector<int64_t>();
+      for (auto i = 0; i < result->size(); ++i) {
+        sum += ids->valueAt(i);
+      }
+      numRows += result->size();
+    }
+    return std::make_pair(numRows, sum);
+  };
+
+  const auto fileSize = std::filesystem::file_size(sample);
+  const auto [numRows, sum] = readRange(0, fileSize);
+  EXPECT_EQ(
+      createReader(sample, readerOptions).numberOfRows(),
+      static_cast<uint64_t>(numRows));
+
+  // A file split by byte range reads every row group exactly once, so that
+  // the row groups of a large file can be read by parallel drivers.
+  const auto [firstRows, firstSum] = readRange(0, fileSize / 2);
+  const auto [secondRows, secondSum] =
+      readRange(fileSize / 2, fileSize - fileSize / 2);
+  EXPECT_EQ(firstRows + secondRows, numRows);
+  EXPECT_EQ(firstSum + secondSum, sum);
+}
@@ -20,6 +20,7 @@
 #include "velox/dwio/common/tests/utils/DataFiles.h"
 #include "velox/dwio/parquet/RegisterParquetReader.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/type/tests/SubfieldFiltersBuilder.h"
@@ -301,6 +302,37 @@ TEST_F(ParquetTableScanTest, singleRowStruct) {
   assertSelectWithFilter({"s"}, {}, "", "SELECT (0, 1)");
 }
 
+TEST_F(ParquetTableScanTest, structSubfieldPruning) {
+  // 's.a' is pruned and 's.c' is not in the file. Both are read as nulls
+  // without making a column reader.
+  auto structType = ROW({"a", "b", "c"}, {BIGINT(), BIGINT(), BIGINT()});
+  auto rowType = ROW({"s"}, {structType});
+  std::vector<common::Subfield> requiredSubfields;
+  requiredSubfields.emplace_back("s.b");
+  requiredSubfields.emplace_back("s.c");
+  std::unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
+      assignments;
+  assignments["s"] = std::make_shared<connector::hive::HiveColumnHandle>(
+      "s",
+      connector::hive::HiveColumnHandle::ColumnType::kRegular,
+      structType,
+      structType,
+      std::move(requiredSubfields));
+  auto plan = PlanBuilder()
+                  .tableScan(rowType, makeTableHandle(), assignments)
+                  .planNode();
+  auto result =
+      AssertQueryBuilder(plan)
+          .split(makeSplit(getExampleFilePath("single_row_struct.parquet")))
+          .copyResults(pool());
+  auto expected = makeRowVector({makeRowVector(
+      {"a", "b", "c"},
+      {makeNullableFlatVector<int64_t>({std::nullopt}),
+       makeFlatVector<int64_t>({1}),
+       makeNullableFlatVector<int64_t>({std::nullopt})})});
+  assertEqualVectors(expected, result);
+}
+
 // Core dump and incorrect result are fixed.
 TEST_F(ParquetTableScanTest, DISABLED_array) {
   auto vector = makeArrayVector<int32_t>({{1, 2, 3}});
@@ -0,0 +1,1117 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/writer/NativeWriter.h"
+
+#include <folly/Random.h>
+#include <folly/container/F14Map.h>
+#include <folly/io/IOBuf.h>
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include <thrift/transport/TBufferTransports.h> //@manual
+
+#include "velox/common/memory/AllocationPool.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/vector/DecodedVector.h"
+
+DEFINE_bool(
+    velox_parquet_native_writer,
+    false,
+    "Write Parquet files with the native writer instead of the Arrow based "
+    "one when the schema and the options are supported");
+
+namespace facebook::velox::parquet {
+
+using dwio::common::DataBuffer;
+
+/// Writer of the values of a column and its descendants. The rows to write
+/// are given as positions in the vector of the column, one per top level row.
+class NativeColumnWriter {
+ public:
+  /// Row of a position whose path has a null ancestor.
+  static constexpr vector_size_t kNullRow = -1;
+
+  struct Position {
+    /// Row in the vector of the column or kNullRow.
+    vector_size_t row;
+    /// Definition level of the path if 'row' is kNullRow.
+    int16_t level;
+  };
+
+  virtual ~NativeColumnWriter() = default;
+
+  /// Appends the values of 'vector' at 'positions'. 'vector' is nullptr if
+  /// all the positions are kNullRow.
+  virtual void write(
+      const BaseVector* vector,
+      const std::vector<Position>& positions) = 0;
+
+  /// Bytes buffered for the current row group.
+  virtual int64_t bufferedBytes() const = 0;
+
+  /// Adds the buffered column chunks to 'buffers' and their metadata to
+  /// 'columns'. 'offset' is the file offset of the first added byte and is
+  /// advanced past the added buffers.
+  virtual void flush(
+      int64_t& offset,
+      std::vector<DataBuffer<char>>& buffers,
+      std::vector<thrift::ColumnChunk>& columns) = 0;
+};
+
+namespace {
+
+constexpr std::string_view kMagic{"PAR1"};
+
+// Number of values appended to a page between checks of its size.
+constexpr int32_t kValuesPerPageCheck = 1'024;
+
+struct ColumnWriterOptions {
+  memory::MemoryPool* pool;
+  bool enableDictionary;
+  int64_t dataPageSize;
+  int64_t dictionaryPageSizeLimit;
+  // nullptr if the pages are not compressed.
+  folly::io::Codec* codec;
+  thrift::CompressionCodec::type thriftCodec;
+};
+
+void appendBytes(DataBuffer<char>& out, const void* data, uint64_t size) {
+  out.extendAppend(out.size(), reinterpret_cast<const char*>(data), size);
+}
+
+// Empties 'buffer' and keeps its memory.
+template <typename T>
+void clearBuffer(DataBuffer<T>& buffer) {
+  if (buffer.size() > 0) {
+    buffer.resize(0);
+  }
+}
+
+template <typename T>
+void serialize(const T& object, DataBuffer<char>& out) {
+  auto transport = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+  apache::thrift::protocol::TCompactProtocolT<
+      apache::thrift::transport::TMemoryBuffer>
+      protocol(transport);
+  object.write(&protocol);
+  uint8_t* data;
+  uint32_t size;
+  transport->getBuffer(&data, &size);
+  appendBytes(out, data, size);
+}
+
+// Returns the bits for values up to 'maxValue', at least 1.
+int32_t bitWidth(uint32_t maxValue) {
+  return 64 - bits::countLeadingZeros<uint64_t>(maxValue | 1);
+}
+
+void writeVarint(uint64_t value, DataBuffer<char>& out) {
+  while (value >= 0x80) {
+    out.append(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out.append(static_cast<char>(value));
+}
+
+// Appends a bit packed run of 'numValues' values, padded with zeros to a
+// multiple of 8 values.
+template <typename T>
+void writeBitPacked(
+    const T* values,
+    int64_t numValues,
+    int32_t bitWidth,
+    DataBuffer<char>& out) {
+  if (numValues == 0) {
+    return;
+  }
+  const auto numGroups = bits::roundUp(numValues, 8) / 8;
+  writeVarint(numGroups << 1 | 1, out);
+  out.extend(numGroups * bitWidth);
+  uint64_t pending = 0;
+  int32_t numPendingBits = 0;
+  for (auto i = 0; i < numGroups * 8; ++i) {
+    const uint64_t value = i < numValues
+        ? static_cast<std::make_unsigned_t<T>>(values[i])
+        : 0;
+    pending |= value << numPendingBits;
+    numPendingBits += bitWidth;
+    while (numPendingBits >= 8) {
+      out.unsafeAppend(static_cast<char>(pending));
+      pending >>= 8;
+      numPendingBits -= 8;
+    }
+  }
+}
+
+// Appends 'values' in the RLE / bit packed hybrid encoding. Runs of at least 8
+// equal values are RLE encoded and the rest is bit packed.
+template <typename T>
+void encodeRleBp(
+    const T* values,
+    int64_t numValues,
+    int32_t bitWidth,
+    DataBuffer<char>& out) {
+  int64_t literalStart = 0;
+  int64_t i = 0;
+  while (i < numValues) {
+    int64_t runEnd = i + 1;
+    while (runEnd < numValues && values[runEnd] == values[i]) {
+      ++runEnd;
+    }
+    // Bit packed runs are multiples of 8 values except at the end, so the run
+    // first completes the last group of the pending literals.
+    const int64_t runStart = i + (8 - (i - literalStart) % 8) % 8;
+    if (runEnd - runStart >= 8) {
+      writeBitPacked(
+          values + literalStart, runStart - literalStart, bitWidth, out);
+      writeVarint((runEnd - runStart) << 1, out);
+      const uint64_t value = static_cast<std::make_unsigned_t<T>>(values[i]);
+      for (auto byte = 0; byte < bits::roundUp(bitWidth, 8) / 8; ++byte) {
+        out.append(static_cast<char>(value >> (byte * 8)));
+      }
+      literalStart = runEnd;
+    }
+    i = runEnd;
+  }
+  writeBitPacked(
+      values + literalStart, numValues - literalStart, bitWidth, out);
+}
+
+thrift::CompressionCodec::type toThriftCodec(
+    common::CompressionKind compression) {
+  switch (compression) {
+    case common::CompressionKind_NONE:
+      return thrift::CompressionCodec::UNCOMPRESSED;
+    case common::CompressionKind_SNAPPY:
+      return thrift::CompressionCodec::SNAPPY;
+    case common::CompressionKind_GZIP:
+      return thrift::CompressionCodec::GZIP;
+    case common::CompressionKind_ZSTD:
+      return thrift::CompressionCodec::ZSTD;
+    default:
+      VELOX_UNSUPPORTED(
+          "Unsupported compression for the native Parquet writer: {}",
+          common::compressionKindToString(compression));
+  }
+}
+
+bool isSupportedType(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::ROW:
+      if (type.size() == 0) {
+        return false;
+      }
+      for (const auto& child : type.asRow().children()) {
+        if (!isSupportedType(*child)) {
+          return false;
+        }
+      }
+      return true;
+    case TypeKind::INTEGER:
+      return type == *INTEGER() || type.isDate();
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      // Excludes the custom types with these kinds, e.g. decimals.
+      return type.equivalent(*createScalarType(type.kind()));
+    default:
+      return false;
+  }
+}
+
+thrift::SchemaElement makeLeafSchema(
+    const TypePtr& type,
+    const std::string& name) {
+  thrift::SchemaElement element;
+  element.__set_name(name);
+  element.__set_repetition_type(thrift::FieldRepetitionType::OPTIONAL);
+  thrift::LogicalType logicalType;
+  thrift::IntType intType;
+  intType.__set_isSigned(true);
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      element.__set_type(thrift::Type::BOOLEAN);
+      break;
+    case TypeKind::TINYINT:
+      element.__set_type(thrift::Type::INT32);
+      element.__set_converted_type(thrift::ConvertedType::INT_8);
+      intType.__set_bitWidth(8);
+      logicalType.__set_INTEGER(intType);
+      element.__set_logicalType(logicalType);
+      break;
+    case TypeKind::SMALLINT:
+      element.__set_type(thrift::Type::INT32);
+      element.__set_converted_type(thrift::ConvertedType::INT_16);
+      intType.__set_bitWidth(16);
+      logicalType.__set_INTEGER(intType);
+      element.__set_logicalType(logicalType);
+      break;
+    case TypeKind::INTEGER:
+      element.__set_type(thrift::Type::INT32);
+      if (type->isDate()) {
+        element.__set_converted_type(thrift::ConvertedType::DATE);
+        logicalType.__set_DATE(thrift::DateType());
+        element.__set_logicalType(logicalType);
+      }
+      break;
+    case TypeKind::BIGINT:
+      element.__set_type(thrift::Type::INT64);
+      break;
+    case TypeKind::REAL:
+      element.__set_type(thrift::Type::FLOAT);
+      break;
+    case TypeKind::DOUBLE:
+      element.__set_type(thrift::Type::DOUBLE);
+      break;
+    case TypeKind::VARCHAR:
+      element.__set_type(thrift::Type::BYTE_ARRAY);
+      element.__set_converted_type(thrift::ConvertedType::UTF8);
+      logicalType.__set_STRING(thrift::StringType());
+      element.__set_logicalType(logicalType);
+      break;
+    case TypeKind::VARBINARY:
+      element.__set_type(thrift::Type::BYTE_ARRAY);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+  return element;
+}
+
+// Physical type, dictionary key and statistics of the values of a TypeKind.
+template <TypeKind kind>
+struct PhysicalTraits {
+  using Physical = typename TypeTraits<kind>::NativeType;
+  using Key = Physical;
+  using Stats = Physical;
+};
+
+template <>
+struct PhysicalTraits<TypeKind::TINYINT> {
+  using Physical = int32_t;
+  using Key = int32_t;
+  using Stats = int32_t;
+};
+
+template <>
+struct PhysicalTraits<TypeKind::SMALLINT> {
+  using Physical = int32_t;
+  using Key = int32_t;
+  using Stats = int32_t;
+};
+
+// Floating point values are keyed by their bits so that NaNs are found.
+template <>
+struct PhysicalTraits<TypeKind::REAL> {
+  using Physical = float;
+  using Key = uint32_t;
+  using Stats = float;
+};
+
+template <>
+struct PhysicalTraits<TypeKind::DOUBLE> {
+  using Physical = double;
+  using Key = uint64_t;
+  using Stats = double;
+};
+
+template <>
+struct PhysicalTraits<TypeKind::VARCHAR> {
+  using Physical = std::string_view;
+  using Key = std::string_view;
+  using Stats = std::string;
+};
+
+template <>
+struct PhysicalTraits<TypeKind::VARBINARY>
+    : PhysicalTraits<TypeKind::VARCHAR> {};
+
+class StructWriter : public NativeColumnWriter {
+ public:
+  // 'level' is the definition level of a non-null struct, 0 for the top
+  // level row.
+  StructWriter(
+      int16_t level,
+      std::vector<std::unique_ptr<NativeColumnWriter>> children)
+      : level_(level), children_(std::move(children)) {}
+
+  void write(const BaseVector* vector, const std::vector<Position>& positions)
+      override {
+    const RowVector* base = nullptr;
+    if (vector) {
+      decoded_.decode(*vector);
+      base = dynamic_cast<const RowVector*>(decoded_.base());
+    }
+    childPositions_.resize(positions.size());
+    for (auto i = 0; i < positions.size(); ++i) {
+      const auto& position = positions[i];
+      if (position.row == kNullRow) {
+        childPositions_[i] = position;
+      } else if (
+          base == nullptr || (level_ > 0 && decoded_.isNullAt(position.row))) {
+        childPositions_[i] = {kNullRow, static_cast<int16_t>(level_ - 1)};
+      } else {
+        childPositions_[i] = {decoded_.index(position.row), 0};
+      }
+    }
+    for (auto i = 0; i < children_.size(); ++i) {
+      children_[i]->write(
+          base ? base->childAt(i).get() : nullptr, childPositions_);
+    }
+  }
+
+  int64_t bufferedBytes() const override {
+    int64_t bytes = 0;
+    for (const auto& child : children_) {
+      bytes += child->bufferedBytes();
+    }
+    return bytes;
+  }
+
+  void flush(
+      int64_t& offset,
+      std::vector<DataBuffer<char>>& buffers,
+      std::vector<thrift::ColumnChunk>& columns) override {
+    for (auto& child : children_) {
+      child->flush(offset, buffers, columns);
+    }
+  }
+
+ private:
+  const int16_t level_;
+  const std::vector<std::unique_ptr<NativeColumnWriter>> children_;
+  DecodedVector decoded_;
+  std::vector<Position> childPositions_;
+};
+
+// Pages and metadata of the column chunk of a leaf column. Subclasses encode
+// the values.
+class LeafWriterBase : public NativeColumnWriter {
+ public:
+  LeafWriterBase(
+      const ColumnWriterOptions& options,
+      std::vector<std::string> path,
+      int16_t maxDefine,
+      thrift::Type::type type)
+      : options_(options),
+        path_(std::move(path)),
+        maxDefine_(maxDefine),
+        type_(type),
+        levels_(*options.pool),
+        pageBody_(*options.pool),
+        pages_(*options.pool) {
+    VELOX_CHECK_LE(maxDefine_, std::numeric_limits<uint8_t>::max());
+  }
+
+  int64_t bufferedBytes() const override {
+    return pages_.size() + levels_.size() + valueBytes();
+  }
+
+  void flush(
+      int64_t& offset,
+      std::vector<DataBuffer<char>>& buffers,
+      std::vector<thrift::ColumnChunk>& columns) override;
+
+ protected:
+  // Encodes the values of the current page into 'out', clears them and
+  // returns their encoding.
+  virtual thrift::Encoding::type encodePageValues(DataBuffer<char>& out) = 0;
+
+  // Estimated size of the encoded values of the current page.
+  virtual int64_t pageValueBytes() const = 0;
+
+  // Bytes held for the values of the current page and the dictionary.
+  virtual int64_t valueBytes() const = 0;
+
+  // Appends the PLAIN encoded dictionary to 'out' and returns its number of
+  // entries if pages of the chunk are dictionary encoded. Returns std::nullopt
+  // otherwise.
+  virtual std::optional<int32_t> encodeDictionary(DataBuffer<char>& out) = 0;
+
+  virtual void addStatistics(thrift::Statistics& statistics) const = 0;
+
+  // Clears the dictionary and the statistics of the chunk.
+  virtual void resetChunk() = 0;
+
+  // Encodes the current page if it is over the page size.
+  void checkPageSize() {
+    if (levels_.size() / 8 + pageValueBytes() >= options_.dataPageSize) {
+      finishPage();
+    }
+  }
+
+  void finishPage();
+
+  const ColumnWriterOptions options_;
+  const std::vector<std::string> path_;
+  const int16_t maxDefine_;
+  const thrift::Type::type type_;
+
+  // Definition levels of the current page, one per value including nulls.
+  DataBuffer<uint8_t> levels_;
+  int64_t nullCount_{0};
+
+ private:
+  // Compresses 'body' and appends it to 'out' after 'header'.
+  void appendPage(
+      thrift::PageHeader& header,
+      const DataBuffer<char>& body,
+      DataBuffer<char>& out);
+
+  // Uncompressed page being assembled.
+  DataBuffer<char> pageBody_;
+  // Data pages of the chunk.
+  DataBuffer<char> pages_;
+  int64_t uncompressedBytes_{0};
+  int64_t numValues_{0};
+  std::vector<thrift::Encoding::type> encodings_;
+};
+
+void LeafWriterBase::finishPage() {
+  if (levels_.size() == 0) {
+    return;
+  }
+  // Version 1 data pages start with the length of the definition levels.
+  clearBuffer(pageBody_);
+  pageBody_.resize(sizeof(int32_t));
+  encodeRleBp(levels_.data(), levels_.size(), bitWidth(maxDefine_), pageBody_);
+  const int32_t levelsSize = pageBody_.size() - sizeof(int32_t);
+  memcpy(pageBody_.data(), &levelsSize, sizeof(int32_t));
+  const auto encoding = encodePageValues(pageBody_);
+
+  thrift::DataPageHeader dataHeader;
+  dataHeader.__set_num_values(levels_.size());
+  dataHeader.__set_encoding(encoding);
+  dataHeader.__set_definition_level_encoding(thrift::Encoding::RLE);
+  dataHeader.__set_repetition_level_encoding(thrift::Encoding::RLE);
+  thrift::PageHeader header;
+  header.__set_type(thrift::PageType::DATA_PAGE);
+  header.__set_data_page_header(dataHeader);
+  appendPage(header, pageBody_, pages_);
+
+  numValues_ += levels_.size();
+  clearBuffer(levels_);
+  if (std::find(encodings_.begin(), encodings_.end(), encoding) ==
+      encodings_.end()) {
+    encodings_.push_back(encoding);
+  }
+}
+
+void LeafWriterBase::appendPage(
+    thrift::PageHeader& header,
+    const DataBuffer<char>& body,
+    DataBuffer<char>& out) {
+  const char* data = body.data();
+  uint64_t size = body.size();
+  std::unique_ptr<folly::IOBuf> compressed;
+  if (options_.codec) {
+    const auto input = folly::IOBuf::wrapBufferAsValue(data, size);
+    compressed = options_.codec->compress(&input);
+    compressed->coalesce();
+    data = reinterpret_cast<const char*>(compressed->data());
+    size = compressed->length();
+  }
+  header.__set_uncompressed_page_size(body.size());
+  header.__set_compressed_page_size(size);
+  const auto headerStart = out.size();
+  serialize(header, out);
+  uncompressedBytes_ += out.size() - headerStart + body.size();
+  appendBytes(out, data, size);
+}
+
+void LeafWriterBase::flush(
+    int64_t& offset,
+    std::vector<DataBuffer<char>>& buffers,
+    std::vector<thrift::ColumnChunk>& columns) {
+  finishPage();
+  const auto chunkOffset = offset;
+  thrift::ColumnMetaData metaData;
+  std::vector<thrift::Encoding::type> encodings{thrift::Encoding::RLE};
+
+  // The dictionary page precedes the data pages.
+  DataBuffer<char> body(*options_.pool);
+  if (const auto numEntries = encodeDictionary(body)) {
+    thrift::DictionaryPageHeader dictionaryHeader;
+    dictionaryHeader.__set_num_values(numEntries.value());
+    dictionaryHeader.__set_encoding(thrift::Encoding::PLAIN);
+    thrift::PageHeader header;
+    header.__set_type(thrift::PageType::DICTIONARY_PAGE);
+    header.__set_dictionary_page_header(dictionaryHeader);
+    DataBuffer<char> page(*options_.pool);
+    appendPage(header, body, page);
+    metaData.__set_dictionary_page_offset(offset);
+    offset += page.size();
+    buffers.push_back(std::move(page));
+    encodings.push_back(thrift::Encoding::PLAIN);
+  }
+  for (const auto encoding : encodings_) {
+    if (std::find(encodings.begin(), encodings.end(), encoding) ==
+        encodings.end()) {
+      encodings.push_back(encoding);
+    }
+  }
+  metaData.__set_data_page_offset(offset);
+  offset += pages_.size();
+
+  metaData.__set_type(type_);
+  metaData.__set_encodings(encodings);
+  metaData.__set_path_in_schema(path_);
+  metaData.__set_codec(options_.thriftCodec);
+  metaData.__set_num_values(numValues_);
+  metaData.__set_total_uncompressed_size(uncompressedBytes_);
+  metaData.__set_total_compressed_size(offset - chunkOffset);
+  thrift::Statistics statistics;
+  statistics.__set_null_count(nullCount_);
+  addStatistics(statistics);
+  metaData.__set_statistics(statistics);
+  buffers.push_back(std::move(pages_));
+
+  thrift::ColumnChunk chunk;
+  chunk.__set_file_offset(chunkOffset);
+  chunk.__set_meta_data(metaData);
+  columns.push_back(std::move(chunk));
+
+  uncompressedBytes_ = 0;
+  numValues_ = 0;
+  nullCount_ = 0;
+  encodings_.clear();
+  resetChunk();
+}
+
+template <TypeKind kind>
+class LeafWriter : public LeafWriterBase {
+ public:
+  using T = typename TypeTraits<kind>::NativeType;
+  using Physical = typename PhysicalTraits<kind>::Physical;
+  using Key = typename PhysicalTraits<kind>::Key;
+  using Stats = typename PhysicalTraits<kind>::Stats;
+
+  static constexpr bool kIsString = std::is_same_v<Physical, std::string_view>;
+
+  LeafWriter(
+      const ColumnWriterOptions& options,
+      std::vector<std::string> path,
+      int16_t maxDefine,
+      thrift::Type::type type)
+      : LeafWriterBase(options, std::move(path), maxDefine, type),
+        values_(*options.pool),
+        ids_(*options.pool),
+        dictionaryValues_(*options.pool),
+        strings_(options.pool) {
+    resetChunk();
+  }
+
+  void write(const BaseVector* vector, const std::vector<Position>& positions)
+      override;
+
+ protected:
+  thrift::Encoding::type encodePageValues(DataBuffer<char>& out) override {
+    // A page of nulls before the first value needs no dictionary.
+    if (dictionaryMode_ && !dictionary_.empty()) {
+      const auto width =
+          bitWidth(std::max<int32_t>(dictionary_.size(), 1) - 1);
+      out.append(static_cast<char>(width));
+      encodeRleBp(ids_.data(), ids_.size(), width, out);
+      clearBuffer(ids_);
+      usedDictionary_ = true;
+      return thrift::Encoding::RLE_DICTIONARY;
+    }
+    appendBytes(out, values_.data(), values_.size());
+    clearBuffer(values_);
+    numBools_ = 0;
+    return thrift::Encoding::PLAIN;
+  }
+
+  int64_t pageValueBytes() const override {
+    if (dictionaryMode_) {
+      return ids_.size() * bitWidth(dictionary_.size()) / 8;
+    }
+    return values_.size();
+  }
+
+  int64_t valueBytes() const override {
+    return values_.size() + ids_.size() * sizeof(int32_t) +
+        dictionaryValues_.size();
+  }
+
+  std::optional<int32_t> encodeDictionary(DataBuffer<char>& out) override {
+    if (!usedDictionary_) {
+      return std::nullopt;
+    }
+    appendBytes(out, dictionaryValues_.data(), dictionaryValues_.size());
+    return dictionary_.size();
+  }
+
+  void addStatistics(thrift::Statistics& statistics) const override {
+    if (!hasMinMax_) {
+      return;
+    }
+    if constexpr (kIsString) {
+      statistics.__set_min_value(min_);
+      statistics.__set_max_value(max_);
+    } else {
+      statistics.__set_min_value(
+          std::string(reinterpret_cast<const char*>(&min_), sizeof(Stats)));
+      statistics.__set_max_value(
+          std::string(reinterpret_cast<const char*>(&max_), sizeof(Stats)));
+    }
+  }
+
+  void resetChunk() override {
+    dictionary_.clear();
+    clearBuffer(dictionaryValues_);
+    strings_.clear();
+    usedDictionary_ = false;
+    dictionaryMode_ =
+        options_.enableDictionary && kind != TypeKind::BOOLEAN;
+    hasMinMax_ = false;
+  }
+
+ private:
+  static Physical toPhysical(const T& value) {
+    if constexpr (kIsString) {
+      return std::string_view(value.data(), value.size());
+    } else {
+      return value;
+    }
+  }
+
+  static Key toKey(Physical value) {
+    if constexpr (std::is_floating_point_v<Physical>) {
+      Key key;
+      memcpy(&key, &value, sizeof(key));
+      return key;
+    } else {
+      return value;
+    }
+  }
+
+  static void appendPlain(Physical value, DataBuffer<char>& out) {
+    if constexpr (kIsString) {
+      const int32_t size = value.size();
+      appendBytes(out, &size, sizeof(size));
+      appendBytes(out, value.data(), size);
+    } else {
+      appendBytes(out, &value, sizeof(value));
+    }
+  }
+
+  void appendValue(Physical value) {
+    if constexpr (kind == TypeKind::BOOLEAN) {
+      if (numBools_ % 8 == 0) {
+        values_.append(0);
+      }
+      values_.data()[values_.size() - 1] |= value << (numBools_ % 8);
+      ++numBools_;
+    } else {
+      appendPlain(value, values_);
+      updateStats(value);
+    }
+  }
+
+  // Returns the dictionary id of 'value', adding it if it is new.
+  int32_t dictionaryId(Physical value) {
+    const auto it = dictionary_.find(toKey(value));
+    if (it != dictionary_.end()) {
+      return it->second;
+    }
+    const int32_t id = dictionary_.size();
+    if constexpr (kIsString) {
+      // The keys refer to copies of the values that live as long as the
+      // dictionary.
+      char* copy = nullptr;
+      if (!value.empty()) {
+        copy = strings_.allocateFixed(value.size());
+        memcpy(copy, value.data(), value.size());
+      }
+      value = std::string_view(copy, value.size());
+    }
+    dictionary_.emplace(toKey(value), id);
+    appendPlain(value, dictionaryValues_);
+    updateStats(value);
+    return id;
+  }
+
+  // Only the new dictionary entries update the statistics in the
+  // dictionary mode.
+  void updateStats(Physical value) {
+    if constexpr (std::is_floating_point_v<Physical>) {
+      if (std::isnan(value)) {
+        return;
+      }
+    }
+    if (!hasMinMax_) {
+      min_ = Stats(value);
+      max_ = Stats(value);
+      hasMinMax_ = true;
+    } else if (value < min_) {
+      min_ = Stats(value);
+    } else if (value > max_) {
+      max_ = Stats(value);
+    }
+  }
+
+  // Ends the current page as dictionary encoded and writes the next ones
+  // PLAIN encoded if the dictionary is over its size limit.
+  void checkDictionarySize() {
+    if (dictionaryMode_ &&
+        dictionaryValues_.size() > options_.dictionaryPageSizeLimit) {
+      finishPage();
+      dictionaryMode_ = false;
+    }
+  }
+
+  DecodedVector decoded_;
+  // PLAIN encoded values of the current page in the PLAIN mode.
+  DataBuffer<char> values_;
+  // Number of bits in 'values_' for BOOLEAN.
+  int32_t numBools_{0};
+  // Dictionary ids of the values of the current page in the dictionary mode.
+  DataBuffer<int32_t> ids_;
+  bool dictionaryMode_;
+  // True if a page of the chunk is dictionary encoded.
+  bool usedDictionary_;
+  folly::F14FastMap<Key, int32_t> dictionary_;
+  // PLAIN encoded dictionary entries in the order of their ids.
+  DataBuffer<char> dictionaryValues_;
+  // Copies of the string dictionary entries.
+  memory::AllocationPool strings_;
+  // Dictionary id of each row of the base of a dictionary encoded vector or
+  // -1 if not yet looked up.
+  std::vector<int32_t> baseIds_;
+  bool hasMinMax_;
+  Stats min_;
+  Stats max_;
+};
+
+template <TypeKind kind>
+void LeafWriter<kind>::write(
+    const BaseVector* vector,
+    const std::vector<Position>& positions) {
+  if (vector) {
+    decoded_.decode(*vector);
+  }
+  const int64_t numPositions = positions.size();
+  for (int64_t begin = 0; begin < numPositions; begin += kValuesPerPageCheck) {
+    const auto end =
+        std::min<int64_t>(begin + kValuesPerPageCheck, numPositions);
+    // A dictionary encoded vector is looked up in the page dictionary once
+    // per distinct index.
+    const bool idsByBase = dictionaryMode_ && vector &&
+        !decoded_.isIdentityMapping() &&
+        decoded_.base()->size() <= numPositions;
+    if (idsByBase && baseIds_.empty()) {
+      baseIds_.resize(decoded_.base()->size(), -1);
+    }
+    levels_.extend(end - begin);
+    for (auto i = begin; i < end; ++i) {
+      const auto& position = positions[i];
+      if (position.row == kNullRow) {
+        levels_.unsafeAppend(position.level);
+        continue;
+      }
+      if (decoded_.isNullAt(position.row)) {
+        levels_.unsafeAppend(maxDefine_ - 1);
+        ++nullCount_;
+        continue;
+      }
+      levels_.unsafeAppend(maxDefine_);
+      if (!dictionaryMode_) {
+        appendValue(toPhysical(decoded_.valueAt<T>(position.row)));
+      } else if (idsByBase) {
+        auto& id = baseIds_[decoded_.index(position.row)];
+        if (id < 0) {
+          id = dictionaryId(toPhysical(decoded_.valueAt<T>(position.row)));
+        }
+        ids_.append(id);
+      } else {
+        ids_.append(
+            dictionaryId(toPhysical(decoded_.valueAt<T>(position.row))));
+      }
+    }
+    checkDictionarySize();
+    checkPageSize();
+  }
+  baseIds_.clear();
+}
+
+template <TypeKind kind>
+std::unique_ptr<NativeColumnWriter> makeLeafWriter(
+    const ColumnWriterOptions& options,
+    std::vector<std::string> path,
+    int16_t maxDefine,
+    thrift::Type::type type) {
+  return std::make_unique<LeafWriter<kind>>(
+      options, std::move(path), maxDefine, type);
+}
+
+std::unique_ptr<NativeColumnWriter> createColumnWriter(
+    const TypePtr& type,
+    const std::string& name,
+    std::vector<std::string> path,
+    int16_t level,
+    const ColumnWriterOptions& options,
+    std::vector<thrift::SchemaElement>& schema) {
+  if (type->isRow()) {
+    if (level > 0) {
+      thrift::SchemaElement element;
+      element.__set_name(name);
+      element.__set_repetition_type(thrift::FieldRepetitionType::OPTIONAL);
+      element.__set_num_children(type->size());
+      schema.push_back(std::move(element));
+    }
+    std::vector<std::unique_ptr<NativeColumnWriter>> children;
+    const auto& rowType = type->asRow();
+    for (auto i = 0; i < rowType.size(); ++i) {
+      auto childPath = path;
+      childPath.push_back(rowType.nameOf(i));
+      children.push_back(createColumnWriter(
+          rowType.childAt(i),
+          rowType.nameOf(i),
+          std::move(childPath),
+          level + 1,
+          options,
+          schema));
+    }
+    return std::make_unique<StructWriter>(level, std::move(children));
+  }
+  schema.push_back(makeLeafSchema(type, name));
+  const auto physicalType = schema.back().type;
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      return makeLeafWriter<TypeKind::BOOLEAN>(
+          options, std::move(path), level, physicalType);
+    case TypeKind::TINYINT:
+      return makeLeafWriter<TypeKind::TINYINT>(
+          options, std::move(path), level, physicalType);
+    case TypeKind::SMALLINT:
+      return makeLeafWriter<TypeKind::SMALLINT>(
+          options, std::move(path), level, physicalType);
+    case TypeKind::INTEGER:
+      return makeLeafWriter<TypeKind::INTEGER>(
+          options, std::move(path), level, physicalType);
+    case TypeKind::BIGINT:
+      return makeLeafWriter<TypeKind::BIGINT>(
+          options, std::move(path), level, physicalType);
+    case TypeKind::REAL:
+      return makeLeafWriter<TypeKind::REAL>(
+          options, std::move(path), level, physicalType);
+    case TypeKind::DOUBLE:
+      return makeLeafWriter<TypeKind::DOUBLE>(
+          options, std::move(path), level, physicalType);
+    case TypeKind::VARCHAR:
+      return makeLeafWriter<TypeKind::VARCHAR>(
+          options, std::move(path), level, physicalType);
+    case TypeKind::VARBINARY:
+      return makeLeafWriter<TypeKind::VARBINARY>(
+          options, std::move(path), level, physicalType);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+} // namespace
+
+NativeWriter::NativeWriter(
+    std::unique_ptr<dwio::common::FileSink> sink,
+    const WriterOptions& options,
+    std::shared_ptr<memory::MemoryPool> pool)
+    : pool_(std::move(pool)),
+      generalPool_{pool_->addLeafChild(".general")},
+      options_(options),
+      sink_(std::move(sink)) {
+  VELOX_CHECK(
+      options_.encoding == arrow::Encoding::PLAIN,
+      "The native Parquet writer only supports the PLAIN and dictionary "
+      "encodings");
+  if (options_.flushPolicyFactory) {
+    flushPolicy_ = options_.flushPolicyFactory();
+  } else {
+    flushPolicy_ = std::make_unique<DefaultFlushPolicy>();
+  }
+  // Fails on unsupported codecs.
+  toThriftCodec(options_.compression);
+  if (options_.compression != common::CompressionKind_NONE) {
+    codec_ = common::compressionKindToCodec(options_.compression);
+  }
+}
+
+NativeWriter::NativeWriter(
+    std::unique_ptr<dwio::common::FileSink> sink,
+    const WriterOptions& options)
+    : NativeWriter{
+          std::move(sink),
+          options,
+          options.memoryPool->addAggregateChild(fmt::format(
+              "writer_node_{}",
+              folly::to<std::string>(folly::Random::rand64())))} {}
+
+NativeWriter::~NativeWriter() = default;
+
+// static
+bool NativeWriter::isSupported(
+    const TypePtr& type,
+    const WriterOptions& options) {
+  switch (options.compression) {
+    case common::CompressionKind_NONE:
+    case common::CompressionKind_SNAPPY:
+    case common::CompressionKind_GZIP:
+    case common::CompressionKind_ZSTD:
+      break;
+    default:
+      return false;
+  }
+  return options.encoding == arrow::Encoding::PLAIN && type->isRow() &&
+      isSupportedType(*type);
+}
+
+void NativeWriter::initialize(const TypePtr& type) {
+  VELOX_USER_CHECK(
+      isSupported(type, options_),
+      "Unsupported type for the native Parquet writer: {}",
+      type->toString());
+  thrift::SchemaElement root;
+  root.__set_name("schema");
+  root.__set_repetition_type(thrift::FieldRepetitionType::REQUIRED);
+  root.__set_num_children(type->size());
+  schema_.push_back(std::move(root));
+  const ColumnWriterOptions columnOptions{
+      generalPool_.get(),
+      options_.enableDictionary,
+      options_.dataPageSize,
+      options_.dictionaryPageSizeLimit,
+      codec_.get(),
+      toThriftCodec(options_.compression)};
+  root_ = createColumnWriter(type, "", {}, 0, columnOptions, schema_);
+}
+
+int64_t NativeWriter::bufferedBytes() const {
+  return root_ ? root_->bufferedBytes() : 0;
+}
+
+void NativeWriter::write(const VectorPtr& data) {
+  VELOX_CHECK(!closed_, "Parquet writer is closed");
+  if (!root_) {
+    initialize(data->type());
+  }
+  if (flushPolicy_->shouldFlush(dwio::common::StripeProgress{
+          .stripeRowCount = stagingRows_,
+          .stripeSizeEstimate = bufferedBytes()})) {
+    flush();
+  }
+  // The rows past the row group size go to the next row groups.
+  const auto rowsInRowGroup = flushPolicy_->rowsInRowGroup();
+  std::vector<NativeColumnWriter::Position> positions;
+  vector_size_t offset = 0;
+  while (offset < data->size()) {
+    if (stagingRows_ >= rowsInRowGroup) {
+      flush();
+    }
+    const auto numRows = std::min<uint64_t>(
+        data->size() - offset, rowsInRowGroup - stagingRows_);
+    positions.resize(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      positions[i] = {static_cast<vector_size_t>(offset + i), 0};
+    }
+    root_->write(data.get(), positions);
+    stagingRows_ += numRows;
+    offset += numRows;
+  }
+}
+
+void NativeWriter::flush() {
+  if (stagingRows_ == 0) {
+    return;
+  }
+  std::vector<DataBuffer<char>> buffers;
+  if (bytesWritten_ == 0) {
+    DataBuffer<char> magic(*generalPool_);
+    appendBytes(magic, kMagic.data(), kMagic.size());
+    buffers.push_back(std::move(magic));
+    bytesWritten_ = kMagic.size();
+  }
+  int64_t offset = bytesWritten_;
+  std::vector<thrift::ColumnChunk> columns;
+  root_->flush(offset, buffers, columns);
+  int64_t uncompressedBytes = 0;
+  for (const auto& column : columns) {
+    uncompressedBytes += column.meta_data.total_uncompressed_size;
+  }
+  thrift::RowGroup rowGroup;
+  rowGroup.__set_columns(columns);
+  rowGroup.__set_num_rows(stagingRows_);
+  rowGroup.__set_total_byte_size(uncompressedBytes);
+  rowGroup.__set_file_offset(bytesWritten_);
+  rowGroup.__set_total_compressed_size(offset - bytesWritten_);
+  rowGroups_.push_back(std::move(rowGroup));
+  sink_->write(buffers);
+  bytesWritten_ = offset;
+  numRows_ += stagingRows_;
+  stagingRows_ = 0;
+}
+
+void NativeWriter::close() {
+  VELOX_CHECK(!closed_, "Parquet writer is closed");
+  flush();
+  // Like the Arrow based writer, a writer without rows leaves the sink empty
+  // since it does not know the schema.
+  if (root_) {
+    std::vector<DataBuffer<char>> buffers;
+    DataBuffer<char> footer(*generalPool_);
+    if (bytesWritten_ == 0) {
+      appendBytes(footer, kMagic.data(), kMagic.size());
+    }
+    thrift::FileMetaData metaData;
+    metaData.__set_version(1);
+    metaData.__set_schema(schema_);
+    metaData.__set_num_rows(numRows_);
+    metaData.__set_row_groups(rowGroups_);
+    metaData.__set_created_by("velox");
+    // The statistics are in the order of the physical types, signed for
+    // integers and unsigned bytewise for strings.
+    std::vector<thrift::ColumnOrder> columnOrders;
+    for (const auto& element : schema_) {
+      if (element.__isset.type) {
+        thrift::ColumnOrder order;
+        order.__set_TYPE_ORDER(thrift::TypeDefinedOrder());
+        columnOrders.push_back(std::move(order));
+      }
+    }
+    metaData.__set_column_orders(columnOrders);
+    const auto footerStart = footer.size();
+    serialize(metaData, footer);
+    const int32_t footerSize = footer.size() - footerStart;
+    appendBytes(footer, &footerSize, sizeof(footerSize));
+    appendBytes(footer, kMagic.data(), kMagic.size());
+    buffers.push_back(std::move(footer));
+    sink_->write(buffers);
+  }
+  sink_->close();
+  root_.reset();
+  closed_ = true;
+}
+
+void NativeWriter::abort() {
+  sink_.reset();
+  root_.reset();
+  closed_ = true;
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <gflags/gflags.h>
+
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/common/Writer.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+#include "velox/vector/ComplexVector.h"
+
+DECLARE_bool(velox_parquet_native_writer);
+
+namespace facebook::velox::parquet {
+
+namespace thrift {
+class RowGroup;
+class SchemaElement;
+} // namespace thrift
+
+class NativeColumnWriter;
+
+/// Writes Velox vectors into a Parquet file without converting them to Arrow.
+/// The values are encoded directly from the vectors, whatever their encoding.
+/// Dictionary vectors are written with the dictionary encoding by mapping each
+/// distinct index of the vector to the page dictionary once instead of hashing
+/// every row.
+///
+/// Supports top level and nested ROW columns of BOOLEAN, TINYINT, SMALLINT,
+/// INTEGER, DATE, BIGINT, REAL, DOUBLE, VARCHAR and VARBINARY, the PLAIN and
+/// dictionary encodings, and the NONE, SNAPPY, GZIP and ZSTD codecs. See
+/// isSupported(). The data pages are version 1 pages. Row groups are formed
+/// with the flush policy of WriterOptions and are buffered in memory from the
+/// pool of the writer until they are flushed.
+class NativeWriter : public dwio::common::Writer {
+ public:
+  NativeWriter(
+      std::unique_ptr<dwio::common::FileSink> sink,
+      const WriterOptions& options,
+      std::shared_ptr<memory::MemoryPool> pool);
+
+  NativeWriter(
+      std::unique_ptr<dwio::common::FileSink> sink,
+      const WriterOptions& options);
+
+  ~NativeWriter() override;
+
+  /// Returns true if rows of 'type' can be written with 'options'.
+  static bool isSupported(const TypePtr& type, const WriterOptions& options);
+
+  /// Appends 'data', a RowVector of the same type for all calls. Starts a new
+  /// row group when the flush policy says so.
+  void write(const VectorPtr& data) override;
+
+  /// Writes the buffered rows as a row group.
+  void flush() override;
+
+  /// Flushes the buffered rows, writes the footer and closes the sink.
+  void close() override;
+
+  void abort() override;
+
+ private:
+  // Creates the column writers and the schema for rows of 'type'.
+  void initialize(const TypePtr& type);
+
+  // Bytes buffered for the current row group.
+  int64_t bufferedBytes() const;
+
+  const std::shared_ptr<memory::MemoryPool> pool_;
+  const std::shared_ptr<memory::MemoryPool> generalPool_;
+  const WriterOptions options_;
+  std::unique_ptr<dwio::common::FileSink> sink_;
+  std::unique_ptr<DefaultFlushPolicy> flushPolicy_;
+  std::unique_ptr<folly::io::Codec> codec_;
+
+  // Writer of the top level row. nullptr before the first write().
+  std::unique_ptr<NativeColumnWriter> root_;
+  std::vector<thrift::SchemaElement> schema_;
+  std::vector<thrift::RowGroup> rowGroups_;
+
+  // Bytes written to 'sink_'.
+  int64_t bytesWritten_{0};
+  int64_t numRows_{0};
+  // Rows in the current row group.
+  uint64_t stagingRows_{0};
+  bool closed_{false};
+};
+
+} // namespace facebook::velox::parquet
@@ -21,6 +21,7 @@
 #include <arrow/table.h>
 
 #include "velox/dwio/parquet/writer/Writer.h"
+#include "velox/dwio/parquet/writer/NativeWriter.h"
 #include "velox/dwio/parquet/writer/arrow/Properties.h"
 #include "velox/dwio/parquet/writer/arrow/Writer.h"
 
@@ -132,7 +133,11 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
   }
   properties =
       properties->compression(getArrowParquetCompression(options.compression));
+  properties = properties->encoding(options.encoding);
   properties = properties->data_pagesize(options.dataPageSize);
+  if (options.writePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
   properties = properties->max_row_group_length(
       static_cast<int64_t>(flushPolicy->rowsInRowGroup()));
   return properties->build();
@@ -293,6 +298,10 @@ std::unique_ptr<dwio::common::Writer> ParquetWriterFactory::createWriter(
     std::unique_ptr<dwio::common::FileSink> sink,
     const dwio::common::WriterOptions& options) {
   auto parquetOptions = getParquetOptions(options);
+  if (FLAGS_velox_parquet_native_writer && options.schema &&
+      NativeWriter::isSupported(options.schema, parquetOptions)) {
+    return std::make_unique<NativeWriter>(std::move(sink), parquetOptions);
+  }
   return std::make_unique<Writer>(std::move(sink), parquetOptions);
 }
 
@@ -23,6 +23,7 @@
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/Writer.h"
 #include "velox/dwio/common/WriterFactory.h"
+#include "velox/dwio/parquet/writer/arrow/Types.h"
 #include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox::parquet {
@@ -90,6 +91,11 @@ struct WriterOptions {
   // folly/FBVector(https://github.com/facebook/folly/blob/main/folly/docs/FBVector.md#memory-handling).
   double bufferGrowRatio = 1.5;
   common::CompressionKind compression = common::CompressionKind_NONE;
+  // Encoding of the columns that are not dictionary encoded.
+  arrow::Encoding::type encoding = arrow::Encoding::PLAIN;
+  // Writes the ColumnIndex and OffsetIndex of the column chunks, which let
+  // readers skip pages that do not match filters.
+  bool writePageIndex = false;
   velox::memory::MemoryPool* memoryPool;
   // The default factory allows the writer to construct the default flush
   // policy with the configs in its ctor.
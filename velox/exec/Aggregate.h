@@ -85,6 +85,11 @@ class Aggregate {
     return false;
   }
 
+  /// Returns true if addDenseInput() is supported.
+  virtual bool supportsDenseAccumulators() const {
+    return false;
+  }
+
   void setAllocator(HashStringAllocator* allocator) {
     setAllocatorInternal(allocator);
   }
@@ -237,6 +242,27 @@ class Aggregate {
     VELOX_NYI("toIntermediate not supported");
   }
 
+  /// Updates accumulators kept in a flat vector of the intermediate type with
+  /// one entry per group instead of in the rows of a RowContainer. Used by
+  /// group by on a small integer key domain, where the groups are indexed
+  /// directly by key value. Each accumulator starts null with a zero value.
+  /// The intermediate result of a group is then the entry of the group in
+  /// 'accumulators' as if produced by extractAccumulators().
+  ///
+  /// @param groupIndices The index in 'accumulators' of the group of each row
+  /// in 'rows'.
+  /// @param rows Rows of 'args' to add to the accumulators.
+  /// @param args Raw input if 'isRawInput', intermediate results otherwise.
+  /// @param accumulators Writable flat vector of accumulators.
+  virtual void addDenseInput(
+      const vector_size_t* /*groupIndices*/,
+      const SelectivityVector& /*rows*/,
+      const std::vector<VectorPtr>& /*args*/,
+      bool /*isRawInput*/,
+      BaseVector& /*accumulators*/) {
+    VELOX_NYI("addDenseInput not supported");
+  }
+
   // Frees any out of line storage for the accumulator in
   // 'groups'. No-op for fixed length accumulators.
   virtual void destroy(folly::Range<char**> /*groups*/) {}
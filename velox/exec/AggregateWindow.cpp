@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/AggregateWindow.h"
+#include <deque>
 #include "velox/common/base/Exceptions.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/WindowFunction.h"
@@ -29,6 +30,10 @@ namespace {
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
 // to frameEnd boundaries at that row using singleGroup.
+// count, sum, avg, min and max over integer arguments are instead computed
+// over a sliding frame: rows entering the frame are added and rows leaving it
+// are retracted, so that moving frames like ROWS BETWEEN k PRECEDING AND
+// CURRENT ROW cost O(1) amortized per row instead of O(k).
 class AggregateWindowFunction : public exec::WindowFunction {
  public:
   AggregateWindowFunction(
@@ -99,6 +104,8 @@ class AggregateWindowFunction : public exec::WindowFunction {
     aggregateResultVector_ = BaseVector::create(resultType, 1, pool_);
 
     computeDefaultAggregateValue(resultType);
+
+    slidingAggregate_ = slidingAggregateFor(name, args, resultType);
   }
 
   ~AggregateWindowFunction() {
@@ -114,6 +121,7 @@ class AggregateWindowFunction : public exec::WindowFunction {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    clearSlidingWindow();
   }
 
   void apply(
@@ -134,7 +142,16 @@ class AggregateWindowFunction : public exec::WindowFunction {
     FrameMetadata frameMetadata =
         analyzeFrameValues(validRows, rawFrameStarts, rawFrameEnds);
 
-    if (frameMetadata.incrementalAggregation) {
+    if (slidingAggregate_ != SlidingAggregate::kNone) {
+      fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
+      slidingAggregation(
+          validRows,
+          frameMetadata.firstRow,
+          rawFrameStarts,
+          rawFrameEnds,
+          resultOffset,
+          result);
+    } else if (frameMetadata.incrementalAggregation) {
       vector_size_t startRow;
       if (frameMetadata.usePreviousAggregate) {
         // If incremental aggregation can be resumed from the previous block,
@@ -176,6 +193,68 @@ class AggregateWindowFunction : public exec::WindowFunction {
   }
 
  private:
+  // Aggregates computed over a sliding frame instead of with 'aggregate_'.
+  enum class SlidingAggregate {
+    kNone,
+    // count(*), i.e. the number of rows in the frame.
+    kCountAll,
+    kCount,
+    kSum,
+    kAvg,
+    kMin,
+    kMax,
+  };
+
+  static bool isSlidingArgType(const TypePtr& type) {
+    switch (type->kind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+        return true;
+      case TypeKind::BIGINT:
+        return !type->isDecimal();
+      default:
+        return false;
+    }
+  }
+
+  // Returns the sliding frame implementation for the aggregate 'name' over
+  // 'args', or kNone if the aggregate must go through 'aggregate_'. Constant
+  // arguments and non-integer types are left to 'aggregate_': floating point
+  // sums are not exactly invertible and min/max would need NaN ordering.
+  static SlidingAggregate slidingAggregateFor(
+      const std::string& name,
+      const std::vector<exec::WindowFunctionArg>& args,
+      const TypePtr& resultType) {
+    if (name == "count" && args.empty()) {
+      return SlidingAggregate::kCountAll;
+    }
+    if (args.size() != 1 || args[0].constantValue) {
+      return SlidingAggregate::kNone;
+    }
+    if (name == "count") {
+      return SlidingAggregate::kCount;
+    }
+    if (!isSlidingArgType(args[0].type)) {
+      return SlidingAggregate::kNone;
+    }
+    if (name == "sum" && resultType->kind() == TypeKind::BIGINT) {
+      return SlidingAggregate::kSum;
+    }
+    if (name == "avg" && resultType->kind() == TypeKind::DOUBLE) {
+      return SlidingAggregate::kAvg;
+    }
+    if (resultType->equivalent(*args[0].type)) {
+      if (name == "min") {
+        return SlidingAggregate::kMin;
+      }
+      if (name == "max") {
+        return SlidingAggregate::kMax;
+      }
+    }
+    return SlidingAggregate::kNone;
+  }
+
   struct FrameMetadata {
     // Min frame start row required for aggregation.
     vector_size_t firstRow;
@@ -343,6 +422,192 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  // Computes the results for 'validRows' by moving the sliding window from
+  // the previous frame to each frame in turn. 'firstRow' is the partition row
+  // at position 0 of 'argVectors_'.
+  void slidingAggregation(
+      const SelectivityVector& validRows,
+      vector_size_t firstRow,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    switch (slidingAggregate_ == SlidingAggregate::kCountAll
+                ? TypeKind::BIGINT
+                : argTypes_[0]->kind()) {
+      case TypeKind::TINYINT:
+        slidingAggregation<int8_t>(
+            validRows,
+            firstRow,
+            rawFrameStarts,
+            rawFrameEnds,
+            resultOffset,
+            result);
+        break;
+      case TypeKind::SMALLINT:
+        slidingAggregation<int16_t>(
+            validRows,
+            firstRow,
+            rawFrameStarts,
+            rawFrameEnds,
+            resultOffset,
+            result);
+        break;
+      case TypeKind::INTEGER:
+        slidingAggregation<int32_t>(
+            validRows,
+            firstRow,
+            rawFrameStarts,
+            rawFrameEnds,
+            resultOffset,
+            result);
+        break;
+      default:
+        // count(x) only looks at the nulls of x, so any type works here.
+        slidingAggregation<int64_t>(
+            validRows,
+            firstRow,
+            rawFrameStarts,
+            rawFrameEnds,
+            resultOffset,
+            result);
+        break;
+    }
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
+  template <typename T>
+  void slidingAggregation(
+      const SelectivityVector& validRows,
+      vector_size_t firstRow,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    const BaseVector* arg = nullptr;
+    const T* rawValues = nullptr;
+    if (slidingAggregate_ != SlidingAggregate::kCountAll) {
+      arg = argVectors_[0].get();
+      if (slidingAggregate_ != SlidingAggregate::kCount) {
+        rawValues = arg->asUnchecked<FlatVector<T>>()->rawValues();
+      }
+    }
+
+    validRows.applyToSelected([&](auto i) {
+      const auto frameStart = rawFrameStarts[i];
+      const auto frameEnd = rawFrameEnds[i];
+      const auto resultRow = resultOffset + i;
+      if (slidingAggregate_ == SlidingAggregate::kCountAll) {
+        result->asFlatVector<int64_t>()->set(
+            resultRow, frameEnd - frameStart + 1);
+        return;
+      }
+      slideWindow(frameStart, frameEnd, firstRow, arg, rawValues);
+      setSlidingResult<T>(resultRow, result);
+    });
+  }
+
+  // Moves the window from ['windowStart_', 'windowEnd_'] to ['frameStart',
+  // 'frameEnd']. Frames of a partition usually only move forward. If this one
+  // moves backward the window is rebuilt from scratch.
+  template <typename T>
+  void slideWindow(
+      vector_size_t frameStart,
+      vector_size_t frameEnd,
+      vector_size_t firstRow,
+      const BaseVector* arg,
+      const T* rawValues) {
+    if (frameStart < windowStart_ || frameEnd < windowEnd_) {
+      clearSlidingWindow();
+    }
+
+    // Retract the rows that left the frame.
+    const bool isSum = slidingAggregate_ == SlidingAggregate::kSum ||
+        slidingAggregate_ == SlidingAggregate::kAvg;
+    while (!window_.empty() && window_.front().first < frameStart) {
+      if (isSum) {
+        windowSum_ -= window_.front().second;
+      }
+      window_.pop_front();
+    }
+    windowStart_ = frameStart;
+
+    // Add the rows that entered the frame.
+    for (auto row = std::max(windowEnd_ + 1, frameStart); row <= frameEnd;
+         ++row) {
+      const auto index = row - firstRow;
+      if (arg->isNullAt(index)) {
+        continue;
+      }
+      const int64_t value = rawValues ? rawValues[index] : 0;
+      switch (slidingAggregate_) {
+        case SlidingAggregate::kMin:
+          // Keeps the values increasing from front to back so that the front
+          // is the min of the frame.
+          while (!window_.empty() && window_.back().second >= value) {
+            window_.pop_back();
+          }
+          break;
+        case SlidingAggregate::kMax:
+          while (!window_.empty() && window_.back().second <= value) {
+            window_.pop_back();
+          }
+          break;
+        default:
+          if (isSum) {
+            windowSum_ += value;
+          }
+          break;
+      }
+      window_.emplace_back(row, value);
+    }
+    windowEnd_ = frameEnd;
+  }
+
+  template <typename T>
+  void setSlidingResult(vector_size_t resultRow, const VectorPtr& result) {
+    if (slidingAggregate_ == SlidingAggregate::kCount) {
+      result->asFlatVector<int64_t>()->set(resultRow, window_.size());
+      return;
+    }
+    if (window_.empty()) {
+      result->setNull(resultRow, true);
+      return;
+    }
+    switch (slidingAggregate_) {
+      case SlidingAggregate::kSum:
+        if (windowSum_ > std::numeric_limits<int64_t>::max() ||
+            windowSum_ < std::numeric_limits<int64_t>::min()) {
+          VELOX_ARITHMETIC_ERROR("integer overflow in sum over window frame");
+        }
+        result->asFlatVector<int64_t>()->set(
+            resultRow, static_cast<int64_t>(windowSum_));
+        break;
+      case SlidingAggregate::kAvg:
+        result->asFlatVector<double>()->set(
+            resultRow,
+            static_cast<double>(windowSum_) /
+                static_cast<double>(window_.size()));
+        break;
+      case SlidingAggregate::kMin:
+      case SlidingAggregate::kMax:
+        result->asFlatVector<T>()->set(
+            resultRow, static_cast<T>(window_.front().second));
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+
+  void clearSlidingWindow() {
+    window_.clear();
+    windowSum_ = 0;
+    windowStart_ = 0;
+    windowEnd_ = -1;
+  }
+
   // Precompute and save the aggregate output for empty input in emptyResult_.
   // This value is returned for rows with empty frames.
   void computeDefaultAggregateValue(const TypePtr& resultType) {
@@ -391,6 +656,20 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // return the default value of an aggregate (aggregation with no rows) for
   // empty frames. e.g. count for empty frames should return 0 and not null.
   VectorPtr emptyResult_;
+
+  SlidingAggregate slidingAggregate_{SlidingAggregate::kNone};
+
+  // The sliding window state. The window covers the partition rows from
+  // 'windowStart_' to 'windowEnd_'. 'window_' holds the partition row number
+  // and value of the non-null rows in the window, in row order. For min and
+  // max it only holds the rows that can still become the min or max of a
+  // later frame. 'windowSum_' is the sum of the values in 'window_' for sum
+  // and avg. It is kept in 128 bits so that it cannot overflow before the
+  // result is checked.
+  std::deque<std::pair<vector_size_t, int64_t>> window_;
+  int128_t windowSum_{0};
+  vector_size_t windowStart_{0};
+  vector_size_t windowEnd_{-1};
 };
 
 } // namespace
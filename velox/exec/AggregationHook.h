@@ -35,6 +35,15 @@ class AggregationHook : public ValueHook {
   static constexpr Kind kFloatMin = 8;
   static constexpr Kind kDoubleMax = 9;
   static constexpr Kind kDoubleMin = 10;
+  static constexpr Kind kSumSmallintToBigint = 11;
+  static constexpr Kind kSumTinyintToBigint = 12;
+  static constexpr Kind kIntegerMax = 13;
+  static constexpr Kind kIntegerMin = 14;
+  static constexpr Kind kSmallintMax = 15;
+  static constexpr Kind kSmallintMin = 16;
+  static constexpr Kind kTinyintMax = 17;
+  static constexpr Kind kTinyintMin = 18;
+  static constexpr Kind kCount = 19;
 
   // Make null behavior known at compile time. This is useful when
   // templating a column decoding loop with a hook.
@@ -131,6 +140,12 @@ class SumHook final : public AggregationHook {
       if (std::is_same_v<TValue, int32_t>) {
         return kSumIntegerToBigint;
       }
+      if (std::is_same_v<TValue, int16_t>) {
+        return kSumSmallintToBigint;
+      }
+      if (std::is_same_v<TValue, int8_t>) {
+        return kSumTinyintToBigint;
+      }
       if (std::is_same_v<TValue, int64_t>) {
         return kSumBigintToBigint;
       }
@@ -192,6 +207,15 @@ class MinMaxHook final : public AggregationHook {
       if (std::is_same_v<T, int64_t>) {
         return kBigintMin;
       }
+      if (std::is_same_v<T, int32_t>) {
+        return kIntegerMin;
+      }
+      if (std::is_same_v<T, int16_t>) {
+        return kSmallintMin;
+      }
+      if (std::is_same_v<T, int8_t>) {
+        return kTinyintMin;
+      }
       if (std::is_same_v<T, float>) {
         return kFloatMin;
       }
@@ -202,6 +226,15 @@ class MinMaxHook final : public AggregationHook {
       if (std::is_same_v<T, int64_t>) {
         return kBigintMax;
       }
+      if (std::is_same_v<T, int32_t>) {
+        return kIntegerMax;
+      }
+      if (std::is_same_v<T, int16_t>) {
+        return kSmallintMax;
+      }
+      if (std::is_same_v<T, int8_t>) {
+        return kTinyintMax;
+      }
       if (std::is_same_v<T, float>) {
         return kFloatMax;
       }
@@ -223,4 +256,35 @@ class MinMaxHook final : public AggregationHook {
   }
 };
 
+/// Counts the non-null values of a column. The value is not read, so the same
+/// hook serves all column types. The count is never null.
+class CountHook final : public AggregationHook {
+ public:
+  CountHook(
+      int32_t offset,
+      int32_t nullByte,
+      uint8_t nullMask,
+      char** groups,
+      uint64_t* numNulls)
+      : AggregationHook(offset, nullByte, nullMask, groups, numNulls) {}
+
+  Kind kind() const override {
+    return kCount;
+  }
+
+  void addValue(vector_size_t row, const void* /*value*/) override {
+    ++*reinterpret_cast<int64_t*>(findGroup(row) + offset_);
+  }
+
+  void addValues(
+      const vector_size_t* rows,
+      const void* /*values*/,
+      vector_size_t size,
+      uint8_t /*valueWidth*/) override {
+    for (auto i = 0; i < size; ++i) {
+      ++*reinterpret_cast<int64_t*>(findGroup(rows[i]) + offset_);
+    }
+  }
+};
+
 } // namespace facebook::velox::aggregate
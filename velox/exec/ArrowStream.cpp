@@ -14,20 +14,37 @@
  * limitations under the License.
  */
 #include "velox/exec/ArrowStream.h"
+#include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
 
+namespace {
+folly::Executor* prefetchExecutor(DriverCtx* driverCtx) {
+  if (driverCtx->queryConfig().arrowStreamMaxPrefetchBytes() == 0) {
+    return nullptr;
+  }
+  return driverCtx->task->queryCtx()->executor();
+}
+} // namespace
+
 ArrowStream::ArrowStream(
     int32_t operatorId,
     DriverCtx* driverCtx,
-    const std::shared_ptr<const core::ArrowStreamNode>& arrowStreamNode)
+    const std::shared_ptr<const core::ArrowStreamNode>& arrowStreamNode,
+    uint32_t numDrivers)
     : SourceOperator(
           driverCtx,
           arrowStreamNode->outputType(),
           operatorId,
           arrowStreamNode->id(),
-          "ArrowStream") {
-  arrowStream_ = arrowStreamNode->arrowStream();
+          "ArrowStream"),
+      maxPrefetchBytes_(driverCtx->queryConfig().arrowStreamMaxPrefetchBytes()),
+      executor_(prefetchExecutor(driverCtx)) {
+  const auto& streams = arrowStreamNode->arrowStreams();
+  VELOX_CHECK_GT(numDrivers, 0);
+  for (auto i = driverCtx->partitionId; i < streams.size(); i += numDrivers) {
+    arrowStreams_.push_back(streams[i]);
+  }
 }
 
 ArrowStream::~ArrowStream() {
@@ -35,53 +52,174 @@ ArrowStream::~ArrowStream() {
 }
 
 RowVectorPtr ArrowStream::getOutput() {
-  // Get Arrow array.
-  struct ArrowArray arrowArray;
-  if (arrowStream_->get_next(arrowStream_.get(), &arrowArray)) {
-    if (arrowArray.release) {
-      arrowArray.release(&arrowArray);
-    }
-    VELOX_FAIL(
-        "Failed to call get_next on ArrowStream: {}", std::string(getError()));
+  if (executor_ == nullptr) {
+    auto batch = readNext();
+    finished_ = batch == nullptr;
+    return batch;
+  }
+
+  std::lock_guard<std::mutex> l(mutex_);
+  if (error_) {
+    std::rethrow_exception(error_);
   }
-  if (arrowArray.release == nullptr) {
-    // End of Stream.
-    finished_ = true;
+  if (queue_.empty()) {
+    finished_ = atEnd_;
+    maybeStartPrefetchLocked();
     return nullptr;
   }
+  auto [batch, bytes] = std::move(queue_.front());
+  queue_.pop_front();
+  queuedBytes_ -= bytes;
+  maybeStartPrefetchLocked();
+  return batch;
+}
+
+BlockingReason ArrowStream::isBlocked(ContinueFuture* future) {
+  if (executor_ == nullptr) {
+    return BlockingReason::kNotBlocked;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (!queue_.empty() || atEnd_ || error_) {
+    return BlockingReason::kNotBlocked;
+  }
+  maybeStartPrefetchLocked();
+  consumerPromise_ = ContinuePromise("ArrowStream::isBlocked");
+  *future = consumerPromise_->getSemiFuture();
+  return BlockingReason::kWaitForProducer;
+}
+
+void ArrowStream::maybeStartPrefetchLocked() {
+  if (prefetching_ || atEnd_ || error_ || closed_ ||
+      queuedBytes_ >= maxPrefetchBytes_) {
+    return;
+  }
+  auto* driver = operatorCtx_->driver();
+  VELOX_CHECK_NOT_NULL(driver);
+  prefetching_ = true;
+  auto [promise, future] =
+      makeVeloxContinuePromiseContract("ArrowStream::prefetch");
+  prefetchFuture_ = std::move(future);
+  // NOTE: the driver reference keeps this operator alive until the prefetch
+  // completes.
+  executor_->add([this,
+                  driverRef = driver->shared_from_this(),
+                  promise = std::move(promise)]() mutable {
+    prefetch();
+    promise.setValue();
+  });
+}
 
-  // Get Arrow schema.
-  struct ArrowSchema arrowSchema;
-  if (arrowStream_->get_schema(arrowStream_.get(), &arrowSchema)) {
-    if (arrowSchema.release) {
-      arrowSchema.release(&arrowSchema);
+void ArrowStream::prefetch() {
+  for (;;) {
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (closed_ || queuedBytes_ >= maxPrefetchBytes_) {
+        prefetching_ = false;
+        return;
+      }
+    }
+    RowVectorPtr batch;
+    std::exception_ptr error;
+    try {
+      batch = readNext();
+    } catch (const std::exception&) {
+      error = std::current_exception();
+    }
+    std::optional<ContinuePromise> promise;
+    bool done = false;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (error) {
+        error_ = error;
+        done = true;
+      } else if (batch == nullptr) {
+        atEnd_ = true;
+        done = true;
+      } else {
+        const auto bytes = batch->estimateFlatSize();
+        queuedBytes_ += bytes;
+        queue_.emplace_back(std::move(batch), bytes);
+      }
+      if (done) {
+        prefetching_ = false;
+      }
+      promise.swap(consumerPromise_);
+    }
+    if (promise.has_value()) {
+      promise->setValue();
     }
-    if (arrowArray.release) {
-      arrowArray.release(&arrowArray);
+    if (done) {
+      return;
     }
-    VELOX_FAIL(
-        "Failed to call get_schema on ArrowStream: {}",
-        std::string(getError()));
   }
+}
+
+RowVectorPtr ArrowStream::readNext() {
+  while (streamIndex_ < arrowStreams_.size()) {
+    auto* arrowStream = arrowStreams_[streamIndex_].get();
 
-  // Convert Arrow Array into RowVector and return.
-  return std::dynamic_pointer_cast<RowVector>(
-      importFromArrowAsOwner(arrowSchema, arrowArray, pool()));
+    // Get Arrow array.
+    struct ArrowArray arrowArray;
+    if (arrowStream->get_next(arrowStream, &arrowArray)) {
+      if (arrowArray.release) {
+        arrowArray.release(&arrowArray);
+      }
+      VELOX_FAIL(
+          "Failed to call get_next on ArrowStream: {}",
+          std::string(getError(arrowStream)));
+    }
+    if (arrowArray.release == nullptr) {
+      // End of this stream.
+      ++streamIndex_;
+      continue;
+    }
+
+    // Get Arrow schema.
+    struct ArrowSchema arrowSchema;
+    if (arrowStream->get_schema(arrowStream, &arrowSchema)) {
+      if (arrowSchema.release) {
+        arrowSchema.release(&arrowSchema);
+      }
+      if (arrowArray.release) {
+        arrowArray.release(&arrowArray);
+      }
+      VELOX_FAIL(
+          "Failed to call get_schema on ArrowStream: {}",
+          std::string(getError(arrowStream)));
+    }
+
+    // Convert Arrow Array into RowVector and return.
+    return std::dynamic_pointer_cast<RowVector>(
+        importFromArrowAsOwner(arrowSchema, arrowArray, pool()));
+  }
+  return nullptr;
 }
 
 bool ArrowStream::isFinished() {
   return finished_;
 }
 
-const char* ArrowStream::getError() const {
-  const char* lastError = arrowStream_->get_last_error(arrowStream_.get());
+const char* ArrowStream::getError(ArrowArrayStream* stream) {
+  const char* lastError = stream->get_last_error(stream);
   VELOX_CHECK_NOT_NULL(lastError);
   return lastError;
 }
 
 void ArrowStream::close() {
-  if (arrowStream_->release) {
-    arrowStream_->release(arrowStream_.get());
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    closed_ = true;
+    queue_.clear();
+    queuedBytes_ = 0;
+  }
+  if (prefetchFuture_.valid()) {
+    // The streams must not be read after they are released.
+    std::move(prefetchFuture_).wait();
+  }
+  for (auto& arrowStream : arrowStreams_) {
+    if (arrowStream->release) {
+      arrowStream->release(arrowStream.get());
+    }
   }
   SourceOperator::close();
 }
@@ -13,6 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#pragma once
+
+#include <deque>
+
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Operator.h"
 
@@ -20,31 +24,82 @@
 
 namespace facebook::velox::exec {
 
+/// Reads the batches of the Arrow streams of an ArrowStreamNode. The driver
+/// for partition i out of n reads streams i, i + n, i + 2n and so on. If the
+/// query has an executor and QueryConfig::kArrowStreamMaxPrefetchBytes is not
+/// zero, the next batches are read and imported on the executor while the
+/// current batch is processed, up to that many bytes ahead.
 class ArrowStream : public SourceOperator {
  public:
+  /// @param numDrivers Number of drivers of the pipeline, which share the
+  /// streams.
   ArrowStream(
       int32_t operatorId,
       DriverCtx* driverCtx,
-      const std::shared_ptr<const core::ArrowStreamNode>& arrowStreamNode);
+      const std::shared_ptr<const core::ArrowStreamNode>& arrowStreamNode,
+      uint32_t numDrivers = 1);
 
   virtual ~ArrowStream();
 
   RowVectorPtr getOutput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
   void close() override;
 
  private:
-  /// Return last error in Arrow array stream.
-  const char* getError() const;
+  /// Returns the last error of 'stream'.
+  static const char* getError(ArrowArrayStream* stream);
+
+  // Reads the next batch from 'arrowStreams_'. Returns nullptr at the end of
+  // the last stream.
+  RowVectorPtr readNext();
+
+  // Starts reading batches on the executor unless a read is in progress, the
+  // streams are at end or 'queue_' is full. Called with 'mutex_' held.
+  void maybeStartPrefetchLocked();
+
+  // Reads batches into 'queue_' until it is full or the streams end. Runs on
+  // the executor.
+  void prefetch();
+
+  // The streams read by this driver.
+  std::vector<std::shared_ptr<ArrowArrayStream>> arrowStreams_;
+
+  // Index in 'arrowStreams_' of the stream being read.
+  size_t streamIndex_{0};
+
+  const uint64_t maxPrefetchBytes_;
+
+  // Executor for prefetch. nullptr if batches are read in getOutput().
+  folly::Executor* const executor_;
+
+  bool finished_{false};
+
+  // Completed when the running prefetch() returns. Waited for by close().
+  ContinueFuture prefetchFuture_{ContinueFuture::makeEmpty()};
+
+  std::mutex mutex_;
+
+  // Batches read ahead and their sizes.
+  std::deque<std::pair<RowVectorPtr, uint64_t>> queue_;
+  uint64_t queuedBytes_{0};
+
+  // True while prefetch() runs.
+  bool prefetching_{false};
+
+  // True if all streams are read to the end.
+  bool atEnd_{false};
+
+  bool closed_{false};
+
+  // Error raised by prefetch(). Rethrown by getOutput().
+  std::exception_ptr error_;
 
-  bool finished_ = false;
-  std::shared_ptr<ArrowArrayStream> arrowStream_;
+  // Set while the driver waits for prefetch() to add a batch.
+  std::optional<ContinuePromise> consumerPromise_;
 };
 
 } // namespace facebook::velox::exec
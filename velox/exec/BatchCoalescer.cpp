@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/BatchCoalescer.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::exec {
+
+RowVectorPtr BatchCoalescer::add(RowVectorPtr batch, vector_size_t minRows) {
+  VELOX_CHECK_GT(batch->size(), 0);
+  if (!hasPending()) {
+    if (batch->size() >= minRows) {
+      return batch;
+    }
+    first_ = std::move(batch);
+    pendingSinceMs_ = getCurrentTimeMs();
+    return flushIfExpired();
+  }
+
+  if (pending_ == nullptr) {
+    // Reserve for the largest batch that is returned.
+    pending_ = BaseVector::create<RowVector>(
+        first_->type(), std::max(minRows, first_->size()) * 2, pool_);
+    pending_->resize(0);
+    pending_->append(first_.get());
+    first_ = nullptr;
+  }
+  pending_->append(batch.get());
+  if (pending_->size() >= minRows) {
+    return flush();
+  }
+  return flushIfExpired();
+}
+
+RowVectorPtr BatchCoalescer::flushIfExpired() {
+  if (hasPending() && maxDelayMs_ > 0 &&
+      getCurrentTimeMs() - pendingSinceMs_ >= maxDelayMs_) {
+    return flush();
+  }
+  return nullptr;
+}
+
+RowVectorPtr BatchCoalescer::flush() {
+  if (first_ != nullptr) {
+    return std::move(first_);
+  }
+  return std::move(pending_);
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+/// Accumulates the small output batches of an operator, e.g. the output of a
+/// selective filter, into larger batches, so that downstream operators do not
+/// pay their per-batch overhead for a few rows at a time. A single small
+/// batch is held as is and only copied once a second one arrives. Pending
+/// rows are returned once they are enough for a batch, once they have waited
+/// for 'maxDelayMs', or when the operator flushes at the end of its input.
+class BatchCoalescer {
+ public:
+  /// @param maxDelayMs Max time in milliseconds that rows are held before
+  /// they are returned. Zero means no limit.
+  BatchCoalescer(memory::MemoryPool* pool, uint64_t maxDelayMs)
+      : pool_(pool), maxDelayMs_(maxDelayMs) {}
+
+  /// Adds 'batch' to the pending rows. 'batch' is returned as is if there are
+  /// no pending rows and it has at least 'minRows' rows. Returns the pending
+  /// rows if they reach 'minRows' rows or wait longer than the max delay.
+  /// Returns nullptr otherwise.
+  RowVectorPtr add(RowVectorPtr batch, vector_size_t minRows);
+
+  /// Returns the pending rows if they have waited longer than the max delay
+  /// and nullptr otherwise.
+  RowVectorPtr flushIfExpired();
+
+  /// Returns the pending rows or nullptr if there are none.
+  RowVectorPtr flush();
+
+  bool hasPending() const {
+    return first_ != nullptr || pending_ != nullptr;
+  }
+
+ private:
+  memory::MemoryPool* const pool_;
+  const uint64_t maxDelayMs_;
+
+  // The only pending batch. Not copied.
+  RowVectorPtr first_;
+
+  // Copy of the pending batches if there is more than one.
+  RowVectorPtr pending_;
+
+  // Time of adding the oldest pending batch.
+  uint64_t pendingSinceMs_{0};
+};
+
+} // namespace facebook::velox::exec
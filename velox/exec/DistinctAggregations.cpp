@@ -43,8 +43,8 @@ class TypedDistinctAggregations : public DistinctAggregations {
         sizeof(AccumulatorType),
         false, // usesExternalMemory
         1, // alignment
-        [](folly::Range<char**> /*groups*/, VectorPtr& /*result*/) {
-          VELOX_UNREACHABLE();
+        [this](folly::Range<char**> groups, VectorPtr& result) {
+          extractForSpill(groups, result);
         },
         [this](folly::Range<char**> groups) {
           for (auto* group : groups) {
@@ -102,6 +102,28 @@ class TypedDistinctAggregations : public DistinctAggregations {
     inputForAccumulator_.reset();
   }
 
+  TypePtr spillType() const override {
+    return ARRAY(inputType_);
+  }
+
+  void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index) override {
+    decodedSpillInput_.decode(*input);
+    const auto* arrayVector =
+        decodedSpillInput_.base()->template asUnchecked<ArrayVector>();
+    decodedInput_.decode(*arrayVector->elements());
+
+    auto* accumulator = reinterpret_cast<AccumulatorType*>(group + offset_);
+    RowSizeTracker<char, uint32_t> tracker(group[rowSizeOffset_], *allocator_);
+    accumulator->addValues(
+        *arrayVector,
+        decodedSpillInput_.index(index),
+        decodedInput_,
+        allocator_);
+  }
+
   void extractValues(folly::Range<char**> groups, const RowVectorPtr& result)
       override {
     SelectivityVector rows;
@@ -147,6 +169,45 @@ class TypedDistinctAggregations : public DistinctAggregations {
     decodedInput_.decode(*inputForAccumulator_, rows);
   }
 
+  // Writes the unique inputs of 'groups' to 'result' as a vector of
+  // spillType().
+  void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const {
+    auto* pool = result ? result->pool() : pool_;
+    const auto numGroups = groups.size();
+    BufferPtr offsets = allocateOffsets(numGroups, pool);
+    BufferPtr sizes = allocateSizes(numGroups, pool);
+    auto* rawOffsets = offsets->asMutable<vector_size_t>();
+    auto* rawSizes = sizes->asMutable<vector_size_t>();
+    vector_size_t numValues = 0;
+    for (auto i = 0; i < numGroups; ++i) {
+      auto* accumulator =
+          reinterpret_cast<AccumulatorType*>(groups[i] + offset_);
+      rawOffsets[i] = numValues;
+      rawSizes[i] = accumulator->size();
+      numValues += rawSizes[i];
+    }
+
+    auto elements = BaseVector::create(inputType_, numValues, pool);
+    for (auto i = 0; i < numGroups; ++i) {
+      auto* accumulator =
+          reinterpret_cast<AccumulatorType*>(groups[i] + offset_);
+      if constexpr (std::is_same_v<T, ComplexType>) {
+        accumulator->extractValues(*elements, rawOffsets[i]);
+      } else {
+        accumulator->extractValues(
+            *(elements->template as<FlatVector<T>>()), rawOffsets[i]);
+      }
+    }
+    result = std::make_shared<ArrayVector>(
+        pool,
+        spillType(),
+        nullptr,
+        numGroups,
+        std::move(offsets),
+        std::move(sizes),
+        std::move(elements));
+  }
+
   static TypePtr makeInputTypeForAccumulator(
       const RowTypePtr& rowType,
       const std::vector<column_index_t>& inputs) {
@@ -191,6 +252,7 @@ class TypedDistinctAggregations : public DistinctAggregations {
 
   DecodedVector decodedInput_;
   VectorPtr inputForAccumulator_;
+  DecodedVector decodedSpillInput_;
 };
 
 } // namespace
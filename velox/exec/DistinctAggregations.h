@@ -71,6 +71,17 @@ class DistinctAggregations {
       const RowVectorPtr& input,
       const SelectivityVector& rows) = 0;
 
+  /// Returns the type of the column that holds the unique inputs of a group
+  /// when spilling. The column is an array of the input type.
+  virtual TypePtr spillType() const = 0;
+
+  /// Adds the unique inputs of 'group' from the spilled array at 'index' of
+  /// 'input'. 'input' is of spillType().
+  virtual void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index) = 0;
+
   /// Computes aggregations and stores results in the specified 'result' vector.
   virtual void extractValues(
       folly::Range<char**> groups,
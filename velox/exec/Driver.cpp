@@ -19,6 +19,8 @@
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <folly/executors/thread_factory/InitThreadFactory.h>
 #include <gflags/gflags.h>
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
@@ -97,6 +99,38 @@ void recordSilentThrows(Operator& op) {
   }
 }
 
+// Returns the reason why 'op' can't make progress. An in-flight asynchronous
+// memory reservation blocks the operator before anything else.
+BlockingReason operatorBlockingReason(Operator* op, ContinueFuture* future) {
+  const auto reason = op->isWaitingForMemory(future);
+  if (reason != BlockingReason::kNotBlocked) {
+    return reason;
+  }
+  return op->isBlocked(future);
+}
+
+// Returns the stats key of the blocked time for 'reason'. Registers the
+// histograms of all reasons on first use. To be called only if a stats
+// reporter is registered.
+folly::StringPiece blockedTimeCounter(BlockingReason reason) {
+  static const std::vector<std::string> keys = []() {
+    std::vector<std::string> keys;
+    for (auto i = 0; i <= static_cast<int32_t>(BlockingReason::kYieldCpuTime);
+         ++i) {
+      keys.push_back(fmt::format(
+          "{}.{}",
+          kCounterDriverBlockedTimeMs.str(),
+          blockingReasonToString(static_cast<BlockingReason>(i))));
+      // Track blocked time in range of [0, 600s] and reports P50, P90, P99,
+      // and P100.
+      REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
+          folly::StringPiece(keys.back()), 100, 0, 600000, 50, 90, 99, 100);
+    }
+    return keys;
+  }();
+  return keys[static_cast<int32_t>(reason)];
+}
+
 } // namespace
 
 DriverCtx::DriverCtx(
@@ -110,7 +144,14 @@ DriverCtx::DriverCtx(
       splitGroupId(_splitGroupId),
       partitionId(_partitionId),
       task(_task),
-      threadDebugInfo({task->queryCtx()->queryId(), task->taskId(), nullptr}) {}
+      threadDebugInfo({task->queryCtx()->queryId(), task->taskId(), nullptr}) {
+  const auto& config = queryConfig();
+  if (config.isExpressionEvaluationCacheEnabled() &&
+      config.driverVectorPoolEnabled()) {
+    // The memory pool of the requesting operator is passed on each allocation.
+    vectorPool = std::make_unique<VectorPool>(nullptr);
+  }
+}
 
 const core::QueryConfig& DriverCtx::queryConfig() const {
   return task->queryCtx()->queryConfig();
@@ -131,6 +172,14 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
   if (task->spillDirectory().empty()) {
     return std::nullopt;
   }
+  common::SpillOverflowTier overflowTier;
+  const auto overflowDirectory = task->spillOverflowDirectory();
+  if (!overflowDirectory.empty() && queryConfig.maxLocalSpillBytes() > 0) {
+    overflowTier.filePath = makeOperatorSpillPath(
+        overflowDirectory, pipelineId, driverId, operatorId);
+    overflowTier.maxLocalBytes = queryConfig.maxLocalSpillBytes();
+    overflowTier.localBytes = &task->localSpillBytes();
+  }
   return common::SpillConfig(
       makeOperatorSpillPath(
           task->spillDirectory(), pipelineId, driverId, operatorId),
@@ -146,7 +195,9 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.aggregationSpillAll(),
       queryConfig.maxSpillLevel(),
       queryConfig.testingSpillPct(),
-      queryConfig.spillCompressionKind());
+      queryConfig.spillCompressionKind(),
+      std::move(overflowTier),
+      common::stringToSpillFileFormat(queryConfig.spillFileFormat()));
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -183,6 +234,22 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
         if (!driver->state().isTerminated) {
           state->operator_->recordBlockingTime(
               state->sinceMicros_, state->reason_);
+          if (BaseStatsReporter::registered) {
+            REPORT_ADD_HISTOGRAM_VALUE(
+                blockedTimeCounter(state->reason_),
+                (getCurrentTimeMicro() - state->sinceMicros_) / 1'000);
+          }
+          if (auto* timeline = task->timeline()) {
+            timeline->record(
+                {.category = "blocked",
+                 .name = blockingReasonToString(state->reason_),
+                 .detail = state->operator_->operatorType(),
+                 .pipelineId = driver->driverCtx()->pipelineId,
+                 .driverId = driver->driverCtx()->driverId,
+                 .startMicros = state->sinceMicros_,
+                 .durationMicros =
+                     getCurrentTimeMicro() - state->sinceMicros_});
+          }
         }
         VELOX_CHECK(!driver->state().isSuspended);
         VELOX_CHECK(driver->state().hasBlockingFuture);
@@ -240,8 +307,17 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  auto* executor = driver->task()->queryCtx()->executor();
+  const auto numPriorities = executor->getNumPriorities();
+  if (driver->cpuTimeSliceLimitNanos_ > 0 && numPriorities > 1) {
+    // Time sliced Drivers come back to the queue often enough for a priority
+    // based on their Task's CPU time to be effective.
+    executor->addWithPriority(
+        [driver]() { Driver::run(driver); },
+        driver->task()->schedulingPriority(numPriorities));
+    return;
+  }
+  executor->add([driver]() { Driver::run(driver); });
 }
 
 void Driver::init(
@@ -253,6 +329,10 @@ void Driver::init(
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  trackOperatorHardwareCounters_ =
+      ctx_->queryConfig().operatorTrackHardwareCounters();
+  cpuTimeSliceLimitNanos_ =
+      ctx_->queryConfig().driverCpuTimeSliceLimitMs() * 1'000'000UL;
 }
 
 void Driver::initializeOperators() {
@@ -338,12 +418,38 @@ void Driver::enqueueInternal() {
   queueTimeStartMicros_ = getCurrentTimeMicro();
 }
 
+namespace {
+// Adds the hardware counts of the scope of 'this' to the stats of 'op'. Does
+// nothing if 'op' is nullptr or the counters are not available.
+class PerfCounterGuard {
+ public:
+  explicit PerfCounterGuard(Operator* op) : op_(op) {
+    if (op_ != nullptr && !process::readThreadPerfCounters(start_)) {
+      op_ = nullptr;
+    }
+  }
+
+  ~PerfCounterGuard() {
+    process::PerfCounters end;
+    if (op_ != nullptr && process::readThreadPerfCounters(end)) {
+      op_->stats().wlock()->perfCounters.add(end.since(start_));
+    }
+  }
+
+ private:
+  Operator* op_;
+  process::PerfCounters start_;
+};
+} // namespace
+
 // Call an Oprator method. record silenced throws, but not a query
 // terminating throw. Annotate exceptions with Operator info.
 #define CALL_OPERATOR(call, operatorPtr, operatorId, operatorMethod)       \
   try {                                                                    \
     Operator::NonReclaimableSectionGuard nonReclaimableGuard(operatorPtr); \
     RuntimeStatWriterScopeGuard statsWriterGuard(operatorPtr);             \
+    PerfCounterGuard perfCounterGuard(                                     \
+        trackOperatorHardwareCounters_ ? operatorPtr : nullptr);           \
     threadNumVeloxThrow() = 0;                                             \
     opCallStatus_.start(operatorId, operatorMethod);                       \
     auto stopGuard = folly::makeGuard([&]() { opCallStatus_.stop(); });    \
@@ -432,6 +538,10 @@ StopReason Driver::runInternal(
     RowVectorPtr& result) {
   const auto now = getCurrentTimeMicro();
   const auto queuedTime = (now - queueTimeStartMicros_) * 1'000;
+  if (queueTimeStartMicros_ != 0) {
+    REPORT_ADD_HISTOGRAM_VALUE(
+        kCounterDriverQueueTimeMs, queuedTime / 1'000'000);
+  }
   // Update the next operator's queueTime.
   auto stop = closed_ ? StopReason::kTerminate : task()->enter(state_, now);
   if (stop != StopReason::kNone) {
@@ -493,6 +603,12 @@ StopReason Driver::runInternal(
           return stop;
         }
 
+        if (timeSliceExpired()) {
+          task()->addTimeSliceYield();
+          guard.notThrown();
+          return StopReason::kYield;
+        }
+
         auto op = operators_[i].get();
         VELOX_CHECK(op->isInitialized());
 
@@ -500,7 +616,7 @@ StopReason Driver::runInternal(
         // queuedTime we should update.
         curOperatorId_ = i;
         CALL_OPERATOR(
-            blockingReason_ = op->isBlocked(&future),
+            blockingReason_ = operatorBlockingReason(op, &future),
             op,
             curOperatorId_,
             kOpMethodIsBlocked);
@@ -514,7 +630,7 @@ StopReason Driver::runInternal(
         if (i < operators_.size() - 1) {
           nextOp = operators_[i + 1].get();
           CALL_OPERATOR(
-              blockingReason_ = nextOp->isBlocked(&future),
+              blockingReason_ = operatorBlockingReason(nextOp, &future),
               nextOp,
               curOperatorId_ + 1,
               kOpMethodIsBlocked);
@@ -603,7 +719,7 @@ StopReason Driver::runInternal(
               // not the source, just try to get output from the one
               // before.
               CALL_OPERATOR(
-                  blockingReason_ = op->isBlocked(&future),
+                  blockingReason_ = operatorBlockingReason(op, &future),
                   op,
                   curOperatorId_,
                   kOpMethodIsBlocked);
@@ -705,7 +821,26 @@ void Driver::run(std::shared_ptr<Driver> self) {
   ScopedDriverThreadContext scopedDriverThreadContext(*self->driverCtx());
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr nullResult;
+  if (self->cpuTimeSliceLimitNanos_ > 0) {
+    self->timeSliceStartCpuNanos_ = process::threadCpuNanos();
+  }
+  auto* timeline = self->task()->timeline();
+  const auto startMicros = timeline != nullptr ? getCurrentTimeMicro() : 0;
   auto reason = self->runInternal(self, blockingState, nullResult);
+  if (timeline != nullptr) {
+    timeline->record(
+        {.category = "driver",
+         .name = "run",
+         .detail = stopReasonString(reason),
+         .pipelineId = self->driverCtx()->pipelineId,
+         .driverId = self->driverCtx()->driverId,
+         .startMicros = startMicros,
+         .durationMicros = getCurrentTimeMicro() - startMicros});
+  }
+  if (self->timeSliceStartCpuNanos_ != 0) {
+    self->task()->addDriverCpuTimeNanos(
+        process::threadCpuNanos() - self->timeSliceStartCpuNanos_);
+  }
 
   // When Driver runs on an executor, the last operator (sink) must not produce
   // any results.
@@ -971,6 +1106,8 @@ std::string blockingReasonToString(BlockingReason reason) {
       return "kWaitForSpill";
     case BlockingReason::kYield:
       return "kYield";
+    case BlockingReason::kYieldCpuTime:
+      return "kYieldCpuTime";
   }
   VELOX_UNREACHABLE();
   return "";
@@ -982,7 +1119,9 @@ DriverThreadContext* driverThreadContext() {
 
 ScopedDriverThreadContext::ScopedDriverThreadContext(const DriverCtx& driverCtx)
     : savedDriverThreadCtx_(driverThreadCtx),
-      currentDriverThreadCtx_{.driverCtx = driverCtx} {
+      currentDriverThreadCtx_{.driverCtx = driverCtx},
+      scopedTraceListener_(
+          driverCtx.task != nullptr ? driverCtx.task->timeline() : nullptr) {
   driverThreadCtx = &currentDriverThreadCtx_;
 }
 
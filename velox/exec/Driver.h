@@ -21,6 +21,7 @@
 
 #include "velox/common/future/VeloxPromise.h"
 #include "velox/common/process/ThreadDebugInfo.h"
+#include "velox/common/process/TraceContext.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/connectors/Connector.h"
 #include "velox/core/PlanFragment.h"
@@ -157,15 +158,22 @@ enum class BlockingReason {
   /// Used by MergeJoin operator, indicating that it was blocked by the right
   /// side input being unavailable.
   kWaitForMergeJoinRightSide,
+  /// Operator is waiting for the memory reservation started by
+  /// Operator::reserveMemoryAsync() to go through memory arbitration.
   kWaitForMemory,
   kWaitForConnector,
   /// Build operator is blocked waiting for all its peers to stop to run group
-  /// spill on all of them.
+  /// spill on all of them. Aggregation operator is blocked waiting for all its
+  /// peers to finish spilling before restoring the spilled data in parallel.
   kWaitForSpill,
   /// Some operators (like Table Scan) may run long loops and can 'voluntarily'
   /// exit them because Task requested to yield or stop or after a certain time.
   /// This is the blocking reason used in such cases.
   kYield,
+  /// Same as kYield when the operator has used up its CPU time budget or the
+  /// CPU time slice of its Driver. The operator keeps its state and continues
+  /// where it left off on the next call.
+  kYieldCpuTime,
 };
 
 std::string blockingReasonToString(BlockingReason reason);
@@ -230,6 +238,9 @@ struct DriverCtx {
   std::shared_ptr<Task> task;
   Driver* driver;
   facebook::velox::process::ThreadDebugInfo threadDebugInfo;
+  /// The vector pool shared by the operators of the driver if
+  /// QueryConfig::driverVectorPoolEnabled() is set, otherwise null.
+  std::unique_ptr<VectorPool> vectorPool;
 
   DriverCtx(
       std::shared_ptr<Task> _task,
@@ -387,6 +398,16 @@ class Driver : public std::enable_shared_from_this<Driver> {
     return blockingReason_;
   }
 
+  /// Returns true if 'this' runs with a CPU time slice limit and has used up
+  /// its slice since it went on thread in run(). Operators that loop inside a
+  /// single call, like TableScan over batches that filter out all rows, check
+  /// this to yield without waiting to return to the Driver.
+  bool timeSliceExpired() const {
+    return timeSliceStartCpuNanos_ != 0 &&
+        process::threadCpuNanos() - timeSliceStartCpuNanos_ >=
+        cpuTimeSliceLimitNanos_;
+  }
+
   static std::shared_ptr<Driver> testingCreate(
       std::unique_ptr<DriverCtx> ctx = nullptr) {
     auto driver = new Driver();
@@ -462,6 +483,17 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   bool trackOperatorCpuUsage_;
 
+  // True if the hardware counters of each operator call are added to the
+  // operator's stats.
+  bool trackOperatorHardwareCounters_{false};
+
+  // CPU time 'this' may run on a thread before it yields. 0 means no limit.
+  uint64_t cpuTimeSliceLimitNanos_{0};
+
+  // Thread CPU time when 'this' last went on thread in run(). 0 if 'this'
+  // runs without a time slice limit or in single-threaded mode via next().
+  uint64_t timeSliceStartCpuNanos_{0};
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
@@ -629,6 +661,8 @@ class ScopedDriverThreadContext {
  private:
   DriverThreadContext* const savedDriverThreadCtx_{nullptr};
   DriverThreadContext currentDriverThreadCtx_;
+  // Sends the sections traced on the thread to the timeline of the Task.
+  process::ScopedTraceListener scopedTraceListener_;
 };
 
 /// Returns the driver thread context set by a per-thread local variable if the
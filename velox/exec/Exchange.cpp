@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/Exchange.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
@@ -53,7 +54,7 @@ bool Exchange::getSplits(ContinueFuture* future) {
 }
 
 BlockingReason Exchange::isBlocked(ContinueFuture* future) {
-  if (currentPage_ || atEnd_) {
+  if (!currentPages_.empty() || atEnd_) {
     return BlockingReason::kNotBlocked;
   }
 
@@ -65,8 +66,13 @@ BlockingReason Exchange::isBlocked(ContinueFuture* future) {
   }
 
   ContinueFuture dataFuture;
-  currentPage_ = exchangeClient_->next(&atEnd_, &dataFuture);
-  if (currentPage_ || atEnd_) {
+  // Pages deserialized without copying are not merged since appending them
+  // into one vector would copy them after all.
+  currentPages_ = exchangeClient_->next(
+      zeroCopyDeserialization_ ? 0 : preferredOutputBatchBytes_,
+      &atEnd_,
+      &dataFuture);
+  if (!currentPages_.empty() || atEnd_) {
     if (atEnd_ && noMoreSplits_) {
       const auto numSplits = stats_.rlock()->numSplits;
       operatorCtx_->task()->multipleSplitsFinished(numSplits);
@@ -96,29 +102,51 @@ bool Exchange::isFinished() {
 }
 
 RowVectorPtr Exchange::getOutput() {
-  if (!currentPage_) {
+  if (currentPages_.empty()) {
     return nullptr;
   }
 
+  // Deserializes all the pages into one vector so that small pages do not
+  // each produce a small output vector.
   uint64_t rawInputBytes{0};
-  if (!inputStream_) {
-    inputStream_ = std::make_unique<ByteStream>();
-    rawInputBytes += currentPage_->size();
-    currentPage_->prepareStreamForDeserialize(inputStream_.get());
+  vector_size_t numRows{0};
+  for (const auto& page : currentPages_) {
+    rawInputBytes += page->size();
+    ByteStream inputStream;
+    page->prepareStreamForDeserialize(&inputStream, zeroCopyDeserialization_);
+    while (!inputStream.atEnd()) {
+      if (numRows == 0) {
+        getSerde()->deserialize(
+            &inputStream,
+            operatorCtx_->pool(),
+            outputType_,
+            &result_,
+            &serdeOptions_);
+      } else {
+        getSerde()->deserialize(
+            &inputStream,
+            operatorCtx_->pool(),
+            outputType_,
+            &pageResult_,
+            &serdeOptions_);
+        // Pages with preserved encodings deserialize into dictionary and
+        // constant children, which cannot be appended to.
+        for (auto& child : result_->children()) {
+          BaseVector::flattenVector(child);
+        }
+        result_->append(pageResult_.get());
+      }
+      numRows = result_->size();
+    }
   }
-
-  getSerde()->deserialize(
-      inputStream_.get(), operatorCtx_->pool(), outputType_, &result_);
+  currentPages_.clear();
 
   {
     auto lockedStats = stats_.wlock();
     lockedStats->rawInputBytes += rawInputBytes;
     lockedStats->addInputVector(result_->estimateFlatSize(), result_->size());
-  }
-
-  if (inputStream_->atEnd()) {
-    currentPage_ = nullptr;
-    inputStream_ = nullptr;
+    addCompressionRuntimeStats(
+        "decompressionCpuNanos", compressionStats_, lockedStats->runtimeStats);
   }
 
   return result_;
@@ -126,8 +154,9 @@ RowVectorPtr Exchange::getOutput() {
 
 void Exchange::close() {
   SourceOperator::close();
-  currentPage_ = nullptr;
+  currentPages_.clear();
   result_ = nullptr;
+  pageResult_ = nullptr;
   if (exchangeClient_) {
     recordExchangeClientStats();
     exchangeClient_->close();
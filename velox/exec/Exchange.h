@@ -17,6 +17,7 @@
 
 #include "velox/exec/ExchangeClient.h"
 #include "velox/exec/Operator.h"
+#include "velox/serializers/PrestoSerializer.h"
 
 namespace facebook::velox::exec {
 
@@ -45,8 +46,16 @@ class Exchange : public SourceOperator {
             operatorId,
             exchangeNode->id(),
             operatorType),
+        preferredOutputBatchBytes_{
+            driverCtx()->queryConfig().preferredOutputBatchBytes()},
+        zeroCopyDeserialization_{
+            driverCtx()->queryConfig().exchangeZeroCopyDeserialization()},
         processSplits_{operatorCtx_->driverCtx()->driverId == 0},
-        exchangeClient_{std::move(exchangeClient)} {}
+        exchangeClient_{std::move(exchangeClient)} {
+    serdeOptions_.compressionKind = common::stringToCompressionKind(
+        driverCtx()->queryConfig().exchangeCompressionKind());
+    serdeOptions_.compressionStats = &compressionStats_;
+  }
 
   ~Exchange() override {
     close();
@@ -77,6 +86,20 @@ class Exchange : public SourceOperator {
   /// operator's stats.
   void recordExchangeClientStats();
 
+  /// Upper bound on the serialized bytes of the pages deserialized into one
+  /// output vector.
+  const uint64_t preferredOutputBatchBytes_;
+
+  /// True if the output vectors may reference the memory of the received
+  /// pages instead of copying it.
+  const bool zeroCopyDeserialization_;
+
+  /// Compression counters of the deserialized pages.
+  serializer::presto::PrestoVectorSerde::CompressionStats compressionStats_;
+
+  /// Options for deserializing the pages.
+  serializer::presto::PrestoVectorSerde::PrestoOptions serdeOptions_;
+
   /// True if this operator is responsible for fetching splits from the Task and
   /// passing these to ExchangeClient.
   const bool processSplits_;
@@ -87,9 +110,12 @@ class Exchange : public SourceOperator {
   ContinueFuture splitFuture_{ContinueFuture::makeEmpty()};
 
   RowVectorPtr result_;
+  // Holds the vector deserialized from the second and later pages before it
+  // is appended to 'result_'.
+  RowVectorPtr pageResult_;
   std::shared_ptr<ExchangeClient> exchangeClient_;
-  std::unique_ptr<SerializedPage> currentPage_;
-  std::unique_ptr<ByteStream> inputStream_;
+  // Pages to deserialize into the next output vector.
+  std::vector<std::unique_ptr<SerializedPage>> currentPages_;
   bool atEnd_{false};
 };
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/ExchangeClient.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::exec {
 
@@ -130,19 +131,68 @@ std::unique_ptr<SerializedPage> ExchangeClient::next(
   return page;
 }
 
+std::vector<std::unique_ptr<SerializedPage>> ExchangeClient::next(
+    uint64_t maxBytes,
+    bool* atEnd,
+    ContinueFuture* future) {
+  RequestSpec requestSpec;
+  std::vector<std::unique_ptr<SerializedPage>> pages;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    *atEnd = false;
+    pages = queue_->dequeueLocked(maxBytes, atEnd, future);
+    if (*atEnd) {
+      return pages;
+    }
+
+    if (!pages.empty() && queue_->totalBytes() > maxQueuedBytes_) {
+      return pages;
+    }
+
+    requestSpec = pickSourcesToRequestLocked();
+  }
+
+  // Outside of lock
+  request(requestSpec);
+  return pages;
+}
+
+void ExchangeClient::recordFetch(
+    const ExchangeSource& source,
+    uint64_t startMicros) {
+  if (timeline_ == nullptr) {
+    return;
+  }
+  timeline_->record(
+      {.category = "exchange",
+       .name = "fetch",
+       .detail = source.remoteTaskId(),
+       .pipelineId = timelinePipelineId_,
+       .startMicros = startMicros,
+       .durationMicros = getCurrentTimeMicro() - startMicros});
+}
+
 void ExchangeClient::request(const RequestSpec& requestSpec) {
   auto& exec = folly::QueuedImmediateExecutor::instance();
-  for (auto& source : requestSpec.sources) {
+  for (const auto& sourceRequest : requestSpec.requests) {
+    const auto& source = sourceRequest.source;
+    const auto maxBytes = sourceRequest.maxBytes;
+    const auto startMicros = getCurrentTimeMicro();
     if (source->supportsFlowControlV2()) {
-      auto future =
-          source->request(requestSpec.maxBytes, kDefaultMaxWaitSeconds);
+      auto future = source->request(maxBytes, kDefaultMaxWaitSeconds);
       VELOX_CHECK(future.valid());
       std::move(future)
           .via(&exec)
-          .thenValue([this, requestSource = source](auto&& response) {
+          .thenValue([this,
+                      requestSource = source,
+                      credit = maxBytes,
+                      startMicros](auto&& response) {
+            recordFetch(*requestSource, startMicros);
             RequestSpec requestSpec;
             {
               std::lock_guard<std::mutex> l(queue_->mutex());
+              onResponseLocked(
+                  *requestSource, credit, startMicros, response.bytes);
               if (!response.atEnd) {
                 if (response.bytes > 0) {
                   producingSources_.push(requestSource);
@@ -158,14 +208,19 @@ void ExchangeClient::request(const RequestSpec& requestSpec) {
               folly::tag_t<std::exception>{},
               [&](const std::exception& e) { queue_->setError(e.what()); });
     } else {
-      auto future = source->request(requestSpec.maxBytes);
+      auto future = source->request(maxBytes);
       VELOX_CHECK(future.valid());
       std::move(future)
           .via(&exec)
-          .thenValue([this, requestSource = source](auto&& /*unused*/) {
+          .thenValue([this,
+                      requestSource = source,
+                      credit = maxBytes,
+                      startMicros](auto&& /*unused*/) {
+            recordFetch(*requestSource, startMicros);
             RequestSpec requestSpec;
             {
               std::lock_guard<std::mutex> l(queue_->mutex());
+              onResponseLocked(*requestSource, credit, startMicros, -1);
               emptySources_.push(requestSource);
               requestSpec = pickSourcesToRequestLocked();
             }
@@ -178,14 +233,25 @@ void ExchangeClient::request(const RequestSpec& requestSpec) {
   }
 }
 
-int32_t ExchangeClient::countPendingSourcesLocked() {
-  int32_t numPending = 0;
-  for (auto& source : sources_) {
-    if (source->isRequestPendingLocked()) {
-      ++numPending;
-    }
+void ExchangeClient::onResponseLocked(
+    const ExchangeSource& source,
+    int64_t credit,
+    uint64_t startMicros,
+    int64_t bytes) {
+  outstandingBytes_ -= credit;
+  VELOX_CHECK_GE(outstandingBytes_, 0);
+  auto& stats = sourceStats_[&source];
+  const auto latencyMicros =
+      std::max<uint64_t>(1, getCurrentTimeMicro() - startMicros);
+  stats.latencyMicros = stats.latencyMicros == 0
+      ? latencyMicros
+      : (stats.latencyMicros * 3 + latencyMicros) / 4;
+  if (bytes > 0) {
+    const int64_t bytesPerSecond = bytes * 1'000'000 / latencyMicros;
+    stats.bytesPerSecond = stats.bytesPerSecond == 0
+        ? bytesPerSecond
+        : (stats.bytesPerSecond * 3 + bytesPerSecond) / 4;
   }
-  return numPending;
 }
 
 int64_t ExchangeClient::getAveragePageSize() {
@@ -198,31 +264,61 @@ int64_t ExchangeClient::getAveragePageSize() {
   return averagePageSize;
 }
 
-int32_t ExchangeClient::getNumSourcesToRequestLocked(int64_t averagePageSize) {
-  // Figure out how many more 'averagePageSize' fit into 'maxQueuedBytes_'.
-  // Make sure to leave room for 'numPending' pages.
-  const auto numPending = countPendingSourcesLocked();
-
-  auto numToRequest = std::max<int32_t>(
-      1, (maxQueuedBytes_ - queue_->totalBytes()) / averagePageSize);
-  if (numToRequest <= numPending) {
-    return 0;
+int64_t ExchangeClient::creditLocked(
+    const ExchangeSource& source,
+    int64_t averagePageSize) {
+  auto it = sourceStats_.find(&source);
+  if (it == sourceStats_.end()) {
+    return averagePageSize;
   }
-
-  return numToRequest - numPending;
+  return std::max<int64_t>(
+      averagePageSize,
+      it->second.bytesPerSecond * kCreditWindowMicros / 1'000'000);
 }
 
 void ExchangeClient::pickSourcesToRequestLocked(
     RequestSpec& requestSpec,
-    int32_t numToRequest,
+    int64_t averagePageSize,
+    int64_t& availableBytes,
     std::queue<std::shared_ptr<ExchangeSource>>& sources) {
-  while (requestSpec.sources.size() < numToRequest && !sources.empty()) {
-    auto& source = sources.front();
-    if (source->shouldRequestLocked()) {
-      requestSpec.sources.push_back(source);
-    }
+  std::vector<std::shared_ptr<ExchangeSource>> candidates;
+  candidates.reserve(sources.size());
+  while (!sources.empty()) {
+    candidates.push_back(std::move(sources.front()));
     sources.pop();
   }
+  // Sources without a response yet go first to find out whether they are
+  // productive.
+  auto latency = [&](const auto& source) {
+    auto it = sourceStats_.find(source.get());
+    return it == sourceStats_.end() ? std::numeric_limits<uint64_t>::max()
+                                    : it->second.latencyMicros;
+  };
+  std::stable_sort(
+      candidates.begin(),
+      candidates.end(),
+      [&](const auto& left, const auto& right) {
+        return latency(left) > latency(right);
+      });
+  for (auto& source : candidates) {
+    // Request at least one page at a time unless nothing is in flight, so
+    // that there is always progress.
+    const bool hasBudget = availableBytes >= averagePageSize ||
+        (outstandingBytes_ == 0 && requestSpec.requests.empty());
+    if (!hasBudget) {
+      sources.push(std::move(source));
+      continue;
+    }
+    if (!source->shouldRequestLocked()) {
+      continue;
+    }
+    const auto credit = std::min(
+        creditLocked(*source, averagePageSize),
+        std::max(availableBytes, averagePageSize));
+    availableBytes -= credit;
+    outstandingBytes_ += credit;
+    requestSpec.requests.push_back({std::move(source), credit});
+  }
 }
 
 ExchangeClient::RequestSpec ExchangeClient::pickSourcesToRequestLocked() {
@@ -231,19 +327,16 @@ ExchangeClient::RequestSpec ExchangeClient::pickSourcesToRequestLocked() {
   }
 
   const auto averagePageSize = getAveragePageSize();
-  const auto numToRequest = getNumSourcesToRequestLocked(averagePageSize);
-
-  if (numToRequest == 0) {
-    return {};
-  }
+  int64_t availableBytes =
+      maxQueuedBytes_ - queue_->totalBytes() - outstandingBytes_;
 
+  // Pick the next sources to request data from while the responses fit in
+  // the queue. Prioritize sources that return data.
   RequestSpec requestSpec;
-  requestSpec.maxBytes = averagePageSize;
-
-  // Pick up to 'numToRequest' next sources to request data from. Prioritize
-  // sources that return data.
-  pickSourcesToRequestLocked(requestSpec, numToRequest, producingSources_);
-  pickSourcesToRequestLocked(requestSpec, numToRequest, emptySources_);
+  pickSourcesToRequestLocked(
+      requestSpec, averagePageSize, availableBytes, producingSources_);
+  pickSourcesToRequestLocked(
+      requestSpec, averagePageSize, availableBytes, emptySources_);
 
   return requestSpec;
 }
@@ -18,6 +18,7 @@
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/exec/ExchangeQueue.h"
 #include "velox/exec/ExchangeSource.h"
+#include "velox/exec/TaskTimeline.h"
 
 namespace facebook::velox::exec {
 
@@ -28,6 +29,10 @@ class ExchangeClient {
   static constexpr int32_t kDefaultMaxQueuedBytes = 32 << 20; // 32 MB.
   static constexpr int32_t kDefaultMaxWaitSeconds = 2;
   static inline const std::string kBackgroundCpuTimeMs = "backgroundCpuTimeMs";
+  // The credit of a source is the bytes it delivers in this time at its
+  // recent throughput, but at least the average page size. Fast sources get
+  // large requests that cover many pages per round trip.
+  static constexpr int64_t kCreditWindowMicros = 100'000;
 
   ExchangeClient(
       std::string taskId,
@@ -72,33 +77,74 @@ class ExchangeClient {
 
   std::unique_ptr<SerializedPage> next(bool* atEnd, ContinueFuture* future);
 
+  /// Returns the next pages, up to 'maxBytes' in total but at least one if any
+  /// is available. This takes the queue lock once for the whole batch.
+  std::vector<std::unique_ptr<SerializedPage>>
+  next(uint64_t maxBytes, bool* atEnd, ContinueFuture* future);
+
   std::string toString() const;
 
   std::string toJsonString() const;
 
+  /// Records each fetch from a source as an event of 'pipelineId' in
+  /// 'timeline'. To be called before adding sources.
+  void setTimeline(std::shared_ptr<TaskTimeline> timeline, int32_t pipelineId) {
+    timeline_ = std::move(timeline);
+    timelinePipelineId_ = pipelineId;
+  }
+
  private:
-  // A list of sources to request data from and how much to request from each
-  // (in bytes).
-  struct RequestSpec {
-    std::vector<std::shared_ptr<ExchangeSource>> sources;
+  // A source to request data from and how much to request (in bytes).
+  struct SourceRequest {
+    std::shared_ptr<ExchangeSource> source;
     int64_t maxBytes;
   };
 
+  // A list of sources to request data from.
+  struct RequestSpec {
+    std::vector<SourceRequest> requests;
+  };
+
+  // Recent behavior of a source, used to size and order its requests.
+  struct SourceStats {
+    // Moving average of the time from request to response.
+    uint64_t latencyMicros{0};
+    // Moving average of the response bytes per second. 0 if the source does
+    // not report response sizes.
+    int64_t bytesPerSecond{0};
+  };
+
   int64_t getAveragePageSize();
 
-  int32_t getNumSourcesToRequestLocked(int64_t averagePageSize);
+  // Returns the bytes to request from 'source' if the budget allows.
+  int64_t creditLocked(const ExchangeSource& source, int64_t averagePageSize);
 
   RequestSpec pickSourcesToRequestLocked();
 
+  // Adds requests for sources from 'sources' while 'availableBytes' allows.
+  // Slow sources go first since their responses take the longest. Sources
+  // that are not requested for lack of budget stay in 'sources'.
   void pickSourcesToRequestLocked(
       RequestSpec& requestSpec,
-      int32_t numToRequest,
+      int64_t averagePageSize,
+      int64_t& availableBytes,
       std::queue<std::shared_ptr<ExchangeSource>>& sources);
 
-  int32_t countPendingSourcesLocked();
-
   void request(const RequestSpec& requestSpec);
 
+  // Releases the credit of a request to 'source' that started at
+  // 'startMicros' and updates the stats of 'source' with the latency and
+  // 'bytes' of the response. 'bytes' is -1 if unknown.
+  void onResponseLocked(
+      const ExchangeSource& source,
+      int64_t credit,
+      uint64_t startMicros,
+      int64_t bytes);
+
+  // Records a fetch from 'source' that started at 'startMicros' in
+  // 'timeline_' if set.
+  void recordFetch(const ExchangeSource& source, uint64_t startMicros);
+
   // Handy for ad-hoc logging.
   const std::string taskId_;
   const int destination_;
@@ -114,6 +160,15 @@ class ExchangeClient {
   std::queue<std::shared_ptr<ExchangeSource>> producingSources_;
   // A queue of sources that returned empty response from the latest request.
   std::queue<std::shared_ptr<ExchangeSource>> emptySources_;
+
+  folly::F14FastMap<const ExchangeSource*, SourceStats> sourceStats_;
+  // Sum of the credits of the requests in flight. Requests are made only
+  // while the queued bytes plus these fit in 'maxQueuedBytes_', so that the
+  // responses do not overflow the queue.
+  int64_t outstandingBytes_{0};
+
+  std::shared_ptr<TaskTimeline> timeline_;
+  int32_t timelinePipelineId_{-1};
 };
 
 } // namespace facebook::velox::exec
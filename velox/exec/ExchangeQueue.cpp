@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/exec/ExchangeQueue.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 
 namespace facebook::velox::exec {
 
@@ -39,8 +41,14 @@ SerializedPage::~SerializedPage() {
   }
 }
 
-void SerializedPage::prepareStreamForDeserialize(ByteStream* input) {
+void SerializedPage::prepareStreamForDeserialize(
+    ByteStream* input,
+    bool shareInput) {
   input->resetInput(std::move(ranges_));
+  if (shareInput && !onDestructionCb_) {
+    // The clone shares the refcounted buffers of 'iobuf_'.
+    input->setInputOwner(std::shared_ptr<folly::IOBuf>(iobuf_->clone()));
+  }
 }
 
 void ExchangeQueue::noMoreSources() {
@@ -79,6 +87,7 @@ void ExchangeQueue::enqueueLocked(
   if (peakBytes_ < totalBytes_) {
     peakBytes_ = totalBytes_;
   }
+  REPORT_ADD_STAT_VALUE(kCounterExchangeQueueBytes, totalBytes_);
 
   ++receivedPages_;
   receivedBytes_ += page->size();
@@ -116,6 +125,38 @@ std::unique_ptr<SerializedPage> ExchangeQueue::dequeueLocked(
   return page;
 }
 
+std::vector<std::unique_ptr<SerializedPage>> ExchangeQueue::dequeueLocked(
+    uint64_t maxBytes,
+    bool* atEnd,
+    ContinueFuture* future) {
+  VELOX_CHECK(future);
+  if (!error_.empty()) {
+    *atEnd = true;
+    VELOX_FAIL(error_);
+  }
+  *atEnd = false;
+  std::vector<std::unique_ptr<SerializedPage>> pages;
+  if (queue_.empty()) {
+    if (atEnd_) {
+      *atEnd = true;
+    } else {
+      promises_.emplace_back("ExchangeQueue::dequeue");
+      *future = promises_.back().getSemiFuture();
+    }
+    return pages;
+  }
+
+  uint64_t pageBytes = 0;
+  do {
+    pageBytes += queue_.front()->size();
+    pages.push_back(std::move(queue_.front()));
+    queue_.pop_front();
+  } while (!queue_.empty() &&
+           pageBytes + queue_.front()->size() <= maxBytes);
+  totalBytes_ -= pageBytes;
+  return pages;
+}
+
 void ExchangeQueue::setError(const std::string& error) {
   std::vector<ContinuePromise> promises;
   {
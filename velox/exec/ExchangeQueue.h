@@ -36,8 +36,11 @@ class SerializedPage {
   }
 
   // Makes 'input' ready for deserializing 'this' with
-  // VectorStreamGroup::read().
-  void prepareStreamForDeserialize(ByteStream* input);
+  // VectorStreamGroup::read(). If 'shareInput' is true, 'input' also gets an
+  // owner that keeps the page memory alive so that the deserialized vectors
+  // may reference it without copying. This is not done for pages with an
+  // 'onDestructionCb_' since their memory is freed when 'this' goes away.
+  void prepareStreamForDeserialize(ByteStream* input, bool shareInput = false);
 
   std::unique_ptr<folly::IOBuf> getIOBuf() const {
     return iobuf_->clone();
@@ -104,6 +107,13 @@ class ExchangeQueue {
       bool* atEnd,
       ContinueFuture* future);
 
+  /// Like dequeueLocked() above but returns as many pages as fit in
+  /// 'maxBytes', and at least one if any is available. Returns an empty
+  /// vector and sets 'atEnd' or 'future' like dequeueLocked() if no page is
+  /// available.
+  std::vector<std::unique_ptr<SerializedPage>>
+  dequeueLocked(uint64_t maxBytes, bool* atEnd, ContinueFuture* future);
+
   /// Returns the total bytes held by SerializedPages in 'this'.
   uint64_t totalBytes() const {
     return totalBytes_;
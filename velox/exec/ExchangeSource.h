@@ -96,6 +96,11 @@ class ExchangeSource : public std::enable_shared_from_this<ExchangeSource> {
   // ExchangeClient::kBackgroundCpuTimeMs.
   virtual folly::F14FastMap<std::string, int64_t> stats() const = 0;
 
+  /// Returns the id of the task 'this' fetches from.
+  const std::string& remoteTaskId() const {
+    return taskId_;
+  }
+
   virtual std::string toString() {
     std::stringstream out;
     out << "[ExchangeSource " << taskId_ << ":" << destination_
@@ -54,7 +54,13 @@ FilterProject::FilterProject(
           "FilterProject"),
       hasFilter_(filter != nullptr),
       project_(project),
-      filter_(filter) {}
+      filter_(filter) {
+  const auto& queryConfig = driverCtx->queryConfig();
+  if (hasFilter_ && queryConfig.outputBatchSizeByBytes()) {
+    coalescer_ = std::make_unique<BatchCoalescer>(
+        pool(), queryConfig.outputBatchCoalesceMaxDelayMs());
+  }
+}
 
 void FilterProject::initialize() {
   Operator::initialize();
@@ -81,6 +87,12 @@ void FilterProject::initialize() {
     isIdentityProjection_ = true;
   }
   numExprs_ = allExprs.size();
+  if (numExprs_ > 0 &&
+      operatorCtx_->driverCtx()->queryConfig().exprFusedKernelEnabled()) {
+    const auto& inputType = project_ ? project_->sources()[0]->outputType()
+                                     : filter_->sources()[0]->outputType();
+    fusedKernel_ = FusedKernel::getOrCompile(allExprs, inputType);
+  }
   exprs_ = makeExprSetFromFlag(std::move(allExprs), operatorCtx_->execCtx());
 
   if (numExprs_ > 0 && !identityProjections_.empty()) {
@@ -119,10 +131,29 @@ bool FilterProject::allInputProcessed() {
 }
 
 bool FilterProject::isFinished() {
-  return noMoreInput_ && allInputProcessed();
+  return noMoreInput_ && allInputProcessed() &&
+      (coalescer_ == nullptr || !coalescer_->hasPending());
 }
 
 RowVectorPtr FilterProject::getOutput() {
+  if (coalescer_ == nullptr) {
+    return evalOutput();
+  }
+  return coalesceOutput(evalOutput());
+}
+
+RowVectorPtr FilterProject::coalesceOutput(RowVectorPtr output) {
+  if (output != nullptr) {
+    const auto rowSize = output->estimateFlatSize() / output->size();
+    return coalescer_->add(std::move(output), outputBatchRows(rowSize) / 2);
+  }
+  if (noMoreInput_ && allInputProcessed()) {
+    return coalescer_->flush();
+  }
+  return coalescer_->flushIfExpired();
+}
+
+RowVectorPtr FilterProject::evalOutput() {
   if (allInputProcessed()) {
     return nullptr;
   }
@@ -140,6 +171,12 @@ RowVectorPtr FilterProject::getOutput() {
     evalCtx.ensureFieldLoaded(fieldIdx, *rows);
   }
 
+  if (fusedKernel_ != nullptr) {
+    if (auto output = evalFused(*rows)) {
+      return output.value();
+    }
+  }
+
   if (!hasFilter_) {
     numProcessedInputRows_ = size;
     VELOX_CHECK(!isIdentityProjection_);
@@ -173,6 +210,33 @@ RowVectorPtr FilterProject::getOutput() {
       results);
 }
 
+std::optional<RowVectorPtr> FilterProject::evalFused(
+    const SelectivityVector& allRows) {
+  std::vector<VectorPtr> results;
+  if (!fusedKernel_->eval(*input_, *operatorCtx_->execCtx(), results)) {
+    return std::nullopt;
+  }
+  addRuntimeStat("fusedKernelBatches", RuntimeCounter(1));
+  const auto size = input_->size();
+  numProcessedInputRows_ = size;
+  if (!hasFilter_) {
+    return fillOutput(size, nullptr, results);
+  }
+
+  const auto numOut =
+      processFilterResults(results[0], allRows, filterEvalCtx_, pool());
+  if (numOut == 0) {
+    input_ = nullptr;
+    return nullptr;
+  }
+  // The projections are computed for all rows and the output wraps them in a
+  // dictionary of the passing rows.
+  return fillOutput(
+      numOut,
+      numOut == size ? nullptr : filterEvalCtx_.selectedIndices,
+      results);
+}
+
 std::vector<VectorPtr> FilterProject::project(
     const SelectivityVector& rows,
     EvalCtx& evalCtx) {
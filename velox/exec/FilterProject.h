@@ -16,6 +16,8 @@
 #pragma once
 
 #include "velox/core/PlanNode.h"
+#include "velox/exec/BatchCoalescer.h"
+#include "velox/exec/FusedKernel.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/expression/Expr.h"
@@ -74,6 +76,15 @@ class FilterProject : public Operator {
   void initialize() override;
 
  private:
+  // Evaluates the filter and projections on 'input_'. Returns nullptr if
+  // there is no input or no row passes the filter.
+  RowVectorPtr evalOutput();
+
+  // Adds 'output' to 'coalescer_' if it has less than half the rows of a
+  // batch of the preferred size. Returns the batch to return from
+  // getOutput(), which is nullptr while the pending rows are too few.
+  RowVectorPtr coalesceOutput(RowVectorPtr output);
+
   // Tests if 'numProcessedRows_' equals to the length of input_ and clears
   // outstanding references to input_ if done. Returns true if getOutput
   // should return nullptr.
@@ -92,9 +103,18 @@ class FilterProject : public Operator {
       const SelectivityVector& rows,
       EvalCtx& evalCtx);
 
+  // Evaluates the filter and projections with 'fusedKernel_'. Returns
+  // std::nullopt if the kernel cannot evaluate 'input_'. Otherwise returns the
+  // output, which is null if no rows pass the filter.
+  std::optional<RowVectorPtr> evalFused(const SelectivityVector& allRows);
+
   // If true exprs_[0] is a filter and the other expressions are projections
   const bool hasFilter_{false};
 
+  // Set if small output batches are coalesced. See
+  // QueryConfig::kOutputBatchSizeByBytes.
+  std::unique_ptr<BatchCoalescer> coalescer_;
+
   // Cached filter and project node for lazy initialization. After
   // initialization, they will be reset, and initialized_ will be set to true.
   std::shared_ptr<const core::ProjectNode> project_;
@@ -104,6 +124,10 @@ class FilterProject : public Operator {
   std::unique_ptr<ExprSet> exprs_;
   int32_t numExprs_;
 
+  // Compiled form of 'exprs_' if enabled and all expressions are supported.
+  // Tried first on each batch, falling back to 'exprs_'.
+  std::shared_ptr<const FusedKernel> fusedKernel_;
+
   FilterEvalCtx filterEvalCtx_;
 
   vector_size_t numProcessedInputRows_{0};
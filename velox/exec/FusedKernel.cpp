@@ -0,0 +1,579 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/FusedKernel.h"
+
+#include <folly/container/F14Map.h>
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::exec {
+namespace {
+// Upper bound on the number of cached kernels. The cache is emptied when it is
+// full. Plans with the same expressions are expected to be compiled far fewer
+// times than this between evictions.
+constexpr int32_t kMaxCachedKernels = 1'000;
+
+struct KernelCache {
+  std::mutex mutex;
+  // Null for expressions that do not compile.
+  folly::F14FastMap<std::string, std::shared_ptr<const FusedKernel>> kernels;
+};
+
+KernelCache& kernelCache() {
+  static KernelCache cache;
+  return cache;
+}
+
+// Returns the kind of 'type' if it is one of the types supported by the
+// kernel. Logical types like DATE are not supported even if their physical
+// type is.
+std::optional<TypeKind> supportedKind(const TypePtr& type) {
+  if (*type == *BOOLEAN()) {
+    return TypeKind::BOOLEAN;
+  }
+  if (*type == *INTEGER()) {
+    return TypeKind::INTEGER;
+  }
+  if (*type == *BIGINT()) {
+    return TypeKind::BIGINT;
+  }
+  if (*type == *DOUBLE()) {
+    return TypeKind::DOUBLE;
+  }
+  return std::nullopt;
+}
+
+std::string fingerprint(const core::TypedExprPtr& expr) {
+  return fmt::format("{}:{}", expr->type()->toString(), expr->toString());
+}
+
+template <typename T, typename TResult, typename Func>
+void binaryLoop(
+    const char* left,
+    const char* right,
+    char* result,
+    vector_size_t size,
+    Func func) {
+  const auto* leftValues = reinterpret_cast<const T*>(left);
+  const auto* rightValues = reinterpret_cast<const T*>(right);
+  auto* resultValues = reinterpret_cast<TResult*>(result);
+  for (vector_size_t i = 0; i < size; ++i) {
+    resultValues[i] = func(leftValues[i], rightValues[i]);
+  }
+}
+
+// Applies 'func' to 64 bit integers. 'func' returns true on overflow. If
+// 'isInteger' is true, also checks that the results fit in 32 bits. Returns
+// true if any row overflows.
+template <typename Func>
+bool checkedLoop(
+    const char* left,
+    const char* right,
+    char* result,
+    vector_size_t size,
+    bool isInteger,
+    Func func) {
+  const auto* leftValues = reinterpret_cast<const int64_t*>(left);
+  const auto* rightValues = reinterpret_cast<const int64_t*>(right);
+  auto* resultValues = reinterpret_cast<int64_t*>(result);
+  bool overflow = false;
+  for (vector_size_t i = 0; i < size; ++i) {
+    overflow |= func(leftValues[i], rightValues[i], &resultValues[i]);
+  }
+  if (isInteger) {
+    for (vector_size_t i = 0; i < size; ++i) {
+      overflow |= resultValues[i] != static_cast<int32_t>(resultValues[i]);
+    }
+  }
+  return overflow;
+}
+
+template <typename Func>
+void compare(
+    TypeKind kind,
+    const char* left,
+    const char* right,
+    char* result,
+    vector_size_t size,
+    Func func) {
+  if (kind == TypeKind::DOUBLE) {
+    binaryLoop<double, int64_t>(left, right, result, size, func);
+  } else {
+    binaryLoop<int64_t, int64_t>(left, right, result, size, func);
+  }
+}
+} // namespace
+
+class FusedKernel::Compiler {
+ public:
+  Compiler(FusedKernel& kernel, const RowTypePtr& inputType)
+      : kernel_(kernel), inputType_(inputType) {}
+
+  // Adds the instructions for 'expr' and returns the register of its result.
+  // Returns std::nullopt if 'expr' is not supported.
+  std::optional<int32_t> compile(const core::TypedExprPtr& expr) {
+    const auto kind = supportedKind(expr->type());
+    if (!kind.has_value()) {
+      return std::nullopt;
+    }
+    auto key = fingerprint(expr);
+    auto it = registers_.find(key);
+    if (it != registers_.end()) {
+      return it->second;
+    }
+
+    std::optional<int32_t> result;
+    if (auto* field =
+            dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get())) {
+      result = compileField(*field, kind.value());
+    } else if (
+        auto* constant =
+            dynamic_cast<const core::ConstantTypedExpr*>(expr.get())) {
+      result = compileConstant(*constant, kind.value());
+    } else if (
+        auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
+      result = compileCall(*call, kind.value());
+    }
+    if (result.has_value()) {
+      registers_.emplace(std::move(key), result.value());
+    }
+    return result;
+  }
+
+ private:
+  int32_t add(const Instruction& instruction) {
+    kernel_.instructions_.push_back(instruction);
+    return kernel_.instructions_.size() - 1;
+  }
+
+  std::optional<int32_t> compileField(
+      const core::FieldAccessTypedExpr& field,
+      TypeKind kind) {
+    const auto& inputs = field.inputs();
+    if (!inputs.empty() &&
+        (inputs.size() > 1 ||
+         !dynamic_cast<const core::InputTypedExpr*>(inputs[0].get()))) {
+      return std::nullopt;
+    }
+    const auto channel = inputType_->getChildIdxIfExists(field.name());
+    if (!channel.has_value()) {
+      return std::nullopt;
+    }
+    auto& channels = kernel_.channels_;
+    if (std::find(channels.begin(), channels.end(), channel.value()) ==
+        channels.end()) {
+      channels.push_back(channel.value());
+    }
+    Instruction instruction{OpCode::kField, kind};
+    instruction.channel = channel.value();
+    return add(instruction);
+  }
+
+  std::optional<int32_t> compileConstant(
+      const core::ConstantTypedExpr& constant,
+      TypeKind kind) {
+    if (constant.hasValueVector() || constant.value().isNull()) {
+      return std::nullopt;
+    }
+    Instruction instruction{OpCode::kConstant, kind};
+    const auto& value = constant.value();
+    switch (kind) {
+      case TypeKind::BOOLEAN:
+        instruction.constant = value.value<bool>();
+        break;
+      case TypeKind::INTEGER:
+        instruction.constant = value.value<int32_t>();
+        break;
+      case TypeKind::BIGINT:
+        instruction.constant = value.value<int64_t>();
+        break;
+      case TypeKind::DOUBLE:
+        instruction.constant =
+            folly::bit_cast<int64_t>(value.value<double>());
+        break;
+      default:
+        return std::nullopt;
+    }
+    return add(instruction);
+  }
+
+  std::optional<int32_t> compileCall(
+      const core::CallTypedExpr& call,
+      TypeKind kind) {
+    static const folly::F14FastMap<std::string, OpCode> kOpCodes = {
+        {"plus", OpCode::kPlus},
+        {"minus", OpCode::kMinus},
+        {"multiply", OpCode::kMultiply},
+        {"divide", OpCode::kDivide},
+        {"eq", OpCode::kEq},
+        {"neq", OpCode::kNeq},
+        {"lt", OpCode::kLt},
+        {"lte", OpCode::kLte},
+        {"gt", OpCode::kGt},
+        {"gte", OpCode::kGte},
+        {"and", OpCode::kAnd},
+        {"or", OpCode::kOr},
+        {"not", OpCode::kNot},
+    };
+    auto it = kOpCodes.find(call.name());
+    if (it == kOpCodes.end()) {
+      return std::nullopt;
+    }
+    const auto op = it->second;
+    const auto& inputs = call.inputs();
+    if (inputs.empty()) {
+      return std::nullopt;
+    }
+    const auto inputKind = supportedKind(inputs[0]->type());
+    if (!inputKind.has_value()) {
+      return std::nullopt;
+    }
+    for (const auto& input : inputs) {
+      if (*input->type() != *inputs[0]->type()) {
+        return std::nullopt;
+      }
+    }
+
+    switch (op) {
+      case OpCode::kNot:
+        if (inputs.size() != 1 || inputKind != TypeKind::BOOLEAN) {
+          return std::nullopt;
+        }
+        break;
+      case OpCode::kAnd:
+      case OpCode::kOr:
+        if (inputKind != TypeKind::BOOLEAN) {
+          return std::nullopt;
+        }
+        break;
+      case OpCode::kDivide:
+        // Integer division throws on division by zero.
+        if (inputKind != TypeKind::DOUBLE) {
+          return std::nullopt;
+        }
+        [[fallthrough]];
+      case OpCode::kPlus:
+      case OpCode::kMinus:
+      case OpCode::kMultiply:
+        if (inputs.size() != 2 || inputKind == TypeKind::BOOLEAN ||
+            inputKind != kind) {
+          return std::nullopt;
+        }
+        break;
+      default:
+        // Comparisons.
+        if (inputs.size() != 2 || inputKind == TypeKind::BOOLEAN ||
+            kind != TypeKind::BOOLEAN) {
+          return std::nullopt;
+        }
+        break;
+    }
+
+    auto left = compile(inputs[0]);
+    if (!left.has_value()) {
+      return std::nullopt;
+    }
+    if (op == OpCode::kNot) {
+      Instruction instruction{op, inputKind.value(), left.value()};
+      return add(instruction);
+    }
+    // 'and' and 'or' may have more than 2 inputs. These are evaluated
+    // left to right.
+    for (auto i = 1; i < inputs.size(); ++i) {
+      auto right = compile(inputs[i]);
+      if (!right.has_value()) {
+        return std::nullopt;
+      }
+      Instruction instruction{
+          op, inputKind.value(), left.value(), right.value()};
+      left = add(instruction);
+    }
+    return left;
+  }
+
+  FusedKernel& kernel_;
+  const RowTypePtr& inputType_;
+  // The register holding the value of each distinct subexpression, keyed on
+  // its fingerprint.
+  folly::F14FastMap<std::string, int32_t> registers_;
+};
+
+// static
+std::shared_ptr<const FusedKernel> FusedKernel::getOrCompile(
+    const std::vector<core::TypedExprPtr>& exprs,
+    const RowTypePtr& inputType) {
+  auto key = inputType->toString();
+  for (const auto& expr : exprs) {
+    key += ";";
+    key += fingerprint(expr);
+  }
+
+  auto& cache = kernelCache();
+  {
+    std::lock_guard<std::mutex> l(cache.mutex);
+    auto it = cache.kernels.find(key);
+    if (it != cache.kernels.end()) {
+      return it->second;
+    }
+  }
+
+  std::shared_ptr<FusedKernel> kernel(new FusedKernel());
+  Compiler compiler(*kernel, inputType);
+  for (const auto& expr : exprs) {
+    auto result = compiler.compile(expr);
+    if (!result.has_value()) {
+      kernel = nullptr;
+      break;
+    }
+    kernel->outputs_.emplace_back(result.value(), expr->type());
+  }
+
+  std::lock_guard<std::mutex> l(cache.mutex);
+  if (cache.kernels.size() >= kMaxCachedKernels) {
+    cache.kernels.clear();
+  }
+  cache.kernels.emplace(std::move(key), kernel);
+  return kernel;
+}
+
+// static
+size_t FusedKernel::testingCacheSize() {
+  auto& cache = kernelCache();
+  std::lock_guard<std::mutex> l(cache.mutex);
+  return cache.kernels.size();
+}
+
+// static
+void FusedKernel::testingClearCache() {
+  auto& cache = kernelCache();
+  std::lock_guard<std::mutex> l(cache.mutex);
+  cache.kernels.clear();
+}
+
+bool FusedKernel::eval(
+    const RowVector& input,
+    core::ExecCtx& execCtx,
+    std::vector<VectorPtr>& results) const {
+  const auto size = input.size();
+  if (size == 0) {
+    return false;
+  }
+  std::vector<const BaseVector*> fields(input.childrenSize());
+  for (auto channel : channels_) {
+    const auto& field = BaseVector::loadedVectorShared(input.childAt(channel));
+    if (field->encoding() != VectorEncoding::Simple::FLAT ||
+        field->mayHaveNulls() || field->size() < size) {
+      return false;
+    }
+    fields[channel] = field.get();
+  }
+
+  core::ExecCtx::ScratchScope scratchScope(&execCtx);
+  std::vector<char*> registers(instructions_.size());
+  bool overflow = false;
+  for (auto i = 0; i < instructions_.size(); ++i) {
+    const auto& instruction = instructions_[i];
+    const BaseVector* field = nullptr;
+    if (instruction.op == OpCode::kField) {
+      field = fields[instruction.channel];
+      // BIGINT and DOUBLE columns are read in place.
+      switch (instruction.kind) {
+        case TypeKind::BIGINT:
+          registers[i] = reinterpret_cast<char*>(const_cast<int64_t*>(
+              field->asUnchecked<FlatVector<int64_t>>()->rawValues()));
+          continue;
+        case TypeKind::DOUBLE:
+          registers[i] = reinterpret_cast<char*>(const_cast<double*>(
+              field->asUnchecked<FlatVector<double>>()->rawValues()));
+          continue;
+        default:
+          break;
+      }
+    }
+    registers[i] = execCtx.allocateScratch(size * sizeof(int64_t), 8);
+    if (instruction.op == OpCode::kField) {
+      auto* values = reinterpret_cast<int64_t*>(registers[i]);
+      if (instruction.kind == TypeKind::INTEGER) {
+        const auto* rawValues =
+            field->asUnchecked<FlatVector<int32_t>>()->rawValues();
+        for (vector_size_t row = 0; row < size; ++row) {
+          values[row] = rawValues[row];
+        }
+      } else {
+        const auto* rawBits =
+            field->asUnchecked<FlatVector<bool>>()->rawValues<uint64_t>();
+        for (vector_size_t row = 0; row < size; ++row) {
+          values[row] = bits::isBitSet(rawBits, row);
+        }
+      }
+      continue;
+    }
+    evalInstruction(instruction, size, registers, overflow);
+    if (overflow) {
+      return false;
+    }
+  }
+
+  results.resize(outputs_.size());
+  for (auto i = 0; i < outputs_.size(); ++i) {
+    const auto& [reg, type] = outputs_[i];
+    const auto* values = reinterpret_cast<const int64_t*>(registers[reg]);
+    auto result = BaseVector::create(type, size, execCtx.pool());
+    switch (type->kind()) {
+      case TypeKind::BOOLEAN: {
+        auto* rawBits = result->asUnchecked<FlatVector<bool>>()
+                            ->mutableRawValues<uint64_t>();
+        for (vector_size_t row = 0; row < size; ++row) {
+          bits::setBit(rawBits, row, values[row] != 0);
+        }
+        break;
+      }
+      case TypeKind::INTEGER: {
+        auto* rawValues =
+            result->asUnchecked<FlatVector<int32_t>>()->mutableRawValues();
+        for (vector_size_t row = 0; row < size; ++row) {
+          rawValues[row] = values[row];
+        }
+        break;
+      }
+      case TypeKind::BIGINT:
+        memcpy(
+            result->asUnchecked<FlatVector<int64_t>>()->mutableRawValues(),
+            values,
+            size * sizeof(int64_t));
+        break;
+      case TypeKind::DOUBLE:
+        memcpy(
+            result->asUnchecked<FlatVector<double>>()->mutableRawValues(),
+            values,
+            size * sizeof(double));
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+    results[i] = std::move(result);
+  }
+  return true;
+}
+
+void FusedKernel::evalInstruction(
+    const Instruction& instruction,
+    vector_size_t size,
+    std::vector<char*>& registers,
+    bool& overflow) const {
+  const auto kind = instruction.kind;
+  const bool isDouble = kind == TypeKind::DOUBLE;
+  const bool isInteger = kind == TypeKind::INTEGER;
+  auto* result = registers[&instruction - instructions_.data()];
+  const auto* left =
+      instruction.left >= 0 ? registers[instruction.left] : nullptr;
+  const auto* right =
+      instruction.right >= 0 ? registers[instruction.right] : nullptr;
+
+  switch (instruction.op) {
+    case OpCode::kConstant: {
+      auto* values = reinterpret_cast<int64_t*>(result);
+      std::fill(values, values + size, instruction.constant);
+      break;
+    }
+    case OpCode::kPlus:
+      if (isDouble) {
+        binaryLoop<double, double>(
+            left, right, result, size, [](auto a, auto b) { return a + b; });
+      } else {
+        overflow = checkedLoop(
+            left, right, result, size, isInteger, [](auto a, auto b, auto* r) {
+              return __builtin_add_overflow(a, b, r);
+            });
+      }
+      break;
+    case OpCode::kMinus:
+      if (isDouble) {
+        binaryLoop<double, double>(
+            left, right, result, size, [](auto a, auto b) { return a - b; });
+      } else {
+        overflow = checkedLoop(
+            left, right, result, size, isInteger, [](auto a, auto b, auto* r) {
+              return __builtin_sub_overflow(a, b, r);
+            });
+      }
+      break;
+    case OpCode::kMultiply:
+      if (isDouble) {
+        binaryLoop<double, double>(
+            left, right, result, size, [](auto a, auto b) { return a * b; });
+      } else {
+        overflow = checkedLoop(
+            left, right, result, size, isInteger, [](auto a, auto b, auto* r) {
+              return __builtin_mul_overflow(a, b, r);
+            });
+      }
+      break;
+    case OpCode::kDivide:
+      binaryLoop<double, double>(
+          left, right, result, size, [](auto a, auto b) { return a / b; });
+      break;
+    case OpCode::kEq:
+      compare(kind, left, right, result, size, [](auto a, auto b) {
+        return a == b;
+      });
+      break;
+    case OpCode::kNeq:
+      compare(kind, left, right, result, size, [](auto a, auto b) {
+        return a != b;
+      });
+      break;
+    case OpCode::kLt:
+      compare(kind, left, right, result, size, [](auto a, auto b) {
+        return a < b;
+      });
+      break;
+    case OpCode::kLte:
+      compare(kind, left, right, result, size, [](auto a, auto b) {
+        return a <= b;
+      });
+      break;
+    case OpCode::kGt:
+      compare(kind, left, right, result, size, [](auto a, auto b) {
+        return a > b;
+      });
+      break;
+    case OpCode::kGte:
+      compare(kind, left, right, result, size, [](auto a, auto b) {
+        return a >= b;
+      });
+      break;
+    case OpCode::kAnd:
+      binaryLoop<int64_t, int64_t>(
+          left, right, result, size, [](auto a, auto b) { return a & b; });
+      break;
+    case OpCode::kOr:
+      binaryLoop<int64_t, int64_t>(
+          left, right, result, size, [](auto a, auto b) { return a | b; });
+      break;
+    case OpCode::kNot: {
+      const auto* values = reinterpret_cast<const int64_t*>(left);
+      auto* resultValues = reinterpret_cast<int64_t*>(result);
+      for (vector_size_t i = 0; i < size; ++i) {
+        resultValues[i] = values[i] ^ 1;
+      }
+      break;
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/Expressions.h"
+#include "velox/core/QueryCtx.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+/// A filter and projections over flat primitive columns compiled into a
+/// straight line program of typed loops over a whole batch. The instructions
+/// read and write scratch registers from the ExecCtx scratch arena, so no
+/// intermediate vectors are made and there is no per-row dispatch. Used by
+/// FilterProject instead of the interpreter in Expr::eval() for numeric
+/// pipelines.
+///
+/// Supports BOOLEAN, INTEGER, BIGINT and DOUBLE field references and
+/// constants, plus, minus, multiply, divide on DOUBLE, eq, neq, lt, lte, gt,
+/// gte, and, or and not. The functions are assumed to have Presto semantics.
+class FusedKernel {
+ public:
+  /// Returns the kernel for 'exprs' over rows of 'inputType'. Kernels are
+  /// compiled on first use and cached process wide by the fingerprint of
+  /// 'inputType' and 'exprs'. Returns nullptr if any of 'exprs' has a node
+  /// that the kernel does not support.
+  static std::shared_ptr<const FusedKernel> getOrCompile(
+      const std::vector<core::TypedExprPtr>& exprs,
+      const RowTypePtr& inputType);
+
+  /// Evaluates the expressions on all rows of 'input' and sets 'results[i]'
+  /// to the value of the i-th expression. Returns false if the batch cannot
+  /// be evaluated by the kernel, i.e. a referenced column has nulls or is not
+  /// flat, or an integer operation overflows. The caller must then evaluate
+  /// the batch with the interpreter, which also raises the overflow errors.
+  bool eval(
+      const RowVector& input,
+      core::ExecCtx& execCtx,
+      std::vector<VectorPtr>& results) const;
+
+  size_t numInstructions() const {
+    return instructions_.size();
+  }
+
+  static size_t testingCacheSize();
+
+  static void testingClearCache();
+
+ private:
+  enum class OpCode {
+    kField,
+    kConstant,
+    kPlus,
+    kMinus,
+    kMultiply,
+    kDivide,
+    kEq,
+    kNeq,
+    kLt,
+    kLte,
+    kGt,
+    kGte,
+    kAnd,
+    kOr,
+    kNot,
+  };
+
+  // Writes its result to the register with the same index as the
+  // instruction. Integer and boolean registers hold int64_t values, double
+  // registers hold doubles.
+  struct Instruction {
+    OpCode op;
+    // Kind of the operands, e.g. BIGINT for a comparison of BIGINTs.
+    TypeKind kind;
+    int32_t left{-1};
+    int32_t right{-1};
+    // Input column for kField.
+    column_index_t channel{0};
+    // Value of kConstant. The double constant is stored bit-wise.
+    int64_t constant{0};
+  };
+
+  class Compiler;
+
+  FusedKernel() = default;
+
+  void evalInstruction(
+      const Instruction& instruction,
+      vector_size_t size,
+      std::vector<char*>& registers,
+      bool& overflow) const;
+
+  std::vector<Instruction> instructions_;
+
+  // Distinct input columns read by the kernel.
+  std::vector<column_index_t> channels_;
+
+  // The register and the type of the result of each expression.
+  std::vector<std::pair<int32_t, TypePtr>> outputs_;
+};
+
+} // namespace facebook::velox::exec
@@ -22,6 +22,10 @@ using facebook::velox::common::testutil::TestValue;
 namespace facebook::velox::exec {
 
 namespace {
+// Number of index bits of the grouping key cardinality sketch. Uses 1KB of
+// memory for a standard error of about 3%.
+constexpr int8_t kKeyCardinalityIndexBits = 11;
+
 bool allAreSinglyReferenced(
     const std::vector<column_index_t>& argList,
     const std::unordered_map<column_index_t, int>& channelUseCount) {
@@ -61,7 +65,8 @@ GroupingSet::GroupingSet(
     uint32_t* numSpillRuns,
     tsan_atomic<bool>* nonReclaimableSection,
     OperatorCtx* operatorCtx)
-    : preGroupedKeyChannels_(std::move(preGroupedKeys)),
+    : inputType_(inputType),
+      preGroupedKeyChannels_(std::move(preGroupedKeys)),
       hashers_(std::move(hashers)),
       isGlobal_(hashers_.empty()),
       isPartial_(isPartial),
@@ -79,7 +84,8 @@ GroupingSet::GroupingSet(
       stringAllocator_(operatorCtx->pool()),
       rows_(operatorCtx->pool()),
       isAdaptive_(queryConfig_.hashAdaptivityEnabled()),
-      pool_(*operatorCtx->pool()) {
+      pool_(*operatorCtx->pool()),
+      denseKeyRange_(queryConfig_.aggregationDenseKeyRange()) {
   VELOX_CHECK_NOT_NULL(nonReclaimableSection_);
   VELOX_CHECK(pool_.trackUsage());
   for (auto& hasher : hashers_) {
@@ -130,6 +136,17 @@ GroupingSet::GroupingSet(
       distinctAggregations_.push_back(nullptr);
     }
   }
+
+  if (isPartial_ && !isGlobal_ &&
+      queryConfig_.partialAggregationKeySamplingEnabled()) {
+    keyCardinality_ = std::make_unique<common::hll::DenseHll>(
+        kKeyCardinalityIndexBits, &stringAllocator_);
+  }
+
+  denseMode_ = canUseDenseAccumulators();
+  if (denseMode_) {
+    lookup_ = std::make_unique<HashLookup>(hashers_);
+  }
 }
 
 GroupingSet::~GroupingSet() {
@@ -138,25 +155,6 @@ GroupingSet::~GroupingSet() {
   }
 }
 
-std::unique_ptr<GroupingSet> GroupingSet::createForMarkDistinct(
-    const RowTypePtr& inputType,
-    std::vector<std::unique_ptr<VectorHasher>>&& hashers,
-    OperatorCtx* operatorCtx,
-    tsan_atomic<bool>* nonReclaimableSection) {
-  return std::make_unique<GroupingSet>(
-      inputType,
-      std::move(hashers),
-      /*preGroupedKeys*/ std::vector<column_index_t>{},
-      /*aggregates*/ std::vector<AggregateInfo>{},
-      /*ignoreNullKeys*/ false,
-      /*isPartial*/ false,
-      /*isRawInput*/ false,
-      /*spillConfig*/ nullptr,
-      /*numSpillRuns*/ nullptr,
-      nonReclaimableSection,
-      operatorCtx);
-};
-
 namespace {
 bool equalKeys(
     const std::vector<column_index_t>& keys,
@@ -180,6 +178,13 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
     return;
   }
 
+  if (denseMode_) {
+    if (addDenseInput(input)) {
+      return;
+    }
+    flushDenseAccumulators();
+  }
+
   auto numRows = input->size();
   if (!preGroupedKeyChannels_.empty()) {
     if (remainingInput_) {
@@ -209,6 +214,10 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
 void GroupingSet::noMoreInput() {
   noMoreInput_ = true;
 
+  if (denseMode_) {
+    flushDenseAccumulators();
+  }
+
   if (remainingInput_) {
     addRemainingInput();
   }
@@ -252,6 +261,9 @@ void GroupingSet::addInputForActiveRows(
   table_->prepareForProbe(*lookup_, input, activeRows_, ignoreNullKeys_);
   table_->groupProbe(*lookup_);
   masks_.addInput(input, activeRows_);
+  if (keyCardinality_ != nullptr) {
+    sampleKeyCardinality();
+  }
 
   auto* groups = lookup_->hits.data();
   const auto& newGroups = lookup_->newGroups;
@@ -306,6 +318,24 @@ void GroupingSet::addInputForActiveRows(
   }
 }
 
+void GroupingSet::sampleKeyCardinality() {
+  // 'hashes' holds hash numbers in kHash mode and value ids or normalized keys
+  // otherwise. Either identifies the key, so mix them to spread the bits the
+  // sketch uses for bucketing. Value ids may change on rehash, which can only
+  // make the estimate a little high.
+  const auto* hashes = lookup_->hashes.data();
+  for (auto row : lookup_->rows) {
+    keyCardinality_->insertHash(folly::hasher<uint64_t>()(hashes[row]));
+  }
+}
+
+std::optional<int64_t> GroupingSet::estimateKeyCardinality() const {
+  if (keyCardinality_ == nullptr) {
+    return std::nullopt;
+  }
+  return keyCardinality_->cardinality();
+}
+
 void GroupingSet::addRemainingInput() {
   activeRows_.resize(remainingInput_->size());
   activeRows_.clearAll();
@@ -375,7 +405,15 @@ void GroupingSet::createHashTable() {
 
   RowContainer& rows = *table_->rows();
   initializeAggregates(aggregates_, rows, false);
+  initializeSortedAndDistinctAggregations(rows);
+
+  lookup_ = std::make_unique<HashLookup>(table_->hashers());
+  if (!isAdaptive_ && table_->hashMode() != BaseHashTable::HashMode::kHash) {
+    table_->forceGenericHashMode();
+  }
+}
 
+void GroupingSet::initializeSortedAndDistinctAggregations(RowContainer& rows) {
   auto numColumns = rows.keyTypes().size() + aggregates_.size();
 
   if (sortedAggregations_) {
@@ -404,11 +442,267 @@ void GroupingSet::createHashTable() {
       ++numColumns;
     }
   }
+}
 
-  lookup_ = std::make_unique<HashLookup>(table_->hashers());
-  if (!isAdaptive_ && table_->hashMode() != BaseHashTable::HashMode::kHash) {
-    table_->forceGenericHashMode();
+namespace {
+template <typename T>
+void readDenseKeys(
+    const DecodedVector& keys,
+    const SelectivityVector& rows,
+    int64_t* values) {
+  rows.applyToSelected([&](vector_size_t row) {
+    values[row] = keys.isNullAt(row) ? 0 : keys.valueAt<T>(row);
+  });
+}
+
+template <typename T>
+void writeDenseKeys(
+    int64_t base,
+    const vector_size_t* groups,
+    vector_size_t numGroups,
+    BaseVector& keys) {
+  auto* flatKeys = keys.asFlatVector<T>();
+  for (auto i = 0; i < numGroups; ++i) {
+    if (groups[i] == 0) {
+      flatKeys->setNull(i, true);
+    } else {
+      flatKeys->set(i, static_cast<T>(base + groups[i] - 1));
+    }
+  }
+}
+
+VectorPtr makeDenseAccumulators(
+    const TypePtr& type,
+    vector_size_t size,
+    memory::MemoryPool* pool) {
+  auto accumulators = BaseVector::create(type, size, pool);
+  accumulators->setNulls(allocateNulls(size, pool, bits::kNull));
+  auto* rawValues = accumulators->values()->asMutable<char>();
+  std::memset(rawValues, 0, accumulators->values()->size());
+  return accumulators;
+}
+} // namespace
+
+bool GroupingSet::canUseDenseAccumulators() const {
+  if (denseKeyRange_ == 0 || isGlobal_ || hashers_.size() != 1 ||
+      !preGroupedKeyChannels_.empty() || spillConfig_ != nullptr ||
+      aggregates_.empty() || sortedAggregations_ != nullptr ||
+      keyCardinality_ != nullptr) {
+    return false;
   }
+  switch (hashers_[0]->typeKind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      break;
+    default:
+      return false;
+  }
+  return std::all_of(
+      aggregates_.begin(), aggregates_.end(), [](const auto& aggregate) {
+        return !aggregate.distinct && !aggregate.mask.has_value() &&
+            aggregate.function->supportsDenseAccumulators();
+      });
+}
+
+bool GroupingSet::addDenseInput(const RowVectorPtr& input) {
+  const auto numRows = input->size();
+  activeRows_.resize(numRows);
+  activeRows_.setAll();
+  denseKeys_.decode(*input->childAt(keyChannels_[0]), activeRows_);
+
+  denseKeyValues_.resize(numRows);
+  auto* keyValues = denseKeyValues_.data();
+  switch (hashers_[0]->typeKind()) {
+    case TypeKind::TINYINT:
+      readDenseKeys<int8_t>(denseKeys_, activeRows_, keyValues);
+      break;
+    case TypeKind::SMALLINT:
+      readDenseKeys<int16_t>(denseKeys_, activeRows_, keyValues);
+      break;
+    case TypeKind::INTEGER:
+      readDenseKeys<int32_t>(denseKeys_, activeRows_, keyValues);
+      break;
+    case TypeKind::BIGINT:
+      readDenseKeys<int64_t>(denseKeys_, activeRows_, keyValues);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+
+  const bool mayHaveNullKeys = denseKeys_.mayHaveNulls();
+  int64_t min = std::numeric_limits<int64_t>::max();
+  int64_t max = std::numeric_limits<int64_t>::min();
+  for (auto row = 0; row < numRows; ++row) {
+    if (mayHaveNullKeys && denseKeys_.isNullAt(row)) {
+      continue;
+    }
+    min = std::min(min, keyValues[row]);
+    max = std::max(max, keyValues[row]);
+  }
+  if (!ensureDenseKeyRange(min, max)) {
+    return false;
+  }
+
+  const SelectivityVector* rows = &activeRows_;
+  if (mayHaveNullKeys && ignoreNullKeys_) {
+    denseRows_ = activeRows_;
+    denseRows_.deselectNulls(denseKeys_.nulls(&activeRows_), 0, numRows);
+    rows = &denseRows_;
+  }
+
+  denseIndices_.resize(numRows);
+  auto* groups = denseIndices_.data();
+  rows->applyToSelected([&](vector_size_t row) {
+    const vector_size_t group = mayHaveNullKeys && denseKeys_.isNullAt(row)
+        ? 0
+        : keyValues[row] - denseBase_ + 1;
+    groups[row] = group;
+    if (!bits::isBitSet(denseGroups_.data(), group)) {
+      bits::setBit(denseGroups_.data(), group);
+      ++numDenseGroups_;
+    }
+  });
+
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    populateTempVectors(i, input);
+    aggregates_[i].function->addDenseInput(
+        groups, *rows, tempVectors_, isRawInput_, *denseAccumulators_[i]);
+  }
+  tempVectors_.clear();
+  return true;
+}
+
+bool GroupingSet::ensureDenseKeyRange(int64_t min, int64_t max) {
+  const bool hasRange = denseNumValues_ > 0;
+  if (!denseAccumulators_.empty() && min > max) {
+    return true;
+  }
+  int64_t newBase = min;
+  int64_t newMax = max;
+  if (hasRange) {
+    newBase = std::min(min, denseBase_);
+    newMax = std::max(max, denseBase_ + denseNumValues_ - 1);
+    if (newBase == denseBase_ &&
+        newMax == denseBase_ + denseNumValues_ - 1) {
+      return true;
+    }
+  }
+  // Computes the size unsigned to not overflow on the full range of BIGINT.
+  uint64_t newNumValues = 0;
+  if (newMax >= newBase) {
+    newNumValues =
+        static_cast<uint64_t>(newMax) - static_cast<uint64_t>(newBase) + 1;
+    if (newNumValues > denseKeyRange_ ||
+        newNumValues >= std::numeric_limits<vector_size_t>::max()) {
+      return false;
+    }
+  } else {
+    // No non-null keys yet. Only the null key group is allocated.
+    newBase = 0;
+  }
+
+  // Group 0 stays the null key group and the other groups move by 'shift'.
+  const auto numGroups = static_cast<vector_size_t>(newNumValues + 1);
+  const int64_t shift = hasRange ? denseBase_ - newBase : 0;
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    auto accumulators = makeDenseAccumulators(
+        aggregates_[i].intermediateType, numGroups, &pool_);
+    if (!denseAccumulators_.empty()) {
+      const auto& oldAccumulators = denseAccumulators_[i];
+      accumulators->copy(oldAccumulators.get(), 0, 0, 1);
+      accumulators->copy(
+          oldAccumulators.get(), shift + 1, 1, oldAccumulators->size() - 1);
+      denseAccumulators_[i] = std::move(accumulators);
+    } else {
+      denseAccumulators_.push_back(std::move(accumulators));
+    }
+  }
+
+  std::vector<uint64_t> groups(bits::nwords(numGroups));
+  if (!denseGroups_.empty()) {
+    bits::forEachSetBit(
+        denseGroups_.data(), 0, denseNumValues_ + 1, [&](auto group) {
+          bits::setBit(groups.data(), group == 0 ? 0 : group + shift);
+        });
+  }
+  denseGroups_ = std::move(groups);
+  denseBase_ = newBase;
+  denseNumValues_ = numGroups - 1;
+  return true;
+}
+
+void GroupingSet::flushDenseAccumulators() {
+  VELOX_CHECK(denseMode_);
+  denseMode_ = false;
+  if (!table_) {
+    createHashTable();
+  }
+  if (numDenseGroups_ == 0) {
+    denseAccumulators_.clear();
+    return;
+  }
+
+  const auto numGroups = numDenseGroups_;
+  BufferPtr indices = allocateIndices(numGroups, &pool_);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t numIndices = 0;
+  bits::forEachSetBit(
+      denseGroups_.data(), 0, denseNumValues_ + 1, [&](auto group) {
+        rawIndices[numIndices++] = group;
+      });
+  VELOX_CHECK_EQ(numIndices, numGroups);
+
+  // Makes an input with the keys of the groups. The other columns are not
+  // read.
+  const auto keyChannel = keyChannels_[0];
+  std::vector<VectorPtr> children(inputType_->size());
+  for (auto i = 0; i < children.size(); ++i) {
+    if (i != keyChannel) {
+      children[i] = BaseVector::createNullConstant(
+          inputType_->childAt(i), numGroups, &pool_);
+    }
+  }
+  auto& keys = children[keyChannel];
+  keys = BaseVector::create(inputType_->childAt(keyChannel), numGroups, &pool_);
+  switch (keys->typeKind()) {
+    case TypeKind::TINYINT:
+      writeDenseKeys<int8_t>(denseBase_, rawIndices, numGroups, *keys);
+      break;
+    case TypeKind::SMALLINT:
+      writeDenseKeys<int16_t>(denseBase_, rawIndices, numGroups, *keys);
+      break;
+    case TypeKind::INTEGER:
+      writeDenseKeys<int32_t>(denseBase_, rawIndices, numGroups, *keys);
+      break;
+    case TypeKind::BIGINT:
+      writeDenseKeys<int64_t>(denseBase_, rawIndices, numGroups, *keys);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+  auto input = std::make_shared<RowVector>(
+      &pool_, inputType_, nullptr, numGroups, std::move(children));
+
+  activeRows_.resize(numGroups);
+  activeRows_.setAll();
+  table_->prepareForProbe(*lookup_, input, activeRows_, ignoreNullKeys_);
+  table_->groupProbe(*lookup_);
+  auto* groups = lookup_->hits.data();
+  const auto& newGroups = lookup_->newGroups;
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    auto& function = aggregates_[i].function;
+    function->initializeNewGroups(groups, newGroups);
+    // The dense accumulators are intermediate results.
+    std::vector<VectorPtr> args{BaseVector::wrapInDictionary(
+        nullptr, indices, numGroups, denseAccumulators_[i])};
+    function->addIntermediateResults(groups, activeRows_, args, false);
+  }
+
+  denseAccumulators_.clear();
+  denseGroups_.clear();
+  numDenseGroups_ = 0;
 }
 
 void GroupingSet::initializeGlobalAggregation() {
@@ -652,9 +946,12 @@ bool GroupingSet::getOutput(
     return getGlobalAggregationOutput(
         maxOutputRows, isPartial_, iterator, result);
   }
-  if (hasSpilled()) {
+  if (hasSpilled() || outputPartition_ != -1) {
     return getOutputWithSpill(maxOutputRows, maxOutputBytes, result);
   }
+  if (denseMode_) {
+    flushDenseAccumulators();
+  }
 
   // @lint-ignore CLANGTIDY
   char* groups[maxOutputRows];
@@ -663,8 +960,13 @@ bool GroupingSet::getOutput(
             &iterator, maxOutputRows, maxOutputBytes, groups)
       : 0;
   if (numGroups == 0) {
-    if (table_ != nullptr) {
-      table_->clear();
+    if (table_ == nullptr) {
+      return false;
+    }
+    table_->clear();
+    if (spillPartitionSource_ != nullptr) {
+      // Restores the spilled partitions of other grouping sets.
+      return getOutputWithSpill(maxOutputRows, maxOutputBytes, result);
     }
     return false;
   }
@@ -743,6 +1045,14 @@ uint64_t GroupingSet::allocatedBytes() const {
     return table_->allocatedBytes();
   }
 
+  if (denseMode_) {
+    uint64_t denseBytes = 0;
+    for (const auto& accumulators : denseAccumulators_) {
+      denseBytes += accumulators->retainedSize();
+    }
+    return denseBytes;
+  }
+
   return stringAllocator_.retainedSize() + rows_.allocatedBytes();
 }
 
@@ -876,6 +1186,36 @@ void GroupingSet::ensureOutputFits() {
   spill(RowContainerIterator{});
 }
 
+RowTypePtr GroupingSet::makeSpillType() const {
+  // The columns follow the accumulators in the rows of 'table_': the keys, one
+  // column per aggregate, one for the input rows of 'sortedAggregations_' and
+  // one for the unique inputs of each of 'distinctAggregations_'.
+  auto types = table_->rows()->keyTypes();
+  for (const auto& aggregate : aggregates_) {
+    types.push_back(aggregate.intermediateType);
+  }
+  if (sortedAggregations_ != nullptr) {
+    types.push_back(sortedAggregations_->spillType());
+  }
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      types.push_back(aggregation->spillType());
+    }
+  }
+  std::vector<std::string> names;
+  for (auto i = 0; i < types.size(); ++i) {
+    names.push_back(fmt::format("s{}", i));
+  }
+  return ROW(std::move(names), std::move(types));
+}
+
+void GroupingSet::eraseGroups(folly::Range<char**> groups) {
+  if (sortedAggregations_ != nullptr) {
+    sortedAggregations_->eraseInputs(groups);
+  }
+  table_->erase(groups);
+}
+
 void GroupingSet::spill(int64_t targetRows, int64_t targetBytes) {
   // NOTE: if the disk spilling is triggered by the memory arbitrator, then it
   // is possible that the grouping set hasn't processed any input data yet.
@@ -885,20 +1225,12 @@ void GroupingSet::spill(int64_t targetRows, int64_t targetBytes) {
   }
   if (!hasSpilled()) {
     auto rows = table_->rows();
-    auto types = rows->keyTypes();
-    for (const auto& aggregate : aggregates_) {
-      types.push_back(aggregate.intermediateType);
-    }
-    std::vector<std::string> names;
-    for (auto i = 0; i < types.size(); ++i) {
-      names.push_back(fmt::format("s{}", i));
-    }
     VELOX_DCHECK(pool_.trackUsage());
     spiller_ = std::make_unique<Spiller>(
         Spiller::Type::kAggregateInput,
         rows,
-        [&](folly::Range<char**> rows) { table_->erase(rows); },
-        ROW(std::move(names), std::move(types)),
+        [&](folly::Range<char**> rows) { eraseGroups(rows); },
+        makeSpillType(),
         HashBitRange(
             spillConfig_->startPartitionBit,
             spillConfig_->startPartitionBit +
@@ -911,7 +1243,9 @@ void GroupingSet::spill(int64_t targetRows, int64_t targetBytes) {
         spillConfig_->minSpillRunSize,
         spillConfig_->compressionKind,
         memory::spillMemoryPool(),
-        spillConfig_->executor);
+        spillConfig_->executor,
+        spillConfig_->overflowTier,
+        spillConfig_->fileFormat);
   }
   ++(*numSpillRuns_);
   spiller_->spill(targetRows, targetBytes);
@@ -928,67 +1262,80 @@ void GroupingSet::spill(const RowContainerIterator& rowIterator) {
   }
 
   auto* rows = table_->rows();
-  auto types = rows->keyTypes();
-  for (const auto& aggregate : aggregates_) {
-    types.push_back(aggregate.intermediateType);
-  }
-  std::vector<std::string> names;
-  for (auto i = 0; i < types.size(); ++i) {
-    names.push_back(fmt::format("s{}", i));
-  }
   VELOX_CHECK(pool_.trackUsage());
   spiller_ = std::make_unique<Spiller>(
       Spiller::Type::kAggregateOutput,
       rows,
-      [&](folly::Range<char**> rows) { table_->erase(rows); },
-      ROW(std::move(names), std::move(types)),
+      [&](folly::Range<char**> rows) { eraseGroups(rows); },
+      makeSpillType(),
       spillConfig_->filePath,
       spillConfig_->writeBufferSize,
       spillConfig_->compressionKind,
       memory::spillMemoryPool(),
-      spillConfig_->executor);
+      spillConfig_->executor,
+      spillConfig_->overflowTier,
+      spillConfig_->fileFormat);
 
   ++(*numSpillRuns_);
   spiller_->spill(rowIterator);
   table_->clear();
 }
 
+SpillPartitionSet GroupingSet::finishSpillToFiles() {
+  VELOX_CHECK(noMoreInput_);
+  VELOX_CHECK(hasSpilled());
+  VELOX_CHECK_EQ(outputPartition_, -1);
+  SpillPartitionSet partitionSet;
+  nonSpilledRows_ = spiller_->finishSpillToFiles(partitionSet);
+  prepareSpillOutput();
+  // The spill files of 'spiller_' are in 'partitionSet' now.
+  outputPartition_ = spiller_->state().maxPartitions();
+  return partitionSet;
+}
+
+void GroupingSet::prepareSpillOutput() {
+  mergeArgs_.resize(1);
+  std::vector<TypePtr> keyTypes;
+  for (auto& hasher : table_->hashers()) {
+    keyTypes.push_back(hasher->type());
+  }
+
+  mergeRows_ = std::make_unique<RowContainer>(
+      keyTypes,
+      !ignoreNullKeys_,
+      accumulators(false),
+      std::vector<TypePtr>(),
+      false,
+      false,
+      false,
+      false,
+      &pool_,
+      table_->rows()->stringAllocatorShared());
+
+  initializeAggregates(aggregates_, *mergeRows_, false);
+  initializeSortedAndDistinctAggregations(*mergeRows_);
+
+  // Take ownership of the rows and free the hash table. The table will not be
+  // needed for producing spill output.
+  nonSpilledRowContainer_ = table_->moveRows();
+  table_.reset();
+}
+
 bool GroupingSet::getOutputWithSpill(
     int32_t maxOutputRows,
     int32_t maxOutputBytes,
     const RowVectorPtr& result) {
   if (outputPartition_ == -1) {
-    mergeArgs_.resize(1);
-    std::vector<TypePtr> keyTypes;
-    for (auto& hasher : table_->hashers()) {
-      keyTypes.push_back(hasher->type());
-    }
-
-    mergeRows_ = std::make_unique<RowContainer>(
-        keyTypes,
-        !ignoreNullKeys_,
-        accumulators(false),
-        std::vector<TypePtr>(),
-        false,
-        false,
-        false,
-        false,
-        &pool_,
-        table_->rows()->stringAllocatorShared());
-
-    initializeAggregates(aggregates_, *mergeRows_, false);
-
-    // Take ownership of the rows and free the hash table. The table will not be
-    // needed for producing spill output.
-    nonSpilledRowContainer_ = table_->moveRows();
-    table_.reset();
+    prepareSpillOutput();
     outputPartition_ = 0;
-    nonSpilledRows_ = spiller_->finishSpill();
+    nonSpilledRows_ = hasSpilled()
+        ? spiller_->finishSpill()
+        : Spiller::SpillRows(0, memory::StlAllocator<char*>(pool_));
   }
 
   // NOTE: we don't expect non-spilled rows if spilling is triggered during the
   // aggregation output processing.
-  if (spiller_->type() == Spiller::Type::kAggregateOutput) {
+  if (hasSpilled() && spiller_->type() == Spiller::Type::kAggregateOutput) {
     VELOX_CHECK_EQ(nonSpilledRows_.value().size(), 0);
   }
 
@@ -1003,7 +1350,9 @@ bool GroupingSet::getOutputWithSpill(
     return true;
   }
 
-  while (outputPartition_ < spiller_->state().maxPartitions()) {
+  const int32_t numPartitions =
+      hasSpilled() ? spiller_->state().maxPartitions() : 0;
+  while (outputPartition_ < numPartitions) {
     if (merge_ == nullptr) {
       merge_ = spiller_->startMerge(outputPartition_);
     }
@@ -1016,6 +1365,24 @@ bool GroupingSet::getOutputWithSpill(
     }
     return true;
   }
+
+  while (spillPartitionSource_ != nullptr) {
+    if (merge_ == nullptr) {
+      auto partition = spillPartitionSource_();
+      if (partition == nullptr) {
+        spillPartitionSource_ = nullptr;
+        break;
+      }
+      // NOTE: 'merge_' might be nullptr if 'partition' has no files.
+      merge_ = partition->createOrderedReader();
+      continue;
+    }
+    if (!mergeNext(maxOutputRows, maxOutputBytes, result)) {
+      merge_ = nullptr;
+      continue;
+    }
+    return true;
+  }
   return false;
 }
 
@@ -1069,9 +1436,20 @@ void GroupingSet::initializeRow(SpillMergeStream& keys, char* row) {
     mergeRows_->store(keys.decoded(i), keys.currentIndex(), mergeState_, i);
   }
   vector_size_t zero = 0;
-  for (auto& aggregate : aggregates_) {
-    aggregate.function->initializeNewGroups(
-        &row, folly::Range<const vector_size_t*>(&zero, 1));
+  const folly::Range<const vector_size_t*> firstRow(&zero, 1);
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    // Sorted and distinct aggregations initialize their aggregates.
+    if (!aggregates_[i].sortingKeys.empty()) {
+      continue;
+    }
+    if (aggregates_[i].distinct) {
+      distinctAggregations_[i]->initializeNewGroups(&row, firstRow);
+      continue;
+    }
+    aggregates_[i].function->initializeNewGroups(&row, firstRow);
+  }
+  if (sortedAggregations_ != nullptr) {
+    sortedAggregations_->initializeNewGroups(&row, firstRow);
   }
 }
 
@@ -1083,6 +1461,10 @@ void GroupingSet::extractSpillResult(const RowVectorPtr& result) {
         &iter, rows.size(), RowContainer::kUnlimited, rows.data());
   }
   extractGroups(folly::Range<char**>(rows.data(), rows.size()), result);
+  if (sortedAggregations_ != nullptr) {
+    sortedAggregations_->eraseInputs(
+        folly::Range<char**>(rows.data(), rows.size()));
+  }
   mergeRows_->clear();
 }
 
@@ -1093,15 +1475,36 @@ void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
   }
   mergeSelection_.setValid(input.currentIndex(), true);
   mergeSelection_.updateBounds();
+  const auto& spilled = input.current();
   for (auto i = 0; i < aggregates_.size(); ++i) {
-    mergeArgs_[0] = input.current().childAt(i + keyChannels_.size());
+    // The aggregates of sorted and distinct aggregations only get input when
+    // producing output. Their spilled state is in the columns below.
+    if (!aggregates_[i].sortingKeys.empty() || aggregates_[i].distinct) {
+      continue;
+    }
+    mergeArgs_[0] = spilled.childAt(i + keyChannels_.size());
     aggregates_[i].function->addSingleGroupIntermediateResults(
         row, mergeSelection_, mergeArgs_, false);
   }
   mergeSelection_.setValid(input.currentIndex(), false);
+
+  auto column = keyChannels_.size() + aggregates_.size();
+  if (sortedAggregations_ != nullptr) {
+    sortedAggregations_->addSingleGroupSpillInput(
+        row, spilled.childAt(column++), input.currentIndex());
+  }
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      aggregation->addSingleGroupSpillInput(
+          row, spilled.childAt(column++), input.currentIndex());
+    }
+  }
 }
 
 void GroupingSet::abandonPartialAggregation() {
+  if (denseMode_) {
+    flushDenseAccumulators();
+  }
   abandonedPartialAggregation_ = true;
   allSupportToIntermediate_ = true;
   for (auto& aggregate : aggregates_) {
@@ -1124,6 +1527,7 @@ void GroupingSet::abandonPartialAggregation() {
       table_->rows()->stringAllocatorShared());
   initializeAggregates(aggregates_, *intermediateRows_, true);
   table_.reset();
+  keyCardinality_.reset();
 }
 
 namespace {
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/hyperloglog/DenseHll.h"
 #include "velox/exec/AggregateInfo.h"
 #include "velox/exec/AggregationMasks.h"
 #include "velox/exec/DistinctAggregations.h"
@@ -43,13 +44,6 @@ class GroupingSet {
 
   ~GroupingSet();
 
-  // Used by MarkDistinct operator to identify rows with unique values.
-  static std::unique_ptr<GroupingSet> createForMarkDistinct(
-      const RowTypePtr& inputType,
-      std::vector<std::unique_ptr<VectorHasher>>&& hashers,
-      OperatorCtx* operatorCtx,
-      tsan_atomic<bool>* nonReclaimableSection);
-
   void addInput(const RowVectorPtr& input, bool mayPushdown);
 
   void noMoreInput();
@@ -86,11 +80,16 @@ class GroupingSet {
 
   /// Returns the count of the hash table, if any.
   int64_t numDistinct() const {
-    return table_ ? table_->numDistinct() : 0;
+    return table_ ? table_->numDistinct() : numDenseGroups_;
   }
 
   const HashLookup& hashLookup() const;
 
+  /// Returns an estimate of the number of distinct grouping keys added since
+  /// 'this' was created, including the groups flushed by resetPartial().
+  /// Returns std::nullopt if key cardinality sampling is not enabled.
+  std::optional<int64_t> estimateKeyCardinality() const;
+
   /// Spills content until under 'targetRows' and under 'targetBytes'
   /// of out of line data are left. If targetRows is 0, spills
   /// everything and physically frees the data in the
@@ -104,6 +103,21 @@ class GroupingSet {
   /// 'rowIterator'.
   void spill(const RowContainerIterator& rowIterator);
 
+  /// Finishes spilling after noMoreInput() and writes all data of the spilled
+  /// partitions to disk, see Spiller::finishSpillToFiles(). Returns the
+  /// spilled partitions, which any GroupingSet of the same aggregation can
+  /// restore via setSpillPartitionSource(). getOutput() then only produces
+  /// the rows of the partitions that have not spilled.
+  SpillPartitionSet finishSpillToFiles();
+
+  /// Sets the source of spilled partitions that getOutput() restores after
+  /// producing the groups of 'this'. 'source' returns nullptr when there are
+  /// no more partitions.
+  void setSpillPartitionSource(
+      std::function<std::unique_ptr<SpillPartition>()> source) {
+    spillPartitionSource_ = std::move(source);
+  }
+
   /// Returns the spiller stats including total bytes and rows spilled so far.
   std::optional<SpillStats> spilledStats() const {
     if (spiller_ == nullptr) {
@@ -145,6 +159,9 @@ class GroupingSet {
 
   void addRemainingInput();
 
+  // Adds the grouping keys of the rows in 'lookup_' to 'keyCardinality_'.
+  void sampleKeyCardinality();
+
   void initializeGlobalAggregation();
 
   void destroyGlobalAggregations();
@@ -159,6 +176,34 @@ class GroupingSet {
 
   void createHashTable();
 
+  // Sets the offsets of the accumulators of 'sortedAggregations_' and
+  // 'distinctAggregations_' in 'rows'.
+  void initializeSortedAndDistinctAggregations(RowContainer& rows);
+
+  // Returns the type of the spilled rows of 'table_'.
+  RowTypePtr makeSpillType() const;
+
+  // Erases 'groups' from 'table_' after spilling them.
+  void eraseGroups(folly::Range<char**> groups);
+
+  // Returns true if the accumulators can be kept in dense arrays indexed by
+  // the value of the single grouping key. See
+  // QueryConfig::kAggregationDenseKeyRange.
+  bool canUseDenseAccumulators() const;
+
+  // Adds 'input' to the dense accumulators. Returns false without adding if
+  // the keys of 'input' do not fit in the dense key range.
+  bool addDenseInput(const RowVectorPtr& input);
+
+  // Extends the dense accumulators to cover keys from 'min' to 'max'. Returns
+  // false if the range gets too large.
+  bool ensureDenseKeyRange(int64_t min, int64_t max);
+
+  // Moves the groups of the dense accumulators into 'table_' and stops using
+  // dense accumulators. Called before anything that needs 'table_', e.g.
+  // producing output.
+  void flushDenseAccumulators();
+
   void populateTempVectors(int32_t aggregateIndex, const RowVectorPtr& input);
 
   // If the given aggregation has mask, the method returns reference to the
@@ -180,9 +225,14 @@ class GroupingSet {
   // otherwise.
   void extractGroups(folly::Range<char**> groups, const RowVectorPtr& result);
 
+  // Sets up 'mergeRows_' for merging spilled data and moves the rows of
+  // 'table_' to 'nonSpilledRowContainer_'.
+  void prepareSpillOutput();
+
   // Produces output in if spilling has occurred. First produces data
   // from non-spilled partitions, then merges spill runs and unspilled data
-  // form spilled partitions. Returns nullptr when at end. 'maxOutputRows' and
+  // form spilled partitions, then the partitions from
+  // 'spillPartitionSource_'. Returns nullptr when at end. 'maxOutputRows' and
   // 'maxOutputBytes' specifies the max number of output rows and bytes in
   // 'result'.
   bool getOutputWithSpill(
@@ -234,6 +284,8 @@ class GroupingSet {
       int32_t maxOutputRows,
       int32_t maxOutputBytes) const;
 
+  const RowTypePtr inputType_;
+
   std::vector<column_index_t> keyChannels_;
 
   /// A subset of grouping keys on which the input is clustered.
@@ -279,6 +331,12 @@ class GroupingSet {
   // Used to allocate memory for a single row accumulating results of global
   // aggregation
   HashStringAllocator stringAllocator_;
+
+  // Sketch of the hashes of all grouping keys seen by a partial aggregation if
+  // 'partial_aggregation_key_sampling_enabled' is set. Unlike 'table_', this
+  // is not reset on flush, so it tells whether keys repeat over a longer
+  // horizon than what fits in memory. Allocated from 'stringAllocator_'.
+  std::unique_ptr<common::hll::DenseHll> keyCardinality_;
   memory::AllocationPool rows_;
   const bool isAdaptive_;
 
@@ -308,6 +366,10 @@ class GroupingSet {
   // The currently running spill partition in producing spilled output.
   int32_t outputPartition_{-1};
 
+  // Returns the spill partitions to restore after the partitions of
+  // 'spiller_', e.g. those handed out by the peers of a parallel restore.
+  std::function<std::unique_ptr<SpillPartition>()> spillPartitionSource_;
+
   // Intermediate vector for passing arguments to aggregate in merging spill.
   std::vector<VectorPtr> mergeArgs_;
 
@@ -337,6 +399,33 @@ class GroupingSet {
   // 'spillConfig_->testSpillPct'.
   uint64_t spillTestCounter_{0};
 
+  // The max number of key values covered by the dense accumulators.
+  const uint64_t denseKeyRange_;
+
+  // True while accumulating in 'denseAccumulators_' instead of 'table_'.
+  bool denseMode_{false};
+
+  // The key value of group 1 of the dense accumulators. Group 0 is for the
+  // null key and group 'i' for key 'denseBase_ + i - 1'.
+  int64_t denseBase_{0};
+
+  // The number of key values covered by the dense accumulators.
+  int64_t denseNumValues_{0};
+
+  // A flat vector of the intermediate type per aggregate, with one entry per
+  // group.
+  std::vector<VectorPtr> denseAccumulators_;
+
+  // A bit per group that is set if the group has input.
+  std::vector<uint64_t> denseGroups_;
+  int64_t numDenseGroups_{0};
+
+  // Reusable memory for dense input processing.
+  DecodedVector denseKeys_;
+  raw_vector<int64_t> denseKeyValues_;
+  raw_vector<vector_size_t> denseIndices_;
+  SelectivityVector denseRows_;
+
   // True if partial aggregation has been given up as non-productive.
   bool abandonedPartialAggregation_{false};
 
@@ -24,6 +24,9 @@
 namespace facebook::velox::exec {
 
 namespace {
+// If more than this many are unique at full memory, give up on partial agg.
+constexpr int32_t kPartialMinFinalPct = 40;
+
 std::vector<core::LambdaTypedExprPtr> extractLambdaInputs(
     const core::AggregationNode::Aggregate& aggregate) {
   std::vector<core::LambdaTypedExprPtr> lambdas;
@@ -114,6 +117,9 @@ HashAggregation::HashAggregation(
       isDistinct_(!isGlobal_ && aggregationNode->aggregates().empty()),
       maxExtendedPartialAggregationMemoryUsage_(
           driverCtx->queryConfig().maxExtendedPartialAggregationMemoryUsage()),
+      parallelSpillRestore_(
+          spillConfig_.has_value() && !isGlobal_ &&
+          driverCtx->queryConfig().aggregationSpillParallelRestoreEnabled()),
       maxPartialAggregationMemoryUsage_(
           driverCtx->queryConfig().maxPartialAggregationMemoryUsage()),
       abandonPartialAggregationMinRows_(
@@ -124,8 +130,8 @@ HashAggregation::HashAggregation(
 
   auto inputType = aggregationNode->sources()[0]->outputType();
 
-  auto hashers =
-      createVectorHashers(inputType, aggregationNode->groupingKeys());
+  auto hashers = createVectorHashers(
+      inputType, aggregationNode->groupingKeys(), pool());
   auto numHashers = hashers.size();
 
   std::vector<column_index_t> preGroupedChannels;
@@ -244,6 +250,7 @@ void HashAggregation::addInput(RowVectorPtr input) {
   }
   groupingSet_->addInput(input, mayPushdown_);
   numInputRows_ += input->size();
+  numAggregatedInputRows_ += input->size();
 
   updateRuntimeStats();
 
@@ -349,19 +356,33 @@ void HashAggregation::resetPartialOutputIfNeed() {
 
 void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
     double aggregationPct) {
-  // If more than this many are unique at full memory, give up on partial agg.
-  constexpr int32_t kPartialMinFinalPct = 40;
   VELOX_DCHECK(isPartialOutput_);
-  // If size is at max and there still is not enough reduction, abandon partial
-  // aggregation.
-  if (abandonPartialAggregationEarly(numOutputRows_) ||
+  if (const auto keyCardinality = groupingSet_->estimateKeyCardinality()) {
+    const auto mode =
+        decidePartialAggregationMode(aggregationPct, keyCardinality.value());
+    addRuntimeStat(
+        "partialAggregationKeyCardinality",
+        RuntimeCounter(keyCardinality.value()));
+    switch (mode) {
+      case PartialAggregationMode::kAggregate:
+        addRuntimeStat("partialAggregationKeepAggregating", RuntimeCounter(1));
+        break;
+      case PartialAggregationMode::kFlushHotKeys:
+        addRuntimeStat("partialAggregationFlushHotKeys", RuntimeCounter(1));
+        return;
+      case PartialAggregationMode::kPassThrough:
+        addRuntimeStat("partialAggregationPassThrough", RuntimeCounter(1));
+        abandonPartialAggregation();
+        return;
+    }
+  } else if (
+      abandonPartialAggregationEarly(numOutputRows_) ||
       (aggregationPct > kPartialMinFinalPct &&
        maxPartialAggregationMemoryUsage_ >=
            maxExtendedPartialAggregationMemoryUsage_)) {
-    groupingSet_->abandonPartialAggregation();
-    pool()->release();
-    addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
-    abandonedPartialAggregation_ = true;
+    // If size is at max and there still is not enough reduction, abandon
+    // partial aggregation.
+    abandonPartialAggregation();
     return;
   }
   const int64_t extendedPartialAggregationMemoryUsage = std::min(
@@ -385,6 +406,42 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
           maxPartialAggregationMemoryUsage_, RuntimeCounter::Unit::kBytes));
 }
 
+HashAggregation::PartialAggregationMode
+HashAggregation::decidePartialAggregationMode(
+    double aggregationPct,
+    int64_t keyCardinality) const {
+  VELOX_DCHECK_GT(numAggregatedInputRows_, 0);
+  // The sketch is not reset on flush, so this tells whether keys repeat at all
+  // or only fail to repeat within the memory limit.
+  const int64_t keyCardinalityPct = 100 *
+      std::min(keyCardinality, numAggregatedInputRows_) /
+      numAggregatedInputRows_;
+  if (numAggregatedInputRows_ > abandonPartialAggregationMinRows_ &&
+      keyCardinalityPct >= abandonPartialAggregationMinPct_) {
+    return PartialAggregationMode::kPassThrough;
+  }
+  if (aggregationPct <= kPartialMinFinalPct || numOutputRows_ == 0) {
+    return PartialAggregationMode::kAggregate;
+  }
+  // The last run filled 'maxPartialAggregationMemoryUsage_' with
+  // 'numOutputRows_' groups. Keep growing if all keys would fit in the
+  // extended limit.
+  const double bytesPerGroup =
+      static_cast<double>(maxPartialAggregationMemoryUsage_) / numOutputRows_;
+  if (keyCardinality * bytesPerGroup <=
+      maxExtendedPartialAggregationMemoryUsage_) {
+    return PartialAggregationMode::kAggregate;
+  }
+  return PartialAggregationMode::kFlushHotKeys;
+}
+
+void HashAggregation::abandonPartialAggregation() {
+  groupingSet_->abandonPartialAggregation();
+  pool()->release();
+  addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
+  abandonedPartialAggregation_ = true;
+}
+
 RowVectorPtr HashAggregation::getOutput() {
   if (finished_) {
     input_ = nullptr;
@@ -466,11 +523,75 @@ RowVectorPtr HashAggregation::getOutput() {
 void HashAggregation::noMoreInput() {
   groupingSet_->noMoreInput();
   Operator::noMoreInput();
+  if (parallelSpillRestore_ &&
+      operatorCtx_->task()->numDrivers(operatorCtx_->driver()) > 1) {
+    startParallelSpillRestore();
+  }
   recordSpillStats();
   // Release the extra reserved memory right after processing all the inputs.
   pool()->release();
 }
 
+void HashAggregation::startParallelSpillRestore() {
+  if (groupingSet_->hasSpilled()) {
+    spillPartitions_ = groupingSet_->finishSpillToFiles();
+  }
+
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(),
+          operatorCtx_->driver(),
+          &restoreFuture_,
+          promises,
+          peers)) {
+    return;
+  }
+
+  auto promisesGuard = folly::makeGuard([&]() {
+    // Realize the promises so that the other Drivers (which were not the last
+    // to finish) can continue from the barrier and produce output.
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  });
+
+  std::vector<HashAggregation*> aggregations{this};
+  for (auto& peer : peers) {
+    auto* aggregation =
+        dynamic_cast<HashAggregation*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(aggregation);
+    aggregations.push_back(aggregation);
+  }
+
+  std::vector<SpillPartitionSet> partitionSets;
+  bool hasSpillPartitions{false};
+  for (auto* aggregation : aggregations) {
+    hasSpillPartitions |= !aggregation->spillPartitions_.empty();
+    partitionSets.push_back(std::move(aggregation->spillPartitions_));
+  }
+  if (!hasSpillPartitions) {
+    return;
+  }
+  auto workQueues =
+      std::make_shared<SpillPartitionWorkQueues>(std::move(partitionSets));
+  for (auto i = 0; i < aggregations.size(); ++i) {
+    aggregations[i]->groupingSet_->setSpillPartitionSource(
+        [workQueues, i]() { return workQueues->next(i); });
+  }
+  addRuntimeStat(
+      "parallelSpillRestoreDrivers", RuntimeCounter(aggregations.size()));
+}
+
+BlockingReason HashAggregation::isBlocked(ContinueFuture* future) {
+  if (restoreFuture_.valid()) {
+    *future = std::move(restoreFuture_);
+    return BlockingReason::kWaitForSpill;
+  }
+  return BlockingReason::kNotBlocked;
+}
+
 bool HashAggregation::isFinished() {
   return finished_;
 }
@@ -37,9 +37,7 @@ class HashAggregation : public Operator {
 
   void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
@@ -65,6 +63,30 @@ class HashAggregation : public Operator {
   // measure of the effectiveness of the partial aggregation.
   void maybeIncreasePartialAggregationMemoryUsage(double aggregationPct);
 
+  // What to do with a partial aggregation after a flush, decided from the
+  // sampled grouping key cardinality.
+  enum class PartialAggregationMode {
+    // The keys repeat and all of them are expected to fit in
+    // 'maxExtendedPartialAggregationMemoryUsage_'. Keeps aggregating and
+    // extends the memory limit if needed.
+    kAggregate,
+    // The keys repeat but there are too many of them to fit in memory. Keeps
+    // the memory limit and flushes whenever full, so that the table works as
+    // a fixed-size cache in which the hot keys get aggregated between flushes.
+    kFlushHotKeys,
+    // Most keys are unique. Abandons partial aggregation.
+    kPassThrough,
+  };
+
+  // Picks the mode for the next run of partial aggregation. 'keyCardinality'
+  // is the estimated number of distinct keys in all input so far.
+  PartialAggregationMode decidePartialAggregationMode(
+      double aggregationPct,
+      int64_t keyCardinality) const;
+
+  // Gives up on partial aggregation and passes input through from now on.
+  void abandonPartialAggregation();
+
   // True if we have enough rows and not enough reduction, i.e. more than
   // 'abandonPartialAggregationMinRows_' rows and more than
   // 'abandonPartialAggregationMinPct_' % of rows are unique.
@@ -74,10 +96,19 @@ class HashAggregation : public Operator {
   // the inputs.
   void recordSpillStats();
 
+  // Invoked on no more input to restore the spilled partitions of all drivers
+  // in parallel. Moves the spilled data to files and waits for the peers to do
+  // the same. The last driver to get here hands out the spilled partitions of
+  // all drivers through SpillPartitionWorkQueues, from which each driver takes
+  // its own partitions first and then steals from the others.
+  void startParallelSpillRestore();
+
   const bool isPartialOutput_;
   const bool isGlobal_;
   const bool isDistinct_;
   const int64_t maxExtendedPartialAggregationMemoryUsage_;
+  // True if the spilled partitions are restored in parallel across drivers.
+  const bool parallelSpillRestore_;
 
   int64_t maxPartialAggregationMemoryUsage_;
   std::unique_ptr<GroupingSet> groupingSet_;
@@ -106,9 +137,18 @@ class HashAggregation : public Operator {
   // Count the number of output rows. It is reset on partial aggregation output
   // flush.
   int64_t numOutputRows_ = 0;
+  // Count the number of input rows added to 'groupingSet_'. Not reset on
+  // partial aggregation output flush.
+  int64_t numAggregatedInputRows_ = 0;
 
   // Possibly reusable output vector.
   RowVectorPtr output_;
+
+  // The spilled partitions of this driver to hand out for parallel restore.
+  SpillPartitionSet spillPartitions_;
+
+  // Set while waiting for the peers to finish input in a parallel restore.
+  ContinueFuture restoreFuture_{ContinueFuture::makeEmpty()};
 };
 
 } // namespace facebook::velox::exec
@@ -34,6 +34,8 @@ BlockingReason fromStateToBlockingReason(HashBuild::State state) {
     case HashBuild::State::kWaitForSpill:
       return BlockingReason::kWaitForSpill;
     case HashBuild::State::kWaitForBuild:
+      FOLLY_FALLTHROUGH;
+    case HashBuild::State::kWaitForCache:
       return BlockingReason::kWaitForJoinBuild;
     case HashBuild::State::kWaitForProbe:
       return BlockingReason::kWaitForJoinProbe;
@@ -53,12 +55,18 @@ HashBuild::HashBuild(
           operatorId,
           joinNode->id(),
           "HashBuild",
-          joinNode->canSpill(driverCtx->queryConfig())
+          // NOTE: a shared hash table is not spilled since the probe side
+          // of other tasks can not restore its spilled partitions.
+          joinNode->canSpill(driverCtx->queryConfig()) &&
+                  !HashTableCache::makeKey(*joinNode, driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       joinNode_(std::move(joinNode)),
       joinType_{joinNode_->joinType()},
       nullAware_{joinNode_->isNullAware()},
+      cacheKey_{HashTableCache::makeKey(
+          *joinNode_,
+          operatorCtx_->driverCtx()->queryConfig())},
       joinBridge_(operatorCtx_->task()->getHashJoinBridgeLocked(
           operatorCtx_->driverCtx()->splitGroupId,
           planNodeId())),
@@ -125,14 +133,17 @@ HashBuild::HashBuild(
 void HashBuild::setupTable() {
   VELOX_CHECK_NULL(table_);
 
+  // A shared table is allocated from its own pool since it can outlive the
+  // query of this task.
+  auto* tablePool = cachePool_ != nullptr ? cachePool_.get() : pool();
+
   const auto numKeys = keyChannels_.size();
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
   keyHashers.reserve(numKeys);
   for (vector_size_t i = 0; i < numKeys; ++i) {
-    keyHashers.emplace_back(
-        VectorHasher::create(tableType_->childAt(i), keyChannels_[i]));
+    keyHashers.emplace_back(VectorHasher::create(
+        tableType_->childAt(i), keyChannels_[i], tablePool));
   }
-
   const auto numDependents = tableType_->size() - numKeys;
   std::vector<TypePtr> dependentTypes;
   dependentTypes.reserve(numDependents);
@@ -150,7 +161,7 @@ void HashBuild::setupTable() {
         operatorCtx_->driverCtx()
             ->queryConfig()
             .minTableRowsForParallelJoinBuild(),
-        pool());
+        tablePool);
   } else {
     // (Left) semi and anti join with no extra filter only needs to know whether
     // there is a match. Hence, no need to store entries with duplicate keys.
@@ -170,7 +181,7 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          tablePool);
     } else {
       // Ignore null keys
       table_ = HashTable<true>::createForJoin(
@@ -181,12 +192,47 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          tablePool);
     }
   }
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
 }
 
+void HashBuild::lookupHashTableCache() {
+  VELOX_CHECK(cacheKey_.has_value());
+  auto* cache = HashTableCache::getInstance();
+  auto lookup =
+      cache->lookup(cacheKey_.value(), operatorCtx_->taskId(), &future_);
+  if (future_.valid()) {
+    setState(State::kWaitForCache);
+    return;
+  }
+  cacheLookupDone_ = true;
+  if (lookup.table != nullptr) {
+    // Another task has built the table, so this skips the build side input.
+    cachedTable_ = std::move(lookup.table);
+    cachedHasNullKeys_ = lookup.hasNullKeys;
+    table_.reset();
+    addRuntimeStat("hashTableCacheHits", RuntimeCounter(1));
+    noMoreInput();
+    return;
+  }
+  VELOX_CHECK_NOT_NULL(lookup.pool);
+  cachePool_ = std::move(lookup.pool);
+  table_.reset();
+  setupTable();
+}
+
+void HashBuild::maybeAbandonHashTableCache() {
+  if (cachePool_ == nullptr) {
+    return;
+  }
+  // NOTE: 'cachePool_' is kept until 'table_' is freed. This does nothing if
+  // the last build driver of this task has cached the table.
+  HashTableCache::getInstance()->abandon(
+      cacheKey_.value(), operatorCtx_->taskId());
+}
+
 void HashBuild::setupSpiller(SpillPartition* spillPartition) {
   VELOX_CHECK_NULL(spiller_);
   VELOX_CHECK_NULL(spillInputReader_);
@@ -238,7 +284,9 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
       spillConfig.minSpillRunSize,
       spillConfig.compressionKind,
       memory::spillMemoryPool(),
-      spillConfig.executor);
+      spillConfig.executor,
+      spillConfig.overflowTier,
+      spillConfig.fileFormat);
 
   const int32_t numPartitions = spiller_->hashBits().numPartitions();
   spillInputIndicesBuffers_.resize(numPartitions);
@@ -474,6 +522,28 @@ bool HashBuild::reserveMemory(const RowVectorPtr& input) {
     return false;
   }
 
+  // Reserves the forecast memory usage of all the input rows in one request
+  // once the row size is known. If the reservation is denied, the operator
+  // spills proactively instead of growing its reservation in small increments
+  // with many rounds of memory arbitration.
+  if (!forecastReserved_) {
+    forecastReserved_ = true;
+    const auto estimatedRows = estimatedInputRows();
+    if (estimatedRows.has_value() && estimatedRows.value() > numRows) {
+      const uint64_t forecastBytes = (estimatedRows.value() - numRows) *
+          (rows->fixedRowSize() + outOfLineBytesPerRow);
+      {
+        Operator::ReclaimableSectionGuard guard(this);
+        if (pool()->maybeReserve(forecastBytes)) {
+          return true;
+        }
+      }
+      numSpillRows_ = numRows;
+      numSpillBytes_ = outOfLineBytes;
+      return false;
+    }
+  }
+
   const auto minReservationBytes =
       currentUsage * spillConfig_->minSpillableReservationPct / 100;
   const auto availableReservationBytes = pool()->availableReservation();
@@ -774,6 +844,12 @@ bool HashBuild::finishHashBuild() {
     }
   });
 
+  if (cachedTable_ != nullptr) {
+    joinBridge_->setHashTable(
+        std::move(cachedTable_), SpillPartitionSet{}, cachedHasNullKeys_);
+    return true;
+  }
+
   if (joinHasNullKeys_ && isAntiJoin(joinType_) && nullAware_ &&
       !joinNode_->filter()) {
     joinBridge_->setAntiJoinHasNullKeys();
@@ -836,9 +912,23 @@ bool HashBuild::finishHashBuild() {
       std::move(otherTables),
       allowParallelJoinBuild ? operatorCtx_->task()->queryCtx()->executor()
                              : nullptr);
+  if (spillPartitions.empty()) {
+    maybeBuildBloomFilters();
+  }
   addRuntimeStats();
+  std::shared_ptr<BaseHashTable> table;
+  if (cachePool_ != nullptr) {
+    table = HashTableCache::getInstance()->put(
+        cacheKey_.value(),
+        operatorCtx_->taskId(),
+        std::move(table_),
+        std::move(cachePool_),
+        joinHasNullKeys_);
+  } else {
+    table = std::move(table_);
+  }
   if (joinBridge_->setHashTable(
-          std::move(table_), std::move(spillPartitions), joinHasNullKeys_)) {
+          std::move(table), std::move(spillPartitions), joinHasNullKeys_)) {
     spillGroup_->restart();
   }
 
@@ -850,8 +940,10 @@ bool HashBuild::finishHashBuild() {
 
 void HashBuild::recordSpillStats() {
   if (spiller_ != nullptr) {
-    const auto spillStats = spiller_->stats();
+    auto spillStats = spiller_->stats();
     VELOX_CHECK_EQ(spillStats.spillSortTimeUs, 0);
+    spillStats.setSpillLevel(
+        spillConfig()->joinSpillLevel(spiller_->hashBits().begin()));
     Operator::recordSpillStats(spillStats);
   } else if (exceededMaxSpillLevelLimit_) {
     exceededMaxSpillLevelLimit_ = false;
@@ -951,6 +1043,128 @@ void HashBuild::processSpillInput() {
   noMoreInputInternal();
 }
 
+namespace {
+// Adds the non-null values of the key column at 'offset' in 'rows' to
+// 'bloomFilter' and updates 'min' and 'max'.
+template <typename T>
+void addKeysToBloomFilter(
+    folly::Range<char**> rows,
+    const RowColumn& column,
+    BloomFilter<>& bloomFilter,
+    int64_t& min,
+    int64_t& max) {
+  for (const auto* row : rows) {
+    if (RowContainer::isNullAt(row, column.nullByte(), column.nullMask())) {
+      continue;
+    }
+    const int64_t value = RowContainer::valueAt<T>(row, column.offset());
+    bloomFilter.insert(folly::hasher<int64_t>()(value));
+    min = std::min(min, value);
+    max = std::max(max, value);
+  }
+}
+} // namespace
+
+void HashBuild::maybeBuildBloomFilters() {
+  const auto maxBytes =
+      operatorCtx_->driverCtx()->queryConfig().hashBuildBloomFilterMaxSize();
+  if (maxBytes == 0) {
+    return;
+  }
+  // Only the join types for which HashProbe pushes down dynamic filters.
+  if (!isInnerJoin(joinType_) && !isLeftSemiFilterJoin(joinType_) &&
+      !isRightSemiFilterJoin(joinType_) && !isRightSemiProjectJoin(joinType_)) {
+    return;
+  }
+  const auto numDistinct = table_->numDistinct();
+  if (numDistinct == 0) {
+    return;
+  }
+  // BloomFilter uses 2 bytes per value.
+  if (bits::nextPowerOfTwo(numDistinct) * 2 > maxBytes) {
+    return;
+  }
+
+  const auto& hashers = table_->hashers();
+  std::vector<column_index_t> bloomKeys;
+  for (auto i = 0; i < hashers.size(); ++i) {
+    switch (hashers[i]->typeKind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+        break;
+      default:
+        continue;
+    }
+    // The VectorHashers produce exact filters if the table is not in kHash
+    // mode and the key has not too many distinct values.
+    if (table_->hashMode() != BaseHashTable::HashMode::kHash &&
+        !hashers[i]->distinctOverflow()) {
+      continue;
+    }
+    bloomKeys.push_back(i);
+  }
+  if (bloomKeys.empty()) {
+    return;
+  }
+
+  std::vector<BloomFilter<>> bloomFilters(bloomKeys.size());
+  std::vector<int64_t> mins(
+      bloomKeys.size(), std::numeric_limits<int64_t>::max());
+  std::vector<int64_t> maxs(
+      bloomKeys.size(), std::numeric_limits<int64_t>::min());
+  for (auto& bloomFilter : bloomFilters) {
+    bloomFilter.reset(numDistinct);
+  }
+  constexpr int32_t kBatch = 1024;
+  std::vector<char*> rows(kBatch);
+  BaseHashTable::RowsIterator iter;
+  while (auto numRows = table_->listAllRows(
+             &iter, kBatch, RowContainer::kUnlimited, rows.data())) {
+    folly::Range<char**> batch(rows.data(), numRows);
+    for (auto i = 0; i < bloomKeys.size(); ++i) {
+      const auto key = bloomKeys[i];
+      const auto column = table_->rows()->columnAt(key);
+      switch (hashers[key]->typeKind()) {
+        case TypeKind::TINYINT:
+          addKeysToBloomFilter<int8_t>(
+              batch, column, bloomFilters[i], mins[i], maxs[i]);
+          break;
+        case TypeKind::SMALLINT:
+          addKeysToBloomFilter<int16_t>(
+              batch, column, bloomFilters[i], mins[i], maxs[i]);
+          break;
+        case TypeKind::INTEGER:
+          addKeysToBloomFilter<int32_t>(
+              batch, column, bloomFilters[i], mins[i], maxs[i]);
+          break;
+        case TypeKind::BIGINT:
+          addKeysToBloomFilter<int64_t>(
+              batch, column, bloomFilters[i], mins[i], maxs[i]);
+          break;
+        default:
+          VELOX_UNREACHABLE();
+      }
+    }
+  }
+
+  for (auto i = 0; i < bloomKeys.size(); ++i) {
+    if (mins[i] > maxs[i]) {
+      // All keys are null.
+      continue;
+    }
+    table_->setJoinKeyBloomFilter(
+        bloomKeys[i],
+        std::make_shared<common::BigintValuesUsingBloomFilter>(
+            mins[i],
+            maxs[i],
+            std::make_shared<BloomFilter<>>(std::move(bloomFilters[i])),
+            false));
+  }
+  addRuntimeStat("bloomFilterKeys", RuntimeCounter(bloomKeys.size()));
+}
+
 void HashBuild::addRuntimeStats() {
   // Report range sizes and number of distinct values for the join keys.
   const auto& hashers = table_->hashers();
@@ -995,12 +1209,20 @@ void HashBuild::addRuntimeStats() {
 BlockingReason HashBuild::isBlocked(ContinueFuture* future) {
   switch (state_) {
     case State::kRunning:
-      if (isInputFromSpill()) {
+      if (cacheKey_.has_value() && !cacheLookupDone_) {
+        lookupHashTableCache();
+      } else if (isInputFromSpill()) {
         processSpillInput();
       }
       break;
     case State::kFinish:
       break;
+    case State::kWaitForCache:
+      if (!future_.valid()) {
+        setRunning();
+        lookupHashTableCache();
+      }
+      break;
     case State::kWaitForSpill:
       if (!future_.valid()) {
         setRunning();
@@ -1053,7 +1275,9 @@ void HashBuild::checkStateTransition(State state) {
   switch (state) {
     case State::kRunning:
       if (!spillEnabled()) {
-        VELOX_CHECK_EQ(state_, State::kWaitForBuild);
+        VELOX_CHECK(
+            state_ == State::kWaitForBuild || state_ == State::kWaitForCache,
+            stateName(state_));
       } else {
         VELOX_CHECK_NE(state_, State::kFinish);
       }
@@ -1064,6 +1288,8 @@ void HashBuild::checkStateTransition(State state) {
       FOLLY_FALLTHROUGH;
     case State::kWaitForProbe:
       FOLLY_FALLTHROUGH;
+    case State::kWaitForCache:
+      FOLLY_FALLTHROUGH;
     case State::kFinish:
       VELOX_CHECK_EQ(state_, State::kRunning);
       break;
@@ -1083,6 +1309,8 @@ std::string HashBuild::stateName(State state) {
       return "WAIT_FOR_BUILD";
     case State::kWaitForProbe:
       return "WAIT_FOR_PROBE";
+    case State::kWaitForCache:
+      return "WAIT_FOR_CACHE";
     case State::kFinish:
       return "FINISH";
     default:
@@ -1208,6 +1436,11 @@ bool HashBuild::nonReclaimableState() const {
       nonReclaimableSection_ || spiller_->finalized();
 }
 
+void HashBuild::close() {
+  maybeAbandonHashTableCache();
+  Operator::close();
+}
+
 void HashBuild::abort() {
   Operator::abort();
 
@@ -17,6 +17,7 @@
 
 #include "velox/exec/HashJoinBridge.h"
 #include "velox/exec/HashTable.h"
+#include "velox/exec/HashTableCache.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Spill.h"
 #include "velox/exec/SpillOperatorGroup.h"
@@ -53,6 +54,10 @@ class HashBuild final : public Operator {
     kWaitForProbe = 4,
     /// The finishing state.
     kFinish = 5,
+    /// The state that waits for another task to build the shared hash table
+    /// of this join. This state only applies if QueryConfig::kHashTableCacheKey
+    /// is set.
+    kWaitForCache = 6,
   };
   static std::string stateName(State state);
 
@@ -82,6 +87,8 @@ class HashBuild final : public Operator {
 
   bool canReclaim() const override;
 
+  void close() override;
+
   void abort() override;
 
  private:
@@ -95,6 +102,17 @@ class HashBuild final : public Operator {
   // Invoked to set up hash table to build.
   void setupTable();
 
+  // Invoked before the first input to look up the shared hash table of this
+  // join in HashTableCache. Finishes the operator without input if the table
+  // is cached, sets up 'table_' to build the shared table if this task is the
+  // builder, or sets 'future_' and transitions to 'kWaitForCache' state if
+  // another task is building the table.
+  void lookupHashTableCache();
+
+  // Gives up building the shared hash table if this task was the builder and
+  // has not finished it, so that a waiting task can build it.
+  void maybeAbandonHashTableCache();
+
   // Invoked when operator has finished processing the build input and wait for
   // all the other drivers to finish the processing. The last driver that
   // reaches to the hash build barrier, is responsible to build the hash table
@@ -236,6 +254,13 @@ class HashBuild final : public Operator {
 
   void addRuntimeStats();
 
+  // Makes Bloom filters on the integer join keys of 'table_' that have too
+  // many distinct values for an exact IN-list dynamic filter. These are pushed
+  // down by HashProbe into the probe side table scan. Does nothing if
+  // disabled by QueryConfig::kHashBuildBloomFilterMaxSize or if the table is
+  // too large for the size limit.
+  void maybeBuildBloomFilters();
+
   // Invoked to check if it needs to trigger spilling for test purpose only.
   bool testingTriggerSpill();
 
@@ -249,6 +274,22 @@ class HashBuild final : public Operator {
 
   const bool nullAware_;
 
+  // The key of the shared hash table of this join in HashTableCache or
+  // std::nullopt if the table is not shared.
+  const std::optional<std::string> cacheKey_;
+
+  // True after the first lookup of 'cacheKey_'.
+  bool cacheLookupDone_{false};
+
+  // The pool of the shared hash table if this task builds it. Declared before
+  // 'table_' to outlive it.
+  std::shared_ptr<memory::MemoryPool> cachePool_;
+
+  // The shared hash table built by another task and whether its build side
+  // has null join keys.
+  std::shared_ptr<BaseHashTable> cachedTable_;
+  bool cachedHasNullKeys_{false};
+
   std::shared_ptr<HashJoinBridge> joinBridge_;
 
   // The maximum memory usage that a hash build can hold before spilling.
@@ -298,6 +339,10 @@ class HashBuild final : public Operator {
   // 'testSpillPct_';.
   uint64_t spillTestCounter_{0};
 
+  // True if the reservation of the forecast memory usage from
+  // estimatedInputRows() has been tried.
+  bool forecastReserved_{false};
+
   // The spill targets set by 'requestSpill()' to request group spill.
   uint64_t numSpillRows_{0};
   uint64_t numSpillBytes_{0};
@@ -15,6 +15,10 @@
  */
 
 #include "velox/exec/HashProbe.h"
+
+#include <folly/container/F14Map.h>
+
+#include "velox/exec/FilterProject.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
@@ -52,7 +56,20 @@ RowTypePtr makeTableType(
   return ROW(std::move(names), std::move(types));
 }
 
-// Copy values from 'rows' of 'table' according to 'projections' in
+// Appends the conjuncts of 'expr' to 'conjuncts'.
+void flattenConjuncts(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& conjuncts) {
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  if (call && call->name() == "and") {
+    for (const auto& input : call->inputs()) {
+      flattenConjuncts(input, conjuncts);
+    }
+    return;
+  }
+  conjuncts.push_back(expr);
+}
+
 // 'result'. Reuses 'result' children where possible.
 void extractColumns(
     BaseHashTable* table,
@@ -78,6 +95,88 @@ void extractColumns(
   }
 }
 
+// Loads a build side column of a join output batch from the rows of the hash
+// table. Holds a reference to the table so that the rows stay valid until the
+// column is loaded or dropped.
+class TableColumnLoader : public VectorLoader {
+ public:
+  TableColumnLoader(
+      std::shared_ptr<BaseHashTable> table,
+      std::shared_ptr<const std::vector<char*>> rows,
+      column_index_t column,
+      TypePtr type,
+      memory::MemoryPool* pool)
+      : table_(std::move(table)),
+        rows_(std::move(rows)),
+        column_(column),
+        type_(std::move(type)),
+        pool_(pool) {}
+
+ protected:
+  void loadInternal(
+      RowSet rows,
+      ValueHook* hook,
+      vector_size_t resultSize,
+      VectorPtr* result) override {
+    VELOX_CHECK_NULL(hook, "TableColumnLoader does not support ValueHook");
+    VELOX_CHECK_LE(resultSize, rows_->size());
+    const char* const* tableRows = rows_->data();
+    std::vector<char*> selectedRows;
+    if (rows.size() < resultSize) {
+      // Rows that are not loaded are extracted as nulls.
+      selectedRows.resize(resultSize, nullptr);
+      for (auto row : rows) {
+        selectedRows[row] = (*rows_)[row];
+      }
+      tableRows = selectedRows.data();
+    }
+    if (!*result || !BaseVector::isVectorWritable(*result) ||
+        !(*result)->isFlatEncoding()) {
+      *result = BaseVector::create(type_, resultSize, pool_);
+    }
+    (*result)->resize(resultSize);
+    table_->rows()->extractColumn(tableRows, resultSize, column_, *result);
+  }
+
+ private:
+  const std::shared_ptr<BaseHashTable> table_;
+  const std::shared_ptr<const std::vector<char*>> rows_;
+  const column_index_t column_;
+  const TypePtr type_;
+  memory::MemoryPool* const pool_;
+};
+
+// Sets the 'projections' of 'resultVectors' to LazyVectors that load the
+// values of 'rows' of 'table'. The row pointers are copied once for all
+// columns.
+void makeLazyColumns(
+    const std::shared_ptr<BaseHashTable>& table,
+    folly::Range<char**> rows,
+    folly::Range<const IdentityProjection*> projections,
+    memory::MemoryPool* pool,
+    const std::vector<TypePtr>& resultTypes,
+    std::vector<VectorPtr>& resultVectors) {
+  if (projections.empty()) {
+    return;
+  }
+  auto copiedRows =
+      std::make_shared<const std::vector<char*>>(rows.begin(), rows.end());
+  for (auto projection : projections) {
+    const auto resultChannel = projection.outputChannel;
+    VELOX_CHECK_LT(resultChannel, resultVectors.size())
+    resultVectors[resultChannel] = std::make_shared<LazyVector>(
+        pool,
+        resultTypes[resultChannel],
+        rows.size(),
+        std::make_unique<TableColumnLoader>(
+            table,
+            copiedRows,
+            projection.inputChannel,
+            resultTypes[resultChannel],
+            pool));
+  }
+}
+
 BlockingReason fromStateToBlockingReason(ProbeOperatorState state) {
   switch (state) {
     case ProbeOperatorState::kRunning:
@@ -127,7 +226,13 @@ HashProbe::HashProbe(
           operatorCtx_->driverCtx()->splitGroupId,
           planNodeId())),
       filterResult_(1),
-      outputTableRows_(outputBatchSize_) {
+      outputTableRows_(outputBatchSize_),
+      lazyBuildColumns_(
+          driverCtx->queryConfig().hashProbeLazyBuildColumns() &&
+          !spillEnabled()),
+      earlyJoinFilterEnabled_(
+          isInnerJoin(joinType_) &&
+          driverCtx->queryConfig().hashProbeEarlyJoinFilterEnabled()) {
   VELOX_CHECK_NOT_NULL(joinBridge_);
 }
 
@@ -135,7 +240,7 @@ void HashProbe::initialize() {
   Operator::initialize();
 
   VELOX_CHECK(hashers_.empty());
-  hashers_ = createVectorHashers(probeType_, joinNode_->leftKeys());
+  hashers_ = createVectorHashers(probeType_, joinNode_->leftKeys(), pool());
 
   const auto numKeys = hashers_.size();
   keyChannels_.reserve(numKeys);
@@ -218,6 +323,101 @@ void HashProbe::initializeFilter(
   }
 
   filterInputType_ = ROW(std::move(names), std::move(types));
+
+  if (!nullAware_ &&
+      operatorCtx_->driverCtx()->queryConfig().hashProbeSimpleFilterEnabled()) {
+    initializeSimpleFilter(filter, probeType, tableType);
+  }
+}
+
+bool HashProbe::initializeSimpleFilter(
+    const core::TypedExprPtr& filter,
+    const RowTypePtr& probeType,
+    const RowTypePtr& tableType) {
+  using Op = SimpleFilterComparison::Op;
+  using Source = SimpleFilterOperand::Source;
+  static const folly::F14FastMap<std::string, Op> kOps = {
+      {"eq", Op::kEq},
+      {"neq", Op::kNeq},
+      {"lt", Op::kLt},
+      {"lte", Op::kLte},
+      {"gt", Op::kGt},
+      {"gte", Op::kGte},
+  };
+
+  std::vector<core::TypedExprPtr> conjuncts;
+  flattenConjuncts(filter, conjuncts);
+
+  std::vector<SimpleFilterComparison> comparisons;
+  std::vector<column_index_t> channels;
+  auto toOperand = [&](const core::TypedExprPtr& expr, TypeKind kind)
+      -> std::optional<SimpleFilterOperand> {
+    if (auto field =
+            std::dynamic_pointer_cast<const core::FieldAccessTypedExpr>(expr)) {
+      const auto& inputs = field->inputs();
+      if (!inputs.empty() &&
+          (inputs.size() > 1 ||
+           !dynamic_cast<const core::InputTypedExpr*>(inputs[0].get()))) {
+        return std::nullopt;
+      }
+      if (auto channel = probeType->getChildIdxIfExists(field->name())) {
+        auto it = std::find(channels.begin(), channels.end(), channel.value());
+        if (it == channels.end()) {
+          it = channels.insert(it, channel.value());
+        }
+        return SimpleFilterOperand{
+            Source::kProbe,
+            static_cast<column_index_t>(it - channels.begin())};
+      }
+      if (auto channel = tableType->getChildIdxIfExists(field->name())) {
+        return SimpleFilterOperand{Source::kTable, channel.value()};
+      }
+      return std::nullopt;
+    }
+    if (auto constant =
+            std::dynamic_pointer_cast<const core::ConstantTypedExpr>(expr)) {
+      if (constant->hasValueVector() || constant->value().isNull()) {
+        return std::nullopt;
+      }
+      const auto& value = constant->value();
+      return SimpleFilterOperand{
+          Source::kConstant,
+          0,
+          kind == TypeKind::BIGINT ? value.value<int64_t>()
+                                   : value.value<int32_t>()};
+    }
+    return std::nullopt;
+  };
+
+  for (const auto& conjunct : conjuncts) {
+    auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(conjunct);
+    if (!call || call->inputs().size() != 2) {
+      return false;
+    }
+    auto it = kOps.find(call->name());
+    if (it == kOps.end()) {
+      return false;
+    }
+    const auto& left = call->inputs()[0];
+    const auto& right = call->inputs()[1];
+    const auto kind = left->type()->kind();
+    if ((kind != TypeKind::BIGINT && kind != TypeKind::INTEGER) ||
+        *left->type() != *right->type()) {
+      return false;
+    }
+    auto leftOperand = toOperand(left, kind);
+    auto rightOperand = toOperand(right, kind);
+    if (!leftOperand.has_value() || !rightOperand.has_value()) {
+      return false;
+    }
+    comparisons.push_back(SimpleFilterComparison{
+        it->second, kind, leftOperand.value(), rightOperand.value()});
+  }
+
+  simpleFilter_ = std::move(comparisons);
+  simpleFilterChannels_ = std::move(channels);
+  simpleFilterDecoded_.resize(simpleFilterChannels_.size());
+  return true;
 }
 
 void HashProbe::maybeSetupSpillInput(
@@ -260,7 +460,9 @@ void HashProbe::maybeSetupSpillInput(
       spillConfig.minSpillRunSize,
       spillConfig.compressionKind,
       memory::spillMemoryPool(),
-      spillConfig.executor);
+      spillConfig.executor,
+      spillConfig.overflowTier,
+      spillConfig.fileFormat);
   // Set the spill partitions to the corresponding ones at the build side. The
   // hash probe operator itself won't trigger any spilling.
   spiller_->setPartitionsSpilled(toPartitionNumSet(spillInputPartitionIds_));
@@ -318,8 +520,7 @@ void HashProbe::asyncWaitForHashTable() {
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept
     // dynamic filters on all or a subset of the join keys. Create dynamic
     // filters to push down.
@@ -328,15 +529,27 @@ void HashProbe::asyncWaitForHashTable() {
     // probe input is read from spilled data and there is no upstream operators
     // involved; (2) if there is spill data to restore, then we can't filter
     // probe inputs solely based on the current table's join keys.
+    //
+    // The VectorHashers produce exact filters unless the table is in kHash
+    // mode or the key has too many distinct values. For such keys, HashBuild
+    // may have made an approximate Bloom filter.
     const auto& buildHashers = table_->hashers();
     auto channels = operatorCtx_->driverCtx()->driver->canPushdownFilters(
         this, keyChannels_);
     for (auto i = 0; i < keyChannels_.size(); i++) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
+      if (channels.find(keyChannels_[i]) == channels.end()) {
+        continue;
+      }
+      if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
         if (auto filter = buildHashers[i]->getFilter(false)) {
           dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
+          continue;
         }
       }
+      if (auto* bloomFilter = table_->joinKeyBloomFilter(i)) {
+        dynamicFilters_.emplace(keyChannels_[i], bloomFilter->clone());
+        hasApproximateDynamicFilter_ = true;
+      }
     }
   }
 }
@@ -497,9 +710,11 @@ void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down
   // filter when the following conditions are met:
   //  * hash table has a single key with unique values,
-  //  * build side has no dependent columns.
+  //  * build side has no dependent columns,
+  //  * the pushed down filter is exact.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      !hasApproximateDynamicFilter_) {
     canReplaceWithDynamicFilter_ = true;
   }
 
@@ -522,6 +737,20 @@ void HashProbe::decodeAndDetectNonNullKeys() {
   }
 }
 
+void HashProbe::updateOutputBatchSize() {
+  if (table_ == nullptr) {
+    return;
+  }
+  // An output row has at most the columns of a probe and a build row.
+  const auto probeRowSize = averageInputRowSize();
+  const auto buildRowSize = table_->rows()->estimateRowSize();
+  if (!probeRowSize.has_value() || !buildRowSize.has_value()) {
+    return;
+  }
+  outputBatchSize_ =
+      outputBatchRowsByBytes(probeRowSize.value() + buildRowSize.value());
+}
+
 void HashProbe::addInput(RowVectorPtr input) {
   if (skipInput_) {
     VELOX_CHECK_NULL(input_);
@@ -531,6 +760,7 @@ void HashProbe::addInput(RowVectorPtr input) {
 
   if (input_->size() > 0) {
     noInput_ = false;
+    updateOutputBatchSize();
   }
 
   if (canReplaceWithDynamicFilter_) {
@@ -538,6 +768,19 @@ void HashProbe::addInput(RowVectorPtr input) {
     return;
   }
 
+  if (earlyJoinFilterEnabled_ && input_->size() > 0) {
+    if (!earlyFiltersInitialized_) {
+      initializeEarlyFilters();
+    }
+    if (!earlyFilters_.empty()) {
+      updateEarlyFilters();
+      applyEarlyFilters();
+      if (input_ == nullptr) {
+        return;
+      }
+    }
+  }
+
   bool hasDecoded = false;
 
   if (needSpillInput()) {
@@ -622,16 +865,206 @@ void HashProbe::addInput(RowVectorPtr input) {
     rows.resize(numInput);
     std::iota(rows.begin(), rows.end(), 0);
   } else {
+    if (earlyJoinFilterEnabled_) {
+      numProbedRows_ += input_->size();
+    }
     if (lookup_->rows.empty()) {
       input_ = nullptr;
       return;
     }
     lookup_->hits.resize(lookup_->rows.back() + 1);
     table_->joinProbe(*lookup_);
+    if (earlyJoinFilterEnabled_) {
+      for (auto row : lookup_->rows) {
+        numMatchedRows_ += lookup_->hits[row] != nullptr;
+      }
+    }
   }
   results_.reset(*lookup_);
 }
 
+void HashProbe::initializeEarlyFilters() {
+  earlyFiltersInitialized_ = true;
+  const auto operators = operatorCtx_->driverCtx()->driver->operators();
+  const auto self = std::find(operators.begin(), operators.end(), this);
+  VELOX_CHECK(self != operators.end());
+  const int32_t selfIndex = self - operators.begin();
+  // Returns the input channel of 'this' that is projected to 'channel' of the
+  // input of operators[index], or std::nullopt if there is none.
+  auto toInputChannel = [&](int32_t index, column_index_t channel) {
+    std::optional<column_index_t> result = channel;
+    for (auto i = index - 1; i >= selfIndex && result.has_value(); --i) {
+      std::optional<column_index_t> inputChannel;
+      for (const auto& projection : operators[i]->identityProjections()) {
+        if (projection.outputChannel == result.value()) {
+          inputChannel = projection.inputChannel;
+          break;
+        }
+      }
+      result = inputChannel;
+    }
+    return result;
+  };
+  for (auto i = selfIndex + 1; i < operators.size(); ++i) {
+    auto* probe = dynamic_cast<HashProbe*>(operators[i]);
+    if (probe == nullptr) {
+      // A FilterProject drops rows one by one and so does not change the
+      // result of filtering its input by a downstream join. Other operators,
+      // e.g. a limit, may.
+      if (dynamic_cast<FilterProject*>(operators[i]) == nullptr) {
+        break;
+      }
+      continue;
+    }
+    if (!probe->earlyJoinFilterEnabled_) {
+      break;
+    }
+    std::vector<column_index_t> channels;
+    for (auto keyChannel : probe->keyChannels_) {
+      const auto channel = toInputChannel(i, keyChannel);
+      if (!channel.has_value()) {
+        break;
+      }
+      channels.push_back(channel.value());
+    }
+    if (channels.size() == probe->keyChannels_.size()) {
+      earlyFilters_.push_back(EarlyFilter{probe, std::move(channels)});
+    }
+  }
+}
+
+void HashProbe::updateEarlyFilters() {
+  for (auto& filter : earlyFilters_) {
+    auto* probe = filter.probe;
+    if (filter.enabled) {
+      if (!probe->canFilterEarly() ||
+          (filter.numChecked >= kMinEarlyFilterRows &&
+           filter.numPassed > kEarlyFilterMaxPassRate * filter.numChecked)) {
+        filter.enabled = false;
+        filter.baseProbed = probe->numProbedRows_;
+        filter.baseMatched = probe->numMatchedRows_;
+      }
+      continue;
+    }
+    // 'probe' sees only the rows that pass the early filters, so only the
+    // rows it probed while disabled tell its selectivity.
+    const auto numProbed = probe->numProbedRows_ - filter.baseProbed;
+    if (numProbed < kMinEarlyFilterRows ||
+        numProbedRows_ < kMinEarlyFilterRows || !probe->canFilterEarly()) {
+      continue;
+    }
+    const auto numMatched = probe->numMatchedRows_ - filter.baseMatched;
+    if (static_cast<double>(numMatched) / numProbed <
+        kEarlyFilterMaxRelativeSelectivity * numMatchedRows_ /
+            numProbedRows_) {
+      filter.enabled = true;
+      filter.numChecked = 0;
+      filter.numPassed = 0;
+    }
+  }
+}
+
+void HashProbe::applyEarlyFilters() {
+  const auto numInput = input_->size();
+  bool anyEnabled = false;
+  for (auto& filter : earlyFilters_) {
+    if (!filter.enabled) {
+      continue;
+    }
+    if (!anyEnabled) {
+      earlyFilterRows_.resizeFill(numInput, true);
+      anyEnabled = true;
+    }
+    const auto numChecked = earlyFilterRows_.countSelected();
+    filter.probe->filterEarly(input_, filter.channels, earlyFilterRows_);
+    filter.numChecked += numChecked;
+    filter.numPassed += earlyFilterRows_.countSelected();
+    if (!earlyFilterRows_.hasSelections()) {
+      break;
+    }
+  }
+  if (!anyEnabled) {
+    return;
+  }
+  const auto numPassed = earlyFilterRows_.countSelected();
+  if (numPassed == numInput) {
+    return;
+  }
+  addRuntimeStat("earlyJoinFilteredRows", RuntimeCounter(numInput - numPassed));
+  if (numPassed == 0) {
+    input_ = nullptr;
+    return;
+  }
+  auto indices = allocateIndices(numPassed, pool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t numIndices = 0;
+  earlyFilterRows_.applyToSelected(
+      [&](auto row) { rawIndices[numIndices++] = row; });
+  input_ = wrap(numPassed, std::move(indices), input_);
+}
+
+bool HashProbe::canFilterEarly() const {
+  return earlyJoinFilterEnabled_ && table_ != nullptr && !needSpillInput() &&
+      !isSpillInput() && !canReplaceWithDynamicFilter_ &&
+      !replacedWithDynamicFilter_;
+}
+
+void HashProbe::filterEarly(
+    const RowVectorPtr& input,
+    const std::vector<column_index_t>& channels,
+    SelectivityVector& rows) {
+  VELOX_CHECK(canFilterEarly());
+  VELOX_CHECK_EQ(channels.size(), keyChannels_.size());
+  if (table_->numDistinct() == 0) {
+    rows.clearAll();
+    return;
+  }
+  if (earlyFilterLookup_ == nullptr) {
+    // The channels of the hashers are not used, the keys are decoded from
+    // 'channels'.
+    for (const auto& hasher : hashers_) {
+      earlyFilterHashers_.push_back(
+          VectorHasher::create(hasher->type(), hasher->channel()));
+    }
+    earlyFilterLookup_ = std::make_unique<HashLookup>(earlyFilterHashers_);
+  }
+
+  for (auto i = 0; i < channels.size(); ++i) {
+    auto key = input->childAt(channels[i])->loadedVector();
+    earlyFilterHashers_[i]->decode(*key, rows);
+  }
+  deselectRowsWithNulls(earlyFilterHashers_, rows);
+
+  auto& lookup = *earlyFilterLookup_;
+  lookup.hashes.resize(input->size());
+  const auto mode = table_->hashMode();
+  auto& buildHashers = table_->hashers();
+  for (auto i = 0; i < channels.size(); ++i) {
+    if (mode != BaseHashTable::HashMode::kHash) {
+      buildHashers[i]->lookupValueIds(
+          *input->childAt(channels[i]),
+          rows,
+          earlyFilterScratchMemory_,
+          lookup.hashes);
+    } else {
+      earlyFilterHashers_[i]->hash(rows, i > 0, lookup.hashes);
+    }
+  }
+  lookup.rows.clear();
+  rows.applyToSelected([&](auto row) { lookup.rows.push_back(row); });
+  if (lookup.rows.empty()) {
+    return;
+  }
+  lookup.hits.resize(lookup.rows.back() + 1);
+  table_->joinProbe(lookup);
+  for (auto row : lookup.rows) {
+    if (lookup.hits[row] == nullptr) {
+      rows.setValid(row, false);
+    }
+  }
+  rows.updateBounds();
+}
+
 void HashProbe::prepareOutput(vector_size_t size) {
   // Try to re-use memory for the output vectors that contain build-side data.
   // We expect output vectors containing probe-side data to be null (reset in
@@ -712,6 +1145,15 @@ void HashProbe::fillOutput(vector_size_t size) {
 
   if (isLeftSemiProjectJoin(joinType_)) {
     fillLeftSemiProjectMatchColumn(size);
+  } else if (lazyBuildColumns_) {
+    makeLazyColumns(
+        table_,
+        folly::Range<char**>(outputTableRows_.data(), size),
+        tableOutputProjections_,
+        pool(),
+        outputType_->children(),
+        output_->children());
+    output_->updateContainsLazyNotLoaded();
   } else {
     extractColumns(
         table_.get(),
@@ -1001,6 +1443,113 @@ void HashProbe::fillFilterInput(vector_size_t size) {
       pool(), filterInputType_, nullptr, size, std::move(filterColumns));
 }
 
+void HashProbe::evalSimpleFilter(vector_size_t numRows) {
+  for (auto i = 0; i < simpleFilterChannels_.size(); ++i) {
+    const auto channel = simpleFilterChannels_[i];
+    ensureLoadedIfNotAtEnd(channel);
+    simpleFilterDecoded_[i].decode(*input_->childAt(channel));
+  }
+
+  auto& result = filterResult_[0];
+  if (result == nullptr) {
+    result = BaseVector::create(BOOLEAN(), numRows, pool());
+  } else {
+    BaseVector::prepareForReuse(result, numRows);
+  }
+  result->clearNulls(0, numRows);
+  auto* rawResult = result->asFlatVector<bool>()->mutableRawValues<uint64_t>();
+  bits::fillBits(rawResult, 0, numRows, true);
+
+  for (const auto& comparison : simpleFilter_) {
+    if (comparison.kind == TypeKind::BIGINT) {
+      evalSimpleComparison<int64_t>(comparison, rawResult);
+    } else {
+      evalSimpleComparison<int32_t>(comparison, rawResult);
+    }
+  }
+}
+
+template <typename T>
+void HashProbe::evalSimpleComparison(
+    const SimpleFilterComparison& comparison,
+    uint64_t* rawResult) {
+  using Source = SimpleFilterOperand::Source;
+  const auto* rawOutputProbeRowMapping = outputRowMapping_->as<vector_size_t>();
+  const auto* rows = table_->rows();
+
+  // Sets 'value' to the value of 'operand' for output row 'row'. Returns false
+  // if the value is null.
+  auto valueAt = [&](const SimpleFilterOperand& operand,
+                     vector_size_t row,
+                     T& value) {
+    switch (operand.source) {
+      case Source::kProbe: {
+        const auto& decoded = simpleFilterDecoded_[operand.channel];
+        const auto index = rawOutputProbeRowMapping[row];
+        if (decoded.isNullAt(index)) {
+          return false;
+        }
+        value = decoded.valueAt<T>(index);
+        return true;
+      }
+      case Source::kTable: {
+        const char* tableRow = outputTableRows_[row];
+        if (tableRow == nullptr) {
+          return false;
+        }
+        const auto column = rows->columnAt(operand.channel);
+        if (RowContainer::isNullAt(
+                tableRow, column.nullByte(), column.nullMask())) {
+          return false;
+        }
+        value = RowContainer::valueAt<T>(tableRow, column.offset());
+        return true;
+      }
+      case Source::kConstant:
+        value = operand.constant;
+        return true;
+    }
+    VELOX_UNREACHABLE();
+  };
+
+  // A null comparison does not pass the conjunction, same as a false one.
+  auto evalRows = [&](auto compare) {
+    filterInputRows_.applyToSelected([&](vector_size_t row) {
+      if (!bits::isBitSet(rawResult, row)) {
+        return;
+      }
+      T left;
+      T right;
+      if (!valueAt(comparison.left, row, left) ||
+          !valueAt(comparison.right, row, right) || !compare(left, right)) {
+        bits::clearBit(rawResult, row);
+      }
+    });
+  };
+
+  using Op = SimpleFilterComparison::Op;
+  switch (comparison.op) {
+    case Op::kEq:
+      evalRows(std::equal_to<T>());
+      break;
+    case Op::kNeq:
+      evalRows(std::not_equal_to<T>());
+      break;
+    case Op::kLt:
+      evalRows(std::less<T>());
+      break;
+    case Op::kLte:
+      evalRows(std::less_equal<T>());
+      break;
+    case Op::kGt:
+      evalRows(std::greater<T>());
+      break;
+    case Op::kGte:
+      evalRows(std::greater_equal<T>());
+      break;
+  }
+}
+
 void HashProbe::prepareFilterRowsForNullAwareJoin(
     vector_size_t numRows,
     bool filterPropagateNulls) {
@@ -1203,15 +1752,20 @@ int32_t HashProbe::evalFilter(int32_t numRows) {
     filterInputRows_.updateBounds();
   }
 
-  fillFilterInput(numRows);
+  if (!simpleFilter_.empty()) {
+    evalSimpleFilter(numRows);
+  } else {
+    fillFilterInput(numRows);
+
+    if (nullAware_) {
+      prepareFilterRowsForNullAwareJoin(numRows, filterPropagateNulls);
+    }
 
-  if (nullAware_) {
-    prepareFilterRowsForNullAwareJoin(numRows, filterPropagateNulls);
+    EvalCtx evalCtx(
+        operatorCtx_->execCtx(), filter_.get(), filterInput_.get());
+    filter_->eval(0, 1, true, filterInputRows_, evalCtx, filterResult_);
   }
 
-  EvalCtx evalCtx(operatorCtx_->execCtx(), filter_.get(), filterInput_.get());
-  filter_->eval(0, 1, true, filterInputRows_, evalCtx, filterResult_);
-
   decodedFilterResult_.decode(*filterResult_[0], filterInputRows_);
 
   int32_t numPassed = 0;
@@ -1415,9 +1969,11 @@ void HashProbe::noMoreInputInternal() {
 
 void HashProbe::recordSpillStats() {
   VELOX_CHECK_NOT_NULL(spiller_);
-  const auto spillStats = spiller_->stats();
+  auto spillStats = spiller_->stats();
   VELOX_CHECK_EQ(spillStats.spillSortTimeUs, 0);
   VELOX_CHECK_EQ(spillStats.spillFillTimeUs, 0);
+  spillStats.setSpillLevel(
+      spillConfig_->joinSpillLevel(spiller_->hashBits().begin()));
   Operator::recordSpillStats(spillStats);
 }
 
@@ -70,7 +70,68 @@ class HashProbe : public Operator {
 
   void clearDynamicFilters() override;
 
+  /// Returns true if the hash table of this inner join can filter the input
+  /// of an upstream operator in the same pipeline. See filterEarly().
+  bool canFilterEarly() const;
+
+  /// Deselects the rows of 'rows' whose join keys in the columns 'channels' of
+  /// 'input' have no match in the hash table. Used by an upstream inner join
+  /// to drop the rows this join would drop before joining them. 'channels'
+  /// has one entry per join key of this join. Requires canFilterEarly().
+  void filterEarly(
+      const RowVectorPtr& input,
+      const std::vector<column_index_t>& channels,
+      SelectivityVector& rows);
+
  private:
+  // A downstream inner join in the pipeline whose join keys are identity
+  // projected from the input of this join. If the downstream join drops a
+  // larger fraction of its input than this one, its hash table filters the
+  // input of this join, so that the more selective join goes first.
+  struct EarlyFilter {
+    HashProbe* probe;
+    // The input channels of this join with the join keys of 'probe'.
+    std::vector<column_index_t> channels;
+    bool enabled{false};
+    // Rows checked and passed by 'probe' since last enabled.
+    uint64_t numChecked{0};
+    uint64_t numPassed{0};
+    // 'numProbedRows_' and 'numMatchedRows_' of 'probe' when last disabled.
+    uint64_t baseProbed{0};
+    uint64_t baseMatched{0};
+  };
+
+  // Minimum number of rows for estimating the selectivity of a join.
+  static constexpr uint64_t kMinEarlyFilterRows = 10'000;
+  // An early filter is enabled if the downstream join passes less than this
+  // fraction of the rows this join passes.
+  static constexpr double kEarlyFilterMaxRelativeSelectivity = 0.5;
+  // An early filter is disabled if it passes more than this fraction of the
+  // rows it checks.
+  static constexpr double kEarlyFilterMaxPassRate = 0.8;
+
+  // One side of a comparison in a simple join filter.
+  struct SimpleFilterOperand {
+    enum class Source { kProbe, kTable, kConstant };
+
+    Source source;
+    // Index into 'simpleFilterDecoded_' for kProbe and the hash table column
+    // for kTable.
+    column_index_t channel{0};
+    // Value of kConstant.
+    int64_t constant{0};
+  };
+
+  // 'left op right' with both sides of the same type.
+  struct SimpleFilterComparison {
+    enum class Op { kEq, kNeq, kLt, kLte, kGt, kGte };
+
+    Op op;
+    TypeKind kind;
+    SimpleFilterOperand left;
+    SimpleFilterOperand right;
+  };
+
   void setState(ProbeOperatorState state);
   void checkStateTransition(ProbeOperatorState state);
 
@@ -92,12 +153,30 @@ class HashProbe : public Operator {
       const std::optional<SpillPartitionId>& restoredSpillPartitionId,
       const SpillPartitionIdSet& spillPartitionIds);
 
+  // Sets 'earlyFilters_' to the downstream inner joins in the pipeline that
+  // are separated from this one only by inner joins and FilterProjects.
+  void initializeEarlyFilters();
+
+  // Enables or disables 'earlyFilters_' by the observed selectivities.
+  void updateEarlyFilters();
+
+  // Removes the rows of 'input_' that the enabled 'earlyFilters_' drop. Sets
+  // 'input_' to nullptr if no row passes.
+  void applyEarlyFilters();
+
   // Sets up 'filter_' and related members.p
   void initializeFilter(
       const core::TypedExprPtr& filter,
       const RowTypePtr& probeType,
       const RowTypePtr& tableType);
 
+  // Sets 'simpleFilter_' if 'filter' is a conjunction of comparisons that
+  // evalSimpleFilter() supports. Returns false otherwise.
+  bool initializeSimpleFilter(
+      const core::TypedExprPtr& filter,
+      const RowTypePtr& probeType,
+      const RowTypePtr& tableType);
+
   // Check if output_ can be re-used and if not make a new one.
   void prepareOutput(vector_size_t size);
 
@@ -124,6 +203,15 @@ class HashProbe : public Operator {
   // Returns the number of passing rows.
   vector_size_t evalFilter(vector_size_t numRows);
 
+  // Evaluates 'simpleFilter_' on the first 'numRows' rows of
+  // 'outputTableRows_' into 'filterResult_'.
+  void evalSimpleFilter(vector_size_t numRows);
+
+  template <typename T>
+  void evalSimpleComparison(
+      const SimpleFilterComparison& comparison,
+      uint64_t* rawResult);
+
   inline bool filterPassed(vector_size_t row) {
     return filterInputRows_.isValid(row) &&
         !decodedFilterResult_.isNullAt(row) &&
@@ -240,8 +328,12 @@ class HashProbe : public Operator {
         spillInputPartitionIds_.empty();
   }
 
-  // TODO: Define batch size as bytes based on RowContainer row sizes.
-  const uint32_t outputBatchSize_;
+  // Sets 'outputBatchSize_' from the sizes of the probe input rows and of the
+  // build side rows if QueryConfig::kOutputBatchSizeByBytes is set.
+  void updateOutputBatchSize();
+
+  // Max number of rows per output batch.
+  uint32_t outputBatchSize_;
 
   const std::shared_ptr<const core::HashJoinNode> joinNode_;
 
@@ -288,6 +380,10 @@ class HashProbe : public Operator {
   // True if the join can become a no-op starting with the next batch of input.
   bool canReplaceWithDynamicFilter_{false};
 
+  // True if any of the dynamic filters to push down is approximate, e.g. a
+  // Bloom filter. The join must then still probe the rows that pass.
+  bool hasApproximateDynamicFilter_{false};
+
   // True if the join became a no-op after pushing down the filter.
   bool replacedWithDynamicFilter_{false};
 
@@ -336,6 +432,18 @@ class HashProbe : public Operator {
   // Maps from column index in hash table to channel in 'filterInputType_'.
   std::vector<IdentityProjection> filterTableProjections_;
 
+  // Conjuncts of 'filter_' if it is a conjunction of comparisons between
+  // probe side columns, build side columns and constants of the same BIGINT
+  // or INTEGER type. Such a filter is evaluated on 'input_' and the hash
+  // table rows without making 'filterInput_'. Empty if 'filter_' is evaluated
+  // by the expression evaluator.
+  std::vector<SimpleFilterComparison> simpleFilter_;
+
+  // The probe input channels referenced by 'simpleFilter_' and their decoded
+  // columns for the current input.
+  std::vector<column_index_t> simpleFilterChannels_;
+  std::vector<DecodedVector> simpleFilterDecoded_;
+
   // Temporary projection from probe and build for evaluating
   // 'filter_'. This can always be reused since this does not escape
   // this operator.
@@ -369,6 +477,10 @@ class HashProbe : public Operator {
   // Rows of table found by join probe, later filtered by 'filter_'.
   std::vector<char*> outputTableRows_;
 
+  // If true, the build side columns of the output are LazyVectors over a copy
+  // of 'outputTableRows_'. See QueryConfig::kHashProbeLazyBuildColumns.
+  const bool lazyBuildColumns_;
+
   // Indicates probe-side rows which should produce a NULL in left semi project
   // with filter.
   SelectivityVector leftSemiProjectIsNull_;
@@ -569,6 +681,24 @@ class HashProbe : public Operator {
   // Input rows with no nulls in the join keys.
   SelectivityVector nonNullInputRows_;
 
+  // If true, inner joins count their probed and matched rows and filter their
+  // input by more selective downstream inner joins. See
+  // QueryConfig::kHashProbeEarlyJoinFilterEnabled.
+  const bool earlyJoinFilterEnabled_;
+  bool earlyFiltersInitialized_{false};
+  std::vector<EarlyFilter> earlyFilters_;
+  // Input rows that pass 'earlyFilters_'.
+  SelectivityVector earlyFilterRows_;
+
+  // Input rows of this inner join and the rows with a match.
+  uint64_t numProbedRows_{0};
+  uint64_t numMatchedRows_{0};
+
+  // Hashers and lookup for filterEarly() calls from an upstream join.
+  std::vector<std::unique_ptr<VectorHasher>> earlyFilterHashers_;
+  std::unique_ptr<HashLookup> earlyFilterLookup_;
+  VectorHasher::ScratchMemory earlyFilterScratchMemory_;
+
   // Input rows with a hash match. This is a subset of rows with no nulls in the
   // join keys and a superset of rows that have a match on the build side.
   SelectivityVector activeRows_;
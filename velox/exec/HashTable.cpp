@@ -55,11 +55,16 @@ HashTable<ignoreNullKeys>::HashTable(
       minTableSizeForParallelJoinBuild_(minTableSizeForParallelJoinBuild),
       isJoinBuild_(isJoinBuild) {
   std::vector<TypePtr> keys;
+  bool allBigint = true;
   for (auto& hasher : hashers_) {
     keys.push_back(hasher->type());
     if (!VectorHasher::typeKindSupportsValueIds(hasher->typeKind())) {
       hashMode_ = HashMode::kHash;
     }
+    allBigint &= hasher->typeKind() == TypeKind::BIGINT;
+  }
+  if (allBigint && hashers_.size() <= kMaxBigintKeys) {
+    numBigintKeys_ = hashers_.size();
   }
 
   rows_ = std::make_unique<RowContainer>(
@@ -280,6 +285,18 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::storeKeys(
     HashLookup& lookup,
     vector_size_t row) {
+  switch (numBigintKeys_) {
+    case 1:
+      return storeBigintKeys<1>(lookup, row);
+    case 2:
+      return storeBigintKeys<2>(lookup, row);
+    case 3:
+      return storeBigintKeys<3>(lookup, row);
+    case 4:
+      return storeBigintKeys<4>(lookup, row);
+    default:
+      break;
+  }
   for (int32_t i = 0; i < hashers_.size(); ++i) {
     auto& hasher = hashers_[i];
     rows_->store(hasher->decodedVector(), row, lookup.hits[row], i); // NOLINT
@@ -355,6 +372,99 @@ bool HashTable<ignoreNullKeys>::compareKeys(
   return true;
 }
 
+template <bool ignoreNullKeys>
+template <int32_t numKeys>
+void HashTable<ignoreNullKeys>::storeBigintKeys(
+    HashLookup& lookup,
+    vector_size_t row) {
+  char* group = lookup.hits[row];
+  for (int32_t i = 0; i < numKeys; ++i) {
+    const auto& decoded = hashers_[i]->decodedVector();
+    const auto column = rows_->columnAt(i);
+    auto* value = reinterpret_cast<int64_t*>(group + column.offset());
+    if constexpr (!ignoreNullKeys) {
+      if (decoded.isNullAt(row)) {
+        group[column.nullByte()] |= column.nullMask();
+        *value = 0;
+        continue;
+      }
+    }
+    *value = decoded.valueAt<int64_t>(row);
+  }
+}
+
+template <bool ignoreNullKeys>
+template <int32_t numKeys>
+FOLLY_ALWAYS_INLINE bool HashTable<ignoreNullKeys>::compareBigintKeys(
+    const char* group,
+    HashLookup& lookup,
+    vector_size_t row) {
+  for (int32_t i = 0; i < numKeys; ++i) {
+    const auto& decoded = lookup.hashers[i]->decodedVector();
+    const auto column = rows_->columnAt(i);
+    if constexpr (!ignoreNullKeys) {
+      const bool groupIsNull =
+          RowContainer::isNullAt(group, column.nullByte(), column.nullMask());
+      const bool rowIsNull = decoded.isNullAt(row);
+      if (groupIsNull || rowIsNull) {
+        if (groupIsNull != rowIsNull) {
+          return false;
+        }
+        continue;
+      }
+    }
+    if (decoded.valueAt<int64_t>(row) !=
+        *reinterpret_cast<const int64_t*>(group + column.offset())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <bool ignoreNullKeys>
+template <bool isJoin>
+FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::fullProbeWithKeys(
+    HashLookup& lookup,
+    ProbeState& state,
+    bool extraCheck) {
+  constexpr ProbeState::Operation op =
+      isJoin ? ProbeState::Operation::kProbe : ProbeState::Operation::kInsert;
+  auto probe = [&](auto compare) INLINE_LAMBDA {
+    // NOLINT
+    lookup.hits[state.row()] = state.fullProbe<op>(
+        *this,
+        0,
+        compare,
+        [&](int32_t index, int32_t row) {
+          return isJoin ? nullptr : insertEntry(lookup, row, index);
+        },
+        numTombstones_,
+        !isJoin && extraCheck);
+  };
+  switch (numBigintKeys_) {
+    case 1:
+      return probe([&](char* group, int32_t row) {
+        return compareBigintKeys<1>(group, lookup, row);
+      });
+    case 2:
+      return probe([&](char* group, int32_t row) {
+        return compareBigintKeys<2>(group, lookup, row);
+      });
+    case 3:
+      return probe([&](char* group, int32_t row) {
+        return compareBigintKeys<3>(group, lookup, row);
+      });
+    case 4:
+      return probe([&](char* group, int32_t row) {
+        return compareBigintKeys<4>(group, lookup, row);
+      });
+    default:
+      return probe([&](char* group, int32_t row) {
+        return compareKeys(group, lookup, row);
+      });
+  }
+}
+
 template <bool ignoreNullKeys>
 template <bool isJoin, bool isNormalizedKey>
 FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::fullProbe(
@@ -379,16 +489,7 @@ FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::fullProbe(
         !isJoin && extraCheck);
     return;
   }
-  // NOLINT
-  lookup.hits[state.row()] = state.fullProbe<op>(
-      *this,
-      0,
-      [&](char* group, int32_t row) { return compareKeys(group, lookup, row); },
-      [&](int32_t index, int32_t row) {
-        return isJoin ? nullptr : insertEntry(lookup, row, index);
-      },
-      numTombstones_,
-      !isJoin && extraCheck);
+  fullProbeWithKeys<isJoin>(lookup, state, extraCheck);
 }
 
 namespace {
@@ -484,7 +585,19 @@ void HashTable<ignoreNullKeys>::groupNormalizedKeyProbe(HashLookup& lookup) {
   auto rows = lookup.rows.data();
   constexpr int32_t kKeyOffset =
       -static_cast<int32_t>(sizeof(normalized_key_t));
+  // Distance in rows at which buckets are prefetched ahead of the probe. Each
+  // group of 4 rows may insert, so probe state cannot be set up ahead of time
+  // but prefetching the buckets is safe.
+  constexpr int32_t kPrefetchDistance = 16;
+  const auto* hashes = lookup.hashes.data();
   for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
+    if (probeIndex + kPrefetchDistance + 4 <= numProbes) {
+      for (int32_t i = 0; i < 4; ++i) {
+        __builtin_prefetch(
+            reinterpret_cast<uint8_t*>(table_) +
+            bucketOffset(hashes[rows[probeIndex + kPrefetchDistance + i]]));
+      }
+    }
     int32_t row = rows[probeIndex];
     state1.preProbe(*this, lookup.hashes[row], row);
     row = rows[probeIndex + 1];
@@ -565,7 +678,11 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   incrementProbes(lookup.rows.size());
   if (hashMode_ == HashMode::kArray) {
-    arrayJoinProbe(lookup);
+    if (memberBits_ != nullptr) {
+      arrayMemberProbe(lookup);
+    } else {
+      arrayJoinProbe(lookup);
+    }
     return;
   }
   if (hashMode_ == HashMode::kNormalizedKey) {
@@ -575,7 +692,7 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   }
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
+  const vector_size_t* rows = clusterProbeRows(lookup);
   ProbeState state1;
   ProbeState state2;
   ProbeState state3;
@@ -652,34 +769,84 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
-  constexpr int32_t groupSize = 64;
-  ProbeState states[groupSize];
+  const vector_size_t* rows = clusterProbeRows(lookup);
+  // The probe is software pipelined over batches of 'kBatchSize' rows: the
+  // buckets of the next batch are prefetched while the tags and keys of the
+  // current batch are compared. A batch is about as many prefetches as a core
+  // can have in flight, so that these are not dropped.
+  constexpr int32_t kBatchSize = 16;
+  ProbeState states[2][kBatchSize];
   const uint64_t* keys = lookup.normalizedKeys.data();
   const uint64_t* hashes = lookup.hashes.data();
   char** hits = lookup.hits.data();
   constexpr int32_t kKeyOffset =
       -static_cast<int32_t>(sizeof(normalized_key_t));
-  for (; probeIndex + groupSize <= numProbes; probeIndex += groupSize) {
-    for (int32_t i = 0; i < groupSize; ++i) {
-      int32_t row = rows[probeIndex + i];
-      states[i].preProbe(*this, hashes[row], row);
+  auto preProbeBatch = [&](ProbeState* batch, int32_t begin) INLINE_LAMBDA {
+    for (int32_t i = 0; i < kBatchSize; ++i) {
+      const int32_t row = rows[begin + i];
+      batch[i].preProbe(*this, hashes[row], row);
     }
-    for (int32_t i = 0; i < groupSize; ++i) {
-      states[i].firstProbe(*this, kKeyOffset);
+  };
+  if (numProbes >= kBatchSize) {
+    preProbeBatch(states[0], 0);
+  }
+  for (int32_t batchIndex = 0; probeIndex + kBatchSize <= numProbes;
+       probeIndex += kBatchSize, ++batchIndex) {
+    ProbeState* batch = states[batchIndex & 1];
+    if (probeIndex + 2 * kBatchSize <= numProbes) {
+      preProbeBatch(states[(batchIndex + 1) & 1], probeIndex + kBatchSize);
+    }
+    for (int32_t i = 0; i < kBatchSize; ++i) {
+      batch[i].firstProbe(*this, kKeyOffset);
     }
-    for (int32_t i = 0; i < groupSize; ++i) {
-      hits[states[i].row()] = states[i].joinNormalizedKeyFullProbe(*this, keys);
+    for (int32_t i = 0; i < kBatchSize; ++i) {
+      hits[batch[i].row()] = batch[i].joinNormalizedKeyFullProbe(*this, keys);
     }
   }
   for (; probeIndex < numProbes; ++probeIndex) {
     int32_t row = rows[probeIndex];
-    states[0].preProbe(*this, lookup.hashes[row], row);
-    states[0].firstProbe(*this, 0);
-    hits[row] = states[0].joinNormalizedKeyFullProbe(*this, keys);
+    states[0][0].preProbe(*this, hashes[row], row);
+    states[0][0].firstProbe(*this, kKeyOffset);
+    hits[row] = states[0][0].joinNormalizedKeyFullProbe(*this, keys);
   }
 }
 
+template <bool ignoreNullKeys>
+const vector_size_t* HashTable<ignoreNullKeys>::clusterProbeRows(
+    HashLookup& lookup) const {
+  const int64_t tableBytes = sizeMask_ + 1;
+  const int32_t numProbes = lookup.rows.size();
+  if (tableBytes < 2 * kProbeClusterBytes ||
+      numProbes < kMinProbeClusterRows) {
+    return lookup.rows.data();
+  }
+  const int32_t tableBits = __builtin_ctzll(tableBytes);
+  const int32_t clusterBits = std::min<int32_t>(
+      kMaxProbeClusterBits, tableBits - __builtin_ctzll(kProbeClusterBytes));
+  const HashBitRange clusterRange(tableBits - clusterBits, tableBits);
+
+  // Counting sort of the probe rows on the high bits of their bucket offset.
+  // The sort is stable so that rows within a cluster keep their order.
+  std::array<int32_t, (1 << kMaxProbeClusterBits) + 1> clusterStarts{};
+  const auto* rows = lookup.rows.data();
+  const auto* hashes = lookup.hashes.data();
+  for (auto i = 0; i < numProbes; ++i) {
+    ++clusterStarts[1 + clusterRange.partition(bucketOffset(hashes[rows[i]]))];
+  }
+  for (auto i = 1; i <= (1 << clusterBits); ++i) {
+    clusterStarts[i] += clusterStarts[i - 1];
+  }
+  lookup.clusteredRows.resize(numProbes);
+  auto* clusteredRows = lookup.clusteredRows.data();
+  for (auto i = 0; i < numProbes; ++i) {
+    const auto row = rows[i];
+    clusteredRows
+        [clusterStarts[clusterRange.partition(bucketOffset(hashes[row]))]++] =
+            row;
+  }
+  return clusteredRows;
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::allocateTables(uint64_t size) {
   VELOX_CHECK(bits::isPowerOfTwo(size), "Size is not a power of two: {}", size);
@@ -694,7 +861,22 @@ void HashTable<ignoreNullKeys>::allocateTables(uint64_t size) {
   // cache line.
   const auto numPages =
       memory::AllocationTraits::numPages(size * tableSlotSize());
-  rows_->pool()->allocateContiguous(numPages, tableAllocation_);
+  const auto numAllocatedPages = tableAllocation_.numPages();
+  if (numPages > numAllocatedPages &&
+      memory::AllocationTraits::pageBytes(numPages) <=
+          tableAllocation_.maxSize()) {
+    // Grows within the address range reserved by an earlier allocation. The
+    // pages of the old table are reused, so the reservation only increases
+    // by the difference and there is no unmap and remap.
+    tableAllocation_.grow(numPages - numAllocatedPages);
+  } else {
+    // Reserves address space for growing a large table in place a few
+    // times. Only 'numPages' count as used.
+    const auto maxPages = numPages >= kMinTablePagesForGrowth
+        ? numPages * kTableGrowthFactor
+        : numPages;
+    rows_->pool()->allocateContiguous(numPages, tableAllocation_, maxPages);
+  }
   table_ = tableAllocation_.data<char*>();
   memset(table_, 0, capacity_ * sizeof(char*));
 }
@@ -702,6 +884,9 @@ void HashTable<ignoreNullKeys>::allocateTables(uint64_t size) {
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::clear() {
   rows_->clear();
+  if (memberBits_ != nullptr) {
+    memset(memberBits_, 0, bits::nwords(capacity_) * sizeof(uint64_t));
+  }
   if (table_) {
     // All modes have 8 bytes per slot.
     memset(table_, 0, capacity_ * sizeof(char*));
@@ -825,16 +1010,30 @@ bool HashTable<ignoreNullKeys>::canApplyParallelJoinBuild() const {
   if (otherTables_.empty()) {
     return false;
   }
-  return (capacity_ / (1 + otherTables_.size())) >
+  return (capacity_ / numParallelBuildPartitions()) >
       minTableSizeForParallelJoinBuild_;
 }
 
+template <bool ignoreNullKeys>
+int32_t HashTable<ignoreNullKeys>::numParallelBuildPartitions() const {
+  const int64_t numBuckets = capacity_ * tableSlotSize() / kBucketSize;
+  return std::max<int64_t>(
+      1,
+      std::min<int64_t>(
+          {static_cast<int64_t>(
+               bits::nextPowerOfTwo(1 + otherTables_.size())),
+           kMaxParallelBuildPartitions,
+           numBuckets}));
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::parallelJoinBuild() {
   TestValue::adjust(
       "facebook::velox::exec::HashTable::parallelJoinBuild", rows_->pool());
   VELOX_CHECK_LE(1 + otherTables_.size(), std::numeric_limits<uint8_t>::max());
-  uint8_t numPartitions = 1 + otherTables_.size();
+  const int32_t numTables = 1 + otherTables_.size();
+  const int32_t numPartitions = numParallelBuildPartitions();
+  VELOX_CHECK(bits::isPowerOfTwo(numPartitions));
   VELOX_CHECK_GT(
       capacity_ / numPartitions,
       minTableSizeForParallelJoinBuild_,
@@ -847,12 +1046,17 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
       buildPartitionBounds_.begin() + buildPartitionBounds_.capacity(),
       std::numeric_limits<PartitionBoundIndexType>::max());
 
-  // The partitioning is in terms of ranges of bucket offset.
+  // The partitioning is in terms of ranges of bucket offset. The partition of
+  // a bucket offset is given by its high bits. Since both the table size and
+  // the number of partitions are powers of two and there are no more
+  // partitions than buckets, the bounds are always cache line aligned.
+  const int32_t tableBits = __builtin_ctzll(sizeMask_ + 1);
+  const int32_t partitionBits = __builtin_ctz(numPartitions);
+  buildPartitionBits_ = HashBitRange(tableBits - partitionBits, tableBits);
   for (auto i = 0; i < numPartitions; ++i) {
-    // The bounds are the closes tag/row pointer group bound, always cache
-    // line aligned.
-    buildPartitionBounds_[i] =
-        bits::roundUp(((sizeMask_ + 1) / numPartitions) * i, kBucketSize);
+    buildPartitionBounds_[i] = static_cast<PartitionBoundIndexType>(i)
+        << buildPartitionBits_.begin();
+    VELOX_DCHECK_EQ(0, buildPartitionBounds_[i] % kBucketSize);
     // Bounds must always be positive
     VELOX_CHECK_GE(
         buildPartitionBounds_[i],
@@ -880,14 +1084,14 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
   // This step can involve large memory allocations, so there is a chance of
   // OOMs here. Do it before any async work is started to reduce the chances of
   // concurrency issues.
-  rowPartitions.reserve(numPartitions);
-  for (auto i = 0; i < numPartitions; ++i) {
+  rowPartitions.reserve(numTables);
+  for (auto i = 0; i < numTables; ++i) {
     auto* table = getTable(i);
     rowPartitions.push_back(table->rows()->createRowPartitions(*rows_->pool()));
   }
 
   // The parallel table partitioning step.
-  for (auto i = 0; i < numPartitions; ++i) {
+  for (auto i = 0; i < numTables; ++i) {
     auto* table = getTable(i);
     partitionSteps.push_back(std::make_shared<AsyncSource<bool>>(
         [this, table, rawRowPartitions = rowPartitions[i].get()]() {
@@ -922,6 +1126,9 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
   raw_vector<uint64_t> hashes;
   for (auto i = 0; i < numPartitions; ++i) {
     auto& overflows = overflowPerPartition[i];
+    if (overflows.empty()) {
+      continue;
+    }
     hashes.resize(overflows.size());
     hashRows(
         folly::Range<char**>(overflows.data(), overflows.size()),
@@ -934,33 +1141,13 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
         0,
         sizeMask_ + 1,
         nullptr);
-    auto table = i == 0 ? this : otherTables_[i - 1].get();
+  }
+  for (auto i = 0; i < numTables; ++i) {
+    auto* table = getTable(i);
     VELOX_CHECK_EQ(table->rows()->numRows(), table->numParallelBuildRows_);
   }
 }
 
-namespace {
-// Returns an index into 'buildPartitionBounds_' given an index into tags of the
-// HashTable.
-int32_t findPartition(
-    PartitionBoundIndexType index,
-    const PartitionBoundIndexType* bounds,
-    int32_t numPartitions) {
-  // The partition bounds are padded to batch size.
-  constexpr int32_t kBatch = xsimd::batch<PartitionBoundIndexType>::size;
-  auto indexVector = xsimd::batch<PartitionBoundIndexType>::broadcast(index);
-  for (auto i = 1; i < numPartitions; i += kBatch) {
-    auto bits = simd::toBitMask(
-        indexVector <
-        xsimd::batch<PartitionBoundIndexType>::load_unaligned(bounds + i));
-    if (bits) {
-      return i + __builtin_ctz(bits) - 1;
-    }
-  }
-  VELOX_UNREACHABLE("Partition index out of range");
-}
-} // namespace
-
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::partitionRows(
     HashTable<ignoreNullKeys>& subtable,
@@ -973,15 +1160,8 @@ void HashTable<ignoreNullKeys>::partitionRows(
   while (auto numRows = subtable.rows_->listRows(
              &iter, kBatch, RowContainer::kUnlimited, rows.data())) {
     hashRows(folly::Range<char**>(rows.data(), numRows), true, hashes);
-    VELOX_DCHECK_EQ(
-        0,
-        buildPartitionBounds_.capacity() %
-            xsimd::batch<PartitionBoundIndexType>::size,
-        "partition bounds must be padded to SIMD width");
     for (auto i = 0; i < numRows; ++i) {
-      auto index = bucketOffset(hashes[i]);
-      partitions[i] = findPartition(
-          index, buildPartitionBounds_.data(), buildPartitionBounds_.size());
+      partitions[i] = buildPartitionBits_.partition(bucketOffset(hashes[i]));
     }
     rowPartitions.appendPartitions(
         folly::Range<const uint8_t*>(partitions.data(), numRows));
@@ -996,8 +1176,8 @@ void HashTable<ignoreNullKeys>::buildJoinPartition(
   constexpr int32_t kBatch = 1024;
   raw_vector<char*> rows(kBatch);
   raw_vector<uint64_t> hashes(kBatch);
-  int32_t numPartitions = 1 + otherTables_.size();
-  for (auto i = 0; i < numPartitions; ++i) {
+  const int32_t numTables = 1 + otherTables_.size();
+  for (auto i = 0; i < numTables; ++i) {
     auto table = i == 0 ? this : otherTables_[i - 1].get();
     RowContainerIterator iter;
     while (auto numRows = table->rows_->listPartitionRows(
@@ -1571,6 +1751,75 @@ void HashTable<ignoreNullKeys>::prepareJoinTable(
   } else {
     decideHashMode(0);
   }
+  maybeMakeMemberBits();
+}
+
+namespace {
+// The hit of a match in a probe of a table with member bits. Nothing is read
+// from it since the table has no dependent columns or next row links.
+char memberHitRow[16] = {};
+} // namespace
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::arrayMemberProbe(HashLookup& lookup) {
+  auto& rows = lookup.rows;
+  const auto* hashes = lookup.hashes.data();
+  auto* hits = reinterpret_cast<uint64_t*>(lookup.hits.data());
+  const auto* words = reinterpret_cast<const int64_t*>(memberBits_);
+  const auto hitRow = reinterpret_cast<uint64_t>(memberHitRow);
+  const auto numRows = rows.size();
+  auto isMember = [&](uint64_t index) {
+    VELOX_DCHECK_LT(index, capacity_);
+    return bits::isBitSet(memberBits_, index);
+  };
+  int32_t i = 0;
+  using Batch = xsimd::batch<uint64_t>;
+  constexpr int32_t kBatchSize = Batch::size;
+  const auto hitRows = Batch::broadcast(hitRow);
+  const auto zeros = Batch::broadcast(0);
+  const auto ones = Batch::broadcast(1);
+  const auto bitMask = Batch::broadcast(63);
+  for (; i + kBatchSize <= numRows; i += kBatchSize) {
+    const auto firstRow = rows[i];
+    if (rows[i + kBatchSize - 1] - firstRow == kBatchSize - 1) {
+      // Consecutive rows. Gathers the word of each slot and tests its bit.
+      const auto indices = Batch::load_unaligned(hashes + firstRow);
+      const auto bitWords = xsimd::bitwise_cast<uint64_t>(
+          simd::gather(words, xsimd::bitwise_cast<int64_t>(indices >> 6)));
+      const auto isSet = ((bitWords >> (indices & bitMask)) & ones) != zeros;
+      xsimd::select(isSet, hitRows, zeros).store_unaligned(hits + firstRow);
+    } else {
+      for (auto j = i; j < i + kBatchSize; ++j) {
+        const auto row = rows[j];
+        hits[row] = isMember(hashes[row]) ? hitRow : 0;
+      }
+    }
+  }
+  for (; i < numRows; ++i) {
+    const auto row = rows[i];
+    hits[row] = isMember(hashes[row]) ? hitRow : 0;
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::maybeMakeMemberBits() {
+  if (hashMode_ != HashMode::kArray || !isJoinBuild_ || table_ == nullptr ||
+      nextOffset_ != 0 || rows_->probedFlagOffset() != 0 ||
+      rows_->columnTypes().size() != rows_->keyTypes().size()) {
+    return;
+  }
+  const auto numBytes = bits::nwords(capacity_) * sizeof(uint64_t);
+  rows_->pool()->allocateContiguous(
+      memory::AllocationTraits::numPages(numBytes), memberBitsAllocation_);
+  memberBits_ = memberBitsAllocation_.data<uint64_t>();
+  memset(memberBits_, 0, numBytes);
+  for (int64_t i = 0; i < capacity_; ++i) {
+    if (table_[i] != nullptr) {
+      bits::setBit(memberBits_, i);
+    }
+  }
+  rows_->pool()->freeContiguous(tableAllocation_);
+  table_ = nullptr;
 }
 
 template <bool ignoreNullKeys>
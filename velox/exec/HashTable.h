@@ -17,6 +17,7 @@
 
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/MemoryAllocator.h"
+#include "velox/exec/HashBitRange.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/VectorHasher.h"
@@ -47,6 +48,10 @@ struct HashLookup {
   raw_vector<char*> hits;
   // Indices of newly inserted rows (not found during probe).
   std::vector<vector_size_t> newGroups;
+  // Permutation of 'rows' grouped by table partition. Used by join probe of a
+  // large table to keep consecutive probes within a cache sized range of the
+  // table. The order of 'rows' itself is not changed.
+  raw_vector<vector_size_t> clusteredRows;
 };
 
 struct HashTableStats {
@@ -294,6 +299,26 @@ class BaseHashTable {
     return offThreadBuildTiming_;
   }
 
+  /// Sets an approximate dynamic filter for the join key at 'keyIndex'. This
+  /// is made by hash join build for a key with too many distinct values for
+  /// the exact filter from the key's VectorHasher.
+  void setJoinKeyBloomFilter(
+      column_index_t keyIndex,
+      std::shared_ptr<const common::Filter> filter) {
+    if (joinKeyBloomFilters_.size() <= keyIndex) {
+      joinKeyBloomFilters_.resize(keyIndex + 1);
+    }
+    joinKeyBloomFilters_[keyIndex] = std::move(filter);
+  }
+
+  /// Returns the filter set by setJoinKeyBloomFilter() for the join key at
+  /// 'keyIndex' or nullptr if there is none.
+  const common::Filter* joinKeyBloomFilter(column_index_t keyIndex) const {
+    return keyIndex < joinKeyBloomFilters_.size()
+        ? joinKeyBloomFilters_[keyIndex].get()
+        : nullptr;
+  }
+
  protected:
   static FOLLY_ALWAYS_INLINE size_t tableSlotSize() {
     // Each slot is 8 bytes.
@@ -307,6 +332,10 @@ class BaseHashTable {
 
   // Time spent in build outside of the calling thread.
   CpuWallTiming offThreadBuildTiming_;
+
+  // Approximate dynamic filters on the join keys, indexed by key. Immutable
+  // once the table is handed to the probe side.
+  std::vector<std::shared_ptr<const common::Filter>> joinKeyBloomFilters_;
 };
 
 FOLLY_ALWAYS_INLINE std::ostream& operator<<(
@@ -437,6 +466,12 @@ class HashTable : public BaseHashTable {
     return hashMode_;
   }
 
+  /// True if a kArray mode join table has been replaced by a bitmap of the
+  /// occupied slots. See 'memberBits_'.
+  bool hasMemberBits() const {
+    return memberBits_ != nullptr;
+  }
+
   void decideHashMode(int32_t numNew, bool disableRangeArrayHash = false)
       override;
 
@@ -501,6 +536,21 @@ class HashTable : public BaseHashTable {
   }
 
  private:
+  // Target size of a range of the table that is probed from one cluster of
+  // probe rows. This is about the size of a L2 cache.
+  static constexpr int64_t kProbeClusterBytes = 1 << 20;
+
+  // Max number of bits for selecting a probe cluster.
+  static constexpr int32_t kMaxProbeClusterBits = 8;
+
+  // Min number of probe rows for clustering the probes. Below this the
+  // clustering costs more than it saves.
+  static constexpr int32_t kMinProbeClusterRows = 256;
+
+  // Max number of partitions for parallel join build. Partition numbers are
+  // stored as uint8_t in RowPartitions.
+  static constexpr int32_t kMaxParallelBuildPartitions = 128;
+
   // Enables debug stats for collisions for debug build.
 #ifdef NDEBUG
   static constexpr bool kTrackLoads = false;
@@ -672,13 +722,20 @@ class HashTable : public BaseHashTable {
   //    than a pre-defined threshold: 1000 for now.
   bool canApplyParallelJoinBuild() const;
 
+  // Returns the number of partitions for parallel join build. This is the
+  // number of build side tables rounded up to a power of two so that a
+  // partition is selected by the high bits of a bucket offset, and is at most
+  // the number of buckets in the table.
+  int32_t numParallelBuildPartitions() const;
+
   // Builds a join table with '1 + otherTables_.size()' independent
-  // threads using 'executor_'. First all RowContainers get partition
-  // numbers assigned to each row. Next, all threads pick all rows
-  // assigned to their thread-specific partition and insert these. If
-  // a row would overflow past the end of its partition it is added to
-  // a set of overflow rows that are sequentially inserted after all
-  // else.
+  // threads using 'executor_'. The table is radix partitioned into
+  // numParallelBuildPartitions() contiguous, bucket aligned ranges selected
+  // by the high bits of the bucket offset. First all RowContainers get
+  // partition numbers assigned to each row. Next, a thread per partition
+  // picks all rows assigned to its partition and inserts these. If a row
+  // would overflow past the end of its partition it is added to a set of
+  // overflow rows that are sequentially inserted after all else.
   void parallelJoinBuild();
 
   // Inserts the rows in 'partition' from this and 'otherTables' into 'this'.
@@ -713,6 +770,23 @@ class HashTable : public BaseHashTable {
 
   bool compareKeys(const char* group, const char* inserted);
 
+  // Versions of compareKeys() and storeKeys() for 'numKeys' BIGINT keys. The
+  // loops over the keys are unrolled and there is no dispatch on the type.
+  template <int32_t numKeys>
+  bool
+  compareBigintKeys(const char* group, HashLookup& lookup, vector_size_t row);
+
+  template <int32_t numKeys>
+  void storeBigintKeys(HashLookup& lookup, vector_size_t row);
+
+  // Probes with compareKeys() or, if 'numBigintKeys_' is set, with
+  // compareBigintKeys().
+  template <bool isJoin>
+  void fullProbeWithKeys(
+      HashLookup& lookup,
+      ProbeState& state,
+      bool extraCheck);
+
   template <bool isJoin, bool isNormalizedKey = false>
   void fullProbe(HashLookup& lookup, ProbeState& state, bool extraCheck);
 
@@ -722,9 +796,25 @@ class HashTable : public BaseHashTable {
   // Array probe with SIMD.
   void arrayJoinProbe(HashLookup& lookup);
 
+  // Array probe of 'memberBits_' with SIMD. Sets the hit of a match to a
+  // placeholder row.
+  void arrayMemberProbe(HashLookup& lookup);
+
+  // Replaces 'table_' with 'memberBits_' if this is a kArray mode join build
+  // where a probe only needs to know whether the key is present. This is the
+  // case if there are no dependent columns, duplicates or probed flags.
+  void maybeMakeMemberBits();
+
   // Shortcut for probe with normalized keys.
   void joinNormalizedKeyProbe(HashLookup& lookup);
 
+  // Returns the order in which to probe 'lookup.rows' in a join probe. If the
+  // table is much larger than a CPU cache and there are enough probes, the
+  // rows are radix clustered by the high bits of their bucket offset into
+  // 'lookup.clusteredRows' so that consecutive probes stay inside a cache
+  // sized range of the table. Otherwise returns 'lookup.rows'.
+  const vector_size_t* clusterProbeRows(HashLookup& lookup) const;
+
   // Adds a row to a hash join table in kArray hash mode. Returns true
   // if a new entry was made and false if the row was added to an
   // existing set of rows with the same key.
@@ -824,8 +914,20 @@ class HashTable : public BaseHashTable {
   // from 'rows_'.
   int32_t nextOffset_;
   char** table_ = nullptr;
+  // A table of at least this many pages reserves address space for
+  // kTableGrowthFactor times its size, so that rehashes to a larger size grow
+  // the allocation in place.
+  static constexpr memory::MachinePageCount kMinTablePagesForGrowth = 256;
+  static constexpr int32_t kTableGrowthFactor = 8;
+
   memory::ContiguousAllocation tableAllocation_;
 
+  // Bit i is set if slot i of the kArray mode table has a row. Replaces
+  // 'table_' for a semi or anti join build with a single bit per slot instead
+  // of a pointer. nullptr if 'table_' is used.
+  uint64_t* memberBits_ = nullptr;
+  memory::ContiguousAllocation memberBitsAllocation_;
+
   // Number of slots across all buckets.
   int64_t capacity_{0};
 
@@ -839,6 +941,12 @@ class HashTable : public BaseHashTable {
   int64_t numDistinct_{0};
   // Counts the number of tombstone table slots.
   int64_t numTombstones_{0};
+
+  // Number of keys if all keys are BIGINT and there are at most
+  // kMaxBigintKeys keys, 0 otherwise. Selects the specialized comparison and
+  // store of keys.
+  static constexpr int32_t kMaxBigintKeys = 4;
+  int32_t numBigintKeys_{0};
   // Counts the number of rehash() calls.
   int64_t numRehashes_{0};
   HashMode hashMode_ = HashMode::kArray;
@@ -866,6 +974,12 @@ class HashTable : public BaseHashTable {
   // of cache line  size.
   raw_vector<PartitionBoundIndexType> buildPartitionBounds_;
 
+  // Bits of a bucket offset that give the partition of a row in parallel join
+  // build. These are the high bits of the table byte offset, so partition i
+  // covers the byte range [buildPartitionBounds_[i],
+  // buildPartitionBounds_[i + 1]).
+  HashBitRange buildPartitionBits_;
+
   // Executor for parallelizing hash join build. This may be the
   // executor for Drivers. If this executor is indefinitely taken by
   // other work, the thread of prepareJoinTables() will sequentially
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/HashTableCache.h"
+
+namespace facebook::velox::exec {
+namespace {
+void notify(std::vector<ContinuePromise> promises) {
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+} // namespace
+
+// static
+HashTableCache* HashTableCache::getInstance() {
+  // Never destroyed since the deleters of the shared tables may run during
+  // static destruction.
+  static auto* kInstance = new HashTableCache();
+  return kInstance;
+}
+
+// static
+std::optional<std::string> HashTableCache::makeKey(
+    const core::HashJoinNode& joinNode,
+    const core::QueryConfig& config) {
+  auto key = config.hashTableCacheKey();
+  if (key.empty()) {
+    return std::nullopt;
+  }
+  // Right and full joins set probed flags in the table and null-aware joins
+  // finish the build early on null keys, so these can not share tables.
+  if (!joinNode.isInnerJoin() && !joinNode.isLeftJoin() &&
+      !joinNode.isLeftSemiFilterJoin() && !joinNode.isLeftSemiProjectJoin() &&
+      !joinNode.isAntiJoin()) {
+    return std::nullopt;
+  }
+  if (joinNode.isNullAware()) {
+    return std::nullopt;
+  }
+  // The join node decides the layout of the table and the build side sub-tree
+  // decides its content, except for the splits which 'key' must identify.
+  return fmt::format(
+      "{}\n{}\n{}",
+      key,
+      joinNode.toString(true, false),
+      joinNode.sources()[1]->toString(true, true));
+}
+
+HashTableCache::Lookup HashTableCache::lookup(
+    const std::string& key,
+    const std::string& taskId,
+    ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& entry = entries_[key];
+  if (auto table = entry.table.lock()) {
+    return {std::move(table), entry.hasNullKeys, nullptr};
+  }
+  if (entry.builderTaskId.empty()) {
+    entry.builderTaskId = taskId;
+    entry.pool = memory::addDefaultLeafMemoryPool(
+        fmt::format("_sys.hashTableCache.{}", numPools_++));
+  }
+  if (entry.builderTaskId == taskId) {
+    // All the build drivers of the builder task add to the same table.
+    return {nullptr, false, entry.pool};
+  }
+  auto [promise, semiFuture] = makeVeloxContinuePromiseContract(
+      fmt::format("HashTableCache::lookup {}", taskId));
+  entry.promises.push_back(std::move(promise));
+  *future = std::move(semiFuture);
+  return {};
+}
+
+std::shared_ptr<BaseHashTable> HashTableCache::put(
+    const std::string& key,
+    const std::string& taskId,
+    std::unique_ptr<BaseHashTable> table,
+    std::shared_ptr<memory::MemoryPool> pool,
+    bool hasNullKeys) {
+  VELOX_CHECK_NOT_NULL(table);
+  std::shared_ptr<BaseHashTable> sharedTable(
+      table.release(), [this, key, pool](BaseHashTable* table) {
+        delete table;
+        release(key);
+      });
+
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end() || it->second.builderTaskId != taskId) {
+      return sharedTable;
+    }
+    auto& entry = it->second;
+    entry.table = sharedTable;
+    entry.hasNullKeys = hasNullKeys;
+    entry.builderTaskId.clear();
+    entry.pool.reset();
+    promises = std::move(entry.promises);
+  }
+  notify(std::move(promises));
+  return sharedTable;
+}
+
+void HashTableCache::abandon(
+    const std::string& key,
+    const std::string& taskId) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end() || it->second.builderTaskId != taskId) {
+      return;
+    }
+    promises = std::move(it->second.promises);
+    entries_.erase(it);
+  }
+  notify(std::move(promises));
+}
+
+size_t HashTableCache::numEntries() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return entries_.size();
+}
+
+void HashTableCache::release(const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end() && it->second.table.expired() &&
+      it->second.builderTaskId.empty()) {
+    entries_.erase(it);
+  }
+}
+
+} // namespace facebook::velox::exec
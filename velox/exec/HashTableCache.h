@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/future/VeloxPromise.h"
+#include "velox/core/PlanNode.h"
+#include "velox/core/QueryConfig.h"
+#include "velox/exec/HashTable.h"
+
+namespace facebook::velox::exec {
+
+/// Worker level cache of hash join tables that lets tasks with identical build
+/// side input share one table, e.g. broadcast joins of many concurrent queries
+/// on the same dimension table. The first task to look up a key builds the
+/// table and the other tasks wait for it and then probe it read-only.
+///
+/// The cache holds the tables by weak reference, so a table is freed when the
+/// last task that uses it releases it. The memory of a table is allocated
+/// from a leaf pool owned by the table instead of a query pool since the table
+/// can outlive the task that built it.
+class HashTableCache {
+ public:
+  static HashTableCache* getInstance();
+
+  /// Returns the cache key for the table built by 'joinNode' or std::nullopt if
+  /// the table can not be shared. Sharing is enabled by
+  /// QueryConfig::kHashTableCacheKey and applies only to joins that do not
+  /// modify the table while probing and do not finish early on null keys.
+  static std::optional<std::string> makeKey(
+      const core::HashJoinNode& joinNode,
+      const core::QueryConfig& config);
+
+  struct Lookup {
+    /// The built table or nullptr if the table has yet to be built.
+    std::shared_ptr<BaseHashTable> table;
+
+    /// True if the build side of 'table' has nulls in join keys.
+    bool hasNullKeys{false};
+
+    /// Set if the table has yet to be built by the task of the caller. The
+    /// table must be allocated from 'pool' and be handed to put(). The task
+    /// must call abandon() if it does not finish the table.
+    std::shared_ptr<memory::MemoryPool> pool;
+  };
+
+  /// Looks up the table for 'key' on behalf of 'taskId'. If another task is
+  /// building the table, returns an empty Lookup and sets 'future' to wait for
+  /// the build to finish or be abandoned.
+  Lookup lookup(
+      const std::string& key,
+      const std::string& taskId,
+      ContinueFuture* future);
+
+  /// Caches 'table' built by 'taskId' from the pool returned by lookup() and
+  /// returns it as a shared table. The table is not cached if 'taskId' is no
+  /// longer the builder of 'key' after abandoning it.
+  std::shared_ptr<BaseHashTable> put(
+      const std::string& key,
+      const std::string& taskId,
+      std::unique_ptr<BaseHashTable> table,
+      std::shared_ptr<memory::MemoryPool> pool,
+      bool hasNullKeys);
+
+  /// Gives up building the table for 'key' by 'taskId', e.g. because the task
+  /// failed. Wakes up the waiting tasks so that one of them builds the table.
+  /// Does nothing if 'taskId' is not the builder of 'key'.
+  void abandon(const std::string& key, const std::string& taskId);
+
+  /// Returns the number of keys with a table that is built or being built.
+  size_t numEntries() const;
+
+ private:
+  struct Entry {
+    std::weak_ptr<BaseHashTable> table;
+    bool hasNullKeys{false};
+    // The task that builds the table. Empty once the table is built.
+    std::string builderTaskId;
+    std::shared_ptr<memory::MemoryPool> pool;
+    // Tasks waiting for 'builderTaskId' to build the table.
+    std::vector<ContinuePromise> promises;
+  };
+
+  // Removes the entry for 'key' if its table has been freed and no task
+  // rebuilds it.
+  void release(const std::string& key);
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, Entry> entries_;
+  uint64_t numPools_{0};
+};
+
+} // namespace facebook::velox::exec
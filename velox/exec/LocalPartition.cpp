@@ -251,7 +251,8 @@ LocalPartition::LocalPartition(
       partitionFunction_(
           numPartitions_ == 1
               ? nullptr
-              : planNode->partitionFunctionSpec().create(numPartitions_)) {
+              : planNode->partitionFunctionSpec().create(numPartitions_)),
+      sortByPartition_(ctx->queryConfig().localPartitionSortByPartition()) {
   VELOX_CHECK(numPartitions_ == 1 || partitionFunction_ != nullptr);
 
   for (auto& queue : queues_) {
@@ -308,25 +309,19 @@ void LocalPartition::addInput(RowVectorPtr input) {
   }
 
   if (numPartitions_ == 1) {
-    ContinueFuture future;
-    auto blockingReason = queues_[0]->enqueue(input, &future);
-    if (blockingReason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(blockingReason);
-      futures_.push_back(std::move(future));
-    }
+    enqueue(0, std::move(input));
     return;
   }
 
   const auto singlePartition =
       partitionFunction_->partition(*input, partitions_);
   if (singlePartition.has_value()) {
-    ContinueFuture future;
-    auto blockingReason =
-        queues_[singlePartition.value()]->enqueue(input, &future);
-    if (blockingReason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(blockingReason);
-      futures_.push_back(std::move(future));
-    }
+    enqueue(singlePartition.value(), std::move(input));
+    return;
+  }
+
+  if (sortByPartition_) {
+    enqueueSortedByPartition(input);
     return;
   }
 
@@ -348,15 +343,71 @@ void LocalPartition::addInput(RowVectorPtr input) {
       continue;
     }
     indexBuffers[i]->setSize(partitionSize * sizeof(vector_size_t));
-    auto partitionData =
-        wrapChildren(input, partitionSize, std::move(indexBuffers[i]));
-
-    ContinueFuture future;
-    auto reason = queues_[i]->enqueue(partitionData, &future);
-    if (reason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(reason);
-      futures_.push_back(std::move(future));
+    enqueue(
+        i, wrapChildren(input, partitionSize, std::move(indexBuffers[i])));
+  }
+}
+
+void LocalPartition::enqueue(uint32_t partition, RowVectorPtr data) {
+  ContinueFuture future;
+  auto reason = queues_[partition]->enqueue(std::move(data), &future);
+  if (reason != BlockingReason::kNotBlocked) {
+    blockingReasons_.push_back(reason);
+    futures_.push_back(std::move(future));
+  }
+}
+
+void LocalPartition::enqueueSortedByPartition(const RowVectorPtr& input) {
+  const auto numInput = input->size();
+
+  // Count the rows of each partition and turn the counts into starts.
+  partitionStarts_.assign(numPartitions_ + 1, 0);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    ++partitionStarts_[partitions_[i] + 1];
+  }
+  for (auto i = 0; i < numPartitions_; ++i) {
+    partitionStarts_[i + 1] += partitionStarts_[i];
+  }
+
+  // Scatter the row numbers into their partition's run.
+  partitionEnds_.assign(partitionStarts_.begin(), partitionStarts_.end() - 1);
+  sortedRows_.resize(numInput);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    sortedRows_[partitionEnds_[partitions_[i]]++] = i;
+  }
+
+  // Copy the columns in partition order. The partitions then share the
+  // buffers of the copy through slices.
+  rows_.resize(numInput);
+  rows_.setAll();
+  std::vector<VectorPtr> sortedColumns;
+  sortedColumns.reserve(input->childrenSize());
+  for (const auto& column : input->children()) {
+    auto sortedColumn = BaseVector::create(column->type(), numInput, pool());
+    sortedColumn->copy(column.get(), rows_, sortedRows_.data());
+    sortedColumns.push_back(std::move(sortedColumn));
+  }
+
+  for (auto i = 0; i < numPartitions_; ++i) {
+    const auto start = partitionStarts_[i];
+    const auto size = partitionStarts_[i + 1] - start;
+    if (size == 0) {
+      // Do not enqueue empty partitions.
+      continue;
+    }
+    std::vector<VectorPtr> slices;
+    slices.reserve(sortedColumns.size());
+    for (const auto& column : sortedColumns) {
+      slices.push_back(column->slice(start, size));
     }
+    enqueue(
+        i,
+        std::make_shared<RowVector>(
+            input->pool(),
+            input->type(),
+            BufferPtr(nullptr),
+            size,
+            std::move(slices)));
   }
 }
 
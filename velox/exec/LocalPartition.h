@@ -172,15 +172,31 @@ class LocalPartition : public Operator {
   bool isFinished() override;
 
  private:
+  void enqueue(uint32_t partition, RowVectorPtr data);
+
+  // Copies 'input' in partition order and enqueues a slice of the copy for
+  // each partition.
+  void enqueueSortedByPartition(const RowVectorPtr& input);
+
   const std::vector<std::shared_ptr<LocalExchangeQueue>> queues_;
   const size_t numPartitions_;
   std::unique_ptr<core::PartitionFunction> partitionFunction_;
 
+  // If true, partitions receive contiguous slices of a reordered copy of the
+  // input. See QueryConfig::kLocalPartitionSortByPartition.
+  const bool sortByPartition_;
+
   std::vector<BlockingReason> blockingReasons_;
   std::vector<ContinueFuture> futures_;
 
   /// Reusable memory for hash calculation.
   std::vector<uint32_t> partitions_;
+
+  // Reusable memory for enqueueSortedByPartition().
+  std::vector<vector_size_t> partitionStarts_;
+  std::vector<vector_size_t> partitionEnds_;
+  std::vector<vector_size_t> sortedRows_;
+  SelectivityVector rows_;
 };
 
 } // namespace facebook::velox::exec
@@ -190,9 +190,15 @@ uint32_t maxDrivers(
       if (!values->isParallelizable()) {
         return 1;
       }
-    } else if (std::dynamic_pointer_cast<const core::ArrowStreamNode>(node)) {
-      // ArrowStream node must run single-threaded.
-      return 1;
+    } else if (
+        auto arrowStream =
+            std::dynamic_pointer_cast<const core::ArrowStreamNode>(node)) {
+      // Each stream is read by a single driver.
+      const uint32_t numStreams = arrowStream->arrowStreams().size();
+      if (numStreams == 1) {
+        return 1;
+      }
+      count = std::min(numStreams, count);
     } else if (
         auto limit = std::dynamic_pointer_cast<const core::LimitNode>(node)) {
       // final limit must run single-threaded
@@ -232,6 +238,10 @@ uint32_t maxDrivers(
       } else {
         if (tableWrite->hasPartitioningScheme()) {
           return queryConfig.taskPartitionedWriterCount();
+        } else if (connectorInsertHandle->requiresPartitioningScheme()) {
+          // Writers without a disjoint set of partitions would write the same
+          // files.
+          return 1;
         } else {
           return queryConfig.taskWriterCount();
         }
@@ -253,6 +263,69 @@ uint32_t maxDrivers(
   }
   return count;
 }
+
+// Returns the columns the output of 'node' is clustered on within a driver.
+// Follows filters and projections down to a table scan.
+std::vector<std::string> clusteringKeys(const core::PlanNodePtr& node) {
+  if (auto tableScan =
+          std::dynamic_pointer_cast<const core::TableScanNode>(node)) {
+    return tableScan->clusteringKeys();
+  }
+  if (std::dynamic_pointer_cast<const core::FilterNode>(node)) {
+    return clusteringKeys(node->sources()[0]);
+  }
+  auto project = std::dynamic_pointer_cast<const core::ProjectNode>(node);
+  if (!project) {
+    return {};
+  }
+  std::vector<std::string> keys;
+  for (const auto& key : clusteringKeys(node->sources()[0])) {
+    std::optional<std::string> output;
+    for (auto i = 0; i < project->projections().size(); ++i) {
+      auto field = std::dynamic_pointer_cast<const core::FieldAccessTypedExpr>(
+          project->projections()[i]);
+      if (field && field->isInputColumn() && field->name() == key) {
+        output = project->names()[i];
+        break;
+      }
+    }
+    if (!output.has_value()) {
+      break;
+    }
+    keys.push_back(std::move(output.value()));
+  }
+  return keys;
+}
+
+// Returns true if the raw input of 'aggregationNode' is clustered on its
+// grouping keys, so that StreamingAggregation can be used instead of
+// HashAggregation even though the keys are not marked as pre-grouped.
+bool isClusteredAggregation(const core::AggregationNode& aggregationNode) {
+  const auto& groupingKeys = aggregationNode.groupingKeys();
+  if (groupingKeys.empty() || aggregationNode.ignoreNullKeys() ||
+      !isRawInput(aggregationNode.step())) {
+    return false;
+  }
+  for (const auto& aggregate : aggregationNode.aggregates()) {
+    if (aggregate.distinct || !aggregate.sortingKeys.empty()) {
+      return false;
+    }
+  }
+  // The grouping keys must be a permutation of a prefix of the clustering
+  // keys.
+  const auto keys = clusteringKeys(aggregationNode.sources()[0]);
+  if (keys.size() < groupingKeys.size()) {
+    return false;
+  }
+  const std::unordered_set<std::string> prefix(
+      keys.begin(), keys.begin() + groupingKeys.size());
+  for (const auto& key : groupingKeys) {
+    if (prefix.count(key->name()) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
 } // namespace detail
 
 // static
@@ -421,8 +494,8 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto arrowStreamNode =
             std::dynamic_pointer_cast<const core::ArrowStreamNode>(planNode)) {
-      operators.push_back(
-          std::make_unique<ArrowStream>(id, ctx.get(), arrowStreamNode));
+      operators.push_back(std::make_unique<ArrowStream>(
+          id, ctx.get(), arrowStreamNode, numDrivers(ctx->pipelineId)));
     } else if (
         auto tableScanNode =
             std::dynamic_pointer_cast<const core::TableScanNode>(planNode)) {
@@ -471,9 +544,10 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto aggregationNode =
             std::dynamic_pointer_cast<const core::AggregationNode>(planNode)) {
-      if (!aggregationNode->preGroupedKeys().empty() &&
-          aggregationNode->preGroupedKeys().size() ==
-              aggregationNode->groupingKeys().size()) {
+      if ((!aggregationNode->preGroupedKeys().empty() &&
+           aggregationNode->preGroupedKeys().size() ==
+               aggregationNode->groupingKeys().size()) ||
+          detail::isClusteredAggregation(*aggregationNode)) {
         operators.push_back(std::make_unique<StreamingAggregation>(
             id, ctx.get(), aggregationNode));
       } else {
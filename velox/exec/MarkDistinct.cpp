@@ -15,12 +15,9 @@
  */
 
 #include "velox/exec/MarkDistinct.h"
-#include "velox/common/base/Range.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/vector/FlatVector.h"
 
-#include <algorithm>
-#include <utility>
-
 namespace facebook::velox::exec {
 
 MarkDistinct::MarkDistinct(
@@ -32,30 +29,107 @@ MarkDistinct::MarkDistinct(
           planNode->outputType(),
           operatorId,
           planNode->id(),
-          "MarkDistinct") {
-  const auto& inputType = planNode->sources()[0]->outputType();
-
+          "MarkDistinct",
+          planNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
+      inputType_(planNode->sources()[0]->outputType()) {
   // Set all input columns as identity projection.
-  for (auto i = 0; i < inputType->size(); ++i) {
+  for (auto i = 0; i < inputType_->size(); ++i) {
     identityProjections_.emplace_back(i, i);
   }
 
   // We will use result[0] for distinct mask output.
-  resultProjections_.emplace_back(0, inputType->size());
+  resultProjections_.emplace_back(0, inputType_->size());
 
-  groupingSet_ = GroupingSet::createForMarkDistinct(
-      inputType,
-      createVectorHashers(inputType, planNode->distinctKeys()),
-      operatorCtx_.get(),
-      &nonReclaimableSection_);
+  table_ = HashTable<false>::createForAggregation(
+      createVectorHashers(inputType_, planNode->distinctKeys(), pool()),
+      std::vector<Accumulator>{},
+      pool());
+  lookup_ = std::make_unique<HashLookup>(table_->hashers());
 
   results_.resize(1);
 }
 
 void MarkDistinct::addInput(RowVectorPtr input) {
-  groupingSet_->addInput(input, false /*mayPushdown*/);
+  ensureInputFits(input);
+
+  if (inputSpiller_ != nullptr) {
+    spillInput(input, pool());
+    return;
+  }
 
   input_ = std::move(input);
+  addInputToTable();
+}
+
+void MarkDistinct::addInputToTable() {
+  SelectivityVector rows(input_->size());
+  table_->prepareForProbe(*lookup_, input_, rows, false);
+  table_->groupProbe(*lookup_);
+}
+
+void MarkDistinct::noMoreInput() {
+  Operator::noMoreInput();
+
+  if (inputSpiller_ != nullptr) {
+    inputSpiller_->finishSpill(spillInputPartitionSet_);
+
+    recordSpillStats(hashTableSpiller_->stats());
+    recordSpillStats(inputSpiller_->stats());
+
+    // Remove empty partitions.
+    auto it = spillInputPartitionSet_.begin();
+    while (it != spillInputPartitionSet_.end()) {
+      if (it->second->numFiles() > 0) {
+        ++it;
+      } else {
+        it = spillInputPartitionSet_.erase(it);
+      }
+    }
+
+    restoreNextSpillPartition();
+  }
+}
+
+void MarkDistinct::restoreNextSpillPartition() {
+  if (spillInputPartitionSet_.empty()) {
+    return;
+  }
+
+  auto it = spillInputPartitionSet_.begin();
+  spillInputReader_ = it->second->createReader();
+
+  // Find matching partition for the hash table.
+  auto hashTableIt = spillHashTablePartitionSet_.find(it->first);
+  if (hashTableIt != spillHashTablePartitionSet_.end()) {
+    auto spillHashTableReader = hashTableIt->second->createReader();
+
+    RowVectorPtr data;
+    while (spillHashTableReader->nextBatch(data)) {
+      // 'data' contains the distinct keys. Transform 'data' to match
+      // 'inputType_' so it can be added to the 'table_'. Move the key columns
+      // and leave other columns unset.
+      std::vector<VectorPtr> columns(inputType_->size());
+
+      const auto& hashers = table_->hashers();
+      for (auto i = 0; i < hashers.size(); ++i) {
+        columns[hashers[i]->channel()] = data->childAt(i);
+      }
+
+      auto input = std::make_shared<RowVector>(
+          pool(), inputType_, nullptr, data->size(), std::move(columns));
+
+      SelectivityVector rows(input->size());
+      table_->prepareForProbe(*lookup_, input, rows, false);
+      table_->groupProbe(*lookup_);
+    }
+  }
+
+  spillInputPartitionSet_.erase(it);
+
+  spillInputReader_->nextBatch(input_);
+  addInputToTable();
 }
 
 RowVectorPtr MarkDistinct::getOutput() {
@@ -79,19 +153,239 @@ RowVectorPtr MarkDistinct::getOutput() {
       results_[0]->as<FlatVector<bool>>()->mutableRawValues<uint64_t>();
 
   bits::fillBits(resultBits, 0, outputSize, false);
-  for (const auto i : groupingSet_->hashLookup().newGroups) {
+  for (const auto i : lookup_->newGroups) {
     bits::setBit(resultBits, i, true);
   }
   auto output = fillOutput(outputSize, nullptr);
 
-  // Drop reference to input_ to make it singly-referenced at the producer and
-  // allow for memory reuse.
-  input_ = nullptr;
+  if (spillInputReader_ != nullptr) {
+    if (spillInputReader_->nextBatch(input_)) {
+      addInputToTable();
+    } else {
+      input_ = nullptr;
+      spillInputReader_ = nullptr;
+      // The next partition has no keys in common with this one.
+      table_->clear();
+      restoreNextSpillPartition();
+    }
+  } else {
+    // Drop reference to input_ to make it singly-referenced at the producer
+    // and allow for memory reuse.
+    input_ = nullptr;
+  }
 
   return output;
 }
 
 bool MarkDistinct::isFinished() {
-  return noMoreInput_ && !input_;
+  return noMoreInput_ && !input_ && spillInputReader_ == nullptr;
 }
+
+void MarkDistinct::ensureInputFits(const RowVectorPtr& input) {
+  if (!spillEnabled() || inputSpiller_ != nullptr) {
+    // Spilling is disabled or the input is already spilled.
+    return;
+  }
+
+  const auto numDistinct = table_->numDistinct();
+  if (numDistinct == 0) {
+    // Table is empty. Nothing to spill.
+    return;
+  }
+
+  auto* rows = table_->rows();
+  auto [freeRows, outOfLineFreeBytes] = rows->freeSpace();
+  const auto outOfLineBytes =
+      rows->stringAllocator().retainedSize() - outOfLineFreeBytes;
+  const auto outOfLineBytesPerRow = outOfLineBytes / numDistinct;
+
+  // Test-only spill path.
+  if (spillConfig_->testSpillPct > 0) {
+    spill();
+    return;
+  }
+
+  const auto currentUsage = pool()->currentBytes();
+  const auto minReservationBytes =
+      currentUsage * spillConfig_->minSpillableReservationPct / 100;
+  const auto availableReservationBytes = pool()->availableReservation();
+  const auto tableIncrementBytes = table_->hashTableSizeIncrease(input->size());
+  const auto incrementBytes =
+      rows->sizeIncrement(input->size(), outOfLineBytesPerRow * input->size()) +
+      tableIncrementBytes;
+
+  // First to check if we have sufficient minimal memory reservation.
+  if (availableReservationBytes >= minReservationBytes) {
+    if ((tableIncrementBytes == 0) && (freeRows > input->size()) &&
+        (outOfLineBytes == 0 ||
+         outOfLineFreeBytes >= outOfLineBytesPerRow * input->size())) {
+      // Enough free rows for input rows and enough variable length free space.
+      return;
+    }
+  }
+
+  // Check if we can increase reservation. The increment is the largest of twice
+  // the maximum increment from this input and 'spillableReservationGrowthPct_'
+  // of the current memory usage.
+  const auto targetIncrementBytes = std::max<int64_t>(
+      incrementBytes * 2,
+      currentUsage * spillConfig_->spillableReservationGrowthPct / 100);
+  {
+    Operator::ReclaimableSectionGuard guard(this);
+    if (pool()->maybeReserve(targetIncrementBytes)) {
+      return;
+    }
+  }
+
+  spill();
+}
+
+void MarkDistinct::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& stats) {
+  if (table_->numDistinct() == 0) {
+    // Nothing to spill.
+    return;
+  }
+
+  if (hashTableSpiller_) {
+    // Already spilled.
+    return;
+  }
+
+  if (nonReclaimableSection_) {
+    ++stats.numNonReclaimableAttempts;
+    return;
+  }
+
+  spill();
+}
+
+void MarkDistinct::setupHashTableSpiller() {
+  const auto& spillConfig = spillConfig_.value();
+  HashBitRange hashBits(
+      spillConfig.startPartitionBit,
+      spillConfig.startPartitionBit + spillConfig.joinPartitionBits);
+
+  auto columnTypes = table_->rows()->columnTypes();
+  auto tableType = ROW(std::move(columnTypes));
+
+  hashTableSpiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kHashJoinBuild,
+      table_->rows(),
+      [&](folly::Range<char**> /*rows*/) {
+        // Do nothing. We spill hash table in full and clear it all at once.
+      },
+      tableType,
+      std::move(hashBits),
+      tableType->size(),
+      std::vector<CompareFlags>(),
+      spillConfig.filePath,
+      spillConfig.maxFileSize,
+      spillConfig.writeBufferSize,
+      spillConfig.minSpillRunSize,
+      spillConfig.compressionKind,
+      memory::spillMemoryPool(),
+      spillConfig.executor,
+      spillConfig.overflowTier,
+      spillConfig.fileFormat);
+}
+
+void MarkDistinct::setupInputSpiller() {
+  const auto& spillConfig = spillConfig_.value();
+  const auto& hashBits = hashTableSpiller_->hashBits();
+
+  inputSpiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kHashJoinProbe,
+      inputType_,
+      hashBits,
+      spillConfig.filePath,
+      spillConfig.maxFileSize,
+      spillConfig.writeBufferSize,
+      spillConfig.minSpillRunSize,
+      spillConfig.compressionKind,
+      memory::spillMemoryPool(),
+      spillConfig.executor,
+      spillConfig.overflowTier,
+      spillConfig.fileFormat);
+
+  const auto& hashers = table_->hashers();
+
+  std::vector<column_index_t> keyChannels;
+  keyChannels.reserve(hashers.size());
+  for (const auto& hasher : hashers) {
+    keyChannels.push_back(hasher->channel());
+  }
+
+  spillHashFunction_ = std::make_unique<HashPartitionFunction>(
+      inputSpiller_->hashBits(), inputType_, keyChannels);
+}
+
+void MarkDistinct::spill() {
+  VELOX_CHECK(spillEnabled());
+  VELOX_CHECK_NULL(hashTableSpiller_);
+  VELOX_CHECK_NULL(inputSpiller_);
+
+  setupHashTableSpiller();
+  setupInputSpiller();
+
+  std::vector<Spiller::SpillableStats> spillableStats(
+      hashTableSpiller_->hashBits().numPartitions());
+  hashTableSpiller_->fillSpillRuns(spillableStats);
+  hashTableSpiller_->spill();
+  hashTableSpiller_->finishSpill(spillHashTablePartitionSet_);
+
+  table_->clear();
+  pool()->release();
+
+  inputSpiller_->setPartitionsSpilled(
+      hashTableSpiller_->state().spilledPartitionSet());
+
+  // 'input_' has been added to the table before the table was spilled, so it
+  // is marked as usual by the next getOutput().
+}
+
+void MarkDistinct::spillInput(
+    const RowVectorPtr& input,
+    memory::MemoryPool* pool) {
+  const auto numInput = input->size();
+
+  std::vector<uint32_t> spillPartitions(numInput);
+  const auto singlePartition =
+      spillHashFunction_->partition(*input, spillPartitions);
+
+  const auto numPartitions = spillHashFunction_->numPartitions();
+
+  std::vector<BufferPtr> partitionIndices(numPartitions);
+  std::vector<vector_size_t*> rawPartitionIndices(numPartitions);
+
+  for (auto i = 0; i < numPartitions; ++i) {
+    partitionIndices[i] = allocateIndices(numInput, pool);
+    rawPartitionIndices[i] = partitionIndices[i]->asMutable<vector_size_t>();
+  }
+
+  std::vector<vector_size_t> numSpillInputs(numPartitions, 0);
+
+  for (auto row = 0; row < numInput; ++row) {
+    const auto partition = singlePartition.has_value() ? singlePartition.value()
+                                                       : spillPartitions[row];
+    rawPartitionIndices[partition][numSpillInputs[partition]++] = row;
+  }
+
+  // Ensure vector are lazy loaded before spilling.
+  for (auto i = 0; i < input->childrenSize(); ++i) {
+    input->childAt(i)->loadedVector();
+  }
+
+  for (int32_t partition = 0; partition < numSpillInputs.size(); ++partition) {
+    const auto numInputs = numSpillInputs[partition];
+    if (numInputs == 0) {
+      continue;
+    }
+
+    inputSpiller_->spill(
+        partition, wrap(numInputs, partitionIndices[partition], input));
+  }
+}
+
 } // namespace facebook::velox::exec
@@ -16,11 +16,18 @@
 
 #pragma once
 
-#include "velox/exec/GroupingSet.h"
+#include "velox/exec/HashPartitionFunction.h"
+#include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
 
 namespace facebook::velox::exec {
 
+/// Adds a BOOLEAN column that is true for the first row of each distinct
+/// combination of the distinct keys. Under memory pressure spills the hash
+/// table of the distinct keys seen so far and all subsequent input, hash
+/// partitioned on the keys. The spilled partitions are processed one at a
+/// time after all input is received. The output order is then not the input
+/// order.
 class MarkDistinct : public Operator {
  public:
   MarkDistinct(
@@ -29,7 +36,7 @@ class MarkDistinct : public Operator {
       const std::shared_ptr<const core::MarkDistinctNode>& planNode);
 
   bool preservesOrder() const override {
-    return true;
+    return !spillConfig_.has_value();
   }
 
   bool needsInput() const override {
@@ -38,6 +45,8 @@ class MarkDistinct : public Operator {
 
   void addInput(RowVectorPtr input) override;
 
+  void noMoreInput() override;
+
   RowVectorPtr getOutput() override;
 
   BlockingReason isBlocked(ContinueFuture* /*future*/) override {
@@ -46,8 +55,52 @@ class MarkDistinct : public Operator {
 
   bool isFinished() override;
 
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
  private:
-  // TODO: Document spilling configuration in spilling.rst.
-  std::unique_ptr<GroupingSet> groupingSet_;
+  bool spillEnabled() const {
+    return spillConfig_.has_value();
+  }
+
+  // Probes 'input_' into 'table_'. The new groups in 'lookup_' are the rows
+  // to mark.
+  void addInputToTable();
+
+  void ensureInputFits(const RowVectorPtr& input);
+
+  void setupHashTableSpiller();
+
+  void setupInputSpiller();
+
+  void spill();
+
+  void spillInput(const RowVectorPtr& input, memory::MemoryPool* pool);
+
+  // Restores the hash table of the next spilled partition and starts reading
+  // its spilled input.
+  void restoreNextSpillPartition();
+
+  RowTypePtr inputType_;
+
+  // Distinct keys seen so far.
+  std::unique_ptr<BaseHashTable> table_;
+  std::unique_ptr<HashLookup> lookup_;
+
+  // Spiller for contents of the HashTable.
+  std::unique_ptr<Spiller> hashTableSpiller_;
+
+  SpillPartitionSet spillHashTablePartitionSet_;
+
+  // Spiller for input received after spilling has been triggered.
+  std::unique_ptr<Spiller> inputSpiller_;
+
+  // Used to restore previously spilled input.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
+
+  SpillPartitionSet spillInputPartitionSet_;
+
+  // Used to calculate the spill partition numbers of the inputs.
+  std::unique_ptr<HashPartitionFunction> spillHashFunction_;
 };
 } // namespace facebook::velox::exec
@@ -24,6 +24,23 @@ std::unique_ptr<memory::MemoryReclaimer> MemoryReclaimer::create() {
   return std::unique_ptr<memory::MemoryReclaimer>(new MemoryReclaimer());
 }
 
+std::unique_ptr<memory::MemoryReclaimer> MemoryReclaimer::create(
+    int32_t priority) {
+  return std::unique_ptr<memory::MemoryReclaimer>(
+      new MemoryReclaimer(priority));
+}
+
+MemoryReclaimer::MemoryReclaimer(int32_t priority) : priority_(priority) {}
+
+void MemoryReclaimer::reclaimCost(
+    const memory::MemoryPool& pool,
+    memory::MemoryReclaimer::ReclaimCost& cost) const {
+  memory::MemoryReclaimer::reclaimCost(pool, cost);
+  cost.priority = priority_;
+  const auto nowMs = getCurrentTimeMs();
+  cost.elapsedTimeMs = nowMs > startTimeMs_ ? nowMs - startTimeMs_ : 0;
+}
+
 void MemoryReclaimer::enterArbitration() {
   DriverThreadContext* driverThreadCtx = driverThreadContext();
   if (FOLLY_UNLIKELY(driverThreadCtx == nullptr)) {
@@ -19,6 +19,7 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/MemoryArbitrator.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::exec {
 /// Provides the default memory reclaimer implementation for velox task
@@ -29,15 +30,30 @@ class MemoryReclaimer : public memory::MemoryReclaimer {
 
   static std::unique_ptr<memory::MemoryReclaimer> create();
 
+  /// Creates a reclaimer for the root memory pool of a query with 'priority'.
+  /// The memory arbitrator reclaims from queries with lower priority first.
+  /// The time the query has been running is measured from the creation.
+  static std::unique_ptr<memory::MemoryReclaimer> create(int32_t priority);
+
   void enterArbitration() override;
 
   void leaveArbitration() noexcept override;
 
+  void reclaimCost(
+      const memory::MemoryPool& pool,
+      memory::MemoryReclaimer::ReclaimCost& cost) const override;
+
   void abort(memory::MemoryPool* pool, const std::exception_ptr& error)
       override;
 
  protected:
   MemoryReclaimer() = default;
+
+  explicit MemoryReclaimer(int32_t priority);
+
+ private:
+  const int32_t priority_{0};
+  const size_t startTimeMs_{getCurrentTimeMs()};
 };
 
 /// Callback used by memory arbitration to check if a driver thread under memory
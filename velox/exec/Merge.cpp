@@ -305,7 +305,10 @@ MergeExchange::MergeExchange(
           mergeExchangeNode->sortingKeys(),
           mergeExchangeNode->sortingOrders(),
           mergeExchangeNode->id(),
-          "MergeExchange") {}
+          "MergeExchange") {
+  serdeOptions_.compressionKind = common::stringToCompressionKind(
+      driverCtx->queryConfig().exchangeCompressionKind());
+}
 
 BlockingReason MergeExchange::addMergeSources(ContinueFuture* future) {
   if (operatorCtx_->driverCtx()->driverId != 0) {
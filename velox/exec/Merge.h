@@ -191,10 +191,17 @@ class MergeExchange : public Merge {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::MergeExchangeNode>& orderByNode);
 
+  /// Options for deserializing the pages received by the merge sources.
+  const serializer::presto::PrestoVectorSerde::PrestoOptions& serdeOptions()
+      const {
+    return serdeOptions_;
+  }
+
  protected:
   BlockingReason addMergeSources(ContinueFuture* future) override;
 
  private:
+  serializer::presto::PrestoVectorSerde::PrestoOptions serdeOptions_;
   bool noMoreSplits_ = false;
   size_t numSplits_{0}; // Number of splits we took to process so far.
 };
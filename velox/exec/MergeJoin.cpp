@@ -191,6 +191,65 @@ int32_t MergeJoin::compare(
   return 0;
 }
 
+// static
+bool MergeJoin::keysMayHaveNulls(
+    const RowVectorPtr& batch,
+    const std::vector<column_index_t>& keys) {
+  for (auto key : keys) {
+    if (batch->childAt(key)->mayHaveNulls()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// static
+template <typename TIsBefore>
+vector_size_t MergeJoin::gallop(
+    vector_size_t start,
+    vector_size_t end,
+    bool linear,
+    TIsBefore isBefore) {
+  if (linear) {
+    while (start < end && isBefore(start)) {
+      ++start;
+    }
+    return start;
+  }
+
+  if (start >= end || !isBefore(start)) {
+    return start;
+  }
+
+  // 'low' is known to be before, 'high' is known to be not before or 'end'.
+  vector_size_t low = start;
+  vector_size_t step = 1;
+  vector_size_t high;
+  for (;;) {
+    if (end - low <= step) {
+      high = end;
+      break;
+    }
+    const auto probe = low + step;
+    if (!isBefore(probe)) {
+      high = probe;
+      break;
+    }
+    low = probe;
+    step *= 2;
+  }
+
+  while (high - low > 1) {
+    const auto middle = low + (high - low) / 2;
+    if (isBefore(middle)) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+  return high;
+}
+
 bool MergeJoin::findEndOfMatch(
     Match& match,
     const RowVectorPtr& input,
@@ -204,11 +263,12 @@ bool MergeJoin::findEndOfMatch(
 
   auto numInput = input->size();
 
-  vector_size_t endIndex = 0;
-  while (endIndex < numInput &&
-         compare(keys, input, endIndex, keys, prevInput, prevIndex) == 0) {
-    ++endIndex;
-  }
+  // Rows equal to the match are contiguous even if other rows have null
+  // keys, so the end can always be found by galloping.
+  const auto endIndex =
+      gallop(0, numInput, false, [&](vector_size_t row) {
+        return compare(keys, input, row, keys, prevInput, prevIndex) == 0;
+      });
 
   if (endIndex == numInput) {
     // Inputs are kept past getting a new batch of inputs. LazyVectors
@@ -346,7 +406,83 @@ void MergeJoin::prepareOutput() {
   }
 }
 
+bool MergeJoin::addToOutputAsDictionary() {
+  if (output_ != nullptr || filter_ != nullptr ||
+      leftMatch_->inputs.size() != 1 || rightMatch_->inputs.size() != 1) {
+    return false;
+  }
+
+  const auto leftBegin = leftMatch_->startIndex;
+  const auto leftEnd = leftMatch_->endIndex;
+  const auto rightBegin = rightMatch_->startIndex;
+  const auto rightEnd = rightMatch_->endIndex;
+  auto leftIndex = leftMatch_->cursor ? leftMatch_->cursor->index : leftBegin;
+  auto rightIndex =
+      rightMatch_->cursor ? rightMatch_->cursor->index : rightBegin;
+
+  // Position of the next output row in the cross product and the size of the
+  // cross product.
+  const int64_t numRights = rightEnd - rightBegin;
+  const int64_t position =
+      (leftIndex - leftBegin) * numRights + (rightIndex - rightBegin);
+  const int64_t total = (leftEnd - leftBegin) * numRights;
+  if (total - position < outputBatchSize_) {
+    return false;
+  }
+
+  auto* pool = operatorCtx_->pool();
+  const vector_size_t size = outputBatchSize_;
+  auto leftIndices = allocateIndices(size, pool);
+  auto rightIndices = allocateIndices(size, pool);
+  auto* rawLeftIndices = leftIndices->asMutable<vector_size_t>();
+  auto* rawRightIndices = rightIndices->asMutable<vector_size_t>();
+  for (auto i = 0; i < size; ++i) {
+    rawLeftIndices[i] = leftIndex;
+    rawRightIndices[i] = rightIndex;
+    if (++rightIndex == rightEnd) {
+      rightIndex = rightBegin;
+      ++leftIndex;
+    }
+  }
+
+  std::vector<VectorPtr> localColumns(outputType_->size());
+  const auto& left = leftMatch_->inputs[0];
+  for (const auto& projection : leftProjections_) {
+    localColumns[projection.outputChannel] = BaseVector::wrapInDictionary(
+        nullptr,
+        leftIndices,
+        size,
+        BaseVector::loadedVectorShared(left->childAt(projection.inputChannel)));
+  }
+  const auto& right = rightMatch_->inputs[0];
+  for (const auto& projection : rightProjections_) {
+    localColumns[projection.outputChannel] = BaseVector::wrapInDictionary(
+        nullptr,
+        rightIndices,
+        size,
+        BaseVector::loadedVectorShared(
+            right->childAt(projection.inputChannel)));
+  }
+
+  output_ = std::make_shared<RowVector>(
+      pool, outputType_, nullptr, size, std::move(localColumns));
+  outputSize_ = size;
+
+  if (leftIndex == leftEnd) {
+    leftMatch_.reset();
+    rightMatch_.reset();
+  } else {
+    leftMatch_->setCursor(0, leftIndex);
+    rightMatch_->setCursor(0, rightIndex);
+  }
+  return true;
+}
+
 bool MergeJoin::addToOutput() {
+  if (addToOutputAsDictionary()) {
+    return true;
+  }
+
   prepareOutput();
 
   size_t firstLeftBatch;
@@ -592,7 +728,32 @@ RowVectorPtr MergeJoin::doGetOutput() {
   auto compareResult = compare();
 
   for (;;) {
-    // Catch up input_ with rightInput_.
+    // Catch up input_ with rightInput_. Rows without a match produce no output
+    // for inner joins and can be skipped by galloping. Null keys sort first
+    // and make the comparison non-monotonic, so batches with nulls are
+    // scanned row by row.
+    if (compareResult < 0 && !isLeftJoin(joinType_)) {
+      index_ = gallop(
+          index_ + 1,
+          input_->size(),
+          keysMayHaveNulls(input_, leftKeys_),
+          [&](vector_size_t row) {
+            return compare(
+                       leftKeys_,
+                       input_,
+                       row,
+                       rightKeys_,
+                       rightInput_,
+                       rightIndex_) < 0;
+          });
+      if (index_ == input_->size()) {
+        // Ran out of rows on the left side.
+        input_ = nullptr;
+        return nullptr;
+      }
+      compareResult = compare();
+    }
+
     while (compareResult < 0) {
       if (isLeftJoin(joinType_)) {
         prepareOutput();
@@ -614,6 +775,25 @@ RowVectorPtr MergeJoin::doGetOutput() {
     }
 
     // Catch up rightInput_ with input_.
+    if (compareResult > 0 && !keysMayHaveNulls(rightInput_, rightKeys_)) {
+      rightIndex_ = gallop(
+          rightIndex_ + 1, rightInput_->size(), false, [&](vector_size_t row) {
+            return compare(
+                       rightKeys_,
+                       rightInput_,
+                       row,
+                       leftKeys_,
+                       input_,
+                       index_) < 0;
+          });
+      if (rightIndex_ == rightInput_->size()) {
+        // Ran out of rows on the right side.
+        rightInput_ = nullptr;
+        return nullptr;
+      }
+      compareResult = compare();
+    }
+
     while (compareResult > 0) {
       rightIndex_ = firstNonNull(rightInput_, rightKeys_, rightIndex_ + 1);
       if (rightIndex_ == rightInput_->size()) {
@@ -627,10 +807,10 @@ RowVectorPtr MergeJoin::doGetOutput() {
     if (compareResult == 0) {
       // Found a match. Identify all rows on the left and right that have the
       // matching keys.
-      vector_size_t endIndex = index_ + 1;
-      while (endIndex < input_->size() && compareLeft(endIndex) == 0) {
-        ++endIndex;
-      }
+      const auto endIndex = gallop(
+          index_ + 1, input_->size(), false, [&](vector_size_t row) {
+            return compareLeft(row) == 0;
+          });
 
       if (endIndex == input_->size()) {
         // Matches continue in subsequent input. Load all lazies.
@@ -639,11 +819,10 @@ RowVectorPtr MergeJoin::doGetOutput() {
       leftMatch_ = Match{
           {input_}, index_, endIndex, endIndex < input_->size(), std::nullopt};
 
-      vector_size_t endRightIndex = rightIndex_ + 1;
-      while (endRightIndex < rightInput_->size() &&
-             compareRight(endRightIndex) == 0) {
-        ++endRightIndex;
-      }
+      const auto endRightIndex = gallop(
+          rightIndex_ + 1, rightInput_->size(), false, [&](vector_size_t row) {
+            return compareRight(row) == 0;
+          });
 
       rightMatch_ = Match{
           {rightInput_},
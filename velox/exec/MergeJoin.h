@@ -99,6 +99,23 @@ class MergeJoin : public Operator {
         rightKeys_, batch, index, rightKeys_, otherBatch, otherIndex);
   }
 
+  // Returns true if any of the 'keys' columns of 'batch' may have nulls.
+  static bool keysMayHaveNulls(
+      const RowVectorPtr& batch,
+      const std::vector<column_index_t>& keys);
+
+  // Returns the first row in [start, end) for which 'isBefore' returns false.
+  // 'isBefore' must be true for a prefix of the range and false for the rest.
+  // Probes rows at exponentially growing distances from 'start', then binary
+  // searches the last interval, so that long runs of rows are skipped in
+  // logarithmic time. Checks the rows one by one if 'linear' is true.
+  template <typename TIsBefore>
+  static vector_size_t gallop(
+      vector_size_t start,
+      vector_size_t end,
+      bool linear,
+      TIsBefore isBefore);
+
   /// Describes a contiguous set of rows on the left or right side of the join
   /// with all join keys being the same. The set of rows may span multiple
   /// batches of input.
@@ -164,13 +181,18 @@ class MergeJoin : public Operator {
   // rightMatchCursor_ if output_ filled up before all rows were added.
   bool addToOutput();
 
+  // Produces a full batch of output from the cross product of leftMatch_ and
+  // rightMatch_ by wrapping the input columns in dictionaries instead of
+  // copying rows. Applies only when there is no filter, output_ is empty, both
+  // matches are within a single input batch and at least a full batch of the
+  // cross product remains. Returns false if it does not apply. Otherwise sets
+  // output_ and updates the cursors or clears the matches like addToOutput().
+  bool addToOutputAsDictionary();
+
   // Adds one row of output by copying values from left and right batches at the
   // specified rows. Advances outputSize_. Assumes that output_ has room.
-  //
-  // TODO: Copying is inefficient especially for complex type values. Consider
-  // an optimization of using dictionary wrapping when full batch of output can
-  // be produced using single batch of input from the left side and single batch
-  // of input from the right side.
+  // Full batches of output from a single batch of input on each side are
+  // made with addToOutputAsDictionary() instead.
   void addOutputRow(
       const RowVectorPtr& left,
       vector_size_t leftIndex,
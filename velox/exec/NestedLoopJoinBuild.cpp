@@ -18,6 +18,145 @@
 
 namespace facebook::velox::exec {
 
+namespace {
+// A bound on a build side column by a probe side column.
+struct BandBound {
+  column_index_t buildChannel;
+  column_index_t probeChannel;
+  bool lower;
+  bool inclusive;
+};
+
+bool isBandType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void flattenConjuncts(
+    const core::TypedExprPtr& expr,
+    std::vector<const core::CallTypedExpr*>& conjuncts) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr) {
+    return;
+  }
+  if (call->name() == "and") {
+    for (const auto& input : call->inputs()) {
+      flattenConjuncts(input, conjuncts);
+    }
+    return;
+  }
+  conjuncts.push_back(call);
+}
+
+// Adds the bound for 'left <op> right', where 'op' is one of lt, lte, gt and
+// gte, if one side is a build side column and the other a probe side column.
+// Resolves names on the probe side first like the join condition does.
+void addBound(
+    const std::string& op,
+    const core::TypedExprPtr& left,
+    const core::TypedExprPtr& right,
+    const RowType& probeType,
+    const RowType& buildType,
+    std::vector<BandBound>& bounds) {
+  const auto* leftField =
+      dynamic_cast<const core::FieldAccessTypedExpr*>(left.get());
+  const auto* rightField =
+      dynamic_cast<const core::FieldAccessTypedExpr*>(right.get());
+  if (leftField == nullptr || rightField == nullptr ||
+      !leftField->isInputColumn() || !rightField->isInputColumn() ||
+      !isBandType(left->type()) || !left->type()->equivalent(*right->type())) {
+    return;
+  }
+
+  bool less = op == "lt" || op == "lte";
+  const bool inclusive = op == "lte" || op == "gte";
+  const auto leftProbe = probeType.getChildIdxIfExists(leftField->name());
+  const auto rightProbe = probeType.getChildIdxIfExists(rightField->name());
+  std::optional<column_index_t> buildChannel;
+  std::optional<column_index_t> probeChannel;
+  if (!leftProbe.has_value() && rightProbe.has_value()) {
+    buildChannel = buildType.getChildIdxIfExists(leftField->name());
+    probeChannel = rightProbe;
+  } else if (leftProbe.has_value() && !rightProbe.has_value()) {
+    // 'probe < build' is 'build > probe'.
+    buildChannel = buildType.getChildIdxIfExists(rightField->name());
+    probeChannel = leftProbe;
+    less = !less;
+  }
+  if (!buildChannel.has_value() || !probeChannel.has_value()) {
+    return;
+  }
+  // 'build < probe' bounds the build column from above.
+  bounds.push_back(
+      {buildChannel.value(), probeChannel.value(), !less, inclusive});
+}
+} // namespace
+
+// static
+std::optional<NestedLoopJoinBand> NestedLoopJoinBand::make(
+    const core::NestedLoopJoinNode& joinNode) {
+  if (joinNode.joinCondition() == nullptr) {
+    return std::nullopt;
+  }
+  const auto& probeType = joinNode.sources()[0]->outputType();
+  const auto& buildType = joinNode.sources()[1]->outputType();
+
+  std::vector<const core::CallTypedExpr*> conjuncts;
+  flattenConjuncts(joinNode.joinCondition(), conjuncts);
+  std::vector<BandBound> bounds;
+  for (const auto* conjunct : conjuncts) {
+    const auto& name = conjunct->name();
+    const auto& inputs = conjunct->inputs();
+    if ((name == "lt" || name == "lte" || name == "gt" || name == "gte") &&
+        inputs.size() == 2) {
+      addBound(name, inputs[0], inputs[1], *probeType, *buildType, bounds);
+    } else if (name == "between" && inputs.size() == 3) {
+      addBound("gte", inputs[0], inputs[1], *probeType, *buildType, bounds);
+      addBound("lte", inputs[0], inputs[2], *probeType, *buildType, bounds);
+    }
+  }
+  if (bounds.empty()) {
+    return std::nullopt;
+  }
+
+  // Prefers a build column that is bounded from both sides.
+  auto buildChannel = bounds[0].buildChannel;
+  for (const auto& bound : bounds) {
+    const bool bothSides =
+        std::any_of(bounds.begin(), bounds.end(), [&](const auto& other) {
+          return other.buildChannel == bound.buildChannel &&
+              other.lower != bound.lower;
+        });
+    if (bothSides) {
+      buildChannel = bound.buildChannel;
+      break;
+    }
+  }
+
+  NestedLoopJoinBand band{buildChannel};
+  for (const auto& bound : bounds) {
+    if (bound.buildChannel != buildChannel) {
+      continue;
+    }
+    if (bound.lower && !band.lowerChannel.has_value()) {
+      band.lowerChannel = bound.probeChannel;
+      band.lowerInclusive = bound.inclusive;
+    } else if (!bound.lower && !band.upperChannel.has_value()) {
+      band.upperChannel = bound.probeChannel;
+      band.upperInclusive = bound.inclusive;
+    }
+  }
+  return band;
+}
+
 void NestedLoopJoinBridge::setData(std::vector<RowVectorPtr> buildVectors) {
   std::vector<ContinuePromise> promises;
   {
@@ -50,7 +189,8 @@ NestedLoopJoinBuild::NestedLoopJoinBuild(
           nullptr,
           operatorId,
           joinNode->id(),
-          "NestedLoopJoinBuild") {}
+          "NestedLoopJoinBuild"),
+      band_{NestedLoopJoinBand::make(*joinNode)} {}
 
 void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
   if (input->size() > 0) {
@@ -105,12 +245,45 @@ void NestedLoopJoinBuild::noMoreInput() {
     }
   }
 
+  if (band_.has_value() && !dataVectors_.empty()) {
+    dataVectors_ = {sortByBand()};
+  }
+
   operatorCtx_->task()
       ->getNestedLoopJoinBridge(
           operatorCtx_->driverCtx()->splitGroupId, planNodeId())
       ->setData(std::move(dataVectors_));
 }
 
+RowVectorPtr NestedLoopJoinBuild::sortByBand() const {
+  vector_size_t numRows = 0;
+  for (const auto& vector : dataVectors_) {
+    numRows += vector->size();
+  }
+
+  auto* pool = operatorCtx_->pool();
+  const auto& type = dataVectors_[0]->type();
+  auto data = BaseVector::create(type, numRows, pool);
+  vector_size_t offset = 0;
+  for (const auto& vector : dataVectors_) {
+    data->copy(vector.get(), offset, 0, vector->size());
+    offset += vector->size();
+  }
+
+  const auto& band = data->as<RowVector>()->childAt(band_->buildChannel);
+  const CompareFlags flags{
+      false, true, false, CompareFlags::NullHandlingMode::NoStop};
+  std::vector<vector_size_t> order(numRows);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](auto left, auto right) {
+    return band->compare(band.get(), left, right, flags).value() < 0;
+  });
+
+  auto sorted = BaseVector::create(type, numRows, pool);
+  sorted->copy(data.get(), SelectivityVector(numRows), order.data());
+  return std::static_pointer_cast<RowVector>(sorted);
+}
+
 bool NestedLoopJoinBuild::isFinished() {
   return !future_.valid() && noMoreInput_;
 }
@@ -20,6 +20,32 @@
 
 namespace facebook::velox::exec {
 
+/// Describes a join condition that bounds one build side column, the band
+/// column, by probe side columns, e.g. 'u.start <= t.ts AND u.start > t.t0' or
+/// 't.ts BETWEEN u.start AND u.end'. Once the build side is sorted on the
+/// band column, the build rows that can match a probe row are a contiguous
+/// range that is found by binary search. The whole join condition is still
+/// evaluated on the rows in the range.
+struct NestedLoopJoinBand {
+  column_index_t buildChannel;
+
+  /// Probe side column that bounds the band column from below, i.e. the
+  /// condition has 'build > probe', or 'build >= probe' if 'lowerInclusive'.
+  std::optional<column_index_t> lowerChannel;
+  bool lowerInclusive{false};
+
+  /// Probe side column that bounds the band column from above, i.e. the
+  /// condition has 'build < probe', or 'build <= probe' if 'upperInclusive'.
+  std::optional<column_index_t> upperChannel;
+  bool upperInclusive{false};
+
+  /// Returns the band of the join condition of 'joinNode' or std::nullopt if
+  /// the condition is not a conjunction with comparisons between a build side
+  /// and a probe side column of the same integer, date or timestamp type.
+  static std::optional<NestedLoopJoinBand> make(
+      const core::NestedLoopJoinNode& joinNode);
+};
+
 class NestedLoopJoinBridge : public JoinBridge {
  public:
   void setData(std::vector<RowVectorPtr> buildVectors);
@@ -59,6 +85,12 @@ class NestedLoopJoinBuild : public Operator {
   }
 
  private:
+  // Returns the rows of 'dataVectors_' in a single vector sorted on the band
+  // column, with null band values last.
+  RowVectorPtr sortByBand() const;
+
+  const std::optional<NestedLoopJoinBand> band_;
+
   std::vector<RowVectorPtr> dataVectors_;
 
   // Future for synchronizing with other Drivers of the same pipeline. All build
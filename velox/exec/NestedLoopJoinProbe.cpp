@@ -55,7 +55,8 @@ NestedLoopJoinProbe::NestedLoopJoinProbe(
           joinNode->id(),
           "NestedLoopJoinProbe"),
       outputBatchSize_{outputBatchRows()},
-      joinType_(joinNode->joinType()) {
+      joinType_(joinNode->joinType()),
+      band_{NestedLoopJoinBand::make(*joinNode)} {
   auto probeType = joinNode->sources()[0]->outputType();
   auto buildType = joinNode->sources()[1]->outputType();
   identityProjections_ = extractProjections(probeType, outputType_);
@@ -96,6 +97,17 @@ BlockingReason NestedLoopJoinProbe::isBlocked(ContinueFuture* future) {
         }
       }
 
+      if (band_.has_value() && !buildSideEmpty_) {
+        VELOX_CHECK_EQ(buildVectors_->size(), 1);
+        // Null band values are sorted last and match no probe row.
+        const auto& build = buildVectors_.value()[0];
+        const auto& band = build->childAt(band_->buildChannel);
+        numBandRows_ = build->size();
+        while (numBandRows_ > 0 && band->isNullAt(numBandRows_ - 1)) {
+          --numBandRows_;
+        }
+      }
+
       setState(ProbeOperatorState::kRunning);
       return BlockingReason::kNotBlocked;
     }
@@ -170,6 +182,18 @@ RowVectorPtr NestedLoopJoinProbe::getOutput() {
       break;
     }
 
+    if (band_.has_value()) {
+      output = doBandMatch();
+      if (probeRow_ == input_->size()) {
+        probeRow_ = 0;
+        buildIndex_ = buildVectors_->size();
+        if (!needsProbeMismatch(joinType_)) {
+          finishProbeInput();
+        }
+      }
+      continue;
+    }
+
     const vector_size_t probeCnt = getNumProbeRows();
     output = doMatch(probeCnt);
     if (advanceProbeRows(probeCnt)) {
@@ -428,7 +452,11 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
       filterInputType_,
       filterProbeProjections_,
       filterBuildProjections_);
+  return evalJoinCondition(filterInput);
+}
 
+RowVectorPtr NestedLoopJoinProbe::evalJoinCondition(
+    const RowVectorPtr& filterInput) {
   if (filterInputRows_.size() != filterInput->size()) {
     filterInputRows_.resizeFill(filterInput->size(), true);
   }
@@ -495,4 +523,105 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
       std::move(projectedChildren));
 }
 
+std::pair<vector_size_t, vector_size_t> NestedLoopJoinProbe::getBandRange(
+    vector_size_t probeRow) const {
+  const auto& band =
+      buildVectors_.value()[buildIndex_]->childAt(band_->buildChannel);
+
+  // Returns the first row in [begin, end) for which 'isBefore' is false.
+  auto search = [](vector_size_t begin, vector_size_t end, auto isBefore) {
+    while (begin < end) {
+      const auto middle = begin + (end - begin) / 2;
+      if (isBefore(middle)) {
+        begin = middle + 1;
+      } else {
+        end = middle;
+      }
+    }
+    return begin;
+  };
+
+  vector_size_t begin = 0;
+  vector_size_t end = numBandRows_;
+  if (band_->lowerChannel.has_value()) {
+    const auto& lower = input_->childAt(band_->lowerChannel.value());
+    if (lower->isNullAt(probeRow)) {
+      return {0, 0};
+    }
+    const bool inclusive = band_->lowerInclusive;
+    begin = search(begin, end, [&](auto row) {
+      const auto result = band->compare(lower.get(), row, probeRow);
+      return inclusive ? result < 0 : result <= 0;
+    });
+  }
+  if (band_->upperChannel.has_value()) {
+    const auto& upper = input_->childAt(band_->upperChannel.value());
+    if (upper->isNullAt(probeRow)) {
+      return {0, 0};
+    }
+    const bool inclusive = band_->upperInclusive;
+    end = search(begin, end, [&](auto row) {
+      const auto result = band->compare(upper.get(), row, probeRow);
+      return inclusive ? result <= 0 : result < 0;
+    });
+  }
+  return {begin, end};
+}
+
+RowVectorPtr NestedLoopJoinProbe::doBandMatch() {
+  VELOX_CHECK_NOT_NULL(input_);
+  VELOX_CHECK(!hasProbedAllBuildData());
+
+  auto rawProbeIndices =
+      initializeRowNumberMapping(probeIndices_, outputBatchSize_, pool());
+  auto rawBuildIndices =
+      initializeRowNumberMapping(buildIndices_, outputBatchSize_, pool());
+  vector_size_t numCandidates = 0;
+  while (probeRow_ < input_->size() && numCandidates < outputBatchSize_) {
+    if (!bandRange_.has_value()) {
+      bandRange_ = getBandRange(probeRow_);
+    }
+    auto& [begin, end] = bandRange_.value();
+    const auto count = std::min<vector_size_t>(
+        end - begin, outputBatchSize_ - numCandidates);
+    std::fill(
+        rawProbeIndices.begin() + numCandidates,
+        rawProbeIndices.begin() + numCandidates + count,
+        probeRow_);
+    std::iota(
+        rawBuildIndices.begin() + numCandidates,
+        rawBuildIndices.begin() + numCandidates + count,
+        begin);
+    numCandidates += count;
+    begin += count;
+    if (begin == end) {
+      bandRange_.reset();
+      ++probeRow_;
+    }
+  }
+  if (numCandidates == 0) {
+    return nullptr;
+  }
+
+  std::vector<VectorPtr> projectedChildren(filterInputType_->size());
+  projectChildren(
+      projectedChildren,
+      input_,
+      filterProbeProjections_,
+      numCandidates,
+      probeIndices_);
+  projectChildren(
+      projectedChildren,
+      buildVectors_.value()[buildIndex_],
+      filterBuildProjections_,
+      numCandidates,
+      buildIndices_);
+  return evalJoinCondition(std::make_shared<RowVector>(
+      pool(),
+      filterInputType_,
+      nullptr,
+      numCandidates,
+      std::move(projectedChildren)));
+}
+
 } // namespace facebook::velox::exec
@@ -80,6 +80,23 @@ class NestedLoopJoinProbe : public Operator {
   // buildMatched_ accordingly.
   RowVectorPtr doMatch(vector_size_t probeCnt);
 
+  // Evaluates joinCondition against 'filterInput', whose rows are the pairs
+  // of rows of input_ and the build side vector at 'buildIndex_' given by
+  // 'probeIndices_' and 'buildIndices_'. Returns the rows that passed and
+  // updates probeMatched_, buildMatched_ accordingly.
+  RowVectorPtr evalJoinCondition(const RowVectorPtr& filterInput);
+
+  // Returns the range of rows of the band sorted build side that can match
+  // 'probeRow' of input_ on the band column.
+  std::pair<vector_size_t, vector_size_t> getBandRange(
+      vector_size_t probeRow) const;
+
+  // Matches rows of input_ starting at 'probeRow_' with the build rows in their
+  // band ranges until up to 'outputBatchSize_' pairs are collected. Evaluates
+  // joinCondition on the pairs and advances 'probeRow_' past the rows whose
+  // ranges have been matched completely.
+  RowVectorPtr doBandMatch();
+
   // Updates 'probeRow_' and 'buildIndex_' by advancing 'probeRow_' by probeCnt.
   // Returns true if 'buildIndex_' points to the end of 'buildData_'.
   bool advanceProbeRows(vector_size_t probeCnt);
@@ -122,6 +139,10 @@ class NestedLoopJoinProbe : public Operator {
   // Maximum number of rows in the output batch.
   const uint32_t outputBatchSize_;
   const core::JoinType joinType_;
+  // Set if the join condition bounds a build column by probe columns. Then
+  // NestedLoopJoinBuild produces a single build vector sorted on that column
+  // and each probe row is matched only with the build rows in its range.
+  const std::optional<NestedLoopJoinBand> band_;
 
   ProbeOperatorState state_{ProbeOperatorState::kWaitForBuild};
   ContinueFuture future_{ContinueFuture::makeEmpty()};
@@ -152,6 +173,12 @@ class NestedLoopJoinProbe : public Operator {
   size_t buildIndex_{0};
   std::vector<IdentityProjection> buildProjections_;
   BufferPtr buildIndices_;
+  // Number of leading rows of the band sorted build vector with non-null
+  // band values.
+  vector_size_t numBandRows_{0};
+  // Build rows in the band range of 'probeRow_' that are left to match if the
+  // range did not fit in the last output batch.
+  std::optional<std::pair<vector_size_t, vector_size_t>> bandRange_;
 
   // Represents whether probe build rows have been matched.
   std::vector<SelectivityVector> buildMatched_;
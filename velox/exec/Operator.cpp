@@ -40,7 +40,9 @@ OperatorCtx::OperatorCtx(
 core::ExecCtx* OperatorCtx::execCtx() const {
   if (!execCtx_) {
     execCtx_ = std::make_unique<core::ExecCtx>(
-        pool_, driverCtx_->task->queryCtx().get());
+        pool_,
+        driverCtx_->task->queryCtx().get(),
+        driverCtx_->vectorPool.get());
   }
   return execCtx_.get();
 }
@@ -268,6 +270,23 @@ uint32_t Operator::outputBatchRows(
       queryConfig.preferredOutputBatchBytes() / rowSize, 1);
 }
 
+uint32_t Operator::outputBatchRowsByBytes(
+    std::optional<uint64_t> averageRowSize) const {
+  const auto& queryConfig = operatorCtx_->task()->queryCtx()->queryConfig();
+  if (!queryConfig.outputBatchSizeByBytes()) {
+    return outputBatchRows();
+  }
+  return outputBatchRows(averageRowSize);
+}
+
+std::optional<uint64_t> Operator::averageInputRowSize() const {
+  auto lockedStats = stats_.rlock();
+  if (lockedStats->inputPositions == 0) {
+    return std::nullopt;
+  }
+  return lockedStats->inputBytes / lockedStats->inputPositions;
+}
+
 void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
   uint64_t now =
       std::chrono::duration_cast<std::chrono::microseconds>(
@@ -285,6 +304,72 @@ void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
       fmt::format("blocked{}Times", blockReason), RuntimeCounter(1));
 }
 
+bool Operator::reserveMemoryAsync(uint64_t bytes) {
+  VELOX_CHECK(
+      !memoryReservationFuture_.valid(),
+      "Memory reservation is already in progress: {}",
+      toString());
+  auto* const opPool = pool();
+  auto* const executor = operatorCtx_->task()->queryCtx()->executor();
+  Driver* const driver = operatorCtx_->driver();
+  // Reserves inline if there is nowhere to run the reservation or it won't
+  // need memory arbitration.
+  if (executor == nullptr || driver == nullptr ||
+      opPool->capacity() == memory::kMaxMemory ||
+      opPool->availableReservation() >= bytes || opPool->freeBytes() >= bytes) {
+    opPool->maybeReserve(bytes);
+    return true;
+  }
+
+  auto promiseAndFuture = makeVeloxContinuePromiseContract(
+      fmt::format("Operator::reserveMemoryAsync {}", toString()));
+  memoryReservationFuture_ = std::move(promiseAndFuture.second);
+  // NOTE: the driver reference keeps this operator alive until the
+  // reservation completes.
+  executor->add([this,
+                 bytes,
+                 driverRef = driver->shared_from_this(),
+                 promise = std::move(promiseAndFuture.first)]() mutable {
+    TestValue::adjust(
+        "facebook::velox::exec::Operator::reserveMemoryAsync", this);
+    try {
+      pool()->maybeReserve(bytes);
+    } catch (const std::exception&) {
+      memoryReservationError_ = std::current_exception();
+    }
+    promise.setValue();
+  });
+  return false;
+}
+
+std::optional<uint64_t> Operator::estimatedInputRows() const {
+  Driver* const driver = operatorCtx_->driver();
+  if (driver == nullptr) {
+    return std::nullopt;
+  }
+  const auto& task = operatorCtx_->task();
+  const auto numRows = task->inputRowsEstimate(planNodeId());
+  if (!numRows.has_value()) {
+    return std::nullopt;
+  }
+  return bits::divRoundUp(
+      numRows.value(), std::max<int32_t>(1, task->numDrivers(driver)));
+}
+
+BlockingReason Operator::isWaitingForMemory(ContinueFuture* future) {
+  if (FOLLY_UNLIKELY(memoryReservationFuture_.valid())) {
+    if (!memoryReservationFuture_.isReady()) {
+      *future = std::move(memoryReservationFuture_);
+      return BlockingReason::kWaitForMemory;
+    }
+    memoryReservationFuture_ = ContinueFuture::makeEmpty();
+  }
+  if (FOLLY_UNLIKELY(memoryReservationError_ != nullptr)) {
+    std::rethrow_exception(std::exchange(memoryReservationError_, nullptr));
+  }
+  return BlockingReason::kNotBlocked;
+}
+
 void Operator::recordSpillStats(const SpillStats& spillStats) {
   VELOX_CHECK(noMoreInput_);
   auto lockedStats = stats_.wlock();
@@ -357,6 +442,21 @@ void Operator::recordSpillStats(const SpillStats& spillStats) {
     updateGlobalMaxSpillLevelExceededCount(
         spillStats.spillMaxLevelExceededCount);
   }
+
+  for (auto level = 0; level < SpillStats::kNumSpillLevels; ++level) {
+    if (spillStats.spilledPartitionsByLevel[level] == 0) {
+      continue;
+    }
+    lockedStats->addRuntimeStat(
+        fmt::format("spilledBytesLevel{}", level),
+        RuntimeCounter{
+            static_cast<int64_t>(spillStats.spilledBytesByLevel[level]),
+            RuntimeCounter::Unit::kBytes});
+    lockedStats->addRuntimeStat(
+        fmt::format("spilledPartitionsLevel{}", level),
+        RuntimeCounter{
+            static_cast<int64_t>(spillStats.spilledPartitionsByLevel[level])});
+  }
 }
 
 std::string Operator::toString() const {
@@ -454,6 +554,8 @@ void OperatorStats::add(const OperatorStats& other) {
 
   backgroundTiming.add(other.backgroundTiming);
 
+  perfCounters.add(other.perfCounters);
+
   memoryStats.add(other.memoryStats);
 
   for (const auto& [name, stats] : other.runtimeStats) {
@@ -493,6 +595,8 @@ void OperatorStats::clear() {
 
   backgroundTiming.clear();
 
+  perfCounters.clear();
+
   memoryStats.clear();
 
   runtimeStats.clear();
@@ -505,6 +609,22 @@ void OperatorStats::clear() {
   spilledFiles = 0;
 }
 
+void Operator::reclaimCost(memory::MemoryReclaimer::ReclaimCost& cost) const {
+  uint64_t bytes{0};
+  if (!reclaimableBytes(bytes) || bytes == 0) {
+    return;
+  }
+  double spillRatio{1};
+  {
+    auto lockedStats = stats_.rlock();
+    if (lockedStats->spilledInputBytes > 0) {
+      spillRatio = static_cast<double>(lockedStats->spilledBytes) /
+          lockedStats->spilledInputBytes;
+    }
+  }
+  cost.spillBytes += bytes * spillRatio;
+}
+
 std::unique_ptr<memory::MemoryReclaimer> Operator::MemoryReclaimer::create(
     DriverCtx* driverCtx,
     Operator* op) {
@@ -570,6 +690,17 @@ bool Operator::MemoryReclaimer::reclaimableBytes(
   return op_->reclaimableBytes(reclaimableBytes);
 }
 
+void Operator::MemoryReclaimer::reclaimCost(
+    const memory::MemoryPool& pool,
+    memory::MemoryReclaimer::ReclaimCost& cost) const {
+  std::shared_ptr<Driver> driver = ensureDriver();
+  if (FOLLY_UNLIKELY(driver == nullptr)) {
+    return;
+  }
+  VELOX_CHECK_EQ(pool.name(), op_->pool()->name());
+  op_->reclaimCost(cost);
+}
+
 uint64_t Operator::MemoryReclaimer::reclaim(
     memory::MemoryPool* pool,
     uint64_t targetBytes,
@@ -16,6 +16,7 @@
 #pragma once
 #include <folly/Synchronized.h>
 #include "velox/common/base/RuntimeMetrics.h"
+#include "velox/common/process/PerfCounters.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Driver.h"
@@ -129,6 +130,10 @@ struct OperatorStats {
   // CPU time at a reasonable time granularity.
   CpuWallTiming backgroundTiming;
 
+  // Hardware counters of the calls of the operator's methods. Only counted if
+  // QueryConfig::operatorTrackHardwareCounters() is true.
+  process::PerfCounters perfCounters;
+
   MemoryStats memoryStats;
 
   // Total bytes in memory for spilling
@@ -457,6 +462,12 @@ class Operator : public BaseRuntimeStatWriter {
     return operatorCtx_->pool();
   }
 
+  /// Invoked by the driver before isBlocked(). Returns kWaitForMemory and
+  /// sets 'future' if a memory reservation started by reserveMemoryAsync() is
+  /// still running, otherwise kNotBlocked. Rethrows the error of a failed
+  /// asynchronous reservation, e.g. if the query has been aborted meanwhile.
+  BlockingReason isWaitingForMemory(ContinueFuture* future);
+
   /// Returns true if the operator is reclaimable. Currently, we only support
   /// to reclaim memory from a spillable operator.
   FOLLY_ALWAYS_INLINE virtual bool canReclaim() const {
@@ -472,6 +483,12 @@ class Operator : public BaseRuntimeStatWriter {
     return reclaimable;
   }
 
+  /// Adds the cost of reclaiming memory from this operator to 'cost'. By
+  /// default, all the reclaimable bytes are spilled. The size written to
+  /// spill storage is estimated from the earlier spills of this operator, if
+  /// any.
+  virtual void reclaimCost(memory::MemoryReclaimer::ReclaimCost& cost) const;
+
   /// Invoked by the memory arbitrator to reclaim memory from this operator with
   /// specified reclaim target bytes. If 'targetBytes' is zero, then it tries to
   /// reclaim all the reclaimable memory from this operator.
@@ -613,6 +630,10 @@ class Operator : public BaseRuntimeStatWriter {
         const memory::MemoryPool& pool,
         uint64_t& reclaimableBytes) const override;
 
+    void reclaimCost(
+        const memory::MemoryPool& pool,
+        memory::MemoryReclaimer::ReclaimCost& cost) const override;
+
     uint64_t reclaim(
         memory::MemoryPool* pool,
         uint64_t targetBytes,
@@ -672,9 +693,36 @@ class Operator : public BaseRuntimeStatWriter {
   uint32_t outputBatchRows(
       std::optional<uint64_t> averageRowSize = std::nullopt) const;
 
+  /// Returns outputBatchRows('averageRowSize') if
+  /// QueryConfig::kOutputBatchSizeByBytes is set and outputBatchRows()
+  /// otherwise. Used by operators that know the size of their output rows
+  /// only once they see input.
+  uint32_t outputBatchRowsByBytes(std::optional<uint64_t> averageRowSize) const;
+
+  /// Returns the average flat size of the input rows so far from the input
+  /// stats or std::nullopt before the first input.
+  std::optional<uint64_t> averageInputRowSize() const;
+
   /// Invoked to record spill stats in operator stats.
   void recordSpillStats(const SpillStats& spillStats);
 
+  /// Reserves 'bytes' from this operator's memory pool ahead of processing. If
+  /// the reservation can't be served from the free capacity of the query
+  /// memory pool, the memory arbitration runs on the query executor and the
+  /// driver yields its thread with BlockingReason::kWaitForMemory until it
+  /// completes, instead of holding the thread while other queries are paused
+  /// and spilled. Returns true if the reservation was made inline. Like
+  /// MemoryPool::maybeReserve(), a failed reservation is not an error: the
+  /// operator proceeds and the allocations it makes later are arbitrated
+  /// synchronously.
+  bool reserveMemoryAsync(uint64_t bytes);
+
+  /// Returns the estimated number of input rows of this operator, which is
+  /// the estimate set by Task::setInputRowsEstimate() for its plan node evenly
+  /// divided among the drivers of its pipeline. Returns std::nullopt if there
+  /// is no such estimate.
+  std::optional<uint64_t> estimatedInputRows() const;
+
   const std::unique_ptr<OperatorCtx> operatorCtx_;
   const RowTypePtr outputType_;
   /// Contains the disk spilling related configs if spilling is enabled (e.g.
@@ -711,6 +759,13 @@ class Operator : public BaseRuntimeStatWriter {
 
   /// The number of times that spilling run on this operator.
   uint32_t numSpillRuns_{0};
+
+  /// Set by reserveMemoryAsync() while the memory reservation runs on the
+  /// query executor, and handed over to the driver by isWaitingForMemory().
+  ContinueFuture memoryReservationFuture_{ContinueFuture::makeEmpty()};
+
+  /// Set by the executor thread if the asynchronous memory reservation threw.
+  std::exception_ptr memoryReservationError_;
 };
 
 /// Given a row type returns indices for the specified subset of columns.
@@ -376,6 +376,45 @@ void addOperatorRuntimeStats(
   stats.at(name).addValue(value.value);
 }
 
+void addCompressionRuntimeStats(
+    const std::string& codecCpuName,
+    serializer::presto::PrestoVectorSerde::CompressionStats& compressionStats,
+    std::unordered_map<std::string, RuntimeMetric>& stats) {
+  if (compressionStats.numCompressedPages == 0 &&
+      compressionStats.numUncompressedPages == 0) {
+    return;
+  }
+  addOperatorRuntimeStats(
+      "numCompressedPages",
+      RuntimeCounter(compressionStats.numCompressedPages),
+      stats);
+  addOperatorRuntimeStats(
+      "numUncompressedPages",
+      RuntimeCounter(compressionStats.numUncompressedPages),
+      stats);
+  addOperatorRuntimeStats(
+      "compressionInputBytes",
+      RuntimeCounter(
+          compressionStats.compressionInputBytes,
+          RuntimeCounter::Unit::kBytes),
+      stats);
+  addOperatorRuntimeStats(
+      "compressedBytes",
+      RuntimeCounter(
+          compressionStats.compressedBytes, RuntimeCounter::Unit::kBytes),
+      stats);
+  addOperatorRuntimeStats(
+      codecCpuName,
+      RuntimeCounter(
+          compressionStats.codecCpuNanos, RuntimeCounter::Unit::kNanos),
+      stats);
+  compressionStats.numCompressedPages = 0;
+  compressionStats.numUncompressedPages = 0;
+  compressionStats.compressionInputBytes = 0;
+  compressionStats.compressedBytes = 0;
+  compressionStats.codecCpuNanos = 0;
+}
+
 void aggregateOperatorRuntimeStats(
     std::unordered_map<std::string, RuntimeMetric>& stats) {
   for (auto& runtimeMetric : stats) {
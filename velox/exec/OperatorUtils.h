@@ -17,6 +17,7 @@
 
 #include "velox/exec/Operator.h"
 #include "velox/exec/Spiller.h"
+#include "velox/serializers/PrestoSerializer.h"
 
 namespace facebook::velox::exec {
 
@@ -122,6 +123,14 @@ void addOperatorRuntimeStats(
     const RuntimeCounter& value,
     std::unordered_map<std::string, RuntimeMetric>& stats);
 
+/// Adds the page counters of 'compressionStats' to operator 'stats' and resets
+/// them. 'codecCpuName' is the name of the metric for the codec CPU time. The
+/// bytes saved by compression are compressionInputBytes - compressedBytes.
+void addCompressionRuntimeStats(
+    const std::string& codecCpuName,
+    serializer::presto::PrestoVectorSerde::CompressionStats& compressionStats,
+    std::unordered_map<std::string, RuntimeMetric>& stats);
+
 /// Aggregates runtime metrics we want to see per operator rather than per
 /// event.
 void aggregateOperatorRuntimeStats(
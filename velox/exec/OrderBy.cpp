@@ -69,10 +69,15 @@ OrderBy::OrderBy(
       &nonReclaimableSection_,
       &numSpillRuns_,
       spillConfig_.has_value() ? &(spillConfig_.value()) : nullptr,
-      operatorCtx_->driverCtx()->queryConfig().orderBySpillMemoryThreshold());
+      operatorCtx_->driverCtx()->queryConfig().orderBySpillMemoryThreshold(),
+      operatorCtx_->driverCtx()->queryConfig().prefixSortEnabled());
 }
 
 void OrderBy::addInput(RowVectorPtr input) {
+  if (!receivedInput_) {
+    receivedInput_ = true;
+    sortBuffer_->setEstimatedNumRows(estimatedInputRows());
+  }
   sortBuffer_->addInput(input);
 }
 
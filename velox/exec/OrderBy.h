@@ -68,6 +68,8 @@ class OrderBy : public Operator {
   void recordSpillStats();
 
   std::unique_ptr<SortBuffer> sortBuffer_;
+  // True once the first input has been received.
+  bool receivedInput_{false};
   bool finished_ = false;
 };
 } // namespace facebook::velox::exec
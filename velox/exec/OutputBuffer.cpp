@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/OutputBuffer.h"
+#include "velox/common/file/FileSystems.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
@@ -31,6 +32,7 @@ void ArbitraryBuffer::noMoreData() {
 void ArbitraryBuffer::enqueue(std::unique_ptr<SerializedPage> page) {
   VELOX_CHECK_NOT_NULL(page, "Unexpected null page");
   VELOX_CHECK(!hasNoMoreData(), "Arbitrary buffer has set no more data marker");
+  bytes_ += page->size();
   pages_.push_back(std::shared_ptr<SerializedPage>(page.release()));
 }
 
@@ -52,6 +54,7 @@ std::vector<std::shared_ptr<SerializedPage>> ArbitraryBuffer::getPages(
     pages.push_back(std::move(pages_.front()));
     pages_.pop_front();
   }
+  bytes_ -= bytesRemoved;
   return pages;
 }
 
@@ -62,16 +65,54 @@ std::string ArbitraryBuffer::toString() const {
       hasNoMoreData());
 }
 
+OutputBufferSpillFile::OutputBufferSpillFile(std::string path)
+    : path_(std::move(path)),
+      writeFile_(filesystems::getFileSystem(path_, nullptr)
+                     ->openFileForWrite(path_)) {}
+
+OutputBufferSpillFile::~OutputBufferSpillFile() {
+  try {
+    writeFile_->close();
+    readFile_.reset();
+    filesystems::getFileSystem(path_, nullptr)->remove(path_);
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Failed to remove output buffer spill file " << path_
+               << ": " << e.what();
+  }
+}
+
+uint64_t OutputBufferSpillFile::write(const SerializedPage& page) {
+  const auto offset = size_;
+  auto iobuf = page.getIOBuf();
+  for (const auto& range : *iobuf) {
+    writeFile_->append(std::string_view(
+        reinterpret_cast<const char*>(range.data()), range.size()));
+  }
+  size_ += page.size();
+  return offset;
+}
+
+std::unique_ptr<SerializedPage> OutputBufferSpillFile::read(
+    uint64_t offset,
+    uint64_t size) {
+  VELOX_CHECK_LE(offset + size, size_);
+  if (readFile_ == nullptr || readFile_->size() < offset + size) {
+    writeFile_->flush();
+    readFile_ =
+        filesystems::getFileSystem(path_, nullptr)->openFileForRead(path_);
+  }
+  auto iobuf = folly::IOBuf::create(size);
+  readFile_->pread(offset, size, iobuf->writableData());
+  iobuf->append(size);
+  return std::make_unique<SerializedPage>(std::move(iobuf));
+}
+
 std::vector<std::unique_ptr<folly::IOBuf>> DestinationBuffer::getData(
     uint64_t maxBytes,
     int64_t sequence,
-    DataAvailableCallback notify,
-    ArbitraryBuffer* arbitraryBuffer) {
+    DataAvailableCallback notify) {
   VELOX_CHECK_GE(
       sequence, sequence_, "Get received for an already acknowledged item");
-  if (arbitraryBuffer != nullptr) {
-    loadData(arbitraryBuffer, maxBytes);
-  }
 
   if (sequence - sequence_ > data_.size()) {
     VLOG(1) << this << " Out of order get: " << sequence << " over "
@@ -108,6 +149,11 @@ std::vector<std::unique_ptr<folly::IOBuf>> DestinationBuffer::getData(
 }
 
 void DestinationBuffer::enqueue(std::shared_ptr<SerializedPage> data) {
+  if (!spilled_.empty()) {
+    VELOX_CHECK_NULL(data, "Pages after spilled pages must be spilled");
+    spilledAtEnd_ = true;
+    return;
+  }
   // Drop duplicate end markers.
   if (data == nullptr && !data_.empty() && data_.back() == nullptr) {
     return;
@@ -116,6 +162,34 @@ void DestinationBuffer::enqueue(std::shared_ptr<SerializedPage> data) {
   data_.push_back(std::move(data));
 }
 
+void DestinationBuffer::spill(
+    const SerializedPage& data,
+    OutputBufferSpillFile& spillFile) {
+  VELOX_CHECK(!spilledAtEnd_);
+  spilled_.emplace_back(spillFile.write(data), data.size());
+}
+
+uint64_t DestinationBuffer::unspill(
+    int64_t sequence,
+    uint64_t maxBytes,
+    OutputBufferSpillFile& spillFile) {
+  if (spilled_.empty() || sequence - sequence_ < data_.size()) {
+    return 0;
+  }
+  uint64_t bytes = 0;
+  while (!spilled_.empty() && (bytes == 0 || bytes < maxBytes)) {
+    const auto [offset, size] = spilled_.front();
+    data_.push_back(spillFile.read(offset, size));
+    spilled_.pop_front();
+    bytes += size;
+  }
+  if (spilled_.empty() && spilledAtEnd_) {
+    spilledAtEnd_ = false;
+    data_.push_back(nullptr);
+  }
+  return bytes;
+}
+
 DataAvailable DestinationBuffer::getAndClearNotify() {
   if (notify_ == nullptr) {
     return DataAvailable();
@@ -142,6 +216,9 @@ void DestinationBuffer::maybeLoadData(ArbitraryBuffer* buffer) {
 void DestinationBuffer::loadData(ArbitraryBuffer* buffer, uint64_t maxBytes) {
   auto pages = buffer->getPages(maxBytes);
   for (auto& page : pages) {
+    if (page != nullptr) {
+      loadedBytes_ += page->size();
+    }
     enqueue(std::move(page));
   }
 }
@@ -193,12 +270,16 @@ DestinationBuffer::deleteResults() {
     freed.push_back(std::move(data_[i]));
   }
   data_.clear();
+  spilled_.clear();
+  spilledAtEnd_ = false;
   return freed;
 }
 
 std::string DestinationBuffer::toString() {
   std::stringstream out;
   out << "[available: " << data_.size() << ", "
+      << (spilled_.empty() ? ""
+                           : fmt::format("spilled: {}, ", spilled_.size()))
       << "sequence: " << sequence_ << ", "
       << (notify_ ? "notify registered, " : "") << this << "]";
   return out.str();
@@ -231,6 +312,14 @@ OutputBuffer::OutputBuffer(
       continueSize_((maxSize_ * kContinuePct) / 100),
       arbitraryBuffer_(
           isArbitrary() ? std::make_unique<ArbitraryBuffer>() : nullptr),
+      spillPath_(
+          isPartitioned() &&
+                  task_->queryCtx()
+                      ->queryConfig()
+                      .partitionedOutputSpillEnabled() &&
+                  !task_->spillDirectory().empty()
+              ? fmt::format("{}/OutputBuffer", task_->spillDirectory())
+              : ""),
       numDrivers_(numDrivers) {
   buffers_.reserve(numDestinations);
   for (int i = 0; i < numDestinations; i++) {
@@ -334,7 +423,8 @@ bool OutputBuffer::enqueue(
         VELOX_UNREACHABLE(PartitionedOutputNode::kindString(kind_));
     }
 
-    if (totalSize_ > maxSize_ && future) {
+    // With spilling, pages over 'maxSize_' go to disk instead of blocking.
+    if (totalSize_ > maxSize_ && future && spillPath_.empty()) {
       promises_.emplace_back("OutputBuffer::enqueue");
       *future = promises_.back().getSemiFuture();
       blocked = true;
@@ -381,20 +471,51 @@ void OutputBuffer::enqueueArbitraryOutputLocked(
 
   arbitraryBuffer_->enqueue(std::move(data));
   VELOX_CHECK_LT(nextArbitraryLoadBufferIndex_, buffers_.size());
+  // The waiting destinations get the pages in the order of the bytes they
+  // have loaded so far, so that the consumers get about the same bytes even
+  // if the pages differ in size. Ties go round robin.
+  std::vector<int32_t> waitingIds;
   int32_t bufferId = nextArbitraryLoadBufferIndex_;
   for (int32_t i = 0; i < buffers_.size();
        ++i, bufferId = (bufferId + 1) % buffers_.size()) {
+    if (buffers_[bufferId] != nullptr && buffers_[bufferId]->hasNotify()) {
+      waitingIds.push_back(bufferId);
+    }
+  }
+  std::stable_sort(
+      waitingIds.begin(), waitingIds.end(), [&](int32_t left, int32_t right) {
+        return buffers_[left]->loadedBytes() < buffers_[right]->loadedBytes();
+      });
+  for (const auto id : waitingIds) {
     if (arbitraryBuffer_->empty()) {
-      nextArbitraryLoadBufferIndex_ = bufferId;
       break;
     }
-    auto* buffer = buffers_[bufferId].get();
-    if (buffer == nullptr) {
-      continue;
-    }
+    auto* buffer = buffers_[id].get();
     buffer->maybeLoadData(arbitraryBuffer_.get());
     dataAvailableCbs.emplace_back(buffer->getAndClearNotify());
+    nextArbitraryLoadBufferIndex_ = (id + 1) % buffers_.size();
+  }
+}
+
+uint64_t OutputBuffer::arbitraryLoadBytesLocked(uint64_t maxBytes) const {
+  const auto numDestinations = std::count_if(
+      buffers_.begin(), buffers_.end(), [](const auto& buffer) {
+        return buffer != nullptr;
+      });
+  const auto share =
+      arbitraryBuffer_->bytes() / std::max<int64_t>(numDestinations, 1);
+  return std::min(maxBytes, std::max<uint64_t>(share, 1));
+}
+
+bool OutputBuffer::shouldSpillLocked(const DestinationBuffer& buffer) const {
+  if (spillPath_.empty()) {
+    return false;
+  }
+  if (buffer.hasSpilledData()) {
+    return true;
   }
+  // A waiting fetch gets the page from memory.
+  return totalSize_ > maxSize_ && !buffer.hasNotify();
 }
 
 void OutputBuffer::enqueuePartitionedOutputLocked(
@@ -407,7 +528,13 @@ void OutputBuffer::enqueuePartitionedOutputLocked(
 
   VELOX_CHECK_LT(destination, buffers_.size());
   auto* buffer = buffers_[destination].get();
-  if (buffer != nullptr) {
+  if (buffer != nullptr && shouldSpillLocked(*buffer)) {
+    if (spillFile_ == nullptr) {
+      spillFile_ = std::make_unique<OutputBufferSpillFile>(spillPath_);
+    }
+    buffer->spill(*data, *spillFile_);
+    totalSize_ -= data->size();
+  } else if (buffer != nullptr) {
     buffer->enqueue(std::move(data));
     dataAvailableCbs.emplace_back(buffer->getAndClearNotify());
   } else {
@@ -589,7 +716,14 @@ void OutputBuffer::getData(
         sequence);
     freed = buffer->acknowledge(sequence, true);
     updateAfterAcknowledgeLocked(freed, promises);
-    data = buffer->getData(maxBytes, sequence, notify, arbitraryBuffer_.get());
+    if (spillFile_ != nullptr) {
+      totalSize_ += buffer->unspill(sequence, maxBytes, *spillFile_);
+    }
+    if (isArbitrary()) {
+      buffer->loadData(
+          arbitraryBuffer_.get(), arbitraryLoadBytesLocked(maxBytes));
+    }
+    data = buffer->getData(maxBytes, sequence, notify);
   }
   releaseAfterAcknowledge(freed, promises);
   if (!data.empty()) {
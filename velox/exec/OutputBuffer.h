@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/file/File.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/ExchangeQueue.h"
 
@@ -68,16 +69,80 @@ class ArbitraryBuffer {
   /// there are sufficient buffered pages.
   std::vector<std::shared_ptr<SerializedPage>> getPages(uint64_t maxBytes);
 
+  /// Returns the total bytes of the buffered pages.
+  uint64_t bytes() const {
+    return bytes_;
+  }
+
   std::string toString() const;
 
  private:
   std::deque<std::shared_ptr<SerializedPage>> pages_;
+  uint64_t bytes_{0};
+};
+
+/// Append-only file that holds the pages a partitioned OutputBuffer moved out
+/// of memory because its consumers were slow. The file is removed on
+/// destruction. This class is not thread-safe.
+class OutputBufferSpillFile {
+ public:
+  explicit OutputBufferSpillFile(std::string path);
+
+  ~OutputBufferSpillFile();
+
+  /// Appends the bytes of 'page' and returns their offset in the file.
+  uint64_t write(const SerializedPage& page);
+
+  /// Reads back the page of 'size' bytes written at 'offset'.
+  std::unique_ptr<SerializedPage> read(uint64_t offset, uint64_t size);
+
+  /// Returns the number of bytes written.
+  uint64_t size() const {
+    return size_;
+  }
+
+ private:
+  const std::string path_;
+  std::unique_ptr<WriteFile> writeFile_;
+  // Opened on first read and reopened when 'writeFile_' has grown past its
+  // size.
+  std::unique_ptr<ReadFile> readFile_;
+  uint64_t size_{0};
 };
 
 class DestinationBuffer {
  public:
   void enqueue(std::shared_ptr<SerializedPage> data);
 
+  /// Writes 'data' to 'spillFile' instead of keeping it in memory. Once a page
+  /// is spilled, the following pages must be spilled too until the spilled
+  /// pages are read back, so that the order of the pages is kept. An end
+  /// marker enqueued while there are spilled pages follows them.
+  void spill(const SerializedPage& data, OutputBufferSpillFile& spillFile);
+
+  /// Returns true if there are spilled pages that are not read back.
+  bool hasSpilledData() const {
+    return !spilled_.empty();
+  }
+
+  /// Returns true if a fetch is waiting for data.
+  bool hasNotify() const {
+    return notify_ != nullptr;
+  }
+
+  /// Returns the total bytes of the pages loaded from the arbitrary buffer.
+  uint64_t loadedBytes() const {
+    return loadedBytes_;
+  }
+
+  /// Reads spilled pages of up to 'maxBytes', but at least one page, back
+  /// into memory if the in-memory pages from 'sequence' on are all fetched.
+  /// Returns the bytes read.
+  uint64_t unspill(
+      int64_t sequence,
+      uint64_t maxBytes,
+      OutputBufferSpillFile& spillFile);
+
   /// Invoked to load data with up to 'notifyMaxBytes_' bytes from arbitrary
   /// 'buffer' if there is pending fetch from this destination in which case
   /// 'notify_' is not null. Otherwise, it does nothing. This only used by
@@ -96,8 +161,7 @@ class DestinationBuffer {
   std::vector<std::unique_ptr<folly::IOBuf>> getData(
       uint64_t maxBytes,
       int64_t sequence,
-      DataAvailableCallback notify,
-      ArbitraryBuffer* arbitraryBuffer = nullptr);
+      DataAvailableCallback notify);
 
   // Removes data from the queue and returns removed data. If 'fromGetData' we
   // do not give a warning for the case where no data is removed, otherwise we
@@ -120,10 +184,16 @@ class DestinationBuffer {
   std::vector<std::shared_ptr<SerializedPage>> data_;
   // The sequence number of the first in 'data_'.
   int64_t sequence_ = 0;
+  // The offsets and sizes in the spill file of the pages that follow
+  // 'data_'.
+  std::deque<std::pair<uint64_t, uint64_t>> spilled_;
+  // True if the end marker follows 'spilled_'.
+  bool spilledAtEnd_{false};
   DataAvailableCallback notify_ = nullptr;
   // The sequence number of the first item to pass to 'notify'.
   int64_t notifySequence_{0};
   uint64_t notifyMaxBytes_{0};
+  uint64_t loadedBytes_{0};
 };
 
 class Task;
@@ -219,6 +289,17 @@ class OutputBuffer {
       std::unique_ptr<SerializedPage> data,
       std::vector<DataAvailable>& dataAvailableCbs);
 
+  // Returns the bytes a fetch asking for 'maxBytes' may take from the
+  // arbitrary buffer: an even share of the buffered bytes among the
+  // destinations, but at least one page. Keeps a consumer that fetches first
+  // with a large 'maxBytes' from taking pages that idle consumers could
+  // process.
+  uint64_t arbitraryLoadBytesLocked(uint64_t maxBytes) const;
+
+  // Returns true if a page for 'buffer' should go to the spill file, i.e. the
+  // buffered size exceeds 'maxSize_' and no fetch waits for 'buffer'.
+  bool shouldSpillLocked(const DestinationBuffer& buffer) const;
+
   void enqueuePartitionedOutputLocked(
       int destination,
       std::unique_ptr<SerializedPage> data,
@@ -247,6 +328,9 @@ class OutputBuffer {
   // resumed.
   const uint64_t continueSize_;
   const std::unique_ptr<ArbitraryBuffer> arbitraryBuffer_;
+  // Path of the spill file for pages that do not fit in 'maxSize_'. Empty if
+  // partitioned output spilling is disabled, in which case producers block.
+  const std::string spillPath_;
 
   // Total number of drivers expected to produce results. This number will
   // decrease in the end of grouped execution, when we understand the real
@@ -271,6 +355,8 @@ class OutputBuffer {
   int32_t nextArbitraryLoadBufferIndex_{0};
   // One buffer per destination.
   std::vector<std::unique_ptr<DestinationBuffer>> buffers_;
+  // Created on first spill.
+  std::unique_ptr<OutputBufferSpillFile> spillFile_;
   uint32_t numFinished_{0};
   // When this reaches buffers_.size(), 'this' can be freed.
   int numFinalAcknowledges_ = 0;
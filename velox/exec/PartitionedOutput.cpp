@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/PartitionedOutput.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
 
@@ -64,7 +65,7 @@ BlockingReason Destination::advance(
   if (!current_) {
     current_ = std::make_unique<VectorStreamGroup>(pool_);
     auto rowType = asRowType(output->type());
-    current_->createStreamTree(rowType, rowsInCurrent_);
+    current_->createStreamTree(rowType, rowsInCurrent_, serdeOptions_);
   }
   current_->append(
       output, folly::Range(&rangesToSerialize_[0], rangesToSerialize_.size()));
@@ -99,16 +100,33 @@ BlockingReason Destination::flush(
   rowsInCurrent_ = 0;
   setTargetSizePct();
 
+  auto page = stream.getIOBuf(bufferReleaseFn);
+  if (checkpoint_ != nullptr) {
+    checkpoint_->addPage(splitGroupId_, destination_, *page);
+  }
   bool blocked = bufferManager.enqueue(
       taskId_,
       destination_,
-      std::make_unique<SerializedPage>(stream.getIOBuf(bufferReleaseFn)),
+      std::make_unique<SerializedPage>(std::move(page)),
       future);
   return blocked ? BlockingReason::kWaitForConsumer
                  : BlockingReason::kNotBlocked;
 }
 } // namespace detail
 
+namespace {
+serializer::presto::PrestoVectorSerde::PrestoOptions makeSerdeOptions(
+    const core::QueryConfig& queryConfig,
+    serializer::presto::PrestoVectorSerde::CompressionStats* compressionStats) {
+  serializer::presto::PrestoVectorSerde::PrestoOptions options;
+  options.preserveEncodings = queryConfig.exchangePreserveEncodings();
+  options.compressionKind =
+      common::stringToCompressionKind(queryConfig.exchangeCompressionKind());
+  options.compressionStats = compressionStats;
+  return options;
+}
+} // namespace
+
 PartitionedOutput::PartitionedOutput(
     int32_t operatorId,
     DriverCtx* ctx,
@@ -138,7 +156,15 @@ PartitionedOutput::PartitionedOutput(
       bufferReleaseFn_([task = operatorCtx_->task()]() {}),
       maxBufferedBytes_(ctx->task->queryCtx()
                             ->queryConfig()
-                            .maxPartitionedOutputBufferSize()) {
+                            .maxPartitionedOutputBufferSize()),
+      sortByPartition_(ctx->queryConfig().partitionedOutputSortByPartition()),
+      serdeOptions_(makeSerdeOptions(ctx->queryConfig(), &compressionStats_)),
+      checkpoint_(
+          ctx->splitGroupId == kUngroupedGroupId ? nullptr
+                                                 : ctx->task->checkpoint()),
+      replayCheckpoint_(
+          checkpoint_ != nullptr &&
+          checkpoint_->isCommitted(ctx->splitGroupId)) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -180,7 +206,13 @@ void PartitionedOutput::initializeDestinations() {
     auto taskId = operatorCtx_->taskId();
     for (int i = 0; i < numDestinations_; ++i) {
       destinations_.push_back(
-          std::make_unique<detail::Destination>(taskId, i, pool()));
+          std::make_unique<detail::Destination>(
+              taskId,
+              i,
+              pool(),
+              &serdeOptions_,
+              checkpoint_,
+              operatorCtx_->driverCtx()->splitGroupId));
     }
   }
 }
@@ -226,8 +258,6 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
 
   initializeSizeBuffers();
 
-  estimateRowSizes();
-
   for (auto& destination : destinations_) {
     destination->beginBatch();
   }
@@ -266,6 +296,8 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
       if (singlePartition.has_value()) {
         destinations_[singlePartition.value()]->addRows(
             IndexRange{0, numInput});
+      } else if (sortByPartition_) {
+        addRowsSortedByPartition();
       } else {
         for (vector_size_t i = 0; i < numInput; ++i) {
           destinations_[partitions_[i]]->addRow(i);
@@ -273,6 +305,50 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
       }
     }
   }
+
+  // Sizes are estimated after the rows are assigned since that may reorder
+  // 'output_'.
+  estimateRowSizes();
+}
+
+void PartitionedOutput::addRowsSortedByPartition() {
+  const auto numInput = input_->size();
+
+  // Count the rows of each destination and turn the counts into starts.
+  partitionStarts_.assign(numDestinations_ + 1, 0);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    ++partitionStarts_[partitions_[i] + 1];
+  }
+  for (auto i = 0; i < numDestinations_; ++i) {
+    partitionStarts_[i + 1] += partitionStarts_[i];
+  }
+
+  // Scatter the row numbers into their destination's run.
+  partitionEnds_.assign(partitionStarts_.begin(), partitionStarts_.end() - 1);
+  sortedRows_.resize(numInput);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    sortedRows_[partitionEnds_[partitions_[i]]++] = i;
+  }
+
+  // Copy the output columns in destination order.
+  rows_.resize(numInput);
+  rows_.setAll();
+  std::vector<VectorPtr> sortedColumns;
+  sortedColumns.reserve(output_->childrenSize());
+  for (const auto& column : output_->children()) {
+    auto sortedColumn = BaseVector::create(column->type(), numInput, pool());
+    sortedColumn->copy(column.get(), rows_, sortedRows_.data());
+    sortedColumns.push_back(std::move(sortedColumn));
+  }
+  output_ = std::make_shared<RowVector>(
+      pool(), outputType_, nullptr, numInput, std::move(sortedColumns));
+
+  for (auto i = 0; i < numDestinations_; ++i) {
+    const auto numRows = partitionStarts_[i + 1] - partitionStarts_[i];
+    if (numRows > 0) {
+      destinations_[i]->addRows(IndexRange{partitionStarts_[i], numRows});
+    }
+  }
 }
 
 void PartitionedOutput::collectNullRows() {
@@ -309,6 +385,10 @@ RowVectorPtr PartitionedOutput::getOutput() {
   VELOX_CHECK_NOT_NULL(
       bufferManager, "OutputBufferManager was already destructed");
 
+  if (replayCheckpoint_ && !replayCheckpoint(*bufferManager)) {
+    return nullptr;
+  }
+
   // Limit serialized pages to 1MB.
   static const uint64_t kMaxPageSize = 1 << 20;
   const uint64_t maxPageSize = std::max<uint64_t>(
@@ -353,6 +433,7 @@ RowVectorPtr PartitionedOutput::getOutput() {
       }
       destination->flush(*bufferManager, bufferReleaseFn_, nullptr);
     }
+    recordCompressionStats();
     return nullptr;
   }
   // All of 'output_' is written into the destinations. We are finishing, hence
@@ -370,12 +451,43 @@ RowVectorPtr PartitionedOutput::getOutput() {
     bufferManager->noMoreData(operatorCtx_->task()->taskId());
     finished_ = true;
   }
+  recordCompressionStats();
   // The input is fully processed, drop the reference to allow reuse.
   input_ = nullptr;
   output_ = nullptr;
   return nullptr;
 }
 
+bool PartitionedOutput::replayCheckpoint(OutputBufferManager& bufferManager) {
+  if (!checkpointPagesTaken_) {
+    checkpointPages_ =
+        checkpoint_->takePages(operatorCtx_->driverCtx()->splitGroupId);
+    checkpointPagesTaken_ = true;
+    if (!checkpointPages_.empty()) {
+      addRuntimeStat(
+          "checkpointReplayedPages", RuntimeCounter(checkpointPages_.size()));
+    }
+  }
+  while (nextCheckpointPage_ < checkpointPages_.size()) {
+    auto& page = checkpointPages_[nextCheckpointPage_++];
+    if (bufferManager.enqueue(
+            operatorCtx_->taskId(),
+            page.destination,
+            std::make_unique<SerializedPage>(std::move(page.data)),
+            &future_)) {
+      blockingReason_ = BlockingReason::kWaitForConsumer;
+      return false;
+    }
+  }
+  checkpointPages_.clear();
+  return true;
+}
+
+void PartitionedOutput::recordCompressionStats() {
+  addCompressionRuntimeStats(
+      "compressionCpuNanos", compressionStats_, stats_.wlock()->runtimeStats);
+}
+
 bool PartitionedOutput::isFinished() {
   return finished_;
 }
@@ -18,6 +18,8 @@
 #include <folly/Random.h>
 #include "velox/exec/Operator.h"
 #include "velox/exec/OutputBufferManager.h"
+#include "velox/exec/TaskCheckpoint.h"
+#include "velox/serializers/PrestoSerializer.h"
 #include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::exec {
@@ -28,8 +30,16 @@ class Destination {
   Destination(
       const std::string& taskId,
       int destination,
-      memory::MemoryPool* pool)
-      : taskId_(taskId), destination_(destination), pool_(pool) {
+      memory::MemoryPool* pool,
+      const VectorSerde::Options* serdeOptions = nullptr,
+      TaskCheckpoint* checkpoint = nullptr,
+      uint32_t splitGroupId = 0)
+      : taskId_(taskId),
+        destination_(destination),
+        pool_(pool),
+        serdeOptions_(serdeOptions),
+        checkpoint_(checkpoint),
+        splitGroupId_(splitGroupId) {
     setTargetSizePct();
   }
 
@@ -93,6 +103,12 @@ class Destination {
   const std::string taskId_;
   const int destination_;
   memory::MemoryPool* const pool_;
+  // Options for the serializer of 'current_'. Owned by the PartitionedOutput.
+  const VectorSerde::Options* const serdeOptions_;
+  // If set, the flushed pages are also added to the checkpoint of
+  // 'splitGroupId_'.
+  TaskCheckpoint* const checkpoint_;
+  const uint32_t splitGroupId_;
   // Bytes serialized in 'current_'
   uint64_t bytesInCurrent_{0};
   // Number of rows serialized in 'current_'
@@ -184,9 +200,23 @@ class PartitionedOutput : public Operator {
 
   void estimateRowSizes();
 
+  /// Adds the compression counters of the pages flushed so far to the
+  /// operator's runtime stats.
+  void recordCompressionStats();
+
   /// Collect all rows with null keys into nullRows_.
   void collectNullRows();
 
+  /// Reorders 'output_' so that the rows of each destination are contiguous
+  /// and adds one range per destination. Uses a counting sort on
+  /// 'partitions_'.
+  void addRowsSortedByPartition();
+
+  /// Sends the checkpointed pages of the split group to the output buffers.
+  /// Returns false if the output buffers are full, in which case the
+  /// operator is blocked.
+  bool replayCheckpoint(OutputBufferManager& bufferManager);
+
   const std::vector<column_index_t> keyChannels_;
   const int numDestinations_;
   const bool replicateNullsAndAny_;
@@ -196,6 +226,22 @@ class PartitionedOutput : public Operator {
   const std::weak_ptr<exec::OutputBufferManager> bufferManager_;
   const std::function<void()> bufferReleaseFn_;
   const int64_t maxBufferedBytes_;
+  // True if hash partitioned rows are serialized in contiguous runs per
+  // destination. See QueryConfig::kPartitionedOutputSortByPartition.
+  const bool sortByPartition_;
+  // Compression counters of the pages of all destinations. Also carries the
+  // decision to skip compression of the next pages.
+  serializer::presto::PrestoVectorSerde::CompressionStats compressionStats_;
+  // Options for serializing the pages of all destinations.
+  const serializer::presto::PrestoVectorSerde::PrestoOptions serdeOptions_;
+  // The checkpoint of the Task if the operator runs in a grouped pipeline.
+  TaskCheckpoint* const checkpoint_;
+  // True if the split group of the operator is checkpointed. The operator then
+  // sends the checkpointed pages and gets no input.
+  const bool replayCheckpoint_;
+  bool checkpointPagesTaken_{false};
+  std::vector<TaskCheckpoint::Page> checkpointPages_;
+  size_t nextCheckpointPage_{0};
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -214,6 +260,13 @@ class PartitionedOutput : public Operator {
   SelectivityVector rows_;
   SelectivityVector nullRows_;
   std::vector<uint32_t> partitions_;
+  // Start of the rows of each destination in 'sortedRows_', followed by the
+  // number of input rows.
+  std::vector<vector_size_t> partitionStarts_;
+  // Next free position in 'sortedRows_' for each destination.
+  std::vector<vector_size_t> partitionEnds_;
+  // Input row numbers ordered by destination.
+  std::vector<vector_size_t> sortedRows_;
   std::vector<DecodedVector> decodedVectors_;
 };
 
@@ -76,6 +76,8 @@ void PlanNodeStats::addTotals(const OperatorStats& stats) {
   spilledRows += stats.spilledRows;
   spilledPartitions += stats.spilledPartitions;
   spilledFiles += stats.spilledFiles;
+
+  perfCounters.add(stats.perfCounters);
 }
 
 std::string PlanNodeStats::toString(bool includeInputStats) const {
@@ -108,6 +110,13 @@ std::string PlanNodeStats::toString(bool includeInputStats) const {
         << succinctBytes(spilledBytes) << ", " << spilledFiles << " files)";
   }
 
+  if (perfCounters.cycles > 0) {
+    out << ", Cycles: " << perfCounters.cycles
+        << ", IPC: " << fmt::format("{:.2f}", perfCounters.ipc())
+        << ", LLC misses: " << perfCounters.llcMisses
+        << ", dTLB misses: " << perfCounters.dtlbMisses;
+  }
+
   return out.str();
 }
 
@@ -158,6 +167,13 @@ folly::dynamic toPlanStatsJson(const facebook::velox::exec::TaskStats& stats) {
       stat["spilledBytes"] = operatorStat.second->spilledBytes;
       stat["spilledRows"] = operatorStat.second->spilledRows;
       stat["spilledFiles"] = operatorStat.second->spilledFiles;
+      if (operatorStat.second->perfCounters.cycles > 0) {
+        const auto& perfCounters = operatorStat.second->perfCounters;
+        stat["cycles"] = perfCounters.cycles;
+        stat["instructions"] = perfCounters.instructions;
+        stat["llcMisses"] = perfCounters.llcMisses;
+        stat["dtlbMisses"] = perfCounters.dtlbMisses;
+      }
 
       folly::dynamic cs = folly::dynamic::object;
       for (const auto& cstat : operatorStat.second->customStats) {
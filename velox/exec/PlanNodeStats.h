@@ -114,6 +114,10 @@ struct PlanNodeStats {
   /// Total spilled files.
   uint32_t spilledFiles{0};
 
+  /// Hardware counters of the operators. All 0 unless
+  /// QueryConfig::operatorTrackHardwareCounters() is true.
+  process::PerfCounters perfCounters;
+
   /// Add stats for a single operator instance.
   void add(const OperatorStats& stats);
 
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/PrefixSort.h"
+
+#include <folly/lang/Bits.h>
+
+#include "velox/row/KeyEncoder.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+// Describes how one key is laid out in the prefix.
+struct PrefixKey {
+  RowColumn column;
+  TypeKind kind;
+  CompareFlags flags;
+  // Offset of the key in the prefix. The null byte comes first for nullable
+  // keys.
+  int32_t offset;
+  bool nullable;
+};
+
+template <TypeKind kind>
+void encodeValueAt(
+    const char* row,
+    int32_t offset,
+    const CompareFlags& flags,
+    char* out) {
+  using T = typename TypeTraits<kind>::NativeType;
+  if constexpr (kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY) {
+    VELOX_UNREACHABLE();
+  } else {
+    row::KeyEncoder::encodeValue(
+        RowContainer::valueAt<T>(row, offset), !flags.ascending, out);
+  }
+}
+
+void encodeKey(const PrefixKey& key, const char* row, char* prefix) {
+  auto* out = prefix + key.offset;
+  if (key.nullable) {
+    if (RowContainer::isNullAt(
+            row, key.column.nullByte(), key.column.nullMask())) {
+      // The value bytes stay zero so that all nulls compare equal.
+      *out = key.flags.nullsFirst ? 0 : 2;
+      return;
+    }
+    *out++ = 1;
+  }
+  VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+      encodeValueAt, key.kind, row, key.column.offset(), key.flags, out);
+}
+
+template <int32_t kNumWords>
+struct PrefixEntry {
+  uint64_t words[kNumWords];
+  char* row;
+};
+
+template <int32_t kNumWords>
+void sortWithPrefix(
+    RowContainer* rowContainer,
+    const std::vector<std::pair<column_index_t, CompareFlags>>& keys,
+    const std::vector<PrefixKey>& prefixKeys,
+    std::vector<char*>& rows) {
+  std::vector<PrefixEntry<kNumWords>> entries(rows.size());
+  char prefix[kNumWords * sizeof(uint64_t)];
+  for (auto i = 0; i < rows.size(); ++i) {
+    memset(prefix, 0, sizeof(prefix));
+    for (const auto& key : prefixKeys) {
+      encodeKey(key, rows[i], prefix);
+    }
+    auto& entry = entries[i];
+    for (auto word = 0; word < kNumWords; ++word) {
+      // Loading the words big endian makes integer comparison match memcmp
+      // on the prefix bytes.
+      entry.words[word] = folly::Endian::big(
+          folly::loadUnaligned<uint64_t>(prefix + word * sizeof(uint64_t)));
+    }
+    entry.row = rows[i];
+  }
+
+  const auto numPrefixKeys = prefixKeys.size();
+  std::sort(
+      entries.begin(),
+      entries.end(),
+      [&](const PrefixEntry<kNumWords>& left,
+          const PrefixEntry<kNumWords>& right) {
+        for (auto word = 0; word < kNumWords; ++word) {
+          if (left.words[word] != right.words[word]) {
+            return left.words[word] < right.words[word];
+          }
+        }
+        // The prefix encodes its keys exactly, so only the keys after it
+        // need comparing.
+        for (auto i = numPrefixKeys; i < keys.size(); ++i) {
+          if (auto result = rowContainer->compare(
+                  left.row, right.row, keys[i].first, keys[i].second)) {
+            return result < 0;
+          }
+        }
+        return false;
+      });
+
+  for (auto i = 0; i < rows.size(); ++i) {
+    rows[i] = entries[i].row;
+  }
+}
+} // namespace
+
+// static
+void PrefixSort::sort(
+    RowContainer* rowContainer,
+    const std::vector<std::pair<column_index_t, CompareFlags>>& keys,
+    std::vector<char*>& rows) {
+  if (rows.size() < 2) {
+    return;
+  }
+
+  std::vector<PrefixKey> prefixKeys;
+  int32_t prefixBytes = 0;
+  for (const auto& [columnIndex, flags] : keys) {
+    const auto& type = rowContainer->columnTypes()[columnIndex];
+    const auto valueBytes = row::KeyEncoder::fixedSize(type);
+    if (valueBytes == 0) {
+      break;
+    }
+    const auto column = rowContainer->columnAt(columnIndex);
+    const bool nullable = column.nullMask() != 0;
+    const auto keyBytes = valueBytes + (nullable ? 1 : 0);
+    if (prefixBytes + keyBytes > kMaxPrefixBytes) {
+      break;
+    }
+    prefixKeys.push_back({column, type->kind(), flags, prefixBytes, nullable});
+    prefixBytes += keyBytes;
+  }
+
+  switch (bits::roundUp(prefixBytes, sizeof(uint64_t)) / sizeof(uint64_t)) {
+    case 0:
+      std::sort(
+          rows.begin(), rows.end(), [&](const char* left, const char* right) {
+            for (const auto& [columnIndex, flags] : keys) {
+              if (auto result =
+                      rowContainer->compare(left, right, columnIndex, flags)) {
+                return result < 0;
+              }
+            }
+            return false;
+          });
+      break;
+    case 1:
+      sortWithPrefix<1>(rowContainer, keys, prefixKeys, rows);
+      break;
+    case 2:
+      sortWithPrefix<2>(rowContainer, keys, prefixKeys, rows);
+      break;
+    case 3:
+      sortWithPrefix<3>(rowContainer, keys, prefixKeys, rows);
+      break;
+    case 4:
+      sortWithPrefix<4>(rowContainer, keys, prefixKeys, rows);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+} // namespace facebook::velox::exec
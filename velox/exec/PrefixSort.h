@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/RowContainer.h"
+
+namespace facebook::velox::exec {
+
+/// Sorts rows of a RowContainer by normalized key prefixes. The leading
+/// fixed-width keys are encoded with row::KeyEncoder into a binary comparable
+/// prefix of at most 'kMaxPrefixBytes' bytes that honors the null ordering and
+/// direction of each key. The sort then runs on (prefix, row) pairs compared as
+/// unsigned words, and only falls back to RowContainer::compare for the keys
+/// after the prefix when two prefixes are equal.
+class PrefixSort {
+ public:
+  static constexpr int32_t kMaxPrefixBytes = 32;
+
+  /// Sorts 'rows' of 'rowContainer' by 'keys', a list of (column index,
+  /// compare flags) pairs in sort order. Sorts with RowContainer::compare on
+  /// all keys if the first key can not be encoded.
+  static void sort(
+      RowContainer* rowContainer,
+      const std::vector<std::pair<column_index_t, CompareFlags>>& keys,
+      std::vector<char*>& rows);
+};
+
+} // namespace facebook::velox::exec
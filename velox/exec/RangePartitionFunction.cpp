@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/RangePartitionFunction.h"
+#include "velox/common/encode/Base64.h"
+#include "velox/row/KeyEncoder.h"
+#include "velox/vector/VectorSaver.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+CompareFlags toCompareFlags(const core::SortOrder& sortOrder) {
+  return {
+      sortOrder.isNullsFirst(),
+      sortOrder.isAscending(),
+      false,
+      CompareFlags::NullHandlingMode::NoStop};
+}
+} // namespace
+
+RangePartitionFunction::RangePartitionFunction(
+    const std::vector<column_index_t>& keyChannels,
+    const std::vector<core::SortOrder>& sortOrders,
+    RowVectorPtr splitters)
+    : keyChannels_{keyChannels}, splitters_{std::move(splitters)} {
+  VELOX_CHECK(!keyChannels_.empty());
+  VELOX_CHECK_EQ(keyChannels_.size(), sortOrders.size());
+  VELOX_CHECK_NOT_NULL(splitters_);
+  VELOX_CHECK_EQ(splitters_->childrenSize(), keyChannels_.size());
+  compareFlags_.reserve(sortOrders.size());
+  for (const auto& sortOrder : sortOrders) {
+    compareFlags_.push_back(toCompareFlags(sortOrder));
+  }
+  keys_.resize(keyChannels_.size());
+
+  const auto& splitterType = splitters_->type()->asRow();
+  for (const auto& type : splitterType.children()) {
+    if (!row::KeyEncoder::isSupported(type)) {
+      return;
+    }
+  }
+  if (splitters_->size() > 0) {
+    row::KeyEncoder::encode(*splitters_, compareFlags_, splitterKeys_);
+  }
+}
+
+int32_t RangePartitionFunction::compareWithSplitter(
+    const std::vector<BaseVector*>& keys,
+    vector_size_t row,
+    vector_size_t splitter) const {
+  for (auto i = 0; i < keys.size(); ++i) {
+    const auto result =
+        keys[i]
+            ->compare(
+                splitters_->childAt(i).get(), row, splitter, compareFlags_[i])
+            .value();
+    if (result != 0) {
+      return result;
+    }
+  }
+  return 0;
+}
+
+void RangePartitionFunction::partitionByNormalizedKeys(
+    const RowVector& input,
+    std::vector<uint32_t>& partitions) {
+  std::vector<VectorPtr> keys;
+  keys.reserve(keyChannels_.size());
+  for (auto channel : keyChannels_) {
+    keys.push_back(input.childAt(channel));
+  }
+  const RowVector keyVector(
+      input.pool(),
+      splitters_->type(),
+      nullptr,
+      input.size(),
+      std::move(keys));
+  for (auto& key : rowKeys_) {
+    key.clear();
+  }
+  row::KeyEncoder::encode(keyVector, compareFlags_, rowKeys_);
+  for (auto row = 0; row < input.size(); ++row) {
+    // The number of splitters that sort before 'row'.
+    partitions[row] = std::lower_bound(
+                          splitterKeys_.begin(),
+                          splitterKeys_.end(),
+                          rowKeys_[row]) -
+        splitterKeys_.begin();
+  }
+}
+
+std::optional<uint32_t> RangePartitionFunction::partition(
+    const RowVector& input,
+    std::vector<uint32_t>& partitions) {
+  const auto numSplitters = splitters_->size();
+  if (numSplitters == 0) {
+    return 0u;
+  }
+
+  const auto size = input.size();
+  partitions.resize(size);
+  if (!splitterKeys_.empty()) {
+    partitionByNormalizedKeys(input, partitions);
+    return std::nullopt;
+  }
+
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    keys_[i] = input.childAt(keyChannels_[i])->loadedVector();
+  }
+
+  for (auto row = 0; row < size; ++row) {
+    // Finds the first splitter that does not sort before 'row'.
+    vector_size_t low = 0;
+    vector_size_t high = numSplitters;
+    while (low < high) {
+      const auto middle = low + (high - low) / 2;
+      if (compareWithSplitter(keys_, row, middle) > 0) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    partitions[row] = low;
+  }
+  return std::nullopt;
+}
+
+// static
+RowVectorPtr RangePartitionFunction::makeSplitters(
+    const RowVector& sample,
+    const std::vector<column_index_t>& keyChannels,
+    const std::vector<core::SortOrder>& sortOrders,
+    int numPartitions,
+    memory::MemoryPool* pool) {
+  VELOX_CHECK_GT(numPartitions, 0);
+  VELOX_CHECK_EQ(keyChannels.size(), sortOrders.size());
+  VELOX_CHECK_GT(sample.size(), 0, "Splitters need a non-empty sample");
+
+  std::vector<BaseVector*> keys;
+  std::vector<CompareFlags> compareFlags;
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (auto i = 0; i < keyChannels.size(); ++i) {
+    keys.push_back(sample.childAt(keyChannels[i])->loadedVector());
+    compareFlags.push_back(toCompareFlags(sortOrders[i]));
+    names.push_back(sample.type()->asRow().nameOf(keyChannels[i]));
+    types.push_back(keys.back()->type());
+  }
+
+  std::vector<vector_size_t> sortedRows(sample.size());
+  std::iota(sortedRows.begin(), sortedRows.end(), 0);
+  std::sort(
+      sortedRows.begin(),
+      sortedRows.end(),
+      [&](vector_size_t left, vector_size_t right) {
+        for (auto i = 0; i < keys.size(); ++i) {
+          const auto result =
+              keys[i]->compare(keys[i], left, right, compareFlags[i]).value();
+          if (result != 0) {
+            return result < 0;
+          }
+        }
+        return false;
+      });
+
+  const vector_size_t numSplitters = numPartitions - 1;
+  std::vector<VectorPtr> columns;
+  columns.reserve(keys.size());
+  for (auto i = 0; i < keys.size(); ++i) {
+    auto column = BaseVector::create(types[i], numSplitters, pool);
+    for (auto splitter = 0; splitter < numSplitters; ++splitter) {
+      const auto rank =
+          static_cast<int64_t>(splitter + 1) * sample.size() / numPartitions;
+      column->copy(keys[i], splitter, sortedRows[rank], 1);
+    }
+    columns.push_back(std::move(column));
+  }
+  return std::make_shared<RowVector>(
+      pool,
+      ROW(std::move(names), std::move(types)),
+      nullptr,
+      numSplitters,
+      std::move(columns));
+}
+
+RangePartitionFunctionSpec::RangePartitionFunctionSpec(
+    RowTypePtr inputType,
+    std::vector<column_index_t> keyChannels,
+    std::vector<core::SortOrder> sortOrders,
+    RowVectorPtr splitters)
+    : inputType_{std::move(inputType)},
+      keyChannels_{std::move(keyChannels)},
+      sortOrders_{std::move(sortOrders)},
+      splitters_{std::move(splitters)} {
+  VELOX_CHECK_EQ(keyChannels_.size(), sortOrders_.size());
+  VELOX_CHECK_NOT_NULL(splitters_);
+}
+
+std::unique_ptr<core::PartitionFunction> RangePartitionFunctionSpec::create(
+    int numPartitions) const {
+  VELOX_CHECK_EQ(
+      numPartitions,
+      splitters_->size() + 1,
+      "Range partitioning needs one splitter less than partitions");
+  return std::make_unique<RangePartitionFunction>(
+      keyChannels_, sortOrders_, splitters_);
+}
+
+std::string RangePartitionFunctionSpec::toString() const {
+  std::ostringstream keys;
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    if (i > 0) {
+      keys << ", ";
+    }
+    keys << inputType_->nameOf(keyChannels_[i]) << " "
+         << sortOrders_[i].toString();
+  }
+  return fmt::format("RANGE({}) {} splitters", keys.str(), splitters_->size());
+}
+
+folly::dynamic RangePartitionFunctionSpec::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["name"] = "RangePartitionFunctionSpec";
+  obj["inputType"] = inputType_->serialize();
+  obj["keyChannels"] = ISerializable::serialize(keyChannels_);
+  folly::dynamic sortOrders = folly::dynamic::array;
+  for (const auto& sortOrder : sortOrders_) {
+    sortOrders.push_back(sortOrder.serialize());
+  }
+  obj["sortOrders"] = std::move(sortOrders);
+  std::ostringstream out;
+  saveVector(*splitters_, out);
+  const auto serialized = out.str();
+  obj["splitters"] =
+      encoding::Base64::encode(serialized.data(), serialized.size());
+  return obj;
+}
+
+// static
+core::PartitionFunctionSpecPtr RangePartitionFunctionSpec::deserialize(
+    const folly::dynamic& obj,
+    void* context) {
+  const auto keys = ISerializable::deserialize<std::vector<column_index_t>>(
+      obj["keyChannels"], context);
+  std::vector<core::SortOrder> sortOrders;
+  for (const auto& sortOrder : obj["sortOrders"]) {
+    sortOrders.push_back(core::SortOrder::deserialize(sortOrder));
+  }
+  std::istringstream dataStream(
+      encoding::Base64::decode(obj["splitters"].asString()));
+  auto* pool = static_cast<memory::MemoryPool*>(context);
+  auto splitters =
+      std::dynamic_pointer_cast<RowVector>(restoreVector(dataStream, pool));
+  VELOX_CHECK_NOT_NULL(splitters);
+  return std::make_shared<RangePartitionFunctionSpec>(
+      ISerializable::deserialize<RowType>(obj["inputType"]),
+      keys,
+      std::move(sortOrders),
+      std::move(splitters));
+}
+} // namespace facebook::velox::exec
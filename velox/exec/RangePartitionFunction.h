@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/PlanNode.h"
+
+namespace facebook::velox::exec {
+
+/// Calculates partition number for each row of the specified vector from
+/// ranges of the sort keys. 'splitters' has one row per partition boundary,
+/// ordered by 'sortOrders', and one column per key in 'keyChannels'. Partition
+/// 'i' gets the rows that sort after splitter 'i - 1' and not after splitter
+/// 'i', so a function with 'n' splitters makes 'n + 1' partitions.
+///
+/// When each partition is sorted by the same keys, e.g. by an OrderBy in each
+/// of several drivers or tasks, the range partitions are disjoint and
+/// concatenating the sorted partitions in partition order produces a globally
+/// sorted result without a single threaded merge.
+///
+/// When all keys are supported by row::KeyEncoder, the splitters are encoded
+/// once into normalized keys and each input row is routed by a binary search
+/// of its normalized key with memcmp instead of comparing vectors key by key.
+class RangePartitionFunction : public core::PartitionFunction {
+ public:
+  RangePartitionFunction(
+      const std::vector<column_index_t>& keyChannels,
+      const std::vector<core::SortOrder>& sortOrders,
+      RowVectorPtr splitters);
+
+  std::optional<uint32_t> partition(
+      const RowVector& input,
+      std::vector<uint32_t>& partitions) override;
+
+  int numPartitions() const {
+    return splitters_->size() + 1;
+  }
+
+  /// Picks 'numPartitions - 1' splitters at evenly spaced ranks of 'sample'
+  /// sorted by 'keyChannels' and 'sortOrders'. The returned vector has one
+  /// column per key and can be passed to the constructor. 'sample' should be
+  /// a random sample of the input to partition for the ranges to be even.
+  static RowVectorPtr makeSplitters(
+      const RowVector& sample,
+      const std::vector<column_index_t>& keyChannels,
+      const std::vector<core::SortOrder>& sortOrders,
+      int numPartitions,
+      memory::MemoryPool* pool);
+
+ private:
+  // Compares the keys of 'row' in 'input' with splitter 'splitter'.
+  int32_t compareWithSplitter(
+      const std::vector<BaseVector*>& keys,
+      vector_size_t row,
+      vector_size_t splitter) const;
+
+  // Sets 'partitions' from the normalized keys of 'input'.
+  void partitionByNormalizedKeys(
+      const RowVector& input,
+      std::vector<uint32_t>& partitions);
+
+  const std::vector<column_index_t> keyChannels_;
+  std::vector<CompareFlags> compareFlags_;
+  const RowVectorPtr splitters_;
+
+  // Normalized keys of 'splitters_' in splitter order. Empty if a key type is
+  // not supported by row::KeyEncoder.
+  std::vector<std::string> splitterKeys_;
+
+  // Reusable memory.
+  std::vector<BaseVector*> keys_;
+  std::vector<std::string> rowKeys_;
+};
+
+/// Factory class to create RangePartitionFunction. 'splitters' must have one
+/// row less than the number of partitions the function is created for.
+class RangePartitionFunctionSpec : public core::PartitionFunctionSpec {
+ public:
+  RangePartitionFunctionSpec(
+      RowTypePtr inputType,
+      std::vector<column_index_t> keyChannels,
+      std::vector<core::SortOrder> sortOrders,
+      RowVectorPtr splitters);
+
+  std::unique_ptr<core::PartitionFunction> create(
+      int numPartitions) const override;
+
+  std::string toString() const override;
+
+  folly::dynamic serialize() const override;
+
+  static core::PartitionFunctionSpecPtr deserialize(
+      const folly::dynamic& obj,
+      void* context);
+
+ private:
+  const RowTypePtr inputType_;
+  const std::vector<column_index_t> keyChannels_;
+  const std::vector<core::SortOrder> sortOrders_;
+  const RowVectorPtr splitters_;
+};
+} // namespace facebook::velox::exec
@@ -129,9 +129,12 @@ RowContainer::RowContainer(
       accumulators_(accumulators),
       hasNormalizedKeys_(hasNormalizedKeys),
       rows_(pool),
+      // Accumulators make and free many small blocks, e.g. for array_agg and
+      // map_agg. Reuse these without coalescing.
       stringAllocator_(
           stringAllocator ? stringAllocator
-                          : std::make_shared<HashStringAllocator>(pool)) {
+                          : std::make_shared<HashStringAllocator>(
+                                pool, !accumulators.empty())) {
   // Compute the layout of the payload row.  The row has keys, null
   // flags, accumulators, dependent fields. All fields are fixed
   // width. If variable width data is referenced, this is done with
@@ -142,13 +145,14 @@ RowContainer::RowContainer(
   // field follows.  If hasProbedFlag is true, there is an extra bit
   // to track if the row has been selected by a hash join probe. This
   // is followed by a free bit which is set if the row is in a free
-  // list. The accumulators come next, with size given by
-  // Aggregate::accumulatorFixedWidthSize(). Dependent fields follow.
+  // list. If this is a hash join build side, the pointer to the next row
+  // with the same key follows the flags, so that a probe reads the keys,
+  // the probed flag and the next pointer from the start of the row and does
+  // not touch the payload of wide rows. The accumulators come next, with size
+  // given by Aggregate::accumulatorFixedWidthSize(). Dependent fields follow.
   // These are non-key columns for hash join or order by. If there are variable
   // length columns or accumulators, i.e. ones that allocate extra space, this
-  // space is tracked by a uint32_t after the dependent columns. If this is a
-  // hash join build side, the pointer to the next row with the same key is
-  // after the optional row size.
+  // space is tracked by a uint32_t after the dependent columns.
   //
   // In most cases, rows are prefixed with a normalized_key_t at index
   // -1, 8 bytes below the pointer. This space is reserved for a 64
@@ -205,6 +209,10 @@ RowContainer::RowContainer(
   }
   int32_t nullBytes = bits::nbytes(nullOffsets_.size());
   offset += nullBytes;
+  if (hasNext) {
+    nextOffset_ = offset;
+    offset += sizeof(void*);
+  }
   for (const auto& accumulator : accumulators) {
     // Accumulator offset must be aligned by their alignment size.
     offset = bits::roundUp(offset, accumulator.alignment());
@@ -219,10 +227,6 @@ RowContainer::RowContainer(
     rowSizeOffset_ = offset;
     offset += sizeof(uint32_t);
   }
-  if (hasNext) {
-    nextOffset_ = offset;
-    offset += sizeof(void*);
-  }
   fixedRowSize_ = bits::roundUp(offset, alignment_);
   for (int i = 0; i < accumulators_.size(); ++i) {
     nullOffset = nullOffsets_[i + firstAggregate];
@@ -39,7 +39,7 @@ RowNumber::RowNumber(
 
   if (numKeys > 0) {
     table_ = std::make_unique<HashTable<false>>(
-        createVectorHashers(inputType, keys),
+        createVectorHashers(inputType, keys, pool()),
         std::vector<Accumulator>{},
         std::vector<TypePtr>{BIGINT()},
         false, // allowDuplicates
@@ -404,7 +404,9 @@ void RowNumber::setupHashTableSpiller() {
       spillConfig.minSpillRunSize,
       spillConfig.compressionKind,
       memory::spillMemoryPool(),
-      spillConfig.executor);
+      spillConfig.executor,
+      spillConfig.overflowTier,
+      spillConfig.fileFormat);
 }
 
 void RowNumber::setupInputSpiller() {
@@ -422,7 +424,9 @@ void RowNumber::setupInputSpiller() {
       spillConfig.minSpillRunSize,
       spillConfig.compressionKind,
       memory::spillMemoryPool(),
-      spillConfig.executor);
+      spillConfig.executor,
+      spillConfig.overflowTier,
+      spillConfig.fileFormat);
 
   const auto& hashers = table_->hashers();
 
@@ -142,6 +142,43 @@ class SimpleAggregateAdapter : public Aggregate {
   struct support_to_intermediate<T, std::void_t<decltype(&T::toIntermediate)>>
       : std::true_type {};
 
+  // Whether the function defines its addInputBatch() method or not. If it is
+  // defined, addRawInput() passes runs of consecutive rows to
+  // addInputBatch() when all inputs are flat without nulls. See
+  // add_input_batch_ for the other requirements.
+  template <typename T, typename = void>
+  struct support_add_input_batch : std::false_type {};
+
+  template <typename T>
+  struct support_add_input_batch<T, std::void_t<decltype(&T::addInputBatch)>>
+      : std::true_type {};
+
+  // Same as support_add_input_batch for addSingleGroupInputBatch(), which is
+  // used by addSingleGroupRawInput().
+  template <typename T, typename = void>
+  struct support_add_single_group_input_batch : std::false_type {};
+
+  template <typename T>
+  struct support_add_single_group_input_batch<
+      T,
+      std::void_t<decltype(&T::addSingleGroupInputBatch)>> : std::true_type {};
+
+  // Batch methods receive the input values as arrays, which is possible for
+  // fixed-width primitive types except bool that is stored as bits.
+  template <typename T>
+  struct is_batch_input_type
+      : std::integral_constant<
+            bool,
+            std::is_arithmetic_v<T> && !std::is_same_v<T, bool>> {};
+
+  template <std::size_t... Is>
+  static constexpr bool inputsSupportBatch(std::index_sequence<Is...>) {
+    return (
+        is_batch_input_type<
+            typename FUNC::InputType::template type_at<Is>>::value &&
+        ...);
+  }
+
   static constexpr bool aggregate_default_null_behavior_ =
       aggregate_default_null_behavior<FUNC>::value;
 
@@ -157,6 +194,17 @@ class SimpleAggregateAdapter : public Aggregate {
   static constexpr bool support_to_intermediate_ =
       support_to_intermediate<FUNC>::value;
 
+  // The batch methods only see rows without nulls and do not track the size
+  // of variable width accumulators.
+  static constexpr bool add_input_batch_ = aggregate_default_null_behavior_ &&
+      accumulator_is_fixed_size_ && support_add_input_batch<FUNC>::value &&
+      inputsSupportBatch(std::make_index_sequence<FUNC::InputType::size_>{});
+
+  static constexpr bool add_single_group_input_batch_ =
+      aggregate_default_null_behavior_ && accumulator_is_fixed_size_ &&
+      support_add_single_group_input_batch<FUNC>::value &&
+      inputsSupportBatch(std::make_index_sequence<FUNC::InputType::size_>{});
+
   bool isFixedSize() const override {
     return accumulator_is_fixed_size_;
   }
@@ -194,6 +242,13 @@ class SimpleAggregateAdapter : public Aggregate {
       inputDecoded_[i].decode(*args[i], rows);
     }
 
+    if constexpr (add_input_batch_) {
+      if (canAddInputBatch(args.size())) {
+        addRawInputBatch(
+            groups, rows, std::make_index_sequence<FUNC::InputType::size_>{});
+        return;
+      }
+    }
     addRawInputImpl(
         groups, rows, std::make_index_sequence<FUNC::InputType::size_>{});
   }
@@ -212,6 +267,13 @@ class SimpleAggregateAdapter : public Aggregate {
       inputDecoded_[i].decode(*args[i], rows);
     }
 
+    if constexpr (add_single_group_input_batch_) {
+      if (canAddInputBatch(args.size())) {
+        addSingleGroupRawInputBatch(
+            group, rows, std::make_index_sequence<FUNC::InputType::size_>{});
+        return;
+      }
+    }
     addSingleGroupRawInputImpl(
         group, rows, std::make_index_sequence<FUNC::InputType::size_>{});
   }
@@ -341,6 +403,79 @@ class SimpleAggregateAdapter : public Aggregate {
   }
 
  private:
+  // Returns true if the decoded inputs are flat without nulls, so that a run
+  // of consecutive rows is a range of each input's values.
+  bool canAddInputBatch(column_index_t numArgs) const {
+    for (column_index_t i = 0; i < numArgs; ++i) {
+      if (!inputDecoded_[i].isIdentityMapping() ||
+          inputDecoded_[i].mayHaveNulls()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Calls 'func(begin, end)' for each run of consecutive selected rows.
+  template <typename Func>
+  static void forEachSelectedRange(const SelectivityVector& rows, Func func) {
+    if (rows.isAllSelected()) {
+      func(rows.begin(), rows.end());
+      return;
+    }
+    const auto* selected = rows.asRange().bits();
+    auto begin = bits::findFirstBit(selected, rows.begin(), rows.end());
+    while (begin >= 0) {
+      auto end = begin + 1;
+      while (end < rows.end() && bits::isBitSet(selected, end)) {
+        ++end;
+      }
+      func(begin, end);
+      begin = bits::findFirstBit(selected, end, rows.end());
+    }
+  }
+
+  template <std::size_t... Is>
+  void addRawInputBatch(
+      char** groups,
+      const SelectivityVector& rows,
+      std::index_sequence<Is...>) {
+    forEachSelectedRange(rows, [&](vector_size_t begin, vector_size_t end) {
+      batchAccumulators_.resize(end - begin);
+      for (auto row = begin; row < end; ++row) {
+        batchAccumulators_[row - begin] =
+            value<typename FUNC::AccumulatorType>(groups[row]);
+        clearNull(groups[row]);
+      }
+      FUNC::addInputBatch(
+          allocator_,
+          batchAccumulators_.data(),
+          end - begin,
+          inputDecoded_[Is]
+                  .template data<
+                      typename FUNC::InputType::template type_at<Is>>() +
+              begin...);
+    });
+  }
+
+  template <std::size_t... Is>
+  void addSingleGroupRawInputBatch(
+      char* group,
+      const SelectivityVector& rows,
+      std::index_sequence<Is...>) {
+    auto accumulator = value<typename FUNC::AccumulatorType>(group);
+    forEachSelectedRange(rows, [&](vector_size_t begin, vector_size_t end) {
+      FUNC::addSingleGroupInputBatch(
+          allocator_,
+          *accumulator,
+          end - begin,
+          inputDecoded_[Is]
+                  .template data<
+                      typename FUNC::InputType::template type_at<Is>>() +
+              begin...);
+      clearNull(group);
+    });
+  }
+
   template <std::size_t... Is>
   void addRawInputImpl(
       char** groups,
@@ -544,6 +679,9 @@ class SimpleAggregateAdapter : public Aggregate {
 
   std::vector<DecodedVector> inputDecoded_;
   DecodedVector intermediateDecoded_;
+
+  // Reusable memory for the accumulators passed to addInputBatch().
+  raw_vector<typename FUNC::AccumulatorType*> batchAccumulators_;
 };
 
 } // namespace facebook::velox::exec
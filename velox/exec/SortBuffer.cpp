@@ -16,6 +16,7 @@
 
 #include "SortBuffer.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/vector/BaseVector.h"
 
 namespace facebook::velox::exec {
@@ -29,7 +30,8 @@ SortBuffer::SortBuffer(
     tsan_atomic<bool>* nonReclaimableSection,
     uint32_t* numSpillRuns,
     const common::SpillConfig* spillConfig,
-    uint64_t spillMemoryThreshold)
+    uint64_t spillMemoryThreshold,
+    bool prefixSortEnabled)
     : input_(input),
       sortCompareFlags_(sortCompareFlags),
       outputBatchSize_(outputBatchSize),
@@ -37,7 +39,8 @@ SortBuffer::SortBuffer(
       nonReclaimableSection_(nonReclaimableSection),
       numSpillRuns_(numSpillRuns),
       spillConfig_(spillConfig),
-      spillMemoryThreshold_(spillMemoryThreshold) {
+      spillMemoryThreshold_(spillMemoryThreshold),
+      prefixSortEnabled_(prefixSortEnabled) {
   VELOX_CHECK_GE(input_->size(), sortCompareFlags_.size());
   VELOX_CHECK_GT(sortCompareFlags_.size(), 0);
   VELOX_CHECK_EQ(sortColumnIndices.size(), sortCompareFlags_.size());
@@ -118,19 +121,29 @@ void SortBuffer::noMoreInput() {
     sortedRows_.resize(numInputRows_);
     RowContainerIterator iter;
     data_->listRows(&iter, numInputRows_, sortedRows_.data());
-    std::sort(
-        sortedRows_.begin(),
-        sortedRows_.end(),
-        [this](const char* leftRow, const char* rightRow) {
-          for (vector_size_t index = 0; index < sortCompareFlags_.size();
-               ++index) {
-            if (auto result = data_->compare(
-                    leftRow, rightRow, index, sortCompareFlags_[index])) {
-              return result < 0;
+    if (prefixSortEnabled_) {
+      // The sort keys are the leading columns of 'data_'.
+      std::vector<std::pair<column_index_t, CompareFlags>> keys;
+      keys.reserve(sortCompareFlags_.size());
+      for (column_index_t i = 0; i < sortCompareFlags_.size(); ++i) {
+        keys.emplace_back(i, sortCompareFlags_[i]);
+      }
+      PrefixSort::sort(data_.get(), keys, sortedRows_);
+    } else {
+      std::sort(
+          sortedRows_.begin(),
+          sortedRows_.end(),
+          [this](const char* leftRow, const char* rightRow) {
+            for (vector_size_t index = 0; index < sortCompareFlags_.size();
+                 ++index) {
+              if (auto result = data_->compare(
+                      leftRow, rightRow, index, sortCompareFlags_[index])) {
+                return result < 0;
+              }
             }
-          }
-          return false;
-        });
+            return false;
+          });
+    }
   } else {
     // Finish spill, and we shouldn't get any rows from non-spilled partition as
     // there is only one hash partition for SortBuffer.
@@ -187,7 +200,9 @@ void SortBuffer::spill(int64_t targetRows, int64_t targetBytes) {
         spillConfig_->minSpillRunSize,
         spillConfig_->compressionKind,
         memory::spillMemoryPool(),
-        spillConfig_->executor);
+        spillConfig_->executor,
+        spillConfig_->overflowTier,
+        spillConfig_->fileFormat);
     VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
   }
 
@@ -248,6 +263,25 @@ void SortBuffer::ensureInputFits(const VectorPtr& input) {
     return;
   }
 
+  // Reserves the forecast memory usage of all the input rows in one request
+  // once the row size is known, including the row pointers used for sorting.
+  // If the reservation is denied, spills all the rows proactively.
+  if (!forecastReserved_ && estimatedNumRows_.has_value()) {
+    forecastReserved_ = true;
+    if (estimatedNumRows_.value() > numRows) {
+      const int64_t forecastBytes = (estimatedNumRows_.value() - numRows) *
+          (data_->fixedRowSize() + outOfLineBytesPerRow + sizeof(char*));
+      {
+        exec::ReclaimableSectionGuard guard(nonReclaimableSection_);
+        if (pool_->maybeReserve(forecastBytes)) {
+          return;
+        }
+      }
+      spill(0, 0);
+      return;
+    }
+  }
+
   // If we have enough free rows for input rows and enough variable length
   // free space for the vector's flat size, no need for spilling.
   if (freeRows > input->size() &&
@@ -39,7 +39,8 @@ class SortBuffer {
       tsan_atomic<bool>* nonReclaimableSection,
       uint32_t* numSpillRuns,
       const common::SpillConfig* spillConfig = nullptr,
-      uint64_t spillMemoryThreshold = 0);
+      uint64_t spillMemoryThreshold = 0,
+      bool prefixSortEnabled = false);
 
   void addInput(const VectorPtr& input);
 
@@ -52,6 +53,13 @@ class SortBuffer {
   /// Returns the sorted output rows in batch.
   RowVectorPtr getOutput();
 
+  /// Sets the estimated number of input rows. If set, the sort buffer
+  /// reserves the forecast memory usage of all the input rows in one request,
+  /// and spills proactively if the reservation is denied.
+  void setEstimatedNumRows(std::optional<uint64_t> estimatedNumRows) {
+    estimatedNumRows_ = estimatedNumRows;
+  }
+
   /// Invoked to spill from 'data_' to disk with specified targets.
   ///
   /// NOTE: if either 'targetRows' or 'targetBytes' is zero, then we spill all
@@ -91,6 +99,8 @@ class SortBuffer {
   //
   // NOTE: 'spillMemoryThreshold_' only applies if disk spilling is enabled.
   const uint64_t spillMemoryThreshold_;
+  // If true, the in-memory rows are sorted with PrefixSort.
+  const bool prefixSortEnabled_;
 
   // The column projection map between 'input_' and 'spillerStoreType_' as sort
   // buffer stores the sort columns first in 'data_'.
@@ -116,6 +126,11 @@ class SortBuffer {
   std::vector<vector_size_t> spillSourceRows_;
   // Counts input batches to trigger spilling for test.
   uint64_t spillTestCounter_{0};
+  // The estimated number of input rows set by setEstimatedNumRows().
+  std::optional<uint64_t> estimatedNumRows_;
+  // True if the reservation of the forecast memory usage from
+  // 'estimatedNumRows_' has been tried.
+  bool forecastReserved_{false};
 
   // Reusable output vector.
   RowVectorPtr output_;
@@ -15,13 +15,15 @@
  */
 
 #include "velox/exec/SortWindowBuild.h"
+#include "velox/exec/PrefixSort.h"
 
 namespace facebook::velox::exec {
 
 SortWindowBuild::SortWindowBuild(
     const std::shared_ptr<const core::WindowNode>& windowNode,
-    velox::memory::MemoryPool* pool)
-    : WindowBuild(windowNode, pool) {
+    velox::memory::MemoryPool* pool,
+    bool prefixSortEnabled)
+    : WindowBuild(windowNode, pool), prefixSortEnabled_(prefixSortEnabled) {
   allKeyInfo_.reserve(partitionKeyInfo_.size() + sortKeyInfo_.size());
   allKeyInfo_.insert(
       allKeyInfo_.cend(), partitionKeyInfo_.begin(), partitionKeyInfo_.end());
@@ -80,12 +82,23 @@ void SortWindowBuild::sortPartitions() {
   RowContainerIterator iter;
   data_->listRows(&iter, numRows_, sortedRows_.data());
 
-  std::sort(
-      sortedRows_.begin(),
-      sortedRows_.end(),
-      [this](const char* leftRow, const char* rightRow) {
-        return compareRowsWithKeys(leftRow, rightRow, allKeyInfo_);
-      });
+  if (prefixSortEnabled_) {
+    std::vector<std::pair<column_index_t, CompareFlags>> keys;
+    keys.reserve(allKeyInfo_.size());
+    for (const auto& [column, sortOrder] : allKeyInfo_) {
+      keys.emplace_back(
+          column,
+          CompareFlags{sortOrder.isNullsFirst(), sortOrder.isAscending()});
+    }
+    PrefixSort::sort(data_.get(), keys, sortedRows_);
+  } else {
+    std::sort(
+        sortedRows_.begin(),
+        sortedRows_.end(),
+        [this](const char* leftRow, const char* rightRow) {
+          return compareRowsWithKeys(leftRow, rightRow, allKeyInfo_);
+        });
+  }
 
   computePartitionStartRows();
 }
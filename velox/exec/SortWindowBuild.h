@@ -27,7 +27,8 @@ class SortWindowBuild : public WindowBuild {
  public:
   SortWindowBuild(
       const std::shared_ptr<const core::WindowNode>& windowNode,
-      velox::memory::MemoryPool* pool);
+      velox::memory::MemoryPool* pool,
+      bool prefixSortEnabled = false);
 
   bool needsInput() override {
     // No partitions are available yet, so can consume input rows.
@@ -59,6 +60,9 @@ class SortWindowBuild : public WindowBuild {
   // this order by the operator.
   std::vector<std::pair<column_index_t, core::SortOrder>> allKeyInfo_;
 
+  // If true, the rows are sorted with PrefixSort.
+  const bool prefixSortEnabled_;
+
   // Vector of pointers to each input row in the data_ RowContainer.
   // The rows are sorted by partitionKeys + sortKeys. This total
   // ordering can be used to split partitions (with the correct
@@ -51,6 +51,9 @@ struct RowPointers {
   }
 
   std::vector<char*> read(HashStringAllocator& allocator) {
+    if (size == 0) {
+      return {};
+    }
     ByteStream stream(&allocator);
     HashStringAllocator::prepareRead(firstBlock, stream);
 
@@ -110,8 +113,8 @@ Accumulator SortedAggregations::accumulator() const {
       sizeof(RowPointers),
       false,
       1,
-      [](folly::Range<char**> /*groups*/, VectorPtr& /*result*/) {
-        VELOX_UNREACHABLE();
+      [this](folly::Range<char**> groups, VectorPtr& result) {
+        extractForSpill(groups, result);
       },
       [this](folly::Range<char**> groups) {
         for (auto* group : groups) {
@@ -198,6 +201,79 @@ bool SortedAggregations::compareRowsWithKeys(
 
 void SortedAggregations::noMoreInput() {}
 
+TypePtr SortedAggregations::spillType() const {
+  const auto& types = inputData_->keyTypes();
+  std::vector<std::string> names;
+  for (auto i = 0; i < types.size(); ++i) {
+    names.push_back(fmt::format("i{}", i));
+  }
+  return ARRAY(ROW(std::move(names), std::vector<TypePtr>(types)));
+}
+
+void SortedAggregations::extractForSpill(
+    folly::Range<char**> groups,
+    VectorPtr& result) const {
+  auto* pool = result ? result->pool() : inputData_->pool();
+  const auto numGroups = groups.size();
+  BufferPtr offsets = allocateOffsets(numGroups, pool);
+  BufferPtr sizes = allocateSizes(numGroups, pool);
+  auto* rawOffsets = offsets->asMutable<vector_size_t>();
+  auto* rawSizes = sizes->asMutable<vector_size_t>();
+  std::vector<char*> rows;
+  for (auto i = 0; i < numGroups; ++i) {
+    const auto groupRows =
+        reinterpret_cast<RowPointers*>(groups[i] + offset_)->read(*allocator_);
+    rawOffsets[i] = rows.size();
+    rawSizes[i] = groupRows.size();
+    rows.insert(rows.end(), groupRows.begin(), groupRows.end());
+  }
+
+  const auto type = spillType();
+  const auto& rowType = type->childAt(0);
+  std::vector<VectorPtr> columns(rowType->size());
+  for (auto i = 0; i < columns.size(); ++i) {
+    columns[i] = BaseVector::create(rowType->childAt(i), rows.size(), pool);
+    inputData_->extractColumn(rows.data(), rows.size(), i, columns[i]);
+  }
+  auto elements = std::make_shared<RowVector>(
+      pool, rowType, nullptr, rows.size(), std::move(columns));
+  result = std::make_shared<ArrayVector>(
+      pool, type, nullptr, numGroups, offsets, sizes, std::move(elements));
+}
+
+void SortedAggregations::addSingleGroupSpillInput(
+    char* group,
+    const VectorPtr& input,
+    vector_size_t index) {
+  decodedSpillInput_.decode(*input);
+  const auto* arrayVector =
+      decodedSpillInput_.base()->asUnchecked<ArrayVector>();
+  const auto arrayIndex = decodedSpillInput_.index(index);
+  const auto offset = arrayVector->offsetAt(arrayIndex);
+  const auto size = arrayVector->sizeAt(arrayIndex);
+  const auto* elements =
+      arrayVector->elements()->loadedVector()->asUnchecked<RowVector>();
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    decodedInputs_[i].decode(*elements->childAt(i));
+  }
+
+  for (auto row = offset; row < offset + size; ++row) {
+    char* newRow = inputData_->newRow();
+    for (auto i = 0; i < inputs_.size(); ++i) {
+      inputData_->store(decodedInputs_[i], row, newRow, i);
+    }
+    addNewRow(group, newRow);
+  }
+}
+
+void SortedAggregations::eraseInputs(folly::Range<char**> groups) {
+  for (auto* group : groups) {
+    auto groupRows =
+        reinterpret_cast<RowPointers*>(group + offset_)->read(*allocator_);
+    inputData_->eraseRows(folly::Range(groupRows.data(), groupRows.size()));
+  }
+}
+
 void SortedAggregations::sortSingleGroup(
     std::vector<char*>& groupRows,
     const AggregateInfo& aggregate) {
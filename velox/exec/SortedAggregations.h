@@ -64,6 +64,21 @@ class SortedAggregations {
 
   void noMoreInput();
 
+  /// Returns the type of the column that holds the input rows of a group when
+  /// spilling. The column is an array of rows with one field per input.
+  TypePtr spillType() const;
+
+  /// Adds the input rows of 'group' from the spilled array at 'index' of
+  /// 'input'. 'input' is of spillType().
+  void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index);
+
+  /// Frees the input rows of 'groups'. Called before the groups are erased,
+  /// e.g. after they are spilled.
+  void eraseInputs(folly::Range<char**> groups);
+
   /// Sorts input row for the specified groups, computes aggregations and stores
   /// results in the specified 'result' vector.
   void extractValues(folly::Range<char**> groups, const RowVectorPtr& result);
@@ -84,6 +99,10 @@ class SortedAggregations {
       std::vector<char*>& groupRows,
       const AggregateInfo& aggregate);
 
+  // Writes the input rows of 'groups' to 'result' as a vector of
+  // spillType().
+  void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const;
+
   const std::vector<AggregateInfo*> aggregates_;
 
   /// Indices of all inputs for all aggregates.
@@ -94,6 +113,7 @@ class SortedAggregations {
   std::vector<column_index_t> inputMapping_;
 
   std::vector<DecodedVector> decodedInputs_;
+  DecodedVector decodedSpillInput_;
 
   HashStringAllocator* allocator_;
   int32_t offset_;
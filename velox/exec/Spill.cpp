@@ -15,10 +15,18 @@
  */
 
 #include "velox/exec/Spill.h"
+#include <gflags/gflags.h>
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/process/TraceContext.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/OperatorUtils.h"
+#include "velox/row/KeyEncoder.h"
 #include "velox/serializers/PrestoSerializer.h"
+#include "velox/serializers/SpillSerializer.h"
+
+DECLARE_bool(velox_local_file_mmap);
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -31,6 +39,27 @@ namespace {
 // preserves precision.
 static const bool kDefaultUseLosslessTimestamp = true;
 
+// Returns the serde for spill files of 'fileFormat'. The Presto format uses the
+// registered default serde.
+VectorSerde* spillSerde(common::SpillFileFormat fileFormat) {
+  if (fileFormat == common::SpillFileFormat::kColumnar) {
+    static serializer::SpillVectorSerde serde;
+    return &serde;
+  }
+  return getVectorSerde();
+}
+
+std::unique_ptr<VectorSerde::Options> spillSerdeOptions(
+    common::SpillFileFormat fileFormat,
+    common::CompressionKind compressionKind) {
+  if (fileFormat == common::SpillFileFormat::kColumnar) {
+    return std::make_unique<serializer::SpillVectorSerde::SpillOptions>(
+        compressionKind);
+  }
+  return std::make_unique<serializer::presto::PrestoVectorSerde::PrestoOptions>(
+      kDefaultUseLosslessTimestamp, compressionKind);
+}
+
 std::vector<folly::Synchronized<SpillStats>>& allSpillStats() {
   static std::vector<folly::Synchronized<SpillStats>> spillStatsList(
       std::thread::hardware_concurrency());
@@ -46,12 +75,65 @@ folly::Synchronized<SpillStats>& localSpillStats() {
 
 std::atomic<int32_t> SpillFile::ordinalCounter_;
 
+SpillInput::~SpillInput() {
+  if (readAhead_ == nullptr) {
+    return;
+  }
+  // Waits for the pending read so that it does not outlive 'this'. This is in
+  // a destructor and must not throw.
+  try {
+    readAhead_->move();
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Error in spill file read ahead: " << e.what();
+  }
+}
+
 void SpillInput::next(bool /*throwIfPastEnd*/) {
-  int32_t readBytes = std::min(input_->size() - offset_, buffer_->capacity());
-  VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
-  setRange({buffer_->asMutable<uint8_t>(), readBytes, 0});
-  input_->pread(offset_, readBytes, buffer_->asMutable<char>());
-  offset_ += readBytes;
+  if (readAhead_ != nullptr) {
+    auto readAhead = std::move(readAhead_);
+    auto result = readAhead->move();
+    VELOX_CHECK_NOT_NULL(result);
+    std::swap(buffer_, readAheadBuffer_);
+    setRange({buffer_->asMutable<uint8_t>(), result->size, 0});
+    offset_ += result->size;
+  } else {
+    int32_t readBytes = std::min(input_->size() - offset_, buffer_->capacity());
+    VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
+    // A mapped file is read in place. The kernel reads ahead, so there is no
+    // read ahead into a second buffer.
+    const auto mapped =
+        input_->mappedRegion({offset_, static_cast<uint64_t>(readBytes)});
+    if (!mapped.empty()) {
+      setRange(
+          {reinterpret_cast<uint8_t*>(const_cast<char*>(mapped.data())),
+           readBytes,
+           0});
+      offset_ += readBytes;
+      return;
+    }
+    setRange({buffer_->asMutable<uint8_t>(), readBytes, 0});
+    input_->pread(offset_, readBytes, buffer_->asMutable<char>());
+    offset_ += readBytes;
+  }
+  startReadAhead();
+}
+
+void SpillInput::startReadAhead() {
+  if (executor_ == nullptr || offset_ >= size_) {
+    return;
+  }
+  if (readAheadBuffer_ == nullptr) {
+    readAheadBuffer_ =
+        AlignedBuffer::allocate<char>(buffer_->capacity(), pool_);
+  }
+  const int32_t readBytes =
+      std::min(size_ - offset_, readAheadBuffer_->capacity());
+  readAhead_ = std::make_shared<AsyncSource<ReadAhead>>(
+      [this, offset = offset_, readBytes]() {
+        input_->pread(offset, readBytes, readAheadBuffer_->asMutable<char>());
+        return std::make_unique<ReadAhead>(ReadAhead{readBytes});
+      });
+  executor_->add([source = readAhead_]() { source->prepare(); });
 }
 
 void SpillMergeStream::pop() {
@@ -60,11 +142,75 @@ void SpillMergeStream::pop() {
   }
 }
 
+void SpillMergeStream::initializePrefixKeys() {
+  prefixKeysInitialized_ = true;
+  if (!usePrefixes_) {
+    return;
+  }
+  const auto& type = rowVector_->type()->asRow();
+  int32_t prefixBytes = 0;
+  for (auto key = 0; key < numSortingKeys(); ++key) {
+    const auto valueBytes = row::KeyEncoder::fixedSize(type.childAt(key));
+    if (valueBytes == 0 ||
+        prefixBytes + 1 + valueBytes > kMaxPrefixBytes) {
+      break;
+    }
+    prefixBytes += 1 + valueBytes;
+    ++numPrefixKeys_;
+  }
+  numPrefixWords_ = bits::nwords(prefixBytes * 8);
+}
+
+void SpillMergeStream::encodePrefixes() {
+  if (size_ == 0) {
+    return;
+  }
+  if (!prefixKeysInitialized_) {
+    initializePrefixKeys();
+  }
+  if (numPrefixWords_ == 0) {
+    return;
+  }
+  ensureDecodedValid(numPrefixKeys_ - 1);
+  prefixes_.assign(size_ * numPrefixWords_, 0);
+  auto* out = reinterpret_cast<char*>(prefixes_.data());
+  const int32_t stride = numPrefixWords_ * sizeof(uint64_t);
+  const auto& type = rowVector_->type()->asRow();
+  for (auto key = 0; key < numPrefixKeys_; ++key) {
+    const auto flags =
+        sortCompareFlags().empty() ? CompareFlags() : sortCompareFlags()[key];
+    row::KeyEncoder::encodeFixedWidth(
+        decoded_[key], type.childAt(key), flags, size_, stride, out);
+    out += 1 + row::KeyEncoder::fixedSize(type.childAt(key));
+  }
+  // Loading the words big endian makes integer comparison match memcmp on
+  // the prefix bytes.
+  for (auto& word : prefixes_) {
+    word = folly::Endian::big(word);
+  }
+}
+
 int32_t SpillMergeStream::compare(const MergeStream& other) const {
   auto& otherStream = static_cast<const SpillMergeStream&>(other);
+  int32_t key = 0;
+  if (numPrefixWords_ > 0 && otherStream.numPrefixWords_ == numPrefixWords_) {
+    const auto* prefix = prefixes_.data() + index_ * numPrefixWords_;
+    const auto* otherPrefix =
+        otherStream.prefixes_.data() + otherStream.index_ * numPrefixWords_;
+    for (auto word = 0; word < numPrefixWords_; ++word) {
+      if (prefix[word] != otherPrefix[word]) {
+        return prefix[word] < otherPrefix[word] ? -1 : 1;
+      }
+    }
+    // The prefix encodes its keys exactly, so only the keys after it need
+    // comparing.
+    key = numPrefixKeys_;
+    if (key == numSortingKeys()) {
+      return 0;
+    }
+  }
   auto& children = rowVector_->children();
   auto& otherChildren = otherStream.current().children();
-  int32_t key = 0;
   if (sortCompareFlags().empty()) {
     do {
       auto result = children[key]
@@ -101,14 +247,18 @@ SpillFile::SpillFile(
     const std::vector<CompareFlags>& sortCompareFlags,
     const std::string& path,
     common::CompressionKind compressionKind,
-    memory::MemoryPool* pool)
+    memory::MemoryPool* pool,
+    folly::Executor* executor,
+    common::SpillFileFormat fileFormat)
     : type_(std::move(type)),
       numSortingKeys_(numSortingKeys),
       sortCompareFlags_(sortCompareFlags),
       ordinal_(ordinalCounter_++),
       path_(fmt::format("{}-{}", path, ordinal_)),
       compressionKind_(compressionKind),
-      pool_(pool) {
+      pool_(pool),
+      executor_(executor),
+      fileFormat_(fileFormat) {
   // NOTE: if the spilling operator has specified the sort comparison flags,
   // then it must match the number of sorting keys.
   VELOX_CHECK(
@@ -129,19 +279,25 @@ void SpillFile::startRead() {
   VELOX_CHECK(!output_);
   VELOX_CHECK(!input_);
   auto fs = filesystems::getFileSystem(path_, nullptr);
-  auto file = fs->openFileForRead(path_);
+  filesystems::FileOptions options;
+  if (FLAGS_velox_local_file_mmap) {
+    // Spill files are read front to back.
+    options.values[filesystems::FileOptions::kLocalMmap] = "sequential";
+  }
+  auto file = fs->openFileForRead(path_, options);
   auto buffer = AlignedBuffer::allocate<char>(
       std::min<uint64_t>(fileSize_, kMaxReadBufferSize), pool_);
-  input_ = std::make_unique<SpillInput>(std::move(file), std::move(buffer));
+  input_ = std::make_unique<SpillInput>(
+      std::move(file), std::move(buffer), executor_, pool_);
 }
 
 bool SpillFile::nextBatch(RowVectorPtr& rowVector) {
   if (input_->atEnd()) {
     return false;
   }
-  serializer::presto::PrestoVectorSerde::PrestoOptions options = {
-      kDefaultUseLosslessTimestamp, compressionKind_};
-  VectorStreamGroup::read(input_.get(), pool_, type_, &rowVector, &options);
+  const auto options = spillSerdeOptions(fileFormat_, compressionKind_);
+  spillSerde(fileFormat_)->deserialize(
+      input_.get(), pool_, type_, &rowVector, options.get());
   return true;
 }
 
@@ -154,7 +310,10 @@ SpillFileList::SpillFileList(
     uint64_t writeBufferSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Synchronized<SpillStats>* stats)
+    folly::Synchronized<SpillStats>* stats,
+    folly::Executor* executor,
+    common::SpillOverflowTier overflowTier,
+    common::SpillFileFormat fileFormat)
     : type_(type),
       numSortingKeys_(numSortingKeys),
       sortCompareFlags_(sortCompareFlags),
@@ -163,31 +322,72 @@ SpillFileList::SpillFileList(
       writeBufferSize_(writeBufferSize),
       compressionKind_(compressionKind),
       pool_(pool),
-      stats_(stats) {
+      stats_(stats),
+      executor_(executor),
+      overflowTier_(std::move(overflowTier)),
+      fileFormat_(fileFormat) {
   // NOTE: if the associated spilling operator has specified the sort
   // comparison flags, then it must match the number of sorting keys.
   VELOX_CHECK(
       sortCompareFlags_.empty() || sortCompareFlags_.size() == numSortingKeys_);
 }
 
+SpillFileList::~SpillFileList() {
+  // Waits for the pending write so that it does not outlive 'this'. This is in
+  // a destructor and must not throw.
+  try {
+    waitForPendingWrite();
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Error in spill file write: " << e.what();
+  }
+}
+
+void SpillFileList::waitForPendingWrite() {
+  if (pendingWrite_ == nullptr) {
+    return;
+  }
+  auto pendingWrite = std::move(pendingWrite_);
+  pendingWrite->move();
+}
+
 WriteFile& SpillFileList::currentOutput() {
   if (files_.empty() || !files_.back()->isWritable() ||
       files_.back()->size() > targetFileSize_) {
     if (!files_.empty() && files_.back()->isWritable()) {
-      files_.back()->finishWrite();
-      updateSpilledFiles(files_.back()->size());
+      finishCurrentFile();
     }
+    isLocalFile_ = !useOverflowTier();
     files_.push_back(std::make_unique<SpillFile>(
         type_,
         numSortingKeys_,
         sortCompareFlags_,
-        fmt::format("{}-{}", path_, files_.size()),
+        fmt::format(
+            "{}-{}",
+            isLocalFile_ ? path_ : overflowTier_.filePath,
+            files_.size()),
         compressionKind_,
-        pool_));
+        pool_,
+        executor_,
+        fileFormat_));
   }
   return files_.back()->output();
 }
 
+bool SpillFileList::useOverflowTier() const {
+  return overflowTier_.enabled() &&
+      overflowTier_.localBytes->load() >= overflowTier_.maxLocalBytes;
+}
+
+void SpillFileList::finishCurrentFile() {
+  files_.back()->finishWrite();
+  updateSpilledFiles(files_.back()->size());
+  if (!isLocalFile_) {
+    addThreadLocalRuntimeStat(
+        "spillOverflowFileSize",
+        RuntimeCounter(files_.back()->size(), RuntimeCounter::Unit::kBytes));
+  }
+}
+
 uint64_t SpillFileList::flush() {
   uint64_t writtenBytes = 0;
   if (batch_) {
@@ -201,20 +401,57 @@ uint64_t SpillFileList::flush() {
 
     batch_.reset();
     auto iobuf = out.getIOBuf();
+    // The previous write must be done before the file it went to can be
+    // finished by currentOutput().
+    waitForPendingWrite();
     auto& file = currentOutput();
-    uint64_t writeTimeUs{0};
-    uint32_t numDiskWrites{0};
-    {
-      MicrosecondTimer timer(&writeTimeUs);
-      for (auto& range : *iobuf) {
-        ++numDiskWrites;
-        file.append(std::string_view(
-            reinterpret_cast<const char*>(range.data()), range.size()));
-        writtenBytes += range.size();
-      }
+    if (executor_ == nullptr) {
+      return writeToFile(*iobuf, file, isLocalFile_, flushTimeUs);
+    }
+    writtenBytes = iobuf->computeChainDataLength();
+    // std::function needs a copyable capture.
+    std::shared_ptr<folly::IOBuf> buffer(std::move(iobuf));
+    pendingWrite_ = std::make_shared<AsyncSource<PendingWrite>>(
+        [this,
+         buffer,
+         &file,
+         isLocalFile = isLocalFile_,
+         flushTimeUs,
+         listener = process::threadTraceListener()]() {
+          // Reports the write to the timeline of the spilling thread's task.
+          process::ScopedTraceListener scopedListener(listener);
+          return std::make_unique<PendingWrite>(PendingWrite{
+              writeToFile(*buffer, file, isLocalFile, flushTimeUs)});
+        });
+    executor_->add([source = pendingWrite_]() { source->prepare(); });
+  }
+  return writtenBytes;
+}
+
+uint64_t SpillFileList::writeToFile(
+    const folly::IOBuf& iobuf,
+    WriteFile& file,
+    bool isLocalFile,
+    uint64_t flushTimeUs) {
+  process::TraceContext trace("Spill write");
+  uint64_t writtenBytes{0};
+  uint64_t writeTimeUs{0};
+  uint32_t numDiskWrites{0};
+  {
+    MicrosecondTimer timer(&writeTimeUs);
+    for (auto& range : iobuf) {
+      ++numDiskWrites;
+      file.append(std::string_view(
+          reinterpret_cast<const char*>(range.data()), range.size()));
+      writtenBytes += range.size();
     }
-    updateWriteStats(numDiskWrites, writtenBytes, flushTimeUs, writeTimeUs);
   }
+  if (isLocalFile && overflowTier_.enabled()) {
+    overflowTier_.localBytes->fetch_add(writtenBytes);
+  }
+  updateWriteStats(numDiskWrites, writtenBytes, flushTimeUs, writeTimeUs);
+  REPORT_ADD_STAT_VALUE(kCounterSpillWriteBytes, writtenBytes);
+  REPORT_ADD_HISTOGRAM_VALUE(kCounterSpillWriteTimeMs, writeTimeUs / 1'000);
   return writtenBytes;
 }
 
@@ -225,13 +462,13 @@ uint64_t SpillFileList::write(
   {
     MicrosecondTimer timer(&timeUs);
     if (batch_ == nullptr) {
-      serializer::presto::PrestoVectorSerde::PrestoOptions options = {
-          kDefaultUseLosslessTimestamp, compressionKind_};
-      batch_ = std::make_unique<VectorStreamGroup>(pool_);
+      const auto options = spillSerdeOptions(fileFormat_, compressionKind_);
+      batch_ = std::make_unique<VectorStreamGroup>(
+          pool_, spillSerde(fileFormat_));
       batch_->createStreamTree(
           std::static_pointer_cast<const RowType>(rows->type()),
           1000,
-          &options);
+          options.get());
     }
     batch_->append(rows, indices);
   }
@@ -274,12 +511,12 @@ void SpillFileList::updateSpilledFiles(uint64_t fileSize) {
 
 void SpillFileList::finishFile() {
   flush();
+  waitForPendingWrite();
   if (files_.empty()) {
     return;
   }
   if (files_.back()->isWritable()) {
-    files_.back()->finishWrite();
-    updateSpilledFiles(files_.back()->size());
+    finishCurrentFile();
   }
 }
 
@@ -300,7 +537,10 @@ SpillState::SpillState(
     uint64_t writeBufferSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Synchronized<SpillStats>* stats)
+    folly::Synchronized<SpillStats>* stats,
+    folly::Executor* executor,
+    common::SpillOverflowTier overflowTier,
+    common::SpillFileFormat fileFormat)
     : path_(path),
       maxPartitions_(maxPartitions),
       numSortingKeys_(numSortingKeys),
@@ -310,6 +550,9 @@ SpillState::SpillState(
       compressionKind_(compressionKind),
       pool_(pool),
       stats_(stats),
+      executor_(executor),
+      overflowTier_(std::move(overflowTier)),
+      fileFormat_(fileFormat),
       files_(maxPartitions_) {}
 
 void SpillState::setPartitionSpilled(int32_t partition) {
@@ -338,6 +581,11 @@ uint64_t SpillState::appendToPartition(
 
   // Ensure that partition exist before writing.
   if (!files_.at(partition)) {
+    auto overflowTier = overflowTier_;
+    if (overflowTier.enabled()) {
+      overflowTier.filePath =
+          fmt::format("{}-spill-{}", overflowTier.filePath, partition);
+    }
     files_[partition] = std::make_unique<SpillFileList>(
         std::static_pointer_cast<const RowType>(rows->type()),
         numSortingKeys_,
@@ -347,7 +595,10 @@ uint64_t SpillState::appendToPartition(
         writeBufferSize_,
         compressionKind_,
         pool_,
-        stats_);
+        stats_,
+        executor_,
+        std::move(overflowTier),
+        fileFormat_);
   }
   updateSpilledInputBytes(rows->estimateFlatSize());
 
@@ -453,6 +704,53 @@ SpillPartition::createReader() {
       std::move(streams));
 }
 
+std::unique_ptr<TreeOfLosers<SpillMergeStream>>
+SpillPartition::createOrderedReader() {
+  std::vector<std::unique_ptr<SpillMergeStream>> streams;
+  streams.reserve(files_.size());
+  for (auto& file : files_) {
+    streams.push_back(FileSpillMergeStream::create(std::move(file)));
+  }
+  files_.clear();
+  if (streams.empty()) {
+    return nullptr;
+  }
+  return std::make_unique<TreeOfLosers<SpillMergeStream>>(std::move(streams));
+}
+
+SpillPartitionWorkQueues::SpillPartitionWorkQueues(
+    std::vector<SpillPartitionSet> partitionSets)
+    : queues_(partitionSets.size()) {
+  for (auto i = 0; i < partitionSets.size(); ++i) {
+    for (auto& [id, partition] : partitionSets[i]) {
+      queues_[i].push_back(std::move(partition));
+    }
+  }
+}
+
+std::unique_ptr<SpillPartition> SpillPartitionWorkQueues::next(int32_t index) {
+  VELOX_CHECK_LT(index, queues_.size());
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& own = queues_[index];
+  if (!own.empty()) {
+    auto partition = std::move(own.front());
+    own.pop_front();
+    return partition;
+  }
+  std::deque<std::unique_ptr<SpillPartition>>* longest{nullptr};
+  for (auto& queue : queues_) {
+    if (longest == nullptr || queue.size() > longest->size()) {
+      longest = &queue;
+    }
+  }
+  if (longest == nullptr || longest->empty()) {
+    return nullptr;
+  }
+  auto partition = std::move(longest->back());
+  longest->pop_back();
+  return partition;
+}
+
 SpillStats::SpillStats(
     uint64_t _spillRuns,
     uint64_t _spilledInputBytes,
@@ -485,6 +783,13 @@ bool SpillStats::empty() const {
   return spilledBytes == 0;
 }
 
+void SpillStats::setSpillLevel(int32_t level) {
+  VELOX_CHECK_GE(level, 0);
+  level = std::min(level, kNumSpillLevels - 1);
+  spilledBytesByLevel[level] = spilledBytes;
+  spilledPartitionsByLevel[level] = spilledPartitions;
+}
+
 SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillRuns += other.spillRuns;
   spilledInputBytes += other.spilledInputBytes;
@@ -499,6 +804,10 @@ SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillFlushTimeUs += other.spillFlushTimeUs;
   spillWriteTimeUs += other.spillWriteTimeUs;
   spillMaxLevelExceededCount += other.spillMaxLevelExceededCount;
+  for (auto level = 0; level < kNumSpillLevels; ++level) {
+    spilledBytesByLevel[level] += other.spilledBytesByLevel[level];
+    spilledPartitionsByLevel[level] += other.spilledPartitionsByLevel[level];
+  }
   return *this;
 }
 
@@ -519,6 +828,12 @@ SpillStats SpillStats::operator-(const SpillStats& other) const {
   result.spillWriteTimeUs = spillWriteTimeUs - other.spillWriteTimeUs;
   result.spillMaxLevelExceededCount =
       spillMaxLevelExceededCount - other.spillMaxLevelExceededCount;
+  for (auto level = 0; level < kNumSpillLevels; ++level) {
+    result.spilledBytesByLevel[level] =
+        spilledBytesByLevel[level] - other.spilledBytesByLevel[level];
+    result.spilledPartitionsByLevel[level] =
+        spilledPartitionsByLevel[level] - other.spilledPartitionsByLevel[level];
+  }
   return result;
 }
 
@@ -550,6 +865,10 @@ bool SpillStats::operator<(const SpillStats& other) const {
   UPDATE_COUNTER(spillFlushTimeUs);
   UPDATE_COUNTER(spillWriteTimeUs);
   UPDATE_COUNTER(spillMaxLevelExceededCount);
+  for (auto level = 0; level < kNumSpillLevels; ++level) {
+    UPDATE_COUNTER(spilledBytesByLevel[level]);
+    UPDATE_COUNTER(spilledPartitionsByLevel[level]);
+  }
 #undef UPDATE_COUNTER
   VELOX_CHECK(
       !((gtCount > 0) && (ltCount > 0)),
@@ -585,7 +904,9 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillDiskWrites,
              spillFlushTimeUs,
              spillWriteTimeUs,
-             spillMaxLevelExceededCount) ==
+             spillMaxLevelExceededCount,
+             spilledBytesByLevel,
+             spilledPartitionsByLevel) ==
       std::tie(
              other.spillRuns,
              other.spilledInputBytes,
@@ -599,7 +920,9 @@ bool SpillStats::operator==(const SpillStats& other) const {
              other.spillDiskWrites,
              other.spillFlushTimeUs,
              other.spillWriteTimeUs,
-             spillMaxLevelExceededCount);
+             other.spillMaxLevelExceededCount,
+             other.spilledBytesByLevel,
+             other.spilledPartitionsByLevel);
 }
 
 void SpillStats::reset() {
@@ -616,11 +939,24 @@ void SpillStats::reset() {
   spillFlushTimeUs = 0;
   spillWriteTimeUs = 0;
   spillMaxLevelExceededCount = 0;
+  spilledBytesByLevel.fill(0);
+  spilledPartitionsByLevel.fill(0);
 }
 
 std::string SpillStats::toString() const {
+  std::string levels;
+  for (auto level = 0; level < kNumSpillLevels; ++level) {
+    if (spilledPartitionsByLevel[level] == 0) {
+      continue;
+    }
+    levels += fmt::format(
+        " level{}[{} partitions {}]",
+        level,
+        spilledPartitionsByLevel[level],
+        succinctBytes(spilledBytesByLevel[level]));
+  }
   return fmt::format(
-      "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] spilledPartitions[{}] spilledFiles[{}] spillFillTimeUs[{}] spillSortTime[{}] spillSerializationTime[{}] spillDiskWrites[{}] spillFlushTime[{}] spillWriteTime[{}] maxSpillExceededLimitCount[{}]",
+      "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] spilledPartitions[{}] spilledFiles[{}] spillFillTimeUs[{}] spillSortTime[{}] spillSerializationTime[{}] spillDiskWrites[{}] spillFlushTime[{}] spillWriteTime[{}] maxSpillExceededLimitCount[{}]{}",
       spillRuns,
       succinctBytes(spilledInputBytes),
       succinctBytes(spilledBytes),
@@ -633,7 +969,8 @@ std::string SpillStats::toString() const {
       spillDiskWrites,
       succinctMicros(spillFlushTimeUs),
       succinctMicros(spillWriteTimeUs),
-      spillMaxLevelExceededCount);
+      spillMaxLevelExceededCount,
+      levels);
 }
 
 SpillPartitionIdSet toSpillPartitionIdSet(
@@ -17,8 +17,12 @@
 #pragma once
 
 #include <folly/container/F14Set.h>
+#include <deque>
+#include <mutex>
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/compression/Compression.h"
+#include "velox/common/config/SpillConfig.h"
 #include "velox/common/file/File.h"
 #include "velox/exec/TreeOfLosers.h"
 #include "velox/exec/UnorderedStreamReader.h"
@@ -31,14 +35,27 @@ namespace facebook::velox::exec {
 // Input stream backed by spill file.
 class SpillInput : public ByteStream {
  public:
-  // Reads from 'input' using 'buffer' for buffering reads.
-  SpillInput(std::unique_ptr<ReadFile>&& input, BufferPtr buffer)
+  // Reads from 'input' using 'buffer' for buffering reads. If 'executor' is
+  // not null, the buffer after the one being consumed is read ahead on
+  // 'executor' into a second buffer of the same size allocated from 'pool'.
+  // Ranges of 'buffer' capacity that 'input' can hand out from a memory
+  // mapping with ReadFile::mappedRegion() are read in place without a copy.
+  SpillInput(
+      std::unique_ptr<ReadFile>&& input,
+      BufferPtr buffer,
+      folly::Executor* executor = nullptr,
+      memory::MemoryPool* pool = nullptr)
       : input_(std::move(input)),
         buffer_(std::move(buffer)),
-        size_(input_->size()) {
+        size_(input_->size()),
+        executor_(executor),
+        pool_(pool) {
+    VELOX_CHECK(executor_ == nullptr || pool_ != nullptr);
     next(true);
   }
 
+  ~SpillInput() override;
+
   void next(bool throwIfPastEnd) override;
 
   // True if all of the file has been read into vectors.
@@ -47,11 +64,26 @@ class SpillInput : public ByteStream {
   }
 
  private:
+  // The outcome of reading ahead into 'readAheadBuffer_'.
+  struct ReadAhead {
+    int32_t size;
+  };
+
+  // Starts reading the bytes after 'offset_' into 'readAheadBuffer_' on
+  // 'executor_'. No-op if there is no executor or nothing left to read.
+  void startReadAhead();
+
   std::unique_ptr<ReadFile> input_;
   BufferPtr buffer_;
   const uint64_t size_;
+  folly::Executor* const executor_;
+  memory::MemoryPool* const pool_;
   // Offset of first byte not in 'buffer_'
   uint64_t offset_ = 0;
+  // Receives the next range of 'input_' while 'buffer_' is consumed.
+  BufferPtr readAheadBuffer_;
+  // Set while a read into 'readAheadBuffer_' is pending.
+  std::shared_ptr<AsyncSource<ReadAhead>> readAhead_;
 };
 
 /// Represents a spill file that is first in write mode and then
@@ -70,7 +102,9 @@ class SpillFile {
       const std::vector<CompareFlags>& sortCompareFlags,
       const std::string& path,
       common::CompressionKind compressionKind,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      folly::Executor* executor = nullptr,
+      common::SpillFileFormat fileFormat = common::SpillFileFormat::kPresto);
 
   int32_t numSortingKeys() const {
     return numSortingKeys_;
@@ -134,6 +168,9 @@ class SpillFile {
   const std::string path_;
   const common::CompressionKind compressionKind_;
   memory::MemoryPool* const pool_;
+  // If set, reads are done ahead on this executor.
+  folly::Executor* const executor_;
+  const common::SpillFileFormat fileFormat_;
 
   // Byte size of the backing file. Set when finishing writing.
   uint64_t fileSize_ = 0;
@@ -175,6 +212,17 @@ struct SpillStats {
   /// limit.
   uint64_t spillMaxLevelExceededCount{0};
 
+  /// The number of hash join spill levels with their own entries in
+  /// 'spilledBytesByLevel' and 'spilledPartitionsByLevel'. Deeper levels are
+  /// counted in the last entry.
+  static constexpr int32_t kNumSpillLevels = 8;
+  /// The number of bytes spilled by hash join operators at each spill level,
+  /// with zero being the initial spilling level.
+  std::array<uint64_t, kNumSpillLevels> spilledBytesByLevel{};
+  /// The number of partitions spilled by hash join operators at each spill
+  /// level.
+  std::array<uint64_t, kNumSpillLevels> spilledPartitionsByLevel{};
+
   SpillStats(
       uint64_t _spillRuns,
       uint64_t _spilledInputBytes,
@@ -194,6 +242,10 @@ struct SpillStats {
 
   bool empty() const;
 
+  /// Attributes 'spilledBytes' and 'spilledPartitions' to hash join spill
+  /// 'level'.
+  void setSpillLevel(int32_t level);
+
   SpillStats& operator+=(const SpillStats& other);
   SpillStats operator-(const SpillStats& other) const;
   bool operator==(const SpillStats& other) const;
@@ -231,6 +283,14 @@ class SpillFileList {
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
+  ///
+  /// If 'executor' is not null, the file writes of a serialized buffer run on
+  /// 'executor' while the caller serializes the next buffer, and the files
+  /// read ahead on 'executor' when read back.
+  ///
+  /// If 'overflowTier' is enabled, new files are opened under
+  /// 'overflowTier.filePath' instead of 'path' once the local tier is full.
+  /// 'fileFormat' is the serialization format of the files.
   SpillFileList(
       const RowTypePtr& type,
       int32_t numSortingKeys,
@@ -240,7 +300,12 @@ class SpillFileList {
       uint64_t writeBufferSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Synchronized<SpillStats>* stats);
+      folly::Synchronized<SpillStats>* stats,
+      folly::Executor* executor = nullptr,
+      common::SpillOverflowTier overflowTier = {},
+      common::SpillFileFormat fileFormat = common::SpillFileFormat::kPresto);
+
+  ~SpillFileList();
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
@@ -267,10 +332,34 @@ class SpillFileList {
   // Returns the current file to write to and creates one if needed.
   WriteFile& currentOutput();
 
+  // Finishes the write of the last file in 'files_'.
+  void finishCurrentFile();
+
+  // Returns true if a new file should go to 'overflowTier_'.
+  bool useOverflowTier() const;
+
   // Writes data from 'batch_' to the current output file. Returns the actual
-  // written size.
+  // written size. If 'executor_' is set, the write to file is left running on
+  // 'executor_' and is waited for by the next flush().
   uint64_t flush();
 
+  // The outcome of a file write started by flush().
+  struct PendingWrite {
+    uint64_t writtenBytes;
+  };
+
+  // Waits for the write started by the previous flush() if any. Rethrows its
+  // error.
+  void waitForPendingWrite();
+
+  // Appends 'iobuf' to 'file' and updates the write stats. 'isLocalFile' is
+  // true if 'file' is on the local tier. Returns the number of bytes written.
+  uint64_t writeToFile(
+      const folly::IOBuf& iobuf,
+      WriteFile& file,
+      bool isLocalFile,
+      uint64_t flushTimeUs);
+
   // Invoked to update the number of spilled rows.
   void updateAppendStats(uint64_t numRows, uint64_t serializationTimeUs);
   // Invoked to increment the number of spilled files and the file size.
@@ -291,7 +380,16 @@ class SpillFileList {
   const common::CompressionKind compressionKind_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<SpillStats>* const stats_;
+  folly::Executor* const executor_;
+  const common::SpillOverflowTier overflowTier_;
+  const common::SpillFileFormat fileFormat_;
   std::unique_ptr<VectorStreamGroup> batch_;
+  // True if the last file of 'files_' is on the local tier.
+  bool isLocalFile_{true};
+  // The write to the last file of 'files_' that runs on 'executor_'. At most
+  // one write is pending so that one buffer is written while the next one is
+  // filled.
+  std::shared_ptr<AsyncSource<PendingWrite>> pendingWrite_;
   SpillFiles files_;
 };
 
@@ -342,6 +440,7 @@ class SpillMergeStream : public MergeStream {
   virtual void nextBatch() = 0;
 
   // loads the next 'rowVector' and sets 'decoded_' if this is initialized.
+  // Also encodes the key prefixes of the new rows.
   void setNextBatch() {
     nextBatch();
     if (!decoded_.empty()) {
@@ -350,6 +449,7 @@ class SpillMergeStream : public MergeStream {
         decoded_[i].decode(*rowVector_->childAt(i), rows_);
       }
     }
+    encodePrefixes();
   }
 
   void ensureDecodedValid(int32_t index) {
@@ -360,7 +460,7 @@ class SpillMergeStream : public MergeStream {
     ensureRows();
     decoded_.resize(index + 1);
     for (auto i = oldSize; i <= index; ++i) {
-      decoded_[index].decode(*rowVector_->childAt(index), rows_);
+      decoded_[i].decode(*rowVector_->childAt(i), rows_);
     }
   }
 
@@ -385,6 +485,36 @@ class SpillMergeStream : public MergeStream {
 
   // Covers all rows inn 'rowVector_' Set if 'decoded_' is non-empty.
   SelectivityVector rows_;
+
+  // Compares the rows by the big endian words of 'prefixes_' before
+  // comparing the keys after the prefix. Cleared by benchmarks to measure
+  // the comparison without prefixes.
+  bool usePrefixes_{true};
+
+ private:
+  static constexpr int32_t kMaxPrefixWords = 2;
+  static constexpr int32_t kMaxPrefixBytes = kMaxPrefixWords * sizeof(uint64_t);
+
+  // Sets the leading sorting keys that fit in the prefix on the first batch.
+  void initializePrefixKeys();
+
+  // Encodes the prefixes of all rows of the current batch.
+  void encodePrefixes();
+
+  bool prefixKeysInitialized_{false};
+
+  // Number of leading sorting keys encoded in the prefix. These are fixed
+  // width integer or boolean keys. Each takes a null byte and its value bytes.
+  int32_t numPrefixKeys_{0};
+
+  // Number of 64 bit words in the prefix of a row. 0 if there is no prefix.
+  int32_t numPrefixWords_{0};
+
+  // 'numPrefixWords_' words for each row of 'rowVector_'. Comparing the words
+  // of two rows as unsigned integers orders them like comparing their first
+  // 'numPrefixKeys_' keys. The keys are encoded exactly, so equal prefixes
+  // have equal keys.
+  std::vector<uint64_t> prefixes_;
 };
 
 // A source of spilled RowVectors coming from a file.
@@ -394,7 +524,7 @@ class FileSpillMergeStream : public SpillMergeStream {
       std::unique_ptr<SpillFile> spillFile) {
     spillFile->startRead();
     auto* spillStream = new FileSpillMergeStream(std::move(spillFile));
-    spillStream->nextBatch();
+    spillStream->setNextBatch();
     return std::unique_ptr<SpillMergeStream>(spillStream);
   }
 
@@ -566,6 +696,11 @@ class SpillPartition {
   /// The created reader will take the ownership of the spill files.
   std::unique_ptr<UnorderedStreamReader<BatchStream>> createReader();
 
+  /// Invoked to create a sort merge reader over the sorted spill files of
+  /// this spill partition. The created reader will take the ownership of the
+  /// spill files. Returns nullptr if there are no files.
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> createOrderedReader();
+
   std::string toString() const;
 
  private:
@@ -578,6 +713,27 @@ class SpillPartition {
 using SpillPartitionSet =
     std::map<SpillPartitionId, std::unique_ptr<SpillPartition>>;
 
+/// Hands out the spill partitions of a group of peer operators that restore
+/// their spilled data in parallel, e.g. the drivers of a hash aggregation. The
+/// partitions of each operator are in a queue of their own. An operator takes
+/// the partitions from the front of its queue and, once that is empty, steals
+/// from the back of the longest queue of the other operators. The spill
+/// partitions must be restorable by any of the operators. This is thread safe.
+class SpillPartitionWorkQueues {
+ public:
+  /// 'partitionSets' has the spill partitions of each operator.
+  explicit SpillPartitionWorkQueues(
+      std::vector<SpillPartitionSet> partitionSets);
+
+  /// Returns the next spill partition for the operator at 'index' in the
+  /// constructor argument or nullptr if all partitions are taken.
+  std::unique_ptr<SpillPartition> next(int32_t index);
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::deque<std::unique_ptr<SpillPartition>>> queues_;
+};
+
 /// Represents all spilled data of an operator, e.g. order by or group
 /// by. This has one SpillFileList per partition of spill data.
 class SpillState {
@@ -588,7 +744,10 @@ class SpillState {
   /// 'numSortingKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. If 'executor' is not null, spill file writes and reads are
+  /// overlapped with the caller on 'executor'. If 'overflowTier' is enabled,
+  /// spill files go there once the local tier under 'path' is full.
+  /// 'fileFormat' is the serialization format of the spill files.
   SpillState(
       const std::string& path,
       int32_t maxPartitions,
@@ -598,7 +757,10 @@ class SpillState {
       uint64_t writeBufferSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Synchronized<SpillStats>* stats);
+      folly::Synchronized<SpillStats>* stats,
+      folly::Executor* executor = nullptr,
+      common::SpillOverflowTier overflowTier = {},
+      common::SpillFileFormat fileFormat = common::SpillFileFormat::kPresto);
 
   /// Indicates if a given 'partition' has been spilled or not.
   bool isPartitionSpilled(int32_t partition) const {
@@ -686,6 +848,9 @@ class SpillState {
   const common::CompressionKind compressionKind_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<SpillStats>* const stats_;
+  folly::Executor* const executor_;
+  const common::SpillOverflowTier overflowTier_;
+  const common::SpillFileFormat fileFormat_;
 
   // A set of spilled partition numbers.
   SpillPartitionNumSet spilledPartitionSet_;
@@ -46,7 +46,9 @@ Spiller::Spiller(
     uint64_t minSpillRunSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    const common::SpillOverflowTier& overflowTier,
+    common::SpillFileFormat fileFormat)
     : Spiller(
           type,
           container,
@@ -61,7 +63,9 @@ Spiller::Spiller(
           minSpillRunSize,
           compressionKind,
           pool,
-          executor) {
+          executor,
+          overflowTier,
+          fileFormat) {
   VELOX_CHECK_EQ(type_, Type::kOrderBy);
 }
 
@@ -74,7 +78,9 @@ Spiller::Spiller(
     uint64_t writeBufferSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    const common::SpillOverflowTier& overflowTier,
+    common::SpillFileFormat fileFormat)
     : Spiller(
           type,
           container,
@@ -89,7 +95,9 @@ Spiller::Spiller(
           0,
           compressionKind,
           pool,
-          executor) {
+          executor,
+          overflowTier,
+          fileFormat) {
   VELOX_CHECK_EQ(type, Type::kAggregateOutput);
   VELOX_CHECK_EQ(state_.maxPartitions(), 1);
   VELOX_CHECK_EQ(state_.targetFileSize(), std::numeric_limits<uint64_t>::max());
@@ -105,7 +113,9 @@ Spiller::Spiller(
     uint64_t minSpillRunSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    const common::SpillOverflowTier& overflowTier,
+    common::SpillFileFormat fileFormat)
     : Spiller(
           type,
           nullptr,
@@ -120,7 +130,9 @@ Spiller::Spiller(
           minSpillRunSize,
           compressionKind,
           pool,
-          executor) {
+          executor,
+          overflowTier,
+          fileFormat) {
   VELOX_CHECK_EQ(type_, Type::kHashJoinProbe);
 }
 
@@ -138,7 +150,9 @@ Spiller::Spiller(
     uint64_t minSpillRunSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    const common::SpillOverflowTier& overflowTier,
+    common::SpillFileFormat fileFormat)
     : type_(type),
       container_(container),
       executor_(executor),
@@ -156,7 +170,10 @@ Spiller::Spiller(
           writeBufferSize,
           compressionKind,
           pool_,
-          &stats_) {
+          &stats_,
+          executor,
+          overflowTier,
+          fileFormat) {
   TestValue::adjust(
       "facebook::velox::exec::Spiller", const_cast<HashBitRange*>(&bits_));
 
@@ -237,7 +254,7 @@ class RowContainerSpillMergeStream : public SpillMergeStream {
         rows_(std::move(rows)),
         spiller_(spiller) {
     if (!rows_.empty()) {
-      nextBatch();
+      setNextBatch();
     }
   }
 
@@ -614,6 +631,31 @@ void Spiller::finishSpill(SpillPartitionSet& partitionSet) {
   }
 }
 
+Spiller::SpillRows Spiller::finishSpillToFiles(
+    SpillPartitionSet& partitionSet) {
+  CHECK_NOT_FINALIZED();
+  VELOX_CHECK_EQ(
+      type_,
+      Type::kAggregateInput,
+      "Can't finish spill to files on spiller type: {}",
+      typeName(type_));
+  VELOX_CHECK(pendingSpillPartitions_.empty());
+
+  SpillRows rowsFromNonSpillingPartitions(
+      0, memory::StlAllocator<char*>(*pool_));
+  fillSpillRuns(nullptr, &rowsFromNonSpillingPartitions);
+  for (const auto partition : state_.spilledPartitionSet()) {
+    if (!spillRuns_[partition].rows.empty()) {
+      pendingSpillPartitions_.insert(partition);
+    }
+  }
+  while (!pendingSpillPartitions_.empty()) {
+    advanceSpill();
+  }
+  finishSpill(partitionSet);
+  return rowsFromNonSpillingPartitions;
+}
+
 void Spiller::finalizeSpill() {
   CHECK_NOT_FINALIZED();
   finalized_ = true;
@@ -58,7 +58,9 @@ class Spiller {
       uint64_t minSpillRunSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Executor* executor);
+      folly::Executor* executor,
+      const common::SpillOverflowTier& overflowTier = {},
+      common::SpillFileFormat fileFormat = common::SpillFileFormat::kPresto);
 
   Spiller(
       Type type,
@@ -69,7 +71,9 @@ class Spiller {
       uint64_t writeBufferSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Executor* executor);
+      folly::Executor* executor,
+      const common::SpillOverflowTier& overflowTier = {},
+      common::SpillFileFormat fileFormat = common::SpillFileFormat::kPresto);
 
   Spiller(
       Type type,
@@ -81,7 +85,9 @@ class Spiller {
       uint64_t minSpillRunSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Executor* executor);
+      folly::Executor* executor,
+      const common::SpillOverflowTier& overflowTier = {},
+      common::SpillFileFormat fileFormat = common::SpillFileFormat::kPresto);
 
   Spiller(
       Type type,
@@ -97,7 +103,9 @@ class Spiller {
       uint64_t minSpillRunSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Executor* executor);
+      folly::Executor* executor,
+      const common::SpillOverflowTier& overflowTier = {},
+      common::SpillFileFormat fileFormat = common::SpillFileFormat::kPresto);
 
   Type type() const {
     return type_;
@@ -176,6 +184,15 @@ class Spiller {
   /// 'partitionSet' by spill partition id.
   void finishSpill(SpillPartitionSet& partitionSet);
 
+  /// Finishes spilling like finishSpill() but first writes the rows of the
+  /// spilled partitions that are still in the row container to disk, so that
+  /// all data of a spilled partition is in its sorted spill files. Moves the
+  /// files into 'partitionSet', from where the partitions can be restored
+  /// without 'this', e.g. by another driver. Returns the rows that are in
+  /// partitions that have not started spilling. Only used by the
+  /// 'kAggregateInput' spiller type.
+  SpillRows finishSpillToFiles(SpillPartitionSet& partitionSet);
+
   const SpillState& state() const {
     return state_;
   }
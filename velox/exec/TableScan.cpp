@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/TableScan.h"
+#include "velox/common/process/ProcessBase.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
 #include "velox/exec/Task.h"
@@ -48,8 +49,12 @@ TableScan::TableScan(
           tableHandle_->connectorId())),
       readBatchSize_(driverCtx_->queryConfig().preferredOutputBatchRows()),
       maxReadBatchSize_(driverCtx_->queryConfig().maxOutputBatchRows()),
+      limit_(tableScanNode->limit()),
       getOutputTimeLimitMs_(
-          driverCtx_->queryConfig().tableScanGetOutputTimeLimitMs()) {
+          driverCtx_->queryConfig().tableScanGetOutputTimeLimitMs()),
+      getOutputCpuTimeLimitNanos_(
+          driverCtx_->queryConfig().tableScanGetOutputCpuTimeLimitMs() *
+          1'000'000) {
   connector_ = connector::getConnector(tableHandle_->connectorId());
 }
 
@@ -59,6 +64,8 @@ RowVectorPtr TableScan::getOutput() {
   }
 
   const auto startTimeMs = getCurrentTimeMs();
+  const uint64_t startCpuNanos =
+      getOutputCpuTimeLimitNanos_ != 0 ? process::threadCpuNanos() : 0;
   for (;;) {
     if (needNewSplit_) {
       // Check if our Task needs us to yield or we've been running for too long
@@ -74,6 +81,9 @@ RowVectorPtr TableScan::getOutput() {
             "facebook::velox::exec::TableScan::getOutput::bail", this);
         return nullptr;
       }
+      if (yieldOnCpuTime(startCpuNanos, *stats_.wlock())) {
+        return nullptr;
+      }
 
       // A point for test code injection.
       TestValue::adjust("facebook::velox::exec::TableScan::getOutput", this);
@@ -151,9 +161,20 @@ RowVectorPtr TableScan::getOutput() {
         // The AsyncSource returns a unique_ptr to a shared_ptr. The
         // unique_ptr will be nullptr if there was a cancellation.
         numReadyPreloadedSplits_ += connectorSplit->dataSource->hasValue();
-        auto preparedDataSource = connectorSplit->dataSource->move();
-        stats_.wlock()->getOutputTiming.add(
-            connectorSplit->dataSource->prepareTiming());
+        uint64_t waitMicros = 0;
+        std::unique_ptr<connector::DataSource> preparedDataSource;
+        {
+          MicrosecondTimer timer(&waitMicros);
+          preparedDataSource = connectorSplit->dataSource->move();
+        }
+        const auto& prepareTiming = connectorSplit->dataSource->prepareTiming();
+        stats_.wlock()->getOutputTiming.add(prepareTiming);
+        // The time the split took to open in the background minus the time
+        // waited for it is the wait that the preload saved.
+        preloadWaitNanos_ += waitMicros * 1'000;
+        if (prepareTiming.wallNanos > waitMicros * 1'000) {
+          preloadHiddenNanos_ += prepareTiming.wallNanos - waitMicros * 1'000;
+        }
         if (!preparedDataSource) {
           // There must be a cancellation.
           VELOX_CHECK(operatorCtx_->task()->isCancelled());
@@ -190,6 +211,16 @@ RowVectorPtr TableScan::getOutput() {
           maxReadBatchSize_,
           static_cast<int>(readBatchSize / maxFilteringRatio_));
     }
+    if (limit_.has_value() && numOutputRows_ < limit_.value()) {
+      // Do not read past the rows the consumer needs, scaled like above for
+      // the rows that filters drop.
+      const auto remaining = limit_.value() - numOutputRows_;
+      readBatchSize = std::min<int64_t>(
+          readBatchSize,
+          maxFilteringRatio_ > 0
+              ? static_cast<int64_t>(remaining / maxFilteringRatio_) + 1
+              : remaining);
+    }
     auto dataOptional = dataSource_->next(readBatchSize, blockingFuture_);
     checkPreload();
 
@@ -217,8 +248,17 @@ RowVectorPtr TableScan::getOutput() {
               {maxFilteringRatio_,
                1.0 * data->size() / readBatchSize,
                1.0 / kMaxSelectiveBatchSizeMultiplier});
+          numOutputRows_ += data->size();
           return data;
         }
+        // A selective scan may go through many batches without a row to
+        // return. Yield the thread when out of CPU time. 'dataSource_' keeps
+        // its position in the split and the next call continues from there.
+        TestValue::adjust(
+            "facebook::velox::exec::TableScan::getOutput::emptyBatch", this);
+        if (yieldOnCpuTime(startCpuNanos, *lockedStats)) {
+          return nullptr;
+        }
         continue;
       }
     }
@@ -235,6 +275,18 @@ RowVectorPtr TableScan::getOutput() {
             "readyPreloadedSplits", RuntimeCounter(numReadyPreloadedSplits_));
         numReadyPreloadedSplits_ = 0;
       }
+      if (preloadWaitNanos_ > 0) {
+        lockedStats->addRuntimeStat(
+            "preloadWaitWallNanos",
+            RuntimeCounter(preloadWaitNanos_, RuntimeCounter::Unit::kNanos));
+        preloadWaitNanos_ = 0;
+      }
+      if (preloadHiddenNanos_ > 0) {
+        lockedStats->addRuntimeStat(
+            "preloadHiddenWallNanos",
+            RuntimeCounter(preloadHiddenNanos_, RuntimeCounter::Unit::kNanos));
+        preloadHiddenNanos_ = 0;
+      }
     }
 
     driverCtx_->task->splitFinished();
@@ -242,6 +294,26 @@ RowVectorPtr TableScan::getOutput() {
   }
 }
 
+bool TableScan::yieldOnCpuTime(uint64_t startCpuNanos, OperatorStats& stats) {
+  const bool timeSliceExpired =
+      driverCtx_->driver != nullptr && driverCtx_->driver->timeSliceExpired();
+  if (!timeSliceExpired &&
+      (getOutputCpuTimeLimitNanos_ == 0 ||
+       process::threadCpuNanos() - startCpuNanos <
+           getOutputCpuTimeLimitNanos_)) {
+    return false;
+  }
+  if (timeSliceExpired) {
+    // Same as the Driver yielding between operators. The Driver goes back on
+    // the executor with the priority of the CPU time of its Task.
+    driverCtx_->task->addTimeSliceYield();
+  }
+  stats.addRuntimeStat("cpuTimeYields", RuntimeCounter(1));
+  blockingReason_ = BlockingReason::kYieldCpuTime;
+  blockingFuture_ = ContinueFuture{folly::Unit{}};
+  return true;
+}
+
 void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
   // The AsyncSource returns a unique_ptr to the shared_ptr of the
   // DataSource. The callback may outlive the Task, hence it captures
@@ -284,6 +356,13 @@ void TableScan::checkPreload() {
     return;
   }
   if (dataSource_->allPrefetchIssued()) {
+    const auto maxMemory =
+        driverCtx_->queryConfig().maxSplitPreloadMemoryBytes();
+    if (maxMemory > 0 && connectorPool_->currentBytes() >= maxMemory) {
+      // The splits preloaded so far stay preloaded.
+      maxPreloadedSplits_ = 0;
+      return;
+    }
     maxPreloadedSplits_ = driverCtx_->task->numDrivers(driverCtx_->driver) *
         FLAGS_split_preload_per_driver;
     if (!splitPreloader_) {
@@ -60,7 +60,8 @@ class TableScan : public SourceOperator {
   // Sets 'maxPreloadSplits' and 'splitPreloader' if prefetching
   // splits is appropriate. The preloader will be applied to the
   // 'first 'maxPreloadSplits' of the Tasks's split queue for 'this'
-  // when getting splits.
+  // when getting splits. Stops preloading while the memory of
+  // 'connectorPool_' exceeds QueryConfig::maxSplitPreloadMemoryBytes().
   void checkPreload();
 
   // Sets 'split->dataSource' to be a Asyncsource that makes a
@@ -69,6 +70,12 @@ class TableScan : public SourceOperator {
   // needed before prepare is done, it will be made when needed.
   void preload(std::shared_ptr<connector::ConnectorSplit> split);
 
+  // Returns true if getOutput() has used 'getOutputCpuTimeLimitNanos_' of
+  // thread CPU time since 'startCpuNanos' or the Driver has used up its CPU
+  // time slice. If so, sets 'blockingReason_' to kYieldCpuTime with a
+  // fulfilled future and counts the yield in 'stats'.
+  bool yieldOnCpuTime(uint64_t startCpuNanos, OperatorStats& stats);
+
   // Process-wide IO wait time.
   static std::atomic<uint64_t> ioWaitNanos_;
 
@@ -105,13 +112,29 @@ class TableScan : public SourceOperator {
   // Count of splits that finished preloading before being read.
   int32_t numReadyPreloadedSplits_{0};
 
+  // Time spent waiting for preloaded splits that were not ready.
+  uint64_t preloadWaitNanos_{0};
+
+  // Time the preloaded splits took to open in the background that was not
+  // waited for.
+  uint64_t preloadHiddenNanos_{0};
+
   int32_t readBatchSize_;
   int32_t maxReadBatchSize_;
 
+  // See core::TableScanNode::limit().
+  const std::optional<int64_t> limit_;
+  // Rows returned by getOutput() so far.
+  int64_t numOutputRows_{0};
+
   // Exits getOutput() method after this many milliseconds.
   // Zero means 'no limit'.
   size_t getOutputTimeLimitMs_{0};
 
+  // Yields from getOutput() after this much thread CPU time, also in the
+  // middle of a split. Zero means 'no limit'.
+  const uint64_t getOutputCpuTimeLimitNanos_;
+
   double maxFilteringRatio_{0};
 
   // String shown in ExceptionContext inside DataSource and LazyVector loading.
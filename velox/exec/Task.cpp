@@ -261,7 +261,12 @@ Task::Task(
       consumerSupplier_(std::move(consumerSupplier)),
       onError_(onError),
       splitsStates_(buildSplitStates(planFragment_.planNode)),
-      bufferManager_(OutputBufferManager::getInstance()) {}
+      bufferManager_(OutputBufferManager::getInstance()),
+      timeline_(
+          queryCtx_->queryConfig().taskTimelineMaxEvents() > 0
+              ? std::make_shared<TaskTimeline>(
+                    queryCtx_->queryConfig().taskTimelineMaxEvents())
+              : nullptr) {}
 
 Task::~Task() {
   TestValue::adjust("facebook::velox::exec::Task::~Task", this);
@@ -298,6 +303,14 @@ bool Task::allNodesReceivedNoMoreSplitsMessageLocked() const {
   return true;
 }
 
+std::string Task::spillOverflowDirectory() const {
+  const auto overflowPath = queryCtx_->queryConfig().spillOverflowPath();
+  if (overflowPath.empty()) {
+    return "";
+  }
+  return fmt::format("{}/{}", overflowPath, taskId_);
+}
+
 void Task::removeSpillDirectoryIfExists() {
   if (!spillDirectory_.empty()) {
     try {
@@ -308,6 +321,22 @@ void Task::removeSpillDirectoryIfExists() {
                  << "' for Task " << taskId() << ": " << e.what();
     }
   }
+  // Only touch the overflow tier if something could have spilled to it.
+  const auto maxLocalSpillBytes =
+      queryCtx_->queryConfig().maxLocalSpillBytes();
+  const auto overflowDirectory = spillOverflowDirectory();
+  if (overflowDirectory.empty() || maxLocalSpillBytes == 0 ||
+      localSpillBytes_ < maxLocalSpillBytes) {
+    return;
+  }
+  try {
+    auto fs = filesystems::getFileSystem(overflowDirectory, nullptr);
+    fs->rmdir(overflowDirectory);
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Failed to remove overflow spill directory '"
+               << overflowDirectory << "' for Task " << taskId() << ": "
+               << e.what();
+  }
 }
 
 void Task::initTaskPool() {
@@ -570,6 +599,12 @@ void Task::start(
       self->concurrentSplitGroups_ = concurrentSplitGroups;
       self->taskStats_.executionStartTimeMs = getCurrentTimeMs();
 
+      const auto checkpointPath =
+          self->queryCtx_->queryConfig().taskCheckpointPath();
+      if (!checkpointPath.empty() && self->isGroupedExecution()) {
+        self->checkpoint_ = std::make_unique<TaskCheckpoint>(checkpointPath);
+      }
+
 #if CODEGEN_ENABLED == 1
       const auto& config = self->queryCtx()->queryConfig();
       if (config.codegenEnabled() &&
@@ -957,6 +992,10 @@ void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
         ++splitGroupState.numFinishedOutputDrivers;
       }
 
+      for (auto* op : driver->operators()) {
+        splitGroupState.peakMemoryBytes += op->pool()->peakBytes();
+      }
+
       // Release the driver, note that after this 'driver' is invalid.
       driverPtr = nullptr;
       self->driverClosedLocked();
@@ -968,6 +1007,11 @@ void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
         if (splitGroupId != kUngroupedGroupId) {
           --self->numRunningSplitGroups_;
           self->taskStats_.completedSplitGroups.emplace(splitGroupId);
+          if (self->checkpoint_ != nullptr && self->isRunningLocked()) {
+            self->checkpoint_->commit(splitGroupId);
+          }
+          self->maxSplitGroupMemoryBytes_ = std::max(
+              self->maxSplitGroupMemoryBytes_, splitGroupState.peakMemoryBytes);
           stateChangeNotifier.activate(std::move(self->stateChangePromises_));
           splitGroupState.clear();
           self->ensureSplitGroupsAreBeingProcessedLocked(self);
@@ -1004,7 +1048,8 @@ void Task::ensureSplitGroupsAreBeingProcessedLocked(
     return;
   }
 
-  while (numRunningSplitGroups_ < concurrentSplitGroups_ and
+  const auto maxConcurrentSplitGroups = maxConcurrentSplitGroupsLocked();
+  while (numRunningSplitGroups_ < maxConcurrentSplitGroups and
          not queuedSplitGroups_.empty()) {
     const uint32_t splitGroupId = queuedSplitGroups_.front();
     queuedSplitGroups_.pop();
@@ -1032,6 +1077,22 @@ void Task::ensureSplitGroupsAreBeingProcessedLocked(
   }
 }
 
+uint32_t Task::maxConcurrentSplitGroupsLocked() const {
+  const auto budget = queryCtx_->queryConfig().groupedExecutionMemoryBudget();
+  if (budget == 0) {
+    return concurrentSplitGroups_;
+  }
+  // Run one split group first to learn how much memory a split group takes.
+  if (taskStats_.completedSplitGroups.empty()) {
+    return 1;
+  }
+  if (maxSplitGroupMemoryBytes_ == 0) {
+    return concurrentSplitGroups_;
+  }
+  return std::clamp<uint64_t>(
+      budget / maxSplitGroupMemoryBytes_, 1, concurrentSplitGroups_);
+}
+
 void Task::setMaxSplitSequenceId(
     const core::PlanNodeId& planNodeId,
     long maxSequenceId) {
@@ -1139,6 +1200,13 @@ std::unique_ptr<ContinuePromise> Task::addSplitLocked(
     // We might have some free driver slots to process this split group.
     ensureSplitGroupsAreBeingProcessedLocked(self);
   }
+  if (checkpoint_ != nullptr && checkpoint_->isCommitted(splitGroupId)) {
+    // The drivers of the split group send the checkpointed pages instead of
+    // reading the split.
+    ++taskStats_.numFinishedSplits;
+    --taskStats_.numQueuedSplits;
+    return nullptr;
+  }
   return addSplitToStoreLocked(
       splitsState.groupSplitsStores[splitGroupId], std::move(split));
 }
@@ -1156,6 +1224,23 @@ std::unique_ptr<ContinuePromise> Task::addSplitToStoreLocked(
   return promise;
 }
 
+void Task::setInputRowsEstimate(
+    const core::PlanNodeId& planNodeId,
+    uint64_t numRows) {
+  std::lock_guard<std::mutex> l(mutex_);
+  inputRowsEstimates_[planNodeId] = numRows;
+}
+
+std::optional<uint64_t> Task::inputRowsEstimate(
+    const core::PlanNodeId& planNodeId) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = inputRowsEstimates_.find(planNodeId);
+  if (it == inputRowsEstimates_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
 void Task::noMoreSplitsForGroup(
     const core::PlanNodeId& planNodeId,
     int32_t splitGroupId) {
@@ -2355,6 +2440,21 @@ int32_t Task::yieldIfDue(uint64_t startTimeMicros) {
   return 0;
 }
 
+int8_t Task::schedulingPriority(int32_t numPriorities) const {
+  VELOX_CHECK_GT(numPriorities, 0);
+  int32_t level = 0;
+  const uint64_t cpuNanos = driverCpuTimeNanos_;
+  for (uint64_t levelCpuNanos = kTopSchedulingLevelCpuTimeNanos;
+       cpuNanos >= levelCpuNanos && level < numPriorities - 1;
+       levelCpuNanos *= 10) {
+    ++level;
+  }
+  // Folly executors with n priority queues map priorities from
+  // (n + 1) / 2 - 1 down to (n + 1) / 2 - n to their queues, highest first.
+  const int32_t highestPriority = (numPriorities + 1) / 2 - 1;
+  return highestPriority - level;
+}
+
 std::vector<ContinuePromise> Task::allThreadsFinishedLocked() {
   std::vector<ContinuePromise> threadFinishPromises;
   threadFinishPromises.swap(threadFinishPromises_);
@@ -2402,6 +2502,9 @@ void Task::createExchangeClient(
       destination_,
       addExchangeClientPool(planNodeId, pipelineId),
       queryCtx()->queryConfig().maxExchangeBufferSize());
+  if (timeline_ != nullptr) {
+    exchangeClients_[pipelineId]->setTimeline(timeline_, pipelineId);
+  }
   exchangeClientByPlanNode_.emplace(planNodeId, exchangeClients_[pipelineId]);
 }
 
@@ -22,7 +22,9 @@
 #include "velox/exec/MergeSource.h"
 #include "velox/exec/Split.h"
 #include "velox/exec/TaskStats.h"
+#include "velox/exec/TaskCheckpoint.h"
 #include "velox/exec/TaskStructs.h"
+#include "velox/exec/TaskTimeline.h"
 #include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox::exec {
@@ -97,6 +99,18 @@ class Task : public std::enable_shared_from_this<Task> {
   // in debugging messages and listings.
   static std::string shortId(const std::string& id);
 
+  /// Returns the timeline of the Task or nullptr if the
+  /// task_timeline_max_events query config is 0.
+  TaskTimeline* timeline() const {
+    return timeline_.get();
+  }
+
+  /// Returns the checkpoint of the split groups of the Task or nullptr if the
+  /// task_checkpoint_path query config is empty or the Task runs ungrouped.
+  TaskCheckpoint* checkpoint() const {
+    return checkpoint_.get();
+  }
+
   /// Returns QueryCtx specified in the constructor.
   const std::shared_ptr<core::QueryCtx>& queryCtx() const {
     return queryCtx_;
@@ -198,6 +212,21 @@ class Task : public std::enable_shared_from_this<Task> {
   /// corresponding to plan node with specified ID.
   void noMoreSplits(const core::PlanNodeId& planNodeId);
 
+  /// Sets the estimated total number of input rows of the operators of plan
+  /// node 'planNodeId', e.g. from the optimizer statistics or the connector
+  /// split statistics of the build side. Memory intensive operators like
+  /// HashBuild and OrderBy use it to reserve their forecast memory footprint in
+  /// one request instead of growing the reservation in small increments. Needs
+  /// to be set before the operators receive their first input.
+  void setInputRowsEstimate(
+      const core::PlanNodeId& planNodeId,
+      uint64_t numRows);
+
+  /// Returns the estimated total number of input rows of the operators of plan
+  /// node 'planNodeId' set by setInputRowsEstimate(), if any.
+  std::optional<uint64_t> inputRowsEstimate(
+      const core::PlanNodeId& planNodeId) const;
+
   /// Updates the total number of output buffers to broadcast or arbitrarily
   /// distribute the results of the execution to. Used when plan tree ends with
   /// a PartitionedOutputNode with broadcast of arbitrary output type.
@@ -544,6 +573,34 @@ class Task : public std::enable_shared_from_this<Task> {
   /// 'this' at the time of requesting yield. Returns 0 if yield not requested.
   int32_t yieldIfDue(uint64_t startTimeMicros);
 
+  /// Adds the CPU time a Driver of 'this' used in one run on a thread.
+  void addDriverCpuTimeNanos(uint64_t cpuNanos) {
+    driverCpuTimeNanos_ += cpuNanos;
+  }
+
+  /// Returns the CPU time used by the Drivers of 'this' so far, as recorded
+  /// with addDriverCpuTimeNanos().
+  uint64_t driverCpuTimeNanos() const {
+    return driverCpuTimeNanos_;
+  }
+
+  /// Counts a Driver of 'this' yielding because it used up its CPU time
+  /// slice.
+  void addTimeSliceYield() {
+    ++numTimeSliceYields_;
+  }
+
+  uint64_t numTimeSliceYields() const {
+    return numTimeSliceYields_;
+  }
+
+  /// Returns the priority to enqueue Drivers of 'this' with on an executor
+  /// with 'numPriorities' priority levels. This is a multi-level feedback
+  /// queue: Tasks start at the highest priority and move one level down each
+  /// time their CPU time grows by 10x over
+  /// 'kTopSchedulingLevelCpuTimeNanos'.
+  int8_t schedulingPriority(int32_t numPriorities) const;
+
   /// Once 'pauseRequested_' is set, it will not be cleared until
   /// task::resume(). It is therefore OK to read it without a mutex
   /// from a thread that this flag concerns.
@@ -574,6 +631,16 @@ class Task : public std::enable_shared_from_this<Task> {
     return spillDirectory_;
   }
 
+  /// Returns the directory of this task under 'spill_overflow_path' or an
+  /// empty string if there is no overflow tier.
+  std::string spillOverflowDirectory() const;
+
+  /// Counts the bytes spilled to 'spillDirectory()' by all the operators of
+  /// this task. Used to decide when to spill to 'spillOverflowDirectory()'.
+  std::atomic<uint64_t>& localSpillBytes() {
+    return localSpillBytes_;
+  }
+
   /// True if produces output via OutputBufferManager.
   bool hasPartitionedOutput() const {
     return numDriversInPartitionedOutput_ > 0;
@@ -606,7 +673,7 @@ class Task : public std::enable_shared_from_this<Task> {
   bool allNodesReceivedNoMoreSplitsMessageLocked() const;
 
   // Remove the spill directory, if the Task was creating it for potential
-  // spilling.
+  // spilling. Also removes the overflow spill directory if used.
   void removeSpillDirectoryIfExists();
 
   // Invoked to initialize the memory pool for this task on creation.
@@ -746,6 +813,13 @@ class Task : public std::enable_shared_from_this<Task> {
   /// processed. If yes, creates split group state and Drivers and runs them.
   void ensureSplitGroupsAreBeingProcessedLocked(std::shared_ptr<Task>& self);
 
+  /// Returns the number of split groups that may run at the same time. This is
+  /// 'concurrentSplitGroups_' unless the query has a grouped execution memory
+  /// budget. Then only one split group runs until one completes, after which
+  /// as many run as fit in the budget by the peak memory of the largest
+  /// completed split group.
+  uint32_t maxConcurrentSplitGroupsLocked() const;
+
   void driverClosedLocked();
 
   /// Returns true if Task is in kRunning state, but all output drivers finished
@@ -959,6 +1033,9 @@ class Task : public std::enable_shared_from_this<Task> {
   /// How many splits groups we are processing at the moment. Used to control
   /// split group concurrency. Ungrouped Split Group is not included here.
   uint32_t numRunningSplitGroups_{0};
+  /// The largest peak memory of a completed split group. See
+  /// maxConcurrentSplitGroupsLocked().
+  uint64_t maxSplitGroupMemoryBytes_{0};
   /// Split groups for which we have received at least one split - meaning our
   /// task is to process these. This set only grows. Used to deduplicate split
   /// groups for different nodes and to determine how many split groups we to
@@ -978,6 +1055,10 @@ class Task : public std::enable_shared_from_this<Task> {
   /// manage splits of the plan nodes that expect splits.
   std::unordered_map<core::PlanNodeId, SplitsState> splitsStates_;
 
+  // The estimated total number of input rows of plan nodes set by
+  // setInputRowsEstimate().
+  std::unordered_map<core::PlanNodeId, uint64_t> inputRowsEstimates_;
+
   // Promises that are fulfilled when the task is completed (terminated).
   std::vector<ContinuePromise> taskCompletionPromises_;
 
@@ -993,6 +1074,13 @@ class Task : public std::enable_shared_from_this<Task> {
 
   std::weak_ptr<OutputBufferManager> bufferManager_;
 
+  // Set if the task_timeline_max_events query config is not 0.
+  const std::shared_ptr<TaskTimeline> timeline_;
+
+  // Set in start() if the task_checkpoint_path query config is not empty and
+  // the Task runs grouped execution.
+  std::unique_ptr<TaskCheckpoint> checkpoint_;
+
   /// Boolean indicating that we have already received no-more-output-buffers
   /// message. Subsequent messages will be ignored.
   bool noMoreOutputBuffers_{false};
@@ -1011,6 +1099,15 @@ class Task : public std::enable_shared_from_this<Task> {
   // one thread running. Used to decide if continuous run should be
   // interrupted by yieldIfDue().
   tsan_atomic<uint64_t> onThreadSince_{0};
+
+  // The CPU time Tasks may use at the top scheduling priority.
+  static constexpr uint64_t kTopSchedulingLevelCpuTimeNanos = 1'000'000'000;
+
+  // CPU time used by the Drivers of 'this'. Only recorded if Drivers run
+  // with a CPU time slice limit.
+  std::atomic<uint64_t> driverCpuTimeNanos_{0};
+  // Number of times a Driver yielded at the end of its time slice.
+  std::atomic<uint64_t> numTimeSliceYields_{0};
   // Promises for the futures returned to callers of requestPause() or
   // terminate(). They are fulfilled when the last thread stops
   // running for 'this'.
@@ -1018,6 +1115,9 @@ class Task : public std::enable_shared_from_this<Task> {
 
   // Base spill directory for this task.
   std::string spillDirectory_;
+
+  // Bytes spilled to 'spillDirectory_'.
+  std::atomic<uint64_t> localSpillBytes_{0};
 };
 
 /// Listener invoked on task completion.
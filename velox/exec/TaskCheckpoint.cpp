@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/TaskCheckpoint.h"
+
+#include <folly/Conv.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/file/File.h"
+
+namespace facebook::velox::exec {
+namespace {
+constexpr std::string_view kSuffix = ".pages";
+constexpr std::string_view kTemporarySuffix = ".pages.tmp";
+
+// A page is stored as its destination and size followed by the bytes.
+struct PageHeader {
+  int32_t destination;
+  uint64_t size;
+};
+} // namespace
+
+TaskCheckpoint::TaskCheckpoint(const std::string& directory)
+    : directory_(directory),
+      fs_(filesystems::getFileSystem(directory_, nullptr)) {
+  fs_->mkdir(directory_);
+  for (const auto& path : fs_->list(directory_)) {
+    std::string_view name(path);
+    const auto slash = name.rfind('/');
+    if (slash != std::string_view::npos) {
+      name.remove_prefix(slash + 1);
+    }
+    if (name.size() <= kSuffix.size() ||
+        name.substr(name.size() - kSuffix.size()) != kSuffix) {
+      continue;
+    }
+    auto splitGroupId = folly::tryTo<uint32_t>(
+        name.substr(0, name.size() - kSuffix.size()));
+    if (splitGroupId.hasValue()) {
+      committed_.insert(splitGroupId.value());
+    }
+  }
+}
+
+std::string TaskCheckpoint::filePath(uint32_t splitGroupId, bool temporary)
+    const {
+  return fmt::format(
+      "{}/{}{}",
+      directory_,
+      splitGroupId,
+      temporary ? kTemporarySuffix : kSuffix);
+}
+
+bool TaskCheckpoint::isCommitted(uint32_t splitGroupId) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return committed_.contains(splitGroupId);
+}
+
+void TaskCheckpoint::addPage(
+    uint32_t splitGroupId,
+    int32_t destination,
+    const folly::IOBuf& page) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(
+      !committed_.contains(splitGroupId),
+      "Split group {} is already checkpointed",
+      splitGroupId);
+  auto& file = files_[splitGroupId];
+  if (file == nullptr) {
+    // Drop the leftover of a failed run.
+    const auto path = filePath(splitGroupId, true);
+    if (fs_->exists(path)) {
+      fs_->remove(path);
+    }
+    file = fs_->openFileForWrite(path);
+  }
+  const PageHeader header{destination, page.computeChainDataLength()};
+  file->append(std::string_view(
+      reinterpret_cast<const char*>(&header), sizeof(header)));
+  for (const auto& range : page) {
+    file->append(std::string_view(
+        reinterpret_cast<const char*>(range.data()), range.size()));
+  }
+}
+
+void TaskCheckpoint::commit(uint32_t splitGroupId) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (committed_.contains(splitGroupId)) {
+    return;
+  }
+  auto it = files_.find(splitGroupId);
+  if (it == files_.end()) {
+    // The split group produced no pages.
+    fs_->openFileForWrite(filePath(splitGroupId, false))->close();
+  } else {
+    it->second->close();
+    files_.erase(it);
+    fs_->rename(
+        filePath(splitGroupId, true), filePath(splitGroupId, false), true);
+  }
+  committed_.insert(splitGroupId);
+  taken_.insert(splitGroupId);
+}
+
+std::vector<TaskCheckpoint::Page> TaskCheckpoint::takePages(
+    uint32_t splitGroupId) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(committed_.contains(splitGroupId));
+    if (!taken_.insert(splitGroupId).second) {
+      return {};
+    }
+  }
+  auto file = fs_->openFileForRead(filePath(splitGroupId, false));
+  const auto contents = file->pread(0, file->size());
+  std::vector<Page> pages;
+  uint64_t offset = 0;
+  while (offset < contents.size()) {
+    VELOX_CHECK_LE(offset + sizeof(PageHeader), contents.size());
+    PageHeader header;
+    memcpy(&header, contents.data() + offset, sizeof(header));
+    offset += sizeof(header);
+    VELOX_CHECK_LE(offset + header.size, contents.size());
+    pages.push_back(
+        {header.destination,
+         folly::IOBuf::copyBuffer(contents.data() + offset, header.size)});
+    offset += header.size;
+  }
+  return pages;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
+#include <folly/io/IOBuf.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "velox/common/file/FileSystems.h"
+
+namespace facebook::velox::exec {
+
+/// Keeps the PartitionedOutput pages of the completed split groups of a task
+/// in grouped execution in a directory on durable storage, so that a restarted
+/// task can send the checkpointed pages again instead of rereading the splits
+/// of these groups. Enabled by the task_checkpoint_path query config. The
+/// pages of a split group are appended to a temporary file that is renamed
+/// when the split group completes, so a task that fails mid-group leaves no
+/// partial checkpoint behind.
+class TaskCheckpoint {
+ public:
+  struct Page {
+    int32_t destination;
+    std::unique_ptr<folly::IOBuf> data;
+  };
+
+  /// Opens the checkpoint in 'directory', creating the directory if needed.
+  /// Split groups committed by an earlier run of the task are loaded.
+  explicit TaskCheckpoint(const std::string& directory);
+
+  /// True if the pages of 'splitGroupId' were committed by this or an earlier
+  /// run of the task.
+  bool isCommitted(uint32_t splitGroupId) const;
+
+  /// Appends 'page' for 'destination' to the pages of 'splitGroupId'.
+  void addPage(
+      uint32_t splitGroupId,
+      int32_t destination,
+      const folly::IOBuf& page);
+
+  /// Makes the pages added for 'splitGroupId' durable. No-op if the group is
+  /// already committed.
+  void commit(uint32_t splitGroupId);
+
+  /// Returns the committed pages of 'splitGroupId' in the order they were
+  /// added. The first call returns the pages, later calls return none, so
+  /// that only one of the drivers of the split group sends them.
+  std::vector<Page> takePages(uint32_t splitGroupId);
+
+ private:
+  std::string filePath(uint32_t splitGroupId, bool temporary) const;
+
+  const std::string directory_;
+  const std::shared_ptr<filesystems::FileSystem> fs_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastSet<uint32_t> committed_;
+  // Groups whose pages were returned by takePages().
+  folly::F14FastSet<uint32_t> taken_;
+  // The temporary files of the split groups being written.
+  folly::F14FastMap<uint32_t, std::unique_ptr<WriteFile>> files_;
+};
+
+} // namespace facebook::velox::exec
@@ -114,6 +114,11 @@ struct SplitGroupState {
   /// e.g. Limit.
   uint32_t numFinishedOutputDrivers{0};
 
+  /// Sum of the peak memory of the operators of the finished drivers of this
+  /// split group. Used to estimate the memory of the next split groups when
+  /// the task has a grouped execution memory budget.
+  uint64_t peakMemoryBytes{0};
+
   // True if the state contains structures used for connecting ungrouped
   // execution pipeline with grouped excution pipeline. In that case we don't
   // want to clean up some of these structures.
@@ -129,6 +134,7 @@ struct SplitGroupState {
     localMergeSources.clear();
     mergeJoinSources.clear();
     localExchanges.clear();
+    peakMemoryBytes = 0;
   }
 };
 
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/TaskTimeline.h"
+
+#include <unordered_set>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/Driver.h"
+
+namespace facebook::velox::exec {
+
+TaskTimeline::TaskTimeline(uint32_t maxEvents) : maxEvents_(maxEvents) {
+  VELOX_CHECK_GT(maxEvents_, 0);
+}
+
+void TaskTimeline::record(Event event) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (events_.size() < maxEvents_) {
+    events_.push_back(std::move(event));
+  } else {
+    events_[numRecorded_ % maxEvents_] = std::move(event);
+  }
+  ++numRecorded_;
+}
+
+void TaskTimeline::onTrace(
+    const std::string& label,
+    std::chrono::steady_clock::time_point start,
+    std::chrono::steady_clock::time_point end) {
+  const uint64_t durationMicros =
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+          .count();
+  // The other events are on the system clock.
+  const auto sinceEndMicros =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - end)
+          .count();
+  Event event{.category = "trace", .name = label};
+  if (auto* context = driverThreadContext()) {
+    event.pipelineId = context->driverCtx.pipelineId;
+    event.driverId = context->driverCtx.driverId;
+  }
+  event.startMicros = getCurrentTimeMicro() - sinceEndMicros - durationMicros;
+  event.durationMicros = durationMicros;
+  record(std::move(event));
+}
+
+std::vector<TaskTimeline::Event> TaskTimeline::events() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (events_.size() < maxEvents_) {
+    return events_;
+  }
+  const auto oldest = numRecorded_ % maxEvents_;
+  std::vector<Event> result(events_.begin() + oldest, events_.end());
+  result.insert(result.end(), events_.begin(), events_.begin() + oldest);
+  return result;
+}
+
+uint64_t TaskTimeline::numDropped() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numRecorded_ - events_.size();
+}
+
+folly::dynamic TaskTimeline::toChromeTrace(const std::string& taskId) const {
+  const auto kept = events();
+  folly::dynamic traceEvents = folly::dynamic::array;
+  std::unordered_set<int32_t> pipelines;
+  std::unordered_set<int64_t> drivers;
+  for (const auto& event : kept) {
+    // Process 0 holds the events recorded off driver threads.
+    const int64_t pid = event.pipelineId + 1;
+    const int64_t tid = event.driverId + 1;
+    folly::dynamic json = folly::dynamic::object;
+    json["name"] = event.name;
+    json["cat"] = event.category;
+    json["ph"] = "X";
+    json["ts"] = static_cast<int64_t>(event.startMicros);
+    json["dur"] = static_cast<int64_t>(event.durationMicros);
+    json["pid"] = pid;
+    json["tid"] = tid;
+    if (!event.detail.empty()) {
+      json["args"] = folly::dynamic::object("detail", event.detail);
+    }
+    traceEvents.push_back(std::move(json));
+
+    if (pipelines.insert(pid).second) {
+      traceEvents.push_back(folly::dynamic::object("name", "process_name")(
+          "ph", "M")("pid", pid)(
+          "args",
+          folly::dynamic::object(
+              "name",
+              pid == 0 ? "background"
+                       : fmt::format("pipeline {}", event.pipelineId))));
+    }
+    if (drivers.insert((pid << 32) | tid).second) {
+      traceEvents.push_back(folly::dynamic::object("name", "thread_name")(
+          "ph", "M")("pid", pid)("tid", tid)(
+          "args",
+          folly::dynamic::object(
+              "name",
+              tid == 0 ? "background"
+                       : fmt::format("driver {}", event.driverId))));
+    }
+  }
+  folly::dynamic trace = folly::dynamic::object;
+  trace["traceEvents"] = std::move(traceEvents);
+  trace["displayTimeUnit"] = "ms";
+  trace["otherData"] = folly::dynamic::object("taskId", taskId)(
+      "droppedEvents", static_cast<int64_t>(numDropped()));
+  return trace;
+}
+
+} // namespace facebook::velox::exec
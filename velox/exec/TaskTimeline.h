@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/json.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "velox/common/process/TraceContext.h"
+
+namespace facebook::velox::exec {
+
+/// Keeps the most recent timed events of a Task in a ring buffer for export
+/// as a timeline in the Chrome trace event format, which chrome://tracing and
+/// Perfetto can open. Events are runs of drivers on threads, the intervals in
+/// which drivers are blocked and the sections traced by process::TraceContext
+/// on driver threads, e.g. spill writes and cache loads. Enabled by the
+/// task_timeline_max_events query config.
+class TaskTimeline : public process::TraceListener {
+ public:
+  struct Event {
+    /// Kind of the event, e.g. "driver" or "blocked".
+    std::string category;
+    std::string name;
+    /// Optional detail, e.g. the operator a driver is blocked on.
+    std::string detail;
+    /// The pipeline and driver of the event or -1 if the event was recorded
+    /// off a driver thread.
+    int32_t pipelineId{-1};
+    int32_t driverId{-1};
+    uint64_t startMicros{0};
+    uint64_t durationMicros{0};
+  };
+
+  explicit TaskTimeline(uint32_t maxEvents);
+
+  /// Adds 'event', replacing the oldest event if the buffer is full.
+  void record(Event event);
+
+  /// Records a section traced on a driver thread of the Task.
+  void onTrace(
+      const std::string& label,
+      std::chrono::steady_clock::time_point start,
+      std::chrono::steady_clock::time_point end) override;
+
+  /// Returns the kept events, oldest first.
+  std::vector<Event> events() const;
+
+  /// Returns the number of events replaced by newer ones.
+  uint64_t numDropped() const;
+
+  /// Returns the kept events as a Chrome trace of complete ('X') events with
+  /// a process per pipeline and a thread per driver.
+  folly::dynamic toChromeTrace(const std::string& taskId) const;
+
+  std::string toChromeTraceJson(const std::string& taskId) const {
+    return folly::toJson(toChromeTrace(taskId));
+  }
+
+ private:
+  const uint32_t maxEvents_;
+
+  mutable std::mutex mutex_;
+  std::vector<Event> events_;
+  // Total number of recorded events. The next event goes to
+  // 'events_[numRecorded_ % maxEvents_]' once 'events_' is full.
+  uint64_t numRecorded_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/TopN.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/vector/FlatVector.h"
 
@@ -36,15 +37,109 @@ TopN::TopN(
           topNNode->sortingOrders(),
           data_.get()),
       topRows_(comparator_),
-      decodedVectors_(outputType_->children().size()) {}
+      decodedVectors_(outputType_->children().size()),
+      firstKeyChannel_(
+          exprToChannel(topNNode->sortingKeys()[0].get(), outputType_)),
+      firstKeyOrder_(topNNode->sortingOrders()[0]) {}
+
+template <typename T>
+vector_size_t TopN::selectCandidateRows(vector_size_t numInput, T threshold) {
+  const auto& decoded = decodedVectors_[firstKeyChannel_];
+  const bool ascending = firstKeyOrder_.isAscending();
+  auto* candidates = candidateRows_.data();
+  vector_size_t numCandidates = 0;
+  vector_size_t row = 0;
+  if (decoded.isIdentityMapping() && !decoded.mayHaveNulls()) {
+    const auto* values = decoded.data<T>();
+    if constexpr (std::is_integral_v<T>) {
+      using Batch = xsimd::batch<T>;
+      const auto thresholds = Batch::broadcast(threshold);
+      for (; row + Batch::size <= numInput; row += Batch::size) {
+        const auto batch = Batch::load_unaligned(values + row);
+        uint64_t mask = simd::toBitMask(
+            ascending ? batch <= thresholds : batch >= thresholds);
+        while (mask) {
+          candidates[numCandidates++] = row + __builtin_ctzll(mask);
+          mask &= mask - 1;
+        }
+      }
+    }
+    for (; row < numInput; ++row) {
+      candidates[numCandidates] = row;
+      numCandidates += ascending ? values[row] <= threshold
+                                 : values[row] >= threshold;
+    }
+    return numCandidates;
+  }
+
+  const bool nullsFirst = firstKeyOrder_.isNullsFirst();
+  for (; row < numInput; ++row) {
+    candidates[numCandidates] = row;
+    if (decoded.isNullAt(row)) {
+      numCandidates += nullsFirst;
+      continue;
+    }
+    const auto value = decoded.valueAt<T>(row);
+    numCandidates += ascending ? value <= threshold : value >= threshold;
+  }
+  return numCandidates;
+}
+
+std::optional<vector_size_t> TopN::selectCandidateRows(vector_size_t numInput) {
+  const char* topRow = topRows_.top();
+  const auto column = data_->columnAt(firstKeyChannel_);
+  if (RowContainer::isNullAt(topRow, column.nullByte(), column.nullMask())) {
+    return std::nullopt;
+  }
+
+  candidateRows_.resize(numInput);
+  const auto offset = column.offset();
+  switch (outputType_->childAt(firstKeyChannel_)->kind()) {
+    case TypeKind::TINYINT:
+      return selectCandidateRows(
+          numInput, RowContainer::valueAt<int8_t>(topRow, offset));
+    case TypeKind::SMALLINT:
+      return selectCandidateRows(
+          numInput, RowContainer::valueAt<int16_t>(topRow, offset));
+    case TypeKind::INTEGER:
+      return selectCandidateRows(
+          numInput, RowContainer::valueAt<int32_t>(topRow, offset));
+    case TypeKind::BIGINT:
+      return selectCandidateRows(
+          numInput, RowContainer::valueAt<int64_t>(topRow, offset));
+    case TypeKind::TIMESTAMP:
+      return selectCandidateRows(
+          numInput, RowContainer::valueAt<Timestamp>(topRow, offset));
+    default:
+      return std::nullopt;
+  }
+}
 
 void TopN::addInput(RowVectorPtr input) {
-  // TODO Decode keys first, then decode the rest only for passing positions
+  const auto numInput = input->size();
+  std::optional<vector_size_t> numCandidates;
+  if (topRows_.size() == count_) {
+    // Once the top rows are known, drops the rows whose first key sorts after
+    // the first key of the current top row before decoding the other columns.
+    // Rows that sort after the top row now also sort after it once it is
+    // replaced by a smaller row.
+    decodedVectors_[firstKeyChannel_].decode(
+        *input->childAt(firstKeyChannel_));
+    numCandidates = selectCandidateRows(numInput);
+    if (numCandidates == 0) {
+      return;
+    }
+  }
+
   for (auto col = 0; col < input->childrenSize(); ++col) {
-    decodedVectors_[col].decode(*input->childAt(col));
+    if (col != firstKeyChannel_ || !numCandidates.has_value()) {
+      decodedVectors_[col].decode(*input->childAt(col));
+    }
   }
 
-  for (auto row = 0; row < input->size(); ++row) {
+  const auto numRows = numCandidates.value_or(numInput);
+  for (auto i = 0; i < numRows; ++i) {
+    const auto row = numCandidates.has_value() ? candidateRows_[i] : i;
     char* newRow = nullptr;
     if (topRows_.size() < count_) {
       newRow = data_->newRow();
@@ -44,6 +44,17 @@ class TopN : public Operator {
   bool isFinished() override;
 
  private:
+  // Returns the number of rows of 'input' whose first sort key does not sort
+  // after the first sort key of the current top row, and stores their indices
+  // in 'candidateRows_'. The other rows can not make it into the top rows.
+  // Returns std::nullopt if the first key can not be used to drop rows, e.g.
+  // because it is not of an integer type. Must be called when 'topRows_' is
+  // full and after decoding the first key column of 'input'.
+  std::optional<vector_size_t> selectCandidateRows(vector_size_t numInput);
+
+  template <typename T>
+  vector_size_t selectCandidateRows(vector_size_t numInput, T threshold);
+
   const int32_t count_;
 
   bool finished_ = false;
@@ -65,5 +76,11 @@ class TopN : public Operator {
 
   std::vector<DecodedVector> decodedVectors_;
   vector_size_t outputBatchSize_;
+
+  // The channel and the order of the first sort key.
+  const column_index_t firstKeyChannel_;
+  const core::SortOrder firstKeyOrder_;
+  // Indices of the input rows that pass selectCandidateRows().
+  std::vector<vector_size_t> candidateRows_;
 };
 } // namespace facebook::velox::exec
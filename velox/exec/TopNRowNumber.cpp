@@ -143,14 +143,15 @@ TopNRowNumber::TopNRowNumber(
   if (numKeys > 0) {
     Accumulator accumulator{
         true,
-        sizeof(TopRows),
+        static_cast<int32_t>(
+            sizeof(TopRows) + (inlineTopRows() ? limit_ * sizeof(char*) : 0)),
         false,
         1,
         [](auto, auto) { VELOX_UNREACHABLE(); },
         [](auto) {}};
 
     table_ = std::make_unique<HashTable<false>>(
-        createVectorHashers(node->inputType(), keys),
+        createVectorHashers(node->inputType(), keys, pool()),
         std::vector<Accumulator>{accumulator},
         std::vector<TypePtr>{},
         false, // allowDuplicates
@@ -162,7 +163,7 @@ TopNRowNumber::TopNRowNumber(
     lookup_ = std::make_unique<HashLookup>(table_->hashers());
   } else {
     allocator_ = std::make_unique<HashStringAllocator>(pool());
-    singlePartition_ = std::make_unique<TopRows>(allocator_.get(), comparator_);
+    singlePartition_ = std::make_unique<TopRows>();
   }
 
   if (generateRowNumber_) {
@@ -203,27 +204,63 @@ void TopNRowNumber::addInput(RowVectorPtr input) {
 
 void TopNRowNumber::initializeNewPartitions() {
   for (auto index : lookup_->newGroups) {
-    new (lookup_->hits[index] + partitionOffset_)
-        TopRows(table_->stringAllocator(), comparator_);
+    auto* partition = new (lookup_->hits[index] + partitionOffset_) TopRows();
+    if (inlineTopRows()) {
+      partition->rows = reinterpret_cast<char**>(
+          lookup_->hits[index] + partitionOffset_ + sizeof(TopRows));
+      partition->capacity = limit_;
+    }
+  }
+}
+
+void TopNRowNumber::growTopRows(TopRows& partition) {
+  VELOX_DCHECK_LT(partition.capacity, limit_);
+  StlAllocator<char*> allocator(topRowsAllocator());
+  const auto newCapacity = std::min<int32_t>(
+      limit_, std::max<int32_t>(kMaxInlineRows, partition.capacity * 2));
+  auto* newRows = allocator.allocate(newCapacity);
+  if (partition.rows != nullptr) {
+    std::copy(partition.rows, partition.rows + partition.size, newRows);
+    allocator.deallocate(partition.rows, partition.capacity);
+  }
+  partition.rows = newRows;
+  partition.capacity = newCapacity;
+}
+
+void TopNRowNumber::freeTopRows(TopRows& partition) {
+  if (inlineTopRows() && table_) {
+    return;
+  }
+  if (partition.rows != nullptr) {
+    StlAllocator<char*>(topRowsAllocator())
+        .deallocate(partition.rows, partition.capacity);
+    partition.rows = nullptr;
+    partition.capacity = 0;
   }
 }
 
 void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
-  auto& topRows = partition.rows;
+  auto compare = [&](const char* lhs, const char* rhs) {
+    return comparator_(lhs, rhs);
+  };
 
   char* newRow = nullptr;
-  if (topRows.size() < limit_) {
+  if (partition.size < limit_) {
+    if (partition.size == partition.capacity) {
+      growTopRows(partition);
+    }
     newRow = data_->newRow();
+    ++partition.size;
   } else {
-    char* topRow = topRows.top();
+    char* topRow = partition.rows[0];
 
     if (!comparator_(decodedVectors_, index, topRow)) {
       // Drop this input row.
       return;
     }
 
-    // Replace existing row.
-    topRows.pop();
+    // Replace existing row. Moves it to the end of the heap.
+    std::pop_heap(partition.rows, partition.rows + partition.size, compare);
 
     // Reuse the topRow's memory.
     newRow = data_->initializeRow(topRow, true /* reuse */);
@@ -233,7 +270,8 @@ void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
     data_->store(decodedVectors_[col], index, newRow, col);
   }
 
-  topRows.push(newRow);
+  partition.rows[partition.size - 1] = newRow;
+  std::push_heap(partition.rows, partition.rows + partition.size, compare);
 }
 
 void TopNRowNumber::noMoreInput() {
@@ -324,15 +362,21 @@ void TopNRowNumber::appendPartitionRows(
     vector_size_t size,
     vector_size_t outputOffset,
     FlatVector<int64_t>* rowNumbers) {
-  // Append 'size' partition rows in reverse order starting from 'start' row.
-  auto rowNumber = partition.rows.size() - start;
+  if (start == 0) {
+    std::sort_heap(
+        partition.rows,
+        partition.rows + partition.size,
+        [&](const char* lhs, const char* rhs) {
+          return comparator_(lhs, rhs);
+        });
+  }
   for (auto i = 0; i < size; ++i) {
-    const auto index = outputOffset + size - i - 1;
+    const auto index = outputOffset + i;
     if (rowNumbers) {
-      rowNumbers->set(index, rowNumber--);
+      // Row numbers start with 1.
+      rowNumbers->set(index, start + i + 1);
     }
-    outputRows_[index] = partition.rows.top();
-    partition.rows.pop();
+    outputRows_[index] = partition.rows[start + i];
   }
 }
 
@@ -360,7 +404,7 @@ RowVectorPtr TopNRowNumber::getOutputFromMemory() {
   vector_size_t offset = 0;
   if (remainingRowsInPartition_ > 0) {
     auto& partition = currentPartition();
-    auto start = partition.rows.size() - remainingRowsInPartition_;
+    auto start = partition.size - remainingRowsInPartition_;
     auto numRows =
         std::min<vector_size_t>(outputBatchSize_, remainingRowsInPartition_);
     appendPartitionRows(partition, start, numRows, offset, rowNumbers);
@@ -374,7 +418,7 @@ RowVectorPtr TopNRowNumber::getOutputFromMemory() {
       break;
     }
 
-    auto numRows = partition->rows.size();
+    auto numRows = partition->size;
     if (offset + numRows > outputBatchSize_) {
       remainingRowsInPartition_ = offset + numRows - outputBatchSize_;
 
@@ -551,10 +595,11 @@ void TopNRowNumber::close() {
                RowContainer::kUnlimited,
                partitions_.data())) {
       for (auto i = 0; i < numPartitions; ++i) {
-        std::destroy_at(
-            reinterpret_cast<TopRows*>(partitions_[i] + partitionOffset_));
+        freeTopRows(partitionAt(partitions_[i]));
       }
     }
+  } else if (singlePartition_) {
+    freeTopRows(*singlePartition_);
   }
 }
 
@@ -671,6 +716,8 @@ void TopNRowNumber::setupSpiller() {
       spillConfig_->minSpillRunSize,
       spillConfig_->compressionKind,
       memory::spillMemoryPool(),
-      spillConfig_->executor);
+      spillConfig_->executor,
+      spillConfig_->overflowTier,
+      spillConfig_->fileFormat);
 }
 } // namespace facebook::velox::exec
@@ -63,22 +63,32 @@ class TopNRowNumber : public Operator {
       override;
 
  private:
-  // A priority queue to keep track of top 'limit' rows for a given partition.
+  // Top 'limit_' rows of a partition, kept as a binary heap ordered by
+  // 'comparator_' so that the first row is the one to replace next. For limits
+  // up to kMaxInlineRows, the heap slots follow this struct in the partition
+  // row of 'table_'. For larger limits, the slots are allocated from the
+  // HashStringAllocator and grow as rows are added.
   struct TopRows {
-    struct Compare {
-      RowComparator& comparator;
+    char** rows{nullptr};
+    int32_t size{0};
+    int32_t capacity{0};
+  };
 
-      bool operator()(const char* lhs, const char* rhs) {
-        return comparator(lhs, rhs);
-      }
-    };
+  static constexpr int32_t kMaxInlineRows = 16;
 
-    std::priority_queue<char*, std::vector<char*, StlAllocator<char*>>, Compare>
-        rows;
+  bool inlineTopRows() const {
+    return limit_ <= kMaxInlineRows;
+  }
 
-    TopRows(HashStringAllocator* allocator, RowComparator& comparator)
-        : rows{{comparator}, StlAllocator<char*>(allocator)} {}
-  };
+  HashStringAllocator* topRowsAllocator() const {
+    return table_ ? table_->stringAllocator() : allocator_.get();
+  }
+
+  // Makes room for one more row in 'partition'.
+  void growTopRows(TopRows& partition);
+
+  // Frees heap slots allocated by growTopRows().
+  void freeTopRows(TopRows& partition);
 
   void initializeNewPartitions();
 
@@ -96,8 +106,9 @@ class TopNRowNumber : public Operator {
   // Returns partition that was partially added to the previous output batch.
   TopRows& currentPartition();
 
-  // Appends partition rows to outputRows_ and optionally populates row
-  // numbers.
+  // Appends 'size' partition rows starting at 'start' in sorted order to
+  // outputRows_ and optionally populates row numbers. Sorts the partition rows
+  // when 'start' is zero.
   void appendPartitionRows(
       TopRows& partition,
       vector_size_t start,
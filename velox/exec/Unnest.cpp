@@ -30,7 +30,10 @@ Unnest::Unnest(
           operatorId,
           unnestNode->id(),
           "Unnest"),
-      withOrdinality_(unnestNode->withOrdinality()) {
+      withOrdinality_(unnestNode->withOrdinality()),
+      splitOutput_(driverCtx->queryConfig().unnestSplitOutput()),
+      batchSizeByBytes_(driverCtx->queryConfig().outputBatchSizeByBytes()),
+      maxOutputSize_(outputBatchRows()) {
   const auto& inputType = unnestNode->sources()[0]->outputType();
   const auto& unnestVariables = unnestNode->unnestVariables();
   for (const auto& variable : unnestVariables) {
@@ -106,6 +109,32 @@ void Unnest::addInput(RowVectorPtr input) {
       }
     }
   }
+
+  if (batchSizeByBytes_) {
+    maxOutputSize_ = outputBatchRows(estimateOutputRowSize());
+  }
+}
+
+uint64_t Unnest::estimateOutputRowSize() const {
+  const auto size = input_->size();
+  if (size == 0) {
+    return 0;
+  }
+  uint64_t replicatedBytes = 0;
+  for (const auto& projection : identityProjections_) {
+    replicatedBytes +=
+        input_->childAt(projection.inputChannel)->estimateFlatSize();
+  }
+  uint64_t unnestBytes = 0;
+  for (auto channel : unnestChannels_) {
+    unnestBytes += input_->childAt(channel)->estimateFlatSize();
+  }
+  uint64_t numElements = 0;
+  for (auto row = 0; row < size; ++row) {
+    numElements += rawMaxSizes_[row];
+  }
+  return replicatedBytes / size +
+      unnestBytes / std::max<uint64_t>(numElements, 1);
 }
 
 RowVectorPtr Unnest::getOutput() {
@@ -114,17 +143,28 @@ RowVectorPtr Unnest::getOutput() {
   }
 
   const auto size = input_->size();
-  const auto maxOutputSize = outputBatchRows();
+  const auto maxOutputSize = maxOutputSize_;
 
   // Limit the number of input rows to keep output batch size within
-  // 'maxOutputSize' if possible. Process each input row fully. Do not break
-  // single row's output into multiple batches.
+  // 'maxOutputSize' if possible. Unless 'splitOutput_' is set, process each
+  // input row fully and do not break single row's output into multiple
+  // batches.
   vector_size_t numInput = 0;
   vector_size_t numElements = 0;
+  vector_size_t lastRowEnd = 0;
   for (auto row = nextInputRow_; row < size; ++row) {
-    numElements += rawMaxSizes_[row];
+    const auto rowStart = row == nextInputRow_ ? nextElement_ : 0;
+    const auto rowSize = rawMaxSizes_[row] - rowStart;
     ++numInput;
 
+    if (splitOutput_ && numElements + rowSize > maxOutputSize) {
+      lastRowEnd = rowStart + (maxOutputSize - numElements);
+      numElements = maxOutputSize;
+      break;
+    }
+    numElements += rowSize;
+    lastRowEnd = rawMaxSizes_[row];
+
     if (numElements >= maxOutputSize) {
       break;
     }
@@ -134,12 +174,20 @@ RowVectorPtr Unnest::getOutput() {
     // All arrays/maps are null or empty.
     input_ = nullptr;
     nextInputRow_ = 0;
+    nextElement_ = 0;
     return nullptr;
   }
 
-  auto output = generateOutput(nextInputRow_, numInput, numElements);
+  auto output = generateOutput(
+      nextInputRow_, numInput, nextElement_, lastRowEnd, numElements);
 
   nextInputRow_ += numInput;
+  nextElement_ = 0;
+  if (lastRowEnd < rawMaxSizes_[nextInputRow_ - 1]) {
+    // The last row continues in the next batch.
+    --nextInputRow_;
+    nextElement_ = lastRowEnd;
+  }
 
   if (nextInputRow_ >= size) {
     input_ = nullptr;
@@ -152,16 +200,29 @@ RowVectorPtr Unnest::getOutput() {
 RowVectorPtr Unnest::generateOutput(
     vector_size_t start,
     vector_size_t size,
+    vector_size_t firstRowStart,
+    vector_size_t lastRowEnd,
     vector_size_t numElements) {
+  const auto end = start + size;
+  // Returns the range of elements of 'row' in the output.
+  auto rowRange = [&](vector_size_t row) {
+    return std::pair<vector_size_t, vector_size_t>{
+        row == start ? firstRowStart : 0,
+        row == end - 1 ? lastRowEnd : rawMaxSizes_[row]};
+  };
+
   // Create "indices" buffer to repeat rows as many times as there are elements
   // in the array (or map) in unnestDecoded.
   auto repeatedIndices = allocateIndices(numElements, pool());
   auto* rawRepeatedIndices = repeatedIndices->asMutable<vector_size_t>();
   vector_size_t index = 0;
-  for (auto row = start; row < start + size; ++row) {
-    for (auto i = 0; i < rawMaxSizes_[row]; i++) {
-      rawRepeatedIndices[index++] = row;
-    }
+  for (auto row = start; row < end; ++row) {
+    const auto [rowStart, rowEnd] = rowRange(row);
+    std::fill(
+        rawRepeatedIndices + index,
+        rawRepeatedIndices + index + rowEnd - rowStart,
+        row);
+    index += rowEnd - rowStart;
   }
 
   // Wrap "replicated" columns in a dictionary using 'repeatedIndices'.
@@ -189,28 +250,30 @@ RowVectorPtr Unnest::generateOutput(
     // Make dictionary index for elements column since they may be out of order.
     index = 0;
     bool identityMapping = true;
-    for (auto row = start; row < start + size; ++row) {
-      auto maxSize = rawMaxSizes_[row];
+    for (auto row = start; row < end; ++row) {
+      const auto [rowStart, rowEnd] = rowRange(row);
 
       if (!currentDecoded.isNullAt(row)) {
         auto offset = currentOffsets[currentIndices[row]];
         auto unnestSize = currentSizes[currentIndices[row]];
 
-        if (index != offset || unnestSize < maxSize) {
+        if (index != offset + rowStart || unnestSize < rowEnd) {
           identityMapping = false;
         }
 
-        for (auto i = 0; i < unnestSize; i++) {
+        const auto sizeInOutput =
+            std::max(rowStart, std::min(unnestSize, rowEnd));
+        for (auto i = rowStart; i < sizeInOutput; i++) {
           rawElementIndices[index++] = offset + i;
         }
 
-        for (auto i = unnestSize; i < maxSize; ++i) {
+        for (auto i = sizeInOutput; i < rowEnd; ++i) {
           bits::setNull(rawNulls, index++, true);
         }
-      } else if (maxSize > 0) {
+      } else if (rowEnd > rowStart) {
         identityMapping = false;
 
-        for (auto i = 0; i < maxSize; ++i) {
+        for (auto i = rowStart; i < rowEnd; ++i) {
           bits::setNull(rawNulls, index++, true);
         }
       }
@@ -249,10 +312,10 @@ RowVectorPtr Unnest::generateOutput(
     // Set the ordinality at each result row to be the index of the element in
     // the original array (or map) plus one.
     auto rawOrdinality = ordinalityVector->mutableRawValues();
-    for (auto row = start; row < start + size; ++row) {
-      auto maxSize = rawMaxSizes_[row];
-      std::iota(rawOrdinality, rawOrdinality + maxSize, 1);
-      rawOrdinality += maxSize;
+    for (auto row = start; row < end; ++row) {
+      const auto [rowStart, rowEnd] = rowRange(row);
+      std::iota(rawOrdinality, rawOrdinality + rowEnd - rowStart, rowStart + 1);
+      rawOrdinality += rowEnd - rowStart;
     }
 
     // Ordinality column is always at the end.
@@ -40,16 +40,32 @@ class Unnest : public Operator {
 
  private:
   // Generate output for 'size' input rows starting from 'start' input row.
+  // The output starts at element 'firstRowStart' of the first row and ends
+  // before element 'lastRowEnd' of the last row, so that the elements of a
+  // row may be split across batches.
   //
   // @param start First input row to include in the output.
   // @param size Number of input rows to include in the output.
+  // @param firstRowStart First element of the first row to output.
+  // @param lastRowEnd End of the elements of the last row to output.
   // @param outputSize Pre-computed number of output rows.
   RowVectorPtr generateOutput(
       vector_size_t start,
       vector_size_t size,
+      vector_size_t firstRowStart,
+      vector_size_t lastRowEnd,
       vector_size_t outputSize);
 
+  // Returns the estimated flat size of an output row for 'input_'. A row has
+  // the replicated columns of its input row and one element of each unnested
+  // column.
+  uint64_t estimateOutputRowSize() const;
+
   const bool withOrdinality_;
+
+  // If true, the elements of an input row may be split across output
+  // batches. See QueryConfig::kUnnestSplitOutput.
+  const bool splitOutput_;
   std::vector<column_index_t> unnestChannels_;
 
   SelectivityVector inputRows_;
@@ -62,7 +78,18 @@ class Unnest : public Operator {
   std::vector<const vector_size_t*> rawOffsets_;
   std::vector<const vector_size_t*> rawIndices_;
 
+  // If true, 'maxOutputSize_' is set from the estimated size of the output
+  // rows of each input. See QueryConfig::kOutputBatchSizeByBytes.
+  const bool batchSizeByBytes_;
+
+  // Max number of rows per output batch.
+  uint32_t maxOutputSize_;
+
   // Next 'input_' row to process in getOutput().
   vector_size_t nextInputRow_{0};
+
+  // First element of 'nextInputRow_' to process in getOutput(). Non-zero if
+  // the row was partially output by the previous batch.
+  vector_size_t nextElement_{0};
 };
 } // namespace facebook::velox::exec
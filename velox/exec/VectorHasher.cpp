@@ -62,6 +62,40 @@ uint64_t hashOne(DecodedVector& decoded, vector_size_t index) {
   using T = typename KindToFlatVector<Kind>::HashRowType;
   return folly::hasher<T>()(decoded.valueAt<T>(index));
 }
+
+// Hashes the non-null flat 'values' for rows 'begin' to 'end' a column at a
+// time. If 'mix' is true, the value hashes of a batch of rows are mixed into
+// 'result' with one SIMD hashMix.
+template <typename T, typename HashT>
+void hashFlatValues(
+    const T* values,
+    vector_size_t begin,
+    vector_size_t end,
+    bool mix,
+    uint64_t* result) {
+  folly::hasher<HashT> hasher;
+  if (!mix) {
+    for (auto row = begin; row < end; ++row) {
+      result[row] = hasher(values[row]);
+    }
+    return;
+  }
+
+  using Batch = xsimd::batch<uint64_t>;
+  alignas(Batch::arch_type::alignment()) uint64_t hashes[Batch::size];
+  auto row = begin;
+  for (; row + Batch::size <= end; row += Batch::size) {
+    for (auto i = 0; i < Batch::size; ++i) {
+      hashes[i] = hasher(values[row + i]);
+    }
+    simd::hashMix(
+        Batch::load_unaligned(result + row), Batch::load_aligned(hashes))
+        .store_unaligned(result + row);
+  }
+  for (; row < end; ++row) {
+    result[row] = bits::hashMix(result[row], hasher(values[row]));
+  }
+}
 } // namespace
 
 template <TypeKind Kind>
@@ -70,6 +104,18 @@ void VectorHasher::hashValues(
     bool mix,
     uint64_t* result) {
   using T = typename TypeTraits<Kind>::NativeType;
+  if constexpr (
+      Kind != TypeKind::BOOLEAN && Kind != TypeKind::ROW &&
+      Kind != TypeKind::ARRAY && Kind != TypeKind::MAP &&
+      Kind != TypeKind::OPAQUE) {
+    if (decoded_.isIdentityMapping() && !decoded_.mayHaveNulls() &&
+        rows.isAllSelected()) {
+      hashFlatValues<T, typename KindToFlatVector<Kind>::HashRowType>(
+          decoded_.data<T>(), rows.begin(), rows.end(), mix, result);
+      return;
+    }
+  }
+
   if (decoded_.isConstantMapping()) {
     auto hash = decoded_.isNullAt(rows.begin())
         ? kNullHash
@@ -242,8 +288,7 @@ template <typename T, bool mayHaveNulls>
 bool VectorHasher::makeValueIdsDecoded(
     const SelectivityVector& rows,
     uint64_t* result) {
-  cachedHashes_.resize(decoded_.base()->size());
-  std::fill(cachedHashes_.begin(), cachedHashes_.end(), 0);
+  reuseCachedValueIds(*decoded_.base());
 
   auto indices = decoded_.indices();
   auto values = decoded_.data<T>();
@@ -261,7 +306,7 @@ bool VectorHasher::makeValueIdsDecoded(
     }
 
     auto baseIndex = indices[row];
-    uint64_t& id = cachedHashes_[baseIndex];
+    uint64_t& id = cachedValueIds_[baseIndex];
 
     if (success) {
       if (id == 0) {
@@ -282,12 +327,31 @@ bool VectorHasher::makeValueIdsDecoded(
       }
     }
 
-    return success || numCachedHashes < cachedHashes_.size();
+    return success || numCachedHashes < cachedValueIds_.size();
   });
 
+  if (!success) {
+    clearCachedValueIds();
+  }
   return success;
 }
 
+bool VectorHasher::reuseCachedValueIds(const BaseVector& base) {
+  const bool isStringDictionary = base.isFlatEncoding() &&
+      (base.typeKind() == TypeKind::VARCHAR ||
+       base.typeKind() == TypeKind::VARBINARY) &&
+      base.values() != nullptr;
+  if (isStringDictionary && cachedValueIdsBase_ == base.values() &&
+      cachedValueIds_.size() == base.size()) {
+    return true;
+  }
+
+  cachedValueIdsBase_ = isStringDictionary ? base.values() : nullptr;
+  cachedValueIds_.resize(base.size());
+  std::fill(cachedValueIds_.begin(), cachedValueIds_.end(), 0);
+  return false;
+}
+
 template <>
 bool VectorHasher::makeValueIdsDecoded<bool, true>(
     const SelectivityVector& rows,
@@ -605,13 +669,13 @@ void VectorHasher::copyStringToLocal(const UniqueValue* unique) {
     return;
   }
   if (uniqueValuesStorage_.empty()) {
-    uniqueValuesStorage_.emplace_back();
+    uniqueValuesStorage_.emplace_back(uniqueValuesStorage_.get_allocator());
     uniqueValuesStorage_.back().reserve(std::max(kStringBufferUnitSize, size));
     distinctStringsBytes_ += uniqueValuesStorage_.back().capacity();
   }
   auto str = &uniqueValuesStorage_.back();
   if (str->size() + size > str->capacity()) {
-    uniqueValuesStorage_.emplace_back();
+    uniqueValuesStorage_.emplace_back(uniqueValuesStorage_.get_allocator());
     uniqueValuesStorage_.back().reserve(std::max(kStringBufferUnitSize, size));
     distinctStringsBytes_ += uniqueValuesStorage_.back().capacity();
     str = &uniqueValuesStorage_.back();
@@ -625,6 +689,7 @@ void VectorHasher::copyStringToLocal(const UniqueValue* unique) {
 
 void VectorHasher::setDistinctOverflow() {
   distinctOverflow_ = true;
+  clearCachedValueIds();
   uniqueValues_.clear();
   uniqueValuesStorage_.clear();
   distinctStringsBytes_ = 0;
@@ -779,6 +844,7 @@ uint64_t VectorHasher::enableValueIds(uint64_t multiplier, int32_t reservePct) {
   multiplier_ = multiplier;
   rangeSize_ = addIdReserve(uniqueValues_.size(), reservePct) + 1;
   isRange_ = false;
+  clearCachedValueIds();
   uint64_t result;
   if (__builtin_mul_overflow(multiplier_, rangeSize_, &result)) {
     return kRangeTooLarge;
@@ -794,6 +860,7 @@ uint64_t VectorHasher::enableValueRange(
   VELOX_CHECK(hasRange_);
   extendRange(type_->kind(), reservePct, min_, max_);
   isRange_ = true;
+  clearCachedValueIds();
   // No overflow because max range is under 63 bits.
   if (typeKind_ == TypeKind::BOOLEAN) {
     rangeSize_ = 3;
@@ -815,6 +882,7 @@ void VectorHasher::copyStatsFrom(const VectorHasher& other) {
   min_ = other.min_;
   max_ = other.max_;
   uniqueValues_ = other.uniqueValues_;
+  clearCachedValueIds();
 }
 
 void VectorHasher::merge(const VectorHasher& other) {
@@ -861,14 +929,15 @@ std::string VectorHasher::toString() const {
 
 std::vector<std::unique_ptr<VectorHasher>> createVectorHashers(
     const RowTypePtr& rowType,
-    const std::vector<core::FieldAccessTypedExprPtr>& keys) {
+    const std::vector<core::FieldAccessTypedExprPtr>& keys,
+    memory::MemoryPool* pool) {
   const auto numKeys = keys.size();
 
   std::vector<std::unique_ptr<VectorHasher>> hashers;
   hashers.reserve(numKeys);
   for (const auto& key : keys) {
     const auto channel = exprToChannel(key.get(), rowType);
-    hashers.push_back(VectorHasher::create(key->type(), channel));
+    hashers.push_back(VectorHasher::create(key->type(), channel, pool));
   }
 
   return hashers;
@@ -130,8 +130,22 @@ class VectorHasher {
   // reservePct to enableValueIds().
   static constexpr int32_t kNoLimit = -1;
 
-  VectorHasher(TypePtr type, column_index_t channel)
-      : channel_(channel), type_(std::move(type)), typeKind_(type_->kind()) {
+  /// If 'pool' is set, the distinct values and their string storage are
+  /// allocated from it, otherwise from the global heap.
+  VectorHasher(
+      TypePtr type,
+      column_index_t channel,
+      memory::MemoryPool* pool = nullptr)
+      : channel_(channel),
+        type_(std::move(type)),
+        typeKind_(type_->kind()),
+        uniqueValues_(
+            0,
+            UniqueValueHasher{},
+            UniqueValueComparer{},
+            memory::OptionalStlAllocator<UniqueValue>(pool)),
+        uniqueValuesStorage_(
+            memory::OptionalStlAllocator<StringStorage>(pool)) {
     if (typeKind_ == TypeKind::BOOLEAN) {
       // We do not need samples to know the cardinality or limits of a bool
       // vector.
@@ -143,8 +157,9 @@ class VectorHasher {
 
   static std::unique_ptr<VectorHasher> create(
       TypePtr type,
-      column_index_t channel) {
-    return std::make_unique<VectorHasher>(std::move(type), channel);
+      column_index_t channel,
+      memory::MemoryPool* pool = nullptr) {
+    return std::make_unique<VectorHasher>(std::move(type), channel, pool);
   }
 
   column_index_t channel() const {
@@ -241,6 +256,12 @@ class VectorHasher {
     return hasRange_ || !distinctOverflow_;
   }
 
+  // Returns true if there have been too many distinct values for value ids
+  // mode. The distinct values are then not kept.
+  bool distinctOverflow() const {
+    return distinctOverflow_;
+  }
+
   // Returns an instance of the filter corresponding to a set of unique values.
   // Returns null if distinctOverflow_ is true.
   std::unique_ptr<common::Filter> getFilter(bool nullAllowed) const;
@@ -248,6 +269,7 @@ class VectorHasher {
   void resetStats() {
     uniqueValues_.clear();
     uniqueValuesStorage_.clear();
+    clearCachedValueIds();
   }
 
   // Sets 'this' to range mode and adds 'reservePct' values to the
@@ -318,6 +340,12 @@ class VectorHasher {
  private:
   static constexpr uint32_t kStringASRangeMaxSize = 7;
   static constexpr uint32_t kStringBufferUnitSize = 1024;
+
+  using StringStorage = std::basic_string<
+      char,
+      std::char_traits<char>,
+      memory::OptionalStlAllocator<char>>;
+
   static constexpr uint64_t kMaxDistinctStringsBytes = 1 << 20;
 
   // Maps a binary string of up to 7 bytes to int64_t. Each size maps
@@ -536,6 +564,17 @@ class VectorHasher {
   template <TypeKind Kind>
   void hashValues(const SelectivityVector& rows, bool mix, uint64_t* result);
 
+  // Returns true if 'cachedValueIds_' has the value ids of the values of
+  // 'base' from a previous batch. Otherwise clears 'cachedValueIds_' and
+  // sizes it for 'base'.
+  bool reuseCachedValueIds(const BaseVector& base);
+
+  // Drops the value ids kept for the next batch. Called whenever the mapping
+  // from values to ids changes.
+  void clearCachedValueIds() {
+    cachedValueIdsBase_ = nullptr;
+  }
+
   const column_index_t channel_;
   const TypePtr type_;
   const TypeKind typeKind_;
@@ -543,6 +582,17 @@ class VectorHasher {
   DecodedVector decoded_;
   raw_vector<uint64_t> cachedHashes_;
 
+  // Value ids of the values of the dictionary base vector of the last batch,
+  // indexed by base index. 0 means not looked up yet.
+  raw_vector<uint64_t> cachedValueIds_;
+
+  // The values buffer of the string dictionary whose ids are in
+  // 'cachedValueIds_'. Readers return many batches over the same dictionary,
+  // e.g. one per DWRF stripe or Parquet row group, so the ids are kept for
+  // the next batch instead of looking up each string again. Holding the
+  // buffer keeps it from being reused for other values.
+  BufferPtr cachedValueIdsBase_;
+
   // Single precomputed hash for constant partition keys.
   uint64_t precomputedHash_{0};
 
@@ -569,11 +619,16 @@ class VectorHasher {
   int64_t min_ = 1;
   int64_t max_ = 0;
   // Table for mapping distinct values to small ints.
-  folly::F14FastSet<UniqueValue, UniqueValueHasher, UniqueValueComparer>
+  folly::F14FastSet<
+      UniqueValue,
+      UniqueValueHasher,
+      UniqueValueComparer,
+      memory::OptionalStlAllocator<UniqueValue>>
       uniqueValues_;
 
   // Memory for unique string values.
-  std::vector<std::string> uniqueValuesStorage_;
+  std::vector<StringStorage, memory::OptionalStlAllocator<StringStorage>>
+      uniqueValuesStorage_;
   uint64_t distinctStringsBytes_ = 0;
 };
 
@@ -697,10 +752,12 @@ bool VectorHasher::makeValueIdsDecoded<bool, false>(
     const SelectivityVector& rows,
     uint64_t* result);
 
-/// Creates VectorHasher instances for specified columns.
+/// Creates VectorHasher instances for specified columns. If 'pool' is set, the
+/// hashers allocate their distinct values from it.
 std::vector<std::unique_ptr<VectorHasher>> createVectorHashers(
     const RowTypePtr& rowType,
-    const std::vector<core::FieldAccessTypedExprPtr>& keys);
+    const std::vector<core::FieldAccessTypedExprPtr>& keys,
+    memory::MemoryPool* pool = nullptr);
 
 } // namespace facebook::velox::exec
 
@@ -21,6 +21,89 @@
 
 namespace facebook::velox::exec {
 
+namespace {
+
+// Sets 'sortingKeys' and 'sortingOrders' to the order 'node' produces its
+// output in. Returns false if there is no known order. Filters keep the order
+// of their input.
+bool findOutputOrder(
+    const core::PlanNodePtr& node,
+    const std::vector<core::FieldAccessTypedExprPtr>** sortingKeys,
+    const std::vector<core::SortOrder>** sortingOrders) {
+  if (auto filter = std::dynamic_pointer_cast<const core::FilterNode>(node)) {
+    return findOutputOrder(filter->sources()[0], sortingKeys, sortingOrders);
+  }
+  if (auto orderBy = std::dynamic_pointer_cast<const core::OrderByNode>(node)) {
+    *sortingKeys = &orderBy->sortingKeys();
+    *sortingOrders = &orderBy->sortingOrders();
+    return true;
+  }
+  if (auto topN = std::dynamic_pointer_cast<const core::TopNNode>(node)) {
+    *sortingKeys = &topN->sortingKeys();
+    *sortingOrders = &topN->sortingOrders();
+    return true;
+  }
+  if (auto merge = std::dynamic_pointer_cast<const core::LocalMergeNode>(node)) {
+    *sortingKeys = &merge->sortingKeys();
+    *sortingOrders = &merge->sortingOrders();
+    return true;
+  }
+  if (auto merge =
+          std::dynamic_pointer_cast<const core::MergeExchangeNode>(node)) {
+    *sortingKeys = &merge->sortingKeys();
+    *sortingOrders = &merge->sortingOrders();
+    return true;
+  }
+  return false;
+}
+
+// Returns true if the input of 'windowNode' arrives sorted by its partition
+// keys, in any order and direction, followed by its sorting keys. Such input
+// can be split into partitions as it streams in instead of being fully
+// materialized and sorted.
+bool isInputSorted(const core::WindowNode& windowNode) {
+  if (windowNode.inputsSorted()) {
+    return true;
+  }
+
+  const std::vector<core::FieldAccessTypedExprPtr>* sortingKeys;
+  const std::vector<core::SortOrder>* sortingOrders;
+  if (!findOutputOrder(windowNode.sources()[0], &sortingKeys, &sortingOrders)) {
+    return false;
+  }
+
+  const auto& partitionKeys = windowNode.partitionKeys();
+  const auto numPartitionKeys = partitionKeys.size();
+  const auto numKeys = numPartitionKeys + windowNode.sortingKeys().size();
+  if (numKeys == 0 || sortingKeys->size() < numKeys) {
+    return false;
+  }
+
+  // Partitions only need their rows to be adjacent, so the partition keys may
+  // appear in any order.
+  for (auto i = 0; i < numPartitionKeys; ++i) {
+    const auto& name = (*sortingKeys)[i]->name();
+    if (std::none_of(
+            partitionKeys.begin(), partitionKeys.end(), [&](const auto& key) {
+              return key->name() == name;
+            })) {
+      return false;
+    }
+  }
+
+  for (auto i = numPartitionKeys; i < numKeys; ++i) {
+    const auto windowKey = i - numPartitionKeys;
+    if ((*sortingKeys)[i]->name() !=
+            windowNode.sortingKeys()[windowKey]->name() ||
+        !((*sortingOrders)[i] == windowNode.sortingOrders()[windowKey])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
 Window::Window(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -35,10 +118,11 @@ Window::Window(
       windowNode_(windowNode),
       currentPartition_(nullptr),
       stringAllocator_(pool()) {
-  if (windowNode->inputsSorted()) {
+  if (isInputSorted(*windowNode)) {
     windowBuild_ = std::make_unique<StreamingWindowBuild>(windowNode, pool());
   } else {
-    windowBuild_ = std::make_unique<SortWindowBuild>(windowNode, pool());
+    windowBuild_ = std::make_unique<SortWindowBuild>(
+        windowNode, pool(), driverCtx->queryConfig().prefixSortEnabled());
   }
 }
 
@@ -13,7 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <sys/resource.h>
+
 #include <folly/Benchmark.h>
+#include <folly/String.h>
+#include <folly/futures/Future.h>
 #include <folly/init/Init.h>
 
 #include "velox/core/QueryConfig.h"
@@ -26,7 +30,9 @@
 #include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/parse/TypeResolver.h"
+#include "velox/serializers/CompactRowSerializer.h"
 #include "velox/serializers/PrestoSerializer.h"
+#include "velox/serializers/UnsafeRowSerializer.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
 DEFINE_int32(width, 16, "Number of parties in shuffle");
@@ -41,6 +47,40 @@ DEFINE_int64(
     "task-wide buffer in local exchange");
 DEFINE_int64(exchange_buffer_mb, 32, "task-wide buffer in remote exchange");
 
+DEFINE_int32(
+    latency_ms,
+    0,
+    "Emulated network latency added to each request of a remote exchange "
+    "source");
+DEFINE_int32(
+    bandwidth_mbps,
+    0,
+    "Emulated bandwidth in megabits per second of each remote exchange source. "
+    "0 means unlimited");
+
+DEFINE_bool(
+    sweep,
+    false,
+    "Instead of the fixed benchmarks, runs the remote exchange for each "
+    "combination of the --sweep_* lists and prints throughput and CPU per "
+    "byte");
+DEFINE_string(sweep_widths, "4,16", "Numbers of partitions for --sweep");
+DEFINE_string(sweep_batch_mb, "1", "MB in a 10k row flat batch for --sweep");
+DEFINE_string(
+    sweep_encodings,
+    "flat,dictionary",
+    "Encodings of the input columns for --sweep");
+DEFINE_string(
+    sweep_compressions,
+    "none,lz4,zstd",
+    "Values of exchange.compression_codec for --sweep. Only the Presto serde "
+    "compresses");
+DEFINE_string(
+    sweep_serdes,
+    "presto,compact,unsafe",
+    "Serializers for --sweep: presto, compact (CompactRow) or unsafe "
+    "(UnsafeRow)");
+
 /// Benchmarks repartition/exchange with different batch sizes,
 /// numbers of destinations and data type mixes.  Generates a plan
 /// that 1. shuffles a constant input in each of n workers, sending
@@ -59,12 +99,135 @@ struct Counters {
   int64_t bytes{0};
   int64_t rows{0};
   int64_t usec{0};
+  // User and system CPU of the process.
+  int64_t cpuNanos{0};
 
   std::string toString() {
-    return fmt::format("{} MB/s", (bytes / (1024 * 1024.0)) / (usec / 1.0e6));
+    return fmt::format(
+        "{} MB/s {} CPU ns/byte",
+        (bytes / (1024 * 1024.0)) / (usec / 1.0e6),
+        bytes == 0 ? 0 : cpuNanos / static_cast<double>(bytes));
   }
 };
 
+int64_t processCpuNanos() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  auto tvNanos = [](struct timeval tv) {
+    return tv.tv_sec * 1'000'000'000L + tv.tv_usec * 1'000L;
+  };
+  return tvNanos(usage.ru_utime) + tvNanos(usage.ru_stime);
+}
+
+/// Wraps the ExchangeSource that reads from the local OutputBufferManager and
+/// emulates a network link with --latency_ms and --bandwidth_mbps. Each
+/// request is delayed by the latency plus the time the previous responses
+/// take to transfer at the bandwidth.
+class ThrottledExchangeSource : public exec::ExchangeSource {
+ public:
+  ThrottledExchangeSource(
+      std::shared_ptr<exec::ExchangeSource> source,
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<exec::ExchangeQueue> queue,
+      memory::MemoryPool* pool)
+      : ExchangeSource(taskId, destination, std::move(queue), pool),
+        source_(std::move(source)) {}
+
+  bool supportsFlowControlV2() const override {
+    return source_->supportsFlowControlV2();
+  }
+
+  bool shouldRequestLocked() override {
+    return source_->shouldRequestLocked();
+  }
+
+  bool isRequestPendingLocked() const override {
+    return source_->isRequestPendingLocked();
+  }
+
+  folly::SemiFuture<Response> request(
+      uint32_t maxBytes,
+      uint32_t maxWaitSeconds) override {
+    const auto now = getCurrentTimeMicro();
+    const auto delayMicros = FLAGS_latency_ms * 1'000L +
+        std::max<int64_t>(0, linkFreeMicros_ - static_cast<int64_t>(now));
+    auto source = source_;
+    auto self = std::static_pointer_cast<ThrottledExchangeSource>(
+        shared_from_this());
+    return folly::futures::sleep(std::chrono::microseconds(delayMicros))
+        .deferValue([source, maxBytes, maxWaitSeconds](auto&&) {
+          return source->request(maxBytes, maxWaitSeconds);
+        })
+        .deferValue([self](Response response) {
+          self->addTransfer(response.bytes);
+          return response;
+        });
+  }
+
+  void close() override {
+    source_->close();
+  }
+
+  folly::F14FastMap<std::string, int64_t> stats() const override {
+    return source_->stats();
+  }
+
+ private:
+  // Advances the time at which the link is free by the transfer time of
+  // 'bytes'.
+  void addTransfer(int64_t bytes) {
+    if (FLAGS_bandwidth_mbps == 0) {
+      return;
+    }
+    const int64_t now = getCurrentTimeMicro();
+    // Megabits per second is bits per microsecond.
+    const int64_t transferMicros = bytes * 8 / FLAGS_bandwidth_mbps;
+    linkFreeMicros_ = std::max<int64_t>(linkFreeMicros_, now) + transferMicros;
+  }
+
+  const std::shared_ptr<exec::ExchangeSource> source_;
+  std::atomic<int64_t> linkFreeMicros_{0};
+};
+
+std::shared_ptr<exec::ExchangeSource> createThrottledExchangeSource(
+    const std::string& taskId,
+    int destination,
+    std::shared_ptr<exec::ExchangeQueue> queue,
+    memory::MemoryPool* pool) {
+  std::shared_ptr<exec::ExchangeSource> source =
+      exec::test::createLocalExchangeSource(taskId, destination, queue, pool);
+  if (source == nullptr ||
+      (FLAGS_latency_ms == 0 && FLAGS_bandwidth_mbps == 0)) {
+    return source;
+  }
+  return std::make_shared<ThrottledExchangeSource>(
+      std::move(source), taskId, destination, std::move(queue), pool);
+}
+
+// Makes 'name' the process wide VectorSerde used by PartitionedOutput and
+// Exchange.
+void setVectorSerde(const std::string& name) {
+  if (isRegisteredVectorSerde()) {
+    deregisterVectorSerde();
+  }
+  if (name == "presto") {
+    serializer::presto::PrestoVectorSerde::registerVectorSerde();
+  } else if (name == "compact") {
+    serializer::CompactRowVectorSerde::registerVectorSerde();
+  } else if (name == "unsafe") {
+    serializer::spark::UnsafeRowVectorSerde::registerVectorSerde();
+  } else {
+    VELOX_USER_FAIL("Unknown serde: {}", name);
+  }
+}
+
+std::vector<std::string> splitList(const std::string& list) {
+  std::vector<std::string> values;
+  folly::split(',', list, values, true);
+  return values;
+}
+
 class ExchangeBenchmark : public VectorTestBase {
  public:
   std::vector<RowVectorPtr>
@@ -86,6 +249,7 @@ class ExchangeBenchmark : public VectorTestBase {
     assert(!vectors.empty());
     configSettings_[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
         fmt::format("{}", FLAGS_exchange_buffer_mb << 20);
+    const auto startCpuNanos = processCpuNanos();
     std::vector<std::shared_ptr<Task>> tasks;
     std::vector<std::string> leafTaskIds;
     auto leafPlan = exec::test::PlanBuilder()
@@ -150,13 +314,96 @@ class ExchangeBenchmark : public VectorTestBase {
     counters.bytes += bytes;
     counters.rows += width * vectors.size() * vectors[0]->size();
     counters.usec += elapsed;
+    counters.cpuNanos += processCpuNanos() - startCpuNanos;
+  }
+
+  // Returns 'vectors' with each column wrapped in a dictionary that reverses
+  // the rows.
+  std::vector<RowVectorPtr> makeDictionaries(
+      const std::vector<RowVectorPtr>& vectors) {
+    std::vector<RowVectorPtr> result;
+    for (const auto& vector : vectors) {
+      auto indices = makeIndicesInReverse(vector->size());
+      std::vector<VectorPtr> children;
+      for (const auto& child : vector->children()) {
+        children.push_back(BaseVector::wrapInDictionary(
+            nullptr, indices, vector->size(), child));
+      }
+      result.push_back(
+          makeRowVector(vector->type()->asRow().names(), children));
+    }
+    return result;
+  }
+
+  // Runs the remote exchange for every combination of the --sweep_* flags.
+  void runSweep(const std::vector<TypePtr>& typeSelection) {
+    for (const auto& batchMb : splitList(FLAGS_sweep_batch_mb)) {
+      auto flat = makeRows(
+          makeFlatType(folly::to<int32_t>(batchMb), typeSelection), 10, 10000);
+      for (const auto& encoding : splitList(FLAGS_sweep_encodings)) {
+        VELOX_USER_CHECK(
+            encoding == "flat" || encoding == "dictionary",
+            "Unknown encoding: {}",
+            encoding);
+        auto vectors = encoding == "flat" ? flat : makeDictionaries(flat);
+        for (const auto& serde : splitList(FLAGS_sweep_serdes)) {
+          setVectorSerde(serde);
+          for (const auto& compression : splitList(FLAGS_sweep_compressions)) {
+            if (serde != "presto" && compression != "none") {
+              continue;
+            }
+            configSettings_[core::QueryConfig::kExchangeCompressionKind] =
+                compression;
+            for (const auto& width : splitList(FLAGS_sweep_widths)) {
+              Counters counters;
+              run(vectors,
+                  folly::to<int32_t>(width),
+                  FLAGS_task_width,
+                  counters);
+              std::cout << fmt::format(
+                               "batch_mb={} encoding={} serde={} "
+                               "compression={} width={}: {}",
+                               batchMb,
+                               encoding,
+                               serde,
+                               compression,
+                               width,
+                               counters.toString())
+                        << std::endl;
+            }
+          }
+        }
+      }
+    }
+    configSettings_.erase(core::QueryConfig::kExchangeCompressionKind);
+  }
+
+  // Returns a row type with a BIGINT c0 and enough columns of 'typeSelection'
+  // to make a 10K row batch be 'batchMb' in flat size.
+  static RowTypePtr makeFlatType(
+      int32_t batchMb,
+      const std::vector<TypePtr>& typeSelection) {
+    std::vector<std::string> names = {"c0"};
+    std::vector<TypePtr> types = {BIGINT()};
+    int64_t flatSize = 0;
+    while (flatSize * 10000 < static_cast<int64_t>(batchMb) << 20) {
+      names.push_back(fmt::format("c{}", names.size()));
+      types.push_back(typeSelection[types.size() % typeSelection.size()]);
+      if (types.back()->isFixedWidth()) {
+        flatSize += types.back()->cppSizeInBytes();
+      } else {
+        flatSize += 20;
+      }
+    }
+    return ROW(std::move(names), std::move(types));
   }
 
   void runLocal(
       std::vector<RowVectorPtr>& vectors,
       int32_t taskWidth,
       int32_t numTasks,
-      Counters& counters) {
+      Counters& counters,
+      bool sortByPartition = false) {
     assert(!vectors.empty());
     std::vector<std::shared_ptr<Task>> tasks;
     counters.bytes = vectors[0]->retainedSize() * vectors.size() * numTasks *
@@ -193,6 +440,9 @@ class ExchangeBenchmark : public VectorTestBase {
                   .config(
                       core::QueryConfig::kMaxLocalExchangeBufferSize,
                       fmt::format("{}", FLAGS_local_exchange_buffer_mb << 20))
+                  .config(
+                      core::QueryConfig::kLocalPartitionSortByPartition,
+                      sortByPartition ? "true" : "false")
                   .maxDrivers(taskWidth)
                   .assertResults(expected);
           {
@@ -306,6 +556,7 @@ Counters deep10kCounters;
 Counters flat50Counters;
 Counters deep50Counters;
 Counters localFlat10kCounters;
+Counters localFlat10kSortedCounters;
 
 BENCHMARK(exchangeFlat10k) {
   bm.run(flat10k, FLAGS_width, FLAGS_task_width, flat10kCounters);
@@ -328,6 +579,15 @@ BENCHMARK(localFlat10k) {
       flat10k, FLAGS_width, FLAGS_num_local_tasks, localFlat10kCounters);
 }
 
+BENCHMARK_RELATIVE(localFlat10kSortedByPartition) {
+  bm.runLocal(
+      flat10k,
+      FLAGS_width,
+      FLAGS_num_local_tasks,
+      localFlat10kSortedCounters,
+      true);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -336,9 +596,7 @@ int main(int argc, char** argv) {
   aggregate::prestosql::registerAllAggregateFunctions();
   parse::registerTypeResolver();
   serializer::presto::PrestoVectorSerde::registerVectorSerde();
-  exec::ExchangeSource::registerFactory(exec::test::createLocalExchangeSource);
-  std::vector<std::string> flatNames = {"c0"};
-  std::vector<TypePtr> flatTypes = {BIGINT()};
+  exec::ExchangeSource::registerFactory(createThrottledExchangeSource);
   std::vector<TypePtr> typeSelection = {
       BOOLEAN(),
       TINYINT(),
@@ -350,20 +608,13 @@ int main(int argc, char** argv) {
       DOUBLE(),
       VARCHAR()};
 
-  int64_t flatSize = 0;
-  // Add enough columns of different types to make a 10K row batch be
-  // flat_batch_mb in flat size.
-  while (flatSize * 10000 < static_cast<int64_t>(FLAGS_flat_batch_mb) << 20) {
-    flatNames.push_back(fmt::format("c{}", flatNames.size()));
-    assert(!flatNames.empty());
-    flatTypes.push_back(typeSelection[flatTypes.size() % typeSelection.size()]);
-    if (flatTypes.back()->isFixedWidth()) {
-      flatSize += flatTypes.back()->cppSizeInBytes();
-    } else {
-      flatSize += 20;
-    }
+  if (FLAGS_sweep) {
+    bm.runSweep(typeSelection);
+    return 0;
   }
-  auto flatType = ROW(std::move(flatNames), std::move(flatTypes));
+
+  auto flatType =
+      ExchangeBenchmark::makeFlatType(FLAGS_flat_batch_mb, typeSelection);
 
   auto deepType = ROW(
       {{"c0", BIGINT()},
@@ -384,7 +635,10 @@ int main(int argc, char** argv) {
   std::cout << "flat10k: " << flat10kCounters.toString() << std::endl
             << "flat50: " << flat50Counters.toString() << std::endl
             << "deep10k: " << deep10kCounters.toString() << std::endl
-            << "deep50: " << deep50Counters.toString() << std::endl;
+            << "deep50: " << deep50Counters.toString() << std::endl
+            << "localFlat10k: " << localFlat10kCounters.toString() << std::endl
+            << "localFlat10kSortedByPartition: "
+            << localFlat10kSortedCounters.toString() << std::endl;
   return 0;
   return 0;
 }
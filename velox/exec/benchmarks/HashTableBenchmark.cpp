@@ -19,6 +19,8 @@
 #include "velox/common/memory/MmapAllocator.h"
 #include "velox/exec/HashTable.h"
 #include "velox/exec/VectorHasher.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
@@ -560,6 +562,38 @@ class HashTableBenchmark : public VectorTestBase {
         << std::endl;
   }
 
+  // Makes input for group by on an integer key of 'numKeys' distinct values.
+  void makeGroupByData(int32_t numKeys) {
+    groupByBatches_.clear();
+    for (auto i = 0; i < 100; ++i) {
+      groupByBatches_.push_back(vectorMaker_->rowVector(
+          {vectorMaker_->flatVector<int32_t>(
+               10'000,
+               [&](auto row) { return (i * 10'000 + row * 7) % numKeys; }),
+           vectorMaker_->flatVector<int64_t>(
+               10'000, [](auto row) { return row; }),
+           vectorMaker_->flatVector<double>(
+               10'000, [](auto row) { return row * 0.1; })}));
+    }
+  }
+
+  // Aggregates 'groupByBatches_' with dense accumulators if 'denseKeyRange' is
+  // not 0 and with a hash table otherwise.
+  void runGroupBy(uint64_t denseKeyRange) {
+    auto plan = exec::test::PlanBuilder()
+                    .values(groupByBatches_)
+                    .singleAggregation(
+                        {"c0"}, {"sum(c1)", "count(1)", "min(c2)", "max(c1)"})
+                    .planNode();
+    auto result =
+        exec::test::AssertQueryBuilder(plan)
+            .config(
+                core::QueryConfig::kAggregationDenseKeyRange,
+                std::to_string(denseKeyRange))
+            .copyResults(pool_.get());
+    folly::doNotOptimizeAway(result);
+  }
+
   std::shared_ptr<memory::MemoryPool> pool_{memory::addDefaultLeafMemoryPool()};
   std::unique_ptr<test::VectorMaker> vectorMaker_{
       std::make_unique<test::VectorMaker>(pool_.get())};
@@ -567,6 +601,8 @@ class HashTableBenchmark : public VectorTestBase {
   std::vector<uint64_t> isInTable_;
   // Test payload, keys first.
   std::vector<RowVectorPtr> batches_;
+  // Input for runGroupBy().
+  std::vector<RowVectorPtr> groupByBatches_;
 
   // Corresponds 1:1 to data in 'batches_'. nullptr if the key is not
   // inserted, otherwise pointer into the RowContainer.
@@ -661,6 +697,24 @@ int main(int argc, char** argv) {
       return 1;
     });
   }
+  // Group by on a small key domain with and without dense accumulators.
+  aggregate::prestosql::registerAllAggregateFunctions();
+  for (const auto numKeys : {100, 10'000}) {
+    for (const auto denseKeyRange : {0, 10'000}) {
+      folly::addBenchmark(
+          __FILE__,
+          fmt::format(
+              "GroupBy{}{}", numKeys, denseKeyRange == 0 ? "Hash" : "Dense"),
+          [numKeys, denseKeyRange, &bm]() {
+            {
+              folly::BenchmarkSuspender suspender;
+              bm->makeGroupByData(numKeys);
+            }
+            bm->runGroupBy(denseKeyRange);
+            return 1;
+          });
+    }
+  }
   folly::runBenchmarks();
   std::cout << "*** Results:" << std::endl;
   for (auto& result : results) {
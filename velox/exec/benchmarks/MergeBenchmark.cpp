@@ -19,15 +19,108 @@
 
 #include <gflags/gflags.h>
 
+#include "velox/exec/Spill.h"
 #include "velox/exec/TreeOfLosers.h"
 #include "velox/exec/tests/utils/MergeTestBase.h"
+#include "velox/vector/tests/utils/VectorMaker.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec::test;
 
+namespace {
+// Reads sorted batches like a FileSpillMergeStream reads a spill file.
+class VectorSpillMergeStream : public exec::SpillMergeStream {
+ public:
+  VectorSpillMergeStream(
+      const std::vector<RowVectorPtr>& batches,
+      int32_t numSortingKeys,
+      bool usePrefixes)
+      : batches_(batches), numSortingKeys_(numSortingKeys) {
+    usePrefixes_ = usePrefixes;
+    setNextBatch();
+  }
+
+ private:
+  int32_t numSortingKeys() const override {
+    return numSortingKeys_;
+  }
+
+  const std::vector<CompareFlags>& sortCompareFlags() const override {
+    return compareFlags_;
+  }
+
+  void nextBatch() override {
+    index_ = 0;
+    if (nextBatchIndex_ >= batches_.size()) {
+      size_ = 0;
+      return;
+    }
+    rowVector_ = batches_[nextBatchIndex_++];
+    size_ = rowVector_->size();
+  }
+
+  const std::vector<RowVectorPtr>& batches_;
+  const int32_t numSortingKeys_;
+  const std::vector<CompareFlags> compareFlags_;
+  size_t nextBatchIndex_{0};
+};
+
+// Sorted runs of (BIGINT, INTEGER, VARCHAR) keys. The first key has few
+// distinct values, so that the merge compares the second key often.
+std::vector<std::vector<RowVectorPtr>> makeSpillRuns(
+    memory::MemoryPool* pool,
+    int32_t numRuns,
+    int32_t numBatches) {
+  constexpr vector_size_t kBatchSize = 1'024;
+  test::VectorMaker vectorMaker(pool);
+  folly::Random::DefaultGenerator rng(1);
+  std::vector<std::vector<RowVectorPtr>> runs(numRuns);
+  for (auto& run : runs) {
+    std::vector<std::pair<int64_t, int32_t>> keys(kBatchSize * numBatches);
+    for (auto& key : keys) {
+      key = {folly::Random::rand32(100, rng), folly::Random::rand32(rng)};
+    }
+    std::sort(keys.begin(), keys.end());
+    for (auto batch = 0; batch < numBatches; ++batch) {
+      const auto* batchKeys = keys.data() + batch * kBatchSize;
+      run.push_back(vectorMaker.rowVector({
+          vectorMaker.flatVector<int64_t>(
+              kBatchSize, [&](auto row) { return batchKeys[row].first; }),
+          vectorMaker.flatVector<int32_t>(
+              kBatchSize, [&](auto row) { return batchKeys[row].second; }),
+          vectorMaker.flatVector<StringView>(
+              kBatchSize, [](auto /*row*/) { return StringView("payload"); }),
+      }));
+    }
+  }
+  return runs;
+}
+
+// Merges 'runs' on their first 'numSortingKeys' columns and returns the
+// number of rows.
+int64_t mergeSpillRuns(
+    const std::vector<std::vector<RowVectorPtr>>& runs,
+    int32_t numSortingKeys,
+    bool usePrefixes) {
+  std::vector<std::unique_ptr<exec::SpillMergeStream>> streams;
+  for (const auto& run : runs) {
+    streams.push_back(std::make_unique<VectorSpillMergeStream>(
+        run, numSortingKeys, usePrefixes));
+  }
+  exec::TreeOfLosers<exec::SpillMergeStream> merge(std::move(streams));
+  int64_t numRows = 0;
+  while (auto* stream = merge.next()) {
+    ++numRows;
+    stream->pop();
+  }
+  return numRows;
+}
+} // namespace
+
 TestData narrow;
 TestData medium;
 TestData wide;
+std::vector<std::vector<RowVectorPtr>> spillRuns;
 
 BENCHMARK(narrowTree) {
   MergeTestBase::test<TreeOfLosers<TestingStream>>(narrow, false);
@@ -53,6 +146,31 @@ BENCHMARK_RELATIVE(wideArray) {
   MergeTestBase::test<MergeArray<TestingStream>>(wide, false);
 }
 
+BENCHMARK(spillMergeOneKey) {
+  folly::doNotOptimizeAway(mergeSpillRuns(spillRuns, 1, false));
+}
+
+BENCHMARK_RELATIVE(spillMergeOneKeyPrefix) {
+  folly::doNotOptimizeAway(mergeSpillRuns(spillRuns, 1, true));
+}
+
+BENCHMARK(spillMergeTwoKeys) {
+  folly::doNotOptimizeAway(mergeSpillRuns(spillRuns, 2, false));
+}
+
+BENCHMARK_RELATIVE(spillMergeTwoKeysPrefix) {
+  folly::doNotOptimizeAway(mergeSpillRuns(spillRuns, 2, true));
+}
+
+// The VARCHAR key after the prefix is compared on ties of the prefix.
+BENCHMARK(spillMergeThreeKeys) {
+  folly::doNotOptimizeAway(mergeSpillRuns(spillRuns, 3, false));
+}
+
+BENCHMARK_RELATIVE(spillMergeThreeKeysPrefix) {
+  folly::doNotOptimizeAway(mergeSpillRuns(spillRuns, 3, true));
+}
+
 int main(int argc, char* argv[]) {
   folly::init(&argc, &argv);
   gflags::ParseCommandLineFlags(&argc, &argv, true);
@@ -61,6 +179,9 @@ int main(int argc, char* argv[]) {
   narrow = test.makeTestData(100'000'000, 7);
   medium = test.makeTestData(10'000'0000, 37);
   wide = test.makeTestData(10'000'0000, 1029);
+  auto pool = memory::addDefaultLeafMemoryPool();
+  spillRuns = makeSpillRuns(pool.get(), 64, 100);
   folly::runBenchmarks();
+  spillRuns.clear();
   return 0;
 }
@@ -238,6 +238,53 @@ BENCHMARK(computeValueIdsLowCardinalityNotAllUsed) {
   }
 }
 
+// Hashes and mixes 4 columns of 'T'. Columns without nulls are hashed a
+// column at a time and mixed with SIMD.
+template <typename T>
+void benchmarkHashMultiColumn(bool withNulls) {
+  folly::BenchmarkSuspender suspender;
+  vector_size_t size = 1'000;
+  BenchmarkBase base;
+
+  std::vector<VectorPtr> vectors;
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  for (int i = 0; i < 4; i++) {
+    vectors.push_back(base.vectorMaker().flatVector<T>(
+        size,
+        [i](vector_size_t row) { return row * (i + 1); },
+        withNulls ? test::VectorMaker::nullEvery(7) : nullptr));
+    hashers.push_back(VectorHasher::create(vectors.back()->type(), i));
+  }
+
+  raw_vector<uint64_t> hashes(size);
+  SelectivityVector rows(size);
+  suspender.dismiss();
+
+  for (int i = 0; i < 10'000; i++) {
+    for (int j = 0; j < 4; j++) {
+      hashers[j]->decode(*vectors[j], rows);
+      hashers[j]->hash(rows, j > 0, hashes);
+    }
+    folly::doNotOptimizeAway(hashes);
+  }
+}
+
+BENCHMARK(hashBigintWithNulls) {
+  benchmarkHashMultiColumn<int64_t>(true);
+}
+
+BENCHMARK_RELATIVE(hashBigintNoNulls) {
+  benchmarkHashMultiColumn<int64_t>(false);
+}
+
+BENCHMARK(hashIntegerWithNulls) {
+  benchmarkHashMultiColumn<int32_t>(true);
+}
+
+BENCHMARK_RELATIVE(hashIntegerNoNulls) {
+  benchmarkHashMultiColumn<int32_t>(false);
+}
+
 int main(int argc, char** argv) {
   folly::init(&argc, &argv);
   folly::runBenchmarks();
@@ -1023,6 +1023,122 @@ TEST_F(AggregationTest, partialAggregationMaybeReservationReleaseCheck) {
   EXPECT_GT(kMaxPartialMemoryUsage, task->pool()->currentBytes());
 }
 
+TEST_F(AggregationTest, partialAggregationKeySampling) {
+  // Every batch has 1000 rows. In 'uniqueKeys' all keys are distinct. In
+  // 'skewedKeys' half of the rows have key 0 and the other half cycles through
+  // 4000 keys, so keys repeat but not within a single batch.
+  std::vector<RowVectorPtr> uniqueKeys;
+  std::vector<RowVectorPtr> skewedKeys;
+  for (auto i = 0; i < 20; ++i) {
+    uniqueKeys.push_back(makeRowVector({makeFlatVector<int64_t>(
+        1'000, [i](auto row) { return i * 1'000 + row; })}));
+    skewedKeys.push_back(makeRowVector({makeFlatVector<int64_t>(
+        1'000, [i](auto row) {
+          return row % 2 == 0 ? 0 : 1 + (i * 1'000 + row) % 4'000;
+        })}));
+  }
+
+  struct {
+    std::vector<RowVectorPtr> vectors;
+    bool keySampling;
+    std::string expectedStat;
+    std::string unexpectedStat;
+  } testSettings[] = {
+      {uniqueKeys,
+       true,
+       "partialAggregationPassThrough",
+       "partialAggregationFlushHotKeys"},
+      {skewedKeys,
+       true,
+       "partialAggregationFlushHotKeys",
+       "abandonedPartialAggregation"},
+      {skewedKeys,
+       false,
+       "abandonedPartialAggregation",
+       "partialAggregationKeyCardinality"}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(fmt::format("keySampling: {}", testData.keySampling));
+    createDuckDbTable(testData.vectors);
+    core::PlanNodeId aggNodeId;
+    // Partial aggregation is full after every batch.
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kMaxPartialAggregationMemory, "1")
+            .config(QueryConfig::kMaxExtendedPartialAggregationMemory, "1")
+            .config(QueryConfig::kAbandonPartialAggregationMinRows, "100")
+            .config(
+                QueryConfig::kPartialAggregationKeySamplingEnabled,
+                testData.keySampling ? "true" : "false")
+            .config("max_drivers_per_task", "1")
+            .plan(PlanBuilder()
+                      .values(testData.vectors)
+                      .partialAggregation({"c0"}, {"count(1)"})
+                      .capturePlanNodeId(aggNodeId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults("SELECT c0, count(1) FROM tmp GROUP BY c0");
+    const auto runtimeStats =
+        toPlanStats(task->taskStats()).at(aggNodeId).customStats;
+    EXPECT_LT(0, runtimeStats.count(testData.expectedStat));
+    EXPECT_EQ(0, runtimeStats.count(testData.unexpectedStat));
+  }
+}
+
+TEST_F(AggregationTest, denseKeyRange) {
+  // The key range grows by 20 per batch and has nulls.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000,
+            [i](auto row) { return i * 20 - 100 + row % 40; },
+            nullEvery(17)),
+        makeFlatVector<int64_t>(
+            1'000, [i](auto row) { return i * row; }, nullEvery(7)),
+        makeFlatVector<double>(
+            1'000, [](auto row) { return row * 0.1; }, nullEvery(11)),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const std::vector<std::string> aggregates = {
+      "sum(c1)", "count(c1)", "count(1)", "min(c2)", "max(c1)"};
+  const std::string sql =
+      "SELECT c0, sum(c1), count(c1), count(1), min(c2), max(c1) FROM tmp "
+      "GROUP BY c0";
+  // A range of 100 is outgrown after a few batches, after which the groups
+  // move to the hash table.
+  for (const auto& range : {"0", "100", "1000"}) {
+    SCOPED_TRACE(fmt::format("range: {}", range));
+    AssertQueryBuilder(duckDbQueryRunner_)
+        .config(QueryConfig::kAggregationDenseKeyRange, range)
+        .plan(PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation({"c0"}, aggregates)
+                  .planNode())
+        .assertResults(sql);
+
+    AssertQueryBuilder(duckDbQueryRunner_)
+        .config(QueryConfig::kAggregationDenseKeyRange, range)
+        .plan(PlanBuilder()
+                  .values(vectors)
+                  .partialAggregation({"c0"}, aggregates)
+                  .finalAggregation()
+                  .planNode())
+        .assertResults(sql);
+  }
+
+  // Aggregates without dense accumulators use the hash table.
+  AssertQueryBuilder(duckDbQueryRunner_)
+      .config(QueryConfig::kAggregationDenseKeyRange, "1000")
+      .plan(PlanBuilder()
+                .values(vectors)
+                .singleAggregation({"c0"}, {"sum(c1)", "avg(c2)"})
+                .planNode())
+      .assertResults("SELECT c0, sum(c1), avg(c2) FROM tmp GROUP BY c0");
+}
+
 TEST_F(AggregationTest, spillWithMemoryLimit) {
   constexpr int32_t kNumDistinct = 2000;
   constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
@@ -1398,6 +1514,61 @@ TEST_F(AggregationTest, spillAll) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(AggregationTest, parallelSpillRestore) {
+  constexpr int32_t kNumDrivers = 4;
+  rowType_ = ROW({"c0", "c1", "c2"}, {BIGINT(), BIGINT(), VARCHAR()});
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 10; ++i) {
+    batches.push_back(makeRowVector(
+        {"c0", "c1", "c2"},
+        {
+            makeFlatVector<int64_t>(
+                1'000, [&](auto row) { return (row * 17 + i) % 3'000; }),
+            makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+            makeFlatVector<std::string>(
+                1'000, [](auto row) { return fmt::format("{}", row % 7); }),
+        }));
+  }
+  createDuckDbTable(batches);
+
+  core::PlanNodeId aggregationNodeId;
+  auto plan = PlanBuilder()
+                  .values(batches)
+                  .localPartition({"c0"})
+                  .singleAggregation({"c0"}, {"sum(c1)", "max(c2)"})
+                  .capturePlanNodeId(aggregationNodeId)
+                  .planNode();
+
+  for (const auto spillAll : {false, true}) {
+    SCOPED_TRACE(fmt::format("spillAll: {}", spillAll));
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .maxDrivers(kNumDrivers)
+            .spillDirectory(tempDirectory->path)
+            .config(QueryConfig::kSpillEnabled, "true")
+            .config(QueryConfig::kAggregationSpillEnabled, "true")
+            .config(QueryConfig::kAggregationSpillPartitionBits, "2")
+            .config(QueryConfig::kAggregationSpillMemoryThreshold, "1024")
+            .config(
+                QueryConfig::kAggregationSpillAll, spillAll ? "true" : "false")
+            .config(
+                QueryConfig::kAggregationSpillParallelRestoreEnabled, "true")
+            .assertResults("SELECT c0, sum(c1), max(c2) FROM tmp GROUP BY 1");
+
+    auto planStats = toPlanStats(task->taskStats());
+    const auto& aggregationStats = planStats.at(aggregationNodeId);
+    ASSERT_LT(0, aggregationStats.spilledBytes);
+    ASSERT_LT(0, aggregationStats.spilledPartitions);
+    // The last driver to finish input hands out the spilled partitions.
+    const auto& restoreStats =
+        aggregationStats.customStats.at("parallelSpillRestoreDrivers");
+    ASSERT_EQ(restoreStats.count, 1);
+    ASSERT_EQ(restoreStats.sum, kNumDrivers);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+}
+
 // Verify number of memory allocations in the HashAggregation operator.
 TEST_F(AggregationTest, memoryAllocations) {
   vector_size_t size = 1'024;
@@ -1911,6 +2082,49 @@ TEST_F(AggregationTest, distinctWithSpilling) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(AggregationTest, spillWithSortedAndDistinctAggregations) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(100, [](auto row) { return row % 17; }),
+        makeFlatVector<int32_t>(
+            100, [](auto row) { return row % 13; }, nullEvery(11)),
+        makeFlatVector<StringView>(
+            100,
+            [](auto row) {
+              return StringView::makeInline(fmt::format("{}", row % 7));
+            }),
+        makeFlatVector<int64_t>(100, [i](auto row) { return i * 100 + row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  core::PlanNodeId aggrNodeId;
+  auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                  .spillDirectory(spillDirectory->path)
+                  .config(QueryConfig::kSpillEnabled, "true")
+                  .config(QueryConfig::kAggregationSpillEnabled, "true")
+                  .config(QueryConfig::kTestingSpillPct, "100")
+                  .plan(PlanBuilder()
+                            .values(vectors)
+                            .singleAggregation(
+                                {"c0"},
+                                {"count(distinct c1)",
+                                 "array_agg(c1 ORDER BY c3)",
+                                 "sum(c1)",
+                                 "count(distinct c2)",
+                                 "array_agg(c2 ORDER BY c3 DESC)"})
+                            .capturePlanNodeId(aggrNodeId)
+                            .planNode())
+                  .assertResults(
+                      "SELECT c0, count(distinct c1), "
+                      "array_agg(c1 ORDER BY c3), sum(c1), count(distinct c2), "
+                      "array_agg(c2 ORDER BY c3 DESC) FROM tmp GROUP BY c0");
+  ASSERT_GT(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+}
+
 TEST_F(AggregationTest, preGroupedAggregationWithSpilling) {
   std::vector<RowVectorPtr> vectors;
   int64_t val = 0;
@@ -226,3 +226,35 @@ TEST_F(ArrowStreamTest, error) {
       AssertQueryBuilder(plan).copyResults(pool_.get()),
       "Failed to call get_schema on ArrowStream: get_schema failed.");
 }
+
+TEST_F(ArrowStreamTest, multipleStreams) {
+  std::vector<std::vector<RowVectorPtr>> streamVectors(5);
+  std::vector<RowVectorPtr> allVectors;
+  for (int32_t i = 0; i < streamVectors.size(); ++i) {
+    for (int32_t j = 0; j < 4; ++j) {
+      auto vector = makeRowVector({makeFlatVector<int64_t>(
+          100, [&](auto row) { return (i * 4 + j) * 100 + row; })});
+      streamVectors[i].push_back(vector);
+      allVectors.push_back(vector);
+    }
+  }
+  createDuckDbTable(allVectors);
+  auto type = asRowType(allVectors[0]->type());
+
+  // Without prefetch, with a queue of one batch and with a large queue.
+  for (const auto* prefetchBytes : {"0", "1", "1000000"}) {
+    SCOPED_TRACE(prefetchBytes);
+    std::vector<std::shared_ptr<ArrowArrayStream>> streams;
+    for (const auto& vectors : streamVectors) {
+      auto stream = std::make_shared<ArrowArrayStream>();
+      exportArrowStream(
+          std::make_shared<ArrowReader>(pool_, vectors, type), stream.get());
+      streams.push_back(std::move(stream));
+    }
+    auto plan = std::make_shared<core::ArrowStreamNode>("0", type, streams);
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .maxDrivers(3)
+        .config(core::QueryConfig::kArrowStreamMaxPrefetchBytes, prefetchBytes)
+        .assertResults("SELECT * FROM tmp");
+  }
+}
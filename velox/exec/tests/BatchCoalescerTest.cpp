@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/BatchCoalescer.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+class BatchCoalescerTest : public testing::Test, public test::VectorTestBase {
+ protected:
+  RowVectorPtr makeBatch(vector_size_t start, vector_size_t size) {
+    return makeRowVector({makeFlatVector<int64_t>(
+        size, [start](auto row) { return start + row; })});
+  }
+};
+
+TEST_F(BatchCoalescerTest, basic) {
+  BatchCoalescer coalescer(pool(), 0);
+
+  // A large batch is returned as is.
+  auto large = makeBatch(0, 100);
+  EXPECT_EQ(coalescer.add(large, 50), large);
+  EXPECT_FALSE(coalescer.hasPending());
+
+  // A single small batch is returned as is on flush.
+  auto small = makeBatch(0, 10);
+  EXPECT_EQ(coalescer.add(small, 50), nullptr);
+  EXPECT_TRUE(coalescer.hasPending());
+  EXPECT_EQ(coalescer.flushIfExpired(), nullptr);
+  EXPECT_EQ(coalescer.flush(), small);
+  EXPECT_FALSE(coalescer.hasPending());
+  EXPECT_EQ(coalescer.flush(), nullptr);
+
+  // Small batches are copied together until there are enough rows.
+  std::vector<RowVectorPtr> batches;
+  RowVectorPtr result;
+  for (auto i = 0; result == nullptr; ++i) {
+    batches.push_back(makeBatch(i * 10, 10));
+    result = coalescer.add(batches.back(), 50);
+  }
+  EXPECT_FALSE(coalescer.hasPending());
+  assertEqualVectors(makeBatch(0, 50), result);
+
+  // A large batch after a small one is added to the pending rows.
+  EXPECT_EQ(coalescer.add(makeBatch(0, 10), 50), nullptr);
+  result = coalescer.add(makeBatch(10, 100), 50);
+  assertEqualVectors(makeBatch(0, 110), result);
+  EXPECT_FALSE(coalescer.hasPending());
+}
+
+TEST_F(BatchCoalescerTest, maxDelay) {
+  BatchCoalescer coalescer(pool(), 10);
+  EXPECT_EQ(coalescer.add(makeBatch(0, 10), 50), nullptr);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  auto result = coalescer.flushIfExpired();
+  ASSERT_NE(result, nullptr);
+  assertEqualVectors(makeBatch(0, 10), result);
+  EXPECT_FALSE(coalescer.hasPending());
+
+  // An expired batch is returned from add().
+  EXPECT_EQ(coalescer.add(makeBatch(0, 10), 50), nullptr);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  result = coalescer.add(makeBatch(10, 10), 50);
+  ASSERT_NE(result, nullptr);
+  assertEqualVectors(makeBatch(0, 20), result);
+  EXPECT_FALSE(coalescer.hasPending());
+}
+
+} // namespace
+} // namespace facebook::velox::exec
@@ -20,6 +20,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/Values.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/Cursor.h"
@@ -574,6 +575,30 @@ TEST_F(DriverTest, pause) {
   EXPECT_EQ(operators[1].outputPositions, 10 * hits);
 }
 
+TEST_F(DriverTest, hardwareCounters) {
+  auto data = makeRowVector({makeFlatVector<int64_t>(10'000, folly::identity)});
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values({data}, false, 10)
+                  .project({"c0 * 3 + 1 as c1"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+  auto task = AssertQueryBuilder(plan)
+                  .config(
+                      core::QueryConfig::kOperatorTrackHardwareCounters, "true")
+                  .assertTypeAndNumRows(ROW({"c1"}, {BIGINT()}), 100'000);
+  const auto& stats = toPlanStats(task->taskStats()).at(projectId);
+  process::PerfCounters probe;
+  if (!process::readThreadPerfCounters(probe)) {
+    // perf_event is not usable in this environment.
+    EXPECT_EQ(stats.perfCounters.cycles, 0);
+    return;
+  }
+  EXPECT_GT(stats.perfCounters.cycles, 0);
+  EXPECT_GT(stats.perfCounters.instructions, 0);
+  EXPECT_NE(stats.toString().find("IPC: "), std::string::npos);
+}
+
 TEST_F(DriverTest, yield) {
   constexpr int32_t kNumTasks = 20;
   constexpr int32_t kThreadsPerTask = 5;
@@ -605,6 +630,37 @@ TEST_F(DriverTest, yield) {
   }
 }
 
+TEST_F(DriverTest, timeSliceYield) {
+  constexpr int32_t kNumRows = 10'000;
+  constexpr int32_t kNumRepeats = 200;
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; })});
+  auto plan =
+      PlanBuilder()
+          .values({data}, false, kNumRepeats)
+          .project({"c0 % 3 + c0 % 5 + c0 % 7 + c0 % 11 + c0 % 13 AS p0"})
+          .singleAggregation({}, {"sum(p0)"})
+          .planNode();
+
+  int64_t sum = 0;
+  for (auto row = 0; row < kNumRows; ++row) {
+    sum += row % 3 + row % 5 + row % 7 + row % 11 + row % 13;
+  }
+  auto expected = makeRowVector({makeFlatVector<int64_t>(
+      std::vector<int64_t>{sum * kNumRepeats})});
+
+  auto task = AssertQueryBuilder(plan)
+                  .config(core::QueryConfig::kDriverCpuTimeSliceLimitMs, "1")
+                  .assertResults(expected);
+  EXPECT_GT(task->numTimeSliceYields(), 0);
+  EXPECT_GT(task->driverCpuTimeNanos(), 0);
+
+  // The CPU time is only recorded with a time slice limit.
+  task = AssertQueryBuilder(plan).assertResults(expected);
+  EXPECT_EQ(task->numTimeSliceYields(), 0);
+  EXPECT_EQ(task->driverCpuTimeNanos(), 0);
+}
+
 // A testing Operator that periodically does one of the following:
 //
 // 1. Blocks and registers a resume that continues the Driver after a timed
@@ -1027,6 +1083,155 @@ TEST_F(DriverTest, nonVeloxOperatorException) {
       "Operator::getOutput failed for [operator: Throw, plan node ID: 1]");
 }
 
+namespace {
+
+// Custom node for the custom factory.
+class ReserveNode : public core::PlanNode {
+ public:
+  ReserveNode(
+      const core::PlanNodeId& id,
+      uint64_t reservationBytes,
+      core::PlanNodePtr input)
+      : PlanNode(id), reservationBytes_{reservationBytes}, sources_{input} {}
+
+  const RowTypePtr& outputType() const override {
+    return sources_[0]->outputType();
+  }
+
+  uint64_t reservationBytes() const {
+    return reservationBytes_;
+  }
+
+  const std::vector<std::shared_ptr<const PlanNode>>& sources() const override {
+    return sources_;
+  }
+
+  std::string_view name() const override {
+    return "Reserve";
+  }
+
+ private:
+  void addDetails(std::stringstream& /* stream */) const override {}
+
+  const uint64_t reservationBytes_;
+  std::vector<core::PlanNodePtr> sources_;
+};
+
+// Custom operator that reserves memory asynchronously on its first input.
+class ReserveOperator : public Operator {
+ public:
+  ReserveOperator(
+      DriverCtx* ctx,
+      int32_t id,
+      const std::shared_ptr<const ReserveNode>& node)
+      : Operator(ctx, node->outputType(), id, node->id(), "Reserve"),
+        reservationBytes_{node->reservationBytes()} {}
+
+  bool needsInput() const override {
+    return !noMoreInput_ && !input_;
+  }
+
+  void addInput(RowVectorPtr input) override {
+    if (!reserved_) {
+      reserved_ = true;
+      reservedInline_ = reserveMemoryAsync(reservationBytes_);
+    }
+    input_ = std::move(input);
+  }
+
+  RowVectorPtr getOutput() override {
+    return std::move(input_);
+  }
+
+  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
+    return BlockingReason::kNotBlocked;
+  }
+
+  bool isFinished() override {
+    return noMoreInput_ && input_ == nullptr;
+  }
+
+  static std::atomic_bool reservedInline_;
+
+ private:
+  const uint64_t reservationBytes_;
+  bool reserved_{false};
+};
+
+std::atomic_bool ReserveOperator::reservedInline_{false};
+
+class ReserveNodeFactory : public Operator::PlanNodeTranslator {
+ public:
+  std::unique_ptr<Operator> toOperator(
+      DriverCtx* ctx,
+      int32_t id,
+      const core::PlanNodePtr& node) override {
+    if (auto reserveNode = std::dynamic_pointer_cast<const ReserveNode>(node)) {
+      return std::make_unique<ReserveOperator>(ctx, id, reserveNode);
+    }
+    return nullptr;
+  }
+};
+
+} // namespace
+
+DEBUG_ONLY_TEST_F(DriverTest, asyncMemoryReservation) {
+  Operator::registerOperator(std::make_unique<ReserveNodeFactory>());
+
+  constexpr int64_t kQueryCapacity = 32 << 20;
+  auto rows = makeRowVector({makeFlatVector<int32_t>({1, 2, 3})});
+  auto makePlan = [&](uint64_t reservationBytes) {
+    return PlanBuilder()
+        .values({rows}, true)
+        .addNode([reservationBytes](std::string id, core::PlanNodePtr input) {
+          return std::make_shared<ReserveNode>(id, reservationBytes, input);
+        })
+        .planNode();
+  };
+
+  std::atomic_bool reservedOffThread{false};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Operator::reserveMemoryAsync",
+      std::function<void(Operator*)>([&](Operator* /*unused*/) {
+        reservedOffThread = driverThreadContext() == nullptr;
+        // Delays the reservation to let the driver see it in flight.
+        std::this_thread::sleep_for(std::chrono::milliseconds(100)); // NOLINT
+      }));
+
+  struct {
+    uint64_t reservationBytes;
+    bool expectInline;
+
+    std::string debugString() const {
+      return fmt::format(
+          "reservationBytes {}, expectInline {}",
+          reservationBytes,
+          expectInline);
+    }
+  } testSettings[] = {{1 << 20, true}, {kQueryCapacity * 2, false}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    reservedOffThread = false;
+    auto queryCtx = std::make_shared<core::QueryCtx>(driverExecutor_.get());
+    queryCtx->testingOverrideMemoryPool(
+        memory::defaultMemoryManager().addRootPool(
+            queryCtx->queryId(), kQueryCapacity));
+
+    // The reservation exceeding the query capacity fails after going through
+    // the memory arbitration but doesn't fail the query.
+    auto task = AssertQueryBuilder(makePlan(testData.reservationBytes))
+                    .queryCtx(queryCtx)
+                    .assertResults({rows});
+    ASSERT_EQ(ReserveOperator::reservedInline_, testData.expectInline);
+    ASSERT_EQ(reservedOffThread, !testData.expectInline);
+    const auto& opStats = task->taskStats().pipelineStats[0].operatorStats[1];
+    ASSERT_EQ(
+        opStats.runtimeStats.count("blockedWaitForMemoryTimes"),
+        testData.expectInline ? 0 : 1);
+  }
+}
+
 DEBUG_ONLY_TEST_F(DriverTest, driverSuspensionRaceWithTaskPause) {
   struct {
     int numDrivers;
@@ -197,5 +197,52 @@ TEST_F(ExchangeClientTest, flowControl) {
   }
 }
 
+TEST_F(ExchangeClientTest, batchedDequeue) {
+  auto data = makeRowVector({makeFlatVector<int32_t>({1, 2, 3})});
+  const auto pageSize = toSerializedPage(data)->size();
+
+  ExchangeQueue queue;
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(queue.mutex());
+    queue.addSourceLocked();
+    for (auto i = 0; i < 5; ++i) {
+      queue.enqueueLocked(toSerializedPage(data), promises);
+    }
+  }
+  queue.noMoreSources();
+  ASSERT_EQ(queue.totalBytes(), 5 * pageSize);
+
+  std::lock_guard<std::mutex> l(queue.mutex());
+  bool atEnd;
+  ContinueFuture future;
+  // Returns one page even if it is larger than 'maxBytes'.
+  auto pages = queue.dequeueLocked(1, &atEnd, &future);
+  ASSERT_EQ(pages.size(), 1);
+  ASSERT_FALSE(atEnd);
+
+  pages = queue.dequeueLocked(pageSize * 3.5, &atEnd, &future);
+  ASSERT_EQ(pages.size(), 3);
+  ASSERT_EQ(queue.totalBytes(), pageSize);
+
+  pages = queue.dequeueLocked(pageSize * 10, &atEnd, &future);
+  ASSERT_EQ(pages.size(), 1);
+  ASSERT_EQ(queue.totalBytes(), 0);
+
+  // Waits for more pages until the source completes.
+  pages = queue.dequeueLocked(pageSize * 10, &atEnd, &future);
+  ASSERT_TRUE(pages.empty());
+  ASSERT_FALSE(atEnd);
+  ASSERT_TRUE(future.valid());
+
+  queue.enqueueLocked(nullptr, promises);
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  pages = queue.dequeueLocked(pageSize * 10, &atEnd, &future);
+  ASSERT_TRUE(pages.empty());
+  ASSERT_TRUE(atEnd);
+}
+
 } // namespace
 } // namespace facebook::velox::exec
@@ -13,12 +13,15 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
+#include "velox/exec/FusedKernel.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/parse/Expressions.h"
+#include "velox/parse/ExpressionsParser.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
@@ -410,6 +413,106 @@ TEST_F(FilterProjectTest, nestedFieldReferenceSharedChild) {
   AssertQueryBuilder(plan).assertResults(makeRowVector({expected}));
 }
 
+TEST_F(FilterProjectTest, fusedKernel) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return row + i; }),
+        makeFlatVector<double>(1'000, [&](auto row) { return row * 0.1; }),
+    }));
+  }
+  // A batch with nulls is evaluated by the interpreter.
+  vectors.push_back(makeRowVector({
+      makeFlatVector<int64_t>(
+          1'000, [](auto row) { return row; }, nullEvery(7)),
+      makeFlatVector<double>(1'000, [](auto row) { return row; }),
+  }));
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .filter("c0 > 10 AND c1 < 80.0")
+                  .project({"c0 * 3 - c0 AS a", "c1 * 2.5 + c1 AS b", "c0"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .config(core::QueryConfig::kExprFusedKernelEnabled, "true")
+                  .assertResults(
+                      "SELECT c0 * 3 - c0, c1 * 2.5 + c1, c0 FROM tmp "
+                      "WHERE c0 > 10 AND c1 < 80.0");
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(
+      planStats.at(projectId).customStats.at("fusedKernelBatches").sum, 5);
+
+  // Integer overflow falls back to the interpreter, which reports the error.
+  auto overflow = makeRowVector({makeFlatVector<int64_t>(
+      {1, std::numeric_limits<int64_t>::max()})});
+  plan = PlanBuilder().values({overflow}).project({"c0 + 1"}).planNode();
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kExprFusedKernelEnabled, "true")
+          .copyResults(pool()),
+      "integer overflow");
+
+  // Compiled kernels are cached by expression.
+  auto rowType = asRowType(vectors[0]->type());
+  FusedKernel::testingClearCache();
+  auto parse = [&](const std::string& sql) {
+    return core::Expressions::inferTypes(
+        parse::parseExpr(sql, {}), rowType, pool());
+  };
+  auto kernel = FusedKernel::getOrCompile({parse("c0 + c0 * 2")}, rowType);
+  ASSERT_NE(kernel, nullptr);
+  // Field c0, constant 2, multiply, plus.
+  ASSERT_EQ(kernel->numInstructions(), 4);
+  ASSERT_EQ(
+      FusedKernel::getOrCompile({parse("c0 + c0 * 2")}, rowType), kernel);
+  ASSERT_EQ(FusedKernel::getOrCompile({parse("c0 % 2")}, rowType), nullptr);
+  ASSERT_EQ(FusedKernel::testingCacheSize(), 2);
+}
+
+TEST_F(FilterProjectTest, coalesceOutput) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 20; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return i * 1'000 + row; }),
+        makeFlatVector<std::string>(
+            1'000, [](auto row) { return std::string(row % 30, 'x'); }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId filterId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .filter("c0 % 100 = 7")
+                  .capturePlanNodeId(filterId)
+                  .planNode();
+  auto numOutputVectors = [&](const std::string& batchBytes) {
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kOutputBatchSizeByBytes, "true")
+            .config(core::QueryConfig::kPreferredOutputBatchBytes, batchBytes)
+            .config(core::QueryConfig::kOutputBatchCoalesceMaxDelayMs, "0")
+            .assertResults("SELECT * FROM tmp WHERE c0 % 100 = 7");
+    return toPlanStats(task->taskStats()).at(filterId).outputVectors;
+  };
+
+  // The 10 rows that pass the filter in each input are returned together.
+  ASSERT_EQ(numOutputVectors("10000000"), 1);
+
+  // Batches of about 1KB, i.e. about 30 rows of about 33 bytes.
+  const auto numVectors = numOutputVectors("1000");
+  ASSERT_GT(numVectors, 1);
+  ASSERT_LT(numVectors, 20);
+
+  // Without coalescing, each input gives one output.
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .assertResults("SELECT * FROM tmp WHERE c0 % 100 = 7");
+  ASSERT_EQ(toPlanStats(task->taskStats()).at(filterId).outputVectors, 20);
+}
+
 TEST_F(FilterProjectTest, numSilentThrow) {
   auto row = makeRowVector(
       {makeFlatVector<int32_t>(100, [&](auto row) { return row; })});
@@ -21,6 +21,7 @@
 #include "velox/exec/tests/utils/Cursor.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/type/Type.h"
 
 namespace facebook::velox::exec::test {
@@ -172,6 +173,67 @@ TEST_F(GroupedExecutionTest, groupedExecutionErrors) {
           localPartitionNodeId));
 }
 
+// Checks that a task restarted with the checkpoint of an earlier run does not
+// read the splits of the checkpointed split groups and sends their pages.
+TEST_F(GroupedExecutionTest, checkpoint) {
+  auto vectors = makeVectors(4, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  auto checkpointDir = exec::test::TempDirectoryPath::create();
+
+  auto runTask = [&](const std::string& taskId,
+                     const std::vector<int32_t>& splitGroups) {
+    core::PlanNodeId tableScanNodeId;
+    auto planFragment = PlanBuilder()
+                            .tableScan(rowType_)
+                            .capturePlanNodeId(tableScanNodeId)
+                            .partitionedOutput({}, 1)
+                            .planFragment();
+    planFragment.executionStrategy = core::ExecutionStrategy::kGrouped;
+    planFragment.groupedExecutionLeafNodeIds.emplace(tableScanNodeId);
+    planFragment.numSplitGroups = 10;
+    auto queryCtx = std::make_shared<core::QueryCtx>(
+        executor_.get(),
+        std::unordered_map<std::string, std::string>{
+            {core::QueryConfig::kTaskCheckpointPath, checkpointDir->path}});
+    auto task = exec::Task::create(
+        taskId, std::move(planFragment), 0, std::move(queryCtx));
+    task->start(task, 1, 1);
+    for (auto splitGroupId : splitGroups) {
+      task->addSplit("0", makeHiveSplitWithGroup(filePath->path, splitGroupId));
+      task->noMoreSplitsForGroup("0", splitGroupId);
+    }
+    waitForFinishedDrivers(task, splitGroups.size());
+    task->noMoreSplits("0");
+    auto outputBufferManager = exec::OutputBufferManager::getInstance().lock();
+    outputBufferManager->deleteResults(task->taskId(), 0);
+    EXPECT_EQ(exec::TaskState::kFinished, task->state());
+    return task->taskStats();
+  };
+
+  auto taskStats = runTask("first", {1, 5});
+  EXPECT_EQ(2, taskStats.pipelineStats[0].operatorStats[0].numSplits);
+  EXPECT_EQ(
+      0,
+      taskStats.pipelineStats[0].operatorStats[1].runtimeStats.count(
+          "checkpointReplayedPages"));
+  auto fs = filesystems::getFileSystem(checkpointDir->path, nullptr);
+  EXPECT_TRUE(fs->exists(checkpointDir->path + "/1.pages"));
+  EXPECT_TRUE(fs->exists(checkpointDir->path + "/5.pages"));
+
+  // Only the split of group 3 is read. Groups 1 and 5 send their pages.
+  taskStats = runTask("second", {1, 5, 3});
+  EXPECT_EQ(1, taskStats.pipelineStats[0].operatorStats[0].numSplits);
+  const auto& replayedPages =
+      taskStats.pipelineStats[0].operatorStats[1].runtimeStats.at(
+          "checkpointReplayedPages");
+  EXPECT_EQ(2, replayedPages.count);
+  EXPECT_GE(replayedPages.sum, 2);
+  EXPECT_EQ(
+      std::unordered_set<int32_t>({1, 3, 5}), taskStats.completedSplitGroups);
+  EXPECT_TRUE(fs->exists(checkpointDir->path + "/3.pages"));
+}
+
 // Here we test various aspects of grouped/bucketed execution involving
 // output buffer and 3 pipelines.
 TEST_F(GroupedExecutionTest, groupedExecutionWithOutputBuffer) {
@@ -281,6 +343,73 @@ TEST_F(GroupedExecutionTest, groupedExecutionWithOutputBuffer) {
   EXPECT_EQ(18, taskStats.pipelineStats[1].operatorStats[1].inputVectors);
 }
 
+// Checks that the number of concurrent split groups is limited by the grouped
+// execution memory budget.
+TEST_F(GroupedExecutionTest, groupedExecutionMemoryBudget) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+
+  struct {
+    uint64_t budget;
+    // Running drivers after the first split group completes.
+    int32_t numRunningDrivers;
+  } testSettings[] = {{1, 9}, {1ULL << 40, 18}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(fmt::format("budget: {}", testData.budget));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId tableScanNodeId;
+    auto planFragment =
+        PlanBuilder(planNodeIdGenerator)
+            .tableScan(rowType_)
+            .capturePlanNodeId(tableScanNodeId)
+            .project({"c3 as x", "c2 as y", "c1 as z", "c0 as w", "c4", "c5"})
+            .localPartitionRoundRobinRow()
+            .project({"w as c0", "z as c1", "y as c2", "x as c3", "c4", "c5"})
+            .localPartitionRoundRobinRow()
+            .partitionedOutput({}, 1, {"c0", "c1", "c2", "c3", "c4", "c5"})
+            .planFragment();
+    planFragment.executionStrategy = core::ExecutionStrategy::kGrouped;
+    planFragment.groupedExecutionLeafNodeIds.emplace(tableScanNodeId);
+    planFragment.numSplitGroups = 10;
+    auto queryCtx = std::make_shared<core::QueryCtx>(
+        executor_.get(),
+        std::unordered_map<std::string, std::string>{
+            {core::QueryConfig::kGroupedExecutionMemoryBudget,
+             std::to_string(testData.budget)}});
+    auto task = exec::Task::create(
+        fmt::format("budget-{}", testData.budget),
+        std::move(planFragment),
+        0,
+        std::move(queryCtx));
+    // 3 drivers max and up to 3 concurrent split groups.
+    task->start(task, 3, 3);
+
+    task->addSplit("0", makeHiveSplitWithGroup(filePath->path, 8));
+    task->addSplit("0", makeHiveSplitWithGroup(filePath->path, 1));
+    task->addSplit("0", makeHiveSplitWithGroup(filePath->path, 5));
+
+    // No split group has completed yet, so only one runs.
+    EXPECT_EQ(9, task->numRunningDrivers());
+
+    task->noMoreSplitsForGroup("0", 8);
+    waitForFinishedDrivers(task, 9);
+    EXPECT_EQ(testData.numRunningDrivers, task->numRunningDrivers());
+    EXPECT_EQ(std::unordered_set<int32_t>({8}), getCompletedSplitGroups(task));
+
+    task->noMoreSplitsForGroup("0", 1);
+    task->noMoreSplitsForGroup("0", 5);
+    waitForFinishedDrivers(task, 27);
+    EXPECT_EQ(0, task->numRunningDrivers());
+
+    task->noMoreSplits("0");
+    auto outputBufferManager = exec::OutputBufferManager::getInstance().lock();
+    outputBufferManager->deleteResults(task->taskId(), 0);
+    EXPECT_EQ(exec::TaskState::kFinished, task->state());
+  }
+}
+
 // Here we test various aspects of grouped/bucketed execution involving
 // output buffer and 3 pipelines.
 TEST_F(GroupedExecutionTest, groupedExecutionWithHashAndNestedLoopJoin) {
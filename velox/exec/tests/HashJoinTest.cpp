@@ -925,6 +925,131 @@ TEST_P(MultiThreadedHashJoinTest, emptyBuild) {
   }
 }
 
+TEST_P(MultiThreadedHashJoinTest, hashTableCache) {
+  struct {
+    core::JoinType joinType;
+    std::vector<std::string> outputLayout;
+    std::string referenceQuery;
+  } testSettings[] = {
+      {core::JoinType::kInner,
+       {"t_k0", "t_data", "u_k0", "u_data"},
+       "SELECT t_k0, t_data, u_k0, u_data FROM t, u WHERE t_k0 = u_k0"},
+      {core::JoinType::kLeft,
+       {"t_k0", "t_data", "u_k0", "u_data"},
+       "SELECT t_k0, t_data, u_k0, u_data FROM t LEFT JOIN u ON t_k0 = u_k0"},
+      {core::JoinType::kLeftSemiFilter,
+       {"t_k0", "t_data"},
+       "SELECT t_k0, t_data FROM t WHERE t_k0 IN (SELECT u_k0 FROM u)"},
+      {core::JoinType::kAnti,
+       {"t_k0", "t_data"},
+       "SELECT t_k0, t_data FROM t WHERE NOT EXISTS "
+       "(SELECT * FROM u WHERE u_k0 = t_k0)"}};
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(core::joinTypeName(testData.joinType));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .numDrivers(numDrivers_)
+        .keyTypes({BIGINT()})
+        .probeVectors(1600, 5)
+        .buildVectors(1500, 5)
+        .joinType(testData.joinType)
+        .joinOutputLayout(testData.outputLayout)
+        .config(core::QueryConfig::kHashTableCacheKey, "hashTableCache")
+        .referenceQuery(testData.referenceQuery)
+        // The shared hash table is not spilled.
+        .checkSpillStats(false)
+        .run();
+  }
+}
+
+TEST_P(MultiThreadedHashJoinTest, lazyBuildColumns) {
+  struct {
+    core::JoinType joinType;
+    std::string referenceQuery;
+  } testSettings[] = {
+      {core::JoinType::kInner,
+       "SELECT t_k0, t_data, u_k0, u_data FROM t, u WHERE t_k0 = u_k0"},
+      {core::JoinType::kLeft,
+       "SELECT t_k0, t_data, u_k0, u_data FROM t LEFT JOIN u ON t_k0 = u_k0"},
+      {core::JoinType::kFull,
+       "SELECT t_k0, t_data, u_k0, u_data FROM t FULL OUTER JOIN u "
+       "ON t_k0 = u_k0"}};
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(core::joinTypeName(testData.joinType));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .numDrivers(numDrivers_)
+        .keyTypes({BIGINT()})
+        .probeVectors(1600, 5)
+        .buildVectors(1500, 5)
+        .joinType(testData.joinType)
+        .joinOutputLayout({"t_k0", "t_data", "u_k0", "u_data"})
+        .config(core::QueryConfig::kHashProbeLazyBuildColumns, "true")
+        .referenceQuery(testData.referenceQuery)
+        .run();
+  }
+}
+
+TEST_P(MultiThreadedHashJoinTest, simpleFilter) {
+  std::vector<RowVectorPtr> probeVectors = makeBatches(5, [&](int32_t batch) {
+    return makeRowVector(
+        {"t0", "t1", "t2"},
+        {
+            makeFlatVector<int32_t>(
+                250, [batch](auto row) { return row % (11 + batch); }),
+            makeFlatVector<int64_t>(
+                250, [batch](auto row) { return row * batch; }, nullEvery(7)),
+            makeFlatVector<int32_t>(250, [](auto row) { return row % 13; }),
+        });
+  });
+
+  std::vector<RowVectorPtr> buildVectors = makeBatches(5, [&](int32_t batch) {
+    return makeRowVector(
+        {"u0", "u1", "u2"},
+        {
+            makeFlatVector<int32_t>(
+                123, [batch](auto row) { return row % (5 + batch); }),
+            makeFlatVector<int64_t>(
+                123, [batch](auto row) { return row * batch; }, nullEvery(5)),
+            makeFlatVector<int32_t>(123, [](auto row) { return row % 7; }),
+        });
+  });
+
+  // The first two filters are evaluated on the table rows, the last one by
+  // the expression evaluator.
+  const std::vector<std::string> filters = {
+      "t1 > u1", "t1 <= u1 AND u2 <> 3 AND t2 >= u2", "t1 < u1 + 10"};
+  for (const auto& filter : filters) {
+    SCOPED_TRACE(filter);
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .numDrivers(numDrivers_)
+        .probeKeys({"t0"})
+        .probeVectors(std::vector<RowVectorPtr>(probeVectors))
+        .buildKeys({"u0"})
+        .buildVectors(std::vector<RowVectorPtr>(buildVectors))
+        .joinType(core::JoinType::kLeft)
+        .joinFilter(filter)
+        .joinOutputLayout({"t0", "t1", "u1"})
+        .config(core::QueryConfig::kHashProbeSimpleFilterEnabled, "true")
+        .referenceQuery(fmt::format(
+            "SELECT t0, t1, u1 FROM t LEFT JOIN u ON t0 = u0 AND {}", filter))
+        .run();
+
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .numDrivers(numDrivers_)
+        .probeKeys({"t0"})
+        .probeVectors(std::vector<RowVectorPtr>(probeVectors))
+        .buildKeys({"u0"})
+        .buildVectors(std::vector<RowVectorPtr>(buildVectors))
+        .joinType(core::JoinType::kLeftSemiFilter)
+        .joinFilter(filter)
+        .joinOutputLayout({"t0", "t1"})
+        .config(core::QueryConfig::kHashProbeSimpleFilterEnabled, "true")
+        .referenceQuery(fmt::format(
+            "SELECT t.* FROM t WHERE EXISTS "
+            "(SELECT * FROM u WHERE t0 = u0 AND {})", filter))
+        .run();
+  }
+}
+
 TEST_P(MultiThreadedHashJoinTest, emptyProbe) {
   HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
       .numDrivers(numDrivers_)
@@ -2203,8 +2328,7 @@ TEST_P(MultiThreadedHashJoinTest, antiJoin) {
         .joinFilter(filter)
         .joinOutputLayout({"t0", "t1"})
         .referenceQuery(fmt::format(
-            "SELECT t.* FROM t WHERE NOT EXISTS (SELECT * FROM u WHERE u.u0 = t.t0 AND {})",
-            filter))
+            "SELECT t.* FROM t WHERE NOT EXISTS (SELECT * FROM u WHERE u.u0 = t.t0 AND {})", filter))
         .run();
   }
 }
@@ -4848,6 +4972,158 @@ DEBUG_ONLY_TEST_F(HashJoinTest, buildReservationReleaseCheck) {
   ASSERT_TRUE(waitForTaskAborted(task, 5'000'000));
 }
 
+TEST_F(HashJoinTest, bloomFilterDynamicFilter) {
+  // More distinct build keys than VectorHasher::kMaxDistinct over a range that
+  // is too large for value ids, so that there is no IN-list dynamic filter.
+  const int32_t numBuildRows = VectorHasher::kMaxDistinct + 10'000;
+  const int64_t kSpacing = 1'000'003;
+  const int32_t numSplits = 5;
+  const int32_t numRowsProbe = 1'000;
+
+  std::vector<RowVectorPtr> buildVectors{makeRowVector(
+      {"u_c0"},
+      {makeFlatVector<int64_t>(
+          numBuildRows, [&](auto row) { return row * kSpacing; })})};
+
+  // Every other probe row has a match.
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    auto rowVector = makeRowVector({makeFlatVector<int64_t>(
+        numRowsProbe, [&](auto row) {
+          const int64_t key = (i * numRowsProbe + row) * kSpacing;
+          return row % 2 == 0 ? key : key + 1;
+        })});
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->path, rowVector);
+  }
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId probeScanId;
+  auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                .tableScan(asRowType(probeVectors[0]->type()))
+                .capturePlanNodeId(probeScanId)
+                .hashJoin(
+                    {"c0"},
+                    {"u_c0"},
+                    PlanBuilder(planNodeIdGenerator, pool_.get())
+                        .values(buildVectors)
+                        .planNode(),
+                    "",
+                    {"c0"},
+                    core::JoinType::kInner)
+                .planNode();
+
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .planNode(std::move(op))
+      .makeInputSplits([&] {
+        std::vector<exec::Split> probeSplits;
+        for (auto& file : tempFiles) {
+          probeSplits.push_back(
+              exec::Split(makeHiveConnectorSplit(file->path)));
+        }
+        SplitInput splits;
+        splits.emplace(probeScanId, probeSplits);
+        return splits;
+      })
+      .config(core::QueryConfig::kHashBuildBloomFilterMaxSize, "1048576")
+      .referenceQuery("SELECT t.c0 FROM t, u WHERE t.c0 = u.u_c0")
+      .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+        SCOPED_TRACE(fmt::format("hasSpill:{}", hasSpill));
+        if (hasSpill) {
+          ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+          ASSERT_EQ(0, getFiltersAccepted(task, 0).sum);
+        } else {
+          ASSERT_EQ(1, getFiltersProduced(task, 1).sum);
+          ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+          // The Bloom filter is approximate, so the join is not replaced.
+          ASSERT_EQ(0, getReplacedWithFilterRows(task, 1).sum);
+          ASSERT_LT(getInputPositions(task, 1), numRowsProbe * numSplits);
+        }
+      })
+      .run();
+}
+
+TEST_F(HashJoinTest, earlyJoinFilter) {
+  // 't0' has a match in 'u' for 9 in 10 rows and 't1' in 'v' for 1 in 10
+  // rows, so that the second join is the more selective one.
+  const vector_size_t batchSize = 2'000;
+  auto probeVectors = makeBatches(10, [&](int32_t batch) {
+    return makeRowVector(
+        {"t0", "t1", "t2"},
+        {
+            makeFlatVector<int32_t>(
+                batchSize, [](auto row) { return row % 1'000; }),
+            makeFlatVector<int64_t>(
+                batchSize,
+                [&](auto row) { return batch * batchSize + row; },
+                nullEvery(11)),
+            makeFlatVector<int64_t>(batchSize, [](auto row) { return row; }),
+        });
+  });
+  std::vector<RowVectorPtr> uVectors{makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int32_t>(900, [](auto row) { return row; }),
+       makeFlatVector<int64_t>(900, [](auto row) { return row * 3; })})};
+  std::vector<RowVectorPtr> vVectors{makeRowVector(
+      {"v0"},
+      {makeFlatVector<int64_t>(
+          batchSize, [](auto row) { return row * 10; })})};
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", uVectors);
+  createDuckDbTable("v", vVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probeVectors)
+                  .hashJoin(
+                      {"t0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(uVectors)
+                          .planNode(),
+                      "",
+                      {"t0", "t1", "t2", "u1"})
+                  .hashJoin(
+                      {"t1"},
+                      {"v0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(vVectors)
+                          .planNode(),
+                      "",
+                      {"t0", "t2", "u1", "v0"})
+                  .planNode();
+
+  for (const bool enabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("enabled: {}", enabled));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(plan)
+        .config(
+            core::QueryConfig::kHashProbeEarlyJoinFilterEnabled,
+            enabled ? "true" : "false")
+        .injectSpill(false)
+        .referenceQuery(
+            "SELECT t0, t2, u1, v0 FROM t, u, v WHERE t0 = u0 AND t1 = v0")
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*hasSpill*/) {
+          const auto filteredRows =
+              getOperatorRuntimeStats(task, 1, "earlyJoinFilteredRows").sum;
+          if (enabled) {
+            // The first join filters its input by 'v' once both joins have
+            // seen enough rows.
+            ASSERT_GT(filteredRows, 0);
+            ASSERT_LT(
+                getInputPositions(task, 2), probeVectors.size() * batchSize);
+          } else {
+            ASSERT_EQ(filteredRows, 0);
+          }
+        })
+        .run();
+  }
+}
+
 TEST_F(HashJoinTest, dynamicFilterOnPartitionKey) {
   vector_size_t size = 10;
   auto filePaths = makeFilePaths(1);
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/HashTableCache.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class HashTableCacheTest : public velox::test::VectorTestBase,
+                           public testing::Test {
+ protected:
+  std::unique_ptr<BaseHashTable> makeTable(memory::MemoryPool* pool) {
+    std::vector<std::unique_ptr<VectorHasher>> keyHashers;
+    keyHashers.emplace_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+    return HashTable<true>::createForJoin(
+        std::move(keyHashers), {}, true, false, 1'000, pool);
+  }
+
+  std::shared_ptr<const core::HashJoinNode> makeJoinNode(
+      core::JoinType joinType,
+      bool nullAware = false) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto probe = makeRowVector({"t0"}, {makeFlatVector<int64_t>({1, 2})});
+    auto build = makeRowVector({"u0"}, {makeFlatVector<int64_t>({1, 2})});
+    const bool leftOutput = !core::isRightSemiFilterJoin(joinType) &&
+        !core::isRightSemiProjectJoin(joinType);
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values({probe})
+                    .hashJoin(
+                        {"t0"},
+                        {"u0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values({build})
+                            .planNode(),
+                        "",
+                        {leftOutput ? "t0" : "u0"},
+                        joinType,
+                        nullAware)
+                    .planNode();
+    return std::dynamic_pointer_cast<const core::HashJoinNode>(plan);
+  }
+
+  HashTableCache cache_;
+};
+
+TEST_F(HashTableCacheTest, makeKey) {
+  const core::QueryConfig noCache({});
+  const core::QueryConfig withCache(
+      {{core::QueryConfig::kHashTableCacheKey, "snapshot1"}});
+
+  auto innerJoin = makeJoinNode(core::JoinType::kInner);
+  ASSERT_FALSE(HashTableCache::makeKey(*innerJoin, noCache).has_value());
+  const auto key = HashTableCache::makeKey(*innerJoin, withCache);
+  ASSERT_TRUE(key.has_value());
+  ASSERT_EQ(key.value().find("snapshot1"), 0);
+
+  ASSERT_TRUE(HashTableCache::makeKey(
+                  *makeJoinNode(core::JoinType::kLeftSemiFilter), withCache)
+                  .has_value());
+  ASSERT_TRUE(
+      HashTableCache::makeKey(*makeJoinNode(core::JoinType::kAnti), withCache)
+          .has_value());
+
+  // Joins that modify the table while probing or finish the build early do not
+  // share tables.
+  ASSERT_FALSE(
+      HashTableCache::makeKey(*makeJoinNode(core::JoinType::kRight), withCache)
+          .has_value());
+  ASSERT_FALSE(
+      HashTableCache::makeKey(*makeJoinNode(core::JoinType::kFull), withCache)
+          .has_value());
+  ASSERT_FALSE(HashTableCache::makeKey(
+                   *makeJoinNode(core::JoinType::kRightSemiFilter), withCache)
+                   .has_value());
+  ASSERT_FALSE(HashTableCache::makeKey(
+                   *makeJoinNode(core::JoinType::kAnti, true), withCache)
+                   .has_value());
+}
+
+TEST_F(HashTableCacheTest, lookupAndPut) {
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  auto build = cache_.lookup("k", "task1", &future);
+  ASSERT_FALSE(future.valid());
+  ASSERT_EQ(build.table, nullptr);
+  ASSERT_NE(build.pool, nullptr);
+  ASSERT_EQ(cache_.numEntries(), 1);
+
+  // Another driver of the builder task adds to the same table.
+  auto sameTask = cache_.lookup("k", "task1", &future);
+  ASSERT_FALSE(future.valid());
+  ASSERT_EQ(sameTask.pool, build.pool);
+
+  // Other tasks wait for the table.
+  auto waiting = cache_.lookup("k", "task2", &future);
+  ASSERT_TRUE(future.valid());
+  ASSERT_EQ(waiting.table, nullptr);
+  ASSERT_EQ(waiting.pool, nullptr);
+  ASSERT_FALSE(future.isReady());
+
+  auto table = cache_.put(
+      "k", "task1", makeTable(build.pool.get()), std::move(build.pool), true);
+  sameTask.pool.reset();
+  ASSERT_NE(table, nullptr);
+  ASSERT_TRUE(future.isReady());
+
+  future = ContinueFuture::makeEmpty();
+  auto hit = cache_.lookup("k", "task2", &future);
+  ASSERT_FALSE(future.valid());
+  ASSERT_EQ(hit.table, table);
+  ASSERT_TRUE(hit.hasNullKeys);
+  ASSERT_EQ(hit.pool, nullptr);
+
+  // The entry is removed when the last user of the table releases it.
+  table.reset();
+  ASSERT_EQ(cache_.numEntries(), 1);
+  hit.table.reset();
+  ASSERT_EQ(cache_.numEntries(), 0);
+
+  build = cache_.lookup("k", "task3", &future);
+  ASSERT_FALSE(future.valid());
+  ASSERT_NE(build.pool, nullptr);
+  cache_.abandon("k", "task3");
+  ASSERT_EQ(cache_.numEntries(), 0);
+}
+
+TEST_F(HashTableCacheTest, abandon) {
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  auto build = cache_.lookup("k", "task1", &future);
+  ASSERT_NE(build.pool, nullptr);
+  cache_.lookup("k", "task2", &future);
+  ASSERT_TRUE(future.valid());
+
+  // Only the builder can abandon the table.
+  cache_.abandon("k", "task2");
+  ASSERT_FALSE(future.isReady());
+  cache_.abandon("k", "task1");
+  ASSERT_TRUE(future.isReady());
+  ASSERT_EQ(cache_.numEntries(), 0);
+
+  // A waiting task becomes the builder and the table of the earlier builder is
+  // not cached.
+  future = ContinueFuture::makeEmpty();
+  auto rebuild = cache_.lookup("k", "task2", &future);
+  ASSERT_FALSE(future.valid());
+  ASSERT_NE(rebuild.pool, nullptr);
+  ASSERT_NE(rebuild.pool, build.pool);
+  auto table = cache_.put(
+      "k", "task1", makeTable(build.pool.get()), std::move(build.pool), false);
+  ASSERT_NE(table, nullptr);
+
+  auto waiting = cache_.lookup("k", "task3", &future);
+  ASSERT_TRUE(future.valid());
+  ASSERT_EQ(waiting.table, nullptr);
+  cache_.abandon("k", "task2");
+  ASSERT_TRUE(future.isReady());
+}
@@ -549,6 +549,15 @@ TEST_P(HashTableTest, int2SparseNormalizedMostMiss) {
   testCycle(BaseHashTable::HashMode::kNormalizedKey, 100000, 2, type, 2);
 }
 
+// Keys with too large ranges for normalized keys, compared and stored by
+// the code specialized for up to 4 BIGINT keys.
+TEST_P(HashTableTest, int4SparseHash) {
+  auto type =
+      ROW({"k1", "k2", "k3", "k4"}, {BIGINT(), BIGINT(), BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 2, type, 4);
+}
+
 TEST_P(HashTableTest, structKey) {
   auto type =
       ROW({"key"}, {ROW({"k1", "k2", "k3"}, {BIGINT(), VARCHAR(), BIGINT()})});
@@ -564,6 +573,15 @@ TEST_P(HashTableTest, mixed6Sparse) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
 }
 
+// Builds from a number of tables that is not a power of two so that the
+// parallel build uses more radix partitions than tables. The table is large
+// enough for the join probe to cluster the probe rows by partition.
+TEST_P(HashTableTest, radixPartitionedJoinBuild) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), VARCHAR()});
+  keySpacing_ = 1000;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 3, type, 2);
+}
+
 // It should be safe to call clear() before we insert any data into HashTable
 TEST_P(HashTableTest, clear) {
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
@@ -742,6 +760,45 @@ TEST_P(HashTableTest, regularHashingTableSize) {
   }
 }
 
+TEST_P(HashTableTest, memberBits) {
+  // A semi join build with no dependents and no duplicates only records which
+  // keys are present.
+  auto keys = vectorMaker_->flatVector<int64_t>(
+      1'000, [](auto row) { return row * 3; });
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+  auto table = HashTable<true>::createForJoin(
+      std::move(hashers), {}, false, false, 1'000, pool_.get());
+  copyVectorsToTable({vectorMaker_->rowVector({keys})}, 0, table.get());
+  table->prepareJoinTable({}, executor_.get());
+  ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kArray);
+  ASSERT_TRUE(table->hasMemberBits());
+
+  auto probeKeys = vectorMaker_->flatVector<int64_t>(3'000, folly::identity);
+  SelectivityVector rows(probeKeys->size());
+  auto lookup = std::make_unique<HashLookup>(table->hashers());
+  lookup->reset(probeKeys->size());
+  VectorHasher::ScratchMemory scratchMemory;
+  table->hashers()[0]->lookupValueIds(
+      *probeKeys, rows, scratchMemory, lookup->hashes);
+  lookup->rows.clear();
+  rows.applyToSelected([&](auto row) { lookup->rows.push_back(row); });
+  table->joinProbe(*lookup);
+  for (auto row : lookup->rows) {
+    ASSERT_EQ(lookup->hits[row] != nullptr, row % 3 == 0) << row;
+  }
+
+  // A join build with dependents keeps the table of rows.
+  hashers.clear();
+  hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+  table = HashTable<true>::createForJoin(
+      std::move(hashers), {BIGINT()}, false, false, 1'000, pool_.get());
+  copyVectorsToTable({vectorMaker_->rowVector({keys, keys})}, 0, table.get());
+  table->prepareJoinTable({}, executor_.get());
+  ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kArray);
+  ASSERT_FALSE(table->hasMemberBits());
+}
+
 TEST_P(HashTableTest, groupBySpill) {
   auto type = ROW({"k1"}, {BIGINT()});
   testGroupBySpill(5'000'000, type, 1, 1000, 1000);
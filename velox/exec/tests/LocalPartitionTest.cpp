@@ -192,6 +192,51 @@ TEST_F(LocalPartitionTest, partition) {
   verifyExchangeSourceOperatorStats(task, 300, 6);
 }
 
+TEST_F(LocalPartitionTest, sortByPartition) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(1'000, [i](auto row) { return i * 7 + row; }),
+        makeFlatVector<std::string>(
+            1'000,
+            [](auto row) { return std::string(row % 23, 'x'); },
+            nullEvery(11)),
+        makeArrayVector<int64_t>(
+            1'000,
+            [](auto row) { return row % 4; },
+            [](auto row, auto index) { return row + index; },
+            nullEvery(13)),
+    }));
+  }
+
+  createDuckDbTable(vectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto valuesNode = [&](int start, int end) {
+    return PlanBuilder(planNodeIdGenerator)
+        .values(std::vector<RowVectorPtr>(
+            vectors.begin() + start, vectors.begin() + end))
+        .planNode();
+  };
+
+  auto op = PlanBuilder(planNodeIdGenerator)
+                .localPartition({"c0"}, {valuesNode(0, 5), valuesNode(5, 10)})
+                .project({"c0", "c1", "c2"})
+                .planNode();
+
+  // Also use a small buffer to make the producers block on consumers.
+  for (const auto* bufferSize : {"33554432", "1000"}) {
+    SCOPED_TRACE(bufferSize);
+    auto task =
+        AssertQueryBuilder(op, duckDbQueryRunner_)
+            .maxDrivers(4)
+            .config(core::QueryConfig::kLocalPartitionSortByPartition, "true")
+            .config(core::QueryConfig::kMaxLocalExchangeBufferSize, bufferSize)
+            .assertResults("SELECT * FROM tmp");
+    verifyExchangeSourceOperatorStats(task, 10'000, 40);
+  }
+}
+
 TEST_F(LocalPartitionTest, maxBufferSizeGather) {
   std::vector<RowVectorPtr> vectors;
   for (auto i = 0; i < 21; i++) {
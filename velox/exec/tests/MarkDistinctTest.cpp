@@ -14,9 +14,11 @@
  * limitations under the License.
  */
 
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::test;
@@ -141,3 +143,43 @@ TEST_F(MarkDistinctTest, aggregation) {
       .assertResults(
           "SELECT c0, sum(distinct c1), sum(distinct c2) FROM tmp GROUP BY 1");
 }
+
+TEST_F(MarkDistinctTest, spill) {
+  filesystems::registerLocalFileSystem();
+  auto spillDirectory = TempDirectoryPath::create();
+
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000, [i](auto row) { return (row * 7 + i * 300) % 2'000; }),
+        makeFlatVector<int64_t>(1'000, [i](auto row) { return i * row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId markDistinctId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .markDistinct("c0_distinct", {"c0"})
+                  .capturePlanNodeId(markDistinctId)
+                  .singleAggregation(
+                      {}, {"count(c0)", "sum(c1)"}, {"c0_distinct", ""})
+                  .planNode();
+
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kTestingSpillPct, "100")
+          .config(core::QueryConfig::kSpillEnabled, "true")
+          .config(core::QueryConfig::kMarkDistinctSpillEnabled, "true")
+          .spillDirectory(spillDirectory->path)
+          .assertResults("SELECT count(distinct c0), sum(c1) FROM tmp");
+
+  auto taskStats = toPlanStats(task->taskStats());
+  const auto& stats = taskStats.at(markDistinctId);
+
+  ASSERT_GT(stats.spilledBytes, 0);
+  ASSERT_GT(stats.spilledRows, 0);
+  ASSERT_GT(stats.spilledFiles, 0);
+  ASSERT_GT(stats.spilledPartitions, 0);
+}
@@ -201,6 +201,34 @@ TEST_F(MergeJoinTest, duplicateMatch) {
       [](auto row) { return row / 2; }, [](auto row) { return row / 3; });
 }
 
+TEST_F(MergeJoinTest, skewedKeys) {
+  // Long runs of repeated keys make cross products that span many output
+  // batches. Long runs of keys without a match on the other side are skipped.
+  testJoin<int32_t>(
+      [](auto row) { return row / 100 * 3; },
+      [](auto row) { return row / 50 * 2; });
+
+  testJoin<int32_t>(
+      [](auto row) { return row < 1'000 ? row : 5'000 + row / 200; },
+      [](auto row) { return 5'000 + row / 300; });
+
+  // Null keys at the end of the last batch.
+  auto keyAt = [](auto row) { return row / 400; };
+  auto isNullAt = [](auto row) { return row >= 1'500; };
+  std::vector<VectorPtr> leftKeys = {
+      makeFlatVector<int32_t>(1'000, keyAt),
+      makeFlatVector<int32_t>(
+          2'000,
+          [&](auto row) { return keyAt(1'000 + row); },
+          [&](auto row) { return isNullAt(1'000 + row); })};
+  std::vector<VectorPtr> rightKeys = {
+      makeFlatVector<int32_t>(2'000, keyAt, isNullAt)};
+
+  testJoin(leftKeys, rightKeys);
+
+  testJoin(rightKeys, leftKeys);
+}
+
 TEST_F(MergeJoinTest, allRowsMatch) {
   std::vector<VectorPtr> leftKeys = {
       makeFlatVector<int32_t>(2, [](auto /* row */) { return 5; }),
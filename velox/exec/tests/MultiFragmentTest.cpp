@@ -531,6 +531,39 @@ TEST_F(MultiFragmentTest, partitionedOutput) {
   }
 }
 
+TEST_F(MultiFragmentTest, partitionedOutputSortByPartition) {
+  setupSources(10, 1000);
+  configSettings_[core::QueryConfig::kPartitionedOutputSortByPartition] =
+      "true";
+
+  constexpr int32_t kFanout = 16;
+  auto leafTaskId = makeTaskId("leaf", 0);
+  auto leafPlan = PlanBuilder()
+                      .values(vectors_)
+                      .partitionedOutput({"c0"}, kFanout, {"c5", "c0", "c3"})
+                      .planNode();
+  auto leafTask = makeTask(leafTaskId, leafPlan, 0);
+  Task::start(leafTask, 4);
+
+  auto intermediatePlan = PlanBuilder()
+                              .exchange(leafPlan->outputType())
+                              .partitionedOutput({}, 1, {"c3", "c0", "c5"})
+                              .planNode();
+  std::vector<std::string> intermediateTaskIds;
+  for (auto i = 0; i < kFanout; ++i) {
+    intermediateTaskIds.push_back(makeTaskId("intermediate", i));
+    auto intermediateTask =
+        makeTask(intermediateTaskIds.back(), intermediatePlan, i);
+    Task::start(intermediateTask, 1);
+    addRemoteSplits(intermediateTask, {leafTaskId});
+  }
+
+  auto op = PlanBuilder().exchange(intermediatePlan->outputType()).planNode();
+  assertQuery(op, intermediateTaskIds, "SELECT c3, c0, c5 FROM tmp");
+
+  ASSERT_TRUE(waitForTaskCompletion(leafTask.get())) << leafTask->taskId();
+}
+
 TEST_F(MultiFragmentTest, partitionedOutputWithLargeInput) {
   // Verify that partitionedOutput operator is able to split a single input
   // vector if it hits memory or row limits.
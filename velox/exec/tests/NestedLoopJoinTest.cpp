@@ -421,3 +421,44 @@ TEST_F(NestedLoopJoinTest, allTypes) {
       "SELECT t0, u0 FROM t {0} JOIN u ON t.t0 {1} u0 AND t1 {1} u1 AND t2 {1} u2 AND t3 {1} u3 AND t4 {1} u4 AND t5 {1} u5 AND t6 {1} u6");
   runSingleAndMultiDriverTest(probeVectors, buildVectors);
 }
+
+TEST_F(NestedLoopJoinTest, bandJoin) {
+  // Each build row covers the range [u0, u1]. Probe rows fall in several
+  // ranges and some build rows have null bounds.
+  auto probeVectors = {
+      makeRowVector(
+          {"t0"},
+          {makeFlatVector<int64_t>(
+              300, [](auto row) { return row * 7 % 2'000; }, nullEvery(17))}),
+      makeRowVector(
+          {"t0"},
+          {makeFlatVector<int64_t>(
+              200, [](auto row) { return row * 11 % 2'000; })}),
+  };
+  auto buildVectors = {
+      makeRowVector(
+          {"u0", "u1"},
+          {makeFlatVector<int64_t>(
+               500, [](auto row) { return row * 13 % 2'000; }, nullEvery(11)),
+           makeFlatVector<int64_t>(
+               500, [](auto row) { return row * 13 % 2'000 + row % 50; })}),
+      makeRowVector(
+          {"u0", "u1"},
+          {makeFlatVector<int64_t>(
+               400, [](auto row) { return row * 3 % 2'000; }),
+           makeFlatVector<int64_t>(
+               400,
+               [](auto row) { return row * 3 % 2'000 + 40; },
+               nullEvery(13))}),
+  };
+
+  setComparisons(
+      {"t0 BETWEEN u0 AND u1",
+       "u0 <= t0 AND t0 < u1",
+       "t0 > u0 AND u1 > t0 + 20",
+       "u1 >= t0"});
+  setJoinConditionStr("{}");
+  setOutputLayout({"t0", "u0", "u1"});
+  setQueryStr("SELECT t0, u0, u1 FROM t {0} JOIN u ON {1}");
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+}
@@ -565,6 +565,65 @@ TEST_F(OrderByTest, spillWithMemoryLimit) {
   }
 }
 
+DEBUG_ONLY_TEST_F(OrderByTest, forecastReservation) {
+  constexpr int64_t kMaxBytes = 64LL << 20; // 64MB
+  auto rowType = ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), INTEGER()});
+  VectorFuzzer fuzzer({}, pool());
+  const int32_t numBatches = 5;
+  std::vector<RowVectorPtr> batches;
+  for (int32_t i = 0; i < numBatches; ++i) {
+    batches.push_back(fuzzer.fuzzRow(rowType));
+  }
+  createDuckDbTable(batches);
+
+  struct {
+    uint64_t estimatedRows;
+    bool expectSpill;
+
+    std::string debugString() const {
+      return fmt::format(
+          "estimatedRows:{}, expectSpill:{}", estimatedRows, expectSpill);
+    }
+  } testSettings[] = {// The forecast fits in the query memory capacity.
+                      {10'000, false},
+                      // The forecast exceeds the query memory capacity.
+                      {1'000'000'000, true}};
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    SCOPED_TESTVALUE_SET(
+        "facebook::velox::exec::Driver::runInternal::addInput",
+        std::function<void(Operator*)>(([&](Operator* op) {
+          if (op->operatorType() != "OrderBy") {
+            return;
+          }
+          op->testingOperatorCtx()->task()->setInputRowsEstimate(
+              op->planNodeId(), testData.estimatedRows);
+        })));
+
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    auto queryCtx = std::make_shared<core::QueryCtx>(executor_.get());
+    queryCtx->testingOverrideMemoryPool(
+        memory::defaultMemoryManager().addRootPool(
+            queryCtx->queryId(), kMaxBytes));
+    auto task =
+        AssertQueryBuilder(
+            PlanBuilder()
+                .values(batches)
+                .orderBy({fmt::format("{} ASC NULLS LAST", "c0")}, false)
+                .planNode(),
+            duckDbQueryRunner_)
+            .queryCtx(queryCtx)
+            .spillDirectory(tempDirectory->path)
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kOrderBySpillEnabled, "true")
+            .assertResults("SELECT * FROM tmp");
+
+    auto stats = task->taskStats().pipelineStats;
+    ASSERT_EQ(testData.expectSpill, stats[0].operatorStats[1].spilledBytes > 0);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+}
+
 DEBUG_ONLY_TEST_F(OrderByTest, reclaimDuringInputProcessing) {
   constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
   auto rowType = ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), INTEGER()});
@@ -17,9 +17,11 @@
 #include <gtest/gtest.h>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/FileSystems.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/serializers/PrestoSerializer.h"
 
 using namespace facebook::velox;
@@ -635,6 +637,68 @@ TEST_F(OutputBufferManagerTest, basicPartitioned) {
   EXPECT_TRUE(task->isFinished());
 }
 
+TEST_F(OutputBufferManagerTest, spillPartitioned) {
+  filesystems::registerLocalFileSystem();
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  const std::string taskId = "spill";
+  bufferManager_->removeTask(taskId);
+
+  auto planFragment = exec::test::PlanBuilder()
+                          .values({std::dynamic_pointer_cast<RowVector>(
+                              BatchMaker::createBatch(rowType_, 100, *pool_))})
+                          .planFragment();
+  const auto pageSize = makeSerializedPage(rowType_, 100)->size();
+  std::unordered_map<std::string, std::string> configSettings{
+      {core::QueryConfig::kMaxPartitionedOutputBufferSize,
+       std::to_string(pageSize * 2)},
+      {core::QueryConfig::kPartitionedOutputSpillEnabled, "true"}};
+  auto task = Task::create(
+      taskId,
+      std::move(planFragment),
+      0,
+      std::make_shared<core::QueryCtx>(
+          executor_.get(), core::QueryConfig(std::move(configSettings))));
+  task->setSpillDirectory(spillDirectory->path);
+  bufferManager_->initializeTask(
+      task, PartitionedOutputNode::Kind::kPartitioned, 2, 1);
+
+  // Destination 0 does not fetch while the producer adds 10 pages. The pages
+  // over the limit go to disk and the producer does not block.
+  std::vector<uint64_t> pageSizes;
+  for (auto i = 0; i < 10; ++i) {
+    auto page = makeSerializedPage(rowType_, 100);
+    pageSizes.push_back(page->size());
+    ContinueFuture future;
+    ASSERT_FALSE(bufferManager_->enqueue(taskId, 0, std::move(page), &future));
+  }
+  const auto spillPath = spillDirectory->path + "/OutputBuffer";
+  ASSERT_TRUE(
+      filesystems::getFileSystem(spillPath, nullptr)->exists(spillPath));
+  noMoreData(taskId);
+
+  // The pages come back in order, followed by the end marker.
+  for (auto i = 0; i < pageSizes.size(); ++i) {
+    bool received = false;
+    ASSERT_TRUE(bufferManager_->getData(
+        taskId,
+        0,
+        1,
+        i,
+        [&](std::vector<std::unique_ptr<folly::IOBuf>> pages,
+            int64_t sequence) {
+          ASSERT_EQ(sequence, i);
+          ASSERT_EQ(pages.size(), 1);
+          ASSERT_NE(pages[0], nullptr);
+          EXPECT_EQ(pages[0]->computeChainDataLength(), pageSizes[i]);
+          received = true;
+        }));
+    ASSERT_TRUE(received);
+  }
+  fetchEndMarker(taskId, 0, pageSizes.size());
+  fetchEndMarker(taskId, 1, 0);
+  bufferManager_->removeTask(taskId);
+}
+
 TEST_F(OutputBufferManagerTest, basicBroadcast) {
   vector_size_t size = 100;
 
@@ -791,6 +855,46 @@ TEST_F(OutputBufferManagerTest, basicArbitrary) {
   EXPECT_TRUE(task->isFinished());
 }
 
+TEST_F(OutputBufferManagerTest, arbitraryBalancesBytes) {
+  const std::string taskId = "t0";
+  auto task = initializeTask(
+      taskId, rowType_, PartitionedOutputNode::Kind::kArbitrary, 2, 1);
+  bufferManager_->updateOutputBuffers(taskId, 2, true);
+  // Pages of the same size.
+  auto vector = BatchMaker::createBatch(rowType_, 100, *pool_);
+  const auto enqueuePage = [&]() {
+    ContinueFuture future;
+    ASSERT_FALSE(
+        bufferManager_->enqueue(taskId, 0, toSerializedPage(vector), &future));
+  };
+
+  // A fetch takes an even share of the buffered bytes, not all of them.
+  for (int i = 0; i < 3; ++i) {
+    enqueuePage();
+  }
+  fetch(taskId, 0, 0, std::numeric_limits<int64_t>::max(), 2);
+  acknowledge(taskId, 0, 2);
+  fetch(taskId, 1, 0, 1, 1);
+  acknowledge(taskId, 1, 1);
+
+  // Destination 1 has loaded fewer bytes, so it gets the next page although
+  // destination 0 comes first in round robin order.
+  bool receivedData0{false};
+  bool receivedData1{false};
+  registerForData(taskId, 0, 2, 1, receivedData0);
+  registerForData(taskId, 1, 1, 1, receivedData1);
+  enqueuePage();
+  ASSERT_FALSE(receivedData0);
+  ASSERT_TRUE(receivedData1);
+  enqueuePage();
+  ASSERT_TRUE(receivedData0);
+
+  noMoreData(taskId);
+  fetchEndMarker(taskId, 0, 3);
+  fetchEndMarker(taskId, 1, 2);
+  bufferManager_->removeTask(taskId);
+}
+
 TEST_F(OutputBufferManagerTest, broadcastWithDynamicAddedDestination) {
   vector_size_t size = 100;
 
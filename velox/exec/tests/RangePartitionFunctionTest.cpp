@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/RangePartitionFunction.h"
+#include <gtest/gtest.h>
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+class RangePartitionFunctionTest : public test::VectorTestBase,
+                                   public testing::Test {};
+
+TEST_F(RangePartitionFunctionTest, function) {
+  auto data = makeRowVector(
+      {makeFlatVector<std::string>({"a", "b", "c", "d", "e", "f"}),
+       makeNullableFlatVector<int32_t>({5, 10, 11, 20, 21, std::nullopt})});
+  std::vector<uint32_t> partitions;
+
+  {
+    RangePartitionFunction function(
+        {1},
+        {core::SortOrder(true, false)},
+        makeRowVector({makeFlatVector<int32_t>({10, 20})}));
+    EXPECT_EQ(3, function.numPartitions());
+    ASSERT_FALSE(function.partition(*data, partitions).has_value());
+    EXPECT_EQ(partitions, std::vector<uint32_t>({0, 0, 1, 1, 2, 2}));
+  }
+
+  {
+    RangePartitionFunction function(
+        {1},
+        {core::SortOrder(false, true)},
+        makeRowVector({makeFlatVector<int32_t>({20, 10})}));
+    ASSERT_FALSE(function.partition(*data, partitions).has_value());
+    EXPECT_EQ(partitions, std::vector<uint32_t>({2, 1, 1, 0, 0, 0}));
+  }
+
+  // Ties on the first key are split on the second.
+  {
+    RangePartitionFunction function(
+        {1, 0},
+        {core::SortOrder(true, true), core::SortOrder(true, true)},
+        makeRowVector(
+            {makeFlatVector<int32_t>({11}),
+             makeFlatVector<std::string>({"b"})}));
+    ASSERT_FALSE(function.partition(*data, partitions).has_value());
+    EXPECT_EQ(partitions, std::vector<uint32_t>({0, 0, 1, 1, 1, 0}));
+  }
+
+  // Without splitters all rows go to a single partition.
+  {
+    RangePartitionFunction function(
+        {1},
+        {core::SortOrder(true, true)},
+        makeRowVector({makeFlatVector<int32_t>(std::vector<int32_t>{})}));
+    EXPECT_EQ(1, function.numPartitions());
+    const auto singlePartition = function.partition(*data, partitions);
+    ASSERT_TRUE(singlePartition.has_value());
+    EXPECT_EQ(0u, singlePartition.value());
+  }
+}
+
+// Checks routing by normalized keys against comparing the key vectors, for
+// key types and orders the normalized keys must reproduce exactly.
+TEST_F(RangePartitionFunctionTest, normalizedKeys) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<double>(
+          {-1.5,
+           std::nullopt,
+           -0.0,
+           0.0,
+           std::numeric_limits<double>::quiet_NaN(),
+           2.5,
+           std::numeric_limits<double>::infinity(),
+           0.0}),
+      makeNullableFlatVector<std::string>(
+          {"x", "y", "", std::string("a\0", 2), "a", std::nullopt, "ab", "b"}),
+      makeArrayVector<int32_t>({{1}, {2}, {}, {3}, {1, 2}, {4}, {5}, {6}}),
+  });
+  std::vector<uint32_t> partitions;
+  for (auto ascending : {true, false}) {
+    for (auto nullsFirst : {true, false}) {
+      const std::vector<core::SortOrder> sortOrders(
+          2, core::SortOrder(ascending, nullsFirst));
+      const CompareFlags flags{nullsFirst, ascending};
+      auto splitters = RangePartitionFunction::makeSplitters(
+          *data, {0, 1}, sortOrders, 4, pool());
+      RangePartitionFunction function({0, 1}, sortOrders, splitters);
+      function.partition(*data, partitions);
+      for (auto row = 0; row < data->size(); ++row) {
+        uint32_t expected = 0;
+        for (auto splitter = 0; splitter < splitters->size(); ++splitter) {
+          auto result = data->childAt(0)
+                            ->compare(
+                                splitters->childAt(0).get(),
+                                row,
+                                splitter,
+                                flags)
+                            .value();
+          if (result == 0) {
+            result = data->childAt(1)
+                         ->compare(
+                             splitters->childAt(1).get(), row, splitter, flags)
+                         .value();
+          }
+          expected += result > 0;
+        }
+        EXPECT_EQ(partitions[row], expected) << data->toString(row);
+      }
+    }
+  }
+
+  // Keys that can not be normalized are compared as vectors.
+  const std::vector<core::SortOrder> sortOrders{core::SortOrder(true, true)};
+  RangePartitionFunction function(
+      {2},
+      sortOrders,
+      RangePartitionFunction::makeSplitters(*data, {2}, sortOrders, 2, pool()));
+  function.partition(*data, partitions);
+  EXPECT_EQ(partitions, std::vector<uint32_t>({0, 0, 0, 0, 0, 1, 1, 1}));
+}
+
+TEST_F(RangePartitionFunctionTest, makeSplitters) {
+  const vector_size_t numRows = 1'000;
+  auto data = makeRowVector({makeFlatVector<int64_t>(
+      numRows, [](auto row) { return (row * 37) % numRows; })});
+
+  auto splitters = RangePartitionFunction::makeSplitters(
+      *data, {0}, {core::SortOrder(true, true)}, 4, pool());
+  test::assertEqualVectors(
+      makeRowVector({makeFlatVector<int64_t>({250, 500, 750})}), splitters);
+
+  RangePartitionFunction function(
+      {0}, {core::SortOrder(true, true)}, splitters);
+  std::vector<uint32_t> partitions;
+  function.partition(*data, partitions);
+  std::vector<int32_t> partitionSizes(function.numPartitions());
+  for (auto i = 0; i < numRows; ++i) {
+    ++partitionSizes[partitions[i]];
+    const auto value = data->childAt(0)->asFlatVector<int64_t>()->valueAt(i);
+    const uint32_t expected = value == 0 ? 0 : (value - 1) / 250;
+    EXPECT_EQ(partitions[i], expected);
+  }
+  EXPECT_EQ(partitionSizes, std::vector<int32_t>({251, 250, 250, 249}));
+
+  splitters = RangePartitionFunction::makeSplitters(
+      *data, {0}, {core::SortOrder(false, true)}, 2, pool());
+  test::assertEqualVectors(
+      makeRowVector({makeFlatVector<int64_t>({499})}), splitters);
+
+  VELOX_ASSERT_THROW(
+      RangePartitionFunction::makeSplitters(
+          *makeRowVector({makeFlatVector<int64_t>(std::vector<int64_t>{})}),
+          {0},
+          {core::SortOrder(true, true)},
+          2,
+          pool()),
+      "Splitters need a non-empty sample");
+}
+
+TEST_F(RangePartitionFunctionTest, spec) {
+  Type::registerSerDe();
+
+  auto rangeSpec = std::make_unique<RangePartitionFunctionSpec>(
+      ROW({"c0", "c1"}, {BIGINT(), VARCHAR()}),
+      std::vector<column_index_t>{1, 0},
+      std::vector<core::SortOrder>{
+          core::SortOrder(true, false), core::SortOrder(false, true)},
+      makeRowVector(
+          {makeFlatVector<std::string>({"a", "m"}),
+           makeFlatVector<int64_t>({1, 2})}));
+  ASSERT_EQ(
+      "RANGE(c1 ASC NULLS LAST, c0 DESC NULLS FIRST) 2 splitters",
+      rangeSpec->toString());
+  ASSERT_NE(rangeSpec->create(3), nullptr);
+  VELOX_ASSERT_THROW(
+      rangeSpec->create(2),
+      "Range partitioning needs one splitter less than partitions");
+
+  auto serialized = rangeSpec->serialize();
+  auto copy = RangePartitionFunctionSpec::deserialize(serialized, pool());
+  ASSERT_EQ(rangeSpec->toString(), copy->toString());
+  ASSERT_EQ(serialized, copy->serialize());
+}
@@ -708,9 +708,9 @@ TEST_F(RowContainerTest, erase) {
   auto data = makeRowContainer({SMALLINT()}, {SMALLINT()});
 
   // The layout is expected to be smallint - 6 bytes of padding - 1 byte of bits
-  // - smallint - next pointer. The bits are a null flag for the second
+  // - next pointer - smallint. The bits are a null flag for the second
   // smallint, a probed flag and a free flag.
-  EXPECT_EQ(data->nextOffset(), 11);
+  EXPECT_EQ(data->nextOffset(), 9);
   // 2nd bit in first byte of flags.
   EXPECT_EQ(data->probedFlagOffset(), 8 * 8 + 1);
   std::unordered_set<char*> rowSet;
@@ -756,6 +756,48 @@ TEST_F(RowContainerTest, erase) {
   data->checkConsistency();
 }
 
+// Extracts 8 byte keys from rows that include nullptrs, which the SIMD
+// gather skips, and a number of rows that is not a multiple of the batch.
+TEST_F(RowContainerTest, extractGatheredKeys) {
+  constexpr int32_t kNumRows = 1'003;
+  auto data = makeRowContainer({BIGINT(), DOUBLE()}, {});
+  auto bigints =
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row * 11; });
+  auto doubles =
+      makeFlatVector<double>(kNumRows, [](auto row) { return row * 0.5; });
+  DecodedVector decodedBigints(*bigints);
+  DecodedVector decodedDoubles(*doubles);
+  std::vector<char*> rows(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    rows[i] = data->newRow();
+    data->store(decodedBigints, i, rows[i], 0);
+    data->store(decodedDoubles, i, rows[i], 1);
+  }
+  for (auto i = 0; i < kNumRows; i += 37) {
+    rows[i] = nullptr;
+  }
+  auto isNull = [](auto row) { return row % 37 == 0; };
+
+  auto bigintResult = BaseVector::create(BIGINT(), kNumRows, pool_.get());
+  // Sets nulls to check that extraction clears them for gathered rows.
+  bigintResult->setNull(40, true);
+  data->extractColumn(rows.data(), kNumRows, 0, bigintResult);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          kNumRows, [](auto row) { return row * 11; }, isNull),
+      bigintResult);
+
+  auto doubleResult = BaseVector::create(DOUBLE(), kNumRows + 5, pool_.get());
+  data->extractColumn(rows.data(), kNumRows, 1, 5, doubleResult);
+  for (auto i = 0; i < kNumRows; ++i) {
+    ASSERT_EQ(isNull(i), doubleResult->isNullAt(i + 5)) << i;
+    if (!isNull(i)) {
+      ASSERT_EQ(
+          i * 0.5, doubleResult->asFlatVector<double>()->valueAt(i + 5));
+    }
+  }
+}
+
 TEST_F(RowContainerTest, initialNulls) {
   std::vector<TypePtr> keys{INTEGER()};
   std::vector<TypePtr> dependent{INTEGER()};
@@ -781,10 +823,10 @@ TEST_F(RowContainerTest, rowSize) {
   auto data = makeRowContainer({SMALLINT()}, {VARCHAR()});
 
   // The layout is expected to be smallint - 6 bytes of padding - 1 byte of bits
-  // - StringView - rowSize - next pointer. The bits are a null flag for the
+  // - next pointer - StringView - rowSize. The bits are a null flag for the
   // second smallint, a probed flag and a free flag.
-  EXPECT_EQ(25, data->rowSizeOffset());
-  EXPECT_EQ(29, data->nextOffset());
+  EXPECT_EQ(33, data->rowSizeOffset());
+  EXPECT_EQ(9, data->nextOffset());
   // 2nd bit in first byte of flags.
   EXPECT_EQ(data->probedFlagOffset(), 8 * 8 + 1);
   std::vector<char*> rows;
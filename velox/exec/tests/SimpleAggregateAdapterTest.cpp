@@ -110,6 +110,47 @@ TEST_F(SimpleAverageAggregationTest, averageAggregate) {
   testAggregations({inputVectors}, {}, {"simple_avg(c0)"}, {expected});
 }
 
+TEST_F(SimpleAverageAggregationTest, addInputBatch) {
+  // Inputs without nulls go through addInputBatch() and
+  // addSingleGroupInputBatch().
+  auto inputVectors = makeRowVector(
+      {makeFlatVector<int32_t>(1'000, [](auto row) { return row % 7; }),
+       makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+       makeFlatVector<double>(1'000, [](auto row) { return row * 0.1; }),
+       makeFlatVector<bool>(1'000, [](auto row) { return row % 3 != 0; })});
+  createDuckDbTable({inputVectors});
+
+  testAggregations(
+      {inputVectors},
+      {"c0"},
+      {"simple_avg(c1)", "simple_avg(c2)"},
+      "SELECT c0, avg(c1), avg(c2) FROM tmp GROUP BY c0");
+  testAggregations(
+      {inputVectors},
+      {},
+      {"simple_avg(c1)", "simple_avg(c2)"},
+      "SELECT avg(c1), avg(c2) FROM tmp");
+
+  // A mask makes runs of selected rows.
+  for (const auto& groupingKeys :
+       {std::vector<std::string>{"c0"}, std::vector<std::string>{}}) {
+    auto plan = PlanBuilder()
+                    .values({inputVectors})
+                    .singleAggregation(
+                        groupingKeys,
+                        {"simple_avg(c1)", "simple_avg(c2)"},
+                        {"c3", "c3"})
+                    .planNode();
+    assertQuery(
+        plan,
+        groupingKeys.empty()
+            ? "SELECT avg(c1) FILTER (WHERE c3), avg(c2) FILTER (WHERE c3) "
+              "FROM tmp"
+            : "SELECT c0, avg(c1) FILTER (WHERE c3), "
+              "avg(c2) FILTER (WHERE c3) FROM tmp GROUP BY c0");
+  }
+}
+
 class SimpleArrayAggAggregationTest : public AggregationTestBase {
  protected:
   void SetUp() override {
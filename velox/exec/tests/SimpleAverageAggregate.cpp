@@ -49,6 +49,35 @@ class AverageAggregate {
     return true;
   }
 
+  struct AccumulatorType;
+
+  // Optional. Adds each of 'size' non-null input values to the accumulator in
+  // 'accumulators' at the same position.
+  static void addInputBatch(
+      HashStringAllocator* /*allocator*/,
+      AccumulatorType** accumulators,
+      vector_size_t size,
+      const T* data) {
+    for (auto i = 0; i < size; ++i) {
+      accumulators[i]->sum_ += data[i];
+      ++accumulators[i]->count_;
+    }
+  }
+
+  // Optional. Adds 'size' non-null input values to 'accumulator'.
+  static void addSingleGroupInputBatch(
+      HashStringAllocator* /*allocator*/,
+      AccumulatorType& accumulator,
+      vector_size_t size,
+      const T* data) {
+    double sum = 0;
+    for (auto i = 0; i < size; ++i) {
+      sum += data[i];
+    }
+    accumulator.sum_ += sum;
+    accumulator.count_ = checkedPlus<int64_t>(accumulator.count_, size);
+  }
+
   struct AccumulatorType {
     double sum_;
     int64_t count_;
@@ -19,6 +19,7 @@
 
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/dwio/common/SortingWriter.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/type/Type.h"
@@ -180,6 +181,107 @@ TEST_F(SortBufferTest, multipleKeys) {
   ASSERT_EQ(output->childAt(1)->asFlatVector<int32_t>()->valueAt(4), 2);
 }
 
+TEST_F(SortBufferTest, prefixSort) {
+  const auto inputType = ROW(
+      {{"c0", BIGINT()},
+       {"c1", INTEGER()},
+       {"c2", SMALLINT()},
+       {"c3", BOOLEAN()},
+       {"c4", VARCHAR()},
+       {"c5", TINYINT()},
+       {"c6", BIGINT()},
+       {"c7", BIGINT()}});
+  const vector_size_t size = 1'000;
+  RowVectorPtr data = makeRowVector(
+      {makeFlatVector<int64_t>(
+           size,
+           [](auto row) { return row % 7 - 3; },
+           [](auto row) { return row % 11 == 0; }),
+       makeFlatVector<int32_t>(
+           size,
+           [](auto row) { return (row * 37) % 13 - 6; },
+           [](auto row) { return row % 5 == 0; }),
+       makeFlatVector<int16_t>(size, [](auto row) { return row % 5 - 2; }),
+       makeFlatVector<bool>(
+           size,
+           [](auto row) { return row % 3 == 0; },
+           [](auto row) { return row % 13 == 0; }),
+       makeFlatVector<std::string>(
+           size, [](auto row) { return std::to_string(row % 17); }),
+       makeFlatVector<int8_t>(
+           size,
+           [](auto row) { return row % 4 - 2; },
+           [](auto row) { return row % 9 == 0; }),
+       makeFlatVector<int64_t>(size, [](auto row) { return row % 3; }),
+       makeFlatVector<int64_t>(
+           size,
+           [](auto row) { return row % 2; },
+           [](auto row) { return row % 7 == 0; })});
+
+  const CompareFlags ascNullsFirst{true, true};
+  const CompareFlags ascNullsLast{false, true};
+  const CompareFlags descNullsFirst{true, false};
+  const CompareFlags descNullsLast{false, false};
+  struct {
+    std::vector<column_index_t> sortColumnIndices;
+    std::vector<CompareFlags> sortCompareFlags;
+
+    std::string debugString() const {
+      std::stringstream sortCompareFlagsStr;
+      for (const auto sortCompareFlag : sortCompareFlags) {
+        sortCompareFlagsStr << sortCompareFlag.toString() << ";";
+      }
+      return fmt::format(
+          "sortColumnIndices:{}, sortCompareFlags:{}",
+          folly::join(",", sortColumnIndices),
+          sortCompareFlagsStr.str());
+    }
+  } testSettings[] = {
+      {{0}, {ascNullsFirst}},
+      {{0}, {descNullsLast}},
+      {{1, 2}, {ascNullsLast, descNullsFirst}},
+      {{3, 4, 0}, {descNullsFirst, ascNullsFirst, ascNullsLast}},
+      // The first key can not be encoded.
+      {{4, 1}, {descNullsLast, ascNullsFirst}},
+      // The keys take more than PrefixSort::kMaxPrefixBytes bytes.
+      {{0, 1, 6, 7, 2, 5, 3},
+       {descNullsFirst,
+        ascNullsLast,
+        ascNullsFirst,
+        descNullsLast,
+        descNullsFirst,
+        ascNullsFirst,
+        descNullsLast}}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    std::vector<RowVectorPtr> results;
+    for (const bool prefixSortEnabled : {false, true}) {
+      auto sortBuffer = std::make_unique<SortBuffer>(
+          inputType,
+          testData.sortColumnIndices,
+          testData.sortCompareFlags,
+          10000,
+          pool_.get(),
+          &nonReclaimableSection_,
+          &numSpillRuns_,
+          nullptr,
+          0,
+          prefixSortEnabled);
+      sortBuffer->addInput(data);
+      sortBuffer->noMoreInput();
+      results.push_back(sortBuffer->getOutput());
+      ASSERT_EQ(results.back()->size(), size);
+    }
+    // Rows with equal keys may come out in any order, so only the sort key
+    // columns are compared.
+    for (const auto column : testData.sortColumnIndices) {
+      velox::test::assertEqualVectors(
+          results[0]->childAt(column), results[1]->childAt(column));
+    }
+  }
+}
+
 // TODO: enable it later with test utility to compare the sorted result.
 TEST_F(SortBufferTest, DISABLED_randomData) {
   struct {
@@ -483,4 +585,72 @@ TEST_F(SortBufferTest, emptySpill) {
     ASSERT_FALSE(sortBuffer->spilledStats());
   }
 }
+
+TEST_F(SortBufferTest, sortingWriterAsyncOutput) {
+  // Collects the written batches.
+  class TestWriter : public dwio::common::Writer {
+   public:
+    explicit TestWriter(std::vector<RowVectorPtr>& batches)
+        : batches_(batches) {}
+
+    void write(const VectorPtr& data) override {
+      batches_.push_back(std::dynamic_pointer_cast<RowVector>(data));
+    }
+
+    void flush() override {}
+
+    void close() override {}
+
+    void abort() override {}
+
+   private:
+    std::vector<RowVectorPtr>& batches_;
+  };
+
+  const std::shared_ptr<memory::MemoryPool> fuzzerPool =
+      memory::addDefaultLeafMemoryPool("sortingWriterSource");
+  VectorFuzzer fuzzer({.vectorSize = 1024}, fuzzerPool.get());
+  std::vector<RowVectorPtr> inputs;
+  for (int i = 0; i < 5; ++i) {
+    inputs.push_back(fuzzer.fuzzRow(inputType_));
+  }
+
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  auto spillConfig = getSpillConfig(
+      makeOperatorSpillPath(spillDirectory->path, 0, 0, 0));
+  std::vector<RowVectorPtr> expected;
+  std::vector<RowVectorPtr> actual;
+  for (bool async : {false, true}) {
+    SCOPED_TRACE(fmt::format("async {}", async));
+    auto sortBuffer = std::make_unique<SortBuffer>(
+        inputType_,
+        sortColumnIndices_,
+        sortCompareFlags_,
+        1000,
+        pool_.get(),
+        &nonReclaimableSection_,
+        &numSpillRuns_,
+        &spillConfig,
+        0);
+    auto* sortBufferPtr = sortBuffer.get();
+    dwio::common::SortingWriter writer(
+        std::make_unique<TestWriter>(async ? actual : expected),
+        std::move(sortBuffer),
+        async ? executor_.get() : nullptr);
+    for (int i = 0; i < inputs.size(); ++i) {
+      writer.write(inputs[i]);
+      // Spills the sorted runs so that the output is merged.
+      if (i % 2 == 0) {
+        sortBufferPtr->spill(0, 0);
+      }
+    }
+    writer.close();
+  }
+
+  ASSERT_EQ(actual.size(), expected.size());
+  ASSERT_EQ(actual.size(), 6);
+  for (int i = 0; i < actual.size(); ++i) {
+    velox::test::assertEqualVectors(expected[i], actual[i]);
+  }
+}
 } // namespace facebook::velox::functions::test
@@ -14,9 +14,11 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
+#include <numeric>
 
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -95,7 +97,8 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
       int numBatches,
       int numRowsPerBatch = 1000,
       int numDuplicates = 1,
-      const std::vector<CompareFlags>& compareFlags = {}) {
+      const std::vector<CompareFlags>& compareFlags = {},
+      folly::Executor* executor = nullptr) {
     ASSERT_TRUE(compareFlags.empty() || compareFlags.size() == 1);
     ASSERT_EQ(numBatches % 2, 0);
 
@@ -160,7 +163,10 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
         writeBufferSize,
         compressionKind_,
         pool(),
-        &stats_);
+        &stats_,
+        executor,
+        {},
+        fileFormat_);
     ASSERT_EQ(targetFileSize, state_->targetFileSize());
     ASSERT_EQ(numPartitions, state_->maxPartitions());
     ASSERT_EQ(stats_.rlock()->spilledPartitions, 0);
@@ -247,7 +253,8 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
       int numBatches,
       int numDuplicates,
       const std::vector<CompareFlags>& compareFlags,
-      uint64_t expectedNumSpilledFiles) {
+      uint64_t expectedNumSpilledFiles,
+      folly::Executor* executor = nullptr) {
     const int numRowsPerBatch = 1'000;
     SCOPED_TRACE(fmt::format(
         "targetFileSize: {}, numPartitions: {}, numBatches: {}, numDuplicates: {}, nullsFirst: {}, ascending: {}",
@@ -266,7 +273,8 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
         numBatches,
         numRowsPerBatch,
         numDuplicates,
-        compareFlags);
+        compareFlags,
+        executor);
     const auto stats = stats_.copy();
     ASSERT_EQ(stats.spilledPartitions, numPartitions);
     ASSERT_EQ(stats.spilledFiles, expectedNumSpilledFiles);
@@ -388,6 +396,7 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
   std::shared_ptr<TempDirectoryPath> tempDir_;
   memory::MemoryAllocator* allocator_;
   common::CompressionKind compressionKind_;
+  common::SpillFileFormat fileFormat_{common::SpillFileFormat::kPresto};
   std::vector<std::optional<int64_t>> values_;
   std::vector<std::vector<RowVectorPtr>> batchesByPartition_;
   std::string spillPath_;
@@ -416,6 +425,46 @@ TEST_P(SpillTest, spillState) {
   spillStateTest(kGB, 2, 8, 8, {}, 8);
 }
 
+TEST_P(SpillTest, spillStateWithExecutor) {
+  // Spill file writes and read ahead run on 'executor'.
+  folly::CPUThreadPoolExecutor executor(4);
+  spillStateTest(kGB, 2, 8, 1, {CompareFlags{true, true}}, 8, &executor);
+  spillStateTest(kGB, 2, 8, 8, {}, 8, &executor);
+  // New file on each batch write.
+  spillStateTest(1, 2, 8, 1, {}, 8 * 2, &executor);
+}
+
+TEST_P(SpillTest, spillInputReadAhead) {
+  // Reads a file of several buffers with and without read ahead.
+  constexpr int32_t kBufferSize = 64 << 10;
+  const auto path = tempDir_->path + "/readAhead";
+  std::string data(10 * kBufferSize + 123, '\0');
+  for (auto i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>(i * 31 + (i >> 10));
+  }
+  auto fs = filesystems::getFileSystem(path, nullptr);
+  {
+    auto file = fs->openFileForWrite(path);
+    file->append(data);
+    file->close();
+  }
+  folly::CPUThreadPoolExecutor executor(2);
+  for (auto* readAheadExecutor :
+       {static_cast<folly::Executor*>(nullptr),
+        static_cast<folly::Executor*>(&executor)}) {
+    SCOPED_TRACE(fmt::format("readAhead: {}", readAheadExecutor != nullptr));
+    SpillInput input(
+        fs->openFileForRead(path),
+        AlignedBuffer::allocate<char>(kBufferSize, pool()),
+        readAheadExecutor,
+        pool());
+    std::string result(data.size(), '\0');
+    input.readBytes(result.data(), result.size());
+    ASSERT_TRUE(input.atEnd());
+    ASSERT_EQ(data, result);
+  }
+}
+
 TEST_P(SpillTest, spillTimestamp) {
   // Verify that timestamp type retains it nanosecond precision when spilled and
   // read back.
@@ -462,6 +511,108 @@ TEST_P(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_P(SpillTest, mergeWithKeyPrefixes) {
+  // The INTEGER and SMALLINT keys are compared by their prefix and the
+  // VARCHAR key only on ties of the prefix.
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  const std::vector<CompareFlags> compareFlags = {
+      {false, false}, {true, true}, {true, false}};
+  const int32_t kNumFiles = 4;
+  const vector_size_t kSize = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(
+          kSize, [](auto row) { return row % 7; }, nullEvery(11)),
+      makeFlatVector<int16_t>(
+          kSize, [](auto row) { return row % 5 - 2; }, nullEvery(13)),
+      makeFlatVector<std::string>(
+          kSize, [](auto row) { return fmt::format("{}", row % 3); }),
+      makeFlatVector<int32_t>(kSize, [](auto row) { return row; }),
+  });
+  std::vector<vector_size_t> order(kSize);
+  std::iota(order.begin(), order.end(), 0);
+  auto lessThan = [&](vector_size_t left, vector_size_t right) {
+    for (auto key = 0; key < compareFlags.size(); ++key) {
+      const auto result = data->childAt(key)
+                              ->compare(
+                                  data->childAt(key).get(),
+                                  left,
+                                  right,
+                                  compareFlags[key])
+                              .value();
+      if (result != 0) {
+        return result < 0;
+      }
+    }
+    return false;
+  };
+  std::sort(order.begin(), order.end(), lessThan);
+
+  SpillState state(
+      tempDirectory->path + "/test",
+      1,
+      compareFlags.size(),
+      compareFlags,
+      1,
+      0,
+      compressionKind_,
+      pool(),
+      &stats_,
+      nullptr,
+      {},
+      fileFormat_);
+  state.setPartitionSpilled(0);
+  // Each file gets the rows at the positions of 'order' that are equal to
+  // it modulo 'kNumFiles'.
+  for (auto file = 0; file < kNumFiles; ++file) {
+    std::vector<vector_size_t> indices;
+    for (auto i = file; i < kSize; i += kNumFiles) {
+      indices.push_back(order[i]);
+    }
+    std::vector<VectorPtr> children;
+    for (const auto& child : data->children()) {
+      children.push_back(BaseVector::wrapInDictionary(
+          nullptr, makeIndices(indices), indices.size(), child));
+    }
+    state.appendToPartition(0, makeRowVector(children));
+  }
+  state.finishWrite(0);
+
+  // The last column is the row number in 'data'. Rows with equal keys may
+  // come in any order.
+  auto merge = state.startMerge(0, nullptr);
+  std::vector<bool> seen(kSize, false);
+  vector_size_t previous = -1;
+  for (auto i = 0; i < kSize; ++i) {
+    auto* stream = merge->next();
+    ASSERT_NE(nullptr, stream);
+    const auto row =
+        stream->decoded(3).valueAt<int32_t>(stream->currentIndex());
+    ASSERT_FALSE(seen[row]);
+    seen[row] = true;
+    if (previous != -1) {
+      ASSERT_FALSE(lessThan(row, previous));
+    }
+    previous = row;
+    stream->pop();
+  }
+  ASSERT_EQ(nullptr, merge->next());
+}
+
+TEST_P(SpillTest, columnarFileFormat) {
+  spillStateTest(kGB, 2, 8, 1, {CompareFlags{true, true}}, 8);
+  const auto prestoBytes = stats_.rlock()->spilledBytes;
+
+  fileFormat_ = common::SpillFileFormat::kColumnar;
+  spillStateTest(kGB, 2, 8, 1, {CompareFlags{true, true}}, 8);
+  if (compressionKind_ == common::CompressionKind_NONE) {
+    // The sorted keys are frame-of-reference encoded.
+    ASSERT_LT(stats_.rlock()->spilledBytes, prestoBytes / 2);
+  }
+  spillStateTest(kGB, 2, 8, 1, {CompareFlags{false, false}}, 8);
+  spillStateTest(kGB, 2, 8, 8, {}, 8);
+  spillStateTest(1, 2, 8, 1, {CompareFlags{true, false}}, 8 * 2);
+}
+
 TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
@@ -690,6 +841,62 @@ TEST_P(SpillTest, spillPartitionSpilt) {
   }
 }
 
+TEST_P(SpillTest, spillOverflowTier) {
+  // The local tier takes the first file and the rest go to the overflow tier.
+  auto overflowDir = exec::test::TempDirectoryPath::create();
+  std::atomic<uint64_t> localBytes{0};
+  common::SpillOverflowTier overflowTier;
+  overflowTier.filePath = overflowDir->path + "/test";
+  overflowTier.maxLocalBytes = 1;
+  overflowTier.localBytes = &localBytes;
+  ASSERT_TRUE(overflowTier.enabled());
+
+  const auto localPath = tempDir_->path + "/test";
+  SpillState state(
+      localPath,
+      1,
+      1,
+      {},
+      kGB,
+      0,
+      compressionKind_,
+      pool(),
+      &stats_,
+      nullptr,
+      overflowTier);
+  state.setPartitionSpilled(0);
+  const int kNumFiles = 3;
+  for (auto i = 0; i < kNumFiles; ++i) {
+    state.appendToPartition(
+        0,
+        makeRowVector({makeFlatVector<int64_t>(
+            100, [i](auto row) { return i * 100 + row; })}));
+    state.finishWrite(0);
+  }
+  const auto paths = state.testingSpilledFilePaths();
+  ASSERT_EQ(kNumFiles, paths.size());
+  ASSERT_EQ(0, paths[0].find(localPath));
+  for (auto i = 1; i < kNumFiles; ++i) {
+    ASSERT_EQ(0, paths[i].find(overflowTier.filePath)) << paths[i];
+  }
+  auto fs = filesystems::getFileSystem(localPath, nullptr);
+  for (const auto& path : paths) {
+    ASSERT_TRUE(fs->exists(path));
+  }
+  ASSERT_EQ(localBytes, fs->openFileForRead(paths[0])->size());
+  ASSERT_EQ(kNumFiles - 1, runtimeStats_["spillOverflowFileSize"].count);
+
+  // The data reads back from both tiers in order.
+  auto merge = state.startMerge(0, nullptr);
+  for (auto i = 0; i < kNumFiles * 100; ++i) {
+    auto stream = merge->next();
+    ASSERT_NE(nullptr, stream);
+    ASSERT_EQ(i, stream->decoded(0).valueAt<int64_t>(stream->currentIndex()));
+    stream->pop();
+  }
+  ASSERT_EQ(nullptr, merge->next());
+}
+
 TEST_P(SpillTest, nonExistSpillFileOnDeletion) {
   const int32_t numRowsPerBatch = 50;
   std::vector<RowVectorPtr> batches;
@@ -727,6 +934,7 @@ TEST(SpillTest, spillStats) {
   stats1.spilledRows = 1023;
   stats1.spillSerializationTimeUs = 1023;
   stats1.spillMaxLevelExceededCount = 3;
+  stats1.setSpillLevel(1);
   ASSERT_FALSE(stats1.empty());
   SpillStats stats2;
   stats2.spillRuns = 100;
@@ -742,6 +950,10 @@ TEST(SpillTest, spillStats) {
   stats2.spilledRows = 1031;
   stats2.spillSerializationTimeUs = 1032;
   stats2.spillMaxLevelExceededCount = 4;
+  stats2.setSpillLevel(1);
+  ASSERT_EQ(stats2.spilledBytesByLevel[1], 1024);
+  ASSERT_EQ(stats2.spilledPartitionsByLevel[1], 1025);
+  ASSERT_EQ(stats2.spilledPartitionsByLevel[0], 0);
   ASSERT_TRUE(stats1 < stats2);
   ASSERT_TRUE(stats1 <= stats2);
   ASSERT_FALSE(stats1 > stats2);
@@ -768,6 +980,8 @@ TEST(SpillTest, spillStats) {
   ASSERT_EQ(delta.spillFillTimeUs, 7);
   ASSERT_EQ(delta.spilledRows, 8);
   ASSERT_EQ(delta.spillSerializationTimeUs, 9);
+  ASSERT_EQ(delta.spilledBytesByLevel[1], 0);
+  ASSERT_EQ(delta.spilledPartitionsByLevel[1], 1);
   delta = stats1 - stats2;
   ASSERT_EQ(delta.spilledInputBytes, 0);
   ASSERT_EQ(delta.spilledBytes, 0);
@@ -794,5 +1008,17 @@ TEST(SpillTest, spillStats) {
   ASSERT_EQ(zeroStats, stats1);
   ASSERT_EQ(
       stats2.toString(),
-      "spillRuns[100] spilledInputBytes[2.00KB] spilledBytes[1.00KB] spilledRows[1031] spilledPartitions[1025] spilledFiles[1026] spillFillTimeUs[1.03ms] spillSortTime[1.03ms] spillSerializationTime[1.03ms] spillDiskWrites[1028] spillFlushTime[1.03ms] spillWriteTime[1.03ms] maxSpillExceededLimitCount[4]");
+      "spillRuns[100] spilledInputBytes[2.00KB] spilledBytes[1.00KB] spilledRows[1031] spilledPartitions[1025] spilledFiles[1026] spillFillTimeUs[1.03ms] spillSortTime[1.03ms] spillSerializationTime[1.03ms] spillDiskWrites[1028] spillFlushTime[1.03ms] spillWriteTime[1.03ms] maxSpillExceededLimitCount[4] level1[1025 partitions 1.00KB]");
+
+  // Levels past the last entry are counted in the last entry.
+  SpillStats deepStats;
+  deepStats.spilledBytes = 100;
+  deepStats.spilledPartitions = 2;
+  deepStats.setSpillLevel(SpillStats::kNumSpillLevels + 3);
+  ASSERT_EQ(
+      deepStats.spilledBytesByLevel[SpillStats::kNumSpillLevels - 1], 100);
+  ASSERT_EQ(
+      deepStats.spilledPartitionsByLevel[SpillStats::kNumSpillLevels - 1], 2);
+  deepStats += stats2;
+  ASSERT_EQ(deepStats.spilledPartitionsByLevel[1], 1025);
 }
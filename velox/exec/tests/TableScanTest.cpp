@@ -16,6 +16,7 @@
 #include "velox/exec/TableScan.h"
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/process/ProcessBase.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnector.h"
@@ -455,6 +456,50 @@ DEBUG_ONLY_TEST_F(TableScanTest, timeLimitInGetOutput) {
   EXPECT_GE(numBailed, 12);
 }
 
+TEST_F(TableScanTest, yieldOnCpuTimeWithinSplit) {
+  // One split of many batches that the filter drops entirely except for the
+  // last one.
+  auto vectors = makeVectors(20, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId scanNodeId;
+  auto plan = PlanBuilder(pool_.get())
+                  .tableScan(rowType_, {"c0 = 0"})
+                  .capturePlanNodeId(scanNodeId)
+                  .planNode();
+
+  // Burn more than the CPU time limit on each empty batch.
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::TableScan::getOutput::emptyBatch",
+      std::function<void(const TableScan*)>(([&](const TableScan*) {
+        const auto start = process::threadCpuNanos();
+        while (process::threadCpuNanos() - start < 2'000'000) {
+        }
+      })));
+
+  auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                  .plan(plan)
+                  .split(makeHiveConnectorSplit(filePath->path))
+                  .config(QueryConfig::kTableScanGetOutputCpuTimeLimitMs, "1")
+                  .assertResults("SELECT * FROM tmp WHERE c0 = 0");
+  auto planStats = toPlanStats(task->taskStats());
+  EXPECT_EQ(planStats.at(scanNodeId).numSplits, 1);
+  EXPECT_GT(planStats.at(scanNodeId).customStats.at("cpuTimeYields").sum, 0);
+
+  // No yields without a limit.
+  task = AssertQueryBuilder(duckDbQueryRunner_)
+             .plan(plan)
+             .split(makeHiveConnectorSplit(filePath->path))
+             .assertResults("SELECT * FROM tmp WHERE c0 = 0");
+  EXPECT_EQ(
+      toPlanStats(task->taskStats())
+          .at(scanNodeId)
+          .customStats.count("cpuTimeYields"),
+      0);
+}
+
 TEST_F(TableScanTest, subfieldPruningRowType) {
   auto innerType = ROW({"a", "b"}, {BIGINT(), DOUBLE()});
   auto columnType = ROW({"c", "d"}, {innerType, BIGINT()});
@@ -1135,6 +1180,75 @@ TEST_F(TableScanTest, batchSize) {
   }
 }
 
+TEST_F(TableScanTest, limitHint) {
+  auto vectors = makeVectors(1, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+
+  auto plan = PlanBuilder()
+                  .addNode([&](auto nodeId, auto /*source*/) {
+                    return std::make_shared<core::TableScanNode>(
+                        nodeId,
+                        rowType_,
+                        makeTableHandle(),
+                        allRegularColumns(rowType_),
+                        10);
+                  })
+                  .limit(0, 10, false)
+                  .planNode();
+
+  // The scan reads only the 10 rows that the limit needs.
+  auto task = AssertQueryBuilder(plan)
+                  .split(makeHiveConnectorSplit(filePath->path))
+                  .assertResults(std::dynamic_pointer_cast<RowVector>(
+                      vectors[0]->slice(0, 10)));
+  auto stats = getTableScanStats(task);
+  EXPECT_EQ(10, stats.outputRows);
+  EXPECT_EQ(1, stats.outputVectors);
+
+  VELOX_ASSERT_THROW(
+      std::make_shared<core::TableScanNode>(
+          "0", rowType_, makeTableHandle(), allRegularColumns(rowType_), 0),
+      "(0 vs. 0)");
+}
+
+TEST_F(TableScanTest, multiFileSplit) {
+  auto filePaths = makeFilePaths(10);
+  auto vectors = makeVectors(10, 100);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->path, vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  // Two splits of 3 and 7 files.
+  std::vector<std::shared_ptr<HiveConnectorSplit>> fileSplits;
+  for (const auto& split : makeHiveConnectorSplits(filePaths)) {
+    fileSplits.push_back(std::dynamic_pointer_cast<HiveConnectorSplit>(split));
+  }
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits = {
+      std::make_shared<HiveMultiFileSplit>(
+          kHiveConnectorId,
+          std::vector<std::shared_ptr<HiveConnectorSplit>>(
+              fileSplits.begin(), fileSplits.begin() + 3)),
+      std::make_shared<HiveMultiFileSplit>(
+          kHiveConnectorId,
+          std::vector<std::shared_ptr<HiveConnectorSplit>>(
+              fileSplits.begin() + 3, fileSplits.end()))};
+
+  auto task = assertQuery(tableScanNode(), splits, "SELECT * FROM tmp");
+  auto stats = getTableScanStats(task);
+  EXPECT_EQ(2, stats.numSplits);
+  EXPECT_EQ(1'000, stats.rawInputRows);
+
+  // With a filter that skips some of the files.
+  assertQuery(
+      PlanBuilder(pool_.get())
+          .tableScan(rowType_, {"c0 > 0"}, "c0 % 3 = 1")
+          .planNode(),
+      splits,
+      "SELECT * FROM tmp WHERE c0 > 0 AND c0 % 3 = 1");
+}
+
 // Test that adding the same split with the same sequence id does not cause
 // double read and the 2nd split is ignored.
 TEST_F(TableScanTest, sequentialSplitNoDoubleRead) {
@@ -1240,12 +1354,46 @@ TEST_F(TableScanTest, multipleSplits) {
     auto stats = getTableScanRuntimeStats(task);
     if (numPrefetchSplit != 0) {
       ASSERT_GT(stats.at("preloadedSplits").sum, 10);
+      // Each preloaded split was either waited for or opened in the
+      // background.
+      ASSERT_GT(
+          stats.count("preloadWaitWallNanos") +
+              stats.count("preloadHiddenWallNanos"),
+          0);
     } else {
       ASSERT_EQ(stats.count("preloadedSplits"), 0);
     }
   }
 }
 
+TEST_F(TableScanTest, splitPreloadMemoryLimit) {
+  FLAGS_split_preload_per_driver = 2;
+  auto filePaths = makeFilePaths(20);
+  auto vectors = makeVectors(20, 100);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->path, vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  // The reader of the first split takes more than 1 byte, so no split is
+  // preloaded.
+  auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                  .plan(tableScanNode())
+                  .splits(makeHiveConnectorSplits(filePaths))
+                  .config(QueryConfig::kMaxSplitPreloadMemoryBytes, "1")
+                  .assertResults("SELECT * FROM tmp");
+  auto stats = getTableScanRuntimeStats(task);
+  ASSERT_EQ(stats.count("preloadedSplits"), 0);
+
+  task = AssertQueryBuilder(duckDbQueryRunner_)
+             .plan(tableScanNode())
+             .splits(makeHiveConnectorSplits(filePaths))
+             .config(QueryConfig::kMaxSplitPreloadMemoryBytes, "1073741824")
+             .assertResults("SELECT * FROM tmp");
+  stats = getTableScanRuntimeStats(task);
+  ASSERT_GT(stats.at("preloadedSplits").sum, 0);
+}
+
 TEST_F(TableScanTest, waitForSplit) {
   auto filePaths = makeFilePaths(10);
   auto vectors = makeVectors(10, 1'000);
@@ -2457,6 +2605,39 @@ TEST_F(TableScanTest, remainingFilter) {
       "SELECT * FROM tmp WHERE not (c0 > 0 or c1 > c0)");
 }
 
+TEST_F(TableScanTest, remainingFilterInReader) {
+  auto rowType = ROW({"c0", "c1", "c2"}, {BIGINT(), BIGINT(), BIGINT()});
+  auto filePaths = makeFilePaths(3);
+  auto vectors = makeVectors(3, 1'000, rowType);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->path, vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  // The reader evaluates the filter after reading c0 and c1 and reads c2 only
+  // for the passing rows.
+  assertQuery(
+      PlanBuilder(pool_.get()).tableScan(rowType, {}, "c0 > c1").planNode(),
+      filePaths,
+      "SELECT * FROM tmp WHERE c0 > c1");
+
+  // Filter on a column with a range filter and a column without.
+  assertQuery(
+      PlanBuilder(pool_.get())
+          .tableScan(rowType, {"c2 > 0"}, "c2 % 3 <> c0 % 3")
+          .planNode(),
+      filePaths,
+      "SELECT * FROM tmp WHERE c2 > 0 AND c2 % 3 <> c0 % 3");
+
+  // Filter without inputs is evaluated before reading any column.
+  assertQuery(
+      PlanBuilder(pool_.get())
+          .tableScan(rowType, {}, "rand() < 2.0")
+          .planNode(),
+      filePaths,
+      "SELECT * FROM tmp");
+}
+
 TEST_F(TableScanTest, remainingFilterSkippedStrides) {
   auto rowType = ROW({{"c0", BIGINT()}, {"c1", BIGINT()}});
   std::vector<RowVectorPtr> vectors(3);
@@ -2612,6 +2793,27 @@ TEST_F(TableScanTest, aggregationPushdown) {
   // 5 aggregates processing 10K rows each via pushdown.
   EXPECT_EQ(5 * 10'000, loadedToValueHook(task, 1));
 
+  op = PlanBuilder()
+           .tableScan(rowType_)
+           .singleAggregation(
+               {"c5"},
+               {"count(c0)",
+                "count(c1)",
+                "count(c2)",
+                "count(c3)",
+                "count(c4)",
+                "sum(c6)",
+                "max(c6)"})
+           .planNode();
+
+  task = assertQuery(
+      op,
+      {filePath},
+      "SELECT c5, count(c0), count(c1), count(c2), count(c3), count(c4), "
+      "sum(c6), max(c6) FROM tmp group by c5");
+  // 7 aggregates processing 10K rows each via pushdown.
+  EXPECT_EQ(7 * 10'000, loadedToValueHook(task, 1));
+
   // Pushdown should also happen if there is a FilterProject node that doesn't
   // touch columns being aggregated
   op = PlanBuilder()
@@ -3532,3 +3734,284 @@ TEST_F(TableScanTest, varbinaryPartitionKey) {
 
   assertQuery(op, split, "SELECT c0, '2021-12-02' FROM tmp");
 }
+
+TEST_F(TableScanTest, clusteredAggregation) {
+  // Two sorted buckets with disjoint keys.
+  std::vector<RowVectorPtr> vectors;
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  for (auto i = 0; i < 2; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [i](auto row) { return i * 1'000 + row / 10; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    }));
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->path, vectors.back());
+  }
+  createDuckDbTable(vectors);
+
+  ColumnHandleMap assignments = {
+      {"a", regularColumn("c0", BIGINT())},
+      {"b", regularColumn("c1", BIGINT())}};
+  auto makePlan = [&](const std::vector<std::string>& clusteringKeys,
+                      core::PlanNodeId& aggregationId) {
+    auto tableHandle = std::make_shared<HiveTableHandle>(
+        kHiveConnectorId,
+        "hive_table",
+        true,
+        SubfieldFilters{},
+        nullptr,
+        nullptr,
+        std::unordered_map<std::string, std::string>{},
+        clusteringKeys);
+    return PlanBuilder()
+        .tableScan(
+            ROW({"a", "b"}, {BIGINT(), BIGINT()}), tableHandle, assignments)
+        .project({"a AS k", "b"})
+        .singleAggregation({"k"}, {"sum(b)", "count(1)"})
+        .capturePlanNodeId(aggregationId)
+        .planNode();
+  };
+
+  // Clustered input is aggregated without a hash table.
+  core::PlanNodeId aggregationId;
+  auto task = assertQuery(
+      makePlan({"c0", "c1"}, aggregationId),
+      filePaths,
+      "SELECT c0, sum(c1), count(1) FROM tmp GROUP BY 1");
+  auto stats = toPlanStats(task->taskStats()).at(aggregationId).customStats;
+  ASSERT_EQ(stats.count("hashtable.capacity"), 0);
+
+  // No clustering on the grouping keys.
+  task = assertQuery(
+      makePlan({"c1"}, aggregationId),
+      filePaths,
+      "SELECT c0, sum(c1), count(1) FROM tmp GROUP BY 1");
+  stats = toPlanStats(task->taskStats()).at(aggregationId).customStats;
+  ASSERT_EQ(stats.count("hashtable.capacity"), 1);
+}
+
+TEST_F(TableScanTest, statsAggregates) {
+  std::vector<RowVectorPtr> vectors;
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  for (auto i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [i](auto row) { return i * 1'000 - row; }),
+        makeFlatVector<double>(
+            1'000,
+            [i](auto row) { return i + row * 0.5; },
+            [](auto row) { return row % 7 == 0; }),
+        makeFlatVector<Timestamp>(
+            1'000, [i](auto row) { return Timestamp(i * 100 + row, 0); }),
+    }));
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->path, vectors.back());
+  }
+  createDuckDbTable(vectors);
+
+  using Kind = HiveStatsAggregate::Kind;
+  auto makePlan = [&](const std::vector<HiveStatsAggregate>& aggregates,
+                      const RowTypePtr& outputType,
+                      const std::vector<std::string>& finalAggregates) {
+    auto tableHandle = std::make_shared<HiveTableHandle>(
+        kHiveConnectorId,
+        "hive_table",
+        true,
+        SubfieldFilters{},
+        nullptr,
+        asRowType(vectors[0]->type()),
+        std::unordered_map<std::string, std::string>{},
+        std::vector<std::string>{},
+        aggregates);
+    return PlanBuilder()
+        .tableScan(outputType, tableHandle, {})
+        .singleAggregation({}, finalAggregates)
+        .planNode();
+  };
+  auto numStatsAggregatedSplits = [](const std::shared_ptr<Task>& task) {
+    auto stats = task->taskStats().pipelineStats[0].operatorStats[0];
+    auto it = stats.runtimeStats.find("numStatsAggregatedSplits");
+    return it != stats.runtimeStats.end() ? it->second.sum : 0;
+  };
+
+  // Count, min and max of integers and doubles come from the statistics.
+  auto plan = makePlan(
+      {{Kind::kCount, ""},
+       {Kind::kCount, "c1"},
+       {Kind::kMin, "c0"},
+       {Kind::kMax, "c0"},
+       {Kind::kMin, "c1"},
+       {Kind::kMax, "c1"}},
+      ROW({"n", "n1", "min0", "max0", "min1", "max1"},
+          {BIGINT(), BIGINT(), BIGINT(), BIGINT(), DOUBLE(), DOUBLE()}),
+      {"sum(n)",
+       "sum(n1)",
+       "min(min0)",
+       "max(max0)",
+       "min(min1)",
+       "max(max1)"});
+  auto task = assertQuery(
+      plan,
+      filePaths,
+      "SELECT count(*), count(c1), min(c0), max(c0), min(c1), max(c1) FROM tmp");
+  EXPECT_EQ(numStatsAggregatedSplits(task), 3);
+
+  // Min and max of timestamps are computed from the rows.
+  plan = makePlan(
+      {{Kind::kCount, ""}, {Kind::kMin, "c2"}, {Kind::kMax, "c2"}},
+      ROW({"n", "min2", "max2"}, {BIGINT(), TIMESTAMP(), TIMESTAMP()}),
+      {"sum(n)", "min(min2)", "max(max2)"});
+  task = assertQuery(
+      plan, filePaths, "SELECT count(*), min(c2), max(c2) FROM tmp");
+  EXPECT_EQ(numStatsAggregatedSplits(task), 0);
+
+  // A split that covers a part of the file is read.
+  plan = makePlan(
+      {{Kind::kCount, ""}, {Kind::kMax, "c0"}},
+      ROW({"n", "max0"}, {BIGINT(), BIGINT()}),
+      {"sum(n)", "max(max0)"});
+  task = assertQuery(
+      plan,
+      makeHiveConnectorSplit(
+          filePaths[1]->path, 0, fs::file_size(filePaths[1]->path) - 1),
+      "SELECT count(*), max(c0) FROM tmp WHERE c0 > 0 AND c0 <= 1000");
+  EXPECT_EQ(numStatsAggregatedSplits(task), 0);
+
+  // Filters on data columns are not supported.
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(
+          PlanBuilder()
+              .tableScan(
+                  ROW({"n"}, {BIGINT()}),
+                  std::make_shared<HiveTableHandle>(
+                      kHiveConnectorId,
+                      "hive_table",
+                      true,
+                      SubfieldFilters{},
+                      parseExpr("c0 > 0", asRowType(vectors[0]->type())),
+                      asRowType(vectors[0]->type()),
+                      std::unordered_map<std::string, std::string>{},
+                      std::vector<std::string>{},
+                      std::vector<HiveStatsAggregate>{{Kind::kCount, ""}}),
+                  {})
+              .planNode())
+          .split(makeHiveConnectorSplit(filePaths[0]->path))
+          .copyResults(pool()),
+      "Stats aggregates do not support a remaining filter");
+}
+
+TEST_F(TableScanTest, scanResultCache) {
+  auto vectors = makeVectors(5, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  createDuckDbTable(vectors);
+  resetHiveConnector(std::make_shared<core::MemConfig>(
+      std::unordered_map<std::string, std::string>{
+          {connector::hive::HiveConfig::kScanResultCacheBytes,
+           folly::to<std::string>(64 << 20)}}));
+
+  auto runQuery = [&](const std::string& filter,
+                      const std::string& sql,
+                      bool enableCache) {
+    auto plan = PlanBuilder(pool_.get())
+                    .tableScan(rowType_, {filter}, "c0 % 3 = 0")
+                    .planNode();
+    return AssertQueryBuilder(duckDbQueryRunner_)
+        .plan(plan)
+        .splits(makeHiveConnectorSplits({filePath}))
+        .connectorConfig(
+            kHiveConnectorId,
+            connector::hive::HiveConfig::kScanResultCacheEnabled,
+            enableCache ? "true" : "false")
+        .assertResults(sql);
+  };
+
+  auto task =
+      runQuery("c1 > 0", "SELECT * FROM tmp WHERE c1 > 0 AND c0 % 3 = 0", true);
+  auto stats = getTableScanRuntimeStats(task);
+  ASSERT_EQ(0, stats["numResultCacheHits"].sum);
+  ASSERT_EQ(1, stats["numResultCacheMisses"].sum);
+
+  // The same scan returns the cached batches.
+  task =
+      runQuery("c1 > 0", "SELECT * FROM tmp WHERE c1 > 0 AND c0 % 3 = 0", true);
+  stats = getTableScanRuntimeStats(task);
+  ASSERT_EQ(1, stats["numResultCacheHits"].sum);
+  ASSERT_EQ(0, stats["numResultCacheMisses"].sum);
+  ASSERT_EQ(5'000, getTableScanStats(task).rawInputRows);
+
+  // A different filter misses.
+  task = runQuery(
+      "c1 > 1000", "SELECT * FROM tmp WHERE c1 > 1000 AND c0 % 3 = 0", true);
+  stats = getTableScanRuntimeStats(task);
+  ASSERT_EQ(0, stats["numResultCacheHits"].sum);
+  ASSERT_EQ(1, stats["numResultCacheMisses"].sum);
+
+  // Queries that do not enable the cache do not use it.
+  task = runQuery(
+      "c1 > 0", "SELECT * FROM tmp WHERE c1 > 0 AND c0 % 3 = 0", false);
+  ASSERT_EQ(0, getTableScanRuntimeStats(task).count("numResultCacheHits"));
+
+  auto hiveConnector =
+      std::dynamic_pointer_cast<connector::hive::HiveConnector>(
+          connector::getConnector(kHiveConnectorId));
+  const auto cacheStats = hiveConnector->scanResultCache()->stats();
+  ASSERT_EQ(2, cacheStats.numEntries);
+  ASSERT_LT(0, cacheStats.bytes);
+}
+
+TEST_F(TableScanTest, filterOrderCache) {
+  auto vectors = makeVectors(5, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  createDuckDbTable(vectors);
+  resetHiveConnector(std::make_shared<core::MemConfig>(
+      std::unordered_map<std::string, std::string>{
+          {connector::hive::HiveConfig::kFilterOrderCacheEntries, "100"}}));
+
+  auto runQuery = [&](const std::vector<std::string>& filters,
+                      const std::string& sql) {
+    auto plan =
+        PlanBuilder(pool_.get()).tableScan(rowType_, filters).planNode();
+    return AssertQueryBuilder(duckDbQueryRunner_)
+        .plan(plan)
+        .splits(makeHiveConnectorSplits({filePath, filePath}))
+        .assertResults(sql);
+  };
+
+  // The first scan measures the filters and adds them to the history.
+  auto task = runQuery(
+      {"c0 > 0", "c1 > 0"},
+      "SELECT * FROM tmp WHERE c0 > 0 AND c1 > 0 "
+      "UNION ALL SELECT * FROM tmp WHERE c0 > 0 AND c1 > 0");
+  auto stats = getTableScanRuntimeStats(task);
+  ASSERT_EQ(0, stats["numFilterOrderCacheHits"].sum);
+  ASSERT_EQ(1, stats["numFilterOrderCacheMisses"].sum);
+
+  auto hiveConnector =
+      std::dynamic_pointer_cast<connector::hive::HiveConnector>(
+          connector::getConnector(kHiveConnectorId));
+  auto* cache = hiveConnector->filterOrderCache();
+  ASSERT_EQ(1, cache->stats().numEntries);
+
+  // The next scan with the same filters starts from the history.
+  task = runQuery(
+      {"c1 > 0", "c0 > 0"},
+      "SELECT * FROM tmp WHERE c0 > 0 AND c1 > 0 "
+      "UNION ALL SELECT * FROM tmp WHERE c0 > 0 AND c1 > 0");
+  stats = getTableScanRuntimeStats(task);
+  ASSERT_EQ(1, stats["numFilterOrderCacheHits"].sum);
+  ASSERT_EQ(0, stats["numFilterOrderCacheMisses"].sum);
+  ASSERT_EQ(1, cache->stats().numEntries);
+
+  // A scan with a single filter has nothing to order.
+  task = runQuery(
+      {"c0 > 0"},
+      "SELECT * FROM tmp WHERE c0 > 0 "
+      "UNION ALL SELECT * FROM tmp WHERE c0 > 0");
+  stats = getTableScanRuntimeStats(task);
+  ASSERT_EQ(0, stats["numFilterOrderCacheHits"].sum);
+  ASSERT_EQ(0, stats["numFilterOrderCacheMisses"].sum);
+  ASSERT_EQ(1, cache->stats().numEntries);
+}
@@ -999,6 +999,74 @@ TEST_F(BasicTableWriteTest, roundTrip) {
   assertEqualResults({data}, {copy});
 }
 
+TEST_F(BasicTableWriteTest, sortedBucketedWrite) {
+  const vector_size_t size = 1'000;
+  const int32_t bucketCount = 4;
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 37; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return size - row; }),
+  });
+  auto rowType = asRowType(data->type());
+  auto bucketProperty = std::make_shared<HiveBucketProperty>(
+      HiveBucketProperty::Kind::kHiveCompatible,
+      bucketCount,
+      std::vector<std::string>{"c0"},
+      std::vector<TypePtr>{INTEGER()},
+      std::vector<std::shared_ptr<const HiveSortingColumn>>{
+          std::make_shared<HiveSortingColumn>(
+              "c1", core::SortOrder{true, true})});
+
+  auto targetDirectoryPath = TempDirectoryPath::create();
+  core::PlanNodeId tableWriteNodeId;
+  auto plan = PlanBuilder()
+                  .values({data}, true)
+                  .tableWrite(targetDirectoryPath->path, {}, bucketProperty)
+                  .capturePlanNodeId(tableWriteNodeId)
+                  .localPartition(std::vector<std::string>{})
+                  .tableWriteMerge()
+                  .project({TableWriteTraits::rowCountColumnName()})
+                  .singleAggregation(
+                      {},
+                      {fmt::format(
+                          "sum({})", TableWriteTraits::rowCountColumnName())})
+                  .planNode();
+
+  // The 4 drivers of the values node each produce 'data'.
+  auto task =
+      AssertQueryBuilder(plan)
+          .maxDrivers(4)
+          .config(QueryConfig::kTaskWriterCount, "4")
+          .config(QueryConfig::kTaskPartitionedWriterCount, "2")
+          .assertResults(makeRowVector({makeFlatVector<int64_t>(
+              std::vector<int64_t>{size * 4})}));
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(2, planStats.at(tableWriteNodeId).numDrivers);
+
+  // Each bucket is written to one file by one writer and is sorted on 'c1'.
+  std::unordered_set<int32_t> seenKeys;
+  int32_t numFiles = 0;
+  for (auto& path : fs::directory_iterator(targetDirectoryPath->path)) {
+    ++numFiles;
+    auto copy = AssertQueryBuilder(PlanBuilder().tableScan(rowType).planNode())
+                    .split(makeHiveConnectorSplit(path.path().string()))
+                    .copyResults(pool());
+    auto keys = copy->childAt(0)->as<SimpleVector<int32_t>>();
+    auto values = copy->childAt(1)->as<SimpleVector<int64_t>>();
+    std::unordered_set<int32_t> fileKeys;
+    for (auto i = 0; i < copy->size(); ++i) {
+      fileKeys.insert(keys->valueAt(i));
+      if (i > 0) {
+        ASSERT_LE(values->valueAt(i - 1), values->valueAt(i));
+      }
+    }
+    for (auto key : fileKeys) {
+      ASSERT_TRUE(seenKeys.insert(key).second) << key;
+    }
+  }
+  ASSERT_EQ(bucketCount, numFiles);
+  ASSERT_EQ(37, seenKeys.size());
+}
+
 class PartitionedTableWriterTest
     : public TableWriteTest,
       public testing::WithParamInterface<uint64_t> {
@@ -1314,4 +1314,42 @@ TEST_F(TaskTest, driverCreationMemoryAllocationCheck) {
     }
   }
 }
+
+TEST_F(TaskTest, timeline) {
+  TaskTimeline ring(3);
+  for (auto i = 0; i < 5; ++i) {
+    ring.record({.category = "driver", .name = std::to_string(i)});
+  }
+  const auto kept = ring.events();
+  ASSERT_EQ(kept.size(), 3);
+  EXPECT_EQ(kept[0].name, "2");
+  EXPECT_EQ(kept[2].name, "4");
+  EXPECT_EQ(ring.numDropped(), 2);
+
+  auto data = makeRowVector({makeFlatVector<int64_t>(1'000, folly::identity)});
+  CursorParameters params;
+  params.planNode =
+      PlanBuilder().values({data}, false, 10).project({"c0 + 1"}).planNode();
+  params.queryCtx = std::make_shared<core::QueryCtx>(driverExecutor_.get());
+  params.queryCtx->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kTaskTimelineMaxEvents, "1000"}});
+  auto [cursor, results] = readCursor(params, [](Task*) {});
+  auto* timeline = cursor->task()->timeline();
+  ASSERT_NE(timeline, nullptr);
+  const auto events = timeline->events();
+  ASSERT_FALSE(events.empty());
+  EXPECT_TRUE(std::any_of(events.begin(), events.end(), [](const auto& e) {
+    return e.category == "driver" && e.pipelineId == 0 && e.driverId == 0;
+  }));
+
+  const auto trace = folly::parseJson(timeline->toChromeTraceJson("t"));
+  EXPECT_EQ(trace["otherData"]["taskId"], "t");
+  EXPECT_EQ(trace["traceEvents"][0]["ph"], "X");
+  EXPECT_EQ(trace["traceEvents"][0]["pid"], 1);
+
+  // The timeline is off by default.
+  params.queryCtx = std::make_shared<core::QueryCtx>(driverExecutor_.get());
+  auto [otherCursor, otherResults] = readCursor(params, [](Task*) {});
+  EXPECT_EQ(otherCursor->task()->timeline(), nullptr);
+}
 } // namespace facebook::velox::exec::test
@@ -233,6 +233,48 @@ TEST_F(TopNRowNumberTest, manyPartitions) {
   testLimit(100);
 }
 
+TEST_F(TopNRowNumberTest, inlineAndGrowingTopRows) {
+  // Partitions of 40 rows in mixed order. Limits up to 16 keep the top rows
+  // inlined in the hash table. Larger limits grow the top rows as rows arrive.
+  const vector_size_t size = 4'000;
+  auto data = split(
+      makeRowVector(
+          {"p", "s", "d"},
+          {
+              // Partitioning key.
+              makeFlatVector<int32_t>(size, [](auto row) { return row % 100; }),
+              // Sorting key. Unique within a partition.
+              makeFlatVector<int64_t>(
+                  size, [](auto row) { return (row * 7919) % size; }),
+              // Data.
+              makeFlatVector<int64_t>(
+                  size, [](auto row) { return row; }, nullEvery(13)),
+          }),
+      8);
+
+  createDuckDbTable(data);
+
+  auto testLimit = [&](auto limit) {
+    SCOPED_TRACE(fmt::format("Limit: {}", limit));
+    auto plan = PlanBuilder()
+                    .values(data)
+                    .topNRowNumber({"p"}, {"s"}, limit, true)
+                    .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+        .assertResults(fmt::format(
+            "SELECT * FROM (SELECT *, row_number() over (partition by p order by s) as rn FROM tmp) "
+            " WHERE rn <= {}",
+            limit));
+  };
+
+  testLimit(15);
+  testLimit(16);
+  testLimit(17);
+  testLimit(33);
+  testLimit(50);
+}
+
 TEST_F(TopNRowNumberTest, planNodeValidation) {
   auto data = makeRowVector(
       ROW({"a", "b", "c", "d", "e"},
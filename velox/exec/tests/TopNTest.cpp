@@ -261,3 +261,73 @@ TEST_F(TopNTest, lowCardinality) {
 
   testTwoKeys(vectors, "c0", "c1", 200);
 }
+
+TEST_F(TopNTest, prefilterByFirstKey) {
+  // Many batches of a few distinct values make most rows lose to the top row
+  // once the top rows are known, and many rows tie with it on the first key.
+  vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize, [&](auto row) { return (row * 17 + i) % 101; });
+    auto c1 = makeFlatVector<int32_t>(
+        batchSize, [&](auto row) { return (row + i) % 23; }, nullEvery(7));
+    auto c2 = makeFlatVector<int16_t>(
+        batchSize, [&](auto row) { return row % 31 - 15; }, nullEvery(11));
+    auto c3 = makeFlatVector<int8_t>(
+        batchSize, [&](auto row) { return (row * i) % 13; });
+    auto c4 = wrapInDictionary(
+        makeIndicesInReverse(batchSize),
+        batchSize,
+        makeFlatVector<int64_t>(
+            batchSize, [&](auto row) { return row % 57; }, nullEvery(5)));
+    auto c5 = makeFlatVector<Timestamp>(
+        batchSize,
+        [&](auto row) { return Timestamp((row % 97) * 10 + i, 0); },
+        nullEvery(13));
+    vectors.push_back(makeRowVector({c0, c1, c2, c3, c4, c5}));
+  }
+  createDuckDbTable(vectors);
+
+  // Only the keys are projected since the rows that tie on all keys at the
+  // limit may be any of them.
+  auto testKeys = [&](const std::vector<std::string>& keys, int32_t limit) {
+    std::vector<std::vector<std::string>> orderings{{}};
+    for (const auto& key : keys) {
+      std::vector<std::vector<std::string>> newOrderings;
+      for (const auto& ordering : orderings) {
+        for (const auto& sortOrderSql : getSortOrderSqls()) {
+          newOrderings.push_back(ordering);
+          newOrderings.back().push_back(
+              fmt::format("{} {}", key, sortOrderSql));
+        }
+      }
+      orderings = std::move(newOrderings);
+    }
+    std::vector<uint32_t> keyIndices(keys.size());
+    std::iota(keyIndices.begin(), keyIndices.end(), 0);
+    for (const auto& ordering : orderings) {
+      SCOPED_TRACE(folly::join(", ", ordering));
+      auto plan = PlanBuilder()
+                      .values(vectors)
+                      .topN(ordering, limit, false)
+                      .project(keys)
+                      .planNode();
+      assertQueryOrdered(
+          plan,
+          fmt::format(
+              "SELECT {} FROM tmp ORDER BY {} LIMIT {}",
+              folly::join(", ", keys),
+              folly::join(", ", ordering),
+              limit),
+          keyIndices);
+    }
+  };
+
+  testKeys({"c0"}, 10);
+  testKeys({"c1"}, 50);
+  testKeys({"c4"}, 100);
+  testKeys({"c5"}, 20);
+  testKeys({"c2", "c0"}, 30);
+  testKeys({"c3", "c1"}, 300);
+}
@@ -406,6 +406,48 @@ TEST_F(UnnestTest, allEmptyOrNullMaps) {
   assertQueryReturnsEmptyResult(op);
 }
 
+TEST_F(UnnestTest, splitLargeArrays) {
+  // Arrays of up to 5K elements, some null or empty, with the ordinality and
+  // a second unnested array of different sizes.
+  auto vector = makeRowVector({
+      makeFlatVector<int64_t>(20, [](auto row) { return row; }),
+      makeArrayVector<int32_t>(
+          20,
+          [](auto row) { return (row * 997) % 5'000; },
+          [](auto row, auto index) { return row * 10'000 + index; },
+          nullEvery(7)),
+      makeArrayVector<int64_t>(
+          20,
+          [](auto row) { return (row * 331) % 3'000; },
+          [](auto row, auto index) { return row + index; },
+          nullEvery(5)),
+  });
+
+  core::PlanNodeId unnestId;
+  auto op = PlanBuilder()
+                .values({vector})
+                .unnest({"c0"}, {"c1", "c2"}, "ordinal")
+                .capturePlanNodeId(unnestId)
+                .planNode();
+
+  auto expected = AssertQueryBuilder(op)
+                      .config(core::QueryConfig::kUnnestSplitOutput, "false")
+                      .copyResults(pool());
+
+  for (auto batchRows : {1, 100, 1'024, 4'999}) {
+    SCOPED_TRACE(fmt::format("batchRows: {}", batchRows));
+    auto task = AssertQueryBuilder(op)
+                    .config(
+                        core::QueryConfig::kPreferredOutputBatchRows,
+                        std::to_string(batchRows))
+                    .assertResults(expected);
+    auto stats = exec::toPlanStats(task->taskStats());
+    ASSERT_EQ(
+        bits::divRoundUp(expected->size(), batchRows),
+        stats.at(unnestId).outputVectors);
+  }
+}
+
 TEST_F(UnnestTest, batchSize) {
   auto data = makeRowVector({
       makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
@@ -424,10 +466,12 @@ TEST_F(UnnestTest, batchSize) {
       makeFlatVector<int64_t>(10'000 * 3, [](auto row) { return 1 + row % 3; }),
   });
 
-  // 17 rows per output allows to unnest 6 input rows at a time.
+  // 17 rows per output allows to unnest 6 input rows at a time if rows are not
+  // split across batches.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "17")
+                    .config(core::QueryConfig::kUnnestSplitOutput, "false")
                     .assertResults({expected});
     auto stats = exec::toPlanStats(task->taskStats());
 
@@ -435,10 +479,12 @@ TEST_F(UnnestTest, batchSize) {
     ASSERT_EQ(1 + 10'000 / 6, stats.at(unnestId).outputVectors);
   }
 
-  // 2 rows per output allows to unnest 1 input row at a time.
+  // 2 rows per output allows to unnest 1 input row at a time if rows are not
+  // split across batches.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "2")
+                    .config(core::QueryConfig::kUnnestSplitOutput, "false")
                     .assertResults({expected});
     auto stats = exec::toPlanStats(task->taskStats());
 
@@ -446,6 +492,21 @@ TEST_F(UnnestTest, batchSize) {
     ASSERT_EQ(10'000, stats.at(unnestId).outputVectors);
   }
 
+  // Rows are split across batches by default, so that all batches except the
+  // last have exactly the preferred number of rows.
+  for (auto batchRows : {2, 17, 1'000}) {
+    auto task = AssertQueryBuilder(plan)
+                    .config(
+                        core::QueryConfig::kPreferredOutputBatchRows,
+                        std::to_string(batchRows))
+                    .assertResults({expected});
+    auto stats = exec::toPlanStats(task->taskStats());
+
+    ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
+    ASSERT_EQ(
+        bits::divRoundUp(30'000, batchRows), stats.at(unnestId).outputVectors);
+  }
+
   // 100K rows per output allows to unnest all at once.
   {
     auto task =
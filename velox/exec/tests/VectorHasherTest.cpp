@@ -224,6 +224,31 @@ TEST_F(VectorHasherTest, flat) {
   }
 }
 
+TEST_F(VectorHasherTest, flatNoNullsMix) {
+  // Flat vectors without nulls are hashed a column at a time. Check that the
+  // hashes and their mix with previous hashes match the row-wise results.
+  auto bigints =
+      vectorMaker_->flatVector<int64_t>(100, [](auto row) { return row * 7; });
+  auto strings = vectorMaker_->flatVector<StringView>(100, [](auto row) {
+    return StringView::makeInline(std::string(row % 20, 'x'));
+  });
+
+  auto bigintHasher = exec::VectorHasher::create(BIGINT(), 0);
+  auto stringHasher = exec::VectorHasher::create(VARCHAR(), 1);
+  raw_vector<uint64_t> hashes(100);
+  bigintHasher->decode(*bigints, allRows_);
+  bigintHasher->hash(allRows_, false, hashes);
+  stringHasher->decode(*strings, allRows_);
+  stringHasher->hash(allRows_, true, hashes);
+
+  for (int32_t i = 0; i < 100; i++) {
+    auto expected = bits::hashMix(
+        folly::hasher<int64_t>()(i * 7),
+        folly::hasher<StringView>()(strings->valueAt(i)));
+    EXPECT_EQ(expected, hashes[i]) << "at " << i;
+  }
+}
+
 TEST_F(VectorHasherTest, nonNullConstant) {
   auto hasher = exec::VectorHasher::create(INTEGER(), 1);
   auto vector = BaseVector::createConstant(INTEGER(), 123, 100, pool_.get());
@@ -414,6 +439,72 @@ TEST_F(VectorHasherTest, stringIds) {
 }
 
 // Tests distinct overflow, but starting with a small string
+TEST_F(VectorHasherTest, poolAccounting) {
+  auto hasherPool = memory::addDefaultLeafMemoryPool();
+  auto hasher = exec::VectorHasher::create(VARCHAR(), 0, hasherPool.get());
+  ASSERT_EQ(hasherPool->currentBytes(), 0);
+
+  const vector_size_t size = 1'000;
+  std::vector<std::string> strings(size);
+  auto vector = vectorMaker_->flatVector<StringView>(size, [&](auto row) {
+    strings[row] = fmt::format("a long string value {}", row);
+    return StringView(strings[row]);
+  });
+  SelectivityVector rows(size);
+  raw_vector<uint64_t> hashes(size);
+  hasher->decode(*vector, rows);
+  ASSERT_FALSE(hasher->computeValueIds(rows, hashes));
+
+  // The distinct values and the copies of their strings are accounted to the
+  // pool.
+  uint64_t asRange;
+  uint64_t asDistincts;
+  hasher->cardinality(0, asRange, asDistincts);
+  ASSERT_EQ(asDistincts, size + 1);
+  ASSERT_GT(hasherPool->currentBytes(), size * sizeof(StringView));
+
+  hasher.reset();
+  ASSERT_EQ(hasherPool->currentBytes(), 0);
+}
+
+TEST_F(VectorHasherTest, stringDictionaryIdsAcrossBatches) {
+  // Strings longer than 7 bytes only map to distinct value ids.
+  auto dictionary = vectorMaker_->flatVector<std::string>(
+      {"grapefruit", "star fruit", "pineapple", "blueberry"});
+  auto makeBatch = [&](int32_t offset) {
+    return BaseVector::wrapInDictionary(
+        nullptr,
+        makeIndices(100, [&](auto row) { return (row + offset) % 4; }),
+        100,
+        dictionary);
+  };
+
+  auto hasher = exec::VectorHasher::create(VARCHAR(), 0);
+  raw_vector<uint64_t> ids(100);
+  auto batch = makeBatch(0);
+  hasher->decode(*batch, allRows_);
+  EXPECT_FALSE(hasher->computeValueIds(allRows_, ids));
+  hasher->enableValueIds(1, 0);
+
+  // Batches over the same dictionary reuse the ids of the previous batch and
+  // must map each string to the same id as a flat copy does.
+  for (auto offset = 0; offset < 3; ++offset) {
+    batch = makeBatch(offset);
+    hasher->decode(*batch, allRows_);
+    ASSERT_TRUE(hasher->computeValueIds(allRows_, ids));
+
+    auto flat = BaseVector::create(VARCHAR(), 100, pool_.get());
+    flat->copy(batch.get(), 0, 0, 100);
+    raw_vector<uint64_t> flatIds(100);
+    hasher->decode(*flat, allRows_);
+    ASSERT_TRUE(hasher->computeValueIds(allRows_, flatIds));
+    for (auto i = 0; i < 100; ++i) {
+      EXPECT_EQ(flatIds[i], ids[i]) << "at " << i;
+      EXPECT_EQ(ids[i], 1 + (i + offset) % 4) << "at " << i;
+    }
+  }
+}
+
 TEST_F(VectorHasherTest, stringDistinctOverflow) {
   auto hasher = exec::VectorHasher::create(VARCHAR(), 1);
 
@@ -306,14 +306,29 @@ PlanBuilder& PlanBuilder::tableWrite(
     const std::string& outputDirectoryPath,
     const dwio::common::FileFormat fileFormat,
     const std::vector<std::string>& aggregates) {
+  return tableWrite(
+      outputDirectoryPath, {}, nullptr, fileFormat, aggregates);
+}
+
+PlanBuilder& PlanBuilder::tableWrite(
+    const std::string& outputDirectoryPath,
+    const std::vector<std::string>& partitionBy,
+    const std::shared_ptr<connector::hive::HiveBucketProperty>& bucketProperty,
+    const dwio::common::FileFormat fileFormat,
+    const std::vector<std::string>& aggregates) {
   auto rowType = planNode_->outputType();
 
   std::vector<std::shared_ptr<const connector::hive::HiveColumnHandle>>
       columnHandles;
   for (auto i = 0; i < rowType->size(); ++i) {
+    const bool isPartitionKey =
+        std::find(partitionBy.begin(), partitionBy.end(), rowType->nameOf(i)) !=
+        partitionBy.end();
     columnHandles.push_back(std::make_shared<connector::hive::HiveColumnHandle>(
         rowType->nameOf(i),
-        connector::hive::HiveColumnHandle::ColumnType::kRegular,
+        isPartitionKey
+            ? connector::hive::HiveColumnHandle::ColumnType::kPartitionKey
+            : connector::hive::HiveColumnHandle::ColumnType::kRegular,
         rowType->childAt(i),
         rowType->childAt(i)));
   }
@@ -326,9 +341,14 @@ PlanBuilder& PlanBuilder::tableWrite(
       columnHandles,
       locationHandle,
       fileFormat,
-      nullptr, // bucketProperty,
+      bucketProperty,
       common::CompressionKind_NONE);
 
+  // Gives each writer a disjoint set of buckets.
+  if (bucketProperty != nullptr) {
+    localPartitionByBucket(bucketProperty);
+  }
+
   auto insertHandle =
       std::make_shared<core::InsertTableHandle>(kHiveConnectorId, hiveHandle);
 
@@ -353,7 +373,7 @@ PlanBuilder& PlanBuilder::tableWrite(
       rowType->names(),
       aggregationNode,
       insertHandle,
-      false,
+      bucketProperty != nullptr,
       TableWriteTraits::outputType(aggregationNode),
       connector::CommitStrategy::kNoCommit,
       planNode_);
@@ -266,6 +266,30 @@ class PlanBuilder {
           dwio::common::FileFormat::DWRF,
       const std::vector<std::string>& aggregates = {});
 
+  /// Adds a TableWriteNode to write all input columns into a partitioned
+  /// and/or bucketed Hive table without compression. For a bucketed table,
+  /// adds a LocalPartitionNode by bucket ahead of the writer, so that each of
+  /// the 'task_partitioned_writer_count' writers owns a disjoint set of
+  /// buckets. The buckets are sorted if 'bucketProperty' has sorting columns.
+  /// The writers' outputs are to be gathered with a local partition followed
+  /// by tableWriteMerge().
+  ///
+  /// @param outputDirectoryPath Path to a directory to write data to.
+  /// @param partitionBy Names of the partition key columns. Can be empty.
+  /// @param bucketProperty Bucketing and sorting of the table. Can be
+  /// nullptr for an un-bucketed table.
+  /// @param fileFormat File format to use for the written data.
+  /// @param aggregates Aggregations for column statistics collection during
+  /// write.
+  PlanBuilder& tableWrite(
+      const std::string& outputDirectoryPath,
+      const std::vector<std::string>& partitionBy,
+      const std::shared_ptr<connector::hive::HiveBucketProperty>&
+          bucketProperty,
+      const dwio::common::FileFormat fileFormat =
+          dwio::common::FileFormat::DWRF,
+      const std::vector<std::string>& aggregates = {});
+
   /// Add a TableWriteMergeNode.
   PlanBuilder& tableWriteMerge(
       const std::shared_ptr<core::AggregationNode>& aggregationNode = nullptr);
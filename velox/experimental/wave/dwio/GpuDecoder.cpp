@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/dwio/GpuDecoder.h"
+
+#include <algorithm>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::wave {
+
+namespace {
+uint64_t readVarint(const uint8_t*& data, const uint8_t* end) {
+  uint64_t result = 0;
+  for (int32_t shift = 0;; shift += 7) {
+    VELOX_CHECK_LT(data, end, "Truncated RLE/bit-packed run header");
+    VELOX_CHECK_LT(shift, 64, "Invalid RLE/bit-packed run header");
+    const uint8_t byte = *data++;
+    result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return result;
+    }
+  }
+}
+} // namespace
+
+std::vector<DecodeRun> parseRleBitPackedRuns(
+    const uint8_t* data,
+    int64_t size,
+    uint8_t bitWidth,
+    int32_t numValues,
+    int32_t maxRunSize) {
+  VELOX_CHECK_LE(bitWidth, 32);
+  VELOX_CHECK_GT(maxRunSize, 0);
+  const auto* start = data;
+  const auto* end = data + size;
+  const int32_t valueBytes = (bitWidth + 7) / 8;
+  std::vector<DecodeRun> runs;
+  int32_t numDecoded = 0;
+  while (numDecoded < numValues) {
+    const auto header = readVarint(data, end);
+    const bool bitPacked = header & 1;
+    int64_t count;
+    int64_t bitOffset = -1;
+    int32_t value = 0;
+    if (bitPacked) {
+      // The count is in groups of 8 values. The last group may be padded.
+      const int64_t numBytes = (header >> 1) * bitWidth;
+      VELOX_CHECK_LE(numBytes, end - data, "Truncated bit-packed run");
+      count = (header >> 1) * 8;
+      bitOffset = (data - start) * 8;
+      data += numBytes;
+    } else {
+      VELOX_CHECK_LE(valueBytes, end - data, "Truncated RLE run");
+      count = header >> 1;
+      for (auto i = 0; i < valueBytes; ++i) {
+        value |= static_cast<uint32_t>(data[i]) << (8 * i);
+      }
+      data += valueBytes;
+    }
+    count = std::min<int64_t>(count, numValues - numDecoded);
+    for (int64_t i = 0; i < count; i += maxRunSize) {
+      const int32_t pieceSize = std::min<int64_t>(maxRunSize, count - i);
+      runs.push_back(
+          {numDecoded,
+           pieceSize,
+           bitPacked ? bitOffset + i * bitWidth : -1,
+           value});
+      numDecoded += pieceSize;
+    }
+  }
+  return runs;
+}
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/dwio/GpuDecoder.h"
+
+namespace facebook::velox::wave {
+
+namespace {
+// Returns the 'bitWidth' <= 32 bit value that starts at bit 'bit' of
+// 'input'. Reads only the bytes that hold the value, so that a value at the
+// end of the buffer does not read past it.
+__device__ inline int32_t
+loadBits(const uint8_t* input, uint64_t bit, uint8_t bitWidth) {
+  if (bitWidth == 0) {
+    return 0;
+  }
+  const uint8_t* bytes = input + (bit >> 3);
+  const int32_t shift = bit & 7;
+  const int32_t numBytes = (shift + bitWidth + 7) >> 3;
+  uint64_t word = 0;
+  for (auto i = 0; i < numBytes; ++i) {
+    word |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+  }
+  return static_cast<int32_t>((word >> shift) & ((1ULL << bitWidth) - 1));
+}
+
+__global__ void unpackBitsKernel(
+    const uint8_t* input,
+    uint8_t bitWidth,
+    int32_t numValues,
+    int32_t* result) {
+  const int32_t row = blockIdx.x * blockDim.x + threadIdx.x;
+  if (row < numValues) {
+    result[row] =
+        loadBits(input, static_cast<uint64_t>(row) * bitWidth, bitWidth);
+  }
+}
+
+__global__ void decodeRleBitPackedKernel(
+    const uint8_t* input,
+    uint8_t bitWidth,
+    const DecodeRun* runs,
+    int32_t* result) {
+  const DecodeRun& run = runs[blockIdx.x];
+  int32_t* runResult = result + run.outputOffset;
+  if (run.bitOffset < 0) {
+    for (int32_t i = threadIdx.x; i < run.numValues; i += blockDim.x) {
+      runResult[i] = run.value;
+    }
+    return;
+  }
+  for (int32_t i = threadIdx.x; i < run.numValues; i += blockDim.x) {
+    runResult[i] = loadBits(input, run.bitOffset + i * bitWidth, bitWidth);
+  }
+}
+
+__global__ void gatherDictionaryKernel(
+    const int64_t* dictionary,
+    const int32_t* indices,
+    int32_t numValues,
+    int64_t* result) {
+  const int32_t row = blockIdx.x * blockDim.x + threadIdx.x;
+  if (row < numValues) {
+    result[row] = dictionary[indices[row]];
+  }
+}
+} // namespace
+
+void GpuDecoderStream::unpackBits(
+    const uint8_t* input,
+    uint8_t bitWidth,
+    int32_t numValues,
+    int32_t* result) {
+  if (numValues == 0) {
+    return;
+  }
+  const int32_t numBlocks = roundUp(numValues, kBlockSize) / kBlockSize;
+  unpackBitsKernel<<<numBlocks, kBlockSize, 0, stream_->stream>>>(
+      input, bitWidth, numValues, result);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+void GpuDecoderStream::decodeRleBitPacked(
+    const uint8_t* input,
+    uint8_t bitWidth,
+    const DecodeRun* runs,
+    int32_t numRuns,
+    int32_t* result) {
+  if (numRuns == 0) {
+    return;
+  }
+  decodeRleBitPackedKernel<<<numRuns, kBlockSize, 0, stream_->stream>>>(
+      input, bitWidth, runs, result);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+void GpuDecoderStream::gatherDictionary(
+    const int64_t* dictionary,
+    const int32_t* indices,
+    int32_t numValues,
+    int64_t* result) {
+  if (numValues == 0) {
+    return;
+  }
+  const int32_t numBlocks = roundUp(numValues, kBlockSize) / kBlockSize;
+  gatherDictionaryKernel<<<numBlocks, kBlockSize, 0, stream_->stream>>>(
+      dictionary, indices, numValues, result);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace facebook::velox::wave
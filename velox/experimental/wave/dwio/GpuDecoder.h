@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "velox/experimental/wave/common/Cuda.h"
+
+/// Decoding of integer column data on the device. The compressed pages are
+/// decompressed on the host and the encoded data is decoded by thread blocks
+/// into device buffers that Wave operators consume.
+namespace facebook::velox::wave {
+
+/// A piece of a Parquet RLE/bit-packed hybrid stream. Each piece is decoded
+/// by one thread block.
+struct DecodeRun {
+  /// Position of the first value of the run in the result.
+  int32_t outputOffset;
+
+  int32_t numValues;
+
+  /// Bit position of the first value of a bit-packed run in the input. -1
+  /// for a RLE run.
+  int64_t bitOffset;
+
+  /// The repeated value of a RLE run.
+  int32_t value;
+};
+
+/// Parses the run headers of the RLE/bit-packed hybrid encoded 'data' of
+/// 'numValues' values of 'bitWidth' bits. The headers are read on the host
+/// since each depends on the previous run. Runs of more than 'maxRunSize'
+/// values are split so that the work of the thread blocks is balanced.
+std::vector<DecodeRun> parseRleBitPackedRuns(
+    const uint8_t* data,
+    int64_t size,
+    uint8_t bitWidth,
+    int32_t numValues,
+    int32_t maxRunSize);
+
+class GpuDecoderStream : public Stream {
+ public:
+  static constexpr int32_t kBlockSize = 256;
+
+  /// Maximum number of values in a DecodeRun passed to decodeRleBitPacked().
+  static constexpr int32_t kMaxRunSize = 8 * kBlockSize;
+
+  /// Unpacks 'numValues' little endian values of 'bitWidth' <= 32 bits from
+  /// 'input' into 'result'. 'input' and 'result' are device or unified
+  /// memory.
+  void unpackBits(
+      const uint8_t* input,
+      uint8_t bitWidth,
+      int32_t numValues,
+      int32_t* result);
+
+  /// Decodes 'numRuns' 'runs' from parseRleBitPackedRuns() over 'input' into
+  /// 'result'. 'runs' must be accessible from the device.
+  void decodeRleBitPacked(
+      const uint8_t* input,
+      uint8_t bitWidth,
+      const DecodeRun* runs,
+      int32_t numRuns,
+      int32_t* result);
+
+  /// Sets 'result[i]' to 'dictionary[indices[i]]' for the first 'numValues'
+  /// indices.
+  void gatherDictionary(
+      const int64_t* dictionary,
+      const int32_t* indices,
+      int32_t numValues,
+      int64_t* result);
+};
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/dwio/GpuDecoder.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/experimental/wave/common/GpuArena.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::wave;
+
+class GpuDecoderTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    device_ = getDevice();
+    setDevice(device_);
+    arena_ = std::make_unique<GpuArena>(1 << 28, getAllocator(device_));
+  }
+
+  // Appends 'values' bit-packed with 'bitWidth' bits to 'data'.
+  static void appendBitPacked(
+      const std::vector<int32_t>& values,
+      uint8_t bitWidth,
+      std::vector<uint8_t>& data) {
+    const auto start = data.size();
+    data.resize(start + (values.size() * bitWidth + 7) / 8);
+    for (auto i = 0; i < values.size(); ++i) {
+      for (auto bit = 0; bit < bitWidth; ++bit) {
+        if (values[i] & (1U << bit)) {
+          const uint64_t position = i * bitWidth + bit;
+          data[start + position / 8] |= 1 << (position % 8);
+        }
+      }
+    }
+  }
+
+  static void appendVarint(uint64_t value, std::vector<uint8_t>& data) {
+    while (value >= 0x80) {
+      data.push_back((value & 0x7f) | 0x80);
+      value >>= 7;
+    }
+    data.push_back(value);
+  }
+
+  template <typename T>
+  T* copyToDevice(const std::vector<T>& values, WaveBufferPtr& holder) {
+    auto* data =
+        arena_->allocate<T>(std::max<size_t>(values.size(), 1), holder);
+    std::copy(values.begin(), values.end(), data);
+    return data;
+  }
+
+  Device* device_;
+  std::unique_ptr<GpuArena> arena_;
+};
+
+TEST_F(GpuDecoderTest, unpackBits) {
+  for (uint8_t bitWidth : {1, 3, 8, 13, 17, 32}) {
+    std::vector<int32_t> values(10'003);
+    for (auto i = 0; i < values.size(); ++i) {
+      values[i] = (i * 2'654'435'761ULL) & ((1ULL << bitWidth) - 1);
+    }
+    std::vector<uint8_t> encoded;
+    appendBitPacked(values, bitWidth, encoded);
+    WaveBufferPtr inputBuffer;
+    WaveBufferPtr resultBuffer;
+    auto* input = copyToDevice(encoded, inputBuffer);
+    auto* result = arena_->allocate<int32_t>(values.size(), resultBuffer);
+    GpuDecoderStream stream;
+    stream.unpackBits(input, bitWidth, values.size(), result);
+    stream.wait();
+    for (auto i = 0; i < values.size(); ++i) {
+      ASSERT_EQ(values[i], result[i]) << "bitWidth " << (int)bitWidth;
+    }
+  }
+}
+
+TEST_F(GpuDecoderTest, rleBitPacked) {
+  constexpr uint8_t kBitWidth = 11;
+  std::vector<int32_t> expected;
+  std::vector<uint8_t> encoded;
+  // Alternates long RLE runs, which are split, with bit-packed runs. The last
+  // bit-packed group is padded past the number of values.
+  for (auto run = 0; run < 20; ++run) {
+    const int32_t count = 100 + run * 500;
+    const int32_t value = run * 97;
+    appendVarint(count << 1, encoded);
+    encoded.push_back(value & 0xff);
+    encoded.push_back(value >> 8);
+    expected.insert(expected.end(), count, value);
+
+    std::vector<int32_t> packed(8 * (run + 1));
+    for (auto i = 0; i < packed.size(); ++i) {
+      packed[i] = (run * 1'000 + i * 7) & ((1 << kBitWidth) - 1);
+    }
+    appendVarint(((packed.size() / 8) << 1) | 1, encoded);
+    appendBitPacked(packed, kBitWidth, encoded);
+    expected.insert(expected.end(), packed.begin(), packed.end());
+  }
+  expected.resize(expected.size() - 5);
+
+  auto runs = parseRleBitPackedRuns(
+      encoded.data(),
+      encoded.size(),
+      kBitWidth,
+      expected.size(),
+      GpuDecoderStream::kMaxRunSize);
+  int32_t numValues = 0;
+  for (auto& run : runs) {
+    ASSERT_EQ(numValues, run.outputOffset);
+    ASSERT_LE(run.numValues, GpuDecoderStream::kMaxRunSize);
+    numValues += run.numValues;
+  }
+  ASSERT_EQ(expected.size(), numValues);
+
+  WaveBufferPtr inputBuffer;
+  WaveBufferPtr runsBuffer;
+  WaveBufferPtr resultBuffer;
+  auto* input = copyToDevice(encoded, inputBuffer);
+  auto* deviceRuns = copyToDevice(runs, runsBuffer);
+  auto* result = arena_->allocate<int32_t>(expected.size(), resultBuffer);
+  GpuDecoderStream stream;
+  stream.decodeRleBitPacked(
+      input, kBitWidth, deviceRuns, runs.size(), result);
+  stream.wait();
+  for (auto i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(expected[i], result[i]) << i;
+  }
+
+  // Decodes dictionary values with the decoded indices.
+  std::vector<int64_t> dictionary(1 << kBitWidth);
+  for (auto i = 0; i < dictionary.size(); ++i) {
+    dictionary[i] = i * 1'000'000'007LL;
+  }
+  WaveBufferPtr dictionaryBuffer;
+  WaveBufferPtr valuesBuffer;
+  auto* deviceDictionary = copyToDevice(dictionary, dictionaryBuffer);
+  auto* values = arena_->allocate<int64_t>(expected.size(), valuesBuffer);
+  stream.gatherDictionary(deviceDictionary, result, expected.size(), values);
+  stream.wait();
+  for (auto i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(dictionary[expected[i]], values[i]) << i;
+  }
+}
+
+TEST_F(GpuDecoderTest, truncatedRuns) {
+  std::vector<uint8_t> encoded;
+  appendVarint(10 << 1, encoded);
+  VELOX_ASSERT_THROW(
+      parseRleBitPackedRuns(encoded.data(), encoded.size(), 8, 10, 100),
+      "Truncated RLE run");
+  encoded.clear();
+  appendVarint((2 << 1) | 1, encoded);
+  encoded.push_back(0);
+  VELOX_ASSERT_THROW(
+      parseRleBitPackedRuns(encoded.data(), encoded.size(), 8, 16, 100),
+      "Truncated bit-packed run");
+}
@@ -59,6 +59,49 @@ int sizeOf() {
 
 } // namespace
 
+// static
+bool Aggregation::canTranslate(
+    const core::AggregationNode& node,
+    const aggregation::AggregateFunctionRegistry& registry) {
+  const auto step = node.step();
+  if ((step != core::AggregationNode::Step::kSingle &&
+       step != core::AggregationNode::Step::kPartial) ||
+      !node.preGroupedKeys().empty()) {
+    return false;
+  }
+  auto& inputType = node.sources()[0]->outputType();
+  for (auto& key : node.groupingKeys()) {
+    const auto kind = inputType->findChild(key->name())->kind();
+    if (kind != TypeKind::INTEGER && kind != TypeKind::BIGINT &&
+        kind != TypeKind::VARCHAR) {
+      return false;
+    }
+  }
+  for (auto& aggregate : node.aggregates()) {
+    if (aggregate.mask || aggregate.distinct ||
+        !aggregate.sortingKeys.empty()) {
+      return false;
+    }
+    const auto& name = aggregate.call->name();
+    if (step == core::AggregationNode::Step::kPartial && name != "count" &&
+        name != "sum") {
+      return false;
+    }
+    std::vector<PhysicalType> argTypes;
+    for (auto& arg : aggregate.call->inputs()) {
+      auto* field = dynamic_cast<const core::FieldAccessTypedExpr*>(arg.get());
+      if (field == nullptr || !arg->type()->isPrimitiveType()) {
+        return false;
+      }
+      argTypes.push_back(fromCpuType(*arg->type()));
+    }
+    if (registry.getFunction(name, argTypes) == nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void Aggregation::toAggregateInfo(
     const TypePtr& inputType,
     const core::AggregationNode::Aggregate& aggregate,
@@ -83,7 +126,9 @@ Aggregation::Aggregation(
     : WaveOperator(state, node.outputType()),
       arena_(&state.arena()),
       functionRegistry_(functionRegistry) {
-  VELOX_CHECK_EQ(node.step(), core::AggregationNode::Step::kSingle);
+  VELOX_CHECK(
+      node.step() == core::AggregationNode::Step::kSingle ||
+      node.step() == core::AggregationNode::Step::kPartial);
   VELOX_CHECK(node.preGroupedKeys().empty());
   auto& inputType = node.sources()[0]->outputType();
   container_ = arena_->allocate<aggregation::GroupsContainer>(
@@ -32,6 +32,15 @@ class Aggregation : public WaveOperator {
 
   ~Aggregation() override;
 
+  /// Returns true if 'node' can run on the device: a single or partial
+  /// aggregation without masks, sorting or distinct, grouped by INTEGER,
+  /// BIGINT or VARCHAR columns, with functions in 'registry'. A partial
+  /// aggregation is only supported with functions whose intermediate result
+  /// is the final result, since the device produces final results.
+  static bool canTranslate(
+      const core::AggregationNode& node,
+      const aggregation::AggregateFunctionRegistry& registry);
+
   bool isStreaming() const override {
     return false;
   }
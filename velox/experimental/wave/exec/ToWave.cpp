@@ -24,6 +24,10 @@
 #include "velox/expression/FieldReference.h"
 
 DEFINE_int64(velox_wave_arena_unit_size, 1 << 30, "Per Driver GPU memory size");
+DEFINE_int64(
+    velox_wave_host_arena_unit_size,
+    64 << 20,
+    "Per Driver pinned host memory size for staging transfers to the GPU");
 
 namespace facebook::velox::wave {
 
@@ -124,6 +128,39 @@ std::optional<OpCode> binaryOpCode(const Expr& expr) {
   return std::nullopt;
 }
 
+// True if 'expr' consists of field references and binary operations on
+// BIGINT that the device kernels implement.
+bool isSupportedExpr(const Expr& expr) {
+  if (isField(expr)) {
+    return true;
+  }
+  if (!binaryOpCode(expr).has_value() || expr.inputs().size() != 2 ||
+      expr.type()->kind() != TypeKind::BIGINT) {
+    return false;
+  }
+  for (auto& input : expr.inputs()) {
+    if (!isSupportedExpr(*input)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// True if 'op' is a FilterProject that can run on the device. Filters are
+// left to the CPU operator.
+bool canTranslateFilterProject(exec::Operator* op) {
+  auto data = reinterpret_cast<exec::FilterProject*>(op)->exprsAndProjection();
+  if (data.hasFilter) {
+    return false;
+  }
+  for (auto& expr : data.exprs->exprs()) {
+    if (!isSupportedExpr(*expr)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 Program* CompileState::newProgram() {
   auto program = std::make_shared<Program>();
   allPrograms_.push_back(program);
@@ -310,19 +347,20 @@ bool CompileState::addOperator(
             driverFactory_.planNodes[nodeIndex].get())));
     outputType = driverFactory_.planNodes[nodeIndex]->outputType();
   } else if (name == "FilterProject") {
-    if (!reserveMemory()) {
+    if (!canTranslateFilterProject(op) || !reserveMemory()) {
       return false;
     }
 
     outputType = driverFactory_.planNodes[nodeIndex]->outputType();
     addFilterProject(op, outputType, nodeIndex);
   } else if (name == "Aggregation") {
-    if (!reserveMemory()) {
-      return false;
-    }
     auto* node = dynamic_cast<const core::AggregationNode*>(
         driverFactory_.planNodes[nodeIndex].get());
     VELOX_CHECK_NOT_NULL(node);
+    if (!Aggregation::canTranslate(*node, *aggregateFunctionRegistry()) ||
+        !reserveMemory()) {
+      return false;
+    }
     operators_.push_back(std::make_unique<Aggregation>(
         *this, *node, aggregateFunctionRegistry()));
     outputType = node->outputType();
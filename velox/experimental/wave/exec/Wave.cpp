@@ -15,6 +15,7 @@
  */
 
 #include "velox/experimental/wave/exec/Wave.h"
+#include "velox/common/base/BitUtil.h"
 #include "velox/experimental/wave/exec/Vectors.h"
 
 namespace facebook::velox::wave {
@@ -113,6 +114,28 @@ void copyData(std::vector<Transfer>& transfers) {
     ::memcpy(transfer.to, transfer.from, transfer.size);
   }
 }
+
+// Copies all of 'transfers' into one pinned staging buffer from 'arena' at
+// 8 byte aligned offsets. Returns the buffer and sets 'offsets' to the start
+// of each transfer. Pinned memory is copied by DMA without the driver
+// staging it, and one contiguous source keeps the copies large.
+WaveBufferPtr stageTransfers(
+    const std::vector<Transfer>& transfers,
+    GpuArena& arena,
+    std::vector<uint64_t>& offsets) {
+  uint64_t size = 0;
+  offsets.reserve(transfers.size());
+  for (auto& transfer : transfers) {
+    offsets.push_back(size);
+    size += bits::roundUp(transfer.size, 8);
+  }
+  auto staging = arena.allocateBytes(std::max<uint64_t>(size, 8));
+  auto* data = staging->as<char>();
+  for (auto i = 0; i < transfers.size(); ++i) {
+    ::memcpy(data + offsets[i], transfers[i].from, transfers[i].size);
+  }
+  return staging;
+}
 } // namespace
 
 void Executable::startTransfer(
@@ -128,6 +151,23 @@ void Executable::startTransfer(
   exe->deviceData.push_back(operands);
   exe->operands = operands->as<Operand>();
   exe->outputOperands = outputOperands;
+  if (auto* hostArena = waveStream.hostArena()) {
+    std::vector<uint64_t> offsets;
+    auto staging = stageTransfers(exe->transfers, *hostArena, offsets);
+    auto* data = staging->as<char>();
+    exe->deviceData.push_back(std::move(staging));
+    waveStream.installExecutables(
+        folly::Range(&exe, 1),
+        [&](Stream* stream, folly::Range<Executable**> executables) {
+          auto& transfers = executables[0]->transfers;
+          for (auto i = 0; i < transfers.size(); ++i) {
+            stream->hostToDeviceAsync(
+                transfers[i].to, data + offsets[i], transfers[i].size);
+          }
+          waveStream.markLaunch(*stream, *executables[0]);
+        });
+    return;
+  }
   copyData(exe->transfers);
   auto* device = waveStream.device();
   waveStream.installExecutables(
@@ -242,7 +242,10 @@ struct LaunchControl;
 /// Represents consecutive data dependent kernel launches.
 class WaveStream {
  public:
-  WaveStream(GpuArena& arena) : arena_(arena) {}
+  /// 'hostArena' is pinned host memory for staging transfers to the device.
+  /// If nullptr, transfers go through unified memory.
+  WaveStream(GpuArena& arena, GpuArena* hostArena = nullptr)
+      : arena_(arena), hostArena_(hostArena) {}
 
   ~WaveStream();
 
@@ -257,6 +260,10 @@ class WaveStream {
     return arena_;
   }
 
+  GpuArena* hostArena() {
+    return hostArena_;
+  }
+
   Executable* operandExecutable(OperandId id) {
     auto it = operandToExecutable_.find(id);
     if (it == operandToExecutable_.end()) {
@@ -351,6 +358,7 @@ class WaveStream {
   static void clearReusable();
 
   GpuArena& arena_;
+  GpuArena* const hostArena_;
   folly::F14FastMap<OperandId, Executable*> operandToExecutable_;
   std::vector<std::unique_ptr<Executable>> executables_;
 
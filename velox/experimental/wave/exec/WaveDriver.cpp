@@ -18,6 +18,8 @@
 #include "velox/experimental/wave/exec/Instruction.h"
 #include "velox/experimental/wave/exec/WaveOperator.h"
 
+DECLARE_int64(velox_wave_host_arena_unit_size);
+
 namespace facebook::velox::wave {
 
 WaveDriver::WaveDriver(
@@ -37,6 +39,9 @@ WaveDriver::WaveDriver(
           planNodeId,
           "Wave"),
       arena_(std::move(arena)),
+      hostArena_(std::make_unique<GpuArena>(
+          FLAGS_velox_wave_host_arena_unit_size,
+          getHostAllocator(getDevice()))),
       resultOrder_(std::move(resultOrder)),
       subfields_(std::move(subfields)),
       operands_(std::move(operands)) {
@@ -150,7 +155,7 @@ void WaveDriver::startMore() {
     auto& ops = pipelines_[i].operators;
     if (auto rows = ops[0]->canAdvance()) {
       VLOG(1) << "Advance " << rows << " rows in pipeline " << i;
-      auto stream = std::make_unique<WaveStream>(*arena_);
+      auto stream = std::make_unique<WaveStream>(*arena_, hostArena_.get());
       for (auto& op : ops) {
         op->schedule(*stream, rows);
       }
@@ -92,6 +92,9 @@ class WaveDriver : public exec::SourceOperator {
 
   std::unique_ptr<GpuArena> arena_;
 
+  // Pinned host memory for staging the data transferred to the device.
+  std::unique_ptr<GpuArena> hostArena_;
+
   ContinueFuture blockingFuture_{ContinueFuture::makeEmpty()};
   exec::BlockingReason blockingReason_;
 
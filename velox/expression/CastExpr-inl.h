@@ -21,6 +21,7 @@
 #include "velox/core/CoreTypeSystem.h"
 #include "velox/expression/StringWriter.h"
 #include "velox/external/date/tz.h"
+#include "velox/type/FastConversions.h"
 #include "velox/type/Type.h"
 #include "velox/vector/SelectivityVector.h"
 
@@ -232,6 +233,35 @@ void CastExpr::applyCastKernel(
   }
 }
 
+template <TypeKind ToKind>
+const SelectivityVector* CastExpr::applyFastStringCast(
+    const SelectivityVector& rows,
+    const SimpleVector<StringView>* input,
+    FlatVector<typename TypeTraits<ToKind>::NativeType>* result,
+    LocalSelectivityVector& remainingRows) {
+  auto* remaining = remainingRows.get(rows);
+  rows.applyToSelected([&](auto row) {
+    const auto string = input->valueAt(row);
+    typename TypeTraits<ToKind>::NativeType value;
+    bool converted;
+    if constexpr (ToKind == TypeKind::DOUBLE) {
+      converted = util::tryFastParseDouble(string.data(), string.size(), value);
+    } else if constexpr (ToKind == TypeKind::TIMESTAMP) {
+      converted =
+          util::tryFastParseTimestamp(string.data(), string.size(), value);
+    } else {
+      converted =
+          util::tryFastParseInteger(string.data(), string.size(), value);
+    }
+    if (converted) {
+      result->set(row, value);
+      remaining->setValid(row, false);
+    }
+  });
+  remaining->updateBounds();
+  return remaining;
+}
+
 template <typename TInput, typename TOutput>
 void CastExpr::applyDecimalCastKernel(
     const SelectivityVector& rows,
@@ -499,8 +529,21 @@ void CastExpr::applyCastPrimitives(
     }
   };
 
+  // Strictly formatted strings are converted in a batch without exceptions.
+  // The other rows and the errors are left to the per-row kernel.
+  const SelectivityVector* kernelRows = &rows;
+  LocalSelectivityVector remainingRows(context);
+  if constexpr (
+      FromKind == TypeKind::VARCHAR &&
+      (ToKind == TypeKind::TINYINT || ToKind == TypeKind::SMALLINT ||
+       ToKind == TypeKind::INTEGER || ToKind == TypeKind::BIGINT ||
+       ToKind == TypeKind::DOUBLE || ToKind == TypeKind::TIMESTAMP)) {
+    kernelRows = applyFastStringCast<ToKind>(
+        rows, inputSimpleVector, resultFlatVector, remainingRows);
+  }
+
   if (!queryConfig.isCastToIntByTruncate()) {
-    applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
+    applyToSelectedNoThrowLocal(context, *kernelRows, result, [&](int row) {
       try {
         applyCastKernel<ToKind, FromKind, false /*truncate*/>(
             row, context, inputSimpleVector, resultFlatVector);
@@ -516,7 +559,7 @@ void CastExpr::applyCastPrimitives(
     });
 
   } else {
-    applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
+    applyToSelectedNoThrowLocal(context, *kernelRows, result, [&](int row) {
       try {
         applyCastKernel<ToKind, FromKind, true /*truncate*/>(
             row, context, inputSimpleVector, resultFlatVector);
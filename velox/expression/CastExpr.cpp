@@ -105,7 +105,20 @@ VectorPtr CastExpr::castToDate(
       auto* inputVector = input.as<SimpleVector<StringView>>();
       const auto& queryConfig = context.execCtx()->queryCtx()->queryConfig();
       auto isIso8601 = queryConfig.isIso8601();
-      applyToSelectedNoThrowLocal(context, rows, castResult, [&](int row) {
+      // "YYYY-MM-DD" is converted in a batch, the other formats and the
+      // errors go through castFromDateString().
+      LocalSelectivityVector otherRows(context, rows);
+      auto* others = otherRows.get();
+      auto* rawResults = resultFlatVector->mutableRawValues();
+      rows.applyToSelected([&](auto row) {
+        const auto value = inputVector->valueAt(row);
+        if (util::tryFastParseDate(
+                value.data(), value.size(), rawResults[row])) {
+          others->setValid(row, false);
+        }
+      });
+      others->updateBounds();
+      applyToSelectedNoThrowLocal(context, *others, castResult, [&](int row) {
         try {
           auto inputString = inputVector->valueAt(row);
           resultFlatVector->set(
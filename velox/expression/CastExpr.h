@@ -182,6 +182,17 @@ class CastExpr : public SpecialForm {
       const SimpleVector<typename TypeTraits<FromKind>::NativeType>* input,
       FlatVector<typename TypeTraits<ToKind>::NativeType>* result);
 
+  /// Converts the strings in 'rows' that are in the fast formats of
+  /// FastConversions.h. Returns the rows that were not converted, which must
+  /// go through applyCastKernel. Errors are raised only from there, so TRY
+  /// and error messages are unchanged.
+  template <TypeKind ToKind>
+  const SelectivityVector* applyFastStringCast(
+      const SelectivityVector& rows,
+      const SimpleVector<StringView>* input,
+      FlatVector<typename TypeTraits<ToKind>::NativeType>* result,
+      LocalSelectivityVector& remainingRows);
+
   VectorPtr castFromDate(
       const SelectivityVector& rows,
       const BaseVector& input,
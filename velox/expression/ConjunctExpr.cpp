@@ -97,6 +97,16 @@ void ConjunctExpr::evalSpecialForm(
     const SelectivityVector& rows,
     EvalCtx& context,
     VectorPtr& result) {
+  auto* queryCtx = context.execCtx()->queryCtx();
+  if (!reorderEnabledChecked_) {
+    reorderEnabled_ =
+        queryCtx->queryConfig().adaptiveFilterReorderingEnabled();
+    reorderEnabledChecked_ = true;
+    if (reorderEnabled_) {
+      seedFromHistory(*queryCtx);
+    }
+  }
+
   // TODO Revisit error handling
   bool throwOnError = *context.mutableThrowOnError();
   ScopedVarSetter saveError(context.mutableThrowOnError(), false);
@@ -156,21 +166,45 @@ void ConjunctExpr::evalSpecialForm(
     selectivity_[inputOrder_[i]].addOutput(numActive);
 
     if (!numActive) {
+      if (i < inputs_.size() - 1) {
+        ++numShortCircuits_;
+      }
       break;
     }
   }
   // Clear errors for 'rows' that are not in 'activeRows'.
   finalizeErrors(rows, *activeRows, throwOnError, context);
-  if (!reorderEnabledChecked_) {
-    reorderEnabled_ = context.execCtx()
-                          ->queryCtx()
-                          ->queryConfig()
-                          .adaptiveFilterReorderingEnabled();
-    reorderEnabledChecked_ = true;
-  }
   if (reorderEnabled_) {
     maybeReorderInputs();
+    maybePublishHistory(*queryCtx);
+  }
+}
+
+void ConjunctExpr::seedFromHistory(core::QueryCtx& queryCtx) {
+  historyKey_ = toString();
+  auto history = queryCtx.conjunctHistory(historyKey_);
+  if (history.size() == inputs_.size()) {
+    selectivity_ = std::move(history);
+    maybeReorderInputs();
+  }
+  published_ = selectivity_;
+}
+
+void ConjunctExpr::maybePublishHistory(core::QueryCtx& queryCtx) {
+  // Publishes after 1, 2, 4 ... 64 batches and then every 64 batches, so
+  // that the drivers that start later benefit early on without contending
+  // on the history for every batch.
+  constexpr uint64_t kPublishInterval = 64;
+  ++numEvals_;
+  if ((numEvals_ & (numEvals_ - 1)) != 0 && numEvals_ % kPublishInterval) {
+    return;
+  }
+  std::vector<SelectivityInfo> delta(selectivity_.size());
+  for (auto i = 0; i < selectivity_.size(); ++i) {
+    delta[i] = selectivity_[i].since(published_[i]);
   }
+  queryCtx.addConjunctHistory(historyKey_, delta);
+  published_ = selectivity_;
 }
 
 void ConjunctExpr::maybeReorderInputs() {
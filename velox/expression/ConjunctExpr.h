@@ -64,6 +64,12 @@ class ConjunctExpr : public SpecialForm {
     return selectivity_[inputOrder_[index]];
   }
 
+  /// Returns the number of evaluations where no rows were left before the
+  /// last input, so that at least one input was not evaluated.
+  uint64_t numShortCircuits() const {
+    return numShortCircuits_;
+  }
+
   std::string toSql(
       std::vector<VectorPtr>* complexConstants = nullptr) const override;
 
@@ -76,6 +82,14 @@ class ConjunctExpr : public SpecialForm {
 
   void maybeReorderInputs();
 
+  // Initializes 'selectivity_' and 'inputOrder_' from what the other drivers
+  // and splits of the query have learned about 'this'.
+  void seedFromHistory(core::QueryCtx& queryCtx);
+
+  // Adds the rows and time gathered since the last call to the history of
+  // the query. Called after each batch, publishes at decreasing frequency.
+  void maybePublishHistory(core::QueryCtx& queryCtx);
+
   void updateResult(
       BaseVector* inputResult,
       EvalCtx& context,
@@ -94,6 +108,12 @@ class ConjunctExpr : public SpecialForm {
   bool reorderEnabled_;
   std::vector<SelectivityInfo> selectivity_;
   std::vector<int32_t> inputOrder_;
+  // Key of 'this' in the conjunct history of the QueryCtx.
+  std::string historyKey_;
+  // 'selectivity_' at the last publish to the history.
+  std::vector<SelectivityInfo> published_;
+  uint64_t numEvals_{0};
+  uint64_t numShortCircuits_{0};
 
   friend class ConjunctCallToSpecialForm;
 };
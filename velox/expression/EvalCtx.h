@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
 #include <functional>
 
 #include "velox/common/base/Portability.h"
@@ -237,6 +238,15 @@ class EvalCtx {
     return execCtx_;
   }
 
+  /// Returns uninitialized scratch space for 'count' values of type T. The
+  /// space is released in bulk after the top level ExprSet::eval() returns,
+  /// so it must only be used for temporaries of the current batch. See
+  /// core::ExecCtx::allocateScratch().
+  template <typename T>
+  T* FOLLY_NONNULL allocateScratch(uint64_t count) const {
+    return execCtx_->allocateScratch<T>(count);
+  }
+
   ExprSet* FOLLY_NULLABLE exprSet() const {
     return exprSet_;
   }
@@ -327,6 +337,29 @@ class EvalCtx {
     return cacheEnabled_;
   }
 
+  /// State that functions keep for an input vector while the current batch
+  /// is evaluated, so that calls with the same input in different
+  /// expressions share work, e.g. subscripts of the same map share an index
+  /// of its keys. 'vector' keeps the input alive and unchanged while 'state'
+  /// refers to it. Currently only used by map subscripts, which own the type
+  /// of 'state'.
+  struct FunctionInputState {
+    VectorPtr vector;
+    // Number of times functionInputState() returned this for the vector.
+    int32_t numUses{0};
+    std::shared_ptr<void> state;
+  };
+
+  /// Returns the state for 'vector'. The state is empty on first use.
+  FunctionInputState& functionInputState(const VectorPtr& vector) {
+    auto& entry = functionInputStates_[vector.get()];
+    if (entry.vector == nullptr) {
+      entry.vector = vector;
+    }
+    ++entry.numUses;
+    return entry;
+  }
+
  private:
   core::ExecCtx* const FOLLY_NONNULL execCtx_;
   ExprSet* FOLLY_NULLABLE const exprSet_;
@@ -359,6 +392,10 @@ class EvalCtx {
   // in a opaque flat vector, which will translate to a
   // std::shared_ptr<std::exception_ptr>.
   ErrorVectorPtr errors_;
+
+  // See functionInputState().
+  folly::F14FastMap<const BaseVector*, FunctionInputState>
+      functionInputStates_;
 };
 
 /// Utility wrapper struct that is used to temporarily reset the value of the an
@@ -1011,6 +1011,21 @@ Expr::PeelEncodingsResult Expr::peelEncodings(
   return {newRows, finalRowsHolder.get(), mayCache};
 }
 
+bool Expr::shouldEvaluatePeeled(
+    vector_size_t numRows,
+    const SelectivityVector& innerRows,
+    bool mayCache) {
+  const auto numInnerRows = innerRows.countSelected();
+  if (mayCache || numInnerRows < numRows ||
+      innerRows.size() <= kMaxPeeledBaseRowsPerRow * numRows) {
+    ++stats_.numPeeledVectors;
+    stats_.numPeelSavedRows += numRows - numInnerRows;
+    return true;
+  }
+  ++stats_.numPeelsSkipped;
+  return false;
+}
+
 void Expr::evalEncodings(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -1040,7 +1055,11 @@ void Expr::evalEncodings(
             newRowsHolder,
             finalRowsHolder);
         auto* newRows = peelEncodingsResult.newRows;
-        if (newRows) {
+        if (newRows &&
+            shouldEvaluatePeeled(
+                rows.countSelected(),
+                *newRows,
+                peelEncodingsResult.mayCache)) {
           VectorPtr peeledResult;
           // peelEncodings() can potentially produce an empty selectivity vector
           // if all selected values we are waiting for are nulls. So, here we
@@ -1143,6 +1162,56 @@ void Expr::evalWithNulls(
   evalAll(rows, context, result);
 }
 
+Expr::Memo&
+Expr::findOrAddMemo(const VectorPtr& base, EvalCtx& context, bool& found) {
+  for (auto& memo : memos_) {
+    if (memo.baseDictionary == base) {
+      found = true;
+      memo.lastUse = numCachableInput_;
+      return memo;
+    }
+  }
+  found = false;
+  if (memos_.size() >= kMaxMemos) {
+    auto lru = std::min_element(
+        memos_.begin(), memos_.end(), [](const auto& left, const auto& right) {
+          return left.lastUse < right.lastUse;
+        });
+    context.releaseVector(lru->baseDictionary);
+    context.releaseVector(lru->dictionaryCache);
+    memos_.erase(lru);
+  }
+  auto& memo = memos_.emplace_back();
+  memo.lastUse = numCachableInput_;
+  return memo;
+}
+
+void Expr::enforceMemoLimit(EvalCtx& context) {
+  auto* queryCtx = context.execCtx()->queryCtx();
+  if (queryCtx == nullptr) {
+    return;
+  }
+  const auto maxBytes = queryCtx->queryConfig().exprMaxMemoBytes();
+  uint64_t totalBytes = 0;
+  for (const auto& memo : memos_) {
+    if (memo.dictionaryCache != nullptr) {
+      totalBytes += memo.dictionaryCache->retainedSize();
+    }
+  }
+  while (totalBytes > maxBytes && !memos_.empty()) {
+    auto lru = std::min_element(
+        memos_.begin(), memos_.end(), [](const auto& left, const auto& right) {
+          return left.lastUse < right.lastUse;
+        });
+    if (lru->dictionaryCache != nullptr) {
+      totalBytes -= lru->dictionaryCache->retainedSize();
+    }
+    context.releaseVector(lru->baseDictionary);
+    context.releaseVector(lru->dictionaryCache);
+    memos_.erase(lru);
+  }
+}
+
 void Expr::evalWithMemo(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -1150,23 +1219,25 @@ void Expr::evalWithMemo(
   VectorPtr base;
   distinctFields_[0]->evalSpecialForm(rows, context, base);
   ++numCachableInput_;
-  if (baseDictionary_ == base) {
+  bool found;
+  auto& memo = findOrAddMemo(base, context, found);
+  if (found) {
     ++numCacheableRepeats_;
-    if (cachedDictionaryIndices_) {
+    if (memo.cachedDictionaryIndices) {
       LocalSelectivityVector cachedHolder(context, rows);
       auto cached = cachedHolder.get();
       VELOX_DCHECK(cached != nullptr);
-      cached->intersect(*cachedDictionaryIndices_);
+      cached->intersect(*memo.cachedDictionaryIndices);
       if (cached->hasSelections()) {
         context.ensureWritable(rows, type(), result);
-        result->copy(dictionaryCache_.get(), *cached, nullptr);
+        result->copy(memo.dictionaryCache.get(), *cached, nullptr);
       }
     }
     LocalSelectivityVector uncachedHolder(context, rows);
     auto uncached = uncachedHolder.get();
     VELOX_DCHECK(uncached != nullptr);
-    if (cachedDictionaryIndices_) {
-      uncached->deselect(*cachedDictionaryIndices_);
+    if (memo.cachedDictionaryIndices) {
+      uncached->deselect(*memo.cachedDictionaryIndices);
     }
     if (uncached->hasSelections()) {
       // Fix finalSelection at "rows" if uncached rows is a strict subset to
@@ -1180,44 +1251,46 @@ void Expr::evalWithMemo(
       context.exprSet()->addToMemo(this);
       auto newCacheSize = uncached->end();
 
-      // dictionaryCache_ is valid only for cachedDictionaryIndices_. Hence, a
+      // dictionaryCache is valid only for cachedDictionaryIndices. Hence, a
       // safe call to BaseVector::ensureWritable must include all the rows not
-      // covered by cachedDictionaryIndices_. If BaseVector::ensureWritable is
+      // covered by cachedDictionaryIndices. If BaseVector::ensureWritable is
       // called only for a subset of rows not covered by
-      // cachedDictionaryIndices_, it will attempt to copy rows that are not
+      // cachedDictionaryIndices, it will attempt to copy rows that are not
       // valid leading to a crash.
-      LocalSelectivityVector allUncached(context, dictionaryCache_->size());
+      LocalSelectivityVector allUncached(
+          context, memo.dictionaryCache->size());
       allUncached.get()->setAll();
-      allUncached.get()->deselect(*cachedDictionaryIndices_);
-      context.ensureWritable(*allUncached.get(), type(), dictionaryCache_);
+      allUncached.get()->deselect(*memo.cachedDictionaryIndices);
+      context.ensureWritable(
+          *allUncached.get(), type(), memo.dictionaryCache);
 
-      if (cachedDictionaryIndices_->size() < newCacheSize) {
-        cachedDictionaryIndices_->resize(newCacheSize, false);
+      if (memo.cachedDictionaryIndices->size() < newCacheSize) {
+        memo.cachedDictionaryIndices->resize(newCacheSize, false);
       }
 
-      cachedDictionaryIndices_->select(*uncached);
+      memo.cachedDictionaryIndices->select(*uncached);
 
-      // Resize the dictionaryCache_ to accommodate all the necessary rows.
-      if (dictionaryCache_->size() < uncached->end()) {
-        dictionaryCache_->resize(uncached->end());
+      // Resize the dictionaryCache to accommodate all the necessary rows.
+      if (memo.dictionaryCache->size() < uncached->end()) {
+        memo.dictionaryCache->resize(uncached->end());
       }
-      dictionaryCache_->copy(result.get(), *uncached, nullptr);
+      memo.dictionaryCache->copy(result.get(), *uncached, nullptr);
+      enforceMemoLimit(context);
     }
     context.releaseVector(base);
     return;
   }
-  context.releaseVector(baseDictionary_);
-  baseDictionary_ = base;
+  memo.baseDictionary = base;
   evalWithNulls(rows, context, result);
 
-  context.releaseVector(dictionaryCache_);
-  dictionaryCache_ = result;
-  if (!cachedDictionaryIndices_) {
-    cachedDictionaryIndices_ =
+  memo.dictionaryCache = result;
+  if (!memo.cachedDictionaryIndices) {
+    memo.cachedDictionaryIndices =
         context.execCtx()->getSelectivityVector(rows.end());
   }
-  *cachedDictionaryIndices_ = rows;
-  context.deselectErrors(*cachedDictionaryIndices_);
+  *memo.cachedDictionaryIndices = rows;
+  context.deselectErrors(*memo.cachedDictionaryIndices);
+  enforceMemoLimit(context);
 }
 
 void Expr::setAllNulls(
@@ -1432,14 +1505,17 @@ bool Expr::applyFunctionWithPeeling(
   if (!peeledEncoding) {
     return false;
   }
-  inputValues_ = std::move(peeledVectors);
-  peeledVectors.clear();
 
   // Translate the relevant rows.
   // Note: We do not need to translate final selection since at this stage those
   // rows are not used but isFinalSelection() is only used to check whether
   // pre-existing rows need to be preserved.
   auto newRows = peeledEncoding->translateToInnerRows(applyRows, newRowsHolder);
+  if (!shouldEvaluatePeeled(applyRows.countSelected(), *newRows, false)) {
+    return false;
+  }
+  inputValues_ = std::move(peeledVectors);
+  peeledVectors.clear();
 
   // Save context and set the peel.
   context.saveAndReset(saver, applyRows);
@@ -1845,6 +1921,7 @@ void ExprSet::eval(
     const SelectivityVector& rows,
     EvalCtx& context,
     std::vector<VectorPtr>& result) {
+  core::ExecCtx::ScratchScope scratchScope(context.execCtx());
   result.resize(exprs_.size());
   if (initialize) {
     clearSharedSubexprs();
@@ -1906,6 +1983,7 @@ void ExprSetSimplified::eval(
     const SelectivityVector& rows,
     EvalCtx& context,
     std::vector<VectorPtr>& result) {
+  core::ExecCtx::ScratchScope scratchScope(context.execCtx());
   result.resize(exprs_.size());
   if (initialize) {
     clearSharedSubexprs();
@@ -59,18 +59,37 @@ struct ExprStats {
   /// size.
   uint64_t numProcessedVectors{0};
 
+  /// Number of batches evaluated on the base of a peeled dictionary or
+  /// constant and wrapped afterwards.
+  uint64_t numPeeledVectors{0};
+
+  /// Number of rows not evaluated because a peeled dictionary maps them to
+  /// the same base rows as other rows.
+  uint64_t numPeelSavedRows{0};
+
+  /// Number of times peeling was skipped because the dictionary had no
+  /// repeated rows and its base was much larger than the selected rows.
+  uint64_t numPeelsSkipped{0};
+
   void add(const ExprStats& other) {
     timing.add(other.timing);
     numProcessedRows += other.numProcessedRows;
     numProcessedVectors += other.numProcessedVectors;
+    numPeeledVectors += other.numPeeledVectors;
+    numPeelSavedRows += other.numPeelSavedRows;
+    numPeelsSkipped += other.numPeelsSkipped;
   }
 
   std::string toString() const {
     return fmt::format(
-        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}",
+        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}, "
+        "numPeeledVectors: {}, numPeelSavedRows: {}, numPeelsSkipped: {}",
         timing.toString(),
         numProcessedRows,
-        numProcessedVectors);
+        numProcessedVectors,
+        numPeeledVectors,
+        numPeelSavedRows,
+        numPeelsSkipped);
   }
 };
 
@@ -244,9 +263,7 @@ class Expr {
   }
 
   void clearMemo() {
-    baseDictionary_ = nullptr;
-    dictionaryCache_ = nullptr;
-    cachedDictionaryIndices_ = nullptr;
+    memos_.clear();
   }
 
   const TypePtr& type() const {
@@ -404,6 +421,22 @@ class Expr {
       LocalSelectivityVector& newRowsHolder,
       LocalSelectivityVector& finalRowsHolder);
 
+  // Peeling is skipped if the wrapped base has more than this many rows per
+  // selected row and no row would be evaluated fewer times. The translation
+  // of rows and the results sized to the base would then cost more than
+  // evaluating through the dictionary.
+  static constexpr int32_t kMaxPeeledBaseRowsPerRow = 8;
+
+  // Returns true if the expression should be evaluated on the 'innerRows' of
+  // a peeled base instead of on the 'numRows' outer rows. 'mayCache' is true
+  // if the results for the base can be memoized across batches, in which case
+  // the expression is always evaluated on the base. Updates the peeling
+  // stats.
+  bool shouldEvaluatePeeled(
+      vector_size_t numRows,
+      const SelectivityVector& innerRows,
+      bool mayCache);
+
   void evalEncodings(
       const SelectivityVector& rows,
       EvalCtx& context,
@@ -585,14 +618,39 @@ class Expr {
   // evaluateSharedSubexpr() is called to the cached shared results.
   std::map<std::vector<const BaseVector*>, SharedResults> sharedSubexprResults_;
 
-  VectorPtr baseDictionary_;
+  // Maximum number of distinct dictionary bases for which results are kept
+  // across batches.
+  static constexpr int32_t kMaxMemos = 4;
+
+  // Results memoized for a dictionary base vector.
+  struct Memo {
+    VectorPtr baseDictionary;
+
+    // Values computed for the base dictionary, 1:1 to the positions in
+    // 'baseDictionary'.
+    VectorPtr dictionaryCache;
+
+    // The indices that are valid in 'dictionaryCache'.
+    std::unique_ptr<SelectivityVector> cachedDictionaryIndices;
+
+    // Value of 'numCachableInput_' when this was last used. The least
+    // recently used memo is evicted first.
+    int32_t lastUse{0};
+  };
+
+  // Returns the memo for 'base', making a new one if there is none. Evicts the
+  // least recently used memo if there are already kMaxMemos.
+  Memo& findOrAddMemo(const VectorPtr& base, EvalCtx& context, bool& found);
 
-  // Values computed for the base dictionary, 1:1 to the positions in
-  // 'baseDictionary_'.
-  VectorPtr dictionaryCache_;
+  // Evicts least recently used memos until the memoized values take at most
+  // QueryConfig::exprMaxMemoBytes(). May evict all memos, including the one
+  // just made. No-op outside of a query.
+  void enforceMemoLimit(EvalCtx& context);
 
-  // The indices that are valid in 'dictionaryCache_'.
-  std::unique_ptr<SelectivityVector> cachedDictionaryIndices_;
+  // Memoized results for the dictionary bases seen most recently. Kept across
+  // batches so that a base that repeats, e.g. the dictionary of a string
+  // column within a stripe, is evaluated once.
+  std::vector<Memo> memos_;
 
   // Count of executions where this is wrapped in a dictionary so that
   // results could be cached.
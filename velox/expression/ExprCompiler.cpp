@@ -347,6 +347,49 @@ std::vector<VectorPtr> getConstantInputs(const std::vector<ExprPtr>& exprs) {
   return constants;
 }
 
+// Simplifies an AND or OR with constant inputs. Drops the inputs that do not
+// affect the result, i.e. TRUE for AND and FALSE for OR. Returns the input
+// that decides the result for all rows if there is one, i.e. FALSE for AND
+// and TRUE for OR, or the only input that is left after dropping. Errors in
+// the other inputs are not raised in this case, which matches the evaluation
+// of AND and OR, where errors in rows that another input decides are
+// discarded. Otherwise removes the dropped inputs from 'inputs' and returns
+// nullptr.
+ExprPtr simplifyConjunct(
+    const std::string& name,
+    std::vector<ExprPtr>& inputs) {
+  if (name != kAnd && name != kOr) {
+    return nullptr;
+  }
+  const bool isAnd = name == kAnd;
+  std::vector<ExprPtr> remaining;
+  remaining.reserve(inputs.size());
+  for (const auto& input : inputs) {
+    if (auto constant = std::dynamic_pointer_cast<ConstantExpr>(input)) {
+      const auto& value = constant->value();
+      if (!value->isNullAt(0)) {
+        if (value->as<SimpleVector<bool>>()->valueAt(0) != isAnd) {
+          return input;
+        }
+        continue;
+      }
+    }
+    remaining.push_back(input);
+  }
+  if (remaining.size() == inputs.size()) {
+    return nullptr;
+  }
+  if (remaining.empty()) {
+    // All inputs are TRUE for AND or FALSE for OR.
+    return inputs[0];
+  }
+  if (remaining.size() == 1) {
+    return remaining[0];
+  }
+  inputs = std::move(remaining);
+  return nullptr;
+}
+
 core::TypedExprPtr rewriteExpression(const core::TypedExprPtr& expr) {
   for (auto& rewrite : expressionRewrites()) {
     if (auto rewritten = rewrite(expr)) {
@@ -403,7 +446,14 @@ ExprPtr compileRewrittenExpression(
           cast->nullOnFailure());
     }
   } else if (auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
-    if (auto specialForm = getSpecialForm(
+    if (auto simplified = enableConstantFolding
+            ? simplifyConjunct(call->name(), compiledInputs)
+            : nullptr) {
+      result = simplified;
+      isConstantExpr =
+          std::dynamic_pointer_cast<ConstantExpr>(simplified) != nullptr;
+    } else if (
+        auto specialForm = getSpecialForm(
             config,
             call->name(),
             resultType,
@@ -577,10 +627,22 @@ std::unordered_set<std::string> collectFlatteningCandidates(
 } // namespace
 
 std::vector<std::shared_ptr<Expr>> compileExpressions(
-    const std::vector<TypedExprPtr>& sources,
+    const std::vector<TypedExprPtr>& originalSources,
     core::ExecCtx* execCtx,
     ExprSet* exprSet,
     bool enableConstantFolding) {
+  // Owns the re-written expressions while they are compiled.
+  std::vector<TypedExprPtr> rewrittenSources;
+  for (auto& rewrite : expressionSetRewrites()) {
+    auto rewritten = rewrite(
+        rewrittenSources.empty() ? originalSources : rewrittenSources);
+    if (!rewritten.empty()) {
+      rewrittenSources = std::move(rewritten);
+    }
+  }
+  const auto& sources =
+      rewrittenSources.empty() ? originalSources : rewrittenSources;
+
   Scope scope({}, nullptr, exprSet);
   std::vector<std::shared_ptr<Expr>> exprs;
   exprs.reserve(sources.size());
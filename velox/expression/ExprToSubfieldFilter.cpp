@@ -93,6 +93,48 @@ bool toSubfield(const core::ITypedExpr* field, common::Subfield& subfield) {
   return true;
 }
 
+// Returns the input of 'expr' if 'expr' is a cast between integer types that
+// keeps all values, e.g. from INTEGER to BIGINT. A range of the cast values is
+// then the same range of the input values. Returns 'expr' otherwise.
+const core::ITypedExpr* skipWideningCast(const core::ITypedExpr* expr) {
+  auto integerSize = [](const TypePtr& type) -> int32_t {
+    if (*type == *TINYINT()) {
+      return 1;
+    }
+    if (*type == *SMALLINT()) {
+      return 2;
+    }
+    if (*type == *INTEGER()) {
+      return 4;
+    }
+    if (*type == *BIGINT()) {
+      return 8;
+    }
+    return 0;
+  };
+  auto* cast = dynamic_cast<const core::CastTypedExpr*>(expr);
+  if (!cast) {
+    return expr;
+  }
+  const auto& input = cast->inputs()[0];
+  const auto inputSize = integerSize(input->type());
+  if (inputSize > 0 && inputSize <= integerSize(cast->type())) {
+    return input.get();
+  }
+  return expr;
+}
+
+// Returns the TIMESTAMP input of 'expr' if 'expr' is CAST(<timestamp> AS
+// DATE) and nullptr otherwise.
+const core::ITypedExpr* asDateOfTimestamp(const core::ITypedExpr* expr) {
+  auto* cast = dynamic_cast<const core::CastTypedExpr*>(expr);
+  if (cast && cast->type()->isDate() &&
+      cast->inputs()[0]->type()->kind() == TypeKind::TIMESTAMP) {
+    return cast->inputs()[0].get();
+  }
+  return nullptr;
+}
+
 common::BigintRange* asBigintRange(std::unique_ptr<common::Filter>& filter) {
   return dynamic_cast<common::BigintRange*>(filter.get());
 }
@@ -111,9 +153,16 @@ std::unique_ptr<common::Filter> makeOrFilter(
     std::unique_ptr<common::Filter> a,
     std::unique_ptr<common::Filter> b) {
   if (asBigintRange(a) && asBigintRange(b)) {
-    return bigintOr(
-        asUniquePtr<common::BigintRange>(std::move(a)),
-        asUniquePtr<common::BigintRange>(std::move(b)));
+    if (asBigintRange(a)->lower() > asBigintRange(b)->lower()) {
+      std::swap(a, b);
+    }
+    // BigintMultiRange requires ordered ranges that do not overlap.
+    if (asBigintRange(a)->upper() < asBigintRange(b)->lower()) {
+      return bigintOr(
+          asUniquePtr<common::BigintRange>(std::move(a)),
+          asUniquePtr<common::BigintRange>(std::move(b)));
+    }
+    return orFilter(std::move(a), std::move(b));
   }
 
   if (asBigintRange(a) && asBigintMultiRange(b)) {
@@ -453,6 +502,159 @@ std::unique_ptr<common::Filter> makeBetweenFilter(
   }
 }
 
+// Converts 'column LIKE pattern' to a range of strings if 'pattern' is a
+// constant without wildcards other than a trailing '%', e.g. 'abc%' to
+// ['abc', 'abd'). Patterns with an escape are not converted.
+std::unique_ptr<common::Filter> makeLikeFilter(
+    const core::TypedExprPtr& patternExpr,
+    core::ExpressionEvaluator* evaluator) {
+  auto pattern = toConstant(patternExpr, evaluator);
+  if (!pattern || pattern->typeKind() != TypeKind::VARCHAR ||
+      pattern->isNullAt(0)) {
+    return nullptr;
+  }
+  std::string prefix = singleValue<StringView>(pattern);
+  const bool isPrefix = !prefix.empty() && prefix.back() == '%';
+  if (isPrefix) {
+    prefix.pop_back();
+  }
+  if (prefix.find_first_of("%_") != std::string::npos) {
+    return nullptr;
+  }
+  if (!isPrefix) {
+    return equal(prefix);
+  }
+  if (prefix.empty()) {
+    return isNotNull();
+  }
+  // The strings that start with 'prefix' are less than 'prefix' with its last
+  // byte incremented. Bytes that cannot be incremented are dropped.
+  auto upper = prefix;
+  while (!upper.empty() && static_cast<uint8_t>(upper.back()) == 0xFF) {
+    upper.pop_back();
+  }
+  if (upper.empty()) {
+    return greaterThanOrEqual(prefix);
+  }
+  upper.back() = static_cast<char>(static_cast<uint8_t>(upper.back()) + 1);
+  return std::make_unique<common::BytesRange>(
+      prefix, false, false, upper, false, true, false);
+}
+
+// Returns the first timestamp of 'day'. Evaluates CAST(<day> AS TIMESTAMP), so
+// that the session time zone applies like in the cast from TIMESTAMP to DATE.
+std::optional<Timestamp> startOfDay(
+    int32_t day,
+    core::ExpressionEvaluator* evaluator) {
+  auto value = toConstant(
+      std::make_shared<core::CastTypedExpr>(
+          TIMESTAMP(),
+          std::make_shared<core::ConstantTypedExpr>(DATE(), variant(day)),
+          false),
+      evaluator);
+  if (!value || value->isNullAt(0)) {
+    return std::nullopt;
+  }
+  return singleValue<Timestamp>(value);
+}
+
+// Converts a comparison of CAST(<timestamp> AS DATE) with DATE constants to a
+// range of timestamps, e.g. "cast(ts as date) = date '2023-01-01'" to the
+// timestamps from the start to the end of that day.
+std::unique_ptr<common::Filter> makeDateOfTimestampFilter(
+    const core::CallTypedExpr& call,
+    core::ExpressionEvaluator* evaluator,
+    bool negated) {
+  static const std::unordered_map<std::string, std::string> kNegations = {
+      {"lt", "gte"}, {"lte", "gt"}, {"gt", "lte"}, {"gte", "lt"}};
+  auto name = call.name();
+  if (negated) {
+    auto it = kNegations.find(name);
+    if (it == kNegations.end()) {
+      return nullptr;
+    }
+    name = it->second;
+  }
+  const auto numValues = name == "between" ? 2 : 1;
+  if (call.inputs().size() != numValues + 1) {
+    return nullptr;
+  }
+  std::vector<int32_t> days;
+  for (auto i = 1; i <= numValues; ++i) {
+    auto value = toConstant(call.inputs()[i], evaluator);
+    if (!value || !value->type()->isDate() || value->isNullAt(0)) {
+      return nullptr;
+    }
+    days.push_back(singleValue<int32_t>(value));
+  }
+  // The first timestamp after 'day'.
+  auto endOfDay = [&](int32_t day) { return startOfDay(day + 1, evaluator); };
+  std::optional<Timestamp> lower;
+  std::optional<Timestamp> upper;
+  if (name == "eq" || name == "between") {
+    lower = startOfDay(days[0], evaluator);
+    upper = endOfDay(days.back());
+  } else if (name == "lt") {
+    upper = startOfDay(days[0], evaluator);
+  } else if (name == "lte") {
+    upper = endOfDay(days[0]);
+  } else if (name == "gt") {
+    lower = endOfDay(days[0]);
+  } else if (name == "gte") {
+    lower = startOfDay(days[0], evaluator);
+  } else {
+    return nullptr;
+  }
+  if (lower.has_value() && upper.has_value()) {
+    --upper.value();
+    return between(lower.value(), upper.value());
+  }
+  if (upper.has_value()) {
+    return lessThan(upper.value());
+  }
+  if (lower.has_value()) {
+    return greaterThanOrEqual(lower.value());
+  }
+  return nullptr;
+}
+
+// Converts an OR of predicates on the same subfield that do not allow nulls,
+// e.g. "a < 10 OR a > 20".
+std::unique_ptr<common::Filter> makeOrCallFilter(
+    const core::CallTypedExpr& call,
+    common::Subfield& subfield,
+    core::ExpressionEvaluator* evaluator) {
+  std::unique_ptr<common::Filter> result;
+  for (const auto& input : call.inputs()) {
+    auto* inputCall = asCall(input.get());
+    if (!inputCall) {
+      return nullptr;
+    }
+    common::Subfield inputSubfield;
+    std::unique_ptr<common::Filter> filter;
+    if (inputCall->name() == "not") {
+      if (auto* inner = asCall(inputCall->inputs()[0].get())) {
+        filter =
+            leafCallToSubfieldFilter(*inner, inputSubfield, evaluator, true);
+      }
+    } else {
+      filter =
+          leafCallToSubfieldFilter(*inputCall, inputSubfield, evaluator, false);
+    }
+    if (!filter || filter->testNull() ||
+        (result && !(inputSubfield == subfield))) {
+      return nullptr;
+    }
+    if (result) {
+      result = makeOrFilter(std::move(result), std::move(filter));
+    } else {
+      subfield = std::move(inputSubfield);
+      result = std::move(filter);
+    }
+  }
+  return result;
+}
+
 } // namespace
 
 std::unique_ptr<common::Filter> leafCallToSubfieldFilter(
@@ -464,7 +666,18 @@ std::unique_ptr<common::Filter> leafCallToSubfieldFilter(
     return nullptr;
   }
 
-  const auto* leftSide = call.inputs()[0].get();
+  if (call.name() == "or") {
+    return negated ? nullptr : makeOrCallFilter(call, subfield, evaluator);
+  }
+
+  const auto* leftSide = skipWideningCast(call.inputs()[0].get());
+
+  if (auto* timestamp = asDateOfTimestamp(leftSide)) {
+    if (toSubfield(timestamp, subfield)) {
+      return makeDateOfTimestampFilter(call, evaluator, negated);
+    }
+    return nullptr;
+  }
 
   if (call.name() == "eq") {
     if (toSubfield(leftSide, subfield)) {
@@ -506,6 +719,11 @@ std::unique_ptr<common::Filter> leafCallToSubfieldFilter(
     if (toSubfield(leftSide, subfield)) {
       return makeInFilter(call.inputs()[1], evaluator, negated);
     }
+  } else if (call.name() == "like") {
+    if (call.inputs().size() == 2 && !negated &&
+        toSubfield(leftSide, subfield)) {
+      return makeLikeFilter(call.inputs()[1], evaluator);
+    }
   } else if (call.name() == "is_null") {
     if (toSubfield(leftSide, subfield)) {
       if (negated) {
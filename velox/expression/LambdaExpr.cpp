@@ -41,6 +41,25 @@ class ExprCallable : public Callable {
     return capture_->childrenSize() > signature_->size();
   }
 
+  std::optional<SimpleCall> simpleCall() const override {
+    if (hasCapture() || body_->isSpecialForm() || !body_->vectorFunction()) {
+      return std::nullopt;
+    }
+    SimpleCall call{body_->name(), {}};
+    for (const auto& input : body_->inputs()) {
+      auto* field = dynamic_cast<const FieldReference*>(input.get());
+      if (!field || !field->inputs().empty()) {
+        return std::nullopt;
+      }
+      auto index = signature_->getChildIdxIfExists(field->field());
+      if (!index.has_value()) {
+        return std::nullopt;
+      }
+      call.parameters.push_back(index.value());
+    }
+    return call;
+  }
+
   void apply(
       const SelectivityVector& rows,
       const SelectivityVector* validRowsInReusedResult,
@@ -109,7 +128,13 @@ class ExprCallable : public Callable {
     for (auto index = args.size(); index < capture_->childrenSize(); ++index) {
       auto values = capture_->childAt(index);
       VELOX_DCHECK(!isLazyNotLoaded(*values));
-      if (wrapCapture) {
+      if (values->isConstantEncoding()) {
+        // A constant stays constant for all elements. This avoids a
+        // dictionary and keeps the fast paths for constant arguments.
+        if (values->size() != size) {
+          values = BaseVector::wrapInConstant(size, 0, values);
+        }
+      } else if (wrapCapture) {
         values = BaseVector::wrapInDictionary(
             BufferPtr(nullptr), wrapCapture, size, values);
       }
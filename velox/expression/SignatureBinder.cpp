@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <boost/algorithm/string.hpp>
+#include <folly/hash/Hash.h>
 #include <optional>
 
 #include "velox/expression/SignatureBinder.h"
@@ -268,4 +269,31 @@ TypePtr SignatureBinder::tryResolveType(
       return nullptr;
   }
 }
+
+size_t ArgumentTypesHasher::operator()(
+    const std::vector<TypePtr>& argTypes) const {
+  size_t hash = argTypes.size();
+  for (const auto& type : argTypes) {
+    hash = folly::hash::hash_128_to_64(hash, type ? type->hashKind() : 0);
+  }
+  return hash;
+}
+
+bool ArgumentTypesComparer::operator()(
+    const std::vector<TypePtr>& left,
+    const std::vector<TypePtr>& right) const {
+  if (left.size() != right.size()) {
+    return false;
+  }
+  for (auto i = 0; i < left.size(); ++i) {
+    if (left[i] == nullptr || right[i] == nullptr) {
+      if (left[i] != right[i]) {
+        return false;
+      }
+    } else if (*left[i] != *right[i]) {
+      return false;
+    }
+  }
+  return true;
+}
 } // namespace facebook::velox::exec
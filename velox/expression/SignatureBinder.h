@@ -112,4 +112,17 @@ class SignatureBinder : private SignatureBinderBase {
  private:
   const std::vector<TypePtr>& actualTypes_;
 };
+
+/// Hash and equality of lists of argument types, used to memoize the results
+/// of binding signatures to argument types. Null types, e.g. of lambda inputs,
+/// are allowed.
+struct ArgumentTypesHasher {
+  size_t operator()(const std::vector<TypePtr>& argTypes) const;
+};
+
+struct ArgumentTypesComparer {
+  bool operator()(
+      const std::vector<TypePtr>& left,
+      const std::vector<TypePtr>& right) const;
+};
 } // namespace facebook::velox::exec
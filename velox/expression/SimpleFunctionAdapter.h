@@ -21,6 +21,7 @@
 #include <type_traits>
 
 #include "velox/common/base/Portability.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/ComplexWriterTypes.h"
 #include "velox/expression/DecodedArgs.h"
 #include "velox/expression/Expr.h"
@@ -440,6 +441,13 @@ class SimpleFunctionAdapter : public VectorFunction {
       const std::vector<VectorPtr>& rawArgs,
       TReader&... readers) const {
     if constexpr (POSITION == FUNC::num_args) {
+      if constexpr (FUNC::is_vectorizable && fastPathIteration) {
+        if (applyContext.rows->isAllSelected() &&
+            (!readers.mayHaveNulls() && ...)) {
+          iterateVectorized(applyContext, readers...);
+          return;
+        }
+      }
       iterate(applyContext, readers...);
     } else {
       auto& arg = rawArgs[POSITION];
@@ -668,6 +676,49 @@ class SimpleFunctionAdapter : public VectorFunction {
     }
   }
 
+  // Calls the function on all rows in a dense loop without per-row dispatch,
+  // null checks or exception handling, so that the compiler can vectorize the
+  // loop. Requires a vectorizable function, all rows selected and flat or
+  // constant inputs without nulls. Boolean results are computed as bytes for
+  // 64 rows at a time and packed into bits with SIMD.
+  template <typename... TReader>
+  void iterateVectorized(ApplyContext& applyContext, TReader&... readers)
+      const {
+    auto& fn = *fn_;
+    const auto end = applyContext.rows->end();
+    if constexpr (return_type_traits::typeKind == TypeKind::BOOLEAN) {
+      using Batch = xsimd::batch<uint8_t>;
+      auto* rawBits =
+          reinterpret_cast<uint64_t*>(applyContext.result->mutableRawValues());
+      bool bytes[64];
+      for (vector_size_t base = 0; base < end; base += 64) {
+        const auto numRows = std::min<vector_size_t>(64, end - base);
+        for (auto i = 0; i < numRows; ++i) {
+          fn.call(bytes[i], readers[base + i]...);
+        }
+        std::fill(bytes + numRows, bytes + 64, false);
+        uint64_t word = 0;
+        for (auto i = 0; i < 64; i += Batch::size) {
+          auto lanes =
+              Batch::load_unaligned(reinterpret_cast<uint8_t*>(bytes + i));
+          const uint32_t laneBits = simd::toBitMask(lanes != Batch(0));
+          word |= static_cast<uint64_t>(laneBits) << i;
+        }
+        if (numRows == 64) {
+          rawBits[base / 64] = word;
+        } else {
+          const auto mask = bits::lowMask(numRows);
+          rawBits[base / 64] = (rawBits[base / 64] & ~mask) | word;
+        }
+      }
+    } else {
+      auto* data = applyContext.resultWriter.data_;
+      for (vector_size_t row = 0; row < end; ++row) {
+        fn.call(data[row], readers[row]...);
+      }
+    }
+  }
+
   template <typename Func>
   void applyUdf(ApplyContext& applyContext, Func func) const {
     if constexpr (IsArrayWriter<T>::value || IsMapWriter<T>::value) {
@@ -42,6 +42,7 @@ void SimpleFunctionRegistry::registerFunctionInternal(
     SignatureMap& signatureMap = map[sanitizedName];
     signatureMap[*metadata->signature()] =
         std::make_unique<const FunctionEntry>(metadata, factory);
+    resolutions_.wlock()->clear();
   });
 }
 
@@ -76,6 +77,18 @@ std::optional<SimpleFunctionRegistry::ResolvedSimpleFunction>
 SimpleFunctionRegistry::resolveFunction(
     const std::string& name,
     const std::vector<TypePtr>& argTypes) const {
+  ResolutionKey key{name, argTypes};
+  {
+    auto resolutions = resolutions_.rlock();
+    auto it = resolutions->find(key);
+    if (it != resolutions->end()) {
+      if (it->second.entry == nullptr) {
+        return std::nullopt;
+      }
+      return ResolvedSimpleFunction(*it->second.entry, it->second.type);
+    }
+  }
+
   const FunctionEntry* selectedCandidate = nullptr;
   TypePtr selectedCandidateType = nullptr;
   registeredFunctions_.withRLock([&](const auto& map) {
@@ -93,6 +106,14 @@ SimpleFunctionRegistry::resolveFunction(
         }
       }
     }
+    // Insert while holding the read lock so that the entry cannot be
+    // replaced before it is cached.
+    auto resolutions = resolutions_.wlock();
+    if (resolutions->size() >= kMaxResolutions) {
+      resolutions->clear();
+    }
+    resolutions->emplace(
+        std::move(key), Resolution{selectedCandidate, selectedCandidateType});
   });
 
   VELOX_DCHECK(!selectedCandidate || selectedCandidateType);
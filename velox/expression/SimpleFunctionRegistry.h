@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
+#include <folly/hash/Hash.h>
+
 #include "velox/core/SimpleFunctionMetadata.h"
 #include "velox/expression/SignatureBinder.h"
 #include "velox/expression/SimpleFunctionAdapter.h"
@@ -85,7 +88,10 @@ class SimpleFunctionRegistry {
   }
 
   void clearRegistry() {
-    registeredFunctions_.withWLock([&](auto& map) { map.clear(); });
+    registeredFunctions_.withWLock([&](auto& map) {
+      map.clear();
+      resolutions_.wlock()->clear();
+    });
   }
 
   std::vector<const FunctionSignature*> getFunctionSignatures(
@@ -115,11 +121,45 @@ class SimpleFunctionRegistry {
     TypePtr type_;
   };
 
+  /// Returns the function with the highest priority among the functions
+  /// named 'name' that accept 'argTypes'. The results, including calls that
+  /// do not resolve, are cached until the next change to the registry, so
+  /// that compiling the same calls again, e.g. in repeated short queries, does
+  /// not bind the signatures again.
   std::optional<ResolvedSimpleFunction> resolveFunction(
       const std::string& name,
       const std::vector<TypePtr>& argTypes) const;
 
  private:
+  struct ResolutionKey {
+    std::string name;
+    std::vector<TypePtr> argTypes;
+
+    bool operator==(const ResolutionKey& other) const {
+      return name == other.name &&
+          ArgumentTypesComparer{}(argTypes, other.argTypes);
+    }
+  };
+
+  struct ResolutionKeyHasher {
+    size_t operator()(const ResolutionKey& key) const {
+      return folly::hash::hash_128_to_64(
+          std::hash<std::string>{}(key.name),
+          ArgumentTypesHasher{}(key.argTypes));
+    }
+  };
+
+  // The result of resolveFunction(). 'entry' is nullptr if no function
+  // matches.
+  struct Resolution {
+    const FunctionEntry* entry;
+    TypePtr type;
+  };
+
+  // Upper bound on the number of cached resolutions. The cache is cleared
+  // when full.
+  static constexpr size_t kMaxResolutions = 10'000;
+
   template <typename T>
   static std::unique_ptr<T> CreateUdf() {
     return std::make_unique<T>();
@@ -131,6 +171,13 @@ class SimpleFunctionRegistry {
       const FunctionFactory& factory);
 
   folly::Synchronized<FunctionMap> registeredFunctions_;
+
+  // Cache of resolveFunction(). The entries point into
+  // 'registeredFunctions_', so the cache is cleared under its write lock
+  // whenever a function is registered.
+  mutable folly::Synchronized<
+      folly::F14FastMap<ResolutionKey, Resolution, ResolutionKeyHasher>>
+      resolutions_;
 };
 
 const SimpleFunctionRegistry& simpleFunctions();
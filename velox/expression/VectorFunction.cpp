@@ -38,20 +38,47 @@ std::optional<std::vector<FunctionSignaturePtr>> getVectorFunctionSignatures(
       });
 }
 
-std::shared_ptr<const Type> resolveVectorFunction(
-    const std::string& functionName,
+TypePtr VectorFunctionResolutions::resolve(
+    const std::vector<FunctionSignaturePtr>& signatures,
     const std::vector<TypePtr>& argTypes) {
-  if (auto vectorFunctionSignatures =
-          exec::getVectorFunctionSignatures(functionName)) {
-    for (const auto& signature : vectorFunctionSignatures.value()) {
-      exec::SignatureBinder binder(*signature, argTypes);
-      if (binder.tryBind()) {
-        return binder.tryResolveReturnType();
-      }
+  {
+    auto returnTypes = returnTypes_.rlock();
+    auto it = returnTypes->find(argTypes);
+    if (it != returnTypes->end()) {
+      return it->second;
+    }
+  }
+
+  TypePtr returnType;
+  for (const auto& signature : signatures) {
+    exec::SignatureBinder binder(*signature, argTypes);
+    if (binder.tryBind()) {
+      returnType = binder.tryResolveReturnType();
+      break;
     }
   }
 
-  return nullptr;
+  auto returnTypes = returnTypes_.wlock();
+  if (returnTypes->size() >= kMaxEntries) {
+    returnTypes->clear();
+  }
+  returnTypes->emplace(argTypes, returnType);
+  return returnType;
+}
+
+std::shared_ptr<const Type> resolveVectorFunction(
+    const std::string& functionName,
+    const std::vector<TypePtr>& argTypes) {
+  const auto sanitizedName = sanitizeName(functionName);
+  return vectorFunctionFactories().withRLock(
+      [&](const auto& functions) -> TypePtr {
+        auto it = functions.find(sanitizedName);
+        if (it == functions.end()) {
+          return nullptr;
+        }
+        return it->second.resolutions->resolve(
+            it->second.signatures, argTypes);
+      });
 }
 
 std::shared_ptr<VectorFunction> getVectorFunction(
@@ -80,10 +107,13 @@ std::shared_ptr<VectorFunction> getVectorFunction(
   return vectorFunctionFactories().withRLock(
       [&sanitizedName, &inputArgs, &config, &inputTypes](
           auto& functionMap) -> std::shared_ptr<VectorFunction> {
-        if (resolveVectorFunction(sanitizedName, inputTypes)) {
-          auto functionIterator = functionMap.find(sanitizedName);
-          return functionIterator->second.factory(
-              sanitizedName, inputArgs, config);
+        auto functionIterator = functionMap.find(sanitizedName);
+        if (functionIterator == functionMap.end()) {
+          return nullptr;
+        }
+        const auto& entry = functionIterator->second;
+        if (entry.resolutions->resolve(entry.signatures, inputTypes)) {
+          return entry.factory(sanitizedName, inputArgs, config);
         }
         return nullptr;
       });
@@ -142,4 +172,13 @@ void registerExpressionRewrite(ExpressionRewrite rewrite) {
   expressionRewrites().emplace_back(rewrite);
 }
 
+std::vector<ExpressionSetRewrite>& expressionSetRewrites() {
+  static std::vector<ExpressionSetRewrite> rewrites;
+  return rewrites;
+}
+
+void registerExpressionSetRewrite(ExpressionSetRewrite rewrite) {
+  expressionSetRewrites().emplace_back(rewrite);
+}
+
 } // namespace facebook::velox::exec
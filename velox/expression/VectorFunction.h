@@ -20,10 +20,12 @@
 #include "velox/core/Expressions.h"
 #include "velox/expression/EvalCtx.h"
 #include "velox/expression/FunctionSignature.h"
+#include "velox/expression/SignatureBinder.h"
 #include "velox/vector/SelectivityVector.h"
 #include "velox/vector/SimpleVector.h"
 
 #include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
 
 namespace facebook::velox::exec {
 
@@ -127,6 +129,17 @@ class VectorFunction {
       const {
     return std::nullopt;
   }
+
+ protected:
+  /// Returns uninitialized per-batch scratch space for 'count' values of type
+  /// T, e.g. for row indices or intermediate results that do not go into the
+  /// result vector. Cheaper than allocating a buffer from context.pool() per
+  /// call since the space comes from a bump arena that is rewound once the
+  /// batch is evaluated.
+  template <typename T>
+  static T* scratchBuffer(EvalCtx& context, vector_size_t count) {
+    return context.allocateScratch<T>(count);
+  }
 };
 
 /// Vector function that generates the specified error for every row. Use this
@@ -239,10 +252,38 @@ using VectorFunctionFactory = std::function<std::shared_ptr<VectorFunction>(
     const std::vector<VectorFunctionArg>& inputArgs,
     const core::QueryConfig& config)>;
 
+/// Memoized return types of binding the signatures of a vector function to
+/// argument types.
+class VectorFunctionResolutions {
+ public:
+  /// Returns the return type of the first of 'signatures' that binds to
+  /// 'argTypes' or nullptr if none binds. 'signatures' must be the same in
+  /// all calls.
+  TypePtr resolve(
+      const std::vector<FunctionSignaturePtr>& signatures,
+      const std::vector<TypePtr>& argTypes);
+
+ private:
+  // Upper bound on the number of memoized argument types. The memo is cleared
+  // when full.
+  static constexpr size_t kMaxEntries = 10'000;
+
+  folly::Synchronized<folly::F14FastMap<
+      std::vector<TypePtr>,
+      TypePtr,
+      ArgumentTypesHasher,
+      ArgumentTypesComparer>>
+      returnTypes_;
+};
+
 struct VectorFunctionEntry {
   std::vector<FunctionSignaturePtr> signatures;
   VectorFunctionFactory factory;
   VectorFunctionMetadata metadata;
+  /// Resolutions of 'signatures'. Shared by the copies of the entry and
+  /// replaced with the entry when the function is registered again.
+  std::shared_ptr<VectorFunctionResolutions> resolutions{
+      std::make_shared<VectorFunctionResolutions>()};
 };
 
 // TODO: Use folly::Singleton here
@@ -295,6 +336,22 @@ std::vector<ExpressionRewrite>& expressionRewrites();
 /// non-null result terminates the re-write for this particular expression.
 void registerExpressionRewrite(ExpressionRewrite rewrite);
 
+/// A re-writer that takes all the top level expressions of an ExprSet and
+/// returns equivalent expressions or an empty vector if re-write is not
+/// possible. Unlike ExpressionRewrite, it sees all the expressions that are
+/// evaluated together, e.g. to combine calls that process the same input.
+using ExpressionSetRewrite = std::function<std::vector<core::TypedExprPtr>(
+    const std::vector<core::TypedExprPtr>&)>;
+
+/// Returns a list of registered expression set re-writes.
+std::vector<ExpressionSetRewrite>& expressionSetRewrites();
+
+/// Appends a 'rewrite' to 'expressionSetRewrites'. The re-writes are applied
+/// in the order they were registered, each to the result of the previous one,
+/// before the expressions are compiled and the rewrites in
+/// 'expressionRewrites' are applied.
+void registerExpressionSetRewrite(ExpressionSetRewrite rewrite);
+
 } // namespace facebook::velox::exec
 
 // Private. Return the external function name given a UDF tag.
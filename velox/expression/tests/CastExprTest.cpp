@@ -22,6 +22,7 @@
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/prestosql/tests/CastBaseTest.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+#include "velox/type/TimestampConversion.h"
 #include "velox/type/Type.h"
 #include "velox/vector/BaseVector.h"
 #include "velox/vector/TypeAliases.h"
@@ -733,6 +734,83 @@ TEST_F(CastExprTest, date) {
       DATE());
 }
 
+// Strings in the fast formats of FastConversions.h mixed with strings that
+// need the general conversion and with invalid strings.
+TEST_F(CastExprTest, fastStringConversions) {
+  testCast<std::string, int64_t>(
+      "bigint",
+      {"123",
+       "-42",
+       "007",
+       "123456789012345678",
+       "-1234567890123456789",
+       "9223372036854775807",
+       "9223372036854775808",
+       "12a",
+       "-",
+       std::nullopt},
+      {123,
+       -42,
+       7,
+       123456789012345678,
+       -1234567890123456789,
+       9223372036854775807,
+       std::nullopt,
+       std::nullopt,
+       std::nullopt,
+       std::nullopt},
+      false,
+      true);
+
+  testCast<std::string, int32_t>(
+      "integer",
+      {"999999999", "2147483647", "2147483648", "-12345678"},
+      {999999999, 2147483647, std::nullopt, -12345678},
+      false,
+      true);
+
+  testCast<std::string, double>(
+      "double",
+      {"1.5",
+       "-0.25",
+       "0.1",
+       "123456789.123456",
+       "12345678901234567.5",
+       "1e3",
+       "1.5x"},
+      {1.5,
+       -0.25,
+       0.1,
+       123456789.123456,
+       12345678901234567.5,
+       1000,
+       std::nullopt},
+      false,
+      true);
+
+  testCast<std::string, int32_t>(
+      "date",
+      {"2020-01-31", "2020-02-30", "2020-1-5", "1969-12-31"},
+      {18292, std::nullopt, 18266, -1},
+      false,
+      true,
+      VARCHAR(),
+      DATE());
+
+  testCast<std::string, Timestamp>(
+      "timestamp",
+      {"2020-01-31 10:20:30",
+       "2020-01-31T10:20:30.123",
+       "2020-01-31 10:20:30.5Z",
+       "2020-01-31 25:00:00"},
+      {util::fromTimestampString("2020-01-31 10:20:30"),
+       util::fromTimestampString("2020-01-31 10:20:30.123"),
+       util::fromTimestampString("2020-01-31 10:20:30.5"),
+       std::nullopt},
+      false,
+      true);
+}
+
 TEST_F(CastExprTest, invalidDate) {
   for (bool isIso8601 : {true, false}) {
     setCastStringToDateIsIso8601(isIso8601);
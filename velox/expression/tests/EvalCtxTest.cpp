@@ -103,6 +103,52 @@ TEST_F(EvalCtxTest, vectorRecycler) {
   ASSERT_NE(vector.get(), newVector.get());
 }
 
+TEST_F(EvalCtxTest, scratchArena) {
+  EvalCtx context(&execCtx_);
+  ASSERT_EQ(execCtx_.scratchBytes(), 0);
+
+  int64_t* first;
+  {
+    core::ExecCtx::ScratchScope outer(&execCtx_);
+    first = context.allocateScratch<int64_t>(100);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(first) % alignof(int64_t), 0);
+    {
+      // Nested scopes do not rewind the arena.
+      core::ExecCtx::ScratchScope inner(&execCtx_);
+      auto* second = context.allocateScratch<int32_t>(100);
+      ASSERT_GE(
+          reinterpret_cast<char*>(second),
+          reinterpret_cast<char*>(first + 100));
+    }
+    auto* third = context.allocateScratch<char>(10);
+    ASSERT_GT(third, reinterpret_cast<char*>(first + 100));
+  }
+  const auto retainedBytes = execCtx_.scratchBytes();
+  ASSERT_GT(retainedBytes, 0);
+
+  // The next batch reuses the same memory.
+  {
+    core::ExecCtx::ScratchScope scope(&execCtx_);
+    ASSERT_EQ(context.allocateScratch<int64_t>(100), first);
+  }
+  ASSERT_EQ(execCtx_.scratchBytes(), retainedBytes);
+
+  // A batch that needs more than one run is consolidated into a single run,
+  // after which batches of the same size do not grow the arena.
+  auto evalBatch = [&]() {
+    core::ExecCtx::ScratchScope scope(&execCtx_);
+    for (auto i = 0; i < 100; ++i) {
+      context.allocateScratch<char>(64 << 10);
+    }
+  };
+  evalBatch();
+  ASSERT_GT(execCtx_.scratchBytes(), retainedBytes);
+  evalBatch();
+  const auto steadyBytes = execCtx_.scratchBytes();
+  evalBatch();
+  ASSERT_EQ(execCtx_.scratchBytes(), steadyBytes);
+}
+
 TEST_F(EvalCtxTest, ensureErrorsVectorSize) {
   EvalCtx context(&execCtx_);
   context.ensureErrorsVectorSize(*context.errorsPtr(), 10);
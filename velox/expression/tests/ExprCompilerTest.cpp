@@ -122,6 +122,36 @@ TEST_F(ExprCompilerTest, constantFolding) {
       "plus(plus(a, 1:BIGINT), 5:BIGINT)", compile(expression)->toString());
 }
 
+TEST_F(ExprCompilerTest, conjunctSimplification) {
+  auto rowType = ROW({"a", "b"}, {BOOLEAN(), BOOLEAN()});
+
+  auto field = makeField(rowType);
+  auto boolean = [](bool value) -> core::TypedExprPtr {
+    return std::make_shared<core::ConstantTypedExpr>(BOOLEAN(), value);
+  };
+
+  auto expression = andCall(field("a"), andCall(boolean(true), field("b")));
+  ASSERT_EQ("and(a, b)", compile(expression)->toString());
+
+  expression = andCall(field("a"), boolean(true));
+  ASSERT_EQ("a", compile(expression)->toString());
+
+  expression = andCall(field("a"), boolean(false));
+  ASSERT_EQ("false:BOOLEAN", compile(expression)->toString());
+
+  expression = orCall(field("a"), orCall(boolean(false), field("b")));
+  ASSERT_EQ("or(a, b)", compile(expression)->toString());
+
+  expression = orCall(field("a"), boolean(true));
+  ASSERT_EQ("true:BOOLEAN", compile(expression)->toString());
+
+  // A null constant does not decide the result.
+  auto nullBoolean = std::make_shared<core::ConstantTypedExpr>(
+      BOOLEAN(), variant::null(TypeKind::BOOLEAN));
+  expression = andCall(field("a"), nullBoolean);
+  ASSERT_EQ("and(a, null:BOOLEAN)", compile(expression)->toString());
+}
+
 TEST_F(ExprCompilerTest, andFlattening) {
   auto rowType =
       ROW({"a", "b", "c", "d"}, {BOOLEAN(), BOOLEAN(), BOOLEAN(), BOOLEAN()});
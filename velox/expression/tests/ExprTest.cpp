@@ -475,6 +475,55 @@ TEST_P(ParameterizedExprTest, reorder) {
   }
 }
 
+TEST_P(ParameterizedExprTest, reorderHistory) {
+  constexpr int32_t kTestSize = 10'000;
+
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(kTestSize, [](auto row) { return row; })});
+  auto rowType = asRowType(data->type());
+  const std::string sql = "if (c0 % 409 < 300 and c0 % 103 < 1, 1, 2)";
+
+  auto conjunct = [](exec::ExprSet& exprSet) {
+    return std::dynamic_pointer_cast<exec::ConjunctExpr>(
+        exprSet.expr(0)->inputs()[0]);
+  };
+
+  // The first driver publishes what it learned after its first batch.
+  auto first = compileExpression(sql, rowType);
+  evaluate(first.get(), data);
+  auto history = queryCtx_->conjunctHistory(conjunct(*first)->toString());
+  ASSERT_EQ(2, history.size());
+  EXPECT_EQ(kTestSize, history[0].numIn());
+
+  // A second driver of the same query starts from the history.
+  auto second = compileExpression(sql, rowType);
+  evaluate(second.get(), data);
+  auto condition = conjunct(*second);
+  auto totalIn = [](const std::vector<SelectivityInfo>& inputs) {
+    uint64_t numIn = 0;
+    for (const auto& info : inputs) {
+      numIn += info.numIn();
+    }
+    return numIn;
+  };
+  std::vector<SelectivityInfo> secondInfo;
+  for (auto i = 0; i < condition->inputs().size(); ++i) {
+    secondInfo.push_back(condition->selectivityAt(i));
+  }
+  EXPECT_GT(totalIn(secondInfo), totalIn(history));
+
+  // The second driver adds only its own rows to the history.
+  EXPECT_EQ(
+      totalIn(secondInfo),
+      totalIn(queryCtx_->conjunctHistory(condition->toString())));
+  EXPECT_EQ(0, condition->numShortCircuits());
+
+  // Both drivers find the more selective input first.
+  EXPECT_LE(
+      condition->selectivityAt(0).timeToDropValue(),
+      condition->selectivityAt(1).timeToDropValue());
+}
+
 TEST_P(ParameterizedExprTest, constant) {
   auto exprSet = compileExpression("1 + 2 + 3 + 4", ROW({}));
   auto constExpr = dynamic_cast<exec::ConstantExpr*>(exprSet->expr(0).get());
@@ -2129,6 +2178,94 @@ TEST_P(ParameterizedExprTest, memo) {
   assertEqualVectors(expectedResult, result);
 }
 
+TEST_P(ParameterizedExprTest, peelingCostModel) {
+  auto rowType = ROW({"c0"}, {BIGINT()});
+
+  // A dictionary with repeated rows is evaluated on its base.
+  auto base = makeFlatVector<int64_t>(1'000, [](auto row) { return row; });
+  auto indices = makeIndices(100, [](auto row) { return row % 10; });
+  auto exprSet = compileExpression("c0 + 1", rowType);
+  auto result = evaluate(
+      exprSet.get(), makeRowVector({wrapInDictionary(indices, 100, base)}));
+  assertEqualVectors(
+      makeFlatVector<int64_t>(100, [](auto row) { return row % 10 + 1; }),
+      result);
+  auto stats = exprSet->exprs()[0]->stats();
+  ASSERT_EQ(stats.numPeeledVectors, 1);
+  ASSERT_EQ(stats.numPeelSavedRows, 90);
+  ASSERT_EQ(stats.numPeelsSkipped, 0);
+
+  // A few distinct rows of a large base are evaluated through the dictionary
+  // unless the results may be memoized.
+  base = makeFlatVector<int64_t>(10'000, [](auto row) { return row; });
+  indices = makeIndices(10, [](auto row) { return row * 1'000; });
+  exprSet = compileExpression("c0 + 1", rowType);
+  result = evaluate(
+      exprSet.get(), makeRowVector({wrapInDictionary(indices, 10, base)}));
+  assertEqualVectors(
+      makeFlatVector<int64_t>(10, [](auto row) { return row * 1'000 + 1; }),
+      result);
+  stats = exprSet->exprs()[0]->stats();
+  if (GetParam()) {
+    ASSERT_EQ(stats.numPeeledVectors, 1);
+    ASSERT_EQ(stats.numPeelsSkipped, 0);
+  } else {
+    ASSERT_EQ(stats.numPeeledVectors, 0);
+    ASSERT_GT(stats.numPeelsSkipped, 0);
+  }
+}
+
+namespace {
+int64_t numPlusOneCalls = 0;
+
+template <typename T>
+struct CountingPlusOneFunction {
+  void call(int64_t& out, const int64_t& in) {
+    ++numPlusOneCalls;
+    out = in + 1;
+  }
+};
+} // namespace
+
+TEST_P(ParameterizedExprTest, memoAcrossBases) {
+  registerFunction<CountingPlusOneFunction, int64_t, int64_t>(
+      {"counting_plus_one"});
+  auto first = makeFlatVector<int64_t>(1'000, [](auto row) { return row; });
+  auto second =
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row * 2; });
+  auto indices = makeIndices(100, [](auto row) { return row * 3; });
+
+  auto rowType = ROW({"c0"}, {BIGINT()});
+  auto evaluateBatches = [&](exec::ExprSet* exprSet) {
+    numPlusOneCalls = 0;
+    // Alternate between 2 dictionaries over the same bases.
+    for (auto i = 0; i < 4; ++i) {
+      const auto& base = i % 2 == 0 ? first : second;
+      auto result = evaluate(
+          exprSet, makeRowVector({wrapInDictionary(indices, 100, base)}));
+      auto expected = makeFlatVector<int64_t>(100, [&](auto row) {
+        return base->valueAt(row * 3) + 1;
+      });
+      assertEqualVectors(expected, result);
+    }
+  };
+
+  // The results for both bases are kept across batches.
+  auto exprSet = compileExpression("counting_plus_one(c0)", rowType);
+  evaluateBatches(exprSet.get());
+  ASSERT_EQ(numPlusOneCalls, GetParam() ? 200 : 400);
+
+  // Memoized results over the limit are dropped.
+  queryCtx_->testingOverrideConfigUnsafe({
+      {core::QueryConfig::kEnableExpressionEvaluationCache,
+       GetParam() ? "true" : "false"},
+      {core::QueryConfig::kExprMaxMemoBytes, "1"},
+  });
+  exprSet = compileExpression("counting_plus_one(c0)", rowType);
+  evaluateBatches(exprSet.get());
+  ASSERT_EQ(numPlusOneCalls, 400);
+}
+
 // This test triggers the situation when peelEncodings() produces an empty
 // selectivity vector, which if passed to evalWithMemo() causes the latter to
 // produce null Expr::dictionaryCache_, which leads to a crash in evaluation
@@ -187,6 +187,119 @@ TEST_F(ExprToSubfieldFilterTest, in) {
   }
 }
 
+TEST_F(ExprToSubfieldFilterTest, like) {
+  auto call = parseCallExpr("a like 'ab%'", ROW({{"a", VARCHAR()}}));
+  Subfield subfield;
+  auto filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"a"});
+  ASSERT_TRUE(filter->testBytes("ab", 2));
+  ASSERT_TRUE(filter->testBytes("abz", 3));
+  ASSERT_FALSE(filter->testBytes("aa", 2));
+  ASSERT_FALSE(filter->testBytes("ac", 2));
+  ASSERT_FALSE(filter->testBytes("a", 1));
+  ASSERT_FALSE(filter->testNull());
+
+  call = parseCallExpr("a like 'ab'", ROW({{"a", VARCHAR()}}));
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testBytes("ab", 2));
+  ASSERT_FALSE(filter->testBytes("abc", 3));
+
+  // Patterns with other wildcards are not converted.
+  call = parseCallExpr("a like 'a_c%'", ROW({{"a", VARCHAR()}}));
+  ASSERT_FALSE(leafCallToSubfieldFilter(*call, subfield, evaluator()));
+  call = parseCallExpr("a like '%bc'", ROW({{"a", VARCHAR()}}));
+  ASSERT_FALSE(leafCallToSubfieldFilter(*call, subfield, evaluator()));
+}
+
+TEST_F(ExprToSubfieldFilterTest, notIn) {
+  auto call = parseCallExpr("a in ('x', 'y')", ROW({{"a", VARCHAR()}}));
+  Subfield subfield;
+  auto filter = leafCallToSubfieldFilter(*call, subfield, evaluator(), true);
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"a"});
+  ASSERT_TRUE(dynamic_cast<NegatedBytesValues*>(filter.get()));
+  ASSERT_FALSE(filter->testBytes("x", 1));
+  ASSERT_TRUE(filter->testBytes("z", 1));
+}
+
+TEST_F(ExprToSubfieldFilterTest, or) {
+  auto call = parseCallExpr("a > 20 or a < 10", ROW({{"a", BIGINT()}}));
+  Subfield subfield;
+  auto filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"a"});
+  for (int i = 0; i <= 30; ++i) {
+    ASSERT_EQ(filter->testInt64(i), i < 10 || i > 20);
+  }
+  ASSERT_FALSE(filter->testNull());
+
+  call = parseCallExpr("a < 0.5 or a > 1.5", ROW({{"a", DOUBLE()}}));
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testDouble(0));
+  ASSERT_FALSE(filter->testDouble(1));
+  ASSERT_TRUE(filter->testDouble(2));
+
+  // Predicates on different columns and predicates that pass nulls are not
+  // converted.
+  call = parseCallExpr("a = 1 or b = 2", ROW({"a", "b"}, {BIGINT(), BIGINT()}));
+  ASSERT_FALSE(leafCallToSubfieldFilter(*call, subfield, evaluator()));
+  call = parseCallExpr("a = 1 or a is null", ROW({{"a", BIGINT()}}));
+  ASSERT_FALSE(leafCallToSubfieldFilter(*call, subfield, evaluator()));
+  call = parseCallExpr("a > 20 or a < 10", ROW({{"a", BIGINT()}}));
+  ASSERT_FALSE(leafCallToSubfieldFilter(*call, subfield, evaluator(), true));
+}
+
+TEST_F(ExprToSubfieldFilterTest, integerCast) {
+  auto call = parseCallExpr(
+      "cast(a as bigint) between 5 and 7", ROW({{"a", INTEGER()}}));
+  Subfield subfield;
+  auto filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"a"});
+  for (int i = 0; i <= 10; ++i) {
+    ASSERT_EQ(filter->testInt64(i), 5 <= i && i <= 7);
+  }
+
+  // Narrowing casts change the values and are not converted.
+  call = parseCallExpr("cast(a as tinyint) = 5", ROW({{"a", INTEGER()}}));
+  ASSERT_FALSE(leafCallToSubfieldFilter(*call, subfield, evaluator()));
+}
+
+TEST_F(ExprToSubfieldFilterTest, dateOfTimestamp) {
+  // 2023-01-01 00:00:00 UTC.
+  constexpr int64_t kStart = 1'672'531'200;
+  constexpr int64_t kDay = 86'400;
+  auto rowType = ROW({{"a", TIMESTAMP()}});
+  auto call = parseCallExpr(
+      "cast(a as date) = cast('2023-01-01' as date)", rowType);
+  Subfield subfield;
+  auto filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"a"});
+  ASSERT_FALSE(filter->testTimestamp(Timestamp(kStart - 1, 999'999'999)));
+  ASSERT_TRUE(filter->testTimestamp(Timestamp(kStart, 0)));
+  ASSERT_TRUE(filter->testTimestamp(Timestamp(kStart + kDay - 1, 999'999'999)));
+  ASSERT_FALSE(filter->testTimestamp(Timestamp(kStart + kDay, 0)));
+
+  call = parseCallExpr(
+      "cast(a as date) > cast('2023-01-01' as date)", rowType);
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_FALSE(filter->testTimestamp(Timestamp(kStart + kDay - 1, 0)));
+  ASSERT_TRUE(filter->testTimestamp(Timestamp(kStart + kDay, 0)));
+
+  // NOT (x < d) is x >= d.
+  call = parseCallExpr(
+      "cast(a as date) < cast('2023-01-01' as date)", rowType);
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator(), true);
+  ASSERT_TRUE(filter);
+  ASSERT_FALSE(filter->testTimestamp(Timestamp(kStart - 1, 0)));
+  ASSERT_TRUE(filter->testTimestamp(Timestamp(kStart, 0)));
+}
+
 TEST_F(ExprToSubfieldFilterTest, isNull) {
   auto call = parseCallExpr("a is null", ROW({{"a", BIGINT()}}));
   Subfield subfield;
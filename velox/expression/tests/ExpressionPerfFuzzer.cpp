@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/tests/ExpressionPerfFuzzer.h"
+
+#include <chrono>
+#include <istream>
+#include <ostream>
+
+#include <folly/Random.h>
+#include <folly/String.h>
+
+#include "velox/expression/Expr.h"
+#include "velox/expression/tests/ArgumentTypeFuzzer.h"
+
+namespace facebook::velox::test {
+
+namespace {
+
+constexpr uint32_t kMaxVariadicArgs = 3;
+
+bool containsTypeName(
+    const exec::TypeSignature& type,
+    const std::vector<std::string>& typeNames) {
+  const auto name = exec::sanitizeName(type.baseName());
+  if (std::find(typeNames.begin(), typeNames.end(), name) != typeNames.end()) {
+    return true;
+  }
+  for (const auto& parameter : type.parameters()) {
+    if (containsTypeName(parameter, typeNames)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Lambdas and the types VectorFuzzer does not generate are not supported, as
+// in ExpressionFuzzer.
+bool isSupportedSignature(const exec::FunctionSignature& signature) {
+  static const std::vector<std::string> kUnsupportedTypes = {
+      "opaque",
+      "function",
+      "long_decimal",
+      "short_decimal",
+      "decimal",
+      "timestamp with time zone",
+      "interval day to second"};
+  if (containsTypeName(signature.returnType(), kUnsupportedTypes)) {
+    return false;
+  }
+  for (const auto& argument : signature.argumentTypes()) {
+    if (containsTypeName(argument, kUnsupportedTypes)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string signatureString(const std::vector<TypePtr>& types) {
+  std::vector<std::string> names;
+  names.reserve(types.size());
+  for (const auto& type : types) {
+    names.push_back(type->toString());
+  }
+  return fmt::format("({})", folly::join(",", names));
+}
+
+std::string resultKey(const ExpressionPerfFuzzer::Result& result) {
+  return fmt::format(
+      "{}{} {} {}",
+      result.function,
+      result.signature,
+      ExpressionPerfFuzzer::encodingName(result.encoding),
+      result.simplified ? "simplified" : "common");
+}
+
+// Returns the time per row of evaluating 'expr' 'numRepeats' times on each
+// of 'inputs'.
+template <typename TExprSet>
+double timeEval(
+    const core::TypedExprPtr& expr,
+    const std::vector<RowVectorPtr>& inputs,
+    int32_t numRepeats,
+    core::ExecCtx& execCtx,
+    bool* deterministic = nullptr) {
+  TExprSet exprSet({expr}, &execCtx);
+  if (deterministic) {
+    *deterministic = exprSet.expr(0)->isDeterministic();
+  }
+  uint64_t nanos = 0;
+  uint64_t numRows = 0;
+  for (const auto& input : inputs) {
+    SelectivityVector rows(input->size());
+    for (auto i = 0; i < numRepeats; ++i) {
+      exec::EvalCtx evalCtx(&execCtx, &exprSet, input.get());
+      std::vector<VectorPtr> result(1);
+      const auto start = std::chrono::steady_clock::now();
+      exprSet.eval(rows, evalCtx, result);
+      nanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - start)
+                   .count();
+      numRows += input->size();
+    }
+  }
+  return numRows == 0 ? 0 : static_cast<double>(nanos) / numRows;
+}
+
+} // namespace
+
+ExpressionPerfFuzzer::ExpressionPerfFuzzer(
+    FunctionSignatureMap signatureMap,
+    Options options,
+    size_t seed)
+    : signatureMap_(std::move(signatureMap)),
+      options_(options),
+      rng_(seed),
+      vectorFuzzer_(
+          [&]() {
+            VectorFuzzer::Options fuzzerOptions;
+            fuzzerOptions.vectorSize = options.batchSize;
+            fuzzerOptions.nullRatio = options.nullRatio;
+            fuzzerOptions.stringLength = options.stringLength;
+            fuzzerOptions.stringVariableLength = options.stringVariableLength;
+            return fuzzerOptions;
+          }(),
+          pool_.get(),
+          seed) {
+  VELOX_CHECK_GT(options_.batchSize, 0);
+  VELOX_CHECK_GT(options_.dictionaryFanout, 0);
+}
+
+// static
+std::string ExpressionPerfFuzzer::encodingName(Encoding encoding) {
+  switch (encoding) {
+    case Encoding::kFlat:
+      return "flat";
+    case Encoding::kConstant:
+      return "constant";
+    case Encoding::kDictionary:
+      return "dictionary";
+  }
+  VELOX_UNREACHABLE();
+}
+
+std::vector<ExpressionPerfFuzzer::Result> ExpressionPerfFuzzer::run() {
+  // Sorted so that the same seed measures the same calls.
+  std::vector<std::string> names;
+  for (const auto& [name, _] : signatureMap_) {
+    names.push_back(name);
+  }
+  std::sort(names.begin(), names.end());
+
+  std::vector<Result> results;
+  for (const auto& name : names) {
+    for (const auto* signature : signatureMap_.at(name)) {
+      auto signatureResults = measure(name, *signature);
+      results.insert(
+          results.end(), signatureResults.begin(), signatureResults.end());
+    }
+  }
+  return results;
+}
+
+std::vector<ExpressionPerfFuzzer::Result> ExpressionPerfFuzzer::measure(
+    const std::string& name,
+    const exec::FunctionSignature& signature) {
+  if (!isSupportedSignature(signature)) {
+    return {};
+  }
+  ArgumentTypeFuzzer typeFuzzer{signature, rng_};
+  if (!typeFuzzer.fuzzArgumentTypes(kMaxVariadicArgs)) {
+    return {};
+  }
+  const auto& argTypes = typeFuzzer.argumentTypes();
+  auto returnType = resolveFunction(name, argTypes);
+  if (!returnType) {
+    return {};
+  }
+
+  // Arguments that must be constant are the same for all encodings. The
+  // others are input columns.
+  const auto& constantArguments = signature.constantArguments();
+  std::vector<core::TypedExprPtr> args;
+  std::vector<std::string> columnNames;
+  std::vector<TypePtr> columnTypes;
+  for (auto i = 0; i < argTypes.size(); ++i) {
+    const bool isConstant = i < constantArguments.size()
+        ? constantArguments[i]
+        : constantArguments.back();
+    if (isConstant) {
+      args.push_back(std::make_shared<core::ConstantTypedExpr>(
+          vectorFuzzer_.fuzzConstant(argTypes[i], 1)));
+    } else {
+      columnNames.push_back(fmt::format("c{}", columnNames.size()));
+      columnTypes.push_back(argTypes[i]);
+      args.push_back(std::make_shared<core::FieldAccessTypedExpr>(
+          argTypes[i], columnNames.back()));
+    }
+  }
+  auto call =
+      std::make_shared<core::CallTypedExpr>(returnType, std::move(args), name);
+  auto rowType = ROW(std::move(columnNames), std::move(columnTypes));
+
+  std::vector<Result> results;
+  try {
+    for (auto encoding :
+         {Encoding::kFlat, Encoding::kConstant, Encoding::kDictionary}) {
+      if (encoding != Encoding::kFlat && rowType->size() == 0) {
+        break;
+      }
+      std::vector<RowVectorPtr> inputs;
+      for (auto i = 0; i < options_.numBatches; ++i) {
+        inputs.push_back(makeInput(rowType, encoding));
+      }
+      bool deterministic;
+      const auto commonNanos = timeEval<exec::ExprSet>(
+          call, inputs, options_.numRepeats, execCtx_, &deterministic);
+      const auto simplifiedNanos = timeEval<exec::ExprSetSimplified>(
+          call, inputs, options_.numRepeats, execCtx_);
+      const auto argSignature = signatureString(argTypes);
+      results.push_back(
+          {name, argSignature, encoding, false, commonNanos, deterministic});
+      results.push_back(
+          {name, argSignature, encoding, true, simplifiedNanos, deterministic});
+    }
+  } catch (const VeloxException& e) {
+    VLOG(1) << "Skipping " << call->toString() << ": " << e.message();
+    return {};
+  }
+  return results;
+}
+
+RowVectorPtr ExpressionPerfFuzzer::makeInput(
+    const RowTypePtr& rowType,
+    Encoding encoding) {
+  const auto size = options_.batchSize;
+  std::vector<VectorPtr> children;
+  children.reserve(rowType->size());
+  switch (encoding) {
+    case Encoding::kFlat:
+      for (const auto& type : rowType->children()) {
+        children.push_back(vectorFuzzer_.fuzzFlat(type, size));
+      }
+      break;
+    case Encoding::kConstant:
+      for (const auto& type : rowType->children()) {
+        children.push_back(vectorFuzzer_.fuzzConstant(type, size));
+      }
+      break;
+    case Encoding::kDictionary: {
+      // All columns share the indices, so that ExprSet can peel them off and
+      // evaluate on the base rows.
+      const vector_size_t baseSize =
+          std::max<vector_size_t>(1, size / options_.dictionaryFanout);
+      auto indices = allocateIndices(size, pool_.get());
+      auto* rawIndices = indices->asMutable<vector_size_t>();
+      for (auto i = 0; i < size; ++i) {
+        rawIndices[i] = folly::Random::rand32(baseSize, rng_);
+      }
+      for (const auto& type : rowType->children()) {
+        children.push_back(BaseVector::wrapInDictionary(
+            nullptr, indices, size, vectorFuzzer_.fuzzFlat(type, baseSize)));
+      }
+      break;
+    }
+  }
+  return std::make_shared<RowVector>(
+      pool_.get(), rowType, nullptr, size, std::move(children));
+}
+
+// static
+void ExpressionPerfFuzzer::writeResults(
+    const std::vector<Result>& results,
+    const std::string& label,
+    std::ostream& out) {
+  out << "label\tfunction\tsignature\tencoding\tevaluator\tnanos_per_row"
+      << "\tdeterministic\n";
+  for (const auto& result : results) {
+    out << fmt::format(
+        "{}\t{}\t{}\t{}\t{}\t{:.3f}\t{}\n",
+        label,
+        result.function,
+        result.signature,
+        encodingName(result.encoding),
+        result.simplified ? "simplified" : "common",
+        result.nanosPerRow,
+        result.deterministic ? 1 : 0);
+  }
+}
+
+// static
+std::vector<ExpressionPerfFuzzer::Result> ExpressionPerfFuzzer::readResults(
+    std::istream& in) {
+  static const std::unordered_map<std::string, Encoding> kEncodings = {
+      {"flat", Encoding::kFlat},
+      {"constant", Encoding::kConstant},
+      {"dictionary", Encoding::kDictionary}};
+  std::vector<Result> results;
+  std::unordered_map<std::string, size_t> indices;
+  std::string line;
+  while (std::getline(in, line)) {
+    std::vector<std::string> fields;
+    folly::split('\t', line, fields);
+    if (fields.empty() || fields[0] == "label" || line.empty()) {
+      continue;
+    }
+    VELOX_USER_CHECK_EQ(fields.size(), 7, "Bad result line: {}", line);
+    auto encoding = kEncodings.find(fields[3]);
+    VELOX_USER_CHECK(
+        encoding != kEncodings.end(), "Bad encoding in line: {}", line);
+    Result result{
+        fields[1],
+        fields[2],
+        encoding->second,
+        fields[4] == "simplified",
+        folly::to<double>(fields[5]),
+        fields[6] == "1"};
+    auto [it, inserted] = indices.emplace(resultKey(result), results.size());
+    if (inserted) {
+      results.push_back(std::move(result));
+    } else {
+      results[it->second] = std::move(result);
+    }
+  }
+  return results;
+}
+
+std::vector<std::string> ExpressionPerfFuzzer::findRegressions(
+    const std::vector<Result>& baseline,
+    const std::vector<Result>& results) const {
+  std::unordered_map<std::string, double> baselineNanos;
+  for (const auto& result : baseline) {
+    baselineNanos[resultKey(result)] = result.nanosPerRow;
+  }
+  std::vector<std::string> regressions;
+  for (const auto& result : results) {
+    const auto key = resultKey(result);
+    auto it = baselineNanos.find(key);
+    if (it == baselineNanos.end() || it->second < options_.minNanosPerRow) {
+      continue;
+    }
+    if (result.nanosPerRow > it->second * options_.maxSlowdown) {
+      regressions.push_back(fmt::format(
+          "{}: {:.2f} ns/row, was {:.2f} ns/row",
+          key,
+          result.nanosPerRow,
+          it->second));
+    }
+  }
+  return regressions;
+}
+
+std::vector<std::string> ExpressionPerfFuzzer::findEncodingOutliers(
+    const std::vector<Result>& results) const {
+  std::unordered_map<std::string, double> flatNanos;
+  for (const auto& result : results) {
+    if (result.encoding == Encoding::kFlat && !result.simplified) {
+      flatNanos[result.function + result.signature] = result.nanosPerRow;
+    }
+  }
+  std::vector<std::string> outliers;
+  for (const auto& result : results) {
+    if (result.encoding == Encoding::kFlat || result.simplified ||
+        !result.deterministic) {
+      continue;
+    }
+    auto it = flatNanos.find(result.function + result.signature);
+    if (it == flatNanos.end() || it->second < options_.minNanosPerRow) {
+      continue;
+    }
+    if (result.nanosPerRow > it->second * options_.maxEncodingRatio) {
+      outliers.push_back(fmt::format(
+          "{}: {:.2f} ns/row, flat {:.2f} ns/row",
+          resultKey(result),
+          result.nanosPerRow,
+          it->second));
+    }
+  }
+  return outliers;
+}
+
+} // namespace facebook::velox::test
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <iosfwd>
+#include <random>
+
+#include "velox/core/QueryCtx.h"
+#include "velox/functions/FunctionRegistry.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+namespace facebook::velox::test {
+
+/// Performance counterpart of ExpressionFuzzer. For each function signature
+/// it generates a call of the function on fuzzed input columns and measures
+/// the time per row of evaluating it with ExprSet and ExprSetSimplified on
+/// flat, constant and dictionary encoded inputs. Results are rows of a CSV
+/// table, so that the results of each commit can be kept and loaded into a
+/// database. Comparing against the results of a previous commit flags
+/// functions that got slower. Comparing the encodings flags missed fast
+/// paths: ExprSet evaluates a deterministic function on constant inputs for
+/// one row and on inputs that share one dictionary for the distinct base rows
+/// only, so both should be faster than flat inputs.
+class ExpressionPerfFuzzer {
+ public:
+  enum class Encoding { kFlat, kConstant, kDictionary };
+
+  struct Options {
+    vector_size_t batchSize{1'000};
+
+    /// Number of input batches per signature and encoding. Each one is
+    /// evaluated 'numRepeats' times.
+    int32_t numBatches{5};
+    int32_t numRepeats{10};
+
+    double nullRatio{0};
+    size_t stringLength{20};
+    bool stringVariableLength{true};
+
+    /// Number of dictionary encoded rows per base row.
+    int32_t dictionaryFanout{10};
+
+    /// Functions over this many times slower than in the baseline are
+    /// reported as regressions.
+    double maxSlowdown{1.2};
+
+    /// Functions whose ExprSet time per row for constant or dictionary inputs
+    /// is over this fraction of the time for flat inputs are reported.
+    double maxEncodingRatio{0.8};
+
+    /// Results that take less time per row in the baseline or for flat inputs
+    /// are not reported, since their times are mostly noise.
+    double minNanosPerRow{1};
+  };
+
+  struct Result {
+    std::string function;
+    /// The argument types of the call, e.g. "(varchar,bigint)".
+    std::string signature;
+    Encoding encoding;
+    bool simplified;
+    double nanosPerRow;
+    bool deterministic{true};
+  };
+
+  ExpressionPerfFuzzer(
+      FunctionSignatureMap signatureMap,
+      Options options,
+      size_t seed);
+
+  /// Measures all signatures. Signatures whose calls throw on the generated
+  /// inputs are skipped.
+  std::vector<Result> run();
+
+  /// Writes 'results' as CSV with a header line. 'label' names the commit or
+  /// build the results are for and is written in the first column.
+  static void writeResults(
+      const std::vector<Result>& results,
+      const std::string& label,
+      std::ostream& out);
+
+  /// Reads results written by writeResults. If the input has results for
+  /// several labels, the last result per function, signature, encoding and
+  /// evaluator is kept.
+  static std::vector<Result> readResults(std::istream& in);
+
+  /// Returns a line per result that is over 'maxSlowdown' times slower than
+  /// its counterpart in 'baseline'.
+  std::vector<std::string> findRegressions(
+      const std::vector<Result>& baseline,
+      const std::vector<Result>& results) const;
+
+  /// Returns a line per deterministic signature whose ExprSet time per row
+  /// for constant or dictionary inputs is over 'maxEncodingRatio' of the time
+  /// for flat inputs.
+  std::vector<std::string> findEncodingOutliers(
+      const std::vector<Result>& results) const;
+
+  static std::string encodingName(Encoding encoding);
+
+ private:
+  // Returns the results for one signature or an empty vector if it is not
+  // supported or its calls throw.
+  std::vector<Result> measure(
+      const std::string& name,
+      const exec::FunctionSignature& signature);
+
+  RowVectorPtr makeInput(const RowTypePtr& rowType, Encoding encoding);
+
+  const FunctionSignatureMap signatureMap_;
+  const Options options_;
+  std::mt19937 rng_;
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::addDefaultLeafMemoryPool()};
+  std::shared_ptr<core::QueryCtx> queryCtx_{
+      std::make_shared<core::QueryCtx>()};
+  core::ExecCtx execCtx_{pool_.get(), queryCtx_.get()};
+  VectorFuzzer vectorFuzzer_;
+};
+
+} // namespace facebook::velox::test
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/String.h>
+#include <folly/init/Init.h>
+#include <fstream>
+#include <iostream>
+
+#include "velox/expression/tests/ExpressionPerfFuzzer.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+/// Measures the time per row of the Presto scalar functions on fuzzed inputs
+/// and reports regressions against a previous run and missed fast paths for
+/// constant and dictionary inputs. Exits with 1 if there is any finding.
+///
+///  $ ./velox_expression_perf_fuzzer_test --label $(git rev-parse HEAD) \
+///         --output results.tsv --baseline previous_results.tsv \
+///         --only "substr,lower"
+
+DEFINE_int64(seed, 1, "Seed for the generated calls and inputs.");
+
+DEFINE_string(
+    only,
+    "",
+    "If specified, only measures the functions in this comma separated list.");
+
+DEFINE_int32(batch_size, 1'000, "Number of rows per input batch.");
+
+DEFINE_int32(num_batches, 5, "Number of input batches per measurement.");
+
+DEFINE_int32(num_repeats, 10, "Number of evaluations per input batch.");
+
+DEFINE_double(null_ratio, 0, "Chance of generating a null input value.");
+
+DEFINE_int32(string_length, 20, "Maximum length of generated strings.");
+
+DEFINE_string(output, "", "File to write the results to.");
+
+DEFINE_string(label, "", "Label of the results, e.g. the commit hash.");
+
+DEFINE_string(
+    baseline,
+    "",
+    "Results of a previous run to report regressions against.");
+
+DEFINE_double(
+    max_slowdown,
+    1.2,
+    "Results over this many times slower than the baseline are reported.");
+
+DEFINE_double(
+    max_encoding_ratio,
+    0.8,
+    "Results for constant or dictionary inputs over this fraction of the "
+    "time for flat inputs are reported.");
+
+using namespace facebook::velox;
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  functions::prestosql::registerAllScalarFunctions();
+
+  auto signatures = getFunctionSignatures();
+  if (!FLAGS_only.empty()) {
+    std::vector<std::string> names;
+    folly::split(',', FLAGS_only, names, true);
+    FunctionSignatureMap selected;
+    for (auto& name : names) {
+      auto it = signatures.find(folly::trimWhitespace(name).str());
+      VELOX_USER_CHECK(it != signatures.end(), "Unknown function: {}", name);
+      selected.insert(*it);
+    }
+    signatures = std::move(selected);
+  }
+
+  test::ExpressionPerfFuzzer::Options options;
+  options.batchSize = FLAGS_batch_size;
+  options.numBatches = FLAGS_num_batches;
+  options.numRepeats = FLAGS_num_repeats;
+  options.nullRatio = FLAGS_null_ratio;
+  options.stringLength = FLAGS_string_length;
+  options.maxSlowdown = FLAGS_max_slowdown;
+  options.maxEncodingRatio = FLAGS_max_encoding_ratio;
+  test::ExpressionPerfFuzzer fuzzer(signatures, options, FLAGS_seed);
+  auto results = fuzzer.run();
+
+  if (FLAGS_output.empty()) {
+    test::ExpressionPerfFuzzer::writeResults(results, FLAGS_label, std::cout);
+  } else {
+    std::ofstream out(FLAGS_output);
+    test::ExpressionPerfFuzzer::writeResults(results, FLAGS_label, out);
+  }
+
+  auto findings = fuzzer.findEncodingOutliers(results);
+  if (!FLAGS_baseline.empty()) {
+    std::ifstream in(FLAGS_baseline);
+    VELOX_USER_CHECK(in.good(), "Cannot read {}", FLAGS_baseline);
+    auto regressions = fuzzer.findRegressions(
+        test::ExpressionPerfFuzzer::readResults(in), results);
+    findings.insert(findings.end(), regressions.begin(), regressions.end());
+  }
+  for (const auto& finding : findings) {
+    LOG(WARNING) << finding;
+  }
+  LOG(INFO) << results.size() << " results, " << findings.size()
+            << " findings";
+  return findings.empty() ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <sstream>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/expression/tests/ExpressionPerfFuzzer.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+namespace facebook::velox::test {
+namespace {
+
+using Encoding = ExpressionPerfFuzzer::Encoding;
+using Result = ExpressionPerfFuzzer::Result;
+
+class ExpressionPerfFuzzerUnitTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    functions::prestosql::registerAllScalarFunctions();
+  }
+
+  static FunctionSignatureMap signatures(
+      const std::vector<std::string>& names) {
+    auto all = getFunctionSignatures();
+    FunctionSignatureMap selected;
+    for (const auto& name : names) {
+      selected.insert(*all.find(name));
+    }
+    return selected;
+  }
+
+  static ExpressionPerfFuzzer::Options smallOptions() {
+    ExpressionPerfFuzzer::Options options;
+    options.batchSize = 100;
+    options.numBatches = 2;
+    options.numRepeats = 2;
+    options.nullRatio = 0.1;
+    return options;
+  }
+};
+
+TEST_F(ExpressionPerfFuzzerUnitTest, run) {
+  ExpressionPerfFuzzer fuzzer(
+      signatures({"lower", "plus", "rand"}), smallOptions(), 1);
+  auto results = fuzzer.run();
+
+  std::unordered_map<std::string, int32_t> counts;
+  for (const auto& result : results) {
+    EXPECT_GE(result.nanosPerRow, 0);
+    ++counts[result.function];
+    if (result.function == "rand") {
+      EXPECT_FALSE(result.deterministic);
+    } else {
+      EXPECT_TRUE(result.deterministic);
+    }
+  }
+  // lower(varchar) has 3 encodings with 2 evaluators each. rand() has no
+  // input columns, so only flat inputs are measured.
+  EXPECT_EQ(counts["lower"], 6);
+  EXPECT_EQ(counts["rand"] % 2, 0);
+  EXPECT_GT(counts["plus"], 0);
+  EXPECT_EQ(counts["plus"] % 6, 0);
+}
+
+TEST_F(ExpressionPerfFuzzerUnitTest, writeAndRead) {
+  std::vector<Result> results = {
+      {"lower", "(varchar)", Encoding::kFlat, false, 12.5},
+      {"lower", "(varchar)", Encoding::kDictionary, true, 3.25},
+      {"rand", "()", Encoding::kFlat, false, 4, false},
+  };
+  std::stringstream out;
+  ExpressionPerfFuzzer::writeResults(results, "first", out);
+  results[0].nanosPerRow = 10;
+  ExpressionPerfFuzzer::writeResults({results[0]}, "second", out);
+
+  std::stringstream in(out.str());
+  auto read = ExpressionPerfFuzzer::readResults(in);
+  ASSERT_EQ(read.size(), results.size());
+  for (auto i = 0; i < results.size(); ++i) {
+    // The later 'second' result replaces the first.
+    EXPECT_EQ(read[i].function, results[i].function);
+    EXPECT_EQ(read[i].signature, results[i].signature);
+    EXPECT_EQ(read[i].encoding, results[i].encoding);
+    EXPECT_EQ(read[i].simplified, results[i].simplified);
+    EXPECT_DOUBLE_EQ(read[i].nanosPerRow, results[i].nanosPerRow);
+    EXPECT_EQ(read[i].deterministic, results[i].deterministic);
+  }
+
+  std::stringstream bad("first\tlower\t(varchar)\tflat\tcommon\n");
+  VELOX_ASSERT_THROW(ExpressionPerfFuzzer::readResults(bad), "Bad result");
+}
+
+TEST_F(ExpressionPerfFuzzerUnitTest, findRegressions) {
+  ExpressionPerfFuzzer fuzzer({}, smallOptions(), 1);
+  std::vector<Result> baseline = {
+      {"lower", "(varchar)", Encoding::kFlat, false, 10},
+      {"lower", "(varchar)", Encoding::kFlat, true, 10},
+      {"plus", "(bigint,bigint)", Encoding::kFlat, false, 0.5},
+  };
+  std::vector<Result> results = {
+      {"lower", "(varchar)", Encoding::kFlat, false, 11},
+      {"lower", "(varchar)", Encoding::kFlat, true, 13},
+      {"lower", "(varchar)", Encoding::kConstant, false, 100},
+      {"plus", "(bigint,bigint)", Encoding::kFlat, false, 0.9},
+  };
+  // Only the simplified lower is over 1.2 times slower. The constant result
+  // has no baseline and plus is too fast to compare.
+  auto regressions = fuzzer.findRegressions(baseline, results);
+  ASSERT_EQ(regressions.size(), 1);
+  EXPECT_EQ(
+      regressions[0],
+      "lower(varchar) flat simplified: 13.00 ns/row, was 10.00 ns/row");
+}
+
+TEST_F(ExpressionPerfFuzzerUnitTest, findEncodingOutliers) {
+  ExpressionPerfFuzzer fuzzer({}, smallOptions(), 1);
+  std::vector<Result> results = {
+      {"lower", "(varchar)", Encoding::kFlat, false, 10},
+      {"lower", "(varchar)", Encoding::kConstant, false, 0.1},
+      {"lower", "(varchar)", Encoding::kDictionary, false, 12},
+      {"lower", "(varchar)", Encoding::kDictionary, true, 12},
+      {"rand", "()", Encoding::kFlat, false, 10, false},
+      {"rand", "()", Encoding::kDictionary, false, 20, false},
+  };
+  // The simplified evaluator and non-deterministic functions have no fast
+  // paths to check.
+  auto outliers = fuzzer.findEncodingOutliers(results);
+  ASSERT_EQ(outliers.size(), 1);
+  EXPECT_EQ(
+      outliers[0],
+      "lower(varchar) dictionary common: 12.00 ns/row, flat 10.00 ns/row");
+}
+
+} // namespace
+} // namespace facebook::velox::test
@@ -1131,6 +1131,79 @@ TEST_F(SimpleFunctionTest, testAllNotNull) {
   assertEqualVectors(expected, result);
 }
 
+template <typename T>
+struct VectorizedPlusFunction {
+  static constexpr bool is_vectorizable = true;
+
+  void call(int64_t& out, int64_t a, int64_t b) {
+    out = a + b;
+  }
+};
+
+template <typename T>
+struct VectorizedLessThanFunction {
+  static constexpr bool is_vectorizable = true;
+
+  void call(bool& out, int64_t a, int64_t b) {
+    out = a < b;
+  }
+};
+
+// Vectorizable functions on flat and constant inputs without nulls run in a
+// dense loop. Inputs with nulls or partially selected rows take the per-row
+// path.
+TEST_F(SimpleFunctionTest, vectorized) {
+  registerFunction<VectorizedPlusFunction, int64_t, int64_t, int64_t>(
+      {"vectorized_plus"});
+  registerFunction<VectorizedLessThanFunction, bool, int64_t, int64_t>(
+      {"vectorized_lt"});
+  static_assert(core::UDFHolder<
+                VectorizedLessThanFunction<exec::VectorExec>,
+                exec::VectorExec,
+                bool,
+                int64_t,
+                int64_t>::is_vectorizable);
+
+  // Not a multiple of 64 to cover the partial last word of boolean results.
+  constexpr vector_size_t kSize = 1'001;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row % 7 * 100; }),
+      makeFlatVector<int64_t>(
+          kSize, [](auto row) { return row; }, nullEvery(5)),
+  });
+
+  auto result = evaluate("vectorized_plus(c0, c1)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          kSize, [](auto row) { return row + row % 7 * 100; }),
+      result);
+
+  result = evaluate("vectorized_lt(c0, c1)", data);
+  assertEqualVectors(
+      makeFlatVector<bool>(kSize, [](auto row) { return row < row % 7 * 100; }),
+      result);
+
+  result = evaluate("vectorized_lt(c0, 500)", data);
+  assertEqualVectors(
+      makeFlatVector<bool>(kSize, [](auto row) { return row < 500; }), result);
+
+  result = evaluate("vectorized_lt(c2, c1)", data);
+  assertEqualVectors(
+      makeFlatVector<bool>(
+          kSize,
+          [](auto row) { return row < row % 7 * 100; },
+          nullEvery(5)),
+      result);
+
+  result = evaluate("if (c0 % 3 = 0, vectorized_lt(c0, c1), true)", data);
+  assertEqualVectors(
+      makeFlatVector<bool>(
+          kSize,
+          [](auto row) { return row % 3 != 0 || row < row % 7 * 100; }),
+      result);
+}
+
 // Test that SimpleFunctionRegistry does not crash in multithreaded environment.
 TEST_F(SimpleFunctionTest, simpleFunctionRegistryThreadSafe) {
   std::vector<std::thread> threads;
@@ -1156,4 +1229,49 @@ TEST_F(SimpleFunctionTest, simpleFunctionRegistryThreadSafe) {
     th.join();
   }
 }
+
+template <typename T>
+struct ReturnOneFunction {
+  void call(int64_t& out, const int64_t&) {
+    out = 1;
+  }
+};
+
+template <typename T>
+struct ReturnTwoFunction {
+  void call(int64_t& out, const int64_t&) {
+    out = 2;
+  }
+};
+
+template <typename T>
+struct ReturnThreeFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  void call(int64_t& out, const arg_type<Varchar>&) {
+    out = 3;
+  }
+};
+
+// Verifies that cached resolutions are dropped when functions are registered.
+TEST_F(SimpleFunctionTest, resolutionCache) {
+  const std::string name = "resolution_cache_test";
+  registerFunction<ReturnOneFunction, int64_t, int64_t>({name});
+  EXPECT_FALSE(
+      exec::simpleFunctions().resolveFunction(name, {VARCHAR()}).has_value());
+
+  auto data = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+  auto result = evaluate(fmt::format("{}(c0)", name), data);
+  assertEqualVectors(makeFlatVector<int64_t>({1, 1, 1}), result);
+
+  // Replaces the function for BIGINT and adds one for VARCHAR.
+  registerFunction<ReturnTwoFunction, int64_t, int64_t>({name});
+  registerFunction<ReturnThreeFunction, int64_t, Varchar>({name});
+  result = evaluate(fmt::format("{}(c0)", name), data);
+  assertEqualVectors(makeFlatVector<int64_t>({2, 2, 2}), result);
+
+  auto resolved = exec::simpleFunctions().resolveFunction(name, {VARCHAR()});
+  ASSERT_TRUE(resolved.has_value());
+  EXPECT_EQ(*resolved->type(), *BIGINT());
+}
 } // namespace
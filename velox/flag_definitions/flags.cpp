@@ -91,6 +91,11 @@ DEFINE_bool(
     false,
     "If true, 'MemoryPool' will be running in debug mode to track the allocation and free call sites to detect the source of memory leak for testing purpose");
 
+DEFINE_uint64(
+    velox_memory_pool_profile_sample_bytes,
+    0,
+    "If not zero, 'MemoryPool' samples the call stack of a memory reservation on average every this number of bytes reserved by a thread, and aggregates the samples per memory pool for allocation-site profiling");
+
 // TODO: deprecate this after solves all the use cases that can cause
 // significant performance regression by memory usage tracking.
 DEFINE_bool(
@@ -105,3 +110,10 @@ DEFINE_bool(
     "exception. This is only used by test to control the test error output size");
 
 DEFINE_bool(velox_memory_use_hugepages, true, "Use explicit huge pages");
+
+DEFINE_int64(
+    velox_memory_huge_page_threshold_bytes,
+    2 << 20,
+    "Contiguous allocations of at least this many bytes are aligned to huge "
+    "pages and advised to be backed by transparent huge pages if "
+    "velox_memory_use_hugepages is true");
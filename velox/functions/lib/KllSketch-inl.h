@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <queue>
 #include <type_traits>
@@ -293,6 +294,46 @@ void KllSketch<T, A, C>::insert(T value) {
   doInsert(value);
 }
 
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::insert(folly::Range<const T*> values) {
+  if (values.empty()) {
+    return;
+  }
+  auto [minIt, maxIt] = std::minmax_element(values.begin(), values.end(), C());
+  if (n_ == 0) {
+    minValue_ = *minIt;
+    maxValue_ = *maxIt;
+  } else {
+    minValue_ = std::min(minValue_, *minIt, C());
+    maxValue_ = std::max(maxValue_, *maxIt, C());
+  }
+  VELOX_DCHECK_GT(k_, 0);
+  VELOX_DCHECK_GE(levels_.size(), 2);
+  size_t i = 0;
+  if (items_.size() < k_ && numLevels() == 1) {
+    const auto count = std::min<size_t>(k_ - items_.size(), values.size());
+    items_.insert(items_.end(), values.begin(), values.begin() + count);
+    levels_[1] += count;
+    i = count;
+  }
+  while (i < values.size()) {
+    // Compacts if level zero is full.
+    items_[insertPosition()] = values[i++];
+    // The slots below level zero are free. The values are copied in reverse,
+    // as insert(T) would place them, since the compaction keeps the last
+    // inserted value of an odd sized level zero.
+    const auto count = std::min<size_t>(levels_[0], values.size() - i);
+    levels_[0] -= count;
+    std::reverse_copy(
+        values.begin() + i,
+        values.begin() + i + count,
+        items_.begin() + levels_[0]);
+    i += count;
+  }
+  n_ += values.size();
+  isLevelZeroSorted_ = false;
+}
+
 template <typename T, typename A, typename C>
 void KllSketch<T, A, C>::doInsert(T value) {
   VELOX_DCHECK_GT(k_, 0);
@@ -60,6 +60,11 @@ struct KllSketch {
   /// Add one new value to the sketch.
   void insert(T value);
 
+  /// Add multiple new values to the sketch.  This is more efficient
+  /// than calling insert(T) repeatedly, since the values are copied to
+  /// level 0 in bulk between compactions.
+  void insert(folly::Range<const T*> values);
+
   /// Call this before serialization can optimize the space used.
   void compact();
 
@@ -15,11 +15,15 @@
  */
 #include "velox/functions/lib/Re2Functions.h"
 
+#include <folly/container/EvictingCacheMap.h>
 #include <re2/re2.h>
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/VectorWriters.h"
 #include "velox/type/StringView.h"
 #include "velox/vector/BaseVector.h"
@@ -35,6 +39,9 @@ using ::re2::RE2;
 
 static const int kMaxCompiledRegexes = 20;
 
+// Number of compiled regular expressions kept by getCachedRe2().
+static const int kMaxCachedRegexes = 256;
+
 std::string printTypesCsv(
     const std::vector<exec::VectorFunctionArg>& inputArgs) {
   std::string result;
@@ -51,6 +58,11 @@ re2::StringPiece toStringPiece(const T& s) {
   return re2::StringPiece(s.data(), s.size());
 }
 
+template <typename T>
+std::string_view toStringView(const T& s) {
+  return std::string_view(s.data(), s.size());
+}
+
 // If v is a non-null constant vector, returns the constant value. Otherwise
 // returns nullopt.
 template <typename T>
@@ -185,7 +197,7 @@ template <bool (*Fn)(StringView, const RE2&)>
 class Re2MatchConstantPattern final : public VectorFunction {
  public:
   explicit Re2MatchConstantPattern(StringView pattern)
-      : re_(toStringPiece(pattern), RE2::Quiet) {}
+      : re_(getCachedRe2(toStringView(pattern))) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -197,19 +209,19 @@ class Re2MatchConstantPattern final : public VectorFunction {
     FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
     exec::LocalDecodedVector toSearch(context, *args[0], rows);
     try {
-      checkForBadPattern(re_);
+      checkForBadPattern(*re_);
     } catch (const std::exception& e) {
       context.setErrors(rows, std::current_exception());
       return;
     }
 
     context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
-      result.set(i, Fn(toSearch->valueAt<StringView>(i), re_));
+      result.set(i, Fn(toSearch->valueAt<StringView>(i), *re_));
     });
   }
 
  private:
-  RE2 re_;
+  std::shared_ptr<const RE2> re_;
 };
 
 template <bool (*Fn)(StringView, const RE2&)>
@@ -232,9 +244,9 @@ class Re2Match final : public VectorFunction {
     exec::LocalDecodedVector toSearch(context, *args[0], rows);
     exec::LocalDecodedVector pattern(context, *args[1], rows);
     context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
-      RE2 re(toStringPiece(pattern->valueAt<StringView>(row)), RE2::Quiet);
-      checkForBadPattern(re);
-      result.set(row, Fn(toSearch->valueAt<StringView>(row), re));
+      auto re = getCachedRe2(toStringView(pattern->valueAt<StringView>(row)));
+      checkForBadPattern(*re);
+      result.set(row, Fn(toSearch->valueAt<StringView>(row), *re));
     });
   }
 };
@@ -251,7 +263,8 @@ class Re2SearchAndExtractConstantPattern final : public VectorFunction {
   explicit Re2SearchAndExtractConstantPattern(
       StringView pattern,
       bool emptyNoMatch)
-      : re_(toStringPiece(pattern), RE2::Quiet), emptyNoMatch_(emptyNoMatch) {}
+      : re_(getCachedRe2(toStringView(pattern))),
+        emptyNoMatch_(emptyNoMatch) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -266,7 +279,7 @@ class Re2SearchAndExtractConstantPattern final : public VectorFunction {
 
     // apply() will not be invoked if the selection is empty.
     try {
-      checkForBadPattern(re_);
+      checkForBadPattern(*re_);
     } catch (const std::exception& e) {
       context.setErrors(rows, std::current_exception());
       return;
@@ -280,7 +293,7 @@ class Re2SearchAndExtractConstantPattern final : public VectorFunction {
       groups.resize(1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
         mustRefSourceStrings |=
-            re2Extract(result, i, re_, toSearch, groups, 0, emptyNoMatch_);
+            re2Extract(result, i, *re_, toSearch, groups, 0, emptyNoMatch_);
       });
       if (mustRefSourceStrings) {
         result.acquireSharedStringBuffers(toSearch->base());
@@ -290,7 +303,7 @@ class Re2SearchAndExtractConstantPattern final : public VectorFunction {
 
     if (const auto groupId = getIfConstant<T>(*args[2])) {
       try {
-        checkForBadGroupId(*groupId, re_);
+        checkForBadGroupId(*groupId, *re_);
       } catch (const std::exception& e) {
         context.setErrors(rows, std::current_exception());
         return;
@@ -299,7 +312,7 @@ class Re2SearchAndExtractConstantPattern final : public VectorFunction {
       groups.resize(*groupId + 1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
         mustRefSourceStrings |= re2Extract(
-            result, i, re_, toSearch, groups, *groupId, emptyNoMatch_);
+            result, i, *re_, toSearch, groups, *groupId, emptyNoMatch_);
       });
       if (mustRefSourceStrings) {
         result.acquireSharedStringBuffers(toSearch->base());
@@ -311,12 +324,12 @@ class Re2SearchAndExtractConstantPattern final : public VectorFunction {
     // number of capturing groups + 1.
     exec::LocalDecodedVector groupIds(context, *args[2], rows);
 
-    groups.resize(re_.NumberOfCapturingGroups() + 1);
+    groups.resize(re_->NumberOfCapturingGroups() + 1);
     context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
       T group = groupIds->valueAt<T>(i);
-      checkForBadGroupId(group, re_);
+      checkForBadGroupId(group, *re_);
       mustRefSourceStrings |=
-          re2Extract(result, i, re_, toSearch, groups, group, emptyNoMatch_);
+          re2Extract(result, i, *re_, toSearch, groups, group, emptyNoMatch_);
     });
     if (mustRefSourceStrings) {
       result.acquireSharedStringBuffers(toSearch->base());
@@ -324,7 +337,7 @@ class Re2SearchAndExtractConstantPattern final : public VectorFunction {
   }
 
  private:
-  RE2 re_;
+  std::shared_ptr<const RE2> re_;
   const bool emptyNoMatch_;
 }; // namespace
 
@@ -360,21 +373,21 @@ class Re2SearchAndExtract final : public VectorFunction {
     if (args.size() == 2) {
       groups.resize(1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
-        RE2 re(toStringPiece(pattern->valueAt<StringView>(i)), RE2::Quiet);
-        checkForBadPattern(re);
+        auto re = getCachedRe2(toStringView(pattern->valueAt<StringView>(i)));
+        checkForBadPattern(*re);
         mustRefSourceStrings |=
-            re2Extract(result, i, re, toSearch, groups, 0, emptyNoMatch_);
+            re2Extract(result, i, *re, toSearch, groups, 0, emptyNoMatch_);
       });
     } else {
       exec::LocalDecodedVector groupIds(context, *args[2], rows);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
         const auto groupId = groupIds->valueAt<T>(i);
-        RE2 re(toStringPiece(pattern->valueAt<StringView>(i)), RE2::Quiet);
-        checkForBadPattern(re);
-        checkForBadGroupId(groupId, re);
+        auto re = getCachedRe2(toStringView(pattern->valueAt<StringView>(i)));
+        checkForBadPattern(*re);
+        checkForBadGroupId(groupId, *re);
         groups.resize(groupId + 1);
-        mustRefSourceStrings |=
-            re2Extract(result, i, re, toSearch, groups, groupId, emptyNoMatch_);
+        mustRefSourceStrings |= re2Extract(
+            result, i, *re, toSearch, groups, groupId, emptyNoMatch_);
       });
     }
     if (mustRefSourceStrings) {
@@ -416,6 +429,20 @@ bool matchSuffixPattern(
           length) == 0;
 }
 
+// Match string 'input' with a substring pattern, i.e. a fixed pattern of
+// 'length' characters surrounded by '%'.
+bool matchSubstringPattern(
+    StringView input,
+    StringView pattern,
+    vector_size_t length) {
+  const char* fixed = pattern.data();
+  while (*fixed == '%') {
+    ++fixed;
+  }
+  return simd::simdStrstr(input.data(), input.size(), fixed, length) !=
+      std::string::npos;
+}
+
 template <PatternKind P>
 class OptimizedLikeWithMemcmp final : public VectorFunction {
  public:
@@ -439,6 +466,8 @@ class OptimizedLikeWithMemcmp final : public VectorFunction {
         return matchPrefixPattern(input, pattern, reducedPatternLength);
       case PatternKind::kSuffix:
         return matchSuffixPattern(input, pattern, reducedPatternLength);
+      case PatternKind::kSubstring:
+        return matchSubstringPattern(input, pattern, reducedPatternLength);
     }
   }
 
@@ -484,11 +513,8 @@ class OptimizedLikeWithMemcmp final : public VectorFunction {
 class LikeWithRe2 final : public VectorFunction {
  public:
   LikeWithRe2(StringView pattern, std::optional<char> escapeChar) {
-    RE2::Options opt{RE2::Quiet};
-    opt.set_dot_nl(true);
-    re_.emplace(
-        toStringPiece(likePatternToRe2(pattern, escapeChar, validPattern_)),
-        opt);
+    re_ = getCachedRe2(
+        likePatternToRe2(pattern, escapeChar, validPattern_), true);
   }
 
   void apply(
@@ -540,7 +566,7 @@ class LikeWithRe2 final : public VectorFunction {
   }
 
  private:
-  std::optional<RE2> re_;
+  std::shared_ptr<const RE2> re_;
   bool validPattern_;
 };
 
@@ -560,23 +586,24 @@ class LikeGeneric final : public VectorFunction {
     auto applyWithRegex = [&](const StringView& input,
                               const StringView& pattern,
                               const std::optional<char>& escapeChar) -> bool {
-      RE2::Options opt{RE2::Quiet};
-      opt.set_dot_nl(true);
-      bool validEscapeUsage;
-      auto regex = likePatternToRe2(pattern, escapeChar, validEscapeUsage);
-      VELOX_USER_CHECK(
-          validEscapeUsage,
-          "Escape character must be followed by '%', '_' or the escape character itself");
-
-      auto key =
-          std::pair<StringView, std::optional<char>>{pattern, escapeChar};
-
-      auto [it, inserted] = compiledRegularExpressions_.emplace(
-          key, std::make_unique<RE2>(toStringPiece(regex), opt));
-      VELOX_CHECK_LE(
-          compiledRegularExpressions_.size(),
-          kMaxCompiledRegexes,
-          "Max number of regex reached");
+      auto key = std::pair<std::string, std::optional<char>>{
+          std::string(pattern), escapeChar};
+
+      auto it = compiledRegularExpressions_.find(key);
+      if (it == compiledRegularExpressions_.end()) {
+        bool validEscapeUsage;
+        auto regex = likePatternToRe2(pattern, escapeChar, validEscapeUsage);
+        VELOX_USER_CHECK(
+            validEscapeUsage,
+            "Escape character must be followed by '%', '_' or the escape character itself");
+        VELOX_CHECK_LT(
+            compiledRegularExpressions_.size(),
+            kMaxCompiledRegexes,
+            "Max number of regex reached");
+        it = compiledRegularExpressions_
+                 .emplace(std::move(key), getCachedRe2(regex, true))
+                 .first;
+      }
       checkForBadPattern(*it->second);
       return re2FullMatch(input, *it->second);
     };
@@ -605,6 +632,9 @@ class LikeGeneric final : public VectorFunction {
           case PatternKind::kSuffix:
             return OptimizedLikeWithMemcmp<PatternKind::kSuffix>::match(
                 input, pattern, reducedLength);
+          case PatternKind::kSubstring:
+            return OptimizedLikeWithMemcmp<PatternKind::kSubstring>::match(
+                input, pattern, reducedLength);
           default:
             return applyWithRegex(input, pattern, escapeChar);
         }
@@ -648,10 +678,154 @@ class LikeGeneric final : public VectorFunction {
  private:
   mutable folly::F14FastMap<
       std::pair<std::string, std::optional<char>>,
-      std::unique_ptr<RE2>>
+      std::shared_ptr<const RE2>>
       compiledRegularExpressions_;
 };
 
+// The fixed strings of a pattern that has no '_' wildcard characters, in the
+// order they must appear in the input, separated by any number of characters.
+struct LikeLiterals {
+  std::vector<std::string> literals;
+  // True if the first literal must be at the start of the input, i.e. the
+  // pattern does not start with '%'.
+  bool anchoredStart{true};
+  // True if the last literal must be at the end of the input.
+  bool anchoredEnd{true};
+};
+
+// Splits 'pattern' at the '%' characters. Returns std::nullopt if the pattern
+// has an unescaped '_' or an invalid escape sequence.
+std::optional<LikeLiterals> parseLikeLiterals(
+    StringView pattern,
+    std::optional<char> escapeChar) {
+  LikeLiterals result;
+  std::string current;
+  bool lastIsWildcard = false;
+  const char* data = pattern.data();
+  const vector_size_t size = pattern.size();
+  for (vector_size_t i = 0; i < size; ++i) {
+    const char c = data[i];
+    if (escapeChar && c == *escapeChar) {
+      if (i + 1 == size ||
+          (data[i + 1] != '%' && data[i + 1] != '_' &&
+           data[i + 1] != *escapeChar)) {
+        return std::nullopt;
+      }
+      current.push_back(data[++i]);
+      lastIsWildcard = false;
+    } else if (c == '_') {
+      return std::nullopt;
+    } else if (c == '%') {
+      if (i == 0) {
+        result.anchoredStart = false;
+      }
+      if (!current.empty()) {
+        result.literals.push_back(std::move(current));
+        current.clear();
+      }
+      lastIsWildcard = true;
+    } else {
+      current.push_back(c);
+      lastIsWildcard = false;
+    }
+  }
+  if (!current.empty()) {
+    result.literals.push_back(std::move(current));
+  }
+  result.anchoredEnd = !lastIsWildcard;
+  return result;
+}
+
+// This function is used when pattern and escape are constants and the pattern
+// has no '_' wildcard characters, e.g. '%special%requests%' or 'a\%%' with
+// escape character '\'. Matches the literals left to right with SIMD
+// substring search instead of running a regular expression. Taking the
+// leftmost occurrence of each literal is always correct since '%' matches any
+// number of characters.
+class LikeWithLiterals final : public VectorFunction {
+ public:
+  explicit LikeWithLiterals(LikeLiterals literals)
+      : literals_(std::move(literals)) {}
+
+  bool match(StringView input) const {
+    const auto& literals = literals_.literals;
+    if (literals.empty()) {
+      // The pattern is either empty or consists of '%' only.
+      return !literals_.anchoredStart || input.size() == 0;
+    }
+    const char* data = input.data();
+    size_t begin = 0;
+    size_t end = input.size();
+    size_t first = 0;
+    size_t last = literals.size();
+    if (literals_.anchoredStart) {
+      const auto& prefix = literals.front();
+      if (end < prefix.size() ||
+          std::memcmp(data, prefix.data(), prefix.size()) != 0) {
+        return false;
+      }
+      begin = prefix.size();
+      first = 1;
+    }
+    if (literals_.anchoredEnd) {
+      if (first == last) {
+        return begin == end;
+      }
+      const auto& suffix = literals.back();
+      if (end - begin < suffix.size() ||
+          std::memcmp(
+              data + end - suffix.size(), suffix.data(), suffix.size()) != 0) {
+        return false;
+      }
+      end -= suffix.size();
+      --last;
+    }
+    for (auto i = first; i < last; ++i) {
+      const auto& literal = literals[i];
+      const auto pos = simd::simdStrstr(
+          data + begin, end - begin, literal.data(), literal.size());
+      if (pos == std::string::npos) {
+        return false;
+      }
+      begin += pos + literal.size();
+    }
+    return true;
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /* outputType */,
+      EvalCtx& context,
+      VectorPtr& resultRef) const final {
+    VELOX_CHECK(args.size() == 2 || args.size() == 3);
+    FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
+    exec::DecodedArgs decodedArgs(rows, args, context);
+    auto toSearch = decodedArgs.at(0);
+
+    if (toSearch->isIdentityMapping()) {
+      auto input = toSearch->data<StringView>();
+      context.applyToSelectedNoThrow(
+          rows, [&](vector_size_t i) { result.set(i, match(input[i])); });
+      return;
+    }
+    if (toSearch->isConstantMapping()) {
+      bool matchResult = match(toSearch->valueAt<StringView>(0));
+      context.applyToSelectedNoThrow(
+          rows, [&](vector_size_t i) { result.set(i, matchResult); });
+      return;
+    }
+
+    // Since the likePattern and escapeChar (2nd and 3rd args) are both
+    // constants, so the first arg is expected to be either of flat or constant
+    // vector only. This code path is unreachable.
+    VELOX_UNREACHABLE();
+  }
+
+ private:
+  const LikeLiterals literals_;
+};
+
 void re2ExtractAll(
     exec::VectorWriter<Array<Varchar>>& resultWriter,
     const RE2& re,
@@ -689,7 +863,7 @@ template <typename T>
 class Re2ExtractAllConstantPattern final : public VectorFunction {
  public:
   explicit Re2ExtractAllConstantPattern(StringView pattern)
-      : re_(toStringPiece(pattern), RE2::Quiet) {}
+      : re_(getCachedRe2(toStringView(pattern))) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -699,7 +873,7 @@ class Re2ExtractAllConstantPattern final : public VectorFunction {
       VectorPtr& resultRef) const final {
     VELOX_CHECK(args.size() == 2 || args.size() == 3);
     try {
-      checkForBadPattern(re_);
+      checkForBadPattern(*re_);
     } catch (const std::exception& e) {
       context.setErrors(rows, std::current_exception());
       return;
@@ -718,13 +892,13 @@ class Re2ExtractAllConstantPattern final : public VectorFunction {
       //
       groups.resize(1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
-        re2ExtractAll(resultWriter, re_, inputStrs, row, groups, 0);
+        re2ExtractAll(resultWriter, *re_, inputStrs, row, groups, 0);
       });
     } else if (const auto _groupId = getIfConstant<T>(*args[2])) {
       // Case 2: Constant groupId
       //
       try {
-        checkForBadGroupId(*_groupId, re_);
+        checkForBadGroupId(*_groupId, *re_);
       } catch (const std::exception& e) {
         context.setErrors(rows, std::current_exception());
         return;
@@ -732,18 +906,18 @@ class Re2ExtractAllConstantPattern final : public VectorFunction {
 
       groups.resize(*_groupId + 1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
-        re2ExtractAll(resultWriter, re_, inputStrs, row, groups, *_groupId);
+        re2ExtractAll(resultWriter, *re_, inputStrs, row, groups, *_groupId);
       });
     } else {
       // Case 3: Variable groupId, so resize the groups vector to accommodate
       // number of capturing groups + 1.
       exec::LocalDecodedVector groupIds(context, *args[2], rows);
 
-      groups.resize(re_.NumberOfCapturingGroups() + 1);
+      groups.resize(re_->NumberOfCapturingGroups() + 1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
         const T groupId = groupIds->valueAt<T>(row);
-        checkForBadGroupId(groupId, re_);
-        re2ExtractAll(resultWriter, re_, inputStrs, row, groups, groupId);
+        checkForBadGroupId(groupId, *re_);
+        re2ExtractAll(resultWriter, *re_, inputStrs, row, groups, groupId);
       });
     }
 
@@ -756,7 +930,7 @@ class Re2ExtractAllConstantPattern final : public VectorFunction {
   }
 
  private:
-  RE2 re_;
+  std::shared_ptr<const RE2> re_;
 };
 
 template <typename T>
@@ -791,9 +965,9 @@ class Re2ExtractAll final : public VectorFunction {
       //
       groups.resize(1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
-        RE2 re(toStringPiece(pattern->valueAt<StringView>(row)), RE2::Quiet);
-        checkForBadPattern(re);
-        re2ExtractAll(resultWriter, re, inputStrs, row, groups, 0);
+        auto re = getCachedRe2(toStringView(pattern->valueAt<StringView>(row)));
+        checkForBadPattern(*re);
+        re2ExtractAll(resultWriter, *re, inputStrs, row, groups, 0);
       });
     } else {
       // Case 2: Has groupId
@@ -801,11 +975,11 @@ class Re2ExtractAll final : public VectorFunction {
       exec::LocalDecodedVector groupIds(context, *args[2], rows);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
         const T groupId = groupIds->valueAt<T>(row);
-        RE2 re(toStringPiece(pattern->valueAt<StringView>(row)), RE2::Quiet);
-        checkForBadPattern(re);
-        checkForBadGroupId(groupId, re);
+        auto re = getCachedRe2(toStringView(pattern->valueAt<StringView>(row)));
+        checkForBadPattern(*re);
+        checkForBadGroupId(groupId, *re);
         groups.resize(groupId + 1);
-        re2ExtractAll(resultWriter, re, inputStrs, row, groups, groupId);
+        re2ExtractAll(resultWriter, *re, inputStrs, row, groups, groupId);
       });
     }
 
@@ -960,6 +1134,33 @@ std::vector<std::shared_ptr<exec::FunctionSignature>> re2ExtractSignatures() {
   };
 }
 
+std::shared_ptr<const RE2> getCachedRe2(std::string_view pattern, bool dotNl) {
+  static std::mutex mutex;
+  static folly::EvictingCacheMap<std::string, std::shared_ptr<const RE2>>
+      cache(kMaxCachedRegexes);
+
+  std::string key;
+  key.reserve(pattern.size() + 1);
+  key.push_back(dotNl ? '1' : '0');
+  key.append(pattern);
+  {
+    std::lock_guard<std::mutex> l(mutex);
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+      return it->second;
+    }
+  }
+
+  // Compile outside of the mutex. If two threads compile the same pattern,
+  // the last one replaces the first one in the cache, which is harmless.
+  RE2::Options opt{RE2::Quiet};
+  opt.set_dot_nl(dotNl);
+  auto re = std::make_shared<const RE2>(toStringPiece(pattern), opt);
+  std::lock_guard<std::mutex> l(mutex);
+  cache.set(key, re);
+  return re;
+}
+
 std::pair<PatternKind, vector_size_t> determinePatternKind(StringView pattern) {
   vector_size_t patternLength = pattern.size();
   vector_size_t i = 0;
@@ -973,6 +1174,26 @@ std::pair<PatternKind, vector_size_t> determinePatternKind(StringView pattern) {
   vector_size_t singleCharacterWildcardCount = 0;
   auto patternStr = pattern.data();
 
+  // Pattern is a substring pattern if it starts and ends with '%' and has
+  // no wildcard characters other than the leading and trailing '%'.
+  if (patternLength > 2 && patternStr[0] == '%' &&
+      patternStr[patternLength - 1] == '%') {
+    vector_size_t start = 0;
+    vector_size_t end = patternLength;
+    while (start < end && patternStr[start] == '%') {
+      start++;
+    }
+    while (end > start && patternStr[end - 1] == '%') {
+      end--;
+    }
+    if (start < end &&
+        std::none_of(patternStr + start, patternStr + end, [](char c) {
+          return c == '%' || c == '_';
+        })) {
+      return {PatternKind::kSubstring, end - start};
+    }
+  }
+
   while (i < patternLength) {
     if (patternStr[i] == '%' || patternStr[i] == '_') {
       // Ensures that pattern has a single contiguous stream of wildcard
@@ -1090,12 +1311,18 @@ std::shared_ptr<exec::VectorFunction> makeLike(
       case PatternKind::kSuffix:
         return std::make_shared<OptimizedLikeWithMemcmp<PatternKind::kSuffix>>(
             pattern, reducedLength);
+      case PatternKind::kSubstring:
+        return std::make_shared<
+            OptimizedLikeWithMemcmp<PatternKind::kSubstring>>(
+            pattern, reducedLength);
       default:
-
-        return std::make_shared<LikeWithRe2>(pattern, escapeChar);
+        break;
     }
   }
 
+  if (auto literals = parseLikeLiterals(pattern, escapeChar)) {
+    return std::make_shared<LikeWithLiterals>(std::move(*literals));
+  }
   return std::make_shared<LikeWithRe2>(pattern, escapeChar);
 }
 
@@ -39,6 +39,9 @@ enum class PatternKind {
   kPrefix,
   /// Fixed pattern preceded by one or more '%', such as '%foo', '%%%hello'.
   kSuffix,
+  /// Fixed pattern preceded and followed by one or more '%', such as '%foo%',
+  /// '%%hello%'.
+  kSubstring,
   /// Patterns which do not fit any of the above types, such as 'hello_world',
   /// '_presto%'.
   kGeneric,
@@ -99,11 +102,21 @@ std::shared_ptr<exec::VectorFunction> makeRe2Extract(
 std::vector<std::shared_ptr<exec::FunctionSignature>> re2ExtractSignatures();
 
 /// Return the pair {pattern kind, length of the fixed pattern} for fixed,
-/// prefix, and suffix patterns. Return the pair {pattern kind, number of '_'
-/// characters} for patterns with wildcard characters only. Return
-/// {kGenericPattern, 0} for generic patterns).
+/// prefix, suffix and substring patterns. Return the pair {pattern kind,
+/// number of '_' characters} for patterns with wildcard characters only.
+/// Return {kGenericPattern, 0} for generic patterns).
 std::pair<PatternKind, vector_size_t> determinePatternKind(StringView pattern);
 
+/// Returns the compiled regular expression for 'pattern' from a process wide
+/// cache of recently used expressions. RE2 objects are thread-safe for
+/// matching, so the same object is shared by all functions and drivers that
+/// use the same pattern, which saves recompiling a pattern per function
+/// instance or per row. The result may be an invalid expression, which the
+/// caller checks with ok(). 'dotNl' sets RE2::Options::dot_nl.
+std::shared_ptr<const re2::RE2> getCachedRe2(
+    std::string_view pattern,
+    bool dotNl = false);
+
 std::shared_ptr<exec::VectorFunction> makeLike(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs,
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/lib/SparkHash.h"
+
+#include <xsimd/xsimd.hpp>
+
+namespace facebook::velox::functions {
+namespace {
+
+// Hashes the non-null 'rows' of 'values' with 'hashFn(value, seed)'. Flat
+// columns without nulls are hashed in a loop over the raw values, which the
+// compiler can unroll and vectorize.
+template <typename T, typename THash, typename HashFn>
+void hashColumn(
+    const DecodedVector& values,
+    const SelectivityVector& rows,
+    THash* hashes,
+    HashFn hashFn) {
+  // Flat booleans are bits.
+  if constexpr (!std::is_same_v<T, bool>) {
+    if (values.isIdentityMapping() && !values.mayHaveNulls()) {
+      const auto* rawValues = values.data<T>();
+      if (rows.isAllSelected()) {
+        const auto numRows = rows.end();
+        for (vector_size_t row = 0; row < numRows; ++row) {
+          hashes[row] = hashFn(rawValues[row], hashes[row]);
+        }
+      } else {
+        rows.applyToSelected([&](auto row) {
+          hashes[row] = hashFn(rawValues[row], hashes[row]);
+        });
+      }
+      return;
+    }
+  }
+  rows.applyToSelected([&](auto row) {
+    if (!values.isNullAt(row)) {
+      hashes[row] = hashFn(values.valueAt<T>(row), hashes[row]);
+    }
+  });
+}
+
+// Sets 'hashes[i]' to the murmur3 hash of 'values[i]' with 'hashes[i]' as
+// seed for i in [0, size). Same as SparkMurmur3Hash::hashInt32() a batch of
+// values at a time.
+void murmur3Int32(const int32_t* values, vector_size_t size, uint32_t* hashes) {
+  using Batch = xsimd::batch<uint32_t>;
+  constexpr int32_t kBatchSize = Batch::size;
+  const Batch c1(0xcc9e2d51);
+  const Batch c2(0x1b873593);
+  const Batch m(5);
+  const Batch n(0xe6546b64);
+  const Batch length(4);
+  const Batch f1(0x85ebca6b);
+  const Batch f2(0xc2b2ae35);
+  vector_size_t i = 0;
+  for (; i + kBatchSize <= size; i += kBatchSize) {
+    // mixK1.
+    auto k1 =
+        Batch::load_unaligned(reinterpret_cast<const uint32_t*>(values + i));
+    k1 *= c1;
+    k1 = (k1 << 15) | (k1 >> 17);
+    k1 *= c2;
+    // mixH1.
+    auto h1 = Batch::load_unaligned(hashes + i) ^ k1;
+    h1 = (h1 << 13) | (h1 >> 19);
+    h1 = h1 * m + n;
+    // fmix.
+    h1 ^= length;
+    h1 ^= h1 >> 16;
+    h1 *= f1;
+    h1 ^= h1 >> 13;
+    h1 *= f2;
+    h1 ^= h1 >> 16;
+    h1.store_unaligned(hashes + i);
+  }
+  for (; i < size; ++i) {
+    hashes[i] = SparkMurmur3Hash::hashInt32(values[i], hashes[i]);
+  }
+}
+
+#define SPARK_HASH_CASE(typeKind, T, hashFn)                             \
+  case TypeKind::typeKind:                                               \
+    hashColumn<T>(                                                       \
+        values, rows, hashes, [](T v, auto s) { return hashFn(v, s); }); \
+    break;
+
+} // namespace
+
+bool isSparkHashSupported(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::HUGEINT:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Derived from InterpretedHashFunction.hash:
+// https://github.com/apache/spark/blob/382b66e/sql/catalyst/src/main/scala/org/apache/spark/sql/catalyst/expressions/hash.scala#L532
+void sparkMurmur3Hash(
+    const DecodedVector& values,
+    TypeKind kind,
+    const SelectivityVector& rows,
+    uint32_t* hashes) {
+  using Hash = SparkMurmur3Hash;
+  switch (kind) {
+    case TypeKind::INTEGER:
+      if (values.isIdentityMapping() && !values.mayHaveNulls() &&
+          rows.isAllSelected()) {
+        murmur3Int32(values.data<int32_t>(), rows.end(), hashes);
+      } else {
+        hashColumn<int32_t>(values, rows, hashes, Hash::hashInt32);
+      }
+      break;
+      SPARK_HASH_CASE(BOOLEAN, bool, Hash::hashInt32);
+      SPARK_HASH_CASE(TINYINT, int8_t, Hash::hashInt32);
+      SPARK_HASH_CASE(SMALLINT, int16_t, Hash::hashInt32);
+      SPARK_HASH_CASE(BIGINT, int64_t, Hash::hashInt64);
+      SPARK_HASH_CASE(VARCHAR, StringView, Hash::hashBytes);
+      SPARK_HASH_CASE(VARBINARY, StringView, Hash::hashBytes);
+      SPARK_HASH_CASE(REAL, float, Hash::hashFloat);
+      SPARK_HASH_CASE(DOUBLE, double, Hash::hashDouble);
+      SPARK_HASH_CASE(HUGEINT, int128_t, Hash::hashLongDecimal);
+      SPARK_HASH_CASE(TIMESTAMP, Timestamp, Hash::hashTimestamp);
+    default:
+      VELOX_NYI("Unsupported type for HASH(): {}", mapTypeKindToName(kind));
+  }
+}
+
+void sparkXxHash64(
+    const DecodedVector& values,
+    TypeKind kind,
+    const SelectivityVector& rows,
+    uint64_t* hashes) {
+  using Hash = SparkXxHash64;
+  switch (kind) {
+      SPARK_HASH_CASE(BOOLEAN, bool, Hash::hashInt32);
+      SPARK_HASH_CASE(TINYINT, int8_t, Hash::hashInt32);
+      SPARK_HASH_CASE(SMALLINT, int16_t, Hash::hashInt32);
+      SPARK_HASH_CASE(INTEGER, int32_t, Hash::hashInt32);
+      SPARK_HASH_CASE(BIGINT, int64_t, Hash::hashInt64);
+      SPARK_HASH_CASE(VARCHAR, StringView, Hash::hashBytes);
+      SPARK_HASH_CASE(VARBINARY, StringView, Hash::hashBytes);
+      SPARK_HASH_CASE(REAL, float, Hash::hashFloat);
+      SPARK_HASH_CASE(DOUBLE, double, Hash::hashDouble);
+      SPARK_HASH_CASE(HUGEINT, int128_t, Hash::hashLongDecimal);
+      SPARK_HASH_CASE(TIMESTAMP, Timestamp, Hash::hashTimestamp);
+    default:
+      VELOX_NYI("Unsupported type for XXHASH64(): {}", mapTypeKindToName(kind));
+  }
+}
+
+#undef SPARK_HASH_CASE
+
+} // namespace facebook::velox::functions
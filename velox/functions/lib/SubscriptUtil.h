@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <folly/hash/Hash.h>
+
+#include "velox/common/base/SimdUtil.h"
+#include "velox/common/memory/MemoryPool.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/type/Type.h"
@@ -29,6 +33,143 @@ const std::exception_ptr& zeroSubscriptError();
 const std::exception_ptr& badSubscriptError();
 const std::exception_ptr& negativeSubscriptError();
 
+namespace detail {
+
+template <typename T>
+constexpr bool kSimdMapKey = std::is_arithmetic_v<T> &&
+    !std::is_same_v<T, bool> && sizeof(T) <= sizeof(int64_t);
+
+// Returns the offset of the first key in [begin, end) of 'keys' that is equal
+// to 'key' or -1. Compares a SIMD batch of keys at a time.
+template <typename T>
+vector_size_t
+findKey(const T* keys, vector_size_t begin, vector_size_t end, T key) {
+  using Batch = xsimd::batch<T>;
+  const auto probe = Batch::broadcast(key);
+  auto offset = begin;
+  for (; offset + static_cast<vector_size_t>(Batch::size) <= end;
+       offset += Batch::size) {
+    const uint32_t matches =
+        simd::toBitMask(Batch::load_unaligned(keys + offset) == probe);
+    if (matches != 0) {
+      return offset + __builtin_ctz(matches);
+    }
+  }
+  for (; offset < end; ++offset) {
+    if (keys[offset] == key) {
+      return offset;
+    }
+  }
+  return -1;
+}
+
+// Returns the vector under the dictionary and constant wrappers of 'vector'
+// that is 'base' or nullptr if there is no such vector.
+inline const VectorPtr* findWrappedVector(
+    const VectorPtr& vector,
+    const BaseVector* base) {
+  const VectorPtr* current = &vector;
+  while (current->get() != base) {
+    const auto encoding = (*current)->encoding();
+    if (encoding != VectorEncoding::Simple::DICTIONARY &&
+        encoding != VectorEncoding::Simple::CONSTANT) {
+      return nullptr;
+    }
+    current = &(*current)->valueVector();
+    if (*current == nullptr) {
+      return nullptr;
+    }
+  }
+  return current;
+}
+
+} // namespace detail
+
+/// Hash table of the keys of all maps in a MapVector, for subscripts with
+/// constant keys that are repeated over the same large maps. Finds the same
+/// offset as a scan of the map, i.e. the first of duplicate keys. Floating
+/// point keys are not indexed, since == does not agree with the hash for NaN
+/// and -0.0, and boolean maps are too small to need it.
+template <typename TKey>
+class MapKeyIndex {
+ public:
+  static constexpr bool kSupported =
+      !std::is_floating_point_v<TKey> && !std::is_same_v<TKey, bool>;
+
+  MapKeyIndex(
+      const MapVector& map,
+      const DecodedVector& keys,
+      memory::MemoryPool& pool)
+      : slots_{memory::StlAllocator<Slot>(pool)} {
+    const auto* rawOffsets = map.rawOffsets();
+    const auto* rawSizes = map.rawSizes();
+    size_t numKeys = 0;
+    for (vector_size_t i = 0; i < map.size(); ++i) {
+      if (!map.isNullAt(i)) {
+        numKeys += rawSizes[i];
+      }
+    }
+    const auto size =
+        bits::nextPowerOfTwo(std::max<uint64_t>(16, numKeys * 2));
+    slots_.resize(size);
+    sizeMask_ = size - 1;
+    for (vector_size_t i = 0; i < map.size(); ++i) {
+      if (map.isNullAt(i)) {
+        continue;
+      }
+      const auto begin = rawOffsets[i];
+      const auto end = begin + rawSizes[i];
+      for (auto offset = begin; offset < end; ++offset) {
+        insert(i, keys.valueAt<TKey>(offset), offset);
+      }
+    }
+  }
+
+  /// Returns the offset of 'key' in the map at 'mapIndex' of the indexed
+  /// MapVector or -1.
+  vector_size_t find(vector_size_t mapIndex, const TKey& key) const {
+    for (auto slot = hashOf(mapIndex, key) & sizeMask_;;
+         slot = (slot + 1) & sizeMask_) {
+      const auto& entry = slots_[slot];
+      if (entry.offset == -1) {
+        return -1;
+      }
+      if (entry.mapIndex == mapIndex && entry.key == key) {
+        return entry.offset;
+      }
+    }
+  }
+
+ private:
+  struct Slot {
+    TKey key{};
+    vector_size_t mapIndex{0};
+    // Offset of 'key' in the keys of the MapVector. -1 if the slot is empty.
+    vector_size_t offset{-1};
+  };
+
+  static uint64_t hashOf(vector_size_t mapIndex, const TKey& key) {
+    return folly::hash::hash_128_to_64(folly::hasher<TKey>()(key), mapIndex);
+  }
+
+  void insert(vector_size_t mapIndex, const TKey& key, vector_size_t offset) {
+    for (auto slot = hashOf(mapIndex, key) & sizeMask_;;
+         slot = (slot + 1) & sizeMask_) {
+      auto& entry = slots_[slot];
+      if (entry.offset == -1) {
+        entry = {key, mapIndex, offset};
+        return;
+      }
+      if (entry.mapIndex == mapIndex && entry.key == key) {
+        return;
+      }
+    }
+  }
+
+  std::vector<Slot, memory::StlAllocator<Slot>> slots_;
+  uint64_t sizeMask_;
+};
+
 /// Generic subscript/element_at implementation for both array and map data
 /// types.
 ///
@@ -345,23 +486,35 @@ class SubscriptImpl : public exec::Subscript {
     auto rawSizes = baseMap->rawSizes();
     auto rawOffsets = baseMap->rawOffsets();
 
+    // Flat primitive keys are compared a SIMD batch at a time.
+    const TKey* rawMapKeys = nullptr;
+    if constexpr (detail::kSimdMapKey<TKey>) {
+      if (decodedMapKeys->isIdentityMapping()) {
+        rawMapKeys = decodedMapKeys->data<TKey>();
+      }
+    }
+
     // Lambda that does the search for a key, for each row.
     auto processRow = [&](vector_size_t row, TKey searchKey) {
-      size_t mapIndex = mapIndices[row];
-      size_t offsetStart = rawOffsets[mapIndex];
-      size_t offsetEnd = offsetStart + rawSizes[mapIndex];
-      bool found = false;
-
-      // Sequentially check each key on this map for a match. We use a
-      // sequential scan over the keys because it's easier to express (and
-      // likely has good memory locality), but if we find that this is slow
-      // for large maps we could try to canonicalize the whole vector and binary
-      // search `searchKey`.
-      for (size_t offset = offsetStart; offset < offsetEnd; ++offset) {
-        if (decodedMapKeys->valueAt<TKey>(offset) == searchKey) {
-          rawIndices[row] = offset;
-          found = true;
-          break;
+      const auto mapIndex = mapIndices[row];
+      const auto offsetStart = rawOffsets[mapIndex];
+      const auto offsetEnd = offsetStart + rawSizes[mapIndex];
+      vector_size_t found = -1;
+
+      // Sequentially check each key on this map for a match. Repeated
+      // subscripts of large maps use a MapKeyIndex instead.
+      if constexpr (detail::kSimdMapKey<TKey>) {
+        if (rawMapKeys != nullptr) {
+          found =
+              detail::findKey(rawMapKeys, offsetStart, offsetEnd, searchKey);
+        }
+      }
+      if (rawMapKeys == nullptr) {
+        for (auto offset = offsetStart; offset < offsetEnd; ++offset) {
+          if (decodedMapKeys->valueAt<TKey>(offset) == searchKey) {
+            found = offset;
+            break;
+          }
         }
       }
 
@@ -369,16 +522,30 @@ class SubscriptImpl : public exec::Subscript {
       // disabled for arrays.
 
       // Handle NULLs.
-      if (!found) {
+      if (found == -1) {
         nullsBuilder.setNull(row);
+      } else {
+        rawIndices[row] = found;
       }
     };
 
     // When second argument ("at") is a constant.
     if (decodedIndices->isConstantMapping()) {
       auto searchKey = decodedIndices->valueAt<TKey>(0);
-      rows.applyToSelected(
-          [&](vector_size_t row) { processRow(row, searchKey); });
+      if (auto* keyIndex = getMapKeyIndex<TKey>(
+              mapArg, *baseMap, *decodedMapKeys, context)) {
+        rows.applyToSelected([&](vector_size_t row) {
+          const auto found = keyIndex->find(mapIndices[row], searchKey);
+          if (found == -1) {
+            nullsBuilder.setNull(row);
+          } else {
+            rawIndices[row] = found;
+          }
+        });
+      } else {
+        rows.applyToSelected(
+            [&](vector_size_t row) { processRow(row, searchKey); });
+      }
     }
     // When the second argument ("at") is also a variable vector.
     else {
@@ -399,6 +566,44 @@ class SubscriptImpl : public exec::Subscript {
         nullsBuilder.build(), indices, rows.end(), baseMap->mapValues());
   }
 
+  // Maps with at least this many keys on average are indexed for repeated
+  // subscripts.
+  static constexpr vector_size_t kMinMapSizeForKeyIndex = 32;
+
+  // Returns the index of the keys of 'baseMap' if the maps are large and this
+  // is at least the second subscript with a constant key of 'baseMap' in the
+  // current batch. The index is kept in 'context' and reused by the following
+  // subscripts, also from other expressions. Returns nullptr if the maps
+  // should be scanned.
+  template <typename TKey>
+  static const MapKeyIndex<TKey>* getMapKeyIndex(
+      const VectorPtr& mapArg,
+      const MapVector& baseMap,
+      const DecodedVector& decodedMapKeys,
+      exec::EvalCtx& context) {
+    if constexpr (!MapKeyIndex<TKey>::kSupported) {
+      return nullptr;
+    } else {
+      if (baseMap.size() == 0 ||
+          baseMap.mapKeys()->size() / baseMap.size() < kMinMapSizeForKeyIndex) {
+        return nullptr;
+      }
+      const auto* base = detail::findWrappedVector(mapArg, &baseMap);
+      if (base == nullptr) {
+        return nullptr;
+      }
+      auto& inputState = context.functionInputState(*base);
+      if (inputState.numUses < 2) {
+        return nullptr;
+      }
+      if (inputState.state == nullptr) {
+        inputState.state = std::make_shared<MapKeyIndex<TKey>>(
+            baseMap, decodedMapKeys, *context.pool());
+      }
+      return static_cast<const MapKeyIndex<TKey>*>(inputState.state.get());
+    }
+  }
+
   VectorPtr applyMapComplexType(
       const SelectivityVector& rows,
       const VectorPtr& mapArg,
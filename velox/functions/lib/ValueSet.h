@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/hash/Hash.h>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
+
+namespace facebook::velox::functions {
+
+/// Set of the distinct values of one array at a time, reused for all the
+/// arrays of a batch. Replaces a hash set per row, which allocates and
+/// clears memory proportional to its capacity for every array.
+///
+/// The first kMaxLinear values are found by a linear scan, compared a SIMD
+/// batch at a time for primitive types, and only larger arrays use a linear
+/// probing hash table. The table marks its slots with a generation number, so
+/// that clear() takes constant time. Equality and hashing are the same
+/// as for folly::F14FastSet<T>.
+template <typename T>
+class ValueSet {
+ public:
+  static constexpr int32_t kMaxLinear = 16;
+
+  ValueSet() : values_(kMinValues) {}
+
+  /// Adds 'value' if it is not in the set. Returns the position of 'value'
+  /// in insertion order and true if it was added.
+  std::pair<int32_t, bool> insert(const T& value) {
+    auto position = find(value);
+    if (position != -1) {
+      return {position, false};
+    }
+    if (size_ == values_.size()) {
+      values_.resize(values_.size() * 2);
+    }
+    position = size_++;
+    values_[position] = value;
+    if (size_ == kMaxLinear + 1) {
+      rehash();
+    } else if (size_ > kMaxLinear) {
+      if (size_ * 2 > slots_.size()) {
+        rehash();
+      } else {
+        insertSlot(position);
+      }
+    }
+    return {position, true};
+  }
+
+  /// Returns the position of 'value' in insertion order or -1 if 'value' is
+  /// not in the set.
+  int32_t find(const T& value) const {
+    if (size_ <= kMaxLinear) {
+      return findLinear(value);
+    }
+    for (auto slot = hashOf(value) & sizeMask_;;
+         slot = (slot + 1) & sizeMask_) {
+      const auto& entry = slots_[slot];
+      if (entry.generation != generation_) {
+        return -1;
+      }
+      if (std::equal_to<T>{}(values_[entry.position], value)) {
+        return entry.position;
+      }
+    }
+  }
+
+  bool contains(const T& value) const {
+    return find(value) != -1;
+  }
+
+  /// Returns the value at 'position' in insertion order.
+  const T& valueAt(int32_t position) const {
+    return values_[position];
+  }
+
+  int32_t size() const {
+    return size_;
+  }
+
+  /// Empties the set in constant time. Keeps the memory for use by the next
+  /// array. The table is only used after rehash(), which starts a new
+  /// generation, so it needs no clearing here.
+  void clear() {
+    size_ = 0;
+  }
+
+ private:
+  static constexpr bool kSimd = std::is_arithmetic_v<T> &&
+      !std::is_same_v<T, bool> && sizeof(T) <= sizeof(int64_t);
+
+  // Number of values that the linear scan may load. Covers kMaxLinear
+  // values rounded up to full SIMD batches.
+  static constexpr int32_t kMinValues = kSimd
+      ? bits::roundUp(kMaxLinear, xsimd::batch<T>::size)
+      : kMaxLinear;
+
+  struct Slot {
+    // The slot is empty unless this is equal to 'generation_'.
+    uint32_t generation{0};
+    int32_t position{0};
+  };
+
+  static uint64_t hashOf(const T& value) {
+    return folly::hasher<T>()(value);
+  }
+
+  int32_t findLinear(const T& value) const {
+    if constexpr (kSimd) {
+      using Batch = xsimd::batch<T>;
+      const auto probe = Batch::broadcast(value);
+      for (int32_t i = 0; i < size_; i += Batch::size) {
+        uint64_t matches = simd::toBitMask(
+            Batch::load_unaligned(values_.data() + i) == probe);
+        if (size_ - i < Batch::size) {
+          matches &= bits::lowMask(size_ - i);
+        }
+        if (matches != 0) {
+          return i + __builtin_ctzll(matches);
+        }
+      }
+    } else {
+      for (int32_t i = 0; i < size_; ++i) {
+        if (std::equal_to<T>{}(values_[i], value)) {
+          return i;
+        }
+      }
+    }
+    return -1;
+  }
+
+  void insertSlot(int32_t position) {
+    auto slot = hashOf(values_[position]) & sizeMask_;
+    while (slots_[slot].generation == generation_) {
+      slot = (slot + 1) & sizeMask_;
+    }
+    slots_[slot] = {generation_, position};
+  }
+
+  // Makes a table with at least 4 slots per value and inserts all values.
+  void rehash() {
+    const auto newSize = std::max<size_t>(
+        slots_.size(), bits::nextPowerOfTwo(size_ * 4));
+    if (newSize > slots_.size()) {
+      slots_.assign(newSize, Slot{});
+      sizeMask_ = newSize - 1;
+      generation_ = 1;
+    } else if (++generation_ == 0) {
+      // The generation wrapped around, so old slots might look current.
+      std::fill(slots_.begin(), slots_.end(), Slot{});
+      generation_ = 1;
+    }
+    for (int32_t i = 0; i < size_; ++i) {
+      insertSlot(i);
+    }
+  }
+
+  // Distinct values in insertion order. The size is at least kMinValues and
+  // only the first 'size_' are in the set.
+  std::vector<T> values_;
+  int32_t size_{0};
+  std::vector<Slot> slots_;
+  uint64_t sizeMask_{0};
+  uint32_t generation_{1};
+};
+
+} // namespace facebook::velox::functions
@@ -192,6 +192,60 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
   }
 
+  // Updates the dense accumulators in 'accumulators', a flat vector of TData,
+  // for group by on a small key domain. See exec::Aggregate::addDenseInput().
+  // An accumulator that is still null is set to 'initialValue' before its
+  // first update, which matches initializeNewGroups() followed by
+  // updateGroups() for a group in a RowContainer.
+  template <
+      typename TData = TResult,
+      typename TValue = TInput,
+      typename UpdateSingleValue>
+  void updateDenseGroups(
+      const vector_size_t* groupIndices,
+      const SelectivityVector& rows,
+      const VectorPtr& arg,
+      BaseVector& accumulators,
+      UpdateSingleValue updateSingleValue,
+      TData initialValue) {
+    auto* rawValues =
+        accumulators.asUnchecked<FlatVector<TData>>()->mutableRawValues();
+    auto* rawNulls = accumulators.mutableRawNulls();
+    auto updateDense = [&](auto group, TData value) {
+      if (bits::isBitNull(rawNulls, group)) {
+        bits::clearNull(rawNulls, group);
+        rawValues[group] = initialValue;
+      }
+      updateSingleValue(rawValues[group], value);
+    };
+
+    DecodedVector decoded(*arg, rows);
+    if (decoded.isConstantMapping()) {
+      if (!decoded.isNullAt(0)) {
+        const auto value = TData(decoded.valueAt<TValue>(0));
+        rows.applyToSelected(
+            [&](vector_size_t i) { updateDense(groupIndices[i], value); });
+      }
+    } else if (decoded.mayHaveNulls()) {
+      rows.applyToSelected([&](vector_size_t i) {
+        if (!decoded.isNullAt(i)) {
+          updateDense(groupIndices[i], TData(decoded.valueAt<TValue>(i)));
+        }
+      });
+    } else if (decoded.isIdentityMapping() && !std::is_same_v<TValue, bool>) {
+      // The values and accumulators are plain arrays here, so this loop has
+      // no pointer chasing and no per row null checks on the input.
+      const auto* data = decoded.data<TValue>();
+      rows.applyToSelected([&](vector_size_t i) {
+        updateDense(groupIndices[i], TData(data[i]));
+      });
+    } else {
+      rows.applyToSelected([&](vector_size_t i) {
+        updateDense(groupIndices[i], TData(decoded.valueAt<TValue>(i)));
+      });
+    }
+  }
+
   template <typename THook>
   void
   pushdown(char** groups, const SelectivityVector& rows, const VectorPtr& arg) {
@@ -83,6 +83,35 @@ class SumAggregateBase
     updateInternal<TAccumulator, TAccumulator>(groups, rows, args, mayPushdown);
   }
 
+  bool supportsDenseAccumulators() const override {
+    return true;
+  }
+
+  void addDenseInput(
+      const vector_size_t* groupIndices,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool isRawInput,
+      BaseVector& accumulators) override {
+    if (isRawInput) {
+      BaseAggregate::template updateDenseGroups<TAccumulator>(
+          groupIndices,
+          rows,
+          args[0],
+          accumulators,
+          &updateSingleValue<TAccumulator>,
+          TAccumulator(0));
+    } else {
+      BaseAggregate::template updateDenseGroups<TAccumulator, TAccumulator>(
+          groupIndices,
+          rows,
+          args[0],
+          accumulators,
+          &updateSingleValue<TAccumulator>,
+          TAccumulator(0));
+    }
+  }
+
   void addSingleGroupRawInput(
       char* group,
       const SelectivityVector& rows,
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <cstring>
 #include <string>
 #include <string_view>
@@ -44,11 +45,36 @@
 namespace facebook::velox::functions {
 namespace stringCore {
 
+namespace detail {
+// High bits of the 8 bytes in a 64 bit word.
+constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+
+FOLLY_ALWAYS_INLINE uint64_t loadWord(const char* str) {
+  uint64_t word;
+  std::memcpy(&word, str, sizeof(word));
+  return word;
+}
+} // namespace detail
+
 /// Check if a given string is ascii
 static bool isAscii(const char* str, size_t length);
 
+/// Tests the high bits 32 bytes at a time with SIMD within 64 bit registers.
 FOLLY_ALWAYS_INLINE bool isAscii(const char* str, size_t length) {
-  for (auto i = 0; i < length; i++) {
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    if ((detail::loadWord(str + i) | detail::loadWord(str + i + 8) |
+         detail::loadWord(str + i + 16) | detail::loadWord(str + i + 24)) &
+        detail::kHighBits) {
+      return false;
+    }
+  }
+  for (; i + 8 <= length; i += 8) {
+    if (detail::loadWord(str + i) & detail::kHighBits) {
+      return false;
+    }
+  }
+  for (; i < length; i++) {
     if (str[i] & 0x80) {
       return false;
     }
@@ -56,6 +82,18 @@ FOLLY_ALWAYS_INLINE bool isAscii(const char* str, size_t length) {
   return true;
 }
 
+/// Returns the number of ASCII bytes at the start of 'str'.
+FOLLY_ALWAYS_INLINE size_t asciiPrefixLength(const char* str, size_t length) {
+  size_t i = 0;
+  while (i + 8 <= length && !(detail::loadWord(str + i) & detail::kHighBits)) {
+    i += 8;
+  }
+  while (i < length && !(str[i] & 0x80)) {
+    i++;
+  }
+  return i;
+}
+
 /// Perform reverse for ascii string input
 FOLLY_ALWAYS_INLINE static void
 reverseAscii(char* output, const char* input, size_t length) {
@@ -90,26 +128,22 @@ reverseUnicode(char* output, const char* input, size_t length) {
 }
 
 /// Perform upper for ascii string input
+/// The loop is branch free so that it vectorizes.
 FOLLY_ALWAYS_INLINE static void
 upperAscii(char* output, const char* input, size_t length) {
   VECTORIZE_LOOP_IF_POSSIBLE for (auto i = 0; i < length; i++) {
-    if (input[i] >= 'a' && input[i] <= 'z') {
-      output[i] = input[i] - 32;
-    } else {
-      output[i] = input[i];
-    }
+    const uint8_t c = input[i];
+    output[i] = c - ((uint8_t)(c - 'a') < 26 ? 32 : 0);
   }
 }
 
 /// Perform lower for ascii string input
+/// The loop is branch free so that it vectorizes.
 FOLLY_ALWAYS_INLINE static void
 lowerAscii(char* output, const char* input, size_t length) {
   VECTORIZE_LOOP_IF_POSSIBLE for (auto i = 0; i < length; i++) {
-    if (input[i] >= 'A' && input[i] <= 'Z') {
-      output[i] = input[i] + 32;
-    } else {
-      output[i] = input[i];
-    }
+    const uint8_t c = input[i];
+    output[i] = c + ((uint8_t)(c - 'A') < 26 ? 32 : 0);
   }
 }
 
@@ -222,6 +256,14 @@ lengthUnicode(const char* inputBuffer, size_t bufferLength) {
   auto currentChar = inputBuffer;
   int64_t size = 0;
   while (currentChar < buffEndAddress) {
+    // Count runs of ASCII characters 8 at a time.
+    auto numAscii =
+        asciiPrefixLength(currentChar, buffEndAddress - currentChar);
+    currentChar += numAscii;
+    size += numAscii;
+    if (currentChar == buffEndAddress) {
+      break;
+    }
     auto chrOffset = utf8proc_char_length(currentChar);
     // Skip bad byte if we get utf length < 0.
     currentChar += UNLIKELY(chrOffset < 0) ? 1 : chrOffset;
@@ -413,19 +455,30 @@ getByteRange(const char* str, size_t startCharPosition, size_t length) {
     size_t startByteIndex = 0;
     size_t nextCharOffset = 0;
 
-    // Find startByteIndex
-    for (auto i = 0; i < startCharPosition - 1; i++) {
-      auto increment = utf8proc_char_length(&str[nextCharOffset]);
-      nextCharOffset += UNLIKELY(increment < 0) ? 1 : increment;
-    }
+    // Skips 'numChars' characters starting at 'nextCharOffset'. Each
+    // character is at least one byte, so the next 8 bytes are in the string
+    // if at least 8 characters are left to skip. These are skipped at once if
+    // they are ASCII.
+    auto skipChars = [&](size_t numChars) {
+      while (numChars > 0) {
+        if (numChars >= 8 &&
+            !(detail::loadWord(str + nextCharOffset) & detail::kHighBits)) {
+          nextCharOffset += 8;
+          numChars -= 8;
+          continue;
+        }
+        auto increment = utf8proc_char_length(&str[nextCharOffset]);
+        nextCharOffset += UNLIKELY(increment < 0) ? 1 : increment;
+        numChars--;
+      }
+    };
 
+    // Find startByteIndex
+    skipChars(startCharPosition - 1);
     startByteIndex = nextCharOffset;
 
     // Find endByteIndex
-    for (auto i = 0; i < length; i++) {
-      auto increment = utf8proc_char_length(&str[nextCharOffset]);
-      nextCharOffset += UNLIKELY(increment < 0) ? 1 : increment;
-    }
+    skipChars(length);
 
     return std::make_pair(startByteIndex, nextCharOffset);
   }
@@ -21,6 +21,7 @@
 
 #include <gtest/gtest.h>
 #include <memory>
+#include <random>
 #include <vector>
 
 using namespace facebook::velox;
@@ -496,6 +497,61 @@ TEST_F(StringImplTest, getByteRange) {
   EXPECT_EQ(range.second, 3);
 }
 
+TEST_F(StringImplTest, asciiRuns) {
+  // Strings of ASCII runs of different lengths separated by 2 and 3 byte
+  // characters, so that the word at a time paths meet non-ASCII bytes at
+  // every offset.
+  std::mt19937 rng(1);
+  for (auto iter = 0; iter < 1'000; ++iter) {
+    std::string input;
+    std::vector<size_t> charOffsets;
+    const int numChars = rng() % 80;
+    for (auto i = 0; i < numChars; ++i) {
+      charOffsets.push_back(input.size());
+      switch (rng() % 8) {
+        case 0:
+          input += "\u00D6";
+          break;
+        case 1:
+          input += "\uFE3D";
+          break;
+        default:
+          input += 'a' + rng() % 26;
+      }
+    }
+    charOffsets.push_back(input.size());
+
+    size_t expectedPrefix = 0;
+    while (expectedPrefix < input.size() && !(input[expectedPrefix] & 0x80)) {
+      ++expectedPrefix;
+    }
+    ASSERT_EQ(expectedPrefix, asciiPrefixLength(input.data(), input.size()));
+    ASSERT_EQ(
+        expectedPrefix == input.size(), isAscii(input.data(), input.size()));
+    ASSERT_EQ(numChars, lengthUnicode(input.data(), input.size()));
+
+    for (auto start = 1; start <= numChars; start += 1 + rng() % 8) {
+      const auto length = 1 + rng() % (numChars - start + 1);
+      auto range = getByteRange<false>(input.data(), start, length);
+      ASSERT_EQ(charOffsets[start - 1], range.first);
+      ASSERT_EQ(charOffsets[start - 1 + length], range.second);
+    }
+  }
+
+  std::string all;
+  for (auto i = 0; i < 128; ++i) {
+    all += (char)i;
+  }
+  std::string upper(all.size(), 0);
+  std::string lower(all.size(), 0);
+  upperAscii(upper.data(), all.data(), all.size());
+  lowerAscii(lower.data(), all.data(), all.size());
+  for (auto i = 0; i < 128; ++i) {
+    ASSERT_EQ((char)std::toupper(i), upper[i]);
+    ASSERT_EQ((char)std::tolower(i), lower[i]);
+  }
+}
+
 TEST_F(StringImplTest, pad) {
   auto runTest = [](const std::string& string,
                     const int64_t size,
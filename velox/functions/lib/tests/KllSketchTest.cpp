@@ -122,6 +122,31 @@ TEST(KllSketchTest, randomInput) {
   }
 }
 
+TEST(KllSketchTest, insertBatch) {
+  constexpr int N = 1e5;
+  std::vector<double> values(N);
+  KllSketch<double> expected(kDefaultK, {}, 0);
+  insertRandomData(0, N, expected, values.data());
+
+  // Batches of different sizes give the same sketch as inserting the values
+  // one at a time with the same seed.
+  std::default_random_engine gen(1);
+  KllSketch<double> kll(kDefaultK, {}, 0);
+  for (int i = 0; i < N;) {
+    int size = std::min<int>(N - i, gen() % 3'000);
+    kll.insert(folly::Range<const double*>(values.data() + i, size));
+    i += size;
+  }
+  EXPECT_EQ(kll.totalCount(), N);
+  expected.compact();
+  kll.compact();
+  std::vector<char> expectedData(expected.serializedByteSize());
+  expected.serialize(expectedData.data());
+  std::vector<char> data(kll.serializedByteSize());
+  kll.serialize(data.data());
+  EXPECT_EQ(data, expectedData);
+}
+
 TEST(KllSketchTest, merge) {
   constexpr int N = 1e4;
   constexpr int M = 1001;
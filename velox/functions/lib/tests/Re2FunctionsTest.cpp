@@ -496,6 +496,12 @@ TEST_F(Re2FunctionsTest, likeDeterminePatternKind) {
   testPattern("%%_%aBcD", PatternKind::kGeneric, 0);
   testPattern("%%a%%BcD", PatternKind::kGeneric, 0);
   testPattern("foo%bar", PatternKind::kGeneric, 0);
+
+  testPattern("%presto%", PatternKind::kSubstring, 6);
+  testPattern("%%hello%%%", PatternKind::kSubstring, 5);
+  testPattern("%a%", PatternKind::kSubstring, 1);
+  testPattern("%a%b%", PatternKind::kGeneric, 0);
+  testPattern("%a_b%", PatternKind::kGeneric, 0);
 }
 
 TEST_F(Re2FunctionsTest, likePatternWildcard) {
@@ -624,6 +630,53 @@ TEST_F(Re2FunctionsTest, likePatternSuffix) {
   testLike(input, generateString(kAnyWildcardCharacter) + input, true);
 }
 
+TEST_F(Re2FunctionsTest, likePatternSubstring) {
+  testLike("abcde", "%bcd%", true);
+  testLike("abcde", "%%abcde%%", true);
+  testLike("abcde", "%e%", true);
+  testLike("abcde", "%bd%", false);
+  testLike("abc", "%abcd%", false);
+  testLike("", "%a%", false);
+  testLike("\nabc\nde\n", "%c\nd%", true);
+
+  std::string input = generateString(kLikePatternCharacterSet, 65);
+  testLike(input, "%" + input.substr(20, 33) + "%", true);
+  testLike(input, "%" + input.substr(20, 33) + "!%", false);
+}
+
+TEST_F(Re2FunctionsTest, likePatternLiterals) {
+  testLike("special packages requests", "%special%requests%", true);
+  testLike("requests special", "%special%requests%", false);
+  testLike("foobar", "foo%bar", true);
+  testLike("foo bar", "foo%bar", true);
+  testLike("fobar", "foo%bar", false);
+  testLike("foobar baz", "foo%bar", false);
+  testLike("abc", "a%b%c", true);
+  testLike("ac", "a%b%c", false);
+  testLike("abab", "ab%ab", true);
+  testLike("aba", "ab%ab", false);
+  testLike("xabcbcx", "%abc%bc%", true);
+  testLike("xabcx", "%abc%bc%", false);
+  testLike("a\nb", "a%b", true);
+
+  testLike("a%", "a#%%", '#', true);
+  testLike("a%bc", "a#%%", '#', true);
+  testLike("ab", "a#%%", '#', false);
+  testLike("a_b_c", "%#_%#_%", '#', true);
+  testLike("a_bc", "%#_%#_%", '#', false);
+  testLike("a#b", "a##%", '#', true);
+  testLike("ab", "%b%", '#', true);
+}
+
+TEST_F(Re2FunctionsTest, cachedRe2) {
+  auto re = getCachedRe2("a+b");
+  ASSERT_TRUE(re->ok());
+  EXPECT_EQ(re, getCachedRe2("a+b"));
+  EXPECT_NE(re, getCachedRe2("a+b", true));
+  EXPECT_TRUE(re2::RE2::FullMatch("aab", *re));
+  EXPECT_FALSE(getCachedRe2("a(b")->ok());
+}
+
 TEST_F(Re2FunctionsTest, nullConstantPatternOrEscape) {
   // Test null pattern.
   ASSERT_TRUE(
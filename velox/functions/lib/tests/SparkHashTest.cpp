@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/functions/lib/SparkHash.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::functions::test {
+namespace {
+
+class SparkHashTest : public testing::Test,
+                      public facebook::velox::test::VectorTestBase {
+ protected:
+  // Returns the hashes of 'rows' of 'columns' computed with 'hashColumn'
+  // column by column, starting from 'seed'.
+  template <typename THash, typename HashColumns>
+  std::vector<THash> hashColumns(
+      const std::vector<VectorPtr>& columns,
+      const SelectivityVector& rows,
+      THash seed,
+      HashColumns hashColumn) {
+    std::vector<THash> hashes(rows.end(), seed);
+    for (const auto& column : columns) {
+      DecodedVector decoded(*column, rows);
+      hashColumn(decoded, column->typeKind(), rows, hashes.data());
+    }
+    return hashes;
+  }
+};
+
+TEST_F(SparkHashTest, flatAndEncoded) {
+  // 1'001 rows so that the SIMD loop over flat INTEGER columns has a tail.
+  const vector_size_t size = 1'001;
+  std::vector<VectorPtr> flat{
+      makeFlatVector<int32_t>(
+          size, [](auto row) { return row * 7'919 - 500'000; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row * 1'000'003; }),
+      makeFlatVector<std::string>(
+          size,
+          [](auto row) { return std::string(row % 37, 'a' + row % 26); }),
+      makeFlatVector<double>(size, [](auto row) { return row / 3.0; }),
+  };
+  // The same values row by row through a dictionary.
+  std::vector<VectorPtr> encoded;
+  for (const auto& column : flat) {
+    encoded.push_back(wrapInDictionary(
+        makeIndices(size, [](auto row) { return row; }), size, column));
+  }
+
+  for (const bool allSelected : {true, false}) {
+    SCOPED_TRACE(fmt::format("allSelected: {}", allSelected));
+    SelectivityVector rows(size);
+    if (!allSelected) {
+      rows.setValid(3, false);
+      rows.updateBounds();
+    }
+    auto murmur3 = hashColumns<uint32_t>(flat, rows, 42, sparkMurmur3Hash);
+    EXPECT_EQ(
+        murmur3, hashColumns<uint32_t>(encoded, rows, 42, sparkMurmur3Hash));
+    EXPECT_EQ(
+        murmur3[0],
+        SparkMurmur3Hash::hashDouble(
+            0,
+            SparkMurmur3Hash::hashBytes(
+                "",
+                SparkMurmur3Hash::hashInt64(
+                    0, SparkMurmur3Hash::hashInt32(-500'000, 42)))));
+
+    auto xxhash64 = hashColumns<uint64_t>(flat, rows, 42, sparkXxHash64);
+    EXPECT_EQ(
+        xxhash64, hashColumns<uint64_t>(encoded, rows, 42, sparkXxHash64));
+  }
+
+  // A single INTEGER column is hashed a batch at a time.
+  SelectivityVector rows(size);
+  auto hashes = hashColumns<uint32_t>({flat[0]}, rows, 42, sparkMurmur3Hash);
+  for (auto row = 0; row < size; ++row) {
+    ASSERT_EQ(
+        hashes[row],
+        SparkMurmur3Hash::hashInt32(row * 7'919 - 500'000, 42))
+        << row;
+  }
+}
+
+TEST_F(SparkHashTest, nulls) {
+  // Null values leave the hash unchanged.
+  auto ints = makeNullableFlatVector<int32_t>({std::nullopt, 0, std::nullopt});
+  auto strings = makeNullableFlatVector<std::string>({"", std::nullopt, ""});
+  SelectivityVector rows(3);
+  auto hashes =
+      hashColumns<uint32_t>({strings, ints}, rows, 42, sparkMurmur3Hash);
+  // Same as Spark's hash("", null), hash(null, 0) and hash("", null).
+  EXPECT_EQ(static_cast<int32_t>(hashes[0]), 142593372);
+  EXPECT_EQ(static_cast<int32_t>(hashes[1]), 933211791);
+  EXPECT_EQ(static_cast<int32_t>(hashes[2]), 142593372);
+}
+
+} // namespace
+} // namespace facebook::velox::functions::test
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <fmt/format.h>
+#include <folly/container/F14Set.h>
+
+#include "velox/functions/lib/ValueSet.h"
+#include "velox/type/StringView.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+template <typename T, typename Make>
+void testSizes(Make make) {
+  ValueSet<T> set;
+  // Sizes on both sides of the switch from the linear scan to the table.
+  // The set is reused as by the array functions.
+  for (auto size : {0, 1, 7, 16, 17, 100, 3, 1'000, 20}) {
+    set.clear();
+    folly::F14FastSet<T> expected;
+    for (auto i = 0; i < size; ++i) {
+      // Every value is inserted twice.
+      const auto value = make(i / 2);
+      const auto [position, inserted] = set.insert(value);
+      EXPECT_EQ(inserted, expected.insert(value).second);
+      EXPECT_EQ(set.valueAt(position), value);
+    }
+    EXPECT_EQ(set.size(), expected.size());
+    for (auto i = 0; i < size; ++i) {
+      EXPECT_EQ(set.contains(make(i)), expected.count(make(i)) > 0) << i;
+    }
+  }
+}
+
+TEST(ValueSetTest, basic) {
+  testSizes<int8_t>([](auto i) { return static_cast<int8_t>(i); });
+  testSizes<int32_t>([](auto i) { return i * 11; });
+  testSizes<int64_t>([](auto i) { return i * 1'000'000'007L; });
+  testSizes<double>([](auto i) { return i * 0.5; });
+  std::vector<std::string> strings;
+  for (auto i = 0; i < 1'000; ++i) {
+    strings.push_back(fmt::format("string value {}", i));
+  }
+  testSizes<StringView>([&](auto i) { return StringView(strings[i]); });
+}
+
+TEST(ValueSetTest, insertionOrder) {
+  ValueSet<int64_t> set;
+  for (auto i = 0; i < 100; ++i) {
+    EXPECT_EQ(set.insert(100 - i).first, i);
+  }
+  for (auto i = 0; i < 100; ++i) {
+    EXPECT_EQ(set.find(100 - i), i);
+  }
+  EXPECT_EQ(set.find(0), -1);
+  set.clear();
+  EXPECT_EQ(set.size(), 0);
+  EXPECT_FALSE(set.contains(100));
+}
+
+} // namespace
+} // namespace facebook::velox::functions
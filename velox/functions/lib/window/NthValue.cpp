@@ -81,6 +81,14 @@ class NthValueFunction : public exec::WindowFunction {
       int32_t resultOffset,
       const VectorPtr& result) override {
     auto numRows = frameStarts->size() / sizeof(vector_size_t);
+    if (numRows > 0 && constantOffset_.has_value() && !ignoreNulls_ &&
+        validRows.isAllSelected() &&
+        applySameFrameStart(
+            frameStarts, frameEnds, numRows, resultOffset, result)) {
+      partitionOffset_ += numRows;
+      return;
+    }
+
     rowNumbers_.resize(numRows);
 
     if (isConstantOffsetNull_) {
@@ -211,6 +219,54 @@ class NthValueFunction : public exec::WindowFunction {
     }
   }
 
+  // Fast path for a constant offset when all frames of the block start at the
+  // same row, e.g. for frames from UNBOUNDED PRECEDING. All rows then read
+  // the same row of the partition, or null if their frame ends before it.
+  // The value is extracted once and copied into runs of rows. Returns false
+  // if the frame starts differ.
+  bool applySameFrameStart(
+      const BufferPtr& frameStarts,
+      const BufferPtr& frameEnds,
+      vector_size_t numRows,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    auto rawFrameStarts = frameStarts->as<vector_size_t>();
+    auto rawFrameEnds = frameEnds->as<vector_size_t>();
+    const auto frameStart = rawFrameStarts[0];
+    for (auto i = 1; i < numRows; ++i) {
+      if (rawFrameStarts[i] != frameStart) {
+        return false;
+      }
+    }
+
+    const int64_t rowNumber = frameStart + constantOffset_.value() - 1;
+    VectorPtr constantValue;
+    vector_size_t i = 0;
+    while (i < numRows) {
+      const bool hasValue = rawFrameEnds[i] >= rowNumber;
+      auto end = i + 1;
+      while (end < numRows && (rawFrameEnds[end] >= rowNumber) == hasValue) {
+        ++end;
+      }
+      if (!hasValue) {
+        for (auto row = i; row < end; ++row) {
+          result->setNull(resultOffset + row, true);
+        }
+      } else {
+        if (!constantValue) {
+          if (!singleValue_) {
+            singleValue_ = BaseVector::create(resultType(), 1, pool());
+          }
+          partition_->extractColumn(valueIndex_, rowNumber, 1, 0, singleValue_);
+          constantValue = BaseVector::wrapInConstant(numRows, 0, singleValue_);
+        }
+        result->copy(constantValue.get(), resultOffset + i, 0, end - i);
+      }
+      i = end;
+    }
+    return true;
+  }
+
   void setRowNumbersForEmptyFrames(const SelectivityVector& validRows) {
     if (validRows.isAllSelected()) {
       return;
@@ -289,6 +345,10 @@ class NthValueFunction : public exec::WindowFunction {
 
   // Member variable re-used for setting null for empty frames.
   SelectivityVector invalidRows_;
+
+  // Single row vector for the value copied to all rows of a block in
+  // applySameFrameStart().
+  VectorPtr singleValue_;
 };
 } // namespace
 
@@ -44,6 +44,9 @@ namespace {
 
 template <typename T>
 struct PlusFunction {
+  // Registered for floating point only, which does not throw.
+  static constexpr bool is_vectorizable = true;
+
   template <typename TInput>
   FOLLY_ALWAYS_INLINE void
   call(TInput& result, const TInput& a, const TInput& b) {
@@ -53,6 +56,8 @@ struct PlusFunction {
 
 template <typename T>
 struct MinusFunction {
+  static constexpr bool is_vectorizable = true;
+
   template <typename TInput>
   FOLLY_ALWAYS_INLINE void
   call(TInput& result, const TInput& a, const TInput& b) {
@@ -62,6 +67,8 @@ struct MinusFunction {
 
 template <typename T>
 struct MultiplyFunction {
+  static constexpr bool is_vectorizable = true;
+
   template <typename TInput>
   FOLLY_ALWAYS_INLINE void
   call(TInput& result, const TInput& a, const TInput& b) {
@@ -14,13 +14,12 @@
  * limitations under the License.
  */
 
-#include <folly/container/F14Map.h>
-
 #include "velox/expression/EvalCtx.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/ComparatorUtil.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
+#include "velox/functions/lib/ValueSet.h"
 
 namespace facebook::velox::functions {
 namespace {
@@ -99,9 +98,11 @@ class ArrayDuplicatesFunction : public exec::VectorFunction {
     auto* rawSizes = newSizes->asMutable<vector_size_t>();
     auto* rawOffsets = newOffsets->asMutable<vector_size_t>();
 
-    // Process the rows: use a hashmap to store unique values and
-    // whether it occurred once or more than once.
-    folly::F14FastMap<T, bool> uniqueMap;
+    // Process the rows: use a set that is reused for all rows to store unique
+    // values and a flag per position in the set telling whether the value has
+    // occurred only once.
+    ValueSet<T> uniqueSet;
+    std::vector<bool> seenOnce;
 
     rows.applyToSelected([&](vector_size_t row) {
       auto size = arrayVector->sizeAt(row);
@@ -119,18 +120,22 @@ class ArrayDuplicatesFunction : public exec::VectorFunction {
           }
         } else {
           T value = elements->valueAt<T>(i);
-          auto it = uniqueMap.find(value);
-          if (it == uniqueMap.end()) {
-            uniqueMap[value] = true;
-          } else if (it->second) {
-            it->second = false;
+          auto [position, inserted] = uniqueSet.insert(value);
+          if (inserted) {
+            if (position == static_cast<int32_t>(seenOnce.size())) {
+              seenOnce.push_back(true);
+            } else {
+              seenOnce[position] = true;
+            }
+          } else if (seenOnce[position]) {
+            seenOnce[position] = false;
             rawIndices[indexCursor] = i;
             indexCursor++;
           }
         }
       }
 
-      uniqueMap.clear();
+      uniqueSet.clear();
       rawSizes[row] = indexCursor - rawOffsets[row];
 
       std::sort(
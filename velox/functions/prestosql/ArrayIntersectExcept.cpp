@@ -16,24 +16,20 @@
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/LambdaFunctionUtil.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
+#include "velox/functions/lib/ValueSet.h"
 
 namespace facebook::velox::functions {
 namespace {
 template <typename T>
 
 struct SetWithNull {
-  SetWithNull(vector_size_t initialSetSize = kInitialSetSize) {
-    set.reserve(initialSetSize);
-  }
-
   void reset() {
     set.clear();
     hasNull = false;
   }
 
-  folly::F14FastSet<T> set;
+  ValueSet<T> set;
   bool hasNull{false};
-  static constexpr vector_size_t kInitialSetSize{128};
 };
 // Generates a set based on the elements of an ArrayVector. Note that we take
 // rightSet as a parameter (instead of returning a new one) to reuse the
@@ -194,9 +190,9 @@ class ArrayIntersectExceptFunction : public exec::VectorFunction {
           // (check outputSet).
           bool addValue = false;
           if constexpr (isIntersect) {
-            addValue = rightSet.set.count(val) > 0;
+            addValue = rightSet.set.contains(val);
           } else {
-            addValue = rightSet.set.count(val) == 0;
+            addValue = !rightSet.set.contains(val);
           }
           if (addValue) {
             auto it = outputSet.set.insert(val);
@@ -292,7 +288,7 @@ class ArraysOverlapFunction : public exec::VectorFunction {
           hasNull = true;
           continue;
         }
-        if (rightSet.set.count(decodedLeftElements->valueAt<T>(i)) > 0) {
+        if (rightSet.set.contains(decodedLeftElements->valueAt<T>(i))) {
           // Found an overlapping element. Add to result set.
           resultBoolVector->set(row, true);
           return;
@@ -26,6 +26,157 @@
 namespace facebook::velox::functions {
 namespace {
 
+// Arrays with at least this many non-null integer values are sorted with a
+// radix sort. std::sort is faster for smaller arrays.
+constexpr vector_size_t kMinRadixSortSize = 256;
+
+// Floating point values are not radix sorted since their order in
+// SimpleVector::compare() differs from the order of their bits for NaN and
+// -0.0.
+template <typename T>
+constexpr bool kRadixSortable = std::is_integral_v<T> &&
+    !std::is_same_v<T, bool> && sizeof(T) <= sizeof(int64_t);
+
+// Unsigned integer that orders like T. Defined for all T so that it can name
+// the type of unused buffers.
+template <typename T>
+using RadixKey =
+    std::make_unsigned_t<std::conditional_t<kRadixSortable<T>, T, int64_t>>;
+
+template <typename T>
+RadixKey<T> toRadixKey(T value, bool ascending) {
+  using Key = RadixKey<T>;
+  constexpr Key kSignBit = Key(1) << (sizeof(Key) * 8 - 1);
+  const Key key = static_cast<Key>(value) ^ kSignBit;
+  return ascending ? key : static_cast<Key>(~key);
+}
+
+template <typename T>
+T fromRadixKey(RadixKey<T> key, bool ascending) {
+  using Key = RadixKey<T>;
+  constexpr Key kSignBit = Key(1) << (sizeof(Key) * 8 - 1);
+  return static_cast<T>(
+      static_cast<Key>(ascending ? key : static_cast<Key>(~key)) ^ kSignBit);
+}
+
+// Stable LSD radix sort of 'size' entries of 'data' by 8 bit digits of
+// 'key(entry)'. 'temp' has space for 'size' entries. Digits that are the same
+// for all entries are skipped, so that small ranges of values take few
+// passes.
+template <typename E, typename KeyFunc>
+void radixSort(E* data, E* temp, vector_size_t size, KeyFunc key) {
+  using Key = decltype(key(*data));
+  constexpr int32_t kKeyBits = sizeof(Key) * 8;
+  if (size == 0) {
+    return;
+  }
+  E* from = data;
+  E* to = temp;
+  for (int32_t shift = 0; shift < kKeyBits; shift += 8) {
+    vector_size_t offsets[256] = {};
+    for (auto i = 0; i < size; ++i) {
+      ++offsets[(key(from[i]) >> shift) & 0xFF];
+    }
+    if (offsets[(key(from[0]) >> shift) & 0xFF] == size) {
+      continue;
+    }
+    vector_size_t offset = 0;
+    for (auto& digitOffset : offsets) {
+      const auto count = digitOffset;
+      digitOffset = offset;
+      offset += count;
+    }
+    for (auto i = 0; i < size; ++i) {
+      to[offsets[(key(from[i]) >> shift) & 0xFF]++] = from[i];
+    }
+    std::swap(from, to);
+  }
+  if (from != data) {
+    std::copy(from, from + size, data);
+  }
+}
+
+// Sorts the 'size' non-null values at 'values'. 'buffer' is scratch memory
+// reused across arrays.
+template <typename T>
+void radixSortValues(
+    T* values,
+    vector_size_t size,
+    bool ascending,
+    std::vector<RadixKey<T>>& buffer) {
+  buffer.resize(size * 2);
+  auto* keys = buffer.data();
+  for (auto i = 0; i < size; ++i) {
+    keys[i] = toRadixKey(values[i], ascending);
+  }
+  radixSort(keys, keys + size, size, [](auto key) { return key; });
+  for (auto i = 0; i < size; ++i) {
+    values[i] = fromRadixKey<T>(keys[i], ascending);
+  }
+}
+
+// Sorts the element indices of each array in 'rows' by flat integer keys,
+// nulls last. Compares the raw keys instead of calling
+// BaseVector::compare() and radix sorts large arrays.
+template <typename T>
+void sortByIntegerKeys(
+    const SelectivityVector& rows,
+    const ArrayVector& inputArray,
+    const DecodedVector& decodedKeys,
+    const T* rawKeys,
+    bool ascending,
+    vector_size_t* rawIndices) {
+  using Entry = std::pair<RadixKey<T>, vector_size_t>;
+  const auto* keyIndices = decodedKeys.indices();
+  std::vector<Entry> entries;
+  std::vector<Entry> temp;
+  rows.applyToSelected([&](vector_size_t row) {
+    const auto size = inputArray.sizeAt(row);
+    const auto offset = inputArray.offsetAt(row);
+    auto* rowIndices = rawIndices + offset;
+    if (size < kMinRadixSortSize) {
+      for (auto i = 0; i < size; ++i) {
+        rowIndices[i] = offset + i;
+      }
+      std::sort(
+          rowIndices,
+          rowIndices + size,
+          [&](vector_size_t a, vector_size_t b) {
+            if (decodedKeys.isNullAt(a)) {
+              return false;
+            }
+            if (decodedKeys.isNullAt(b)) {
+              return true;
+            }
+            return ascending ? rawKeys[keyIndices[a]] < rawKeys[keyIndices[b]]
+                             : rawKeys[keyIndices[b]] < rawKeys[keyIndices[a]];
+          });
+      return;
+    }
+    entries.clear();
+    for (auto i = offset; i < offset + size; ++i) {
+      if (!decodedKeys.isNullAt(i)) {
+        entries.push_back({toRadixKey(rawKeys[keyIndices[i]], ascending), i});
+      }
+    }
+    temp.resize(entries.size());
+    radixSort(
+        entries.data(),
+        temp.data(),
+        entries.size(),
+        [](const Entry& entry) { return entry.first; });
+    for (auto i = 0; i < entries.size(); ++i) {
+      rowIndices[i] = entries[i].second;
+    }
+    auto nullIndex = entries.size();
+    for (auto i = offset; i < offset + size; ++i) {
+      if (decodedKeys.isNullAt(i)) {
+        rowIndices[nullIndex++] = i;
+      }
+    }
+  });
+}
+
 BufferPtr sortElements(
     const SelectivityVector& rows,
     const ArrayVector& inputArray,
@@ -42,6 +193,35 @@ BufferPtr sortElements(
   BufferPtr indices = allocateIndices(inputElements.size(), context.pool());
   vector_size_t* rawIndices = indices->asMutable<vector_size_t>();
 
+  if (baseElementsVector->isFlatEncoding()) {
+    auto sortByKeys = [&](const auto* rawKeys) {
+      sortByIntegerKeys(
+          rows,
+          inputArray,
+          *decodedElements.get(),
+          rawKeys,
+          ascending,
+          rawIndices);
+      return indices;
+    };
+    switch (baseElementsVector->typeKind()) {
+      case TypeKind::TINYINT:
+        return sortByKeys(
+            baseElementsVector->asUnchecked<FlatVector<int8_t>>()->rawValues());
+      case TypeKind::SMALLINT:
+        return sortByKeys(baseElementsVector->asUnchecked<FlatVector<int16_t>>()
+                              ->rawValues());
+      case TypeKind::INTEGER:
+        return sortByKeys(baseElementsVector->asUnchecked<FlatVector<int32_t>>()
+                              ->rawValues());
+      case TypeKind::BIGINT:
+        return sortByKeys(baseElementsVector->asUnchecked<FlatVector<int64_t>>()
+                              ->rawValues());
+      default:
+        break;
+    }
+  }
+
   const CompareFlags flags{.nullsFirst = false, .ascending = ascending};
   auto decodedIndices = decodedElements->indices();
 
@@ -127,6 +307,7 @@ void applyScalarType(
       inputElements.get(), inputElementRows, /*toSourceRow=*/nullptr);
 
   auto flatResults = resultElements->asFlatVector<T>();
+  std::vector<RadixKey<T>> radixBuffer;
 
   auto processRow = [&](vector_size_t row) {
     const auto size = inputArray->sizeAt(row);
@@ -160,6 +341,16 @@ void applyScalarType(
       }
     } else {
       T* resultRawValues = flatResults->mutableRawValues();
+      if constexpr (kRadixSortable<T>) {
+        if (endRow - startRow >= kMinRadixSortSize) {
+          radixSortValues(
+              resultRawValues + startRow,
+              endRow - startRow,
+              ascending,
+              radixBuffer);
+          return;
+        }
+      }
       if (ascending) {
         std::sort(resultRawValues + startRow, resultRawValues + endRow);
       } else {
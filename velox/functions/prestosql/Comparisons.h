@@ -44,6 +44,7 @@ struct TimestampWithTimezoneComparisonSupport {
   template <typename T>                                            \
   struct Name : public TimestampWithTimezoneComparisonSupport<T> { \
     VELOX_DEFINE_FUNCTION_TYPES(T);                                \
+    static constexpr bool is_vectorizable = true;                  \
     template <typename TInput>                                     \
     FOLLY_ALWAYS_INLINE void                                       \
     call(TResult& result, const TInput& lhs, const TInput& rhs) {  \
@@ -106,6 +107,7 @@ struct DistinctFromFunction {
 template <typename T>
 struct EqFunction : public TimestampWithTimezoneComparisonSupport<T> {
   VELOX_DEFINE_FUNCTION_TYPES(T);
+  static constexpr bool is_vectorizable = true;
 
   // Used for primitive inputs.
   template <typename TInput>
@@ -143,6 +145,7 @@ struct EqFunction : public TimestampWithTimezoneComparisonSupport<T> {
 template <typename T>
 struct NeqFunction : public TimestampWithTimezoneComparisonSupport<T> {
   VELOX_DEFINE_FUNCTION_TYPES(T);
+  static constexpr bool is_vectorizable = true;
 
   // Used for primitive inputs.
   template <typename TInput>
@@ -174,6 +177,8 @@ struct NeqFunction : public TimestampWithTimezoneComparisonSupport<T> {
 
 template <typename T>
 struct BetweenFunction {
+  static constexpr bool is_vectorizable = true;
+
   template <typename TInput>
   FOLLY_ALWAYS_INLINE void call(
       bool& result,
@@ -231,25 +231,21 @@ struct YearFunction : public InitSessionTimezone<T>,
                       public TimestampWithTimezoneSupport<T> {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
-  FOLLY_ALWAYS_INLINE int64_t getYear(const std::tm& time) {
-    return 1900 + time.tm_year;
-  }
-
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getYear(getDateTime(timestamp, this->timeZone_));
+    result = civilFromDays(getDays(timestamp, this->timeZone_)).year;
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
-    result = getYear(getDateTime(date));
+    result = civilFromDays(date).year;
   }
 
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<TimestampWithTimezone>& timestampWithTimezone) {
     auto timestamp = this->toTimestamp(timestampWithTimezone);
-    result = getYear(getDateTime(timestamp, nullptr));
+    result = civilFromDays(getDays(timestamp, nullptr)).year;
   }
 };
 
@@ -258,25 +254,25 @@ struct QuarterFunction : public InitSessionTimezone<T>,
                          public TimestampWithTimezoneSupport<T> {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
-  FOLLY_ALWAYS_INLINE int64_t getQuarter(const std::tm& time) {
-    return time.tm_mon / 3 + 1;
+  FOLLY_ALWAYS_INLINE int64_t getQuarter(int64_t days) {
+    return (civilFromDays(days).month - 1) / 3 + 1;
   }
 
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getQuarter(getDateTime(timestamp, this->timeZone_));
+    result = getQuarter(getDays(timestamp, this->timeZone_));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
-    result = getQuarter(getDateTime(date));
+    result = getQuarter(date);
   }
 
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<TimestampWithTimezone>& timestampWithTimezone) {
     auto timestamp = this->toTimestamp(timestampWithTimezone);
-    result = getQuarter(getDateTime(timestamp, nullptr));
+    result = getQuarter(getDays(timestamp, nullptr));
   }
 };
 
@@ -285,25 +281,21 @@ struct MonthFunction : public InitSessionTimezone<T>,
                        public TimestampWithTimezoneSupport<T> {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
-  FOLLY_ALWAYS_INLINE int64_t getMonth(const std::tm& time) {
-    return 1 + time.tm_mon;
-  }
-
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getMonth(getDateTime(timestamp, this->timeZone_));
+    result = civilFromDays(getDays(timestamp, this->timeZone_)).month;
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
-    result = getMonth(getDateTime(date));
+    result = civilFromDays(date).month;
   }
 
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<TimestampWithTimezone>& timestampWithTimezone) {
     auto timestamp = this->toTimestamp(timestampWithTimezone);
-    result = getMonth(getDateTime(timestamp, nullptr));
+    result = civilFromDays(getDays(timestamp, nullptr)).month;
   }
 };
 
@@ -315,18 +307,18 @@ struct DayFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDateTime(timestamp, this->timeZone_).tm_mday;
+    result = civilFromDays(getDays(timestamp, this->timeZone_)).day;
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
-    result = getDateTime(date).tm_mday;
+    result = civilFromDays(date).day;
   }
 
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<TimestampWithTimezone>& timestampWithTimezone) {
     auto timestamp = this->toTimestamp(timestampWithTimezone);
-    result = getDateTime(timestamp, nullptr).tm_mday;
+    result = civilFromDays(getDays(timestamp, nullptr)).day;
   }
 };
 
@@ -417,25 +409,21 @@ struct DayOfWeekFunction : public InitSessionTimezone<T>,
                            public TimestampWithTimezoneSupport<T> {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
-  FOLLY_ALWAYS_INLINE int64_t getDayOfWeek(const std::tm& time) {
-    return time.tm_wday == 0 ? 7 : time.tm_wday;
-  }
-
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDayOfWeek(getDateTime(timestamp, this->timeZone_));
+    result = dayOfWeekFromDays(getDays(timestamp, this->timeZone_));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
-    result = getDayOfWeek(getDateTime(date));
+    result = dayOfWeekFromDays(date);
   }
 
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<TimestampWithTimezone>& timestampWithTimezone) {
     auto timestamp = this->toTimestamp(timestampWithTimezone);
-    result = getDayOfWeek(getDateTime(timestamp, nullptr));
+    result = dayOfWeekFromDays(getDays(timestamp, nullptr));
   }
 };
 
@@ -444,25 +432,25 @@ struct DayOfYearFunction : public InitSessionTimezone<T>,
                            public TimestampWithTimezoneSupport<T> {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
-  FOLLY_ALWAYS_INLINE int64_t getDayOfYear(const std::tm& time) {
-    return time.tm_yday + 1;
+  FOLLY_ALWAYS_INLINE int64_t getDayOfYear(int64_t days) {
+    return days - daysFromCivil(civilFromDays(days).year, 1, 1) + 1;
   }
 
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDayOfYear(getDateTime(timestamp, this->timeZone_));
+    result = getDayOfYear(getDays(timestamp, this->timeZone_));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
-    result = getDayOfYear(getDateTime(date));
+    result = getDayOfYear(date);
   }
 
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<TimestampWithTimezone>& timestampWithTimezone) {
     auto timestamp = this->toTimestamp(timestampWithTimezone);
-    result = getDayOfYear(getDateTime(timestamp, nullptr));
+    result = getDayOfYear(getDays(timestamp, nullptr));
   }
 };
 
@@ -728,74 +716,42 @@ struct DateTruncFunction : public TimestampWithTimezoneSupport<T> {
     }
   }
 
-  FOLLY_ALWAYS_INLINE void adjustDateTime(
-      std::tm& dateTime,
-      const DateTimeUnit& unit) {
+  // Returns the first day of the 'unit' that contains 'days' since epoch.
+  // 'unit' is at least a day.
+  FOLLY_ALWAYS_INLINE int64_t truncateDays(int64_t days, DateTimeUnit unit) {
     switch (unit) {
       case DateTimeUnit::kYear:
-        dateTime.tm_mon = 0;
-        dateTime.tm_yday = 0;
-        FMT_FALLTHROUGH;
-      case DateTimeUnit::kQuarter:
-        dateTime.tm_mon = dateTime.tm_mon / 3 * 3;
-        FMT_FALLTHROUGH;
+        return daysFromCivil(civilFromDays(days).year, 1, 1);
+      case DateTimeUnit::kQuarter: {
+        const auto date = civilFromDays(days);
+        return daysFromCivil(date.year, (date.month - 1) / 3 * 3 + 1, 1);
+      }
       case DateTimeUnit::kMonth:
-        dateTime.tm_mday = 1;
-        dateTime.tm_hour = 0;
-        dateTime.tm_min = 0;
-        dateTime.tm_sec = 0;
-        break;
+        return days - civilFromDays(days).day + 1;
       case DateTimeUnit::kWeek:
-        // Subtract the truncation
-        dateTime.tm_mday -= dateTime.tm_wday == 0 ? 6 : dateTime.tm_wday - 1;
-        // Setting the day of the week to Monday
-        dateTime.tm_wday = 1;
-
-        // If the adjusted day of the month falls in the previous month
-        // Move to the previous month
-        if (dateTime.tm_mday < 1) {
-          dateTime.tm_mon -= 1;
-
-          // If the adjusted month falls in the previous year
-          // Set to December and Move to the previous year
-          if (dateTime.tm_mon < 0) {
-            dateTime.tm_mon = 11;
-            dateTime.tm_year -= 1;
-          }
-
-          // Calculate the correct day of the month based on the number of days
-          // in the adjusted month
-          static const int daysInMonth[] = {
-              31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-          int daysInPrevMonth = daysInMonth[dateTime.tm_mon];
-
-          // Adjust for leap year if February
-          if (dateTime.tm_mon == 1 && (dateTime.tm_year + 1900) % 4 == 0 &&
-              ((dateTime.tm_year + 1900) % 100 != 0 ||
-               (dateTime.tm_year + 1900) % 400 == 0)) {
-            daysInPrevMonth = 29;
-          }
-          // Set to the correct day in the previous month
-          dateTime.tm_mday += daysInPrevMonth;
-        }
-        dateTime.tm_hour = 0;
-        dateTime.tm_min = 0;
-        dateTime.tm_sec = 0;
-        break;
+        return days - dayOfWeekFromDays(days) + 1;
       case DateTimeUnit::kDay:
-        dateTime.tm_hour = 0;
-        FMT_FALLTHROUGH;
-      case DateTimeUnit::kHour:
-        dateTime.tm_min = 0;
-        FMT_FALLTHROUGH;
-      case DateTimeUnit::kMinute:
-        dateTime.tm_sec = 0;
-        break;
+        return days;
       default:
         VELOX_UNREACHABLE();
     }
   }
 
+  // Returns the first second of the 'unit' that contains 'seconds' since
+  // epoch.
+  FOLLY_ALWAYS_INLINE int64_t
+  truncateSeconds(int64_t seconds, DateTimeUnit unit) {
+    switch (unit) {
+      case DateTimeUnit::kMinute:
+        return floorDiv(seconds, 60) * 60;
+      case DateTimeUnit::kHour:
+        return floorDiv(seconds, 3'600) * 3'600;
+      default:
+        return truncateDays(floorDiv(seconds, kSecondsInDay), unit) *
+            kSecondsInDay;
+    }
+  }
+
   FOLLY_ALWAYS_INLINE void call(
       out_type<Timestamp>& result,
       const arg_type<Varchar>& unitString,
@@ -812,10 +768,8 @@ struct DateTruncFunction : public TimestampWithTimezoneSupport<T> {
       return;
     }
 
-    auto dateTime = getDateTime(timestamp, timeZone_);
-    adjustDateTime(dateTime, unit);
-
-    result = Timestamp(timegm(&dateTime), 0);
+    result = Timestamp(
+        truncateSeconds(getSeconds(timestamp, timeZone_), unit), 0);
     if (timeZone_ != nullptr) {
       result.toGMT(*timeZone_);
     }
@@ -834,10 +788,7 @@ struct DateTruncFunction : public TimestampWithTimezoneSupport<T> {
       return;
     }
 
-    auto dateTime = getDateTime(date);
-    adjustDateTime(dateTime, unit);
-
-    result = timegm(&dateTime) / kSecondsInDay;
+    result = truncateDays(date, unit);
   }
 
   FOLLY_ALWAYS_INLINE void call(
@@ -861,9 +812,8 @@ struct DateTruncFunction : public TimestampWithTimezoneSupport<T> {
     }
 
     auto timestamp = this->toTimestamp(timestampWithTimezone);
-    auto dateTime = getDateTime(timestamp, nullptr);
-    adjustDateTime(dateTime, unit);
-    timestamp = Timestamp::fromMillis(timegm(&dateTime) * 1000);
+    timestamp = Timestamp::fromMillis(
+        truncateSeconds(timestamp.getSeconds(), unit) * 1000);
     timestamp.toGMT(*timestampWithTimezone.template at<1>());
 
     result.template get_writer_at<0>() = timestamp.toMillis();
@@ -47,6 +47,11 @@ class DecimalBaseFunction : public exec::VectorFunction {
       exec::EvalCtx& context,
       VectorPtr& result) const override {
     auto rawResults = prepareResults(rows, resultType, context, result);
+    if constexpr (kShortNoOverflow) {
+      if (applyShort(rows, args, rawResults)) {
+        return;
+      }
+    }
     if (args[0]->isConstantEncoding() && args[1]->isFlatEncoding()) {
       // Fast path for (const, flat).
       auto constant = args[0]->asUnchecked<SimpleVector<A>>()->valueAt(0);
@@ -92,6 +97,66 @@ class DecimalBaseFunction : public exec::VectorFunction {
   }
 
  private:
+  // True if the operation on short decimals with a short decimal result
+  // cannot overflow, so that it needs no checks.
+  static constexpr bool kShortNoOverflow = std::is_same_v<R, int64_t> &&
+      std::is_same_v<A, int64_t> && std::is_same_v<B, int64_t> &&
+      Operation::kShortNoOverflow;
+
+  // Evaluates flat and constant arguments with 64 bit arithmetic and no
+  // overflow checks in loops that the compiler can vectorize. The rescale is
+  // skipped if the scales match. Returns false for other encodings.
+  bool applyShort(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      int64_t* rawResults) const {
+    const bool aConstant = args[0]->isConstantEncoding();
+    const bool bConstant = args[1]->isConstantEncoding();
+    if ((!aConstant && !args[0]->isFlatEncoding()) ||
+        (!bConstant && !args[1]->isFlatEncoding()) ||
+        (aConstant && bConstant)) {
+      return false;
+    }
+    const auto aFactor =
+        static_cast<int64_t>(DecimalUtil::kPowersOfTen[aRescale_]);
+    const auto bFactor =
+        static_cast<int64_t>(DecimalUtil::kPowersOfTen[bRescale_]);
+    const auto apply = [&](auto a, auto b) {
+      if (aRescale_ == 0 && bRescale_ == 0) {
+        rows.applyToSelected([&](auto row) {
+          rawResults[row] = Operation::applyShort(a(row), b(row));
+        });
+      } else {
+        rows.applyToSelected([&](auto row) {
+          rawResults[row] =
+              Operation::applyShort(a(row) * aFactor, b(row) * bFactor);
+        });
+      }
+    };
+    const auto* rawA = aConstant
+        ? nullptr
+        : args[0]->asUnchecked<FlatVector<int64_t>>()->rawValues();
+    const auto* rawB = bConstant
+        ? nullptr
+        : args[1]->asUnchecked<FlatVector<int64_t>>()->rawValues();
+    if (aConstant) {
+      const auto constant =
+          args[0]->asUnchecked<SimpleVector<int64_t>>()->valueAt(0);
+      apply(
+          [&](auto) { return constant; }, [&](auto row) { return rawB[row]; });
+    } else if (bConstant) {
+      const auto constant =
+          args[1]->asUnchecked<SimpleVector<int64_t>>()->valueAt(0);
+      apply(
+          [&](auto row) { return rawA[row]; }, [&](auto) { return constant; });
+    } else {
+      apply(
+          [&](auto row) { return rawA[row]; },
+          [&](auto row) { return rawB[row]; });
+    }
+    return true;
+  }
+
   R* prepareResults(
       const SelectivityVector& rows,
       const TypePtr& resultType,
@@ -271,6 +336,14 @@ class DecimalBetweenFunction : public exec::VectorFunction {
 
 class Addition {
  public:
+  // The result has one more digit than the rescaled arguments, so a short
+  // decimal result means that the arguments have at most 17 digits.
+  static constexpr bool kShortNoOverflow = true;
+
+  inline static int64_t applyShort(int64_t a, int64_t b) {
+    return a + b;
+  }
+
   template <typename R, typename A, typename B>
   inline static void
   apply(R& r, const A& a, const B& b, uint8_t aRescale, uint8_t bRescale)
@@ -313,6 +386,13 @@ class Addition {
 
 class Subtraction {
  public:
+  // See Addition.
+  static constexpr bool kShortNoOverflow = true;
+
+  inline static int64_t applyShort(int64_t a, int64_t b) {
+    return a - b;
+  }
+
   template <typename R, typename A, typename B>
   inline static void
   apply(R& r, const A& a, const B& b, uint8_t aRescale, uint8_t bRescale)
@@ -351,6 +431,14 @@ class Subtraction {
 
 class Multiply {
  public:
+  // The result has the digits of both arguments, so a short decimal result
+  // means that the product has at most 18 digits.
+  static constexpr bool kShortNoOverflow = true;
+
+  inline static int64_t applyShort(int64_t a, int64_t b) {
+    return a * b;
+  }
+
   template <typename R, typename A, typename B>
   inline static void
   apply(R& r, const A& a, const B& b, uint8_t aRescale, uint8_t bRescale) {
@@ -376,6 +464,9 @@ class Multiply {
 
 class Divide {
  public:
+  // Rounds, so it has no short path.
+  static constexpr bool kShortNoOverflow = false;
+
   template <typename R, typename A, typename B>
   inline static void
   apply(R& r, const A& a, const B& b, uint8_t aRescale, uint8_t /*bRescale*/) {
@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "velox/functions/prestosql/JsonExtractScalarMulti.h"
+
+#include "velox/expression/ConstantExpr.h"
+#include "velox/expression/VectorFunction.h"
+#include "velox/functions/prestosql/SIMDJsonFunctions.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+class JsonExtractScalarMultiFunction : public exec::VectorFunction {
+ public:
+  explicit JsonExtractScalarMultiFunction(
+      const std::vector<std::string>& paths) {
+    extractors_.reserve(paths.size());
+    for (const auto& path : paths) {
+      extractors_.push_back(detail::SIMDJsonExtractor::make(path));
+    }
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    exec::LocalDecodedVector decodedJson(context, *args[0], rows);
+
+    std::vector<VectorPtr> children(extractors_.size());
+    std::vector<FlatVector<StringView>*> flatChildren(extractors_.size());
+    for (auto i = 0; i < extractors_.size(); ++i) {
+      children[i] = BaseVector::create(VARCHAR(), rows.end(), context.pool());
+      flatChildren[i] = children[i]->asFlatVector<StringView>();
+    }
+
+    context.applyToSelectedNoThrow(rows, [&](auto row) {
+      extractAll(decodedJson->valueAt<StringView>(row), row, flatChildren);
+    });
+
+    auto localResult = std::make_shared<RowVector>(
+        context.pool(), outputType, nullptr, rows.end(), std::move(children));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+ private:
+  bool parse(
+      const simdjson::padded_string& json,
+      simdjson::ondemand::document& jsonDoc) const {
+    SIMDJSON_ASSIGN_OR_RAISE(jsonDoc, extractors_[0]->parse(json));
+    return true;
+  }
+
+  // Sets 'row' of each of 'results' to the value at the corresponding path
+  // in 'json'. The document is indexed once and each path is walked from the
+  // start of the document.
+  void extractAll(
+      const StringView& json,
+      vector_size_t row,
+      std::vector<FlatVector<StringView>*>& results) const {
+    simdjson::padded_string paddedJson(json.data(), json.size());
+    simdjson::ondemand::document jsonDoc;
+    bool needsParse = true;
+    for (auto i = 0; i < extractors_.size(); ++i) {
+      if (needsParse) {
+        if (!parse(paddedJson, jsonDoc)) {
+          for (; i < extractors_.size(); ++i) {
+            results[i]->setNull(row, true);
+          }
+          return;
+        }
+        needsParse = false;
+      } else {
+        jsonDoc.rewind();
+      }
+
+      bool jsonError = false;
+      std::optional<std::string> value;
+      if (detail::extractJsonScalar(
+              [&](auto& consumer) {
+                jsonError =
+                    !simdJsonExtract(jsonDoc, *extractors_[i], consumer);
+                return !jsonError;
+              },
+              value)) {
+        results[i]->set(row, StringView(*value));
+      } else {
+        results[i]->setNull(row, true);
+      }
+      // The on-demand parser validates the document lazily, so that an error
+      // may be seen on one path and not on another. The iterator is not
+      // usable after an error, so the next path starts from a new parse.
+      needsParse = jsonError;
+    }
+  }
+
+  std::vector<std::shared_ptr<detail::SIMDJsonExtractor>> extractors_;
+};
+
+bool isJsonExtractScalarCall(
+    const std::string& prefix,
+    const core::CallTypedExpr& call) {
+  return call.name() == prefix + "json_extract_scalar" &&
+      call.inputs().size() == 2;
+}
+
+// Returns the path of a json_extract_scalar call if it is a valid constant.
+std::optional<std::string> constantPath(const core::TypedExprPtr& expr) {
+  auto constant = dynamic_cast<const core::ConstantTypedExpr*>(expr.get());
+  if (constant == nullptr || constant->type()->kind() != TypeKind::VARCHAR) {
+    return std::nullopt;
+  }
+  std::string path;
+  if (constant->hasValueVector()) {
+    const auto& vector = constant->valueVector();
+    if (vector->isNullAt(0)) {
+      return std::nullopt;
+    }
+    path = vector->as<SimpleVector<StringView>>()->valueAt(0).str();
+  } else {
+    if (constant->value().isNull()) {
+      return std::nullopt;
+    }
+    path = constant->value().value<TypeKind::VARCHAR>();
+  }
+  if (JsonPathTokenizer::getTokens(folly::trimWhitespace(path)) == nullptr) {
+    // Leave invalid paths to json_extract_scalar, which reports the error.
+    return std::nullopt;
+  }
+  return path;
+}
+
+// The distinct paths extracted from one JSON input.
+struct PathGroup {
+  core::TypedExprPtr json;
+  std::vector<std::string> paths;
+  std::vector<core::TypedExprPtr> pathExprs;
+  // The shared multi-path call. Set if there are at least 2 paths.
+  core::TypedExprPtr multiCall;
+};
+
+PathGroup* findGroup(
+    const core::TypedExprPtr& json,
+    std::vector<PathGroup>& groups) {
+  for (auto& group : groups) {
+    if (*group.json == *json) {
+      return &group;
+    }
+  }
+  return nullptr;
+}
+
+// Only calls and casts are traversed. Other expressions, e.g. lambdas, are
+// left as they are.
+void collectPaths(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr,
+    std::vector<PathGroup>& groups) {
+  auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr &&
+      dynamic_cast<const core::CastTypedExpr*>(expr.get()) == nullptr) {
+    return;
+  }
+  if (call != nullptr && isJsonExtractScalarCall(prefix, *call)) {
+    if (auto path = constantPath(call->inputs()[1])) {
+      const auto& json = call->inputs()[0];
+      auto* group = findGroup(json, groups);
+      if (group == nullptr) {
+        group = &groups.emplace_back(PathGroup{json});
+      }
+      if (std::find(group->paths.begin(), group->paths.end(), *path) ==
+          group->paths.end()) {
+        group->paths.push_back(*path);
+        group->pathExprs.push_back(call->inputs()[1]);
+      }
+      return;
+    }
+  }
+  for (const auto& input : expr->inputs()) {
+    collectPaths(prefix, input, groups);
+  }
+}
+
+core::TypedExprPtr rewritePaths(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr,
+    std::vector<PathGroup>& groups) {
+  auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  auto cast = dynamic_cast<const core::CastTypedExpr*>(expr.get());
+  if (call == nullptr && cast == nullptr) {
+    return expr;
+  }
+  if (call != nullptr && isJsonExtractScalarCall(prefix, *call)) {
+    if (auto path = constantPath(call->inputs()[1])) {
+      auto* group = findGroup(call->inputs()[0], groups);
+      VELOX_CHECK_NOT_NULL(group);
+      if (group->multiCall == nullptr) {
+        return expr;
+      }
+      auto it = std::find(group->paths.begin(), group->paths.end(), *path);
+      return std::make_shared<core::DereferenceTypedExpr>(
+          call->type(), group->multiCall, it - group->paths.begin());
+    }
+  }
+
+  std::vector<core::TypedExprPtr> inputs;
+  inputs.reserve(expr->inputs().size());
+  bool changed = false;
+  for (const auto& input : expr->inputs()) {
+    inputs.push_back(rewritePaths(prefix, input, groups));
+    changed |= inputs.back() != input;
+  }
+  if (!changed) {
+    return expr;
+  }
+  if (call != nullptr) {
+    return std::make_shared<core::CallTypedExpr>(
+        call->type(), std::move(inputs), call->name());
+  }
+  return std::make_shared<core::CastTypedExpr>(
+      cast->type(), inputs, cast->nullOnFailure());
+}
+
+} // namespace
+
+TypePtr JsonExtractScalarMultiCallToSpecialForm::resolveType(
+    const std::vector<TypePtr>& argTypes) {
+  VELOX_USER_CHECK_GE(
+      argTypes.size(),
+      2,
+      "{} expects a JSON input and at least one path",
+      kJsonExtractScalarMulti);
+  VELOX_USER_CHECK_EQ(
+      argTypes[0]->kind(),
+      TypeKind::VARCHAR,
+      "{} expects a JSON or VARCHAR input",
+      kJsonExtractScalarMulti);
+  for (auto i = 1; i < argTypes.size(); ++i) {
+    VELOX_USER_CHECK_EQ(
+        argTypes[i]->kind(),
+        TypeKind::VARCHAR,
+        "{} expects VARCHAR paths",
+        kJsonExtractScalarMulti);
+  }
+  return ROW(std::vector<TypePtr>(argTypes.size() - 1, VARCHAR()));
+}
+
+exec::ExprPtr JsonExtractScalarMultiCallToSpecialForm::constructSpecialForm(
+    const TypePtr& type,
+    std::vector<exec::ExprPtr>&& compiledChildren,
+    bool trackCpuUsage,
+    const core::QueryConfig& /*config*/) {
+  std::vector<std::string> paths;
+  for (auto i = 1; i < compiledChildren.size(); ++i) {
+    auto constant =
+        dynamic_cast<const exec::ConstantExpr*>(compiledChildren[i].get());
+    VELOX_USER_CHECK(
+        constant != nullptr && !constant->value()->isNullAt(0),
+        "{} expects constant, non-null paths",
+        kJsonExtractScalarMulti);
+    paths.push_back(
+        constant->value()->as<SimpleVector<StringView>>()->valueAt(0).str());
+  }
+  return std::make_shared<exec::Expr>(
+      type,
+      std::move(compiledChildren),
+      std::make_shared<JsonExtractScalarMultiFunction>(paths),
+      kJsonExtractScalarMulti,
+      trackCpuUsage);
+}
+
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalarCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  std::vector<PathGroup> groups;
+  for (const auto& expr : exprs) {
+    collectPaths(prefix, expr, groups);
+  }
+
+  bool hasMultiCall = false;
+  for (auto& group : groups) {
+    if (group.paths.size() < 2) {
+      continue;
+    }
+    std::vector<core::TypedExprPtr> inputs{group.json};
+    inputs.insert(
+        inputs.end(), group.pathExprs.begin(), group.pathExprs.end());
+    group.multiCall = std::make_shared<core::CallTypedExpr>(
+        ROW(std::vector<TypePtr>(group.paths.size(), VARCHAR())),
+        std::move(inputs),
+        JsonExtractScalarMultiCallToSpecialForm::kJsonExtractScalarMulti);
+    hasMultiCall = true;
+  }
+  if (!hasMultiCall) {
+    return {};
+  }
+
+  std::vector<core::TypedExprPtr> rewritten;
+  rewritten.reserve(exprs.size());
+  for (const auto& expr : exprs) {
+    rewritten.push_back(rewritePaths(prefix, expr, groups));
+  }
+  return rewritten;
+}
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#pragma once
+
+#include "velox/core/Expressions.h"
+#include "velox/expression/FunctionCallToSpecialForm.h"
+
+namespace facebook::velox::functions {
+
+/// Extracts several constant JSON paths from the same JSON document with one
+/// parse of the document per row:
+///
+///     $internal$json_extract_scalar_multi(json, path1, ..., pathN)
+///
+/// returns a ROW of N VARCHARs where field i is the same as
+/// json_extract_scalar(json, path<i + 1>).
+class JsonExtractScalarMultiCallToSpecialForm
+    : public exec::FunctionCallToSpecialForm {
+ public:
+  TypePtr resolveType(const std::vector<TypePtr>& argTypes) override;
+
+  exec::ExprPtr constructSpecialForm(
+      const TypePtr& type,
+      std::vector<exec::ExprPtr>&& compiledChildren,
+      bool trackCpuUsage,
+      const core::QueryConfig& config) override;
+
+  static constexpr const char* kJsonExtractScalarMulti =
+      "$internal$json_extract_scalar_multi";
+};
+
+/// Rewrites the json_extract_scalar calls in 'exprs' that extract different
+/// constant paths from the same JSON input into field accesses of one shared
+/// $internal$json_extract_scalar_multi call. For example, rewrites
+///
+///     json_extract_scalar(c0, '$.a'), json_extract_scalar(c0, '$.b')
+///
+/// into
+///
+///     multi(c0, '$.a', '$.b')[0], multi(c0, '$.a', '$.b')[1]
+///
+/// The shared call is then evaluated once per batch as a common
+/// subexpression. Calls inside lambdas are not rewritten. Returns an empty
+/// vector if there is nothing to rewrite.
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalarCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs);
+
+} // namespace facebook::velox::functions
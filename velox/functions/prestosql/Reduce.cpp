@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/expression/VectorFunction.h"
+#include "velox/common/base/CheckedArithmetic.h"
 #include "velox/functions/lib/LambdaFunctionUtil.h"
 
 namespace facebook::velox::functions {
@@ -52,6 +53,127 @@ bool toNthElementRows(
   return arrayRows.hasSelections();
 }
 
+/// Returns true if 'inputFunction' is (s, x) -> s + x or (s, x) -> x + s
+/// over a numeric type. Sets 'stateFirst' to true if 's' is the first
+/// argument of plus.
+bool isSumStep(
+    const Callable& inputFunction,
+    const TypePtr& stateType,
+    const TypePtr& elementType,
+    bool& stateFirst) {
+  if (!stateType->equivalent(*elementType) || stateType->isDecimal()) {
+    return false;
+  }
+  switch (stateType->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      break;
+    default:
+      return false;
+  }
+  if (!stateType->equivalent(*createScalarType(stateType->kind()))) {
+    return false;
+  }
+  auto call = inputFunction.simpleCall();
+  if (!call.has_value() || call->parameters.size() != 2 ||
+      call->parameters[0] == call->parameters[1]) {
+    return false;
+  }
+  const auto& name = call->name;
+  if (name != "plus" &&
+      !(name.size() > 5 && name.compare(name.size() - 5, 5, ".plus") == 0)) {
+    return false;
+  }
+  stateFirst = call->parameters[0] == 0;
+  return true;
+}
+
+/// Computes the reduce step (s, x) -> s + x over all elements of each array
+/// in one loop, in the same order and with the same overflow checks as
+/// evaluating the lambda one element at a time. A null state or element
+/// makes the state null.
+template <typename T>
+void sumElements(
+    const SelectivityVector& rows,
+    const ArrayVector& arrays,
+    const BaseVector& initialState,
+    bool stateFirst,
+    exec::EvalCtx& context,
+    VectorPtr& partialResult) {
+  exec::LocalDecodedVector initialDecoder(context, initialState, rows);
+  auto& initial = *initialDecoder.get();
+  const auto& elementsVector = arrays.elements();
+  exec::LocalSelectivityVector elementRows(context);
+  exec::LocalDecodedVector elementsDecoder(
+      context, *elementsVector, *elementRows.get(elementsVector->size(), true));
+  auto& elements = *elementsDecoder.get();
+  auto* rawOffsets = arrays.rawOffsets();
+  auto* rawSizes = arrays.rawSizes();
+  auto* flatResult = partialResult->asFlatVector<T>();
+
+  auto add = [&](T left, T right) {
+    if constexpr (std::is_floating_point_v<T>) {
+      return left + right;
+    } else {
+      return checkedPlus<T>(left, right);
+    }
+  };
+
+  context.applyToSelectedNoThrow(rows, [&](auto row) {
+    if (initial.isNullAt(row)) {
+      flatResult->setNull(row, true);
+      return;
+    }
+    T state = initial.valueAt<T>(row);
+    const auto end = rawOffsets[row] + rawSizes[row];
+    for (auto i = rawOffsets[row]; i < end; ++i) {
+      if (elements.isNullAt(i)) {
+        flatResult->setNull(row, true);
+        return;
+      }
+      const T element = elements.valueAt<T>(i);
+      state = stateFirst ? add(state, element) : add(element, state);
+    }
+    flatResult->set(row, state);
+  });
+}
+
+void sumElements(
+    TypeKind kind,
+    const SelectivityVector& rows,
+    const ArrayVector& arrays,
+    const BaseVector& initialState,
+    bool stateFirst,
+    exec::EvalCtx& context,
+    VectorPtr& partialResult) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+      return sumElements<int8_t>(
+          rows, arrays, initialState, stateFirst, context, partialResult);
+    case TypeKind::SMALLINT:
+      return sumElements<int16_t>(
+          rows, arrays, initialState, stateFirst, context, partialResult);
+    case TypeKind::INTEGER:
+      return sumElements<int32_t>(
+          rows, arrays, initialState, stateFirst, context, partialResult);
+    case TypeKind::BIGINT:
+      return sumElements<int64_t>(
+          rows, arrays, initialState, stateFirst, context, partialResult);
+    case TypeKind::REAL:
+      return sumElements<float>(
+          rows, arrays, initialState, stateFirst, context, partialResult);
+    case TypeKind::DOUBLE:
+      return sumElements<double>(
+          rows, arrays, initialState, stateFirst, context, partialResult);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
 /// See documentation at
 /// https://prestodb.io/docs/current/functions/array.html#reduce
 class ReduceFunction : public exec::VectorFunction {
@@ -116,6 +238,23 @@ class ReduceFunction : public exec::VectorFunction {
     // At each step the number of arrays being processed will get smaller as
     // some arrays will run out of elements.
     while (auto entry = inputFuncIt.next()) {
+      bool stateFirst;
+      if (isSumStep(
+              *entry.callable,
+              initialState->type(),
+              flatArray->elements()->type(),
+              stateFirst)) {
+        sumElements(
+            initialState->type()->kind(),
+            *entry.rows,
+            *flatArray,
+            *initialState,
+            stateFirst,
+            context,
+            partialResult);
+        continue;
+      }
+
       VectorPtr state = initialState;
 
       vector_size_t n = 0;
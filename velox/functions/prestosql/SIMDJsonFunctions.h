@@ -163,6 +163,56 @@ struct SIMDJsonArrayLengthFunction {
   }
 };
 
+namespace detail {
+
+// Extracts the value for json_extract_scalar() into 'result'. 'extract' takes
+// the consumer of the selected values and returns false on a JSON error.
+// Returns false if the result is null.
+template <typename TExtract>
+bool extractJsonScalar(TExtract&& extract, std::optional<std::string>& result) {
+  bool resultPopulated = false;
+  auto consumer = [&result, &resultPopulated](auto& v) {
+    if (resultPopulated) {
+      // We should just get a single value, if we see multiple, it's an error
+      // and we should return null.
+      result = std::nullopt;
+      return true;
+    }
+
+    resultPopulated = true;
+
+    SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
+    switch (vtype) {
+      case simdjson::ondemand::json_type::boolean: {
+        SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
+        result = vbool ? "true" : "false";
+        break;
+      }
+      case simdjson::ondemand::json_type::string: {
+        SIMDJSON_ASSIGN_OR_RAISE(result, v.get_string());
+        break;
+      }
+      case simdjson::ondemand::json_type::object:
+      case simdjson::ondemand::json_type::array:
+      case simdjson::ondemand::json_type::null:
+        // Do nothing.
+        break;
+      default: {
+        SIMDJSON_ASSIGN_OR_RAISE(result, simdjson::to_json_string(v));
+      }
+    }
+    return true;
+  };
+
+  if (!extract(consumer)) {
+    // If there's an error parsing the JSON, return null.
+    return false;
+  }
+  return result.has_value();
+}
+
+} // namespace detail
+
 // jsonExtractScalar(json, json_path) -> varchar
 // Like jsonExtract(), but returns the result value as a string (as opposed
 // to being encoded as JSON). The value referenced by json_path must be a scalar
@@ -175,52 +225,16 @@ struct SIMDJsonExtractScalarFunction {
       out_type<Varchar>& result,
       const arg_type<Json>& json,
       const arg_type<Varchar>& jsonPath) {
-    bool resultPopulated = false;
     std::optional<std::string> resultStr;
-    auto consumer = [&resultStr, &resultPopulated](auto& v) {
-      if (resultPopulated) {
-        // We should just get a single value, if we see multiple, it's an error
-        // and we should return null.
-        resultStr = std::nullopt;
-        return true;
-      }
-
-      resultPopulated = true;
-
-      SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
-      switch (vtype) {
-        case simdjson::ondemand::json_type::boolean: {
-          SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
-          resultStr = vbool ? "true" : "false";
-          break;
-        }
-        case simdjson::ondemand::json_type::string: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
-          break;
-        }
-        case simdjson::ondemand::json_type::object:
-        case simdjson::ondemand::json_type::array:
-        case simdjson::ondemand::json_type::null:
-          // Do nothing.
-          break;
-        default: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
-        }
-      }
-      return true;
-    };
-
-    if (!simdJsonExtract(json, jsonPath, consumer)) {
-      // If there's an error parsing the JSON, return null.
-      return false;
-    }
-
-    if (resultStr.has_value()) {
-      result.copy_from(*resultStr);
-      return true;
-    } else {
+    if (!detail::extractJsonScalar(
+            [&](auto& consumer) {
+              return simdJsonExtract(json, jsonPath, consumer);
+            },
+            resultStr)) {
       return false;
     }
+    result.copy_from(*resultStr);
+    return true;
   }
 };
 
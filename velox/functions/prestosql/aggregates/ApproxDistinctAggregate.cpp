@@ -212,6 +212,7 @@ class ApproxDistinctAggregate : public exec::Aggregate {
       addIntermediateResults(groups, rows, args, false /*unused*/);
     } else {
       decodeArguments(rows, args);
+      computeHashes(rows);
 
       rows.applyToSelected([&](auto row) {
         if (decodedValue_.isNullAt(row)) {
@@ -224,8 +225,7 @@ class ApproxDistinctAggregate : public exec::Aggregate {
         clearNull(group);
         accumulator->setIndexBitLength(indexBitLength_);
 
-        auto hash = hashOne(decodedValue_.valueAt<T>(row));
-        accumulator->append(hash);
+        accumulator->append(hashes_[row]);
       });
     }
   }
@@ -263,6 +263,7 @@ class ApproxDistinctAggregate : public exec::Aggregate {
       addSingleGroupIntermediateResults(group, rows, args, false /*unused*/);
     } else {
       decodeArguments(rows, args);
+      computeHashes(rows);
 
       rows.applyToSelected([&](auto row) {
         if (decodedValue_.isNullAt(row)) {
@@ -273,8 +274,7 @@ class ApproxDistinctAggregate : public exec::Aggregate {
         clearNull(group);
         accumulator->setIndexBitLength(indexBitLength_);
 
-        auto hash = hashOne(decodedValue_.valueAt<T>(row));
-        accumulator->append(hash);
+        accumulator->append(hashes_[row]);
       });
     }
   }
@@ -352,6 +352,26 @@ class ApproxDistinctAggregate : public exec::Aggregate {
     }
   }
 
+  // Hashes the non-null values of 'decodedValue_' into 'hashes_' in a loop
+  // of its own, before the values are added to the accumulators of their
+  // groups. The hashes of consecutive rows are independent, so the loop
+  // overlaps them instead of interleaving each with an update of a
+  // different accumulator.
+  void computeHashes(const SelectivityVector& rows) {
+    hashes_.resize(rows.end());
+    if (!decodedValue_.mayHaveNulls()) {
+      rows.applyToSelected([&](auto row) {
+        hashes_[row] = hashOne(decodedValue_.valueAt<T>(row));
+      });
+      return;
+    }
+    rows.applyToSelected([&](auto row) {
+      if (!decodedValue_.isNullAt(row)) {
+        hashes_[row] = hashOne(decodedValue_.valueAt<T>(row));
+      }
+    });
+  }
+
   void checkSetMaxStandardError() {
     VELOX_USER_CHECK(
         decodedMaxStandardError_.isConstantMapping(),
@@ -389,6 +409,8 @@ class ApproxDistinctAggregate : public exec::Aggregate {
   DecodedVector decodedValue_;
   DecodedVector decodedMaxStandardError_;
   DecodedVector decodedHll_;
+  // Hashes of the values of 'decodedValue_' by row.
+  std::vector<uint64_t> hashes_;
 };
 
 template <TypeKind kind>
@@ -52,6 +52,10 @@ struct KllSketchAccumulator {
     sketch_.insert(value);
   }
 
+  void append(folly::Range<const T*> values) {
+    sketch_.insert(values);
+  }
+
   void append(T value, int64_t count) {
     constexpr size_t kMaxBufferSize = 4096;
     constexpr int64_t kMinCountToBuffer = 512;
@@ -71,7 +75,7 @@ struct KllSketchAccumulator {
     sketch_.mergeViews(folly::Range(&view, 1));
   }
 
-  void append(const std::vector<typename KllSketch<T>::View>& views) {
+  void append(folly::Range<const typename KllSketch<T>::View*> views) {
     sketch_.mergeViews(views);
   }
 
@@ -394,19 +398,21 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         accumulator->append(value, weight);
       });
     } else {
+      // Insert the values in bulk.
+      values_.clear();
       if (decodedValue_.mayHaveNulls()) {
         rows.applyToSelected([&](auto row) {
-          if (decodedValue_.isNullAt(row)) {
-            return;
+          if (!decodedValue_.isNullAt(row)) {
+            values_.push_back(decodedValue_.valueAt<T>(row));
           }
-
-          accumulator->append(decodedValue_.valueAt<T>(row));
         });
       } else {
         rows.applyToSelected([&](auto row) {
-          accumulator->append(decodedValue_.valueAt<T>(row));
+          values_.push_back(decodedValue_.valueAt<T>(row));
         });
       }
+      accumulator->append(
+          folly::Range<const T*>(values_.data(), values_.size()));
     }
   }
 
@@ -613,6 +619,8 @@ class ApproxPercentileAggregate : public exec::Aggregate {
   DecodedVector decodedWeight_;
   DecodedVector decodedAccuracy_;
   DecodedVector decodedDigest_;
+  // Non-null input values of a batch for a single group.
+  std::vector<T> values_;
 
  private:
   template <bool kSingleGroup, bool checkIntermediateInputs>
@@ -678,9 +686,9 @@ class ApproxPercentileAggregate : public exec::Aggregate {
 
     KllSketchAccumulator<T>* accumulator = nullptr;
     std::vector<typename KllSketch<T>::View> views;
-    if constexpr (kSingleGroup) {
-      views.reserve(rows.end());
-    }
+    // Group and index in 'views' of each view if not kSingleGroup.
+    std::vector<std::pair<char*, vector_size_t>> viewGroups;
+    views.reserve(rows.end());
     rows.applyToSelected([&](auto row) {
       if (decoded.isNullAt(row)) {
         return;
@@ -737,18 +745,38 @@ class ApproxPercentileAggregate : public exec::Aggregate {
               {rawLevels + levels->offsetAt(i),
                static_cast<size_t>(levels->sizeAt(i))},
       };
-      if constexpr (kSingleGroup) {
-        views.push_back(v);
-      } else {
-        auto tracker = trackRowSize(group[row]);
-        accumulator->append(v);
+      if constexpr (!kSingleGroup) {
+        viewGroups.emplace_back(group[row], views.size());
       }
+      views.push_back(v);
     });
     if constexpr (kSingleGroup) {
       if (!views.empty()) {
         auto tracker = trackRowSize(group);
         accumulator->append(views);
       }
+    } else {
+      // Merge all the views of a group at once, which is a single multi-way
+      // merge per level instead of one merge per view.
+      std::stable_sort(
+          viewGroups.begin(),
+          viewGroups.end(),
+          [](const auto& left, const auto& right) {
+            return left.first < right.first;
+          });
+      std::vector<typename KllSketch<T>::View> groupViews;
+      for (size_t begin = 0; begin < viewGroups.size();) {
+        auto* groupPtr = viewGroups[begin].first;
+        groupViews.clear();
+        auto end = begin;
+        for (; end < viewGroups.size() && viewGroups[end].first == groupPtr;
+             ++end) {
+          groupViews.push_back(views[viewGroups[end].second]);
+        }
+        auto tracker = trackRowSize(groupPtr);
+        value<KllSketchAccumulator<T>>(groupPtr)->append(groupViews);
+        begin = end;
+      }
     }
   }
 };
@@ -37,6 +37,30 @@ class BitwiseXorAggregate {
     return true;
   }
 
+  struct AccumulatorType;
+
+  static void addInputBatch(
+      HashStringAllocator* /*allocator*/,
+      AccumulatorType** accumulators,
+      vector_size_t size,
+      const T* data) {
+    for (auto i = 0; i < size; ++i) {
+      accumulators[i]->xor_ ^= data[i];
+    }
+  }
+
+  static void addSingleGroupInputBatch(
+      HashStringAllocator* /*allocator*/,
+      AccumulatorType& accumulator,
+      vector_size_t size,
+      const T* data) {
+    T result = 0;
+    for (auto i = 0; i < size; ++i) {
+      result ^= data[i];
+    }
+    accumulator.xor_ ^= result;
+  }
+
   struct AccumulatorType {
     T xor_{0};
 
@@ -54,12 +54,19 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
       char** groups,
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
-      bool /*mayPushdown*/) override {
+      bool mayPushdown) override {
     if (args.empty()) {
       rows.applyToSelected([&](vector_size_t i) { addToGroup(groups[i], 1); });
       return;
     }
 
+    // Counts the non-null values in the reader without making a vector.
+    if (mayPushdown && args[0]->isLazy() &&
+        isPushdownType(args[0]->typeKind())) {
+      BaseAggregate::template pushdown<CountHook>(groups, rows, args[0]);
+      return;
+    }
+
     DecodedVector decoded(*args[0], rows);
     if (decoded.isConstantMapping()) {
       if (!decoded.isNullAt(0)) {
@@ -89,6 +96,52 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
     });
   }
 
+  bool supportsDenseAccumulators() const override {
+    return true;
+  }
+
+  void addDenseInput(
+      const vector_size_t* groupIndices,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool isRawInput,
+      BaseVector& accumulators) override {
+    auto* rawCounts =
+        accumulators.asUnchecked<FlatVector<int64_t>>()->mutableRawValues();
+    auto* rawNulls = accumulators.mutableRawNulls();
+    // The result of count is never null, so every group with a row is set.
+    rows.applyToSelected(
+        [&](vector_size_t i) { bits::clearNull(rawNulls, groupIndices[i]); });
+    if (args.empty()) {
+      rows.applyToSelected(
+          [&](vector_size_t i) { ++rawCounts[groupIndices[i]]; });
+      return;
+    }
+
+    DecodedVector decoded(*args[0], rows);
+    if (!isRawInput) {
+      rows.applyToSelected([&](vector_size_t i) {
+        if (!decoded.isNullAt(i)) {
+          rawCounts[groupIndices[i]] += decoded.valueAt<int64_t>(i);
+        }
+      });
+    } else if (decoded.isConstantMapping()) {
+      if (!decoded.isNullAt(0)) {
+        rows.applyToSelected(
+            [&](vector_size_t i) { ++rawCounts[groupIndices[i]]; });
+      }
+    } else if (decoded.mayHaveNulls()) {
+      rows.applyToSelected([&](vector_size_t i) {
+        if (!decoded.isNullAt(i)) {
+          ++rawCounts[groupIndices[i]];
+        }
+      });
+    } else {
+      rows.applyToSelected(
+          [&](vector_size_t i) { ++rawCounts[groupIndices[i]]; });
+    }
+  }
+
   void addSingleGroupRawInput(
       char* group,
       const SelectivityVector& rows,
@@ -141,6 +194,22 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
   }
 
  private:
+  // True for the types of the column readers with a fast path for CountHook.
+  static bool isPushdownType(TypeKind kind) {
+    switch (kind) {
+      case TypeKind::BOOLEAN:
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+        return true;
+      default:
+        return false;
+    }
+  }
+
   inline void addToGroup(char* group, int64_t count) {
     *value<int64_t>(group) += count;
   }
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/hash/Hash.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/memory/MemoryPool.h"
+
+namespace facebook::velox::aggregate::prestosql {
+
+/// Counts of distinct values for all groups of an aggregation in one open
+/// addressed hash table keyed on (group, value). Replaces a hash map per
+/// group, which makes many small allocations that fragment the
+/// HashStringAllocator when there are many groups with few distinct values
+/// each. The entries of a group are linked into a list, so the group's values
+/// can be listed and erased without scanning the table.
+///
+/// The accumulator of each group holds a Group, which must stay at the same
+/// address while the group has entries. The aggregate must erase the group
+/// before the Group is destroyed.
+template <typename T>
+class GroupKeyCountTable {
+ public:
+  /// The part of the table that lives in the accumulator of a group.
+  struct Group {
+    // Index of the last added entry of the group in 'entries_'. Valid if
+    // 'size' > 0.
+    int32_t firstEntry{-1};
+    // Number of distinct values of the group.
+    int32_t size{0};
+  };
+
+  explicit GroupKeyCountTable(memory::MemoryPool& pool)
+      : slots_{memory::StlAllocator<int32_t>(pool)},
+        entries_{memory::StlAllocator<Entry>(pool)} {}
+
+  /// Adds 'count' to the count of 'value' in 'group'. Returns true if
+  /// 'value' was not in 'group' before.
+  bool add(Group& group, const T& value, int64_t count) {
+    if (FOLLY_UNLIKELY((numUsedSlots_ + 1) * 4 > slots_.size() * 3)) {
+      rehash();
+    }
+    const auto hash = hashOf(group, value);
+    int32_t firstDeleted = -1;
+    for (auto slot = hash & sizeMask_;; slot = (slot + 1) & sizeMask_) {
+      const auto index = slots_[slot];
+      if (index == kEmpty) {
+        if (firstDeleted == -1) {
+          ++numUsedSlots_;
+          firstDeleted = slot;
+        }
+        slots_[firstDeleted] = newEntry(group, value, count);
+        return true;
+      }
+      if (index == kDeleted) {
+        if (firstDeleted == -1) {
+          firstDeleted = slot;
+        }
+        continue;
+      }
+      auto& entry = entries_[index];
+      if (entry.group == &group && std::equal_to<T>{}(entry.value, value)) {
+        entry.count += count;
+        return false;
+      }
+    }
+  }
+
+  /// Returns the stored copy of 'value' in 'group' or nullptr if 'group' does
+  /// not have 'value'.
+  const T* find(const Group& group, const T& value) const {
+    if (group.size == 0) {
+      return nullptr;
+    }
+    const auto hash = hashOf(group, value);
+    for (auto slot = hash & sizeMask_;; slot = (slot + 1) & sizeMask_) {
+      const auto index = slots_[slot];
+      if (index == kEmpty) {
+        return nullptr;
+      }
+      if (index != kDeleted) {
+        const auto& entry = entries_[index];
+        if (entry.group == &group && std::equal_to<T>{}(entry.value, value)) {
+          return &entry.value;
+        }
+      }
+    }
+  }
+
+  /// Calls 'func(value, count)' for each distinct value of 'group'.
+  template <typename Func>
+  void forEach(const Group& group, Func func) const {
+    auto index = group.firstEntry;
+    for (auto i = 0; i < group.size; ++i) {
+      const auto& entry = entries_[index];
+      func(entry.value, entry.count);
+      index = entry.next;
+    }
+  }
+
+  /// Removes all values of 'group' from the table. A zero-initialized Group
+  /// is empty.
+  void erase(Group& group) {
+    auto index = group.firstEntry;
+    for (auto i = 0; i < group.size; ++i) {
+      auto& entry = entries_[index];
+      const auto next = entry.next;
+      for (auto slot = hashOf(group, entry.value) & sizeMask_;;
+           slot = (slot + 1) & sizeMask_) {
+        if (slots_[slot] == index) {
+          slots_[slot] = kDeleted;
+          break;
+        }
+      }
+      entry.group = nullptr;
+      entry.next = firstFree_;
+      firstFree_ = index;
+      --numEntries_;
+      index = next;
+    }
+    group.firstEntry = -1;
+    group.size = 0;
+  }
+
+  /// Number of distinct (group, value) pairs in the table.
+  int64_t size() const {
+    return numEntries_;
+  }
+
+ private:
+  static constexpr int32_t kEmpty = -1;
+  static constexpr int32_t kDeleted = -2;
+  static constexpr size_t kInitialSize = 16;
+
+  struct Entry {
+    T value;
+    int64_t count;
+    const Group* group;
+    // Next entry of the same group or, for free entries, the next free entry.
+    int32_t next;
+  };
+
+  static uint64_t hashOf(const Group& group, const T& value) {
+    return folly::hash::hash_128_to_64(
+        std::hash<T>{}(value), reinterpret_cast<uintptr_t>(&group));
+  }
+
+  int32_t newEntry(Group& group, const T& value, int64_t count) {
+    int32_t index;
+    if (firstFree_ != -1) {
+      index = firstFree_;
+      firstFree_ = entries_[index].next;
+      entries_[index] = Entry{value, count, &group, group.firstEntry};
+    } else {
+      VELOX_CHECK_LT(
+          entries_.size(),
+          std::numeric_limits<int32_t>::max(),
+          "Too many distinct values in histogram");
+      index = entries_.size();
+      entries_.push_back(Entry{value, count, &group, group.firstEntry});
+    }
+    group.firstEntry = index;
+    ++group.size;
+    ++numEntries_;
+    return index;
+  }
+
+  // Grows the table if more than half of the used slots are live and
+  // otherwise rebuilds it at the same size to drop the deleted slots.
+  void rehash() {
+    auto newSize = std::max<size_t>(slots_.size(), kInitialSize);
+    if (numEntries_ * 2 >= numUsedSlots_) {
+      newSize = std::max<size_t>(newSize, slots_.size() * 2);
+    }
+    slots_.assign(newSize, kEmpty);
+    sizeMask_ = newSize - 1;
+    for (int32_t i = 0; i < entries_.size(); ++i) {
+      const auto& entry = entries_[i];
+      if (entry.group == nullptr) {
+        continue;
+      }
+      auto slot = hashOf(*entry.group, entry.value) & sizeMask_;
+      while (slots_[slot] != kEmpty) {
+        slot = (slot + 1) & sizeMask_;
+      }
+      slots_[slot] = i;
+    }
+    numUsedSlots_ = numEntries_;
+  }
+
+  // Indices into 'entries_' or kEmpty or kDeleted. The size is a power of 2.
+  std::vector<int32_t, memory::StlAllocator<int32_t>> slots_;
+  std::vector<Entry, memory::StlAllocator<Entry>> entries_;
+  uint64_t sizeMask_{0};
+  // Number of slots that are not kEmpty.
+  int64_t numUsedSlots_{0};
+  // Number of entries that belong to a group.
+  int64_t numEntries_{0};
+  // Head of the list of erased entries.
+  int32_t firstFree_{-1};
+};
+
+} // namespace facebook::velox::aggregate::prestosql
@@ -13,13 +13,12 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include "folly/container/F14Map.h"
-
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/Strings.h"
 #include "velox/functions/prestosql/aggregates/AggregateNames.h"
+#include "velox/functions/prestosql/aggregates/GroupKeyCountTable.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::aggregate::prestosql {
@@ -28,60 +27,59 @@ namespace {
 
 template <typename T>
 struct Accumulator {
-  using ValueMap = folly::F14FastMap<
-      T,
-      int64_t,
-      std::hash<T>,
-      std::equal_to<T>,
-      AlignedStlAllocator<std::pair<const T, int64_t>, 16>>;
-  ValueMap values;
-
-  explicit Accumulator(HashStringAllocator* allocator)
-      : values{
-            AlignedStlAllocator<std::pair<const T, int64_t>, 16>(allocator)} {}
+  using Table = GroupKeyCountTable<T>;
+
+  /// The distinct values of the group and their counts in the table shared
+  /// by all groups.
+  typename Table::Group values;
 
   size_t size() const {
-    return values.size();
+    return values.size;
   }
 
   void addValue(
       DecodedVector& decoded,
       vector_size_t index,
+      Table& table,
       HashStringAllocator* /*allocator*/) {
-    values[decoded.valueAt<T>(index)]++;
+    table.add(values, decoded.valueAt<T>(index), 1);
   }
 
   void addValueWithCount(
       T value,
       int64_t count,
+      Table& table,
       HashStringAllocator* /*allocator*/) {
-    values[value] += count;
+    table.add(values, value, count);
   }
 
   void extractValues(
+      const Table& table,
       FlatVector<T>& keys,
       FlatVector<int64_t>& counts,
-      vector_size_t offset) {
+      vector_size_t offset) const {
     auto index = offset;
-    for (const auto& [value, count] : values) {
+    table.forEach(values, [&](const T& value, int64_t count) {
       keys.set(index, value);
       counts.set(index, count);
-
       ++index;
-    }
+    });
+  }
+
+  void destroy(Table& table, HashStringAllocator* /*allocator*/) {
+    table.erase(values);
   }
 };
 
 struct StringViewAccumulator {
-  /// A map of unique StringViews pointing to storage managed by 'strings'.
+  using Table = GroupKeyCountTable<StringView>;
+
+  /// Unique StringViews pointing to storage managed by 'strings'.
   Accumulator<StringView> base;
 
   /// Stores unique non-null non-inline strings.
   Strings strings;
 
-  explicit StringViewAccumulator(HashStringAllocator* allocator)
-      : base{allocator} {}
-
   size_t size() const {
     return base.size();
   }
@@ -89,23 +87,25 @@ struct StringViewAccumulator {
   void addValue(
       DecodedVector& decoded,
       vector_size_t index,
+      Table& table,
       HashStringAllocator* allocator) {
     auto value = decoded.valueAt<StringView>(index);
-    base.values[store(value, allocator)]++;
+    table.add(base.values, store(value, table, allocator), 1);
   }
 
   void addValueWithCount(
       StringView value,
       int64_t count,
+      Table& table,
       HashStringAllocator* allocator) {
-    base.values[store(value, allocator)] += count;
+    table.add(base.values, store(value, table, allocator), count);
   }
 
-  StringView store(StringView value, HashStringAllocator* allocator) {
+  StringView
+  store(StringView value, const Table& table, HashStringAllocator* allocator) {
     if (!value.isInline()) {
-      auto it = base.values.find(value);
-      if (it != base.values.end()) {
-        value = it->first;
+      if (auto* existing = table.find(base.values, value)) {
+        value = *existing;
       } else {
         value = strings.append(value, *allocator);
       }
@@ -114,10 +114,16 @@ struct StringViewAccumulator {
   }
 
   void extractValues(
+      const Table& table,
       FlatVector<StringView>& keys,
       FlatVector<int64_t>& counts,
-      vector_size_t offset) {
-    base.extractValues(keys, counts, offset);
+      vector_size_t offset) const {
+    base.extractValues(table, keys, counts, offset);
+  }
+
+  void destroy(Table& table, HashStringAllocator* allocator) {
+    base.destroy(table, allocator);
+    strings.free(*allocator);
   }
 };
 
@@ -141,6 +147,7 @@ FOLLY_ALWAYS_INLINE void addToFinalAggregation(
     const vector_size_t* rawSizes,
     const vector_size_t* rawOffsets,
     Accumulator* accumulator,
+    GroupKeyCountTable<T>& table,
     HashStringAllocator* allocator) {
   auto size = rawSizes[index];
   auto offset = rawOffsets[index];
@@ -148,6 +155,7 @@ FOLLY_ALWAYS_INLINE void addToFinalAggregation(
     accumulator->addValueWithCount(
         mapKeys->valueAt(offset + i),
         mapValues->valueAt(offset + i),
+        table,
         allocator);
   }
 }
@@ -168,11 +176,20 @@ class HistogramAggregate : public exec::Aggregate {
     return false;
   }
 
+  // The values live in 'table_', so destroy() must be called for all groups
+  // to remove their values.
+  bool accumulatorUsesExternalMemory() const override {
+    return true;
+  }
+
   void initializeNewGroups(
       char** groups,
       folly::Range<const vector_size_t*> indices) override {
+    if (!table_) {
+      table_ = std::make_unique<GroupKeyCountTable<T>>(*allocator_->pool());
+    }
     for (auto index : indices) {
-      new (groups[index] + offset_) AccumulatorType{allocator_};
+      new (groups[index] + offset_) AccumulatorType{};
     }
   }
 
@@ -203,7 +220,7 @@ class HistogramAggregate : public exec::Aggregate {
         bits::setNull(rawNulls, i, true);
       } else {
         clearNull(rawNulls, i);
-        accumulator->extractValues(*mapKeys, *mapValues, offset);
+        accumulator->extractValues(*table_, *mapKeys, *mapValues, offset);
         offset += mapSize;
       }
     }
@@ -230,7 +247,7 @@ class HistogramAggregate : public exec::Aggregate {
       auto* accumulator = value<AccumulatorType>(group);
 
       auto tracker = trackRowSize(group);
-      accumulator->addValue(decodedKeys_, row, allocator_);
+      accumulator->addValue(decodedKeys_, row, *table_, allocator_);
     });
   }
 
@@ -246,7 +263,7 @@ class HistogramAggregate : public exec::Aggregate {
     rows.applyToSelected([&](auto row) {
       // Nulls among the values being aggregated are ignored.
       if (!decodedKeys_.isNullAt(row)) {
-        accumulator->addValue(decodedKeys_, row, allocator_);
+        accumulator->addValue(decodedKeys_, row, *table_, allocator_);
       }
     });
   }
@@ -281,6 +298,7 @@ class HistogramAggregate : public exec::Aggregate {
             rawSizes,
             rawOffsets,
             accumulator,
+            *table_,
             allocator_);
       }
     });
@@ -316,13 +334,21 @@ class HistogramAggregate : public exec::Aggregate {
             rawSizes,
             rawOffsets,
             accumulator,
+            *table_,
             allocator_);
       }
     });
   }
 
   void destroy(folly::Range<char**> groups) override {
-    destroyAccumulators<AccumulatorType>(groups);
+    for (auto* group : groups) {
+      value<AccumulatorType>(group)->destroy(*table_, allocator_);
+      destroyAccumulator<AccumulatorType>(group);
+    }
+    if (table_ && table_->size() == 0) {
+      // All groups are gone, e.g. after spilling. Free the table's memory.
+      table_.reset();
+    }
   }
 
  private:
@@ -336,6 +362,9 @@ class HistogramAggregate : public exec::Aggregate {
 
   DecodedVector decodedKeys_;
   DecodedVector decodedIntermediate_;
+
+  // Distinct values and counts of all groups. Created with the first group.
+  std::unique_ptr<GroupKeyCountTable<T>> table_;
 };
 
 exec::AggregateRegistrationResult registerHistogram(const std::string& name) {
@@ -51,6 +51,10 @@ class MinMaxAggregate : public SimpleNumericAggregate<T, T, T> {
     return true;
   }
 
+  bool supportsDenseAccumulators() const override {
+    return std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+  }
+
   void toIntermediate(
       const SelectivityVector& rows,
       std::vector<VectorPtr>& args,
@@ -164,6 +168,25 @@ class MaxAggregate : public MinMaxAggregate<T> {
     addRawInput(groups, rows, args, mayPushdown);
   }
 
+  void addDenseInput(
+      const vector_size_t* groupIndices,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool /*isRawInput*/,
+      BaseVector& accumulators) override {
+    BaseAggregate::template updateDenseGroups<T>(
+        groupIndices,
+        rows,
+        args[0],
+        accumulators,
+        [](T& result, T value) {
+          if (result < value) {
+            result = value;
+          }
+        },
+        kInitialValue_);
+  }
+
   void addSingleGroupRawInput(
       char* group,
       const SelectivityVector& rows,
@@ -249,6 +272,25 @@ class MinAggregate : public MinMaxAggregate<T> {
     addRawInput(groups, rows, args, mayPushdown);
   }
 
+  void addDenseInput(
+      const vector_size_t* groupIndices,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool /*isRawInput*/,
+      BaseVector& accumulators) override {
+    BaseAggregate::template updateDenseGroups<T>(
+        groupIndices,
+        rows,
+        args[0],
+        accumulators,
+        [](T& result, T value) {
+          if (result > value) {
+            result = value;
+          }
+        },
+        kInitialValue_);
+  }
+
   void addSingleGroupRawInput(
       char* group,
       const SelectivityVector& rows,
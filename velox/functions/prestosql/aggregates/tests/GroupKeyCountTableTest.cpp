@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/prestosql/aggregates/GroupKeyCountTable.h"
+#include <gtest/gtest.h>
+#include <map>
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::aggregate::prestosql {
+
+namespace {
+
+class GroupKeyCountTableTest : public testing::Test,
+                               public test::VectorTestBase {
+ protected:
+  template <typename T>
+  static std::map<T, int64_t> toMap(
+      const GroupKeyCountTable<T>& table,
+      const typename GroupKeyCountTable<T>::Group& group) {
+    std::map<T, int64_t> result;
+    table.forEach(group, [&](const T& value, int64_t count) {
+      EXPECT_TRUE(result.emplace(value, count).second);
+    });
+    EXPECT_EQ(result.size(), static_cast<size_t>(group.size));
+    return result;
+  }
+};
+
+TEST_F(GroupKeyCountTableTest, basic) {
+  GroupKeyCountTable<int64_t> table(*pool());
+  std::vector<GroupKeyCountTable<int64_t>::Group> groups(3);
+
+  EXPECT_TRUE(table.add(groups[0], 1, 1));
+  EXPECT_TRUE(table.add(groups[1], 1, 2));
+  EXPECT_FALSE(table.add(groups[0], 1, 5));
+  EXPECT_TRUE(table.add(groups[0], 2, 1));
+  EXPECT_EQ(3, table.size());
+
+  EXPECT_EQ(
+      (std::map<int64_t, int64_t>{{1, 6}, {2, 1}}), toMap(table, groups[0]));
+  EXPECT_EQ((std::map<int64_t, int64_t>{{1, 2}}), toMap(table, groups[1]));
+  EXPECT_TRUE(toMap(table, groups[2]).empty());
+
+  EXPECT_EQ(2, *table.find(groups[0], 2));
+  EXPECT_EQ(nullptr, table.find(groups[1], 2));
+  EXPECT_EQ(nullptr, table.find(groups[2], 1));
+
+  table.erase(groups[0]);
+  EXPECT_EQ(1, table.size());
+  EXPECT_TRUE(toMap(table, groups[0]).empty());
+  EXPECT_EQ(nullptr, table.find(groups[0], 1));
+  EXPECT_EQ((std::map<int64_t, int64_t>{{1, 2}}), toMap(table, groups[1]));
+
+  // Erasing a zero-initialized group is a no-op.
+  GroupKeyCountTable<int64_t>::Group zeroed;
+  memset(&zeroed, 0, sizeof(zeroed));
+  table.erase(zeroed);
+  EXPECT_EQ(1, table.size());
+}
+
+// Many groups with different numbers of distinct values, repeatedly erasing
+// some of the groups so that the table reuses entries and deleted slots.
+TEST_F(GroupKeyCountTableTest, manyGroups) {
+  constexpr int32_t kNumGroups = 1'000;
+  GroupKeyCountTable<int32_t> table(*pool());
+  std::vector<GroupKeyCountTable<int32_t>::Group> groups(kNumGroups);
+  std::vector<std::map<int32_t, int64_t>> expected(kNumGroups);
+
+  int32_t counter = 0;
+  for (auto round = 0; round < 10; ++round) {
+    for (auto i = 0; i < 10'000; ++i) {
+      const auto group = (i * 7 + round) % kNumGroups;
+      const int32_t value = (++counter * 31) % (1 + group % 50);
+      const bool isNew = expected[group].count(value) == 0;
+      EXPECT_EQ(isNew, table.add(groups[group], value, 2));
+      expected[group][value] += 2;
+    }
+    for (auto group = round; group < kNumGroups; group += 10) {
+      table.erase(groups[group]);
+      expected[group].clear();
+    }
+
+    int64_t numValues = 0;
+    for (auto group = 0; group < kNumGroups; ++group) {
+      ASSERT_EQ(expected[group], toMap(table, groups[group]));
+      numValues += expected[group].size();
+    }
+    ASSERT_EQ(numValues, table.size());
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::aggregate::prestosql
@@ -64,21 +64,11 @@ class JsonExtractor {
 
  private:
   bool tokenize(const std::string& path) {
-    if (path.empty()) {
+    auto tokens = JsonPathTokenizer::getTokens(path);
+    if (tokens == nullptr) {
       return false;
     }
-    if (!kTokenizer.reset(path)) {
-      return false;
-    }
-
-    while (kTokenizer.hasNext()) {
-      if (auto token = kTokenizer.getNext()) {
-        tokens_.push_back(token.value());
-      } else {
-        tokens_.clear();
-        return false;
-      }
-    }
+    tokens_ = *tokens;
     return true;
   }
 
@@ -87,7 +77,6 @@ class JsonExtractor {
   thread_local static std::
       unordered_map<std::string, std::shared_ptr<JsonExtractor>>
           kExtractorCache;
-  thread_local static JsonPathTokenizer kTokenizer;
 
   // Max extractor number in extractor cache
   static const uint32_t kMaxCacheNum{32};
@@ -97,7 +86,6 @@ class JsonExtractor {
 
 thread_local std::unordered_map<std::string, std::shared_ptr<JsonExtractor>>
     JsonExtractor::kExtractorCache;
-thread_local JsonPathTokenizer JsonExtractor::kTokenizer;
 
 void extractObject(
     const folly::dynamic* jsonObj,
@@ -16,6 +16,8 @@
 
 #include "velox/functions/prestosql/json/JsonPathTokenizer.h"
 
+#include <folly/container/F14Map.h>
+
 namespace facebook::velox::functions {
 
 const char ROOT = '$';
@@ -29,6 +31,38 @@ const char UNDER_SCORE = '_';
 const char OPEN_BRACKET = '[';
 const char CLOSE_BRACKET = ']';
 
+// static
+std::shared_ptr<const std::vector<std::string>> JsonPathTokenizer::getTokens(
+    folly::StringPiece path) {
+  thread_local folly::F14FastMap<
+      std::string,
+      std::shared_ptr<const std::vector<std::string>>>
+      cache;
+  auto it = cache.find(path);
+  if (it != cache.end()) {
+    return it->second;
+  }
+  if (cache.size() >= kMaxCacheSize) {
+    cache.clear();
+  }
+
+  std::shared_ptr<std::vector<std::string>> tokens;
+  JsonPathTokenizer tokenizer;
+  if (tokenizer.reset(path)) {
+    tokens = std::make_shared<std::vector<std::string>>();
+    while (tokenizer.hasNext()) {
+      if (auto token = tokenizer.getNext()) {
+        tokens->push_back(std::move(token.value()));
+      } else {
+        tokens = nullptr;
+        break;
+      }
+    }
+  }
+  cache.emplace(path.str(), tokens);
+  return tokens;
+}
+
 bool JsonPathTokenizer::reset(folly::StringPiece path) {
   if (path.empty() || path[0] != ROOT) {
     return false;
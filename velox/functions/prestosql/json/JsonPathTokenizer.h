@@ -18,6 +18,9 @@
 
 #include <folly/Expected.h>
 #include <folly/Range.h>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace facebook::velox::functions {
 
@@ -25,6 +28,12 @@ using ParseResult = folly::Expected<std::string, bool>;
 
 class JsonPathTokenizer {
  public:
+  /// Returns the tokens of 'path' or nullptr if 'path' is not a valid JSON
+  /// path. Tokenized paths are cached per thread, so that a path used for
+  /// many rows or by many calls is tokenized once.
+  static std::shared_ptr<const std::vector<std::string>> getTokens(
+      folly::StringPiece path);
+
   bool reset(folly::StringPiece path);
 
   bool hasNext() const;
@@ -44,6 +53,9 @@ class JsonPathTokenizer {
   bool isUnquotedBracketKeyFormat(char c);
 
  private:
+  // Max number of paths cached by getTokens().
+  static constexpr size_t kMaxCacheSize{1'024};
+
   size_t index_;
   folly::StringPiece path_;
 };
@@ -42,6 +42,12 @@ namespace facebook::velox::functions::detail {
   return *it.first->second;
 }
 
+/* static */ std::shared_ptr<SIMDJsonExtractor> SIMDJsonExtractor::make(
+    folly::StringPiece path) {
+  return std::shared_ptr<SIMDJsonExtractor>(
+      new SIMDJsonExtractor(folly::trimWhitespace(path).str()));
+}
+
 simdjson::simdjson_result<simdjson::ondemand::document>
 SIMDJsonExtractor::parse(const simdjson::padded_string& json) {
   thread_local static simdjson::ondemand::parser parser;
@@ -49,25 +55,11 @@ SIMDJsonExtractor::parse(const simdjson::padded_string& json) {
 }
 
 bool SIMDJsonExtractor::tokenize(const std::string& path) {
-  thread_local static JsonPathTokenizer tokenizer;
-
-  if (path.empty()) {
+  auto tokens = JsonPathTokenizer::getTokens(path);
+  if (tokens == nullptr) {
     return false;
   }
-
-  if (!tokenizer.reset(path)) {
-    return false;
-  }
-
-  while (tokenizer.hasNext()) {
-    if (auto token = tokenizer.getNext()) {
-      tokens_.push_back(token.value());
-    } else {
-      tokens_.clear();
-      return false;
-    }
-  }
-
+  tokens_ = *tokens;
   return true;
 }
 
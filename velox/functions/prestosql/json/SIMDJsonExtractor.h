@@ -64,6 +64,11 @@ class SIMDJsonExtractor {
   simdjson::simdjson_result<simdjson::ondemand::document> parse(
       const simdjson::padded_string& json);
 
+  /// Returns a new extractor for 'path' that is not shared with other
+  /// callers. For callers that keep the extractor for many rows, e.g. for a
+  /// constant path. Throws if the path is invalid.
+  static std::shared_ptr<SIMDJsonExtractor> make(folly::StringPiece path);
+
  private:
   // Use this method to get an instance of SIMDJsonExtractor given a JSON path.
   // Given the nature of the cache, it's important this is only used by
@@ -173,17 +178,13 @@ bool SIMDJsonExtractor::extract(
  *         If any errors are encountered parsing the JSON, returns false.
  */
 
+/// Same as above for an already parsed 'jsonDoc'. The document must be at its
+/// start, e.g. after parse() or rewind().
 template <typename TConsumer>
 bool simdJsonExtract(
-    const velox::StringView& json,
-    const velox::StringView& path,
+    simdjson::ondemand::document& jsonDoc,
+    detail::SIMDJsonExtractor& extractor,
     TConsumer&& consumer) {
-  // If extractor fails to parse the path, this will throw a VeloxUserError, and
-  // we want to let this exception bubble up to the client.
-  auto& extractor = detail::SIMDJsonExtractor::getInstance(path);
-  simdjson::padded_string paddedJson(json.data(), json.size());
-  SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, extractor.parse(paddedJson));
-
   if (extractor.isRootOnlyPath()) {
     // If the path is just to return the original object, call consumer on the
     // document.  Note, we cannot convert this to a value as this is not
@@ -191,7 +192,21 @@ bool simdJsonExtract(
     return consumer(jsonDoc);
   }
   SIMDJSON_ASSIGN_OR_RAISE(auto value, jsonDoc.get_value());
-  return extractor.extract(value, std::forward<TConsumer>(consumer));
+  return extractor.extract(value, consumer);
+}
+
+template <typename TConsumer>
+bool simdJsonExtract(
+    const velox::StringView& json,
+    const velox::StringView& path,
+    TConsumer&& consumer) {
+  // If extractor fails to parse the path, this will throw a VeloxUserError, and
+  // we want to let this exception bubble up to the client.
+  auto& extractor = detail::SIMDJsonExtractor::getInstance(path);
+  simdjson::padded_string paddedJson(json.data(), json.size());
+  SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, extractor.parse(paddedJson));
+  return simdJsonExtract(
+      jsonDoc, extractor, std::forward<TConsumer>(consumer));
 }
 
 template <typename TConsumer>
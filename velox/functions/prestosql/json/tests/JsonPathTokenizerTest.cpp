@@ -121,3 +121,16 @@ TEST(JsonPathTokenizerTest, tokenizeTest) {
 
   EXPECT_TOKEN_INVALID("$.store.book[");
 }
+
+TEST(JsonPathTokenizerTest, getTokens) {
+  auto tokens = JsonPathTokenizer::getTokens("$.store.fruit[*].weight");
+  ASSERT_NE(tokens, nullptr);
+  EXPECT_EQ(*tokens, (TokenList{"store"s, "fruit"s, "*"s, "weight"s}));
+  // Repeated paths are served from the cache.
+  EXPECT_EQ(JsonPathTokenizer::getTokens("$.store.fruit[*].weight"), tokens);
+
+  EXPECT_EQ(*JsonPathTokenizer::getTokens("$"), TokenList());
+  EXPECT_EQ(JsonPathTokenizer::getTokens(""), nullptr);
+  EXPECT_EQ(JsonPathTokenizer::getTokens("$.store.book["), nullptr);
+  EXPECT_EQ(JsonPathTokenizer::getTokens("$.store.book["), nullptr);
+}
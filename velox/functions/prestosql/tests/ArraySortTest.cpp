@@ -542,6 +542,46 @@ TEST_F(ArraySortTest, lambda) {
       "(x, y) -> if(length(x) < length(y), 1, if(length(x) = length(y), 0, -1))");
 }
 
+TEST_F(ArraySortTest, largeArrays) {
+  // Large enough to be radix sorted.
+  constexpr vector_size_t kSize = 1'000;
+  using Array = std::vector<std::optional<int64_t>>;
+  std::vector<Array> arrays;
+  std::vector<Array> sortedAsc;
+  std::vector<Array> sortedDesc;
+  for (auto row = 0; row < 3; ++row) {
+    Array array;
+    std::vector<int64_t> values;
+    for (auto i = 0; i < kSize; ++i) {
+      if (i % 17 == row) {
+        array.push_back(std::nullopt);
+      } else {
+        values.push_back((i * 7'919 + row * 31) % 2'001 - 1'000);
+        array.push_back(values.back());
+      }
+    }
+    arrays.push_back(array);
+    // Nulls go last.
+    std::sort(values.begin(), values.end());
+    sortedAsc.push_back(Array(values.begin(), values.end()));
+    sortedAsc.back().resize(kSize);
+    sortedDesc.push_back(Array(values.rbegin(), values.rend()));
+    sortedDesc.back().resize(kSize);
+  }
+  auto data = makeRowVector({makeNullableArrayVector<int64_t>(arrays)});
+  auto expectedAsc = makeNullableArrayVector<int64_t>(sortedAsc);
+  auto expectedDesc = makeNullableArrayVector<int64_t>(sortedDesc);
+
+  assertEqualVectors(expectedAsc, evaluate("array_sort(c0)", data));
+  assertEqualVectors(expectedDesc, evaluate("array_sort_desc(c0)", data));
+  // Sort by the keys computed by a lambda.
+  assertEqualVectors(expectedAsc, evaluate("array_sort(c0, x -> x * 2)", data));
+  assertEqualVectors(
+      expectedDesc, evaluate("array_sort_desc(c0, x -> x * 2)", data));
+  assertEqualVectors(
+      expectedDesc, evaluate("array_sort(c0, x -> x * -1)", data));
+}
+
 TEST_F(ArraySortTest, failOnMapTypeSort) {
   static const std::string kErrorMessage =
       "Scalar function signature is not supported"_sv;
@@ -18,6 +18,7 @@
 #include <string>
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/external/date/tz.h"
+#include "velox/functions/lib/TimeUtils.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 #include "velox/functions/prestosql/types/TimestampWithTimeZoneType.h"
 #include "velox/type/tz/TimeZoneMap.h"
@@ -416,6 +417,24 @@ TEST_F(DateTimeFunctionsTest, fromUnixtime) {
   EXPECT_EQ(Timestamp(0, 0), fromUnixtime(kNan));
 }
 
+TEST_F(DateTimeFunctionsTest, civilFromDays) {
+  for (int32_t days = -1'000'000; days <= 1'000'000; days += 13) {
+    SCOPED_TRACE(days);
+    const auto dateTime = functions::getDateTime(days);
+    const auto date = functions::civilFromDays(days);
+    ASSERT_EQ(date.year, dateTime.tm_year + 1900);
+    ASSERT_EQ(date.month, dateTime.tm_mon + 1);
+    ASSERT_EQ(date.day, dateTime.tm_mday);
+    ASSERT_EQ(functions::daysFromCivil(date.year, date.month, date.day), days);
+    ASSERT_EQ(
+        functions::dayOfWeekFromDays(days),
+        dateTime.tm_wday == 0 ? 7 : dateTime.tm_wday);
+  }
+  ASSERT_EQ(functions::getDays(Timestamp(-1, 0), nullptr), -1);
+  ASSERT_EQ(functions::getDays(Timestamp(-86'400, 0), nullptr), -1);
+  ASSERT_EQ(functions::getDays(Timestamp(86'399, 0), nullptr), 0);
+}
+
 TEST_F(DateTimeFunctionsTest, year) {
   const auto year = [&](std::optional<Timestamp> date) {
     return evaluateOnce<int64_t>("year(c0)", date);
@@ -106,6 +106,18 @@ TEST_F(DecimalArithmeticTest, add) {
   testDecimalExpr<TypeKind::BIGINT>(
       expectedConstantFlat, "plus(c0,1.00)", {shortFlat});
 
+  // Add short and short with different scales, returning short.
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>({12'305, -9'999'989'901}, DECIMAL(13, 4)),
+      "c0 + c1",
+      {makeFlatVector<int64_t>({123, -99'999'999}, DECIMAL(10, 2)),
+       makeFlatVector<int64_t>({5, 9'999}, DECIMAL(10, 4))});
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>({12'295, -9'999'989'901}, DECIMAL(13, 4)),
+      "c0 - c1",
+      {makeFlatVector<int64_t>({123, -99'999'999}, DECIMAL(10, 2)),
+       makeFlatVector<int64_t>({5, -9'999}, DECIMAL(10, 4))});
+
   testDecimalExpr<TypeKind::BIGINT>(
       makeNullableFlatVector<int64_t>(
           {2, 4, std::nullopt, std::nullopt, std::nullopt}, DECIMAL(11, 3)),
@@ -293,6 +305,16 @@ TEST_F(DecimalArithmeticTest, multiply) {
       "Decimal overflow. Value '119630519620642428561342635425231011830' is not in the range of Decimal Type");
 }
 
+TEST_F(DecimalArithmeticTest, multiplyShort) {
+  // The largest short decimal product.
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>(
+          {8'369'910, 999'999'998'000'000'001}, DECIMAL(18, 3)),
+      "c0 * c1",
+      {makeFlatVector<int64_t>({12'345, 999'999'999}, DECIMAL(9, 2)),
+       makeFlatVector<int64_t>({678, 999'999'999}, DECIMAL(9, 1))});
+}
+
 TEST_F(DecimalArithmeticTest, decimalDivTest) {
   auto shortFlat = makeFlatVector<int64_t>({1000, 2000}, DECIMAL(17, 3));
   // Divide short and short, returning long.
@@ -666,6 +666,40 @@ TEST_F(ElementAtTest, variableInputMap) {
   testVariableInputMap<StringView>(); // VARCHAR
 }
 
+TEST_F(ElementAtTest, repeatedKeysOfLargeMaps) {
+  // Large enough maps to build a key index for the repeated subscripts. Each
+  // map ends with a duplicate of key 30, which must not be found.
+  constexpr vector_size_t kNumRows = 10;
+  constexpr vector_size_t kMapSize = 101;
+  auto offset = [](auto row) { return row * kMapSize; };
+  std::vector<vector_size_t> offsets;
+  for (auto row = 0; row < kNumRows; ++row) {
+    offsets.push_back(offset(row));
+  }
+  auto keys = makeFlatVector<int64_t>(kNumRows * kMapSize, [](auto i) {
+    return i % kMapSize == kMapSize - 1 ? 30 : i % kMapSize * 3;
+  });
+  auto values = makeFlatVector<int64_t>(kNumRows * kMapSize, [](auto i) {
+    return i % kMapSize == kMapSize - 1 ? -1 : i;
+  });
+  auto data = makeRowVector({makeMapVector(offsets, keys, values)});
+
+  auto result = evaluate(
+      "array_constructor(element_at(c0, 3), element_at(c0, 30), "
+      "element_at(c0, 31), c0[297], c0[0])",
+      data);
+  std::vector<std::vector<std::optional<int64_t>>> expected;
+  for (auto row = 0; row < kNumRows; ++row) {
+    expected.push_back(
+        {offset(row) + 1,
+         offset(row) + 10,
+         std::nullopt,
+         offset(row) + 99,
+         offset(row)});
+  }
+  test::assertEqualVectors(makeNullableArrayVector(expected), result);
+}
+
 TEST_F(ElementAtTest, timestampAsKey) {
   const auto keyVector = makeFlatVector<Timestamp>(
       {Timestamp(1991, 0),
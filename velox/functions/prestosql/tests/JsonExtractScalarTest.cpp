@@ -183,6 +183,40 @@ TEST_F(JsonExtractScalarTest, overflow) {
       "184467440737095516151844674407370955161518446744073709551615");
 }
 
+TEST_F(JsonExtractScalarTest, multiplePaths) {
+  auto data = makeRowVector({makeNullableFlatVector<StringView>(
+      {R"({"a": 1, "b": {"c": "x", "d": [true, 2.5]}})",
+       R"({"b": {"c": "a string that is too long to be inlined"}, "a": null})",
+       R"([1, 2])",
+       std::nullopt,
+       R"({"a": 10, "b": {"c": tru}})",
+       R"(not json)",
+       R"({"a": [1], "b": {"c": 1, "c": 2, "d": [false]}})"},
+      JSON())});
+
+  std::vector<std::string> exprs;
+  for (const auto& path :
+       {"$.a", " $.b.c", "$.b.d[1]", "$[0]", "$", "$.b.d[*]", "$.a"}) {
+    exprs.push_back(fmt::format("json_extract_scalar(c0, '{}')", path));
+  }
+
+  // The calls are evaluated with one parse per row and give the same results
+  // as separate calls.
+  auto exprSet = compileExpressions(exprs, asRowType(data->type()));
+  ASSERT_NE(
+      exprSet->toString().find("$internal$json_extract_scalar_multi"),
+      std::string::npos);
+
+  exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+  SelectivityVector rows(data->size());
+  std::vector<VectorPtr> results(exprs.size());
+  exprSet->eval(rows, context, results);
+  for (auto i = 0; i < exprs.size(); ++i) {
+    SCOPED_TRACE(exprs[i]);
+    velox::test::assertEqualVectors(evaluate(exprs[i], data), results[i]);
+  }
+}
+
 // TODO: When there is a wildcard in the json path, Presto's behavior is to
 // always extract an array of selected items, and hence json_extract_scalar()
 // always return NULL in this situation. But some internal customers are
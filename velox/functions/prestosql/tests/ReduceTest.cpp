@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 
 using namespace facebook::velox;
@@ -242,3 +243,50 @@ TEST_F(ReduceTest, nullArray) {
   assertEqualVectors(
       makeNullableFlatVector<int64_t>({std::nullopt, std::nullopt}), result);
 }
+
+// (s, x) -> s + x is computed over all elements of an array in one loop. The
+// results, including nulls and overflow errors, must be the same as when
+// evaluating the lambda one element at a time. (s, x) -> s + x * 1 is not a
+// plain sum and is evaluated per element.
+TEST_F(ReduceTest, sumStep) {
+  auto data = makeRowVector({
+      makeArrayVectorFromJson<int64_t>(
+          {"[1, 2, 3]",
+           "[]",
+           "null",
+           "[4, null, 5]",
+           "[9223372036854775807, 1]",
+           "[-1, 9223372036854775807, 1]"}),
+      makeNullableFlatVector<int64_t>({10, 20, 30, 40, 50, std::nullopt}),
+      makeArrayVectorFromJson<double>(
+          {"[0.1, 0.2, 0.3]",
+           "[]",
+           "null",
+           "[1e20, 1, -1e20]",
+           "[1.5]",
+           "[2.5]"}),
+  });
+
+  auto testSum = [&](const std::string& sum, const std::string& reference) {
+    auto result = evaluate(sum, data);
+    auto expected = evaluate(reference, data);
+    assertEqualVectors(expected, result);
+  };
+
+  testSum(
+      "try(reduce(c0, c1, (s, x) -> s + x, s -> s))",
+      "try(reduce(c0, c1, (s, x) -> s + x * 1, s -> s))");
+  testSum(
+      "try(reduce(c0, c1, (s, x) -> x + s, s -> s))",
+      "try(reduce(c0, c1, (s, x) -> x * 1 + s, s -> s))");
+  testSum(
+      "reduce(c2, 0.0, (s, x) -> s + x, s -> s)",
+      "reduce(c2, 0.0, (s, x) -> s + x * 1.0, s -> s)");
+  testSum(
+      "reduce(c2, 0.0, (s, x) -> x + s, s -> s)",
+      "reduce(c2, 0.0, (s, x) -> x * 1.0 + s, s -> s)");
+
+  VELOX_ASSERT_THROW(
+      evaluate("reduce(c0, c1, (s, x) -> s + x, s -> s)", data),
+      "integer overflow: 50 + 9223372036854775807");
+}
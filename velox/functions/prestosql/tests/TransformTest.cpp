@@ -75,6 +75,22 @@ TEST_F(TransformTest, differentResultType) {
   assertEqualVectors(expectedResult, result);
 }
 
+TEST_F(TransformTest, constantCapture) {
+  vector_size_t size = 1'000;
+  auto input = makeRowVector(
+      {makeArrayVector<int64_t>(size, modN(5), modN(7), nullEvery(11)),
+       makeConstant<int64_t>(10, size)});
+
+  auto result = evaluate<ArrayVector>("transform(c0, x -> x + c1)", input);
+
+  auto expectedResult = makeArrayVector<int64_t>(
+      size,
+      modN(5),
+      [](vector_size_t row) { return row % 7 + 10; },
+      nullEvery(11));
+  assertEqualVectors(expectedResult, result);
+}
+
 // Test different lambdas applied to different rows
 TEST_F(TransformTest, conditional) {
   vector_size_t size = 1'000;
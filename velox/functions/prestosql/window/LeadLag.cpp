@@ -65,6 +65,13 @@ class LeadLagFunction : public exec::WindowFunction {
       const VectorPtr& result) override {
     const auto numRows = frameStarts->size() / sizeof(vector_size_t);
 
+    if (constantOffset_.has_value() && !ignoreNullsForPartition_ &&
+        !defaultValueIndex_) {
+      applyConstantOffset(numRows, resultOffset, result);
+      partitionOffset_ += numRows;
+      return;
+    }
+
     rowNumbers_.resize(numRows);
 
     if (constantOffset_.has_value() || isConstantOffsetNull_) {
@@ -127,6 +134,72 @@ class LeadLagFunction : public exec::WindowFunction {
     }
   }
 
+  // Fast path for a constant offset when nulls are not ignored. The rows of
+  // the block with a value then read consecutive rows of the partition, so
+  // that these are copied with a single extraction of a range, and the other
+  // rows are set to the default value or null without going through
+  // 'rowNumbers_'.
+  void applyConstantOffset(
+      vector_size_t numRows,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    const int64_t offset = constantOffset_.value();
+    const int64_t numPartitionRows = partition_->numRows();
+    // The rows [firstValid, firstValid + numValid) of the block read the
+    // partition rows starting at 'sourceStart'.
+    int64_t firstValid;
+    int64_t numValid;
+    int64_t sourceStart;
+    if constexpr (isLag) {
+      firstValid = std::clamp<int64_t>(offset - partitionOffset_, 0, numRows);
+      numValid = numRows - firstValid;
+      sourceStart = partitionOffset_ + firstValid - offset;
+    } else {
+      firstValid = 0;
+      numValid = std::clamp<int64_t>(
+          numPartitionRows - partitionOffset_ - offset, 0, numRows);
+      sourceStart = partitionOffset_ + offset;
+    }
+
+    if (numValid > 0) {
+      partition_->extractColumn(
+          valueIndex_,
+          sourceStart,
+          numValid,
+          resultOffset + firstValid,
+          result);
+    }
+
+    if constexpr (isLag) {
+      setDefaultValueOrNull(resultOffset, firstValid, result);
+    } else {
+      setDefaultValueOrNull(
+          resultOffset + numValid, numRows - numValid, result);
+    }
+  }
+
+  // Sets 'numRows' rows of 'result' starting at 'resultOffset' to the
+  // constant default value or to null if there is no default value.
+  void setDefaultValueOrNull(
+      vector_size_t resultOffset,
+      vector_size_t numRows,
+      const VectorPtr& result) {
+    if (numRows == 0) {
+      return;
+    }
+    if (constantDefaultValue_) {
+      result->copy(
+          BaseVector::wrapInConstant(numRows, 0, constantDefaultValue_).get(),
+          resultOffset,
+          0,
+          numRows);
+    } else {
+      for (auto i = 0; i < numRows; ++i) {
+        result->setNull(resultOffset + i, true);
+      }
+    }
+  }
+
   void setRowNumbersForConstantOffset(vector_size_t offset);
 
   void setRowNumbersForConstantOffset() {
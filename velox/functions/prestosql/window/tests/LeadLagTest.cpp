@@ -291,6 +291,40 @@ TEST_P(LeadLagTest, largePartitions) {
   }
 }
 
+// Constant offsets copy ranges of the partition. Make sure nulls and strings
+// in the values are copied and that the rows without a value get the default
+// value across output batches.
+TEST_P(LeadLagTest, constantOffsetRanges) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(5'000, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          5'000,
+          [](auto row) {
+            return std::string(row % 20, 'a') + std::to_string(row);
+          },
+          nullEvery(3)),
+      makeFlatVector<int64_t>(5'000, [](auto row) { return row / 1'000; }),
+  });
+
+  createDuckDbTable({data});
+
+  auto assertResults = [&](const std::string& functionSql) {
+    auto queryInfo = buildWindowQuery(
+        {data}, functionSql, "partition by c2 order by c0", "");
+    SCOPED_TRACE(queryInfo.functionSql);
+    AssertQueryBuilder(queryInfo.planNode, duckDbQueryRunner_)
+        .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+        .assertResults(queryInfo.querySql);
+  };
+
+  assertResults(fn("c1"));
+  assertResults(fn("c1, 0"));
+  assertResults(fn("c1, 7"));
+  assertResults(fn("c1, 7, 'none'"));
+  assertResults(fn("c1, 999, 'none'"));
+  assertResults(fn("c1, 1000, 'none'"));
+}
+
 TEST_P(LeadLagTest, invalidOffset) {
   auto data = makeRowVector({
       // Values.
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/functions/lib/window/tests/WindowTestBase.h"
 #include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
 
@@ -128,6 +129,97 @@ TEST_F(StringAggregatesTest, nonFixedWidthAggregate) {
   testWindowFunction(input, "max(c2)", kOverClauses);
 }
 
+class SlidingFrameAggregatesTest : public WindowTestBase {};
+
+// Test for sliding frames over a partition spanning several output blocks, so
+// that the frames retract rows aggregated in a previous block.
+TEST_F(SlidingFrameAggregatesTest, largePartition) {
+  auto size = 3'000;
+  auto input = {makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 2; }),
+      makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          size,
+          [](auto row) { return (row * 7919) % 1'001 - 500; },
+          nullEvery(5)),
+      makeFlatVector<int64_t>(size, [](auto row) { return row % 17; }),
+      makeFlatVector<int16_t>(
+          size, [](auto row) { return row % 13; }, nullEvery(3)),
+  })};
+
+  const std::vector<std::string> frameClauses = {
+      "rows between 100 preceding and current row",
+      "rows between 1000 preceding and 10 preceding",
+      "rows between 10 following and 1000 following",
+      "rows between c3 preceding and c3 following",
+  };
+  for (const auto& function :
+       {"sum(c2)", "count(c2)", "avg(c2)", "min(c2)", "max(c2)", "max(c4)"}) {
+    testWindowFunction(
+        input, function, {"partition by c0 order by c1"}, frameClauses);
+  }
+}
+
+// Test that sums over a sliding frame still check for overflow.
+TEST_F(SlidingFrameAggregatesTest, sumOverflow) {
+  const auto kMax = std::numeric_limits<int64_t>::max();
+  auto input = makeRowVector({
+      makeFlatVector<int32_t>({1, 2, 3, 4}),
+      makeFlatVector<int64_t>({kMax, -1, kMax, 0}),
+  });
+
+  auto expected = makeRowVector({
+      input->childAt(0),
+      input->childAt(1),
+      makeFlatVector<int64_t>({kMax, kMax - 1, kMax - 1, kMax}),
+  });
+  testWindowFunction(
+      {input},
+      "sum(c1)",
+      "order by c0",
+      "rows between 1 preceding and current row",
+      expected);
+
+  input = makeRowVector({
+      makeFlatVector<int32_t>({1, 2}),
+      makeFlatVector<int64_t>({kMax, 1}),
+  });
+  assertWindowFunctionError(
+      {input},
+      "sum(c1)",
+      "order by c0",
+      "rows between 1 preceding and current row",
+      "integer overflow");
+}
+
+class SortedInputWindowTest : public WindowTestBase {};
+
+// Test for a window over input that is already sorted by an OrderBy. The
+// Window streams the input partition by partition if the order matches its
+// partition and sorting keys, and sorts it again if it does not.
+TEST_F(SortedInputWindowTest, orderByInput) {
+  auto input = {makeRandomInputVector(50), makeRandomInputVector(60)};
+  createDuckDbTable(input);
+
+  const std::string function =
+      "sum(c2) over (partition by c0 order by c1 desc nulls first, c2, c3)";
+  for (const auto& keys : std::vector<std::vector<std::string>>{
+           {"c0", "c1 desc nulls first", "c2", "c3"},
+           {"c0 desc nulls last", "c1 desc nulls first", "c2", "c3", "c1"},
+           {"c1 desc nulls first", "c0", "c2", "c3"},
+           {"c0", "c1 asc nulls first", "c2", "c3"},
+           {"c0", "c1 desc nulls first"}}) {
+    SCOPED_TRACE(folly::join(", ", keys));
+    auto plan = PlanBuilder()
+                    .values(input)
+                    .orderBy(keys, false)
+                    .window({function})
+                    .planNode();
+    assertQuery(
+        plan, fmt::format("SELECT c0, c1, c2, c3, {} FROM tmp", function));
+  }
+}
+
 class AggregateEmptyFramesTest : public WindowTestBase {};
 
 // Test for aggregates that return NULL as the default value for empty frames
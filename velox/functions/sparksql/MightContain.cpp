@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/sparksql/MightContain.h"
+
+#include <folly/hash/Hash.h>
+
+#include "velox/common/base/BloomFilter.h"
+#include "velox/expression/DecodedArgs.h"
+
+namespace facebook::velox::functions::sparksql {
+namespace {
+
+class BloomFilterMightContainFunction : public exec::VectorFunction {
+ public:
+  explicit BloomFilterMightContainFunction(const VectorPtr& serialized) {
+    if (serialized != nullptr && !serialized->isNullAt(0)) {
+      bloomFilter_.merge(serialized->as<ConstantVector<StringView>>()
+                             ->valueAt(0)
+                             .str()
+                             .c_str());
+    }
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    context.ensureWritable(rows, outputType, result);
+    auto* flatResult = result->asFlatVector<bool>();
+    auto* rawResults = flatResult->mutableRawValues<uint64_t>();
+    if (!bloomFilter_.isSet()) {
+      rows.applyToSelected(
+          [&](auto row) { bits::clearBit(rawResults, row); });
+      return;
+    }
+    const auto& values = args[1];
+    if (values->isFlatEncoding()) {
+      probeFlat(rows, values->asFlatVector<int64_t>()->rawValues(), rawResults);
+      return;
+    }
+    exec::DecodedArgs decodedArgs(rows, {values}, context);
+    auto* decoded = decodedArgs.at(0);
+    rows.applyToSelected([&](auto row) {
+      bits::setBit(
+          rawResults,
+          row,
+          bloomFilter_.mayContain(
+              folly::hasher<int64_t>()(decoded->valueAt<int64_t>(row))));
+    });
+  }
+
+ private:
+  // Hashes a batch of values at a time and probes the filter for all lanes
+  // with one gather. Unselected rows inside a batch are probed too but their
+  // results are not written.
+  void probeFlat(
+      const SelectivityVector& rows,
+      const int64_t* rawValues,
+      uint64_t* rawResults) const {
+    constexpr auto kBatchSize = xsimd::batch<int64_t>::size;
+    alignas(xsimd::default_arch::alignment()) int64_t hashes[kBatchSize];
+    const bool allSelected = rows.isAllSelected();
+    auto row = rows.begin();
+    for (; row + kBatchSize <= rows.end(); row += kBatchSize) {
+      for (auto i = 0; i < kBatchSize; ++i) {
+        hashes[i] = folly::hasher<int64_t>()(rawValues[row + i]);
+      }
+      const uint64_t mask = simd::toBitMask(bloomFilter_.mayContain(
+          xsimd::batch<int64_t>::load_aligned(hashes)));
+      for (auto i = 0; i < kBatchSize; ++i) {
+        if (allSelected || rows.isValid(row + i)) {
+          bits::setBit(rawResults, row + i, (mask >> i) & 1);
+        }
+      }
+    }
+    for (; row < rows.end(); ++row) {
+      if (!rows.isValid(row)) {
+        continue;
+      }
+      bits::setBit(
+          rawResults,
+          row,
+          bloomFilter_.mayContain(folly::hasher<int64_t>()(rawValues[row])));
+    }
+  }
+
+  BloomFilter<> bloomFilter_;
+};
+
+} // namespace
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> mightContainSignatures() {
+  return {exec::FunctionSignatureBuilder()
+              .returnType("boolean")
+              .argumentType("varbinary")
+              .argumentType("bigint")
+              .build()};
+}
+
+std::shared_ptr<exec::VectorFunction> makeMightContain(
+    const std::string& /*name*/,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  VELOX_CHECK_EQ(inputArgs.size(), 2);
+  return std::make_shared<BloomFilterMightContainFunction>(
+      inputArgs[0].constantValue);
+}
+
+} // namespace facebook::velox::functions::sparksql
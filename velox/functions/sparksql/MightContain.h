@@ -13,36 +13,20 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include "velox/common/base/BloomFilter.h"
-#include "velox/core/QueryConfig.h"
-#include "velox/functions/Macros.h"
+#pragma once
 
-namespace facebook::velox::functions::sparksql {
-
-template <typename T>
-struct BloomFilterMightContainFunction {
-  VELOX_DEFINE_FUNCTION_TYPES(T);
+#include "velox/expression/VectorFunction.h"
 
-  using Allocator = std::allocator<uint64_t>;
-
-  void initialize(
-      const core::QueryConfig&,
-      const arg_type<Varbinary>* serialized,
-      const arg_type<int64_t>*) {
-    if (serialized != nullptr) {
-      bloomFilter_.merge(serialized->str().c_str());
-    }
-  }
+namespace facebook::velox::functions::sparksql {
 
-  FOLLY_ALWAYS_INLINE void
-  call(bool& result, const arg_type<Varbinary>&, const int64_t& input) {
-    result = bloomFilter_.isSet()
-        ? bloomFilter_.mayContain(folly::hasher<int64_t>()(input))
-        : false;
-  }
+std::vector<std::shared_ptr<exec::FunctionSignature>> mightContainSignatures();
 
- private:
-  BloomFilter<Allocator> bloomFilter_;
-};
+/// might_contain(serialized bloom filter, bigint) -> boolean. The filter
+/// argument is expected to be constant. The values of flat input are probed
+/// a SIMD batch at a time.
+std::shared_ptr<exec::VectorFunction> makeMightContain(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
 
 } // namespace facebook::velox::functions::sparksql
@@ -84,6 +84,28 @@ TEST_F(MightContainTest, basic) {
   testMightContain(serialized, values, expected);
 }
 
+TEST_F(MightContainTest, batch) {
+  constexpr int32_t kSize = 1'000;
+  auto serialized = getSerializedBloomFilter(kSize);
+  BloomFilter bloomFilter;
+  bloomFilter.merge(serialized.data());
+  // Half of the values are in the filter. The size is not a multiple of the
+  // SIMD width.
+  auto value = makeFlatVector<int64_t>(
+      2 * kSize + 3, [](vector_size_t row) { return row * 2; });
+  auto expected = makeFlatVector<bool>(value->size(), [&](vector_size_t row) {
+    return bloomFilter.mayContain(folly::hasher<int64_t>()(row * 2));
+  });
+  testMightContain(serialized, value, expected);
+
+  // Same on dictionary encoded input.
+  auto indices = makeIndicesInReverse(value->size());
+  testMightContain(
+      serialized,
+      wrapInDictionary(indices, value),
+      wrapInDictionary(indices, expected));
+}
+
 TEST_F(MightContainTest, nullBloomFilter) {
   auto value = makeFlatVector<int64_t>({2, 4});
   auto expected = makeNullConstant(TypeKind::BOOLEAN, value->size());
@@ -437,6 +437,20 @@ TEST_F(FunctionRegistryTest, hasVectorFunctionSignatureWrongFunctionName) {
   testResolveVectorFunction("vector_method_one", {VARCHAR()}, nullptr);
 }
 
+// Resolutions of vector functions are memoized per registration.
+TEST_F(FunctionRegistryTest, reregisterVectorFunction) {
+  const std::string name = "vector_func_reregistered";
+  exec::registerVectorFunction(
+      name, VectorFuncOne::signatures(), std::make_unique<VectorFuncOne>());
+  testResolveVectorFunction(name, {VARCHAR()}, BIGINT());
+  testResolveVectorFunction(name, {ARRAY(VARCHAR())}, nullptr);
+
+  exec::registerVectorFunction(
+      name, VectorFuncTwo::signatures(), std::make_unique<VectorFuncTwo>());
+  testResolveVectorFunction(name, {VARCHAR()}, nullptr);
+  testResolveVectorFunction(name, {ARRAY(VARCHAR())}, ARRAY(BIGINT()));
+}
+
 TEST_F(FunctionRegistryTest, registerFunctionTwice) {
   // For better or worse, there are code paths that depend on the ability to
   // register the same functions repeatedly and have those repeated calls
@@ -55,6 +55,11 @@ void CompactRow::initialize(const TypePtr& type) {
       }
 
       rowNullBytes_ = bits::nbytes(type->size());
+      int32_t fieldOffset = rowNullBytes_;
+      for (auto i = 0; i < children_.size() && childIsFixedWidth_[i]; ++i) {
+        fixedFieldOffsets_.push_back(fieldOffset);
+        fieldOffset += children_[i].valueBytes_;
+      }
       break;
     }
     case TypeKind::BOOLEAN:
@@ -149,13 +154,17 @@ int32_t CompactRow::rowRowSize(vector_size_t index) {
 }
 
 int32_t CompactRow::serializeRow(vector_size_t index, char* buffer) {
-  auto childIndex = decoded_.index(index);
-
-  int64_t valuesOffset = rowNullBytes_;
+  return serializeFields(decoded_.index(index), 0, rowNullBytes_, buffer);
+}
 
+int32_t CompactRow::serializeFields(
+    vector_size_t childIndex,
+    size_t firstField,
+    int32_t valuesOffset,
+    char* buffer) {
   auto* nulls = reinterpret_cast<uint8_t*>(buffer);
 
-  for (auto i = 0; i < children_.size(); ++i) {
+  for (auto i = firstField; i < children_.size(); ++i) {
     auto& child = children_[i];
 
     // Write null bit. Advance offset if 'fixed-width'.
@@ -420,6 +429,82 @@ int32_t CompactRow::serialize(vector_size_t index, char* buffer) {
   return serializeRow(index, buffer);
 }
 
+void CompactRow::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  childIndices_.resize(size);
+  for (auto i = 0; i < size; ++i) {
+    childIndices_[i] = decoded_.index(offset + i);
+  }
+
+  const auto numFixedFields = fixedFieldOffsets_.size();
+  for (auto field = 0; field < numFixedFields; ++field) {
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH_ALL(
+        serializeFixedWidthField,
+        children_[field].typeKind_,
+        field,
+        childIndices_.data(),
+        size,
+        bufferOffsets,
+        buffer);
+  }
+
+  if (numFixedFields == children_.size()) {
+    return;
+  }
+
+  const int32_t valuesOffset = numFixedFields == 0
+      ? rowNullBytes_
+      : fixedFieldOffsets_.back() + children_[numFixedFields - 1].valueBytes_;
+  for (auto i = 0; i < size; ++i) {
+    serializeFields(
+        childIndices_[i],
+        numFixedFields,
+        valuesOffset,
+        buffer + bufferOffsets[i]);
+  }
+}
+
+template <TypeKind kind>
+void CompactRow::serializeFixedWidthField(
+    size_t field,
+    const vector_size_t* childIndices,
+    vector_size_t size,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  using T = typename TypeTraits<kind>::NativeType;
+  auto& child = children_[field];
+  const auto fieldOffset = fixedFieldOffsets_[field];
+  const bool mayHaveNulls = child.decoded_.mayHaveNulls();
+
+  for (auto i = 0; i < size; ++i) {
+    auto* row = buffer + bufferOffsets[i];
+    const auto childIndex = childIndices[i];
+    if (mayHaveNulls && child.isNullAt(childIndex)) {
+      bits::setBit(reinterpret_cast<uint8_t*>(row), field, true);
+      continue;
+    }
+
+    if constexpr (kind == TypeKind::UNKNOWN) {
+      // Not reachable since UNKNOWN values are always null.
+    } else if constexpr (kind == TypeKind::BOOLEAN) {
+      *reinterpret_cast<bool*>(row + fieldOffset) =
+          child.decoded_.valueAt<bool>(childIndex);
+    } else if constexpr (kind == TypeKind::TIMESTAMP) {
+      auto micros = child.decoded_.valueAt<Timestamp>(childIndex).toMicros();
+      memcpy(row + fieldOffset, &micros, sizeof(int64_t));
+    } else if constexpr (TypeTraits<kind>::isFixedWidth) {
+      auto value = child.decoded_.valueAt<T>(childIndex);
+      memcpy(row + fieldOffset, &value, sizeof(T));
+    } else {
+      VELOX_UNREACHABLE(
+          "Unexpected type kind: {}", mapTypeKindToName(child.typeKind_));
+    }
+  }
+}
+
 void CompactRow::serializeFixedWidth(vector_size_t index, char* buffer) {
   VELOX_DCHECK(fixedWidthTypeKind_);
   switch (typeKind_) {
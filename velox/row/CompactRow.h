@@ -36,6 +36,17 @@ class CompactRow {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Serializes 'size' rows starting at 'offset'. Row 'offset + i' is written
+  /// at 'buffer + bufferOffsets[i]', which must have room for its serialized
+  /// size and be set to all zeros. Leading fixed-width fields sit at the same
+  /// offset in every row and are written one column at a time. The remaining
+  /// fields are written row by row.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      const size_t* bufferOffsets,
+      char* buffer);
+
   /// Deserializes multiple rows into a RowVector of specified type. The type
   /// must match the contents of the serialized rows.
   static RowVectorPtr deserialize(
@@ -108,6 +119,26 @@ class CompactRow {
   /// Serializes struct value to buffer. Value must not be null.
   int32_t serializeRow(vector_size_t index, char* buffer);
 
+  /// Writes fields starting at 'firstField' of the struct value at
+  /// 'childIndex' in the children. 'valuesOffset' is the offset in 'buffer' of
+  /// the first of these fields. Returns offset of the end of the struct value.
+  int32_t serializeFields(
+      vector_size_t childIndex,
+      size_t firstField,
+      int32_t valuesOffset,
+      char* buffer);
+
+  /// Writes values and null flags of fixed-width child 'field' for the struct
+  /// values at 'childIndices'. The row for 'childIndices[i]' starts at 'buffer
+  /// + bufferOffsets[i]'.
+  template <TypeKind kind>
+  void serializeFixedWidthField(
+      size_t field,
+      const vector_size_t* childIndices,
+      vector_size_t size,
+      const size_t* bufferOffsets,
+      char* buffer);
+
   const TypeKind typeKind_;
   DecodedVector decoded_;
 
@@ -125,6 +156,14 @@ class CompactRow {
   // ROW type only. Number of bytes used by null flags.
   size_t rowNullBytes_;
 
+  // ROW type only. Offsets of the leading fixed-width fields. These are the
+  // same in every row since no variable-width field precedes them.
+  std::vector<int32_t> fixedFieldOffsets_;
+
+  // ROW type only. Scratch space for indices into the children of the rows
+  // serialized by a batch serialize() call.
+  std::vector<vector_size_t> childIndices_;
+
   // Fixed-width types only. Number of bytes used for a single value.
   size_t valueBytes_;
 };
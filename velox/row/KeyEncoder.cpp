@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/row/KeyEncoder.h"
+
+namespace facebook::velox::row {
+namespace {
+
+// Null byte values. A value sorts between nulls first and nulls last.
+constexpr char kNullFirst = 0;
+constexpr char kNotNull = 1;
+constexpr char kNullLast = 2;
+
+// Escape and terminator bytes of variable width values.
+constexpr char kZero = 0;
+constexpr char kEscapedZero = static_cast<char>(0xff);
+
+template <typename T, bool kDescending>
+void encodeFlat(
+    const T* values,
+    vector_size_t numRows,
+    int32_t stride,
+    char* out) {
+  for (vector_size_t row = 0; row < numRows; ++row, out += stride) {
+    *out = kNotNull;
+    KeyEncoder::encodeValue(values[row], kDescending, out + 1);
+  }
+}
+
+template <TypeKind kind>
+void encodeFixedWidthColumn(
+    const DecodedVector& decoded,
+    const CompareFlags& flags,
+    vector_size_t numRows,
+    int32_t stride,
+    char* out) {
+  using T = typename TypeTraits<kind>::NativeType;
+  if constexpr (kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY) {
+    VELOX_UNREACHABLE();
+  } else {
+    const bool descending = !flags.ascending;
+    // Flat booleans are bits.
+    if (kind != TypeKind::BOOLEAN && decoded.isIdentityMapping() &&
+        !decoded.mayHaveNulls()) {
+      if (descending) {
+        encodeFlat<T, true>(decoded.data<T>(), numRows, stride, out);
+      } else {
+        encodeFlat<T, false>(decoded.data<T>(), numRows, stride, out);
+      }
+      return;
+    }
+    for (vector_size_t row = 0; row < numRows; ++row, out += stride) {
+      if (decoded.isNullAt(row)) {
+        // The value bytes stay as they are, zero if the caller cleared them.
+        *out = flags.nullsFirst ? kNullFirst : kNullLast;
+        continue;
+      }
+      *out = kNotNull;
+      KeyEncoder::encodeValue(decoded.valueAt<T>(row), descending, out + 1);
+    }
+  }
+}
+
+template <TypeKind kind>
+void appendFixedWidth(
+    const DecodedVector& decoded,
+    const CompareFlags& flags,
+    std::vector<std::string>& keys) {
+  using T = typename TypeTraits<kind>::NativeType;
+  if constexpr (kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY) {
+    VELOX_UNREACHABLE();
+  } else {
+    char value[sizeof(T)];
+    for (vector_size_t row = 0; row < keys.size(); ++row) {
+      auto& key = keys[row];
+      if (decoded.isNullAt(row)) {
+        key.push_back(flags.nullsFirst ? kNullFirst : kNullLast);
+        key.append(sizeof(T), kZero);
+        continue;
+      }
+      key.push_back(kNotNull);
+      KeyEncoder::encodeValue(
+          decoded.valueAt<T>(row), !flags.ascending, value);
+      key.append(value, sizeof(value));
+    }
+  }
+}
+
+void appendVariableWidth(
+    const DecodedVector& decoded,
+    const CompareFlags& flags,
+    std::vector<std::string>& keys) {
+  const char mask = flags.ascending ? 0 : static_cast<char>(0xff);
+  for (vector_size_t row = 0; row < keys.size(); ++row) {
+    auto& key = keys[row];
+    if (decoded.isNullAt(row)) {
+      key.push_back(flags.nullsFirst ? kNullFirst : kNullLast);
+      continue;
+    }
+    key.push_back(kNotNull);
+    const auto value = decoded.valueAt<StringView>(row);
+    const auto begin = key.size();
+    for (auto i = 0; i < value.size(); ++i) {
+      key.push_back(value.data()[i]);
+      if (value.data()[i] == kZero) {
+        key.push_back(kEscapedZero);
+      }
+    }
+    key.push_back(kZero);
+    key.push_back(kZero);
+    if (mask != 0) {
+      for (auto i = begin; i < key.size(); ++i) {
+        key[i] ^= mask;
+      }
+    }
+  }
+}
+} // namespace
+
+// static
+int32_t KeyEncoder::fixedSize(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+      return 1;
+    case TypeKind::SMALLINT:
+      return 2;
+    case TypeKind::INTEGER:
+    case TypeKind::REAL:
+      return 4;
+    case TypeKind::BIGINT:
+    case TypeKind::DOUBLE:
+      return 8;
+    case TypeKind::HUGEINT:
+    case TypeKind::TIMESTAMP:
+      return 16;
+    default:
+      return 0;
+  }
+}
+
+// static
+bool KeyEncoder::isSupported(const TypePtr& type) {
+  return fixedSize(type) > 0 || type->kind() == TypeKind::VARCHAR ||
+      type->kind() == TypeKind::VARBINARY;
+}
+
+// static
+void KeyEncoder::encodeFixedWidth(
+    const DecodedVector& decoded,
+    const TypePtr& type,
+    const CompareFlags& flags,
+    vector_size_t numRows,
+    int32_t stride,
+    char* out) {
+  VELOX_CHECK_GT(fixedSize(type), 0, "Not a fixed width key: {}", *type);
+  VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+      encodeFixedWidthColumn,
+      type->kind(),
+      decoded,
+      flags,
+      numRows,
+      stride,
+      out);
+}
+
+// static
+void KeyEncoder::encode(
+    const RowVector& input,
+    const std::vector<CompareFlags>& flags,
+    std::vector<std::string>& keys) {
+  VELOX_CHECK_LE(flags.size(), input.childrenSize());
+  keys.resize(input.size());
+  SelectivityVector rows(input.size());
+  DecodedVector decoded;
+  for (auto i = 0; i < flags.size(); ++i) {
+    const auto& child = input.childAt(i);
+    decoded.decode(*child, rows);
+    if (fixedSize(child->type()) == 0) {
+      VELOX_CHECK(
+          isSupported(child->type()),
+          "Unsupported key type: {}",
+          *child->type());
+      appendVariableWidth(decoded, flags[i], keys);
+      continue;
+    }
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        appendFixedWidth, child->type()->kind(), decoded, flags[i], keys);
+  }
+}
+
+} // namespace facebook::velox::row
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/lang/Bits.h>
+
+#include "velox/type/HugeInt.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::row {
+
+/// Encodes sort keys into bytes that compare with memcmp like the keys
+/// compare with their CompareFlags, i.e. order preserving normalized keys.
+/// Each key is a null byte followed by the value bytes. The null byte is 1
+/// for a value and 0 or 2 for a null depending on CompareFlags::nullsFirst.
+/// A null has no value bytes in variable width encodings and zero value
+/// bytes in fixed width ones, so that all nulls compare equal.
+///
+/// - Integers are stored big endian with the sign bit flipped.
+/// - REAL and DOUBLE are stored like integers after flipping the other bits
+///   of negative values. NaNs compare equal and above all other values, and
+///   -0 equals 0, as in RowContainer::compare().
+/// - TIMESTAMP is stored as seconds followed by nanos, HUGEINT as the high
+///   followed by the low 64 bits.
+/// - VARCHAR and VARBINARY are variable width. Zero bytes are escaped as 0,
+///   255 and the value ends with 0, 0, so that no encoding is a prefix of
+///   another.
+///
+/// The value bytes of descending keys are inverted. This is shared by
+/// PrefixSort, the merge of sorted spill runs and other users that compare
+/// many rows on the same keys.
+class KeyEncoder {
+ public:
+  /// Returns the number of value bytes of a fixed width key of 'type', or 0
+  /// if 'type' is not fixed width or not supported.
+  static int32_t fixedSize(const TypePtr& type);
+
+  /// Returns true if keys of 'type' can be encoded.
+  static bool isSupported(const TypePtr& type);
+
+  /// Writes the fixedSize() value bytes of 'value' at 'out', inverted if
+  /// 'descending'.
+  template <typename T>
+  static void encodeValue(T value, bool descending, char* out) {
+    if constexpr (std::is_same_v<T, bool>) {
+      encodeValue<uint8_t>(value, descending, out);
+    } else if constexpr (std::is_same_v<T, float>) {
+      encodeValue(floatBits<uint32_t>(value), descending, out);
+    } else if constexpr (std::is_same_v<T, double>) {
+      encodeValue(floatBits<uint64_t>(value), descending, out);
+    } else if constexpr (std::is_same_v<T, Timestamp>) {
+      encodeValue(value.getSeconds(), descending, out);
+      encodeValue(value.getNanos(), descending, out + sizeof(int64_t));
+    } else if constexpr (std::is_same_v<T, int128_t>) {
+      encodeValue(
+          static_cast<int64_t>(HugeInt::upper(value)), descending, out);
+      encodeValue(HugeInt::lower(value), descending, out + sizeof(int64_t));
+    } else {
+      using U = std::make_unsigned_t<T>;
+      auto encoded = static_cast<U>(value);
+      if constexpr (std::is_signed_v<T>) {
+        encoded ^= static_cast<U>(1) << (sizeof(U) * 8 - 1);
+      }
+      if (descending) {
+        encoded = ~encoded;
+      }
+      encoded = folly::Endian::big(encoded);
+      memcpy(out, &encoded, sizeof(U));
+    }
+  }
+
+  /// Writes the null byte and fixedSize() value bytes of 'numRows' rows of
+  /// the fixed width key 'decoded' of type 'type' at 'out', 'out + stride'
+  /// and so on. Flat columns without nulls are encoded in a branch free loop
+  /// over the raw values that the compiler can vectorize.
+  static void encodeFixedWidth(
+      const DecodedVector& decoded,
+      const TypePtr& type,
+      const CompareFlags& flags,
+      vector_size_t numRows,
+      int32_t stride,
+      char* out);
+
+  /// Appends the encoding of the first 'flags.size()' columns of 'input' to
+  /// 'keys[row]' for each row of 'input', resizing 'keys' to the number of
+  /// rows. The columns must be supported.
+  static void encode(
+      const RowVector& input,
+      const std::vector<CompareFlags>& flags,
+      std::vector<std::string>& keys);
+
+ private:
+  // Returns the bits of 'value' as an unsigned integer that orders like
+  // 'value'. Maps all NaNs to one value above infinity and -0 to 0.
+  template <typename U, typename T>
+  static U floatBits(T value) {
+    if (std::isnan(value)) {
+      value = std::numeric_limits<T>::quiet_NaN();
+    } else if (value == 0) {
+      value = 0;
+    }
+    U bits;
+    memcpy(&bits, &value, sizeof(U));
+    constexpr U kSignBit = static_cast<U>(1) << (sizeof(U) * 8 - 1);
+    // Flipping the sign bit orders positive values above negative ones. The
+    // other bits of negative values order in reverse.
+    return (bits & kSignBit) ? ~bits : bits ^ kSignBit;
+  }
+};
+
+} // namespace facebook::velox::row
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/row/UnsafeRowFast.h"
+#include "velox/row/UnsafeRowDeserializers.h"
 
 namespace facebook::velox::row {
 
@@ -408,4 +409,210 @@ int32_t UnsafeRowFast::serializeRow(vector_size_t index, char* buffer) {
 
   return variableWidthOffset;
 }
+
+namespace {
+// Returns the size and offset stored in the slot of a variable-width field.
+std::pair<uint32_t, uint32_t> readSizeAndOffset(const char* slot) {
+  uint64_t sizeAndOffset;
+  memcpy(&sizeAndOffset, slot, sizeof(uint64_t));
+  return {static_cast<uint32_t>(sizeAndOffset), sizeAndOffset >> 32};
+}
+
+// Returns the null flags of the field 'field' in all rows or nullptr if there
+// are no nulls.
+BufferPtr deserializeNulls(
+    const std::vector<std::string_view>& data,
+    size_t field,
+    memory::MemoryPool* pool) {
+  const auto numRows = data.size();
+  BufferPtr nulls = allocateNulls(numRows, pool);
+  auto* rawNulls = nulls->asMutable<uint64_t>();
+  for (auto i = 0; i < numRows; ++i) {
+    bits::setNull(rawNulls, i, bits::isBitSet(data[i].data(), field));
+  }
+
+  if (bits::countNulls(rawNulls, 0, numRows) == 0) {
+    return nullptr;
+  }
+  return nulls;
+}
+
+template <TypeKind kind>
+VectorPtr deserializeFixedWidth(
+    const TypePtr& type,
+    const std::vector<std::string_view>& data,
+    size_t fieldOffset,
+    const BufferPtr& nulls,
+    memory::MemoryPool* pool) {
+  using T = typename TypeTraits<kind>::NativeType;
+
+  if constexpr (!TypeTraits<kind>::isFixedWidth) {
+    VELOX_UNREACHABLE("Unexpected type: {}", type->toString());
+  } else {
+    const auto numRows = data.size();
+    const auto* rawNulls = nulls ? nulls->as<uint64_t>() : nullptr;
+
+    BufferPtr values;
+    if constexpr (kind == TypeKind::BOOLEAN) {
+      values = AlignedBuffer::allocate<bool>(numRows, pool, false);
+      auto* rawValues = values->asMutable<uint64_t>();
+      for (auto i = 0; i < numRows; ++i) {
+        if (data[i][fieldOffset] != 0 &&
+            !(rawNulls && bits::isBitNull(rawNulls, i))) {
+          bits::setBit(rawValues, i);
+        }
+      }
+    } else {
+      values = AlignedBuffer::allocate<T>(numRows, pool);
+      auto* rawValues = values->asMutable<T>();
+      for (auto i = 0; i < numRows; ++i) {
+        if (rawNulls && bits::isBitNull(rawNulls, i)) {
+          rawValues[i] = T();
+          continue;
+        }
+        const char* slot = data[i].data() + fieldOffset;
+        if constexpr (kind == TypeKind::TIMESTAMP) {
+          int64_t micros;
+          memcpy(&micros, slot, sizeof(int64_t));
+          rawValues[i] = Timestamp::fromMicros(micros);
+        } else {
+          memcpy(&rawValues[i], slot, sizeof(T));
+        }
+      }
+    }
+
+    return std::make_shared<FlatVector<T>>(
+        pool,
+        type,
+        nulls,
+        numRows,
+        std::move(values),
+        std::vector<BufferPtr>{});
+  }
+}
+
+VectorPtr deserializeStrings(
+    const TypePtr& type,
+    const std::vector<std::string_view>& data,
+    size_t fieldOffset,
+    const BufferPtr& nulls,
+    memory::MemoryPool* pool) {
+  const auto numRows = data.size();
+  const auto* rawNulls = nulls ? nulls->as<uint64_t>() : nullptr;
+
+  // Copy all non-inlined strings into a single buffer.
+  size_t totalSize = 0;
+  for (auto i = 0; i < numRows; ++i) {
+    if (rawNulls && bits::isBitNull(rawNulls, i)) {
+      continue;
+    }
+    auto size = readSizeAndOffset(data[i].data() + fieldOffset).first;
+    if (!StringView::isInline(size)) {
+      totalSize += size;
+    }
+  }
+
+  BufferPtr values = AlignedBuffer::allocate<StringView>(numRows, pool);
+  auto vector = std::make_shared<FlatVector<StringView>>(
+      pool, type, nulls, numRows, values, std::vector<BufferPtr>{});
+  char* rawBuffer =
+      totalSize > 0 ? vector->getRawStringBufferWithSpace(totalSize) : nullptr;
+
+  auto* rawValues = values->asMutable<StringView>();
+  for (auto i = 0; i < numRows; ++i) {
+    if (rawNulls && bits::isBitNull(rawNulls, i)) {
+      rawValues[i] = StringView();
+      continue;
+    }
+    auto [size, offset] = readSizeAndOffset(data[i].data() + fieldOffset);
+    const char* value = data[i].data() + offset;
+    if (StringView::isInline(size)) {
+      rawValues[i] = StringView(value, size);
+    } else {
+      memcpy(rawBuffer, value, size);
+      rawValues[i] = StringView(rawBuffer, size);
+      rawBuffer += size;
+    }
+  }
+
+  return vector;
+}
+
+VectorPtr deserializeUnknowns(
+    const std::vector<std::string_view>& data,
+    const BufferPtr& nulls,
+    memory::MemoryPool* pool) {
+  const auto numRows = data.size();
+  VELOX_CHECK_EQ(
+      BaseVector::countNulls(nulls, numRows),
+      numRows,
+      "UNKNOWN type supports only NULL values");
+
+  return std::make_shared<FlatVector<UnknownValue>>(
+      pool,
+      UNKNOWN(),
+      nulls,
+      numRows,
+      nullptr, // values
+      std::vector<BufferPtr>{}); // stringBuffers
+}
+
+// Deserializes a complex type or long decimal field using the row-wise
+// UnsafeRowDeserializer on the field values of all rows.
+VectorPtr deserializeNested(
+    const TypePtr& type,
+    const std::vector<std::string_view>& data,
+    size_t field,
+    size_t fieldOffset,
+    memory::MemoryPool* pool) {
+  std::vector<std::optional<std::string_view>> fieldData(data.size());
+  for (auto i = 0; i < data.size(); ++i) {
+    if (bits::isBitSet(data[i].data(), field)) {
+      continue;
+    }
+    auto [size, offset] = readSizeAndOffset(data[i].data() + fieldOffset);
+    fieldData[i] = std::string_view(data[i].data() + offset, size);
+  }
+  return UnsafeRowDeserializer::deserialize(fieldData, type, pool);
+}
+} // namespace
+
+// static
+RowVectorPtr UnsafeRowFast::deserialize(
+    const std::vector<std::string_view>& data,
+    const RowTypePtr& rowType,
+    memory::MemoryPool* pool) {
+  const auto numFields = rowType->size();
+  const size_t nullLength = alignBits(numFields);
+
+  std::vector<VectorPtr> fields(numFields);
+  for (auto i = 0; i < numFields; ++i) {
+    const auto& type = rowType->childAt(i);
+    const size_t fieldOffset = nullLength + i * kFieldWidth;
+
+    if (type->isUnKnown()) {
+      fields[i] =
+          deserializeUnknowns(data, deserializeNulls(data, i, pool), pool);
+    } else if (isFixedWidth(type)) {
+      fields[i] = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          deserializeFixedWidth,
+          type->kind(),
+          type,
+          data,
+          fieldOffset,
+          deserializeNulls(data, i, pool),
+          pool);
+    } else if (type->kind() == TypeKind::VARCHAR ||
+               type->kind() == TypeKind::VARBINARY) {
+      fields[i] = deserializeStrings(
+          type, data, fieldOffset, deserializeNulls(data, i, pool), pool);
+    } else {
+      fields[i] = deserializeNested(type, data, i, fieldOffset, pool);
+    }
+  }
+
+  return std::make_shared<RowVector>(
+      pool, rowType, nullptr, data.size(), std::move(fields));
+}
+
 } // namespace facebook::velox::row
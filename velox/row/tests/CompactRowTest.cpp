@@ -58,6 +58,7 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
     }
 
     std::vector<std::string_view> serialized;
+    std::vector<size_t> offsets;
 
     BufferPtr buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
     auto* rawBuffer = buffer->asMutable<char>();
@@ -65,6 +66,7 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
     for (auto i = 0; i < numRows; ++i) {
       auto size = row.serialize(i, rawBuffer + offset);
       serialized.push_back(std::string_view(rawBuffer + offset, size));
+      offsets.push_back(offset);
       offset += size;
 
       VELOX_CHECK_EQ(size, row.rowSize(i), "Row {}: {}", i, data->toString(i));
@@ -72,6 +74,12 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
 
     VELOX_CHECK_EQ(offset, totalSize);
 
+    // Serializing all rows in one batch must produce the same bytes.
+    BufferPtr batchBuffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    auto* rawBatchBuffer = batchBuffer->asMutable<char>();
+    row.serialize(0, numRows, offsets.data(), rawBatchBuffer);
+    ASSERT_EQ(0, memcmp(rawBuffer, rawBatchBuffer, totalSize));
+
     auto copy = CompactRow::deserialize(serialized, rowType, pool());
     assertEqualVectors(data, copy);
   }
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/row/KeyEncoder.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox::test;
+
+namespace facebook::velox::row {
+namespace {
+
+class KeyEncoderTest : public ::testing::Test, public VectorTestBase {
+ protected:
+  static int32_t sign(int32_t value) {
+    return value < 0 ? -1 : (value > 0 ? 1 : 0);
+  }
+
+  // Checks that the encoded keys of all pairs of rows of 'data' compare like
+  // the rows compare on the columns of 'data' with 'flags'.
+  void testOrder(
+      const RowVectorPtr& data,
+      const std::vector<CompareFlags>& flags) {
+    std::vector<std::string> keys;
+    KeyEncoder::encode(*data, flags, keys);
+    ASSERT_EQ(keys.size(), data->size());
+    for (auto i = 0; i < data->size(); ++i) {
+      for (auto j = 0; j < data->size(); ++j) {
+        int32_t expected = 0;
+        for (auto column = 0; column < flags.size(); ++column) {
+          const auto& child = data->childAt(column);
+          expected = child->compare(child.get(), i, j, flags[column]).value();
+          if (expected != 0) {
+            break;
+          }
+        }
+        const auto size = std::min(keys[i].size(), keys[j].size());
+        auto actual = memcmp(keys[i].data(), keys[j].data(), size);
+        if (actual == 0) {
+          actual = keys[i].size() - keys[j].size();
+        }
+        ASSERT_EQ(sign(expected), sign(actual))
+            << data->toString(i) << " vs " << data->toString(j);
+      }
+    }
+  }
+
+  // Checks that encodeFixedWidth() writes the same bytes as encode() for the
+  // single column of 'data'.
+  void testFixedWidth(const RowVectorPtr& data, const CompareFlags& flags) {
+    std::vector<std::string> keys;
+    KeyEncoder::encode(*data, {flags}, keys);
+    const auto& type = data->childAt(0)->type();
+    const auto stride = 1 + KeyEncoder::fixedSize(type);
+    std::vector<char> encoded(data->size() * stride, 0);
+    SelectivityVector rows(data->size());
+    DecodedVector decoded(*data->childAt(0), rows);
+    KeyEncoder::encodeFixedWidth(
+        decoded, type, flags, data->size(), stride, encoded.data());
+    for (auto row = 0; row < data->size(); ++row) {
+      ASSERT_EQ(keys[row].size(), stride);
+      ASSERT_EQ(
+          0, memcmp(keys[row].data(), encoded.data() + row * stride, stride))
+          << data->toString(row);
+    }
+  }
+};
+
+TEST_F(KeyEncoderTest, fixedSize) {
+  EXPECT_EQ(KeyEncoder::fixedSize(BOOLEAN()), 1);
+  EXPECT_EQ(KeyEncoder::fixedSize(SMALLINT()), 2);
+  EXPECT_EQ(KeyEncoder::fixedSize(DATE()), 4);
+  EXPECT_EQ(KeyEncoder::fixedSize(DOUBLE()), 8);
+  EXPECT_EQ(KeyEncoder::fixedSize(DECIMAL(20, 2)), 16);
+  EXPECT_EQ(KeyEncoder::fixedSize(TIMESTAMP()), 16);
+  EXPECT_EQ(KeyEncoder::fixedSize(VARCHAR()), 0);
+  EXPECT_TRUE(KeyEncoder::isSupported(VARBINARY()));
+  EXPECT_FALSE(KeyEncoder::isSupported(ARRAY(INTEGER())));
+}
+
+TEST_F(KeyEncoderTest, edgeValues) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<int64_t>(
+          {std::numeric_limits<int64_t>::min(),
+           -1,
+           0,
+           std::nullopt,
+           1,
+           std::numeric_limits<int64_t>::max()}),
+      makeNullableFlatVector<double>(
+          {-std::numeric_limits<double>::infinity(),
+           -0.0,
+           0.0,
+           std::numeric_limits<double>::quiet_NaN(),
+           std::nullopt,
+           std::numeric_limits<double>::infinity()}),
+      makeNullableFlatVector<std::string>(
+          {"", std::string("a\0b", 3), "a", std::nullopt, "ab", "b"}),
+  });
+  for (auto ascending : {true, false}) {
+    for (auto nullsFirst : {true, false}) {
+      CompareFlags flags{nullsFirst, ascending};
+      for (auto column = 0; column < data->childrenSize(); ++column) {
+        SCOPED_TRACE(fmt::format("{} {}", column, flags.toString()));
+        testOrder(makeRowVector({data->childAt(column)}), {flags});
+      }
+    }
+  }
+}
+
+TEST_F(KeyEncoderTest, fuzz) {
+  auto rowType = ROW({
+      BOOLEAN(),
+      TINYINT(),
+      SMALLINT(),
+      INTEGER(),
+      BIGINT(),
+      REAL(),
+      DOUBLE(),
+      TIMESTAMP(),
+      DECIMAL(20, 5),
+      VARCHAR(),
+      VARBINARY(),
+  });
+  VectorFuzzer::Options opts;
+  opts.vectorSize = 100;
+  opts.nullRatio = 0.1;
+  opts.stringVariableLength = true;
+  opts.stringLength = 10;
+  VectorFuzzer fuzzer(opts, pool());
+
+  for (auto column = 0; column < rowType->size(); ++column) {
+    const auto& type = rowType->childAt(column);
+    SCOPED_TRACE(type->toString());
+    // Few distinct values so that later keys decide some comparisons.
+    auto data = makeRowVector(
+        {fuzzer.fuzzDictionary(fuzzer.fuzzFlat(type, 10), opts.vectorSize),
+         fuzzer.fuzzFlat(BIGINT())});
+    testOrder(data, {{true, false}, {false, true}});
+    if (KeyEncoder::fixedSize(type) > 0) {
+      testFixedWidth(data, {false, false});
+      testFixedWidth(
+          makeRowVector({fuzzer.fuzzFlatNotNull(type)}), {true, true});
+      testFixedWidth(
+          makeRowVector({fuzzer.fuzzFlatNotNull(type)}), {true, false});
+    }
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::row
@@ -82,6 +82,16 @@ class UnsafeRowFuzzTests : public ::testing::Test {
           UnsafeRowDeserializer::deserialize(serialized, rowType, pool_.get());
 
       assertEqualVectors(inputVector, outputVector);
+
+      // Deserialize the same bytes column by column.
+      std::vector<std::string_view> rows;
+      rows.reserve(serialized.size());
+      for (const auto& row : serialized) {
+        rows.push_back(row.value());
+      }
+      assertEqualVectors(
+          inputVector,
+          UnsafeRowFast::deserialize(rows, rowType, pool_.get()));
     }
   }
 
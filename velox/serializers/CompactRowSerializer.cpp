@@ -19,11 +19,31 @@
 
 namespace facebook::velox::serializer {
 
+// PartitionedOutput estimates the row sizes one column at a time. The column is
+// serialized as a single column row to get its share of the row size.
 void CompactRowVectorSerde::estimateSerializedSize(
-    VectorPtr /* vector */,
-    const folly::Range<const IndexRange*>& /* ranges */,
-    vector_size_t** /* sizes */) {
-  VELOX_UNSUPPORTED();
+    VectorPtr vector,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t** sizes) {
+  auto rowVector = std::make_shared<RowVector>(
+      vector->pool(),
+      ROW({vector->type()}),
+      nullptr,
+      vector->size(),
+      std::vector<VectorPtr>{vector});
+  if (auto fixedRowSize =
+          row::CompactRow::fixedRowSize(asRowType(rowVector->type()))) {
+    for (auto i = 0; i < ranges.size(); ++i) {
+      *sizes[i] += fixedRowSize.value() * ranges[i].size;
+    }
+    return;
+  }
+  row::CompactRow row(rowVector);
+  for (auto i = 0; i < ranges.size(); ++i) {
+    for (auto j = ranges[i].begin; j < ranges[i].begin + ranges[i].size; ++j) {
+      *sizes[i] += row.rowSize(j);
+    }
+  }
 }
 
 namespace {
@@ -37,40 +57,55 @@ class CompactRowVectorSerializer : public VectorSerializer {
   void append(
       const RowVectorPtr& vector,
       const folly::Range<const IndexRange*>& ranges) override {
-    size_t totalSize = 0;
+    size_t numRows = 0;
+    for (const auto& range : ranges) {
+      numRows += range.size;
+    }
+    if (numRows == 0) {
+      return;
+    }
+
+    // Offsets of the serialized rows in the output buffer. Each row is
+    // preceded by its size.
     row::CompactRow row(vector);
+    rowOffsets_.resize(numRows);
+    rowSizes_.resize(numRows);
+    size_t totalSize = 0;
+    size_t index = 0;
     if (auto fixedRowSize =
             row::CompactRow::fixedRowSize(asRowType(vector->type()))) {
-      for (const auto& range : ranges) {
-        totalSize += (fixedRowSize.value() + sizeof(TRowSize)) * range.size;
+      for (; index < numRows; ++index) {
+        rowSizes_[index] = fixedRowSize.value();
+        rowOffsets_[index] = totalSize + sizeof(TRowSize);
+        totalSize += fixedRowSize.value() + sizeof(TRowSize);
       }
-
     } else {
       for (const auto& range : ranges) {
         for (auto i = range.begin; i < range.begin + range.size; ++i) {
-          totalSize += row.rowSize(i) + sizeof(TRowSize);
+          rowSizes_[index] = row.rowSize(i);
+          rowOffsets_[index] = totalSize + sizeof(TRowSize);
+          totalSize += rowSizes_[index] + sizeof(TRowSize);
+          ++index;
         }
       }
     }
 
-    if (totalSize == 0) {
-      return;
-    }
-
     BufferPtr buffer = AlignedBuffer::allocate<char>(totalSize, pool_, 0);
     auto rawBuffer = buffer->asMutable<char>();
     buffers_.push_back(std::move(buffer));
 
-    size_t offset = 0;
-    for (auto& range : ranges) {
-      for (auto i = range.begin; i < range.begin + range.size; ++i) {
-        // Write row data.
-        TRowSize size = row.serialize(i, rawBuffer + offset + sizeof(TRowSize));
+    // Write raw sizes. Needs to be in big endian order.
+    for (auto i = 0; i < numRows; ++i) {
+      *(TRowSize*)(rawBuffer + rowOffsets_[i] - sizeof(TRowSize)) =
+          folly::Endian::big(rowSizes_[i]);
+    }
 
-        // Write raw size. Needs to be in big endian order.
-        *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(size);
-        offset += sizeof(TRowSize) + size;
-      }
+    // Write row data.
+    index = 0;
+    for (const auto& range : ranges) {
+      row.serialize(
+          range.begin, range.size, rowOffsets_.data() + index, rawBuffer);
+      index += range.size;
     }
   }
 
@@ -92,6 +127,10 @@ class CompactRowVectorSerializer : public VectorSerializer {
  private:
   memory::MemoryPool* const FOLLY_NONNULL pool_;
   std::vector<BufferPtr> buffers_;
+
+  // Reusable per-append offsets and sizes of the serialized rows.
+  std::vector<size_t> rowOffsets_;
+  std::vector<TRowSize> rowSizes_;
 };
 } // namespace
 
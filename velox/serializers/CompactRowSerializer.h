@@ -23,7 +23,8 @@ namespace facebook::velox::serializer {
 class CompactRowVectorSerde : public VectorSerde {
  public:
   CompactRowVectorSerde() = default;
-  // We do not implement this method since it is not used in production code.
+  // Adds the serialized size of the rows of 'vector' in each of 'ranges' to
+  // the corresponding 'sizes'. 'vector' is one column of the serialized rows.
   void estimateSerializedSize(
       VectorPtr vector,
       const folly::Range<const IndexRange*>& ranges,
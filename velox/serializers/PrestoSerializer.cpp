@@ -14,9 +14,12 @@
  * limitations under the License.
  */
 #include "velox/serializers/PrestoSerializer.h"
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
 #include "velox/common/base/Crc.h"
 #include "velox/common/base/RawVector.h"
 #include "velox/common/memory/ByteStream.h"
+#include "velox/common/process/ProcessBase.h"
 #include "velox/functions/prestosql/types/TimestampWithTimeZoneType.h"
 #include "velox/vector/BiasVector.h"
 #include "velox/vector/ComplexVector.h"
@@ -314,6 +317,44 @@ readNulls(ByteStream* source, vector_size_t size, BaseVector& result) {
   return nullCount;
 }
 
+// Keeps the memory of a deserialized page alive for as long as a buffer
+// referencing it exists.
+struct InputReleaser {
+  explicit InputReleaser(std::shared_ptr<void> owner)
+      : owner_(std::move(owner)) {}
+  void addRef() const {}
+  void release() const {}
+
+ private:
+  std::shared_ptr<void> owner_;
+};
+
+// Reads 'size' fixed width values from 'source'. Returns a view over the input
+// if the values are in one range and suitably aligned. Otherwise copies them
+// into a new buffer. 'source' must have an input owner.
+template <typename T>
+BufferPtr readValuesZeroCopy(
+    ByteStream* source,
+    vector_size_t size,
+    velox::memory::MemoryPool* pool) {
+  const int32_t numBytes = size * sizeof(T);
+  auto view = source->nextView(numBytes);
+  if (view.size() == numBytes &&
+      reinterpret_cast<uintptr_t>(view.data()) % alignof(T) == 0) {
+    return BufferView<InputReleaser>::create(
+        reinterpret_cast<const uint8_t*>(view.data()),
+        numBytes,
+        InputReleaser(source->inputOwner()));
+  }
+  auto values = AlignedBuffer::allocate<T>(size, pool);
+  auto rawValues = values->asMutable<char>();
+  memcpy(rawValues, view.data(), view.size());
+  if (view.size() < numBytes) {
+    source->readBytes(rawValues + view.size(), numBytes - view.size());
+  }
+  return values;
+}
+
 template <typename T>
 void read(
     ByteStream* source,
@@ -327,6 +368,22 @@ void read(
   auto flatResult = result->asFlatVector<T>();
   auto nullCount = readNulls(source, size, *flatResult);
 
+  if constexpr (!std::is_same_v<T, bool> && !std::is_same_v<T, Timestamp>) {
+    // Values without nulls are laid out as in a FlatVector and can be
+    // referenced in place if something keeps the input alive.
+    if (nullCount == 0 && size > 0 && source->inputOwner() &&
+        !type->isLongDecimal()) {
+      result = std::make_shared<FlatVector<T>>(
+          pool,
+          type,
+          nullptr,
+          size,
+          readValuesZeroCopy<T>(source, size, pool),
+          std::vector<BufferPtr>{});
+      return;
+    }
+  }
+
   BufferPtr values = flatResult->mutableValues(size);
   if constexpr (std::is_same_v<T, Timestamp>) {
     if (useLosslessTimestamp) {
@@ -940,6 +997,7 @@ class VectorStream {
       : type_(type),
         encoding_{encoding},
         useLosslessTimestamp_(useLosslessTimestamp),
+        streamArena_(streamArena),
         nulls_(streamArena, true, true),
         lengths_(streamArena),
         values_(streamArena) {
@@ -1059,6 +1117,56 @@ class VectorStream {
     return children_[index].get();
   }
 
+  /// Returns the number of rows appended so far.
+  int32_t size() const {
+    return nullCount_ + nonNullCount_;
+  }
+
+  /// Switches an empty stream to dictionary encoding. Rows are then appended
+  /// as indices into the distinct values in childAt(0), which the caller
+  /// tracks in dictionaryState(). If all rows end up with the same value, the
+  /// stream is flushed as RLE instead. 'numValues' is the expected number of
+  /// distinct values.
+  void startDictionary(int32_t numValues) {
+    VELOX_CHECK_EQ(size(), 0);
+    VELOX_CHECK(!encoding_.has_value());
+    encoding_ = VectorEncoding::Simple::DICTIONARY;
+    isAdaptiveDictionary_ = true;
+    initializeHeader(kDictionary, *streamArena_);
+    children_.clear();
+    children_.emplace_back(std::make_unique<VectorStream>(
+        type_,
+        std::nullopt,
+        streamArena_,
+        std::max(1, numValues),
+        useLosslessTimestamp_));
+  }
+
+  bool isAdaptiveDictionary() const {
+    return isAdaptiveDictionary_;
+  }
+
+  /// Maps the rows of the columns appended to a stream started with
+  /// startDictionary() to their position in childAt(0).
+  struct DictionaryState {
+    /// Last non-constant column appended. Kept alive so that its identity can
+    /// be used to reuse 'indices' when the next append is from the same
+    /// column.
+    VectorPtr lastVector;
+    /// Maps a row of 'lastVector->wrappedVector()' to its position in the
+    /// dictionary.
+    folly::F14FastMap<vector_size_t, int32_t> indices;
+    /// Position of null in the dictionary for 'lastVector' or -1.
+    int32_t nullIndex{-1};
+    /// Last constant column appended and the position of its value.
+    VectorPtr lastConstant;
+    int32_t constantIndex{-1};
+  };
+
+  DictionaryState& dictionaryState() {
+    return dictionaryState_;
+  }
+
   // Returns the size to flush to OutputStream before calling `flush`.
   size_t serializedSize() {
     CountingOutputStream out;
@@ -1068,6 +1176,15 @@ class VectorStream {
 
   // Writes out the accumulated contents. Does not change the state.
   void flush(OutputStream* out) {
+    if (isAdaptiveDictionary_ && children_[0]->size() == 1) {
+      // All rows have the same value.
+      writeInt32(out, kRLE.size());
+      out->write(kRLE.data(), kRLE.size());
+      writeInt32(out, nonNullCount_);
+      children_[0]->flush(out);
+      return;
+    }
+
     out->write(reinterpret_cast<char*>(header_.buffer), header_.size);
 
     if (encoding_.has_value()) {
@@ -1159,11 +1276,16 @@ class VectorStream {
 
  private:
   const TypePtr type_;
-  const std::optional<VectorEncoding::Simple> encoding_;
+  std::optional<VectorEncoding::Simple> encoding_;
   /// Indicates whether to serialize timestamps with nanosecond precision.
   /// If false, they are serialized with millisecond precision which is
   /// compatible with presto.
   const bool useLosslessTimestamp_;
+  StreamArena* const streamArena_;
+  // True if the stream was switched to dictionary encoding by
+  // startDictionary().
+  bool isAdaptiveDictionary_{false};
+  DictionaryState dictionaryState_;
   int32_t nonNullCount_{0};
   int32_t nullCount_{0};
   int32_t totalLength_{0};
@@ -1619,6 +1741,133 @@ void serializeEncodedColumn(
   }
 }
 
+// Returns true if the rows in 'ranges' of a dictionary or constant encoded
+// 'vector' take fewer bytes as 4 byte indices into their distinct values than
+// as flat values.
+bool shouldPreserveDictionary(
+    const BaseVector& vector,
+    const folly::Range<const IndexRange*>& ranges,
+    int32_t numRows) {
+  if (!vector.type()->isPrimitiveType() ||
+      vector.typeKind() == TypeKind::UNKNOWN) {
+    return false;
+  }
+  if (vector.isConstantEncoding()) {
+    return true;
+  }
+  if (vector.encoding() != VectorEncoding::Simple::DICTIONARY) {
+    return false;
+  }
+
+  const auto* wrapped = vector.wrappedVector();
+  const bool isString = vector.typeKind() == TypeKind::VARCHAR ||
+      vector.typeKind() == TypeKind::VARBINARY;
+  // Strings take a 4 byte length besides their bytes.
+  const int64_t fixedSize =
+      isString ? sizeof(int32_t) : vector.type()->cppSizeInBytes();
+  folly::F14FastSet<vector_size_t> distinct;
+  int64_t distinctBytes = 0;
+  int64_t flatBytes = 0;
+  for (const auto& range : ranges) {
+    for (auto row = range.begin; row < range.begin + range.size; ++row) {
+      int64_t rowBytes = fixedSize;
+      const auto index = vector.wrappedIndex(row);
+      if (isString && !vector.isNullAt(row)) {
+        rowBytes += wrapped->asUnchecked<SimpleVector<StringView>>()
+                        ->valueAt(index)
+                        .size();
+      }
+      flatBytes += rowBytes;
+      if (distinct.insert(index).second) {
+        distinctBytes += rowBytes;
+      }
+    }
+  }
+  return distinctBytes + numRows * sizeof(int32_t) < flatBytes;
+}
+
+// Appends the rows in 'ranges' of 'column' to 'stream' started with
+// VectorStream::startDictionary(). Adds the values not yet in the dictionary
+// to the stream's child and the positions of all values to its indices.
+void serializeDictionaryIndices(
+    const VectorPtr& column,
+    const folly::Range<const IndexRange*>& ranges,
+    int32_t numRows,
+    VectorStream* stream) {
+  auto& state = stream->dictionaryState();
+  auto* values = stream->childAt(0);
+  const auto* vector = column->loadedVector();
+  stream->appendNonNull(numRows);
+
+  if (vector->isConstantEncoding()) {
+    const bool isNull = vector->isNullAt(0);
+    if (!state.lastConstant || state.lastConstant->isNullAt(0) != isNull ||
+        (!isNull && !vector->equalValueAt(state.lastConstant.get(), 0, 0))) {
+      IndexRange first{0, 1};
+      serializeColumn(vector, folly::Range(&first, 1), values);
+      state.lastConstant = column;
+      state.constantIndex = values->size() - 1;
+    }
+    for (auto i = 0; i < numRows; ++i) {
+      stream->appendOne<int32_t>(state.constantIndex);
+    }
+    return;
+  }
+
+  if (state.lastVector != column) {
+    state.lastVector = column;
+    state.indices.clear();
+    state.nullIndex = -1;
+  }
+  const auto* wrapped = vector->wrappedVector();
+  std::vector<IndexRange> newValues;
+  for (const auto& range : ranges) {
+    for (auto row = range.begin; row < range.begin + range.size; ++row) {
+      if (vector->isNullAt(row)) {
+        if (state.nullIndex < 0) {
+          if (!newValues.empty()) {
+            serializeColumn(wrapped, newValues, values);
+            newValues.clear();
+          }
+          values->appendNull();
+          state.nullIndex = values->size() - 1;
+        }
+        stream->appendOne<int32_t>(state.nullIndex);
+        continue;
+      }
+      const auto index = vector->wrappedIndex(row);
+      auto [it, inserted] = state.indices.try_emplace(
+          index, values->size() + newValues.size());
+      if (inserted) {
+        newValues.push_back(IndexRange{index, 1});
+      }
+      stream->appendOne<int32_t>(it->second);
+    }
+  }
+  if (!newValues.empty()) {
+    serializeColumn(wrapped, newValues, values);
+  }
+}
+
+// Serializes a top level column. Switches an empty stream to dictionary
+// encoding if 'column' is dictionary or constant encoded and that is
+// smaller.
+void serializeColumnPreservingEncoding(
+    const VectorPtr& column,
+    const folly::Range<const IndexRange*>& ranges,
+    int32_t numRows,
+    VectorStream* stream) {
+  if (stream->size() == 0 && !stream->isAdaptiveDictionary() &&
+      shouldPreserveDictionary(*column->loadedVector(), ranges, numRows)) {
+    stream->startDictionary(numRows);
+  }
+  if (stream->isAdaptiveDictionary()) {
+    serializeDictionaryIndices(column, ranges, numRows, stream);
+  } else {
+    serializeColumn(column.get(), ranges, stream);
+  }
+}
+
 void expandRepeatedRanges(
     const BaseVector* vector,
     const vector_size_t* rawOffsets,
@@ -1891,9 +2140,15 @@ class PrestoVectorSerializer : public VectorSerializer {
       int32_t numRows,
       StreamArena* streamArena,
       bool useLosslessTimestamp,
-      common::CompressionKind compressionKind)
+      common::CompressionKind compressionKind,
+      bool preserveEncodings,
+      float minCompressionRatio,
+      PrestoVectorSerde::CompressionStats* compressionStats)
       : streamArena_(streamArena),
-        codec_(common::compressionKindToCodec(compressionKind)) {
+        codec_(common::compressionKindToCodec(compressionKind)),
+        preserveEncodings_(preserveEncodings && encodings.empty()),
+        minCompressionRatio_(minCompressionRatio),
+        compressionStats_(compressionStats) {
     auto types = rowType->children();
     auto numTypes = types.size();
     streams_.resize(numTypes);
@@ -1914,7 +2169,12 @@ class PrestoVectorSerializer : public VectorSerializer {
     if (newRows > 0) {
       numRows_ += newRows;
       for (int32_t i = 0; i < vector->childrenSize(); ++i) {
-        serializeColumn(vector->childAt(i).get(), ranges, streams_[i].get());
+        if (preserveEncodings_) {
+          serializeColumnPreservingEncoding(
+              vector->childAt(i), ranges, newRows, streams_[i].get());
+        } else {
+          serializeColumn(vector->childAt(i).get(), ranges, streams_[i].get());
+        }
       }
     }
   }
@@ -2015,24 +2275,49 @@ class PrestoVectorSerializer : public VectorSerializer {
     out->seekp(offset + size);
   }
 
-  void flushCompressed(
-      int32_t numRows,
-      OutputStream* output,
-      PrestoOutputStreamListener* listener) {
-    const int32_t offset = output->tellp();
-    char codec = kCompressedBitMask;
-    if (listener) {
-      codec |= kCheckSumBitMask;
+  // Returns true if the page should be compressed. After a page that does not
+  // compress well, skips compression for a number of pages that doubles with
+  // each consecutive such page.
+  bool shouldTryCompression() {
+    if (compressionStats_ == nullptr || compressionStats_->pagesToSkip == 0) {
+      return true;
     }
+    --compressionStats_->pagesToSkip;
+    return false;
+  }
 
-    // Pause CRC computation
-    if (listener) {
-      listener->pause();
+  void updateCompressionStats(
+      int32_t uncompressedSize,
+      std::optional<int32_t> compressedSize,
+      uint64_t cpuNanos) {
+    if (compressionStats_ == nullptr) {
+      return;
     }
+    static constexpr int32_t kMaxPagesToSkip = 64;
+    auto& stats = *compressionStats_;
+    stats.codecCpuNanos += cpuNanos;
+    if (!compressedSize.has_value()) {
+      ++stats.numUncompressedPages;
+      return;
+    }
+    stats.compressionInputBytes += uncompressedSize;
+    if (compressedSize.value() <= uncompressedSize * minCompressionRatio_) {
+      ++stats.numCompressedPages;
+      stats.compressedBytes += compressedSize.value();
+      stats.pagesToSkipOnFailure = 1;
+    } else {
+      ++stats.numUncompressedPages;
+      stats.compressedBytes += uncompressedSize;
+      stats.pagesToSkip = stats.pagesToSkipOnFailure;
+      stats.pagesToSkipOnFailure =
+          std::min(2 * stats.pagesToSkipOnFailure, kMaxPagesToSkip);
+    }
+  }
 
-    writeInt32(output, numRows);
-    output->write(&codec, 1);
-
+  void flushCompressed(
+      int32_t numRows,
+      OutputStream* output,
+      PrestoOutputStreamListener* listener) {
     IOBufOutputStream out(
         *(streamArena_->pool()), nullptr, streamArena_->size());
     writeInt32(&out, streams_.size());
@@ -2046,19 +2331,49 @@ class PrestoVectorSerializer : public VectorSerializer {
         uncompressedSize,
         codec_->maxUncompressedLength(),
         "UncompressedSize exceeds limit");
-    auto compressed = codec_->compress(out.getIOBuf().get());
-    const int32_t compressedSize = compressed->length();
+    auto data = out.getIOBuf();
+    std::unique_ptr<folly::IOBuf> compressed;
+    uint64_t cpuNanos = 0;
+    if (shouldTryCompression()) {
+      const auto startCpuNanos = process::threadCpuNanos();
+      compressed = codec_->compress(data.get());
+      cpuNanos = process::threadCpuNanos() - startCpuNanos;
+      const int32_t compressedSize = compressed->computeChainDataLength();
+      updateCompressionStats(uncompressedSize, compressedSize, cpuNanos);
+      // Pages that do not compress well are sent uncompressed and the reader
+      // does not need to decompress them.
+      if (compressedSize > uncompressedSize * minCompressionRatio_) {
+        compressed.reset();
+      }
+    } else {
+      updateCompressionStats(uncompressedSize, std::nullopt, 0);
+    }
+
+    char codec = compressed ? kCompressedBitMask : 0;
+    if (listener) {
+      codec |= kCheckSumBitMask;
+    }
+    const auto& payload = compressed ? compressed : data;
+    const int32_t payloadSize = payload->computeChainDataLength();
+
+    // Pause CRC computation
+    if (listener) {
+      listener->pause();
+    }
+
+    writeInt32(output, numRows);
+    output->write(&codec, 1);
     writeInt32(output, uncompressedSize);
-    writeInt32(output, compressedSize);
+    writeInt32(output, payloadSize);
     const int32_t crcOffset = output->tellp();
     writeInt64(output, 0); // Write zero checksum
     // Number of columns and stream content. Unpause CRC.
     if (listener) {
       listener->resume();
     }
-    output->write(
-        reinterpret_cast<const char*>(compressed->writableData()),
-        compressed->length());
+    for (auto& range : *payload) {
+      output->write(reinterpret_cast<const char*>(range.data()), range.size());
+    }
     // Pause CRC computation
     if (listener) {
       listener->pause();
@@ -2067,7 +2382,7 @@ class PrestoVectorSerializer : public VectorSerializer {
     // Fill in crc
     int64_t crc = 0;
     if (listener) {
-      crc = computeChecksum(listener, codec, numRows, compressedSize);
+      crc = computeChecksum(listener, codec, numRows, payloadSize);
     }
     output->seekp(crcOffset);
     writeInt64(output, crc);
@@ -2094,6 +2409,9 @@ class PrestoVectorSerializer : public VectorSerializer {
 
   StreamArena* const streamArena_;
   const std::unique_ptr<folly::io::Codec> codec_;
+  const bool preserveEncodings_;
+  const float minCompressionRatio_;
+  PrestoVectorSerde::CompressionStats* const compressionStats_;
   int32_t numRows_{0};
   std::vector<std::unique_ptr<VectorStream>> streams_;
 };
@@ -2118,7 +2436,10 @@ std::unique_ptr<VectorSerializer> PrestoVectorSerde::createSerializer(
       numRows,
       streamArena,
       prestoOptions.useLosslessTimestamp,
-      prestoOptions.compressionKind);
+      prestoOptions.compressionKind,
+      prestoOptions.preserveEncodings,
+      prestoOptions.minCompressionRatio,
+      prestoOptions.compressionStats);
 }
 
 void PrestoVectorSerde::serializeEncoded(
@@ -2171,27 +2492,46 @@ void PrestoVectorSerde::deserialize(
   VELOX_CHECK_EQ(
       checksum, actualCheckSum, "Received corrupted serialized page.");
 
-  VELOX_CHECK_EQ(
-      needCompression(*codec),
-      isCompressedBitSet(pageCodecMarker),
+  // A serializer with a codec writes pages that do not compress well
+  // uncompressed.
+  VELOX_CHECK(
+      needCompression(*codec) || !isCompressedBitSet(pageCodecMarker),
       "Compression kind {} should align with codec marker.",
       common::compressionKindToString(
           common::codecTypeToCompressionKind(codec->type())));
 
+  auto* compressionStats = prestoOptions.compressionStats;
   auto& children = (*result)->children();
   const auto& childTypes = type->asRow().children();
-  if (!needCompression(*codec)) {
+  if (!isCompressedBitSet(pageCodecMarker)) {
+    if (compressionStats && needCompression(*codec)) {
+      ++compressionStats->numUncompressedPages;
+    }
     auto numColumns = source->read<int32_t>();
     readColumns(source, pool, childTypes, children, useLosslessTimestamp);
   } else {
     auto compressBuf = folly::IOBuf::create(compressedSize);
     source->readBytes(compressBuf->writableData(), compressedSize);
     compressBuf->append(compressedSize);
+    const auto startCpuNanos = process::threadCpuNanos();
     auto uncompress = codec->uncompress(compressBuf.get(), uncompressedSize);
+    if (compressionStats) {
+      ++compressionStats->numCompressedPages;
+      compressionStats->compressionInputBytes += uncompressedSize;
+      compressionStats->compressedBytes += compressedSize;
+      compressionStats->codecCpuNanos +=
+          process::threadCpuNanos() - startCpuNanos;
+    }
     ByteRange byteRange{
         uncompress->writableData(), (int32_t)uncompress->length(), 0};
     ByteStream uncompressedSource;
     uncompressedSource.resetInput({byteRange});
+    if (source->inputOwner()) {
+      // The caller allows referencing the input, so the vectors may also
+      // reference the uncompressed bytes.
+      uncompressedSource.setInputOwner(
+          std::shared_ptr<folly::IOBuf>(std::move(uncompress)));
+    }
     auto numColumns = uncompressedSource.read<int32_t>();
     VELOX_CHECK_EQ(numColumns, type->as<TypeKind::ROW>().size());
     readColumns(
@@ -21,6 +21,28 @@
 namespace facebook::velox::serializer::presto {
 class PrestoVectorSerde : public VectorSerde {
  public:
+  /// Counters of page compression. Updated by the serializers and the
+  /// deserialization given a pointer to them in PrestoOptions. Not thread
+  /// safe.
+  struct CompressionStats {
+    /// Number of pages written or read compressed.
+    int64_t numCompressedPages{0};
+    /// Number of pages written or read uncompressed although a codec was set.
+    int64_t numUncompressedPages{0};
+    /// Bytes of the pages compression was tried on, before and after. Pages
+    /// that did not compress well count with their uncompressed size.
+    int64_t compressionInputBytes{0};
+    int64_t compressedBytes{0};
+    /// Thread CPU time spent in compressing or decompressing.
+    int64_t codecCpuNanos{0};
+
+    /// Number of next pages to write uncompressed without trying. Set after a
+    /// page does not compress well to 'pagesToSkipOnFailure', which doubles
+    /// with each consecutive such page.
+    int32_t pagesToSkip{0};
+    int32_t pagesToSkipOnFailure{1};
+  };
+
   // Input options that the serializer recognizes.
   struct PrestoOptions : VectorSerde::Options {
     PrestoOptions() = default;
@@ -39,6 +61,19 @@ class PrestoVectorSerde : public VectorSerde {
     common::CompressionKind compressionKind{
         common::CompressionKind::CompressionKind_NONE};
     std::vector<VectorEncoding::Simple> encodings;
+    // If true, top level dictionary and constant encoded columns of primitive
+    // types are serialized as DICTIONARY or RLE if that is smaller than
+    // flattening them. The choice is made per column on the first append to a
+    // serializer. Ignored if 'encodings' is set.
+    bool preserveEncodings{false};
+    // Pages whose compressed size is more than this fraction of their
+    // uncompressed size are written uncompressed. Same as the minimum
+    // compression ratio of Presto.
+    float minCompressionRatio{0.8};
+    // If set, the serializer counts its compression attempts here and uses the
+    // outcome of earlier pages to skip compression of incompressible data. The
+    // deserialization counts the pages it decompresses.
+    CompressionStats* compressionStats{nullptr};
   };
 
   void estimateSerializedSize(
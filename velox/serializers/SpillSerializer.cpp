@@ -0,0 +1,886 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/SpillSerializer.h"
+#include <folly/container/F14Map.h>
+#include "velox/common/memory/ByteStream.h"
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::serializer {
+namespace {
+
+// Encoding of a column, written ahead of the column data.
+enum class Encoding : uint8_t {
+  // A single column page in the Presto wire format.
+  kPresto = 0,
+  // The minimum value and the bit packed differences to it.
+  kFrameOfReference = 1,
+  // Each value as the size of the prefix shared with the previous value, the
+  // size of the rest and the rest.
+  kPrefix = 2,
+  // The distinct values in prefix encoding and the bit packed indices into
+  // them.
+  kDictionary = 3,
+};
+
+// Set in the header of a compressed batch.
+constexpr int8_t kCompressedBitMask = 1;
+
+// Limits on the distinct values of a string column beyond which the column is
+// not considered for dictionary encoding. The distinct values are copied
+// outside of the StreamArena, so their size is bounded.
+constexpr int32_t kMaxDictionarySize = 1 << 16;
+constexpr int64_t kMaxDictionaryBytes = 1 << 20;
+
+const presto::PrestoVectorSerde::PrestoOptions& prestoOptions() {
+  static const presto::PrestoVectorSerde::PrestoOptions kOptions{
+      true, common::CompressionKind_NONE};
+  return kOptions;
+}
+
+presto::PrestoVectorSerde& prestoSerde() {
+  static presto::PrestoVectorSerde serde;
+  return serde;
+}
+
+template <typename T>
+void write(OutputStream* out, T value) {
+  out->write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+int64_t numPackedWords(int64_t numValues, uint8_t bitWidth) {
+  return (numValues * bitWidth + 63) / 64;
+}
+
+uint8_t bitWidthOf(uint64_t maxValue) {
+  return maxValue == 0 ? 0 : 64 - bits::countLeadingZeros(maxValue);
+}
+
+// Bytes appended to ranges of the serializer's StreamArena, so that the size
+// of the arena accounts for the buffered data.
+class ArenaBuffer {
+ public:
+  explicit ArenaBuffer(StreamArena* arena) : arena_(arena) {}
+
+  void append(const void* data, int64_t size) {
+    auto* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+      if (ranges_.empty() || ranges_.back().position == ranges_.back().size) {
+        // Sizes the ranges as a fraction of the data, so that small columns
+        // take little memory and large ones few ranges.
+        ranges_.emplace_back();
+        arena_->newRange(
+            std::clamp<int64_t>(size_ / 4, 1 << 10, 1 << 20), &ranges_.back());
+      }
+      auto& range = ranges_.back();
+      const auto numBytes =
+          std::min<int64_t>(size, range.size - range.position);
+      memcpy(range.buffer + range.position, bytes, numBytes);
+      range.position += numBytes;
+      bytes += numBytes;
+      size -= numBytes;
+      size_ += numBytes;
+    }
+  }
+
+  template <typename T>
+  void appendOne(T value) {
+    append(&value, sizeof(T));
+  }
+
+  void appendVarint(uint64_t value) {
+    uint8_t bytes[10];
+    int32_t size = 0;
+    while (value >= 0x80) {
+      bytes[size++] = value | 0x80;
+      value >>= 7;
+    }
+    bytes[size++] = value;
+    append(bytes, size);
+  }
+
+  int64_t size() const {
+    return size_;
+  }
+
+  void flush(OutputStream* out) const {
+    for (const auto& range : ranges_) {
+      out->write(reinterpret_cast<const char*>(range.buffer), range.position);
+    }
+  }
+
+  // Reads back the appended values in order.
+  class Reader {
+   public:
+    explicit Reader(const ArenaBuffer& buffer) : ranges_(buffer.ranges_) {}
+
+    template <typename T>
+    T next() {
+      T value;
+      auto* bytes = reinterpret_cast<uint8_t*>(&value);
+      int32_t size = sizeof(T);
+      while (size > 0) {
+        const auto& range = ranges_[rangeIndex_];
+        if (position_ == range.position) {
+          ++rangeIndex_;
+          position_ = 0;
+          continue;
+        }
+        const auto numBytes = std::min(size, range.position - position_);
+        memcpy(bytes, range.buffer + position_, numBytes);
+        bytes += numBytes;
+        position_ += numBytes;
+        size -= numBytes;
+      }
+      return value;
+    }
+
+   private:
+    const std::vector<ByteRange>& ranges_;
+    size_t rangeIndex_{0};
+    int32_t position_{0};
+  };
+
+ private:
+  StreamArena* const arena_;
+  std::vector<ByteRange> ranges_;
+  int64_t size_{0};
+};
+
+// Writes values of 'bitWidth' bits packed into 64 bit words.
+class BitPacker {
+ public:
+  BitPacker(OutputStream* out, uint8_t bitWidth)
+      : out_(out), bitWidth_(bitWidth) {}
+
+  void add(uint64_t value) {
+    if (bitWidth_ == 0) {
+      return;
+    }
+    word_ |= value << numBits_;
+    numBits_ += bitWidth_;
+    if (numBits_ >= 64) {
+      write(out_, word_);
+      numBits_ -= 64;
+      word_ = numBits_ == 0 ? 0 : value >> (bitWidth_ - numBits_);
+    }
+  }
+
+  void finish() {
+    if (numBits_ > 0) {
+      write(out_, word_);
+    }
+  }
+
+ private:
+  OutputStream* const out_;
+  const uint8_t bitWidth_;
+  uint64_t word_{0};
+  int32_t numBits_{0};
+};
+
+// Returns the 'index'th value of 'bitWidth' bits from the words at 'data'.
+uint64_t unpack(const char* data, uint8_t bitWidth, int64_t index) {
+  if (bitWidth == 0) {
+    return 0;
+  }
+  auto loadWord = [&](int64_t wordIndex) {
+    uint64_t word;
+    memcpy(&word, data + wordIndex * sizeof(uint64_t), sizeof(uint64_t));
+    return word;
+  };
+  const int64_t bit = index * bitWidth;
+  const int32_t shift = bit % 64;
+  uint64_t value = loadWord(bit / 64) >> shift;
+  if (shift + bitWidth > 64) {
+    value |= loadWord(bit / 64 + 1) << (64 - shift);
+  }
+  return bitWidth == 64 ? value : value & ((1ULL << bitWidth) - 1);
+}
+
+// One bit per row, set for rows that are not null as in Velox nulls.
+class NullsWriter {
+ public:
+  explicit NullsWriter(StreamArena* arena) : words_(arena) {}
+
+  void append(bool isNull) {
+    if (isNull) {
+      hasNulls_ = true;
+    } else {
+      word_ |= 1ULL << (numRows_ % 64);
+    }
+    if (++numRows_ % 64 == 0) {
+      words_.appendOne(word_);
+      word_ = 0;
+    }
+  }
+
+  int64_t size() const {
+    return words_.size() + sizeof(uint64_t);
+  }
+
+  void flush(OutputStream* out) const {
+    write<uint8_t>(out, hasNulls_);
+    if (!hasNulls_) {
+      return;
+    }
+    words_.flush(out);
+    if (numRows_ % 64 != 0) {
+      write(out, word_);
+    }
+  }
+
+ private:
+  ArenaBuffer words_;
+  uint64_t word_{0};
+  int64_t numRows_{0};
+  bool hasNulls_{false};
+};
+
+// Appends strings in prefix encoding.
+class PrefixEncoder {
+ public:
+  explicit PrefixEncoder(StreamArena* arena) : bytes_(arena) {}
+
+  void add(std::string_view value) {
+    const auto maxPrefixSize = std::min(value.size(), previous_.size());
+    size_t prefixSize = 0;
+    while (prefixSize < maxPrefixSize &&
+           value[prefixSize] == previous_[prefixSize]) {
+      ++prefixSize;
+    }
+    bytes_.appendVarint(prefixSize);
+    bytes_.appendVarint(value.size() - prefixSize);
+    bytes_.append(value.data() + prefixSize, value.size() - prefixSize);
+    previous_.assign(value);
+    totalSize_ += value.size();
+  }
+
+  int64_t size() const {
+    return bytes_.size() + 2 * sizeof(int64_t);
+  }
+
+  void flush(OutputStream* out) const {
+    write<int64_t>(out, totalSize_);
+    write<int64_t>(out, bytes_.size());
+    bytes_.flush(out);
+  }
+
+ private:
+  ArenaBuffer bytes_;
+  std::string previous_;
+  // Total size of the added values.
+  int64_t totalSize_{0};
+};
+
+class ColumnWriter {
+ public:
+  virtual ~ColumnWriter() = default;
+
+  virtual void append(
+      const VectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges) = 0;
+
+  // Upper bound of the bytes written by flush().
+  virtual int64_t maxSerializedSize() const = 0;
+
+  virtual void flush(OutputStream* out) = 0;
+
+  static std::unique_ptr<ColumnWriter>
+  create(const TypePtr& type, int32_t numRows, StreamArena* arena);
+};
+
+template <typename T>
+class FrameOfReferenceWriter : public ColumnWriter {
+ public:
+  explicit FrameOfReferenceWriter(StreamArena* arena)
+      : nulls_(arena), values_(arena) {}
+
+  void append(
+      const VectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges) override {
+    decoded_.decode(*vector);
+    for (const auto& range : ranges) {
+      for (auto row = range.begin; row < range.begin + range.size; ++row) {
+        const bool isNull = decoded_.isNullAt(row);
+        nulls_.append(isNull);
+        if (isNull) {
+          continue;
+        }
+        const T value = decoded_.valueAt<T>(row);
+        values_.appendOne(value);
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+        ++numValues_;
+      }
+    }
+  }
+
+  int64_t maxSerializedSize() const override {
+    return sizeof(Encoding) + nulls_.size() + sizeof(int64_t) +
+        sizeof(uint8_t) + numValues_ * sizeof(T);
+  }
+
+  void flush(OutputStream* out) override {
+    write(out, Encoding::kFrameOfReference);
+    nulls_.flush(out);
+    const int64_t min = numValues_ == 0 ? 0 : min_;
+    const uint8_t bitWidth = numValues_ == 0
+        ? 0
+        : bitWidthOf(static_cast<uint64_t>(max_) - static_cast<uint64_t>(min));
+    write(out, min);
+    write(out, bitWidth);
+    BitPacker packer(out, bitWidth);
+    ArenaBuffer::Reader reader(values_);
+    for (auto i = 0; i < numValues_; ++i) {
+      const int64_t value = reader.next<T>();
+      packer.add(static_cast<uint64_t>(value) - static_cast<uint64_t>(min));
+    }
+    packer.finish();
+  }
+
+ private:
+  DecodedVector decoded_;
+  NullsWriter nulls_;
+  // The non-null values.
+  ArenaBuffer values_;
+  int64_t numValues_{0};
+  T min_{std::numeric_limits<T>::max()};
+  T max_{std::numeric_limits<T>::min()};
+};
+
+class StringWriter : public ColumnWriter {
+ public:
+  explicit StringWriter(StreamArena* arena)
+      : arena_(arena), nulls_(arena), values_(arena), indices_(arena) {}
+
+  void append(
+      const VectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges) override {
+    decoded_.decode(*vector);
+    for (const auto& range : ranges) {
+      for (auto row = range.begin; row < range.begin + range.size; ++row) {
+        const bool isNull = decoded_.isNullAt(row);
+        nulls_.append(isNull);
+        if (isNull) {
+          continue;
+        }
+        const auto value = decoded_.valueAt<StringView>(row);
+        const std::string_view view(value.data(), value.size());
+        values_.add(view);
+        ++numValues_;
+        if (useDictionary_) {
+          addToDictionary(view);
+        }
+      }
+    }
+  }
+
+  int64_t maxSerializedSize() const override {
+    return sizeof(Encoding) + nulls_.size() + values_.size();
+  }
+
+  void flush(OutputStream* out) override {
+    const auto indexBitWidth = bitWidthOf(
+        distinctValues_.empty() ? 0 : distinctValues_.size() - 1);
+    // The distinct values take about their size in prefix encoding.
+    const int64_t dictionarySize = distinctBytes_ +
+        2 * distinctValues_.size() +
+        numPackedWords(numValues_, indexBitWidth) * sizeof(uint64_t);
+    if (!useDictionary_ || numValues_ == 0 ||
+        dictionarySize >= values_.size()) {
+      write(out, Encoding::kPrefix);
+      nulls_.flush(out);
+      values_.flush(out);
+      return;
+    }
+    write(out, Encoding::kDictionary);
+    nulls_.flush(out);
+    write<int32_t>(out, distinctValues_.size());
+    PrefixEncoder distinctValues(arena_);
+    for (const auto* value : distinctValues_) {
+      distinctValues.add(*value);
+    }
+    distinctValues.flush(out);
+    write(out, indexBitWidth);
+    BitPacker packer(out, indexBitWidth);
+    ArenaBuffer::Reader reader(indices_);
+    for (auto i = 0; i < numValues_; ++i) {
+      packer.add(reader.next<int32_t>());
+    }
+    packer.finish();
+  }
+
+ private:
+  void addToDictionary(std::string_view value) {
+    auto it = distinctIndices_.find(value);
+    if (it == distinctIndices_.end()) {
+      if (distinctValues_.size() >= kMaxDictionarySize ||
+          distinctBytes_ + value.size() > kMaxDictionaryBytes) {
+        useDictionary_ = false;
+        distinctIndices_.clear();
+        distinctValues_.clear();
+        return;
+      }
+      it = distinctIndices_.emplace(value, distinctValues_.size()).first;
+      distinctValues_.push_back(&it->first);
+      distinctBytes_ += value.size();
+    }
+    indices_.appendOne<int32_t>(it->second);
+  }
+
+  StreamArena* const arena_;
+  DecodedVector decoded_;
+  NullsWriter nulls_;
+  // The non-null values in prefix encoding.
+  PrefixEncoder values_;
+  int64_t numValues_{0};
+
+  // False once there are too many distinct values for dictionary encoding.
+  bool useDictionary_{true};
+  // Index of each distinct value in 'distinctValues_'.
+  folly::F14NodeMap<std::string, int32_t> distinctIndices_;
+  // The keys of 'distinctIndices_' in the order of first appearance.
+  std::vector<const std::string*> distinctValues_;
+  int64_t distinctBytes_{0};
+  // Index of the distinct value of each non-null value.
+  ArenaBuffer indices_;
+};
+
+class PrestoWriter : public ColumnWriter {
+ public:
+  PrestoWriter(const TypePtr& type, int32_t numRows, StreamArena* arena)
+      : pool_(arena->pool()),
+        type_(ROW({type})),
+        serializer_(prestoSerde().createSerializer(
+            type_,
+            numRows,
+            arena,
+            &prestoOptions())) {}
+
+  void append(
+      const VectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges) override {
+    serializer_->append(
+        std::make_shared<RowVector>(
+            vector->pool(),
+            type_,
+            nullptr,
+            vector->size(),
+            std::vector<VectorPtr>{vector}),
+        ranges);
+  }
+
+  int64_t maxSerializedSize() const override {
+    return sizeof(Encoding) + sizeof(int32_t) +
+        serializer_->maxSerializedSize();
+  }
+
+  void flush(OutputStream* out) override {
+    IOBufOutputStream page(*pool_, nullptr, serializer_->maxSerializedSize());
+    serializer_->flush(&page);
+    auto iobuf = page.getIOBuf();
+    write(out, Encoding::kPresto);
+    write<int32_t>(out, iobuf->computeChainDataLength());
+    for (const auto& range : *iobuf) {
+      out->write(reinterpret_cast<const char*>(range.data()), range.size());
+    }
+  }
+
+ private:
+  memory::MemoryPool* const pool_;
+  const RowTypePtr type_;
+  const std::unique_ptr<VectorSerializer> serializer_;
+};
+
+// static
+std::unique_ptr<ColumnWriter>
+ColumnWriter::create(const TypePtr& type, int32_t numRows, StreamArena* arena) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+      return std::make_unique<FrameOfReferenceWriter<int8_t>>(arena);
+    case TypeKind::SMALLINT:
+      return std::make_unique<FrameOfReferenceWriter<int16_t>>(arena);
+    case TypeKind::INTEGER:
+      return std::make_unique<FrameOfReferenceWriter<int32_t>>(arena);
+    case TypeKind::BIGINT:
+      return std::make_unique<FrameOfReferenceWriter<int64_t>>(arena);
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return std::make_unique<StringWriter>(arena);
+    default:
+      return std::make_unique<PrestoWriter>(type, numRows, arena);
+  }
+}
+
+// The layout of a batch is numRows(4) | codec marker(1) |
+// uncompressedSize(4) | size(4) | columns. Each column starts with its
+// Encoding.
+class SpillVectorSerializer : public VectorSerializer {
+ public:
+  SpillVectorSerializer(
+      const RowTypePtr& type,
+      int32_t numRows,
+      StreamArena* streamArena,
+      common::CompressionKind compressionKind)
+      : pool_(streamArena->pool()),
+        codec_(common::compressionKindToCodec(compressionKind)) {
+    columns_.reserve(type->size());
+    for (const auto& childType : type->children()) {
+      columns_.push_back(ColumnWriter::create(childType, numRows, streamArena));
+    }
+  }
+
+  void append(
+      const RowVectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges) override {
+    for (auto i = 0; i < columns_.size(); ++i) {
+      columns_[i]->append(vector->childAt(i), ranges);
+    }
+    for (const auto& range : ranges) {
+      numRows_ += range.size;
+    }
+  }
+
+  size_t maxSerializedSize() const override {
+    constexpr int32_t kHeaderSize = 3 * sizeof(int32_t) + sizeof(int8_t);
+    int64_t size = 0;
+    for (const auto& column : columns_) {
+      size += column->maxSerializedSize();
+    }
+    return kHeaderSize +
+        std::max<int64_t>(size, codec_->maxCompressedLength(size));
+  }
+
+  void flush(OutputStream* stream) override {
+    IOBufOutputStream out(*pool_, nullptr, 64 << 10);
+    for (auto& column : columns_) {
+      column->flush(&out);
+    }
+    const int32_t uncompressedSize = out.tellp();
+    auto data = out.getIOBuf();
+    std::unique_ptr<folly::IOBuf> compressed;
+    if (codec_->type() != folly::io::CodecType::NO_COMPRESSION) {
+      compressed = codec_->compress(data.get());
+      if (compressed->computeChainDataLength() >= uncompressedSize) {
+        compressed.reset();
+      }
+    }
+    const auto& payload = compressed ? compressed : data;
+    write<int32_t>(stream, numRows_);
+    write<int8_t>(stream, compressed ? kCompressedBitMask : 0);
+    write<int32_t>(stream, uncompressedSize);
+    write<int32_t>(stream, payload->computeChainDataLength());
+    for (const auto& range : *payload) {
+      stream->write(reinterpret_cast<const char*>(range.data()), range.size());
+    }
+  }
+
+ private:
+  memory::MemoryPool* const pool_;
+  const std::unique_ptr<folly::io::Codec> codec_;
+  std::vector<std::unique_ptr<ColumnWriter>> columns_;
+  int32_t numRows_{0};
+};
+
+// Reads the parts of the columns of a batch from contiguous memory.
+class ColumnReader {
+ public:
+  ColumnReader(const char* data, int64_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  T read() {
+    T value;
+    memcpy(&value, readBytes(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  const char* readBytes(int64_t size) {
+    VELOX_CHECK_LE(position_ + size, size_, "Reading past end of spill batch");
+    const auto* bytes = data_ + position_;
+    position_ += size;
+    return bytes;
+  }
+
+  uint64_t readVarint() {
+    uint64_t value = 0;
+    for (int32_t shift = 0;; shift += 7) {
+      const auto byte = read<uint8_t>();
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+  }
+
+  bool atEnd() const {
+    return position_ == size_;
+  }
+
+ private:
+  const char* const data_;
+  const int64_t size_;
+  int64_t position_{0};
+};
+
+BufferPtr readNulls(
+    ColumnReader& reader,
+    vector_size_t numRows,
+    memory::MemoryPool* pool) {
+  if (reader.read<uint8_t>() == 0) {
+    return nullptr;
+  }
+  auto nulls = AlignedBuffer::allocate<bool>(numRows, pool);
+  memcpy(
+      nulls->asMutable<char>(),
+      reader.readBytes(bits::nwords(numRows) * sizeof(uint64_t)),
+      bits::nbytes(numRows));
+  return nulls;
+}
+
+vector_size_t numNonNulls(const BufferPtr& nulls, vector_size_t numRows) {
+  return nulls ? numRows - BaseVector::countNulls(nulls, numRows) : numRows;
+}
+
+template <typename T>
+VectorPtr readFrameOfReference(
+    ColumnReader& reader,
+    const TypePtr& type,
+    vector_size_t numRows,
+    memory::MemoryPool* pool) {
+  auto nulls = readNulls(reader, numRows, pool);
+  const auto* rawNulls = nulls ? nulls->as<uint64_t>() : nullptr;
+  const auto min = static_cast<uint64_t>(reader.read<int64_t>());
+  const auto bitWidth = reader.read<uint8_t>();
+  const auto* packed = reader.readBytes(
+      numPackedWords(numNonNulls(nulls, numRows), bitWidth) *
+      sizeof(uint64_t));
+  auto values = AlignedBuffer::allocate<T>(numRows, pool);
+  auto* rawValues = values->asMutable<T>();
+  int64_t index = 0;
+  for (auto row = 0; row < numRows; ++row) {
+    if (rawNulls && bits::isBitNull(rawNulls, row)) {
+      rawValues[row] = T();
+      continue;
+    }
+    rawValues[row] = static_cast<T>(min + unpack(packed, bitWidth, index++));
+  }
+  return std::make_shared<FlatVector<T>>(
+      pool, type, nulls, numRows, values, std::vector<BufferPtr>{});
+}
+
+// Reads 'numValues' strings in prefix encoding into one string buffer and
+// calls 'func(value)' for each. Returns the string buffer.
+template <typename Func>
+BufferPtr readPrefixEncoded(
+    ColumnReader& reader,
+    int64_t numValues,
+    memory::MemoryPool* pool,
+    Func func) {
+  const auto totalSize = reader.read<int64_t>();
+  const auto numBytes = reader.read<int64_t>();
+  ColumnReader bytes(reader.readBytes(numBytes), numBytes);
+  auto buffer = AlignedBuffer::allocate<char>(totalSize, pool);
+  auto* rawBuffer = buffer->asMutable<char>();
+  const char* previous = nullptr;
+  int64_t offset = 0;
+  for (auto i = 0; i < numValues; ++i) {
+    const auto prefixSize = bytes.readVarint();
+    const auto suffixSize = bytes.readVarint();
+    VELOX_CHECK_LE(offset + prefixSize + suffixSize, totalSize);
+    auto* value = rawBuffer + offset;
+    // The previous value ends at 'value', so the copy does not overlap.
+    if (prefixSize > 0) {
+      memcpy(value, previous, prefixSize);
+    }
+    memcpy(value + prefixSize, bytes.readBytes(suffixSize), suffixSize);
+    func(StringView(value, prefixSize + suffixSize));
+    previous = value;
+    offset += prefixSize + suffixSize;
+  }
+  VELOX_CHECK(bytes.atEnd());
+  return buffer;
+}
+
+VectorPtr readPrefix(
+    ColumnReader& reader,
+    const TypePtr& type,
+    vector_size_t numRows,
+    memory::MemoryPool* pool) {
+  auto nulls = readNulls(reader, numRows, pool);
+  const auto* rawNulls = nulls ? nulls->as<uint64_t>() : nullptr;
+  auto values = AlignedBuffer::allocate<StringView>(numRows, pool);
+  auto* rawValues = values->asMutable<StringView>();
+  vector_size_t row = 0;
+  auto stringBuffer = readPrefixEncoded(
+      reader, numNonNulls(nulls, numRows), pool, [&](StringView value) {
+        while (rawNulls && bits::isBitNull(rawNulls, row)) {
+          rawValues[row++] = StringView();
+        }
+        rawValues[row++] = value;
+      });
+  for (; row < numRows; ++row) {
+    rawValues[row] = StringView();
+  }
+  return std::make_shared<FlatVector<StringView>>(
+      pool,
+      type,
+      nulls,
+      numRows,
+      values,
+      std::vector<BufferPtr>{std::move(stringBuffer)});
+}
+
+VectorPtr readDictionary(
+    ColumnReader& reader,
+    const TypePtr& type,
+    vector_size_t numRows,
+    memory::MemoryPool* pool) {
+  auto nulls = readNulls(reader, numRows, pool);
+  const auto* rawNulls = nulls ? nulls->as<uint64_t>() : nullptr;
+  const auto numDistinct = reader.read<int32_t>();
+  auto distinctValues = AlignedBuffer::allocate<StringView>(numDistinct, pool);
+  auto* rawDistinctValues = distinctValues->asMutable<StringView>();
+  int32_t numRead = 0;
+  auto stringBuffer =
+      readPrefixEncoded(reader, numDistinct, pool, [&](StringView value) {
+        rawDistinctValues[numRead++] = value;
+      });
+  const auto bitWidth = reader.read<uint8_t>();
+  const auto* packed = reader.readBytes(
+      numPackedWords(numNonNulls(nulls, numRows), bitWidth) *
+      sizeof(uint64_t));
+  auto indices = allocateIndices(numRows, pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  int64_t index = 0;
+  for (auto row = 0; row < numRows; ++row) {
+    rawIndices[row] = rawNulls && bits::isBitNull(rawNulls, row)
+        ? 0
+        : unpack(packed, bitWidth, index++);
+  }
+  auto base = std::make_shared<FlatVector<StringView>>(
+      pool,
+      type,
+      nullptr,
+      numDistinct,
+      distinctValues,
+      std::vector<BufferPtr>{std::move(stringBuffer)});
+  return BaseVector::wrapInDictionary(nulls, indices, numRows, base);
+}
+
+VectorPtr readPresto(
+    ColumnReader& reader,
+    const TypePtr& type,
+    memory::MemoryPool* pool) {
+  const auto size = reader.read<int32_t>();
+  auto* data = const_cast<char*>(reader.readBytes(size));
+  ByteStream page;
+  page.resetInput({ByteRange{reinterpret_cast<uint8_t*>(data), size, 0}});
+  RowVectorPtr row;
+  prestoSerde().deserialize(&page, pool, ROW({type}), &row, &prestoOptions());
+  return row->childAt(0);
+}
+
+VectorPtr readColumn(
+    ColumnReader& reader,
+    const TypePtr& type,
+    vector_size_t numRows,
+    memory::MemoryPool* pool) {
+  const auto encoding = reader.read<Encoding>();
+  switch (encoding) {
+    case Encoding::kPresto:
+      return readPresto(reader, type, pool);
+    case Encoding::kFrameOfReference:
+      switch (type->kind()) {
+        case TypeKind::TINYINT:
+          return readFrameOfReference<int8_t>(reader, type, numRows, pool);
+        case TypeKind::SMALLINT:
+          return readFrameOfReference<int16_t>(reader, type, numRows, pool);
+        case TypeKind::INTEGER:
+          return readFrameOfReference<int32_t>(reader, type, numRows, pool);
+        case TypeKind::BIGINT:
+          return readFrameOfReference<int64_t>(reader, type, numRows, pool);
+        default:
+          VELOX_FAIL(
+              "Unexpected type for frame of reference encoding: {}",
+              type->toString());
+      }
+    case Encoding::kPrefix:
+      return readPrefix(reader, type, numRows, pool);
+    case Encoding::kDictionary:
+      return readDictionary(reader, type, numRows, pool);
+  }
+  VELOX_FAIL("Unknown spill column encoding: {}", static_cast<int>(encoding));
+}
+
+} // namespace
+
+void SpillVectorSerde::estimateSerializedSize(
+    VectorPtr vector,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t** sizes) {
+  // The encodings are at most as large as the Presto format.
+  prestoSerde().estimateSerializedSize(std::move(vector), ranges, sizes);
+}
+
+std::unique_ptr<VectorSerializer> SpillVectorSerde::createSerializer(
+    RowTypePtr type,
+    int32_t numRows,
+    StreamArena* streamArena,
+    const Options* options) {
+  const auto compressionKind = options != nullptr
+      ? static_cast<const SpillOptions*>(options)->compressionKind
+      : common::CompressionKind_NONE;
+  return std::make_unique<SpillVectorSerializer>(
+      type, numRows, streamArena, compressionKind);
+}
+
+void SpillVectorSerde::deserialize(
+    ByteStream* source,
+    velox::memory::MemoryPool* pool,
+    RowTypePtr type,
+    RowVectorPtr* result,
+    const Options* options) {
+  const auto numRows = source->read<int32_t>();
+  const auto codecMarker = source->read<int8_t>();
+  const auto uncompressedSize = source->read<int32_t>();
+  const auto size = source->read<int32_t>();
+
+  auto buffer = folly::IOBuf::create(size);
+  source->readBytes(buffer->writableData(), size);
+  buffer->append(size);
+  if (codecMarker & kCompressedBitMask) {
+    VELOX_CHECK_NOT_NULL(options, "Compressed spill batch needs a codec");
+    auto codec = common::compressionKindToCodec(
+        static_cast<const SpillOptions*>(options)->compressionKind);
+    buffer = codec->uncompress(buffer.get(), uncompressedSize);
+  }
+  const auto data = buffer->coalesce();
+  VELOX_CHECK_EQ(data.size(), uncompressedSize);
+
+  ColumnReader reader(reinterpret_cast<const char*>(data.data()), data.size());
+  std::vector<VectorPtr> children;
+  children.reserve(type->size());
+  for (const auto& childType : type->children()) {
+    children.push_back(readColumn(reader, childType, numRows, pool));
+  }
+  VELOX_CHECK(reader.atEnd());
+  *result = std::make_shared<RowVector>(
+      pool, type, nullptr, numRows, std::move(children));
+}
+
+} // namespace facebook::velox::serializer
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/common/compression/Compression.h"
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::serializer {
+
+/// Serde for spill files. The data is only read back by the process that
+/// wrote it, so the format is not a wire format and may change between
+/// versions. Each batch is stored column by column with lightweight
+/// encodings that fit the sorted runs and repeated keys of spilled data:
+///
+/// - TINYINT, SMALLINT, INTEGER and BIGINT columns are frame-of-reference
+///   encoded, i.e. the minimum followed by the differences to it bit packed
+///   to the width of the largest difference.
+/// - VARCHAR and VARBINARY columns are prefix compressed, i.e. each value is
+///   stored as the length of the prefix it shares with the previous value and
+///   the rest, or dictionary encoded if that is smaller. Dictionary encoded
+///   columns are read back as DictionaryVectors.
+/// - The other columns are stored in the Presto wire format with lossless
+///   timestamps.
+///
+/// Null rows take no space besides one bit per row in columns that have
+/// nulls.
+class SpillVectorSerde : public VectorSerde {
+ public:
+  struct SpillOptions : VectorSerde::Options {
+    SpillOptions() = default;
+
+    explicit SpillOptions(common::CompressionKind _compressionKind)
+        : compressionKind(_compressionKind) {}
+
+    /// Codec for the serialized batches. A batch that does not get smaller
+    /// with compression is written uncompressed.
+    common::CompressionKind compressionKind{
+        common::CompressionKind::CompressionKind_NONE};
+  };
+
+  void estimateSerializedSize(
+      VectorPtr vector,
+      const folly::Range<const IndexRange*>& ranges,
+      vector_size_t** sizes) override;
+
+  std::unique_ptr<VectorSerializer> createSerializer(
+      RowTypePtr type,
+      int32_t numRows,
+      StreamArena* streamArena,
+      const Options* options) override;
+
+  void deserialize(
+      ByteStream* source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      const Options* options) override;
+};
+
+} // namespace facebook::velox::serializer
@@ -15,16 +15,35 @@
  */
 #include "velox/serializers/UnsafeRowSerializer.h"
 #include <folly/lang/Bits.h>
-#include "velox/row/UnsafeRowDeserializers.h"
 #include "velox/row/UnsafeRowFast.h"
 
 namespace facebook::velox::serializer::spark {
 
+// PartitionedOutput estimates the row sizes one column at a time. The column is
+// serialized as a single column row to get its share of the row size.
 void UnsafeRowVectorSerde::estimateSerializedSize(
-    VectorPtr /* vector */,
-    const folly::Range<const IndexRange*>& /* ranges */,
-    vector_size_t** /* sizes */) {
-  VELOX_UNSUPPORTED();
+    VectorPtr vector,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t** sizes) {
+  auto rowVector = std::make_shared<RowVector>(
+      vector->pool(),
+      ROW({vector->type()}),
+      nullptr,
+      vector->size(),
+      std::vector<VectorPtr>{vector});
+  if (auto fixedRowSize =
+          row::UnsafeRowFast::fixedRowSize(asRowType(rowVector->type()))) {
+    for (auto i = 0; i < ranges.size(); ++i) {
+      *sizes[i] += fixedRowSize.value() * ranges[i].size;
+    }
+    return;
+  }
+  row::UnsafeRowFast row(rowVector);
+  for (auto i = 0; i < ranges.size(); ++i) {
+    for (auto j = ranges[i].begin; j < ranges[i].begin + ranges[i].size; ++j) {
+      *sizes[i] += row.rowSize(j);
+    }
+  }
 }
 
 namespace {
@@ -111,7 +130,7 @@ void UnsafeRowVectorSerde::deserialize(
     RowTypePtr type,
     RowVectorPtr* result,
     const Options* /* options */) {
-  std::vector<std::optional<std::string_view>> serializedRows;
+  std::vector<std::string_view> serializedRows;
   while (!source->atEnd()) {
     // First read row size in big endian order.
     auto rowSize =
@@ -126,9 +145,7 @@ void UnsafeRowVectorSerde::deserialize(
     return;
   }
 
-  *result = std::dynamic_pointer_cast<RowVector>(
-      velox::row::UnsafeRowDeserializer::deserialize(
-          serializedRows, type, pool));
+  *result = velox::row::UnsafeRowFast::deserialize(serializedRows, type, pool);
 }
 
 // static
@@ -22,7 +22,8 @@ namespace facebook::velox::serializer::spark {
 class UnsafeRowVectorSerde : public VectorSerde {
  public:
   UnsafeRowVectorSerde() = default;
-  // We do not implement this method since it is not used in production code.
+  // Adds the serialized size of the rows of 'vector' in each of 'ranges' to
+  // the corresponding 'sizes'. 'vector' is one column of the serialized rows.
   void estimateSerializedSize(
       VectorPtr vector,
       const folly::Range<const IndexRange*>& ranges,
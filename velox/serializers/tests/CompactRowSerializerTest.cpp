@@ -15,6 +15,7 @@
  */
 #include "velox/serializers/CompactRowSerializer.h"
 #include <gtest/gtest.h>
+#include "velox/row/CompactRow.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
@@ -123,5 +124,28 @@ TEST_F(CompactRowSerializerTest, fuzz) {
   testRoundTrip(data);
 }
 
+TEST_F(CompactRowSerializerTest, estimateSerializedSize) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3}),
+      makeFlatVector<std::string>({"a", std::string(100, 'b'), ""}),
+  });
+  std::vector<IndexRange> ranges = {{0, 1}, {1, 1}, {2, 1}};
+  std::vector<vector_size_t> sizes(3, 0);
+  std::vector<vector_size_t*> sizePointers = {
+      &sizes[0], &sizes[1], &sizes[2]};
+  for (const auto& child : data->children()) {
+    serde_->estimateSerializedSize(
+        child, folly::Range(ranges.data(), ranges.size()), sizePointers.data());
+  }
+
+  // The estimate is the row size without the size prefix, plus one byte of
+  // null flags for each column.
+  row::CompactRow row(data);
+  for (auto i = 0; i < data->size(); ++i) {
+    EXPECT_EQ(row.rowSize(i) + 1, sizes[i]);
+  }
+  EXPECT_LT(sizes[0] + 90, sizes[1]);
+}
+
 } // namespace
 } // namespace facebook::velox::serializer
@@ -66,6 +66,11 @@ class PrestoSerializerTest
     common::CompressionKind kind = GetParam();
     serializer::presto::PrestoVectorSerde::PrestoOptions paramOptions{
         useLosslessTimestamp, kind};
+    if (serdeOptions != nullptr) {
+      paramOptions.preserveEncodings = serdeOptions->preserveEncodings;
+      paramOptions.minCompressionRatio = serdeOptions->minCompressionRatio;
+      paramOptions.compressionStats = serdeOptions->compressionStats;
+    }
     return paramOptions;
   }
 
@@ -332,6 +337,34 @@ TEST_P(PrestoSerializerTest, multiPage) {
   }
 }
 
+TEST_P(PrestoSerializerTest, zeroCopyInput) {
+  auto input = makeTestVector(1'000);
+  std::ostringstream out;
+  serialize(input, &out, nullptr);
+
+  auto bytes = std::make_shared<std::string>(out.str());
+  std::weak_ptr<std::string> weakBytes = bytes;
+  auto byteStream = toByteStream(*bytes);
+  byteStream->setInputOwner(std::move(bytes));
+
+  RowVectorPtr result;
+  auto paramOptions = getParamSerdeOptions(nullptr);
+  serde_->deserialize(
+      byteStream.get(),
+      pool_.get(),
+      asRowType(input->type()),
+      &result,
+      &paramOptions);
+  // The vectors may reference the serialized bytes, which must stay alive
+  // after the stream is gone.
+  byteStream.reset();
+  assertEqualVectors(input, result);
+  result->validate({});
+
+  result.reset();
+  EXPECT_TRUE(weakBytes.expired());
+}
+
 TEST_P(PrestoSerializerTest, timestampWithNanosecondPrecision) {
   // Verify that nanosecond precision is preserved when the right options are
   // passed to the serde.
@@ -404,6 +437,127 @@ TEST_P(PrestoSerializerTest, encodings) {
   testEncodedRoundTrip(data);
 }
 
+TEST_P(PrestoSerializerTest, preserveEncodings) {
+  const vector_size_t size = 1'000;
+  auto strings = vectorMaker_->flatVector<std::string>(
+      {"apple", "banana banana banana banana", "cherry"});
+  auto numbers = vectorMaker_->flatVector<int64_t>(
+      size, [](vector_size_t row) { return row * 3; });
+  auto makeIndices = [&](std::function<vector_size_t(vector_size_t)> func) {
+    auto indices = allocateIndices(size, pool_.get());
+    auto rawIndices = indices->asMutable<vector_size_t>();
+    for (auto i = 0; i < size; ++i) {
+      rawIndices[i] = func(i);
+    }
+    return indices;
+  };
+  auto makeInput = [&](int32_t seed) {
+    auto nulls =
+        AlignedBuffer::allocate<bool>(size, pool_.get(), bits::kNotNull);
+    for (auto i = seed; i < size; i += 11) {
+      bits::setNull(nulls->asMutable<uint64_t>(), i);
+    }
+    return vectorMaker_->rowVector({
+        // Few distinct values.
+        BaseVector::wrapInDictionary(
+            nullptr,
+            makeIndices([&](auto row) { return (row + seed) % 3; }),
+            size,
+            strings),
+        BaseVector::createConstant(BIGINT(), (int64_t)7, size, pool_.get()),
+        // All values distinct.
+        BaseVector::wrapInDictionary(
+            nullptr,
+            makeIndices([&](auto row) { return size - 1 - row; }),
+            size,
+            numbers),
+        // Nulls added by the dictionary.
+        BaseVector::wrapInDictionary(
+            nulls,
+            makeIndices([&](auto row) { return (row * seed) % 3; }),
+            size,
+            strings),
+    });
+  };
+
+  // Appends all of one vector and parts of another with different
+  // dictionaries to one page.
+  auto first = makeInput(1);
+  auto second = makeInput(2);
+  std::vector<IndexRange> ranges{{100, 200}, {700, 50}};
+  auto rowType = asRowType(first->type());
+  serializer::presto::PrestoVectorSerde::PrestoOptions options;
+  options.preserveEncodings = true;
+  auto paramOptions = getParamSerdeOptions(&options);
+  StreamArena arena(pool_.get());
+  auto serializer =
+      serde_->createSerializer(rowType, size, &arena, &paramOptions);
+  serializer->append(first);
+  serializer->append(second, folly::Range(ranges.data(), ranges.size()));
+
+  std::ostringstream out;
+  facebook::velox::serializer::presto::PrestoOutputStreamListener listener;
+  OStreamOutputStream output(&out, &listener);
+  serializer->flush(&output);
+  auto deserialized = deserialize(rowType, out.str(), &paramOptions);
+
+  auto expected = BaseVector::create(rowType, size + 250, pool_.get());
+  expected->copy(first.get(), 0, 0, size);
+  expected->copy(second.get(), size, 100, 200);
+  expected->copy(second.get(), size + 200, 700, 50);
+  assertEqualVectors(expected, deserialized);
+
+  EXPECT_EQ(
+      deserialized->childAt(0)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  EXPECT_EQ(
+      deserialized->childAt(1)->encoding(), VectorEncoding::Simple::CONSTANT);
+  EXPECT_EQ(deserialized->childAt(2)->encoding(), VectorEncoding::Simple::FLAT);
+  EXPECT_EQ(
+      deserialized->childAt(3)->encoding(), VectorEncoding::Simple::DICTIONARY);
+}
+
+TEST_P(PrestoSerializerTest, adaptiveCompression) {
+  if (GetParam() == common::CompressionKind_NONE) {
+    return;
+  }
+  serializer::presto::PrestoVectorSerde::CompressionStats stats;
+  serializer::presto::PrestoVectorSerde::PrestoOptions options;
+  options.compressionStats = &stats;
+
+  // Repeating values compress well.
+  auto compressible = makeTestVector(10'000);
+  std::ostringstream out;
+  serialize(compressible, &out, &options);
+  EXPECT_EQ(stats.numCompressedPages, 1);
+  EXPECT_LT(stats.compressedBytes, stats.compressionInputBytes);
+  assertEqualVectors(
+      compressible,
+      deserialize(asRowType(compressible->type()), out.str(), nullptr));
+
+  // Random values do not. The first page is sent uncompressed and compression
+  // is not tried on the next one.
+  folly::Random::DefaultGenerator rng(1);
+  auto random = vectorMaker_->rowVector({vectorMaker_->flatVector<int64_t>(
+      10'000, [&](auto /*row*/) { return folly::Random::rand64(rng); })});
+  const auto compressionInputBytes = stats.compressionInputBytes;
+  const auto compressedBytes = stats.compressedBytes;
+  for (auto i = 0; i < 2; ++i) {
+    std::ostringstream randomOut;
+    serialize(random, &randomOut, &options);
+    assertEqualVectors(
+        random,
+        deserialize(asRowType(random->type()), randomOut.str(), nullptr));
+  }
+  EXPECT_EQ(stats.numCompressedPages, 1);
+  EXPECT_EQ(stats.numUncompressedPages, 2);
+  EXPECT_EQ(stats.pagesToSkip, 0);
+  EXPECT_EQ(stats.pagesToSkipOnFailure, 2);
+  // The page that did not compress counts with its uncompressed size.
+  EXPECT_EQ(
+      stats.compressionInputBytes - compressionInputBytes,
+      stats.compressedBytes - compressedBytes);
+}
+
 TEST_P(PrestoSerializerTest, scatterEncoded) {
   // Makes a struct with nulls and constant/dictionary encoded children. The
   // children need to get gaps where the parent struct has a null.
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/SpillSerializer.h"
+#include <gtest/gtest.h>
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::serializer {
+namespace {
+
+class SpillSerializerTest : public ::testing::Test,
+                            public test::VectorTestBase {
+ protected:
+  // Serializes the rows of 'batches' into one batch, the first and second
+  // half of each in separate ranges.
+  std::string serialize(
+      const std::vector<RowVectorPtr>& batches,
+      VectorSerde& serde,
+      const VectorSerde::Options* options) {
+    auto rowType = asRowType(batches[0]->type());
+    StreamArena arena(pool());
+    auto serializer = serde.createSerializer(rowType, 100, &arena, options);
+    for (const auto& batch : batches) {
+      const vector_size_t half = batch->size() / 2;
+      std::vector<IndexRange> ranges{{0, half}, {half, batch->size() - half}};
+      serializer->append(batch, folly::Range(ranges.data(), ranges.size()));
+    }
+    std::ostringstream output;
+    OStreamOutputStream out(&output);
+    const auto maxSize = serializer->maxSerializedSize();
+    serializer->flush(&out);
+    EXPECT_LE(static_cast<size_t>(output.tellp()), maxSize);
+    return output.str();
+  }
+
+  RowVectorPtr deserialize(
+      const RowTypePtr& rowType,
+      const std::string& input,
+      common::CompressionKind compressionKind) {
+    ByteStream byteStream;
+    byteStream.resetInput({ByteRange{
+        reinterpret_cast<uint8_t*>(const_cast<char*>(input.data())),
+        static_cast<int32_t>(input.size()),
+        0}});
+    SpillVectorSerde::SpillOptions options(compressionKind);
+    RowVectorPtr result;
+    serde_.deserialize(&byteStream, pool(), rowType, &result, &options);
+    EXPECT_TRUE(byteStream.atEnd());
+    return result;
+  }
+
+  RowVectorPtr testRoundTrip(
+      const std::vector<RowVectorPtr>& batches,
+      common::CompressionKind compressionKind =
+          common::CompressionKind_NONE) {
+    SpillVectorSerde::SpillOptions options(compressionKind);
+    auto serialized = serialize(batches, serde_, &options);
+    auto rowType = asRowType(batches[0]->type());
+    auto result = deserialize(rowType, serialized, compressionKind);
+
+    auto expected = BaseVector::create<RowVector>(rowType, 0, pool());
+    for (const auto& batch : batches) {
+      const auto offset = expected->size();
+      expected->resize(offset + batch->size());
+      expected->copy(batch.get(), offset, 0, batch->size());
+    }
+    test::assertEqualVectors(expected, result);
+    return result;
+  }
+
+  // Returns the serialized size of 'data' with 'serde_' divided by the size
+  // with PrestoVectorSerde.
+  double sizeRatioToPresto(const RowVectorPtr& data) {
+    SpillVectorSerde::SpillOptions options;
+    presto::PrestoVectorSerde prestoSerde;
+    presto::PrestoVectorSerde::PrestoOptions prestoOptions(
+        true, common::CompressionKind_NONE);
+    return static_cast<double>(serialize({data}, serde_, &options).size()) /
+        serialize({data}, prestoSerde, &prestoOptions).size();
+  }
+
+  SpillVectorSerde serde_;
+};
+
+TEST_F(SpillSerializerTest, fuzz) {
+  auto rowType = ROW({
+      BOOLEAN(),
+      TINYINT(),
+      SMALLINT(),
+      INTEGER(),
+      BIGINT(),
+      REAL(),
+      DOUBLE(),
+      VARCHAR(),
+      VARBINARY(),
+      TIMESTAMP(),
+      DATE(),
+      DECIMAL(10, 2),
+      DECIMAL(20, 5),
+      ROW({VARCHAR(), INTEGER()}),
+      ARRAY(INTEGER()),
+      MAP(VARCHAR(), ARRAY(INTEGER())),
+  });
+
+  VectorFuzzer::Options opts;
+  opts.vectorSize = 100;
+  opts.nullRatio = 0.1;
+  opts.stringVariableLength = true;
+  opts.stringLength = 20;
+
+  auto seed = folly::Random::rand32();
+  LOG(INFO) << "Seed: " << seed;
+  SCOPED_TRACE(fmt::format("seed: {}", seed));
+  VectorFuzzer fuzzer(opts, pool(), seed);
+
+  for (auto compressionKind :
+       {common::CompressionKind_NONE, common::CompressionKind_ZLIB}) {
+    SCOPED_TRACE(common::compressionKindToString(compressionKind));
+    for (auto i = 0; i < 5; ++i) {
+      testRoundTrip(
+          {fuzzer.fuzzInputRow(rowType), fuzzer.fuzzInputRow(rowType)},
+          compressionKind);
+    }
+  }
+}
+
+TEST_F(SpillSerializerTest, allNulls) {
+  auto data = makeRowVector({
+      makeAllNullFlatVector<int64_t>(10),
+      makeAllNullFlatVector<StringView>(10),
+      makeAllNullFlatVector<double>(10),
+  });
+  testRoundTrip({data, data});
+
+  auto empty = makeRowVector({
+      makeFlatVector<int64_t>(std::vector<int64_t>{}),
+      makeFlatVector<std::string>(std::vector<std::string>{}),
+  });
+  testRoundTrip({empty});
+}
+
+TEST_F(SpillSerializerTest, frameOfReference) {
+  const vector_size_t size = 10'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return 1'000'000'000'000 + row % 100; }),
+      makeFlatVector<int32_t>(
+          size, [](auto row) { return -row; }, nullEvery(5)),
+      makeFlatVector<int8_t>(
+          size, [](auto row) { return row % 2 == 0 ? -128 : 127; }),
+      makeFlatVector<int64_t>(size, [](auto row) {
+        return row % 2 == 0 ? std::numeric_limits<int64_t>::min()
+                            : std::numeric_limits<int64_t>::max();
+      }),
+  });
+  testRoundTrip({data});
+
+  // The first column takes 7 bits per value, the second 14.
+  auto ratio = sizeRatioToPresto(makeRowVector({data->childAt(0)}));
+  EXPECT_LT(ratio, 0.15);
+  ratio = sizeRatioToPresto(makeRowVector({data->childAt(1)}));
+  EXPECT_LT(ratio, 0.55);
+}
+
+TEST_F(SpillSerializerTest, prefix) {
+  // Sorted strings with long common prefixes as in a sorted spill run.
+  const vector_size_t size = 10'000;
+  auto data = makeRowVector({makeFlatVector<std::string>(
+      size,
+      [](auto row) {
+        return fmt::format("https://www.example.com/path/{:08}", row);
+      },
+      nullEvery(7))});
+  auto result = testRoundTrip({data});
+  ASSERT_EQ(result->childAt(0)->encoding(), VectorEncoding::Simple::FLAT);
+  EXPECT_LT(sizeRatioToPresto(data), 0.25);
+}
+
+TEST_F(SpillSerializerTest, dictionary) {
+  const vector_size_t size = 10'000;
+  const std::vector<std::string> values = {
+      "UNITED STATES", "UNITED KINGDOM", "GERMANY", "FRANCE", "JAPAN"};
+  auto data = makeRowVector({
+      makeFlatVector<std::string>(
+          size, [&](auto row) { return values[row % values.size()]; }),
+      BaseVector::wrapInDictionary(
+          makeNulls(size, nullEvery(3)),
+          makeIndices(size, [&](auto row) { return row % values.size(); }),
+          size,
+          makeFlatVector<std::string>(values)),
+  });
+  auto result = testRoundTrip({data, data});
+  for (const auto& child : result->children()) {
+    ASSERT_EQ(child->encoding(), VectorEncoding::Simple::DICTIONARY);
+    ASSERT_EQ(child->valueVector()->size(), values.size());
+  }
+  EXPECT_LT(sizeRatioToPresto(data), 0.1);
+
+  // Distinct values are not dictionary encoded.
+  data = makeRowVector({makeFlatVector<std::string>(
+      size, [](auto row) { return fmt::format("{}", row * 7919 % size); })});
+  result = testRoundTrip({data});
+  ASSERT_EQ(result->childAt(0)->encoding(), VectorEncoding::Simple::FLAT);
+}
+
+} // namespace
+} // namespace facebook::velox::serializer
@@ -144,6 +144,62 @@ std::shared_ptr<SubstraitParser::SubstraitType> SubstraitParser::parseType(
   return std::make_shared<SubstraitType>(type);
 }
 
+TypePtr SubstraitParser::parseVeloxType(
+    const ::substrait::Type& substraitType) {
+  switch (substraitType.kind_case()) {
+    case ::substrait::Type::KindCase::kBool:
+      return BOOLEAN();
+    case ::substrait::Type::KindCase::kI8:
+      return TINYINT();
+    case ::substrait::Type::KindCase::kI16:
+      return SMALLINT();
+    case ::substrait::Type::KindCase::kI32:
+      return INTEGER();
+    case ::substrait::Type::KindCase::kI64:
+      return BIGINT();
+    case ::substrait::Type::KindCase::kFp32:
+      return REAL();
+    case ::substrait::Type::KindCase::kFp64:
+      return DOUBLE();
+    case ::substrait::Type::KindCase::kString:
+      return VARCHAR();
+    case ::substrait::Type::KindCase::kBinary:
+      return VARBINARY();
+    case ::substrait::Type::KindCase::kStruct: {
+      const auto& substraitTypes = substraitType.struct_().types();
+      VELOX_CHECK(
+          !substraitTypes.empty(),
+          "Converting empty ROW type from Substrait to Velox is not supported.");
+      std::vector<std::string> names;
+      std::vector<TypePtr> types;
+      names.reserve(substraitTypes.size());
+      types.reserve(substraitTypes.size());
+      for (int i = 0; i < substraitTypes.size(); i++) {
+        names.emplace_back("col_" + std::to_string(i));
+        types.emplace_back(parseVeloxType(substraitTypes[i]));
+      }
+      return ROW(std::move(names), std::move(types));
+    }
+    case ::substrait::Type::KindCase::kList:
+      return ARRAY(parseVeloxType(substraitType.list().type()));
+    case ::substrait::Type::KindCase::kMap:
+      return MAP(
+          parseVeloxType(substraitType.map().key()),
+          parseVeloxType(substraitType.map().value()));
+    case ::substrait::Type::KindCase::kUserDefined:
+      // We only support UNKNOWN type to handle the null literal whose type is
+      // not known.
+      VELOX_CHECK_EQ(substraitType.user_defined().type_reference(), 0);
+      return UNKNOWN();
+    case ::substrait::Type::KindCase::kDate:
+      return DATE();
+    default:
+      VELOX_NYI(
+          "Parsing for Substrait type not supported: {}",
+          substraitType.DebugString());
+  }
+}
+
 std::vector<std::shared_ptr<SubstraitParser::SubstraitType>>
 SubstraitParser::parseNamedStruct(const ::substrait::NamedStruct& namedStruct) {
   // Nte that "names" are not used.
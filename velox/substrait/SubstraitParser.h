@@ -24,6 +24,7 @@
 #include "velox/substrait/proto/substrait/plan.pb.h"
 #include "velox/substrait/proto/substrait/type.pb.h"
 #include "velox/substrait/proto/substrait/type_expressions.pb.h"
+#include "velox/type/Type.h"
 
 namespace facebook::velox::substrait {
 
@@ -45,6 +46,11 @@ class SubstraitParser {
   std::shared_ptr<SubstraitType> parseType(
       const ::substrait::Type& substraitType);
 
+  /// Returns the Velox type of 'substraitType'. Same as
+  /// toVeloxType(parseType(substraitType)->type) but without making and
+  /// parsing the type name.
+  TypePtr parseVeloxType(const ::substrait::Type& substraitType);
+
   /// Parse Substrait ReferenceSegment.
   int32_t parseReferenceSegment(
       const ::substrait::Expression::ReferenceSegment& refSegment);
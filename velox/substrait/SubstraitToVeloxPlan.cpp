@@ -152,8 +152,8 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
       aggParams.emplace_back(
           exprConverter_->toVeloxExpr(arg.value(), inputType));
     }
-    auto aggVeloxType = toVeloxType(
-        substraitParser_->parseType(aggFunction.output_type())->type);
+    auto aggVeloxType =
+        substraitParser_->parseVeloxType(aggFunction.output_type());
     auto aggExpr = std::make_shared<const core::CallTypedExpr>(
         aggVeloxType, std::move(aggParams), funcName);
 
@@ -365,13 +365,43 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
         childNode);
 
   } else {
+    // The scan stops reading early once it has the rows that the limit
+    // needs. The LimitNode stays on top and enforces the limit.
     return std::make_shared<core::LimitNode>(
         nextPlanNodeId(),
         (int32_t)fetchRel.offset(),
         (int32_t)fetchRel.count(),
         false /*isPartial*/,
-        childNode);
+        pushLimitIntoScan(childNode, fetchRel.offset() + fetchRel.count()));
+  }
+}
+
+core::PlanNodePtr SubstraitVeloxPlanConverter::pushLimitIntoScan(
+    const core::PlanNodePtr& node,
+    int64_t limit) {
+  if (limit <= 0) {
+    return node;
+  }
+  if (auto scan = std::dynamic_pointer_cast<const core::TableScanNode>(node)) {
+    if (scan->limit().has_value() && scan->limit().value() <= limit) {
+      return node;
+    }
+    return std::make_shared<core::TableScanNode>(
+        scan->id(),
+        scan->outputType(),
+        scan->tableHandle(),
+        scan->assignments(),
+        limit);
+  }
+  if (auto project = std::dynamic_pointer_cast<const core::ProjectNode>(node)) {
+    auto source = pushLimitIntoScan(project->sources()[0], limit);
+    if (source == project->sources()[0]) {
+      return node;
+    }
+    return std::make_shared<core::ProjectNode>(
+        project->id(), project->names(), project->projections(), source);
   }
+  return node;
 }
 
 core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
@@ -393,10 +423,11 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
     for (const auto& name : baseSchema.names()) {
       colNameList.emplace_back(name);
     }
-    auto substraitTypeList = substraitParser_->parseNamedStruct(baseSchema);
-    veloxTypeList.reserve(substraitTypeList.size());
-    for (const auto& substraitType : substraitTypeList) {
-      veloxTypeList.emplace_back(toVeloxType(substraitType->type));
+    const auto& substraitTypes = baseSchema.struct_().types();
+    veloxTypeList.reserve(substraitTypes.size());
+    for (const auto& substraitType : substraitTypes) {
+      veloxTypeList.emplace_back(
+          substraitParser_->parseVeloxType(substraitType));
     }
   }
 
@@ -604,6 +635,18 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
   VELOX_FAIL("RelRoot or Rel is expected in Plan.");
 }
 
+std::vector<core::PlanNodePtr> SubstraitVeloxPlanConverter::toVeloxPlans(
+    const std::vector<const ::substrait::Plan*>& substraitPlans) {
+  std::vector<core::PlanNodePtr> plans;
+  plans.reserve(substraitPlans.size());
+  for (const auto* substraitPlan : substraitPlans) {
+    // The function anchors are local to each plan.
+    functionMap_.clear();
+    plans.push_back(toVeloxPlan(*substraitPlan));
+  }
+  return plans;
+}
+
 std::string SubstraitVeloxPlanConverter::nextPlanNodeId() {
   auto id = fmt::format("{}", planNodeId_);
   planNodeId_++;
@@ -87,6 +87,12 @@ class SubstraitVeloxPlanConverter {
   /// Convert Substrait Plan into Velox PlanNode.
   core::PlanNodePtr toVeloxPlan(const ::substrait::Plan& substraitPlan);
 
+  /// Converts a batch of Substrait Plans, e.g. the task plans of a stage.
+  /// The plan node IDs are unique across the batch and splitInfos() has the
+  /// splits of all returned plans.
+  std::vector<core::PlanNodePtr> toVeloxPlans(
+      const std::vector<const ::substrait::Plan*>& substraitPlans);
+
   /// Check the Substrait type extension only has one unknown extension.
   bool checkTypeExtension(const ::substrait::Plan& substraitPlan);
 
@@ -156,6 +162,14 @@ class SubstraitVeloxPlanConverter {
           sortField,
       const RowTypePtr& inputType);
 
+  /// Returns 'node' with 'limit' set as the row limit hint of the
+  /// TableScanNode at its bottom if 'node' is a TableScanNode, possibly under
+  /// ProjectNodes. Otherwise returns 'node' as is. The plan node IDs stay the
+  /// same, so the splits in 'splitInfoMap_' still apply.
+  core::PlanNodePtr pushLimitIntoScan(
+      const core::PlanNodePtr& node,
+      int64_t limit);
+
   /// The Expression converter used to convert Substrait representations into
   /// Velox expressions.
   std::shared_ptr<SubstraitVeloxExprConverter> exprConverter_;
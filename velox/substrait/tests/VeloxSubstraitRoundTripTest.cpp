@@ -100,6 +100,25 @@ class VeloxSubstraitRoundTripTest : public OperatorTestBase {
       std::make_shared<SubstraitVeloxPlanConverter>(pool_.get());
 };
 
+TEST_F(VeloxSubstraitRoundTripTest, batch) {
+  auto vectors = makeVectors(3, 4, 2);
+  createDuckDbTable(vectors);
+  std::vector<core::PlanNodePtr> plans = {
+      PlanBuilder().values(vectors).project({"c0 + c1"}).planNode(),
+      PlanBuilder().values(vectors).filter("c0 < c1").planNode()};
+
+  google::protobuf::Arena arena;
+  std::vector<const ::substrait::Plan*> substraitPlans;
+  for (const auto& plan : plans) {
+    substraitPlans.push_back(&veloxConvertor_->toSubstrait(arena, plan));
+  }
+  auto samePlans = substraitConverter_->toVeloxPlans(substraitPlans);
+  ASSERT_EQ(2, samePlans.size());
+  ASSERT_NE(samePlans[0]->id(), samePlans[1]->id());
+  assertQuery(samePlans[0], "SELECT c0 + c1 FROM tmp");
+  assertQuery(samePlans[1], "SELECT * FROM tmp WHERE c0 < c1");
+}
+
 TEST_F(VeloxSubstraitRoundTripTest, project) {
   auto vectors = makeVectors(3, 4, 2);
   createDuckDbTable(vectors);
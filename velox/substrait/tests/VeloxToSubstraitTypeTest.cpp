@@ -37,6 +37,7 @@ class VeloxToSubstraitTypeTest : public ::testing::Test {
     ASSERT_TRUE(sameType->kindEquals(type))
         << "Expected: " << type->toString()
         << ", but got: " << sameType->toString();
+    ASSERT_EQ(*substraitParser_->parseVeloxType(substraitType), *sameType);
   }
 
   std::shared_ptr<VeloxToSubstraitTypeConvertor> typeConvertor_;
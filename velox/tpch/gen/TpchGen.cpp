@@ -17,6 +17,7 @@
 #include "velox/tpch/gen/TpchGen.h"
 #include <velox/tpch/gen/dbgen/include/tpch_constants.hpp>
 #include "velox/tpch/gen/DBGenIterator.h"
+#include "velox/type/FastConversions.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::tpch {
@@ -80,7 +81,13 @@ double decimalToDouble(int64_t value) {
   return (double)value * 0.01;
 }
 
+// Dbgen dates are always "YYYY-MM-DD", so the fast parser practically never
+// falls back to the general one.
 int32_t toDate(std::string_view stringDate) {
+  int32_t days;
+  if (util::tryFastParseDate(stringDate.data(), stringDate.size(), days)) {
+    return days;
+  }
   return DATE()->toDays(stringDate);
 }
 
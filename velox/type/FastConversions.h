@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/lang/Bits.h>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "velox/type/Timestamp.h"
+#include "velox/type/TimestampConversion.h"
+
+/// Parsers for the common, strictly formatted strings seen in casts from
+/// VARCHAR, e.g. text read from CSV or JSON. Each parser returns false if the
+/// input is not in the fast format, in which case the caller must use the
+/// general conversion in Conversions.h, which also produces the error
+/// message. For inputs that are accepted the results are identical to the
+/// general conversion. Digits are validated and converted 8 at a time using
+/// SIMD within a 64 bit register.
+namespace facebook::velox::util {
+
+namespace detail {
+
+static_assert(folly::kIsLittleEndian);
+
+inline uint64_t loadEight(const char* chars) {
+  uint64_t word;
+  memcpy(&word, chars, sizeof(word));
+  return word;
+}
+
+// True if all 8 bytes of 'word' are ASCII digits.
+inline bool isEightDigits(uint64_t word) {
+  return ((word & 0xF0F0F0F0F0F0F0F0) |
+          (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+      0x3333333333333333;
+}
+
+// Converts 8 ASCII digits in 'word' to their value. The first digit is in the
+// lowest byte.
+inline uint32_t parseEightDigits(uint64_t word) {
+  constexpr uint64_t kMask = 0x000000FF000000FF;
+  constexpr uint64_t kMul1 = 100 + (1000000ULL << 32);
+  constexpr uint64_t kMul2 = 1 + (10000ULL << 32);
+  word -= 0x3030303030303030;
+  word = (word * 10) + (word >> 8);
+  return static_cast<uint32_t>(
+      (((word & kMask) * kMul1) + (((word >> 16) & kMask) * kMul2)) >> 32);
+}
+
+// Parses 'size' > 0 ASCII digits at 'chars' into 'value'. Returns false if
+// there is a non-digit. The caller ensures 'size' digits fit in 64 bits.
+inline bool parseDigits(const char* chars, int32_t size, uint64_t& value) {
+  uint64_t result = 0;
+  int32_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    auto word = loadEight(chars + i);
+    if (!isEightDigits(word)) {
+      return false;
+    }
+    result = result * 100'000'000 + parseEightDigits(word);
+  }
+  for (; i < size; ++i) {
+    const uint8_t digit = chars[i] - '0';
+    if (digit > 9) {
+      return false;
+    }
+    result = result * 10 + digit;
+  }
+  value = result;
+  return true;
+}
+
+// Parses exactly 'size' digits at 'chars', as in the fixed width fields of
+// dates and times.
+inline bool parseFixedDigits(const char* chars, int32_t size, int32_t& value) {
+  uint64_t result;
+  if (!parseDigits(chars, size, result)) {
+    return false;
+  }
+  value = static_cast<int32_t>(result);
+  return true;
+}
+
+// Parses "YYYY-MM-DD" at 'chars' into days since epoch.
+inline bool parseDate(const char* chars, int64_t& days) {
+  int32_t year;
+  int32_t month;
+  int32_t day;
+  if (chars[4] != '-' || chars[7] != '-' ||
+      !parseFixedDigits(chars, 4, year) ||
+      !parseFixedDigits(chars + 5, 2, month) ||
+      !parseFixedDigits(chars + 8, 2, day) || !isValidDate(year, month, day)) {
+    return false;
+  }
+  days = daysSinceEpochFromDate(year, month, day);
+  return true;
+}
+
+} // namespace detail
+
+/// Parses an optional '-' followed by up to digits10 digits of T, so that
+/// the value always fits in T. Used for casts to TINYINT, SMALLINT, INTEGER
+/// and BIGINT.
+template <typename T>
+bool tryFastParseInteger(const char* chars, size_t size, T& result) {
+  static_assert(std::is_integral_v<T> && std::is_signed_v<T>);
+  const bool negative = size > 0 && chars[0] == '-';
+  const int32_t numDigits = size - negative;
+  if (numDigits == 0 || numDigits > std::numeric_limits<T>::digits10) {
+    return false;
+  }
+  uint64_t value;
+  if (!detail::parseDigits(chars + negative, numDigits, value)) {
+    return false;
+  }
+  result = negative ? -static_cast<T>(value) : static_cast<T>(value);
+  return true;
+}
+
+/// Parses an optional '-' followed by digits with an optional '.' and
+/// fraction digits, 15 digits at most without an exponent. The mantissa and
+/// the power of 10 are then exact doubles, so that a single correctly rounded
+/// division gives the correctly rounded result (Clinger's fast path).
+inline bool tryFastParseDouble(const char* chars, size_t size, double& result) {
+  static constexpr double kPowersOf10[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+      1e13, 1e14, 1e15};
+  const bool negative = size > 0 && chars[0] == '-';
+  const char* start = chars + negative;
+  const char* end = chars + size;
+  const char* dot = static_cast<const char*>(memchr(start, '.', end - start));
+  const int32_t numIntegerDigits = (dot ? dot : end) - start;
+  const int32_t numFractionDigits = dot ? end - dot - 1 : 0;
+  if (numIntegerDigits == 0 || (dot && numFractionDigits == 0) ||
+      numIntegerDigits + numFractionDigits > 15) {
+    return false;
+  }
+  uint64_t integer;
+  if (!detail::parseDigits(start, numIntegerDigits, integer)) {
+    return false;
+  }
+  uint64_t fraction = 0;
+  if (dot && !detail::parseDigits(dot + 1, numFractionDigits, fraction)) {
+    return false;
+  }
+  const uint64_t mantissa =
+      integer * static_cast<uint64_t>(kPowersOf10[numFractionDigits]) +
+      fraction;
+  const double value =
+      static_cast<double>(mantissa) / kPowersOf10[numFractionDigits];
+  result = negative ? -value : value;
+  return true;
+}
+
+/// Parses "YYYY-MM-DD" into days since epoch.
+inline bool tryFastParseDate(const char* chars, size_t size, int32_t& result) {
+  int64_t days;
+  if (size != 10 || !detail::parseDate(chars, days)) {
+    return false;
+  }
+  result = days;
+  return true;
+}
+
+/// Parses "YYYY-MM-DD HH:MM:SS" with 'T' or ' ' as date-time separator and an
+/// optional fraction of up to 6 digits after '.'.
+inline bool
+tryFastParseTimestamp(const char* chars, size_t size, Timestamp& result) {
+  int64_t days;
+  int32_t hour;
+  int32_t minute;
+  int32_t second;
+  if (size < 19 || size == 20 || size > 26 ||
+      (chars[10] != ' ' && chars[10] != 'T') || chars[13] != ':' ||
+      chars[16] != ':' || !detail::parseDate(chars, days) ||
+      !detail::parseFixedDigits(chars + 11, 2, hour) ||
+      !detail::parseFixedDigits(chars + 14, 2, minute) ||
+      !detail::parseFixedDigits(chars + 17, 2, second) || hour >= 24 ||
+      minute >= 60 || second > 60) {
+    return false;
+  }
+  int32_t micros = 0;
+  if (size > 19) {
+    static constexpr int32_t kScale[] = {1, 100'000, 10'000, 1'000, 100, 10, 1};
+    const int32_t numDigits = size - 20;
+    if (chars[19] != '.' ||
+        !detail::parseFixedDigits(chars + 20, numDigits, micros)) {
+      return false;
+    }
+    micros *= kScale[numDigits];
+  }
+  result = fromDatetime(days, fromTime(hour, minute, second, micros));
+  return true;
+}
+
+} // namespace facebook::velox::util
@@ -20,6 +20,8 @@
 #include <set>
 #include <string>
 
+#include <folly/String.h>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/type/Filter.h"
 
@@ -94,6 +96,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      strKind = "BigintValuesUsingBloomFilter";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +136,8 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBigintValuesUsingBloomFilter,
+       "kBigintValuesUsingBloomFilter"},
   };
 }
 
@@ -190,6 +197,8 @@ void Filter::registerSerDe() {
       NegatedBigintValuesUsingBitmask::create);
   registry.Register(
       "HugeintValuesUsingHashTable", HugeintValuesUsingHashTable::create);
+  registry.Register(
+      "BigintValuesUsingBloomFilter", BigintValuesUsingBloomFilter::create);
   registry.Register("FloatRange", AbstractRange::create);
   registry.Register("DoubleRange", AbstractRange::create);
   registry.Register("BytesRange", BytesRange::create);
@@ -964,6 +973,58 @@ bool BigintValuesUsingHashTable::testInt64Range(
   return max >= *it;
 }
 
+folly::dynamic BigintValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase("BigintValuesUsingBloomFilter");
+  obj["min"] = min_;
+  obj["max"] = max_;
+  std::string bits(bloomFilter_->serializedSize(), '\0');
+  bloomFilter_->serialize(bits.data());
+  obj["bloomFilter"] = folly::hexlify(bits);
+  return obj;
+}
+
+FilterPtr BigintValuesUsingBloomFilter::create(const folly::dynamic& obj) {
+  auto nullAllowed = deserializeNullAllowed(obj);
+  auto min = obj["min"].asInt();
+  auto max = obj["max"].asInt();
+  std::string bits;
+  VELOX_CHECK(folly::unhexlify(obj["bloomFilter"].asString(), bits));
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->merge(bits.data());
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), nullAllowed);
+}
+
+bool BigintValuesUsingBloomFilter::testingEquals(const Filter& other) const {
+  auto otherBloom = dynamic_cast<const BigintValuesUsingBloomFilter*>(&other);
+  if (otherBloom == nullptr || !Filter::testingBaseEquals(other) ||
+      min_ != otherBloom->min_ || max_ != otherBloom->max_) {
+    return false;
+  }
+  const auto size = bloomFilter_->serializedSize();
+  if (size != otherBloom->bloomFilter_->serializedSize()) {
+    return false;
+  }
+  std::string bits(size, '\0');
+  std::string otherBits(size, '\0');
+  bloomFilter_->serialize(bits.data());
+  otherBloom->bloomFilter_->serialize(otherBits.data());
+  return bits == otherBits;
+}
+
+bool BigintValuesUsingBloomFilter::testInt64Range(
+    int64_t min,
+    int64_t max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+  if (min == max) {
+    return testInt64(min);
+  }
+  return !(min > max_ || max < min_);
+}
+
 folly::dynamic HugeintValuesUsingHashTable::serialize() const {
   auto obj = Filter::serializeBase("HugeintValuesUsingHashTable");
   obj["min_lower"] = HugeInt::lower(min_);
@@ -1840,6 +1901,7 @@ std::unique_ptr<Filter> BigintRange::mergeWith(const Filter* other) const {
     case FilterKind::kNegatedBigintRange:
     case FilterKind::kBigintValuesUsingBitmask:
     case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kBigintMultiRange: {
       auto otherMultiRange = dynamic_cast<const BigintMultiRange*>(other);
@@ -1970,6 +2032,7 @@ std::unique_ptr<Filter> NegatedBigintRange::mergeWith(
     }
     case FilterKind::kBigintValuesUsingHashTable:
     case FilterKind::kBigintValuesUsingBitmask:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kNegatedBigintValuesUsingHashTable:
     case FilterKind::kNegatedBigintValuesUsingBitmask: {
@@ -2026,6 +2089,13 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
     }
     case FilterKind::kBigintValuesUsingBitmask:
       return other->mergeWith(this);
+    case FilterKind::kBigintValuesUsingBloomFilter: {
+      auto otherBloom = static_cast<const BigintValuesUsingBloomFilter*>(other);
+      auto min = std::max(min_, otherBloom->min());
+      auto max = std::min(max_, otherBloom->max());
+
+      return mergeWith(min, max, other);
+    }
     case FilterKind::kBigintMultiRange: {
       auto otherMultiRange = dynamic_cast<const BigintMultiRange*>(other);
 
@@ -2092,6 +2162,59 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
   return createBigintValues(valuesToKeep, bothNullAllowed);
 }
 
+std::unique_ptr<Filter> BigintValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return this->clone(false);
+    case FilterKind::kBigintRange:
+    case FilterKind::kBigintValuesUsingBloomFilter: {
+      bool bothNullAllowed = nullAllowed_ && other->testNull();
+      int64_t otherMin;
+      int64_t otherMax;
+      if (other->kind() == FilterKind::kBigintRange) {
+        auto otherRange = static_cast<const BigintRange*>(other);
+        otherMin = otherRange->lower();
+        otherMax = otherRange->upper();
+      } else {
+        auto otherBloom =
+            static_cast<const BigintValuesUsingBloomFilter*>(other);
+        otherMin = otherBloom->min();
+        otherMax = otherBloom->max();
+      }
+      auto min = std::max(min_, otherMin);
+      auto max = std::min(max_, otherMax);
+      if (min > max) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      // Keeps the Bloom filter of 'this' over the intersection of the ranges.
+      // If 'other' is also a Bloom filter, it is dropped, which accepts a
+      // superset of the values accepted by both.
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          min, max, bloomFilter_, bothNullAllowed);
+    }
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBitmask:
+      // The exact values of 'other' that pass 'this'.
+      return other->mergeWith(this);
+    case FilterKind::kNegatedBigintRange:
+    case FilterKind::kBigintMultiRange:
+    case FilterKind::kNegatedBigintValuesUsingHashTable:
+    case FilterKind::kNegatedBigintValuesUsingBitmask: {
+      // These cannot be combined with a Bloom filter. Keeps the exact filter,
+      // which accepts a superset of the values accepted by both.
+      bool bothNullAllowed = nullAllowed_ && other->testNull();
+      return other->clone(bothNullAllowed);
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
 std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
     const Filter* other) const {
   switch (other->kind()) {
@@ -2125,6 +2248,14 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
 
       return mergeWith(min, max, other);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter: {
+      auto otherBloom = static_cast<const BigintValuesUsingBloomFilter*>(other);
+
+      auto min = std::max(min_, otherBloom->min());
+      auto max = std::min(max_, otherBloom->max());
+
+      return mergeWith(min, max, other);
+    }
     case FilterKind::kBigintMultiRange: {
       auto otherMultiRange = dynamic_cast<const BigintMultiRange*>(other);
 
@@ -2186,6 +2317,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
       return std::make_unique<NegatedBigintValuesUsingHashTable>(*this, false);
     case FilterKind::kBigintValuesUsingHashTable:
     case FilterKind::kBigintValuesUsingBitmask:
+    case FilterKind::kBigintValuesUsingBloomFilter:
     case FilterKind::kBigintRange:
     case FilterKind::kBigintMultiRange: {
       return other->mergeWith(this);
@@ -2225,6 +2357,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingBitmask::mergeWith(
       return std::make_unique<NegatedBigintValuesUsingBitmask>(*this, false);
     case FilterKind::kBigintValuesUsingHashTable:
     case FilterKind::kBigintValuesUsingBitmask:
+    case FilterKind::kBigintValuesUsingBloomFilter:
     case FilterKind::kBigintRange:
     case FilterKind::kNegatedBigintRange:
     case FilterKind::kBigintMultiRange: {
@@ -2267,7 +2400,8 @@ std::unique_ptr<Filter> BigintMultiRange::mergeWith(const Filter* other) const {
     case FilterKind::kBigintRange:
     case FilterKind::kNegatedBigintRange:
     case FilterKind::kBigintValuesUsingBitmask:
-    case FilterKind::kBigintValuesUsingHashTable: {
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBloomFilter: {
       return other->mergeWith(this);
     }
     case FilterKind::kBigintMultiRange: {
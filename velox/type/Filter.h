@@ -25,6 +25,7 @@
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -56,6 +57,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBigintValuesUsingBloomFilter,
 };
 
 class Filter;
@@ -1019,6 +1021,96 @@ class HugeintValuesUsingHashTable final : public Filter {
   folly::F14FastSet<int128_t> values_;
 };
 
+/// Approximate IN-list filter for integral data types, implemented as a Bloom
+/// filter over the values plus their range. Used for dynamic filters pushed
+/// down from a hash join build side that has too many distinct keys for an
+/// exact IN-list. Values that are not in the list pass with a small
+/// probability, so this may only be used where the consumer rechecks the
+/// values, e.g. a hash join probe. Merging with another filter returns a
+/// filter that accepts at least the values accepted by both.
+class BigintValuesUsingBloomFilter final : public Filter {
+ public:
+  /// @param min Minimum value.
+  /// @param max Maximum value.
+  /// @param bloomFilter Bloom filter containing folly::hasher<int64_t> hashes
+  /// of the values that pass the filter.
+  /// @param nullAllowed Null values are passing the filter if true.
+  BigintValuesUsingBloomFilter(
+      int64_t min,
+      int64_t max,
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+        min_(min),
+        max_(max),
+        bloomFilter_(std::move(bloomFilter)) {
+    VELOX_CHECK_LE(min_, max_);
+    VELOX_CHECK_NOT_NULL(bloomFilter_);
+  }
+
+  BigintValuesUsingBloomFilter(
+      const BigintValuesUsingBloomFilter& other,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+        min_(other.min_),
+        max_(other.max_),
+        bloomFilter_(other.bloomFilter_) {}
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    if (nullAllowed) {
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          *this, nullAllowed.value());
+    } else {
+      return std::make_unique<BigintValuesUsingBloomFilter>(*this);
+    }
+  }
+
+  bool testInt64(int64_t value) const final {
+    if (value < min_ || value > max_) {
+      return false;
+    }
+    return bloomFilter_->mayContain(folly::hasher<int64_t>()(value));
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  int64_t min() const {
+    return min_;
+  }
+
+  int64_t max() const {
+    return max_;
+  }
+
+  const BloomFilter<>& bloomFilter() const {
+    return *bloomFilter_;
+  }
+
+  std::string toString() const final {
+    return fmt::format(
+        "BigintValuesUsingBloomFilter: [{}, {}] {} bytes {}",
+        min_,
+        max_,
+        bloomFilter_->serializedSize(),
+        nullAllowed_ ? "with nulls" : "no nulls");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  const int64_t min_;
+  const int64_t max_;
+  // Immutable after construction, shared between clones.
+  const std::shared_ptr<const BloomFilter<>> bloomFilter_;
+};
+
 /// IN-list filter for integral data types. Implemented as a bitmask. Offers
 /// better performance than the hash table when the range of values is small.
 class BigintValuesUsingBitmask final : public Filter {
@@ -18,6 +18,7 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/external/date/tz.h"
 #include "velox/type/tz/TimeZoneMap.h"
+#include "velox/type/tz/TimeZoneTransitions.h"
 
 namespace facebook::velox {
 namespace {
@@ -33,6 +34,18 @@ inline int64_t getPrestoTZOffsetInSeconds(int16_t tzID) {
   return ((tzID <= 840) ? (tzID - 841) : (tzID - 840)) * 60;
 }
 
+// Returns the zone of 'tzID' > 1680. Conversions of a column mostly use the
+// same zone, so the last lookup of the thread is kept.
+const date::time_zone& locateZone(int16_t tzID) {
+  thread_local int16_t lastTzID = 0;
+  thread_local const date::time_zone* lastZone = nullptr;
+  if (tzID != lastTzID) {
+    lastZone = date::locate_zone(util::getTimeZoneName(tzID));
+    lastTzID = tzID;
+  }
+  return *lastZone;
+}
+
 } // namespace
 
 // static
@@ -45,6 +58,11 @@ Timestamp Timestamp::now() {
 }
 
 void Timestamp::toGMT(const date::time_zone& zone) {
+  int64_t seconds;
+  if (util::TimeZoneTransitions::get(zone).toUtc(seconds_, seconds)) {
+    seconds_ = seconds;
+    return;
+  }
   // Magic number -2^39 + 24*3600. This number and any number lower than that
   // will cause time_zone::to_sys() to SIGABRT. We don't want that to happen.
   if (seconds_ <= (-1096193779200l + 86400l)) {
@@ -75,7 +93,7 @@ void Timestamp::toGMT(int16_t tzID) {
     seconds_ -= getPrestoTZOffsetInSeconds(tzID);
   } else {
     // Other ids go this path.
-    toGMT(*date::locate_zone(util::getTimeZoneName(tzID)));
+    toGMT(locateZone(tzID));
   }
 }
 
@@ -111,6 +129,11 @@ Timestamp::toTimePoint() const {
 }
 
 void Timestamp::toTimezone(const date::time_zone& zone) {
+  int64_t localSeconds;
+  if (util::TimeZoneTransitions::get(zone).toLocal(seconds_, localSeconds)) {
+    seconds_ = localSeconds;
+    return;
+  }
   auto tp = toTimePoint();
   auto epoch = zone.to_local(tp).time_since_epoch();
   // NOTE: Round down to get the seconds of the current time point.
@@ -124,7 +147,7 @@ void Timestamp::toTimezone(int16_t tzID) {
     seconds_ += getPrestoTZOffsetInSeconds(tzID);
   } else {
     // Other ids go this path.
-    toTimezone(*date::locate_zone(util::getTimeZoneName(tzID)));
+    toTimezone(locateZone(tzID));
   }
 }
 
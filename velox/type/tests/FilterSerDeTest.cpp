@@ -110,6 +110,16 @@ TEST_F(FilterSerDeTest, valuesFilters) {
   }
 }
 
+TEST_F(FilterSerDeTest, bloomFilter) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(1'000);
+  for (auto i = 0; i < 1'000; ++i) {
+    bloomFilter->insert(folly::hasher<int64_t>()(i * 7));
+  }
+  testSerde(BigintValuesUsingBloomFilter(0, 6'993, bloomFilter, false));
+  testSerde(BigintValuesUsingBloomFilter(0, 6'993, bloomFilter, true));
+}
+
 TEST_F(FilterSerDeTest, rangeFilters) {
   FloatRange floatRange(1.0, true, true, 124.5, false, true, false);
   testSerde(floatRange);
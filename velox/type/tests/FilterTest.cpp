@@ -269,6 +269,84 @@ TEST(FilterTest, bigintValuesUsingHashTable) {
   EXPECT_TRUE(filter->testInt64Range(0, 1, false));
 }
 
+namespace {
+std::unique_ptr<BigintValuesUsingBloomFilter> makeBloomFilter(
+    const std::vector<int64_t>& values,
+    bool nullAllowed) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(values.size());
+  for (auto value : values) {
+    bloomFilter->insert(folly::hasher<int64_t>()(value));
+  }
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      *std::min_element(values.begin(), values.end()),
+      *std::max_element(values.begin(), values.end()),
+      std::move(bloomFilter),
+      nullAllowed);
+}
+} // namespace
+
+TEST(FilterTest, bigintValuesUsingBloomFilter) {
+  std::vector<int64_t> values;
+  for (auto i = 0; i < 10'000; ++i) {
+    values.push_back(i * 1'000);
+  }
+  auto filter = makeBloomFilter(values, false);
+  for (auto value : values) {
+    ASSERT_TRUE(filter->testInt64(value));
+  }
+  EXPECT_FALSE(filter->testNull());
+  EXPECT_FALSE(filter->testInt64(-1));
+  EXPECT_FALSE(filter->testInt64(10'000'000));
+
+  // Expect a false positive rate of a few percent.
+  int32_t numFalsePositives = 0;
+  for (auto value : values) {
+    numFalsePositives += filter->testInt64(value + 1);
+  }
+  EXPECT_LT(numFalsePositives, values.size() / 20);
+
+  EXPECT_TRUE(filter->testInt64Range(1, 999, false));
+  EXPECT_FALSE(filter->testInt64Range(-10, -1, false));
+  EXPECT_FALSE(filter->testInt64Range(10'000'000, 20'000'000, false));
+  EXPECT_TRUE(filter->clone(true)->testNull());
+
+  // Merge with a range narrows the range of the Bloom filter.
+  BigintRange range(5'000, 20'000, false);
+  auto merged = filter->mergeWith(&range);
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_TRUE(merged->testInt64(5'000));
+  EXPECT_TRUE(merged->testInt64(20'000));
+  EXPECT_FALSE(merged->testInt64(4'000));
+  EXPECT_FALSE(merged->testInt64(21'000));
+  ASSERT_EQ(range.mergeWith(filter.get())->kind(), merged->kind());
+
+  BigintRange disjoint(-100, -1, false);
+  ASSERT_EQ(filter->mergeWith(&disjoint)->kind(), FilterKind::kAlwaysFalse);
+
+  // Merge with an IN-list keeps the exact values that pass the Bloom filter.
+  auto inList = createBigintValues({1'000, 2'000, 123'456'789}, false);
+  merged = filter->mergeWith(inList.get());
+  EXPECT_TRUE(merged->testInt64(1'000));
+  EXPECT_TRUE(merged->testInt64(2'000));
+  EXPECT_FALSE(merged->testInt64(3'000));
+  EXPECT_FALSE(merged->testInt64(123'456'789));
+  merged = inList->mergeWith(filter.get());
+  EXPECT_TRUE(merged->testInt64(1'000));
+  EXPECT_FALSE(merged->testInt64(123'456'789));
+
+  // Filters that cannot be combined with the Bloom filter are kept as is.
+  auto notIn = createNegatedBigintValues({1'000, 2'000}, false);
+  merged = notIn->mergeWith(filter.get());
+  EXPECT_FALSE(merged->testInt64(1'000));
+  EXPECT_TRUE(merged->testInt64(3'000));
+
+  IsNotNull isNotNull;
+  merged = filter->clone(true)->mergeWith(&isNotNull);
+  EXPECT_FALSE(merged->testNull());
+  EXPECT_TRUE(merged->testInt64(1'000));
+}
+
 TEST(FilterTest, negatedBigintValuesUsingHashTable) {
   auto filter = createNegatedBigintValues({1, 6, 10'000, 8, 9, 100, 10}, false);
   auto castedFilter =
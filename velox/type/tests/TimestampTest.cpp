@@ -20,6 +20,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/external/date/tz.h"
 #include "velox/type/Timestamp.h"
+#include "velox/type/tz/TimeZoneTransitions.h"
 
 namespace facebook::velox {
 namespace {
@@ -299,6 +300,64 @@ TEST(TimestampTest, outOfRange) {
       t.toTimezone(*timezone), "Timestamp is outside of supported range");
 }
 
+TEST(TimestampTest, timeZoneTransitions) {
+  std::default_random_engine gen(42);
+  std::uniform_int_distribution<int64_t> dist(
+      util::TimeZoneTransitions::kMinSeconds - 86'400,
+      util::TimeZoneTransitions::kMaxSeconds + 86'400);
+  for (const auto* name :
+       {"America/Los_Angeles",
+        "Europe/London",
+        "Australia/Lord_Howe",
+        "Asia/Kolkata",
+        "Etc/GMT+5"}) {
+    SCOPED_TRACE(name);
+    const auto* zone = date::locate_zone(name);
+    const auto& transitions = util::TimeZoneTransitions::get(*zone);
+    ASSERT_EQ(&transitions, &util::TimeZoneTransitions::get(*zone));
+    std::vector<int64_t> seconds;
+    for (int i = 0; i < 10'000; ++i) {
+      seconds.push_back(dist(gen));
+    }
+    // Around the daylight saving transitions of 2023 in the northern and
+    // southern hemispheres.
+    for (const int64_t transition : {1678611600, 1699171200, 1680364800}) {
+      for (int64_t delta = -7'200; delta <= 7'200; delta += 900) {
+        seconds.push_back(transition + delta);
+      }
+    }
+    for (const auto value : seconds) {
+      SCOPED_TRACE(value);
+      const date::sys_seconds sysTime{std::chrono::seconds(value)};
+      int64_t local;
+      if (transitions.toLocal(value, local)) {
+        ASSERT_EQ(local, zone->to_local(sysTime).time_since_epoch().count());
+      }
+      Timestamp timestamp(value, 0);
+      timestamp.toTimezone(*zone);
+      ASSERT_EQ(
+          timestamp.getSeconds(),
+          zone->to_local(sysTime).time_since_epoch().count());
+
+      const date::local_seconds localTime{std::chrono::seconds(value)};
+      const auto info = zone->get_info(localTime);
+      int64_t utc;
+      if (info.result == date::local_info::unique) {
+        const auto expected =
+            zone->to_sys(localTime).time_since_epoch().count();
+        if (transitions.toUtc(value, utc)) {
+          ASSERT_EQ(utc, expected);
+        }
+        timestamp = Timestamp(value, 0);
+        timestamp.toGMT(*zone);
+        ASSERT_EQ(timestamp.getSeconds(), expected);
+      } else {
+        ASSERT_FALSE(transitions.toUtc(value, utc));
+      }
+    }
+  }
+}
+
 TEST(TimestampTest, epochToUtc) {
   std::tm tm;
   ASSERT_FALSE(epochToUtc(-(1ll << 60), tm));
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/type/tz/TimeZoneTransitions.h"
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/external/date/tz.h"
+
+namespace facebook::velox::util {
+namespace {
+
+// Offsets from UTC are less than a day.
+constexpr int64_t kSecondsInDay = 86'400;
+
+} // namespace
+
+TimeZoneTransitions::TimeZoneTransitions(const date::time_zone& zone) {
+  auto seconds = kMinSeconds;
+  while (seconds < kMaxSeconds) {
+    const auto info =
+        zone.get_info(date::sys_seconds(std::chrono::seconds(seconds)));
+    const auto end = info.end.time_since_epoch().count();
+    VELOX_CHECK_GT(end, seconds, "Bad transition in {}", zone.name());
+    const int32_t offset = info.offset.count();
+    // Only the offset matters, so a change of abbreviation or of daylight
+    // saving with the same total offset does not start an interval.
+    if (offsets_.empty() || offsets_.back() != offset) {
+      begins_.push_back(seconds);
+      offsets_.push_back(offset);
+    }
+    seconds = end;
+  }
+}
+
+// static
+const TimeZoneTransitions& TimeZoneTransitions::get(
+    const date::time_zone& zone) {
+  // Conversions of a column mostly use the same zone.
+  thread_local const date::time_zone* lastZone = nullptr;
+  thread_local const TimeZoneTransitions* lastTransitions = nullptr;
+  if (&zone == lastZone) {
+    return *lastTransitions;
+  }
+  static folly::Synchronized<folly::F14FastMap<
+      const date::time_zone*,
+      std::unique_ptr<TimeZoneTransitions>>>
+      cache;
+  const auto* transitions = cache.withWLock([&](auto& map) {
+    auto& entry = map[&zone];
+    if (entry == nullptr) {
+      entry = std::make_unique<TimeZoneTransitions>(zone);
+    }
+    return entry.get();
+  });
+  lastZone = &zone;
+  lastTransitions = transitions;
+  return *transitions;
+}
+
+bool TimeZoneTransitions::toUtc(int64_t localSeconds, int64_t& seconds) const {
+  if (localSeconds < kMinSeconds + kSecondsInDay ||
+      localSeconds >= kMaxSeconds - kSecondsInDay) {
+    return false;
+  }
+  // An interval that contains the UTC time starts at most a day after and
+  // ends at least a day before 'localSeconds'.
+  int32_t numMatches = 0;
+  for (auto i = findInterval(localSeconds - kSecondsInDay);
+       i < begins_.size() && begins_[i] <= localSeconds + kSecondsInDay;
+       ++i) {
+    const auto utc = localSeconds - offsets_[i];
+    const auto end = i + 1 < begins_.size() ? begins_[i + 1] : kMaxSeconds;
+    if (utc >= begins_[i] && utc < end) {
+      seconds = utc;
+      ++numMatches;
+    }
+  }
+  return numMatches == 1;
+}
+
+} // namespace facebook::velox::util
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace date {
+class time_zone;
+} // namespace date
+
+namespace facebook::velox::util {
+
+/// The offsets from UTC of a time zone between 1900 and 2100, precomputed from
+/// the time zone database so that converting a timestamp takes a binary
+/// search over a small array instead of a 'date::time_zone' lookup. Times that
+/// the table cannot convert are left to the caller, which then uses the time
+/// zone database.
+class TimeZoneTransitions {
+ public:
+  /// 1900-01-01 00:00:00 UTC.
+  static constexpr int64_t kMinSeconds = -2'208'988'800;
+  /// 2100-01-01 00:00:00 UTC.
+  static constexpr int64_t kMaxSeconds = 4'102'444'800;
+
+  explicit TimeZoneTransitions(const date::time_zone& zone);
+
+  /// Returns the table for 'zone'. Tables are built on first use and kept for
+  /// the life of the process.
+  static const TimeZoneTransitions& get(const date::time_zone& zone);
+
+  /// Sets 'localSeconds' to the local time of 'seconds' since epoch in UTC.
+  /// Returns false if 'seconds' is not in [kMinSeconds, kMaxSeconds).
+  bool toLocal(int64_t seconds, int64_t& localSeconds) const {
+    if (seconds < kMinSeconds || seconds >= kMaxSeconds) {
+      return false;
+    }
+    localSeconds = seconds + offsets_[findInterval(seconds)];
+    return true;
+  }
+
+  /// Sets 'seconds' to the UTC time of 'localSeconds'. Returns false if
+  /// 'localSeconds' is out of range or does not map to exactly one UTC time,
+  /// i.e. is in the overlap or the gap of a transition.
+  bool toUtc(int64_t localSeconds, int64_t& seconds) const;
+
+  /// Returns the number of intervals with a constant offset.
+  size_t numIntervals() const {
+    return begins_.size();
+  }
+
+ private:
+  // Returns the index of the interval that contains 'seconds', which must be
+  // in range. The search has no data dependent branches, so that it runs at
+  // the same speed for any distribution of inputs.
+  size_t findInterval(int64_t seconds) const {
+    const int64_t* data = begins_.data();
+    size_t size = begins_.size();
+    while (size > 1) {
+      const auto half = size / 2;
+      data = data[half] <= seconds ? data + half : data;
+      size -= half;
+    }
+    return data - begins_.data();
+  }
+
+  // UTC start of each interval. The first is kMinSeconds.
+  std::vector<int64_t> begins_;
+  // Offset from UTC in seconds of each interval.
+  std::vector<int32_t> offsets_;
+};
+
+} // namespace facebook::velox::util
@@ -548,7 +548,7 @@ void BaseVector::ensureWritable(
     VectorPool* vectorPool) {
   if (!result) {
     if (vectorPool) {
-      result = vectorPool->get(type, rows.end());
+      result = vectorPool->get(type, rows.end(), pool);
     } else {
       result = BaseVector::create(type, rows.end(), pool);
     }
@@ -580,7 +580,8 @@ void BaseVector::ensureWritable(
 
   VectorPtr copy;
   if (vectorPool) {
-    copy = vectorPool->get(isUnknownType ? type : resultType, targetSize);
+    copy = vectorPool->get(
+        isUnknownType ? type : resultType, targetSize, pool);
   } else {
     copy =
         BaseVector::create(isUnknownType ? type : resultType, targetSize, pool);
@@ -16,6 +16,7 @@
 #include "velox/vector/DecodedVector.h"
 #include "velox/buffer/Buffer.h"
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/vector/BaseVector.h"
 #include "velox/vector/LazyVector.h"
 
@@ -31,6 +32,50 @@ std::vector<vector_size_t> makeConsecutiveIndices(size_t size) {
   }
   return consecutiveIndices;
 }
+
+// Sets 'result[i]' to 'indices[wrappedIndices[i]]' for i in [0, size).
+// 'result' may be the same as 'wrappedIndices'.
+void gatherIndices(
+    const vector_size_t* indices,
+    const vector_size_t* wrappedIndices,
+    vector_size_t size,
+    vector_size_t* result) {
+  constexpr int32_t kBatchSize = xsimd::batch<int32_t>::size;
+  vector_size_t i = 0;
+  for (; i + kBatchSize <= size; i += kBatchSize) {
+    simd::gather(indices, wrappedIndices + i).store_unaligned(result + i);
+  }
+  for (; i < size; ++i) {
+    result[i] = indices[wrappedIndices[i]];
+  }
+}
+
+// Sets the bits in 'nulls' to null for the rows in [0, size) whose index in
+// 'indices' is null in 'baseNulls'. Bits are gathered 8 at a time and
+// combined a byte at a time.
+void andNullsAtIndices(
+    uint64_t* nulls,
+    const uint64_t* baseNulls,
+    const vector_size_t* indices,
+    vector_size_t size) {
+  constexpr int32_t kBatchSize = xsimd::batch<int32_t>::size;
+  constexpr int32_t kStep = std::min(kBatchSize, 8);
+  auto* nullBytes = reinterpret_cast<uint8_t*>(nulls);
+  vector_size_t i = 0;
+  // Gathers read 'kBatchSize' indices even if only 'kStep' are used.
+  for (; i + std::max(kBatchSize, 8) <= size; i += 8) {
+    uint8_t notNull = 0;
+    for (auto j = 0; j < 8; j += kStep) {
+      notNull |= simd::gather8Bits(baseNulls, indices + i + j, kStep) << j;
+    }
+    nullBytes[i / 8] &= notNull;
+  }
+  for (; i < size; ++i) {
+    if (bits::isBitNull(baseNulls, indices[i])) {
+      bits::setNull(nulls, i);
+    }
+  }
+}
 } // namespace
 
 const std::vector<vector_size_t>& DecodedVector::consecutiveIndices() {
@@ -104,10 +149,6 @@ void DecodedVector::makeIndices(
 }
 
 void DecodedVector::reset(vector_size_t size) {
-  if (!indicesNotCopied()) {
-    // Init with default value to avoid invalid indices for unselected rows)
-    std::fill(copiedIndices_.begin(), copiedIndices_.end(), 0);
-  }
   size_ = size;
   indices_ = nullptr;
   data_ = nullptr;
@@ -196,6 +237,9 @@ void DecodedVector::applyDictionaryWrapper(
 
   auto newIndices = dictionaryVector.wrapInfo()->as<vector_size_t>();
   auto newNulls = dictionaryVector.rawNulls();
+  // If all rows are selected and not null, the indices of all rows are valid
+  // and can be combined in bulk.
+  const bool bulk = nulls_ == nullptr && (!rows || rows->isAllSelected());
   if (newNulls) {
     hasExtraNulls_ = true;
     mayHaveNulls_ = true;
@@ -209,10 +253,29 @@ void DecodedVector::applyDictionaryWrapper(
   auto copiedNulls = copiedNulls_.data();
   auto currentIndices = indices_;
   if (indicesNotCopied()) {
-    copiedIndices_.resize(size_);
+    if (bulk) {
+      copiedIndices_.resize(size_);
+    } else {
+      // Zero the rows that are not set below, so that they stay valid.
+      copiedIndices_.assign(size_, 0);
+    }
     indices_ = copiedIndices_.data();
   }
 
+  if (bulk) {
+    if (newNulls) {
+      andNullsAtIndices(copiedNulls, newNulls, currentIndices, size_);
+    }
+    gatherIndices(newIndices, currentIndices, size_, copiedIndices_.data());
+    if (newNulls) {
+      // The indices of null rows are not defined.
+      bits::forEachUnsetBit(copiedNulls, 0, size_, [&](auto row) {
+        copiedIndices_[row] = 0;
+      });
+    }
+    return;
+  }
+
   applyToRows(rows, [&](vector_size_t row) {
     if (!nulls_ || !bits::isBitNull(nulls_, row)) {
       auto wrappedIndex = currentIndices[row];
@@ -265,14 +328,18 @@ void DecodedVector::setFlatNulls(
     const BaseVector& vector,
     const SelectivityVector* rows) {
   if (hasExtraNulls_) {
+    auto leafNulls = vector.rawNulls();
+    if (!leafNulls) {
+      // The nulls of the wrappers are the nulls of the rows.
+      return;
+    }
     if (nullsNotCopied()) {
       copyNulls(end(rows));
     }
-    auto leafNulls = vector.rawNulls();
     auto copiedNulls = &copiedNulls_[0];
     applyToRows(rows, [&](vector_size_t row) {
       if (!bits::isBitNull(nulls_, row) &&
-          (leafNulls && bits::isBitNull(leafNulls, indices_[row]))) {
+          bits::isBitNull(leafNulls, indices_[row])) {
         bits::setNull(copiedNulls, row);
       }
     });
@@ -431,11 +498,9 @@ const uint64_t* DecodedVector::nulls() {
       allNulls_ = copiedNulls_.data();
     } else {
       // Copy base nulls.
-      copiedNulls_.resize(bits::nwords(size_));
-      auto* rawCopiedNulls = copiedNulls_.data();
-      for (auto i = 0; i < size_; ++i) {
-        bits::setNull(rawCopiedNulls, i, bits::isBitNull(nulls_, indices_[i]));
-      }
+      copiedNulls_.resize(0);
+      copiedNulls_.resize(bits::nwords(size_), bits::kNotNull64);
+      andNullsAtIndices(copiedNulls_.data(), nulls_, indices_, size_);
       allNulls_ = copiedNulls_.data();
     }
   }
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <optional>
+
 #include "velox/vector/BaseVector.h"
 #include "velox/vector/FlatVector.h"
 
@@ -31,6 +33,24 @@ class Callable {
 
   virtual bool hasCapture() const = 0;
 
+  /// A lambda whose body is a function call on the lambda's parameters, e.g.
+  /// (s, x) -> s + x.
+  struct SimpleCall {
+    /// Name of the called function.
+    std::string name;
+
+    /// Index of the parameter passed as each argument of the call.
+    std::vector<int32_t> parameters;
+  };
+
+  /// Returns the call if the body of 'this' is a function call whose
+  /// arguments are all parameters of the lambda and there are no captures.
+  /// Lets higher order functions evaluate common lambdas over all elements
+  /// at once without calling 'this'.
+  virtual std::optional<SimpleCall> simpleCall() const {
+    return std::nullopt;
+  }
+
   /// Applies 'this' to 'args' for 'rows' and returns the result in
   /// '*result'.
   /// @param rows The rows that this callable applies to. It is the element rows
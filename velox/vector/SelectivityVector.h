@@ -46,6 +46,7 @@ class SelectivityVector {
     begin_ = 0;
     end_ = allSelected ? size_ : 0;
     allSelected_ = allSelected;
+    isDenseRange_ = true;
   }
 
   // Returns a statically allocated reference to an empty selectivity vector
@@ -88,6 +89,7 @@ class SelectivityVector {
     begin_ = 0;
     end_ = value ? size_ : 0;
     allSelected_ = value;
+    isDenseRange_ = true;
   }
 
   /**
@@ -99,6 +101,7 @@ class SelectivityVector {
     VELOX_DCHECK_LT(idx, bits_.size() * sizeof(bits_[0]) * 8);
     bits::setBit(bits_.data(), idx, valid);
     allSelected_.reset();
+    isDenseRange_.reset();
   }
 
   /**
@@ -114,6 +117,7 @@ class SelectivityVector {
     VELOX_DCHECK_LE(end, bits_.size() * sizeof(bits_[0]) * 8);
     bits::fillBits(bits_.data(), begin, end, valid);
     allSelected_.reset();
+    isDenseRange_.reset();
   }
 
   /**
@@ -157,6 +161,7 @@ class SelectivityVector {
     begin_ = 0;
     end_ = 0;
     allSelected_ = false;
+    isDenseRange_ = true;
   }
 
   /**
@@ -167,6 +172,7 @@ class SelectivityVector {
     begin_ = 0;
     end_ = size_;
     allSelected_ = true;
+    isDenseRange_ = true;
   }
 
   void setFromBits(const uint64_t* bits, int32_t size) {
@@ -280,29 +286,42 @@ class SelectivityVector {
       begin_ = 0;
       end_ = 0;
       allSelected_ = false;
+      isDenseRange_ = true;
       return;
     }
     end_ = bits::findLastBit(bits_.data(), begin_, size_) + 1;
     allSelected_.reset();
+    isDenseRange_.reset();
   }
 
   bool isAllSelected() const {
     if (allSelected_.has_value()) {
       return allSelected_.value();
     }
-    allSelected_ = begin_ == 0 && end_ == size_ &&
-        bits::isAllSet(bits_.data(), 0, size_, true);
+    allSelected_ = begin_ == 0 && end_ == size_ && isDenseRange();
     return allSelected_.value();
   }
+
+  /// Returns true if all rows in [begin(), end()) are selected, e.g. after
+  /// setAll() or for a filter that passes a contiguous range of rows. Such
+  /// vectors are iterated without reading the bits.
+  bool isDenseRange() const {
+    if (!isDenseRange_.has_value()) {
+      isDenseRange_ = bits::isAllSet(bits_.data(), begin_, end_, true);
+    }
+    return isDenseRange_.value();
+  }
+
   /**
    * Iterate and count the number of selected values in this SelectivityVector
    */
   vector_size_t countSelected() const {
-    if (allSelected_.has_value() && *allSelected_) {
-      return size();
+    if (isDenseRange_.has_value() && *isDenseRange_) {
+      return end_ - begin_;
     }
     auto count = bits::countBits(bits_.data(), begin_, end_);
     allSelected_ = count == size();
+    isDenseRange_ = count == end_ - begin_;
     return count;
   }
 
@@ -377,6 +396,10 @@ class SelectivityVector {
 
   mutable std::optional<bool> allSelected_;
 
+  // True if all bits in [begin_, end_) are set. Computed on first use after a
+  // change of the bits.
+  mutable std::optional<bool> isDenseRange_;
+
   friend class SelectivityIterator;
 };
 
@@ -424,7 +447,7 @@ class SelectivityIterator {
 
 template <typename Callable>
 inline void SelectivityVector::applyToSelected(Callable func) const {
-  if (isAllSelected()) {
+  if (isDenseRange()) {
     for (vector_size_t row = begin_; row < end_; ++row) {
       func(row);
     }
@@ -435,7 +458,7 @@ inline void SelectivityVector::applyToSelected(Callable func) const {
 
 template <typename Callable>
 inline bool SelectivityVector::testSelected(Callable func) const {
-  if (isAllSelected()) {
+  if (isDenseRange()) {
     for (vector_size_t row = begin_; row < end_; ++row) {
       if (!func(row)) {
         return false;
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/vector/VectorPool.h"
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox {
 
@@ -47,14 +49,107 @@ FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
 
   return -1;
 }
+
+// Returns true if 'type' can be a child of a recyclable complex vector, i.e.
+// BaseVector::create() makes a flat, array, map or row vector for it.
+bool isRecyclableChildType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::ARRAY:
+    case TypeKind::MAP:
+    case TypeKind::ROW:
+      for (auto i = 0; i < type->size(); ++i) {
+        if (!isRecyclableChildType(type->childAt(i))) {
+          return false;
+        }
+      }
+      return true;
+    case TypeKind::UNKNOWN:
+    case TypeKind::FUNCTION:
+    case TypeKind::OPAQUE:
+    case TypeKind::INVALID:
+      return false;
+    default:
+      return true;
+  }
+}
+
+bool isComplexEncoding(const BaseVector& vector) {
+  switch (vector.encoding()) {
+    case VectorEncoding::Simple::ARRAY:
+    case VectorEncoding::Simple::MAP:
+    case VectorEncoding::Simple::ROW:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool isStringKind(TypeKind kind) {
+  return kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY;
+}
+
+int32_t bufferSizeClass(size_t size) {
+  return std::max<int32_t>(
+      VectorPool::kMinBufferSizeClass,
+      size <= 1 ? 0 : 64 - __builtin_clzll(size - 1));
+}
 } // namespace
 
-VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
-  auto cacheIndex = toCacheIndex(type);
-  if (cacheIndex >= 0 && size <= kMaxRecycleSize) {
-    return vectors_[cacheIndex].pop(type, size, *pool_);
+std::string VectorPool::Stats::toString() const {
+  return fmt::format(
+      "vectorHits:{} vectorMisses:{} vectorHitRate:{:.2f} bufferHits:{} bufferMisses:{} bufferHitRate:{:.2f}",
+      numVectorHits,
+      numVectorMisses,
+      vectorHitRate(),
+      numBufferHits,
+      numBufferMisses,
+      bufferHitRate());
+}
+
+VectorPool::TypePool* VectorPool::complexTypePool(
+    const TypePtr& type,
+    bool create) {
+  if (!type->isArray() && !type->isMap() && !type->isRow()) {
+    return nullptr;
   }
-  return BaseVector::create(type, size, pool_);
+  for (auto& [cachedType, typePool] : complexVectors_) {
+    if (cachedType == type || *cachedType == *type) {
+      return &typePool;
+    }
+  }
+  if (!create || complexVectors_.size() >= kMaxComplexTypes ||
+      !isRecyclableChildType(type)) {
+    return nullptr;
+  }
+  complexVectors_.emplace_back(type, TypePool{});
+  return &complexVectors_.back().second;
+}
+
+VectorPtr VectorPool::get(
+    const TypePtr& type,
+    vector_size_t size,
+    memory::MemoryPool* pool) {
+  if (pool == nullptr) {
+    pool = pool_;
+  }
+  const auto cacheIndex = toCacheIndex(type);
+  VectorPtr vector;
+  if (size <= kMaxRecycleSize) {
+    TypePool* typePool = cacheIndex >= 0 ? &vectors_[cacheIndex]
+                                         : complexTypePool(type, false);
+    if (typePool != nullptr && typePool->size > 0) {
+      ++stats_.numVectorHits;
+      vector = typePool->pop(type, size, *pool);
+    }
+  }
+  if (vector == nullptr) {
+    ++stats_.numVectorMisses;
+    vector = BaseVector::create(type, size, pool);
+  }
+  if (cacheIndex >= 0 && isStringKind(type->kind())) {
+    maybeAddStringBuffer(*vector);
+  }
+  return vector;
 }
 
 bool VectorPool::release(VectorPtr& vector) {
@@ -65,11 +160,94 @@ bool VectorPool::release(VectorPtr& vector) {
     return false;
   }
 
-  auto cacheIndex = toCacheIndex(vector->type());
-  if (cacheIndex < 0) {
+  const auto& type = vector->type();
+  const auto cacheIndex = toCacheIndex(type);
+  TypePool* typePool =
+      cacheIndex >= 0 ? &vectors_[cacheIndex] : complexTypePool(type, true);
+  if (typePool == nullptr) {
+    return false;
+  }
+  if (!isStringKind(type->kind()) || !vector->isFlatEncoding()) {
+    return typePool->maybePushBack(vector);
+  }
+
+  // Holds on to the string buffers dropped by the vector on reuse to recycle
+  // them. The vector keeps its first string buffer if it can.
+  const auto& vectorStringBuffers =
+      vector->asFlatVector<StringView>()->stringBuffers();
+  std::vector<BufferPtr> stringBuffers;
+  if (vectorStringBuffers.size() > 1) {
+    stringBuffers.assign(
+        vectorStringBuffers.begin() + 1, vectorStringBuffers.end());
+  }
+  if (!typePool->maybePushBack(vector)) {
+    return false;
+  }
+  recycleStringBuffers(stringBuffers);
+  return true;
+}
+
+void VectorPool::recycleStringBuffers(std::vector<BufferPtr>& stringBuffers) {
+  for (auto& buffer : stringBuffers) {
+    releaseBuffer(buffer);
+  }
+}
+
+void VectorPool::maybeAddStringBuffer(BaseVector& vector) {
+  auto* flatVector = vector.asFlatVector<StringView>();
+  if (!flatVector->stringBuffers().empty()) {
+    return;
+  }
+  for (int32_t i = kNumBufferSizeClasses - 1; i >= 0; --i) {
+    auto& bufferPool = buffers_[i];
+    if (bufferPool.size > 0) {
+      auto buffer = std::move(bufferPool.buffers[--bufferPool.size]);
+      buffer->setSize(0);
+      flatVector->addStringBuffer(std::move(buffer));
+      return;
+    }
+  }
+}
+
+BufferPtr VectorPool::getBuffer(size_t size, memory::MemoryPool* pool) {
+  const auto sizeClass = bufferSizeClass(size);
+  if (sizeClass <= kMaxBufferSizeClass) {
+    auto& bufferPool = buffers_[sizeClass - kMinBufferSizeClass];
+    if (bufferPool.size > 0) {
+      ++stats_.numBufferHits;
+      auto buffer = std::move(bufferPool.buffers[--bufferPool.size]);
+      buffer->setSize(size);
+      return buffer;
+    }
+  }
+  ++stats_.numBufferMisses;
+  // Allocates the whole size class to make the buffer recyclable for the same
+  // size class.
+  auto buffer = AlignedBuffer::allocate<char>(
+      sizeClass <= kMaxBufferSizeClass ? 1UL << sizeClass : size,
+      pool == nullptr ? pool_ : pool);
+  buffer->setSize(size);
+  return buffer;
+}
+
+bool VectorPool::releaseBuffer(BufferPtr& buffer) {
+  if (buffer == nullptr || !buffer->isMutable() || buffer->isView()) {
+    return false;
+  }
+  const auto capacity = buffer->capacity();
+  if (capacity < (1UL << kMinBufferSizeClass)) {
+    return false;
+  }
+  const int32_t sizeClass = 63 - __builtin_clzll(capacity);
+  if (sizeClass > kMaxBufferSizeClass) {
     return false;
   }
-  return vectors_[cacheIndex].maybePushBack(vector);
+  auto& bufferPool = buffers_[sizeClass - kMinBufferSizeClass];
+  if (bufferPool.size >= kNumPerBufferSizeClass) {
+    return false;
+  }
+  bufferPool.buffers[bufferPool.size++] = std::move(buffer);
+  return true;
 }
 
 size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
@@ -87,7 +265,11 @@ size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
 bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
   // Check that this is a Flat Vector with an initialized, unique, and mutable
   // values Buffer and an uninitialized or unique and mutable nulls Buffer.
-  if (!vector->isWritable() || !vector->isFlatEncoding() || !vector->values()) {
+  if (!vector->isWritable()) {
+    return false;
+  }
+  if (vector->isFlatEncoding() ? !vector->values()
+                               : !isComplexEncoding(*vector)) {
     return false;
   }
   if (size >= kNumPerType) {
@@ -123,6 +305,14 @@ VectorPtr VectorPool::TypePool::pop(
     if (result->size() != vectorSize) {
       result->resize(vectorSize);
     }
+    if (result->encoding() == VectorEncoding::Simple::ROW) {
+      // The recycled children are empty. Sizes them like BaseVector::create().
+      for (auto& child : result->asUnchecked<RowVector>()->children()) {
+        if (child->size() != vectorSize) {
+          child->resize(vectorSize);
+        }
+      }
+    }
     return result;
   }
   return BaseVector::create(type, vectorSize, &pool);
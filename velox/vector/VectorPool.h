@@ -20,20 +20,64 @@
 
 namespace facebook::velox {
 
-/// A thread-level cache of pre-allocated flat vectors of different types.
-/// Keeps up to 10 recyclable vectors of each type. A vector is
-/// recyclable if it is flat and recursively singly-referenced.
-/// Only singleton built-in types are supported. Decimal types, fixed-size array
-/// type, complex and custom types are not supported. Calling 'get' for an
-/// unsupported type already returns a newly allocated vector. Calling 'release'
-/// for an unsupported type is a no-op.
+/// A thread-level cache of pre-allocated vectors of different types and of
+/// buffers of different sizes. Keeps up to 10 recyclable vectors of each type.
+/// A vector is recyclable if it is flat, array, map or row encoded and
+/// recursively singly-referenced. Singleton built-in types and complex types
+/// made of scalar types are supported. Up to 8 distinct complex types are
+/// cached. Decimal types, fixed-size array type and custom types are not
+/// supported at the top level. Calling 'get' for an unsupported type already
+/// returns a newly allocated vector. Calling 'release' for an unsupported type
+/// is a no-op.
+///
+/// The string buffers of a released VARCHAR or VARBINARY vector which are not
+/// kept by the vector for reuse are recycled as buffers, and handed to the
+/// next VARCHAR or VARBINARY vector taken from the pool.
 class VectorPool {
  public:
+  struct Stats {
+    uint64_t numVectorHits{0};
+    uint64_t numVectorMisses{0};
+    uint64_t numBufferHits{0};
+    uint64_t numBufferMisses{0};
+
+    double vectorHitRate() const {
+      const auto numGets = numVectorHits + numVectorMisses;
+      return numGets == 0 ? 0 : numVectorHits / static_cast<double>(numGets);
+    }
+
+    double bufferHitRate() const {
+      const auto numGets = numBufferHits + numBufferMisses;
+      return numGets == 0 ? 0 : numBufferHits / static_cast<double>(numGets);
+    }
+
+    std::string toString() const;
+  };
+
   explicit VectorPool(memory::MemoryPool* pool) : pool_{pool} {}
 
   /// Gets a possibly recycled vector of 'type and 'size'. Allocates from
-  /// 'pool_' if no pre-allocated vector or type is a complex type.
-  VectorPtr get(const TypePtr& type, vector_size_t size);
+  /// 'pool' if no pre-allocated vector or type is not supported. 'pool'
+  /// defaults to the memory pool of this vector pool, and is set if the vector
+  /// pool is shared by the operators of a driver.
+  VectorPtr get(
+      const TypePtr& type,
+      vector_size_t size,
+      memory::MemoryPool* pool = nullptr);
+
+  /// Gets a possibly recycled buffer of at least 'size' bytes with its size set
+  /// to 'size'. Allocates from 'pool' if no pre-allocated buffer of the size
+  /// class of 'size' or 'size' is too large.
+  BufferPtr getBuffer(size_t size, memory::MemoryPool* pool = nullptr);
+
+  /// Moves 'buffer' into 'this' if it is singly referenced, mutable, not too
+  /// large and there is space. Returns true if 'buffer' has been returned back
+  /// to this pool.
+  bool releaseBuffer(BufferPtr& buffer);
+
+  const Stats& stats() const {
+    return stats_;
+  }
 
   /// Moves vector into 'this' if it is flat, recursively singly referenced and
   /// there is space. The function returns true if 'vector' is not null and has
@@ -47,6 +91,17 @@ class VectorPool {
   /// the batch the less the win from recycling.
   static constexpr vector_size_t kMaxRecycleSize = 64 * 1024;
   static constexpr int32_t kNumPerType = 10;
+  /// Max number of distinct complex types to cache vectors of.
+  static constexpr int32_t kMaxComplexTypes = 8;
+
+  /// The buffers are cached by power of two size classes from 1KB to 1MB. A
+  /// recycled buffer is put in the largest size class not exceeding its
+  /// capacity.
+  static constexpr int32_t kMinBufferSizeClass = 10;
+  static constexpr int32_t kMaxBufferSizeClass = 20;
+  static constexpr int32_t kNumBufferSizeClasses =
+      kMaxBufferSizeClass - kMinBufferSizeClass + 1;
+  static constexpr int32_t kNumPerBufferSizeClass = 10;
 
   struct TypePool {
     int32_t size{0};
@@ -60,6 +115,23 @@ class VectorPool {
         memory::MemoryPool& pool);
   };
 
+  struct BufferPool {
+    int32_t size{0};
+    std::array<BufferPtr, kNumPerBufferSizeClass> buffers;
+  };
+
+  // Returns the cache of complex type 'type', or nullptr if 'type' is not a
+  // supported complex type. Creates the cache if 'create' is true and there is
+  // space.
+  TypePool* complexTypePool(const TypePtr& type, bool create);
+
+  // Recycles the string buffers dropped by a vector returned to this pool.
+  void recycleStringBuffers(std::vector<BufferPtr>& stringBuffers);
+
+  // Hands a recycled string buffer to 'vector' taken from this pool if it has
+  // none.
+  void maybeAddStringBuffer(BaseVector& vector);
+
   memory::MemoryPool* const pool_;
 
   static constexpr int32_t kNumCachedVectorTypes =
@@ -67,6 +139,14 @@ class VectorPool {
 
   /// Caches of pre-allocated vectors indexed by typeKind.
   std::array<TypePool, kNumCachedVectorTypes> vectors_;
+
+  /// Caches of pre-allocated vectors of complex types.
+  std::vector<std::pair<TypePtr, TypePool>> complexVectors_;
+
+  /// Caches of pre-allocated buffers indexed by size class.
+  std::array<BufferPool, kNumBufferSizeClasses> buffers_;
+
+  Stats stats_;
 };
 
 /// A simple vector ptr wrapper with an associated vector pool. It releases
@@ -579,6 +579,46 @@ void exportDictionary(
   exportBase(values, Selection(values.size()), *out.dictionary, pool);
 }
 
+// Exports a constant vector as a run-end encoded array with a single run,
+// so that the value is not repeated for each row.
+void exportConstant(
+    const BaseVector& vec,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    VeloxToArrowBridgeHolder& holder) {
+  // Run-end encoded arrays have no buffers of their own. The nulls are in the
+  // values.
+  out.n_buffers = 0;
+  out.null_count = 0;
+  const vector_size_t numRuns = out.length > 0 ? 1 : 0;
+  auto runEnds = AlignedBuffer::allocate<int32_t>(numRuns, pool);
+  if (numRuns > 0) {
+    *runEnds->asMutable<int32_t>() = out.length;
+  }
+  auto runEndsVector = std::make_shared<FlatVector<int32_t>>(
+      pool,
+      INTEGER(),
+      nullptr,
+      numRuns,
+      std::move(runEnds),
+      std::vector<BufferPtr>{});
+  auto values = BaseVector::create(vec.type(), numRuns, pool);
+  if (numRuns > 0) {
+    values->copy(&vec, 0, 0, 1);
+  }
+  holder.resizeChildren(2);
+  out.n_children = 2;
+  out.children = holder.getChildrenArrays();
+  exportBase(
+      *runEndsVector, Selection(numRuns), *holder.allocateChild(0), pool);
+  try {
+    exportBase(*values, Selection(numRuns), *holder.allocateChild(1), pool);
+  } catch (const VeloxException&) {
+    out.children[0]->release(out.children[0]);
+    throw;
+  }
+}
+
 void exportBase(
     const BaseVector& vec,
     const Selection& rows,
@@ -589,7 +629,9 @@ void exportBase(
   out.length = rows.count();
   out.offset = 0;
   out.dictionary = nullptr;
-  exportNulls(vec, rows, out, pool, *holder);
+  if (vec.encoding() != VectorEncoding::Simple::CONSTANT) {
+    exportNulls(vec, rows, out, pool, *holder);
+  }
   switch (vec.encoding()) {
     case VectorEncoding::Simple::FLAT:
       exportFlat(vec, rows, out, pool, *holder);
@@ -606,6 +648,9 @@ void exportBase(
     case VectorEncoding::Simple::DICTIONARY:
       exportDictionary(vec, rows, out, pool, *holder);
       break;
+    case VectorEncoding::Simple::CONSTANT:
+      exportConstant(vec, out, pool, *holder);
+      break;
     default:
       VELOX_NYI("{} cannot be exported to Arrow yet.", vec.encoding());
   }
@@ -644,6 +689,28 @@ void exportToArrow(const VectorPtr& vec, ArrowSchema& arrowSchema) {
     arrowSchema.dictionary = bridgeHolder->dictionary.get();
     exportToArrow(vec->valueVector(), *arrowSchema.dictionary);
 
+  } else if (vec->encoding() == VectorEncoding::Simple::CONSTANT) {
+    // Run-end encoded with int32 run ends. See exportConstant().
+    arrowSchema.format = "+r";
+    arrowSchema.dictionary = nullptr;
+    bridgeHolder->childrenRaw.resize(2);
+    bridgeHolder->childrenOwned.resize(2);
+    arrowSchema.children = bridgeHolder->childrenRaw.data();
+    arrowSchema.n_children = 2;
+    const std::vector<VectorPtr> children = {
+        BaseVector::create(INTEGER(), 0, vec->pool()),
+        BaseVector::create(type, 0, vec->pool())};
+    static const char* kNames[] = {"run_ends", "values"};
+    for (auto i = 0; i < 2; ++i) {
+      auto& child = bridgeHolder->childrenOwned[i];
+      child = std::make_unique<ArrowSchema>();
+      exportToArrow(children[i], *child);
+      child->name = kNames[i];
+      arrowSchema.children[i] = child.get();
+    }
+    // Run ends are never null.
+    arrowSchema.children[0]->flags = 0;
+
   } else {
     arrowSchema.format = exportArrowFormatStr(type, bridgeHolder->formatBuffer);
     arrowSchema.dictionary = nullptr;
@@ -803,6 +870,12 @@ TypePtr importFromArrow(const ArrowSchema& arrowSchema) {
               importFromArrow(*child.children[1]));
         }
 
+        // Run-end encoded. Imported as the type of the values.
+        case 'r':
+          VELOX_CHECK_EQ(arrowSchema.n_children, 2);
+          VELOX_CHECK_NOT_NULL(arrowSchema.children[1]);
+          return importFromArrow(*arrowSchema.children[1]);
+
         // Struct/rows.
         case 's': {
           // Loop collecting the child types and names.
@@ -1077,6 +1150,74 @@ VectorPtr createDictionaryVector(
       std::move(wrapped));
 }
 
+// Sets 'indices' to the number of the run of each of the first 'length' rows.
+template <typename T>
+void fillRunIndices(
+    const T* runEnds,
+    int64_t numRuns,
+    int64_t length,
+    vector_size_t* indices) {
+  int64_t row = 0;
+  for (int64_t run = 0; run < numRuns && row < length; ++run) {
+    const auto end = std::min<int64_t>(runEnds[run], length);
+    VELOX_USER_CHECK_GT(end, row, "Run ends must be increasing.");
+    std::fill(indices + row, indices + end, run);
+    row = end;
+  }
+  VELOX_USER_CHECK_EQ(row, length, "Run ends must cover all rows.");
+}
+
+// Imports a run-end encoded array as a dictionary over its values, or as a
+// constant if there is a single run. The values are imported without copy.
+VectorPtr createRunEndEncodedVector(
+    memory::MemoryPool* pool,
+    const ArrowSchema& arrowSchema,
+    const ArrowArray& arrowArray,
+    bool isViewer) {
+  VELOX_CHECK_EQ(arrowArray.n_children, 2);
+  const auto& runEnds = *arrowArray.children[0];
+  VELOX_USER_CHECK_EQ(
+      runEnds.offset,
+      0,
+      "Offsets are not supported during arrow conversion yet.");
+  auto values = importFromArrowImpl(
+      *arrowSchema.children[1], *arrowArray.children[1], pool, isViewer);
+  const auto length = arrowArray.length;
+  if (runEnds.length == 1 && length > 0) {
+    return BaseVector::wrapInConstant(length, 0, std::move(values));
+  }
+  auto indices = AlignedBuffer::allocate<vector_size_t>(length, pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  const char* format = arrowSchema.children[0]->format;
+  switch (format[0]) {
+    case 's':
+      fillRunIndices(
+          static_cast<const int16_t*>(runEnds.buffers[1]),
+          runEnds.length,
+          length,
+          rawIndices);
+      break;
+    case 'i':
+      fillRunIndices(
+          static_cast<const int32_t*>(runEnds.buffers[1]),
+          runEnds.length,
+          length,
+          rawIndices);
+      break;
+    case 'l':
+      fillRunIndices(
+          static_cast<const int64_t*>(runEnds.buffers[1]),
+          runEnds.length,
+          length,
+          rawIndices);
+      break;
+    default:
+      VELOX_USER_FAIL("Unsupported run end type '{}'.", format);
+  }
+  return BaseVector::wrapInDictionary(
+      nullptr, std::move(indices), length, std::move(values));
+}
+
 VectorPtr importFromArrowImpl(
     ArrowSchema& arrowSchema,
     ArrowArray& arrowArray,
@@ -1117,6 +1258,10 @@ VectorPtr importFromArrowImpl(
         pool, type, nulls, arrowSchema, arrowArray, isViewer, wrapInBufferView);
   }
 
+  if (strcmp(arrowSchema.format, "+r") == 0) {
+    return createRunEndEncodedVector(pool, arrowSchema, arrowArray, isViewer);
+  }
+
   // String data types (VARCHAR and VARBINARY).
   if (type->isVarchar() || type->isVarbinary()) {
     VELOX_USER_CHECK_EQ(
@@ -662,10 +662,32 @@ TEST_F(ArrowBridgeArrayExportTest, unsupported) {
   // Timestamps.
   vector = vectorMaker_.flatVectorNullable<Timestamp>({});
   EXPECT_THROW(exportToArrow(vector, arrowArray, pool_.get()), VeloxException);
+}
 
-  // Constant encoding.
-  vector = BaseVector::createConstant(INTEGER(), variant(10), 10, pool_.get());
-  EXPECT_THROW(exportToArrow(vector, arrowArray, pool_.get()), VeloxException);
+TEST_F(ArrowBridgeArrayExportTest, constant) {
+  VectorPtr vec =
+      BaseVector::createConstant(INTEGER(), variant(10), 10, pool_.get());
+  auto array = toArrow(vec, pool_.get());
+  ASSERT_OK(array->ValidateFull());
+  ASSERT_EQ(
+      *array->type(), *arrow::run_end_encoded(arrow::int32(), arrow::int32()));
+  auto& ree = static_cast<const arrow::RunEndEncodedArray&>(*array);
+  ASSERT_EQ(ree.length(), 10);
+  auto& runEnds = static_cast<const arrow::Int32Array&>(*ree.run_ends());
+  ASSERT_EQ(runEnds.length(), 1);
+  EXPECT_EQ(runEnds.Value(0), 10);
+  auto& values = static_cast<const arrow::Int32Array&>(*ree.values());
+  ASSERT_EQ(values.length(), 1);
+  EXPECT_EQ(values.Value(0), 10);
+
+  // A null constant has a single null value.
+  vec = BaseVector::createNullConstant(VARCHAR(), 5, pool_.get());
+  array = toArrow(vec, pool_.get());
+  ASSERT_OK(array->ValidateFull());
+  auto& nullRee = static_cast<const arrow::RunEndEncodedArray&>(*array);
+  ASSERT_EQ(nullRee.length(), 5);
+  ASSERT_EQ(nullRee.values()->length(), 1);
+  EXPECT_TRUE(nullRee.values()->IsNull(0));
 }
 
 class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
@@ -1097,6 +1119,55 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
     });
   }
 
+  void testImportRunEndEncoded() {
+    arrow::Int32Builder runEndsBuilder;
+    ASSERT_OK(runEndsBuilder.AppendValues({3, 4, 8}));
+    ASSERT_OK_AND_ASSIGN(auto runEnds, runEndsBuilder.Finish());
+    arrow::Int64Builder valuesBuilder;
+    ASSERT_OK(valuesBuilder.Append(1));
+    ASSERT_OK(valuesBuilder.AppendNull());
+    ASSERT_OK(valuesBuilder.Append(3));
+    ASSERT_OK_AND_ASSIGN(auto values, valuesBuilder.Finish());
+    ASSERT_OK_AND_ASSIGN(
+        auto array, arrow::RunEndEncodedArray::Make(8, runEnds, values));
+
+    auto expected = vectorMaker_.flatVectorNullable<int64_t>(
+        {1, 1, 1, std::nullopt, 3, 3, 3, 3});
+    auto vec = importArray(*array);
+    ASSERT_EQ(*vec->type(), *BIGINT());
+    EXPECT_EQ(vec->encoding(), VectorEncoding::Simple::DICTIONARY);
+    ASSERT_EQ(vec->size(), expected->size());
+    for (auto i = 0; i < vec->size(); ++i) {
+      EXPECT_TRUE(vec->equalValueAt(expected.get(), i, i)) << i;
+    }
+
+    // A single run is imported as a constant.
+    ASSERT_OK(runEndsBuilder.Append(5));
+    ASSERT_OK_AND_ASSIGN(runEnds, runEndsBuilder.Finish());
+    ASSERT_OK(valuesBuilder.Append(7));
+    ASSERT_OK_AND_ASSIGN(values, valuesBuilder.Finish());
+    ASSERT_OK_AND_ASSIGN(
+        array, arrow::RunEndEncodedArray::Make(5, runEnds, values));
+    vec = importArray(*array);
+    EXPECT_EQ(vec->encoding(), VectorEncoding::Simple::CONSTANT);
+    ASSERT_EQ(vec->size(), 5);
+    EXPECT_EQ(vec->as<SimpleVector<int64_t>>()->valueAt(4), 7);
+  }
+
+  // Imports 'array', which stays alive with the caller.
+  VectorPtr importArray(const arrow::Array& array) {
+    ArrowSchema schema;
+    ArrowArray data;
+    VELOX_CHECK(arrow::ExportType(*array.type(), &schema).ok());
+    VELOX_CHECK(arrow::ExportArray(array, &data).ok());
+    auto vec = importFromArrow(schema, data, pool_.get());
+    if (isViewer()) {
+      schema.release(&schema);
+      data.release(&data);
+    }
+    return vec;
+  }
+
   void testImportFailures() {
     ArrowSchema arrowSchema;
     ArrowArray arrowArray;
@@ -1200,6 +1271,10 @@ TEST_F(ArrowBridgeArrayImportAsViewerTest, dictionary) {
   testImportDictionary();
 }
 
+TEST_F(ArrowBridgeArrayImportAsViewerTest, runEndEncoded) {
+  testImportRunEndEncoded();
+}
+
 TEST_F(ArrowBridgeArrayImportAsViewerTest, failures) {
   testImportFailures();
 }
@@ -1247,6 +1322,10 @@ TEST_F(ArrowBridgeArrayImportAsOwnerTest, dictionary) {
   testImportDictionary();
 }
 
+TEST_F(ArrowBridgeArrayImportAsOwnerTest, runEndEncoded) {
+  testImportRunEndEncoded();
+}
+
 TEST_F(ArrowBridgeArrayImportAsOwnerTest, failures) {
   testImportFailures();
 }
@@ -1392,6 +1392,64 @@ TEST_F(DecodedVectorTest, dictionaryWrapping) {
   }
 }
 
+TEST_F(DecodedVectorTest, nestedDictionaryAllRows) {
+  // Sizes that are not a multiple of the SIMD width or of 8.
+  for (auto size : {5, 100, 1'001}) {
+    SCOPED_TRACE(size);
+    auto flat = makeFlatVector<int64_t>(
+        size, [](auto row) { return row; }, nullEvery(11));
+    auto innerIndices = makeIndices(size, [&](auto row) {
+      return (row * 7) % size;
+    });
+    auto outerIndices = makeIndicesInReverse(size);
+    auto innerNulls = makeNulls(size, nullEvery(5));
+
+    auto* rawInner = innerIndices->as<vector_size_t>();
+    auto* rawOuter = outerIndices->as<vector_size_t>();
+    auto check = [&](const VectorPtr& vector, bool hasInnerNulls) {
+      for (const bool useRows : {false, true}) {
+        SelectivityVector rows(size);
+        DecodedVector decoded;
+        if (useRows) {
+          decoded.decode(*vector, rows);
+        } else {
+          decoded.decode(*vector);
+        }
+        ASSERT_EQ(decoded.base(), flat.get());
+        for (auto i = 0; i < size; ++i) {
+          const auto inner = rawOuter[i];
+          const bool isNull = (hasInnerNulls && inner % 5 == 0) ||
+              (rawInner[inner] % 11 == 0);
+          ASSERT_EQ(decoded.isNullAt(i), isNull) << i;
+          if (!isNull) {
+            ASSERT_EQ(decoded.index(i), rawInner[inner]) << i;
+          }
+          ASSERT_LT(decoded.index(i), size) << i;
+        }
+        auto* nulls = decoded.nulls();
+        ASSERT_NE(nulls, nullptr);
+        for (auto i = 0; i < size; ++i) {
+          ASSERT_EQ(bits::isBitNull(nulls, i), decoded.isNullAt(i)) << i;
+        }
+      }
+    };
+
+    auto dict = BaseVector::wrapInDictionary(
+        nullptr,
+        outerIndices,
+        size,
+        BaseVector::wrapInDictionary(nullptr, innerIndices, size, flat));
+    check(dict, false);
+
+    dict = BaseVector::wrapInDictionary(
+        nullptr,
+        outerIndices,
+        size,
+        BaseVector::wrapInDictionary(innerNulls, innerIndices, size, flat));
+    check(dict, true);
+  }
+}
+
 TEST_F(DecodedVectorTest, previousIndicesInReUsedDecodedVector) {
   // Verify that when DecodedVector is re-used with different set of valid rows,
   // then the unselected indices would still have valid values.
@@ -252,6 +252,47 @@ TEST(SelectivityVectorTest, setAll) {
   EXPECT_EQ(expected, vector);
 }
 
+TEST(SelectivityVectorTest, denseRange) {
+  SelectivityVector rows(1'000, false);
+  EXPECT_TRUE(rows.isDenseRange());
+
+  rows.setValidRange(100, 900, true);
+  rows.updateBounds();
+  EXPECT_TRUE(rows.isDenseRange());
+  EXPECT_FALSE(rows.isAllSelected());
+  EXPECT_EQ(rows.countSelected(), 800);
+
+  std::vector<vector_size_t> selected;
+  rows.applyToSelected([&](auto row) { selected.push_back(row); });
+  ASSERT_EQ(selected.size(), 800);
+  EXPECT_EQ(selected.front(), 100);
+  EXPECT_EQ(selected.back(), 899);
+
+  // A hole in the range makes it sparse.
+  rows.setValid(500, false);
+  rows.updateBounds();
+  EXPECT_FALSE(rows.isDenseRange());
+  EXPECT_EQ(rows.countSelected(), 799);
+  selected.clear();
+  rows.applyToSelected([&](auto row) { selected.push_back(row); });
+  ASSERT_EQ(selected.size(), 799);
+  EXPECT_EQ(selected[400], 501);
+
+  // Filling the hole makes it dense again.
+  rows.setValid(500, true);
+  rows.updateBounds();
+  EXPECT_EQ(rows.countSelected(), 800);
+  EXPECT_TRUE(rows.isDenseRange());
+
+  rows.setAll();
+  EXPECT_TRUE(rows.isDenseRange());
+  EXPECT_TRUE(rows.isAllSelected());
+
+  rows.clearAll();
+  EXPECT_TRUE(rows.isDenseRange());
+  rows.applyToSelected([](auto /*row*/) { FAIL(); });
+}
+
 namespace {
 
 void testEquals(
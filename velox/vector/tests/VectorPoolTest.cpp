@@ -146,4 +146,118 @@ TEST_F(VectorPoolTest, customTypes) {
   ASSERT_EQ(1'000, vector->size());
   ASSERT_TRUE(isJsonType(vector->type()));
 }
+
+TEST_F(VectorPoolTest, complexTypes) {
+  VectorPool vectorPool(pool());
+
+  auto makeTypes = []() -> std::vector<TypePtr> {
+    return {
+        ARRAY(BIGINT()),
+        MAP(VARCHAR(), ARRAY(INTEGER())),
+        ROW({"a", "b"}, {BIGINT(), ARRAY(VARCHAR())})};
+  };
+  const auto types = makeTypes();
+  const auto equalTypes = makeTypes();
+  for (auto i = 0; i < types.size(); ++i) {
+    const auto& type = types[i];
+    SCOPED_TRACE(type->toString());
+    auto vector = vectorPool.get(type, 100);
+    ASSERT_EQ(vector->size(), 100);
+    ASSERT_TRUE(vector->type()->equivalent(*type));
+    auto* vectorPtr = vector.get();
+    ASSERT_TRUE(vectorPool.release(vector));
+    ASSERT_EQ(vector, nullptr);
+
+    // An equal type which is a different object hits the same cache.
+    auto recycled = vectorPool.get(equalTypes[i], 200);
+    ASSERT_EQ(recycled.get(), vectorPtr);
+    ASSERT_EQ(recycled->size(), 200);
+    for (auto i = 0; i < recycled->size(); ++i) {
+      ASSERT_FALSE(recycled->isNullAt(i));
+    }
+    if (type->isRow()) {
+      for (const auto& child : recycled->as<RowVector>()->children()) {
+        ASSERT_EQ(child->size(), 200);
+      }
+    } else if (type->isArray()) {
+      auto* array = recycled->as<ArrayVector>();
+      ASSERT_EQ(array->elements()->size(), 0);
+      for (auto i = 0; i < recycled->size(); ++i) {
+        ASSERT_EQ(array->sizeAt(i), 0);
+        ASSERT_EQ(array->offsetAt(i), 0);
+      }
+    }
+  }
+
+  // Multiply-referenced children make the vector non-recyclable.
+  auto array = vectorPool.get(ARRAY(BIGINT()), 10);
+  auto elements = array->as<ArrayVector>()->elements();
+  ASSERT_FALSE(vectorPool.release(array));
+
+  // Complex types of unknown type are not supported.
+  auto unknowns = BaseVector::create(ARRAY(UNKNOWN()), 10, pool());
+  ASSERT_FALSE(vectorPool.release(unknowns));
+
+  ASSERT_EQ(vectorPool.stats().numVectorHits, types.size());
+  ASSERT_EQ(vectorPool.stats().numVectorMisses, types.size() + 1);
+}
+
+TEST_F(VectorPoolTest, buffers) {
+  VectorPool vectorPool(pool());
+
+  auto buffer = vectorPool.getBuffer(3'000);
+  ASSERT_EQ(buffer->size(), 3'000);
+  ASSERT_GE(buffer->capacity(), 4'096);
+  auto* bufferPtr = buffer.get();
+  ASSERT_TRUE(vectorPool.releaseBuffer(buffer));
+  ASSERT_EQ(buffer, nullptr);
+
+  // The same size class gets the recycled buffer.
+  auto recycled = vectorPool.getBuffer(4'000);
+  ASSERT_EQ(recycled.get(), bufferPtr);
+  ASSERT_EQ(recycled->size(), 4'000);
+
+  // Multiply-referenced, too small and too large buffers are not recycled.
+  auto copy = recycled;
+  ASSERT_FALSE(vectorPool.releaseBuffer(recycled));
+  auto small = AlignedBuffer::allocate<char>(100, pool());
+  ASSERT_FALSE(vectorPool.releaseBuffer(small));
+  auto large = vectorPool.getBuffer(4 << 20);
+  ASSERT_EQ(large->size(), 4 << 20);
+  ASSERT_FALSE(vectorPool.releaseBuffer(large));
+
+  ASSERT_EQ(vectorPool.stats().numBufferHits, 1);
+  ASSERT_EQ(vectorPool.stats().numBufferMisses, 2);
+  ASSERT_EQ(vectorPool.stats().bufferHitRate(), 1.0 / 3);
+}
+
+TEST_F(VectorPoolTest, stringBuffers) {
+  VectorPool vectorPool(pool());
+
+  const std::string longString(2'000, 'x');
+  auto vector = vectorPool.get(VARCHAR(), 1'000);
+  auto* flatVector = vector->asFlatVector<StringView>();
+  for (auto i = 0; i < vector->size(); ++i) {
+    flatVector->set(i, StringView(longString));
+  }
+  const auto numStringBuffers = flatVector->stringBuffers().size();
+  ASSERT_GT(numStringBuffers, 1);
+  std::unordered_set<const Buffer*> stringBuffers;
+  for (const auto& buffer : flatVector->stringBuffers()) {
+    stringBuffers.insert(buffer.get());
+  }
+  ASSERT_TRUE(vectorPool.release(vector));
+
+  // The vector keeps its first string buffer and the others are recycled.
+  auto recycled = vectorPool.get(VARCHAR(), 1'000);
+  ASSERT_EQ(recycled->asFlatVector<StringView>()->stringBuffers().size(), 1);
+
+  // A vector with no string buffers gets a recycled one.
+  auto another = vectorPool.get(VARCHAR(), 1'000);
+  const auto& anotherBuffers =
+      another->asFlatVector<StringView>()->stringBuffers();
+  ASSERT_EQ(anotherBuffers.size(), 1);
+  ASSERT_EQ(anotherBuffers[0]->size(), 0);
+  ASSERT_EQ(stringBuffers.count(anotherBuffers[0].get()), 1);
+}
 } // namespace facebook::velox::test